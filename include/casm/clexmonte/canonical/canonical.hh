@@ -20,6 +20,11 @@ class CanonicalPotential {
   /// \brief Reset pointer to state currently being calculated
   void set(state_type const *state, std::shared_ptr<Conditions> conditions);
 
+  /// \brief Reset pointer to state currently being calculated, using the
+  ///     given formation energy cluster expansion
+  void set(state_type const *state, std::shared_ptr<Conditions> conditions,
+           std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex);
+
   /// \brief Pointer to current state
   state_type const *state() const;
 
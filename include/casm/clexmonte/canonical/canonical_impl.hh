@@ -79,8 +79,7 @@ void Canonical<EngineType>::run(state_type &state,
 
   // Enforce composition
   clexmonte::enforce_composition(
-      get_occupation(state),
-      state.conditions.vector_values.at("mol_composition"),
+      get_occupation(state), *this->conditions->mol_composition,
       get_composition_calculator(*this->system), semigrand_canonical_swaps,
       occ_location, random_number_generator);
 
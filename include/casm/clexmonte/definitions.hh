@@ -53,6 +53,9 @@ struct RunData;
 class StateGenerator;
 typedef StateGenerator state_generator_type;
 class IncrementalConditionsStateGenerator;
+class AdaptiveConditionsStateGenerator;
+class GridConditionsStateGenerator;
+class FiniteSizeScalingStateGenerator;
 
 class ConfigGenerator;
 typedef ConfigGenerator config_generator_type;
@@ -0,0 +1,76 @@
+#ifndef CASM_clexmonte_events_ActiveEventSet
+#define CASM_clexmonte_events_ActiveEventSet
+
+#include <vector>
+
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Tracks which events are allowed by the current occupation
+///
+/// An event is "active" if it is included in the event list and the
+/// current occupation of its sites matches its initial occupation. After an
+/// event occurs, only the events that share a site with it are re-checked,
+/// so with dilute defects the set of active events is maintained at a cost
+/// proportional to the number of events per site rather than the number of
+/// events in the supercell.
+///
+/// Notes:
+/// - Expected to be constructed as shared_ptr
+/// - Holds references to `prim_event_list`, `event_list`, and the
+///   occupation, which must outlive the ActiveEventSet
+class ActiveEventSet {
+ public:
+  ActiveEventSet(std::vector<PrimEventData> const &_prim_event_list,
+                 EventDataList const &_event_list,
+                 Eigen::VectorXi const &_occupation);
+
+  /// \brief Set the occupation, and re-check all events
+  void reset(Eigen::VectorXi const &_occupation);
+
+  /// \brief Re-check all events
+  void reset();
+
+  /// \brief Re-check events that share a site with `event_id`, after it
+  ///     occurred
+  void set_occurred(EventID const &event_id);
+
+  /// \brief True if the event with a given linear index is active
+  bool is_active(Index linear_index) const {
+    return m_is_active[linear_index];
+  }
+
+  /// \brief Number of active events
+  Index size() const { return m_size; }
+
+ private:
+  bool _check(EventID const &event_id);
+
+  void _set(Index linear_index, bool value);
+
+  std::vector<PrimEventData> const *m_prim_event_list;
+  EventDataList const *m_event_list;
+  Eigen::VectorXi const *m_occupation;
+
+  /// Linear indices of events including site `l` are
+  /// `m_site_events[m_site_offsets[l]]` to
+  /// `m_site_events[m_site_offsets[l+1]-1]`
+  std::vector<Index> m_site_offsets;
+  std::vector<Index> m_site_events;
+
+  std::vector<char> m_is_active;
+  Index m_size;
+
+  // scratch space
+  std::vector<Index> m_sites;
+  std::vector<Index> m_occurred_sites;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
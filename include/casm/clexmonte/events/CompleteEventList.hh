@@ -1,11 +1,18 @@
 #ifndef CASM_clexmonte_events_CompleteEventList
 #define CASM_clexmonte_events_CompleteEventList
 
+#include <algorithm>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "casm/clexmonte/events/ImpactTable.hh"
 #include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/filesystem.hh"
 
 namespace CASM {
 namespace monte {
@@ -14,10 +21,337 @@ class OccLocation;
 
 namespace clexmonte {
 
+/// \brief Constructs EventData on demand, from PrimEventData and the event
+///     translation
+///
+/// Used by EventDataList when EventData is not stored for every event.
+///
+/// Notes:
+/// - Holds pointers to the prim event list and occupant location tracker,
+///   which must outlive the EventDataBuilder (see `set_occ_location`)
+/// - Results are written to an internal scratch buffer which is overwritten
+///   by the next call, so each thread should use its own EventDataBuilder
+class EventDataBuilder {
+ public:
+  EventDataBuilder(std::vector<PrimEventData> const &_prim_event_list,
+                   monte::OccLocation const &_occ_location);
+
+  /// \brief Reset the occupant location tracker used to construct events
+  void set_occ_location(monte::OccLocation const &_occ_location);
+
+  /// \brief Construct EventData for an event, valid until the next call
+  EventData const &operator()(EventID const &id) const;
+
+  /// \brief Construct EventData for an event, using already calculated
+  ///     linear site indices, valid until the next call
+  EventData const &operator()(EventID const &id,
+                              Index const *linear_site_index) const;
+
+  /// \brief Set only the linear site indices of an event
+  void set_linear_site_index(std::vector<Index> &linear_site_index,
+                             EventID const &id) const;
+
+ private:
+  std::vector<PrimEventData> const *m_prim_event_list;
+  monte::OccLocation const *m_occ_location;
+  mutable EventData m_event_data;
+};
+
+/// \brief Dense, index-addressed storage of EventData for all supercell events
+///
+/// Events are stored contiguously, at the linear index
+/// `unitcell_index * n_prim_events + prim_event_index` (the same indexing
+/// used by SupercellEventImpactTable), so lookup by EventID is constant time
+/// and does not require a tree walk.
+///
+/// Notes:
+/// - The methods `at`, `count`, `size`, `emplace`, and iteration over
+///   `(EventID, EventData)` pairs mirror `std::map<EventID, EventData>` so
+///   that existing callers continue to work
+/// - Events excluded by event filters still occupy a slot, but are not
+///   included: `count` returns 0 and `at` throws std::out_of_range for them
+/// - Optionally, the event sites may also be stored in a structure-of-arrays
+///   layout (see `init_site_arrays`): the `linear_site_index` of all events
+///   are stored in one contiguous block, with a fixed stride per event, so
+///   that rate calculations can stream through them without dereferencing
+///   the heap-allocated vectors of each `monte::OccEvent`. The unit cell and
+///   prim event index of a slot are determined by its linear index (see
+///   `event_id`), so they do not need to be stored separately.
+/// - Optionally, EventData may be constructed on demand instead of being
+///   stored for every event (see the constructor taking an
+///   EventDataBuilder). Then only which events are included is stored, and
+///   `at`, `operator[]`, and iteration return a reference to a scratch
+///   EventData that is valid until the next access.
+class EventDataList {
+ public:
+  class const_iterator;
+
+  EventDataList();
+
+  EventDataList(Index _n_unitcells, Index _n_prim_events);
+
+  EventDataList(Index _n_unitcells, Index _n_prim_events,
+                std::shared_ptr<EventDataBuilder> _builder);
+
+  /// \brief Number of unit cells in the supercell
+  Index n_unitcells() const { return m_n_unitcells; }
+
+  /// \brief Number of events in the origin unit cell
+  Index n_prim_events() const { return m_n_prim_events; }
+
+  /// \brief Number of slots, `n_unitcells * n_prim_events`
+  Index n_slots() const { return m_is_included.size(); }
+
+  /// \brief Number of included events
+  Index size() const { return m_size; }
+
+  /// \brief True if no events are included
+  bool empty() const { return m_size == 0; }
+
+  /// \brief Linear index of an event
+  Index linear_index(EventID const &id) const {
+    return clexmonte::linear_index(id, m_n_prim_events);
+  }
+
+  /// \brief Linear index of an event
+  Index linear_index(PackedEventID const &id) const {
+    return clexmonte::linear_index(id, m_n_prim_events);
+  }
+
+  /// \brief EventID corresponding to a linear index
+  EventID event_id(Index linear_index) const;
+
+  /// \brief True if the event at `linear_index` is included
+  bool is_included(Index linear_index) const {
+    return m_is_included[linear_index];
+  }
+
+  /// \brief Return linear index of an event if included, else -1
+  Index find(EventID const &id) const;
+
+  /// \brief Return linear index of an event if included, else -1
+  Index find(PackedEventID const &id) const { return find(unpack(id)); }
+
+  /// \brief Return 1 if event is included, else 0
+  Index count(EventID const &id) const;
+
+  /// \brief Access event data, with range and inclusion check
+  EventData const &at(EventID const &id) const;
+
+  /// \brief Access event data by linear index, without checks
+  EventData const &operator[](Index linear_index) const {
+    if (m_builder) {
+      return _build(linear_index);
+    }
+    return m_data[linear_index];
+  }
+
+  /// \brief Include an event, returns false if it was already included
+  ///
+  /// If EventData is constructed on demand, `data` is not stored.
+  bool emplace(EventID const &id, EventData const &data);
+
+  /// \brief Include an event, without setting its EventData
+  bool include(EventID const &id);
+
+  /// \brief Include the event at `linear_index`, without checks and without
+  ///     updating `size()`
+  ///
+  /// If `data` is not null, and EventData is stored, it is copied. Different
+  /// threads may include events at different `linear_index` concurrently.
+  /// `recount` must be called afterwards.
+  void include_unchecked(Index linear_index, EventData const *data) {
+    if (data && !m_builder) {
+      m_data[linear_index] = *data;
+    }
+    m_is_included[linear_index] = true;
+  }
+
+  /// \brief Update `size()` after using `include_unchecked`
+  void recount() {
+    m_size = std::count(m_is_included.begin(), m_is_included.end(), true);
+  }
+
+  /// \brief True if EventData is stored for every event, false if it is
+  ///     constructed on demand
+  bool stores_event_data() const { return m_builder == nullptr; }
+
+  /// \brief EventDataBuilder, if EventData is constructed on demand
+  std::shared_ptr<EventDataBuilder> const &builder() const {
+    return m_builder;
+  }
+
+  /// \brief Iterate over included events, in order of linear index
+  const_iterator begin() const;
+
+  /// \brief Iterate over included events, in order of linear index
+  const_iterator end() const;
+
+  // --- Structure-of-arrays site storage ---
+
+  /// \brief Allocate structure-of-arrays storage for event sites
+  void init_site_arrays(std::vector<Index> const &n_sites_by_prim_event);
+
+  /// \brief True if event sites are stored in structure-of-arrays layout
+  bool has_site_arrays() const { return m_site_stride != 0; }
+
+  /// \brief Number of entries reserved per event in the site arrays
+  Index site_stride() const { return m_site_stride; }
+
+  /// \brief Number of sites for events of a prim event type
+  Index n_sites(Index prim_event_index) const {
+    return m_n_sites[prim_event_index];
+  }
+
+  /// \brief Pointer to the first of `n_sites(prim_event_index)` linear site
+  ///     indices of the event at `linear_index`
+  Index const *linear_site_index(Index linear_index) const {
+    return m_linear_site_index.data() + linear_index * m_site_stride;
+  }
+
+  /// \brief Pointer to the first of `n_sites(prim_event_index)` linear site
+  ///     indices of the event at `linear_index`
+  Index *linear_site_index(Index linear_index) {
+    return m_linear_site_index.data() + linear_index * m_site_stride;
+  }
+
+  /// \brief Linear site indices of an included event
+  EventSites event_sites(EventID const &id,
+                         std::vector<Index> &scratch) const;
+
+ private:
+  EventData const &_build(Index linear_index) const;
+
+  Index m_n_unitcells;
+  Index m_n_prim_events;
+  Index m_size;
+  std::vector<EventData> m_data;
+  std::vector<char> m_is_included;
+  std::shared_ptr<EventDataBuilder> m_builder;
+
+  Index m_site_stride;
+  std::vector<Index> m_n_sites;
+  std::vector<Index> m_linear_site_index;
+};
+
+/// \brief Iterates over included events, dereferencing to
+///     `std::pair<EventID, EventData const &>`
+class EventDataList::const_iterator {
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef std::pair<EventID, EventData const &> value_type;
+  typedef value_type reference;
+  typedef std::ptrdiff_t difference_type;
+
+  const_iterator(EventDataList const *_list, Index _linear_index)
+      : m_list(_list), m_linear_index(_linear_index) {
+    _skip_excluded();
+  }
+
+  value_type operator*() const {
+    return value_type(m_list->event_id(m_linear_index),
+                      (*m_list)[m_linear_index]);
+  }
+
+  const_iterator &operator++() {
+    ++m_linear_index;
+    _skip_excluded();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  bool operator==(const_iterator const &other) const {
+    return m_linear_index == other.m_linear_index;
+  }
+
+  bool operator!=(const_iterator const &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  void _skip_excluded() {
+    while (m_linear_index < m_list->n_slots() &&
+           !m_list->is_included(m_linear_index)) {
+      ++m_linear_index;
+    }
+  }
+
+  EventDataList const *m_list;
+  Index m_linear_index;
+};
+
+/// \brief Specifies how the impact table of a CompleteEventList is stored
+enum class ImpactTableType {
+  /// std::map<EventID, std::vector<EventID>>, as required by
+  /// lotto::RejectionFreeEventSelector
+  map,
+  /// RelativeEventImpactTable
+  relative,
+  /// SupercellEventImpactTable
+  supercell,
+  /// CsrEventImpactTable
+  csr
+};
+
 struct CompleteEventList {
+  /// \brief Which impact table is constructed
+  ImpactTableType impact_table_type = ImpactTableType::map;
+
+  /// \brief Impact table, if `impact_table_type == ImpactTableType::map`
   std::map<EventID, std::vector<EventID>> impact_table;
 
-  std::map<EventID, EventData> events;
+  /// \brief Impact table, if `impact_table_type == ImpactTableType::relative`
+  std::shared_ptr<RelativeEventImpactTable> relative_impact_table;
+
+  /// \brief Impact table, if `impact_table_type == ImpactTableType::supercell`
+  std::shared_ptr<SupercellEventImpactTable> supercell_impact_table;
+
+  /// \brief Impact table, if `impact_table_type == ImpactTableType::csr`
+  std::shared_ptr<CsrEventImpactTable> csr_impact_table;
+
+  EventDataList events;
+};
+
+/// \brief Parameters controlling how a CompleteEventList is stored
+struct CompleteEventListParams {
+  /// \brief If true, store event sites in the structure-of-arrays layout
+  ///     of EventDataList, which is then used for rate calculations, and
+  ///     construct EventData on demand from the stored sites (regardless of
+  ///     `store_event_data`)
+  bool store_site_arrays = false;
+
+  /// \brief If true, store EventData (including a translated
+  ///     monte::OccEvent) for every event. If false, only EventID are
+  ///     enumerated and EventData is constructed on demand. Ignored if
+  ///     `store_site_arrays` is true.
+  bool store_event_data = true;
+
+  /// \brief Which impact table to construct. Only `ImpactTableType::map` can
+  ///     be used with lotto::RejectionFreeEventSelector, all types can be
+  ///     used with the other event selectors (see `EventSelectorType`).
+  ImpactTableType impact_table_type = ImpactTableType::map;
+
+  /// \brief If true, do not include events which can never be allowed
+  ///     because an initial occupant species is not present anywhere in the
+  ///     supercell. This assumes the number of each species is conserved, as
+  ///     in KMC (see `find_possible_prim_events`).
+  bool skip_impossible_events = false;
+
+  /// \brief If set, and `impact_table_type == ImpactTableType::csr`, the
+  ///     impact table is stored in a file in this directory that is
+  ///     memory-mapped read-only and shared by all processes using the same
+  ///     directory (see `make_shared_csr_event_impact_table`)
+  std::optional<fs::path> shared_impact_table_dir;
+
+  /// \brief Number of threads used to construct the event list and impact
+  ///     table. Each thread handles a contiguous range of unit cells, and
+  ///     the result does not depend on the number of threads.
+  Index n_threads = 1;
 };
 
 struct EventFilterGroup {
@@ -31,15 +365,214 @@ struct EventFilterGroup {
   std::set<Index> prim_event_index;
 };
 
+/// \brief Precomputed lookup of which events are included by event filters
+///
+/// Each unit cell is assigned the first EventFilterGroup that lists it, as
+/// in `make_complete_event_list`, and whether each prim event is included
+/// is tabulated once per group, so that `is_included` is constant time
+/// rather than a search through the filters and their sets. Unit cell
+/// indices outside the supercell are ignored.
+class EventFilterIndex {
+ public:
+  EventFilterIndex(std::vector<EventFilterGroup> const &event_filters,
+                   Index _n_unitcells, Index _n_prim_events);
+
+  /// \brief True if the event is included by the filters
+  bool is_included(Index unitcell_index, Index prim_event_index) const {
+    return m_is_included[m_group[unitcell_index] * m_n_prim_events +
+                         prim_event_index];
+  }
+
+  /// \brief True if the prim event is excluded in every unit cell
+  bool is_excluded_everywhere(Index prim_event_index) const {
+    return m_is_excluded_everywhere[prim_event_index];
+  }
+
+ private:
+  Index m_n_prim_events;
+
+  /// Row of m_is_included used by each unit cell; row 0 includes all events
+  /// and is used by unit cells without a filter
+  std::vector<Index> m_group;
+
+  /// Whether each prim event is included, one row per filter group
+  std::vector<char> m_is_included;
+
+  std::vector<char> m_is_excluded_everywhere;
+};
+
 CompleteEventList make_complete_event_list(
     std::vector<PrimEventData> const &prim_event_list,
     std::vector<EventImpactInfo> const &prim_impact_info_list,
     monte::OccLocation const &occ_location,
-    std::vector<EventFilterGroup> const &event_filters = {});
+    std::vector<EventFilterGroup> const &event_filters = {},
+    CompleteEventListParams const &params = {});
 
 std::vector<EventID> make_complete_event_id_list(
     Index n_unitcells, std::vector<PrimEventData> const &prim_event_list);
 
+std::vector<EventID> make_included_event_id_list(
+    EventDataList const &event_list);
+
+std::vector<bool> find_possible_prim_events(
+    std::vector<PrimEventData> const &prim_event_list,
+    monte::OccLocation const &occ_location);
+
+std::size_t approximate_memory_usage(CompleteEventList const &event_list);
+
+std::size_t approximate_events_memory_usage(
+    CompleteEventList const &event_list);
+
+std::size_t approximate_impact_table_memory_usage(
+    CompleteEventList const &event_list);
+
+// -- Inline definitions --
+
+inline EventDataList::const_iterator EventDataList::begin() const {
+  return const_iterator(this, 0);
+}
+
+inline EventDataList::const_iterator EventDataList::end() const {
+  return const_iterator(this, n_slots());
+}
+
+inline EventDataList::EventDataList()
+    : m_n_unitcells(0), m_n_prim_events(0), m_size(0), m_site_stride(0) {}
+
+inline EventDataList::EventDataList(Index _n_unitcells, Index _n_prim_events)
+    : m_n_unitcells(_n_unitcells),
+      m_n_prim_events(_n_prim_events),
+      m_size(0),
+      m_data(_n_unitcells * _n_prim_events),
+      m_is_included(_n_unitcells * _n_prim_events, false),
+      m_site_stride(0) {}
+
+inline EventDataList::EventDataList(Index _n_unitcells, Index _n_prim_events,
+                                    std::shared_ptr<EventDataBuilder> _builder)
+    : m_n_unitcells(_n_unitcells),
+      m_n_prim_events(_n_prim_events),
+      m_size(0),
+      m_is_included(_n_unitcells * _n_prim_events, false),
+      m_builder(_builder),
+      m_site_stride(0) {}
+
+inline EventID EventDataList::event_id(Index linear_index) const {
+  return make_event_id(linear_index, m_n_prim_events);
+}
+
+inline Index EventDataList::find(EventID const &id) const {
+  if (id.prim_event_index < 0 || id.prim_event_index >= m_n_prim_events ||
+      id.unitcell_index < 0 || id.unitcell_index >= m_n_unitcells) {
+    return -1;
+  }
+  Index i = linear_index(id);
+  if (!m_is_included[i]) {
+    return -1;
+  }
+  return i;
+}
+
+inline Index EventDataList::count(EventID const &id) const {
+  return find(id) == -1 ? 0 : 1;
+}
+
+inline EventData const &EventDataList::at(EventID const &id) const {
+  Index i = find(id);
+  if (i == -1) {
+    throw std::out_of_range(
+        "Error in EventDataList::at: event is out of range or not included");
+  }
+  return (*this)[i];
+}
+
+/// \brief Linear site indices of an included event
+///
+/// \param id The event
+/// \param scratch Used to hold the result if the event sites are
+///     constructed on demand, and not stored in structure-of-arrays layout
+///
+/// \returns A view of the event's linear site indices, which refers to the
+///     site arrays, `scratch`, or the stored EventData
+inline EventSites EventDataList::event_sites(
+    EventID const &id, std::vector<Index> &scratch) const {
+  Index i = find(id);
+  if (i == -1) {
+    throw std::out_of_range(
+        "Error in EventDataList::event_sites: event is out of range or not "
+        "included");
+  }
+  if (has_site_arrays()) {
+    return EventSites(linear_site_index(i), n_sites(id.prim_event_index));
+  }
+  if (m_builder) {
+    m_builder->set_linear_site_index(scratch, id);
+    return scratch;
+  }
+  return m_data[i].event.linear_site_index;
+}
+
+inline EventData const &EventDataList::_build(Index linear_index) const {
+  if (has_site_arrays()) {
+    return (*m_builder)(event_id(linear_index),
+                        linear_site_index(linear_index));
+  }
+  return (*m_builder)(event_id(linear_index));
+}
+
+/// \brief Allocate structure-of-arrays storage for event sites
+///
+/// \param n_sites_by_prim_event Number of sites for each prim event. The
+///     site stride is set to the maximum, unused entries are set to -1.
+inline void EventDataList::init_site_arrays(
+    std::vector<Index> const &n_sites_by_prim_event) {
+  if (n_sites_by_prim_event.size() != m_n_prim_events) {
+    throw std::runtime_error(
+        "Error in EventDataList::init_site_arrays: n_sites_by_prim_event "
+        "size mismatch");
+  }
+  m_n_sites = n_sites_by_prim_event;
+  m_site_stride = 0;
+  for (Index n : m_n_sites) {
+    if (n > m_site_stride) {
+      m_site_stride = n;
+    }
+  }
+  m_linear_site_index.assign(n_slots() * m_site_stride, -1);
+}
+
+inline bool EventDataList::emplace(EventID const &id, EventData const &data) {
+  if (id.prim_event_index < 0 || id.prim_event_index >= m_n_prim_events ||
+      id.unitcell_index < 0 || id.unitcell_index >= m_n_unitcells) {
+    throw std::out_of_range(
+        "Error in EventDataList::emplace: event is out of range");
+  }
+  Index i = linear_index(id);
+  if (m_is_included[i]) {
+    return false;
+  }
+  if (!m_builder) {
+    m_data[i] = data;
+  }
+  m_is_included[i] = true;
+  ++m_size;
+  return true;
+}
+
+inline bool EventDataList::include(EventID const &id) {
+  if (id.prim_event_index < 0 || id.prim_event_index >= m_n_prim_events ||
+      id.unitcell_index < 0 || id.unitcell_index >= m_n_unitcells) {
+    throw std::out_of_range(
+        "Error in EventDataList::include: event is out of range");
+  }
+  Index i = linear_index(id);
+  if (m_is_included[i]) {
+    return false;
+  }
+  m_is_included[i] = true;
+  ++m_size;
+  return true;
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
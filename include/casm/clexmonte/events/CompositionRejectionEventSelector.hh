@@ -0,0 +1,300 @@
+#ifndef CASM_clexmonte_events_CompositionRejectionEventSelector
+#define CASM_clexmonte_events_CompositionRejectionEventSelector
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/misc/CompensatedSum.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection-free event selector using composition-rejection
+///
+/// Events are binned into groups by rate, with group `g` holding events
+/// with rate in `[2^(g-1), 2^g)`. An event is selected by first choosing a
+/// group in proportion to the sum of its rates, by a linear search over the
+/// non-empty groups, and then choosing an event in the group uniformly at
+/// random and accepting it with probability `rate / 2^g`, which is at least
+/// 1/2. Updating one rate is O(1), and selecting an event is O(number of
+/// non-empty groups), which is small even when rates span many orders of
+/// magnitude.
+///
+/// The selection protocol and constructor are the same as
+/// SumTreeEventSelector, so CompositionRejectionEventSelector may be used
+/// with monte::kinetic_monte_carlo.
+///
+/// Group sums are updated incrementally, as CompensatedSum, and the sum of
+/// one group is re-summed from its members' rates only when its round-off
+/// error bound exceeds a relative tolerance, so no periodic re-summation of
+/// all groups is needed.
+///
+/// \tparam EventCalculatorType Must implement `double calculate_rate(EventID
+///     const &)`, `void calculate_rates(std::vector<EventID> const &,
+///     std::vector<double> &)`, and `void set_occurred_event(EventID const
+///     &)`
+/// \tparam TableType Impact table type, for which
+///     `impacted_events(TableType const &, EventID const &)` is defined
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename TableType,
+          typename EngineType>
+class CompositionRejectionEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _n_prim_events Number of prim events
+  /// \param _event_id_list Events which may be selected. Events not in this
+  ///     list are skipped if they appear in the impact table.
+  /// \param _impact_table The impact table, which must outlive the selector
+  /// \param _engine Random number engine
+  CompositionRejectionEventSelector(
+      std::shared_ptr<EventCalculatorType> _event_calculator,
+      Index _n_unitcells, Index _n_prim_events,
+      std::vector<EventID> const &_event_id_list,
+      TableType const &_impact_table, std::shared_ptr<EngineType> _engine)
+      : m_event_calculator(_event_calculator),
+        m_n_prim_events(_n_prim_events),
+        m_impact_table(&_impact_table),
+        m_random_number_generator(_engine),
+        m_has_selected_event(false) {
+    Index n_total = _n_unitcells * m_n_prim_events;
+    m_rate.assign(n_total, 0.0);
+    m_group_index.assign(n_total, -1);
+    m_position.assign(n_total, -1);
+    m_is_selectable.assign(n_total, false);
+    m_groups.resize(max_exponent - min_exponent + 1);
+    m_active_position.assign(m_groups.size(), -1);
+    for (EventID const &event_id : _event_id_list) {
+      Index i = linear_index(event_id, m_n_prim_events);
+      m_is_selectable[i] = true;
+      _set_rate(i, m_event_calculator->calculate_rate(event_id));
+    }
+  }
+
+  /// \brief Update rates impacted by the last selected event, then select
+  ///     an event
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    if (m_has_selected_event) {
+      collect_impacted_events(*m_impact_table, m_selected_event_id,
+                              m_n_prim_events, m_is_selectable,
+                              m_batch_linear_index, m_batch_event_id);
+      m_event_calculator->set_occurred_event(m_selected_event_id);
+      m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+      for (Index k = 0; k < m_batch_linear_index.size(); ++k) {
+        _set_rate(m_batch_linear_index[k], m_batch_rate[k]);
+      }
+    }
+
+    double total = total_rate();
+    if (!(total > 0.0)) {
+      std::stringstream msg;
+      msg << "Error in CompositionRejectionEventSelector::select_event: total "
+             "rate is "
+          << total;
+      throw std::runtime_error(msg.str());
+    }
+
+    // choose a group in proportion to its rate sum
+    double r = m_random_number_generator.random_real(total);
+    Index g = m_active.back();
+    for (Index candidate : m_active) {
+      double sum = m_groups[candidate].sum.value();
+      if (r < sum) {
+        g = candidate;
+        break;
+      }
+      r -= sum;
+    }
+
+    // choose an event in the group, by rejection
+    Group const &group = m_groups[g];
+    double upper = std::ldexp(1.0, g + min_exponent);
+    Index n_members = group.members.size();
+    Index i;
+    while (true) {
+      Index k = m_random_number_generator.random_real(n_members);
+      i = group.members[k < n_members ? k : n_members - 1];
+      if (m_random_number_generator.random_real(upper) < m_rate[i]) {
+        break;
+      }
+    }
+    m_selected_event_id = make_event_id(i, m_n_prim_events);
+    m_has_selected_event = true;
+
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    return std::make_pair(m_selected_event_id, -std::log(u) / total);
+  }
+
+  /// \brief Total rate of all selectable events
+  double total_rate() const {
+    double total = 0.0;
+    for (Index g : m_active) {
+      total += m_groups[g].sum.value();
+    }
+    return total;
+  }
+
+  /// \brief Sum of the round-off error bounds of the group sums
+  double error_bound() const {
+    double bound = 0.0;
+    for (Index g : m_active) {
+      bound += m_groups[g].sum.error_bound();
+    }
+    return bound;
+  }
+
+  /// \brief Current rate of an event
+  double rate(EventID const &event_id) const {
+    return m_rate[linear_index(event_id, m_n_prim_events)];
+  }
+
+  /// \brief Number of groups with at least one event with non-zero rate
+  Index n_active_groups() const { return m_active.size(); }
+
+ private:
+  /// Exponents, as given by std::frexp, of the smallest and largest
+  /// positive doubles
+  static constexpr int min_exponent =
+      std::numeric_limits<double>::min_exponent -
+      std::numeric_limits<double>::digits + 1;
+  static constexpr int max_exponent =
+      std::numeric_limits<double>::max_exponent;
+
+  struct Group {
+    /// Linear indices of events in the group
+    std::vector<Index> members;
+
+    /// Sum of rates of events in the group
+    CompensatedSum sum;
+  };
+
+  /// \brief Set the rate of event with linear index `i`, moving it between
+  ///     groups as necessary
+  void _set_rate(Index i, double new_rate) {
+    Index new_group = -1;
+    if (new_rate > 0.0) {
+      int exponent;
+      std::frexp(new_rate, &exponent);
+      new_group = exponent - min_exponent;
+    }
+    Index old_group = m_group_index[i];
+    if (old_group == new_group) {
+      if (new_group != -1) {
+        CompensatedSum &sum = m_groups[new_group].sum;
+        sum.add(new_rate);
+        sum.add(-m_rate[i]);
+        m_rate[i] = new_rate;
+        if (sum.needs_refresh()) {
+          _resum(new_group);
+        }
+      } else {
+        m_rate[i] = new_rate;
+      }
+      return;
+    }
+    if (old_group != -1) {
+      _remove(i, old_group);
+    }
+    m_rate[i] = new_rate;
+    if (new_group != -1) {
+      _insert(i, new_group);
+    }
+  }
+
+  void _insert(Index i, Index g) {
+    Group &group = m_groups[g];
+    if (group.members.empty()) {
+      m_active_position[g] = m_active.size();
+      m_active.push_back(g);
+      group.sum.reset();
+    }
+    m_group_index[i] = g;
+    m_position[i] = group.members.size();
+    group.members.push_back(i);
+    group.sum.add(m_rate[i]);
+  }
+
+  void _remove(Index i, Index g) {
+    Group &group = m_groups[g];
+    Index last = group.members.back();
+    group.members[m_position[i]] = last;
+    m_position[last] = m_position[i];
+    group.members.pop_back();
+    group.sum.add(-m_rate[i]);
+    m_group_index[i] = -1;
+    m_position[i] = -1;
+    if (group.members.empty()) {
+      group.sum.reset();
+      Index last_active = m_active.back();
+      m_active[m_active_position[g]] = last_active;
+      m_active_position[last_active] = m_active_position[g];
+      m_active.pop_back();
+      m_active_position[g] = -1;
+    } else if (group.sum.needs_refresh()) {
+      _resum(g);
+    }
+  }
+
+  /// \brief Re-calculate the sum of group `g` from its members' rates
+  ///
+  /// Rates in a group are within a factor of 2 of each other, so the
+  /// re-calculated sum is accurate, and this is O(group size).
+  void _resum(Index g) {
+    Group &group = m_groups[g];
+    group.sum.reset();
+    for (Index i : group.members) {
+      group.sum.add(m_rate[i]);
+    }
+  }
+
+  std::shared_ptr<EventCalculatorType> m_event_calculator;
+  Index m_n_prim_events;
+  TableType const *m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// Rate of event with a given linear index
+  std::vector<double> m_rate;
+
+  /// Group of event with a given linear index, or -1 if rate is zero
+  std::vector<Index> m_group_index;
+
+  /// Position of event with a given linear index in its group's members
+  std::vector<Index> m_position;
+
+  /// Whether the event with a given linear index may be selected
+  std::vector<bool> m_is_selectable;
+
+  /// Groups, indexed by `exponent - min_exponent`
+  std::vector<Group> m_groups;
+
+  /// Indices of non-empty groups
+  std::vector<Index> m_active;
+
+  /// Position of a group in m_active, or -1 if empty
+  std::vector<Index> m_active_position;
+
+  bool m_has_selected_event;
+  EventID m_selected_event_id;
+
+  // scratch space for batch updates
+  std::vector<Index> m_batch_linear_index;
+  std::vector<EventID> m_batch_event_id;
+  std::vector<double> m_batch_rate;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
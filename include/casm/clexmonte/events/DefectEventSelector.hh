@@ -0,0 +1,497 @@
+#ifndef CASM_clexmonte_events_DefectEventSelector
+#define CASM_clexmonte_events_DefectEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection-free event selector which only tracks events adjacent
+///     to defects
+///
+/// In dilute systems, such as vacancy-mediated diffusion with a few
+/// vacancies, the only events that can be allowed are those that include a
+/// defect site. DefectEventSelector keeps a list of the sites occupied by a
+/// "defect" species (i.e. "Va"), which is initialized from
+/// monte::OccLocation, and for each defect a block of the events for which
+/// it is the "owner". The owner of an event is the site of the first
+/// position in the prim event whose initial occupant is a defect species, so
+/// each event belongs to at most one block. A binary sum tree over defects,
+/// with leaves equal to the total rate of each block, is used to select a
+/// defect, and then an event in its block is selected by a linear search.
+///
+/// After an event occurs, defects that moved onto or off of the event's
+/// sites have their blocks recalculated, and events of other defects which
+/// are impacted by the event (according to the relative impact table) are
+/// recalculated. Event sites and translations are calculated from the
+/// prim events on demand, so memory use and the cost per event depend on
+/// the number of defects and prim events, not on the supercell size.
+///
+/// Requirements:
+/// - Every prim event must have a defect species in its initial occupation
+/// - The event calculator must calculate the rate of any event from its
+///   EventID, without a complete event list (i.e.
+///   kinetic::OnDemandEventCalculator), and return 0.0 for events that are
+///   not allowed
+///
+/// The selection protocol is the same as SumTreeEventSelector, so
+/// DefectEventSelector may be used with monte::kinetic_monte_carlo.
+///
+/// \tparam EventCalculatorType Must implement `void calculate_rates(
+///     std::vector<EventID> const &, std::vector<double> &)` and `void
+///     set_occurred_event(EventID const &)`
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename EngineType>
+class DefectEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _prim_event_list The prim events, which must outlive the selector
+  /// \param _prim_impact_info_list Impact information for each prim event
+  /// \param _is_defect_species Whether each species, by
+  ///     monte::Conversions species index, is a defect
+  /// \param _occ_location Occupant location tracker, which must outlive the
+  ///     selector and be kept up-to-date as events occur
+  /// \param _engine Random number engine
+  DefectEventSelector(
+      std::shared_ptr<EventCalculatorType> _event_calculator,
+      std::vector<PrimEventData> const &_prim_event_list,
+      std::vector<EventImpactInfo> const &_prim_impact_info_list,
+      std::vector<bool> const &_is_defect_species,
+      monte::OccLocation const &_occ_location,
+      std::shared_ptr<EngineType> _engine)
+      : m_event_calculator(_event_calculator),
+        m_prim_event_list(&_prim_event_list),
+        m_is_defect_species(_is_defect_species),
+        m_occ_location(&_occ_location),
+        m_impact_table(make_relative_impact_table(_prim_impact_info_list)),
+        m_random_number_generator(_engine),
+        m_max_block_size(0),
+        m_capacity(1),
+        m_tree(2, 0.0),
+        m_has_selected_event(false) {
+    monte::Conversions const &convert = m_occ_location->convert();
+
+    // find the owner position of each prim event, and group prim events by
+    // the (sublattice, occupant index) of their owner
+    std::map<std::pair<Index, Index>, Index> key_index;
+    Index n_prim_events = m_prim_event_list->size();
+    m_owner_position.resize(n_prim_events);
+    m_owner_key.resize(n_prim_events);
+    m_owner_block_index.resize(n_prim_events);
+    for (Index p = 0; p < n_prim_events; ++p) {
+      PrimEventData const &prim_event_data = (*m_prim_event_list)[p];
+      Index i = 0;
+      for (; i < prim_event_data.sites.size(); ++i) {
+        Index b = prim_event_data.sites[i].sublattice();
+        Index species_index = convert.species_index(
+            convert.b_to_asym(b), prim_event_data.occ_init[i]);
+        if (m_is_defect_species[species_index]) {
+          break;
+        }
+      }
+      if (i == prim_event_data.sites.size()) {
+        std::stringstream msg;
+        msg << "Error constructing DefectEventSelector: prim event " << p
+            << " (" << prim_event_data.event_type_name
+            << ") does not include a defect species";
+        throw std::runtime_error(msg.str());
+      }
+      std::pair<Index, Index> key(prim_event_data.sites[i].sublattice(),
+                                  prim_event_data.occ_init[i]);
+      auto it = key_index.find(key);
+      if (it == key_index.end()) {
+        it = key_index.emplace(key, m_block_events.size()).first;
+        m_keys.push_back(key);
+        m_block_events.emplace_back();
+      }
+      m_owner_position[p] = i;
+      m_owner_key[p] = it->second;
+      m_owner_block_index[p] = m_block_events[it->second].size();
+      m_block_events[it->second].push_back(p);
+    }
+    for (auto const &block_events : m_block_events) {
+      if (block_events.size() > m_max_block_size) {
+        m_max_block_size = block_events.size();
+      }
+    }
+
+    // add the current defects
+    for (auto const &cand : m_occ_location->candidate_list()) {
+      if (!m_is_defect_species[cand.species_index]) {
+        continue;
+      }
+      for (Index loc = 0; loc < m_occ_location->cand_size(cand); ++loc) {
+        Index l = m_occ_location->mol(m_occ_location->mol_id(cand, loc)).l;
+        m_moved_slots.push_back(_add_defect(l));
+      }
+    }
+    _recalculate_blocks();
+  }
+
+  /// \brief Update rates impacted by the last selected event, then select
+  ///     an event
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    if (m_has_selected_event) {
+      _update(m_selected_event_id);
+    }
+
+    double total = total_rate();
+    if (!(total > 0.0)) {
+      std::stringstream msg;
+      msg << "Error in DefectEventSelector::select_event: total rate is "
+          << total;
+      throw std::runtime_error(msg.str());
+    }
+
+    // descend the tree to choose a defect
+    double r = m_random_number_generator.random_real(total);
+    if (r > m_tree[1]) {
+      r = m_tree[1];
+    }
+    Index i = 1;
+    while (i < m_capacity) {
+      Index left = 2 * i;
+      if (r < m_tree[left] || !(m_tree[left + 1] > 0.0)) {
+        i = left;
+      } else {
+        r -= m_tree[left];
+        i = left + 1;
+      }
+    }
+    Index slot = i - m_capacity;
+
+    // choose an event in the defect's block
+    double const *rate = m_rate.data() + slot * m_max_block_size;
+    Index n_events = m_block_events[m_slot_key[slot]].size();
+    Index k = 0;
+    Index last_allowed = 0;
+    for (; k < n_events; ++k) {
+      if (rate[k] > 0.0) {
+        if (r < rate[k]) {
+          break;
+        }
+        r -= rate[k];
+        last_allowed = k;
+      }
+    }
+    if (k == n_events) {
+      k = last_allowed;
+    }
+    m_selected_event_id = _event_id(slot, k);
+    m_has_selected_event = true;
+
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    return std::make_pair(m_selected_event_id, -std::log(u) / total);
+  }
+
+  /// \brief Total rate of all events
+  double total_rate() const { return m_tree[1]; }
+
+  /// \brief Number of defects
+  Index n_defects() const { return m_site_to_slot.size(); }
+
+  /// \brief Current rate of an event, or 0.0 if it is not owned by a defect
+  double rate(EventID const &event_id) const {
+    Index p = event_id.prim_event_index;
+    auto it = m_site_to_slot.find(_owner_site(event_id));
+    if (it == m_site_to_slot.end() ||
+        m_slot_key[it->second] != m_owner_key[p]) {
+      return 0.0;
+    }
+    return m_rate[it->second * m_max_block_size + m_owner_block_index[p]];
+  }
+
+ private:
+  /// \brief Linear site index of the owner position of an event
+  Index _owner_site(EventID const &event_id) const {
+    monte::Conversions const &convert = m_occ_location->convert();
+    PrimEventData const &prim_event_data =
+        (*m_prim_event_list)[event_id.prim_event_index];
+    xtal::UnitCell translation =
+        convert.unitcell_index_converter()(event_id.unitcell_index);
+    return convert.index_converter()(
+        prim_event_data.sites[m_owner_position[event_id.prim_event_index]] +
+        translation);
+  }
+
+  /// \brief EventID of the k-th event in the block of a defect
+  EventID _event_id(Index slot, Index k) const {
+    monte::Conversions const &convert = m_occ_location->convert();
+    Index p = m_block_events[m_slot_key[slot]][k];
+    PrimEventData const &prim_event_data = (*m_prim_event_list)[p];
+    xtal::UnitCell translation =
+        convert.l_to_bijk(m_slot_site[slot]).unitcell() -
+        prim_event_data.sites[m_owner_position[p]].unitcell();
+    return EventID{p, convert.unitcell_index_converter()(translation)};
+  }
+
+  /// \brief Linear site indices of an event
+  void _event_sites(EventID const &event_id, std::vector<Index> &sites) const {
+    monte::Conversions const &convert = m_occ_location->convert();
+    PrimEventData const &prim_event_data =
+        (*m_prim_event_list)[event_id.prim_event_index];
+    xtal::UnitCell translation =
+        convert.unitcell_index_converter()(event_id.unitcell_index);
+    sites.resize(prim_event_data.sites.size());
+    for (Index i = 0; i < sites.size(); ++i) {
+      sites[i] = convert.index_converter()(prim_event_data.sites[i] +
+                                           translation);
+    }
+  }
+
+  /// \brief True if site `l` is currently occupied by a defect species
+  bool _is_defect(Index l) const {
+    Index mol_id = m_occ_location->l_to_mol_id(l);
+    if (mol_id < 0 || mol_id >= m_occ_location->mol_size()) {
+      return false;
+    }
+    return m_is_defect_species[m_occ_location->mol(mol_id).species_index];
+  }
+
+  /// \brief Block key of the defect at site `l`, or -1 if it owns no events
+  Index _key(Index l) const {
+    monte::Conversions const &convert = m_occ_location->convert();
+    Index mol_id = m_occ_location->l_to_mol_id(l);
+    std::pair<Index, Index> key(
+        convert.l_to_b(l),
+        convert.occ_index(convert.l_to_asym(l),
+                          m_occ_location->mol(mol_id).species_index));
+    for (Index i = 0; i < m_keys.size(); ++i) {
+      if (m_keys[i] == key) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /// \brief Add a defect at site `l`, returning its slot
+  Index _add_defect(Index l) {
+    Index slot;
+    if (!m_free_slots.empty()) {
+      slot = m_free_slots.back();
+      m_free_slots.pop_back();
+    } else {
+      slot = m_slot_site.size();
+      m_slot_site.push_back(-1);
+      m_slot_key.push_back(-1);
+      m_rate.resize(m_rate.size() + m_max_block_size, 0.0);
+      if (slot >= m_capacity) {
+        _grow();
+      }
+    }
+    _set_defect(slot, l);
+    return slot;
+  }
+
+  /// \brief Set the site of a defect, its block must then be recalculated
+  void _set_defect(Index slot, Index l) {
+    m_slot_site[slot] = l;
+    m_slot_key[slot] = _key(l);
+    m_site_to_slot[l] = slot;
+  }
+
+  /// \brief Remove a defect, and set the rates of its block to zero
+  void _remove_defect(Index slot) {
+    m_slot_site[slot] = -1;
+    m_slot_key[slot] = -1;
+    std::fill(m_rate.begin() + slot * m_max_block_size,
+              m_rate.begin() + (slot + 1) * m_max_block_size, 0.0);
+    _set_leaf(slot);
+    m_free_slots.push_back(slot);
+  }
+
+  /// \brief Double the tree capacity
+  void _grow() {
+    std::vector<double> leaves(m_tree.begin() + m_capacity, m_tree.end());
+    m_capacity *= 2;
+    m_tree.assign(2 * m_capacity, 0.0);
+    std::copy(leaves.begin(), leaves.end(), m_tree.begin() + m_capacity);
+    for (Index i = m_capacity - 1; i > 0; --i) {
+      m_tree[i] = m_tree[2 * i] + m_tree[2 * i + 1];
+    }
+  }
+
+  /// \brief Set a leaf to the total rate of a block and update its ancestors
+  void _set_leaf(Index slot) {
+    double sum = 0.0;
+    double const *rate = m_rate.data() + slot * m_max_block_size;
+    for (Index k = 0; k < m_max_block_size; ++k) {
+      sum += rate[k];
+    }
+    Index i = m_capacity + slot;
+    m_tree[i] = sum;
+    for (i /= 2; i > 0; i /= 2) {
+      m_tree[i] = m_tree[2 * i] + m_tree[2 * i + 1];
+    }
+  }
+
+  /// \brief Update defects and rates after an event occurred
+  void _update(EventID const &event_id) {
+    m_event_calculator->set_occurred_event(event_id);
+
+    // defects that moved onto or off of the event sites
+    _event_sites(event_id, m_sites);
+    m_removed_slots.clear();
+    m_added_sites.clear();
+    for (Index l : m_sites) {
+      auto it = m_site_to_slot.find(l);
+      bool was_defect = (it != m_site_to_slot.end());
+      bool is_defect = _is_defect(l);
+      if (was_defect && !is_defect) {
+        m_removed_slots.push_back(it->second);
+        m_site_to_slot.erase(it);
+      } else if (!was_defect && is_defect) {
+        m_added_sites.push_back(l);
+      } else if (was_defect && is_defect) {
+        // the defect species may have changed
+        _set_defect(it->second, l);
+        m_moved_slots.push_back(it->second);
+      }
+    }
+    for (Index j = 0; j < m_added_sites.size(); ++j) {
+      if (j < m_removed_slots.size()) {
+        _set_defect(m_removed_slots[j], m_added_sites[j]);
+        m_moved_slots.push_back(m_removed_slots[j]);
+      } else {
+        m_moved_slots.push_back(_add_defect(m_added_sites[j]));
+      }
+    }
+    for (Index j = m_added_sites.size(); j < m_removed_slots.size(); ++j) {
+      _remove_defect(m_removed_slots[j]);
+    }
+
+    // impacted events of other defects
+    monte::Conversions const &convert = m_occ_location->convert();
+    auto const &unitcell_converter = convert.unitcell_index_converter();
+    xtal::UnitCell translation = unitcell_converter(event_id.unitcell_index);
+    for (RelativeEventID const &relative :
+         m_impact_table[event_id.prim_event_index]) {
+      EventID impacted{relative.prim_event_index,
+                       unitcell_converter(translation + relative.translation)};
+      auto it = m_site_to_slot.find(_owner_site(impacted));
+      if (it == m_site_to_slot.end() ||
+          m_slot_key[it->second] != m_owner_key[impacted.prim_event_index]) {
+        continue;
+      }
+      m_batch_position.push_back(
+          it->second * m_max_block_size +
+          m_owner_block_index[impacted.prim_event_index]);
+      m_batch_event_id.push_back(impacted);
+      m_changed_slots.push_back(it->second);
+    }
+    _recalculate_blocks();
+  }
+
+  /// \brief Recalculate all events of the defects in `m_moved_slots`, and
+  ///     the events already in the batch, then update the tree
+  void _recalculate_blocks() {
+    for (Index slot : m_moved_slots) {
+      m_changed_slots.push_back(slot);
+      std::fill(m_rate.begin() + slot * m_max_block_size,
+                m_rate.begin() + (slot + 1) * m_max_block_size, 0.0);
+      if (m_slot_key[slot] == -1) {
+        continue;
+      }
+      Index n_events = m_block_events[m_slot_key[slot]].size();
+      for (Index k = 0; k < n_events; ++k) {
+        m_batch_position.push_back(slot * m_max_block_size + k);
+        m_batch_event_id.push_back(_event_id(slot, k));
+      }
+    }
+    m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+    for (Index k = 0; k < m_batch_position.size(); ++k) {
+      m_rate[m_batch_position[k]] = m_batch_rate[k];
+    }
+    for (Index slot : m_changed_slots) {
+      _set_leaf(slot);
+    }
+    m_batch_position.clear();
+    m_batch_event_id.clear();
+    m_moved_slots.clear();
+    m_changed_slots.clear();
+  }
+
+  std::shared_ptr<EventCalculatorType> m_event_calculator;
+  std::vector<PrimEventData> const *m_prim_event_list;
+  std::vector<bool> m_is_defect_species;
+  monte::OccLocation const *m_occ_location;
+  std::vector<std::vector<RelativeEventID>> m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// For each prim event, the position of its owner site
+  std::vector<Index> m_owner_position;
+
+  /// For each prim event, the block key of its owner
+  std::vector<Index> m_owner_key;
+
+  /// For each prim event, its index in `m_block_events[m_owner_key[p]]`
+  std::vector<Index> m_owner_block_index;
+
+  /// (sublattice, occupant index) of each block key
+  std::vector<std::pair<Index, Index>> m_keys;
+
+  /// Prim events owned by a defect, for each block key
+  std::vector<std::vector<Index>> m_block_events;
+
+  /// Maximum number of events owned by one defect
+  Index m_max_block_size;
+
+  /// Site of each defect slot, or -1 if free
+  std::vector<Index> m_slot_site;
+
+  /// Block key of each defect slot, or -1 if free or owning no events
+  std::vector<Index> m_slot_key;
+
+  /// Free defect slots
+  std::vector<Index> m_free_slots;
+
+  /// Defect slot of each site occupied by a defect
+  std::unordered_map<Index, Index> m_site_to_slot;
+
+  /// Event rates, the k-th event of a slot is at
+  /// `slot * m_max_block_size + k`
+  std::vector<double> m_rate;
+
+  /// Number of leaves in the tree (power of 2)
+  Index m_capacity;
+
+  /// Sum tree over defect slots, root at index 1, children of node i at
+  /// 2*i and 2*i+1, and the total rate of slot j at m_capacity + j
+  std::vector<double> m_tree;
+
+  bool m_has_selected_event;
+  EventID m_selected_event_id;
+
+  // scratch space
+  std::vector<Index> m_sites;
+  std::vector<Index> m_moved_slots;
+  std::vector<Index> m_changed_slots;
+  std::vector<Index> m_removed_slots;
+  std::vector<Index> m_added_sites;
+  std::vector<Index> m_batch_position;
+  std::vector<EventID> m_batch_event_id;
+  std::vector<double> m_batch_rate;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef CASM_clexmonte_events_EventJournal
+#define CASM_clexmonte_events_EventJournal
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Writes the selected events and time increments of a KMC run to a
+///     compact binary file
+///
+/// A journal allows a run to be replayed (see ReplayEventSelector) without
+/// calculating any event rates, for example to evaluate sampling functions
+/// that were not used in the original run.
+///
+/// File format:
+/// - A 32 byte header: magic "CLXKMCJ1", format version, number of unit
+///   cells, and number of prim events, as 64-bit integers
+/// - One record per event: the event linear index `unitcell_index *
+///   n_prim_events + prim_event_index` as an unsigned LEB128 varint,
+///   followed by the time increment as a 64-bit double
+///
+/// The varint encoding uses 4 bytes per event index for supercells of up to
+/// 2^28 events, so a record is typically 12 bytes. Records are buffered, and
+/// written when the buffer is full, by `flush`, and on destruction. Time
+/// increments are stored exactly, so a replay reproduces the time of each
+/// event of the original run.
+class EventJournalWriter {
+ public:
+  EventJournalWriter(fs::path const &_path, Index _n_unitcells,
+                     Index _n_prim_events, Index _buffer_bytes = 1 << 20);
+
+  ~EventJournalWriter();
+
+  EventJournalWriter(EventJournalWriter const &) = delete;
+  EventJournalWriter &operator=(EventJournalWriter const &) = delete;
+
+  /// \brief Record an event
+  void record(EventID const &event_id, double time_increment);
+
+  /// \brief Write buffered records to the file
+  void flush();
+
+  /// \brief Number of events recorded
+  Index n_events() const { return m_n_events; }
+
+ private:
+  Index m_n_prim_events;
+  Index m_buffer_bytes;
+  std::ofstream m_out;
+  std::vector<char> m_buffer;
+  Index m_n_events;
+};
+
+/// \brief Reads events written by EventJournalWriter
+class EventJournalReader {
+ public:
+  explicit EventJournalReader(fs::path const &_path,
+                              Index _buffer_bytes = 1 << 20);
+
+  EventJournalReader(EventJournalReader const &) = delete;
+  EventJournalReader &operator=(EventJournalReader const &) = delete;
+
+  /// \brief Number of unit cells of the journal's supercell
+  Index n_unitcells() const { return m_n_unitcells; }
+
+  /// \brief Number of prim events of the journal's system
+  Index n_prim_events() const { return m_n_prim_events; }
+
+  /// \brief Read the next event, returning false if there are no more
+  bool read(EventID &event_id, double &time_increment);
+
+  /// \brief Number of events read
+  Index n_events() const { return m_n_events; }
+
+ private:
+  /// \brief Make at least `n` bytes available in the buffer, if the file
+  ///     has them
+  bool _fill(Index n);
+
+  Index m_n_unitcells;
+  Index m_n_prim_events;
+  Index m_buffer_bytes;
+  std::ifstream m_in;
+  std::vector<char> m_buffer;
+  Index m_begin;
+  Index m_end;
+  Index m_n_events;
+};
+
+/// \brief Wraps an event selector, recording each selected event in an
+///     EventJournalWriter
+///
+/// \tparam SelectorType Event selector type
+template <typename SelectorType>
+class JournalingEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _selector The event selector, which must outlive the
+  ///     JournalingEventSelector
+  /// \param _journal The journal
+  JournalingEventSelector(SelectorType &_selector,
+                          std::shared_ptr<EventJournalWriter> _journal)
+      : m_selector(&_selector), m_journal(std::move(_journal)) {
+    if (!m_journal) {
+      throw std::runtime_error(
+          "Error constructing JournalingEventSelector: journal is empty");
+    }
+  }
+
+  /// \brief Select an event and record it
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    std::pair<EventID, double> result = m_selector->select_event();
+    m_journal->record(result.first, result.second);
+    return result;
+  }
+
+ private:
+  SelectorType *m_selector;
+  std::shared_ptr<EventJournalWriter> m_journal;
+};
+
+/// \brief Event selector that replays the events of an EventJournalReader
+///
+/// No event rates are calculated. Used with `monte::kinetic_monte_carlo`,
+/// starting from the initial state of the journaled run and with the same
+/// completion criteria, the replay applies the same events at the same
+/// times, so sampling functions are evaluated along the same trajectory.
+class ReplayEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _journal The journal
+  /// \param _n_unitcells Number of unit cells, which must match the journal
+  /// \param _n_prim_events Number of prim events, which must match the
+  ///     journal
+  ReplayEventSelector(std::shared_ptr<EventJournalReader> _journal,
+                      Index _n_unitcells, Index _n_prim_events);
+
+  /// \brief Return the next journaled event
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event();
+
+ private:
+  std::shared_ptr<EventJournalReader> m_journal;
+  std::pair<EventID, double> m_result;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef CASM_clexmonte_events_EventSchedule
+#define CASM_clexmonte_events_EventSchedule
+
+#include <functional>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A change of which events are enabled, or of the temperature,
+///     during a kinetic Monte Carlo run
+struct EventScheduleStep {
+  /// \brief Time, since the start of the run, at which the step applies
+  double time = 0.0;
+
+  /// \brief Events which are disabled at `time`
+  std::vector<EventID> disabled_events;
+
+  /// \brief Events which are enabled at `time`, after `disabled_events` are
+  ///     disabled
+  std::vector<EventID> enabled_events;
+
+  /// \brief If set, the temperature from `time`
+  std::optional<double> temperature;
+};
+
+/// \brief Return the EventID of the events in a region
+///
+/// \param unitcell_index Linear unit cell indices of the region
+/// \param prim_event_index Prim event indices of the events. If empty, all
+///     prim events are included.
+/// \param n_prim_events Number of prim events
+inline std::vector<EventID> make_region_event_id_list(
+    std::set<Index> const &unitcell_index,
+    std::set<Index> const &prim_event_index, Index n_prim_events) {
+  std::vector<EventID> event_id_list;
+  for (Index l : unitcell_index) {
+    if (prim_event_index.empty()) {
+      for (Index p = 0; p < n_prim_events; ++p) {
+        event_id_list.push_back(EventID{p, l});
+      }
+    } else {
+      for (Index p : prim_event_index) {
+        event_id_list.push_back(EventID{p, l});
+      }
+    }
+  }
+  return event_id_list;
+}
+
+/// \brief Applies a schedule of EventScheduleStep during a kinetic Monte
+///     Carlo run
+///
+/// Wraps an event selector, such as SumTreeEventSelector, which must
+/// implement `select_event`, `update_rates`, `cancel_selection`,
+/// `set_events_enabled`, `recalculate_rates`, and `total_rate`. Steps
+/// apply in order of increasing time, measured from the construction of
+/// the ScheduledEventSelector.
+///
+/// Rates are piecewise constant between steps. If the event selected with
+/// the current rates would occur after the next step, the selection is
+/// cancelled, time advances to the step, the step is applied, and an event
+/// is selected again with the new rates. Because event waiting times are
+/// memoryless this is exact, and the returned time increment includes the
+/// time advanced. If no event is enabled, time advances to the next step
+/// that changes that.
+///
+/// Enabling or disabling events costs time proportional to the number of
+/// events changed. A temperature change recalculates all rates, reusing
+/// the event calculator's cached event state parts, if any.
+///
+/// \tparam SelectorType Event selector type
+template <typename SelectorType>
+class ScheduledEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _selector The event selector, which must outlive the
+  ///     ScheduledEventSelector
+  /// \param _schedule Steps, in order of non-decreasing time
+  /// \param _set_temperature_f Sets the temperature of the conditions used
+  ///     by the event calculator. Required if any step sets the
+  ///     temperature.
+  ScheduledEventSelector(SelectorType &_selector,
+                         std::vector<EventScheduleStep> _schedule,
+                         std::function<void(double)> _set_temperature_f)
+      : m_selector(&_selector),
+        m_schedule(std::move(_schedule)),
+        m_set_temperature_f(_set_temperature_f),
+        m_next_step(0),
+        m_time(0.0) {
+    for (Index i = 0; i < Index(m_schedule.size()); ++i) {
+      if (i > 0 && m_schedule[i].time < m_schedule[i - 1].time) {
+        throw std::runtime_error(
+            "Error constructing ScheduledEventSelector: schedule is not in "
+            "order of time");
+      }
+      if (m_schedule[i].temperature.has_value() && !m_set_temperature_f) {
+        throw std::runtime_error(
+            "Error constructing ScheduledEventSelector: schedule sets "
+            "temperature, but no function to set it");
+      }
+    }
+  }
+
+  /// \brief Select an event, applying the steps that occur first
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    double time_begin = m_time;
+    while (true) {
+      _apply_due_steps();
+      m_selector->update_rates();
+      bool has_next_step = m_next_step < Index(m_schedule.size());
+      if (!(m_selector->total_rate() > 0.0) && has_next_step) {
+        m_time = m_schedule[m_next_step].time;
+        continue;
+      }
+      std::pair<EventID, double> result = m_selector->select_event();
+      if (has_next_step &&
+          m_time + result.second > m_schedule[m_next_step].time) {
+        m_selector->cancel_selection();
+        m_time = m_schedule[m_next_step].time;
+        continue;
+      }
+      m_time += result.second;
+      result.second = m_time - time_begin;
+      return result;
+    }
+  }
+
+  /// \brief Time since the start of the schedule
+  double time() const { return m_time; }
+
+  /// \brief Number of steps applied
+  Index n_steps_applied() const { return m_next_step; }
+
+ private:
+  /// \brief Apply the steps with time <= m_time
+  void _apply_due_steps() {
+    while (m_next_step < Index(m_schedule.size()) &&
+           m_schedule[m_next_step].time <= m_time) {
+      EventScheduleStep const &step = m_schedule[m_next_step];
+      if (!step.disabled_events.empty()) {
+        m_selector->set_events_enabled(step.disabled_events, false);
+      }
+      if (!step.enabled_events.empty()) {
+        m_selector->set_events_enabled(step.enabled_events, true);
+      }
+      if (step.temperature.has_value()) {
+        m_set_temperature_f(*step.temperature);
+        m_selector->recalculate_rates();
+      }
+      ++m_next_step;
+    }
+  }
+
+  SelectorType *m_selector;
+  std::vector<EventScheduleStep> m_schedule;
+  std::function<void(double)> m_set_temperature_f;
+  Index m_next_step;
+  double m_time;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
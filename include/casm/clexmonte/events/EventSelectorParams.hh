@@ -0,0 +1,102 @@
+#ifndef CASM_clexmonte_events_EventSelectorParams
+#define CASM_clexmonte_events_EventSelectorParams
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Event selector method used by KMC and N-fold way calculations
+enum class EventSelectorType {
+  /// lotto::RejectionFreeEventSelector, which requires
+  /// `ImpactTableType::map`
+  lotto_rejection_free,
+
+  /// SumTreeEventSelector, a flat binary sum tree
+  sum_tree,
+
+  /// GroupedSumTreeEventSelector, one sum tree per prim event
+  grouped_sum_tree,
+
+  /// CompositionRejectionEventSelector, which bins events by rate
+  composition_rejection,
+
+  /// RejectionEventSelector, which does not use the impact table
+  rejection,
+
+  /// DefectEventSelector, which only tracks events adjacent to defects and
+  /// does not use the complete event list (KMC only)
+  defect,
+
+  /// SynchronousSublatticeEventSelector, which selects events in spatial
+  /// domains concurrently (KMC only)
+  synchronous_sublattice
+};
+
+/// \brief Parameters controlling which event selector is used
+struct EventSelectorParams {
+  /// \brief Event selector method
+  EventSelectorType type = EventSelectorType::lotto_rejection_free;
+
+  /// \brief For `EventSelectorType::rejection`, the upper bound on event
+  ///     rates of event types not in `max_rate_by_event_type`. If <= 0.0,
+  ///     `max_rate_factor` times the maximum rate in the initial state of
+  ///     each prim event's events is used.
+  double max_rate = 0.0;
+
+  /// \brief For `EventSelectorType::rejection`, used to estimate upper
+  ///     bounds if `max_rate` <= 0.0
+  double max_rate_factor = 10.0;
+
+  /// \brief For `EventSelectorType::rejection` (KMC only), the upper bound
+  ///     on event rates, by event type name
+  std::map<std::string, double> max_rate_by_event_type;
+
+  /// \brief For `EventSelectorType::defect`, names of the defect species
+  std::vector<std::string> defect_species = {"Va"};
+
+  /// \brief For `EventSelectorType::sum_tree` (KMC only), the number of
+  ///     events between rate updates of impacted events beyond
+  ///     `deferred_update_radius`. If <= 1, all impacted events are updated
+  ///     after each event (exact).
+  Index deferred_update_interval = 1;
+
+  /// \brief For `EventSelectorType::sum_tree` with
+  ///     `deferred_update_interval` > 1, impacted events with a site within
+  ///     this distance of a site of the occurring event are updated after
+  ///     each event
+  double deferred_update_radius = 0.0;
+
+  /// \brief For `EventSelectorType::sum_tree` (KMC only), the number of
+  ///     recurrences of a pair of events between scalings of their rates
+  ///     (see SuperbasinParams). If <= 0, superbasin acceleration is
+  ///     disabled.
+  Index superbasin_n_recurrence = 0;
+
+  /// \brief For `superbasin_n_recurrence` > 0, the factor recurrent event
+  ///     rates are multiplied by
+  double superbasin_scale_factor = 0.5;
+
+  /// \brief For `superbasin_n_recurrence` > 0, the lower bound on the
+  ///     accumulated scale of any event rate
+  double superbasin_min_scale = 1e-6;
+
+  /// \brief For `EventSelectorType::synchronous_sublattice`, the time
+  ///     horizon of each phase. If <= 0.0, it is chosen so that about one
+  ///     event occurs per domain per phase.
+  double time_horizon = 0.0;
+
+  /// \brief For `EventSelectorType::synchronous_sublattice`, the number of
+  ///     domains along each supercell lattice vector. Values <= 0 are
+  ///     chosen automatically as the maximum allowed by the impact reach.
+  std::vector<Index> domain_shape = {0, 0, 0};
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
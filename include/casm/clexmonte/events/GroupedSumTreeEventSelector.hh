@@ -0,0 +1,211 @@
+#ifndef CASM_clexmonte_events_GroupedSumTreeEventSelector
+#define CASM_clexmonte_events_GroupedSumTreeEventSelector
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/events/sum_tree.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection-free event selector using one sum tree per prim event
+///
+/// All events with the same `prim_event_index` differ only by translation,
+/// so events are grouped by prim event. Each group has a binary sum tree
+/// over unit cells, indexed by `unitcell_index`. An event is selected by
+/// first choosing a prim event in proportion to the total rate of its
+/// group, by a linear search over the (few) prim events, and then
+/// descending that group's tree to choose a translation.
+///
+/// Compared to SumTreeEventSelector, each tree has `n_unitcells` rather
+/// than `n_unitcells * n_prim_events` leaves, and the rates of events of
+/// one type are contiguous in memory.
+///
+/// The selection protocol and constructor are the same as
+/// SumTreeEventSelector, so GroupedSumTreeEventSelector may be used with
+/// monte::kinetic_monte_carlo.
+///
+/// \tparam EventCalculatorType Must implement `double calculate_rate(EventID
+///     const &)`, `void calculate_rates(std::vector<EventID> const &,
+///     std::vector<double> &)`, and `void set_occurred_event(EventID const
+///     &)`
+/// \tparam TableType Impact table type, for which
+///     `impacted_events(TableType const &, EventID const &)` is defined
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename TableType,
+          typename EngineType>
+class GroupedSumTreeEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _n_prim_events Number of prim events
+  /// \param _event_id_list Events which may be selected. Events not in this
+  ///     list are skipped if they appear in the impact table.
+  /// \param _impact_table The impact table, which must outlive the selector
+  /// \param _engine Random number engine
+  GroupedSumTreeEventSelector(
+      std::shared_ptr<EventCalculatorType> _event_calculator,
+      Index _n_unitcells, Index _n_prim_events,
+      std::vector<EventID> const &_event_id_list,
+      TableType const &_impact_table, std::shared_ptr<EngineType> _engine)
+      : m_event_calculator(_event_calculator),
+        m_n_prim_events(_n_prim_events),
+        m_impact_table(&_impact_table),
+        m_random_number_generator(_engine),
+        m_has_selected_event(false) {
+    m_capacity = 1;
+    while (m_capacity < _n_unitcells) {
+      m_capacity *= 2;
+    }
+    m_trees.assign(m_n_prim_events, std::vector<double>(2 * m_capacity, 0.0));
+    m_is_selectable.assign(_n_unitcells * m_n_prim_events, false);
+    m_event_calculator->calculate_rates(_event_id_list, m_batch_rate);
+    for (Index k = 0; k < _event_id_list.size(); ++k) {
+      EventID const &event_id = _event_id_list[k];
+      m_is_selectable[linear_index(event_id, m_n_prim_events)] = true;
+      std::vector<double> &tree = m_trees[event_id.prim_event_index];
+      tree[m_capacity + event_id.unitcell_index] = m_batch_rate[k];
+    }
+    for (auto &tree : m_trees) {
+      build_sum_tree(tree, m_capacity);
+    }
+    m_batch_node.resize(m_n_prim_events);
+  }
+
+  /// \brief Update rates impacted by the last selected event, then select
+  ///     an event
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    if (m_has_selected_event) {
+      collect_impacted_events(*m_impact_table, m_selected_event_id,
+                              m_n_prim_events, m_is_selectable,
+                              m_batch_linear_index, m_batch_event_id);
+      m_event_calculator->set_occurred_event(m_selected_event_id);
+      m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+      _set_rates();
+    }
+
+    double total = total_rate();
+    if (!(total > 0.0)) {
+      std::stringstream msg;
+      msg << "Error in GroupedSumTreeEventSelector::select_event: total rate "
+             "is "
+          << total;
+      throw std::runtime_error(msg.str());
+    }
+
+    // choose a prim event in proportion to its total rate
+    double r = m_random_number_generator.random_real(total);
+    Index p = 0;
+    for (; p < m_n_prim_events - 1; ++p) {
+      if (r < m_trees[p][1]) {
+        break;
+      }
+      r -= m_trees[p][1];
+    }
+    while (!(m_trees[p][1] > 0.0)) {
+      --p;
+    }
+
+    // descend the prim event's tree to choose a translation
+    std::vector<double> const &tree = m_trees[p];
+    if (r > tree[1]) {
+      r = tree[1];
+    }
+    Index i = 1;
+    while (i < m_capacity) {
+      Index left = 2 * i;
+      if (r < tree[left] || !(tree[left + 1] > 0.0)) {
+        i = left;
+      } else {
+        r -= tree[left];
+        i = left + 1;
+      }
+    }
+    m_selected_event_id = EventID{p, i - m_capacity};
+    m_has_selected_event = true;
+
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    return std::make_pair(m_selected_event_id, -std::log(u) / total);
+  }
+
+  /// \brief Total rate of all selectable events
+  double total_rate() const {
+    double total = 0.0;
+    for (auto const &tree : m_trees) {
+      total += tree[1];
+    }
+    return total;
+  }
+
+  /// \brief Total rate of all selectable events of one prim event
+  double total_rate(Index prim_event_index) const {
+    return m_trees[prim_event_index][1];
+  }
+
+  /// \brief Current rate of an event
+  double rate(EventID const &event_id) const {
+    return m_trees[event_id.prim_event_index]
+                  [m_capacity + event_id.unitcell_index];
+  }
+
+ private:
+  /// \brief Set leaves from m_batch_event_id and m_batch_rate, then update
+  ///     the ancestors in each prim event's tree level by level
+  ///
+  /// Requires m_batch_event_id is sorted by linear index and unique, so the
+  /// leaves of each prim event's tree are sorted by unit cell.
+  void _set_rates() {
+    for (Index k = 0; k < m_batch_event_id.size(); ++k) {
+      EventID const &event_id = m_batch_event_id[k];
+      Index i = m_capacity + event_id.unitcell_index;
+      m_trees[event_id.prim_event_index][i] = m_batch_rate[k];
+      m_batch_node[event_id.prim_event_index].push_back(i);
+    }
+    for (Index p = 0; p < m_n_prim_events; ++p) {
+      update_sum_tree_ancestors(m_trees[p], m_batch_node[p]);
+      m_batch_node[p].clear();
+    }
+  }
+
+  std::shared_ptr<EventCalculatorType> m_event_calculator;
+  Index m_n_prim_events;
+  TableType const *m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// Number of leaves in each tree (power of 2)
+  Index m_capacity;
+
+  /// One sum tree per prim event, root at index 1, children of node i at
+  /// 2*i and 2*i+1, and the rate of the event in unit cell j at
+  /// m_capacity + j
+  std::vector<std::vector<double>> m_trees;
+
+  /// Whether the event with a given linear index may be selected
+  std::vector<bool> m_is_selectable;
+
+  bool m_has_selected_event;
+  EventID m_selected_event_id;
+
+  // scratch space for batch updates
+  std::vector<Index> m_batch_linear_index;
+  std::vector<EventID> m_batch_event_id;
+  std::vector<double> m_batch_rate;
+  std::vector<std::vector<Index>> m_batch_node;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef CASM_clexmonte_events_ImpactTable
 #define CASM_clexmonte_events_ImpactTable
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -9,6 +12,11 @@
 #include "casm/crystallography/UnitCellCoord.hh"
 
 namespace CASM {
+
+namespace xtal {
+class BasicStructure;
+}
+
 namespace clexmonte {
 
 /// \brief Implements an event impact table, storing only relative interations
@@ -27,6 +35,11 @@ struct RelativeEventImpactTable {
       std::vector<EventImpactInfo> const &prim_event_list,
       xtal::UnitCellIndexConverter const &unitcell_converter);
 
+  /// \brief Constructor, from a relative impact table
+  RelativeEventImpactTable(
+      std::vector<std::vector<RelativeEventID>> _impact_table,
+      xtal::UnitCellIndexConverter const &unitcell_converter);
+
   std::vector<EventID> const &operator()(EventID const &event_id) const;
 
  private:
@@ -47,19 +60,130 @@ struct RelativeEventImpactTable {
 struct SupercellEventImpactTable {
   SupercellEventImpactTable(
       std::vector<EventImpactInfo> const &prim_event_list,
-      xtal::UnitCellIndexConverter const &unitcell_converter);
+      xtal::UnitCellIndexConverter const &unitcell_converter,
+      Index n_threads = 1);
 
   std::vector<EventID> const &operator()(EventID const &event_id) const;
 
+  /// \brief Remove events which are not included, and free unused memory
+  void compact(std::vector<bool> const &is_included, Index n_threads = 1);
+
  private:
   Index m_n_prim_events;
   std::vector<std::vector<EventID>> m_impact_table;
 };
 
+/// \brief A contiguous range of PackedEventID, as returned by
+///     CsrEventImpactTable
+struct PackedEventIDRange {
+  PackedEventIDRange(PackedEventID const *_begin, PackedEventID const *_end)
+      : m_begin(_begin), m_end(_end) {}
+
+  PackedEventID const *begin() const { return m_begin; }
+  PackedEventID const *end() const { return m_end; }
+  Index size() const { return m_end - m_begin; }
+  bool empty() const { return m_begin == m_end; }
+
+ private:
+  PackedEventID const *m_begin;
+  PackedEventID const *m_end;
+};
+
+/// \brief Implement an event impact table, storing all interations in a
+/// supercell explicitly in one compressed array
+///
+/// Specifies which events are impacted (and therefore must have their
+/// propensities updated) by the occurance of another event.
+///
+/// CsrEventImpactTable stores the same impact vectors as
+/// SupercellEventImpactTable, but in compressed sparse row format: all
+/// impacted events are stored as PackedEventID in one array, and the impact
+/// vector of the event with linear index `i = unitcell_index * n_prim_events
+/// + prim_event_index` is the range `[offsets[i], offsets[i+1])`. This avoids
+/// the per-event allocation overhead of SupercellEventImpactTable and keeps
+/// impact vectors of neighboring events contiguous in memory.
+///
+/// The arrays are read-only after construction, and may be owned by the
+/// table or by external storage, such as a memory-mapped file shared by
+/// several processes (see `make_shared_csr_event_impact_table`). Copies
+/// share the arrays.
+struct CsrEventImpactTable {
+  CsrEventImpactTable(std::vector<EventImpactInfo> const &prim_event_list,
+                      xtal::UnitCellIndexConverter const &unitcell_converter,
+                      Index n_threads = 1);
+
+  /// \brief Constructor, using arrays kept valid by `_storage`
+  CsrEventImpactTable(Index _n_prim_events, Index _n_offsets,
+                      Index const *_offsets, Index _n_impacted,
+                      PackedEventID const *_impacted,
+                      std::shared_ptr<void const> _storage);
+
+  PackedEventIDRange operator()(EventID const &event_id) const;
+
+  /// \brief Number of prim events
+  Index n_prim_events() const { return m_n_prim_events; }
+
+  /// \brief Size of the offsets array, `n_events + 1`
+  Index n_offsets() const { return m_n_offsets; }
+
+  /// \brief Offsets array
+  Index const *offsets() const { return m_offsets; }
+
+  /// \brief Total number of stored impacted events
+  Index n_impacted() const { return m_n_impacted; }
+
+  /// \brief Impacted events array
+  PackedEventID const *impacted() const { return m_impacted; }
+
+ private:
+  Index m_n_prim_events;
+  Index m_n_offsets;
+  Index const *m_offsets;
+  Index m_n_impacted;
+  PackedEventID const *m_impacted;
+
+  /// Keeps m_offsets and m_impacted valid
+  std::shared_ptr<void const> m_storage;
+};
+
+/// \brief Return a CsrEventImpactTable without the events which are not
+///     included
+CsrEventImpactTable make_compacted_csr_event_impact_table(
+    CsrEventImpactTable const &impact_table,
+    std::vector<bool> const &is_included);
+
 /// \brief Return an impact table for events in the origin unit cell
 std::vector<std::vector<RelativeEventID>> make_relative_impact_table(
     std::vector<EventImpactInfo> const &prim_event_list);
 
+/// \brief Return the part of the relative impact table for which the
+///     impacted event is within a distance of the occurring event
+std::vector<std::vector<RelativeEventID>> make_relative_impact_table_within(
+    std::vector<EventImpactInfo> const &prim_event_list,
+    xtal::BasicStructure const &prim, double radius);
+
+/// \brief Bit flags specifying which parts of an impacted event's state
+///     must be recalculated
+enum EventUpdateFlags : unsigned char {
+  update_none = 0,
+  /// The change in energy (i.e. "formation_energy")
+  update_dE_final = 1,
+  /// The event local cluster expansion values (i.e. "kra", "freq")
+  update_local_clex = 2,
+  update_all = 3
+};
+
+/// \brief An impacted event and which parts of its state must be updated
+struct RelativeEventUpdate {
+  RelativeEventID event;
+  unsigned char flags;
+};
+
+/// \brief Return an impact table for events in the origin unit cell, which
+///     also specifies which parts of the impacted events' states are changed
+std::vector<std::vector<RelativeEventUpdate>> make_relative_update_table(
+    std::vector<EventImpactInfo> const &prim_event_list);
+
 // -- Inline definitions --
 
 inline std::vector<EventID> const &RelativeEventImpactTable::operator()(
@@ -85,6 +209,73 @@ inline std::vector<EventID> const &SupercellEventImpactTable::operator()(
   return m_impact_table[linear_index];
 }
 
+inline PackedEventIDRange CsrEventImpactTable::operator()(
+    EventID const &event_id) const {
+  Index i = linear_index(event_id, m_n_prim_events);
+  return PackedEventIDRange(m_impacted + m_offsets[i],
+                            m_impacted + m_offsets[i + 1]);
+}
+
+/// \brief Return the events impacted by `event_id`
+inline std::vector<EventID> const &impacted_events(
+    std::map<EventID, std::vector<EventID>> const &impact_table,
+    EventID const &event_id) {
+  return impact_table.at(event_id);
+}
+
+/// \brief Return the events impacted by `event_id`
+inline std::vector<EventID> const &impacted_events(
+    RelativeEventImpactTable const &impact_table, EventID const &event_id) {
+  return impact_table(event_id);
+}
+
+/// \brief Return the events impacted by `event_id`
+inline std::vector<EventID> const &impacted_events(
+    SupercellEventImpactTable const &impact_table, EventID const &event_id) {
+  return impact_table(event_id);
+}
+
+/// \brief Return the events impacted by `event_id`
+inline PackedEventIDRange impacted_events(
+    CsrEventImpactTable const &impact_table, EventID const &event_id) {
+  return impact_table(event_id);
+}
+
+/// \brief Collect the events impacted by `event_id` which may be selected
+///
+/// \param impact_table An impact table, for which `impacted_events` is
+///     defined
+/// \param event_id The event which occurred
+/// \param n_prim_events Number of prim events
+/// \param is_selectable Whether the event with a given linear index may be
+///     selected
+/// \param linear_index_list Set to the sorted, unique linear indices of the
+///     selectable impacted events
+/// \param event_id_list Set to the EventID corresponding to each element of
+///     `linear_index_list`
+template <typename TableType>
+void collect_impacted_events(TableType const &impact_table,
+                             EventID const &event_id, Index n_prim_events,
+                             std::vector<bool> const &is_selectable,
+                             std::vector<Index> &linear_index_list,
+                             std::vector<EventID> &event_id_list) {
+  linear_index_list.clear();
+  for (auto const &impacted : impacted_events(impact_table, event_id)) {
+    Index i = linear_index(impacted, n_prim_events);
+    if (is_selectable[i]) {
+      linear_index_list.push_back(i);
+    }
+  }
+  std::sort(linear_index_list.begin(), linear_index_list.end());
+  linear_index_list.erase(
+      std::unique(linear_index_list.begin(), linear_index_list.end()),
+      linear_index_list.end());
+  event_id_list.clear();
+  for (Index i : linear_index_list) {
+    event_id_list.push_back(make_event_id(i, n_prim_events));
+  }
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
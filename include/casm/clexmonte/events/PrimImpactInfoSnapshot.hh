@@ -0,0 +1,50 @@
+#ifndef CASM_clexmonte_events_PrimImpactInfoSnapshot
+#define CASM_clexmonte_events_PrimImpactInfoSnapshot
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+struct System;
+
+/// \brief Binary snapshot format version
+///
+/// Snapshots with a different version are treated as stale.
+constexpr std::uint64_t prim_impact_info_snapshot_version = 1;
+
+/// \brief Make the key identifying a prim impact info snapshot
+std::string make_prim_impact_info_snapshot_key(
+    System const &system, std::vector<EventImpactInfo> const &local_impact,
+    std::vector<std::string> const &clex_names,
+    std::vector<std::string> const &multiclex_names);
+
+/// \brief Write a prim impact info snapshot
+void write_prim_impact_info_snapshot(
+    fs::path const &snapshot_path, std::string const &key,
+    std::vector<EventImpactInfo> const &prim_impact_info_list);
+
+/// \brief Read the clex update neighborhoods from a prim impact info
+///     snapshot, if it exists and is current
+std::optional<std::vector<std::set<xtal::UnitCellCoord>>>
+read_prim_impact_info_snapshot(fs::path const &snapshot_path,
+                               std::string const &key);
+
+/// \brief Construct the list of event impact neighborhoods, reading and
+///     writing a snapshot of the cluster expansion neighborhoods
+std::vector<EventImpactInfo> load_or_make_prim_impact_info_list(
+    System const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names = {"formation_energy"},
+    std::vector<std::string> const &multiclex_names = {});
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
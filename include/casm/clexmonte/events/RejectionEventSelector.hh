@@ -0,0 +1,255 @@
+#ifndef CASM_clexmonte_events_RejectionEventSelector
+#define CASM_clexmonte_events_RejectionEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Diagnostics of RejectionEventSelector
+struct RejectionDiagnostics {
+  /// \brief Number of proposed events
+  Index n_proposed = 0;
+
+  /// \brief Number of accepted events
+  Index n_accepted = 0;
+
+  /// \brief Fraction of proposed events that were rejected
+  double rejection_fraction() const {
+    return n_proposed ? double(n_proposed - n_accepted) / n_proposed : 0.0;
+  }
+};
+
+/// \brief Rejection KMC event selector
+///
+/// Each prim event `p` has an upper bound on its event rates,
+/// `max_rate(p)`. Events are proposed at random with probability
+/// proportional to the upper bound of their prim event, and accepted with
+/// probability `rate / max_rate(p)`. Each proposal, accepted or not,
+/// advances time by an exponentially distributed increment with rate equal
+/// to the sum of upper bounds of all selectable events, so the total time
+/// increment returned by `select_event` has the same distribution as for
+/// rejection-free selection.
+///
+/// No rates are stored and no impact table is required; only the rates of
+/// proposed events are calculated. This is efficient when the rates of each
+/// prim event are similar in magnitude to its upper bound, but the
+/// acceptance probability is low if most events have rates much less than
+/// their upper bound.
+///
+/// \tparam EventCalculatorType Must implement `double calculate_rate(EventID
+///     const &)` and `void set_occurred_event(EventID const &)`, which is
+///     called with the selected event before the next proposal
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename EngineType>
+class RejectionEventSelector {
+ public:
+  /// \brief Constructor, with the same upper bound for all events
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _event_id_list Events which may be selected
+  /// \param _max_rate Upper bound on event rates. If <= 0.0, the upper bound
+  ///     is set, for each prim event, to `_max_rate_factor` times the maximum
+  ///     rate of its events in the initial state.
+  /// \param _max_rate_factor Used if `_max_rate` <= 0.0
+  /// \param _engine Random number engine
+  RejectionEventSelector(std::shared_ptr<EventCalculatorType> _event_calculator,
+                         std::vector<EventID> const &_event_id_list,
+                         double _max_rate, double _max_rate_factor,
+                         std::shared_ptr<EngineType> _engine)
+      : RejectionEventSelector(_event_calculator, _event_id_list,
+                               std::vector<double>(), _max_rate,
+                               _max_rate_factor, _engine) {}
+
+  /// \brief Constructor, with an upper bound for each prim event
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _event_id_list Events which may be selected
+  /// \param _prim_event_max_rate Upper bound on the event rates of each
+  ///     prim event, by prim event index. Prim events not included, or with
+  ///     value <= 0.0, use `_max_rate`.
+  /// \param _max_rate Upper bound on event rates of prim events without a
+  ///     value in `_prim_event_max_rate`. If <= 0.0, the upper bound is set
+  ///     to `_max_rate_factor` times the maximum rate of the prim event's
+  ///     events in the initial state, or of all events if those are all
+  ///     zero.
+  /// \param _max_rate_factor Used to estimate upper bounds
+  /// \param _engine Random number engine
+  RejectionEventSelector(std::shared_ptr<EventCalculatorType> _event_calculator,
+                         std::vector<EventID> const &_event_id_list,
+                         std::vector<double> const &_prim_event_max_rate,
+                         double _max_rate, double _max_rate_factor,
+                         std::shared_ptr<EngineType> _engine)
+      : m_event_calculator(_event_calculator),
+        m_random_number_generator(_engine),
+        m_has_selected_event(false) {
+    if (_event_id_list.empty()) {
+      throw std::runtime_error(
+          "Error constructing RejectionEventSelector: no events");
+    }
+
+    // group events by prim event
+    Index n_prim_events = _prim_event_max_rate.size();
+    for (EventID const &event_id : _event_id_list) {
+      n_prim_events = std::max(n_prim_events, event_id.prim_event_index + 1);
+    }
+    m_events.resize(n_prim_events);
+    for (EventID const &event_id : _event_id_list) {
+      m_events[event_id.prim_event_index].push_back(event_id);
+    }
+
+    // set upper bounds, estimating them from initial rates if necessary
+    m_max_rate.resize(n_prim_events, _max_rate);
+    for (Index p = 0; p < _prim_event_max_rate.size(); ++p) {
+      if (_prim_event_max_rate[p] > 0.0) {
+        m_max_rate[p] = _prim_event_max_rate[p];
+      }
+    }
+    std::vector<double> initial_max_rate(n_prim_events, 0.0);
+    double overall_initial_max_rate = 0.0;
+    for (Index p = 0; p < n_prim_events; ++p) {
+      if (m_max_rate[p] > 0.0) {
+        continue;
+      }
+      for (EventID const &event_id : m_events[p]) {
+        initial_max_rate[p] = std::max(
+            initial_max_rate[p], m_event_calculator->calculate_rate(event_id));
+      }
+      overall_initial_max_rate =
+          std::max(overall_initial_max_rate, initial_max_rate[p]);
+    }
+    for (Index p = 0; p < n_prim_events; ++p) {
+      if (m_max_rate[p] > 0.0) {
+        continue;
+      }
+      m_max_rate[p] = _max_rate_factor * (initial_max_rate[p] > 0.0
+                                              ? initial_max_rate[p]
+                                              : overall_initial_max_rate);
+    }
+
+    // cumulative proposal weights, by prim event
+    m_total_max_rate = 0.0;
+    for (Index p = 0; p < n_prim_events; ++p) {
+      if (m_events[p].empty()) {
+        m_cumulative_max_rate.push_back(m_total_max_rate);
+        continue;
+      }
+      if (!(m_max_rate[p] > 0.0)) {
+        std::stringstream msg;
+        msg << "Error constructing RejectionEventSelector: max_rate of prim "
+               "event "
+            << p << " is " << m_max_rate[p];
+        throw std::runtime_error(msg.str());
+      }
+      m_total_max_rate += m_events[p].size() * m_max_rate[p];
+      m_cumulative_max_rate.push_back(m_total_max_rate);
+    }
+    m_n_events = _event_id_list.size();
+  }
+
+  /// \brief Propose events until one is accepted
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    if (m_has_selected_event) {
+      m_event_calculator->set_occurred_event(m_selected_event_id);
+    }
+
+    double time_increment = 0.0;
+    for (Index n_proposed = 0;; ++n_proposed) {
+      if (n_proposed == max_proposals_per_event * m_n_events) {
+        throw std::runtime_error(
+            "Error in RejectionEventSelector::select_event: no event accepted "
+            "(event rates may be zero, or much less than max_rate)");
+      }
+      double u = 1.0 - m_random_number_generator.random_real(1.0);
+      time_increment -= std::log(u) / m_total_max_rate;
+
+      // choose a prim event, in proportion to its total upper bound, then
+      // one of its events uniformly
+      double x = m_random_number_generator.random_real(m_total_max_rate);
+      Index p = std::upper_bound(m_cumulative_max_rate.begin(),
+                                 m_cumulative_max_rate.end(), x) -
+                m_cumulative_max_rate.begin();
+      while (p >= m_events.size() || m_events[p].empty()) {
+        --p;
+      }
+      std::vector<EventID> const &events = m_events[p];
+      Index n_events = events.size();
+      Index k = m_random_number_generator.random_real(n_events);
+      EventID const &event_id = events[k < n_events ? k : n_events - 1];
+
+      ++m_diagnostics.n_proposed;
+      double rate = m_event_calculator->calculate_rate(event_id);
+      if (rate > m_max_rate[p]) {
+        std::stringstream msg;
+        msg << "Error in RejectionEventSelector::select_event: event rate ("
+            << rate << ") exceeds max_rate (" << m_max_rate[p]
+            << ") of prim event " << p << ". Increase max_rate.";
+        throw std::runtime_error(msg.str());
+      }
+      if (m_random_number_generator.random_real(m_max_rate[p]) < rate) {
+        ++m_diagnostics.n_accepted;
+        m_selected_event_id = event_id;
+        m_has_selected_event = true;
+        return std::make_pair(m_selected_event_id, time_increment);
+      }
+    }
+  }
+
+  /// \brief Maximum upper bound on event rates, over all prim events
+  double max_rate() const {
+    return *std::max_element(m_max_rate.begin(), m_max_rate.end());
+  }
+
+  /// \brief Upper bound on event rates, by prim event index
+  std::vector<double> const &prim_event_max_rate() const {
+    return m_max_rate;
+  }
+
+  /// \brief Proposal and acceptance counts
+  RejectionDiagnostics const &diagnostics() const { return m_diagnostics; }
+
+  /// \brief `select_event` throws after this many proposals per event
+  ///     without acceptance
+  static constexpr Index max_proposals_per_event = 1000;
+
+ private:
+  std::shared_ptr<EventCalculatorType> m_event_calculator;
+
+  /// Selectable events, by prim event index
+  std::vector<std::vector<EventID>> m_events;
+
+  /// Total number of selectable events
+  Index m_n_events;
+
+  /// Upper bound on event rates, by prim event index
+  std::vector<double> m_max_rate;
+
+  /// Cumulative sum of `m_events[p].size() * m_max_rate[p]`
+  std::vector<double> m_cumulative_max_rate;
+
+  /// Sum of upper bounds of all selectable events
+  double m_total_max_rate;
+
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  bool m_has_selected_event;
+  EventID m_selected_event_id;
+
+  RejectionDiagnostics m_diagnostics;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CASM_clexmonte_events_SharedImpactTable
+#define CASM_clexmonte_events_SharedImpactTable
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Shared impact table file format version
+///
+/// Files with a different version are treated as stale.
+constexpr std::uint64_t shared_impact_table_version = 1;
+
+/// \brief Make the key identifying a shared CsrEventImpactTable file
+std::string make_shared_impact_table_key(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    Eigen::Matrix3l const &transformation_matrix_to_super);
+
+/// \brief Write a CsrEventImpactTable to a file that can be memory-mapped
+void write_csr_event_impact_table(fs::path const &path, std::string const &key,
+                                  CsrEventImpactTable const &table);
+
+/// \brief Memory-map a CsrEventImpactTable file, read-only
+std::shared_ptr<CsrEventImpactTable> map_csr_event_impact_table(
+    fs::path const &path, std::string const &key);
+
+/// \brief Construct a CsrEventImpactTable backed by a memory-mapped file
+///     shared by all processes using the same directory
+std::shared_ptr<CsrEventImpactTable> make_shared_csr_event_impact_table(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter,
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    fs::path const &shared_dir);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
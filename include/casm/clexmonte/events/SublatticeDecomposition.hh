@@ -0,0 +1,84 @@
+#ifndef CASM_clexmonte_events_SublatticeDecomposition
+#define CASM_clexmonte_events_SublatticeDecomposition
+
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return, along each lattice vector, the maximum separation in unit
+///     cells of the origin unit cells of two events such that the occurrence
+///     of one may impact the other
+Eigen::Vector3l event_impact_reach(
+    std::vector<EventImpactInfo> const &prim_impact_info_list);
+
+/// \brief Partition of supercell events into spatial domains, each divided
+///     into sectors, for synchronous sublattice parallel KMC
+///
+/// Along each lattice vector, the supercell is divided into
+/// `domain_shape(k)` domains of (nearly) equal width. If there is more than
+/// one domain along a lattice vector, each domain is split in two sectors
+/// along it, so each domain has up to 8 sectors. Events are assigned to the
+/// domain and sector of their origin unit cell.
+///
+/// Every sector is wider than the impact reach (see `event_impact_reach`)
+/// along each lattice vector with more than one domain. Therefore, events
+/// in the same sector of different domains do not impact each other, and
+/// may occur concurrently.
+///
+/// Events are grouped into "tasks", one per sector and domain, with
+/// `task_index = sector_index * n_domains + domain_index`.
+class SublatticeDecomposition {
+ public:
+  /// \brief Constructor
+  SublatticeDecomposition(
+      Eigen::Matrix3l const &transformation_matrix_to_super,
+      Eigen::Vector3l const &reach, Index n_prim_events,
+      std::vector<EventID> const &event_id_list,
+      Eigen::Vector3l domain_shape = Eigen::Vector3l::Zero());
+
+  /// \brief Number of domains along each lattice vector
+  Eigen::Vector3l const &domain_shape() const { return m_domain_shape; }
+
+  /// \brief Number of domains
+  Index n_domains() const { return m_n_domains; }
+
+  /// \brief Number of sectors per domain
+  Index n_sectors() const { return m_n_sectors; }
+
+  /// \brief Number of tasks, `n_sectors() * n_domains()`
+  Index n_tasks() const { return m_task_events.size(); }
+
+  /// \brief Events of one task
+  std::vector<EventID> const &task_events(Index task_index) const {
+    return m_task_events[task_index];
+  }
+
+  /// \brief Task of the event with a given linear index, or -1 if the event
+  ///     is not in `event_id_list`
+  Index task_index(Index linear_index) const {
+    return m_task_index[linear_index];
+  }
+
+  /// \brief Index of the event with a given linear index in
+  ///     `task_events(task_index(linear_index))`
+  Index local_index(Index linear_index) const {
+    return m_local_index[linear_index];
+  }
+
+ private:
+  Eigen::Vector3l m_domain_shape;
+  Index m_n_domains;
+  Index m_n_sectors;
+  std::vector<std::vector<EventID>> m_task_events;
+  std::vector<Index> m_task_index;
+  std::vector<Index> m_local_index;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
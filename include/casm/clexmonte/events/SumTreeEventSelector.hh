@@ -0,0 +1,747 @@
+#ifndef CASM_clexmonte_events_SumTreeEventSelector
+#define CASM_clexmonte_events_SumTreeEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/events/sum_tree.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Diagnostics of SumTreeEventSelector deferred rate updates
+///
+/// When pending events are updated, the difference between each event's
+/// stored (stale) rate and its recalculated rate is the rate error that the
+/// deferral introduced.
+struct DeferredUpdateDiagnostics {
+  /// \brief Number of times pending rate updates were applied
+  Index n_flushes = 0;
+
+  /// \brief Number of impacted event rate updates that were deferred
+  Index n_deferred_updates = 0;
+
+  /// \brief Number of pending events updated, summed over flushes
+  Index n_flushed_events = 0;
+
+  /// \brief Maximum absolute rate error of any flushed event
+  double max_abs_rate_error = 0.0;
+
+  /// \brief Sum of absolute rate errors of all flushed events
+  double sum_abs_rate_error = 0.0;
+
+  /// \brief Maximum, over flushes, of the sum of absolute rate errors of
+  ///     the flushed events relative to the total rate after the flush
+  ///
+  /// This bounds the relative error of the total rate, and therefore of the
+  /// expected time increment, just before the flush.
+  double max_rel_total_rate_error = 0.0;
+};
+
+/// \brief Parameters of SumTreeEventSelector superbasin acceleration
+///
+/// A pair of events is recurrent each time one of them is selected
+/// directly after the other, with the other also selected directly before,
+/// as for a vacancy hopping back and forth between two sites. After every
+/// `n_recurrence` recurrences of a pair, the rates of both events are
+/// multiplied by `scale_factor`, which is equivalent to raising their
+/// barriers by kT*ln(1/scale_factor), until the accumulated scale reaches
+/// `min_scale`. All scaling is removed when an event that is not part of a
+/// tracked pair is selected.
+struct SuperbasinParams {
+  /// \brief Number of recurrences of a pair between scalings. If <= 0,
+  ///     superbasin acceleration is disabled.
+  Index n_recurrence = 0;
+
+  /// \brief Factor, in (0.0, 1.0), that scaled rates are multiplied by
+  double scale_factor = 0.5;
+
+  /// \brief Lower bound on the accumulated scale of any event's rate
+  double min_scale = 1e-6;
+};
+
+/// \brief Diagnostics of SumTreeEventSelector superbasin acceleration
+struct SuperbasinDiagnostics {
+  /// \brief Number of selections that completed a recurrent pair
+  Index n_recurrences = 0;
+
+  /// \brief Number of times the rates of a pair were scaled
+  Index n_scalings = 0;
+
+  /// \brief Number of times all scaling was removed
+  Index n_exits = 0;
+
+  /// \brief Number of selected events whose rate was scaled
+  Index n_scaled_selections = 0;
+
+  /// \brief Time elapsed while any rate was scaled
+  double scaled_time = 0.0;
+
+  /// \brief Minimum accumulated scale applied to any event's rate
+  double min_scale = 1.0;
+};
+
+/// \brief Rejection-free event selector using a flat binary sum tree
+///
+/// Event rates are stored in the leaves of a binary sum tree, which is
+/// stored in a single array and indexed by the event linear index
+/// `unitcell_index * n_prim_events + prim_event_index`. Selecting an event
+/// and updating one rate are both O(log(n_events)).
+///
+/// After an event is selected, it is assumed to occur, and on the next call
+/// to `select_event` the rates of the events impacted by it are updated
+/// before selecting the next event. This is the same protocol as
+/// lotto::RejectionFreeEventSelector, so SumTreeEventSelector may be used with
+/// monte::kinetic_monte_carlo.
+///
+/// Unlike lotto::RejectionFreeEventSelector, the impact table type is a
+/// template parameter, so any of the impact table types (std::map,
+/// RelativeEventImpactTable, SupercellEventImpactTable, CsrEventImpactTable)
+/// may be used directly. Also, the rates of all impacted events are
+/// calculated with one call to the event calculator's batch method and the
+/// sum tree is updated in bulk.
+///
+/// Optionally (see `set_deferred_updates`), only the impacted events in a
+/// smaller "immediate" impact table, such as the events near the occurring
+/// event, are updated after each event. The other impacted events are
+/// marked pending, and are updated together every `update_interval`
+/// selections. This is an approximation, in which events are selected with
+/// stale rates for at most `update_interval - 1` steps; the induced rate
+/// errors are reported by `deferred_update_diagnostics`.
+///
+/// Optionally (see `set_superbasin`), the rates of recurrent pairs of
+/// events, such as the hops of a vacancy trapped by a solute, are scaled
+/// down as they recur (see SuperbasinParams). Time increments are drawn
+/// from the total of the scaled rates, as in accelerated superbasin KMC,
+/// so each step out of a trap represents proportionally more time. Every
+/// selected event still occurs, so quantities counted per event, such as
+/// jumps, are unaffected.
+///
+/// Events may be disabled and enabled again during a run (see
+/// `set_events_enabled`), for example to model a region where events are
+/// only possible part of the time. A disabled event keeps its place in the
+/// sum tree with rate 0.0, and is skipped when it is impacted, so the cost
+/// is proportional to the number of events changed, and the event list and
+/// impact table are not reconstructed. Only events in the event list given
+/// to the constructor can be enabled.
+///
+/// \tparam EventCalculatorType Must implement `double calculate_rate(EventID
+///     const &)`, `void calculate_rates(std::vector<EventID> const &,
+///     std::vector<double> &)`, and `void set_occurred_event(EventID const
+///     &)`, which is called with the selected event before the rates of the
+///     impacted events are recalculated
+/// \tparam TableType Impact table type, for which
+///     `impacted_events(TableType const &, EventID const &)` is defined and
+///     returns a range of EventID or PackedEventID
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename TableType,
+          typename EngineType>
+class SumTreeEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _event_calculator Calculates event rates
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _n_prim_events Number of prim events
+  /// \param _event_id_list Events which may be selected. Events not in this
+  ///     list are skipped if they appear in the impact table.
+  /// \param _impact_table The impact table, which must outlive the selector
+  /// \param _engine Random number engine
+  SumTreeEventSelector(std::shared_ptr<EventCalculatorType> _event_calculator,
+                       Index _n_unitcells, Index _n_prim_events,
+                       std::vector<EventID> _event_id_list,
+                       TableType const &_impact_table,
+                       std::shared_ptr<EngineType> _engine)
+      : m_event_calculator(_event_calculator),
+        m_n_prim_events(_n_prim_events),
+        m_impact_table(&_impact_table),
+        m_random_number_generator(_engine),
+        m_event_id_list(std::move(_event_id_list)),
+        m_has_selected_event(false) {
+    Index n_total = _n_unitcells * m_n_prim_events;
+    m_capacity = 1;
+    while (m_capacity < n_total) {
+      m_capacity *= 2;
+    }
+    m_tree.assign(2 * m_capacity, 0.0);
+    m_is_selectable.assign(n_total, false);
+    m_is_disabled.assign(n_total, false);
+    for (EventID const &event_id : m_event_id_list) {
+      m_is_selectable[linear_index(event_id, m_n_prim_events)] = true;
+    }
+    _reset_rates();
+  }
+
+  /// \brief Recalculate the rates of all selectable events and rebuild the
+  ///     sum tree, keeping the event list and impact table
+  ///
+  /// Use this, rather than constructing a new selector, to restart with the
+  /// same events after the event calculator's conditions or the occupation
+  /// change, for example for each run of a chemical potential scan in the
+  /// same supercell.
+  ///
+  /// \param _engine Random number engine used for the following selections
+  void reset_rates(std::shared_ptr<EngineType> _engine) {
+    m_random_number_generator =
+        monte::RandomNumberGenerator<EngineType>(_engine);
+    m_has_selected_event = false;
+    _reset_rates();
+  }
+
+  /// \brief Recalculate the rates of all enabled events and rebuild the
+  ///     sum tree, continuing the current run
+  ///
+  /// Use this after a change of the event calculator's conditions that
+  /// changes all rates, such as the temperature during a temperature ramp.
+  /// The rates impacted by the last selected event are updated first, so
+  /// the event calculator's cached event state parts remain valid and are
+  /// reused. Superbasin scaling is removed.
+  void recalculate_rates() {
+    update_rates();
+    _reset_rates();
+  }
+
+  /// \brief Set the rates of all events in the event list and rebuild the
+  ///     sum tree, continuing the current run
+  ///
+  /// As `recalculate_rates`, but with rates calculated by the caller, for
+  /// example when they are known analytically after a change of
+  /// conditions. The sum tree is built bottom-up in O(n_events), using
+  /// `n_threads()` threads.
+  ///
+  /// \param rates The rate of each event in `event_id_list()`, in order
+  void rebuild(std::vector<double> const &rates) {
+    if (rates.size() != m_event_id_list.size()) {
+      throw std::runtime_error(
+          "Error in SumTreeEventSelector::rebuild: rates size does not "
+          "match the event list size");
+    }
+    update_rates();
+    m_batch_rate = rates;
+    _reset_rates(false);
+  }
+
+  /// \brief Set the rates of a batch of events, updating each ancestor in
+  ///     the sum tree once
+  ///
+  /// The rates impacted by the last selected event are updated first.
+  /// Events that are not enabled (see `is_enabled`) are skipped. If an event
+  /// is given more than once, the last rate is used. The cost is the number
+  /// of distinct sum tree nodes on the paths from the changed leaves to the
+  /// root, rather than `event_id_list.size() * log(n_events)`.
+  ///
+  /// \param event_id_list Events to set
+  /// \param rates The new rate of each event in `event_id_list`
+  void set_rates(std::vector<EventID> const &event_id_list,
+                 std::vector<double> const &rates) {
+    if (rates.size() != event_id_list.size()) {
+      throw std::runtime_error(
+          "Error in SumTreeEventSelector::set_rates: rates size does not "
+          "match the event list size");
+    }
+    update_rates();
+    _flush_pending();
+    std::vector<std::pair<Index, double>> batch;
+    batch.reserve(event_id_list.size());
+    for (Index k = 0; k < event_id_list.size(); ++k) {
+      Index i = linear_index(event_id_list[k], m_n_prim_events);
+      if (m_is_selectable[i]) {
+        batch.emplace_back(i, rates[k]);
+      }
+    }
+    std::stable_sort(
+        batch.begin(), batch.end(),
+        [](auto const &a, auto const &b) { return a.first < b.first; });
+    m_batch_linear_index.clear();
+    m_batch_rate.clear();
+    for (auto const &pair : batch) {
+      if (!m_batch_linear_index.empty() &&
+          m_batch_linear_index.back() == pair.first) {
+        m_batch_rate.back() = pair.second;
+      } else {
+        m_batch_linear_index.push_back(pair.first);
+        m_batch_rate.push_back(pair.second);
+      }
+    }
+    _set_rates();
+  }
+
+  /// \brief Events which may be selected, as given to the constructor
+  std::vector<EventID> const &event_id_list() const { return m_event_id_list; }
+
+  /// \brief Number of threads used to build the sum tree
+  Index n_threads() const { return m_n_threads; }
+
+  /// \brief Set the number of threads used to build the sum tree, by
+  ///     `reset_rates`, `recalculate_rates`, and `rebuild`
+  void set_n_threads(Index _n_threads) {
+    m_n_threads = std::max(Index(1), _n_threads);
+  }
+
+  /// \brief Disable or enable events
+  ///
+  /// Disabled events have rate 0.0 and are not updated when impacted by
+  /// other events. Enabled events have their rates recalculated. Events that
+  /// are not in the event list given to the constructor, or that are
+  /// already disabled or enabled, are skipped. The rates impacted by the
+  /// last selected event are updated first.
+  ///
+  /// \param event_id_list Events to disable or enable
+  /// \param enabled If true, enable the events, else disable them
+  void set_events_enabled(std::vector<EventID> const &event_id_list,
+                          bool enabled) {
+    update_rates();
+    _flush_pending();
+    m_batch_linear_index.clear();
+    for (EventID const &event_id : event_id_list) {
+      Index i = linear_index(event_id, m_n_prim_events);
+      if (enabled && m_is_disabled[i]) {
+        m_is_disabled[i] = false;
+        m_is_selectable[i] = true;
+        m_batch_linear_index.push_back(i);
+      } else if (!enabled && m_is_selectable[i]) {
+        m_is_selectable[i] = false;
+        m_is_disabled[i] = true;
+        _set_leaf(i, 0.0);
+      }
+    }
+    if (m_batch_linear_index.empty()) {
+      return;
+    }
+    std::sort(m_batch_linear_index.begin(), m_batch_linear_index.end());
+    m_batch_linear_index.erase(
+        std::unique(m_batch_linear_index.begin(), m_batch_linear_index.end()),
+        m_batch_linear_index.end());
+    m_batch_event_id.clear();
+    for (Index i : m_batch_linear_index) {
+      m_batch_event_id.push_back(make_event_id(i, m_n_prim_events));
+    }
+    m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+    _set_rates();
+  }
+
+  /// \brief True if an event is in the event list and not disabled
+  bool is_enabled(EventID const &event_id) const {
+    return m_is_selectable[linear_index(event_id, m_n_prim_events)];
+  }
+
+  /// \brief Update the rates impacted by the last selected event, if they
+  ///     have not been updated yet
+  ///
+  /// This is done by `select_event`, so it is only needed to read current
+  /// rates, such as `total_rate`, between selections.
+  void update_rates() {
+    if (!m_has_selected_event) {
+      return;
+    }
+    collect_impacted_events(*m_impact_table, m_selected_event_id,
+                            m_n_prim_events, m_is_selectable,
+                            m_batch_linear_index, m_batch_event_id);
+    m_event_calculator->set_occurred_event(m_selected_event_id);
+    if (m_immediate_table) {
+      _defer_updates();
+    }
+    m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+    _set_rates();
+    m_has_selected_event = false;
+  }
+
+  /// \brief Cancel the last selected event, which will not occur
+  ///
+  /// For a selection made with rates that changed before the selected
+  /// event's time, such as at a scheduled change of conditions. Superbasin
+  /// pair tracking, if enabled, still includes the cancelled selection.
+  void cancel_selection() { m_has_selected_event = false; }
+
+  /// \brief Update impacted events outside `_immediate_table` only every
+  ///     `_update_interval` selections
+  ///
+  /// \param _immediate_table Impact table of events which are updated
+  ///     after each selection, for example from
+  ///     `make_relative_impact_table_within`. It should be a subset of the
+  ///     full impact table and include the occurring event. If null,
+  ///     deferred updates are disabled.
+  /// \param _update_interval Number of selections between updates of the
+  ///     pending events. If <= 1, deferred updates are disabled.
+  void set_deferred_updates(
+      std::shared_ptr<RelativeEventImpactTable const> _immediate_table,
+      Index _update_interval) {
+    _flush_pending();
+    if (!_immediate_table || _update_interval <= 1) {
+      m_immediate_table.reset();
+      m_update_interval = 1;
+    } else {
+      m_immediate_table = _immediate_table;
+      m_update_interval = _update_interval;
+      m_is_pending.assign(m_is_selectable.size(), false);
+    }
+    m_n_since_flush = 0;
+    m_diagnostics = DeferredUpdateDiagnostics();
+  }
+
+  /// \brief Diagnostics of deferred rate updates
+  DeferredUpdateDiagnostics const &deferred_update_diagnostics() const {
+    return m_diagnostics;
+  }
+
+  /// \brief Scale down the rates of recurrent event pairs
+  ///
+  /// \param _params Superbasin parameters. If `_params.n_recurrence` <= 0,
+  ///     superbasin acceleration is disabled.
+  void set_superbasin(SuperbasinParams const &_params) {
+    _exit_superbasin();
+    m_superbasin = _params;
+    m_n_history = 0;
+    m_superbasin_diagnostics = SuperbasinDiagnostics();
+  }
+
+  /// \brief Diagnostics of superbasin acceleration
+  SuperbasinDiagnostics const &superbasin_diagnostics() const {
+    return m_superbasin_diagnostics;
+  }
+
+  /// \brief Update rates impacted by the last selected event, then select
+  ///     an event
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    update_rates();
+
+    double total = total_rate();
+    if (!(total > 0.0)) {
+      std::stringstream msg;
+      msg << "Error in SumTreeEventSelector::select_event: total rate is "
+          << total;
+      throw std::runtime_error(msg.str());
+    }
+
+    // descend the tree, choosing child in proportion to subtree rate sums
+    double r = m_random_number_generator.random_real(total);
+    Index i = 1;
+    while (i < m_capacity) {
+      Index left = 2 * i;
+      if (r < m_tree[left] || !(m_tree[left + 1] > 0.0)) {
+        i = left;
+      } else {
+        r -= m_tree[left];
+        i = left + 1;
+      }
+    }
+    m_selected_event_id = make_event_id(i - m_capacity, m_n_prim_events);
+    m_has_selected_event = true;
+
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    double time_increment = -std::log(u) / total;
+    if (m_superbasin.n_recurrence > 0) {
+      _update_superbasin(i - m_capacity, time_increment);
+    }
+    return std::make_pair(m_selected_event_id, time_increment);
+  }
+
+  /// \brief Total rate of all selectable events
+  double total_rate() const { return m_tree[1]; }
+
+  /// \brief Current rate of an event
+  double rate(EventID const &event_id) const {
+    return m_tree[m_capacity + linear_index(event_id, m_n_prim_events)];
+  }
+
+ private:
+  /// \brief Calculate all selectable event rates with one call to the
+  ///     event calculator's batch method, then write the sum tree layer by
+  ///     layer, from the leaves to the root
+  ///
+  /// If `calculate` is false, the rates already in m_batch_rate are used.
+  void _reset_rates(bool calculate = true) {
+    m_scale.clear();
+    m_pair_count.clear();
+    m_tracked.clear();
+    m_n_history = 0;
+    if (m_immediate_table) {
+      std::fill(m_is_pending.begin(), m_is_pending.end(), false);
+      m_pending_linear_index.clear();
+      m_n_since_flush = 0;
+    }
+    if (calculate) {
+      m_event_calculator->calculate_rates(m_event_id_list, m_batch_rate);
+    }
+    _build_tree(m_batch_rate);
+  }
+
+  /// \brief Set the leaves from the rates of the events in the event list,
+  ///     in order, and build the sum tree bottom-up
+  void _build_tree(std::vector<double> const &rates) {
+    std::fill(m_tree.begin(), m_tree.end(), 0.0);
+    for (Index k = 0; k < m_event_id_list.size(); ++k) {
+      Index i = linear_index(m_event_id_list[k], m_n_prim_events);
+      m_tree[m_capacity + i] = m_is_selectable[i] ? rates[k] : 0.0;
+    }
+    build_sum_tree(m_tree, m_capacity, m_n_threads);
+  }
+
+  /// \brief Set one leaf and update its ancestors
+  void _set_leaf(Index i, double value) {
+    Index node = m_capacity + i;
+    m_tree[node] = value;
+    for (node /= 2; node > 0; node /= 2) {
+      m_tree[node] = m_tree[2 * node] + m_tree[2 * node + 1];
+    }
+  }
+
+  /// \brief Track recurrent pairs after the event with linear index `i` is
+  ///     selected, scaling or unscaling rates as necessary
+  ///
+  /// The time increment was drawn before any scaling change, so scaling
+  /// takes effect for the next selection.
+  void _update_superbasin(Index i, double time_increment) {
+    SuperbasinDiagnostics &d = m_superbasin_diagnostics;
+    if (!m_scale.empty()) {
+      d.scaled_time += time_increment;
+    }
+    if (m_scale.count(i)) {
+      ++d.n_scaled_selections;
+    }
+    if (m_n_history == 2 && m_history[0] == i && m_history[1] != i) {
+      ++d.n_recurrences;
+      std::pair<Index, Index> key = std::minmax(i, m_history[1]);
+      m_tracked.insert(key.first);
+      m_tracked.insert(key.second);
+      Index &count = m_pair_count[key];
+      if (++count >= m_superbasin.n_recurrence) {
+        count = 0;
+        _scale_event(key.first);
+        _scale_event(key.second);
+      }
+    } else if (!m_tracked.empty() && !m_tracked.count(i)) {
+      _exit_superbasin();
+    }
+    m_history[0] = m_n_history ? m_history[1] : i;
+    m_history[1] = i;
+    m_n_history = std::min(m_n_history + 1, Index(2));
+  }
+
+  /// \brief Multiply an event's rate by the scale factor, down to the
+  ///     minimum scale
+  void _scale_event(Index i) {
+    auto it = m_scale.emplace(i, 1.0).first;
+    double scale = std::max(it->second * m_superbasin.scale_factor,
+                            m_superbasin.min_scale);
+    if (!(scale < it->second)) {
+      return;
+    }
+    _set_leaf(i, m_tree[m_capacity + i] * scale / it->second);
+    it->second = scale;
+    ++m_superbasin_diagnostics.n_scalings;
+    m_superbasin_diagnostics.min_scale =
+        std::min(m_superbasin_diagnostics.min_scale, scale);
+  }
+
+  /// \brief Restore the unscaled rates and stop tracking pairs
+  void _exit_superbasin() {
+    if (!m_scale.empty()) {
+      for (auto const &pair : m_scale) {
+        _set_leaf(pair.first, m_tree[m_capacity + pair.first] / pair.second);
+      }
+      m_scale.clear();
+      ++m_superbasin_diagnostics.n_exits;
+    }
+    m_pair_count.clear();
+    m_tracked.clear();
+  }
+
+  /// \brief Move impacted events outside the immediate table from the
+  ///     batch to the pending list, or, every `m_update_interval`
+  ///     selections, add the pending events to the batch
+  ///
+  /// Requires m_batch_linear_index is set from the full impact table. On
+  /// return m_batch_linear_index and m_batch_event_id are sorted and unique.
+  void _defer_updates() {
+    collect_impacted_events(*m_immediate_table, m_selected_event_id,
+                            m_n_prim_events, m_is_selectable,
+                            m_immediate_linear_index, m_batch_event_id);
+    for (Index i : m_batch_linear_index) {
+      if (std::binary_search(m_immediate_linear_index.begin(),
+                             m_immediate_linear_index.end(), i)) {
+        // updated now; it may remain in m_pending_linear_index
+        m_is_pending[i] = false;
+      } else {
+        ++m_diagnostics.n_deferred_updates;
+        if (!m_is_pending[i]) {
+          m_is_pending[i] = true;
+          m_pending_linear_index.push_back(i);
+        }
+      }
+    }
+    std::swap(m_batch_linear_index, m_immediate_linear_index);
+
+    ++m_n_since_flush;
+    if (m_n_since_flush < m_update_interval) {
+      return;
+    }
+    m_n_since_flush = 0;
+    if (m_pending_linear_index.empty()) {
+      return;
+    }
+    m_batch_linear_index.insert(m_batch_linear_index.end(),
+                                m_pending_linear_index.begin(),
+                                m_pending_linear_index.end());
+    std::sort(m_batch_linear_index.begin(), m_batch_linear_index.end());
+    m_batch_linear_index.erase(
+        std::unique(m_batch_linear_index.begin(), m_batch_linear_index.end()),
+        m_batch_linear_index.end());
+    m_batch_event_id.clear();
+    for (Index i : m_batch_linear_index) {
+      m_batch_event_id.push_back(make_event_id(i, m_n_prim_events));
+    }
+    m_flush_pending_after_set = true;
+  }
+
+  /// \brief Update the rates of all pending events now
+  void _flush_pending() {
+    if (!m_immediate_table || m_pending_linear_index.empty()) {
+      return;
+    }
+    std::sort(m_pending_linear_index.begin(), m_pending_linear_index.end());
+    m_pending_linear_index.erase(std::unique(m_pending_linear_index.begin(),
+                                             m_pending_linear_index.end()),
+                                 m_pending_linear_index.end());
+    m_batch_linear_index = m_pending_linear_index;
+    m_batch_event_id.clear();
+    for (Index i : m_batch_linear_index) {
+      m_batch_event_id.push_back(make_event_id(i, m_n_prim_events));
+    }
+    m_event_calculator->calculate_rates(m_batch_event_id, m_batch_rate);
+    m_flush_pending_after_set = true;
+    _set_rates();
+  }
+
+  /// \brief After pending events are included in a batch update, record
+  ///     their rate errors and clear the pending list
+  ///
+  /// Must be called before the leaves are overwritten.
+  void _record_flush() {
+    double sum_abs_error = 0.0;
+    for (Index k = 0; k < m_batch_linear_index.size(); ++k) {
+      Index i = m_batch_linear_index[k];
+      if (m_is_pending[i]) {
+        double error = std::abs(m_batch_rate[k] - m_tree[m_capacity + i]);
+        sum_abs_error += error;
+        m_diagnostics.max_abs_rate_error =
+            std::max(m_diagnostics.max_abs_rate_error, error);
+        m_is_pending[i] = false;
+        ++m_diagnostics.n_flushed_events;
+      }
+    }
+    m_diagnostics.sum_abs_rate_error += sum_abs_error;
+    ++m_diagnostics.n_flushes;
+    m_pending_linear_index.clear();
+    m_flush_sum_abs_error = sum_abs_error;
+  }
+
+  /// \brief Set leaves from m_batch_linear_index and m_batch_rate, then
+  ///     update their ancestors level by level
+  ///
+  /// Requires m_batch_linear_index is sorted and unique, so that the parents
+  /// at each level are also sorted and duplicates are adjacent.
+  void _set_rates() {
+    if (!m_scale.empty()) {
+      for (Index k = 0; k < m_batch_linear_index.size(); ++k) {
+        auto it = m_scale.find(m_batch_linear_index[k]);
+        if (it != m_scale.end()) {
+          m_batch_rate[k] *= it->second;
+        }
+      }
+    }
+    bool is_flush = m_flush_pending_after_set;
+    if (is_flush) {
+      _record_flush();
+      m_flush_pending_after_set = false;
+    }
+    m_batch_node.clear();
+    for (Index k = 0; k < m_batch_linear_index.size(); ++k) {
+      Index i = m_capacity + m_batch_linear_index[k];
+      m_tree[i] = m_batch_rate[k];
+      m_batch_node.push_back(i);
+    }
+    update_sum_tree_ancestors(m_tree, m_batch_node);
+    if (is_flush && total_rate() > 0.0) {
+      m_diagnostics.max_rel_total_rate_error =
+          std::max(m_diagnostics.max_rel_total_rate_error,
+                   m_flush_sum_abs_error / total_rate());
+    }
+  }
+
+  std::shared_ptr<EventCalculatorType> m_event_calculator;
+  Index m_n_prim_events;
+  TableType const *m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// Number of leaves (power of 2)
+  Index m_capacity;
+
+  /// Number of threads used to build the sum tree
+  Index m_n_threads = 1;
+
+  /// Sum tree, root at index 1, children of node i at 2*i and 2*i+1, and
+  /// the rate of event with linear index j at m_capacity + j
+  std::vector<double> m_tree;
+
+  /// Events which may be selected
+  std::vector<EventID> m_event_id_list;
+
+  /// Whether the event with a given linear index may be selected
+  std::vector<bool> m_is_selectable;
+
+  /// Whether the event with a given linear index is in the event list but
+  /// disabled
+  std::vector<bool> m_is_disabled;
+
+  /// True if the rates impacted by m_selected_event_id are not updated yet
+  bool m_has_selected_event;
+  EventID m_selected_event_id;
+
+  // scratch space for batch updates
+  std::vector<Index> m_batch_linear_index;
+  std::vector<EventID> m_batch_event_id;
+  std::vector<double> m_batch_rate;
+  std::vector<Index> m_batch_node;
+
+  // deferred updates, used if m_immediate_table is not null
+  std::shared_ptr<RelativeEventImpactTable const> m_immediate_table;
+  Index m_update_interval = 1;
+  Index m_n_since_flush = 0;
+  std::vector<bool> m_is_pending;
+  std::vector<Index> m_pending_linear_index;
+  std::vector<Index> m_immediate_linear_index;
+  bool m_flush_pending_after_set = false;
+  double m_flush_sum_abs_error = 0.0;
+  DeferredUpdateDiagnostics m_diagnostics;
+
+  // superbasin acceleration, used if m_superbasin.n_recurrence > 0
+  SuperbasinParams m_superbasin;
+  /// Accumulated scale of each scaled event, by linear index
+  std::map<Index, double> m_scale;
+  /// Recurrences since the last scaling, by pair of linear indices
+  std::map<std::pair<Index, Index>, Index> m_pair_count;
+  /// Linear indices of the events in tracked pairs
+  std::set<Index> m_tracked;
+  /// Linear indices of the last two selected events, oldest first
+  Index m_history[2] = {0, 0};
+  Index m_n_history = 0;
+  SuperbasinDiagnostics m_superbasin_diagnostics;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,469 @@
+#ifndef CASM_clexmonte_events_SynchronousSublatticeEventSelector
+#define CASM_clexmonte_events_SynchronousSublatticeEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/SublatticeDecomposition.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Diagnostics of SynchronousSublatticeEventSelector
+struct SynchronousSublatticeDiagnostics {
+  /// \brief Time horizon of each phase, in local time
+  double time_horizon = 0.0;
+
+  /// \brief Number of cycles started
+  Index n_cycles = 0;
+
+  /// \brief Number of phases, one per sector per cycle
+  Index n_phases = 0;
+
+  /// \brief Number of events that occurred
+  Index n_events = 0;
+
+  /// \brief Maximum number of events that occurred in one task in one phase
+  Index max_task_events = 0;
+
+  /// \brief Number of events whose rates were recalculated at the start of
+  ///     a phase, because they were impacted by events in other tasks
+  Index n_boundary_updates = 0;
+};
+
+/// \brief Parallel KMC event selector using the synchronous sublattice
+///     algorithm
+///
+/// The supercell is partitioned into domains, each divided into sectors
+/// (see SublatticeDecomposition), and each domain has its own sum tree of
+/// event rates for each sector. A cycle consists of one phase per sector,
+/// in random order. In each phase, the domains are processed concurrently:
+/// for each domain, events in the phase's sector are selected and occur,
+/// using the domain's own random number stream, until the local time
+/// reaches the time horizon. The event that would occur after the time
+/// horizon is rejected. Events in the same sector of different domains are
+/// farther apart than the impact reach, so they do not interact.
+///
+/// While a phase runs, events are applied directly to `occupation`, so that
+/// later events in the same domain see them, and then `occupation` is
+/// restored. The events of the phase are then returned one at a time by
+/// `select_event`, in order of time, to be applied by the KMC loop (i.e.
+/// `monte::kinetic_monte_carlo`), which keeps `monte::OccLocation`, jump
+/// counts, and sampling consistent. After all events of a phase are
+/// returned, events in other sectors that they impacted are marked, and
+/// their rates are recalculated at the start of their next phase (the
+/// boundary event exchange).
+///
+/// Every region of the supercell evolves by the time horizon in each
+/// cycle, so each cycle advances the time by the time horizon. Within a
+/// cycle, the events of each phase are reported in consecutive
+/// sub-intervals of length `time_horizon / n_sectors`, so reported event
+/// times are accurate to within the time horizon. As for the synchronous
+/// sublattice algorithm in general, the result approaches serial KMC as the
+/// time horizon becomes small compared to the inverse rate of events in a
+/// sector.
+///
+/// Notes:
+/// - The random number stream of each domain is an independent stream (see
+///   `make_stream_engine`) of one seed drawn from the engine, so results are
+///   reproducible for a given seed and decomposition, and do not depend on
+///   the number of threads.
+/// - `total_rate` is the sum of the rates stored in all domains, which
+///   includes stale rates of events waiting for a boundary update.
+/// - Requires EventData to be stored for every event.
+///
+/// \tparam EventCalculatorType Must implement `void calculate_rates(
+///     std::vector<EventID> const &, std::vector<double> &)` and `void
+///     set_occurred_event(EventID const &)`. One calculator is used per
+///     thread, so calculators must not share mutable data.
+/// \tparam TableType Impact table type, for which
+///     `impacted_events(TableType const &, EventID const &)` is defined
+/// \tparam EngineType Random number engine type
+template <typename EventCalculatorType, typename TableType,
+          typename EngineType>
+class SynchronousSublatticeEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _event_calculators Event calculators, one per thread
+  /// \param _decomposition Domains and sectors, including only the events
+  ///     which may be selected
+  /// \param _n_prim_events Number of prim events
+  /// \param _impact_table The impact table, which must outlive the selector
+  /// \param _event_list The event list, which must store EventData and
+  ///     outlive the selector
+  /// \param _occupation The occupation, which rates are calculated for
+  /// \param _time_horizon Time horizon of each phase. If <= 0.0, the number
+  ///     of tasks divided by the initial total rate is used, so that about
+  ///     one event occurs per domain per phase.
+  /// \param _engine Random number engine, used to seed the domain random
+  ///     number streams and choose the order of sectors
+  SynchronousSublatticeEventSelector(
+      std::vector<std::shared_ptr<EventCalculatorType>> _event_calculators,
+      std::shared_ptr<SublatticeDecomposition const> _decomposition,
+      Index _n_prim_events, TableType const &_impact_table,
+      EventDataList const &_event_list, Eigen::VectorXi &_occupation,
+      double _time_horizon, std::shared_ptr<EngineType> _engine)
+      : m_event_calculators(std::move(_event_calculators)),
+        m_decomposition(std::move(_decomposition)),
+        m_n_prim_events(_n_prim_events),
+        m_impact_table(&_impact_table),
+        m_event_list(&_event_list),
+        m_occupation(&_occupation),
+        m_random_number_generator(_engine),
+        m_pool(std::max(Index(1), Index(m_event_calculators.size()))),
+        m_tasks(m_decomposition->n_tasks()),
+        m_is_dirty(_event_list.n_slots(), 0),
+        m_sector_order(m_decomposition->n_sectors()),
+        m_phase(0),
+        m_cycle_start(0.0),
+        m_time(0.0),
+        m_next(0) {
+    if (m_event_calculators.empty()) {
+      throw std::runtime_error(
+          "Error constructing SynchronousSublatticeEventSelector: no event "
+          "calculators");
+    }
+    if (!m_event_list->stores_event_data()) {
+      throw std::runtime_error(
+          "Error constructing SynchronousSublatticeEventSelector: requires "
+          "stored event data");
+    }
+
+    // independent random number streams for each domain
+    std::uint64_t stream_seed = (*_engine)();
+    for (Index d = 0; d < m_decomposition->n_domains(); ++d) {
+      m_domain_generators.emplace_back(
+          make_stream_engine<EngineType>(stream_seed, d));
+    }
+    for (Index s = 0; s < m_sector_order.size(); ++s) {
+      m_sector_order[s] = s;
+    }
+
+    // calculate all rates, one block of tasks per thread
+    Index n_tasks = m_tasks.size();
+    Index n_threads = m_pool.n_threads();
+    m_pool.run([&](Index t) {
+      auto &calculator = *m_event_calculators[t];
+      for (Index i = (n_tasks * t) / n_threads;
+           i < (n_tasks * (t + 1)) / n_threads; ++i) {
+        Task &task = m_tasks[i];
+        std::vector<EventID> const &events = m_decomposition->task_events(i);
+        task.capacity = 1;
+        while (task.capacity < events.size()) {
+          task.capacity *= 2;
+        }
+        task.tree.assign(2 * task.capacity, 0.0);
+        calculator.calculate_rates(events, task.batch_rate);
+        for (Index k = 0; k < events.size(); ++k) {
+          task.tree[task.capacity + k] = task.batch_rate[k];
+        }
+        for (Index node = task.capacity - 1; node > 0; --node) {
+          task.tree[node] = task.tree[2 * node] + task.tree[2 * node + 1];
+        }
+      }
+    });
+    _update_total_rate();
+    if (!(m_total_rate > 0.0)) {
+      std::stringstream msg;
+      msg << "Error constructing SynchronousSublatticeEventSelector: total "
+             "rate is "
+          << m_total_rate;
+      throw std::runtime_error(msg.str());
+    }
+    m_time_horizon =
+        (_time_horizon > 0.0) ? _time_horizon : n_tasks / m_total_rate;
+    m_diagnostics.time_horizon = m_time_horizon;
+  }
+
+  /// \brief Select the next event, running the next phase if all events of
+  ///     the current phase have been selected
+  ///
+  /// All previously selected events must have been applied to the
+  /// occupation before the next call.
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    while (m_next == m_queue.size()) {
+      _run_phase();
+    }
+    QueuedEvent const &queued = m_queue[m_next++];
+    double time_increment = queued.time - m_time;
+    m_time = queued.time;
+    return std::make_pair(queued.event_id, time_increment);
+  }
+
+  /// \brief Sum of the rates stored in all domains
+  double total_rate() const { return m_total_rate; }
+
+  /// \brief Time horizon of each phase, in local time
+  double time_horizon() const { return m_time_horizon; }
+
+  /// \brief Diagnostics
+  SynchronousSublatticeDiagnostics const &diagnostics() const {
+    return m_diagnostics;
+  }
+
+ private:
+  struct Task {
+    /// Number of leaves (power of 2)
+    Index capacity = 1;
+
+    /// Sum tree, root at index 1, and the rate of the event with local
+    /// index k at capacity + k
+    std::vector<double> tree;
+
+    /// Local indices of events impacted by events in other tasks
+    std::vector<Index> dirty;
+
+    /// Events that occurred in the last phase, with local time
+    std::vector<std::pair<EventID, double>> occurred;
+
+    /// (linear site index, previous occupation) of changes made to the
+    /// occupation in the last phase
+    std::vector<std::pair<Index, int>> changes;
+
+    // scratch space for batch updates
+    std::vector<Index> batch_local_index;
+    std::vector<EventID> batch_event_id;
+    std::vector<double> batch_rate;
+  };
+
+  struct QueuedEvent {
+    double time;
+    EventID event_id;
+  };
+
+  /// \brief Run the next phase concurrently, then queue its events
+  void _run_phase() {
+    SublatticeDecomposition const &decomposition = *m_decomposition;
+    Index n_sectors = decomposition.n_sectors();
+    Index n_domains = decomposition.n_domains();
+    if (m_phase == 0) {
+      // random order of sectors for this cycle
+      for (Index i = n_sectors - 1; i > 0; --i) {
+        Index j = m_random_number_generator.random_real(i + 1);
+        std::swap(m_sector_order[i], m_sector_order[std::min(j, i)]);
+      }
+      ++m_diagnostics.n_cycles;
+    }
+    Index sector_index = m_sector_order[m_phase];
+    double phase_start = m_cycle_start + m_phase * m_time_horizon / n_sectors;
+
+    Index n_threads = m_pool.n_threads();
+    m_pool.run([&](Index t) {
+      for (Index d = (n_domains * t) / n_threads;
+           d < (n_domains * (t + 1)) / n_threads; ++d) {
+        _run_task(*m_event_calculators[t], sector_index * n_domains + d, d);
+      }
+    });
+
+    // queue events in order of time, and mark events in other tasks
+    // impacted by them for update in their next phase
+    m_queue.clear();
+    m_next = 0;
+    for (Index d = 0; d < n_domains; ++d) {
+      Index task_index = sector_index * n_domains + d;
+      Task &task = m_tasks[task_index];
+      m_diagnostics.max_task_events = std::max(
+          m_diagnostics.max_task_events, Index(task.occurred.size()));
+      for (auto const &occurred : task.occurred) {
+        m_queue.push_back(QueuedEvent{
+            phase_start + occurred.second / n_sectors, occurred.first});
+        for (auto const &impacted :
+             impacted_events(*m_impact_table, occurred.first)) {
+          Index i = linear_index(impacted, m_n_prim_events);
+          Index other = decomposition.task_index(i);
+          if (other < 0 || other == task_index || m_is_dirty[i]) {
+            continue;
+          }
+          m_is_dirty[i] = 1;
+          m_tasks[other].dirty.push_back(decomposition.local_index(i));
+          ++m_diagnostics.n_boundary_updates;
+        }
+      }
+    }
+    std::stable_sort(m_queue.begin(), m_queue.end(),
+                     [](QueuedEvent const &lhs, QueuedEvent const &rhs) {
+                       return lhs.time < rhs.time;
+                     });
+    m_diagnostics.n_events += m_queue.size();
+    ++m_diagnostics.n_phases;
+
+    ++m_phase;
+    if (m_phase == n_sectors) {
+      m_phase = 0;
+      m_cycle_start += m_time_horizon;
+    }
+    _update_total_rate();
+    if (!(m_total_rate > 0.0)) {
+      std::stringstream msg;
+      msg << "Error in SynchronousSublatticeEventSelector::select_event: "
+             "total rate is "
+          << m_total_rate;
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  /// \brief Update boundary events, then select and apply events in one
+  ///     task until the time horizon, then restore the occupation
+  void _run_task(EventCalculatorType &calculator, Index task_index,
+                 Index domain_index) {
+    SublatticeDecomposition const &decomposition = *m_decomposition;
+    std::vector<EventID> const &events =
+        decomposition.task_events(task_index);
+    Task &task = m_tasks[task_index];
+    task.occurred.clear();
+    task.changes.clear();
+
+    // rates changed by events in other tasks
+    if (!task.dirty.empty()) {
+      task.batch_event_id.clear();
+      for (Index k : task.dirty) {
+        m_is_dirty[linear_index(events[k], m_n_prim_events)] = 0;
+        task.batch_event_id.push_back(events[k]);
+      }
+      calculator.calculate_rates(task.batch_event_id, task.batch_rate);
+      for (Index j = 0; j < task.dirty.size(); ++j) {
+        _set_leaf(task, task.dirty[j], task.batch_rate[j]);
+      }
+      task.dirty.clear();
+    }
+
+    auto &random_number_generator = m_domain_generators[domain_index];
+    Eigen::VectorXi &occupation = *m_occupation;
+    double time = 0.0;
+    while (task.tree[1] > 0.0) {
+      double total = task.tree[1];
+      double u = 1.0 - random_number_generator.random_real(1.0);
+      time += -std::log(u) / total;
+      if (time >= m_time_horizon) {
+        break;
+      }
+
+      // descend the tree, choosing child in proportion to subtree rate sums
+      double r = random_number_generator.random_real(total);
+      Index node = 1;
+      while (node < task.capacity) {
+        Index left = 2 * node;
+        if (r < task.tree[left] || !(task.tree[left + 1] > 0.0)) {
+          node = left;
+        } else {
+          r -= task.tree[left];
+          node = left + 1;
+        }
+      }
+      EventID const &event_id = events[node - task.capacity];
+
+      // apply the event to the occupation
+      monte::OccEvent const &event =
+          (*m_event_list)[linear_index(event_id, m_n_prim_events)].event;
+      for (Index i = 0; i < event.linear_site_index.size(); ++i) {
+        Index l = event.linear_site_index[i];
+        task.changes.emplace_back(l, occupation(l));
+        occupation(l) = event.new_occ[i];
+      }
+      task.occurred.emplace_back(event_id, time);
+
+      // update the impacted events of this task
+      calculator.set_occurred_event(event_id);
+      task.batch_local_index.clear();
+      for (auto const &impacted : impacted_events(*m_impact_table, event_id)) {
+        Index i = linear_index(impacted, m_n_prim_events);
+        if (decomposition.task_index(i) == task_index) {
+          task.batch_local_index.push_back(decomposition.local_index(i));
+        }
+      }
+      std::sort(task.batch_local_index.begin(), task.batch_local_index.end());
+      task.batch_local_index.erase(std::unique(task.batch_local_index.begin(),
+                                               task.batch_local_index.end()),
+                                   task.batch_local_index.end());
+      task.batch_event_id.clear();
+      for (Index k : task.batch_local_index) {
+        task.batch_event_id.push_back(events[k]);
+      }
+      calculator.calculate_rates(task.batch_event_id, task.batch_rate);
+      for (Index j = 0; j < task.batch_local_index.size(); ++j) {
+        _set_leaf(task, task.batch_local_index[j], task.batch_rate[j]);
+      }
+    }
+
+    // restore the occupation; the KMC loop applies the events again
+    for (auto it = task.changes.rbegin(); it != task.changes.rend(); ++it) {
+      occupation(it->first) = it->second;
+    }
+  }
+
+  /// \brief Set one leaf of a task's sum tree and update its ancestors
+  static void _set_leaf(Task &task, Index local_index, double value) {
+    Index node = task.capacity + local_index;
+    task.tree[node] = value;
+    for (node /= 2; node > 0; node /= 2) {
+      task.tree[node] = task.tree[2 * node] + task.tree[2 * node + 1];
+    }
+  }
+
+  void _update_total_rate() {
+    m_total_rate = 0.0;
+    for (Task const &task : m_tasks) {
+      m_total_rate += task.tree[1];
+    }
+  }
+
+  std::vector<std::shared_ptr<EventCalculatorType>> m_event_calculators;
+  std::shared_ptr<SublatticeDecomposition const> m_decomposition;
+  Index m_n_prim_events;
+  TableType const *m_impact_table;
+  EventDataList const *m_event_list;
+  Eigen::VectorXi *m_occupation;
+
+  /// Used to choose the order of sectors
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// Random number generators, one per domain
+  std::vector<monte::RandomNumberGenerator<EngineType>> m_domain_generators;
+
+  ThreadPool m_pool;
+  std::vector<Task> m_tasks;
+
+  /// 1 if the event with a given linear index is in its task's `dirty`
+  /// list. Note: unsigned char rather than bool, so that different tasks
+  /// may clear their events concurrently
+  std::vector<unsigned char> m_is_dirty;
+
+  /// Order of sectors in the current cycle
+  std::vector<Index> m_sector_order;
+
+  /// Index into m_sector_order of the next phase
+  Index m_phase;
+
+  double m_time_horizon;
+  double m_cycle_start;
+  double m_total_rate;
+
+  /// Time of the last selected event
+  double m_time;
+
+  /// Events of the last phase, and the index of the next to be selected
+  std::vector<QueuedEvent> m_queue;
+  Index m_next;
+
+  SynchronousSublatticeDiagnostics m_diagnostics;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
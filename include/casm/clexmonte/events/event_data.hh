@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_events_event_data
 #define CASM_clexmonte_events_event_data
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -32,9 +34,8 @@ struct EventData {
   /// \brief Used to apply event and track occupants in monte::OccLocation
   monte::OccEvent event;
 
-  // Note: To keep all event state values, uncomment this:
-  // /// \brief Holds the calculated event state
-  // mutable EventState event_state;
+  // Note: To keep all event state values, use the KMC option
+  // "store_event_states" (see kinetic::EventStateStore)
 };
 
 /// \brief Data common to all translationally equivalent events
@@ -73,6 +74,16 @@ struct EventImpactInfo {
   /// \brief The set of sites for which a change in DoF results in a
   ///     change in the event propensity
   std::set<xtal::UnitCellCoord> required_update_neighborhood;
+
+  /// \brief The subset of `required_update_neighborhood` for which a change
+  ///     in DoF results in a change in the event local cluster expansion
+  ///     values (i.e. "kra", "freq")
+  std::set<xtal::UnitCellCoord> local_clex_update_neighborhood;
+
+  /// \brief The subset of `required_update_neighborhood` for which a change
+  ///     in DoF results in a change in the event's change in energy
+  ///     (i.e. cluster expansions such as "formation_energy")
+  std::set<xtal::UnitCellCoord> clex_update_neighborhood;
 };
 
 /// \brief Identifies an event via translation from the `origin` unit cell
@@ -106,6 +117,89 @@ struct EventID {
 
 bool operator<(EventID const &lhs, EventID const &rhs);
 
+bool operator==(EventID const &lhs, EventID const &rhs);
+
+bool operator!=(EventID const &lhs, EventID const &rhs);
+
+/// \brief Non-owning view of the linear site indices of an event
+///
+/// Refers either to the `linear_site_index` of a monte::OccEvent, or to the
+/// structure-of-arrays site storage of EventDataList, so that event sites
+/// can be passed to rate calculations without being copied. The referenced
+/// indices must outlive the view.
+class EventSites {
+ public:
+  EventSites() : m_data(nullptr), m_size(0) {}
+
+  EventSites(Index const *_data, Index _size) : m_data(_data), m_size(_size) {}
+
+  EventSites(std::vector<Index> const &_sites)
+      : m_data(_sites.data()), m_size(_sites.size()) {}
+
+  Index const *data() const { return m_data; }
+
+  Index size() const { return m_size; }
+
+  Index operator[](Index i) const { return m_data[i]; }
+
+  Index const *begin() const { return m_data; }
+
+  Index const *end() const { return m_data + m_size; }
+
+ private:
+  Index const *m_data;
+  Index m_size;
+};
+
+/// \brief Identifies an event using a single 64-bit key
+///
+/// The unit cell index is stored in the upper `unitcell_index_bits` bits and
+/// the prim event index in the lower `prim_event_index_bits` bits, so that
+/// PackedEventID compares in the same order as EventID, at half the size.
+/// Use `pack` and `unpack` to convert between EventID and PackedEventID.
+struct PackedEventID {
+  static constexpr int prim_event_index_bits = 24;
+  static constexpr int unitcell_index_bits = 40;
+  static constexpr std::uint64_t prim_event_index_mask =
+      (std::uint64_t(1) << prim_event_index_bits) - 1;
+
+  /// \brief Maximum number of prim events that can be packed
+  static constexpr Index max_n_prim_events = Index(1)
+                                             << prim_event_index_bits;
+
+  /// \brief Maximum number of unit cells that can be packed
+  static constexpr Index max_n_unitcells = Index(1) << unitcell_index_bits;
+
+  std::uint64_t key;
+
+  Index prim_event_index() const { return key & prim_event_index_mask; }
+
+  Index unitcell_index() const { return key >> prim_event_index_bits; }
+};
+
+/// \brief Convert EventID to PackedEventID
+PackedEventID pack(EventID const &event_id);
+
+/// \brief Convert PackedEventID to EventID
+EventID unpack(PackedEventID const &packed_event_id);
+
+bool operator<(PackedEventID const &lhs, PackedEventID const &rhs);
+
+bool operator==(PackedEventID const &lhs, PackedEventID const &rhs);
+
+bool operator!=(PackedEventID const &lhs, PackedEventID const &rhs);
+
+/// \brief Event linear index, `unitcell_index * n_prim_events +
+///     prim_event_index`
+Index linear_index(EventID const &event_id, Index n_prim_events);
+
+/// \brief Event linear index, `unitcell_index * n_prim_events +
+///     prim_event_index`
+Index linear_index(PackedEventID const &event_id, Index n_prim_events);
+
+/// \brief Construct EventID from event linear index
+EventID make_event_id(Index linear_index, Index n_prim_events);
+
 // -- Inline definitions --
 
 inline bool operator<(RelativeEventID const &lhs, RelativeEventID const &rhs) {
@@ -128,7 +222,78 @@ inline bool operator<(EventID const &lhs, EventID const &rhs) {
   return lhs.prim_event_index < rhs.prim_event_index;
 }
 
+inline bool operator==(EventID const &lhs, EventID const &rhs) {
+  return lhs.unitcell_index == rhs.unitcell_index &&
+         lhs.prim_event_index == rhs.prim_event_index;
+}
+
+inline bool operator!=(EventID const &lhs, EventID const &rhs) {
+  return !(lhs == rhs);
+}
+
+/// Note: Does not check that the indices fit, see
+/// `PackedEventID::max_n_prim_events` and `PackedEventID::max_n_unitcells`
+inline PackedEventID pack(EventID const &event_id) {
+  return PackedEventID{
+      (std::uint64_t(event_id.unitcell_index)
+       << PackedEventID::prim_event_index_bits) |
+      std::uint64_t(event_id.prim_event_index)};
+}
+
+inline EventID unpack(PackedEventID const &packed_event_id) {
+  EventID event_id;
+  event_id.prim_event_index = packed_event_id.prim_event_index();
+  event_id.unitcell_index = packed_event_id.unitcell_index();
+  return event_id;
+}
+
+inline bool operator<(PackedEventID const &lhs, PackedEventID const &rhs) {
+  return lhs.key < rhs.key;
+}
+
+inline bool operator==(PackedEventID const &lhs, PackedEventID const &rhs) {
+  return lhs.key == rhs.key;
+}
+
+inline bool operator!=(PackedEventID const &lhs, PackedEventID const &rhs) {
+  return lhs.key != rhs.key;
+}
+
+inline Index linear_index(EventID const &event_id, Index n_prim_events) {
+  return event_id.unitcell_index * n_prim_events + event_id.prim_event_index;
+}
+
+inline Index linear_index(PackedEventID const &event_id, Index n_prim_events) {
+  return event_id.unitcell_index() * n_prim_events +
+         event_id.prim_event_index();
+}
+
+inline EventID make_event_id(Index linear_index, Index n_prim_events) {
+  EventID event_id;
+  event_id.unitcell_index = linear_index / n_prim_events;
+  event_id.prim_event_index = linear_index % n_prim_events;
+  return event_id;
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
+namespace std {
+
+template <>
+struct hash<CASM::clexmonte::PackedEventID> {
+  size_t operator()(CASM::clexmonte::PackedEventID const &id) const {
+    return std::hash<std::uint64_t>()(id.key);
+  }
+};
+
+template <>
+struct hash<CASM::clexmonte::EventID> {
+  size_t operator()(CASM::clexmonte::EventID const &id) const {
+    return std::hash<std::uint64_t>()(CASM::clexmonte::pack(id).key);
+  }
+};
+
+}  // namespace std
+
 #endif
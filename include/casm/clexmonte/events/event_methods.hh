@@ -51,6 +51,14 @@ monte::OccEvent &set_event(monte::OccEvent &event,
                            xtal::UnitCell const &translation,
                            monte::OccLocation const &occ_location);
 
+/// \brief Sets a monte::OccEvent consistent with the PrimEventData and
+/// OccLocation, using already calculated linear site indices
+monte::OccEvent &set_event(monte::OccEvent &event,
+                           PrimEventData const &prim_event_data,
+                           xtal::UnitCell const &translation,
+                           Index const *linear_site_index,
+                           monte::OccLocation const &occ_location);
+
 // --- Inline definitions ---
 
 /// \brief Make event required update neighborhood
@@ -70,8 +78,9 @@ EventImpactInfo make_event_impact_info(
   if (!event_type_data.local_multiclex_name.empty()) {
     LocalMultiClexData const &local_multiclex_data =
         get_local_multiclex_data(system, event_type_data.local_multiclex_name);
-    impact.required_update_neighborhood = get_required_update_neighborhood(
+    auto const &nhood = get_required_update_neighborhood(
         system, local_multiclex_data, prim_event_data.equivalent_index);
+    impact.local_clex_update_neighborhood.insert(nhood.begin(), nhood.end());
   }
 
   // include impact neighborhood to include clex
@@ -83,7 +92,7 @@ EventImpactInfo make_event_impact_info(
       msg << name << "' does not have cluster_info";
       throw std::runtime_error(msg.str());
     }
-    expand(phenom, impact.required_update_neighborhood, *clex_data.cluster_info,
+    expand(phenom, impact.clex_update_neighborhood, *clex_data.cluster_info,
            clex_data.coefficients);
   }
 
@@ -97,11 +106,16 @@ EventImpactInfo make_event_impact_info(
       throw std::runtime_error(msg.str());
     }
     for (auto const &coeffs : multiclex_data.coefficients) {
-      expand(phenom, impact.required_update_neighborhood,
+      expand(phenom, impact.clex_update_neighborhood,
              *multiclex_data.cluster_info, coeffs);
     }
   }
 
+  impact.required_update_neighborhood = impact.local_clex_update_neighborhood;
+  impact.required_update_neighborhood.insert(
+      impact.clex_update_neighborhood.begin(),
+      impact.clex_update_neighborhood.end());
+
   return impact;
 }
 
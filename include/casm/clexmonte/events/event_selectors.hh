@@ -0,0 +1,98 @@
+#ifndef CASM_clexmonte_events_event_selectors
+#define CASM_clexmonte_events_event_selectors
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "casm/clexmonte/events/CompositionRejectionEventSelector.hh"
+#include "casm/clexmonte/events/EventSelectorParams.hh"
+#include "casm/clexmonte/events/GroupedSumTreeEventSelector.hh"
+#include "casm/clexmonte/events/RejectionEventSelector.hh"
+#include "casm/clexmonte/events/SumTreeEventSelector.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/events/lotto.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Construct the event selector specified by `params`, and call
+///     `f(event_selector)`
+///
+/// \param params Specifies the event selector type
+/// \param event_calculator Calculates event rates
+/// \param n_unitcells Number of unit cells in the supercell
+/// \param n_prim_events Number of prim events
+/// \param event_id_list Events which may be selected. This is the explicit
+///     list of included events, rather than an index range, because
+///     lotto::RejectionFreeEventSelector only accepts a
+///     `std::vector<EventID>`, and the other selectors take the same list.
+/// \param impact_table Impact table. Must be
+///     `std::map<EventID, std::vector<EventID>>` for
+///     `EventSelectorType::lotto_rejection_free`, and is not used for
+///     `EventSelectorType::rejection`.
+/// \param engine Random number engine
+/// \param f Function called with the event selector, which is destroyed
+///     when `f` returns
+template <typename EventCalculatorType, typename TableType,
+          typename EngineType, typename F>
+void run_with_event_selector(
+    EventSelectorParams const &params,
+    std::shared_ptr<EventCalculatorType> event_calculator, Index n_unitcells,
+    Index n_prim_events, std::vector<EventID> const &event_id_list,
+    TableType const &impact_table, std::shared_ptr<EngineType> engine, F f) {
+  if (params.type == EventSelectorType::lotto_rejection_free) {
+    if constexpr (std::is_same_v<TableType,
+                                 std::map<EventID, std::vector<EventID>>>) {
+      lotto::RejectionFreeEventSelector event_selector(
+          event_calculator, event_id_list, impact_table,
+          std::make_shared<lotto::RandomGenerator>(engine));
+      f(event_selector);
+    } else {
+      throw std::runtime_error(
+          "Error in run_with_event_selector: the \"lotto_rejection_free\" "
+          "event selector requires the \"map\" impact table");
+    }
+  } else if (params.type == EventSelectorType::sum_tree) {
+    SumTreeEventSelector<EventCalculatorType, TableType, EngineType>
+        event_selector(event_calculator, n_unitcells, n_prim_events,
+                       event_id_list, impact_table, engine);
+    f(event_selector);
+  } else if (params.type == EventSelectorType::grouped_sum_tree) {
+    GroupedSumTreeEventSelector<EventCalculatorType, TableType, EngineType>
+        event_selector(event_calculator, n_unitcells, n_prim_events,
+                       event_id_list, impact_table, engine);
+    f(event_selector);
+  } else if (params.type == EventSelectorType::composition_rejection) {
+    CompositionRejectionEventSelector<EventCalculatorType, TableType,
+                                      EngineType>
+        event_selector(event_calculator, n_unitcells, n_prim_events,
+                       event_id_list, impact_table, engine);
+    f(event_selector);
+  } else if (params.type == EventSelectorType::rejection) {
+    RejectionEventSelector<EventCalculatorType, EngineType> event_selector(
+        event_calculator, event_id_list, params.max_rate,
+        params.max_rate_factor, engine);
+    f(event_selector);
+  } else if (params.type == EventSelectorType::defect) {
+    throw std::runtime_error(
+        "Error in run_with_event_selector: the \"defect\" event selector "
+        "requires constructing events on demand, and is only available for "
+        "KMC");
+  } else if (params.type == EventSelectorType::synchronous_sublattice) {
+    throw std::runtime_error(
+        "Error in run_with_event_selector: the \"synchronous_sublattice\" "
+        "event selector requires one event calculator per thread, and is only "
+        "available for KMC");
+  } else {
+    throw std::runtime_error(
+        "Error in run_with_event_selector: invalid event selector type");
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef CASM_clexmonte_events_CompleteEventListParams_json_io
+#define CASM_clexmonte_events_CompleteEventListParams_json_io
+
+namespace CASM {
+
+class jsonParser;
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+
+struct CompleteEventListParams;
+
+}  // namespace clexmonte
+
+jsonParser &to_json(clexmonte::CompleteEventListParams const &params,
+                    jsonParser &json);
+
+void parse(InputParser<clexmonte::CompleteEventListParams> &parser);
+
+void from_json(clexmonte::CompleteEventListParams &params,
+               jsonParser const &json);
+
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef CASM_clexmonte_events_EventSelectorParams_json_io
+#define CASM_clexmonte_events_EventSelectorParams_json_io
+
+namespace CASM {
+
+class jsonParser;
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+
+struct EventSelectorParams;
+
+}  // namespace clexmonte
+
+jsonParser &to_json(clexmonte::EventSelectorParams const &params,
+                    jsonParser &json);
+
+void parse(InputParser<clexmonte::EventSelectorParams> &parser);
+
+void from_json(clexmonte::EventSelectorParams &params,
+               jsonParser const &json);
+
+}  // namespace CASM
+
+#endif
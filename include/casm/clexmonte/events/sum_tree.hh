@@ -0,0 +1,82 @@
+#ifndef CASM_clexmonte_events_sum_tree
+#define CASM_clexmonte_events_sum_tree
+
+#include <algorithm>
+#include <vector>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+// Binary sum trees, as used by SumTreeEventSelector and
+// GroupedSumTreeEventSelector, are stored in one array of size
+// `2 * capacity`, with `capacity` a power of 2: the root is at index 1, the
+// children of node i are at 2*i and 2*i+1, and leaf j is at capacity + j.
+
+/// \brief Set all internal nodes of a binary sum tree from its leaves
+///
+/// Each level is summed once, from the leaves to the root, so this is
+/// O(capacity). With `n_threads > 1`, the levels below the top
+/// `log2(n_threads)` levels are split into contiguous blocks of subtrees,
+/// one per thread, which need no synchronization between levels; the top
+/// levels are then summed on the calling thread. The result does not depend
+/// on `n_threads`.
+///
+/// \param tree The sum tree, of size `2 * capacity`, with leaves set
+/// \param capacity Number of leaves (power of 2)
+/// \param n_threads Number of threads to use
+inline void build_sum_tree(std::vector<double> &tree, Index capacity,
+                           Index n_threads = 1) {
+  // number of subtrees summed independently
+  Index n_roots = 1;
+  while (n_roots < n_threads && n_roots < capacity / 2) {
+    n_roots *= 2;
+  }
+  parallel_for_blocks(n_roots, std::min(n_threads, n_roots),
+                      [&](Index begin, Index end, Index) {
+                        for (Index w = capacity / 2; w >= n_roots; w /= 2) {
+                          Index scale = w / n_roots;
+                          for (Index i = w + begin * scale;
+                               i < w + end * scale; ++i) {
+                            tree[i] = tree[2 * i] + tree[2 * i + 1];
+                          }
+                        }
+                      });
+  for (Index i = n_roots - 1; i > 0; --i) {
+    tree[i] = tree[2 * i] + tree[2 * i + 1];
+  }
+}
+
+/// \brief Update the ancestors of changed nodes of a binary sum tree
+///
+/// Parents are updated level by level, so each ancestor shared by several
+/// changed nodes is summed once per call, rather than once per changed
+/// node. Updating k leaves costs O(number of distinct ancestors), which is
+/// at most O(k * log(capacity)) and much less when the changed leaves are
+/// close together, as the events impacted by one event usually are.
+///
+/// \param tree The sum tree
+/// \param nodes Sorted, unique indices of the changed nodes, which must all
+///     be in the same level, for example leaves `capacity + j`. Used as
+///     scratch space; on return it is empty or contains only the root.
+inline void update_sum_tree_ancestors(std::vector<double> &tree,
+                                      std::vector<Index> &nodes) {
+  while (!nodes.empty() && nodes[0] > 1) {
+    Index n_parents = 0;
+    for (Index i : nodes) {
+      Index parent = i / 2;
+      if (n_parents == 0 || nodes[n_parents - 1] != parent) {
+        nodes[n_parents++] = parent;
+        tree[parent] = tree[2 * parent] + tree[2 * parent + 1];
+      }
+    }
+    nodes.resize(n_parents);
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
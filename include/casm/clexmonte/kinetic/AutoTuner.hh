@@ -0,0 +1,72 @@
+#ifndef CASM_clexmonte_kinetic_AutoTuner
+#define CASM_clexmonte_kinetic_AutoTuner
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Chooses the fastest of several candidate sets of KMC options for
+///     each supercell
+///
+/// The first time a supercell is seen by `choose`, the steps per second of
+/// each candidate is obtained from a calibration function, and the
+/// candidate with the most steps per second is chosen for that supercell.
+/// Candidates whose calibration throws are skipped. Later calls for the same
+/// supercell return the same choice without calibrating.
+///
+/// The calibration results of each tuned supercell are kept, and, if
+/// `output_file` is not empty, written to it after each is tuned.
+class AutoTuner {
+ public:
+  /// \brief Returns the steps per second of the candidate with the given
+  ///     index, or throws if its calibration fails
+  typedef std::function<double(Index candidate_index)> steps_per_second_f_type;
+
+  /// \brief Constructor
+  AutoTuner(std::vector<jsonParser> _candidate_values, Index _n_steps,
+            std::string _output_file = "");
+
+  /// \brief The options given for each candidate, as written to results
+  std::vector<jsonParser> const candidate_values;
+
+  /// \brief Number of steps timed for each candidate, as written to results
+  Index const n_steps;
+
+  /// \brief If not empty, results are written to this file
+  std::string const output_file;
+
+  /// \brief Index of the candidate whose options are in use, or -1
+  Index applied = -1;
+
+  /// \brief Index of the fastest candidate for a supercell, calibrating if
+  ///     the supercell has not been tuned yet
+  Index choose(Eigen::Matrix3l const &transformation_matrix_to_super,
+               steps_per_second_f_type const &steps_per_second_f);
+
+  /// \brief Calibration results of each tuned supercell
+  jsonParser const &results() const { return m_results; }
+
+ private:
+  Index _calibrate(Eigen::Matrix3l const &transformation_matrix_to_super,
+                   steps_per_second_f_type const &steps_per_second_f);
+
+  /// Supercells tuned so far, with the index of the fastest candidate
+  std::vector<std::pair<Eigen::Matrix3l, Index>> m_choices;
+
+  jsonParser m_results;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
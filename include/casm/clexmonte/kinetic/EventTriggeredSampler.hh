@@ -0,0 +1,200 @@
+#ifndef CASM_clexmonte_kinetic_EventTriggeredSampler
+#define CASM_clexmonte_kinetic_EventTriggeredSampler
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+
+class jsonParser;
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Parameters for event-triggered sampling
+struct EventTriggeredSamplingParams {
+  /// \brief Prim event indices of the events which trigger a sample
+  std::set<Index> prim_event_index;
+
+  /// \brief Event type names of the events which trigger a sample
+  std::set<std::string> event_type_name;
+
+  /// \brief Names of the sampling functions evaluated for each sample
+  std::vector<std::string> sampler_names;
+
+  /// \brief If not empty, the samples of each run are written to this
+  ///     file at the end of the run, overwriting it
+  fs::path output_file;
+};
+
+/// \brief Samples the state of a KMC run after each occurrence of selected
+///     events
+///
+/// Count and time based sampling must sample often to catch the state
+/// after rare events, such as solute jumps. An EventTriggeredSampler
+/// instead evaluates its sampling functions only after events of selected
+/// prim events or event types:
+///
+/// - `reset` begins a run, and sets a bitmask, by prim event index, of the
+///   events which trigger a sample, so checking a selected event is O(1).
+/// - `record` is called with each selected event and the time at which it
+///   occurs. If it triggers a sample, the sample is pending until the event
+///   has been applied.
+/// - `sample_if_pending` is called before the next event is selected, and
+///   at the end of the run, and takes the pending sample, so the sampled
+///   state is the state just after the triggering event.
+///
+/// EventTriggeredSamplingSelector makes these calls for a KMC run. Samples
+/// are kept separately from the sampling fixtures, which sample by count or
+/// time in `monte::kinetic_monte_carlo`.
+///
+/// Notes:
+/// - Sampling functions which use data kept per sampling fixture, such as
+///   the displacement based "mean_R_squared_*", "L_*", and "D_tracer_*",
+///   cannot be used.
+class EventTriggeredSampler {
+ public:
+  /// \brief Constructor
+  EventTriggeredSampler(
+      EventTriggeredSamplingParams _params,
+      std::map<std::string, state_sampling_function_type> const
+          &sampling_functions);
+
+  /// \brief Parameters
+  EventTriggeredSamplingParams const params;
+
+  /// \brief Begin a run
+  void reset(std::vector<std::string> const &prim_event_type_names);
+
+  /// \brief Check if events of a prim event trigger a sample
+  bool is_trigger(Index prim_event_index) const {
+    return m_is_trigger[prim_event_index];
+  }
+
+  /// \brief Record a selected event, which occurs at `event_time`
+  void record(Index prim_event_index, double event_time) {
+    ++m_n_events;
+    if (m_is_trigger[prim_event_index]) {
+      m_pending_prim_event_index = prim_event_index;
+      m_pending_time = event_time;
+      m_pending_n_events = m_n_events;
+    }
+  }
+
+  /// \brief Take the pending sample, if there is one
+  void sample_if_pending() {
+    if (m_pending_prim_event_index >= 0) {
+      _sample();
+    }
+  }
+
+  /// \brief Number of samples of the current or last run
+  Index n_samples() const { return m_sample_time.size(); }
+
+  /// \brief Time of the triggering event of each sample
+  std::vector<double> const &sample_time() const { return m_sample_time; }
+
+  /// \brief Number of events since the start of the run, including the
+  ///     triggering event, of each sample
+  std::vector<Index> const &sample_n_events() const {
+    return m_sample_n_events;
+  }
+
+  /// \brief Prim event index of the triggering event of each sample
+  std::vector<Index> const &sample_prim_event_index() const {
+    return m_sample_prim_event_index;
+  }
+
+  /// \brief Sampled values, as a matrix with one row per sample
+  Eigen::MatrixXd values(std::string const &sampler_name) const;
+
+  /// \brief Sampling functions, by name
+  std::map<std::string, state_sampling_function_type> const &
+  sampling_functions() const {
+    return m_sampling_functions;
+  }
+
+ private:
+  void _sample();
+
+  std::map<std::string, state_sampling_function_type> m_sampling_functions;
+
+  /// Bitmask, by prim event index, of the events which trigger a sample
+  std::vector<bool> m_is_trigger;
+
+  /// Number of events recorded since the start of the run
+  Index m_n_events = 0;
+
+  /// Prim event index, time, and event number of the pending sample, with
+  /// index -1 if none is pending
+  Index m_pending_prim_event_index = -1;
+  double m_pending_time = 0.0;
+  Index m_pending_n_events = 0;
+
+  std::vector<double> m_sample_time;
+  std::vector<Index> m_sample_n_events;
+  std::vector<Index> m_sample_prim_event_index;
+  std::map<std::string, std::vector<Eigen::VectorXd>> m_values;
+};
+
+/// \brief Write EventTriggeredSampler samples to JSON
+jsonParser &to_json(EventTriggeredSampler const &sampler, jsonParser &json);
+
+/// \brief Event selector wrapper which drives an EventTriggeredSampler
+///
+/// Used with `monte::kinetic_monte_carlo`, which applies each selected
+/// event before selecting the next, so a sample pending from the previous
+/// event is taken from the state after that event was applied. Time is
+/// measured from the construction of the EventTriggeredSamplingSelector.
+/// Call `sampler->sample_if_pending()` after the run to take a sample
+/// triggered by the last event.
+template <typename SelectorType>
+class EventTriggeredSamplingSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _selector The event selector, which must outlive the
+  ///     EventTriggeredSamplingSelector
+  /// \param _sampler The sampler, already `reset` for the run
+  EventTriggeredSamplingSelector(
+      SelectorType &_selector, std::shared_ptr<EventTriggeredSampler> _sampler)
+      : m_selector(&_selector), m_sampler(std::move(_sampler)), m_time(0.0) {
+    if (!m_sampler) {
+      throw std::runtime_error(
+          "Error constructing EventTriggeredSamplingSelector: sampler is "
+          "empty");
+    }
+  }
+
+  /// \brief Take a pending sample, then select an event and record it
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    m_sampler->sample_if_pending();
+    std::pair<EventID, double> result = m_selector->select_event();
+    m_time += result.second;
+    m_sampler->record(result.first.prim_event_index, m_time);
+    return result;
+  }
+
+ private:
+  SelectorType *m_selector;
+  std::shared_ptr<EventTriggeredSampler> m_sampler;
+  double m_time;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
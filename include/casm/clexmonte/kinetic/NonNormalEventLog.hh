@@ -0,0 +1,108 @@
+#ifndef CASM_clexmonte_kinetic_NonNormalEventLog
+#define CASM_clexmonte_kinetic_NonNormalEventLog
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Counts non-normal events and writes a limited number of examples
+///
+/// Non-normal events are counted by prim event index. Only the first
+/// `max_examples` non-normal events are written in full, so in the common
+/// case the cost of a non-normal event is incrementing two counters.
+///
+/// Examples are written to `out` either directly, or, if `async` is true,
+/// by a background writer thread, so that the thread calculating event
+/// rates does not wait on I/O.
+///
+/// Notes:
+/// - Counting and writing are thread-safe, so one NonNormalEventLog may be
+///   shared by several CompleteEventCalculator
+/// - Expected to be constructed as shared_ptr
+class NonNormalEventLog {
+ public:
+  NonNormalEventLog(Index _n_prim_events, Index _max_examples,
+                    std::ostream &_out, bool _async = false);
+
+  ~NonNormalEventLog();
+
+  NonNormalEventLog(NonNormalEventLog const &) = delete;
+  NonNormalEventLog &operator=(NonNormalEventLog const &) = delete;
+
+  /// \brief Count a non-normal event, and return true if it should be
+  ///     written as an example
+  bool count(Index prim_event_index);
+
+  /// \brief Write an example
+  void write(std::string message);
+
+  /// \brief Wait until all examples have been written
+  void flush();
+
+  /// \brief Total number of non-normal events counted
+  Index total_count() const;
+
+  /// \brief Number of non-normal events counted, for one prim event
+  Index count_by_prim_event(Index prim_event_index) const;
+
+  /// \brief Number of non-normal events counted, for each prim event
+  std::vector<Index> counts_by_prim_event() const;
+
+  /// \brief Print number of non-normal events by prim event
+  void print_summary(std::ostream &sout) const;
+
+  /// \brief Maximum number of examples written, or -1 for no limit
+  Index max_examples() const { return m_max_examples; }
+
+  /// \brief True if examples are written by a background thread
+  bool async() const { return m_writer.joinable(); }
+
+ private:
+  void _run_writer();
+
+  Index m_max_examples;
+  std::ostream &m_out;
+
+  std::atomic<Index> m_total_count;
+  std::vector<std::atomic<Index>> m_count_by_prim_event;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::string> m_queue;
+  bool m_writing;
+  bool m_stop;
+  std::thread m_writer;
+};
+
+// -- Inline definitions --
+
+/// \brief Count a non-normal event, and return true if it should be
+///     written as an example
+///
+/// \param prim_event_index Index of the non-normal event's prim event
+///
+/// \returns True if fewer than `max_examples` non-normal events have been
+///     counted before this one.
+inline bool NonNormalEventLog::count(Index prim_event_index) {
+  m_count_by_prim_event[prim_event_index].fetch_add(1,
+                                                    std::memory_order_relaxed);
+  Index previous = m_total_count.fetch_add(1, std::memory_order_relaxed);
+  return m_max_examples < 0 || previous < m_max_examples;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef CASM_clexmonte_kinetic_SelectiveAtomTracker
+#define CASM_clexmonte_kinetic_SelectiveAtomTracker
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/events/OccEvent.hh"
+
+namespace CASM {
+namespace monte {
+class OccLocation;
+}
+
+namespace occ_events {
+struct OccSystem;
+}
+
+namespace xtal {
+class BasicStructure;
+}
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Calculates unwrapped cartesian displacements of atom trajectories
+///
+/// Linear site indices are `l = b * n_unitcells + unitcell_index`, as in
+/// `monte::Conversions`.
+class AtomDisplacementCalculator {
+ public:
+  /// \brief Constructor
+  AtomDisplacementCalculator(xtal::BasicStructure const &prim,
+                             Index _n_unitcells);
+
+  /// \brief Number of unit cells in the supercell
+  Index const n_unitcells;
+
+  /// \brief Cartesian coordinates of the prim basis sites,
+  ///     shape=(3, n_basis)
+  Eigen::MatrixXd const &basis_cart() const { return m_basis_cart; }
+
+  /// \brief Prim lattice vectors, as columns
+  Eigen::Matrix3d const &lattice_column_mat() const {
+    return m_lattice_column_mat;
+  }
+
+  /// \brief Cartesian displacement of an atom trajectory
+  Eigen::Vector3d operator()(monte::AtomTraj const &traj) const {
+    Index b_from = traj.from.l / n_unitcells;
+    Index b_to = traj.to.l / n_unitcells;
+    return m_basis_cart.col(b_to) - m_basis_cart.col(b_from) +
+           m_lattice_column_mat * traj.delta_ijk.cast<double>();
+  }
+
+ private:
+  Eigen::MatrixXd m_basis_cart;
+  Eigen::Matrix3d m_lattice_column_mat;
+};
+
+/// \brief Tracks the positions of only the atoms of selected types during
+///     kinetic Monte Carlo
+///
+/// `monte::OccLocation` atom tracking (`update_species == true`) follows
+/// every atom, which for solvent-rich systems is most of the cost of
+/// applying an event. SelectiveAtomTracker follows only the atoms whose
+/// name is in `tracked_atom_names`, such as a solute, by applying the
+/// atom trajectories of each event that move a tracked atom. It only uses
+/// the site indices of the trajectories, so it may be used with an
+/// `monte::OccLocation` that does not track atoms.
+///
+/// Positions are cartesian and unwrapped, so that displacements across
+/// periodic boundaries accumulate. Tracked atoms are indexed in the order
+/// found by `reset`, and this order does not change while events are
+/// applied.
+class SelectiveAtomTracker {
+ public:
+  /// \brief Constructor
+  explicit SelectiveAtomTracker(std::set<std::string> _tracked_atom_names);
+
+  /// \brief Names of the tracked atom types
+  std::set<std::string> const tracked_atom_names;
+
+  /// \brief Find the tracked atoms in the current occupation
+  void reset(monte::OccLocation const &occ_location,
+             occ_events::OccSystem const &occ_system,
+             xtal::BasicStructure const &prim);
+
+  /// \brief Move the tracked atoms of an event
+  void apply(monte::OccEvent const &event);
+
+  /// \brief Number of tracked atoms
+  Index size() const { return m_atom_name_index_list.size(); }
+
+  /// \brief Unwrapped cartesian positions of the tracked atoms,
+  ///     shape=(3, size())
+  Eigen::MatrixXd const &atom_positions_cart() const {
+    return m_atom_positions_cart;
+  }
+
+  /// \brief Atom name index (as in `occ_events::OccSystem::atom_name_list`)
+  ///     of each tracked atom
+  std::vector<Index> const &atom_name_index_list() const {
+    return m_atom_name_index_list;
+  }
+
+  /// \brief Tracked atoms moved by the last event applied
+  std::vector<Index> const &moved_atoms() const { return m_moved_atoms; }
+
+  /// \brief Displacements of `moved_atoms()` by the last event applied
+  std::vector<Eigen::Vector3d> const &moved_atom_displacements() const {
+    return m_moved_atom_displacements;
+  }
+
+ private:
+  std::unique_ptr<AtomDisplacementCalculator> m_displacement_f;
+
+  /// Maximum number of atoms in an occupant
+  Index m_max_n_components;
+
+  /// Tracked atom at `l * m_max_n_components + mol_comp`, or -1
+  std::vector<Index> m_site_atom;
+
+  Eigen::MatrixXd m_atom_positions_cart;
+  std::vector<Index> m_atom_name_index_list;
+  std::vector<Index> m_moved_atoms;
+  std::vector<Eigen::Vector3d> m_moved_atom_displacements;
+
+  /// Scratch space, the tracked atom at the start of each trajectory
+  std::vector<Index> m_traj_atom;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
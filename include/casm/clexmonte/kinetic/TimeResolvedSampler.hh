@@ -0,0 +1,230 @@
+#ifndef CASM_clexmonte_kinetic_TimeResolvedSampler
+#define CASM_clexmonte_kinetic_TimeResolvedSampler
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+
+class jsonParser;
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Parameters for time-resolved sampling
+struct TimeResolvedSamplingParams {
+  /// \brief Time between samples, which are taken at times
+  ///     `begin + k * period`, for k = 0, 1, ...
+  double period = 1.0;
+
+  /// \brief Time of the first sample
+  double begin = 0.0;
+
+  /// \brief Names of the sampling functions evaluated for each sample
+  std::vector<std::string> sampler_names;
+
+  /// \brief If true, after each sample the number of events expected
+  ///     before the next sample time is estimated from the event rate since
+  ///     the previous sample, and the sample time is not checked for
+  ///     `lookahead_fraction` of those events
+  bool lookahead = true;
+
+  /// \brief Fraction, in (0, 1], of the expected number of events before the
+  ///     next sample time for which the sample time is not checked
+  double lookahead_fraction = 0.5;
+
+  /// \brief Minimum number of events since the previous sample for the
+  ///     event rate to be used to skip checks
+  Index lookahead_min_events = 100;
+
+  /// \brief If true, a sample time passed while checks were skipped is
+  ///     sampled by linear interpolation between the previous sample and
+  ///     the current state; otherwise the current state is sampled
+  bool interpolate = false;
+
+  /// \brief If not empty, the samples of each run are written to this
+  ///     file at the end of the run, overwriting it
+  fs::path output_file;
+};
+
+/// \brief Samples the state of a KMC run at regular times, with an
+///     event-count lookahead
+///
+/// The state of a KMC run is constant between events, so the sample at a
+/// sample time is exact if it is taken from the state before the first
+/// event after the sample time is applied. This requires comparing the time
+/// of each event with the next sample time. With many events per sample, a
+/// TimeResolvedSampler instead estimates, after each sample, how many events
+/// remain until the next sample time from the event rate since the previous
+/// sample, and skips the comparison for `params.lookahead_fraction` of
+/// them:
+///
+/// - `reset` begins a run, at time 0.0.
+/// - `record` is called with the time of each selected event, before the
+///   event is applied. While checks are skipped it only counts the event;
+///   otherwise, each sample time at or before the event time is sampled.
+///
+/// The sample times passed during skipped checks are detected at the next
+/// check. That is rare with `lookahead_fraction` well below 1, because the
+/// number of events in a time interval varies little when it is large, but
+/// can happen when the event rate decreases. Those samples are not exact:
+/// by default they are the current state, or, with `params.interpolate`,
+/// the linear interpolation of the sampled values between the previous
+/// sample and the current state. Samples which are not exact are marked in
+/// `sample_is_exact`.
+///
+/// TimeResolvedSamplingSelector makes these calls for a KMC run. Samples
+/// are kept separately from the sampling fixtures, which sample by count or
+/// time in `monte::kinetic_monte_carlo`.
+///
+/// Notes:
+/// - Sampling functions which use data kept per sampling fixture, such as
+///   the displacement based "mean_R_squared_*", "L_*", and "D_tracer_*",
+///   cannot be used.
+class TimeResolvedSampler {
+ public:
+  /// \brief Constructor
+  TimeResolvedSampler(TimeResolvedSamplingParams _params,
+                      std::map<std::string, state_sampling_function_type> const
+                          &sampling_functions);
+
+  /// \brief Parameters
+  TimeResolvedSamplingParams const params;
+
+  /// \brief Begin a run
+  void reset();
+
+  /// \brief Record a selected event, which occurs at `event_time`, before
+  ///     it is applied
+  void record(double event_time) {
+    ++m_n_events;
+    if (m_n_skip > 0) {
+      --m_n_skip;
+      m_time = event_time;
+      return;
+    }
+    _check(event_time);
+  }
+
+  /// \brief Number of times the event time was compared with the next
+  ///     sample time in the current or last run
+  Index n_checks() const { return m_n_checks; }
+
+  /// \brief Number of samples of the current or last run
+  Index n_samples() const { return m_sample_time.size(); }
+
+  /// \brief Time of each sample
+  std::vector<double> const &sample_time() const { return m_sample_time; }
+
+  /// \brief Number of events applied before each sample
+  std::vector<Index> const &sample_n_events() const {
+    return m_sample_n_events;
+  }
+
+  /// \brief For each sample, true if it is the state at the sample time,
+  ///     false if the sample time was passed while checks were skipped
+  std::vector<bool> const &sample_is_exact() const {
+    return m_sample_is_exact;
+  }
+
+  /// \brief Sampled values, as a matrix with one row per sample
+  Eigen::MatrixXd values(std::string const &sampler_name) const;
+
+  /// \brief Sampling functions, by name
+  std::map<std::string, state_sampling_function_type> const &
+  sampling_functions() const {
+    return m_sampling_functions;
+  }
+
+ private:
+  void _check(double event_time);
+
+  void _sample(double sample_time, Index n_events_applied, bool is_exact,
+               std::map<std::string, Eigen::VectorXd> const &current);
+
+  std::map<std::string, state_sampling_function_type> m_sampling_functions;
+
+  /// Time of the last recorded event, or 0.0 at the start of a run
+  double m_time = 0.0;
+
+  /// Number of events recorded since the start of the run
+  Index m_n_events = 0;
+
+  /// Index and time of the next sample
+  Index m_next_sample_index = 0;
+  double m_next_sample_time = 0.0;
+
+  /// Number of events for which the sample time is not checked
+  Index m_n_skip = 0;
+
+  /// Number of checks
+  Index m_n_checks = 0;
+
+  /// Event time and number of events of the last check which sampled, from
+  /// which the event rate is estimated
+  double m_rate_ref_time = 0.0;
+  Index m_rate_ref_n_events = 0;
+
+  std::vector<double> m_sample_time;
+  std::vector<Index> m_sample_n_events;
+  std::vector<bool> m_sample_is_exact;
+  std::map<std::string, std::vector<Eigen::VectorXd>> m_values;
+};
+
+/// \brief Write TimeResolvedSampler samples to JSON
+jsonParser &to_json(TimeResolvedSampler const &sampler, jsonParser &json);
+
+/// \brief Event selector wrapper which drives a TimeResolvedSampler
+///
+/// Used with `monte::kinetic_monte_carlo`, which applies each selected
+/// event before selecting the next, so the sampler is called with the
+/// state from before the selected event is applied. Time is measured from
+/// the construction of the TimeResolvedSamplingSelector.
+template <typename SelectorType>
+class TimeResolvedSamplingSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _selector The event selector, which must outlive the
+  ///     TimeResolvedSamplingSelector
+  /// \param _sampler The sampler, already `reset` for the run
+  TimeResolvedSamplingSelector(SelectorType &_selector,
+                               std::shared_ptr<TimeResolvedSampler> _sampler)
+      : m_selector(&_selector), m_sampler(std::move(_sampler)), m_time(0.0) {
+    if (!m_sampler) {
+      throw std::runtime_error(
+          "Error constructing TimeResolvedSamplingSelector: sampler is "
+          "empty");
+    }
+  }
+
+  /// \brief Select an event and record it
+  ///
+  /// \returns (event_id, time_increment)
+  std::pair<EventID, double> select_event() {
+    std::pair<EventID, double> result = m_selector->select_event();
+    m_time += result.second;
+    m_sampler->record(m_time);
+    return result;
+  }
+
+ private:
+  SelectorType *m_selector;
+  std::shared_ptr<TimeResolvedSampler> m_sampler;
+  double m_time;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef CASM_clexmonte_kinetic_clex_kernel
+#define CASM_clexmonte_kinetic_clex_kernel
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "casm/clexulator/SparseCoefficients.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+class RuntimeLibrary;
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief The coefficients of one or more cluster expansions, flattened
+///     into contiguous arrays
+///
+/// The coefficients of property `p` are
+/// `index[k]`, `value[k]`, for `offsets[p] <= k < offsets[p+1]`.
+struct FlatCoefficientTable {
+  /// \brief Number of properties, i.e. cluster expansions
+  Index n_properties = 0;
+
+  /// \brief Number of correlations required, one more than the largest
+  ///     correlation index of any property
+  Index n_corr = 0;
+
+  /// \brief Start of the coefficients of each property, size
+  ///     `n_properties + 1`
+  std::vector<Index> offsets;
+
+  /// \brief Correlation index of each coefficient
+  std::vector<Index> index;
+
+  /// \brief Value of each coefficient
+  std::vector<double> value;
+};
+
+/// \brief Flatten the coefficients of cluster expansions, one per property
+FlatCoefficientTable make_flat_coefficient_table(
+    std::vector<clexulator::SparseCoefficients> const &coefficients);
+
+/// \brief Evaluate cluster expansions for a batch of correlation vectors
+void evaluate_clex_batch(FlatCoefficientTable const &table, Index n,
+                         double const *corr, double *values);
+
+/// \brief Write the source of a batch kernel specialized for fixed
+///     coefficients
+void write_specialized_clex_kernel_source(std::ostream &sout,
+                                          FlatCoefficientTable const &table,
+                                          std::string const &function_name);
+
+/// \brief A batch kernel, equivalent to `evaluate_clex_batch`, compiled for
+///     fixed coefficients
+///
+/// For basis sets and coefficients which do not change between many runs,
+/// the coefficient indices and values are written to a source file as
+/// `constexpr` tables, with only the nonzero coefficients of each property,
+/// and the loop over coefficients is fully unrolled, so that the compiler
+/// can vectorize the loop over events with all coefficients known. The
+/// source file is compiled with `RuntimeLibrary` and loaded.
+///
+/// The source and library file names include a hash of the source, so a
+/// compiled kernel is reused by later runs with the same coefficients, and
+/// a change of coefficients makes a new one.
+class SpecializedClexKernel {
+ public:
+  /// \brief Constructor, compiling the kernel if necessary
+  SpecializedClexKernel(FlatCoefficientTable const &_table, fs::path dirpath,
+                        std::string name, std::string compile_options = "",
+                        std::string so_options = "");
+
+  /// \brief The coefficients
+  FlatCoefficientTable const table;
+
+  /// \brief Evaluate cluster expansions for a batch of correlation vectors,
+  ///     as `evaluate_clex_batch(table, n, corr, values)`
+  void operator()(Index n, double const *corr, double *values) const {
+    m_f(n, corr, values);
+  }
+
+ private:
+  std::shared_ptr<RuntimeLibrary> m_lib;
+  std::function<void(Index, double const *, double *)> m_f;
+};
+
+/// \brief Correlations and cluster expansion values of a batch of events,
+///     in structure-of-arrays layout
+///
+/// The correlations may be point correlations, for local cluster expansion
+/// values, or changes in correlations, for changes in property values.
+struct ClexBatch {
+  /// \brief Correlations, `corr[j * size() + i]` is correlation `j` of
+  ///     event `i`
+  std::vector<double> corr;
+
+  /// \brief Values, `values[p * size() + i]` is the value of property `p`
+  ///     for event `i`, set by `calculate`
+  std::vector<double> values;
+
+  /// \brief Number of events
+  Index size() const { return m_size; }
+
+  /// \brief Set the number of events and correlations, setting all
+  ///     correlations to 0.0
+  void resize(Index _size, Index _n_corr) {
+    m_size = _size;
+    m_n_corr = _n_corr;
+    corr.assign(m_size * m_n_corr, 0.0);
+  }
+
+  /// \brief Set the correlations of event `i` from the first `n_corr`
+  ///     values of `_corr`
+  void set_corr(Index i, double const *_corr) {
+    for (Index j = 0; j < m_n_corr; ++j) {
+      corr[j * m_size + i] = _corr[j];
+    }
+  }
+
+  /// \brief Value of property `p` for event `i`
+  double value(Index p, Index i) const { return values[p * m_size + i]; }
+
+  /// \brief Evaluate all cluster expansions for all events
+  ///
+  /// Requires `table.n_corr` <= the number of correlations set by `resize`.
+  void calculate(FlatCoefficientTable const &table) {
+    values.resize(table.n_properties * m_size);
+    evaluate_clex_batch(table, m_size, corr.data(), values.data());
+  }
+
+  /// \brief Evaluate all cluster expansions for all events, with a
+  ///     specialized kernel
+  ///
+  /// Requires `kernel.table.n_corr` <= the number of correlations set by
+  /// `resize`.
+  void calculate(SpecializedClexKernel const &kernel) {
+    values.resize(kernel.table.n_properties * m_size);
+    kernel(m_size, corr.data(), values.data());
+  }
+
+ private:
+  Index m_size = 0;
+  Index m_n_corr = 0;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
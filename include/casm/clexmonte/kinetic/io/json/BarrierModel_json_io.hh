@@ -0,0 +1,28 @@
+#ifndef CASM_clexmonte_kinetic_BarrierModel_json_io
+#define CASM_clexmonte_kinetic_BarrierModel_json_io
+
+namespace CASM {
+
+class jsonParser;
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+namespace kinetic {
+
+struct BarrierModel;
+
+}  // namespace kinetic
+}  // namespace clexmonte
+
+jsonParser &to_json(clexmonte::kinetic::BarrierModel const &model,
+                    jsonParser &json);
+
+void parse(InputParser<clexmonte::kinetic::BarrierModel> &parser);
+
+void from_json(clexmonte::kinetic::BarrierModel &model,
+               jsonParser const &json);
+
+}  // namespace CASM
+
+#endif
@@ -2,10 +2,14 @@
 #define CASM_clexmonte_kinetic_EventState_stream_io
 
 #include <iostream>
+#include <vector>
+
+#include "casm/global/definitions.hh"
 
 namespace CASM {
 namespace clexmonte {
 struct EventData;
+class EventSites;
 struct PrimEventData;
 
 namespace kinetic {
@@ -19,6 +23,10 @@ void print(std::ostream &out, kinetic::EventState const &event_state,
 void print(std::ostream &out, kinetic::EventState const &event_state,
            EventData const &event_data, PrimEventData const &prim_event_data);
 
+void print(std::ostream &out, kinetic::EventState const &event_state,
+           Index unitcell_index, EventSites linear_site_index,
+           PrimEventData const &prim_event_data);
+
 }  // namespace kinetic
 }  // namespace clexmonte
 }  // namespace CASM
@@ -0,0 +1,44 @@
+#ifndef CASM_clexmonte_kinetic_kernel_dispatch
+#define CASM_clexmonte_kinetic_kernel_dispatch
+
+#include <string>
+
+// Vectorized kernels are compiled for several x86-64 instruction sets, with
+// the GCC / Clang `target` attribute, and the best one supported by the CPU
+// is selected at runtime, so one build runs well on both AVX2 and AVX-512
+// nodes. Elsewhere, only the baseline variant is compiled.
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CASM_CLEXMONTE_KERNEL_DISPATCH 1
+#define CASM_CLEXMONTE_TARGET_AVX2 __attribute__((target("avx2")))
+#define CASM_CLEXMONTE_TARGET_AVX512 __attribute__((target("avx512f")))
+#define CASM_CLEXMONTE_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define CASM_CLEXMONTE_TARGET_AVX2
+#define CASM_CLEXMONTE_TARGET_AVX512
+#define CASM_CLEXMONTE_ALWAYS_INLINE inline
+#endif
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Instruction set variants of the vectorized kernels
+enum class KernelISA { baseline, avx2, avx512 };
+
+/// \brief Name of a kernel instruction set variant: "baseline", "avx2", or
+///     "avx512"
+std::string to_string(KernelISA isa);
+
+/// \brief Best kernel instruction set variant supported by this CPU
+KernelISA detect_kernel_isa();
+
+/// \brief Kernel instruction set variant used by the vectorized kernels,
+///     selected on first use
+KernelISA kernel_isa();
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
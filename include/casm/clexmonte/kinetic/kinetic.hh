@@ -2,10 +2,22 @@
 #define CASM_clexmonte_kinetic
 
 #include <random>
+#include <set>
 
 #include "casm/clexmonte/canonical/canonical.hh"
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/EventJournal.hh"
+#include "casm/clexmonte/events/EventSchedule.hh"
+#include "casm/clexmonte/events/EventSelectorParams.hh"
+#include "casm/clexmonte/events/RejectionEventSelector.hh"
+#include "casm/clexmonte/events/SumTreeEventSelector.hh"
+#include "casm/clexmonte/events/SynchronousSublatticeEventSelector.hh"
+#include "casm/clexmonte/kinetic/EventTriggeredSampler.hh"
+#include "casm/clexmonte/kinetic/SelectiveAtomTracker.hh"
+#include "casm/clexmonte/kinetic/TimeResolvedSampler.hh"
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
+#include "casm/clexmonte/misc/diffusion_calculations.hh"
+#include "casm/clexmonte/run/MemoryReport.hh"
 #include "casm/monte/RandomNumberGenerator.hh"
 #include "casm/monte/methods/kinetic_monte_carlo.hh"
 
@@ -19,7 +31,9 @@ struct Kinetic {
   typedef EngineType engine_type;
 
   explicit Kinetic(std::shared_ptr<system_type> _system,
-                   std::vector<EventFilterGroup> _event_filters = {});
+                   std::vector<EventFilterGroup> _event_filters = {},
+                   CompleteEventListParams _event_list_params = {},
+                   Index _n_threads = 1);
 
   /// System data
   std::shared_ptr<system_type> system;
@@ -30,16 +44,77 @@ struct Kinetic {
   /// Update species in monte::OccLocation tracker
   bool update_species = true;
 
+  /// Names of the atom types whose positions are tracked for sampling
+  /// functions. If empty (default), all atoms are tracked by the
+  /// monte::OccLocation, which requires `update_species`. If not empty, only
+  /// atoms of these types, such as a solute, are tracked by a
+  /// SelectiveAtomTracker, and `update_species` should be false, so that
+  /// applying an event costs about as much as without atom tracking.
+  /// Displacement and jump sampling functions then only include the tracked
+  /// atoms.
+  std::set<std::string> tracked_atom_names;
+
   /// Method allows time-based sampling
+  ///
+  /// Time-based sampling is checked by `monte::kinetic_monte_carlo` before
+  /// each event is applied. The state is constant between events, so a
+  /// sample taken at a sample time is exact, because it is taken before the
+  /// first event after that time is applied, and no interpolation is
+  /// needed. To sample at regular times without checking every event, use
+  /// `time_resolved_sampler`.
   bool time_sampling_allowed = true;
 
-  // TODO:
-  // /// If true: rejection-free KMC, if false: rejection-KMC
-  // bool rejection_free = true;
+  /// Event selector method. If `event_selector_params.type` is
+  /// `EventSelectorType::lotto_rejection_free`, the event list must use
+  /// `ImpactTableType::map`.
+  EventSelectorParams event_selector_params;
+
+  /// Changes of which events are enabled, and of the temperature, applied
+  /// during each run at the given times since the start of the run (see
+  /// ScheduledEventSelector). Requires the "sum_tree" event selector. Events
+  /// which are enabled by a step must be included by `event_filters`; to
+  /// start a run with them disabled, disable them with a step at time 0.0.
+  /// Temperature changes are made to `conditions`, which are used to
+  /// calculate event rates, but not to the state's conditions, which are
+  /// written to the results.
+  std::vector<EventScheduleStep> event_schedule;
+
+  /// If not empty, each run writes its selected events and time increments
+  /// to this file (see EventJournalWriter), overwriting it, so that the run
+  /// can be replayed using `replay_event_journal_path`.
+  fs::path event_journal_path;
+
+  /// If not empty, each run replays the events of this journal (see
+  /// ReplayEventSelector) instead of selecting events, without calculating
+  /// any event rates. The run must start from the initial state of the
+  /// journaled run, in the same supercell, with the same completion
+  /// criteria, but may use different sampling functions, for example to
+  /// sample a new quantity along the trajectory of a long run.
+  fs::path replay_event_journal_path;
+
+  /// If not null, samples the state after each occurrence of its selected
+  /// events, in addition to the sampling fixtures (see
+  /// EventTriggeredSampler). It holds the samples of the current or last
+  /// run, which are also written to `params.output_file`, if not empty, at
+  /// the end of each run.
+  std::shared_ptr<EventTriggeredSampler> event_triggered_sampler;
+
+  /// If not null, samples the state at regular times, in addition to the
+  /// sampling fixtures, skipping the sample time check for a number of
+  /// events estimated from the event rate, with optional interpolation
+  /// (see TimeResolvedSampler). It holds the samples of the current or last
+  /// run, which are also written to `params.output_file`, if not empty, at
+  /// the end of each run.
+  std::shared_ptr<TimeResolvedSampler> time_resolved_sampler;
 
   /// \brief KMC event data and calculators
   std::shared_ptr<KineticEventData> event_data;
 
+  /// \brief KMC event data of previously used supercells, which is reused
+  ///     if a later run is in the same supercell. Disabled if
+  ///     `event_data_cache.max_bytes()` is 0 (default).
+  KineticEventDataCache event_data_cache;
+
   // --- Standard state specific ---
 
   /// Pointer to current state
@@ -56,8 +131,10 @@ struct Kinetic {
   /// Note: This is shared with the calculators in `prim_event_calculators`
   std::shared_ptr<clexmonte::Conditions> conditions;
 
-  /// The current state's potential calculator, set
-  ///    when the `run` method is called - for sampling function only
+  /// The current state's potential calculator, constructed once and set
+  ///    when the `run` method is called to share the formation energy
+  ///    cluster expansion of the event calculators - for sampling function
+  ///    only
   std::shared_ptr<canonical::CanonicalPotential> potential;
 
   /// The current state's formation energy cluster expansion calculator, set
@@ -69,10 +146,62 @@ struct Kinetic {
   /// Data for sampling functions
   monte::KMCData<config_type, statistics_type, engine_type> kmc_data;
 
+  /// Atom displacements since the previous sample, accumulated per sampling
+  /// fixture as events are applied and shared by sampling functions
+  KMCDisplacementCache displacement_cache;
+
+  /// Number of atoms and atom jumps by type, updated as events are applied
+  KMCJumpCounter jump_counter;
+
+  /// Rate-weighted estimator sums of collective displacements, updated as
+  /// events are applied if "L_isotropic_rate_weighted" or
+  /// "L_anisotropic_rate_weighted" is sampled and the event selector
+  /// maintains `event_rate_totals`
+  KMCRateWeightedDiffusionSums rate_weighted_diffusion_sums;
+
+  /// Tracks atoms of `tracked_atom_names` during a run, if not empty
+  std::shared_ptr<SelectiveAtomTracker> atom_tracker;
+
+  /// Rate error diagnostics of the last run, if
+  /// `event_selector_params.deferred_update_interval` > 1
+  DeferredUpdateDiagnostics deferred_update_diagnostics;
+
+  /// Superbasin acceleration diagnostics of the last run, if
+  /// `event_selector_params.superbasin_n_recurrence` > 0
+  SuperbasinDiagnostics superbasin_diagnostics;
+
+  /// Most recently calculated event rates, with totals by prim event, if
+  /// maintained by the event selector of the current run, else null. The
+  /// totals are current for the rejection-free selectors that store rates
+  /// ("lotto_rejection_free", "sum_tree", "grouped_sum_tree", and
+  /// "composition_rejection").
+  std::shared_ptr<EventRateTotals const> event_rate_totals;
+
+  /// Proposal and acceptance counts of the last run, if
+  /// `event_selector_params.type` is `rejection`
+  RejectionDiagnostics rejection_diagnostics;
+
+  /// Upper bound on event rates, by prim event index, used in the last run
+  /// if `event_selector_params.type` is `rejection`
+  std::vector<double> rejection_prim_event_max_rate;
+
+  /// Synchronous sublattice diagnostics of the last run, if
+  /// `event_selector_params.type` is `synchronous_sublattice`
+  SynchronousSublatticeDiagnostics synchronous_sublattice_diagnostics;
+
+  /// Approximate memory used by each subsystem, set by `run` at the start
+  /// of each run, when it is also written to the log
+  MemoryReport memory_report;
+
   /// \brief Perform a single run, evolving current state
   void run(state_type &state, monte::OccLocation &occ_location,
            run_manager_type<EngineType> &run_manager);
 
+  /// \brief Approximate memory used by each subsystem of a run
+  MemoryReport make_memory_report(
+      state_type const &state, monte::OccLocation const &occ_location,
+      run_manager_type<EngineType> const &run_manager) const;
+
   /// \brief Construct functions that may be used to sample various quantities
   ///     of the Monte Carlo calculation as it runs
   static std::map<std::string, state_sampling_function_type>
@@ -94,6 +223,25 @@ struct Kinetic {
   /// \brief Construct functions that may be used to modify states
   static StateModifyingFunctionMap standard_modifying_functions(
       std::shared_ptr<Kinetic<EngineType>> const &calculation);
+
+ private:
+  /// \brief Write non-normal event counts to the event log
+  void _write_non_normal_event_summary();
+
+  /// \brief Write local environment cache statistics to the event log
+  void _write_local_environment_cache_summary();
+
+  /// \brief Write deferred rate update diagnostics to the event log
+  void _write_deferred_update_summary();
+
+  /// \brief Write superbasin acceleration diagnostics to the event log
+  void _write_superbasin_summary();
+
+  /// \brief Write rejection KMC diagnostics to the event log
+  void _write_rejection_summary();
+
+  /// \brief Write synchronous sublattice diagnostics to the event log
+  void _write_synchronous_sublattice_summary();
 };
 
 /// \brief Construct a list of atom names corresponding to OccLocation atoms
@@ -101,6 +249,19 @@ std::vector<Index> make_atom_name_index_list(
     monte::OccLocation const &occ_location,
     occ_events::OccSystem const &occ_system);
 
+/// \brief Construct the atom displacements of each prim event
+std::vector<std::vector<PrimEventAtomDisplacement>>
+make_prim_event_atom_displacements(
+    std::vector<PrimEventData> const &prim_event_list,
+    occ_events::OccSystem const &occ_system,
+    AtomDisplacementCalculator const &displacement_f);
+
+/// \brief Construct a list, indexed by species index, of which species are
+///     defects
+std::vector<bool> make_is_defect_species(
+    occ_events::OccSystem const &occ_system,
+    std::vector<std::string> const &defect_species);
+
 /// \brief Helper for making a conditions ValueMap for kinetic Monte
 ///     Carlo calculations
 monte::ValueMap make_conditions(
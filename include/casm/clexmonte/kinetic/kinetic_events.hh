@@ -1,14 +1,31 @@
 #ifndef CASM_clexmonte_kinetic_events
 #define CASM_clexmonte_kinetic_events
 
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "casm/casm_io/Log.hh"
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/ActiveEventSet.hh"
 #include "casm/clexmonte/events/CompleteEventList.hh"
 #include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/kinetic/NonNormalEventLog.hh"
+#include "casm/clexmonte/kinetic/rate_kernel.hh"
+#include "casm/clexmonte/misc/CompensatedSum.hh"
+#include "casm/clexmonte/misc/Matrix3lCompare.hh"
 #include "casm/clexulator/ClusterExpansion.hh"
 #include "casm/clexulator/LocalClusterExpansion.hh"
 
 namespace CASM {
 namespace clexmonte {
+struct MemoryReport;
+
 namespace kinetic {
 
 /// \brief Data calculated for a single event in a single state
@@ -22,13 +39,279 @@ struct EventState {
   double rate;          ///< Occurance rate
 };
 
+/// \brief Cached parts of event states, which are reused when an occuring
+///     event only changes some of the sites an event depends on
+///
+/// Stores the change in energy (`dE_final`) and the event local cluster
+/// expansion values (`Ekra`, `freq`) of every event in structure-of-arrays
+/// layout, indexed by the event linear index `unitcell_index *
+/// n_prim_events + prim_event_index`, along with EventUpdateFlags indicating
+/// which parts are out of date.
+///
+/// Usage:
+/// - Call `set_occurred` after an event occurs, before the rates of the
+///   impacted events are recalculated. It marks the impacted events'
+///   `dE_final` and/or local cluster expansion values out of date using the
+///   split impact neighborhoods of EventImpactInfo.
+/// - Call `invalidate` after any other change to the state or occupation.
+/// - Different events may be calculated concurrently, but `set_occurred`
+///   and `invalidate` must not be called concurrently with calculations.
+struct EventStateCache {
+  EventStateCache(std::vector<EventImpactInfo> const &prim_impact_info_list,
+                  xtal::UnitCellIndexConverter const &unitcell_converter);
+
+  /// \brief Mark all parts of all events out of date
+  void invalidate();
+
+  /// \brief Mark parts of events impacted by `event_id` out of date
+  void set_occurred(EventID const &event_id);
+
+  /// \brief Number of prim events
+  Index n_prim_events;
+
+  /// \brief Cached change in energy, by event linear index
+  std::vector<double> dE_final;
+
+  /// \brief Cached KRA, by event linear index
+  std::vector<double> Ekra;
+
+  /// \brief Cached attempt frequency, by event linear index
+  std::vector<double> freq;
+
+  /// \brief EventUpdateFlags, by event linear index
+  std::vector<unsigned char> update_flags;
+
+ private:
+  std::vector<std::vector<RelativeEventUpdate>> m_update_table;
+  xtal::UnitCellIndexConverter m_unitcell_converter;
+};
+
+/// \brief Memoized event rate inputs, keyed by prim event and the
+///     occupation of the event's impact neighborhood
+///
+/// In many systems the number of distinct local environments around events
+/// is much smaller than the number of events. This stores the change in
+/// energy (`dE_final`), KRA (`Ekra`), and attempt frequency (`freq`) of
+/// allowed events by prim event index and the occupation of the sites in
+/// `EventImpactInfo::required_update_neighborhood`, so that an event with
+/// an environment seen before skips the cluster expansion evaluations.
+/// These values do not depend on the conditions, so entries remain valid
+/// when only the conditions change, but not when changing supercell.
+///
+/// The number of entries is bounded by `max_size`. When it is reached, all
+/// entries are removed.
+///
+/// Usage:
+/// - Call `find` for an allowed event. If it returns false, calculate the
+///   rate inputs and call `insert` before the next call to `find`.
+/// - Not thread-safe. Each thread must use its own cache.
+class LocalEnvironmentCache {
+ public:
+  /// \brief Constructor
+  LocalEnvironmentCache(
+      std::vector<EventImpactInfo> const &prim_impact_info_list,
+      xtal::UnitCellCoordIndexConverter const &index_converter,
+      xtal::UnitCellIndexConverter const &unitcell_converter,
+      Index _max_size);
+
+  /// \brief Find stored rate inputs of an event
+  bool find(EventState &state, Index prim_event_index, Index unitcell_index,
+            Eigen::VectorXi const &occupation);
+
+  /// \brief Store rate inputs for the event of the last unsuccessful `find`
+  void insert(EventState const &state);
+
+  /// \brief Remove all entries, keeping counts
+  void clear() { m_entries.clear(); }
+
+  /// \brief Construct a cache for the same events, with no entries
+  std::shared_ptr<LocalEnvironmentCache> make_empty_copy() const;
+
+  /// \brief Number of entries
+  Index size() const { return m_entries.size(); }
+
+  /// \brief Maximum number of entries
+  Index max_size() const { return m_max_size; }
+
+  /// \brief Number of successful `find` calls
+  Index n_hits() const { return m_n_hits; }
+
+  /// \brief Number of unsuccessful `find` calls
+  Index n_misses() const { return m_n_misses; }
+
+  /// \brief Number of times all entries were removed because the cache
+  ///     was full
+  Index n_clears() const { return m_n_clears; }
+
+ private:
+  struct Entry {
+    double dE_final;
+    double Ekra;
+    double freq;
+  };
+
+  /// Impact neighborhood of each prim event
+  std::vector<std::vector<xtal::UnitCellCoord>> m_neighborhood;
+
+  xtal::UnitCellCoordIndexConverter m_index_converter;
+  xtal::UnitCellIndexConverter m_unitcell_converter;
+  Index m_max_size;
+  std::unordered_map<std::string, Entry> m_entries;
+
+  /// Key of the last `find`
+  std::string m_key;
+
+  Index m_n_hits;
+  Index m_n_misses;
+  Index m_n_clears;
+};
+
+/// \brief Stores the most recently calculated state of every event
+///
+/// Stores one entry per event, indexed by the event linear index
+/// `unitcell_index * n_prim_events + prim_event_index`. If the number of
+/// events is at most `max_full_size`, the complete EventState of each event
+/// is stored. Otherwise, to limit memory use, only `rate` and
+/// `dE_activated`, as float, and `is_allowed` and `is_normal` are stored.
+///
+/// Different events may be stored concurrently.
+class EventStateStore {
+ public:
+  /// \brief Constructor
+  EventStateStore(Index _n_events, Index _max_full_size);
+
+  /// \brief Number of events
+  Index size() const { return m_is_allowed.size(); }
+
+  /// \brief If true, complete EventState are stored
+  bool is_full() const { return m_is_full; }
+
+  /// \brief Store the state of an event
+  void set(Index linear_index, EventState const &event_state);
+
+  /// \brief The complete stored state of an event, requires `is_full()`
+  EventState const &event_state(Index linear_index) const;
+
+  /// \brief True if the event has been calculated since construction
+  bool is_calculated(Index linear_index) const {
+    return m_is_calculated[linear_index];
+  }
+
+  /// \brief Stored `is_allowed`
+  bool is_allowed(Index linear_index) const {
+    return m_is_allowed[linear_index];
+  }
+
+  /// \brief Stored `is_normal`
+  bool is_normal(Index linear_index) const {
+    return m_is_normal[linear_index];
+  }
+
+  /// \brief Stored `rate`
+  double rate(Index linear_index) const {
+    return m_is_full ? m_event_state[linear_index].rate
+                     : m_rate[linear_index];
+  }
+
+  /// \brief Stored `dE_activated`
+  double dE_activated(Index linear_index) const {
+    return m_is_full ? m_event_state[linear_index].dE_activated
+                     : m_dE_activated[linear_index];
+  }
+
+ private:
+  bool m_is_full;
+
+  // full storage
+  std::vector<EventState> m_event_state;
+
+  // compact storage
+  std::vector<float> m_rate;
+  std::vector<float> m_dE_activated;
+
+  // both. Note: unsigned char rather than bool, so that different events
+  // may be set concurrently
+  std::vector<unsigned char> m_is_calculated;
+  std::vector<unsigned char> m_is_allowed;
+  std::vector<unsigned char> m_is_normal;
+};
+
+/// \brief Stores the most recently calculated rate of every event, and
+///     running totals by prim event
+///
+/// When used by CompleteEventCalculator with an event selector that
+/// recalculates the rates of all impacted events after each event, the
+/// totals are the current total rate of each prim event, updated at O(1)
+/// cost per rate change. Totals are kept as CompensatedSum, and the total
+/// of one prim event is re-summed from its stored rates only when its
+/// round-off error bound exceeds a relative tolerance, so totals stay
+/// accurate when rates span many orders of magnitude without periodic
+/// re-summation of all totals.
+class EventRateTotals {
+ public:
+  /// \brief Constructor
+  EventRateTotals(Index _n_events, Index _n_prim_events);
+
+  /// \brief Number of events
+  Index size() const { return m_rate.size(); }
+
+  /// \brief Store the rate of an event, by linear index, and update totals
+  void set(Index linear_index, double rate) {
+    double &prev_rate = m_rate[linear_index];
+    Index prim_event_index = linear_index % m_n_prim_events;
+    CompensatedSum &total = m_total[prim_event_index];
+    total.add(rate);
+    total.add(-prev_rate);
+    prev_rate = rate;
+    if (total.needs_refresh()) {
+      resum(prim_event_index);
+    }
+    m_prim_event_total_rate[prim_event_index] = total.value();
+  }
+
+  /// \brief Stored rate of an event, by linear index
+  double rate(Index linear_index) const { return m_rate[linear_index]; }
+
+  /// \brief Total of the stored rates of each prim event
+  std::vector<double> const &prim_event_total_rate() const {
+    return m_prim_event_total_rate;
+  }
+
+  /// \brief Bound on the accumulated round-off error of each prim event
+  ///     total
+  double error_bound(Index prim_event_index) const {
+    return m_total[prim_event_index].error_bound();
+  }
+
+  /// \brief Re-sum totals from the stored rates
+  void resum();
+
+  /// \brief Re-sum the total of one prim event from its stored rates
+  void resum(Index prim_event_index);
+
+  /// \brief Set all stored rates and totals to 0.0
+  void reset();
+
+ private:
+  Index m_n_prim_events;
+  std::vector<double> m_rate;
+  std::vector<CompensatedSum> m_total;
+  std::vector<double> m_prim_event_total_rate;
+};
+
 /// \brief Event rate calculation for a particular KMC event
 ///
 /// EventStateCalculator is used to separate the event calculation from the
 /// event definition data in PrimEventData. All symmetrically equivalent
-/// events can use the same EventStateCalculator, but a simple approach
-/// is to create one for each distinct event associated with the primitive
-/// cell.
+/// events can use the same EventStateCalculator, because the event local
+/// cluster expansion is evaluated by `PrimEventData::equivalent_index`.
+///
+/// Copies of an EventStateCalculator share their state, conditions, and
+/// cluster expansions, so `set` on one sets all of them.
+/// `make_prim_event_calculators` returns one calculator per prim event, for
+/// indexing by prim event index, but prim events of the same type share one
+/// calculator, so `set_prim_event_calculators` only sets each event type
+/// once.
 class EventStateCalculator {
  public:
   // /// \brief Constructor
@@ -40,38 +323,130 @@ class EventStateCalculator {
 
   /// \brief Constructor
   EventStateCalculator(std::shared_ptr<system_type> _system,
-                       std::string _event_type_name);
+                       std::string _event_type_name,
+                       BarrierModel _barrier_model = BarrierModel());
 
   /// \brief Reset pointer to state currently being calculated
   void set(state_type const *state, std::shared_ptr<Conditions> conditions);
 
+  /// \brief Reset pointer to state currently being calculated, using the
+  ///     given cluster expansion objects
+  void set(state_type const *state, std::shared_ptr<Conditions> conditions,
+           std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex,
+           std::shared_ptr<clexulator::MultiLocalClusterExpansion> event_clex);
+
   /// \brief Pointer to current state
   state_type const *state() const;
 
   /// \brief Pointer to current conditions
   std::shared_ptr<Conditions> const &conditions() const;
 
+  /// \brief Formation energy cluster expansion, set to evaluate the current
+  ///     state
+  std::shared_ptr<clexulator::ClusterExpansion> const &formation_energy_clex()
+      const {
+    return m_data->formation_energy_clex;
+  }
+
+  /// \brief The barrier model used to calculate activation energies
+  BarrierModel const &barrier_model() const { return m_data->barrier_model; }
+
+  /// \brief True if this and `other` are copies, which share their state,
+  ///     conditions, and cluster expansions
+  bool is_shared_with(EventStateCalculator const &other) const {
+    return m_data == other.m_data;
+  }
+
+  /// \brief Names of the event local cluster expansion coefficient sets
+  ///     used to calculate event states
+  std::vector<std::string> event_clex_coefficient_names() const;
+
   /// \brief Calculate the state of an event
   void calculate_event_state(EventState &state, EventData const &event_data,
                              PrimEventData const &prim_event_data) const;
 
+  /// \brief Calculate the state of an event, given its linear site indices
+  void calculate_event_state(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data) const;
+
+  /// \brief Calculate the state of an event, reusing cached parts which are
+  ///     not out of date
+  void calculate_event_state(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data,
+                             EventStateCache &cache, Index linear_index) const;
+
+  /// \brief Calculate whether an event is allowed, and if it is, the change
+  ///     in energy, KRA, and attempt frequency, but not the rate
+  bool calculate_rate_inputs(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data) const;
+
+  /// \brief Calculate whether an event is allowed, and if it is, the change
+  ///     in energy, KRA, and attempt frequency, reusing cached parts which
+  ///     are not out of date, but not the rate
+  bool calculate_rate_inputs(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data,
+                             EventStateCache &cache, Index linear_index) const;
+
+  /// \brief Calculate the state of an event, reusing the rate inputs of
+  ///     events with the same local environment
+  void calculate_event_state(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data,
+                             LocalEnvironmentCache &cache) const;
+
+  /// \brief Calculate whether an event is allowed, and if it is, the change
+  ///     in energy, KRA, and attempt frequency, reusing those of events with
+  ///     the same local environment, but not the rate
+  bool calculate_rate_inputs(EventState &state, Index unitcell_index,
+                             EventSites linear_site_index,
+                             PrimEventData const &prim_event_data,
+                             LocalEnvironmentCache &cache) const;
+
+  /// \brief Set normal / activated energy / rate, given dE_final, Ekra, freq
+  void set_rate(EventState &state) const;
+
  private:
-  /// System pointer
-  std::shared_ptr<system_type> m_system;
+  /// \brief Return true if the event sites have the initial occupation
+  bool _is_allowed(EventSites linear_site_index,
+                   PrimEventData const &prim_event_data) const;
+
+  /// \brief Calculate the parts of an allowed event's state selected by
+  ///     `flags` (see EventUpdateFlags)
+  void _calculate_energies(EventState &state, Index unitcell_index,
+                           EventSites linear_site_index,
+                           PrimEventData const &prim_event_data,
+                           unsigned char flags) const;
+
+  /// Data shared by copies
+  struct Data {
+    /// System pointer
+    std::shared_ptr<system_type> system;
+
+    /// Event type name
+    std::string event_type_name;
 
-  /// Event type name
-  std::string m_event_type_name;
+    /// State to use
+    state_type const *state = nullptr;
 
-  /// State to use
-  state_type const *m_state;
+    /// Conditions
+    std::shared_ptr<Conditions> conditions;
 
-  /// Conditions
-  std::shared_ptr<Conditions> m_conditions;
+    std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex;
+    std::shared_ptr<clexulator::MultiLocalClusterExpansion> event_clex;
+    /// Index of the "kra" coefficients, or -1 if not used by the barrier
+    /// model
+    Index kra_index = -1;
+    Index freq_index = -1;
 
-  std::shared_ptr<clexulator::ClusterExpansion> m_formation_energy_clex;
-  std::shared_ptr<clexulator::MultiLocalClusterExpansion> m_event_clex;
-  Index m_kra_index;
-  Index m_freq_index;
+    /// Barrier model
+    BarrierModel barrier_model;
+  };
+
+  std::shared_ptr<Data> m_data;
 };
 
 /// \brief Construct a vector EventStateCalculator, one per event in a
@@ -79,7 +454,22 @@ class EventStateCalculator {
 std::vector<EventStateCalculator> make_prim_event_calculators(
     std::shared_ptr<system_type> system, state_type const &state,
     std::vector<PrimEventData> const &prim_event_list,
-    std::shared_ptr<Conditions> conditions);
+    std::shared_ptr<Conditions> conditions,
+    std::map<std::string, BarrierModel> const &barrier_models = {});
+
+/// \brief Reset the state of a vector of EventStateCalculator, setting
+///     calculators shared by several prim events once
+void set_prim_event_calculators(
+    std::vector<EventStateCalculator> &prim_event_calculators,
+    state_type const *state, std::shared_ptr<Conditions> conditions);
+
+/// \brief Construct a vector EventStateCalculator, one per event in a
+///     vector of PrimEventData, which use their own cluster expansion objects
+std::vector<EventStateCalculator> make_independent_prim_event_calculators(
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::vector<PrimEventData> const &prim_event_list,
+    std::shared_ptr<Conditions> conditions,
+    std::map<std::string, BarrierModel> const &barrier_models = {});
 
 /// \brief CompleteEventCalculator is an event calculator with the required
 /// interface for the
@@ -97,26 +487,290 @@ struct CompleteEventCalculator {
   std::vector<EventStateCalculator> const &prim_event_calculators;
 
   /// \brief Complete event list
-  std::map<EventID, EventData> const &event_list;
+  EventDataList const &event_list;
 
   /// \brief Write to warn about non-normal events
   Log &event_log;
 
-  // Note: to keep all event state calculations, comment out this:
   /// \brief Holds last calculated event state
   EventState event_state;
 
+  /// \brief If not null, the state of every calculated event is stored
+  std::shared_ptr<EventStateStore> event_state_store;
+
   /// \brief Count not-normal events
   Index not_normal_count;
 
+  /// \brief If not null, non-normal events are counted by
+  ///     `non_normal_event_log`, which also limits how many are written.
+  ///     If null, every non-normal event is written to `event_log`.
+  std::shared_ptr<NonNormalEventLog> non_normal_event_log;
+
+  /// \brief Scratch space for event sites read from the
+  ///     structure-of-arrays layout of `event_list`
+  std::vector<Index> linear_site_index;
+
+  /// \brief Scratch space used by `calculate_rates` to group events by
+  ///     prim_event_index
+  std::vector<Index> batch_offsets;
+
+  /// \brief Scratch space used by `calculate_rates` to group events by
+  ///     prim_event_index
+  std::vector<Index> batch_order;
+
+  /// \brief Scratch space used by `calculate_rates` to calculate the rates
+  ///     of the allowed events of one prim event together
+  ArrheniusRateBatch rate_batch;
+
+  /// \brief Scratch space used by `calculate_rates`, the index in the input
+  ///     event list of each event in `rate_batch`
+  std::vector<Index> batch_allowed;
+
+  /// \brief If not null, used to reuse parts of event states that are not
+  ///     impacted by the last occurred event (see `set_occurred_event`)
+  std::shared_ptr<EventStateCache> event_state_cache;
+
+  /// \brief If not null, events that are not active are given rate 0.0
+  ///     without calculating their state
+  std::shared_ptr<ActiveEventSet> active_event_set;
+
+  /// \brief If not null, the rate of every calculated event is stored, with
+  ///     totals by prim event
+  std::shared_ptr<EventRateTotals> event_rate_totals;
+
+  /// \brief If not null, and `event_state_cache` is null, used to reuse the
+  ///     rate inputs of events with the same local environment
+  std::shared_ptr<LocalEnvironmentCache> local_environment_cache;
+
   CompleteEventCalculator(
       std::vector<PrimEventData> const &_prim_event_list,
       std::vector<EventStateCalculator> const &_prim_event_calculators,
-      std::map<EventID, EventData> const &_event_list,
+      EventDataList const &_event_list,
       Log &_event_log = CASM::err_log());
 
   /// \brief Get CASM::monte::OccEvent corresponding to given event ID
   double calculate_rate(EventID const &id);
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates);
+
+  /// \brief Notify that an event occurred, before the rates of impacted
+  ///     events are recalculated
+  void set_occurred_event(EventID const &id);
+
+ private:
+  double _calculate_rate(EventID const &id,
+                         PrimEventData const &prim_event_data,
+                         EventStateCalculator const &prim_event_calculator);
+
+  bool _calculate_rate_inputs(
+      EventID const &id, PrimEventData const &prim_event_data,
+      EventStateCalculator const &prim_event_calculator);
+
+  void _finish_event_state(EventID const &id,
+                           PrimEventData const &prim_event_data);
+
+  void _write_not_normal(EventID const &id, EventSites event_sites,
+                         PrimEventData const &prim_event_data);
+};
+
+/// \brief Calculates batches of event rates using a pool of worker threads
+///
+/// Each worker owns a CompleteEventCalculator whose prim event calculators
+/// use their own cluster expansion objects (see
+/// `make_independent_prim_event_calculators`), so each worker has its own
+/// EventState and clexulator scratch space. A batch is split into
+/// contiguous chunks, the first calculated by the calling thread and the
+/// rest by the workers, and each rate is written to its position in the
+/// output. Rates therefore do not depend on the number of threads or on
+/// scheduling, and are bit-for-bit the same as serial calculation.
+///
+/// Workers share the `non_normal_event_log` of the main calculator, if it
+/// has one. Otherwise, non-normal event messages from workers are buffered
+/// and written to the event log of the main calculator after each batch, in
+/// chunk order. If the main calculator has a `local_environment_cache`,
+/// each worker has its own empty one.
+///
+/// Notes:
+/// - Expected to be constructed as shared_ptr
+/// - Has the same `calculate_rate` / `calculate_rates` interface as
+///   CompleteEventCalculator, so it can be used with SumTreeEventSelector
+class ParallelCompleteEventCalculator {
+ public:
+  ParallelCompleteEventCalculator(
+      std::shared_ptr<CompleteEventCalculator> _calculator,
+      std::shared_ptr<system_type> _system, state_type const &_state,
+      std::shared_ptr<Conditions> _conditions, Index _n_threads,
+      Index _min_batch_size = 64);
+
+  ~ParallelCompleteEventCalculator();
+
+  ParallelCompleteEventCalculator(ParallelCompleteEventCalculator const &) =
+      delete;
+  ParallelCompleteEventCalculator &operator=(
+      ParallelCompleteEventCalculator const &) = delete;
+
+  /// \brief Calculate the rate of a single event, on the calling thread
+  double calculate_rate(EventID const &id);
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates);
+
+  /// \brief Notify that an event occurred, before the rates of impacted
+  ///     events are recalculated
+  void set_occurred_event(EventID const &id);
+
+  /// \brief Total number of threads, including the calling thread
+  Index n_threads() const { return m_workers.size() + 1; }
+
+  /// \brief Local environment caches of the worker calculators, if any
+  std::vector<std::shared_ptr<LocalEnvironmentCache const>>
+  worker_local_environment_caches() const;
+
+ private:
+  struct Worker {
+    Worker(std::vector<EventStateCalculator> _prim_event_calculators,
+           CompleteEventCalculator const &main_calculator);
+
+    std::vector<EventStateCalculator> prim_event_calculators;
+    std::stringstream log_stream;
+    Log log;
+    CompleteEventCalculator calculator;
+  };
+
+  void _run_worker(Index worker_index);
+
+  void _calculate_chunk(CompleteEventCalculator &calculator,
+                        Index chunk_index) const;
+
+  /// Used by the calling thread, and for batches smaller than
+  /// m_min_batch_size
+  std::shared_ptr<CompleteEventCalculator> m_calculator;
+
+  Index m_min_batch_size;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  Index m_generation;
+  Index m_n_pending;
+  bool m_stop;
+
+  // current batch
+  std::vector<EventID> const *m_event_id_list;
+  double *m_rates;
+  Index m_n_chunks;
+};
+
+/// \brief A CompleteEventCalculator with its own prim event calculators and
+///     event log, for use on one thread
+///
+/// The prim event calculators use their own cluster expansion objects (see
+/// `make_independent_prim_event_calculators`). The calculator shares the
+/// `non_normal_event_log` of the main calculator, if it has one, but not its
+/// event state cache, event state store, or active event set, which may not
+/// be updated concurrently. Other non-normal event messages are written to
+/// `log_stream`.
+///
+/// Notes:
+/// - Expected to be constructed as shared_ptr, see
+///   `make_independent_event_calculators`
+/// - Used by SynchronousSublatticeEventSelector
+struct IndependentEventCalculator {
+  IndependentEventCalculator(
+      std::vector<EventStateCalculator> _prim_event_calculators,
+      CompleteEventCalculator const &main_calculator);
+
+  IndependentEventCalculator(IndependentEventCalculator const &) = delete;
+  IndependentEventCalculator &operator=(IndependentEventCalculator const &) =
+      delete;
+
+  std::vector<EventStateCalculator> prim_event_calculators;
+  std::stringstream log_stream;
+  Log log;
+  CompleteEventCalculator calculator;
+
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventID const &id) {
+    return calculator.calculate_rate(id);
+  }
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates) {
+    calculator.calculate_rates(event_id_list, rates);
+  }
+
+  /// \brief Notify that an event occurred
+  void set_occurred_event(EventID const &id) {
+    calculator.set_occurred_event(id);
+  }
+};
+
+/// \brief Construct independent event calculators, one per thread
+std::vector<std::shared_ptr<IndependentEventCalculator>>
+make_independent_event_calculators(
+    CompleteEventCalculator const &main_calculator,
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::shared_ptr<Conditions> conditions, Index n_threads);
+
+/// \brief Calculates event rates without a complete event list
+///
+/// Event sites are constructed on demand from the prim event and the event
+/// translation, so nothing is stored per supercell event. This is used with
+/// DefectEventSelector, so that memory use does not depend on the supercell
+/// size.
+///
+/// Notes:
+/// - Expected to be constructed as shared_ptr
+/// - Holds references to the prim event list and calculators, which must
+///   outlive the OnDemandEventCalculator
+struct OnDemandEventCalculator {
+  /// \brief Prim event list
+  std::vector<PrimEventData> const &prim_event_list;
+
+  /// \brief Prim event calculators - order must match prim_event_list
+  std::vector<EventStateCalculator> const &prim_event_calculators;
+
+  /// \brief Constructs event sites
+  EventDataBuilder event_builder;
+
+  /// \brief Write to warn about non-normal events
+  Log &event_log;
+
+  /// \brief Holds last calculated event state
+  EventState event_state;
+
+  /// \brief Count not-normal events
+  Index not_normal_count;
+
+  /// \brief If not null, non-normal events are counted by
+  ///     `non_normal_event_log`, which also limits how many are written.
+  ///     If null, every non-normal event is written to `event_log`.
+  std::shared_ptr<NonNormalEventLog> non_normal_event_log;
+
+  /// \brief Scratch space for event sites
+  std::vector<Index> linear_site_index;
+
+  OnDemandEventCalculator(
+      std::vector<PrimEventData> const &_prim_event_list,
+      std::vector<EventStateCalculator> const &_prim_event_calculators,
+      monte::OccLocation const &_occ_location,
+      Log &_event_log = CASM::err_log());
+
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventID const &id);
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates);
+
+  /// \brief Notify that an event occurred, does nothing
+  void set_occurred_event(EventID const &id) {}
 };
 
 struct KineticEventData {
@@ -130,6 +784,9 @@ struct KineticEventData {
   /// The system
   std::shared_ptr<system_type> system;
 
+  /// Parameters controlling how `event_list` is stored
+  CompleteEventListParams event_list_params;
+
   /// The `prim events`, one translationally distinct instance
   /// of each event, associated with origin primitive cell
   std::vector<clexmonte::PrimEventData> prim_event_list;
@@ -146,8 +803,218 @@ struct KineticEventData {
   /// because it depends on supercell-specific clexulators
   std::vector<EventStateCalculator> prim_event_calculators;
 
+  /// Barrier models, by event type name. Event types not included use the
+  /// KRA midpoint formula.
+  std::map<std::string, BarrierModel> barrier_models;
+
   /// Calculator for KMC event selection
   std::shared_ptr<CompleteEventCalculator> event_calculator;
+
+  /// Number of threads used to calculate impacted event rates. If greater
+  /// than 1, `parallel_event_calculator` is constructed by `update`.
+  Index n_threads = 1;
+
+  /// Multithreaded calculator for KMC event selection, if `n_threads > 1`
+  std::shared_ptr<ParallelCompleteEventCalculator> parallel_event_calculator;
+
+  /// If true, `update` constructs `event_state_cache`, so that only the
+  /// parts of impacted event states that changed are recalculated
+  bool split_impact_neighborhoods = false;
+
+  /// Cached event state parts, used by `event_calculator` and
+  /// `parallel_event_calculator` if `split_impact_neighborhoods` is true
+  std::shared_ptr<EventStateCache> event_state_cache;
+
+  /// Occupation for which `event_state_cache` is up-to-date, set at the end
+  /// of each run. If the next run is in the same supercell and starts from
+  /// this occupation, the cache is kept, so only activation energies and
+  /// rates are recalculated for the new conditions.
+  Eigen::VectorXi event_state_cache_occupation;
+
+  /// If true, `update` constructs `event_state_store`, so that the most
+  /// recently calculated state of every event is kept
+  bool store_event_states = false;
+
+  /// If the number of events is greater than this, `event_state_store`
+  /// only stores rate and dE_activated, as float, for each event
+  Index max_full_event_states = 10000000;
+
+  /// Stored event states, used by `event_calculator` and
+  /// `parallel_event_calculator` if `store_event_states` is true
+  std::shared_ptr<EventStateStore> event_state_store;
+
+  /// If > 0, `update` constructs `local_environment_cache` with this
+  /// maximum number of entries
+  Index local_environment_cache_size = 0;
+
+  /// Memoized rate inputs by local environment, used by `event_calculator`
+  /// (and copies used by `parallel_event_calculator`) if
+  /// `local_environment_cache_size` > 0
+  std::shared_ptr<LocalEnvironmentCache> local_environment_cache;
+
+  /// Most recently calculated rate of every event, with totals by prim
+  /// event, used by `event_calculator` and `parallel_event_calculator`.
+  /// Constructed by `update` if the complete event list is constructed.
+  std::shared_ptr<EventRateTotals> event_rate_totals;
+
+  /// If true, `update` constructs `active_event_set`, so that only events
+  /// whose initial occupation matches the current occupation are calculated
+  bool use_active_event_set = false;
+
+  /// Events allowed by the current occupation, used by `event_calculator`
+  /// and `parallel_event_calculator` if `use_active_event_set` is true
+  std::shared_ptr<ActiveEventSet> active_event_set;
+
+  /// For each prim event, true if it was included in `event_list` (see
+  /// `CompleteEventListParams::skip_impossible_events`)
+  std::vector<bool> possible_prim_events;
+
+  /// Maximum number of non-normal events written in full to the event log.
+  /// Further non-normal events are only counted. If < 0, and
+  /// `async_event_log` is false, every non-normal event is written.
+  Index max_non_normal_examples = 100;
+
+  /// If true, non-normal event examples are written by a background thread
+  bool async_event_log = false;
+
+  /// If false, `update` constructs `event_list` with the small
+  /// "relative" impact table, whatever `event_list_params.impact_table_type`
+  /// is. Set by Kinetic for the "rejection" event selector, which only
+  /// calculates the rates of proposed events and does not use the impact
+  /// table.
+  bool require_impact_table = true;
+
+  /// If true, `update` does not construct the complete `event_list`, and
+  /// instead constructs `on_demand_event_calculator`, which is used by the
+  /// "defect" event selector
+  bool on_demand_events = false;
+
+  /// Calculator constructing events on demand, if `on_demand_events` is
+  /// true
+  std::shared_ptr<OnDemandEventCalculator> on_demand_event_calculator;
+
+  /// Non-normal event counts and examples, used by `event_calculator` and
+  /// `parallel_event_calculator`, unless every non-normal event is written
+  std::shared_ptr<NonNormalEventLog> non_normal_event_log;
+
+  /// \brief Construct `parallel_event_calculator` for the current state
+  void update_parallel_event_calculator(state_type const &state,
+                                        std::shared_ptr<Conditions> conditions);
+
+  /// \brief Approximate memory used by supercell-specific data, in bytes
+  std::size_t approximate_memory_usage() const;
+
+  /// \brief Add the approximate memory used by the events, impact table,
+  ///     event states, and calculators to a memory report
+  void add_memory_usage(MemoryReport &report) const;
+};
+
+/// \brief Construct KineticEventData with the same options, but no
+///     supercell-specific data
+std::shared_ptr<KineticEventData> make_event_data_with_same_options(
+    KineticEventData const &event_data);
+
+/// \brief The complete event list, in structure-of-arrays layout
+///
+/// Events are ordered by increasing linear index, `unitcell_index *
+/// n_prim_events + prim_event_index`, which is the order of the arrays of
+/// `EventStateArrays` and `calculate_event_list_rates`.
+struct EventListArrays {
+  /// \brief Linear index of each event
+  Eigen::VectorXl linear_index;
+
+  /// \brief Prim event index of each event
+  Eigen::VectorXl prim_event_index;
+
+  /// \brief Unit cell index of each event
+  Eigen::VectorXl unitcell_index;
+
+  /// \brief Linear site indices of each event, one row per event, padded
+  ///     with -1 to the maximum number of sites of any prim event
+  Eigen::Matrix<Index, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      linear_site_index;
+};
+
+/// \brief Make the complete event list arrays
+EventListArrays make_event_list_arrays(KineticEventData const &event_data);
+
+/// \brief Stored event states (see EventStateStore), in structure-of-arrays
+///     layout, in the order of `EventListArrays`
+///
+/// `dE_final`, `Ekra`, and `freq` are empty if the store only keeps
+/// `rate` and `dE_activated`. Values of events that have not been
+/// calculated are 0.0 / false.
+struct EventStateArrays {
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> is_calculated;
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> is_allowed;
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> is_normal;
+  Eigen::VectorXd dE_activated;
+  Eigen::VectorXd rate;
+  Eigen::VectorXd dE_final;
+  Eigen::VectorXd Ekra;
+  Eigen::VectorXd freq;
+};
+
+/// \brief Make the stored event state arrays
+EventStateArrays make_event_state_arrays(KineticEventData const &event_data);
+
+/// \brief Calculate the current rate of every event in the complete event
+///     list
+Eigen::VectorXd calculate_event_list_rates(KineticEventData &event_data);
+
+/// \brief Keeps KineticEventData of recently used supercells, so that
+///     the event list is constructed once per supercell in a series of runs
+///
+/// Entries are keyed by the transformation matrix to the supercell. When
+/// the approximate memory used by all entries (see
+/// `KineticEventData::approximate_memory_usage`) exceeds `max_bytes`, the
+/// least recently inserted or taken entries are removed.
+class KineticEventDataCache {
+ public:
+  /// \brief Constructor
+  explicit KineticEventDataCache(std::size_t _max_bytes = 0)
+      : m_max_bytes(_max_bytes), m_bytes(0), m_counter(0) {}
+
+  /// \brief Maximum approximate memory used by cached event data, in bytes.
+  ///     If 0, nothing is cached.
+  std::size_t max_bytes() const { return m_max_bytes; }
+
+  /// \brief Set the maximum memory, removing entries if necessary
+  void set_max_bytes(std::size_t _max_bytes);
+
+  /// \brief Approximate memory used by cached event data, in bytes
+  std::size_t bytes() const { return m_bytes; }
+
+  /// \brief Number of cached supercells
+  Index size() const { return m_entries.size(); }
+
+  /// \brief Remove and return the event data for a supercell, or nullptr if
+  ///     not cached
+  std::shared_ptr<KineticEventData> take(
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  /// \brief Insert event data for a supercell, then remove the least
+  ///     recently used entries until within `max_bytes`
+  void insert(Eigen::Matrix3l const &transformation_matrix_to_super,
+              std::shared_ptr<KineticEventData> event_data);
+
+  /// \brief Remove all entries
+  void clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<KineticEventData> event_data;
+    std::size_t bytes;
+    Index last_used;
+  };
+
+  /// \brief Remove least recently used entries until within `max_bytes`
+  void _evict();
+
+  std::size_t m_max_bytes;
+  std::size_t m_bytes;
+  Index m_counter;
+  std::map<Eigen::Matrix3l, Entry, Matrix3lCompare> m_entries;
 };
 
 }  // namespace kinetic
@@ -2,8 +2,11 @@
 #define CASM_clexmonte_kinetic_impl
 
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/DefectEventSelector.hh"
+#include "casm/clexmonte/events/SublatticeDecomposition.hh"
+#include "casm/clexmonte/events/SynchronousSublatticeEventSelector.hh"
 #include "casm/clexmonte/events/event_methods.hh"
-#include "casm/clexmonte/events/lotto.hh"
+#include "casm/clexmonte/events/event_selectors.hh"
 #include "casm/clexmonte/kinetic/kinetic.hh"
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 #include "casm/clexmonte/run/analysis_functions.hh"
@@ -32,17 +35,25 @@ namespace kinetic {
 /// \brief Implements kinetic Monte Carlo calculations
 template <typename EngineType>
 Kinetic<EngineType>::Kinetic(std::shared_ptr<system_type> _system,
-                             std::vector<EventFilterGroup> _event_filters)
+                             std::vector<EventFilterGroup> _event_filters,
+                             CompleteEventListParams _event_list_params,
+                             Index _n_threads)
     : system(_system),
       event_filters(_event_filters),
       event_data(std::make_shared<KineticEventData>(system)),
       state(nullptr),
       transformation_matrix_to_super(Eigen::Matrix3l::Zero(3, 3)),
-      occ_location(nullptr) {
+      occ_location(nullptr),
+      potential(std::make_shared<canonical::CanonicalPotential>(system)) {
   if (!is_clex_data(*this->system, "formation_energy")) {
     throw std::runtime_error(
         "Error constructing Kinetic: no 'formation_energy' clex.");
   }
+  this->event_data->event_list_params = _event_list_params;
+  this->event_data->n_threads = _n_threads;
+  if (_event_list_params.impact_table_type != ImpactTableType::map) {
+    this->event_selector_params.type = EventSelectorType::sum_tree;
+  }
 }
 
 /// \brief Perform a single run, evolving current state
@@ -53,30 +64,11 @@ void Kinetic<EngineType>::run(state_type &state,
   this->state = &state;
   this->occ_location = &occ_location;
   this->conditions = make_conditions(*this->system, state);
-  Index n_unitcells = this->transformation_matrix_to_super.determinant();
-
-  // Make potential calculator - for sampling function only
-  this->potential =
-      std::make_shared<canonical::CanonicalPotential>(this->system);
-  this->potential->set(this->state, this->conditions);
-  this->formation_energy = this->potential->formation_energy();
-
-  // if same supercell
-  // -> just re-set state & conditions & avoid re-constructing event list
-  if (this->transformation_matrix_to_super ==
-          get_transformation_matrix_to_super(state) &&
-      this->conditions != nullptr) {
-    for (auto &event_state_calculator :
-         this->event_data->prim_event_calculators) {
-      event_state_calculator.set(this->state, this->conditions);
-    }
-  } else {
-    this->transformation_matrix_to_super =
-        get_transformation_matrix_to_super(state);
-    n_unitcells = this->transformation_matrix_to_super.determinant();
-    this->event_data->update(state, this->conditions, occ_location,
-                             this->event_filters);
+  if (!this->conditions->mol_composition.has_value()) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: state `mol_composition` conditions not set.");
   }
+  Index n_unitcells = this->transformation_matrix_to_super.determinant();
 
   // Random number generator
   monte::RandomNumberGenerator<EngineType> random_number_generator(
@@ -86,33 +78,732 @@ void Kinetic<EngineType>::run(state_type &state,
   std::vector<monte::OccSwap> const &semigrand_canonical_swaps =
       get_semigrand_canonical_swaps(*this->system);
   clexmonte::enforce_composition(
-      get_occupation(state),
-      state.conditions.vector_values.at("mol_composition"),
+      get_occupation(state), *this->conditions->mol_composition,
       get_composition_calculator(*system), semigrand_canonical_swaps,
       occ_location, random_number_generator);
 
+  // if changing supercell, and event data for the new supercell are cached
+  // -> swap the current event data into the cache, and use the cached event
+  //    data as if in the same supercell
+  Eigen::Matrix3l const &T = get_transformation_matrix_to_super(state);
+  bool same_supercell = (this->transformation_matrix_to_super == T);
+  if (!same_supercell && this->event_data_cache.max_bytes() > 0) {
+    std::shared_ptr<KineticEventData> cached = this->event_data_cache.take(T);
+    if (n_unitcells != 0) {
+      // worker threads are not kept for cached event data
+      this->event_data->parallel_event_calculator.reset();
+      this->event_data_cache.insert(this->transformation_matrix_to_super,
+                                    this->event_data);
+    }
+    if (cached) {
+      this->event_data = cached;
+      this->transformation_matrix_to_super = T;
+      n_unitcells = T.determinant();
+      same_supercell = true;
+    } else {
+      this->event_data = make_event_data_with_same_options(*this->event_data);
+    }
+  }
+
+  // if same supercell
+  // -> just re-set state & conditions & avoid re-constructing event list,
+  //    unless species that were absent when it was constructed are present
+  if (same_supercell &&
+      this->event_data->event_list_params.skip_impossible_events &&
+      find_possible_prim_events(this->event_data->prim_event_list,
+                                occ_location) !=
+          this->event_data->possible_prim_events) {
+    same_supercell = false;
+  }
+  // the "rejection" event selector does not use the impact table, so the
+  // event list is re-constructed if changing to or from it
+  bool require_impact_table =
+      (this->event_selector_params.type != EventSelectorType::rejection);
+  if (this->event_data->require_impact_table != require_impact_table) {
+    this->event_data->require_impact_table = require_impact_table;
+    same_supercell = false;
+  }
+  if (same_supercell && this->conditions != nullptr) {
+    set_prim_event_calculators(this->event_data->prim_event_calculators,
+                               this->state, this->conditions);
+    // events constructed on demand must use the current occupant tracker
+    auto const &builder = this->event_data->event_list.events.builder();
+    if (builder) {
+      builder->set_occ_location(occ_location);
+    }
+    if (this->event_data->on_demand_event_calculator) {
+      this->event_data->on_demand_event_calculator->event_builder
+          .set_occ_location(occ_location);
+    }
+    // active events must be found for the current state
+    if (this->event_data->active_event_set) {
+      this->event_data->active_event_set->reset(get_occupation(state));
+    }
+    // worker calculators must evaluate the current state
+    this->event_data->update_parallel_event_calculator(state,
+                                                       this->conditions);
+  } else {
+    this->transformation_matrix_to_super = T;
+    n_unitcells = this->transformation_matrix_to_super.determinant();
+    this->event_data->update(state, this->conditions, occ_location,
+                             this->event_filters);
+  }
+
+  // The potential is for sampling functions only; it shares the formation
+  // energy cluster expansion already set by the event calculators
+  auto const &prim_event_calculators =
+      this->event_data->prim_event_calculators;
+  if (prim_event_calculators.empty()) {
+    this->potential->set(this->state, this->conditions);
+  } else {
+    this->potential->set(this->state, this->conditions,
+                         prim_event_calculators[0].formation_energy_clex());
+  }
+  this->formation_energy = this->potential->formation_energy();
+
+  // Cached event state parts may be out of date after changing the state.
+  // If only the conditions changed (i.e. a temperature series), they are
+  // kept, and only activation energies and rates are recalculated.
+  auto &event_state_cache = this->event_data->event_state_cache;
+  if (event_state_cache) {
+    Eigen::VectorXi const &cached_occupation =
+        this->event_data->event_state_cache_occupation;
+    if (!same_supercell ||
+        cached_occupation.size() != get_occupation(state).size() ||
+        cached_occupation != get_occupation(state)) {
+      event_state_cache->invalidate();
+    }
+  }
+
+  // Atom displacements of each applied event are accumulated, per sampling
+  // fixture, by the displacement cache
+  AtomDisplacementCalculator displacement_f(
+      *get_prim_basicstructure(*this->system), n_unitcells);
+
   // Used to apply selected events: EventID -> monte::OccEvent
-  auto get_event_f = [&](EventID const &selected_event_id) {
-    // returns a monte::OccEvent
-    return this->event_data->event_list.events.at(selected_event_id).event;
+  // The last applied event is kept so that the cache can be updated for it
+  // at the end of the run.
+  bool has_applied_event = false;
+  EventID last_applied_event_id;
+  // Returns a reference to the stored or on-demand built event, so that no
+  // monte::OccEvent (and its vectors) is copied per step
+  auto get_event_f =
+      [&](EventID const &selected_event_id) -> monte::OccEvent const & {
+    has_applied_event = true;
+    last_applied_event_id = selected_event_id;
+    auto const &on_demand = this->event_data->on_demand_event_calculator;
+    monte::OccEvent const &event =
+        on_demand ? on_demand->event_builder(selected_event_id).event
+                  : this->event_data->event_list.events.at(selected_event_id)
+                        .event;
+    if (this->event_rate_totals) {
+      this->rate_weighted_diffusion_sums.add_step(
+          this->event_rate_totals->prim_event_total_rate(),
+          selected_event_id.prim_event_index);
+    }
+    if (this->atom_tracker) {
+      this->atom_tracker->apply(event);
+      auto const &moved_atoms = this->atom_tracker->moved_atoms();
+      auto const &dR = this->atom_tracker->moved_atom_displacements();
+      for (Index i = 0; i < Index(moved_atoms.size()); ++i) {
+        this->jump_counter.count_atom(moved_atoms[i]);
+        this->displacement_cache.add_displacement(moved_atoms[i], dR[i]);
+      }
+    } else {
+      this->jump_counter.count(event, occ_location);
+      for (auto const &traj : event.atom_traj) {
+        Index atom_id =
+            occ_location.mol(traj.from.mol_id).component[traj.from.mol_comp];
+        this->displacement_cache.add_displacement(atom_id,
+                                                  displacement_f(traj));
+      }
+    }
+    return event;
   };
 
-  // Make selector
-  lotto::RejectionFreeEventSelector event_selector(
-      this->event_data->event_calculator,
-      clexmonte::make_complete_event_id_list(n_unitcells,
-                                             this->event_data->prim_event_list),
-      this->event_data->event_list.impact_table,
-      std::make_shared<lotto::RandomGenerator>(run_manager.engine));
+  // Sampling fixture labels, in the order of their displacement cache slots
+  std::vector<std::string> sampling_fixture_labels;
+  for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+    sampling_fixture_labels.push_back(fixture_ptr->label());
+  }
 
   // Update atom_name_index_list -- These do not change --
   // TODO: KMC with atoms that move to/from resevoir will need to update this
   auto event_system = get_event_system(*this->system);
-  this->kmc_data.atom_name_index_list =
-      make_atom_name_index_list(occ_location, *event_system);
+  if (this->tracked_atom_names.empty()) {
+    this->atom_tracker.reset();
+    this->kmc_data.atom_name_index_list =
+        make_atom_name_index_list(occ_location, *event_system);
+    this->displacement_cache.reset_accumulated(
+        this->kmc_data.atom_name_index_list.size(), sampling_fixture_labels);
+    this->jump_counter.reset(this->kmc_data.atom_name_index_list,
+                             event_system->atom_name_list.size(),
+                             occ_location);
+  } else {
+    this->atom_tracker =
+        std::make_shared<SelectiveAtomTracker>(this->tracked_atom_names);
+    this->atom_tracker->reset(occ_location, *event_system,
+                              *get_prim_basicstructure(*this->system));
+    this->kmc_data.atom_name_index_list =
+        this->atom_tracker->atom_name_index_list();
+    this->displacement_cache.reset_accumulated(
+        this->kmc_data.atom_name_index_list.size(), sampling_fixture_labels);
+    this->jump_counter.reset(this->kmc_data.atom_name_index_list,
+                             event_system->atom_name_list.size());
+  }
+
+  // The rate-weighted diffusion sums cost O(n_prim_events) per event, so
+  // they are only accumulated if sampled
+  bool sample_rate_weighted = false;
+  for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+    auto const &samplers = fixture_ptr->results().samplers;
+    if (samplers.count("L_isotropic_rate_weighted") ||
+        samplers.count("L_anisotropic_rate_weighted")) {
+      sample_rate_weighted = true;
+    }
+  }
+  this->rate_weighted_diffusion_sums.reset(
+      make_prim_event_atom_displacements(this->event_data->prim_event_list,
+                                         *event_system, displacement_f),
+      event_system->atom_name_list.size(), occ_location.atom_size(),
+      sample_rate_weighted);
+
+  // Approximate memory usage, for sizing jobs and choosing memory budgets
+  this->memory_report = make_memory_report(state, occ_location, run_manager);
+  print(CASM::log(), this->memory_report);
+
+  // Optionally record the selected events, for replay
+  Index n_prim_events = this->event_data->prim_event_list.size();
+  std::shared_ptr<EventJournalWriter> event_journal;
+  if (!this->event_journal_path.empty()) {
+    if (!this->replay_event_journal_path.empty()) {
+      throw std::runtime_error(
+          "Error in Kinetic::run: cannot both write and replay an event "
+          "journal");
+    }
+    event_journal = std::make_shared<EventJournalWriter>(
+        this->event_journal_path, n_unitcells, n_prim_events);
+  }
+
+  // Optionally sample the state after selected events
+  auto const &event_triggered_sampler = this->event_triggered_sampler;
+  if (event_triggered_sampler) {
+    std::vector<std::string> prim_event_type_names;
+    for (auto const &prim_event_data : this->event_data->prim_event_list) {
+      prim_event_type_names.push_back(prim_event_data.event_type_name);
+    }
+    event_triggered_sampler->reset(prim_event_type_names);
+  }
+
+  // Optionally sample the state at regular times
+  auto const &time_resolved_sampler = this->time_resolved_sampler;
+  if (time_resolved_sampler) {
+    time_resolved_sampler->reset();
+  }
+
+  // Runs the KMC loop, with time-resolved sampling if enabled
+  auto run_time_resolved = [&](auto &event_selector) {
+    if (!time_resolved_sampler) {
+      monte::kinetic_monte_carlo<EventID>(state, occ_location, this->kmc_data,
+                                          event_selector, get_event_f,
+                                          run_manager);
+      return;
+    }
+    typedef std::decay_t<decltype(event_selector)> selector_type;
+    TimeResolvedSamplingSelector<selector_type> sampling_selector(
+        event_selector, time_resolved_sampler);
+    monte::kinetic_monte_carlo<EventID>(state, occ_location, this->kmc_data,
+                                        sampling_selector, get_event_f,
+                                        run_manager);
+    fs::path const &output_file = time_resolved_sampler->params.output_file;
+    if (!output_file.empty()) {
+      jsonParser json;
+      to_json(*time_resolved_sampler, json);
+      json.write(output_file);
+    }
+  };
+
+  // Runs the KMC loop, with event-triggered sampling if enabled
+  auto run_loop = [&](auto &event_selector) {
+    if (!event_triggered_sampler) {
+      run_time_resolved(event_selector);
+      return;
+    }
+    typedef std::decay_t<decltype(event_selector)> selector_type;
+    EventTriggeredSamplingSelector<selector_type> sampling_selector(
+        event_selector, event_triggered_sampler);
+    run_time_resolved(sampling_selector);
+    event_triggered_sampler->sample_if_pending();
+    fs::path const &output_file = event_triggered_sampler->params.output_file;
+    if (!output_file.empty()) {
+      jsonParser json;
+      to_json(*event_triggered_sampler, json);
+      json.write(output_file);
+    }
+  };
+
+  // Times event selector initialization, from the start of selector setup
+  // until the run begins, as startup phase "event_selector"
+  std::optional<PhaseTimer> event_selector_timer;
+
+  auto run_kmc = [&](auto &event_selector) {
+    event_selector_timer.reset();
+    if (event_journal) {
+      typedef std::decay_t<decltype(event_selector)> selector_type;
+      JournalingEventSelector<selector_type> journaling_selector(
+          event_selector, event_journal);
+      run_loop(journaling_selector);
+      event_journal->flush();
+      return;
+    }
+    run_loop(event_selector);
+  };
+
+  // Replay journaled events, without calculating event rates
+  if (!this->replay_event_journal_path.empty()) {
+    ReplayEventSelector event_selector(
+        std::make_shared<EventJournalReader>(this->replay_event_journal_path),
+        n_unitcells, n_prim_events);
+    run_loop(event_selector);
+    return;
+  }
+
+  // Events adjacent to defects only, without the complete event list
+  if (this->event_selector_params.type == EventSelectorType::defect) {
+    if (!this->event_data->on_demand_event_calculator) {
+      throw std::runtime_error(
+          "Error in Kinetic::run: the \"defect\" event selector requires "
+          "event_data->on_demand_events");
+    }
+    event_selector_timer.emplace(this->system->startup_timings,
+                                 "event_selector");
+    DefectEventSelector<OnDemandEventCalculator, EngineType> event_selector(
+        this->event_data->on_demand_event_calculator,
+        this->event_data->prim_event_list,
+        this->event_data->prim_impact_info_list,
+        make_is_defect_species(*event_system,
+                               this->event_selector_params.defect_species),
+        occ_location, run_manager.engine);
+    run_kmc(event_selector);
+    _write_non_normal_event_summary();
+    return;
+  }
+
+  // Event rate totals are only current for selectors that recalculate the
+  // rates of all impacted events after each event
+  EventSelectorType selector_type = this->event_selector_params.type;
+  bool maintains_rate_totals =
+      (selector_type == EventSelectorType::lotto_rejection_free ||
+       selector_type == EventSelectorType::sum_tree ||
+       selector_type == EventSelectorType::grouped_sum_tree ||
+       selector_type == EventSelectorType::composition_rejection);
+  auto const &event_rate_totals = this->event_data->event_rate_totals;
+  if (event_rate_totals) {
+    event_rate_totals->reset();
+  }
+  this->event_data->event_calculator->event_rate_totals =
+      maintains_rate_totals ? event_rate_totals : nullptr;
+  this->event_rate_totals =
+      maintains_rate_totals ? event_rate_totals : nullptr;
+
+  // Make selector & run
+  event_selector_timer.emplace(this->system->startup_timings,
+                               "event_selector");
+  CompleteEventList const &event_list = this->event_data->event_list;
+  // Only included events are selectable, for all selectors, so events
+  // removed by event filters do not take space in the selector
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+
+  // Approximate deferred rate updates beyond deferred_update_radius
+  EventSelectorParams const &selector_params = this->event_selector_params;
+  bool use_deferred_updates =
+      (selector_params.type == EventSelectorType::sum_tree &&
+       selector_params.deferred_update_interval > 1);
+  std::shared_ptr<RelativeEventImpactTable const> immediate_table;
+  if (use_deferred_updates) {
+    immediate_table = std::make_shared<RelativeEventImpactTable>(
+        make_relative_impact_table_within(
+            this->event_data->prim_impact_info_list,
+            *get_prim_basicstructure(*this->system),
+            selector_params.deferred_update_radius),
+        occ_location.convert().unitcell_index_converter());
+  }
+  this->deferred_update_diagnostics = DeferredUpdateDiagnostics();
+
+  // Superbasin acceleration of recurrent event pairs
+  bool use_superbasin =
+      (selector_params.type == EventSelectorType::sum_tree &&
+       selector_params.superbasin_n_recurrence > 0);
+  SuperbasinParams superbasin_params;
+  superbasin_params.n_recurrence = selector_params.superbasin_n_recurrence;
+  superbasin_params.scale_factor = selector_params.superbasin_scale_factor;
+  superbasin_params.min_scale = selector_params.superbasin_min_scale;
+  this->superbasin_diagnostics = SuperbasinDiagnostics();
+
+  // Scheduled changes of enabled events and temperature
+  bool use_event_schedule = !this->event_schedule.empty();
+  if (use_event_schedule &&
+      selector_params.type != EventSelectorType::sum_tree) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: \"event_schedule\" requires the "
+        "\"sum_tree\" event selector");
+  }
+
+  // Synchronous sublattice parallel KMC, with one independent event
+  // calculator per thread
+  bool use_synchronous_sublattice =
+      (selector_params.type == EventSelectorType::synchronous_sublattice);
+  std::shared_ptr<SublatticeDecomposition const> decomposition;
+  std::vector<std::shared_ptr<IndependentEventCalculator>>
+      independent_calculators;
+  if (use_synchronous_sublattice) {
+    if (!event_list.events.stores_event_data()) {
+      throw std::runtime_error(
+          "Error in Kinetic::run: the \"synchronous_sublattice\" event "
+          "selector requires event_list_params.store_event_data");
+    }
+    Eigen::Vector3l domain_shape;
+    for (Index k = 0; k < 3; ++k) {
+      domain_shape(k) = selector_params.domain_shape[k];
+    }
+    decomposition = std::make_shared<SublatticeDecomposition>(
+        T, event_impact_reach(this->event_data->prim_impact_info_list),
+        n_prim_events, event_id_list, domain_shape);
+    independent_calculators = make_independent_event_calculators(
+        *this->event_data->event_calculator, this->system, state,
+        this->conditions, std::max(Index(1), this->event_data->n_threads));
+  }
+  this->synchronous_sublattice_diagnostics =
+      SynchronousSublatticeDiagnostics();
+
+  // Rejection KMC, with an upper bound on event rates for each prim event
+  bool use_rejection = (selector_params.type == EventSelectorType::rejection);
+  std::vector<double> prim_event_max_rate(n_prim_events, 0.0);
+  if (use_rejection) {
+    for (auto const &pair : selector_params.max_rate_by_event_type) {
+      bool found = false;
+      for (Index p = 0; p < n_prim_events; ++p) {
+        if (this->event_data->prim_event_list[p].event_type_name ==
+            pair.first) {
+          prim_event_max_rate[p] = pair.second;
+          found = true;
+        }
+      }
+      if (!found) {
+        std::stringstream msg;
+        msg << "Error in Kinetic::run: \"max_rate_by_event_type\" includes "
+               "unknown event type \""
+            << pair.first << "\"";
+        throw std::runtime_error(msg.str());
+      }
+    }
+  }
+  this->rejection_diagnostics = RejectionDiagnostics();
+
+  auto run_with = [&](auto const &impact_table, auto const &event_calculator) {
+    if (use_rejection) {
+      typedef typename std::decay_t<decltype(event_calculator)>::element_type
+          calculator_type;
+      RejectionEventSelector<calculator_type, EngineType> event_selector(
+          event_calculator, event_id_list, prim_event_max_rate,
+          selector_params.max_rate, selector_params.max_rate_factor,
+          run_manager.engine);
+      this->rejection_prim_event_max_rate =
+          event_selector.prim_event_max_rate();
+      run_kmc(event_selector);
+      this->rejection_diagnostics = event_selector.diagnostics();
+      return;
+    }
+    if (use_synchronous_sublattice) {
+      typedef std::decay_t<decltype(impact_table)> table_type;
+      SynchronousSublatticeEventSelector<IndependentEventCalculator,
+                                         table_type, EngineType>
+          event_selector(independent_calculators, decomposition,
+                         n_prim_events, impact_table, event_list.events,
+                         get_occupation(state), selector_params.time_horizon,
+                         run_manager.engine);
+      run_kmc(event_selector);
+      this->synchronous_sublattice_diagnostics = event_selector.diagnostics();
+      return;
+    }
+    if (use_deferred_updates || use_superbasin || use_event_schedule) {
+      typedef typename std::decay_t<decltype(event_calculator)>::element_type
+          calculator_type;
+      typedef std::decay_t<decltype(impact_table)> table_type;
+      SumTreeEventSelector<calculator_type, table_type, EngineType>
+          event_selector(event_calculator, n_unitcells, n_prim_events,
+                         event_id_list, impact_table, run_manager.engine);
+      event_selector.set_n_threads(this->event_data->n_threads);
+      if (use_deferred_updates) {
+        event_selector.set_deferred_updates(
+            immediate_table, selector_params.deferred_update_interval);
+      }
+      if (use_superbasin) {
+        event_selector.set_superbasin(superbasin_params);
+      }
+      if (use_event_schedule) {
+        ScheduledEventSelector<decltype(event_selector)>
+            scheduled_event_selector(
+                event_selector, this->event_schedule,
+                [&](double temperature) {
+                  this->conditions->set_temperature(temperature);
+                });
+        run_kmc(scheduled_event_selector);
+      } else {
+        run_kmc(event_selector);
+      }
+      this->deferred_update_diagnostics =
+          event_selector.deferred_update_diagnostics();
+      this->superbasin_diagnostics = event_selector.superbasin_diagnostics();
+      return;
+    }
+    run_with_event_selector(this->event_selector_params, event_calculator,
+                            n_unitcells, n_prim_events, event_id_list,
+                            impact_table, run_manager.engine, run_kmc);
+  };
+  auto run_with_table = [&](auto const &impact_table) {
+    if (this->event_data->parallel_event_calculator) {
+      run_with(impact_table, this->event_data->parallel_event_calculator);
+    } else {
+      run_with(impact_table, this->event_data->event_calculator);
+    }
+  };
+  if (event_list.impact_table_type == ImpactTableType::map) {
+    run_with_table(event_list.impact_table);
+  } else if (event_list.impact_table_type == ImpactTableType::relative) {
+    run_with_table(*event_list.relative_impact_table);
+  } else if (event_list.impact_table_type == ImpactTableType::supercell) {
+    run_with_table(*event_list.supercell_impact_table);
+  } else if (event_list.impact_table_type == ImpactTableType::csr) {
+    run_with_table(*event_list.csr_impact_table);
+  } else {
+    throw std::runtime_error(
+        "Error in Kinetic::run: invalid impact table type");
+  }
+  _write_non_normal_event_summary();
+  if (this->event_data->local_environment_cache) {
+    _write_local_environment_cache_summary();
+  }
+  if (use_deferred_updates) {
+    _write_deferred_update_summary();
+  }
+  if (use_superbasin) {
+    _write_superbasin_summary();
+  }
+  if (use_rejection) {
+    _write_rejection_summary();
+  }
+  if (use_synchronous_sublattice) {
+    Log &event_log = this->event_data->event_calculator->event_log;
+    for (auto const &calculator : independent_calculators) {
+      this->event_data->event_calculator->not_normal_count +=
+          calculator->calculator.not_normal_count;
+      event_log.ostream() << calculator->log_stream.str();
+    }
+    _write_synchronous_sublattice_summary();
+  }
+
+  // The last applied event has not been registered with the calculator by
+  // the event selector, so register it now to keep the cache valid for the
+  // final state
+  if (event_state_cache) {
+    if (has_applied_event) {
+      this->event_data->event_calculator->set_occurred_event(
+          last_applied_event_id);
+    }
+    this->event_data->event_state_cache_occupation = get_occupation(state);
+  }
+}
+
+/// \brief Write remaining non-normal event examples, and counts by prim
+///     event, to the event log
+///
+/// Counts are cumulative since the event list was last constructed. Does
+/// nothing if no non-normal events have been counted.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_non_normal_event_summary() {
+  auto const &non_normal_event_log = this->event_data->non_normal_event_log;
+  if (!non_normal_event_log || non_normal_event_log->total_count() == 0) {
+    return;
+  }
+  non_normal_event_log->flush();
+  Log &event_log = this->event_data->event_calculator->event_log;
+  non_normal_event_log->print_summary(event_log.ostream());
+}
+
+/// \brief Write deferred rate update diagnostics to the event log
+///
+/// The rate errors are the differences between stale and recalculated
+/// rates of events whose updates were deferred, for the last run.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_deferred_update_summary() {
+  DeferredUpdateDiagnostics const &d = this->deferred_update_diagnostics;
+  Log &event_log = this->event_data->event_calculator->event_log;
+  std::ostream &sout = event_log.ostream();
+  sout << "Deferred rate updates:" << std::endl;
+  sout << "  n_flushes: " << d.n_flushes << std::endl;
+  sout << "  n_deferred_updates: " << d.n_deferred_updates << std::endl;
+  sout << "  n_flushed_events: " << d.n_flushed_events << std::endl;
+  sout << "  max_abs_rate_error: " << d.max_abs_rate_error << std::endl;
+  sout << "  mean_abs_rate_error: "
+       << (d.n_flushed_events ? d.sum_abs_rate_error / d.n_flushed_events
+                              : 0.0)
+       << std::endl;
+  sout << "  max_rel_total_rate_error: " << d.max_rel_total_rate_error
+       << std::endl;
+}
+
+/// \brief Write local environment cache hit-rate statistics to the event
+///     log
+///
+/// Counts are cumulative since the event list was last constructed, and
+/// include the caches of worker threads.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_local_environment_cache_summary() {
+  std::vector<std::shared_ptr<LocalEnvironmentCache const>> caches = {
+      this->event_data->local_environment_cache};
+  if (this->event_data->parallel_event_calculator) {
+    for (auto const &cache : this->event_data->parallel_event_calculator
+                                 ->worker_local_environment_caches()) {
+      caches.push_back(cache);
+    }
+  }
+  Index size = 0;
+  Index n_hits = 0;
+  Index n_misses = 0;
+  Index n_clears = 0;
+  for (auto const &cache : caches) {
+    size += cache->size();
+    n_hits += cache->n_hits();
+    n_misses += cache->n_misses();
+    n_clears += cache->n_clears();
+  }
+  Log &event_log = this->event_data->event_calculator->event_log;
+  std::ostream &sout = event_log.ostream();
+  sout << "Local environment cache:" << std::endl;
+  sout << "  size: " << size << std::endl;
+  sout << "  n_hits: " << n_hits << std::endl;
+  sout << "  n_misses: " << n_misses << std::endl;
+  sout << "  hit_rate: "
+       << (n_hits + n_misses ? double(n_hits) / (n_hits + n_misses) : 0.0)
+       << std::endl;
+  sout << "  n_clears: " << n_clears << std::endl;
+}
+
+/// \brief Write superbasin acceleration diagnostics to the event log
+///
+/// The diagnostics are for the last run.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_superbasin_summary() {
+  SuperbasinDiagnostics const &d = this->superbasin_diagnostics;
+  Log &event_log = this->event_data->event_calculator->event_log;
+  std::ostream &sout = event_log.ostream();
+  sout << "Superbasin acceleration:" << std::endl;
+  sout << "  n_recurrences: " << d.n_recurrences << std::endl;
+  sout << "  n_scalings: " << d.n_scalings << std::endl;
+  sout << "  n_exits: " << d.n_exits << std::endl;
+  sout << "  n_scaled_selections: " << d.n_scaled_selections << std::endl;
+  sout << "  scaled_time: " << d.scaled_time << std::endl;
+  sout << "  min_scale: " << d.min_scale << std::endl;
+}
+
+/// \brief Write rejection KMC diagnostics to the event log
+///
+/// The diagnostics are for the last run.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_rejection_summary() {
+  RejectionDiagnostics const &d = this->rejection_diagnostics;
+  Log &event_log = this->event_data->event_calculator->event_log;
+  std::ostream &sout = event_log.ostream();
+  sout << "Rejection KMC:" << std::endl;
+  sout << "  n_proposed: " << d.n_proposed << std::endl;
+  sout << "  n_accepted: " << d.n_accepted << std::endl;
+  sout << "  rejection_fraction: " << d.rejection_fraction() << std::endl;
+  sout << "  max_rate:" << std::endl;
+  auto const &prim_event_list = this->event_data->prim_event_list;
+  for (Index p = 0; p < this->rejection_prim_event_max_rate.size(); ++p) {
+    sout << "    " << p << " (" << prim_event_list[p].event_type_name
+         << "): " << this->rejection_prim_event_max_rate[p] << std::endl;
+  }
+}
+
+/// \brief Write synchronous sublattice diagnostics to the event log
+///
+/// The diagnostics are for the last run.
+template <typename EngineType>
+void Kinetic<EngineType>::_write_synchronous_sublattice_summary() {
+  SynchronousSublatticeDiagnostics const &d =
+      this->synchronous_sublattice_diagnostics;
+  Log &event_log = this->event_data->event_calculator->event_log;
+  std::ostream &sout = event_log.ostream();
+  sout << "Synchronous sublattice:" << std::endl;
+  sout << "  time_horizon: " << d.time_horizon << std::endl;
+  sout << "  n_cycles: " << d.n_cycles << std::endl;
+  sout << "  n_phases: " << d.n_phases << std::endl;
+  sout << "  n_events: " << d.n_events << std::endl;
+  sout << "  max_task_events: " << d.max_task_events << std::endl;
+  sout << "  n_boundary_updates: " << d.n_boundary_updates << std::endl;
+}
+
+/// \brief Approximate memory used by each subsystem of a run
+///
+/// Includes, in order:
+/// - "supercell_data": `System::supercell_data`, with its budget
+///   ("supercell_data_max_size_in_bytes"), if set
+/// - "kmc_events", "kmc_impact_table", "kmc_event_states", and
+///   "kmc_event_calculators": see `KineticEventData::add_memory_usage`
+/// - "kmc_event_selector": the rates and sum tree, or other structures, of
+///   the event selector, estimated from the number of events
+/// - "kmc_event_data_cache": `event_data_cache`, with its budget
+///   ("event_data_cache_size_mb"), if enabled
+/// - "occ_location": the occupant location tracker
+/// - "sampling_fixture/<label>": the data sampled so far by each sampling
+///   fixture (see `approximate_memory_usage` for sampling fixtures)
+///
+/// \param state The state being run
+/// \param occ_location The occupant location tracker of the run
+/// \param run_manager The run manager of the run
+///
+/// \returns The memory report
+template <typename EngineType>
+MemoryReport Kinetic<EngineType>::make_memory_report(
+    state_type const &state, monte::OccLocation const &occ_location,
+    run_manager_type<EngineType> const &run_manager) const {
+  MemoryReport report;
+  SupercellSystemDataCache const &supercell_data =
+      this->system->supercell_data;
+  std::optional<std::size_t> supercell_data_max_bytes;
+  if (supercell_data.max_size_in_bytes().has_value()) {
+    supercell_data_max_bytes = *supercell_data.max_size_in_bytes();
+  }
+  report.add("supercell_data", supercell_data.size_in_bytes(),
+             supercell_data_max_bytes);
+
+  this->event_data->add_memory_usage(report);
+
+  // rejection-free selectors keep about one rate and one sum tree node per
+  // event; the "rejection" selector keeps one bound per prim event
+  std::size_t n_events = this->event_data->event_list.events.n_slots();
+  std::size_t n_prim_events = this->event_data->prim_event_list.size();
+  EventSelectorType selector_type = this->event_selector_params.type;
+  std::size_t selector_bytes = 0;
+  if (selector_type == EventSelectorType::rejection) {
+    selector_bytes = n_prim_events * sizeof(double);
+  } else if (selector_type != EventSelectorType::defect) {
+    selector_bytes = n_events * 2 * sizeof(double);
+  }
+  report.add("kmc_event_selector", selector_bytes);
+
+  if (this->event_data_cache.max_bytes() > 0) {
+    report.add("kmc_event_data_cache", this->event_data_cache.bytes(),
+               this->event_data_cache.max_bytes());
+  }
 
-  monte::kinetic_monte_carlo<EventID>(state, occ_location, this->kmc_data,
-                                      event_selector, get_event_f, run_manager);
+  report.add("occ_location", clexmonte::approximate_memory_usage(
+                                 occ_location, get_occupation(state).size()));
+  clexmonte::add_memory_usage(report, run_manager);
+  return report;
 }
 
 /// \brief Construct functions that may be used to sample various quantities
@@ -134,11 +825,14 @@ Kinetic<EngineType>::standard_sampling_functions(
       make_mean_R_squared_individual_anisotropic_f(calculation),
       make_L_isotropic_f(calculation),
       make_L_anisotropic_f(calculation),
+      make_L_isotropic_rate_weighted_f(calculation),
+      make_L_anisotropic_rate_weighted_f(calculation),
       make_D_tracer_isotropic_f(calculation),
       make_D_tracer_anisotropic_f(calculation),
       make_jumps_per_atom_by_type_f(calculation),
       make_jumps_per_event_by_type_f(calculation),
-      make_jumps_per_atom_per_event_by_type_f(calculation)};
+      make_jumps_per_atom_per_event_by_type_f(calculation),
+      make_total_rate_by_event_type_f(calculation)};
 
   make_order_parameter_f(functions, calculation);
   make_subspace_order_parameter_f(functions, calculation);
@@ -1,9 +1,14 @@
 #ifndef CASM_clexmonte_kinetic_json_io
 #define CASM_clexmonte_kinetic_json_io
 
+#include <algorithm>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/events/io/json/CompleteEventListParams_json_io.hh"
 #include "casm/clexmonte/events/io/json/EventFilterGroup_json_io.hh"
+#include "casm/clexmonte/events/io/json/EventSelectorParams_json_io.hh"
+#include "casm/clexmonte/kinetic/io/json/BarrierModel_json_io.hh"
 #include "casm/clexmonte/kinetic/kinetic.hh"
 #include "casm/clexmonte/misc/parse_array.hh"
 
@@ -41,6 +46,194 @@ namespace kinetic {
 ///         "exclude" are allowed. If `false`, the events not listed in
 ///         "include" or "exclude" are not allowed.
 ///
+///   "event_list_params": <clexmonte::CompleteEventListParams> (optional)
+///       Controls how the complete event list is stored. Has the format:
+///
+///     "store_site_arrays": bool (optional, default=false)
+///         If true, store the sites of all events in a contiguous
+///         structure-of-arrays layout, which is used for event rate
+///         calculations. Event data is then constructed on demand, and
+///         "store_event_data" is ignored.
+///     "store_event_data": bool (optional, default=true)
+///         If true, store the translated event data for every event. If
+///         false, only which events are included is stored and event data
+///         is constructed on demand.
+///     "impact_table": string (optional, default="map")
+///         How the impact table is stored, one of "map", "relative",
+///         "supercell", or "csr". The "lotto_rejection_free" event
+///         selector requires "map".
+///     "skip_impossible_events": bool (optional, default=false)
+///         If true, do not construct events of prim events which can never
+///         be allowed, because the prim event's initial occupants are not
+///         allowed on its sites, or are not present in the initial state.
+///         Requires an "event_selector" other than "lotto_rejection_free".
+///
+///   "event_selector": <clexmonte::EventSelectorParams> (optional)
+///       Chooses the event selector method. The default is
+///       "lotto_rejection_free" if "impact_table" is "map", and "sum_tree"
+///       otherwise. Has the format:
+///
+///     "type": string (required)
+///         One of "lotto_rejection_free", "sum_tree", "grouped_sum_tree",
+///         "composition_rejection", "rejection", "defect", or
+///         "synchronous_sublattice". The "sum_tree",
+///         "grouped_sum_tree", and "composition_rejection" selectors are
+///         rejection-free and may use any impact table. The
+///         "grouped_sum_tree" selector first chooses a prim event, then a
+///         translation from a per-prim-event sum tree, which keeps trees
+///         small for large supercells. The "composition_rejection" selector
+///         bins events by rate, which makes selection efficient when rates
+///         span many orders of magnitude. The "rejection" selector proposes
+///         events in proportion to the upper bound on the rates of their
+///         event type and accepts them with probability rate / max_rate,
+///         only calculating the rates of proposed events, without storing
+///         rates or constructing the impact table.
+///         The "defect" selector only tracks events that include a site
+///         occupied by a defect species, and does not construct the complete
+///         event list, so memory use and the cost per event do not depend on
+///         the supercell size. It requires that every prim event has a
+///         defect species in its initial occupation, and cannot be used with
+///         "event_filters", "n_threads" > 1, "split_impact_neighborhoods",
+///         "store_event_states", or "active_event_set".
+///         The "synchronous_sublattice" selector divides the supercell into
+///         spatial domains, each split into sectors wider than the range of
+///         event impact, and selects events in the same sector of all
+///         domains concurrently, using "n_threads" threads, up to a time
+///         horizon. Events are then applied in time order, so sampling is
+///         unchanged. It is approximate near domain boundaries, requires a
+///         diagonal supercell transformation matrix and stored event data,
+///         and cannot be used with "split_impact_neighborhoods",
+///         "store_event_states", or "active_event_set".
+///     "max_rate": number (optional, default=0.0)
+///         For "rejection", the upper bound on event rates of event types
+///         not in "max_rate_by_event_type". If <= 0.0, the upper bound for
+///         each prim event is "max_rate_factor" times the maximum initial
+///         rate of its events.
+///     "max_rate_factor": number (optional, default=10.0)
+///         For "rejection", used if "max_rate" <= 0.0.
+///     "max_rate_by_event_type": object (optional, default={})
+///         For "rejection", the upper bound on event rates by event type
+///         name, as `{"<event_type_name>": max_rate, ...}`. Tighter upper
+///         bounds give a lower rejection fraction, which is written to the
+///         event log after each run. An event rate greater than its upper
+///         bound is an error.
+///     "defect_species": array of string (optional, default=["Va"])
+///         For "defect", the names of the defect species.
+///     "deferred_update_interval": int (optional, default=1)
+///         For "sum_tree", if > 1, enables approximate deferred rate
+///         updates: events impacted by an occurring event, but without a
+///         site within "deferred_update_radius" of its sites, are only
+///         updated every "deferred_update_interval" events. Rate error
+///         diagnostics are written to the event log after each run.
+///     "deferred_update_radius": number (optional, default=0.0)
+///         For "deferred_update_interval" > 1, the distance (Angstrom)
+///         within which impacted events are updated after every event.
+///     "superbasin_n_recurrence": int (optional, default=0)
+///         For "sum_tree", if > 0, enables superbasin acceleration: after
+///         every "superbasin_n_recurrence" back-and-forth recurrences of a
+///         pair of events, such as a vacancy trapped by a solute, the
+///         rates of both are multiplied by "superbasin_scale_factor",
+///         raising their barriers. Time increments use the scaled rates.
+///         Scaling is removed when an event outside the tracked pairs
+///         occurs. Every selected event occurs, so jump counts are
+///         unaffected. Diagnostics are written to the event log after each
+///         run.
+///     "superbasin_scale_factor": number (optional, default=0.5)
+///         For "superbasin_n_recurrence" > 0, the rate scale factor.
+///     "superbasin_min_scale": number (optional, default=1e-6)
+///         For "superbasin_n_recurrence" > 0, the lower bound on the
+///         accumulated scale of any event rate.
+///     "time_horizon": number (optional, default=0.0)
+///         For "synchronous_sublattice", the time horizon of each phase. If
+///         <= 0.0, the number of domains times sectors divided by the
+///         initial total rate is used, so about one event occurs per domain
+///         per phase.
+///     "domain_shape": array of 3 int (optional, default=[0, 0, 0])
+///         For "synchronous_sublattice", the number of domains along each
+///         supercell lattice vector. Values <= 0 choose the largest number
+///         for which sectors are wider than the range of event impact.
+///
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to recalculate the rates of impacted events
+///       after each event. Rates are the same for any number of threads, so
+///       results are reproducible for a fixed random number seed. Values
+///       greater than 1 require an "event_selector" other than
+///       "lotto_rejection_free".
+///
+///   "split_impact_neighborhoods": bool (optional, default=false)
+///       If true, cache the change in energy and the KRA and attempt
+///       frequency of every event, and after each event only recalculate the
+///       parts of impacted events whose neighborhood (formation energy
+///       cluster expansion or event local cluster expansion) was changed.
+///       The cached parts are kept between runs in the same supercell if a
+///       run starts from the final occupation of the previous run, so when
+///       only the conditions change (i.e. a temperature series) event rates
+///       are recalculated without evaluating cluster expansions.
+///       Requires an "event_selector" other than "lotto_rejection_free".
+///
+///   "local_environment_cache_size": int (optional, default=0)
+///       If > 0, memoize the change in energy and the KRA and attempt
+///       frequency of allowed events by prim event and the occupation of the
+///       sites in their impact neighborhood, keeping at most this many
+///       entries, so that events with an environment seen before are
+///       calculated without evaluating cluster expansions. This is efficient
+///       when there are few distinct local environments, as in dilute
+///       alloys. Hit-rate statistics are written to the event log after each
+///       run. Cannot be used with "split_impact_neighborhoods".
+///
+///   "store_event_states": bool (optional, default=false)
+///       If true, keep the most recently calculated state (rate, energies,
+///       whether allowed and "normal") of every event.
+///
+///   "max_full_event_states": int (optional, default=10000000)
+///       If "store_event_states" is true and the number of events is greater
+///       than this, only the rate and activation energy, as 32-bit floats,
+///       and whether each event is allowed and "normal" are kept, to limit
+///       memory use.
+///
+///   "max_non_normal_examples": int (optional, default=100)
+///       Maximum number of non-normal events (activation energy less than
+///       zero or than the change in energy) written in full to the event
+///       log. Further non-normal events are only counted, and counts by
+///       prim event are written at the end of each run. If < 0, every
+///       non-normal event is written.
+///
+///   "async_event_log": bool (optional, default=false)
+///       If true, non-normal event examples are written by a background
+///       thread.
+///
+///   "active_event_set": bool (optional, default=false)
+///       If true, track which events have their initial occupants in the
+///       current state, and do not calculate the rates of other events,
+///       which are not allowed. This is efficient in dilute systems.
+///       Requires an "event_selector" other than "lotto_rejection_free".
+///
+///   "barrier_models": object (optional)
+///       Specifies how activation energies are calculated, by event type
+///       name. Event types not included use the KRA midpoint formula,
+///       dE_activated = 0.5 * dE_final + Ekra. Has the format:
+///
+///     "<event_type_name>": <clexmonte::kinetic::BarrierModel>
+///         The barrier model for one event type. Has the format:
+///
+///       "type": string (required)
+///           One of "kra" (the KRA midpoint formula), "fixed"
+///           (dE_activated = barrier), or "bep" (Bronsted-Evans-Polanyi
+///           scaling, dE_activated = intercept + slope * dE_final). The
+///           "kra" event local cluster expansion is only required for
+///           "kra".
+///       "barrier": number (required for "fixed")
+///       "intercept": number (required for "bep")
+///       "slope": number (optional, default=0.5)
+///           For "bep".
+///
+///   "event_data_cache_size_mb": number (optional, default=0.0)
+///       Approximate memory, in MB, used to keep the event list and impact
+///       table of previously used supercells, so that when a series of runs
+///       returns to a supercell they are not re-constructed. When the limit
+///       is exceeded, the least recently used supercells are removed. If 0,
+///       only the event data of the current supercell is kept.
+///
 /// \endcode
 ///
 template <typename EngineType>
@@ -58,8 +251,192 @@ void parse(InputParser<Kinetic<EngineType>> &parser,
     }
   }
 
+  // "event_list_params"
+  CompleteEventListParams event_list_params;
+  if (parser.self.contains("event_list_params")) {
+    auto subparser =
+        parser.template subparse<CompleteEventListParams>("event_list_params");
+    if (subparser->valid()) {
+      event_list_params = std::move(*subparser->value);
+    }
+  }
+
+  // "event_selector"
+  EventSelectorParams event_selector_params;
+  if (event_list_params.impact_table_type != ImpactTableType::map) {
+    event_selector_params.type = EventSelectorType::sum_tree;
+  }
+  if (parser.self.contains("event_selector")) {
+    auto subparser =
+        parser.template subparse<EventSelectorParams>("event_selector");
+    if (subparser->valid()) {
+      event_selector_params = std::move(*subparser->value);
+    }
+  }
+  bool is_lotto = (event_selector_params.type ==
+                   EventSelectorType::lotto_rejection_free);
+  if (is_lotto &&
+      event_list_params.impact_table_type != ImpactTableType::map) {
+    parser.insert_error("event_selector",
+                        "Error: the \"lotto_rejection_free\" event selector "
+                        "requires the \"map\" impact table");
+  }
+  if (is_lotto && event_list_params.skip_impossible_events) {
+    parser.insert_error("event_list_params",
+                        "Error: \"skip_impossible_events\" requires an "
+                        "\"event_selector\" other than "
+                        "\"lotto_rejection_free\"");
+  }
+
+  // "n_threads"
+  Index n_threads = 1;
+  parser.optional(n_threads, "n_threads");
+  if (n_threads < 1) {
+    parser.insert_error("n_threads", "Error: \"n_threads\" must be >= 1");
+  } else if (n_threads > 1 && is_lotto) {
+    parser.insert_error("n_threads",
+                        "Error: \"n_threads\" > 1 requires an "
+                        "\"event_selector\" other than "
+                        "\"lotto_rejection_free\"");
+  }
+
+  // "store_event_states"
+  bool store_event_states = false;
+  parser.optional(store_event_states, "store_event_states");
+  Index max_full_event_states = 10000000;
+  parser.optional(max_full_event_states, "max_full_event_states");
+
+  // "max_non_normal_examples", "async_event_log"
+  Index max_non_normal_examples = 100;
+  parser.optional(max_non_normal_examples, "max_non_normal_examples");
+  bool async_event_log = false;
+  parser.optional(async_event_log, "async_event_log");
+
+  // "split_impact_neighborhoods"
+  bool split_impact_neighborhoods = false;
+  parser.optional(split_impact_neighborhoods, "split_impact_neighborhoods");
+  if (split_impact_neighborhoods && is_lotto) {
+    parser.insert_error("split_impact_neighborhoods",
+                        "Error: \"split_impact_neighborhoods\" requires an "
+                        "\"event_selector\" other than "
+                        "\"lotto_rejection_free\"");
+  }
+
+  // "local_environment_cache_size"
+  Index local_environment_cache_size = 0;
+  parser.optional(local_environment_cache_size,
+                  "local_environment_cache_size");
+  if (local_environment_cache_size < 0) {
+    parser.insert_error(
+        "local_environment_cache_size",
+        "Error: \"local_environment_cache_size\" must be >= 0");
+  } else if (local_environment_cache_size > 0 && split_impact_neighborhoods) {
+    parser.insert_error("local_environment_cache_size",
+                        "Error: \"local_environment_cache_size\" > 0 cannot "
+                        "be used with \"split_impact_neighborhoods\"");
+  }
+
+  // "active_event_set"
+  bool use_active_event_set = false;
+  parser.optional(use_active_event_set, "active_event_set");
+  if (use_active_event_set && is_lotto) {
+    parser.insert_error("active_event_set",
+                        "Error: \"active_event_set\" requires an "
+                        "\"event_selector\" other than "
+                        "\"lotto_rejection_free\"");
+  }
+
+  // "barrier_models"
+  std::map<std::string, BarrierModel> barrier_models;
+  if (parser.self.contains("barrier_models")) {
+    auto const &event_type_data = get_event_type_data(*system);
+    jsonParser const &json = parser.self["barrier_models"];
+    for (auto it = json.begin(); it != json.end(); ++it) {
+      std::string name = it.name();
+      fs::path option = fs::path("barrier_models") / name;
+      if (!event_type_data.count(name)) {
+        parser.insert_error(option, "Error: \"" + name +
+                                        "\" is not an event type name");
+        continue;
+      }
+      auto subparser = parser.template subparse<BarrierModel>(option);
+      if (subparser->valid()) {
+        barrier_models[name] = *subparser->value;
+      }
+    }
+  }
+
+  // "event_data_cache_size_mb"
+  double event_data_cache_size_mb = 0.0;
+  parser.optional(event_data_cache_size_mb, "event_data_cache_size_mb");
+  if (event_data_cache_size_mb < 0.0) {
+    parser.insert_error("event_data_cache_size_mb",
+                        "Error: \"event_data_cache_size_mb\" must be >= 0");
+  }
+
+  // "defect" event selector
+  bool is_defect = (event_selector_params.type == EventSelectorType::defect);
+  if (is_defect) {
+    auto const &name_list = get_event_system(*system)->orientation_name_list;
+    for (std::string const &name : event_selector_params.defect_species) {
+      if (std::find(name_list.begin(), name_list.end(), name) ==
+          name_list.end()) {
+        parser.insert_error("event_selector",
+                            "Error: invalid \"defect_species\": \"" + name +
+                                "\" is not an occupant name");
+      }
+    }
+    if (!event_filters.empty() || n_threads > 1 ||
+        split_impact_neighborhoods || store_event_states ||
+        use_active_event_set) {
+      parser.insert_error(
+          "event_selector",
+          "Error: the \"defect\" event selector cannot be used with "
+          "\"event_filters\", \"n_threads\" > 1, "
+          "\"split_impact_neighborhoods\", \"store_event_states\", or "
+          "\"active_event_set\"");
+    }
+  }
+
+  // "synchronous_sublattice" event selector
+  if (event_selector_params.type ==
+      EventSelectorType::synchronous_sublattice) {
+    if (split_impact_neighborhoods || store_event_states ||
+        use_active_event_set) {
+      parser.insert_error(
+          "event_selector",
+          "Error: the \"synchronous_sublattice\" event selector cannot be "
+          "used with \"split_impact_neighborhoods\", "
+          "\"store_event_states\", or \"active_event_set\"");
+    }
+    if (!event_list_params.store_event_data ||
+        event_list_params.store_site_arrays) {
+      parser.insert_error(
+          "event_selector",
+          "Error: the \"synchronous_sublattice\" event selector requires "
+          "\"store_event_data\", and cannot be used with "
+          "\"store_site_arrays\"");
+    }
+  }
+
   if (parser.valid()) {
-    parser.value = std::make_unique<Kinetic<EngineType>>(system, event_filters);
+    parser.value = std::make_unique<Kinetic<EngineType>>(
+        system, event_filters, event_list_params, n_threads);
+    parser.value->event_selector_params = event_selector_params;
+    parser.value->event_data->split_impact_neighborhoods =
+        split_impact_neighborhoods;
+    parser.value->event_data->store_event_states = store_event_states;
+    parser.value->event_data->max_full_event_states = max_full_event_states;
+    parser.value->event_data->local_environment_cache_size =
+        local_environment_cache_size;
+    parser.value->event_data->max_non_normal_examples =
+        max_non_normal_examples;
+    parser.value->event_data->async_event_log = async_event_log;
+    parser.value->event_data->use_active_event_set = use_active_event_set;
+    parser.value->event_data->on_demand_events = is_defect;
+    parser.value->event_data->barrier_models = barrier_models;
+    parser.value->event_data_cache.set_max_bytes(
+        static_cast<std::size_t>(event_data_cache_size_mb * 1024 * 1024));
   }
 }
 
@@ -0,0 +1,256 @@
+#ifndef CASM_clexmonte_kinetic_rate_kernel
+#define CASM_clexmonte_kinetic_rate_kernel
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Exponential function, written without branches so that loops
+///     calling it can be vectorized by the compiler
+///
+/// Uses the range reduction `x = n * ln(2) + r`, with `|r| <= ln(2) / 2`, a
+/// degree 13 Taylor polynomial for `exp(r)`, and scaling by `2^n`, which is
+/// constructed from its bit pattern. For `-708.0 <= x <= 709.0` the relative
+/// error compared to `std::exp` is less than 1e-15. Values of `x` less than
+/// -708.0 give 0.0, and values greater than 709.0 give infinity.
+inline double vectorizable_exp(double x) {
+  double const log2e = 1.4426950408889634;
+  double const ln2_hi = 6.93147180369123816490e-01;
+  double const ln2_lo = 1.90821492927058770002e-10;
+  // adding 1.5 * 2^52 rounds to an integer, which is stored in the low bits
+  double const round_shift = 6755399441055744.0;
+
+  double y = x < -708.0 ? -708.0 : x;
+  y = y > 709.0 ? 709.0 : y;
+
+  double t = y * log2e + round_shift;
+  double n = t - round_shift;
+  double r = y - n * ln2_hi;
+  r = r - n * ln2_lo;
+
+  double p = 1.0 / 6227020800.0;
+  p = p * r + 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // 2^n, from the exponent bits
+  std::int64_t t_bits;
+  std::int64_t shift_bits;
+  std::memcpy(&t_bits, &t, sizeof(double));
+  std::memcpy(&shift_bits, &round_shift, sizeof(double));
+  std::int64_t scale_bits = (t_bits - shift_bits + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &scale_bits, sizeof(double));
+
+  double result = p * scale;
+  result = x < -708.0 ? 0.0 : result;
+  return x > 709.0 ? std::numeric_limits<double>::infinity() : result;
+}
+
+/// \brief Activation energy by the KRA midpoint formula,
+///     `dE_activated = 0.5 * dE_final + Ekra`
+struct KRABarrierModel {
+  double activation_energy(double dE_final, double Ekra) const {
+    return dE_final * 0.5 + Ekra;
+  }
+};
+
+/// \brief Fixed activation energy, `dE_activated = barrier`
+struct FixedBarrierModel {
+  double barrier;
+
+  double activation_energy(double dE_final, double Ekra) const {
+    return barrier;
+  }
+};
+
+/// \brief Activation energy by Bronsted-Evans-Polanyi scaling,
+///     `dE_activated = intercept + slope * dE_final`
+struct BEPBarrierModel {
+  double intercept;
+  double slope;
+
+  double activation_energy(double dE_final, double Ekra) const {
+    return intercept + slope * dE_final;
+  }
+};
+
+/// \brief Barrier model types
+enum class BarrierModelType { kra, fixed, bep };
+
+/// \brief Specifies the barrier model used to calculate the activation
+///     energy of events of one type
+///
+/// The barrier model is chosen when an EventStateCalculator is constructed.
+/// Calculations call `visit`, once per batch of events, so that the
+/// activation energy calculation of the concrete barrier model is inlined
+/// in the loop over events.
+struct BarrierModel {
+  /// \brief Barrier model type
+  BarrierModelType type = BarrierModelType::kra;
+
+  /// \brief For `BarrierModelType::fixed`, the activation energy
+  double barrier = 0.0;
+
+  /// \brief For `BarrierModelType::bep`, the activation energy if
+  ///     `dE_final` is 0.0
+  double intercept = 0.0;
+
+  /// \brief For `BarrierModelType::bep`, the change in activation energy
+  ///     per change in `dE_final`
+  double slope = 0.5;
+
+  /// \brief True if the KRA local cluster expansion is used
+  bool uses_kra() const { return type == BarrierModelType::kra; }
+
+  /// \brief Call `f(model)`, with `model` the concrete barrier model
+  template <typename F>
+  void visit(F f) const {
+    if (type == BarrierModelType::fixed) {
+      f(FixedBarrierModel{barrier});
+    } else if (type == BarrierModelType::bep) {
+      f(BEPBarrierModel{intercept, slope});
+    } else {
+      f(KRABarrierModel{});
+    }
+  }
+};
+
+/// \brief Return true if an event is "normal", `dE_activated > 0.0` and
+///     `dE_activated > dE_final`, where `dE_activated` is given by the
+///     barrier model
+template <typename ModelType>
+bool is_normal_event(ModelType const &model, double dE_final, double Ekra) {
+  double dE_activated = model.activation_energy(dE_final, Ekra);
+  return (dE_activated > 0.0) & (dE_activated > dE_final);
+}
+
+/// \brief Return the activation energy given by the barrier model, clamped
+///     to be no less than `dE_final` or 0.0
+template <typename ModelType>
+double clamped_activation_energy(ModelType const &model, double dE_final,
+                                 double Ekra) {
+  double dE_activated = model.activation_energy(dE_final, Ekra);
+  dE_activated = dE_activated < dE_final ? dE_final : dE_activated;
+  return dE_activated < 0.0 ? 0.0 : dE_activated;
+}
+
+/// \brief Calculate the activation energy, "normal" flag, and rate,
+///     `freq * exp(-beta * dE_activated)`, of one event
+///
+/// Uses `std::exp`. The activation energy and "normal" flag are identical to
+/// those given by `calculate_arrhenius_rates`, and the rate agrees with it
+/// to within a relative error of 1e-15 (see `vectorizable_exp`).
+template <typename ModelType>
+void calculate_arrhenius_rate(ModelType const &model, double dE_final,
+                              double Ekra, double freq, double beta,
+                              double &dE_activated, bool &is_normal,
+                              double &rate) {
+  is_normal = is_normal_event(model, dE_final, Ekra);
+  dE_activated = clamped_activation_energy(model, dE_final, Ekra);
+  rate = freq * std::exp(-beta * dE_activated);
+}
+
+/// \brief Calculate the activation energy, "normal" flag, and rate of one
+///     event, using the KRA midpoint formula
+inline void calculate_arrhenius_rate(double dE_final, double Ekra,
+                                     double freq, double beta,
+                                     double &dE_activated, bool &is_normal,
+                                     double &rate) {
+  calculate_arrhenius_rate(KRABarrierModel{}, dE_final, Ekra, freq, beta,
+                           dE_activated, is_normal, rate);
+}
+
+/// \brief Calculate activation energies, "normal" flags, and rates of a
+///     batch of events, using the KRA midpoint formula
+void calculate_arrhenius_rates(Index n, double beta, double const *dE_final,
+                               double const *Ekra, double const *freq,
+                               double *dE_activated, unsigned char *is_normal,
+                               double *rate);
+
+/// \brief Calculate activation energies, "normal" flags, and rates of a
+///     batch of events, using the given barrier model
+void calculate_arrhenius_rates(BarrierModel const &model, Index n,
+                               double beta, double const *dE_final,
+                               double const *Ekra, double const *freq,
+                               double *dE_activated, unsigned char *is_normal,
+                               double *rate);
+
+/// \brief Inputs and results of `calculate_arrhenius_rates`, in
+///     structure-of-arrays layout
+struct ArrheniusRateBatch {
+  /// \brief Change in energy to the final state
+  std::vector<double> dE_final;
+
+  /// \brief KRA energy
+  std::vector<double> Ekra;
+
+  /// \brief Attempt frequency
+  std::vector<double> freq;
+
+  /// \brief Clamped activation energy, set by `calculate`
+  std::vector<double> dE_activated;
+
+  /// \brief 1 if an event is "normal", else 0, set by `calculate`
+  std::vector<unsigned char> is_normal;
+
+  /// \brief Event rate, set by `calculate`
+  std::vector<double> rate;
+
+  /// \brief Number of events
+  Index size() const { return dE_final.size(); }
+
+  /// \brief Remove all events, keeping allocated memory
+  void clear() {
+    dE_final.clear();
+    Ekra.clear();
+    freq.clear();
+  }
+
+  /// \brief Add an event
+  void push_back(double _dE_final, double _Ekra, double _freq) {
+    dE_final.push_back(_dE_final);
+    Ekra.push_back(_Ekra);
+    freq.push_back(_freq);
+  }
+
+  /// \brief Calculate activation energies, "normal" flags, and rates of all
+  ///     events
+  void calculate(BarrierModel const &model, double beta) {
+    Index n = size();
+    dE_activated.resize(n);
+    is_normal.resize(n);
+    rate.resize(n);
+    calculate_arrhenius_rates(model, n, beta, dE_final.data(), Ekra.data(),
+                              freq.data(), dE_activated.data(),
+                              is_normal.data(), rate.data());
+  }
+
+  /// \brief Calculate activation energies, "normal" flags, and rates of all
+  ///     events, using the KRA midpoint formula
+  void calculate(double beta) { calculate(BarrierModel(), beta); }
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,385 @@
+/// A domain-decomposed ("checkerboard") occupation Metropolis Monte Carlo
+/// main loop, in which events in non-interacting unit cells are proposed and
+/// accepted or rejected concurrently by a pool of threads.
+
+#ifndef CASM_clexmonte_methods_checkerboard_metropolis
+#define CASM_clexmonte_methods_checkerboard_metropolis
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return the maximum distance, in unit cells along any lattice
+///     vector, of a neighborhood from the origin unit cell
+Index unitcell_reach(std::set<xtal::UnitCellCoord> const &neighborhood);
+
+/// \brief Partition of the unit cells of a supercell into colors, such that
+///     unit cells of the same color are at least `spacing` unit cells apart
+///     along some lattice vector, including periodic images
+///
+/// Unit cell `(i, j, k)` has color `(i % s) + s * ((j % s) + s * (k % s))`,
+/// with `s = spacing`. This requires a diagonal transformation matrix, with
+/// each diagonal element either 1 or a multiple of `spacing`.
+///
+/// The unit cells of each color are in Morton (Z-order) of their unit cell
+/// coordinates, so that the contiguous chunk of a color handled by one
+/// thread is a compact region of the supercell rather than a slab.
+class CheckerboardColoring {
+ public:
+  CheckerboardColoring(Eigen::Matrix3l const &transformation_matrix_to_super,
+                       Index spacing);
+
+  /// \brief Minimum distance between unit cells of the same color
+  Index spacing() const { return m_spacing; }
+
+  /// \brief Number of colors
+  Index n_colors() const { return m_colors.size(); }
+
+  /// \brief Unit cell indices of one color, in Morton order
+  std::vector<Index> const &color(Index color_index) const {
+    return m_colors[color_index];
+  }
+
+ private:
+  Index m_spacing;
+  std::vector<std::vector<Index>> m_colors;
+};
+
+/// \brief Proposes occupation events local to one unit cell, for
+///     checkerboard Metropolis
+///
+/// For canonical calculations, an event swaps the occupants of a random site
+/// in the unit cell and a random site in the same unit cell or one of its 6
+/// neighbors along the lattice vectors. For semi-grand canonical
+/// calculations, an event changes the occupant of a random site in the unit
+/// cell to a random allowed species.
+///
+/// Allowed events are determined from the system's canonical or semi-grand
+/// canonical swaps. Proposals are symmetric for canonical events; for
+/// semi-grand canonical events `propose` returns the log of the proposal
+/// ratio, which accounts for species with different numbers of allowed
+/// changes, so that detailed balance is satisfied.
+class CheckerboardEventProposer {
+ public:
+  CheckerboardEventProposer(
+      Eigen::Matrix3l const &transformation_matrix_to_super,
+      monte::Conversions const &convert,
+      std::vector<monte::OccSwap> const &swaps, bool is_canonical);
+
+  /// \brief True if events are canonical swaps
+  bool is_canonical() const { return m_is_canonical; }
+
+  /// \brief Minimum color spacing so that events in unit cells of the same
+  ///     color do not interact, given the cluster expansion `unitcell_reach`
+  ///
+  /// A semi-grand canonical event only changes its own unit cell, so events
+  /// must be more than `reach` apart. A canonical event may also change a
+  /// neighboring unit cell, and its energy depends on sites within
+  /// `reach + 1`, so events must be more than `reach + 2` apart.
+  Index required_spacing(Index reach) const {
+    return m_is_canonical ? reach + 3 : reach + 1;
+  }
+
+  /// \brief Propose an event in one unit cell
+  ///
+  /// \param event Set to the proposed event, if one is proposed
+  /// \param log_proposal_ratio Set to
+  ///     `log(P(propose reverse event) / P(propose event))`
+  /// \param unitcell_index The unit cell
+  /// \param occupation The current occupation, which is only read
+  /// \param occ_location Occupant location tracker, which is only read
+  /// \param random_number_generator Random number generator
+  ///
+  /// \returns False, if the proposal does not change the occupation (i.e.
+  ///     a swap of identical species), which counts as a rejected event.
+  template <typename RandomNumberGeneratorType>
+  bool propose(monte::OccEvent &event, double &log_proposal_ratio,
+               Index unitcell_index, Eigen::VectorXi const &occupation,
+               monte::OccLocation const &occ_location,
+               RandomNumberGeneratorType &random_number_generator) const;
+
+ private:
+  template <typename RandomNumberGeneratorType>
+  Index _random_index(
+      Index n, RandomNumberGeneratorType &random_number_generator) const {
+    Index i = random_number_generator.random_real(n);
+    return i < n ? i : n - 1;
+  }
+
+  void _set_transform(monte::OccTransform &transform, Index l, Index asym,
+                      Index from_species, Index to_species,
+                      monte::OccLocation const &occ_location) const {
+    transform.l = l;
+    transform.mol_id = occ_location.l_to_mol_id(l);
+    transform.asym = asym;
+    transform.from_species = from_species;
+    transform.to_species = to_species;
+  }
+
+  monte::Conversions const &m_convert;
+  bool m_is_canonical;
+  Index m_n_sublat;
+  Index m_n_species;
+  Index m_n_asym;
+
+  /// Linear site index, `m_site_l[unitcell_index * m_n_sublat + b]`
+  std::vector<Index> m_site_l;
+
+  /// Canonical: the unit cell and its 6 neighbors,
+  /// `m_neighbor_unitcell[unitcell_index * 7 + d]`
+  std::vector<Index> m_neighbor_unitcell;
+
+  /// Canonical: 1 if the swap of (asym_a, species_a) and (asym_b, species_b)
+  /// is allowed, else 0
+  std::vector<unsigned char> m_swap_allowed;
+
+  /// Semi-grand canonical: species a site may change to, by
+  /// `asym * m_n_species + species_index`
+  std::vector<std::vector<Index>> m_flip_options;
+};
+
+template <typename PotentialOccDeltaPerSupercellF, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void checkerboard_occupation_metropolis(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature,
+    std::vector<PotentialOccDeltaPerSupercellF> const
+        &potential_occ_delta_per_supercell_f,
+    CheckerboardEventProposer const &proposer,
+    CheckerboardColoring const &coloring,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager);
+
+// --- Implementation ---
+
+template <typename RandomNumberGeneratorType>
+bool CheckerboardEventProposer::propose(
+    monte::OccEvent &event, double &log_proposal_ratio, Index unitcell_index,
+    Eigen::VectorXi const &occupation, monte::OccLocation const &occ_location,
+    RandomNumberGeneratorType &random_number_generator) const {
+  log_proposal_ratio = 0.0;
+  Index b_a = _random_index(m_n_sublat, random_number_generator);
+  Index l_a = m_site_l[unitcell_index * m_n_sublat + b_a];
+  Index asym_a = m_convert.l_to_asym(l_a);
+  Index species_a = m_convert.species_index(asym_a, occupation(l_a));
+
+  if (!m_is_canonical) {
+    auto const &options = m_flip_options[asym_a * m_n_species + species_a];
+    if (options.empty()) {
+      return false;
+    }
+    Index new_species =
+        options[_random_index(options.size(), random_number_generator)];
+    auto const &reverse_options =
+        m_flip_options[asym_a * m_n_species + new_species];
+    log_proposal_ratio = std::log(double(options.size()) /
+                                  double(reverse_options.size()));
+
+    event.linear_site_index.resize(1);
+    event.new_occ.resize(1);
+    event.occ_transform.resize(1);
+    event.atom_traj.clear();
+    event.linear_site_index[0] = l_a;
+    event.new_occ[0] = m_convert.occ_index(asym_a, new_species);
+    _set_transform(event.occ_transform[0], l_a, asym_a, species_a, new_species,
+                   occ_location);
+    return true;
+  }
+
+  Index d = _random_index(7, random_number_generator);
+  Index unitcell_index_b = m_neighbor_unitcell[unitcell_index * 7 + d];
+  Index b_b = _random_index(m_n_sublat, random_number_generator);
+  Index l_b = m_site_l[unitcell_index_b * m_n_sublat + b_b];
+  if (l_a == l_b) {
+    return false;
+  }
+  Index asym_b = m_convert.l_to_asym(l_b);
+  Index species_b = m_convert.species_index(asym_b, occupation(l_b));
+  if (species_a == species_b) {
+    return false;
+  }
+  Index n_cand = m_n_asym * m_n_species;
+  if (!m_swap_allowed[(asym_a * m_n_species + species_a) * n_cand +
+                      asym_b * m_n_species + species_b]) {
+    return false;
+  }
+
+  event.linear_site_index.resize(2);
+  event.new_occ.resize(2);
+  event.occ_transform.resize(2);
+  event.atom_traj.clear();
+  event.linear_site_index[0] = l_a;
+  event.linear_site_index[1] = l_b;
+  event.new_occ[0] = m_convert.occ_index(asym_a, species_b);
+  event.new_occ[1] = m_convert.occ_index(asym_b, species_a);
+  _set_transform(event.occ_transform[0], l_a, asym_a, species_a, species_b,
+                 occ_location);
+  _set_transform(event.occ_transform[1], l_b, asym_b, species_b, species_a,
+                 occ_location);
+  return true;
+}
+
+/// \brief Run a checkerboard occupation Metropolis Monte Carlo calculation
+///
+/// Each step chooses a color at random, then proposes one event in every
+/// unit cell of that color. The unit cells of a color are split into
+/// contiguous chunks, one per thread, and each thread proposes events and
+/// accepts or rejects them using its own potential calculator and random
+/// number generator. Unit cells of the same color do not interact, so the
+/// events are independent. Accepted events are then applied on the calling
+/// thread. Since each event satisfies detailed balance given the occupation
+/// of the other colors, and colors are chosen at random, the combined
+/// update satisfies detailed balance.
+///
+/// Notes:
+/// - Each proposal in a unit cell counts as one step for the run manager.
+///   Samples due during a color step are taken after all of its events are
+///   applied.
+/// - The random number generator of each thread is an independent stream
+///   (see `make_stream_engine`) of one seed drawn from `run_manager.engine`,
+///   so results are reproducible for a given seed and number of threads, but
+///   depend on the number of threads.
+/// - Events do not include atom trajectories, so `occ_location` must not
+///   track atom positions.
+///
+/// \param state The state. Consists of both the initial
+///     configuration and conditions.
+/// \param occ_location An occupant location tracker. It must already be
+///     initialized with the input state.
+/// \param temperature The temperature, in K.
+/// \param potential_occ_delta_per_supercell_f Functions, with signature
+///     `double potential_occ_delta_per_supercell_f(OccEvent const &)`, which
+///     calculate the change in potential energy due to a proposed event. One
+///     per thread, each of which must use its own cluster expansion
+///     calculator (see `make_independent_clex`).
+/// \param proposer Proposes events in a unit cell
+/// \param coloring Unit cell colors, which must have spacing of at least
+///     `proposer.required_spacing(reach)`
+/// \param run_manager Contains random number engine, sampling fixtures, and
+///     after completion holds final results
+template <typename PotentialOccDeltaPerSupercellF, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void checkerboard_occupation_metropolis(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature,
+    std::vector<PotentialOccDeltaPerSupercellF> const
+        &potential_occ_delta_per_supercell_f,
+    CheckerboardEventProposer const &proposer,
+    CheckerboardColoring const &coloring,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager) {
+  Index n_threads = potential_occ_delta_per_supercell_f.size();
+  if (n_threads < 1) {
+    throw std::runtime_error(
+        "Error in checkerboard_occupation_metropolis: no potential "
+        "calculators");
+  }
+  ThreadPool pool(n_threads);
+
+  // # construct RandomNumberGenerator
+  monte::RandomNumberGenerator<EngineType> random_number_generator(
+      run_manager.engine);
+
+  // Independent random number streams for each thread
+  std::uint64_t stream_seed = (*run_manager.engine)();
+  std::vector<monte::RandomNumberGenerator<EngineType>> thread_generators;
+  for (Index t = 0; t < n_threads; ++t) {
+    thread_generators.emplace_back(
+        make_stream_engine<EngineType>(stream_seed, t));
+  }
+
+  // Events proposed by each thread, the first `n_accept[t]` accepted
+  std::vector<std::vector<monte::OccEvent>> thread_events(n_threads);
+  std::vector<Index> n_accept(n_threads, 0);
+  std::vector<Index> n_reject(n_threads, 0);
+
+  Index steps_per_pass = occ_location.mol_size();
+  double beta = 1.0 / (CASM::KB * temperature);
+  Eigen::VectorXi &occupation = get_occupation(state);
+
+  // Main loop
+  run_manager.initialize(steps_per_pass);
+  run_manager.sample_data_by_count_if_due(state);
+  while (!run_manager.is_complete()) {
+    // Write run status, if due
+    run_manager.write_status_if_due();
+
+    // Choose a color
+    Index n_colors = coloring.n_colors();
+    Index color_index = random_number_generator.random_real(n_colors);
+    std::vector<Index> const &unitcells =
+        coloring.color(color_index < n_colors ? color_index : n_colors - 1);
+
+    // Propose and accept or reject events concurrently
+    pool.run([&](Index t) {
+      n_accept[t] = 0;
+      n_reject[t] = 0;
+      auto &events = thread_events[t];
+      auto &generator = thread_generators[t];
+      auto const &delta_f = potential_occ_delta_per_supercell_f[t];
+      Index n = unitcells.size();
+      Index begin = (n * t) / n_threads;
+      Index end = (n * (t + 1)) / n_threads;
+      double log_proposal_ratio;
+      for (Index i = begin; i < end; ++i) {
+        if (events.size() == n_accept[t]) {
+          events.emplace_back();
+        }
+        monte::OccEvent &event = events[n_accept[t]];
+        if (!proposer.propose(event, log_proposal_ratio, unitcells[i],
+                              occupation, occ_location, generator)) {
+          ++n_reject[t];
+          continue;
+        }
+        double delta_potential_energy =
+            delta_f(event) - log_proposal_ratio / beta;
+        if (metropolis_acceptance(delta_potential_energy, beta, generator)) {
+          ++n_accept[t];
+        } else {
+          ++n_reject[t];
+        }
+      }
+    });
+
+    // Apply accepted events
+    for (Index t = 0; t < n_threads; ++t) {
+      for (Index i = 0; i < n_accept[t]; ++i) {
+        occ_location.apply(thread_events[t][i], occupation);
+      }
+    }
+
+    // Increment count, and sample data if a sample is due by count
+    for (Index t = 0; t < n_threads; ++t) {
+      for (Index i = 0; i < n_accept[t] + n_reject[t]; ++i) {
+        if (i < n_accept[t]) {
+          run_manager.increment_n_accept();
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(state);
+      }
+    }
+  }
+
+  run_manager.finalize(state);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,209 @@
+/// Collective ("cluster flip") semi-grand canonical Metropolis events, in
+/// which a connected domain of sites with the same occupant is grown from a
+/// random seed site, Wolff-style, and changed to another species at once.
+
+#ifndef CASM_clexmonte_methods_cluster_flip
+#define CASM_clexmonte_methods_cluster_flip
+
+#include <cmath>
+#include <vector>
+
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace xtal {
+class BasicStructure;
+}
+
+namespace clexmonte {
+
+/// \brief Make nearest neighbor bonds between sites of the same asymmetric
+///     unit
+///
+/// \param prim The prim structure
+/// \param convert Index conversions, used for the asymmetric unit of each
+///     sublattice
+///
+/// \returns Bonds, where `bonds[b]` are the nearest neighbors of the site on
+///     sublattice `b` in the origin unit cell, among sites with the same
+///     asymmetric unit index. "Nearest" is by Cartesian distance, for each
+///     asymmetric unit separately.
+std::vector<std::vector<xtal::UnitCellCoord>> make_nearest_neighbor_bonds(
+    xtal::BasicStructure const &prim, monte::Conversions const &convert);
+
+/// \brief Proposes semi-grand canonical events that change the species of a
+///     connected domain of sites
+///
+/// A proposal chooses a random seed site and a random species it may change
+/// to, as allowed by the semi-grand canonical swaps. The domain is then grown
+/// from the seed as in the Wolff algorithm: each bond from a domain site to a
+/// site with the same asymmetric unit and species as the seed, not yet in the
+/// domain, is added with probability `bond_probability`. All domain sites
+/// are changed to the new species.
+///
+/// `propose` returns the log of the proposal ratio, which accounts for the
+/// unsatisfied bonds on the boundary of the domain before and after the
+/// change, so that detailed balance is satisfied for any Hamiltonian. For an
+/// Ising model with nearest neighbor pair interaction `J` (in the spin
+/// convention, so that a broken bond costs `2J`), choosing `bond_probability
+/// = 1 - exp(-2 * beta * J)` cancels the energy change and every proposal is
+/// accepted; for other Hamiltonians the acceptance rate is reduced by the
+/// remaining energy change.
+class ClusterFlipEventProposer {
+ public:
+  ClusterFlipEventProposer(
+      Eigen::Matrix3l const &transformation_matrix_to_super,
+      monte::Conversions const &convert,
+      std::vector<std::vector<xtal::UnitCellCoord>> const &bonds,
+      std::vector<monte::OccSwap> const &swaps, double bond_probability);
+
+  /// \brief Probability of adding a bond to the domain
+  double bond_probability() const { return m_bond_probability; }
+
+  /// \brief Nearest neighbors of a site
+  std::vector<Index> neighbors(Index l) const {
+    return std::vector<Index>(
+        m_neighbor_l.begin() + m_neighbor_begin[l],
+        m_neighbor_l.begin() + m_neighbor_begin[l + 1]);
+  }
+
+  /// \brief Propose an event
+  ///
+  /// \param event Set to the proposed event, if one is proposed
+  /// \param log_proposal_ratio Set to
+  ///     `log(P(propose reverse event) / P(propose event))`
+  /// \param occupation The current occupation, which is only read
+  /// \param occ_location Occupant location tracker, which is only read
+  /// \param random_number_generator Random number generator
+  ///
+  /// \returns False, if the seed site's species may not be changed, which
+  ///     counts as a rejected event.
+  template <typename RandomNumberGeneratorType>
+  bool propose(monte::OccEvent &event, double &log_proposal_ratio,
+               Eigen::VectorXi const &occupation,
+               monte::OccLocation const &occ_location,
+               RandomNumberGeneratorType &random_number_generator);
+
+ private:
+  template <typename RandomNumberGeneratorType>
+  Index _random_index(
+      Index n, RandomNumberGeneratorType &random_number_generator) const {
+    Index i = random_number_generator.random_real(n);
+    return i < n ? i : n - 1;
+  }
+
+  monte::Conversions const &m_convert;
+  double m_bond_probability;
+  double m_log_bond_rejection;
+  Index m_n_species;
+
+  /// Sites whose species may change
+  std::vector<Index> m_seed_l;
+
+  /// Neighbors of site `l` are
+  /// `m_neighbor_l[m_neighbor_begin[l]], ..., m_neighbor_l[m_neighbor_begin[l
+  /// + 1] - 1]`
+  std::vector<Index> m_neighbor_begin;
+  std::vector<Index> m_neighbor_l;
+
+  /// Species a site may change to, by `asym * m_n_species + species_index`
+  std::vector<std::vector<Index>> m_flip_options;
+
+  /// 1 if a site is in the current domain, else 0
+  std::vector<unsigned char> m_in_domain;
+
+  /// Sites in the domain whose neighbors have not been checked
+  std::vector<Index> m_stack;
+};
+
+// --- Implementation ---
+
+template <typename RandomNumberGeneratorType>
+bool ClusterFlipEventProposer::propose(
+    monte::OccEvent &event, double &log_proposal_ratio,
+    Eigen::VectorXi const &occupation, monte::OccLocation const &occ_location,
+    RandomNumberGeneratorType &random_number_generator) {
+  log_proposal_ratio = 0.0;
+  Index l_seed =
+      m_seed_l[_random_index(m_seed_l.size(), random_number_generator)];
+  Index asym = m_convert.l_to_asym(l_seed);
+  int occ = occupation(l_seed);
+  Index species = m_convert.species_index(asym, occ);
+  auto const &options = m_flip_options[asym * m_n_species + species];
+  if (options.empty()) {
+    return false;
+  }
+  Index new_species =
+      options[_random_index(options.size(), random_number_generator)];
+  int new_occ = m_convert.occ_index(asym, new_species);
+  auto const &reverse_options =
+      m_flip_options[asym * m_n_species + new_species];
+
+  // Grow the domain; neighbors always have the same asymmetric unit
+  event.linear_site_index.clear();
+  event.linear_site_index.push_back(l_seed);
+  m_in_domain[l_seed] = 1;
+  m_stack.clear();
+  m_stack.push_back(l_seed);
+  while (!m_stack.empty()) {
+    Index l = m_stack.back();
+    m_stack.pop_back();
+    for (Index i = m_neighbor_begin[l]; i < m_neighbor_begin[l + 1]; ++i) {
+      Index l_nbor = m_neighbor_l[i];
+      if (m_in_domain[l_nbor] || occupation(l_nbor) != occ) {
+        continue;
+      }
+      if (random_number_generator.random_real(1.0) < m_bond_probability) {
+        m_in_domain[l_nbor] = 1;
+        event.linear_site_index.push_back(l_nbor);
+        m_stack.push_back(l_nbor);
+      }
+    }
+  }
+
+  // Count boundary bonds to sites with the initial species (all rejected
+  // by this proposal) and with the new species (which the reverse proposal
+  // would have to reject)
+  Index n_boundary_forward = 0;
+  Index n_boundary_reverse = 0;
+  for (Index l : event.linear_site_index) {
+    for (Index i = m_neighbor_begin[l]; i < m_neighbor_begin[l + 1]; ++i) {
+      Index l_nbor = m_neighbor_l[i];
+      if (m_in_domain[l_nbor]) {
+        continue;
+      }
+      if (occupation(l_nbor) == occ) {
+        ++n_boundary_forward;
+      } else if (occupation(l_nbor) == new_occ) {
+        ++n_boundary_reverse;
+      }
+    }
+  }
+  log_proposal_ratio =
+      std::log(double(options.size()) / double(reverse_options.size())) +
+      (n_boundary_reverse - n_boundary_forward) * m_log_bond_rejection;
+
+  Index n = event.linear_site_index.size();
+  event.new_occ.assign(n, new_occ);
+  event.occ_transform.resize(n);
+  event.atom_traj.clear();
+  for (Index i = 0; i < n; ++i) {
+    Index l = event.linear_site_index[i];
+    m_in_domain[l] = 0;
+    monte::OccTransform &transform = event.occ_transform[i];
+    transform.l = l;
+    transform.mol_id = occ_location.l_to_mol_id(l);
+    transform.asym = asym;
+    transform.from_species = species;
+    transform.to_species = new_species;
+  }
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef CASM_clexmonte_methods_local_swap_proposal
+#define CASM_clexmonte_methods_local_swap_proposal
+
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEvent.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace xtal {
+class BasicStructure;
+}
+
+namespace clexmonte {
+
+/// \brief Return the neighbors of each sublattice of a prim within a
+///     distance shell
+std::vector<std::vector<xtal::UnitCellCoord>> make_local_swap_neighbors(
+    xtal::BasicStructure const &prim, std::vector<bool> const &is_included,
+    double max_distance = 0.0);
+
+/// \brief Proposes canonical swaps between a site and one of its neighbors
+///
+/// Global canonical swaps, between two random sites anywhere in the
+/// supercell, are mostly rejected at low temperature or near ordered
+/// states, because the two sites rarely have compatible environments.
+/// Local ("Kawasaki") exchange swaps a site with a nearby site instead,
+/// which is accepted more often and has a physical interpretation as
+/// diffusion-like dynamics.
+///
+/// A proposal chooses a site uniformly from the sites of sublattices that
+/// take part in canonical swaps, then chooses a neighbor uniformly from its
+/// neighbors (see `make_local_swap_neighbors`). Because the neighbor
+/// relation is symmetric, the probability of proposing the swap of a pair
+/// of sites is the same before and after the swap, so no proposal ratio is
+/// needed in the acceptance probability. A proposal of a swap of identical
+/// species, or of a pair of candidates which is not an allowed canonical
+/// swap, does not change the occupation; `propose` returns false, and it
+/// must count as a rejected event (not be redrawn) to preserve detailed
+/// balance.
+class LocalSwapProposer {
+ public:
+  LocalSwapProposer(Eigen::Matrix3l const &transformation_matrix_to_super,
+                    monte::Conversions const &convert,
+                    std::vector<monte::OccSwap> const &swaps,
+                    xtal::BasicStructure const &prim,
+                    double max_distance = 0.0);
+
+  /// \brief Number of sites which may be chosen first
+  Index n_sites() const { return m_site_l.size(); }
+
+  /// \brief Linear site index of site `k`
+  Index site(Index k) const { return m_site_l[k]; }
+
+  /// \brief Number of neighbors of site `k`
+  Index n_neighbors(Index k) const {
+    return m_neighbor_begin[k + 1] - m_neighbor_begin[k];
+  }
+
+  /// \brief Linear site index of neighbor `n` of site `k`
+  Index neighbor(Index k, Index n) const {
+    return m_neighbor_l[m_neighbor_begin[k] + n];
+  }
+
+  /// \brief Propose a local swap
+  ///
+  /// \param event Set to the proposed event, if one is proposed
+  /// \param occupation The current occupation, which is only read
+  /// \param occ_location Occupant location tracker, which is only read
+  /// \param random_number_generator Random number generator
+  ///
+  /// \returns False, if the proposal does not change the occupation, which
+  ///     counts as a rejected event.
+  template <typename RandomNumberGeneratorType>
+  bool propose(monte::OccEvent &event, Eigen::VectorXi const &occupation,
+               monte::OccLocation const &occ_location,
+               RandomNumberGeneratorType &random_number_generator) const;
+
+ private:
+  template <typename RandomNumberGeneratorType>
+  Index _random_index(
+      Index n, RandomNumberGeneratorType &random_number_generator) const {
+    Index i = random_number_generator.random_real(n);
+    return i < n ? i : n - 1;
+  }
+
+  void _set_transform(monte::OccTransform &transform, Index l, Index asym,
+                      Index from_species, Index to_species,
+                      monte::OccLocation const &occ_location) const {
+    transform.l = l;
+    transform.mol_id = occ_location.l_to_mol_id(l);
+    transform.asym = asym;
+    transform.from_species = from_species;
+    transform.to_species = to_species;
+  }
+
+  monte::Conversions const &m_convert;
+  Index m_n_species;
+  Index m_n_asym;
+
+  /// Linear site index of the sites which may be chosen first
+  std::vector<Index> m_site_l;
+
+  /// Neighbors of `m_site_l[k]` are
+  /// `m_neighbor_l[m_neighbor_begin[k]:m_neighbor_begin[k+1]]`
+  std::vector<Index> m_neighbor_begin;
+  std::vector<Index> m_neighbor_l;
+
+  /// 1 if the swap of (asym_a, species_a) and (asym_b, species_b) is
+  /// allowed, else 0
+  std::vector<unsigned char> m_swap_allowed;
+};
+
+// --- Implementation ---
+
+template <typename RandomNumberGeneratorType>
+bool LocalSwapProposer::propose(
+    monte::OccEvent &event, Eigen::VectorXi const &occupation,
+    monte::OccLocation const &occ_location,
+    RandomNumberGeneratorType &random_number_generator) const {
+  Index k = _random_index(m_site_l.size(), random_number_generator);
+  Index l_a = m_site_l[k];
+  Index l_b = neighbor(
+      k, _random_index(n_neighbors(k), random_number_generator));
+  if (l_a == l_b) {
+    return false;
+  }
+  Index asym_a = m_convert.l_to_asym(l_a);
+  Index species_a = m_convert.species_index(asym_a, occupation(l_a));
+  Index asym_b = m_convert.l_to_asym(l_b);
+  Index species_b = m_convert.species_index(asym_b, occupation(l_b));
+  if (species_a == species_b) {
+    return false;
+  }
+  Index n_cand = m_n_asym * m_n_species;
+  if (!m_swap_allowed[(asym_a * m_n_species + species_a) * n_cand +
+                      asym_b * m_n_species + species_b]) {
+    return false;
+  }
+
+  event.linear_site_index.resize(2);
+  event.new_occ.resize(2);
+  event.occ_transform.resize(2);
+  event.atom_traj.clear();
+  event.linear_site_index[0] = l_a;
+  event.linear_site_index[1] = l_b;
+  event.new_occ[0] = m_convert.occ_index(asym_a, species_b);
+  event.new_occ[1] = m_convert.occ_index(asym_b, species_a);
+  _set_transform(event.occ_transform[0], l_a, asym_a, species_a, species_b,
+                 occ_location);
+  _set_transform(event.occ_transform[1], l_b, asym_b, species_b, species_a,
+                 occ_location);
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef CASM_clexmonte_methods_loop_profile
+#define CASM_clexmonte_methods_loop_profile
+
+#include <array>
+#include <chrono>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Phases of a Monte Carlo main loop, timed by LoopProfile
+enum class LoopPhase {
+  propose,
+  delta_potential,
+  accept,
+  apply,
+  sample,
+  status
+};
+
+/// \brief Number of LoopPhase values
+constexpr int n_loop_phases = 6;
+
+/// \brief Name of a LoopPhase
+inline char const *loop_phase_name(LoopPhase phase) {
+  static char const *names[n_loop_phases] = {
+      "propose", "delta_potential", "accept", "apply", "sample", "status"};
+  return names[static_cast<int>(phase)];
+}
+
+/// \brief Call counts and total times of the phases of a Monte Carlo main
+///     loop
+///
+/// Timing is only compiled in if `CASM_CLEXMONTE_LOOP_PROFILE` is defined,
+/// which is set by the CMake option of the same name. Otherwise, `LoopTimer`
+/// does nothing and all counts and times stay zero, so main loops have no
+/// timing overhead.
+struct LoopProfile {
+#ifdef CASM_CLEXMONTE_LOOP_PROFILE
+  static constexpr bool is_enabled = true;
+#else
+  static constexpr bool is_enabled = false;
+#endif
+
+  LoopProfile() { reset(); }
+
+  /// \brief Number of times each phase was timed, indexed by LoopPhase
+  std::array<Index, n_loop_phases> n_calls;
+
+  /// \brief Total time spent in each phase, in seconds, indexed by LoopPhase
+  std::array<double, n_loop_phases> total_time_s;
+
+  /// \brief Reset counts and times to zero
+  void reset() {
+    n_calls.fill(0);
+    total_time_s.fill(0.0);
+  }
+
+  /// \brief Add one timed call of a phase
+  void add(LoopPhase phase, double time_s) {
+    int i = static_cast<int>(phase);
+    ++n_calls[i];
+    total_time_s[i] += time_s;
+  }
+
+  /// \brief Total time spent in all phases, in seconds
+  double total() const {
+    double sum = 0.0;
+    for (double t : total_time_s) {
+      sum += t;
+    }
+    return sum;
+  }
+};
+
+/// \brief Times consecutive phases of a main loop
+///
+/// Each call to `lap(phase)` adds the time since the previous call, or since
+/// construction, to `phase`, so the phases of a loop can be timed with one
+/// clock read per phase. If `profile` is null, or if
+/// `CASM_CLEXMONTE_LOOP_PROFILE` is not defined, nothing is timed.
+class LoopTimer {
+ public:
+#ifdef CASM_CLEXMONTE_LOOP_PROFILE
+  typedef std::chrono::steady_clock clock_type;
+
+  explicit LoopTimer(LoopProfile *profile)
+      : m_profile(profile), m_last(clock_type::now()) {}
+
+  /// \brief Add the time since the previous lap to `phase`
+  void lap(LoopPhase phase) {
+    if (m_profile) {
+      clock_type::time_point now = clock_type::now();
+      std::chrono::duration<double> elapsed = now - m_last;
+      m_profile->add(phase, elapsed.count());
+      m_last = now;
+    }
+  }
+
+ private:
+  LoopProfile *m_profile;
+  clock_type::time_point m_last;
+#else
+  explicit LoopTimer(LoopProfile *profile) {}
+
+  /// \brief Add the time since the previous lap to `phase` (disabled)
+  void lap(LoopPhase phase) {}
+#endif
+};
+
+/// \brief Print the time spent in each phase of a main loop, if
+///     `CASM_CLEXMONTE_LOOP_PROFILE` is defined
+inline void print_loop_profile(Log &log, LoopProfile const &profile) {
+  if (!LoopProfile::is_enabled) {
+    return;
+  }
+  double total = profile.total();
+  log.indent() << "Main loop profile:" << std::endl;
+  for (int i = 0; i < n_loop_phases; ++i) {
+    LoopPhase phase = static_cast<LoopPhase>(i);
+    double t = profile.total_time_s[i];
+    log.indent() << "- " << loop_phase_name(phase) << ": " << t << " s ("
+                 << (total > 0.0 ? 100.0 * t / total : 0.0) << "%, "
+                 << profile.n_calls[i] << " calls)" << std::endl;
+  }
+  log << std::endl;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
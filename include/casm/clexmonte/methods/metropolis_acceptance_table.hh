@@ -0,0 +1,176 @@
+/// A table of Metropolis acceptance probabilities for quantized changes in
+/// potential energy, which avoids evaluating `exp` for each proposed event
+/// when the set of possible energy changes is small.
+
+#ifndef CASM_clexmonte_methods_metropolis_acceptance_table
+#define CASM_clexmonte_methods_metropolis_acceptance_table
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/monte/methods/metropolis.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Parameters of a MetropolisAcceptanceTable
+struct MetropolisAcceptanceTableParams {
+  /// \brief Changes in potential energy (per_supercell) are rounded to the
+  ///     nearest multiple of `tolerance`. If `tolerance <= 0.0`, no table is
+  ///     used.
+  double tolerance = 0.0;
+
+  /// \brief Maximum number of table entries
+  Index max_size = 4096;
+};
+
+/// \brief Metropolis acceptance with tabulated acceptance probabilities
+///
+/// For `delta_potential_energy >= 0.0`, the acceptance probability
+/// `exp(-beta * k * tolerance)` is read from a table, where `k` is
+/// `delta_potential_energy / tolerance` rounded to the nearest integer.
+/// The error in each energy change is at most `tolerance / 2`, so for
+/// energy changes that are multiples of `tolerance`, as for cluster
+/// expansions with integer-like ECI, acceptance is exact up to round-off.
+///
+/// Notes:
+/// - Events with `delta_potential_energy < 0.0`, or that round to `k == 0`,
+///   are accepted without drawing a random number.
+/// - The table covers energy changes up to `max_size * tolerance`, or up to
+///   where `beta * delta_potential_energy` reaches `cutoff`, whichever is
+///   smaller. Larger energy changes use `exp`. If the energy change of more
+///   than `max_miss_fraction` of uphill events in `check_interval`
+///   consecutive uphill events is beyond the table but below `cutoff`, the
+///   distribution of energy changes is too wide for the table, and it is
+///   disabled for the rest of the run.
+/// - When disabled, `accept` is equivalent to `monte::metropolis_acceptance`.
+class MetropolisAcceptanceTable {
+ public:
+  /// \brief Acceptance probabilities less than `exp(-cutoff)` are not
+  ///     tabulated
+  static constexpr double cutoff = 40.0;
+
+  /// \brief Number of consecutive uphill events between checks of the
+  ///     fraction of energy changes beyond the table
+  static constexpr Index check_interval = 1024;
+
+  /// \brief Maximum fraction of uphill events with energy changes beyond
+  ///     the table before the table is disabled
+  static constexpr double max_miss_fraction = 0.1;
+
+  /// \brief Constructor
+  ///
+  /// \param _beta The inverse temperature, `1 / (KB * T)`
+  /// \param params Table parameters. If `params.tolerance <= 0.0` or
+  ///     `params.max_size < 1`, the table is constructed disabled.
+  MetropolisAcceptanceTable(double _beta,
+                            MetropolisAcceptanceTableParams const &params)
+      : m_beta(_beta),
+        m_enabled(false),
+        m_inv_tolerance(0.0),
+        m_max_x(0.0),
+        m_n_uphill(0),
+        m_n_miss(0) {
+    if (params.tolerance <= 0.0 || params.max_size < 1) {
+      return;
+    }
+    Index size = params.max_size;
+    double x_cutoff = cutoff / (m_beta * params.tolerance);
+    if (x_cutoff < size) {
+      size = std::max(Index(1), Index(std::ceil(x_cutoff)));
+    }
+    m_probability.resize(size);
+    for (Index k = 0; k < size; ++k) {
+      m_probability[k] = std::exp(-m_beta * k * params.tolerance);
+    }
+    m_enabled = true;
+    m_inv_tolerance = 1.0 / params.tolerance;
+    m_max_x = size - 0.5;
+  }
+
+  /// \brief True if the table is used, false if `exp` is used
+  bool enabled() const { return m_enabled; }
+
+  /// \brief Number of table entries
+  Index size() const { return m_probability.size(); }
+
+  /// \brief Probability of accepting an event, using the table if enabled
+  ///     and `delta_potential_energy` is in its range
+  double probability(double delta_potential_energy) const {
+    if (delta_potential_energy <= 0.0) {
+      return 1.0;
+    }
+    double x = delta_potential_energy * m_inv_tolerance;
+    if (m_enabled && x < m_max_x) {
+      return m_probability[Index(x + 0.5)];
+    }
+    return std::exp(-m_beta * delta_potential_energy);
+  }
+
+  /// \brief Accept or reject an event with change in potential energy
+  ///     (per_supercell) `delta_potential_energy`
+  template <typename GeneratorType>
+  bool accept(double delta_potential_energy,
+              GeneratorType &random_number_generator) {
+    if (!m_enabled) {
+      return monte::metropolis_acceptance(delta_potential_energy, m_beta,
+                                          random_number_generator);
+    }
+    if (delta_potential_energy < 0.0) {
+      return true;
+    }
+    double x = delta_potential_energy * m_inv_tolerance;
+    double p;
+    if (x < m_max_x) {
+      Index k = Index(x + 0.5);
+      if (k == 0) {
+        _count_uphill();
+        return true;
+      }
+      p = m_probability[k];
+    } else {
+      double beta_delta = m_beta * delta_potential_energy;
+      if (beta_delta < cutoff) {
+        ++m_n_miss;
+      }
+      p = std::exp(-beta_delta);
+    }
+    _count_uphill();
+    return random_number_generator.random_real(1.0) < p;
+  }
+
+ private:
+  /// \brief Count an uphill event and disable the table if too many energy
+  ///     changes were beyond it
+  void _count_uphill() {
+    if (++m_n_uphill < check_interval) {
+      return;
+    }
+    if (m_n_miss > max_miss_fraction * check_interval) {
+      m_enabled = false;
+    }
+    m_n_uphill = 0;
+    m_n_miss = 0;
+  }
+
+  double m_beta;
+  bool m_enabled;
+  double m_inv_tolerance;
+
+  /// Energy changes with `delta_potential_energy / tolerance < m_max_x` are
+  /// in the table
+  double m_max_x;
+
+  /// Acceptance probabilities, `exp(-beta * k * tolerance)`
+  std::vector<double> m_probability;
+
+  Index m_n_uphill;
+  Index m_n_miss;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef CASM_clexmonte_methods_neighborhood_prefetch
+#define CASM_clexmonte_methods_neighborhood_prefetch
+
+#include "casm/clexulator/NeighborList.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+/// \brief Hint that the cache line holding `addr` will be read soon
+///
+/// Expands to `__builtin_prefetch` for GCC and Clang, and to nothing
+/// otherwise.
+#if defined(__GNUC__) || defined(__clang__)
+#define CASM_CLEXMONTE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CASM_CLEXMONTE_PREFETCH(addr) ((void)(addr))
+#endif
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Prefetches the memory read when evaluating a cluster expansion
+///     change at a site
+///
+/// In large supercells, evaluating the change in a cluster expansion for
+/// an event is latency-bound: the neighbor list entry of the unit cell of
+/// each event site, and the occupation of the event sites, are random
+/// accesses that are usually not in cache. Calling a NeighborhoodPrefetcher
+/// with the sites of the next proposal (see
+/// `SwapProposalStream::prefetch_next`) while the current proposal is being
+/// evaluated overlaps those accesses with useful work.
+///
+/// Only the neighbor list entry and the occupation of the site itself are
+/// prefetched; the occupation of the neighbors is not, since their indices
+/// are in the neighbor list entry being prefetched.
+class NeighborhoodPrefetcher {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _neighbor_list The supercell neighbor list, which must outlive
+  ///     the prefetcher
+  /// \param _occupation The occupation, which must outlive the prefetcher
+  NeighborhoodPrefetcher(clexulator::SuperNeighborList const &_neighbor_list,
+                         Eigen::VectorXi const &_occupation)
+      : m_neighbor_list(&_neighbor_list), m_occupation(&_occupation) {}
+
+  /// \brief Prefetch the neighbor list entry and occupation of site `l`
+  void operator()(Index l) const {
+    CASM_CLEXMONTE_PREFETCH(m_occupation->data() + l);
+    auto const &sites =
+        m_neighbor_list->sites(m_neighbor_list->unitcell_index(l));
+    Index const *begin = sites.data();
+    Index const *end = begin + sites.size();
+    // one prefetch per 64 byte cache line
+    for (Index const *ptr = begin; ptr < end; ptr += 64 / sizeof(Index)) {
+      CASM_CLEXMONTE_PREFETCH(ptr);
+    }
+  }
+
+ private:
+  clexulator::SuperNeighborList const *m_neighbor_list;
+  Eigen::VectorXi const *m_occupation;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
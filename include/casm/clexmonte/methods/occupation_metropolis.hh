@@ -7,10 +7,17 @@
 #ifndef CASM_clexmonte_methods_occupation_metropolis
 #define CASM_clexmonte_methods_occupation_metropolis
 
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "casm/clexmonte/methods/loop_profile.hh"
+#include "casm/clexmonte/methods/metropolis_acceptance_table.hh"
+#include "casm/clexmonte/misc/BufferedRandomNumberGenerator.hh"
+#include "casm/clexmonte/run/RunControl.hh"
+#include "casm/clexmonte/run/TelemetryChannel.hh"
 #include "casm/monte/Conversions.hh"
 #include "casm/monte/checks/CompletionCheck.hh"
 #include "casm/monte/events/OccCandidate.hh"
@@ -34,12 +41,276 @@ void occupation_metropolis_v2(
     PotentialOccDeltaPerSupercellF potential_occ_delta_per_supercell_f,
     ProposeOccEventFuntionType propose_event_f,
     ApplyOccEventFuntionType apply_event_f,
-    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager);
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params =
+        MetropolisAcceptanceTableParams(),
+    LoopProfile *loop_profile = nullptr, TelemetryChannel *telemetry = nullptr,
+    RunControl *run_control = nullptr, Index steps_per_check = 1,
+    bool buffered_random_numbers = false);
+
+template <typename PotentialOccDeltaBatchF,
+          typename ProposeOccEventFuntionType,
+          typename ApplyOccEventFuntionType, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void occupation_metropolis_batched(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature, PotentialOccDeltaBatchF potential_occ_delta_batch_f,
+    ProposeOccEventFuntionType propose_event_f,
+    ApplyOccEventFuntionType apply_event_f, Index batch_size,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params =
+        MetropolisAcceptanceTableParams(),
+    LoopProfile *loop_profile = nullptr, TelemetryChannel *telemetry = nullptr,
+    RunControl *run_control = nullptr, Index steps_per_check = 1,
+    bool buffered_random_numbers = false);
+
+/// \brief Throw if sampling and completion can not be checked every
+///     `steps_per_check` steps
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void validate_steps_per_check(
+    std::string const &method, Index steps_per_check, Index steps_per_pass,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager);
 
 // --- Implementation ---
 
+/// \brief Throw if sampling and completion can not be checked every
+///     `steps_per_check` steps
+///
+/// Samples due by pass are only taken on time if checks fall on every pass
+/// boundary, so `steps_per_check` must divide the pass length, and samples
+/// due by step may be due at any step, so if `steps_per_check > 1` no
+/// sampling fixture may sample by step.
+///
+/// \param method Name of the calling method, for error messages
+/// \param steps_per_check Number of steps between checks
+/// \param steps_per_pass Number of steps per pass
+/// \param run_manager The run manager, with the sampling fixtures
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void validate_steps_per_check(
+    std::string const &method, Index steps_per_check, Index steps_per_pass,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager) {
+  if (steps_per_check < 1) {
+    throw std::runtime_error("Error in " + method + ": steps_per_check < 1");
+  }
+  if (steps_per_check == 1) {
+    return;
+  }
+  if (steps_per_pass < 1 || steps_per_pass % steps_per_check != 0) {
+    throw std::runtime_error(
+        "Error in " + method +
+        ": steps_per_check must divide the number of steps per pass");
+  }
+  for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+    if (fixture_ptr->params().sampling_params.sample_mode ==
+        monte::SAMPLE_MODE::BY_STEP) {
+      throw std::runtime_error(
+          "Error in " + method + ": steps_per_check > 1 requires that no "
+          "sampling fixture samples by step (sampling fixture \"" +
+          fixture_ptr->label() + "\")");
+    }
+  }
+}
+
+namespace occupation_metropolis_impl {
+
+/// \brief Main loop of `occupation_metropolis_v2`, using the given random
+///     number generator for event proposal and acceptance
+template <typename PotentialOccDeltaPerSupercellF,
+          typename ProposeOccEventFuntionType,
+          typename ApplyOccEventFuntionType, typename ConfigType,
+          typename StatisticsType, typename EngineType, typename GeneratorType>
+void run_v2(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature,
+    PotentialOccDeltaPerSupercellF potential_occ_delta_per_supercell_f,
+    ProposeOccEventFuntionType propose_event_f,
+    ApplyOccEventFuntionType apply_event_f,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params,
+    LoopProfile *loop_profile, TelemetryChannel *telemetry,
+    RunControl *run_control, Index steps_per_check,
+    GeneratorType &random_number_generator) {
+  Index steps_per_pass = occ_location.mol_size();
+
+  // Used within the main loop:
+  double beta = 1.0 / (CASM::KB * temperature);
+  MetropolisAcceptanceTable acceptance_table(beta, acceptance_table_params);
+  double delta_potential_energy;
+  Index status_check_interval = std::max(steps_per_pass, Index(1));
+  validate_steps_per_check("occupation_metropolis_v2", steps_per_check,
+                           steps_per_pass, run_manager);
+  Index steps_until_check = steps_per_check;
+
+  // Main loop
+  run_manager.initialize(steps_per_pass);
+  begin_run_control(run_control);
+  run_manager.sample_data_by_count_if_due(state);
+  check_run_control(run_control, run_manager);
+  LoopTimer timer(loop_profile);
+  while (!is_run_complete(run_control, run_manager)) {
+    // Write run status, if due (check clocktime vs status log frequency, but
+    // only after #samples or #count changes). Status depends on clocktime,
+    // so it is only checked once per `status_check_interval` steps.
+    run_manager.write_status_if_due();
+    publish_telemetry(telemetry, run_manager);
+    timer.lap(LoopPhase::status);
+
+    for (Index i = 0; i < status_check_interval; ++i) {
+      // Propose an event
+      monte::OccEvent const &event = propose_event_f(random_number_generator);
+      timer.lap(LoopPhase::propose);
+
+      // Calculate change in potential energy (per_supercell) due to event
+      delta_potential_energy = potential_occ_delta_per_supercell_f(event);
+      timer.lap(LoopPhase::delta_potential);
+
+      // Accept or reject event
+      bool accept = acceptance_table.accept(delta_potential_energy,
+                                            random_number_generator);
+      timer.lap(LoopPhase::accept);
+
+      // Apply accepted event
+      if (accept) {
+        run_manager.increment_n_accept();
+        apply_event_f(event);
+        timer.lap(LoopPhase::apply);
+      } else {
+        run_manager.increment_n_reject();
+      }
+
+      // Increment count
+      run_manager.increment_step();
+
+      // Sample data, if a sample is due by count, and check completion,
+      // once per `steps_per_check` steps
+      if (--steps_until_check != 0) {
+        continue;
+      }
+      steps_until_check = steps_per_check;
+      run_manager.sample_data_by_count_if_due(state);
+      check_run_control(run_control, run_manager);
+      timer.lap(LoopPhase::sample);
+
+      if (is_run_complete(run_control, run_manager)) {
+        break;
+      }
+    }
+  }
+
+  run_manager.finalize(state);
+  publish_telemetry(telemetry, run_manager, true);
+}
+
+/// \brief Main loop of `occupation_metropolis_batched`, using the given
+///     random number generator for event proposal and acceptance
+template <typename PotentialOccDeltaBatchF,
+          typename ProposeOccEventFuntionType,
+          typename ApplyOccEventFuntionType, typename ConfigType,
+          typename StatisticsType, typename EngineType, typename GeneratorType>
+void run_batched(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature, PotentialOccDeltaBatchF potential_occ_delta_batch_f,
+    ProposeOccEventFuntionType propose_event_f,
+    ApplyOccEventFuntionType apply_event_f, Index batch_size,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params,
+    LoopProfile *loop_profile, TelemetryChannel *telemetry,
+    RunControl *run_control, Index steps_per_check,
+    GeneratorType &random_number_generator) {
+  Index steps_per_pass = occ_location.mol_size();
+
+  // Used within the main loop:
+  double beta = 1.0 / (CASM::KB * temperature);
+  MetropolisAcceptanceTable acceptance_table(beta, acceptance_table_params);
+  std::vector<monte::OccEvent> events(batch_size);
+  std::vector<double> delta_potential_energy(batch_size);
+  Index status_check_interval = std::max(steps_per_pass, Index(1));
+  Index steps_until_status_check = 0;
+  validate_steps_per_check("occupation_metropolis_batched", steps_per_check,
+                           steps_per_pass, run_manager);
+  Index steps_until_check = steps_per_check;
+
+  // Main loop
+  run_manager.initialize(steps_per_pass);
+  begin_run_control(run_control);
+  run_manager.sample_data_by_count_if_due(state);
+  check_run_control(run_control, run_manager);
+  LoopTimer timer(loop_profile);
+  while (!is_run_complete(run_control, run_manager)) {
+    // Propose a batch of events, all from the current state
+    for (Index i = 0; i < batch_size; ++i) {
+      events[i] = propose_event_f(random_number_generator);
+    }
+    timer.lap(LoopPhase::propose);
+
+    // Calculate change in potential energy (per_supercell) due to each event
+    potential_occ_delta_batch_f(events, batch_size,
+                                delta_potential_energy.data());
+    timer.lap(LoopPhase::delta_potential);
+
+    // Accept or reject events in order, until one is accepted
+    for (Index i = 0; i < batch_size; ++i) {
+      // Write run status, if due, checking once per `status_check_interval`
+      // steps
+      if (steps_until_status_check == 0) {
+        run_manager.write_status_if_due();
+        publish_telemetry(telemetry, run_manager);
+        steps_until_status_check = status_check_interval;
+        timer.lap(LoopPhase::status);
+      }
+      --steps_until_status_check;
+
+      // Accept or reject event
+      bool accept = acceptance_table.accept(delta_potential_energy[i],
+                                            random_number_generator);
+      timer.lap(LoopPhase::accept);
+
+      // Apply accepted event
+      if (accept) {
+        run_manager.increment_n_accept();
+        apply_event_f(events[i]);
+        timer.lap(LoopPhase::apply);
+      } else {
+        run_manager.increment_n_reject();
+      }
+
+      // Increment count
+      run_manager.increment_step();
+
+      // Sample data, if a sample is due by count, and check completion,
+      // once per `steps_per_check` steps
+      bool is_complete = false;
+      if (--steps_until_check == 0) {
+        steps_until_check = steps_per_check;
+        run_manager.sample_data_by_count_if_due(state);
+        check_run_control(run_control, run_manager);
+        timer.lap(LoopPhase::sample);
+        is_complete = is_run_complete(run_control, run_manager);
+      }
+
+      // Later events were proposed from the previous state
+      if (accept || is_complete) {
+        break;
+      }
+    }
+  }
+
+  run_manager.finalize(state);
+  publish_telemetry(telemetry, run_manager, true);
+}
+
+}  // namespace occupation_metropolis_impl
+
 /// \brief Run an occupation metropolis Monte Carlo calculation
 ///
+/// Notes:
+/// - Sampling and completion are checked every `steps_per_check` steps, by
+///   default after every step. The run status, which depends on the
+///   clocktime, is only checked once per pass (`occ_location.mol_size()`
+///   steps).
+///
 /// \param state The state. Consists of both the initial
 ///     configuration and conditions. Conditions must include `temperature`
 ///     and any others required by `potential`.
@@ -57,13 +328,40 @@ void occupation_metropolis_v2(
 ///      canonical swaps. It can also be a subset to restrict which swaps are
 ///     allowed.
 /// \param propose_event_f A function, with signature
-///     `OccEvent const & propose_event_f(RandomNumberGenerator<EngineType>
-///     &random_number_generator)`, which proposes an event.
+///     `OccEvent const & propose_event_f(GeneratorType
+///     &random_number_generator)`, which proposes an event. It must accept
+///     both `monte::RandomNumberGenerator<EngineType>` and
+///     `BufferedRandomNumberGenerator<EngineType>` (see
+///     `buffered_random_numbers`), for instance as a generic lambda.
 /// \param apply_event_f A function, with signature
 ///     `void apply_event_f(OccEvent const &)`, which updates the state and
 ///     occ_location after an event is accepted.
 /// \param run_manager Contains random number engine, sampling fixtures, and
 ///     after completion holds final results
+/// \param acceptance_table_params If `acceptance_table_params.tolerance >
+///     0.0`, acceptance probabilities are read from a
+///     `MetropolisAcceptanceTable` rather than calculated with `exp`. By
+///     default, `exp` is used.
+/// \param loop_profile If not null, the time spent in each phase of the
+///     main loop is added to `*loop_profile` (only if built with
+///     `CASM_CLEXMONTE_LOOP_PROFILE`, see `LoopProfile`).
+/// \param telemetry If not null, run progress is published to `*telemetry`
+///     when the run status is checked and when the run is finalized, see
+///     `publish_telemetry`.
+/// \param run_control If not null, `run_control->predicate` is evaluated
+///     after each new sample, and may stop the run early or extend it past
+///     its completion checks, see `RunControl`.
+/// \param steps_per_check Number of steps between checks for due samples
+///     and for completion. With `occ_location.mol_size()`, the pass length,
+///     they are checked once per pass, on pass boundaries, which avoids
+///     their per-step overhead. Values > 1 must divide the pass length, and
+///     require that no sampling fixture samples by step (see
+///     `validate_steps_per_check`). Cutoffs in steps may then be exceeded
+///     by fewer than `steps_per_check` steps.
+/// \param buffered_random_numbers If true, random numbers for event
+///     proposal and acceptance are drawn in blocks from a
+///     BufferedRandomNumberGenerator. Results for a given seed then differ
+///     from those with the default, `monte::RandomNumberGenerator`.
 ///
 template <typename PotentialOccDeltaPerSupercellF,
           typename ProposeOccEventFuntionType,
@@ -75,51 +373,131 @@ void occupation_metropolis_v2(
     PotentialOccDeltaPerSupercellF potential_occ_delta_per_supercell_f,
     ProposeOccEventFuntionType propose_event_f,
     ApplyOccEventFuntionType apply_event_f,
-    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager) {
-  // # construct RandomNumberGenerator
-  monte::RandomNumberGenerator<EngineType> random_number_generator(
-      run_manager.engine);
-
-  Index steps_per_pass = occ_location.mol_size();
-
-  // Used within the main loop:
-  double beta = 1.0 / (CASM::KB * temperature);
-  double delta_potential_energy;
-
-  // Main loop
-  run_manager.initialize(steps_per_pass);
-  run_manager.sample_data_by_count_if_due(state);
-  while (!run_manager.is_complete()) {
-    // Write run status, if due (check clocktime vs status log frequency, but
-    // only after #samples or #count changes)
-    run_manager.write_status_if_due();
-
-    // Propose an event
-    monte::OccEvent const &event = propose_event_f(random_number_generator);
-
-    // Calculate change in potential energy (per_supercell) due to event
-    delta_potential_energy = potential_occ_delta_per_supercell_f(event);
-
-    // Accept or reject event
-    bool accept = metropolis_acceptance(delta_potential_energy, beta,
-                                        random_number_generator);
-
-    // Apply accepted event
-    if (accept) {
-      run_manager.increment_n_accept();
-      apply_event_f(event);
-    } else {
-      run_manager.increment_n_reject();
-    }
-
-    // Increment count
-    run_manager.increment_step();
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params,
+    LoopProfile *loop_profile, TelemetryChannel *telemetry,
+    RunControl *run_control, Index steps_per_check,
+    bool buffered_random_numbers) {
+  if (buffered_random_numbers) {
+    BufferedRandomNumberGenerator<EngineType> random_number_generator(
+        run_manager.engine);
+    occupation_metropolis_impl::run_v2(
+        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
+        propose_event_f, apply_event_f, run_manager, acceptance_table_params,
+        loop_profile, telemetry, run_control, steps_per_check,
+        random_number_generator);
+  } else {
+    monte::RandomNumberGenerator<EngineType> random_number_generator(
+        run_manager.engine);
+    occupation_metropolis_impl::run_v2(
+        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
+        propose_event_f, apply_event_f, run_manager, acceptance_table_params,
+        loop_profile, telemetry, run_control, steps_per_check,
+        random_number_generator);
+  }
+}
 
-    // Sample data, if a sample is due by count
-    run_manager.sample_data_by_count_if_due(state);
+/// \brief Run an occupation metropolis Monte Carlo calculation, evaluating
+///     the change in potential energy of a batch of proposed events at once
+///
+/// Each iteration proposes `batch_size` events from the current state and
+/// calculates the change in potential energy of all of them with one call
+/// to `potential_occ_delta_batch_f`. Events are then accepted or rejected in
+/// order, each counting as one step, until one is accepted. Because all
+/// events before the accepted one were rejected, each event is proposed and
+/// evaluated with respect to the current state, so the Markov chain is the
+/// same as for `occupation_metropolis_v2`. The remaining events in the batch
+/// are discarded.
+///
+/// Batching reduces the per-event dispatch overhead of evaluating the
+/// potential, so it is most effective when the acceptance rate is low, as
+/// in long low temperature runs. With `batch_size == 1` this is equivalent
+/// to `occupation_metropolis_v2`.
+///
+/// \param state The state. Consists of both the initial
+///     configuration and conditions. Conditions must include `temperature`
+///     and any others required by `potential`.
+/// \param occ_location An occupant location tracker, which enables efficient
+///     event proposal. It must already be initialized with the input state.
+/// \param temperature The temperature, in K.
+/// \param potential_occ_delta_batch_f A function, with signature
+///     `void potential_occ_delta_batch_f(std::vector<OccEvent> const &events,
+///     Index n_events, double *delta)`, which sets `delta[i]` to the change
+///     in potential energy due to `events[i]`, for `i < n_events`, each
+///     relative to the current state.
+/// \param propose_event_f A function, with signature
+///     `OccEvent const & propose_event_f(GeneratorType
+///     &random_number_generator)`, which proposes an event. It must accept
+///     both `monte::RandomNumberGenerator<EngineType>` and
+///     `BufferedRandomNumberGenerator<EngineType>` (see
+///     `buffered_random_numbers`), for instance as a generic lambda.
+/// \param apply_event_f A function, with signature
+///     `void apply_event_f(OccEvent const &)`, which updates the state and
+///     occ_location after an event is accepted.
+/// \param batch_size Number of events proposed and evaluated together.
+/// \param run_manager Contains random number engine, sampling fixtures, and
+///     after completion holds final results
+/// \param acceptance_table_params If `acceptance_table_params.tolerance >
+///     0.0`, acceptance probabilities are read from a
+///     `MetropolisAcceptanceTable` rather than calculated with `exp`. By
+///     default, `exp` is used.
+/// \param loop_profile If not null, the time spent in each phase of the
+///     main loop is added to `*loop_profile` (only if built with
+///     `CASM_CLEXMONTE_LOOP_PROFILE`, see `LoopProfile`).
+/// \param telemetry If not null, run progress is published to `*telemetry`
+///     when the run status is checked and when the run is finalized, see
+///     `publish_telemetry`.
+/// \param run_control If not null, `run_control->predicate` is evaluated
+///     after each new sample, and may stop the run early or extend it past
+///     its completion checks, see `RunControl`.
+/// \param steps_per_check Number of steps between checks for due samples
+///     and for completion. With `occ_location.mol_size()`, the pass length,
+///     they are checked once per pass, on pass boundaries, which avoids
+///     their per-step overhead. Values > 1 must divide the pass length, and
+///     require that no sampling fixture samples by step (see
+///     `validate_steps_per_check`). Cutoffs in steps may then be exceeded
+///     by fewer than `steps_per_check` steps.
+/// \param buffered_random_numbers If true, random numbers for event
+///     proposal and acceptance are drawn in blocks from a
+///     BufferedRandomNumberGenerator. Results for a given seed then differ
+///     from those with the default, `monte::RandomNumberGenerator`.
+///
+template <typename PotentialOccDeltaBatchF,
+          typename ProposeOccEventFuntionType,
+          typename ApplyOccEventFuntionType, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void occupation_metropolis_batched(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature, PotentialOccDeltaBatchF potential_occ_delta_batch_f,
+    ProposeOccEventFuntionType propose_event_f,
+    ApplyOccEventFuntionType apply_event_f, Index batch_size,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager,
+    MetropolisAcceptanceTableParams const &acceptance_table_params,
+    LoopProfile *loop_profile, TelemetryChannel *telemetry,
+    RunControl *run_control, Index steps_per_check,
+    bool buffered_random_numbers) {
+  if (batch_size < 1) {
+    throw std::runtime_error(
+        "Error in occupation_metropolis_batched: batch_size < 1");
   }
 
-  run_manager.finalize(state);
+  if (buffered_random_numbers) {
+    BufferedRandomNumberGenerator<EngineType> random_number_generator(
+        run_manager.engine);
+    occupation_metropolis_impl::run_batched(
+        state, occ_location, temperature, potential_occ_delta_batch_f,
+        propose_event_f, apply_event_f, batch_size, run_manager,
+        acceptance_table_params, loop_profile, telemetry, run_control,
+        steps_per_check, random_number_generator);
+  } else {
+    monte::RandomNumberGenerator<EngineType> random_number_generator(
+        run_manager.engine);
+    occupation_metropolis_impl::run_batched(
+        state, occ_location, temperature, potential_occ_delta_batch_f,
+        propose_event_f, apply_event_f, batch_size, run_manager,
+        acceptance_table_params, loop_profile, telemetry, run_control,
+        steps_per_check, random_number_generator);
+  }
 }
 
 }  // namespace clexmonte
@@ -0,0 +1,166 @@
+/// An occupation Metropolis Monte Carlo main loop in which independent
+/// chains at the same conditions are evolved on a pool of threads, and
+/// sampled by one run manager, so that observations are pooled.
+
+#ifndef CASM_clexmonte_methods_parallel_chains_metropolis
+#define CASM_clexmonte_methods_parallel_chains_metropolis
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/clexmonte/methods/replica_exchange_metropolis.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Run independent occupation Metropolis Monte Carlo chains at the
+///     same conditions, with pooled observations
+///
+/// Chains are distributed over `n_threads` threads, and evolved in rounds
+/// of one pass each. After each round, on the calling thread, the steps of
+/// each chain, in chain order, are counted by `run_manager`, and each
+/// sample due during a chain's steps is taken from that chain's state at
+/// the end of the round. So one run manager collects observations from all
+/// chains, and its completion check, including the requested precision
+/// check, uses the pooled observations. With `n_chains` chains, the pooled
+/// step count advances `n_chains` passes per round.
+///
+/// Notes:
+/// - Samples are taken at the end of each round, so sampling periods
+///   should be a whole number of passes, and a multiple of the number of
+///   chains, so that each chain contributes equally to each sampling
+///   period. Consecutive observations come from different chains, so
+///   precision estimates based on the autocorrelation between consecutive
+///   observations underestimate the correlation of each chain. Use a
+///   sampling period longer than the correlation time of a chain.
+/// - The random number generator of each chain is an independent stream
+///   (see `make_stream_engine`) of one seed drawn from
+///   `run_manager.engine`, so results are reproducible for a given seed,
+///   independent of the number of threads.
+/// - Each chain must be equilibrated separately, so the equilibration cost
+///   is paid once per chain.
+/// - `set_current_chain_f(i)` is called on the thread that evolves or
+///   samples chain `i`, before it does so, i.e. to select which state
+///   sampling functions use.
+/// - The run manager is finalized with the state of the chain whose steps
+///   completed the run.
+///
+/// \param states The states of each chain, with the same conditions.
+/// \param occ_locations Occupant location trackers, one per chain, each
+///     already initialized with the corresponding state.
+/// \param temperature The temperature, in K.
+/// \param chains The functions used to evolve each chain.
+/// \param set_current_chain_f Called with the index of a chain before it is
+///     evolved or sampled.
+/// \param n_threads Maximum number of threads to use.
+/// \param run_manager Contains sampling fixtures and after completion holds
+///     final results.
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void parallel_chains_metropolis(
+    std::vector<monte::State<ConfigType>> &states,
+    std::vector<monte::OccLocation> &occ_locations, double temperature,
+    std::vector<MetropolisReplica<EngineType>> const &chains,
+    std::function<void(Index)> const &set_current_chain_f, Index n_threads,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager) {
+  Index n_chains = states.size();
+  if (n_chains == 0) {
+    throw std::runtime_error("Error in parallel_chains_metropolis: no chains");
+  }
+  if (occ_locations.size() != n_chains || chains.size() != n_chains) {
+    throw std::runtime_error(
+        "Error in parallel_chains_metropolis: the number of states, "
+        "occ_locations, and chains must match");
+  }
+  Index steps_per_pass = occ_locations[0].mol_size();
+  for (auto const &occ_location : occ_locations) {
+    if (occ_location.mol_size() != steps_per_pass) {
+      throw std::runtime_error(
+          "Error in parallel_chains_metropolis: all chains must have the "
+          "same number of mobile occupants");
+    }
+  }
+  ThreadPool pool(std::max(Index(1), std::min(n_threads, n_chains)));
+
+  // Independent random number streams for each chain
+  std::uint64_t stream_seed = (*run_manager.engine)();
+  std::vector<monte::RandomNumberGenerator<EngineType>> generators;
+  for (Index i = 0; i < n_chains; ++i) {
+    generators.emplace_back(make_stream_engine<EngineType>(stream_seed, i));
+  }
+
+  double beta = 1.0 / (CASM::KB * temperature);
+  std::vector<Index> n_accept(n_chains, 0);
+
+  // Evolve chain `i` for one pass
+  auto evolve = [&](Index i) {
+    set_current_chain_f(i);
+    auto &random_number_generator = generators[i];
+    auto const &chain = chains[i];
+    n_accept[i] = 0;
+    for (Index step = 0; step < steps_per_pass; ++step) {
+      monte::OccEvent const &event =
+          chain.propose_event_f(random_number_generator);
+      double delta_potential_energy =
+          chain.potential_occ_delta_per_supercell_f(event);
+      if (metropolis_acceptance(delta_potential_energy, beta,
+                                random_number_generator)) {
+        chain.apply_event_f(event);
+        ++n_accept[i];
+      }
+    }
+  };
+
+  // Main loop
+  set_current_chain_f(0);
+  run_manager.initialize(steps_per_pass);
+  run_manager.sample_data_by_count_if_due(states[0]);
+  Index completing_chain = 0;
+  while (!run_manager.is_complete()) {
+    // Write run status, if due
+    run_manager.write_status_if_due();
+
+    // Evolve chains concurrently
+    Index n_pool_threads = pool.n_threads();
+    pool.run([&](Index t) {
+      Index begin = (n_chains * t) / n_pool_threads;
+      Index end = (n_chains * (t + 1)) / n_pool_threads;
+      for (Index i = begin; i < end; ++i) {
+        evolve(i);
+      }
+    });
+
+    // Increment count, and sample data if a sample is due by count
+    for (Index i = 0; i < n_chains; ++i) {
+      set_current_chain_f(i);
+      for (Index step = 0; step < steps_per_pass; ++step) {
+        if (step < n_accept[i]) {
+          run_manager.increment_n_accept();
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(states[i]);
+      }
+      if (run_manager.is_complete()) {
+        completing_chain = i;
+        break;
+      }
+    }
+  }
+
+  set_current_chain_f(completing_chain);
+  run_manager.finalize(states[completing_chain]);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
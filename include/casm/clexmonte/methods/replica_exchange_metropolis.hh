@@ -0,0 +1,297 @@
+/// A replica exchange (parallel tempering) occupation Metropolis Monte Carlo
+/// main loop, in which each replica is evolved at its own conditions on a
+/// pool of threads, and configurations of replicas at neighboring conditions
+/// are periodically exchanged.
+
+#ifndef CASM_clexmonte_methods_replica_exchange_metropolis
+#define CASM_clexmonte_methods_replica_exchange_metropolis
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Functions used to evolve one replica of a replica exchange
+///     calculation
+///
+/// Each replica must use its own potential calculator and event generator,
+/// because replicas are evolved concurrently.
+template <typename EngineType>
+struct MetropolisReplica {
+  /// \brief Calculate the change in potential energy (per_supercell) due to
+  ///     a proposed event
+  std::function<double(monte::OccEvent const &)>
+      potential_occ_delta_per_supercell_f;
+
+  /// \brief Calculate the potential energy (per_supercell) of the replica's
+  ///     current configuration, at the replica's conditions
+  std::function<double()> potential_per_supercell_f;
+
+  /// \brief Propose an event
+  std::function<monte::OccEvent const &(
+      monte::RandomNumberGenerator<EngineType> &)>
+      propose_event_f;
+
+  /// \brief Update the state and occ_location after an event is accepted
+  std::function<void(monte::OccEvent const &)> apply_event_f;
+};
+
+/// \brief Counts of attempted and accepted configuration exchanges between
+///     replicas `i` and `i+1`
+struct ReplicaExchangeCounts {
+  std::vector<Index> n_attempt;
+  std::vector<Index> n_accept;
+
+  /// \brief Reset counts to zero, for `n_replicas` replicas
+  void reset(Index n_replicas) {
+    Index n_pairs = std::max(n_replicas - 1, Index(0));
+    n_attempt.assign(n_pairs, 0);
+    n_accept.assign(n_pairs, 0);
+  }
+
+  /// \brief Fraction of attempted exchanges between replicas `i` and `i+1`
+  ///     that were accepted
+  double acceptance_rate(Index i) const {
+    return n_attempt[i] ? double(n_accept[i]) / n_attempt[i] : 0.0;
+  }
+};
+
+/// \brief Exponent of the acceptance probability, `min(1, exp(-delta))`,
+///     of exchanging the configurations of replicas `i` and `j`
+///
+/// \param beta_i, beta_j `1/(k_B*T)` of replicas `i` and `j`
+/// \param phi_ii, phi_jj Potential energy of each replica's configuration
+///     at its own conditions
+/// \param phi_ij, phi_ji Potential energy of the configuration of replica
+///     `j` at the conditions of replica `i`, and vice versa
+inline double replica_exchange_delta(double beta_i, double beta_j,
+                                     double phi_ii, double phi_jj,
+                                     double phi_ij, double phi_ji) {
+  return beta_i * (phi_ij - phi_ii) + beta_j * (phi_ji - phi_jj);
+}
+
+/// \brief Accept an exchange with probability `min(1, exp(-delta))`
+template <typename GeneratorType>
+bool replica_exchange_acceptance(double delta,
+                                 GeneratorType &random_number_generator) {
+  return delta <= 0.0 ||
+         random_number_generator.random_real(1.0) < std::exp(-delta);
+}
+
+/// \brief Print the acceptance rate of exchanges between each pair of
+///     neighboring replicas
+inline void print_replica_exchange_counts(Log &log,
+                                          ReplicaExchangeCounts const &counts) {
+  log.indent() << "Replica exchange acceptance rates:" << std::endl;
+  for (Index i = 0; i < counts.n_attempt.size(); ++i) {
+    log.indent() << "- " << i << " <-> " << i + 1 << ": "
+                 << counts.acceptance_rate(i) << " (" << counts.n_accept[i]
+                 << " / " << counts.n_attempt[i] << ")" << std::endl;
+  }
+  log << std::endl;
+}
+
+/// \brief Run a replica exchange (parallel tempering) occupation Metropolis
+///     Monte Carlo calculation
+///
+/// Replicas are distributed over `n_threads` threads. Each thread evolves
+/// its replicas by Metropolis Monte Carlo for `exchange_interval` passes,
+/// then exchanges of configurations between replicas `i` and `i+1` are
+/// attempted, alternating between even and odd `i`. An exchange is accepted
+/// with probability `min(1, exp(-delta))`, where
+///
+///     delta = beta_i * (Phi_i(c_j) - Phi_i(c_i))
+///             + beta_j * (Phi_j(c_i) - Phi_j(c_j)),
+///
+/// with `Phi_i(c)` the potential energy of configuration `c` at the
+/// conditions of replica `i`. This satisfies detailed balance for
+/// replicas that differ in temperature, chemical potential, or both.
+///
+/// Notes:
+/// - Replicas stay at their conditions; configurations are exchanged. So
+///   the sampling fixtures of `run_managers[i]` sample the conditions of
+///   `states[i]`. Replicas should be ordered so that neighbors have similar
+///   conditions.
+/// - Replicas keep evolving after their run manager is complete, so that
+///   exchanges are possible until all run managers are complete, but
+///   they are not sampled again. Each run manager is finalized when it
+///   completes.
+/// - The random number generator of each replica, and the one used to
+///   accept or reject exchanges, are independent streams (see
+///   `make_stream_engine`) of one seed drawn from `run_managers[0]->engine`,
+///   so results are reproducible for a given seed, independent of the
+///   number of threads.
+/// - `set_current_replica_f(i)` is called on the thread that evolves,
+///   samples, or finalizes replica `i`, before it does so, i.e. to select
+///   which state sampling functions use.
+///
+/// \param states The states, including the initial configuration and
+///     conditions of each replica.
+/// \param occ_locations Occupant location trackers, one per replica, each
+///     already initialized with the corresponding state.
+/// \param temperatures The temperature of each replica, in K.
+/// \param replicas The functions used to evolve each replica.
+/// \param set_current_replica_f Called with the index of a replica before it
+///     is evolved, sampled, or finalized.
+/// \param exchange_interval Number of passes between exchange attempts.
+/// \param n_threads Maximum number of threads to use.
+/// \param run_managers Run managers, one per replica, which contain
+///     sampling fixtures and after completion hold final results.
+/// \param counts Set to the counts of attempted and accepted exchanges.
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void replica_exchange_metropolis(
+    std::vector<monte::State<ConfigType>> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    std::vector<double> const &temperatures,
+    std::vector<MetropolisReplica<EngineType>> const &replicas,
+    std::function<void(Index)> const &set_current_replica_f,
+    Index exchange_interval, Index n_threads,
+    std::vector<std::shared_ptr<
+        monte::RunManager<ConfigType, StatisticsType, EngineType>>> const
+        &run_managers,
+    ReplicaExchangeCounts &counts) {
+  Index n_replicas = states.size();
+  if (n_replicas == 0) {
+    throw std::runtime_error(
+        "Error in replica_exchange_metropolis: no replicas");
+  }
+  if (occ_locations.size() != n_replicas ||
+      temperatures.size() != n_replicas || replicas.size() != n_replicas ||
+      run_managers.size() != n_replicas) {
+    throw std::runtime_error(
+        "Error in replica_exchange_metropolis: the number of states, "
+        "occ_locations, temperatures, replicas, and run_managers must match");
+  }
+  if (exchange_interval < 1) {
+    throw std::runtime_error(
+        "Error in replica_exchange_metropolis: exchange_interval < 1");
+  }
+  ThreadPool pool(std::max(Index(1), std::min(n_threads, n_replicas)));
+
+  // Independent random number streams for each replica, and for exchanges
+  std::uint64_t stream_seed = (*run_managers[0]->engine)();
+  std::vector<monte::RandomNumberGenerator<EngineType>> generators;
+  for (Index i = 0; i < n_replicas; ++i) {
+    generators.emplace_back(make_stream_engine<EngineType>(stream_seed, i));
+  }
+  monte::RandomNumberGenerator<EngineType> exchange_generator(
+      make_stream_engine<EngineType>(stream_seed, n_replicas));
+
+  std::vector<double> beta(n_replicas);
+  std::vector<Index> steps_per_pass(n_replicas);
+  std::vector<unsigned char> is_complete(n_replicas, 0);
+  counts.reset(n_replicas);
+
+  for (Index i = 0; i < n_replicas; ++i) {
+    beta[i] = 1.0 / (CASM::KB * temperatures[i]);
+    steps_per_pass[i] = occ_locations[i].mol_size();
+    set_current_replica_f(i);
+    run_managers[i]->initialize(steps_per_pass[i]);
+    run_managers[i]->sample_data_by_count_if_due(states[i]);
+    if (run_managers[i]->is_complete()) {
+      is_complete[i] = 1;
+      run_managers[i]->finalize(states[i]);
+    }
+  }
+
+  // Evolve replica `i` for `exchange_interval` passes
+  auto evolve = [&](Index i) {
+    set_current_replica_f(i);
+    auto &run_manager = *run_managers[i];
+    auto &random_number_generator = generators[i];
+    auto const &replica = replicas[i];
+    Index n_steps = exchange_interval * steps_per_pass[i];
+    for (Index step = 0; step < n_steps; ++step) {
+      if (!is_complete[i]) {
+        run_manager.write_status_if_due();
+      }
+
+      monte::OccEvent const &event =
+          replica.propose_event_f(random_number_generator);
+      double delta_potential_energy =
+          replica.potential_occ_delta_per_supercell_f(event);
+      bool accept = metropolis_acceptance(delta_potential_energy, beta[i],
+                                          random_number_generator);
+      if (accept) {
+        replica.apply_event_f(event);
+      }
+
+      if (!is_complete[i]) {
+        if (accept) {
+          run_manager.increment_n_accept();
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(states[i]);
+        if (run_manager.is_complete()) {
+          is_complete[i] = 1;
+          run_manager.finalize(states[i]);
+        }
+      }
+    }
+  };
+
+  // Exchange configurations of replicas `i` and `i+1`
+  auto _swap = [&](Index i, Index j) {
+    get_occupation(states[i]).swap(get_occupation(states[j]));
+    occ_locations[i].initialize(get_occupation(states[i]));
+    occ_locations[j].initialize(get_occupation(states[j]));
+  };
+  auto attempt_exchange = [&](Index i) {
+    Index j = i + 1;
+    double phi_ii = replicas[i].potential_per_supercell_f();
+    double phi_jj = replicas[j].potential_per_supercell_f();
+    _swap(i, j);
+    double phi_ij = replicas[i].potential_per_supercell_f();
+    double phi_ji = replicas[j].potential_per_supercell_f();
+    double delta = replica_exchange_delta(beta[i], beta[j], phi_ii, phi_jj,
+                                          phi_ij, phi_ji);
+    ++counts.n_attempt[i];
+    if (replica_exchange_acceptance(delta, exchange_generator)) {
+      ++counts.n_accept[i];
+    } else {
+      _swap(i, j);
+    }
+  };
+
+  // Main loop
+  Index n_exchange_rounds = 0;
+  while (std::find(is_complete.begin(), is_complete.end(), 0) !=
+         is_complete.end()) {
+    // Evolve replicas concurrently
+    Index n_pool_threads = pool.n_threads();
+    pool.run([&](Index t) {
+      Index begin = (n_replicas * t) / n_pool_threads;
+      Index end = (n_replicas * (t + 1)) / n_pool_threads;
+      for (Index i = begin; i < end; ++i) {
+        evolve(i);
+      }
+    });
+
+    // Attempt exchanges, alternating even and odd pairs
+    for (Index i = n_exchange_rounds % 2; i + 1 < n_replicas; i += 2) {
+      attempt_exchange(i);
+    }
+    ++n_exchange_rounds;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,272 @@
+/// A replica exchange occupation Metropolis Monte Carlo main loop for
+/// replicas distributed over the ranks of an MPI communicator, in which
+/// replicas exchange conditions, so only energies are communicated.
+
+#ifndef CASM_clexmonte_methods_replica_exchange_mpi
+#define CASM_clexmonte_methods_replica_exchange_mpi
+
+#ifdef CASM_CLEXMONTE_MPI
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/methods/replica_exchange_metropolis.hh"
+#include "casm/clexmonte/methods/replica_exchange_slots.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Functions used to evolve one walker of an MPI replica exchange
+///     calculation
+///
+/// In addition to the MetropolisReplica functions, which use the walker's
+/// current conditions, a walker must be able to evaluate its potential at
+/// the conditions of any slot, and to change its conditions.
+template <typename EngineType>
+struct MPIMetropolisReplica : public MetropolisReplica<EngineType> {
+  /// \brief Calculate the potential energy (per_supercell) of the walker's
+  ///     current configuration at the conditions of a slot
+  std::function<double(Index)> potential_per_supercell_at_slot_f;
+
+  /// \brief Change the walker's conditions, i.e. the state conditions and
+  ///     the potential, to those of a slot
+  std::function<void(Index)> set_slot_f;
+};
+
+/// \brief The walkers `[begin, end)` evolved by a rank
+inline std::pair<Index, Index> mpi_replica_walker_range(Index n_walkers,
+                                                        int rank, int size) {
+  return std::make_pair((n_walkers * rank) / size,
+                        (n_walkers * (rank + 1)) / size);
+}
+
+/// \brief Run a replica exchange occupation Metropolis Monte Carlo
+///     calculation, with replicas distributed over MPI ranks
+///
+/// Each rank evolves the walkers `mpi_replica_walker_range(n_slots, rank,
+/// size)` by Metropolis Monte Carlo for `exchange_interval` passes. Then
+/// each walker evaluates its potential at the conditions of its slot and of
+/// its slot's exchange partner, these two values per walker are gathered on
+/// all ranks, and every rank makes the same exchange decisions with
+/// `slots.exchange` (see ReplicaExchangeSlots). Walkers whose slot changed
+/// then call `set_slot_f`. Configurations are never communicated, so the
+/// cost of an exchange round does not depend on the supercell size, and
+/// hundreds of replicas on many nodes are practical. Exchanges may be over
+/// a grid of conditions, for example temperature x chemical potential, or
+/// between slots that differ in potential parameters (Hamiltonian
+/// exchange), as long as `potential_per_supercell_at_slot_f` evaluates the
+/// potential with the slot's parameters.
+///
+/// Notes:
+/// - Each walker has its own run manager, which samples the walker at the
+///   conditions of its current slot. The slots of every walker after each
+///   round are recorded in `slots.history()`, which can be used to
+///   demultiplex samples by conditions: exchange round `r` begins after
+///   `r * exchange_interval` passes of every walker.
+/// - Walkers keep evolving after their run manager is complete, so that
+///   exchanges are possible until the run managers of all walkers, on all
+///   ranks, are complete. Each run manager is finalized when it completes.
+/// - The random number generator of walker `w` is stream `w`, and the one
+///   used for exchanges is stream `n_slots`, of one seed drawn on rank 0
+///   from `run_managers[0]->engine` (see `make_stream_engine`), so results
+///   are reproducible for a given seed, independent of the number of ranks.
+/// - `set_current_replica_f(i)` is called before local walker `i` is
+///   evolved, sampled, or finalized.
+///
+/// \param states The states of the local walkers, including their initial
+///     configurations.
+/// \param occ_locations Occupant location trackers, one per local walker,
+///     each already initialized with the corresponding state.
+/// \param replicas The functions used to evolve each local walker.
+/// \param set_current_replica_f Called with the local index of a walker
+///     before it is evolved, sampled, or finalized.
+/// \param slots The slot conditions, identical on all ranks. On return,
+///     holds the replica trajectories and exchange counts.
+/// \param exchange_interval Number of passes between exchange attempts.
+/// \param run_managers Run managers, one per local walker, which contain
+///     sampling fixtures and after completion hold final results.
+/// \param comm The MPI communicator
+///
+/// Requires:
+/// - MPI is initialized
+/// - `slots.n_slots()` >= the number of ranks of `comm`
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void mpi_replica_exchange_metropolis(
+    std::vector<monte::State<ConfigType>> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    std::vector<MPIMetropolisReplica<EngineType>> const &replicas,
+    std::function<void(Index)> const &set_current_replica_f,
+    ReplicaExchangeSlots &slots, Index exchange_interval,
+    std::vector<std::shared_ptr<
+        monte::RunManager<ConfigType, StatisticsType, EngineType>>> const
+        &run_managers,
+    MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  Index n_slots = slots.n_slots();
+  if (n_slots < size) {
+    throw std::runtime_error(
+        "Error in mpi_replica_exchange_metropolis: fewer slots than ranks");
+  }
+  auto range = mpi_replica_walker_range(n_slots, rank, size);
+  Index begin = range.first;
+  Index n_local = range.second - range.first;
+  if (states.size() != n_local || occ_locations.size() != n_local ||
+      replicas.size() != n_local || run_managers.size() != n_local) {
+    throw std::runtime_error(
+        "Error in mpi_replica_exchange_metropolis: the number of states, "
+        "occ_locations, replicas, and run_managers must equal the number of "
+        "walkers of this rank");
+  }
+  if (exchange_interval < 1) {
+    throw std::runtime_error(
+        "Error in mpi_replica_exchange_metropolis: exchange_interval < 1");
+  }
+
+  // Independent random number streams for each walker, and for exchanges
+  std::uint64_t stream_seed = 0;
+  if (rank == 0) {
+    stream_seed = (*run_managers[0]->engine)();
+  }
+  MPI_Bcast(&stream_seed, 1, MPI_UINT64_T, 0, comm);
+  std::vector<monte::RandomNumberGenerator<EngineType>> generators;
+  for (Index i = 0; i < n_local; ++i) {
+    generators.emplace_back(
+        make_stream_engine<EngineType>(stream_seed, begin + i));
+  }
+  monte::RandomNumberGenerator<EngineType> exchange_generator(
+      make_stream_engine<EngineType>(stream_seed, n_slots));
+
+  // Gather layout: two values per walker, in walker order
+  std::vector<int> recv_counts(size);
+  std::vector<int> displacements(size);
+  for (int r = 0; r < size; ++r) {
+    auto r_range = mpi_replica_walker_range(n_slots, r, size);
+    recv_counts[r] = 2 * (r_range.second - r_range.first);
+    displacements[r] = 2 * r_range.first;
+  }
+
+  std::vector<Index> steps_per_pass(n_local);
+  std::vector<unsigned char> is_complete(n_local, 0);
+  for (Index i = 0; i < n_local; ++i) {
+    replicas[i].set_slot_f(slots.slot(begin + i));
+    steps_per_pass[i] = occ_locations[i].mol_size();
+    set_current_replica_f(i);
+    run_managers[i]->initialize(steps_per_pass[i]);
+    run_managers[i]->sample_data_by_count_if_due(states[i]);
+    if (run_managers[i]->is_complete()) {
+      is_complete[i] = 1;
+      run_managers[i]->finalize(states[i]);
+    }
+  }
+
+  // Evolve local walker `i` for `exchange_interval` passes
+  auto evolve = [&](Index i) {
+    set_current_replica_f(i);
+    auto &run_manager = *run_managers[i];
+    auto &random_number_generator = generators[i];
+    auto const &replica = replicas[i];
+    double beta = slots.beta(slots.slot(begin + i));
+    Index n_steps = exchange_interval * steps_per_pass[i];
+    for (Index step = 0; step < n_steps; ++step) {
+      if (!is_complete[i]) {
+        run_manager.write_status_if_due();
+      }
+
+      monte::OccEvent const &event =
+          replica.propose_event_f(random_number_generator);
+      double delta_potential_energy =
+          replica.potential_occ_delta_per_supercell_f(event);
+      bool accept = metropolis_acceptance(delta_potential_energy, beta,
+                                          random_number_generator);
+      if (accept) {
+        replica.apply_event_f(event);
+      }
+
+      if (!is_complete[i]) {
+        if (accept) {
+          run_manager.increment_n_accept();
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(states[i]);
+        if (run_manager.is_complete()) {
+          is_complete[i] = 1;
+          run_manager.finalize(states[i]);
+        }
+      }
+    }
+  };
+
+  auto is_all_complete = [&]() {
+    int local_incomplete = std::find(is_complete.begin(), is_complete.end(),
+                                     0) != is_complete.end();
+    int any_incomplete = 0;
+    MPI_Allreduce(&local_incomplete, &any_incomplete, 1, MPI_INT, MPI_MAX,
+                  comm);
+    return !any_incomplete;
+  };
+
+  // Main loop
+  std::vector<double> local_phi(2 * n_local);
+  std::vector<double> phi(2 * n_slots);
+  std::vector<double> phi_own(n_slots);
+  std::vector<double> phi_partner(n_slots);
+  Index round = 0;
+  while (!is_all_complete()) {
+    for (Index i = 0; i < n_local; ++i) {
+      evolve(i);
+    }
+
+    // Exchange energies, never configurations
+    for (Index i = 0; i < n_local; ++i) {
+      Index slot = slots.slot(begin + i);
+      Index partner = slots.partner(slot, round);
+      local_phi[2 * i] = replicas[i].potential_per_supercell_f();
+      local_phi[2 * i + 1] =
+          partner >= 0 ? replicas[i].potential_per_supercell_at_slot_f(partner)
+                       : 0.0;
+    }
+    MPI_Allgatherv(local_phi.data(), local_phi.size(), MPI_DOUBLE,
+                   phi.data(), recv_counts.data(), displacements.data(),
+                   MPI_DOUBLE, comm);
+    for (Index w = 0; w < n_slots; ++w) {
+      phi_own[w] = phi[2 * w];
+      phi_partner[w] = phi[2 * w + 1];
+    }
+
+    // Every rank makes the same decisions
+    std::vector<Index> previous_slots = slots.history().back();
+    slots.exchange(round, phi_own, phi_partner, exchange_generator);
+    for (Index i = 0; i < n_local; ++i) {
+      Index slot = slots.slot(begin + i);
+      if (slot != previous_slots[begin + i]) {
+        replicas[i].set_slot_f(slot);
+      }
+    }
+    ++round;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif  // CASM_CLEXMONTE_MPI
+
+#endif
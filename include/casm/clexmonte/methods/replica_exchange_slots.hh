@@ -0,0 +1,259 @@
+/// Bookkeeping for replica exchange calculations in which replicas exchange
+/// conditions rather than configurations, so that only energies need to be
+/// communicated between processes.
+
+#ifndef CASM_clexmonte_methods_replica_exchange_slots
+#define CASM_clexmonte_methods_replica_exchange_slots
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Assignment of replicas to conditions "slots", and its history
+///
+/// In a replica exchange calculation in which conditions are exchanged,
+/// each replica ("walker") keeps its configuration and moves between a
+/// fixed set of conditions, the "slots". Slots are arranged on a grid, for
+/// example temperature x chemical potential, with `shape[a]` slots along
+/// axis `a`. The slot index is
+///
+///     slot = x_0 + shape[0] * (x_1 + shape[1] * (x_2 + ...)),
+///
+/// where `x_a` is the slot coordinate along axis `a`. Slots may also differ
+/// in potential parameters, for Hamiltonian exchange.
+///
+/// In exchange round `round`, exchanges are attempted between slots that
+/// are neighbors along axis `a = round % n_axes`, pairing coordinates
+/// `(x, x+1)` with `x % 2 == (round / n_axes) % 2`, so that all pairs along
+/// every axis are attempted in turn.
+///
+/// An exchange of the walkers at slots `k` and `l` is accepted with
+/// probability `min(1, exp(-delta))`, where
+///
+///     delta = beta_k * (Phi_k(c_l) - Phi_k(c_k))
+///             + beta_l * (Phi_l(c_k) - Phi_l(c_l)),
+///
+/// with `c_k` the configuration of the walker at slot `k`, and `Phi_k(c)`
+/// the potential energy of configuration `c` at the conditions of slot `k`.
+///
+/// The slot of each walker after each exchange round is recorded, for
+/// analysis of the replica trajectories, i.e. to demultiplex walker
+/// samples by conditions or to count round trips.
+class ReplicaExchangeSlots {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _shape The number of slots along each axis
+  /// \param _beta The value of `1/(kB*T)` of each slot
+  ///
+  /// Initially, walker `i` is at slot `i`.
+  ReplicaExchangeSlots(std::vector<Index> const &_shape,
+                       std::vector<double> const &_beta)
+      : m_shape(_shape), m_beta(_beta) {
+    Index n_slots = 1;
+    for (Index n : m_shape) {
+      if (n < 1) {
+        throw std::runtime_error(
+            "Error constructing ReplicaExchangeSlots: shape value < 1");
+      }
+      m_stride.push_back(n_slots);
+      n_slots *= n;
+    }
+    if (m_shape.empty() || m_beta.size() != n_slots) {
+      throw std::runtime_error(
+          "Error constructing ReplicaExchangeSlots: beta size must equal the "
+          "number of slots");
+    }
+    for (Index i = 0; i < n_slots; ++i) {
+      m_walker_of_slot.push_back(i);
+      m_slot_of_walker.push_back(i);
+    }
+    m_n_attempt.assign(n_slots * n_axes(), 0);
+    m_n_accept.assign(n_slots * n_axes(), 0);
+    m_history.push_back(m_slot_of_walker);
+  }
+
+  /// \brief Number of slots, which equals the number of walkers
+  Index n_slots() const { return m_beta.size(); }
+
+  /// \brief Number of slot grid axes
+  Index n_axes() const { return m_shape.size(); }
+
+  /// \brief Number of slots along each axis
+  std::vector<Index> const &shape() const { return m_shape; }
+
+  /// \brief The value of `1/(kB*T)` of a slot
+  double beta(Index slot) const { return m_beta[slot]; }
+
+  /// \brief The coordinate of `slot` along `axis`
+  Index coordinate(Index slot, Index axis) const {
+    return (slot / m_stride[axis]) % m_shape[axis];
+  }
+
+  /// \brief The slot of a walker
+  Index slot(Index walker) const { return m_slot_of_walker[walker]; }
+
+  /// \brief The walker at a slot
+  Index walker(Index slot) const { return m_walker_of_slot[slot]; }
+
+  /// \brief The axis along which exchanges are attempted in a round
+  Index axis(Index round) const { return round % n_axes(); }
+
+  /// \brief The slot `slot` may exchange with in a round, or -1 if none
+  Index partner(Index slot, Index round) const {
+    Index a = axis(round);
+    Index parity = (round / n_axes()) % 2;
+    Index x = coordinate(slot, a);
+    if (x % 2 == parity) {
+      return x + 1 < m_shape[a] ? slot + m_stride[a] : -1;
+    }
+    return x > 0 ? slot - m_stride[a] : -1;
+  }
+
+  /// \brief Attempt the exchanges of a round
+  ///
+  /// \param round The exchange round
+  /// \param phi_own The potential energy of each walker's configuration at
+  ///     the conditions of its slot, indexed by walker
+  /// \param phi_partner The potential energy of each walker's configuration
+  ///     at the conditions of its slot's partner in this round, indexed by
+  ///     walker. Values for walkers without a partner are ignored.
+  /// \param random_number_generator Used to accept or reject exchanges
+  ///
+  /// After the exchanges, the slot of each walker is recorded in
+  /// `history()`.
+  template <typename GeneratorType>
+  void exchange(Index round, std::vector<double> const &phi_own,
+                std::vector<double> const &phi_partner,
+                GeneratorType &random_number_generator) {
+    Index a = axis(round);
+    for (Index k = 0; k < n_slots(); ++k) {
+      Index l = partner(k, round);
+      if (l < k) {
+        continue;
+      }
+      Index w_k = m_walker_of_slot[k];
+      Index w_l = m_walker_of_slot[l];
+      double delta = m_beta[k] * (phi_partner[w_l] - phi_own[w_k]) +
+                     m_beta[l] * (phi_partner[w_k] - phi_own[w_l]);
+      ++m_n_attempt[k * n_axes() + a];
+      if (delta <= 0.0 ||
+          random_number_generator.random_real(1.0) < std::exp(-delta)) {
+        ++m_n_accept[k * n_axes() + a];
+        m_walker_of_slot[k] = w_l;
+        m_walker_of_slot[l] = w_k;
+        m_slot_of_walker[w_l] = k;
+        m_slot_of_walker[w_k] = l;
+      }
+    }
+    m_history.push_back(m_slot_of_walker);
+  }
+
+  /// \brief Number of attempted exchanges between `slot` and its upper
+  ///     neighbor along `axis`
+  Index n_attempt(Index slot, Index axis) const {
+    return m_n_attempt[slot * n_axes() + axis];
+  }
+
+  /// \brief Number of accepted exchanges between `slot` and its upper
+  ///     neighbor along `axis`
+  Index n_accept(Index slot, Index axis) const {
+    return m_n_accept[slot * n_axes() + axis];
+  }
+
+  /// \brief Fraction of attempted exchanges between `slot` and its upper
+  ///     neighbor along `axis` that were accepted
+  double acceptance_rate(Index slot, Index axis) const {
+    Index n = n_attempt(slot, axis);
+    return n ? double(n_accept(slot, axis)) / n : 0.0;
+  }
+
+  /// \brief The slot of each walker, initially and after each exchange
+  ///     round
+  ///
+  /// `history()[r][w]` is the slot of walker `w` after `r` exchange rounds.
+  std::vector<std::vector<Index>> const &history() const { return m_history; }
+
+  /// \brief Number of round trips of a walker along `axis`
+  ///
+  /// A round trip is counted each time the walker returns to one end of the
+  /// axis after visiting the other end. More round trips indicate better
+  /// mixing of the replica exchange.
+  Index n_round_trips(Index walker, Index axis = 0) const {
+    Index last = m_shape[axis] - 1;
+    if (last == 0) {
+      return 0;
+    }
+    Index n_ends = 0;
+    Index previous_end = -1;
+    for (auto const &slots : m_history) {
+      Index x = coordinate(slots[walker], axis);
+      if ((x == 0 || x == last) && x != previous_end) {
+        if (previous_end != -1) {
+          ++n_ends;
+        }
+        previous_end = x;
+      }
+    }
+    return n_ends / 2;
+  }
+
+ private:
+  std::vector<Index> m_shape;
+  std::vector<Index> m_stride;
+  std::vector<double> m_beta;
+  std::vector<Index> m_walker_of_slot;
+  std::vector<Index> m_slot_of_walker;
+  std::vector<Index> m_n_attempt;
+  std::vector<Index> m_n_accept;
+  std::vector<std::vector<Index>> m_history;
+};
+
+/// \brief Write the replica trajectories and exchange counts to JSON
+///
+/// Format:
+///   shape: array of int
+///     Number of slots along each axis.
+///   walker_slots: array of array of int
+///     `walker_slots[r][w]` is the slot of walker `w` after `r` exchange
+///     rounds.
+///   n_attempt, n_accept: array of array of int
+///     `n_attempt[k][a]` is the number of exchanges attempted between slot
+///     `k` and its upper neighbor along axis `a`.
+///   n_round_trips: array of int
+///     Number of round trips along axis 0 of each walker.
+inline jsonParser &to_json(ReplicaExchangeSlots const &slots,
+                           jsonParser &json) {
+  json["shape"] = slots.shape();
+  json["walker_slots"] = slots.history();
+  std::vector<std::vector<Index>> n_attempt;
+  std::vector<std::vector<Index>> n_accept;
+  for (Index k = 0; k < slots.n_slots(); ++k) {
+    n_attempt.emplace_back();
+    n_accept.emplace_back();
+    for (Index a = 0; a < slots.n_axes(); ++a) {
+      n_attempt.back().push_back(slots.n_attempt(k, a));
+      n_accept.back().push_back(slots.n_accept(k, a));
+    }
+  }
+  json["n_attempt"] = n_attempt;
+  json["n_accept"] = n_accept;
+  std::vector<Index> n_round_trips;
+  for (Index w = 0; w < slots.n_slots(); ++w) {
+    n_round_trips.push_back(slots.n_round_trips(w));
+  }
+  json["n_round_trips"] = n_round_trips;
+  return json;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
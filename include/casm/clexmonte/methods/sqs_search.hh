@@ -0,0 +1,82 @@
+#ifndef CASM_clexmonte_methods_sqs_search
+#define CASM_clexmonte_methods_sqs_search
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/state/CorrMatchingPotential.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Parameters for `sqs_search`
+struct SQSSearchParams {
+  /// \brief Key of the basis set used to calculate correlations
+  std::string basis_set_key = "formation_energy";
+
+  /// \brief Number of independent annealing chains per candidate supercell
+  Index n_chains_per_supercell = 1;
+
+  /// \brief Number of passes per chain, where one pass is one proposed
+  ///     canonical swap per site
+  Index n_passes = 1000;
+
+  /// \brief Annealing temperature, in units of the correlation-matching
+  ///     potential, at the first pass
+  double initial_temperature = 1.0;
+
+  /// \brief Annealing temperature at the last pass. Temperatures decrease
+  ///     geometrically.
+  double final_temperature = 1e-3;
+
+  /// \brief Number of best configurations kept
+  Index n_best = 10;
+
+  /// \brief Number of threads chains are run on
+  Index n_threads = 1;
+
+  /// \brief If true, stop all chains once a configuration matching all
+  ///     target correlations exactly is found
+  bool stop_if_exact = true;
+
+  /// \brief Seed of chain `i` is `seed + i`, so results do not depend on
+  ///     the number of threads, unless a chain stops early
+  std::uint64_t seed = 0;
+};
+
+/// \brief One of the best configurations found by `sqs_search`
+struct SQSResult {
+  /// \brief Index into the candidate supercells
+  Index supercell_index;
+
+  /// \brief Chain index, for the chain's seed
+  Index chain_index;
+
+  /// \brief Supercell transformation matrix
+  Eigen::Matrix3l transformation_matrix_to_super;
+
+  /// \brief Occupation
+  Eigen::VectorXi occupation;
+
+  /// \brief Correlation-matching potential value
+  double potential;
+
+  /// \brief Number of leading exactly matching targets
+  Index n_exact;
+};
+
+/// \brief Search for special quasirandom structures (SQS) by running
+///     independent annealing chains over candidate supercells in parallel
+std::vector<SQSResult> sqs_search(
+    System &system, std::vector<Eigen::Matrix3l> const &supercells,
+    Eigen::VectorXd const &target_mol_composition,
+    CorrMatchingParams const &corr_matching_params,
+    SQSSearchParams const &search_params);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
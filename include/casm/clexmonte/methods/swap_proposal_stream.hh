@@ -0,0 +1,274 @@
+#ifndef CASM_clexmonte_methods_swap_proposal_stream
+#define CASM_clexmonte_methods_swap_proposal_stream
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEvent.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Proposes canonical or semi-grand canonical swap events from
+///     blocks of pre-drawn proposals
+///
+/// `monte::propose_canonical_event` and
+/// `monte::propose_semigrand_canonical_event` sum the number of candidates
+/// of every swap type, choose a swap type, and then choose candidates, for
+/// every proposal. A SwapProposalStream instead draws a block of
+/// `block_size` proposals at once, each a swap type and the positions of the
+/// candidates in the `monte::OccLocation` candidate lists, and proposes
+/// events from them in order:
+///
+/// - The swap type weights, the product of the numbers of candidates of a
+///   canonical swap or the number of candidates of a semi-grand canonical
+///   swap, are calculated once per block.
+/// - A position drawn uniformly from a candidate list is a uniformly random
+///   candidate for any contents of the list, so proposals remain valid
+///   after an event is applied, as long as the number of candidates of each
+///   type is unchanged. This is the case for canonical swaps between sites
+///   of the same asymmetric unit.
+/// - Applied events that change the number of candidates of any type must be
+///   passed to `notify_applied`, which discards the rest of the block.
+///   Since most proposals are rejected at low acceptance rates, the block
+///   is still reused for many proposals.
+///
+/// Proposals have the same distribution as those of the `monte` functions,
+/// but random numbers are consumed in a different order, so results for a
+/// given seed differ.
+///
+/// Notes:
+/// - Events do not include atom trajectories, so the `monte::OccLocation`
+///   must not track atom positions.
+class SwapProposalStream {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _swaps Canonical swaps, or semi-grand canonical single site
+  ///     swaps
+  /// \param _is_canonical If true, propose canonical swaps, else semi-grand
+  ///     canonical single site changes
+  /// \param _block_size Number of proposals drawn at once
+  SwapProposalStream(std::vector<monte::OccSwap> const &_swaps,
+                     bool _is_canonical, Index _block_size)
+      : swaps(_swaps),
+        is_canonical(_is_canonical),
+        block_size(_block_size),
+        m_next(0),
+        m_n_blocks(0) {
+    if (swaps.size() == 0) {
+      throw std::runtime_error(
+          "Error constructing SwapProposalStream: no swaps");
+    }
+    if (block_size < 1) {
+      throw std::runtime_error(
+          "Error constructing SwapProposalStream: block_size < 1");
+    }
+    m_cumulative_weight.resize(swaps.size());
+    m_block.reserve(block_size);
+  }
+
+  /// \brief Swap types
+  std::vector<monte::OccSwap> const swaps;
+
+  /// \brief If true, propose canonical swaps, else semi-grand canonical
+  ///     single site changes
+  bool const is_canonical;
+
+  /// \brief Number of proposals drawn at once
+  Index const block_size;
+
+  /// \brief Discard remaining proposals, for instance when the occupant
+  ///     location tracker is changed
+  void reset() {
+    m_block.clear();
+    m_next = 0;
+  }
+
+  /// \brief Discard remaining proposals if an applied event changed the
+  ///     number of candidates of any type
+  void notify_applied(monte::OccEvent const &e) {
+    if (_changes_candidate_counts(e)) {
+      reset();
+    }
+  }
+
+  /// \brief Propose an event
+  template <typename GeneratorType>
+  monte::OccEvent &propose(monte::OccEvent &e,
+                           monte::OccLocation const &occ_location,
+                           GeneratorType &random_number_generator);
+
+  /// \brief Call `f(l)` for each site `l` of the next proposal, if it has
+  ///     already been drawn
+  template <typename SiteF>
+  void prefetch_next(monte::OccLocation const &occ_location, SiteF f) const;
+
+  /// \brief Number of blocks of proposals drawn
+  Index n_blocks() const { return m_n_blocks; }
+
+ private:
+  struct Proposal {
+    Index swap_index;
+    Index loc_a;
+    Index loc_b;
+  };
+
+  template <typename GeneratorType>
+  void _draw_block(monte::OccLocation const &occ_location,
+                   GeneratorType &random_number_generator);
+
+  bool _changes_candidate_counts(monte::OccEvent const &e) const;
+
+  std::vector<double> m_cumulative_weight;
+
+  std::vector<Proposal> m_block;
+
+  Index m_next;
+
+  Index m_n_blocks;
+};
+
+/// \brief Propose an event
+///
+/// \param e Event to set, reusing its storage
+/// \param occ_location The occupant location tracker. If it is not the one
+///     used for the previous proposal, or it was changed other than by
+///     events passed to `notify_applied`, `reset` must be called first.
+/// \param random_number_generator A random number generator, such as
+///     `monte::RandomNumberGenerator` or `BufferedRandomNumberGenerator`
+///
+/// \returns A reference to `e`
+template <typename GeneratorType>
+monte::OccEvent &SwapProposalStream::propose(
+    monte::OccEvent &e, monte::OccLocation const &occ_location,
+    GeneratorType &random_number_generator) {
+  if (m_next == Index(m_block.size())) {
+    _draw_block(occ_location, random_number_generator);
+  }
+  Proposal const &proposal = m_block[m_next++];
+  monte::OccSwap const &swap = swaps[proposal.swap_index];
+  monte::Conversions const &convert = occ_location.convert();
+
+  Index n_sites = is_canonical ? 2 : 1;
+  e.linear_site_index.resize(n_sites);
+  e.new_occ.resize(n_sites);
+  e.occ_transform.resize(n_sites);
+  e.atom_traj.clear();
+
+  auto _set_site = [&](Index i, Index mol_id, monte::OccCandidate const &from,
+                       monte::OccCandidate const &to) {
+    monte::Mol const &mol = occ_location.mol(mol_id);
+    e.linear_site_index[i] = mol.l;
+    e.new_occ[i] = convert.occ_index(to.asym, to.species_index);
+    monte::OccTransform &transform = e.occ_transform[i];
+    transform.l = mol.l;
+    transform.mol_id = mol_id;
+    transform.asym = from.asym;
+    transform.from_species = from.species_index;
+    transform.to_species = to.species_index;
+  };
+
+  if (is_canonical) {
+    _set_site(0, occ_location.mol_id(swap.cand_a, proposal.loc_a), swap.cand_a,
+              monte::OccCandidate(swap.cand_a.asym, swap.cand_b.species_index));
+    _set_site(1, occ_location.mol_id(swap.cand_b, proposal.loc_b), swap.cand_b,
+              monte::OccCandidate(swap.cand_b.asym, swap.cand_a.species_index));
+  } else {
+    _set_site(0, occ_location.mol_id(swap.cand_a, proposal.loc_a), swap.cand_a,
+              swap.cand_b);
+  }
+  return e;
+}
+
+/// \brief Call `f(l)` for each site `l` of the next proposal, if it has
+///     already been drawn
+///
+/// This allows prefetching memory for the next proposal, for instance with
+/// a NeighborhoodPrefetcher, while the current proposal is evaluated. Does
+/// nothing if the current block is used up or was discarded.
+///
+/// \param occ_location The occupant location tracker, as for `propose`
+/// \param f A function with signature `void f(Index l)`
+template <typename SiteF>
+void SwapProposalStream::prefetch_next(monte::OccLocation const &occ_location,
+                                       SiteF f) const {
+  if (m_next == Index(m_block.size())) {
+    return;
+  }
+  Proposal const &proposal = m_block[m_next];
+  monte::OccSwap const &swap = swaps[proposal.swap_index];
+  f(occ_location.mol(occ_location.mol_id(swap.cand_a, proposal.loc_a)).l);
+  if (is_canonical) {
+    f(occ_location.mol(occ_location.mol_id(swap.cand_b, proposal.loc_b)).l);
+  }
+}
+
+/// \brief Draw a block of proposals, using the current numbers of
+///     candidates
+template <typename GeneratorType>
+void SwapProposalStream::_draw_block(monte::OccLocation const &occ_location,
+                                     GeneratorType &random_number_generator) {
+  double total = 0.0;
+  for (Index i = 0; i < Index(swaps.size()); ++i) {
+    double weight = occ_location.cand_size(swaps[i].cand_a);
+    if (is_canonical) {
+      weight *= occ_location.cand_size(swaps[i].cand_b);
+    }
+    total += weight;
+    m_cumulative_weight[i] = total;
+  }
+  if (total == 0.0) {
+    throw std::runtime_error(
+        "Error in SwapProposalStream: no swaps are possible");
+  }
+
+  m_block.resize(block_size);
+  for (Proposal &proposal : m_block) {
+    double r = random_number_generator.random_real(total);
+    Index swap_index = std::upper_bound(m_cumulative_weight.begin(),
+                                        m_cumulative_weight.end(), r) -
+                       m_cumulative_weight.begin();
+    swap_index = std::min(swap_index, Index(swaps.size()) - 1);
+    monte::OccSwap const &swap = swaps[swap_index];
+    proposal.swap_index = swap_index;
+    proposal.loc_a = random_number_generator.random_int(
+        occ_location.cand_size(swap.cand_a) - 1);
+    proposal.loc_b = is_canonical
+                         ? random_number_generator.random_int(
+                               occ_location.cand_size(swap.cand_b) - 1)
+                         : 0;
+  }
+  m_next = 0;
+  ++m_n_blocks;
+}
+
+/// \brief True if an event changes the number of candidates of any type
+///
+/// Each site of the event removes a candidate of type `(asym,
+/// from_species)` and adds one of type `(asym, to_species)`. The counts are
+/// unchanged if the removed and added types are the same multiset.
+inline bool SwapProposalStream::_changes_candidate_counts(
+    monte::OccEvent const &e) const {
+  Index n = e.occ_transform.size();
+  if (n == 0) {
+    return false;
+  }
+  if (n == 2) {
+    auto const &t0 = e.occ_transform[0];
+    auto const &t1 = e.occ_transform[1];
+    return !(t0.asym == t1.asym && t0.from_species == t1.to_species &&
+             t1.from_species == t0.to_species);
+  }
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
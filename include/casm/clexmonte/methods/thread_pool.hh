@@ -0,0 +1,79 @@
+#ifndef CASM_clexmonte_methods_thread_pool
+#define CASM_clexmonte_methods_thread_pool
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Runs a function on a fixed set of threads
+///
+/// The calling thread is thread 0, and `n_threads - 1` worker threads wait
+/// between calls to `run`.
+class ThreadPool {
+ public:
+  explicit ThreadPool(Index _n_threads);
+
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  /// \brief Total number of threads, including the calling thread
+  Index n_threads() const { return m_threads.size() + 1; }
+
+  /// \brief Call `f(thread_index)` for each `thread_index` in
+  ///     `[0, n_threads())`, and wait for all calls to finish
+  void run(std::function<void(Index)> const &f);
+
+ private:
+  void _run_worker(Index thread_index);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  Index m_generation;
+  Index m_n_pending;
+  bool m_stop;
+  std::function<void(Index)> const *m_f;
+  std::exception_ptr m_exception;
+};
+
+/// \brief Call `f(begin, end, thread_index)` for contiguous, disjoint
+///     blocks `[begin, end)` covering `[0, n)`, one block per thread
+///
+/// The block boundaries only depend on `n` and `n_threads`, so results that
+/// are written by index are deterministic. If `n_threads == 1`, or `n` is
+/// small, `f` is called once on the calling thread, without creating
+/// threads.
+inline void parallel_for_blocks(
+    Index n, Index n_threads,
+    std::function<void(Index, Index, Index)> const &f) {
+  if (n_threads > n) {
+    n_threads = std::max(Index(1), n);
+  }
+  if (n_threads <= 1) {
+    f(0, n, 0);
+    return;
+  }
+  ThreadPool pool(n_threads);
+  pool.run([&](Index thread_index) {
+    Index begin = (n * thread_index) / n_threads;
+    Index end = (n * (thread_index + 1)) / n_threads;
+    f(begin, end, thread_index);
+  });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
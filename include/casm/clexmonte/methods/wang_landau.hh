@@ -0,0 +1,554 @@
+/// Wang-Landau flat-histogram estimation of the density of states, with the
+/// energy range decomposed into overlapping windows sampled on a pool of
+/// threads.
+
+#ifndef CASM_clexmonte_methods_wang_landau
+#define CASM_clexmonte_methods_wang_landau
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/methods/replica_exchange_metropolis.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "casm/global/definitions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Parameters of a Wang-Landau calculation
+///
+/// Energies are the potential energy, normalized per unit cell.
+struct WangLandauParams {
+  /// Lower bound of the energy range
+  double energy_min = 0.0;
+
+  /// Upper bound of the energy range
+  double energy_max = 0.0;
+
+  /// Width of the energy bins
+  double bin_width = 0.0;
+
+  /// Number of energy windows, each sampled by one walker
+  Index n_windows = 1;
+
+  /// Fraction of the bins of a window shared with the next window
+  double window_overlap = 0.5;
+
+  /// A histogram is flat when the smallest count of the visited bins of a
+  /// window is at least `flatness` times their mean count
+  double flatness = 0.8;
+
+  /// Initial value of the modification factor, `ln(f)`
+  double ln_f_initial = 1.0;
+
+  /// A window is converged when `ln(f)` is smaller than this
+  double ln_f_final = 1e-6;
+
+  /// If true, once `ln(f)` is smaller than `n_bins / t`, with `t` the
+  /// number of steps of a window and `n_bins` its number of bins, `ln(f)`
+  /// is set to `n_bins / t` from then on (Belardinelli and Pereyra), which
+  /// avoids the saturation of the error of the original method
+  bool one_over_t = true;
+
+  /// Number of passes between histogram flatness checks
+  Index check_period = 10;
+
+  /// If > 0, the maximum number of passes of each walker, including the
+  /// passes needed to reach its window
+  Index max_passes = 0;
+};
+
+/// \brief The density of states estimate of one energy window
+class WangLandauWindow {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _begin, _end The window includes bins `[_begin, _end)`
+  /// \param _ln_f The initial modification factor, `ln(f)`
+  WangLandauWindow(Index _begin, Index _end, double _ln_f)
+      : begin(_begin),
+        end(_end),
+        ln_f(_ln_f),
+        ln_g(_end - _begin, 0.0),
+        histogram(_end - _begin, 0),
+        visited(_end - _begin, 0) {}
+
+  /// First bin of the window
+  Index begin;
+
+  /// One past the last bin of the window
+  Index end;
+
+  /// Current modification factor
+  double ln_f;
+
+  /// Logarithm of the density of states, up to a constant, of each bin
+  std::vector<double> ln_g;
+
+  /// Visits of each bin since the last modification factor update
+  std::vector<Index> histogram;
+
+  /// Non-zero for bins visited at least once
+  std::vector<unsigned char> visited;
+
+  /// Number of steps in the window
+  Index n_steps = 0;
+
+  /// Number of passes, including the passes needed to reach the window
+  Index n_passes = 0;
+
+  /// True once `ln(f)` follows the `1/t` schedule
+  bool is_one_over_t = false;
+
+  /// \brief Number of bins of the window
+  Index size() const { return end - begin; }
+
+  /// \brief True if `bin` is in the window
+  bool contains(Index bin) const { return bin >= begin && bin < end; }
+
+  /// \brief Record a step at `bin`, which must be in the window
+  void update(Index bin) {
+    Index i = bin - begin;
+    ln_g[i] += ln_f;
+    ++histogram[i];
+    visited[i] = 1;
+    ++n_steps;
+  }
+
+  /// \brief True if the histogram of the visited bins is flat
+  bool is_flat(double flatness) const {
+    Index n_visited = 0;
+    double sum = 0.0;
+    Index min_count = std::numeric_limits<Index>::max();
+    for (Index i = 0; i < size(); ++i) {
+      if (visited[i]) {
+        ++n_visited;
+        sum += histogram[i];
+        min_count = std::min(min_count, histogram[i]);
+      }
+    }
+    return n_visited > 0 && min_count >= flatness * (sum / n_visited);
+  }
+
+  /// \brief Update the modification factor after a flatness check
+  void update_ln_f(WangLandauParams const &params) {
+    double ln_f_one_over_t = n_steps ? double(size()) / n_steps : ln_f;
+    if (is_one_over_t) {
+      ln_f = ln_f_one_over_t;
+    } else if (is_flat(params.flatness)) {
+      ln_f /= 2.0;
+      std::fill(histogram.begin(), histogram.end(), 0);
+      if (params.one_over_t && ln_f < ln_f_one_over_t) {
+        is_one_over_t = true;
+        ln_f = ln_f_one_over_t;
+      }
+    }
+  }
+};
+
+/// \brief Density of states from a Wang-Landau calculation
+///
+/// The windows are joined by shifting the `ln_g` of each window by the mean
+/// difference from the previous windows over the bins visited by both, and
+/// averaging in the overlap. The result is normalized so that the smallest
+/// `ln_g` of the visited bins is 0.
+struct WangLandauResults {
+  /// Lower bound of the energy range, normalized per unit cell
+  double energy_min = 0.0;
+
+  /// Width of the energy bins, normalized per unit cell
+  double bin_width = 0.0;
+
+  /// Number of unit cells in the supercell
+  Index n_unitcells = 0;
+
+  /// Logarithm of the density of states of each bin, up to a constant.
+  /// Valid only for visited bins.
+  std::vector<double> ln_g;
+
+  /// Non-zero for bins visited at least once
+  std::vector<unsigned char> visited;
+
+  /// The final estimates of each window
+  std::vector<WangLandauWindow> windows;
+
+  /// \brief The energy at the center of a bin, normalized per unit cell
+  double energy(Index bin) const {
+    return energy_min + (bin + 0.5) * bin_width;
+  }
+};
+
+/// \brief Split `n_bins` bins into `n_windows` overlapping windows
+///
+/// Windows have equal widths, and neighboring windows share about
+/// `overlap` times a window width of bins, and at least one bin.
+inline std::vector<std::pair<Index, Index>> make_wang_landau_windows(
+    Index n_bins, Index n_windows, double overlap) {
+  if (n_bins < 1 || n_windows < 1 || n_windows > n_bins) {
+    throw std::runtime_error(
+        "Error in make_wang_landau_windows: invalid number of bins or "
+        "windows");
+  }
+  if (overlap < 0.0 || overlap >= 1.0) {
+    throw std::runtime_error(
+        "Error in make_wang_landau_windows: overlap must be in [0, 1)");
+  }
+  double width = n_bins / (n_windows - (n_windows - 1) * overlap);
+  std::vector<std::pair<Index, Index>> windows;
+  for (Index k = 0; k < n_windows; ++k) {
+    Index begin = std::lround(k * width * (1.0 - overlap));
+    Index end = std::lround(k * width * (1.0 - overlap) + width);
+    if (k > 0) {
+      begin = std::min(begin, windows.back().second - 1);
+    }
+    end = (k == n_windows - 1) ? n_bins : std::min(std::max(end, begin + 1),
+                                                   n_bins);
+    windows.emplace_back(begin, end);
+  }
+  return windows;
+}
+
+/// \brief Join the windows of a Wang-Landau calculation
+///
+/// \param results Has `windows` set, and `ln_g` and `visited` are set by
+///     this function
+/// \param n_bins Total number of bins
+inline void join_wang_landau_windows(WangLandauResults &results,
+                                     Index n_bins) {
+  results.ln_g.assign(n_bins, 0.0);
+  results.visited.assign(n_bins, 0);
+  for (Index w = 0; w < results.windows.size(); ++w) {
+    WangLandauWindow const &window = results.windows[w];
+    double shift = 0.0;
+    if (w > 0) {
+      double sum = 0.0;
+      Index count = 0;
+      for (Index b = window.begin; b < window.end; ++b) {
+        if (results.visited[b] && window.visited[b - window.begin]) {
+          sum += results.ln_g[b] - window.ln_g[b - window.begin];
+          ++count;
+        }
+      }
+      if (count == 0) {
+        throw std::runtime_error(
+            "Error in join_wang_landau_windows: neighboring windows have no "
+            "visited bins in common; increase the window overlap");
+      }
+      shift = sum / count;
+    }
+    for (Index b = window.begin; b < window.end; ++b) {
+      Index i = b - window.begin;
+      if (!window.visited[i]) {
+        continue;
+      }
+      double value = window.ln_g[i] + shift;
+      if (results.visited[b]) {
+        results.ln_g[b] = 0.5 * (results.ln_g[b] + value);
+      } else {
+        results.ln_g[b] = value;
+        results.visited[b] = 1;
+      }
+    }
+  }
+
+  double min_ln_g = std::numeric_limits<double>::infinity();
+  for (Index b = 0; b < n_bins; ++b) {
+    if (results.visited[b]) {
+      min_ln_g = std::min(min_ln_g, results.ln_g[b]);
+    }
+  }
+  for (Index b = 0; b < n_bins; ++b) {
+    if (results.visited[b]) {
+      results.ln_g[b] -= min_ln_g;
+    }
+  }
+}
+
+/// \brief Estimate the density of states by Wang-Landau sampling, with one
+///     walker per energy window
+///
+/// The energy range is split into `params.n_windows` overlapping windows
+/// (see `make_wang_landau_windows`), and walker `i` samples window `i`.
+/// Walkers are distributed over `n_threads` threads. Each walker first
+/// moves to its window, accepting only events that do not move its energy
+/// further from the window. Then, events that leave the window are
+/// rejected, other events are accepted with probability
+/// `min(1, g(E_current) / g(E_trial))`, and after each step `ln(g)` of the
+/// current bin is increased by `ln(f)`. Every `params.check_period` passes
+/// the histogram of the window is checked for flatness, and if flat `ln(f)`
+/// is halved and the histogram is reset. A walker is done when `ln(f)` is
+/// smaller than `params.ln_f_final`, or after `params.max_passes` passes.
+/// The windows are then joined (see `join_wang_landau_windows`).
+///
+/// Notes:
+/// - The random number generator of each walker is an independent stream
+///   (see `make_stream_engine`) of one seed drawn from `engine`, so results
+///   are reproducible for a given seed, independent of the number of
+///   threads.
+/// - The energy of each walker is incremented by the change in potential of
+///   accepted events, and recalculated for the full supercell at each
+///   flatness check, to control round-off drift.
+/// - `set_current_walker_f(i)` is called on the thread that evolves walker
+///   `i`, before it does so.
+///
+/// \param occ_locations Occupant location trackers, one per walker, each
+///     already initialized with the walker's state.
+/// \param walkers The functions used to evolve each walker. The
+///     temperature of the walkers is not used.
+/// \param set_current_walker_f Called with the index of a walker before it
+///     is evolved.
+/// \param n_unitcells Number of unit cells in the supercell
+/// \param params Wang-Landau parameters
+/// \param n_threads Maximum number of threads to use.
+/// \param engine Random number engine, used to seed the walker streams
+/// \return The density of states
+template <typename EngineType>
+WangLandauResults wang_landau_metropolis(
+    std::vector<monte::OccLocation> const &occ_locations,
+    std::vector<MetropolisReplica<EngineType>> const &walkers,
+    std::function<void(Index)> const &set_current_walker_f, Index n_unitcells,
+    WangLandauParams const &params, Index n_threads, EngineType &engine) {
+  Index n_walkers = walkers.size();
+  if (n_walkers != params.n_windows || occ_locations.size() != n_walkers) {
+    throw std::runtime_error(
+        "Error in wang_landau_metropolis: the number of occ_locations and "
+        "walkers must equal the number of windows");
+  }
+  if (!(params.bin_width > 0.0) ||
+      !(params.energy_max > params.energy_min)) {
+    throw std::runtime_error(
+        "Error in wang_landau_metropolis: invalid energy range or bin width");
+  }
+  if (params.check_period < 1) {
+    throw std::runtime_error(
+        "Error in wang_landau_metropolis: check_period < 1");
+  }
+  Index n_bins = std::ceil((params.energy_max - params.energy_min) /
+                           params.bin_width);
+
+  WangLandauResults results;
+  results.energy_min = params.energy_min;
+  results.bin_width = params.bin_width;
+  results.n_unitcells = n_unitcells;
+  for (auto const &range : make_wang_landau_windows(
+           n_bins, params.n_windows, params.window_overlap)) {
+    results.windows.emplace_back(range.first, range.second,
+                                 params.ln_f_initial);
+  }
+
+  // Bin of a per_supercell energy, which may be outside [0, n_bins)
+  auto bin_of = [&](double energy) -> Index {
+    return std::floor((energy / n_unitcells - params.energy_min) /
+                      params.bin_width);
+  };
+
+  // Independent random number streams for each walker
+  std::uint64_t stream_seed = engine();
+  std::vector<monte::RandomNumberGenerator<EngineType>> generators;
+  for (Index i = 0; i < n_walkers; ++i) {
+    generators.emplace_back(make_stream_engine<EngineType>(stream_seed, i));
+  }
+
+  auto evolve = [&](Index i) {
+    set_current_walker_f(i);
+    auto &random_number_generator = generators[i];
+    auto const &walker = walkers[i];
+    WangLandauWindow &window = results.windows[i];
+    Index steps_per_pass = occ_locations[i].mol_size();
+    auto is_done = [&]() {
+      return params.max_passes > 0 && window.n_passes >= params.max_passes;
+    };
+
+    // Move to the window
+    auto distance = [&](Index bin) -> Index {
+      if (bin < window.begin) {
+        return window.begin - bin;
+      }
+      return bin < window.end ? 0 : bin - window.end + 1;
+    };
+    double energy = walker.potential_per_supercell_f();
+    Index current = bin_of(energy);
+    while (!window.contains(current) && !is_done()) {
+      for (Index step = 0; step < steps_per_pass; ++step) {
+        monte::OccEvent const &event =
+            walker.propose_event_f(random_number_generator);
+        double delta = walker.potential_occ_delta_per_supercell_f(event);
+        Index trial = bin_of(energy + delta);
+        if (distance(trial) <= distance(current)) {
+          walker.apply_event_f(event);
+          energy += delta;
+          current = trial;
+        }
+      }
+      ++window.n_passes;
+    }
+    if (!window.contains(current)) {
+      return;
+    }
+
+    // Flat-histogram sampling of the window
+    while (window.ln_f >= params.ln_f_final && !is_done()) {
+      for (Index pass = 0; pass < params.check_period; ++pass) {
+        for (Index step = 0; step < steps_per_pass; ++step) {
+          monte::OccEvent const &event =
+              walker.propose_event_f(random_number_generator);
+          double delta = walker.potential_occ_delta_per_supercell_f(event);
+          Index trial = bin_of(energy + delta);
+          if (window.contains(trial)) {
+            double ln_ratio = window.ln_g[current - window.begin] -
+                              window.ln_g[trial - window.begin];
+            if (ln_ratio >= 0.0 ||
+                random_number_generator.random_real(1.0) <
+                    std::exp(ln_ratio)) {
+              walker.apply_event_f(event);
+              energy += delta;
+              current = trial;
+            }
+          }
+          window.update(current);
+        }
+        ++window.n_passes;
+      }
+      energy = walker.potential_per_supercell_f();
+      window.update_ln_f(params);
+    }
+  };
+
+  ThreadPool pool(std::max(Index(1), std::min(n_threads, n_walkers)));
+  Index n_pool_threads = pool.n_threads();
+  pool.run([&](Index t) {
+    Index begin = (n_walkers * t) / n_pool_threads;
+    Index end = (n_walkers * (t + 1)) / n_pool_threads;
+    for (Index i = begin; i < end; ++i) {
+      evolve(i);
+    }
+  });
+
+  for (Index i = 0; i < n_walkers; ++i) {
+    if (results.windows[i].n_steps == 0) {
+      throw std::runtime_error(
+          "Error in wang_landau_metropolis: a walker did not reach its energy "
+          "window within max_passes");
+    }
+  }
+  join_wang_landau_windows(results, n_bins);
+  return results;
+}
+
+/// \brief Thermodynamic averages at one temperature, from a density of
+///     states
+struct WangLandauThermodynamics {
+  /// Temperature, in K
+  double temperature;
+
+  /// Mean potential energy, normalized per unit cell
+  double energy;
+
+  /// Heat capacity, normalized per unit cell,
+  /// `var(potential_energy_per_supercell)/(kB*T*T*n_unitcells)`
+  double heat_capacity;
+
+  /// Free energy, normalized per unit cell, up to a constant that does not
+  /// depend on temperature times `temperature`
+  double free_energy;
+};
+
+/// \brief Calculate thermodynamic averages at a temperature from a density
+///     of states
+///
+/// Bins that were not visited are excluded. Averages are accurate only if
+/// the energy range of the calculation includes the energies that
+/// contribute at `temperature`.
+inline WangLandauThermodynamics wang_landau_thermodynamics(
+    WangLandauResults const &results, double temperature) {
+  double beta = 1.0 / (CASM::KB * temperature);
+  double N = results.n_unitcells;
+  double max_ln_w = -std::numeric_limits<double>::infinity();
+  for (Index b = 0; b < results.ln_g.size(); ++b) {
+    if (results.visited[b]) {
+      max_ln_w = std::max(max_ln_w, results.ln_g[b] -
+                                        beta * N * results.energy(b));
+    }
+  }
+  double Z = 0.0;
+  double sum_E = 0.0;
+  double sum_E2 = 0.0;
+  for (Index b = 0; b < results.ln_g.size(); ++b) {
+    if (results.visited[b]) {
+      double E = N * results.energy(b);
+      double w = std::exp(results.ln_g[b] - beta * E - max_ln_w);
+      Z += w;
+      sum_E += w * E;
+      sum_E2 += w * E * E;
+    }
+  }
+  WangLandauThermodynamics thermo;
+  thermo.temperature = temperature;
+  double mean_E = sum_E / Z;
+  double var_E = sum_E2 / Z - mean_E * mean_E;
+  thermo.energy = mean_E / N;
+  thermo.heat_capacity = var_E / (CASM::KB * temperature * temperature * N);
+  thermo.free_energy = -(std::log(Z) + max_ln_w) / (beta * N);
+  return thermo;
+}
+
+/// \brief Write Wang-Landau results to JSON
+///
+/// Format:
+///   energy: array of number
+///     Energy at the center of each visited bin, normalized per unit cell.
+///   ln_g: array of number
+///     Logarithm of the density of states of each visited bin, up to a
+///     constant, with the smallest value 0.
+///   bin_width: number
+///     Width of the energy bins, normalized per unit cell.
+///   n_unitcells: int
+///     Number of unit cells in the supercell.
+///   windows: array of object
+///     For each window, "energy_min" and "energy_max" of its bins, the
+///     final "ln_f", and the number of "n_passes" and "n_steps".
+inline jsonParser &to_json(WangLandauResults const &results,
+                           jsonParser &json) {
+  json.put_obj();
+  std::vector<double> energy;
+  std::vector<double> ln_g;
+  for (Index b = 0; b < results.ln_g.size(); ++b) {
+    if (results.visited[b]) {
+      energy.push_back(results.energy(b));
+      ln_g.push_back(results.ln_g[b]);
+    }
+  }
+  json["energy"] = energy;
+  json["ln_g"] = ln_g;
+  json["bin_width"] = results.bin_width;
+  json["n_unitcells"] = results.n_unitcells;
+  json["windows"].put_array();
+  for (auto const &window : results.windows) {
+    jsonParser tjson;
+    tjson["energy_min"] =
+        results.energy_min + window.begin * results.bin_width;
+    tjson["energy_max"] = results.energy_min + window.end * results.bin_width;
+    tjson["ln_f"] = window.ln_f;
+    tjson["n_passes"] = window.n_passes;
+    tjson["n_steps"] = window.n_steps;
+    json["windows"].push_back(tjson);
+  }
+  return json;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
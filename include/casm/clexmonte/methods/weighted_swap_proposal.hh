@@ -0,0 +1,262 @@
+#ifndef CASM_clexmonte_methods_weighted_swap_proposal
+#define CASM_clexmonte_methods_weighted_swap_proposal
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEvent.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Proposes semi-grand canonical single site events with swap type
+///     weights adapted to the acceptance rate of each swap type
+///
+/// `monte::propose_semigrand_canonical_event` chooses a swap type with
+/// probability proportional to its number of candidates, so when some
+/// species are dilute, most proposals are flips of majority species that
+/// are rarely accepted. A WeightedSwapProposer instead chooses swap type
+/// `s`, and then a uniformly random candidate of type `s.cand_a`, with
+/// probability
+///
+///     P(s, candidate) = w_s / W,   W = sum_s' w_s' * N(s'.cand_a),
+///
+/// where `N(c)` is the number of candidates of type `c`. The reverse event
+/// uses the reverse swap type `r` from the new occupation, so `propose`
+/// returns the Hastings correction
+///
+///     log_proposal_ratio = log((w_r / W_new) / (w_s / W)),
+///
+/// which must be included in the acceptance probability, for instance by
+/// subtracting `log_proposal_ratio / beta` from the change in potential
+/// energy. Events without a reverse swap type have `log_proposal_ratio =
+/// -inf`, and are rejected.
+///
+/// Weights:
+/// - Proposals and acceptances (see `notify_accepted`) are counted per swap
+///   type. `update_weights` sets `w_s = max(min_weight, a_s / a_max)`, with
+///   `a_s = (n_accept_s + 1) / (n_propose_s + 2)`.
+/// - While adapting (see `begin_adaptation`), weights are updated after
+///   every `update_interval` proposals. Adaptation must be finite for the
+///   chain to converge to the correct distribution, so weights should only
+///   change during equilibration, and are fixed afterwards. Counts and
+///   weights are kept between runs.
+///
+/// Notes:
+/// - Events do not include atom trajectories, so the `monte::OccLocation`
+///   must not track atom positions.
+class WeightedSwapProposer {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _swaps Semi-grand canonical single site swaps
+  /// \param _min_weight Minimum weight of a swap type, relative to the
+  ///     largest, in `(0.0, 1.0]`
+  /// \param _update_interval Number of proposals between weight updates,
+  ///     while adapting
+  WeightedSwapProposer(std::vector<monte::OccSwap> const &_swaps,
+                       double _min_weight = 0.01,
+                       Index _update_interval = 10000)
+      : swaps(_swaps),
+        min_weight(_min_weight),
+        update_interval(_update_interval),
+        m_weight(swaps.size(), 1.0),
+        m_n_propose(swaps.size(), 0),
+        m_n_accept(swaps.size(), 0),
+        m_cumulative_weight(swaps.size()),
+        m_last_swap_index(-1),
+        m_n_adapt(0),
+        m_n_since_update(0) {
+    if (swaps.size() == 0) {
+      throw std::runtime_error(
+          "Error constructing WeightedSwapProposer: no swaps");
+    }
+    if (!(min_weight > 0.0 && min_weight <= 1.0)) {
+      throw std::runtime_error(
+          "Error constructing WeightedSwapProposer: min_weight must be in "
+          "(0.0, 1.0]");
+    }
+    if (update_interval < 1) {
+      throw std::runtime_error(
+          "Error constructing WeightedSwapProposer: update_interval < 1");
+    }
+    for (auto const &swap : swaps) {
+      if (swap.cand_a.asym != swap.cand_b.asym) {
+        throw std::runtime_error(
+            "Error constructing WeightedSwapProposer: semi-grand canonical "
+            "swaps must change the species on one site");
+      }
+    }
+    m_reverse.resize(swaps.size(), -1);
+    for (Index i = 0; i < Index(swaps.size()); ++i) {
+      for (Index j = 0; j < Index(swaps.size()); ++j) {
+        if (_same(swaps[j].cand_a, swaps[i].cand_b) &&
+            _same(swaps[j].cand_b, swaps[i].cand_a)) {
+          m_reverse[i] = j;
+          break;
+        }
+      }
+    }
+  }
+
+  /// \brief Swap types
+  std::vector<monte::OccSwap> const swaps;
+
+  /// \brief Minimum weight of a swap type, relative to the largest
+  double const min_weight;
+
+  /// \brief Number of proposals between weight updates, while adapting
+  Index const update_interval;
+
+  /// \brief Adapt weights during the next `n_proposals` proposals
+  void begin_adaptation(Index n_proposals) {
+    m_n_adapt = std::max(Index(0), n_proposals);
+    m_n_since_update = 0;
+  }
+
+  /// \brief Propose an event
+  template <typename GeneratorType>
+  monte::OccEvent &propose(monte::OccEvent &e, double &log_proposal_ratio,
+                           monte::OccLocation const &occ_location,
+                           GeneratorType &random_number_generator);
+
+  /// \brief Count the last proposed event as accepted
+  void notify_accepted() {
+    if (m_last_swap_index >= 0) {
+      ++m_n_accept[m_last_swap_index];
+      m_last_swap_index = -1;
+    }
+  }
+
+  /// \brief Set weights from the acceptance rate of each swap type
+  void update_weights() {
+    double a_max = 0.0;
+    for (Index i = 0; i < Index(swaps.size()); ++i) {
+      m_weight[i] = (m_n_accept[i] + 1.0) / (m_n_propose[i] + 2.0);
+      a_max = std::max(a_max, m_weight[i]);
+    }
+    for (double &w : m_weight) {
+      w = std::max(min_weight, w / a_max);
+    }
+    m_n_since_update = 0;
+  }
+
+  /// \brief Weight of each swap type
+  std::vector<double> const &weights() const { return m_weight; }
+
+  /// \brief Number of proposals of each swap type
+  std::vector<Index> const &n_propose() const { return m_n_propose; }
+
+  /// \brief Number of acceptances of each swap type
+  std::vector<Index> const &n_accept() const { return m_n_accept; }
+
+ private:
+  static bool _same(monte::OccCandidate const &a,
+                    monte::OccCandidate const &b) {
+    return a.asym == b.asym && a.species_index == b.species_index;
+  }
+
+  /// Sum of the weights of swap types from candidate type `cand`
+  double _out_weight(monte::OccCandidate const &cand) const {
+    double total = 0.0;
+    for (Index i = 0; i < Index(swaps.size()); ++i) {
+      if (_same(swaps[i].cand_a, cand)) {
+        total += m_weight[i];
+      }
+    }
+    return total;
+  }
+
+  std::vector<double> m_weight;
+  std::vector<Index> m_n_propose;
+  std::vector<Index> m_n_accept;
+  std::vector<Index> m_reverse;
+  std::vector<double> m_cumulative_weight;
+  Index m_last_swap_index;
+  Index m_n_adapt;
+  Index m_n_since_update;
+};
+
+/// \brief Propose an event
+///
+/// \param e Event to set, reusing its storage
+/// \param log_proposal_ratio Set to
+///     `log(P(propose reverse event) / P(propose event))`
+/// \param occ_location The occupant location tracker
+/// \param random_number_generator A random number generator, such as
+///     `monte::RandomNumberGenerator` or `BufferedRandomNumberGenerator`
+///
+/// \returns A reference to `e`
+template <typename GeneratorType>
+monte::OccEvent &WeightedSwapProposer::propose(
+    monte::OccEvent &e, double &log_proposal_ratio,
+    monte::OccLocation const &occ_location,
+    GeneratorType &random_number_generator) {
+  double total = 0.0;
+  for (Index i = 0; i < Index(swaps.size()); ++i) {
+    total += m_weight[i] * occ_location.cand_size(swaps[i].cand_a);
+    m_cumulative_weight[i] = total;
+  }
+  if (total == 0.0) {
+    throw std::runtime_error(
+        "Error in WeightedSwapProposer: no swaps are possible");
+  }
+  double r = random_number_generator.random_real(total);
+  Index swap_index = std::upper_bound(m_cumulative_weight.begin(),
+                                      m_cumulative_weight.end(), r) -
+                     m_cumulative_weight.begin();
+  swap_index = std::min(swap_index, Index(swaps.size()) - 1);
+  monte::OccSwap const &swap = swaps[swap_index];
+  Index loc = random_number_generator.random_int(
+      occ_location.cand_size(swap.cand_a) - 1);
+
+  // Hastings correction
+  Index reverse_index = m_reverse[swap_index];
+  if (reverse_index < 0) {
+    log_proposal_ratio = -std::numeric_limits<double>::infinity();
+  } else {
+    double total_new =
+        total - _out_weight(swap.cand_a) + _out_weight(swap.cand_b);
+    log_proposal_ratio = std::log(m_weight[reverse_index] / total_new) -
+                         std::log(m_weight[swap_index] / total);
+  }
+
+  Index mol_id = occ_location.mol_id(swap.cand_a, loc);
+  monte::Mol const &mol = occ_location.mol(mol_id);
+  monte::Conversions const &convert = occ_location.convert();
+  e.linear_site_index.resize(1);
+  e.new_occ.resize(1);
+  e.occ_transform.resize(1);
+  e.atom_traj.clear();
+  e.linear_site_index[0] = mol.l;
+  e.new_occ[0] =
+      convert.occ_index(swap.cand_b.asym, swap.cand_b.species_index);
+  monte::OccTransform &transform = e.occ_transform[0];
+  transform.l = mol.l;
+  transform.mol_id = mol_id;
+  transform.asym = swap.cand_a.asym;
+  transform.from_species = swap.cand_a.species_index;
+  transform.to_species = swap.cand_b.species_index;
+
+  ++m_n_propose[swap_index];
+  m_last_swap_index = swap_index;
+  if (m_n_adapt > 0) {
+    --m_n_adapt;
+    if (++m_n_since_update >= update_interval) {
+      update_weights();
+    }
+  }
+  return e;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef CASM_clexmonte_misc_BatchMeansStatistics
+#define CASM_clexmonte_misc_BatchMeansStatistics
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/BasicStatistics.hh"
+#include "casm/monte/sampling/RequestedPrecision.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return z such that a standard normal variable is in [-z, z] with
+///     probability `confidence`
+inline double normal_confidence_interval_z(double confidence) {
+  if (!(confidence > 0.0 && confidence < 1.0)) {
+    throw std::runtime_error(
+        "Error in normal_confidence_interval_z: confidence must be in (0, 1)");
+  }
+  // solve erf(x) = confidence by Newton's method, then z = sqrt(2) * x
+  double x = 1.0;
+  for (int i = 0; i < 100; ++i) {
+    double dx = (std::erf(x) - confidence) /
+                (2.0 / std::sqrt(M_PI) * std::exp(-x * x));
+    x -= dx;
+    if (std::abs(dx) < 1e-12) {
+      break;
+    }
+  }
+  return std::sqrt(2.0) * x;
+}
+
+/// \brief Streaming batch means accumulator of a scalar observation
+///
+/// Samples are added one at a time by `push`, in O(1) amortized time and
+/// O(max_batches) memory. Samples are grouped into consecutive batches of
+/// `batch_size` samples. When `max_batches` batches are complete, adjacent
+/// pairs are merged and the batch size is doubled, so the number of
+/// batches stays between `max_batches / 2` and `max_batches` once
+/// `max_batches / 2` samples have been added.
+///
+/// For correlated samples, the batch means become approximately
+/// independent once the batch size is large compared to the correlation
+/// length, so the precision of the mean can be estimated from the variance
+/// of the batch means without calculating the autocorrelation.
+class BatchMeansAccumulator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _max_batches Maximum number of complete batches, must be even
+  ///     and >= 4
+  explicit BatchMeansAccumulator(Index _max_batches = 64)
+      : m_max_batches(_max_batches),
+        m_batch_size(1),
+        m_n_batches(0),
+        m_batch_sum_wx(_max_batches, 0.0),
+        m_batch_sum_w(_max_batches, 0.0),
+        m_count(0),
+        m_current_count(0),
+        m_current_sum_wx(0.0),
+        m_current_sum_w(0.0) {
+    if (m_max_batches < 4 || m_max_batches % 2 != 0) {
+      throw std::runtime_error(
+          "Error constructing BatchMeansAccumulator: max_batches must be even "
+          "and >= 4");
+    }
+  }
+
+  /// \brief Add one sample, with optional weight
+  void push(double x, double w = 1.0) {
+    ++m_count;
+    ++m_current_count;
+    m_current_sum_wx += w * x;
+    m_current_sum_w += w;
+    if (m_current_count < m_batch_size) {
+      return;
+    }
+    m_batch_sum_wx[m_n_batches] = m_current_sum_wx;
+    m_batch_sum_w[m_n_batches] = m_current_sum_w;
+    ++m_n_batches;
+    m_current_count = 0;
+    m_current_sum_wx = 0.0;
+    m_current_sum_w = 0.0;
+    if (m_n_batches == m_max_batches) {
+      for (Index i = 0; i < m_max_batches / 2; ++i) {
+        m_batch_sum_wx[i] = m_batch_sum_wx[2 * i] + m_batch_sum_wx[2 * i + 1];
+        m_batch_sum_w[i] = m_batch_sum_w[2 * i] + m_batch_sum_w[2 * i + 1];
+      }
+      m_n_batches = m_max_batches / 2;
+      m_batch_size *= 2;
+    }
+  }
+
+  /// \brief Number of samples
+  Index count() const { return m_count; }
+
+  /// \brief Number of samples per complete batch
+  Index batch_size() const { return m_batch_size; }
+
+  /// \brief Number of complete batches
+  Index n_batches() const { return m_n_batches; }
+
+  /// \brief (Weighted) mean of all samples, or NaN if there are no samples
+  double mean() const {
+    double sum_wx = m_current_sum_wx;
+    double sum_w = m_current_sum_w;
+    for (Index i = 0; i < m_n_batches; ++i) {
+      sum_wx += m_batch_sum_wx[i];
+      sum_w += m_batch_sum_w[i];
+    }
+    if (m_count == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return sum_wx / sum_w;
+  }
+
+  /// \brief Half-width of the confidence interval of the mean, estimated
+  ///     from the complete batches, or infinity if there are fewer than 2
+  ///     complete batches
+  double calculated_precision(double confidence) const {
+    if (m_n_batches < 2) {
+      return std::numeric_limits<double>::infinity();
+    }
+    double mean_of_means = 0.0;
+    for (Index i = 0; i < m_n_batches; ++i) {
+      mean_of_means += m_batch_sum_wx[i] / m_batch_sum_w[i];
+    }
+    mean_of_means /= m_n_batches;
+    double var = 0.0;
+    for (Index i = 0; i < m_n_batches; ++i) {
+      double d = m_batch_sum_wx[i] / m_batch_sum_w[i] - mean_of_means;
+      var += d * d;
+    }
+    var /= (m_n_batches - 1);
+    return normal_confidence_interval_z(confidence) *
+           std::sqrt(var / m_n_batches);
+  }
+
+ private:
+  Index m_max_batches;
+  Index m_batch_size;
+  Index m_n_batches;
+
+  /// Sums of w*x and w for complete batches
+  std::vector<double> m_batch_sum_wx;
+  std::vector<double> m_batch_sum_w;
+
+  Index m_count;
+
+  /// Incomplete current batch
+  Index m_current_count;
+  double m_current_sum_wx;
+  double m_current_sum_w;
+};
+
+/// \brief Calculates statistics of sampled observations by batch means
+///
+/// An alternative to `monte::BasicStatisticsCalculator` for
+/// `CompletionCheckParams::calc_statistics_f`, which calculates the mean
+/// and precision in a single pass over the observations using a
+/// `BatchMeansAccumulator`, without calculating the autocorrelation or
+/// resampling weighted observations. Combined with log spaced completion
+/// checks (`CompletionCheckParams::log_spacing`), the total cost of
+/// checking convergence is O(1) amortized per sample.
+struct BatchMeansStatisticsCalculator {
+  /// \brief Constructor
+  ///
+  /// \param _confidence Confidence level of the calculated precision
+  /// \param _max_batches Maximum number of batches, must be even and >= 4
+  BatchMeansStatisticsCalculator(double _confidence = 0.95,
+                                 Index _max_batches = 64)
+      : confidence(_confidence), max_batches(_max_batches) {}
+
+  /// \brief Confidence level of the calculated precision
+  double confidence;
+
+  /// \brief Maximum number of batches
+  Index max_batches;
+
+  /// \brief Calculate statistics
+  ///
+  /// \param observations Observations, in sampling order
+  /// \param sample_weight Sample weights, or empty for equally weighted
+  ///     samples
+  /// \param requested_precision Unused
+  monte::BasicStatistics operator()(
+      Eigen::VectorXd const &observations,
+      Eigen::VectorXd const &sample_weight,
+      monte::RequestedPrecision requested_precision) const {
+    BatchMeansAccumulator accumulator(max_batches);
+    if (sample_weight.size() == 0) {
+      for (Index i = 0; i < observations.size(); ++i) {
+        accumulator.push(observations(i));
+      }
+    } else {
+      if (sample_weight.size() != observations.size()) {
+        throw std::runtime_error(
+            "Error in BatchMeansStatisticsCalculator: sample_weight size "
+            "does not match observations size");
+      }
+      for (Index i = 0; i < observations.size(); ++i) {
+        accumulator.push(observations(i), sample_weight(i));
+      }
+    }
+    monte::BasicStatistics stats;
+    stats.mean = accumulator.mean();
+    stats.calculated_precision = accumulator.calculated_precision(confidence);
+    return stats;
+  }
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
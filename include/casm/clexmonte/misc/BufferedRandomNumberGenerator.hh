@@ -0,0 +1,123 @@
+#ifndef CASM_clexmonte_misc_BufferedRandomNumberGenerator
+#define CASM_clexmonte_misc_BufferedRandomNumberGenerator
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Random number generator that draws uniform deviates in blocks
+///
+/// Provides the same `random_int` and `random_real` interface as
+/// `monte::RandomNumberGenerator`, so it can be used by the event proposal
+/// and acceptance functions, which are templated on the generator type.
+/// Rather than constructing a distribution for every call, a block of
+/// `buffer_size` uniform doubles in `[0, 1)` is generated at once. For
+/// engines with 64-bit output the block is filled in two simple loops, one
+/// drawing raw engine values and one converting them to doubles (using the
+/// upper 53 bits), which the compiler can vectorize.
+///
+/// Notes:
+/// - Values may differ from those of `monte::RandomNumberGenerator` for the
+///   same engine, but are reproducible given the engine state.
+/// - `random_int(max)` is `floor(u * (max + 1))`, which for `max + 1` much
+///   less than 2^53 is uniform to within a relative error of order
+///   `(max + 1) / 2^53`.
+/// - Values remaining in the buffer are discarded when the generator is
+///   destroyed, so the engine state then does not reflect the values used.
+template <typename EngineType>
+class BufferedRandomNumberGenerator {
+ public:
+  typedef EngineType engine_type;
+
+  /// \brief Constructor
+  ///
+  /// \param _engine The random number engine. If nullptr, a new engine is
+  ///     constructed and seeded from `std::random_device`.
+  /// \param _buffer_size Number of uniform deviates generated at once.
+  explicit BufferedRandomNumberGenerator(
+      std::shared_ptr<EngineType> _engine = std::shared_ptr<EngineType>(),
+      Index _buffer_size = 1024)
+      : engine(_engine), m_buffer(_buffer_size), m_raw(_buffer_size) {
+    if (_buffer_size < 1) {
+      throw std::runtime_error(
+          "Error constructing BufferedRandomNumberGenerator: buffer_size < 1");
+    }
+    if (!engine) {
+      engine = std::make_shared<EngineType>();
+      std::random_device device;
+      engine->seed(device());
+    }
+    m_index = m_buffer.size();
+  }
+
+  /// \brief Random number engine
+  std::shared_ptr<EngineType> engine;
+
+  /// \brief Return a uniformly distributed double in `[0, 1)`
+  double uniform() {
+    if (m_index == m_buffer.size()) {
+      _refill();
+    }
+    return m_buffer[m_index++];
+  }
+
+  /// \brief Return uniformly distributed integer in `[0, max]`
+  template <typename IntType>
+  IntType random_int(IntType max) {
+    IntType i = uniform() * (double(max) + 1.0);
+    return i > max ? max : i;
+  }
+
+  /// \brief Return uniformly distributed floating point value in `[0, max)`
+  template <typename RealType>
+  RealType random_real(RealType max) {
+    return uniform() * max;
+  }
+
+ private:
+  void _refill() {
+    typedef typename EngineType::result_type result_type;
+    std::size_t n = m_buffer.size();
+    if constexpr (std::is_same_v<result_type, std::uint64_t> &&
+                  EngineType::min() == 0 &&
+                  EngineType::max() ==
+                      std::numeric_limits<std::uint64_t>::max()) {
+      EngineType &e = *engine;
+      for (std::size_t i = 0; i < n; ++i) {
+        m_raw[i] = e();
+      }
+      double const scale = 1.0 / double(std::uint64_t(1) << 53);
+      for (std::size_t i = 0; i < n; ++i) {
+        m_buffer[i] = double(m_raw[i] >> 11) * scale;
+      }
+    } else {
+      std::uniform_real_distribution<double> distribution(0.0, 1.0);
+      for (std::size_t i = 0; i < n; ++i) {
+        m_buffer[i] = distribution(*engine);
+      }
+    }
+    m_index = 0;
+  }
+
+  /// Uniform deviates, `m_buffer[m_index]` is the next one used
+  std::vector<double> m_buffer;
+
+  /// Raw engine values, used while refilling
+  std::vector<std::uint64_t> m_raw;
+
+  std::size_t m_index;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
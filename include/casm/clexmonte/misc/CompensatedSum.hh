@@ -0,0 +1,81 @@
+#ifndef CASM_clexmonte_misc_CompensatedSum
+#define CASM_clexmonte_misc_CompensatedSum
+
+#include <cmath>
+#include <limits>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Running sum with compensation (Neumaier) and a bound on its
+///     accumulated round-off error
+///
+/// Running totals that are updated incrementally, `sum += new - old`,
+/// accumulate round-off error, which is large relative to the total when
+/// the terms span many orders of magnitude or mostly cancel. A
+/// CompensatedSum keeps the exact round-off of each addition in a separate
+/// compensation term, so `value()` is accurate to a few ulps of the true
+/// sum until the compensation term itself loses precision.
+///
+/// `error_bound()` is a rigorous bound on the error of `value()`, excluding
+/// the final rounding, accumulated since construction or the last `reset`.
+/// It grows by `eps/2 * |compensation|` per addition, which is usually
+/// negligible, so owners can re-sum a total from its terms only when
+/// `needs_refresh` is true, instead of periodically.
+class CompensatedSum {
+ public:
+  /// \brief Default relative tolerance used by `needs_refresh`
+  static constexpr double default_relative_tolerance = 1e-12;
+
+  /// \brief Constructor
+  explicit CompensatedSum(double _value = 0.0) { reset(_value); }
+
+  /// \brief Add a term
+  void add(double x) {
+    double t = m_sum + x;
+    // exact round-off of `m_sum + x` (Fast2Sum, larger magnitude first)
+    if (std::abs(m_sum) >= std::abs(x)) {
+      m_compensation += (m_sum - t) + x;
+    } else {
+      m_compensation += (x - t) + m_sum;
+    }
+    m_sum = t;
+    m_error_bound += unit_roundoff * std::abs(m_compensation);
+  }
+
+  /// \brief Current value of the sum
+  double value() const { return m_sum + m_compensation; }
+
+  /// \brief Bound on the accumulated round-off error of `value()`
+  double error_bound() const { return m_error_bound; }
+
+  /// \brief True if the error bound exceeds `relative_tolerance * |value()|`
+  ///
+  /// If the value is exactly 0.0, this is true if any error may have
+  /// accumulated.
+  bool needs_refresh(
+      double relative_tolerance = default_relative_tolerance) const {
+    return m_error_bound > relative_tolerance * std::abs(value());
+  }
+
+  /// \brief Set the value, for example to a sum re-calculated from its
+  ///     terms, and clear the error bound
+  void reset(double _value = 0.0) {
+    m_sum = _value;
+    m_compensation = 0.0;
+    m_error_bound = 0.0;
+  }
+
+ private:
+  static constexpr double unit_roundoff =
+      std::numeric_limits<double>::epsilon() / 2.0;
+
+  double m_sum;
+  double m_compensation;
+  double m_error_bound;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef CASM_clexmonte_misc_ContentHash
+#define CASM_clexmonte_misc_ContentHash
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief 128-bit FNV-1a style hash, as two 64-bit FNV-1a hashes with
+///     different offsets
+///
+/// Used to make content-addressed keys. Not cryptographic.
+class ContentHash {
+ public:
+  /// \brief Add a length-prefixed string
+  void update(std::string const &data) {
+    std::uint64_t size = data.size();
+    update(reinterpret_cast<char const *>(&size), sizeof(size));
+    update(data.data(), data.size());
+  }
+
+  /// \brief Add raw bytes
+  void update(char const *data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      for (auto &h : m_h) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 0x100000001b3ULL;
+      }
+    }
+  }
+
+  /// \brief Add the bytes of an integer value
+  void update_value(std::int64_t value) {
+    update(reinterpret_cast<char const *>(&value), sizeof(value));
+  }
+
+  /// \brief Hash, as 32 hexadecimal digits
+  std::string hex() const {
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << m_h[0]
+       << std::setw(16) << m_h[1];
+    return ss.str();
+  }
+
+ private:
+  std::uint64_t m_h[2] = {0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL};
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef CASM_clexmonte_misc_CovarianceAccumulator
+#define CASM_clexmonte_misc_CovarianceAccumulator
+
+#include <limits>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Streaming (Welford) accumulator of the means and covariance of
+///     two vector observations
+///
+/// Observations are added one sample at a time by `push`, in O(m * n) time
+/// and without storing past samples, where `m` and `n` are the sizes of the
+/// two observations. Accumulators of disjoint sets of samples can be
+/// combined with `merge`. The covariance is the population covariance,
+/// `cov(x_i, y_j) = (1/N) * sum_k (x_ik - mean(x_i)) * (y_jk - mean(y_j))`,
+/// as calculated by `monte::covariance`.
+class CovarianceAccumulator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param m Size of the first observation
+  /// \param n Size of the second observation
+  CovarianceAccumulator(Index m, Index n)
+      : m_count(0),
+        m_mean_x(Eigen::VectorXd::Zero(m)),
+        m_mean_y(Eigen::VectorXd::Zero(n)),
+        m_comoment(Eigen::MatrixXd::Zero(m, n)),
+        m_dx(m) {}
+
+  /// \brief Add one sample
+  template <typename XType, typename YType>
+  void push(XType const &x, YType const &y) {
+    ++m_count;
+    m_dx = x - m_mean_x;
+    m_mean_x += m_dx / m_count;
+    m_mean_y += (y - m_mean_y) / m_count;
+    // uses the updated mean of y, so the co-moment update is exact
+    m_comoment.noalias() += m_dx * (y - m_mean_y).transpose();
+  }
+
+  /// \brief Combine with an accumulator of a disjoint set of samples
+  void merge(CovarianceAccumulator const &other) {
+    if (other.m_count == 0) {
+      return;
+    }
+    double n_a = m_count;
+    double n_b = other.m_count;
+    double n = n_a + n_b;
+    Eigen::VectorXd dx = other.m_mean_x - m_mean_x;
+    Eigen::VectorXd dy = other.m_mean_y - m_mean_y;
+    m_comoment += other.m_comoment + dx * dy.transpose() * (n_a * n_b / n);
+    m_mean_x += dx * (n_b / n);
+    m_mean_y += dy * (n_b / n);
+    m_count += other.m_count;
+  }
+
+  /// \brief Number of samples
+  Index count() const { return m_count; }
+
+  /// \brief Mean of the first observation
+  Eigen::VectorXd const &mean_x() const { return m_mean_x; }
+
+  /// \brief Mean of the second observation
+  Eigen::VectorXd const &mean_y() const { return m_mean_y; }
+
+  /// \brief Population covariance matrix, of size `m x n`, or NaN if there
+  ///     are no samples
+  Eigen::MatrixXd covariance() const {
+    if (m_count == 0) {
+      return Eigen::MatrixXd::Constant(
+          m_comoment.rows(), m_comoment.cols(),
+          std::numeric_limits<double>::quiet_NaN());
+    }
+    return m_comoment / double(m_count);
+  }
+
+ private:
+  Index m_count;
+  Eigen::VectorXd m_mean_x;
+  Eigen::VectorXd m_mean_y;
+
+  /// Sum of products of deviations from the means
+  Eigen::MatrixXd m_comoment;
+
+  /// Scratch space
+  Eigen::VectorXd m_dx;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef CASM_clexmonte_misc_HistogramAccumulator
+#define CASM_clexmonte_misc_HistogramAccumulator
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Streaming histogram of a scalar observation
+///
+/// Observations are added one sample at a time by `push`, in O(1) time,
+/// without storing past samples, so memory is O(n_bins) rather than
+/// O(n_samples). Two binning modes are supported:
+///
+/// - Fixed: `n_bins` bins of equal width span `[min, max)`. Values outside
+///   the range are counted by `n_underflow` and `n_overflow`.
+/// - Adaptive: bins of width `bin_width` are aligned to multiples of the
+///   width, and the range grows to include every value. If more than
+///   `max_bins` bins would be needed, adjacent pairs of bins are merged,
+///   doubling the width, so no values are lost.
+///
+/// Histograms with the same binning can be combined with `merge`.
+class HistogramAccumulator {
+ public:
+  /// \brief Construct a histogram with fixed bins
+  ///
+  /// \param _min Lower edge of the first bin
+  /// \param _max Upper edge of the last bin
+  /// \param _n_bins Number of bins
+  HistogramAccumulator(double _min, double _max, Index _n_bins)
+      : m_is_adaptive(false),
+        m_bin_width((_max - _min) / _n_bins),
+        m_initial_bin_width(m_bin_width),
+        m_max_bins(_n_bins),
+        m_first_bin(0),
+        m_min(_min),
+        m_counts(_n_bins, 0),
+        m_n_underflow(0),
+        m_n_overflow(0),
+        m_count(0) {
+    if (_n_bins < 1) {
+      throw std::runtime_error(
+          "Error constructing HistogramAccumulator: n_bins < 1");
+    }
+    if (!(_max > _min)) {
+      throw std::runtime_error(
+          "Error constructing HistogramAccumulator: max <= min");
+    }
+  }
+
+  /// \brief Construct a histogram with adaptive bins
+  ///
+  /// \param _bin_width Initial bin width
+  /// \param _max_bins Maximum number of bins before the bin width is
+  ///     doubled
+  static HistogramAccumulator adaptive(double _bin_width, Index _max_bins) {
+    if (!(_bin_width > 0.0)) {
+      throw std::runtime_error(
+          "Error constructing HistogramAccumulator: bin_width <= 0");
+    }
+    if (_max_bins < 2) {
+      throw std::runtime_error(
+          "Error constructing HistogramAccumulator: max_bins < 2");
+    }
+    HistogramAccumulator result(0.0, _bin_width, 1);
+    result.m_is_adaptive = true;
+    result.m_initial_bin_width = _bin_width;
+    result.m_max_bins = _max_bins;
+    result.m_counts.clear();
+    return result;
+  }
+
+  /// \brief Add one sample
+  void push(double x) {
+    ++m_count;
+    if (!m_is_adaptive) {
+      double i = std::floor((x - m_min) / m_bin_width);
+      if (i < 0.0) {
+        ++m_n_underflow;
+      } else if (i >= double(m_counts.size())) {
+        ++m_n_overflow;
+      } else {
+        ++m_counts[Index(i)];
+      }
+      return;
+    }
+    Index i = Index(std::floor(x / m_bin_width));
+    if (m_counts.empty()) {
+      m_first_bin = i;
+      m_counts.push_back(0);
+    }
+    while (std::max(i, m_first_bin + Index(m_counts.size()) - 1) -
+               std::min(i, m_first_bin) + 1 >
+           m_max_bins) {
+      _double_bin_width();
+      i = Index(std::floor(x / m_bin_width));
+    }
+    if (i < m_first_bin) {
+      m_counts.insert(m_counts.begin(), m_first_bin - i, 0);
+      m_first_bin = i;
+    } else if (i >= m_first_bin + Index(m_counts.size())) {
+      m_counts.resize(i - m_first_bin + 1, 0);
+    }
+    ++m_counts[i - m_first_bin];
+  }
+
+  /// \brief Combine with a histogram of a disjoint set of samples
+  ///
+  /// Fixed histograms must have the same bins. Adaptive histograms must
+  /// have the same `max_bins` and initial bin width; the result uses the
+  /// larger of the two bin widths.
+  void merge(HistogramAccumulator const &other) {
+    if (m_is_adaptive != other.m_is_adaptive ||
+        m_max_bins != other.m_max_bins ||
+        m_initial_bin_width != other.m_initial_bin_width ||
+        (!m_is_adaptive && m_min != other.m_min)) {
+      throw std::runtime_error(
+          "Error in HistogramAccumulator::merge: incompatible bins");
+    }
+    m_count += other.m_count;
+    m_n_underflow += other.m_n_underflow;
+    m_n_overflow += other.m_n_overflow;
+    if (!m_is_adaptive) {
+      for (Index i = 0; i < Index(m_counts.size()); ++i) {
+        m_counts[i] += other.m_counts[i];
+      }
+      return;
+    }
+    HistogramAccumulator rhs = other;
+    while (m_bin_width < rhs.m_bin_width) {
+      _double_bin_width();
+    }
+    while (rhs.m_bin_width < m_bin_width) {
+      rhs._double_bin_width();
+    }
+    for (Index j = 0; j < Index(rhs.m_counts.size()); ++j) {
+      if (!rhs.m_counts[j]) {
+        continue;
+      }
+      // add each occupied bin, as a value at its center
+      double center = (rhs.m_first_bin + j + 0.5) * rhs.m_bin_width;
+      Index n = rhs.m_counts[j];
+      --m_count;
+      push(center);
+      m_counts[Index(std::floor(center / m_bin_width)) - m_first_bin] +=
+          n - 1;
+    }
+  }
+
+  /// \brief True if bins are adaptive
+  bool is_adaptive() const { return m_is_adaptive; }
+
+  /// \brief Current bin width
+  double bin_width() const { return m_bin_width; }
+
+  /// \brief Maximum number of bins (equal to the number of bins if fixed)
+  Index max_bins() const { return m_max_bins; }
+
+  /// \brief Number of samples, including underflow and overflow
+  Index count() const { return m_count; }
+
+  /// \brief Number of samples below the first bin (fixed bins only)
+  Index n_underflow() const { return m_n_underflow; }
+
+  /// \brief Number of samples at or above the last bin (fixed bins only)
+  Index n_overflow() const { return m_n_overflow; }
+
+  /// \brief Number of samples in each bin
+  std::vector<Index> const &counts() const { return m_counts; }
+
+  /// \brief Bin edges, of size `counts().size() + 1`
+  Eigen::VectorXd bin_edges() const {
+    Eigen::VectorXd edges(m_counts.size() + 1);
+    for (Index i = 0; i < edges.size(); ++i) {
+      edges(i) = m_is_adaptive ? (m_first_bin + i) * m_bin_width
+                               : m_min + i * m_bin_width;
+    }
+    return edges;
+  }
+
+  /// \brief Remove all samples, keeping the current bin width
+  void reset() {
+    if (m_is_adaptive) {
+      m_counts.clear();
+    } else {
+      std::fill(m_counts.begin(), m_counts.end(), 0);
+    }
+    m_n_underflow = 0;
+    m_n_overflow = 0;
+    m_count = 0;
+  }
+
+ private:
+  /// Merge adjacent pairs of adaptive bins, keeping bins aligned to
+  /// multiples of the bin width
+  void _double_bin_width() {
+    m_bin_width *= 2.0;
+    if (m_counts.empty()) {
+      return;
+    }
+    Index new_first_bin = Index(std::floor(m_first_bin / 2.0));
+    Index new_last_bin =
+        Index(std::floor((m_first_bin + Index(m_counts.size()) - 1) / 2.0));
+    std::vector<Index> new_counts(new_last_bin - new_first_bin + 1, 0);
+    for (Index j = 0; j < Index(m_counts.size()); ++j) {
+      Index k = Index(std::floor((m_first_bin + j) / 2.0));
+      new_counts[k - new_first_bin] += m_counts[j];
+    }
+    m_first_bin = new_first_bin;
+    m_counts = std::move(new_counts);
+  }
+
+  bool m_is_adaptive;
+  double m_bin_width;
+  double m_initial_bin_width;
+  Index m_max_bins;
+
+  /// Index of the first adaptive bin, which spans
+  /// `[m_first_bin * m_bin_width, (m_first_bin + 1) * m_bin_width)`
+  Index m_first_bin;
+
+  /// Lower edge of the first fixed bin
+  double m_min;
+
+  std::vector<Index> m_counts;
+  Index m_n_underflow;
+  Index m_n_overflow;
+  Index m_count;
+};
+
+/// \brief Write HistogramAccumulator to JSON
+///
+/// Format: an object with "bin_edges", "counts", "count", and, for fixed
+/// bins, "n_underflow" and "n_overflow".
+inline jsonParser &to_json(HistogramAccumulator const &histogram,
+                           jsonParser &json) {
+  json.put_obj();
+  to_json(histogram.bin_edges(), json["bin_edges"], jsonParser::as_array());
+  json["counts"] = histogram.counts();
+  json["count"] = histogram.count();
+  if (!histogram.is_adaptive()) {
+    json["n_underflow"] = histogram.n_underflow();
+    json["n_overflow"] = histogram.n_overflow();
+  }
+  return json;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
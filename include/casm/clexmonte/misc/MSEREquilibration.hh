@@ -0,0 +1,292 @@
+#ifndef CASM_clexmonte_misc_MSEREquilibration
+#define CASM_clexmonte_misc_MSEREquilibration
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/clexmonte/misc/BatchMeansStatistics.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/checks/EquilibrationCheck.hh"
+#include "casm/monte/sampling/RequestedPrecision.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Result of the MSER truncation rule
+struct MSERTruncation {
+  /// \brief True if the truncation point is in the first half of the
+  ///     blocks, so that the samples after it are considered equilibrated
+  bool is_equilibrated = false;
+
+  /// \brief Number of blocks before the truncation point
+  Index n_truncated_blocks = 0;
+
+  /// \brief Value of the MSER statistic at the truncation point
+  double statistic = std::numeric_limits<double>::infinity();
+};
+
+/// \brief Apply the MSER (marginal standard error rule) truncation rule to
+///     block means
+///
+/// For each candidate number of truncated blocks `d`, the MSER statistic is
+/// the sum of squared deviations of the remaining block means from their
+/// mean, divided by `(n - d)^2`. The truncation point minimizes it. As
+/// usual, only truncation points in the first half are accepted, since a
+/// minimum in the second half indicates the run is too short to detect
+/// equilibration. Runs in O(n) time using suffix sums.
+///
+/// \param block_means Block means, in sampling order
+/// \param min_blocks Minimum number of blocks to attempt detection
+inline MSERTruncation mser_truncation(std::vector<double> const &block_means,
+                                      Index min_blocks = 4) {
+  MSERTruncation result;
+  Index n = block_means.size();
+  if (n < min_blocks || n < 2) {
+    return result;
+  }
+  double suffix_sum = 0.0;
+  double suffix_sum_sq = 0.0;
+  for (Index d = n - 1; d >= 0; --d) {
+    suffix_sum += block_means[d];
+    suffix_sum_sq += block_means[d] * block_means[d];
+    Index m = n - d;
+    if (m < 2) {
+      continue;
+    }
+    double ss = std::max(0.0, suffix_sum_sq - suffix_sum * suffix_sum / m);
+    double statistic = ss / (double(m) * double(m));
+    if (statistic <= result.statistic) {
+      result.statistic = statistic;
+      result.n_truncated_blocks = d;
+    }
+  }
+  result.is_equilibrated = (2 * result.n_truncated_blocks < n);
+  return result;
+}
+
+/// \brief Equilibration check by the MSER-m rule
+///
+/// An alternative to `monte::default_equilibration_check` for
+/// `CompletionCheckParams::equilibration_check_f`. Observations are grouped
+/// into blocks of `block_size` samples (MSER-5 by default), and the
+/// truncation point is found by `mser_truncation` in a single pass.
+struct MSEREquilibrationCheck {
+  /// \brief Constructor
+  ///
+  /// \param _block_size Number of samples per block
+  /// \param _min_blocks Minimum number of blocks to attempt detection
+  MSEREquilibrationCheck(Index _block_size = 5, Index _min_blocks = 4)
+      : block_size(_block_size), min_blocks(_min_blocks) {
+    if (block_size < 1) {
+      throw std::runtime_error(
+          "Error constructing MSEREquilibrationCheck: block_size < 1");
+    }
+  }
+
+  /// \brief Number of samples per block
+  Index block_size;
+
+  /// \brief Minimum number of blocks to attempt detection
+  Index min_blocks;
+
+  /// \brief Check equilibration
+  ///
+  /// \param observations Observations, in sampling order
+  /// \param sample_weight Sample weights, or empty for equally weighted
+  ///     samples. Block means are weighted means.
+  /// \param requested_precision Unused
+  monte::IndividualEquilibrationCheckResult operator()(
+      Eigen::VectorXd const &observations,
+      Eigen::VectorXd const &sample_weight,
+      monte::RequestedPrecision requested_precision) const {
+    bool is_weighted = (sample_weight.size() != 0);
+    if (is_weighted && sample_weight.size() != observations.size()) {
+      throw std::runtime_error(
+          "Error in MSEREquilibrationCheck: sample_weight size does not "
+          "match observations size");
+    }
+    Index n_blocks = observations.size() / block_size;
+    std::vector<double> block_means(n_blocks);
+    for (Index i = 0; i < n_blocks; ++i) {
+      auto x = observations.segment(i * block_size, block_size);
+      if (is_weighted) {
+        auto w = sample_weight.segment(i * block_size, block_size);
+        block_means[i] = x.dot(w) / w.sum();
+      } else {
+        block_means[i] = x.mean();
+      }
+    }
+    MSERTruncation truncation = mser_truncation(block_means, min_blocks);
+
+    monte::IndividualEquilibrationCheckResult result;
+    result.is_equilibrated = truncation.is_equilibrated;
+    if (truncation.is_equilibrated) {
+      result.N_samples_for_equilibration =
+          truncation.n_truncated_blocks * block_size;
+    }
+    return result;
+  }
+};
+
+/// \brief Streaming equilibration detection by the MSER rule, with
+///     production statistics from the detected equilibration point
+///
+/// Samples are added one at a time by `push`. Until equilibration is
+/// detected, samples are kept only as block means, and when `max_blocks`
+/// blocks are kept adjacent pairs are merged and the block size doubled, so
+/// memory is O(max_blocks) regardless of the run length. Every
+/// `check_period` completed blocks, `mser_truncation` is applied to the kept
+/// blocks. Once it accepts a truncation point, the blocks before it are
+/// discarded, the remaining blocks seed a `BatchMeansAccumulator` of
+/// production samples, and every later block is added to it directly.
+///
+/// So burn-in samples are dropped as soon as they are identified, and the
+/// production mean and precision are available at any time in O(1) memory.
+/// The equilibration point is not revised after it is detected.
+class StreamingMSEREquilibration {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _block_size Initial number of samples per block
+  /// \param _max_blocks Maximum number of kept burn-in blocks, must be even
+  ///     and >= 4
+  /// \param _min_blocks Minimum number of blocks to attempt detection
+  /// \param _check_period Number of completed blocks between detection
+  ///     attempts
+  StreamingMSEREquilibration(Index _block_size = 5, Index _max_blocks = 256,
+                             Index _min_blocks = 8, Index _check_period = 1)
+      : m_block_size(_block_size),
+        m_max_blocks(_max_blocks),
+        m_min_blocks(_min_blocks),
+        m_check_period(_check_period),
+        m_production(64) {
+    if (m_block_size < 1) {
+      throw std::runtime_error(
+          "Error constructing StreamingMSEREquilibration: block_size < 1");
+    }
+    if (m_max_blocks < 4 || m_max_blocks % 2 != 0) {
+      throw std::runtime_error(
+          "Error constructing StreamingMSEREquilibration: max_blocks must be "
+          "even and >= 4");
+    }
+    if (m_check_period < 1) {
+      throw std::runtime_error(
+          "Error constructing StreamingMSEREquilibration: check_period < 1");
+    }
+  }
+
+  /// \brief Add one sample, with optional weight
+  void push(double x, double w = 1.0) {
+    ++m_count;
+    ++m_current_count;
+    m_current_sum_wx += w * x;
+    m_current_sum_w += w;
+    if (m_current_count < m_block_size) {
+      return;
+    }
+    double block_mean = m_current_sum_wx / m_current_sum_w;
+    double block_w = m_current_sum_w;
+    m_current_count = 0;
+    m_current_sum_wx = 0.0;
+    m_current_sum_w = 0.0;
+
+    if (m_is_equilibrated) {
+      m_production.push(block_mean, block_w);
+      return;
+    }
+    m_block_means.push_back(block_mean);
+    m_block_w.push_back(block_w);
+    if (Index(m_block_means.size()) == m_max_blocks) {
+      _merge_blocks();
+    }
+    if (++m_blocks_since_check >= m_check_period) {
+      m_blocks_since_check = 0;
+      _check();
+    }
+  }
+
+  /// \brief Number of samples added
+  Index count() const { return m_count; }
+
+  /// \brief True if equilibration has been detected
+  bool is_equilibrated() const { return m_is_equilibrated; }
+
+  /// \brief Number of samples before the detected equilibration point, or
+  ///     the number of samples added if not yet equilibrated
+  Index n_burn_in_samples() const {
+    return m_is_equilibrated ? m_n_burn_in_samples : m_count;
+  }
+
+  /// \brief Number of burn-in blocks kept while detecting equilibration
+  Index n_kept_blocks() const { return m_block_means.size(); }
+
+  /// \brief Current number of samples per block
+  Index block_size() const { return m_block_size; }
+
+  /// \brief Production samples accumulator
+  ///
+  /// Each pushed value is the (weighted) mean of one complete block of
+  /// production samples. Samples in an incomplete block are not included.
+  BatchMeansAccumulator const &production() const { return m_production; }
+
+ private:
+  /// Merge adjacent pairs of kept blocks, doubling the block size
+  void _merge_blocks() {
+    Index n = m_block_means.size() / 2;
+    for (Index i = 0; i < n; ++i) {
+      double w = m_block_w[2 * i] + m_block_w[2 * i + 1];
+      m_block_means[i] = (m_block_w[2 * i] * m_block_means[2 * i] +
+                          m_block_w[2 * i + 1] * m_block_means[2 * i + 1]) /
+                         w;
+      m_block_w[i] = w;
+    }
+    m_block_means.resize(n);
+    m_block_w.resize(n);
+    m_block_size *= 2;
+  }
+
+  /// Attempt detection, and if accepted discard the burn-in blocks
+  void _check() {
+    MSERTruncation truncation = mser_truncation(m_block_means, m_min_blocks);
+    if (!truncation.is_equilibrated) {
+      return;
+    }
+    Index d = truncation.n_truncated_blocks;
+    m_is_equilibrated = true;
+    m_n_burn_in_samples = m_count - (m_block_means.size() - d) * m_block_size;
+    for (Index i = d; i < Index(m_block_means.size()); ++i) {
+      m_production.push(m_block_means[i], m_block_w[i]);
+    }
+    std::vector<double>().swap(m_block_means);
+    std::vector<double>().swap(m_block_w);
+  }
+
+  Index m_block_size;
+  Index m_max_blocks;
+  Index m_min_blocks;
+  Index m_check_period;
+
+  Index m_count = 0;
+  bool m_is_equilibrated = false;
+  Index m_n_burn_in_samples = 0;
+  Index m_blocks_since_check = 0;
+
+  /// Kept burn-in block means and weights, before equilibration
+  std::vector<double> m_block_means;
+  std::vector<double> m_block_w;
+
+  /// Incomplete current block
+  Index m_current_count = 0;
+  double m_current_sum_wx = 0.0;
+  double m_current_sum_w = 0.0;
+
+  BatchMeansAccumulator m_production;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef CASM_clexmonte_misc_MortonOrder
+#define CASM_clexmonte_misc_MortonOrder
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Spread the lower 21 bits of `x` so that there are two zero bits
+///     between each
+inline std::uint64_t morton_spread_bits(std::uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | (x << 32)) & 0x1f00000000ffff;
+  x = (x | (x << 16)) & 0x1f0000ff0000ff;
+  x = (x | (x << 8)) & 0x100f00f00f00f00f;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+  x = (x | (x << 2)) & 0x1249249249249249;
+  return x;
+}
+
+/// \brief Morton (Z-order) code of non-negative 3d integer coordinates
+///
+/// Interleaves the bits of `i`, `j`, and `k`, which must be in
+/// `[0, 2^21)`, so that points close in space tend to have close codes.
+inline std::uint64_t morton_code(std::uint64_t i, std::uint64_t j,
+                                 std::uint64_t k) {
+  return morton_spread_bits(i) | (morton_spread_bits(j) << 1) |
+         (morton_spread_bits(k) << 2);
+}
+
+/// \brief Sort unit cell indices in Morton (Z-order) of their unit cell
+///     coordinates
+///
+/// Linear unit cell and site indices are fixed by the supercell index
+/// conversions, which order unit cells so that neighbors along the last
+/// lattice vector can be far apart in memory. Visiting unit cells in Morton
+/// order instead keeps consecutive unit cells, and the sites and neighbor
+/// list entries they access, close together in all three directions.
+///
+/// \param unitcell_index Unit cell indices to sort, in place
+/// \param unitcell_converter Converts unit cell indices to unit cell
+///     coordinates
+inline void sort_by_morton_order(
+    std::vector<Index> &unitcell_index,
+    xtal::UnitCellIndexConverter const &unitcell_converter) {
+  if (unitcell_index.empty()) {
+    return;
+  }
+  std::vector<xtal::UnitCell> unitcells;
+  unitcells.reserve(unitcell_index.size());
+  Index min[3] = {0, 0, 0};
+  for (Index index : unitcell_index) {
+    unitcells.push_back(unitcell_converter(index));
+    for (Index k = 0; k < 3; ++k) {
+      min[k] = std::min(min[k], Index(unitcells.back()(k)));
+    }
+  }
+
+  std::vector<std::pair<std::uint64_t, Index>> keyed;
+  keyed.reserve(unitcell_index.size());
+  for (Index i = 0; i < Index(unitcell_index.size()); ++i) {
+    xtal::UnitCell const &c = unitcells[i];
+    std::uint64_t code =
+        morton_code(c(0) - min[0], c(1) - min[1], c(2) - min[2]);
+    keyed.emplace_back(code, unitcell_index[i]);
+  }
+  std::sort(keyed.begin(), keyed.end());
+  for (Index i = 0; i < Index(keyed.size()); ++i) {
+    unitcell_index[i] = keyed[i].second;
+  }
+}
+
+/// \brief All unit cell indices of a supercell, in Morton (Z-order) of their
+///     unit cell coordinates
+inline std::vector<Index> make_morton_unitcell_order(
+    xtal::UnitCellIndexConverter const &unitcell_converter) {
+  std::vector<Index> unitcell_index(unitcell_converter.total_sites());
+  std::iota(unitcell_index.begin(), unitcell_index.end(), 0);
+  sort_by_morton_order(unitcell_index, unitcell_converter);
+  return unitcell_index;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef CASM_clexmonte_misc_PhaseTimings
+#define CASM_clexmonte_misc_PhaseTimings
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Wall-clock times of named phases of constructing a System and
+///     calculations
+///
+/// Startup phases, such as parsing the System JSON, prim symmetry,
+/// clexulator compilation, prim event and impact info lists, supercell data,
+/// and the complete event list, are each timed by a PhaseTimer, which adds
+/// the time to a PhaseTimings and writes it to `CASM::log()` if the log
+/// verbosity is at least `log_verbosity()`. The collected times show which
+/// phases dominate startup for a given system.
+///
+/// Notes:
+/// - Phases are kept in the order they were first timed. Timing a phase
+///   again adds to its count and total time.
+/// - Thread-safe, so one PhaseTimings may be shared by threads constructing
+///   supercell data or event lists concurrently
+class PhaseTimings {
+ public:
+  /// \brief Times of one phase
+  struct Entry {
+    /// \brief Number of times the phase was timed
+    Index n_calls = 0;
+
+    /// \brief Total time, in seconds
+    double total_time_s = 0.0;
+  };
+
+  PhaseTimings() : m_log_verbosity(Log::verbose) {}
+
+  PhaseTimings(PhaseTimings const &other)
+      : m_entries(other.entries()), m_log_verbosity(other.log_verbosity()) {}
+
+  PhaseTimings &operator=(PhaseTimings const &other) {
+    auto entries = other.entries();
+    int log_verbosity = other.log_verbosity();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries = std::move(entries);
+    m_log_verbosity = log_verbosity;
+    return *this;
+  }
+
+  /// \brief Add one timed call of a phase
+  void add(std::string const &phase, double time_s) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &pair : m_entries) {
+      if (pair.first == phase) {
+        ++pair.second.n_calls;
+        pair.second.total_time_s += time_s;
+        return;
+      }
+    }
+    m_entries.emplace_back(phase, Entry{1, time_s});
+  }
+
+  /// \brief Times of each phase, in the order first timed
+  std::vector<std::pair<std::string, Entry>> entries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries;
+  }
+
+  /// \brief Remove all entries
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+  }
+
+  /// \brief Minimum `CASM::log()` verbosity at which phase times are
+  ///     written as they are timed (default `Log::verbose`)
+  int log_verbosity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_log_verbosity;
+  }
+
+  /// \brief Set the minimum `CASM::log()` verbosity at which phase times
+  ///     are written
+  void set_log_verbosity(int _log_verbosity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_log_verbosity = _log_verbosity;
+  }
+
+ private:
+  mutable std::mutex m_mutex;
+  std::vector<std::pair<std::string, Entry>> m_entries;
+  int m_log_verbosity;
+};
+
+/// \brief Times a phase from construction until `stop` or destruction,
+///     adding the time to a PhaseTimings
+class PhaseTimer {
+ public:
+  typedef std::chrono::steady_clock clock_type;
+
+  /// \brief Constructor, starts timing
+  ///
+  /// \param _timings Where the time is added, which must outlive the
+  ///     PhaseTimer
+  /// \param _phase Phase name
+  PhaseTimer(PhaseTimings &_timings, std::string _phase)
+      : m_timings(&_timings),
+        m_phase(std::move(_phase)),
+        m_begin(clock_type::now()) {}
+
+  /// \brief Constructor, for a phase that began earlier
+  ///
+  /// \param _timings Where the time is added, which must outlive the
+  ///     PhaseTimer
+  /// \param _phase Phase name
+  /// \param _begin When the phase began
+  PhaseTimer(PhaseTimings &_timings, std::string _phase,
+             clock_type::time_point _begin)
+      : m_timings(&_timings), m_phase(std::move(_phase)), m_begin(_begin) {}
+
+  PhaseTimer(PhaseTimer const &) = delete;
+  PhaseTimer &operator=(PhaseTimer const &) = delete;
+
+  ~PhaseTimer() { stop(); }
+
+  /// \brief Stop timing, add the time, and write it to `CASM::log()` if
+  ///     the log verbosity is high enough. Only the first call has an
+  ///     effect.
+  void stop() {
+    if (!m_timings) {
+      return;
+    }
+    std::chrono::duration<double> elapsed = clock_type::now() - m_begin;
+    m_timings->add(m_phase, elapsed.count());
+    Log &log = CASM::log();
+    if (log.verbosity() >= m_timings->log_verbosity()) {
+      log.indent() << "Startup phase \"" << m_phase
+                   << "\": " << elapsed.count() << " s" << std::endl;
+    }
+    m_timings = nullptr;
+  }
+
+ private:
+  PhaseTimings *m_timings;
+  std::string m_phase;
+  clock_type::time_point m_begin;
+};
+
+/// \brief Total time of each phase added since an earlier copy was taken
+///
+/// \param timings The current timings
+/// \param earlier An earlier copy of the entries of `timings`
+///
+/// \returns Phase name and total time, in seconds, of each phase timed
+///     since `earlier`, in the order first timed
+inline std::vector<std::pair<std::string, double>> phase_times_since(
+    PhaseTimings const &timings,
+    std::vector<std::pair<std::string, PhaseTimings::Entry>> const &earlier) {
+  std::map<std::string, PhaseTimings::Entry> before(earlier.begin(),
+                                                    earlier.end());
+  std::vector<std::pair<std::string, double>> result;
+  for (auto const &pair : timings.entries()) {
+    PhaseTimings::Entry const &prev = before[pair.first];
+    if (pair.second.n_calls > prev.n_calls) {
+      result.emplace_back(pair.first,
+                          pair.second.total_time_s - prev.total_time_s);
+    }
+  }
+  return result;
+}
+
+/// \brief Write PhaseTimings to JSON
+///
+/// Format: an object with one entry per phase, with "n_calls" and
+/// "total_time_s".
+inline jsonParser &to_json(PhaseTimings const &timings, jsonParser &json) {
+  json.put_obj();
+  for (auto const &pair : timings.entries()) {
+    json[pair.first]["n_calls"] = pair.second.n_calls;
+    json[pair.first]["total_time_s"] = pair.second.total_time_s;
+  }
+  return json;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
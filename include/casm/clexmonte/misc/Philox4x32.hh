@@ -0,0 +1,146 @@
+#ifndef CASM_clexmonte_misc_Philox4x32
+#define CASM_clexmonte_misc_Philox4x32
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Philox4x32-10 counter-based random number engine
+///
+/// Each output block is a bijection (10 Philox rounds) of a 128-bit counter,
+/// keyed by a 64-bit seed, so:
+/// - The engine state is just the seed and counter, and `discard` is O(1).
+/// - Engines with the same seed and different `stream` values produce
+///   non-overlapping, statistically independent sequences, which can be
+///   reproduced from the seed alone. The stream index occupies the upper 64
+///   bits of the counter, so each stream has 2^64 blocks of 4 values.
+///
+/// Satisfies the C++ UniformRandomBitGenerator requirements, with 32-bit
+/// output, as described by Salmon et al., "Parallel random numbers: as easy
+/// as 1, 2, 3", SC11 (2011).
+class Philox4x32 {
+ public:
+  typedef std::uint32_t result_type;
+
+  /// \brief Constructor
+  ///
+  /// \param seed The key
+  /// \param stream Independent stream index
+  explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+    this->seed(seed, stream);
+  }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /// \brief Reset, with a new seed and stream, to the start of the stream
+  void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+    m_key = {std::uint32_t(seed), std::uint32_t(seed >> 32)};
+    m_counter = {0, 0, std::uint32_t(stream), std::uint32_t(stream >> 32)};
+    m_index = 4;
+  }
+
+  /// \brief Generate the next value
+  result_type operator()() {
+    if (m_index == 4) {
+      m_block = block(m_counter, m_key);
+      _increment_counter(1);
+      m_index = 0;
+    }
+    return m_block[m_index++];
+  }
+
+  /// \brief Advance the engine by `n` values
+  void discard(unsigned long long n) {
+    while (n > 0 && m_index < 4) {
+      ++m_index;
+      --n;
+    }
+    if (n == 0) {
+      return;
+    }
+    _increment_counter(n / 4);
+    m_index = 4;
+    for (unsigned long long i = 0; i < n % 4; ++i) {
+      (*this)();
+    }
+  }
+
+  /// \brief Philox4x32-10 bijection of one counter block
+  static std::array<std::uint32_t, 4> block(
+      std::array<std::uint32_t, 4> counter,
+      std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+      }
+      std::uint64_t p0 = std::uint64_t(0xD2511F53) * counter[0];
+      std::uint64_t p1 = std::uint64_t(0xCD9E8D57) * counter[2];
+      counter = {std::uint32_t(p1 >> 32) ^ counter[1] ^ key[0],
+                 std::uint32_t(p1),
+                 std::uint32_t(p0 >> 32) ^ counter[3] ^ key[1],
+                 std::uint32_t(p0)};
+    }
+    return counter;
+  }
+
+ private:
+  /// Increment the lower 64 bits of the counter (the position in the stream)
+  void _increment_counter(std::uint64_t n) {
+    std::uint64_t position =
+        (std::uint64_t(m_counter[1]) << 32 | m_counter[0]) + n;
+    m_counter[0] = std::uint32_t(position);
+    m_counter[1] = std::uint32_t(position >> 32);
+  }
+
+  std::array<std::uint32_t, 2> m_key;
+  std::array<std::uint32_t, 4> m_counter;
+  std::array<std::uint32_t, 4> m_block;
+  int m_index;
+};
+
+/// \brief Seed a random number engine for one of many independent streams
+///
+/// The engine is seeded from a `std::seed_seq` of values drawn from
+/// `Philox4x32(seed, stream)`, so engines for different streams, such as one
+/// per thread or replica, are initialized from independent values and the
+/// whole set is reproducible from `seed`.
+///
+/// \param engine The engine to seed
+/// \param seed The seed shared by all streams
+/// \param stream The stream index
+template <typename EngineType>
+void seed_stream_engine(EngineType &engine, std::uint64_t seed,
+                        std::uint64_t stream) {
+  Philox4x32 philox(seed, stream);
+  std::array<std::uint32_t, 16> values;
+  for (auto &value : values) {
+    value = philox();
+  }
+  std::seed_seq seq(values.begin(), values.end());
+  engine.seed(seq);
+}
+
+/// \brief Make a random number engine seeded for one of many independent
+///     streams, using `seed_stream_engine`
+template <typename EngineType>
+std::shared_ptr<EngineType> make_stream_engine(std::uint64_t seed,
+                                               std::uint64_t stream) {
+  auto engine = std::make_shared<EngineType>();
+  seed_stream_engine(*engine, seed, stream);
+  return engine;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
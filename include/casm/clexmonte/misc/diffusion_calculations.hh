@@ -1,6 +1,12 @@
 #ifndef CASM_clexmonte_diffusion_calculations
 #define CASM_clexmonte_diffusion_calculations
 
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "casm/clexmonte/misc/eigen.hh"
 #include "casm/global/eigen.hh"
 
@@ -169,6 +175,266 @@ static std::vector<std::string> make_component_names(
   return component_names;
 }
 
+/// \brief Per atom type sums of displacements, from which all diffusion
+///     observables are calculated
+///
+/// `accumulate` makes a single pass over the atoms, without allocating
+/// memory once sized, and sums for atoms of each type:
+/// - the number of atoms, `N(i)`
+/// - the displacement, `sumR(alpha, i) = \sum_\zeta \Delta R^\zeta_{i,\alpha}`
+/// - the displacement products, `sumRR(k, i) = \sum_\zeta \Delta
+///   R^\zeta_{i,\alpha} * \Delta R^\zeta_{i,\beta}`, with `k` indexing the
+///   directions (xx, yy, zz, yz, xz, xy), as in AnisotropicCounter
+///
+/// Sums from separate sets of atoms can be combined with `add`.
+struct DiffusionSums {
+  /// \brief Total number of atoms
+  double n_atoms = 0.0;
+
+  /// \brief Number of atoms of each type, size `n_atom_types`
+  Eigen::VectorXd N;
+
+  /// \brief Sum of displacements of atoms of each type,
+  ///     shape=(3, n_atom_types)
+  Eigen::MatrixXd sumR;
+
+  /// \brief Sum of displacement products of atoms of each type,
+  ///     shape=(6, n_atom_types)
+  Eigen::MatrixXd sumRR;
+
+  /// \brief Set all sums to zero, for `n_atom_types` atom types
+  void reset(Index n_atom_types) {
+    n_atoms = 0.0;
+    N.setZero(n_atom_types);
+    sumR.setZero(3, n_atom_types);
+    sumRR.setZero(6, n_atom_types);
+  }
+
+  /// \brief Add displacements of all atoms
+  ///
+  /// \param atom_name_index_list The atom type of each atom (column of
+  ///     `delta_R`)
+  /// \param delta_R Atom displacements, shape=(3, n_atoms)
+  void accumulate(std::vector<Index> const &atom_name_index_list,
+                  Eigen::MatrixXd const &delta_R) {
+    Index const *type = atom_name_index_list.data();
+    double const *R = delta_R.data();
+    double *N_ptr = N.data();
+    double *sumR_ptr = sumR.data();
+    double *sumRR_ptr = sumRR.data();
+    Index n = delta_R.cols();
+    for (Index atom_index = 0; atom_index < n; ++atom_index) {
+      double x = R[3 * atom_index];
+      double y = R[3 * atom_index + 1];
+      double z = R[3 * atom_index + 2];
+      Index t = type[atom_index];
+      N_ptr[t] += 1.0;
+      double *r = sumR_ptr + 3 * t;
+      r[0] += x;
+      r[1] += y;
+      r[2] += z;
+      double *rr = sumRR_ptr + 6 * t;
+      rr[0] += x * x;
+      rr[1] += y * y;
+      rr[2] += z * z;
+      rr[3] += y * z;
+      rr[4] += x * z;
+      rr[5] += x * y;
+    }
+    n_atoms += n;
+  }
+
+  /// \brief Add the displacement of one atom to `sumR` and `sumRR`
+  ///
+  /// Does not change `N` or `n_atoms`, so that atoms which have not moved
+  /// can be counted separately.
+  ///
+  /// \param atom_name_index The atom type
+  /// \param R The atom displacement
+  void add_displacement(Index atom_name_index, Eigen::Vector3d const &R) {
+    double x = R(0);
+    double y = R(1);
+    double z = R(2);
+    double *r = sumR.data() + 3 * atom_name_index;
+    r[0] += x;
+    r[1] += y;
+    r[2] += z;
+    double *rr = sumRR.data() + 6 * atom_name_index;
+    rr[0] += x * x;
+    rr[1] += y * y;
+    rr[2] += z * z;
+    rr[3] += y * z;
+    rr[4] += x * z;
+    rr[5] += x * y;
+  }
+
+  /// \brief Add sums from another set of atoms
+  void add(DiffusionSums const &other) {
+    n_atoms += other.n_atoms;
+    N += other.N;
+    sumR += other.sumR;
+    sumRR += other.sumRR;
+  }
+};
+
+/// \brief Diffusion observable types
+///
+/// Values are unrolled in the order given by the corresponding counter:
+/// - `collective_isotropic`: CollectiveIsotropicCounter
+/// - `collective_anisotropic`: CollectiveAnisotropicCounter
+/// - `individual_isotropic`: IndividualIsotropicCounter
+/// - `individual_anisotropic`: IndividualAnisotropicCounter
+enum class DiffusionObservableType {
+  collective_isotropic,
+  collective_anisotropic,
+  individual_isotropic,
+  individual_anisotropic
+};
+
+/// \brief Precomputed component index layout of a diffusion observable
+///
+/// The counter is iterated once, on construction, to store the atom type
+/// and direction indices of each unrolled component. `mean_R_squared` then
+/// evaluates all components from DiffusionSums without constructing names
+/// or temporary containers.
+class DiffusionObservableLayout {
+ public:
+  DiffusionObservableLayout(DiffusionObservableType _type,
+                            std::vector<std::string> const &atom_name_list)
+      : m_type(_type), m_n_atom_types(atom_name_list.size()) {
+    if (m_type == DiffusionObservableType::collective_isotropic) {
+      CollectiveIsotropicCounter counter(atom_name_list);
+      while (counter.is_valid()) {
+        _add(counter.i, counter.j, 0, 0);
+        counter.advance();
+      }
+    } else if (m_type == DiffusionObservableType::collective_anisotropic) {
+      CollectiveAnisotropicCounter counter(atom_name_list);
+      while (counter.is_valid()) {
+        _add(counter.i, counter.j, counter.alpha, counter.beta);
+        counter.advance();
+      }
+    } else if (m_type == DiffusionObservableType::individual_isotropic) {
+      IndividualIsotropicCounter counter(atom_name_list);
+      while (counter.is_valid()) {
+        _add(counter.i, counter.i, 0, 0);
+        counter.advance();
+      }
+    } else {
+      IndividualAnisotropicCounter counter(atom_name_list);
+      while (counter.is_valid()) {
+        // the sumRR row is the direction index
+        _add(counter.i, counter.i, counter.dir_index, 0);
+        counter.advance();
+      }
+    }
+  }
+
+  /// \brief Observable type
+  DiffusionObservableType type() const { return m_type; }
+
+  /// \brief Number of atom types
+  Index n_atom_types() const { return m_n_atom_types; }
+
+  /// \brief Number of unrolled components
+  Index size() const { return m_i.size(); }
+
+  /// \brief Set `v` to the mean squared displacement components
+  ///
+  /// Collective observables are normalized by the total number of atoms,
+  /// and individual observables by the number of atoms of type `i`. The
+  /// size of `v` is only changed if it is not `size()`.
+  void mean_R_squared(DiffusionSums const &sums, Eigen::VectorXd &v) const {
+    Index n = size();
+    if (v.size() != n) {
+      v.resize(n);
+    }
+    Eigen::MatrixXd const &sumR = sums.sumR;
+    Eigen::MatrixXd const &sumRR = sums.sumRR;
+    if (m_type == DiffusionObservableType::collective_isotropic) {
+      for (Index c = 0; c < n; ++c) {
+        v(c) = sumR.col(m_i[c]).dot(sumR.col(m_j[c])) / sums.n_atoms;
+      }
+    } else if (m_type == DiffusionObservableType::collective_anisotropic) {
+      for (Index c = 0; c < n; ++c) {
+        v(c) = sumR(m_a[c], m_i[c]) * sumR(m_b[c], m_j[c]) / sums.n_atoms;
+      }
+    } else if (m_type == DiffusionObservableType::individual_isotropic) {
+      for (Index c = 0; c < n; ++c) {
+        Index i = m_i[c];
+        v(c) = (sumRR(0, i) + sumRR(1, i) + sumRR(2, i)) / sums.N(i);
+      }
+    } else {
+      for (Index c = 0; c < n; ++c) {
+        Index i = m_i[c];
+        v(c) = sumRR(m_a[c], i) / sums.N(i);
+      }
+    }
+  }
+
+  /// \brief Set `v` to the collective mean squared displacement components
+  ///     from a second moment matrix
+  ///
+  /// \param E Second moment of the collective displacements, with
+  ///     `E(3*i+a, 3*j+b)` the value for atom types `i`, `j` and directions
+  ///     `a`, `b`
+  /// \param n_atoms Total number of atoms, the normalization
+  /// \param v Set to the components. The size of `v` is only changed if it
+  ///     is not `size()`.
+  void collective_mean_R_squared(Eigen::MatrixXd const &E, double n_atoms,
+                                 Eigen::VectorXd &v) const {
+    Index n = size();
+    if (v.size() != n) {
+      v.resize(n);
+    }
+    if (m_type == DiffusionObservableType::collective_isotropic) {
+      for (Index c = 0; c < n; ++c) {
+        Index i = 3 * m_i[c];
+        Index j = 3 * m_j[c];
+        v(c) = (E(i, j) + E(i + 1, j + 1) + E(i + 2, j + 2)) / n_atoms;
+      }
+    } else if (m_type == DiffusionObservableType::collective_anisotropic) {
+      for (Index c = 0; c < n; ++c) {
+        v(c) = E(3 * m_i[c] + m_a[c], 3 * m_j[c] + m_b[c]) / n_atoms;
+      }
+    } else {
+      throw std::runtime_error(
+          "Error in DiffusionObservableLayout::collective_mean_R_squared: "
+          "not a collective observable");
+    }
+  }
+
+ private:
+  void _add(Index i, Index j, Index a, Index b) {
+    m_i.push_back(i);
+    m_j.push_back(j);
+    m_a.push_back(a);
+    m_b.push_back(b);
+  }
+
+  DiffusionObservableType m_type;
+  Index m_n_atom_types;
+  std::vector<Index> m_i;
+  std::vector<Index> m_j;
+  std::vector<Index> m_a;
+  std::vector<Index> m_b;
+};
+
+/// \brief Calculate mean squared displacements using DiffusionSums and
+///     DiffusionObservableLayout
+inline Eigen::VectorXd _mean_R_squared(
+    DiffusionObservableType type,
+    std::vector<std::string> const &atom_name_list,
+    std::vector<Index> const &atom_name_index_list,
+    Eigen::MatrixXd const &delta_R) {
+  DiffusionSums sums;
+  sums.reset(atom_name_list.size());
+  sums.accumulate(atom_name_index_list, delta_R);
+  Eigen::VectorXd v;
+  DiffusionObservableLayout(type, atom_name_list).mean_R_squared(sums, v);
+  return v;
+}
+
 /// \brief Returns the mean collective atom isotropic squared displacement
 ///
 /// This is:
@@ -189,20 +455,8 @@ static std::vector<std::string> make_component_names(
 Eigen::VectorXd mean_R_squared_collective_isotropic(
     std::vector<std::string> atom_name_list,
     std::vector<Index> atom_name_index_list, Eigen::MatrixXd const &delta_R) {
-  std::vector<Eigen::Vector3d> sumR(atom_name_list.size(),
-                                    Eigen::Vector3d::Zero());
-  for (Index atom_index = 0; atom_index < delta_R.cols(); ++atom_index) {
-    sumR[atom_name_index_list[atom_index]] += delta_R.col(atom_index);
-  }
-
-  CollectiveIsotropicCounter counter(atom_name_list);
-  std::vector<double> v;
-  double N = delta_R.cols();
-  while (counter.is_valid()) {
-    v.push_back(sumR[counter.i].dot(sumR[counter.j]) / N);
-    counter.advance();
-  }
-  return to_VectorXd(v);
+  return _mean_R_squared(DiffusionObservableType::collective_isotropic,
+                         atom_name_list, atom_name_index_list, delta_R);
 }
 
 Eigen::VectorXd L_isotropic_sample(std::vector<std::string> atom_name_list,
@@ -241,21 +495,8 @@ Eigen::VectorXd L_isotropic_sample(std::vector<std::string> atom_name_list,
 Eigen::VectorXd mean_R_squared_collective_anisotropic(
     std::vector<std::string> atom_name_list,
     std::vector<Index> atom_name_index_list, Eigen::MatrixXd const &delta_R) {
-  std::vector<Eigen::Vector3d> sumR(atom_name_list.size(),
-                                    Eigen::Vector3d::Zero());
-  for (Index atom_index = 0; atom_index < delta_R.cols(); ++atom_index) {
-    sumR[atom_name_index_list[atom_index]] += delta_R.col(atom_index);
-  }
-
-  CollectiveAnisotropicCounter counter(atom_name_list);
-  std::vector<double> v;
-  double N = delta_R.cols();
-  while (counter.is_valid()) {
-    v.push_back(sumR[counter.i](counter.alpha) * sumR[counter.j](counter.beta) /
-                N);
-    counter.advance();
-  }
-  return to_VectorXd(v);
+  return _mean_R_squared(DiffusionObservableType::collective_anisotropic,
+                         atom_name_list, atom_name_index_list, delta_R);
 }
 
 Eigen::VectorXd L_anisotropic_sample(std::vector<std::string> atom_name_list,
@@ -292,21 +533,8 @@ Eigen::VectorXd L_anisotropic_sample(std::vector<std::string> atom_name_list,
 Eigen::VectorXd mean_R_squared_individual_isotropic(
     std::vector<std::string> atom_name_list,
     std::vector<Index> atom_name_index_list, Eigen::MatrixXd const &delta_R) {
-  std::vector<double> sumRR(atom_name_list.size(), 0.0);
-  Eigen::VectorXd N = Eigen::VectorXd::Zero(atom_name_list.size());
-  for (Index atom_index = 0; atom_index < delta_R.cols(); ++atom_index) {
-    sumRR[atom_name_index_list[atom_index]] +=
-        delta_R.col(atom_index).dot(delta_R.col(atom_index));
-    N(atom_name_index_list[atom_index]) += 1.0;
-  }
-
-  IndividualIsotropicCounter counter(atom_name_list);
-  std::vector<double> v;
-  while (counter.is_valid()) {
-    v.push_back(sumRR[counter.i] / N(counter.i));
-    counter.advance();
-  }
-  return to_VectorXd(v);
+  return _mean_R_squared(DiffusionObservableType::individual_isotropic,
+                         atom_name_list, atom_name_index_list, delta_R);
 }
 
 Eigen::VectorXd D_tracer_isotropic_sample(
@@ -339,22 +567,8 @@ Eigen::VectorXd D_tracer_isotropic_sample(
 Eigen::VectorXd mean_R_squared_individual_anisotropic(
     std::vector<std::string> atom_name_list,
     std::vector<Index> atom_name_index_list, Eigen::MatrixXd const &delta_R) {
-  std::vector<Eigen::Matrix3d> sumRR(atom_name_list.size(),
-                                     Eigen::Matrix3d::Zero());
-  Eigen::VectorXd N = Eigen::VectorXd::Zero(atom_name_list.size());
-  for (Index atom_index = 0; atom_index < delta_R.cols(); ++atom_index) {
-    sumRR[atom_name_index_list[atom_index]] +=
-        delta_R.col(atom_index) * delta_R.col(atom_index).transpose();
-    N(atom_name_index_list[atom_index]) += 1.0;
-  }
-
-  IndividualAnisotropicCounter counter(atom_name_list);
-  std::vector<double> v;
-  while (counter.is_valid()) {
-    v.push_back(sumRR[counter.i](counter.alpha, counter.beta) / N(counter.i));
-    counter.advance();
-  }
-  return to_VectorXd(v);
+  return _mean_R_squared(DiffusionObservableType::individual_anisotropic,
+                         atom_name_list, atom_name_index_list, delta_R);
 }
 
 Eigen::VectorXd D_tracer_anisotropic_sample(
@@ -366,6 +580,523 @@ Eigen::VectorXd D_tracer_anisotropic_sample(
   return RiaRib / (2 * delta_time);
 }
 
+/// \brief Atom displacements and elapsed time since the previous sample,
+///     shared by the sampling functions of one sample
+///
+/// Sampling functions which use displacements, i.e. "mean_R_squared_*",
+/// "L_*", and "D_tracer_*", share one KMCDisplacementCache so that
+/// displacements are found once per sample rather than once per sampling
+/// function. The cached values are re-calculated if the sampling fixture
+/// label, the current time, or the previous sample time changes.
+///
+/// Displacements are found in one of two ways:
+/// - By default, as `delta_R = R_curr - R_prev` from the positions in
+///   `kmc_data`, which costs O(n_atoms) per sample. Call `reset` when atom
+///   positions may change without a change in time, i.e. at the beginning
+///   of a run.
+/// - After `reset_accumulated`, from the displacements given by
+///   `add_displacement` for the atoms moved by each event. Displacements
+///   are accumulated separately for each sampling fixture, and a sample
+///   only visits the atoms moved since the previous sample of its fixture,
+///   so no position matrices are copied or subtracted. The cache must then
+///   be used for every sample of the sampling fixtures that use it.
+///   Each sampling fixture is assigned an integer slot by
+///   `reset_accumulated`, and its accumulated displacements are kept in a
+///   vector indexed by slot. The slot and the fixture's previous sample time
+///   are resolved once per sample, rather than by label lookup for each
+///   sampling function.
+///
+/// `KMCDataType` must have members:
+/// - `Eigen::MatrixXd atom_positions_cart`, by default
+/// - `std::map<std::string, Eigen::MatrixXd> prev_atom_positions_cart`, by
+///   default
+/// - `double time`
+/// - `std::map<std::string, double> prev_time`
+/// - `std::string sampling_fixture_label`
+/// - `std::vector<Index> atom_name_index_list`, for `diffusion_sums`
+class KMCDisplacementCache {
+ public:
+  KMCDisplacementCache()
+      : m_is_valid(false),
+        m_sums_are_valid(false),
+        m_delta_R_is_valid(false),
+        m_is_accumulated(false),
+        m_n_atoms(0),
+        m_slot(-1) {}
+
+  /// \brief Require re-calculation on the next request, with displacements
+  ///     found from the positions in `kmc_data`
+  void reset() {
+    m_is_valid = false;
+    m_sums_are_valid = false;
+    m_delta_R_is_valid = false;
+    m_is_accumulated = false;
+    m_accumulators.clear();
+    m_slot_labels.clear();
+    m_slot = -1;
+  }
+
+  /// \brief Require re-calculation on the next request, with displacements
+  ///     accumulated by `add_displacement`
+  ///
+  /// \param n_atoms Number of atoms
+  /// \param sampling_fixture_labels Labels of the sampling fixtures which
+  ///     may request displacements, in the order of their slots. The first
+  ///     displacements requested by each are relative to the positions at
+  ///     `reset_accumulated`.
+  void reset_accumulated(
+      Index n_atoms, std::vector<std::string> const &sampling_fixture_labels) {
+    reset();
+    m_is_accumulated = true;
+    m_n_atoms = n_atoms;
+    m_type_count.resize(0);
+    for (std::string const &label : sampling_fixture_labels) {
+      if (std::find(m_slot_labels.begin(), m_slot_labels.end(), label) !=
+          m_slot_labels.end()) {
+        continue;
+      }
+      m_slot_labels.push_back(label);
+      Accumulator acc;
+      acc.dR = Eigen::MatrixXd::Zero(3, n_atoms);
+      acc.is_moved.assign(n_atoms, false);
+      m_accumulators.push_back(std::move(acc));
+    }
+  }
+
+  /// \brief Add the displacement of an atom by an event, for all sampling
+  ///     fixtures
+  ///
+  /// \param atom_id Atom index, the column of `delta_R`
+  /// \param dR Cartesian displacement
+  void add_displacement(Index atom_id, Eigen::Vector3d const &dR) {
+    for (Accumulator &acc : m_accumulators) {
+      if (!acc.is_moved[atom_id]) {
+        acc.is_moved[atom_id] = true;
+        acc.moved.push_back(atom_id);
+      }
+      acc.dR.col(atom_id) += dR;
+    }
+  }
+
+  /// \brief Return `R_curr - R_prev`, for the current sampling fixture
+  template <typename KMCDataType>
+  Eigen::MatrixXd const &delta_R(KMCDataType const &kmc_data) {
+    _update(kmc_data);
+    if (!m_delta_R_is_valid) {
+      m_delta_R.setZero(3, m_n_atoms);
+      for (Index i = 0; i < Index(m_moved.size()); ++i) {
+        m_delta_R.col(m_moved[i]) = m_moved_dR[i];
+      }
+      m_delta_R_is_valid = true;
+    }
+    return m_delta_R;
+  }
+
+  /// \brief Return `time_curr - time_prev`, for the current sampling fixture
+  template <typename KMCDataType>
+  double delta_time(KMCDataType const &kmc_data) {
+    _update(kmc_data);
+    return m_time - m_prev_time;
+  }
+
+  /// \brief Return the DiffusionSums of `delta_R`, for the current sampling
+  ///     fixture and the atom types of `layout`
+  ///
+  /// The sums are calculated in one pass over atoms per sample, or over the
+  /// atoms moved since the previous sample if displacements are
+  /// accumulated, and shared by all diffusion observables.
+  template <typename KMCDataType>
+  DiffusionSums const &diffusion_sums(KMCDataType const &kmc_data,
+                                      DiffusionObservableLayout const &layout) {
+    _update(kmc_data);
+    if (m_sums_are_valid && m_sums.N.size() == layout.n_atom_types()) {
+      return m_sums;
+    }
+    m_sums.reset(layout.n_atom_types());
+    if (!m_is_accumulated) {
+      m_sums.accumulate(kmc_data.atom_name_index_list, m_delta_R);
+    } else {
+      // atom type counts do not change during a run
+      if (m_type_count.size() != layout.n_atom_types()) {
+        m_type_count.setZero(layout.n_atom_types());
+        for (Index atom_name_index : kmc_data.atom_name_index_list) {
+          m_type_count(atom_name_index) += 1.0;
+        }
+      }
+      m_sums.N = m_type_count;
+      m_sums.n_atoms = kmc_data.atom_name_index_list.size();
+      for (Index i = 0; i < Index(m_moved.size()); ++i) {
+        m_sums.add_displacement(kmc_data.atom_name_index_list[m_moved[i]],
+                                m_moved_dR[i]);
+      }
+    }
+    m_sums_are_valid = true;
+    return m_sums;
+  }
+
+ private:
+  template <typename KMCDataType>
+  void _update(KMCDataType const &kmc_data) {
+    std::string const &label = kmc_data.sampling_fixture_label;
+    if (m_is_accumulated) {
+      // A new sample changes the time or the sampling fixture; only then
+      // are the slot and previous sample time looked up
+      if (m_is_valid && m_time == kmc_data.time &&
+          m_slot_labels[m_slot] == label) {
+        return;
+      }
+      m_is_valid = false;
+      m_slot = _find_slot(label);
+      m_prev_time = kmc_data.prev_time.at(label);
+      m_time = kmc_data.time;
+      _consume(m_slot, m_prev_time, m_time);
+      m_is_valid = true;
+      m_sums_are_valid = false;
+      return;
+    }
+
+    double prev_time = kmc_data.prev_time.at(label);
+    if (m_is_valid && m_label == label && m_time == kmc_data.time &&
+        m_prev_time == prev_time) {
+      return;
+    }
+    auto const &R_curr = kmc_data.atom_positions_cart;
+    auto const &R_prev = kmc_data.prev_atom_positions_cart.at(label);
+    m_delta_R.resize(R_curr.rows(), R_curr.cols());
+    m_delta_R.noalias() = R_curr - R_prev;
+    m_delta_R_is_valid = true;
+    m_label = label;
+    m_time = kmc_data.time;
+    m_prev_time = prev_time;
+    m_is_valid = true;
+    m_sums_are_valid = false;
+  }
+
+  /// \brief Slot of a sampling fixture, checking the current slot first
+  Index _find_slot(std::string const &label) const {
+    if (m_slot >= 0 && m_slot_labels[m_slot] == label) {
+      return m_slot;
+    }
+    for (Index slot = 0; slot < Index(m_slot_labels.size()); ++slot) {
+      if (m_slot_labels[slot] == label) {
+        return slot;
+      }
+    }
+    throw std::runtime_error(
+        "Error in KMCDisplacementCache: no displacements accumulated for "
+        "sampling fixture '" +
+        label + "'");
+  }
+
+  /// \brief Take, and reset, the displacements accumulated for a sampling
+  ///     fixture since its previous sample
+  void _consume(Index slot, double prev_time, double time) {
+    Accumulator &acc = m_accumulators[slot];
+    if (acc.has_prev_sample && acc.prev_sample_time != prev_time) {
+      throw std::runtime_error(
+          "Error in KMCDisplacementCache: previous sample displacements "
+          "are not available for sampling fixture '" +
+          m_slot_labels[slot] + "'");
+    }
+    m_moved_dR.clear();
+    for (Index atom_id : acc.moved) {
+      m_moved_dR.push_back(acc.dR.col(atom_id));
+      acc.dR.col(atom_id).setZero();
+      acc.is_moved[atom_id] = false;
+    }
+    m_moved.swap(acc.moved);
+    acc.moved.clear();
+    acc.has_prev_sample = true;
+    acc.prev_sample_time = time;
+    m_delta_R_is_valid = false;
+  }
+
+  /// \brief Displacements since the previous sample of one sampling fixture
+  struct Accumulator {
+    bool has_prev_sample = false;
+    double prev_sample_time = 0.0;
+    Eigen::MatrixXd dR;
+    std::vector<bool> is_moved;
+    std::vector<Index> moved;
+  };
+
+  bool m_is_valid;
+  std::string m_label;
+  double m_time;
+  double m_prev_time;
+  Eigen::MatrixXd m_delta_R;
+  bool m_sums_are_valid;
+  DiffusionSums m_sums;
+
+  // Accumulated displacements, if m_is_accumulated
+  bool m_delta_R_is_valid;
+  bool m_is_accumulated;
+  Index m_n_atoms;
+  // Accumulated displacements and label of each sampling fixture, by slot
+  std::vector<Accumulator> m_accumulators;
+  std::vector<std::string> m_slot_labels;
+  // Slot of the current sample, or -1
+  Index m_slot;
+  Eigen::VectorXd m_type_count;
+  // Atoms moved since the previous sample of the current sampling fixture,
+  // and their displacements
+  std::vector<Index> m_moved;
+  std::vector<Eigen::Vector3d> m_moved_dR;
+};
+
+/// \brief Number of atoms and atom jumps by atom type, updated as KMC
+///     events are applied
+///
+/// Call `reset` at the beginning of a run to count from the occupant
+/// tracker, and `count` for each selected event, before it is applied, so
+/// that jumps per atom type do not need to be summed over all atoms for
+/// each sample. One jump is counted for each atom trajectory, consistent
+/// with `monte::OccLocation::current_atom_n_jumps`.
+class KMCJumpCounter {
+ public:
+  /// \brief Count atoms and jumps by type from the occupant tracker
+  ///
+  /// \param atom_name_index_list The atom type of each atom
+  /// \param n_atom_types Number of atom types
+  /// \param occ_location A `monte::OccLocation`
+  template <typename OccLocationType>
+  void reset(std::vector<Index> const &atom_name_index_list,
+             Index n_atom_types, OccLocationType const &occ_location) {
+    reset(atom_name_index_list, n_atom_types);
+    auto const &n_jumps = occ_location.current_atom_n_jumps();
+    for (Index i = 0; i < n_jumps.size(); ++i) {
+      m_sum_n_jumps(m_atom_name_index_list[i]) += n_jumps[i];
+    }
+  }
+
+  /// \brief Count atoms by type, starting with no jumps
+  ///
+  /// \param atom_name_index_list The atom type of each atom
+  /// \param n_atom_types Number of atom types
+  void reset(std::vector<Index> const &atom_name_index_list,
+             Index n_atom_types) {
+    m_atom_name_index_list = atom_name_index_list;
+    m_n_atoms = Eigen::VectorXd::Zero(n_atom_types);
+    m_sum_n_jumps = Eigen::VectorXd::Zero(n_atom_types);
+    for (Index atom_name_index : m_atom_name_index_list) {
+      m_n_atoms(atom_name_index) += 1.0;
+    }
+  }
+
+  /// \brief Count the jumps of an event, which must not yet be applied
+  ///
+  /// \param event A `monte::OccEvent`
+  /// \param occ_location A `monte::OccLocation`
+  template <typename OccEventType, typename OccLocationType>
+  void count(OccEventType const &event, OccLocationType const &occ_location) {
+    for (auto const &traj : event.atom_traj) {
+      Index atom_id =
+          occ_location.mol(traj.from.mol_id).component[traj.from.mol_comp];
+      m_sum_n_jumps(m_atom_name_index_list[atom_id]) += 1.0;
+    }
+  }
+
+  /// \brief Count one jump of an atom
+  ///
+  /// \param atom_id Index into `atom_name_index_list`
+  void count_atom(Index atom_id) {
+    m_sum_n_jumps(m_atom_name_index_list[atom_id]) += 1.0;
+  }
+
+  /// \brief Number of atoms of each type
+  Eigen::VectorXd const &n_atoms() const { return m_n_atoms; }
+
+  /// \brief Total number of jumps by atoms of each type
+  Eigen::VectorXd const &sum_n_jumps() const { return m_sum_n_jumps; }
+
+ private:
+  std::vector<Index> m_atom_name_index_list;
+  Eigen::VectorXd m_n_atoms;
+  Eigen::VectorXd m_sum_n_jumps;
+};
+
+/// \brief Displacement of an atom, of a given type, by a prim event
+struct PrimEventAtomDisplacement {
+  /// \brief Atom type (as in `occ_events::OccSystem::atom_name_list`)
+  Index atom_name_index;
+
+  /// \brief Cartesian displacement
+  Eigen::Vector3d dR;
+};
+
+/// \brief Rate-weighted ("kinetic") estimator sums of the second moment of
+///     collective displacements, updated as KMC events are selected
+///
+/// The collective displacement `R`, the displacement summed over the atoms
+/// of each type, changes at each step by the displacement `dR_p` of the
+/// selected prim event `p`, which is the same for all translations of the
+/// prim event. Rather than sampling `R R^T` at the end of an interval, the
+/// expected change of `R R^T` at each step, given the current total rate
+/// `Gamma_p` of each prim event and `Gamma = sum_p Gamma_p`, is summed:
+///
+///     E[d(R R^T)] = (R J^T + J R^T + M) / Gamma,
+///     J = sum_p Gamma_p dR_p,  M = sum_p Gamma_p dR_p dR_p^T,
+///
+/// and the elapsed time is estimated by the sum of the expected residence
+/// times, `1 / Gamma`. These are unbiased estimates of the change in
+/// `R R^T` and of the elapsed time over an interval, without the variance
+/// of which event is selected at each step and of the residence times, so
+/// Onsager coefficients converge in far fewer events than with `R R^T`
+/// sampled directly.
+///
+/// Usage:
+/// - Call `reset` at the beginning of a run, and `add_step` for each
+///   selected event, before it is applied, with the current total rate of
+///   each prim event.
+/// - Sums are cumulative from `reset`. Take a Snapshot at the start of a
+///   sampling interval, and use `second_moment` at its end.
+///
+/// Notes:
+/// - `R` is a vector of size `3 * n_atom_types`, with `R(3*i+a)` the
+///   component `a` for atom type `i`.
+/// - `M` is linear in the prim event total rates, so only
+///   `sum_k Gamma_p / Gamma` is summed per step for each prim event, and `M`
+///   is formed once per sample. The cost per step is O(n_prim_events).
+class KMCRateWeightedDiffusionSums {
+ public:
+  /// \brief Cumulative sums, from `reset`
+  struct Snapshot {
+    /// \brief Number of steps
+    Index n_steps = 0;
+
+    /// \brief Sum of expected residence times, `sum_k 1 / Gamma`
+    double W = 0.0;
+
+    /// \brief `sum_k Gamma_p / Gamma`, by prim event index
+    Eigen::VectorXd G;
+
+    /// \brief `sum_k J / Gamma`
+    Eigen::VectorXd SJ;
+
+    /// \brief `sum_k R J^T / Gamma`
+    Eigen::MatrixXd X;
+
+    /// \brief Current collective displacement, `R`
+    Eigen::VectorXd R;
+  };
+
+  KMCRateWeightedDiffusionSums() : m_is_enabled(false), m_n_atoms(0) {}
+
+  /// \brief Begin a run, with all sums zero
+  ///
+  /// \param _prim_event_dR The atom displacements of each prim event, by
+  ///     prim event index
+  /// \param _n_atom_types Number of atom types
+  /// \param _n_atoms Total number of atoms
+  /// \param _is_enabled If false, `add_step` has no effect, so there is no
+  ///     cost when the estimator is not sampled
+  void reset(
+      std::vector<std::vector<PrimEventAtomDisplacement>> _prim_event_dR,
+      Index _n_atom_types, Index _n_atoms, bool _is_enabled) {
+    m_prim_event_dR = std::move(_prim_event_dR);
+    m_n_atoms = _n_atoms;
+    m_is_enabled = _is_enabled;
+    Index n = 3 * _n_atom_types;
+    m_sums.n_steps = 0;
+    m_sums.W = 0.0;
+    m_sums.G.setZero(m_prim_event_dR.size());
+    m_sums.SJ.setZero(n);
+    m_sums.X.setZero(n, n);
+    m_sums.R.setZero(n);
+    m_J.setZero(n);
+  }
+
+  /// \brief True if `add_step` accumulates sums
+  bool is_enabled() const { return m_is_enabled; }
+
+  /// \brief Total number of atoms
+  Index n_atoms() const { return m_n_atoms; }
+
+  /// \brief Add the expected change of a step, then the displacement of
+  ///     the selected event
+  ///
+  /// \param prim_event_total_rate The current total rate of each prim
+  ///     event, before the selected event is applied
+  /// \param prim_event_index The prim event index of the selected event
+  void add_step(std::vector<double> const &prim_event_total_rate,
+                Index prim_event_index) {
+    if (!m_is_enabled) {
+      return;
+    }
+    double total_rate = 0.0;
+    for (double rate : prim_event_total_rate) {
+      total_rate += rate;
+    }
+    if (total_rate > 0.0) {
+      double w = 1.0 / total_rate;
+      m_J.setZero();
+      for (Index p = 0; p < Index(m_prim_event_dR.size()); ++p) {
+        double rate = prim_event_total_rate[p];
+        if (rate == 0.0) {
+          continue;
+        }
+        m_sums.G(p) += w * rate;
+        for (auto const &d : m_prim_event_dR[p]) {
+          m_J.segment<3>(3 * d.atom_name_index) += rate * d.dR;
+        }
+      }
+      m_sums.W += w;
+      m_sums.SJ += w * m_J;
+      m_sums.X.noalias() += (w * m_sums.R) * m_J.transpose();
+    }
+    for (auto const &d : m_prim_event_dR[prim_event_index]) {
+      m_sums.R.segment<3>(3 * d.atom_name_index) += d.dR;
+    }
+    ++m_sums.n_steps;
+  }
+
+  /// \brief Cumulative sums, from `reset`
+  Snapshot const &sums() const { return m_sums; }
+
+  /// \brief Estimated second moment of the change in collective
+  ///     displacement, and elapsed time, since a snapshot
+  ///
+  /// \param prev Sums at the start of the interval, or default constructed
+  ///     to use the start of the run
+  /// \param E Set to the estimated `E[dR dR^T]`, where `dR` is the change
+  ///     in `R` since `prev`
+  ///
+  /// \returns The estimated elapsed time since `prev`
+  double second_moment(Snapshot const &prev, Eigen::MatrixXd &E) const {
+    Index n = m_sums.R.size();
+    bool is_start = (prev.R.size() != n);
+    Eigen::MatrixXd Y = m_sums.X;
+    Eigen::VectorXd dG = m_sums.G;
+    if (!is_start) {
+      Y -= prev.X;
+      Y.noalias() -= prev.R * (m_sums.SJ - prev.SJ).transpose();
+      dG -= prev.G;
+    }
+    E = Y + Y.transpose();
+    Eigen::VectorXd v(n);
+    for (Index p = 0; p < dG.size(); ++p) {
+      if (dG(p) == 0.0) {
+        continue;
+      }
+      v.setZero();
+      for (auto const &d : m_prim_event_dR[p]) {
+        v.segment<3>(3 * d.atom_name_index) += d.dR;
+      }
+      E.noalias() += dG(p) * v * v.transpose();
+    }
+    return is_start ? m_sums.W : m_sums.W - prev.W;
+  }
+
+ private:
+  bool m_is_enabled;
+  Index m_n_atoms;
+  std::vector<std::vector<PrimEventAtomDisplacement>> m_prim_event_dR;
+  Snapshot m_sums;
+
+  /// Scratch space
+  Eigen::VectorXd m_J;
+};
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -4,7 +4,13 @@
 #include <random>
 
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/methods/loop_profile.hh"
+#include "casm/clexmonte/methods/replica_exchange_metropolis.hh"
+#include "casm/clexmonte/methods/wang_landau.hh"
 #include "casm/clexmonte/monte_calculator/StateData.hh"
+#include "casm/clexmonte/run/MemoryReport.hh"
+#include "casm/clexmonte/run/TelemetryChannel.hh"
+#include "casm/clexmonte/run/RunControl.hh"
 #include "casm/clexmonte/run/StateModifyingFunction.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/misc/Validator.hh"
@@ -19,6 +25,10 @@ namespace clexmonte {
 
 class MonteCalculator;
 
+namespace kinetic {
+struct KineticEventData;
+}
+
 /// \brief Implements a potential
 class BaseMontePotential {
  public:
@@ -38,6 +48,27 @@ class BaseMontePotential {
   virtual double occ_delta_per_supercell(
       std::vector<Index> const &linear_site_index,
       std::vector<int> const &new_occ) = 0;
+
+  /// \brief Calculate the change in (per_supercell) potential value due to
+  ///     each of a batch of events, each relative to the current state
+  ///
+  /// The default implementation calls `occ_delta_per_supercell` for each
+  /// event. Derived potentials may override this to avoid per-event
+  /// dispatch.
+  ///
+  /// \param events The events
+  /// \param n_events The number of events to evaluate, `events[0]` to
+  ///     `events[n_events-1]`
+  /// \param delta Set to the change in potential value of each event, size
+  ///     `n_events`
+  virtual void occ_delta_per_supercell_batch(
+      std::vector<monte::OccEvent> const &events, Index n_events,
+      double *delta) {
+    for (Index i = 0; i < n_events; ++i) {
+      delta[i] = this->occ_delta_per_supercell(events[i].linear_site_index,
+                                               events[i].new_occ);
+    }
+  }
 };
 
 /// \brief Implements semi-grand canonical Monte Carlo calculations
@@ -135,6 +166,11 @@ class BaseMonteCalculator {
       bool write_status, std::optional<std::string> output_dir,
       std::optional<std::string> log_file, double log_frequency_in_s) const = 0;
 
+  /// \brief Construct lean SamplingFixtureParams for fast screening runs
+  virtual sampling_fixture_params_type make_screening_sampling_fixture_params(
+      std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+      bool write_results, std::optional<std::string> output_dir) const;
+
   /// \brief Validate the state's configuration
   virtual Validator validate_configuration(state_type &state) const = 0;
 
@@ -163,6 +199,29 @@ class BaseMonteCalculator {
   /// KMC data for sampling functions, for the current state (if applicable)
   std::shared_ptr<kmc_data_type> kmc_data;
 
+  /// \brief KMC event list and event calculators of the current or last run,
+  ///     or nullptr if not applicable
+  virtual std::shared_ptr<kinetic::KineticEventData> kinetic_event_data()
+      const {
+    return nullptr;
+  }
+
+  /// \brief Approximate memory used by each subsystem in the current or
+  ///     last run, or an empty report if not reported by the method
+  virtual MemoryReport memory_report() const { return MemoryReport(); }
+
+  /// Call counts and times of the phases of the main loop, from the last
+  /// single state Metropolis run, if built with CASM_CLEXMONTE_LOOP_PROFILE
+  LoopProfile loop_profile;
+
+  /// If not null, single state Metropolis runs publish run progress to this
+  /// channel
+  std::shared_ptr<TelemetryChannel> telemetry;
+
+  /// If not null, single state Metropolis runs may be stopped early or
+  /// extended by this run control
+  std::shared_ptr<RunControl> run_control;
+
   // --- Run method: ---
 
   /// \brief Perform a single run, evolving current state
@@ -188,6 +247,43 @@ class BaseMonteCalculator {
                    std::vector<monte::OccLocation> &occ_locations,
                    run_manager_type<engine_type> &run_manager) = 0;
 
+  /// Counts of attempted and accepted exchanges, from the last replica
+  /// exchange run
+  ReplicaExchangeCounts replica_exchange_counts;
+
+  /// \brief Perform a replica exchange (parallel tempering) run, evolving
+  ///     each state at its own conditions with its own run manager
+  virtual void run_replica_exchange(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<std::shared_ptr<run_manager_type<engine_type>>> const
+          &run_managers);
+
+  /// \brief Perform a run of independent chains of the same state, with
+  ///     observations of all chains pooled by one run manager
+  virtual void run_parallel_chains(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      run_manager_type<engine_type> &run_manager);
+
+  /// Density of states, from the last Wang-Landau run
+  WangLandauResults wang_landau_results;
+
+  /// \brief Perform a Wang-Landau run, estimating the density of states
+  ///     with one walker per energy window
+  virtual void run_wang_landau(std::vector<state_type> &states,
+                               std::vector<monte::OccLocation> &occ_locations,
+                               WangLandauParams const &params,
+                               std::shared_ptr<engine_type> engine);
+
+  /// \brief Index of the state evolved by the calling thread during a
+  ///     multi-state run of this calculator, else -1
+  int thread_current_state() const;
+
+  /// \brief Set the index of the state evolved by the calling thread during
+  ///     a multi-state run of this calculator, or -1 if none
+  void set_thread_current_state(int state_index) const;
+
   /// \brief Clone the BaseMonteCalculator
   std::unique_ptr<BaseMonteCalculator> clone() const;
 
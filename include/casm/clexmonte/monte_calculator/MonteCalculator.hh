@@ -34,6 +34,26 @@ class MontePotential {
     return m_pot->occ_delta_per_supercell(linear_site_index, new_occ);
   }
 
+  /// \brief Calculate the change in (per_supercell) potential value due to
+  ///     each of a batch of events, each relative to the current state
+  void occ_delta_per_supercell_batch(std::vector<monte::OccEvent> const &events,
+                                     Index n_events, double *delta) {
+    m_pot->occ_delta_per_supercell_batch(events, n_events, delta);
+  }
+
+  typedef Eigen::Matrix<Index, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>
+      site_index_batch_type;
+  typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      occ_batch_type;
+
+  /// \brief Calculate the change in (per_supercell) potential value due to
+  ///     each of a batch of independent events, given as arrays
+  void occ_delta_per_supercell_batch(
+      Eigen::Ref<site_index_batch_type const> const &linear_site_index,
+      Eigen::Ref<occ_batch_type const> const &new_occ,
+      Eigen::Ref<Eigen::VectorXd> delta);
+
  private:
   std::shared_ptr<BaseMontePotential> m_pot;
   std::shared_ptr<RuntimeLibrary> m_lib;
@@ -77,6 +97,11 @@ class MonteCalculator {
   /// Method tracks species locations? (like in KMC)
   bool update_species() const { return m_calc->update_species; }
 
+  /// \brief Construct a MonteCalculator with the same implementation,
+  ///     parameters, and system, and its own standard functions, which
+  ///     shares no calculation data with this one
+  std::shared_ptr<MonteCalculator> make_independent_copy() const;
+
   // --- Set at `reset`: ---
 
   /// \brief Set parameters, check for required system data, and reset derived
@@ -109,7 +134,14 @@ class MonteCalculator {
   // --- Set when `set_state_and_potential` or `run` is called: ---
 
   /// State data for sampling functions, for the current state
+  ///
+  /// During a multi-state run, this is the state data of the state evolved by
+  /// the calling thread.
   std::shared_ptr<StateData> state_data() {
+    int index = m_calc->thread_current_state();
+    if (index >= 0) {
+      return m_calc->multistate_data.at(index);
+    }
     if (m_calc->state_data == nullptr) {
       throw std::runtime_error(
           "Error in MonteCalculator::state_data: State data is not "
@@ -120,7 +152,14 @@ class MonteCalculator {
   }
 
   /// \brief Potential calculator
+  ///
+  /// During a multi-state run, this is the potential calculator of the state
+  /// evolved by the calling thread.
   MontePotential potential() {
+    int index = m_calc->thread_current_state();
+    if (index >= 0) {
+      return MontePotential(m_calc->multistate_potential.at(index), m_lib);
+    }
     if (m_calc->potential == nullptr) {
       throw std::runtime_error(
           "Error in MonteCalculator::potential: Potential calculator is not "
@@ -164,6 +203,22 @@ class MonteCalculator {
     return m_calc->kmc_data;
   }
 
+  /// KMC event list and event calculators, for the current or last run (if
+  /// applicable)
+  std::shared_ptr<kinetic::KineticEventData> kinetic_event_data() {
+    auto event_data = m_calc->kinetic_event_data();
+    if (event_data == nullptr) {
+      throw std::runtime_error(
+          "Error in MonteCalculator::kinetic_event_data: KMC event data is "
+          "not yet constructed.");
+    }
+    return event_data;
+  }
+
+  /// \brief Approximate memory used by each subsystem in the current or
+  ///     last run, or an empty report if not reported by the method
+  MemoryReport memory_report() const { return m_calc->memory_report(); }
+
   /// \brief Perform a single run, evolving current state
   void run(state_type &state, monte::OccLocation &occ_location,
            run_manager_type<engine_type> &run_manager) {
@@ -214,6 +269,15 @@ class MonteCalculator {
         write_status, output_dir, log_file, log_frequency_in_s);
   }
 
+  /// \brief Construct lean SamplingFixtureParams for fast screening runs
+  sampling_fixture_params_type make_screening_sampling_fixture_params(
+      std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+      bool write_results = true,
+      std::optional<std::string> output_dir = std::nullopt) const {
+    return m_calc->make_screening_sampling_fixture_params(
+        calculation, label, write_results, output_dir);
+  }
+
   // --- Experimental, to support multi-state methods: ---
 
   /// \brief Check if a multi-state method
@@ -223,7 +287,13 @@ class MonteCalculator {
   int n_states() const { return m_calc->multistate_data.size(); }
 
   /// \brief Current state index
-  int current_state() const { return m_calc->current_state; }
+  ///
+  /// During a multi-state run, this is the index of the state evolved by the
+  /// calling thread.
+  int current_state() const {
+    int index = m_calc->thread_current_state();
+    return index >= 0 ? index : m_calc->current_state;
+  }
 
   /// \brief State data for sampling functions, for specified state
   std::shared_ptr<StateData> multistate_state_data(int state_index) {
@@ -242,6 +312,73 @@ class MonteCalculator {
     m_calc->run(current_state, states, occ_locations, run_manager);
   }
 
+  /// \brief Perform a replica exchange (parallel tempering) run, evolving
+  ///     each state at its own conditions with its own run manager
+  void run_replica_exchange(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<std::shared_ptr<run_manager_type<engine_type>>> const
+          &run_managers) {
+    m_calc->run_replica_exchange(states, occ_locations, run_managers);
+  }
+
+  /// \brief Perform a run of independent chains of the same state, with
+  ///     observations of all chains pooled by one run manager
+  void run_parallel_chains(std::vector<state_type> &states,
+                           std::vector<monte::OccLocation> &occ_locations,
+                           run_manager_type<engine_type> &run_manager) {
+    m_calc->run_parallel_chains(states, occ_locations, run_manager);
+  }
+
+  /// \brief Perform a Wang-Landau run, estimating the density of states
+  ///     with one walker per energy window
+  void run_wang_landau(std::vector<state_type> &states,
+                       std::vector<monte::OccLocation> &occ_locations,
+                       WangLandauParams const &params,
+                       std::shared_ptr<engine_type> engine) {
+    m_calc->run_wang_landau(states, occ_locations, params, engine);
+  }
+
+  /// \brief Density of states, from the last Wang-Landau run
+  WangLandauResults const &wang_landau_results() const {
+    return m_calc->wang_landau_results;
+  }
+
+  /// \brief Counts of attempted and accepted exchanges, from the last
+  ///     replica exchange run
+  ReplicaExchangeCounts const &replica_exchange_counts() const {
+    return m_calc->replica_exchange_counts;
+  }
+
+  /// \brief Call counts and times of the phases of the main loop, from the
+  ///     last single state Metropolis run, if built with
+  ///     CASM_CLEXMONTE_LOOP_PROFILE
+  LoopProfile const &loop_profile() const { return m_calc->loop_profile; }
+
+  /// \brief Channel that single state Metropolis runs publish run progress
+  ///     to, or nullptr
+  std::shared_ptr<TelemetryChannel> telemetry() const {
+    return m_calc->telemetry;
+  }
+
+  /// \brief Set the channel that single state Metropolis runs publish run
+  ///     progress to, or nullptr to stop publishing
+  void set_telemetry(std::shared_ptr<TelemetryChannel> _telemetry) {
+    m_calc->telemetry = _telemetry;
+  }
+
+  /// \brief Run control that may stop or extend single state Metropolis
+  ///     runs, or nullptr
+  std::shared_ptr<RunControl> run_control() const {
+    return m_calc->run_control;
+  }
+
+  /// \brief Set the run control that may stop or extend single state
+  ///     Metropolis runs, or nullptr to use only the completion checks
+  void set_run_control(std::shared_ptr<RunControl> _run_control) {
+    m_calc->run_control = _run_control;
+  }
+
  private:
   notstd::cloneable_ptr<BaseMonteCalculator> m_calc;
   std::shared_ptr<RuntimeLibrary> m_lib;
@@ -0,0 +1,49 @@
+#ifndef CASM_clexmonte_monte_calculator_MonteCalculatorCache
+#define CASM_clexmonte_monte_calculator_MonteCalculatorCache
+
+#include <optional>
+#include <string>
+
+#include "casm/clexmonte/system/ClexulatorCache.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A content-addressed, on-disk cache of compiled custom
+///     MonteCalculator libraries
+///
+/// Each entry is a copy of the directory containing a MonteCalculator
+/// source file, in which the calculator is compiled once and reused by
+/// later jobs and workers. The key is a hash of the contents of the source
+/// directory (except compiled files), the calculator name, the compile and
+/// shared object options, the plugin API version of the headers, and the
+/// compiler environment variables (see `acquire_source_dir_cache_entry`),
+/// so a change to any of them makes a new entry.
+///
+/// As for ClexulatorCache, concurrent jobs sharing one cache directory take
+/// the entry's lock while it is populated, compiled, and loaded, so only
+/// the first job compiles and the others load the result.
+class MonteCalculatorCache {
+ public:
+  explicit MonteCalculatorCache(fs::path _cache_dir);
+
+  /// \brief Cache directory
+  fs::path const cache_dir;
+
+  /// \brief Lock, and populate if necessary, the cache entry for a
+  ///     MonteCalculator source file
+  SourceDirCacheEntry acquire(fs::path dirpath, std::string calculator_name,
+                              std::string const &compile_options,
+                              std::string const &so_options) const;
+};
+
+/// \brief Return the MonteCalculator cache directory, from the JSON input or
+///     the CASM_MONTE_CALCULATOR_CACHE_DIR environment variable, if set
+std::optional<fs::path> default_monte_calculator_cache_dir(
+    std::optional<std::string> cache_dir_input);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -4,6 +4,11 @@
 #include <random>
 
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/state/ClexTrackers.hh"
+#include "casm/clexmonte/state/ComponentCounts.hh"
+#include "casm/clexmonte/state/Conditions.hh"
+#include "casm/clexmonte/state/ParallelCorrelations.hh"
+#include "casm/clexmonte/state/SampleCache.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/monte/RandomNumberGenerator.hh"
@@ -24,12 +29,25 @@ struct StateData {
   /// Occupant tracker (may be null)
   monte::OccLocation const *occ_location;
 
+  /// Conditions, made once from `state->conditions` (not null)
+  ///
+  /// Use this rather than `state->conditions` to read conditions without
+  /// string-keyed lookups or recalculating derived values, such as `beta`
+  /// and `exchange_chem_pot`.
+  std::shared_ptr<Conditions const> conditions;
+
   /// Current supercell, depends on current state
   Eigen::Matrix3l transformation_matrix_to_super;
 
   /// Number of unit cells, depends on current state
   Index n_unitcells;
 
+  /// Supercell data, depends on current state (not null)
+  ///
+  /// Held so that `convert` and the supercell calculators remain valid if
+  /// the supercell data is evicted from `system->supercell_data`.
+  std::shared_ptr<SupercellSystemData> supercell_data;
+
   /// Index conversions, depends on current state (not null)
   monte::Conversions const *convert;
 
@@ -40,6 +58,14 @@ struct StateData {
   std::map<std::string, std::shared_ptr<clexulator::LocalCorrelations>>
       local_corr;
 
+  /// Multi-threaded full supercell correlation calculators, by basis set
+  /// name (empty unless set by `set_parallel_corr`)
+  ///
+  /// If set, sampling functions use these rather than `corr` or `clex` to
+  /// calculate correlations and cluster expansion values for the full
+  /// supercell.
+  std::map<std::string, std::shared_ptr<ParallelCorrelations>> parallel_corr;
+
   /// Cluster expansion calculators, set for current state
   std::map<std::string, std::shared_ptr<clexulator::ClusterExpansion>> clex;
 
@@ -58,8 +84,36 @@ struct StateData {
   /// Order parameter calculators, set for current state
   std::map<std::string, std::shared_ptr<clexulator::OrderParameter>>
       order_parameters;
+
+  /// Number of each component, updated as events are applied during a run
+  /// (may be null)
+  ///
+  /// If not null, sampling functions may use this rather than counting
+  /// components from the occupation. Only set while all changes to the
+  /// occupation are made by events that update it.
+  std::shared_ptr<ComponentCounts> component_counts;
+
+  /// Correlations and cluster expansion values, updated as events are
+  /// applied during a run (may be null)
+  ///
+  /// If not null, sampling functions may use this rather than calculating
+  /// correlations for the full supercell. Only set while all changes to the
+  /// occupation are made by events that update it.
+  std::shared_ptr<ClexTrackers> clex_trackers;
+
+  /// Intermediate values shared by sampling functions (may be null)
+  ///
+  /// If not null, sampling functions calculate shared intermediate values,
+  /// such as the composition and order parameters, once per sample. Only set
+  /// while all changes to the occupation are made by events that invalidate
+  /// it.
+  std::shared_ptr<SampleCache> sample_cache;
 };
 
+/// \brief Set `StateData::parallel_corr` to calculate full supercell
+///     correlations using multiple threads
+void set_parallel_corr(StateData &state_data, Index n_threads);
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -34,6 +34,11 @@ results_analysis_function_type make_mol_thermochem_susc_f(
 results_analysis_function_type make_param_thermochem_susc_f(
     std::shared_ptr<MonteCalculator> const &calculation);
 
+/// \brief Make cluster expansion coefficients ensemble analysis function
+///     ("eci_ensemble.<key>")
+results_analysis_function_type make_eci_ensemble_f(
+    std::shared_ptr<MonteCalculator> const &calculation, std::string key);
+
 }  // namespace monte_calculator
 }  // namespace clexmonte
 }  // namespace CASM
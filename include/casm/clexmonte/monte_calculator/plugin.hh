@@ -0,0 +1,48 @@
+#ifndef CASM_clexmonte_monte_calculator_plugin
+#define CASM_clexmonte_monte_calculator_plugin
+
+/// \file
+/// \brief Headers available to custom MonteCalculator plugins
+///
+/// A custom MonteCalculator, compiled and loaded by
+/// `make_monte_calculator_from_source`, may include this header to use the
+/// building blocks of the standard calculators:
+///
+/// - Calculator interface: BaseMonteCalculator, BaseMontePotential
+///   (including `occ_delta_per_supercell_batch`), StateData, and the
+///   standard sampling, analysis, and modifying function factories in
+///   `monte_calculator`.
+/// - Metropolis loops: `occupation_metropolis_v2`,
+///   `occupation_metropolis_batched`, and MetropolisAcceptanceTable.
+/// - Incrementally updated state: ComponentCounts and ClexTrackers.
+/// - Events: EventDataList, with structure-of-arrays site storage, impact
+///   tables, event selectors, and the kinetic event calculators.
+/// - Threading: ThreadPool.
+/// - Sampling: BatchedSamplingFunction.
+///
+/// The interfaces of these headers are versioned by
+/// CASM_CLEXMONTE_PLUGIN_API_VERSION. Plugins should declare the version
+/// they are compiled against with `CASM_CLEXMONTE_PLUGIN(<calculator_name>)`,
+/// so that loading a plugin compiled against a different version fails with
+/// an error rather than undefined behavior. Other headers may change without
+/// a change of version.
+
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_selectors.hh"
+#include "casm/clexmonte/kinetic/kinetic_events.hh"
+#include "casm/clexmonte/methods/metropolis_acceptance_table.hh"
+#include "casm/clexmonte/methods/occupation_metropolis.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/monte_calculator/BaseMonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/StateData.hh"
+#include "casm/clexmonte/monte_calculator/analysis_functions.hh"
+#include "casm/clexmonte/monte_calculator/modifying_functions.hh"
+#include "casm/clexmonte/monte_calculator/plugin_api_version.hh"
+#include "casm/clexmonte/monte_calculator/sampling_functions.hh"
+#include "casm/clexmonte/run/BatchedSamplingFunction.hh"
+#include "casm/clexmonte/state/ClexTrackers.hh"
+#include "casm/clexmonte/state/ComponentCounts.hh"
+
+#endif
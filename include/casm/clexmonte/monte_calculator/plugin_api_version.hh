@@ -0,0 +1,23 @@
+#ifndef CASM_clexmonte_monte_calculator_plugin_api_version
+#define CASM_clexmonte_monte_calculator_plugin_api_version
+
+/// \brief Version of the MonteCalculator plugin API
+///
+/// Incremented when a header included by
+/// "casm/clexmonte/monte_calculator/plugin.hh" changes in a way that breaks
+/// source or binary compatibility of compiled plugins.
+#define CASM_CLEXMONTE_PLUGIN_API_VERSION 1
+
+/// \brief Declare the plugin API version a custom MonteCalculator is compiled
+///     against
+///
+/// Use once in a custom MonteCalculator source file, with the same
+/// `calculator_name` as the factory function `make_<calculator_name>`. It
+/// defines `extern "C" int <calculator_name>_plugin_api_version()`, which is
+/// checked by `make_monte_calculator_from_source` when the plugin is loaded.
+#define CASM_CLEXMONTE_PLUGIN(calculator_name)            \
+  extern "C" int calculator_name##_plugin_api_version() { \
+    return CASM_CLEXMONTE_PLUGIN_API_VERSION;             \
+  }
+
+#endif
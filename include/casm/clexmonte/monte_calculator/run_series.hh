@@ -0,0 +1,40 @@
+#ifndef CASM_clexmonte_monte_calculator_run_series
+#define CASM_clexmonte_monte_calculator_run_series
+
+#include <memory>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
+#include "casm/clexmonte/run/AutoEquilibration.hh"
+#include "casm/clexmonte/run/RunData.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace monte_calculator {
+
+/// \brief Construct a StateGenerator from JSON, for a series of runs with a
+///     MonteCalculator
+std::unique_ptr<state_generator_type> make_state_generator(
+    jsonParser const &json, std::shared_ptr<MonteCalculator> const &calculator);
+
+/// \brief Perform a series of runs with a MonteCalculator, according to a
+///     state generator
+std::vector<RunData> run_series(
+    std::shared_ptr<MonteCalculator> const &calculator,
+    std::shared_ptr<MonteCalculator::engine_type> engine,
+    state_generator_type &state_generator,
+    std::vector<sampling_fixture_params_type> const &sampling_fixture_params,
+    bool global_cutoff = true,
+    std::vector<sampling_fixture_params_type> const &before_first_run =
+        std::vector<sampling_fixture_params_type>({}),
+    std::vector<sampling_fixture_params_type> const &before_each_run =
+        std::vector<sampling_fixture_params_type>({}),
+    Index n_threads = 1,
+    std::shared_ptr<AutoEquilibration> auto_equilibration = nullptr);
+
+}  // namespace monte_calculator
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold
+#define CASM_clexmonte_nfold_canonical_nfold
+
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/events/EventSelectorParams.hh"
+#include "casm/clexmonte/nfold/canonical_nfold_events.hh"
+#include "casm/monte/methods/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Implements canonical N-fold way Monte Carlo calculations
+///
+/// Events are swaps of the occupants of nearby sites, as constructed by
+/// `make_canonical_swap_event_type_data`, so composition is conserved.
+template <typename EngineType>
+struct CanonicalNfold : public canonical::Canonical<EngineType> {
+  typedef EngineType engine_type;
+
+  explicit CanonicalNfold(std::shared_ptr<system_type> _system);
+
+  /// Method allows time-based sampling
+  bool time_sampling_allowed = true;
+
+  /// Data for N-fold way implementation
+  std::shared_ptr<CanonicalNfoldEventData> event_data;
+
+  /// Event selector method
+  EventSelectorParams event_selector_params;
+
+  /// Data for sampling functions
+  monte::NfoldData<config_type, statistics_type, engine_type> nfold_data;
+
+  /// \brief Perform a single run, evolving current state
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<EngineType> &run_manager);
+
+  typedef canonical::Canonical<EngineType> Base;
+  using Base::standard_analysis_functions;
+  using Base::standard_json_sampling_functions;
+  using Base::standard_modifying_functions;
+  using Base::standard_sampling_functions;
+};
+
+/// \brief Explicitly instantiated CanonicalNfold calculator
+typedef CanonicalNfold<std::mt19937_64> CanonicalNfold_mt19937_64;
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
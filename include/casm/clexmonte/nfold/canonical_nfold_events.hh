@@ -0,0 +1,84 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold_events
+#define CASM_clexmonte_nfold_canonical_nfold_events
+
+#include <random>
+
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/nfold/nfold_events.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Event calculator for canonical N-fold way calculations, with the
+///     required interface for the classes `lotto::RejectionFree` and
+///     `lotto::Rejection`.
+///
+/// Notes:
+/// - Expected to be constructed as shared_ptr
+/// - Mostly holds references to external data structures
+/// - Stores one `EventState` which is used to perform the calculations
+struct CanonicalCompleteEventCalculator {
+  /// \brief Prim event list
+  std::vector<PrimEventData> const &prim_event_list;
+
+  /// \brief Complete event list
+  EventDataList const &event_list;
+
+  /// \brief Holds last calculated event state
+  EventState event_state;
+
+  /// \brief Potential
+  std::shared_ptr<canonical::CanonicalPotential> potential;
+
+  CanonicalCompleteEventCalculator(
+      std::shared_ptr<canonical::CanonicalPotential> _potential,
+      std::vector<PrimEventData> const &_prim_event_list,
+      EventDataList const &_event_list);
+
+  /// \brief Calculate the rate of the event with the given event ID
+  double calculate_rate(EventID const &id);
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates);
+
+  /// \brief Notify that an event occurred (no cached data to update)
+  void set_occurred_event(EventID const &id) {}
+};
+
+/// \brief Make OccEventTypeData for canonical swap events
+std::map<std::string, OccEventTypeData> make_canonical_swap_event_type_data(
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::vector<monte::OccSwap> const &canonical_swaps);
+
+struct CanonicalNfoldEventData {
+  CanonicalNfoldEventData(
+      std::shared_ptr<system_type> system, state_type const &state,
+      monte::OccLocation const &occ_location,
+      std::vector<monte::OccSwap> const &canonical_swaps,
+      std::shared_ptr<canonical::CanonicalPotential> potential);
+
+  /// The `prim events`, one translationally distinct instance
+  /// of each event, associated with origin primitive cell
+  std::vector<clexmonte::PrimEventData> prim_event_list;
+
+  /// Information about what sites may impact each prim event
+  std::vector<clexmonte::EventImpactInfo> prim_impact_info_list;
+
+  /// All supercell events, and which events must be updated
+  /// when one occurs
+  clexmonte::CompleteEventList event_list;
+
+  /// Calculator for N-fold way event selection
+  std::shared_ptr<CanonicalCompleteEventCalculator> event_calculator;
+};
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
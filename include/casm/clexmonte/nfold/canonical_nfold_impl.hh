@@ -0,0 +1,121 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold_impl
+#define CASM_clexmonte_nfold_canonical_nfold_impl
+
+#include "casm/clexmonte/canonical/canonical_impl.hh"
+#include "casm/clexmonte/events/event_selectors.hh"
+#include "casm/clexmonte/nfold/canonical_nfold.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/methods/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+template <typename EngineType>
+CanonicalNfold<EngineType>::CanonicalNfold(
+    std::shared_ptr<system_type> _system)
+    : canonical::Canonical<EngineType>(_system) {}
+
+/// \brief Perform a single run, evolving current state
+///
+/// Notes:
+/// - state and occ_location are evolved and end in modified states
+/// - The composition of the state is first set to `mol_composition`, as
+///   for `canonical::Canonical`
+/// - Each event rate is the Metropolis acceptance probability of the event,
+///   so the number of steps counted per accepted event is the expected
+///   number of steps of a Metropolis calculation that proposes each event
+///   in the complete event list with equal probability
+template <typename EngineType>
+void CanonicalNfold<EngineType>::run(
+    state_type &state, monte::OccLocation &occ_location,
+    run_manager_type<EngineType> &run_manager) {
+  if (!state.conditions.scalar_values.count("temperature")) {
+    throw std::runtime_error(
+        "Error in CanonicalNfold::run: state `temperature` not set.");
+  }
+  if (!state.conditions.vector_values.count("mol_composition")) {
+    throw std::runtime_error(
+        "Error in CanonicalNfold::run: state `mol_composition` conditions not "
+        "set.");
+  }
+
+  // Store state info / pointers
+  this->state = &state;
+  this->occ_location = &occ_location;
+  this->conditions = clexmonte::make_conditions(*this->system, state);
+
+  // Make potential calculator
+  this->potential =
+      std::make_shared<canonical::CanonicalPotential>(this->system);
+  this->potential->set(this->state, this->conditions);
+  this->formation_energy = this->potential->formation_energy();
+
+  // Get swaps
+  std::vector<monte::OccSwap> const &canonical_swaps =
+      get_canonical_swaps(*this->system);
+  std::vector<monte::OccSwap> const &semigrand_canonical_swaps =
+      get_semigrand_canonical_swaps(*this->system);
+
+  // Enforce composition
+  monte::RandomNumberGenerator<EngineType> random_number_generator(
+      run_manager.engine);
+  clexmonte::enforce_composition(
+      get_occupation(state), *this->conditions->mol_composition,
+      get_composition_calculator(*this->system), semigrand_canonical_swaps,
+      occ_location, random_number_generator);
+
+  // if same supercell
+  // -> just re-set potential & avoid re-constructing event list
+  Index n_unitcells;
+  if (this->event_data != nullptr &&
+      this->transformation_matrix_to_super ==
+          get_transformation_matrix_to_super(state)) {
+    n_unitcells = this->transformation_matrix_to_super.determinant();
+    this->event_data->event_calculator->potential = this->potential;
+  } else {
+    this->transformation_matrix_to_super =
+        get_transformation_matrix_to_super(state);
+    n_unitcells = this->transformation_matrix_to_super.determinant();
+
+    // Event data
+    this->event_data = std::make_shared<CanonicalNfoldEventData>(
+        this->system, state, occ_location, canonical_swaps, this->potential);
+
+    // Nfold data
+    this->nfold_data.n_events_possible =
+        static_cast<double>(n_unitcells) *
+        this->event_data->prim_event_list.size();
+  }
+
+  // Used to apply selected events: EventID -> monte::OccEvent
+  // Returns a reference to the stored event, so that no monte::OccEvent (and
+  // its vectors) is copied per step
+  auto get_event_f =
+      [&](EventID const &selected_event_id) -> monte::OccEvent const & {
+    return this->event_data->event_list.events.at(selected_event_id).event;
+  };
+
+  // Make selector & run nfold-way
+  // Only included events are selectable, for all selectors, so events
+  // removed by event filters do not take space in the selector
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(this->event_data->event_list.events);
+  auto run_nfold = [&](auto &event_selector) {
+    monte::nfold<EventID>(state, occ_location, this->nfold_data,
+                          event_selector, get_event_f, run_manager);
+  };
+  run_with_event_selector(
+      this->event_selector_params, this->event_data->event_calculator,
+      n_unitcells, this->event_data->prim_event_list.size(), event_id_list,
+      this->event_data->event_list.impact_table, run_manager.engine,
+      run_nfold);
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold_json_io
+#define CASM_clexmonte_nfold_canonical_nfold_json_io
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/events/io/json/EventSelectorParams_json_io.hh"
+#include "casm/clexmonte/nfold/canonical_nfold_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Parse CanonicalNfold "calculation_options"
+///
+/// \tparam EngineType
+/// \param parser
+/// \param system
+/// \param random_number_engine (Unused)
+///
+/// Expected format:
+/// \code
+///   "event_selector": <clexmonte::EventSelectorParams> (optional)
+///       Chooses the event selector method. Has the format:
+///
+///     "type": string (required)
+///         One of "lotto_rejection_free" (default), "sum_tree",
+///         "grouped_sum_tree", "composition_rejection", or "rejection".
+///     "max_rate": number (optional, default=0.0)
+///         For "rejection", the upper bound on event rates. If <= 0.0,
+///         "max_rate_factor" times the maximum initial event rate is used.
+///     "max_rate_factor": number (optional, default=10.0)
+///         For "rejection", used if "max_rate" <= 0.0.
+///
+/// \endcode
+///
+template <typename EngineType>
+void parse(InputParser<CanonicalNfold<EngineType>> &parser,
+           std::shared_ptr<system_type> system,
+           std::shared_ptr<EngineType> random_number_engine =
+               std::shared_ptr<EngineType>()) {
+  // "event_selector"
+  EventSelectorParams event_selector_params;
+  if (parser.self.contains("event_selector")) {
+    auto subparser =
+        parser.template subparse<EventSelectorParams>("event_selector");
+    if (subparser->valid()) {
+      event_selector_params = std::move(*subparser->value);
+    }
+  }
+  if (event_selector_params.type == EventSelectorType::defect) {
+    parser.insert_error("event_selector",
+                        "Error: the \"defect\" event selector is only "
+                        "available for KMC");
+  }
+  if (event_selector_params.type ==
+      EventSelectorType::synchronous_sublattice) {
+    parser.insert_error("event_selector",
+                        "Error: the \"synchronous_sublattice\" event "
+                        "selector is only available for KMC");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<CanonicalNfold<EngineType>>(system);
+    parser.value->event_selector_params = event_selector_params;
+  }
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_nfold
 #define CASM_clexmonte_nfold
 
+#include "casm/clexmonte/events/EventSelectorParams.hh"
+#include "casm/clexmonte/events/SumTreeEventSelector.hh"
 #include "casm/clexmonte/nfold/nfold_events.hh"
 #include "casm/clexmonte/semigrand_canonical/calculator.hh"
 #include "casm/monte/methods/nfold.hh"
@@ -12,6 +14,23 @@ namespace nfold {
 using semigrand_canonical::make_conditions;
 using semigrand_canonical::make_conditions_increment;
 
+/// \brief Parameters for choosing between Metropolis and N-fold way runs by
+///     acceptance rate
+struct AdaptiveMethodParams {
+  /// \brief If true, the first run uses the Metropolis method, and the
+  ///     method of each following run is chosen by the acceptance rate of the
+  ///     previous run. If false, all runs use the N-fold way.
+  bool enabled = false;
+
+  /// \brief After a Metropolis run with acceptance rate below this, the next
+  ///     run uses the N-fold way
+  double nfold_below = 0.05;
+
+  /// \brief After an N-fold way run ending with mean event acceptance
+  ///     probability above this, the next run uses the Metropolis method
+  double metropolis_above = 0.2;
+};
+
 /// \brief Implements semi-grand canonical Monte Carlo calculations
 template <typename EngineType>
 struct Nfold : public semigrand_canonical::SemiGrandCanonical<EngineType> {
@@ -25,13 +44,42 @@ struct Nfold : public semigrand_canonical::SemiGrandCanonical<EngineType> {
   /// Data for N-fold way implementation
   std::shared_ptr<NfoldEventData> event_data;
 
+  /// Supercell `event_data` was constructed for
+  Eigen::Matrix3l event_data_transformation_matrix_to_super;
+
+  /// Event selector method
+  EventSelectorParams event_selector_params;
+
+  typedef SumTreeEventSelector<CompleteEventCalculator,
+                               std::map<EventID, std::vector<EventID>>,
+                               EngineType>
+      sum_tree_selector_type;
+
+  /// For the "sum_tree" event selector, the selector is kept while the
+  /// supercell is unchanged, and only its rates are recalculated for each run
+  std::shared_ptr<sum_tree_selector_type> sum_tree_selector;
+
   /// Data for sampling functions
   monte::NfoldData<config_type, statistics_type, engine_type> nfold_data;
 
+  /// Choice of Metropolis or N-fold way runs by acceptance rate
+  AdaptiveMethodParams adaptive_method_params;
+
+  /// If true, the next run uses the N-fold way, else the Metropolis method
+  bool use_nfold = true;
+
+  /// Acceptance rate of the last run, if Metropolis, or the mean event
+  /// acceptance probability at the end of the last run, if N-fold way
+  double acceptance_rate = 0.0;
+
   /// \brief Perform a single run, evolving current state
   void run(state_type &state, monte::OccLocation &occ_location,
            run_manager_type<EngineType> &run_manager);
 
+  /// \brief Perform a single N-fold way run, evolving current state
+  void run_nfold(state_type &state, monte::OccLocation &occ_location,
+                 run_manager_type<EngineType> &run_manager);
+
   typedef semigrand_canonical::SemiGrandCanonical<EngineType> Base;
   using Base::standard_analysis_functions;
   using Base::standard_json_sampling_functions;
@@ -9,6 +9,10 @@
 #include "casm/clexmonte/semigrand_canonical/potential.hh"
 
 namespace CASM {
+namespace monte {
+class Conversions;
+}
+
 namespace clexmonte {
 namespace nfold {
 
@@ -31,22 +35,59 @@ struct CompleteEventCalculator {
   std::vector<PrimEventData> const &prim_event_list;
 
   /// \brief Complete event list
-  std::map<EventID, EventData> const &event_list;
+  EventDataList const &event_list;
 
   /// \brief Holds last calculated event state
   EventState event_state;
 
-  /// \brief Potential
+  /// \brief Potential (set with `set_potential`)
   std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential> potential;
 
+  /// \brief Initial and final species index of each site of each prim event
+  std::vector<std::vector<std::pair<Index, Index>>> prim_event_species;
+
+  /// \brief Change in the exchange chemical potential term of the potential,
+  ///     `-sum_i exchange_chem_pot(final_species_i, init_species_i)`, due to
+  ///     each prim event, at the current conditions
+  std::vector<double> prim_event_delta_chem_pot;
+
+  /// \brief Scratch space used by `calculate_rates` to group events by
+  ///     prim_event_index
+  std::vector<Index> batch_offsets;
+
+  /// \brief Scratch space used by `calculate_rates` to group events by
+  ///     prim_event_index
+  std::vector<Index> batch_order;
+
   CompleteEventCalculator(
       std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
           _potential,
       std::vector<PrimEventData> const &_prim_event_list,
-      std::map<EventID, EventData> const &_event_list);
+      EventDataList const &_event_list, monte::Conversions const &convert);
+
+  /// \brief Set the potential, and the exchange chemical potential change
+  ///     due to each prim event at its conditions
+  void set_potential(
+      std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
+          _potential);
 
   /// \brief Get CASM::monte::OccEvent corresponding to given event ID
   double calculate_rate(EventID const &id);
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(std::vector<EventID> const &event_id_list,
+                       std::vector<double> &rates);
+
+  /// \brief Notify that an event occurred (no cached data to update)
+  void set_occurred_event(EventID const &id) {}
+
+ private:
+  double _calculate_rate(EventData const &event_data,
+                         PrimEventData const &prim_event_data,
+                         double delta_chem_pot,
+                         Eigen::VectorXi const &occupation,
+                         clexulator::ClusterExpansion &formation_energy,
+                         double beta);
 };
 
 struct NfoldEventData {
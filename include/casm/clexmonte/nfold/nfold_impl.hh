@@ -1,6 +1,7 @@
 #ifndef CASM_clexmonte_nfold_impl
 #define CASM_clexmonte_nfold_impl
 
+#include "casm/clexmonte/events/event_selectors.hh"
 #include "casm/clexmonte/nfold/nfold.hh"
 #include "casm/clexmonte/semigrand_canonical/calculator_impl.hh"
 #include "casm/clexmonte/state/Configuration.hh"
@@ -19,9 +20,55 @@ Nfold<EngineType>::Nfold(std::shared_ptr<system_type> _system)
 ///
 /// Notes:
 /// - state and occ_location are evolved and end in modified states
+/// - If `adaptive_method_params.enabled`, each run uses either the
+///   Metropolis method or the N-fold way, chosen by the acceptance rate of
+///   the previous run. Each run uses a single method, and both sample the
+///   same ensemble, so results of runs using either method are consistent.
+///   Time-based sampling is only meaningful for N-fold way runs.
 template <typename EngineType>
 void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
                             run_manager_type<EngineType> &run_manager) {
+  if (!this->adaptive_method_params.enabled) {
+    this->run_nfold(state, occ_location, run_manager);
+    return;
+  }
+  AdaptiveMethodParams const &params = this->adaptive_method_params;
+
+  if (!this->use_nfold) {
+    Base::run(state, occ_location, run_manager);
+    this->acceptance_rate =
+        this->n_proposed ? double(this->n_accepted) / this->n_proposed : 1.0;
+    if (this->acceptance_rate < params.nfold_below) {
+      this->use_nfold = true;
+    }
+    return;
+  }
+
+  this->run_nfold(state, occ_location, run_manager);
+
+  // Mean acceptance probability of all possible events in the final state
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(this->event_data->event_list.events);
+  std::vector<double> rates;
+  this->event_data->event_calculator->calculate_rates(event_id_list, rates);
+  double total_rate = 0.0;
+  for (double rate : rates) {
+    total_rate += rate;
+  }
+  this->acceptance_rate = total_rate / this->nfold_data.n_events_possible;
+  if (this->acceptance_rate > params.metropolis_above) {
+    this->use_nfold = false;
+  }
+}
+
+/// \brief Perform a single N-fold way run, evolving current state
+///
+/// Notes:
+/// - state and occ_location are evolved and end in modified states
+template <typename EngineType>
+void Nfold<EngineType>::run_nfold(state_type &state,
+                                  monte::OccLocation &occ_location,
+                                  run_manager_type<EngineType> &run_manager) {
   if (!state.conditions.scalar_values.count("temperature")) {
     throw std::runtime_error(
         "Error in Canonical::run: state `temperature` not set.");
@@ -38,7 +85,7 @@ void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
       std::make_shared<semigrand_canonical::SemiGrandCanonicalConditions>(
           get_composition_converter(*this->system));
   this->conditions->set_all(state.conditions, false);
-  Index n_unitcells = this->transformation_matrix_to_super.determinant();
+  Index n_unitcells = get_transformation_matrix_to_super(state).determinant();
 
   // Make potential calculator
   this->potential =
@@ -53,19 +100,22 @@ void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
 
   // if same supercell
   // -> just re-set potential & avoid re-constructing event list
-  if (this->transformation_matrix_to_super ==
-          get_transformation_matrix_to_super(state) &&
-      this->conditions != nullptr) {
-    this->event_data->event_calculator->potential = this->potential;
+  if (this->event_data != nullptr &&
+      this->event_data_transformation_matrix_to_super ==
+          get_transformation_matrix_to_super(state)) {
+    this->event_data->event_calculator->set_potential(this->potential);
   } else {
     this->transformation_matrix_to_super =
         get_transformation_matrix_to_super(state);
+    this->event_data_transformation_matrix_to_super =
+        this->transformation_matrix_to_super;
     n_unitcells = this->transformation_matrix_to_super.determinant();
 
     // Event data
     this->event_data = std::make_shared<NfoldEventData>(
         this->system, state, occ_location, semigrand_canonical_swaps,
         this->potential);
+    this->sum_tree_selector.reset();
 
     // Nfold data
     monte::Conversions const &convert =
@@ -76,23 +126,41 @@ void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
         static_cast<double>(n_unitcells) * n_allowed_per_unitcell;
   }
 
-  // Make selector
-  lotto::RejectionFreeEventSelector event_selector(
-      this->event_data->event_calculator,
-      clexmonte::make_complete_event_id_list(n_unitcells,
-                                             this->event_data->prim_event_list),
-      this->event_data->event_list.impact_table,
-      std::make_shared<lotto::RandomGenerator>(run_manager.engine));
-
   // Used to apply selected events: EventID -> monte::OccEvent
-  auto get_event_f = [&](EventID const &selected_event_id) {
-    // returns a monte::OccEvent
+  // Returns a reference to the stored event, so that no monte::OccEvent (and
+  // its vectors) is copied per step
+  auto get_event_f =
+      [&](EventID const &selected_event_id) -> monte::OccEvent const & {
     return this->event_data->event_list.events.at(selected_event_id).event;
   };
 
-  // Run nfold-way
-  monte::nfold<EventID>(state, occ_location, this->nfold_data, event_selector,
-                        get_event_f, run_manager);
+  // Make selector & run nfold-way
+  auto run_nfold = [&](auto &event_selector) {
+    monte::nfold<EventID>(state, occ_location, this->nfold_data,
+                          event_selector, get_event_f, run_manager);
+  };
+  // Only included events are selectable, for all selectors, so events
+  // removed by event filters do not take space in the selector
+  if (this->event_selector_params.type == EventSelectorType::sum_tree) {
+    if (this->sum_tree_selector == nullptr) {
+      this->sum_tree_selector = std::make_shared<sum_tree_selector_type>(
+          this->event_data->event_calculator, n_unitcells,
+          this->event_data->prim_event_list.size(),
+          make_included_event_id_list(this->event_data->event_list.events),
+          this->event_data->event_list.impact_table, run_manager.engine);
+    } else {
+      this->sum_tree_selector->reset_rates(run_manager.engine);
+    }
+    run_nfold(*this->sum_tree_selector);
+    return;
+  }
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(this->event_data->event_list.events);
+  run_with_event_selector(
+      this->event_selector_params, this->event_data->event_calculator,
+      n_unitcells, this->event_data->prim_event_list.size(), event_id_list,
+      this->event_data->event_list.impact_table, run_manager.engine,
+      run_nfold);
 }
 
 }  // namespace nfold
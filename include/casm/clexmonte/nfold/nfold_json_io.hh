@@ -3,19 +3,93 @@
 
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/events/io/json/EventSelectorParams_json_io.hh"
 #include "casm/clexmonte/nfold/nfold_impl.hh"
 
 namespace CASM {
 namespace clexmonte {
 namespace nfold {
 
+/// \brief Parse Nfold "calculation_options"
+///
+/// \tparam EngineType
+/// \param parser
+/// \param system
+/// \param random_number_engine (Unused)
+///
+/// Expected format:
+/// \code
+///   "event_selector": <clexmonte::EventSelectorParams> (optional)
+///       Chooses the event selector method. Has the format:
+///
+///     "type": string (required)
+///         One of "lotto_rejection_free" (default), "sum_tree",
+///         "grouped_sum_tree", "composition_rejection", or "rejection".
+///     "max_rate": number (optional, default=0.0)
+///         For "rejection", the upper bound on event rates. If <= 0.0,
+///         "max_rate_factor" times the maximum initial event rate is used.
+///     "max_rate_factor": number (optional, default=10.0)
+///         For "rejection", used if "max_rate" <= 0.0.
+///
+///   "adaptive_method": bool (optional, default=false)
+///       If true, the first run uses the Metropolis method, and each
+///       following run uses the N-fold way or the Metropolis method,
+///       depending on the acceptance rate of the previous run.
+///   "adaptive_nfold_below": number (optional, default=0.05)
+///       With "adaptive_method", switch to the N-fold way after a Metropolis
+///       run with acceptance rate below this value.
+///   "adaptive_metropolis_above": number (optional, default=0.2)
+///       With "adaptive_method", switch to the Metropolis method after an
+///       N-fold way run ending with mean event acceptance probability above
+///       this value.
+///
+/// \endcode
+///
 template <typename EngineType>
 void parse(InputParser<Nfold<EngineType>> &parser,
            std::shared_ptr<system_type> system,
            std::shared_ptr<EngineType> random_number_engine =
                std::shared_ptr<EngineType>()) {
-  parser.value =
-      std::make_unique<Nfold<EngineType>>(system, random_number_engine);
+  // "event_selector"
+  EventSelectorParams event_selector_params;
+  if (parser.self.contains("event_selector")) {
+    auto subparser =
+        parser.template subparse<EventSelectorParams>("event_selector");
+    if (subparser->valid()) {
+      event_selector_params = std::move(*subparser->value);
+    }
+  }
+  if (event_selector_params.type == EventSelectorType::defect) {
+    parser.insert_error("event_selector",
+                        "Error: the \"defect\" event selector is only "
+                        "available for KMC");
+  }
+  if (event_selector_params.type ==
+      EventSelectorType::synchronous_sublattice) {
+    parser.insert_error("event_selector",
+                        "Error: the \"synchronous_sublattice\" event "
+                        "selector is only available for KMC");
+  }
+
+  // "adaptive_method", "adaptive_nfold_below", "adaptive_metropolis_above"
+  AdaptiveMethodParams adaptive_method_params;
+  parser.optional(adaptive_method_params.enabled, "adaptive_method");
+  parser.optional(adaptive_method_params.nfold_below, "adaptive_nfold_below");
+  parser.optional(adaptive_method_params.metropolis_above,
+                  "adaptive_metropolis_above");
+  if (adaptive_method_params.nfold_below >
+      adaptive_method_params.metropolis_above) {
+    parser.insert_error("adaptive_nfold_below",
+                        "Error: \"adaptive_nfold_below\" must be <= "
+                        "\"adaptive_metropolis_above\"");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<Nfold<EngineType>>(system);
+    parser.value->event_selector_params = event_selector_params;
+    parser.value->adaptive_method_params = adaptive_method_params;
+    parser.value->use_nfold = !adaptive_method_params.enabled;
+  }
 }
 
 }  // namespace nfold
@@ -0,0 +1,378 @@
+#ifndef CASM_clexmonte_AdaptiveConditionsStateGenerator
+#define CASM_clexmonte_AdaptiveConditionsStateGenerator
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexulator/ClusterExpansion.hh"
+#include "casm/composition/CompositionCalculator.hh"
+#include "casm/composition/CompositionConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Parameters controlling the refinement of an adaptive conditions
+///     path
+struct AdaptiveStepParams {
+  /// \brief Observables compared between runs, and the maximum allowed
+  ///     change of any component of each between adjacent runs
+  ///
+  /// Observables are evaluated from the final state of each run. Options
+  /// are:
+  /// - "mol_composition": Number of each component per unit cell
+  /// - "param_composition": Parametric composition
+  /// - The name of any cluster expansion of the system (e.g.
+  ///   "formation_energy"): Value per unit cell
+  std::map<std::string, double> max_change;
+
+  /// \brief Maximum number of times an increment is halved
+  ///
+  /// The smallest step between conditions is `conditions_increment /
+  /// 2^max_refinement_level`.
+  Index max_refinement_level = 4;
+
+  /// \brief Additional values of the path parameter `t` at which runs are
+  ///     performed
+  ///
+  /// For instance, where thermodynamic integration along the path needs more
+  /// conditions (see `ThermodynamicIntegration::refinement_t`).
+  std::vector<double> requested_t;
+};
+
+/// \brief The path parameter `t` of conditions on the path
+///     `initial_conditions + t * conditions_increment`
+///
+/// The conditions are projected onto `conditions_increment`, so conditions
+/// off the path give the `t` of the closest point on the path. Requires
+/// `conditions_increment` to be non-zero.
+inline double get_conditions_path_parameter(
+    monte::ValueMap const &conditions,
+    monte::ValueMap const &initial_conditions,
+    monte::ValueMap const &conditions_increment) {
+  double dot = 0.0;
+  double norm_squared = 0.0;
+  for (auto const &pair : conditions_increment.scalar_values) {
+    dot += (conditions.scalar_values.at(pair.first) -
+            initial_conditions.scalar_values.at(pair.first)) *
+           pair.second;
+    norm_squared += pair.second * pair.second;
+  }
+  for (auto const &pair : conditions_increment.vector_values) {
+    dot += (conditions.vector_values.at(pair.first) -
+            initial_conditions.vector_values.at(pair.first))
+               .dot(pair.second);
+    norm_squared += pair.second.squaredNorm();
+  }
+  return dot / norm_squared;
+}
+
+/// \brief Evaluate an adaptive step observable from a state
+///
+/// \param system System data
+/// \param state The state, usually the final state of a run
+/// \param name One of "mol_composition", "param_composition", or the name
+///     of a cluster expansion of the system
+///
+/// \returns The observable value. Cluster expansion values are per unit
+///     cell.
+inline Eigen::VectorXd evaluate_adaptive_step_observable(
+    System &system, state_type const &state, std::string const &name) {
+  if (name == "mol_composition" || name == "param_composition") {
+    Eigen::VectorXd mol_composition =
+        get_composition_calculator(system).mean_num_each_component(
+            get_occupation(state));
+    if (name == "mol_composition") {
+      return mol_composition;
+    }
+    return get_composition_converter(system).param_composition(
+        mol_composition);
+  }
+  Eigen::VectorXd value(1);
+  value(0) = get_clex(system, state, name)->per_unitcell();
+  return value;
+}
+
+/// \brief Generates a series of states along a path of conditions,
+///     refining the step between conditions where selected observables
+///     change quickly
+///
+/// The conditions of each state are on the path
+/// \code
+/// conditions(t) = initial_conditions + t * conditions_increment
+/// \endcode
+/// for `t` in `[0, n_states - 1]`. Runs are first performed at the integer
+/// values of `t`, as by IncrementalConditionsStateGenerator. After each run,
+/// completed runs are checked in order of increasing `t`: if any observable
+/// in `params.max_change` changes by more than the allowed amount between
+/// two adjacent runs, a run is performed halfway between them, unless their
+/// step is already the smallest allowed. Only then does the path continue
+/// to the next integer value of `t`. This resolves jumps, such as at phase
+/// transitions, with far fewer runs than a uniformly fine step.
+/// Runs are also performed at each value of `params.requested_t` that has not
+/// been run, after refinement and before continuing along the path.
+///
+/// Notes:
+/// - The next state depends on the results of completed runs, so states
+///   are never independent and runs are performed one at a time.
+/// - If `dependent_runs` is true, the initial configuration of each run is
+///   the final configuration of the completed run with the largest `t` less
+///   than the new run's `t`. Final configurations are kept internally for
+///   this, regardless of the completed runs output parameters.
+/// - When restarting, `t` is recovered from the conditions of the
+///   completed runs. Observables can only be re-evaluated for completed runs
+///   whose final state was written, so the path is not refined between runs
+///   without them.
+class AdaptiveConditionsStateGenerator
+    : public IncrementalConditionsStateGenerator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _params Controls refinement
+  ///
+  /// Other parameters are the same as for IncrementalConditionsStateGenerator.
+  AdaptiveConditionsStateGenerator(
+      std::shared_ptr<system_type> system, RunDataOutputParams output_params,
+      std::unique_ptr<ConfigGenerator> _config_generator,
+      monte::ValueMap const &_initial_conditions,
+      monte::ValueMap const &_conditions_increment, Index _n_states,
+      bool _dependent_runs, AdaptiveStepParams const &_params,
+      std::vector<StateModifyingFunction> const &_modifiers = {})
+      : IncrementalConditionsStateGenerator(
+            system, output_params, std::move(_config_generator),
+            _initial_conditions, _conditions_increment, _n_states,
+            _dependent_runs, _modifiers),
+        m_params(_params) {
+    if (_increment_norm_squared() == 0.0) {
+      throw std::runtime_error(
+          "Error constructing AdaptiveConditionsStateGenerator: "
+          "conditions_increment is zero");
+    }
+    if (m_params.max_refinement_level < 0) {
+      throw std::runtime_error(
+          "Error constructing AdaptiveConditionsStateGenerator: "
+          "max_refinement_level < 0");
+    }
+    for (auto const &pair : m_params.max_change) {
+      if (pair.first != "mol_composition" &&
+          pair.first != "param_composition" &&
+          !is_clex_data(*m_system, pair.first)) {
+        std::stringstream msg;
+        msg << "Error constructing AdaptiveConditionsStateGenerator: "
+            << "invalid observable \"" << pair.first << "\"";
+        throw std::runtime_error(msg.str());
+      }
+    }
+  }
+
+  /// \brief Check if all integer values of `t` have been run and no
+  ///     adjacent runs need refinement
+  bool is_complete() override { return !_next_t().has_value(); }
+
+  /// \brief Return the next state
+  state_type next_state() override {
+    std::optional<double> t = _next_t();
+    if (!t.has_value()) {
+      throw std::runtime_error(
+          "Error in AdaptiveConditionsStateGenerator::next_state: complete");
+    }
+    return _make_adaptive_state(*t);
+  }
+
+  /// \brief Return the next state, without applying state modifiers
+  state_type next_unmodified_state() override {
+    std::optional<double> t = _next_t();
+    if (!t.has_value()) {
+      throw std::runtime_error(
+          "Error in AdaptiveConditionsStateGenerator::next_state: complete");
+    }
+    return _make_adaptive_state(*t, false);
+  }
+
+  /// \brief The next state depends on the results of completed runs
+  bool has_independent_states() const override { return false; }
+
+  /// \brief The next state depends on the results of completed runs
+  bool allows_warm_start() const override { return false; }
+
+  void push_back(RunData const &run_data) override {
+    m_points.push_back(_make_point(run_data));
+    IncrementalConditionsStateGenerator::push_back(run_data);
+  }
+
+  void read_completed_runs() override {
+    m_points.clear();
+    IncrementalConditionsStateGenerator::read_completed_runs();
+    if (m_points.size() != m_completed_runs.size()) {
+      m_points.clear();
+      for (auto const &run_data : m_completed_runs) {
+        m_points.push_back(_make_point(run_data));
+      }
+    }
+  }
+
+  /// \brief The path parameter `t` of each completed run, in run order
+  std::vector<double> completed_t() const {
+    std::vector<double> t;
+    for (auto const &point : m_points) {
+      t.push_back(point.t);
+    }
+    return t;
+  }
+
+ private:
+  /// \brief Data used for refinement about one completed run
+  struct Point {
+    double t;
+
+    /// Observable values, in the order of `m_params.max_change`, if the
+    /// final state was available
+    std::optional<std::vector<Eigen::VectorXd>> observables;
+
+    /// Final configuration, if `dependent_runs`
+    std::optional<config_type> final_configuration;
+  };
+
+  double _increment_norm_squared() const {
+    double norm_squared = 0.0;
+    for (auto const &pair : m_conditions_increment.scalar_values) {
+      norm_squared += pair.second * pair.second;
+    }
+    for (auto const &pair : m_conditions_increment.vector_values) {
+      norm_squared += pair.second.squaredNorm();
+    }
+    return norm_squared;
+  }
+
+  /// \brief Path parameter of `conditions`, by projection onto
+  ///     `conditions_increment`
+  double _get_t(monte::ValueMap const &conditions) const {
+    return get_conditions_path_parameter(conditions, m_initial_conditions,
+                                         m_conditions_increment);
+  }
+
+  Point _make_point(RunData const &run_data) {
+    Point point;
+    point.t = _get_t(run_data.conditions);
+    if (run_data.final_state.has_value()) {
+      std::vector<Eigen::VectorXd> observables;
+      for (auto const &pair : m_params.max_change) {
+        observables.push_back(evaluate_adaptive_step_observable(
+            *m_system, *run_data.final_state, pair.first));
+      }
+      point.observables = std::move(observables);
+      if (m_dependent_runs) {
+        point.final_configuration = run_data.final_state->configuration;
+      }
+    }
+    return point;
+  }
+
+  /// \brief True if any observable changes by more than allowed between
+  ///     `a` and `b`
+  bool _needs_refinement(Point const &a, Point const &b) const {
+    if (!a.observables.has_value() || !b.observables.has_value()) {
+      return false;
+    }
+    Index i = 0;
+    for (auto const &pair : m_params.max_change) {
+      Eigen::VectorXd const &x = (*a.observables)[i];
+      Eigen::VectorXd const &y = (*b.observables)[i];
+      if (x.size() == y.size() &&
+          (x - y).cwiseAbs().maxCoeff() > pair.second) {
+        return true;
+      }
+      ++i;
+    }
+    return false;
+  }
+
+  /// \brief The path parameter of the next run, or std::nullopt if complete
+  std::optional<double> _next_t() const {
+    std::vector<Point const *> sorted;
+    for (auto const &point : m_points) {
+      sorted.push_back(&point);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](Point const *a, Point const *b) { return a->t < b->t; });
+
+    // refine the first pair of adjacent runs that changes too much
+    double min_step = std::ldexp(1.0, -m_params.max_refinement_level);
+    for (Index i = 1; i < sorted.size(); ++i) {
+      Point const &a = *sorted[i - 1];
+      Point const &b = *sorted[i];
+      if (b.t - a.t > min_step * 1.5 && _needs_refinement(a, b)) {
+        return 0.5 * (a.t + b.t);
+      }
+    }
+
+    auto is_run = [&](double t) {
+      for (Point const *point : sorted) {
+        if (std::abs(point->t - t) < min_step * 0.25) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    // then run requested values of t
+    for (double t : m_params.requested_t) {
+      if (!is_run(t)) {
+        return t;
+      }
+    }
+
+    // then continue to the next integer value of t
+    for (Index k = 0; k < m_n_states; ++k) {
+      if (!is_run(k)) {
+        return double(k);
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Make the initial state at path parameter `t`, optionally
+  ///     applying the state modifiers
+  state_type _make_adaptive_state(double t, bool apply_modifiers = true) {
+    // Make conditions
+    monte::ValueMap conditions = make_incremented_values(
+        m_initial_conditions, m_conditions_increment, t);
+
+    // Make configuration: start from the closest completed run below `t`
+    Point const *start = nullptr;
+    if (m_dependent_runs) {
+      for (auto const &point : m_points) {
+        if (point.t < t && point.final_configuration.has_value() &&
+            (!start || point.t > start->t)) {
+          start = &point;
+        }
+      }
+    }
+    config_type configuration =
+        start ? *start->final_configuration
+              : (*m_config_generator)(conditions, m_completed_runs);
+
+    // Make state
+    state_type state(configuration, conditions);
+
+    // Apply custom modifiers
+    if (apply_modifiers) {
+      modify_state(state, nullptr);
+    }
+    return state;
+  }
+
+  AdaptiveStepParams m_params;
+
+  /// Refinement data about completed runs, in run order
+  std::vector<Point> m_points;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef CASM_clexmonte_run_AdaptiveSamplingPeriod
+#define CASM_clexmonte_run_AdaptiveSamplingPeriod
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Estimate the integrated autocorrelation time of a series, in units
+///     of samples
+double integrated_autocorrelation_time(Eigen::VectorXd const &x,
+                                       double window_factor = 5.0);
+
+/// \brief Parameters for an adaptive sampling period
+struct AdaptiveSamplingPeriodParams {
+  /// \brief Names of the sampling functions whose components are used to
+  ///     estimate the autocorrelation time. If empty, the sampling functions
+  ///     with a requested precision (the converged observables) are used.
+  std::vector<std::string> sampler_names;
+
+  /// \brief Count (or time) of the first sample
+  double begin = 0.0;
+
+  /// \brief Sampling period of the first samples of each run
+  double initial_period = 1.0;
+
+  /// \brief Minimum sampling period
+  double min_period = 1.0;
+
+  /// \brief Maximum sampling period
+  double max_period = 1e6;
+
+  /// \brief Number of samples used for each estimate of the autocorrelation
+  ///     time, at least 16
+  Index window = 128;
+
+  /// \brief Maximum factor by which the period may change per update
+  double max_change_factor = 2.0;
+
+  /// \brief Window factor of the autocorrelation time estimator, see
+  ///     `integrated_autocorrelation_time`
+  double window_factor = 5.0;
+};
+
+/// \brief Adjusts a sampling period to about one sample per integrated
+///     autocorrelation time of the sampled quantities
+///
+/// Sampling more often than once per correlation time costs sampling
+/// function calls and memory for samples that add little information, and
+/// sampling less often slows convergence. An AdaptiveSamplingPeriod is used
+/// as the custom sample spacing of a sampling fixture (see
+/// `enable_adaptive_sampling_period`):
+///
+/// - `sample_at(n)` gives the count (or time, depending on the sampling
+///   mode) at which sample `n` of a run is taken. Sample 0 is taken at
+///   `params.begin`, and each later sample is taken one `period()` after the
+///   previous one. `sample_at(0)` begins a new run, and resets the period to
+///   `params.initial_period`.
+/// - `push` is called with sampled values. After each `params.window`
+///   samples, the integrated autocorrelation time of each component is
+///   estimated in units of samples, `tau_s`, and converted to units of
+///   count, `tau`, assuming correlations decay exponentially so that
+///   `tau_s = coth(period / tau)`. This gives `tau ~= period * tau_s` when
+///   sampling often, and detects when sampling is too sparse because
+///   `tau_s` approaches 1.
+/// - The period moves half way, on a log scale, to the largest `tau` of the
+///   components, which damps estimator noise. It changes by at most
+///   `params.max_change_factor` per update, and is bounded by
+///   `params.min_period` and `params.max_period`. Components with zero
+///   variance are ignored.
+///
+/// An AdaptiveSamplingPeriod holds the state of one run at a time, so it
+/// must not be shared by sampling fixtures or by runs that are sampled
+/// concurrently.
+class AdaptiveSamplingPeriod {
+ public:
+  /// \brief Constructor
+  explicit AdaptiveSamplingPeriod(AdaptiveSamplingPeriodParams _params);
+
+  /// \brief Parameters
+  AdaptiveSamplingPeriodParams const params;
+
+  /// \brief Count (or time) at which sample `n` is taken
+  double sample_at(Index n);
+
+  /// \brief Add a sampled value of a sampling function
+  void push(std::string const &sampler_name, Eigen::VectorXd const &value);
+
+  /// \brief Current sampling period
+  double period() const { return m_period; }
+
+  /// \brief Last estimated autocorrelation time, in units of count (or
+  ///     time), or 0.0 if not yet estimated in this run
+  double autocorrelation_time() const { return m_autocorrelation_time; }
+
+  /// \brief Sampling periods used in the current run, one per update
+  std::vector<double> const &period_history() const {
+    return m_period_history;
+  }
+
+ private:
+  /// Estimate the autocorrelation time and update the period
+  void _update();
+
+  double m_period;
+
+  double m_autocorrelation_time;
+
+  std::vector<double> m_period_history;
+
+  /// Sample positions of the current run
+  std::vector<double> m_sample_at;
+
+  /// Values pushed since the last update, by sampler name
+  std::map<std::string, std::vector<Eigen::VectorXd>> m_values;
+};
+
+/// \brief Make a sampling fixture use an adaptive sampling period
+void enable_adaptive_sampling_period(
+    sampling_fixture_params_type &sampling_fixture_params,
+    std::shared_ptr<AdaptiveSamplingPeriod> adaptive_sampling_period);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef CASM_clexmonte_run_AsyncRunPool
+#define CASM_clexmonte_run_AsyncRunPool
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "casm/clexmonte/run/RunControl.hh"
+#include "casm/clexmonte/run/TelemetryChannel.hh"
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Status of an AsyncRun
+enum class AsyncRunStatus {
+  /// Submitted, and waiting for a worker
+  pending,
+
+  /// In progress on a worker
+  running,
+
+  /// Completed normally
+  finished,
+
+  /// Cancelled before it started, or stopped by `cancel` while running
+  cancelled,
+
+  /// Ended by an exception
+  failed
+};
+
+/// \brief Name of an AsyncRunStatus: "pending", "running", "finished",
+///     "cancelled", or "failed"
+std::string async_run_status_name(AsyncRunStatus status);
+
+/// \brief A run submitted to an AsyncRunPool
+///
+/// An AsyncRun is a handle to a run executed on a worker thread of an
+/// AsyncRunPool:
+///
+/// - `status`, `done`, `wait`, and `wait_for` report and wait for
+///   completion. `rethrow_if_failed` rethrows an exception thrown by the
+///   run.
+/// - `cancel` cancels a pending run, so that it never starts, or requests
+///   that a running run stops, by `RunControl::request_stop`. A stopped run
+///   is finalized as usual, so its results are written. Runs that do not
+///   check a RunControl can only be cancelled before they start.
+/// - `telemetry`, if not null, is the channel the run publishes its
+///   progress to.
+/// - Functions added by `add_done_callback` are called, on the worker
+///   thread, when the run is done, or immediately if it already is.
+///
+/// All members may be called from any thread.
+class AsyncRun {
+ public:
+  /// \brief Constructor
+  AsyncRun(std::function<void()> _run,
+           std::shared_ptr<RunControl> _run_control = nullptr,
+           std::shared_ptr<TelemetryChannel> _telemetry = nullptr);
+
+  AsyncRun(AsyncRun const &) = delete;
+  AsyncRun &operator=(AsyncRun const &) = delete;
+
+  /// \brief RunControl used to stop the run, may be null
+  std::shared_ptr<RunControl> const run_control;
+
+  /// \brief Channel the run publishes its progress to, may be null
+  std::shared_ptr<TelemetryChannel> const telemetry;
+
+  /// \brief Current status
+  AsyncRunStatus status() const;
+
+  /// \brief True if finished, cancelled, or failed
+  bool done() const;
+
+  /// \brief Cancel a pending run, or request that a running run stops
+  void cancel();
+
+  /// \brief Wait until the run is done
+  void wait() const;
+
+  /// \brief Wait until the run is done, for at most `timeout_s` seconds
+  bool wait_for(double timeout_s) const;
+
+  /// \brief Rethrow the exception that ended a failed run
+  void rethrow_if_failed() const;
+
+  /// \brief Add a function to call when the run is done
+  void add_done_callback(std::function<void()> f);
+
+  /// \brief Worker: Perform the run, unless cancelled
+  void execute();
+
+ private:
+  bool _is_done() const;
+
+  void _finish(AsyncRunStatus status, std::exception_ptr exception);
+
+  std::function<void()> m_run;
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_cv;
+  AsyncRunStatus m_status;
+  bool m_cancel_requested;
+  std::exception_ptr m_exception;
+  std::vector<std::function<void()>> m_done_callbacks;
+};
+
+/// \brief Executes AsyncRun on a fixed number of worker threads
+///
+/// Runs are started in submission order, as workers become free. The
+/// destructor cancels pending runs and waits for running runs to finish.
+class AsyncRunPool {
+ public:
+  /// \brief Constructor
+  explicit AsyncRunPool(Index _n_workers);
+
+  /// \brief Destructor, cancels pending runs and waits for running runs
+  ~AsyncRunPool();
+
+  AsyncRunPool(AsyncRunPool const &) = delete;
+  AsyncRunPool &operator=(AsyncRunPool const &) = delete;
+
+  /// \brief Number of worker threads
+  Index n_workers() const { return m_threads.size(); }
+
+  /// \brief Queue a run
+  void submit(std::shared_ptr<AsyncRun> run);
+
+  /// \brief Number of submitted runs not yet started
+  Index n_pending() const;
+
+ private:
+  void _work();
+
+  std::deque<std::shared_ptr<AsyncRun>> m_queue;
+  bool m_stop;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::thread> m_threads;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
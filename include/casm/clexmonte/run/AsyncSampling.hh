@@ -0,0 +1,155 @@
+#ifndef CASM_clexmonte_run_AsyncSampling
+#define CASM_clexmonte_run_AsyncSampling
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Evaluates sampling functions on worker threads, from snapshots of
+///     the occupation
+///
+/// Heavy sampling functions, such as correlations or order parameters, stall
+/// the Monte Carlo loop when they are evaluated on the simulation thread,
+/// once for each sampling fixture that samples them. With AsyncSampling:
+///
+/// - Functions are registered by `add_function`, with a factory that makes
+///   the function which calculates a value from an occupation. The factory
+///   is called once per worker thread, on the worker thread, so each worker
+///   has its own calculator.
+/// - Each call of `record` takes a snapshot of the current occupation and
+///   queues its evaluation, then returns immediately. Snapshots are shared
+///   and immutable: a new copy is only made if the occupation has changed
+///   since the last snapshot, so all functions sampled at the same step, by
+///   any sampling fixture, share one copy.
+/// - Values are stored by sample index, so they are in sampling order
+///   regardless of which worker evaluated them. `values` waits for pending
+///   evaluations.
+/// - `record` blocks only if `max_pending` evaluations are pending.
+///
+/// Usage:
+/// - `make_async_state_sampling_function` makes a state sampling function
+///   that calls `record`. As with `BatchedSamplingFunction`, its sampled
+///   value is the row of `values` where the value will be stored, so the
+///   values are not available for convergence checks.
+/// - Call `values` after a run, and `reset` before the next one.
+/// - `record`, `values`, and `reset` must be called from one thread, the
+///   simulation thread.
+///
+/// If an evaluation throws, the exception is rethrown by the next call to
+/// `record` or `wait`, and the remaining pending evaluations are discarded.
+class AsyncSampling {
+ public:
+  typedef std::function<Eigen::VectorXd(Eigen::VectorXi const &)>
+      evaluate_function_type;
+
+  typedef std::function<evaluate_function_type()> make_function_type;
+
+  /// \brief Constructor
+  AsyncSampling(std::function<Eigen::VectorXi const &()> _get_occupation,
+                Index _n_threads = 1, Index _max_pending = 64);
+
+  /// \brief Destructor, finishes pending evaluations
+  ~AsyncSampling();
+
+  AsyncSampling(AsyncSampling const &) = delete;
+  AsyncSampling &operator=(AsyncSampling const &) = delete;
+
+  /// \brief Number of worker threads
+  Index n_threads() const { return m_threads.size(); }
+
+  /// \brief Maximum number of pending evaluations
+  Index max_pending() const { return m_max_pending; }
+
+  /// \brief Register a function
+  Index add_function(std::string name,
+                     std::vector<std::string> component_names,
+                     make_function_type make_function);
+
+  /// \brief Index of a registered function, by name
+  Index function_index(std::string const &name) const;
+
+  /// \brief Names of the components of a registered function
+  std::vector<std::string> const &component_names(Index function_index) const;
+
+  /// \brief Snapshot the current occupation and queue the evaluation of a
+  ///     function
+  Index record(Index function_index);
+
+  /// \brief Wait for all pending evaluations to finish
+  void wait();
+
+  /// \brief Wait for pending evaluations and return the sampled values of a
+  ///     function
+  Eigen::MatrixXd values(std::string const &name);
+
+  /// \brief Number of samples recorded for a function
+  Index n_samples(std::string const &name) const;
+
+  /// \brief Number of occupation snapshots copied
+  Index n_snapshots() const { return m_n_snapshots; }
+
+  /// \brief Wait for pending evaluations, then clear sampled values
+  void reset();
+
+ private:
+  struct Function {
+    std::string name;
+    std::vector<std::string> component_names;
+    make_function_type make_function;
+
+    /// Values by sample index, written by workers
+    std::vector<Eigen::VectorXd> values;
+  };
+
+  struct Task {
+    Index function_index;
+    Index sample_index;
+    std::shared_ptr<Eigen::VectorXi const> occupation;
+  };
+
+  void _work();
+
+  void _rethrow_if_failed();
+
+  std::function<Eigen::VectorXi const &()> m_get_occupation;
+  Index m_max_pending;
+
+  /// Registered functions, only added from the simulation thread; workers
+  /// write `values` elements under `m_mutex`
+  std::deque<Function> m_functions;
+
+  /// Last snapshot, shared by tasks until the occupation changes
+  std::shared_ptr<Eigen::VectorXi const> m_snapshot;
+  Index m_n_snapshots;
+
+  std::deque<Task> m_queue;
+  Index m_n_busy;
+  bool m_stop;
+  std::exception_ptr m_exception;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::thread> m_threads;
+};
+
+/// \brief Make a state sampling function which records samples for an
+///     AsyncSampling function
+monte::StateSamplingFunction make_async_state_sampling_function(
+    std::shared_ptr<AsyncSampling> async_sampling, std::string name,
+    std::string description);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
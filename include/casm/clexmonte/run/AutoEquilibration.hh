@@ -0,0 +1,123 @@
+#ifndef CASM_clexmonte_run_AutoEquilibration
+#define CASM_clexmonte_run_AutoEquilibration
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/checks/EquilibrationCheck.hh"
+#include "casm/monte/sampling/RequestedPrecision.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Equilibration check by a drift test
+///
+/// An alternative to `monte::default_equilibration_check` for
+/// `CompletionCheckParams::equilibration_check_f`, which is cheap enough to
+/// check often. The trailing half of the observations is split into two
+/// halves, and the observations are considered equilibrated from the start
+/// of the trailing half if the difference between the means of its two
+/// halves is within the confidence interval estimated from batch means.
+///
+/// Notes:
+/// - Costs one pass over the trailing half of the observations
+/// - Each half of the trailing half is split into 4 batches, and the
+///   variance of the batch means is pooled within each half, so that a
+///   drift does not inflate the estimated variance
+struct DriftEquilibrationCheck {
+  /// \brief Constructor
+  DriftEquilibrationCheck(double _confidence = 0.95, Index _min_samples = 20);
+
+  /// \brief Confidence level of the drift test
+  double confidence;
+
+  /// \brief Minimum number of observations to attempt the test
+  Index min_samples;
+
+  /// \brief Check equilibration
+  monte::IndividualEquilibrationCheckResult operator()(
+      Eigen::VectorXd const &observations,
+      Eigen::VectorXd const &sample_weight,
+      monte::RequestedPrecision requested_precision) const;
+};
+
+/// \brief Parameters for automatic equilibration runs
+struct AutoEquilibrationParams {
+  /// \brief Names of the sampling functions whose components must pass the
+  ///     drift test. Names that are not sampled by a fixture are skipped.
+  std::vector<std::string> sampler_names = {"potential_energy",
+                                            "mol_composition"};
+
+  /// \brief Confidence level of the drift test
+  double confidence = 0.95;
+
+  /// \brief Minimum number of samples
+  Index min_n_samples = 20;
+
+  /// \brief Maximum number of samples (the cap on the equilibration length)
+  Index max_n_samples = 10000;
+
+  /// \brief If true, use the lengths of previous equilibration runs in the
+  ///     series to set the minimum number of samples of later ones
+  bool learn_length = false;
+
+  /// \brief With `learn_length`, the minimum number of samples is this
+  ///     fraction of the median number of samples of previous equilibration
+  ///     runs
+  double learned_length_fraction = 0.5;
+};
+
+/// \brief Makes equilibration runs end when a drift test passes, and learns
+///     their typical length
+///
+/// `make_sampling_fixture_params` modifies "before each run" sampling
+/// fixture parameters so that:
+/// - The equilibration check is a `DriftEquilibrationCheck` on the
+///   components of `params.sampler_names`
+/// - Convergence is requested for those components at a precision that is
+///   always met, so that each run is complete as soon as the drift test
+///   passes (checks are scheduled by the fixture's completion check
+///   parameters, as usual)
+/// - The number of samples is capped at `params.max_n_samples`
+/// - With `params.learn_length`, the minimum number of samples is an
+///   initial guess learned from previous runs, so that early checks which
+///   would fail are skipped
+///
+/// The number of samples of each equilibration run is recorded by `record`.
+/// It is safe to share an AutoEquilibration between the worker threads of a
+/// series.
+class AutoEquilibration {
+ public:
+  /// \brief Constructor
+  explicit AutoEquilibration(AutoEquilibrationParams _params);
+
+  /// \brief Parameters
+  AutoEquilibrationParams const params;
+
+  /// \brief Make sampling fixture parameters for an equilibration run
+  std::vector<sampling_fixture_params_type> make_sampling_fixture_params(
+      std::vector<sampling_fixture_params_type> const &before_each_run) const;
+
+  /// \brief Record the number of samples of a completed equilibration run
+  void record(Index n_samples);
+
+  /// \brief Learned minimum number of samples, or std::nullopt if not
+  ///     learning or no runs are recorded
+  std::optional<Index> initial_guess() const;
+
+  /// \brief Number of samples of each recorded equilibration run
+  std::vector<Index> history() const;
+
+ private:
+  mutable std::mutex m_mutex;
+  std::vector<Index> m_history;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef CASM_clexmonte_run_BackgroundWriter
+#define CASM_clexmonte_run_BackgroundWriter
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Performs output tasks in order on a background thread
+///
+/// Output tasks are queued by `push`, which blocks only if `max_queue_size`
+/// tasks are pending, so slow file systems do not stall the Monte Carlo
+/// loop. Tasks must own, by copy or move, any data they write.
+///
+/// If a task throws, the exception is rethrown by the next call to `push`
+/// or `wait`, and the remaining queued tasks are discarded.
+class BackgroundWriter {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _max_queue_size Maximum number of pending tasks
+  explicit BackgroundWriter(Index _max_queue_size = 4);
+
+  /// \brief Destructor, finishes pending tasks
+  ~BackgroundWriter();
+
+  BackgroundWriter(BackgroundWriter const &) = delete;
+  BackgroundWriter &operator=(BackgroundWriter const &) = delete;
+
+  /// \brief Maximum number of pending tasks
+  Index max_queue_size() const { return m_max_queue_size; }
+
+  /// \brief Queue a task, blocking while the queue is full
+  void push(std::function<void()> task);
+
+  /// \brief Wait for all queued tasks to finish
+  void wait();
+
+ private:
+  void _work();
+
+  void _rethrow_if_failed();
+
+  Index m_max_queue_size;
+  std::deque<std::function<void()>> m_queue;
+  bool m_is_busy;
+  bool m_stop;
+  std::exception_ptr m_exception;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::thread m_thread;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
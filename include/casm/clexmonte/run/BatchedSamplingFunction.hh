@@ -0,0 +1,111 @@
+#ifndef CASM_clexmonte_run_BatchedSamplingFunction
+#define CASM_clexmonte_run_BatchedSamplingFunction
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Evaluates a sampling function for batches of occupation snapshots
+///
+/// A sampling function that is expensive to call once per sample, such as a
+/// function defined in Python, can be evaluated for many samples at once:
+///
+/// - Each call of `record` copies the current occupation into a
+///   preallocated buffer of `batch_size` rows.
+/// - When the buffer is full, or `flush` is called, `batch_function` is
+///   called once with the buffered occupations, one row per sample, and
+///   must return the sampled values, one row per sample with one column per
+///   component. The buffer passed to `batch_function` is only valid for the
+///   duration of the call.
+/// - Sampled values are appended to `values`.
+///
+/// Usage:
+/// - `make_batched_state_sampling_function` makes a state sampling function
+///   that calls `record` each time it is sampled. Its sampled value is the
+///   row of `values` where the batched value will be stored, so the values
+///   are not available for convergence checks.
+/// - Call `flush` after a run, or use `values`, which flushes, to evaluate
+///   the last partial batch.
+/// - A BatchedSamplingFunction is not thread-safe; use one per worker.
+class BatchedSamplingFunction {
+ public:
+  typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      occupation_batch_type;
+
+  typedef std::function<Eigen::MatrixXd(
+      Eigen::Ref<occupation_batch_type const> const &)>
+      batch_function_type;
+
+  /// \brief Constructor
+  BatchedSamplingFunction(
+      std::string _name, std::string _description,
+      std::vector<std::string> _component_names, Index _batch_size,
+      batch_function_type _batch_function,
+      std::function<Eigen::VectorXi const &()> _get_occupation);
+
+  /// \brief Sampling function name
+  std::string const name;
+
+  /// \brief Sampling function description
+  std::string const description;
+
+  /// \brief Names of the components of batched values
+  std::vector<std::string> const component_names;
+
+  /// \brief Number of samples per call of `batch_function`
+  Index const batch_size;
+
+  /// \brief Record the current occupation, evaluating a batch if the buffer
+  ///     is full
+  Index record();
+
+  /// \brief Evaluate buffered samples
+  void flush();
+
+  /// \brief Evaluate buffered samples and return all sampled values
+  Eigen::MatrixXd values();
+
+  /// \brief Number of samples recorded, including buffered samples
+  Index n_samples() const { return m_n_evaluated + m_n_buffered; }
+
+  /// \brief Number of calls of `batch_function`
+  Index n_batches() const { return m_n_batches; }
+
+  /// \brief Clear buffered samples and sampled values
+  void reset();
+
+ private:
+  batch_function_type m_batch_function;
+
+  std::function<Eigen::VectorXi const &()> m_get_occupation;
+
+  /// Buffered occupations, `batch_size` rows once allocated
+  occupation_batch_type m_buffer;
+
+  /// Number of rows of `m_buffer` in use
+  Index m_n_buffered;
+
+  /// Evaluated values, the first `m_n_evaluated` rows are in use
+  Eigen::MatrixXd m_values;
+
+  Index m_n_evaluated;
+
+  Index m_n_batches;
+};
+
+/// \brief Make a state sampling function which records samples for a
+///     BatchedSamplingFunction
+monte::StateSamplingFunction make_batched_state_sampling_function(
+    std::shared_ptr<BatchedSamplingFunction> batched_function);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
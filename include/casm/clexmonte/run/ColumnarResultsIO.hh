@@ -0,0 +1,111 @@
+#ifndef CASM_clexmonte_run_ColumnarResultsIO
+#define CASM_clexmonte_run_ColumnarResultsIO
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+#include "casm/monte/run_management/io/ResultsIO.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Write results to typed binary columns
+///
+/// Results are written to raw binary columns, which can be read without
+/// parsing, or memory-mapped (for instance with `numpy.memmap`), rather than
+/// to JSON:
+///
+///     <output_dir>/
+///       columns.json
+///       <column_name>.bin
+///       run.<run_index>/
+///         observations.json
+///         <sampler_name>.bin
+///
+/// Per-run columns have one row per run, in the order written:
+/// - "run_index", "n_samples", "n_accept", "n_reject", "elapsed_clocktime",
+///   "is_complete", "all_equilibrated", and "all_converged"
+/// - "conditions.<key>", for each condition
+/// - "analysis.<name>", for each analysis result
+///
+/// Per-sample columns, in the run directories, have one row per sample, in
+/// the format written by `ObservationStream`, so they can be read with
+/// `read_streamed_observations`:
+/// - "<sampler_name>", for each sampler
+/// - "sample_count", "sample_time", "sample_weight", and "sample_clocktime",
+///   if not empty
+///
+/// All columns store float64 values in native byte order, row-major, with
+/// one row of `component_names.size()` values, except that the per-sample
+/// columns of samplers in `float32_sampler_names` are stored as float32, to
+/// halve the output size of long trajectories. Missing values, such as an
+/// analysis result that was not calculated for some runs, are NaN. Matrix
+/// conditions are stored in column-major order. "columns.json" is rewritten
+/// after each run:
+///
+///     {
+///       "n_runs": int,
+///       "columns": {
+///         "<column_name>": {
+///           "file": "<column_name>.bin",
+///           "dtype": "float64",
+///           "component_names": [...],
+///           "value_type": "scalar" | "boolean" | "vector" | "matrix",
+///           "shape": [...]
+///         }, ...
+///       }
+///     }
+///
+/// Only the first "n_runs" rows of each per-run column are valid. Rows of a
+/// run that was being written when a calculation stopped are discarded when
+/// the next run is written.
+///
+/// Values are not compressed, so that columns can be memory-mapped. The
+/// cost of writing a run does not depend on the number of runs already
+/// written.
+class ColumnarResultsIO : public results_io_type {
+ public:
+  /// \brief Constructor
+  ColumnarResultsIO(fs::path _output_dir, bool _write_observations,
+                    std::set<std::string> _float32_sampler_names = {});
+
+  /// \brief Read the conditions of the runs written, in order
+  std::vector<monte::ValueMap> read_conditions() override;
+
+  /// \brief Append the results of one run
+  void write(results_type const &results, monte::ValueMap const &conditions,
+             Index run_index) override;
+
+ private:
+  struct Column {
+    std::vector<std::string> component_names;
+    std::string value_type;
+    std::vector<Index> shape;
+  };
+
+  void _load();
+
+  void _write_index() const;
+
+  fs::path m_output_dir;
+  bool m_write_observations;
+  std::set<std::string> m_float32_sampler_names;
+
+  bool m_is_loaded;
+  Index m_n_runs;
+  std::map<std::string, Column> m_columns;
+};
+
+/// \brief Read a per-run column written by ColumnarResultsIO
+Eigen::MatrixXd read_results_column(fs::path const &output_dir,
+                                    std::string const &column_name);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
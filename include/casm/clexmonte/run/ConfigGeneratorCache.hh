@@ -0,0 +1,122 @@
+#ifndef CASM_clexmonte_run_ConfigGeneratorCache
+#define CASM_clexmonte_run_ConfigGeneratorCache
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/run/ConfigGenerator.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Stores generated configurations by key, so that identical
+///     expensive configuration generation is only done once
+///
+/// Generating an initial configuration can require symmetry analysis and
+/// copying a motif into a large supercell. A ConfigGeneratorCache stores the
+/// result by a key that identifies the inputs, for example the motif,
+/// the transformation matrix of the supercell, and a subset of the
+/// conditions (see `make_config_cache_key`).
+///
+/// Notes:
+/// - Thread-safe; one cache may be shared, via `std::shared_ptr`, by the
+///   configuration generators of all parallel workers of a series
+/// - Configurations are stored as `std::shared_ptr<config_type const>` and
+///   are never modified; callers copy the configuration they use
+class ConfigGeneratorCache {
+ public:
+  ConfigGeneratorCache() : m_n_hits(0), m_n_misses(0) {}
+
+  /// \brief Return the configuration stored by `key`, calling `make_f` to
+  ///     generate and store it if it is not yet stored
+  std::shared_ptr<config_type const> get_or_make(
+      std::string const &key, std::function<config_type()> const &make_f);
+
+  /// \brief Number of stored configurations
+  Index size() const;
+
+  /// \brief Remove all stored configurations
+  void clear();
+
+  /// \brief Number of `get_or_make` calls that returned a stored
+  ///     configuration
+  Index n_hits() const;
+
+  /// \brief Number of `get_or_make` calls that generated a configuration
+  Index n_misses() const;
+
+ private:
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::shared_ptr<config_type const>> m_configurations;
+  Index m_n_hits;
+  Index m_n_misses;
+};
+
+/// \brief A ConfigGeneratorCache shared by all configuration generators of
+///     this process
+std::shared_ptr<ConfigGeneratorCache> default_config_generator_cache();
+
+/// \brief Make a ConfigGeneratorCache key
+std::string make_config_cache_key(
+    std::string const &prefix,
+    Eigen::Matrix3l const *transformation_matrix_to_super = nullptr,
+    config_type const *motif = nullptr,
+    monte::ValueMap const *conditions = nullptr,
+    std::vector<std::string> const &condition_keys = {});
+
+/// \brief A `ConfigGenerator` that stores the configurations generated by
+///     another ConfigGenerator by a subset of the conditions
+///
+/// - Generated configurations are stored in a ConfigGeneratorCache by the
+///   values of the conditions named in `condition_keys`, so the wrapped
+///   generator is only called once for each distinct combination. For
+///   example, a generator that makes a configuration for a composition can
+///   be cached by `{"mol_composition"}`, so that runs which vary the
+///   temperature reuse the configuration.
+/// - The wrapped generator must only depend on those conditions; the
+///   completed runs are only passed to it when it is called.
+class CachedConfigGenerator : public ConfigGenerator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _config_generator The wrapped configuration generator
+  /// \param _condition_keys Names of the conditions that the generated
+  ///     configuration depends on
+  /// \param _cache Where configurations are stored. May be shared by
+  ///     several generators. If null, a new cache is used.
+  /// \param _key_prefix Distinguishes generators that share a cache
+  CachedConfigGenerator(
+      std::unique_ptr<ConfigGenerator> _config_generator,
+      std::vector<std::string> _condition_keys,
+      std::shared_ptr<ConfigGeneratorCache> _cache = nullptr,
+      std::string _key_prefix = "")
+      : m_config_generator(std::move(_config_generator)),
+        m_condition_keys(std::move(_condition_keys)),
+        m_cache(_cache ? _cache : std::make_shared<ConfigGeneratorCache>()),
+        m_key_prefix(std::move(_key_prefix)) {}
+
+  config_type operator()(monte::ValueMap const &conditions,
+                         std::vector<RunData> const &completed_runs) override;
+
+  /// \brief Where configurations are stored
+  std::shared_ptr<ConfigGeneratorCache> const &cache() const {
+    return m_cache;
+  }
+
+ private:
+  std::unique_ptr<ConfigGenerator> m_config_generator;
+  std::vector<std::string> m_condition_keys;
+  std::shared_ptr<ConfigGeneratorCache> m_cache;
+  std::string m_key_prefix;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
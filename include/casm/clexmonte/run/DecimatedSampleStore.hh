@@ -0,0 +1,106 @@
+#ifndef CASM_clexmonte_run_DecimatedSampleStore
+#define CASM_clexmonte_run_DecimatedSampleStore
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Stores samples with full resolution for recent samples and
+///     progressively coarser resolution for older samples
+///
+/// Samples are kept in levels. Each entry of level `k` is the mean of `2^k`
+/// consecutive samples. Level 0 holds the most recent samples, and when a
+/// level has more than `level_size` entries, its two oldest entries are
+/// merged into one entry of the next level. So the number of entries kept
+/// is at most `level_size` per level, and the number of levels grows with
+/// the logarithm of the number of samples. This suits logarithmic time
+/// sampling of long kinetic Monte Carlo runs: early samples can be taken
+/// frequently without memory growing with the run length.
+///
+/// The mean and variance of each component are accumulated over all samples
+/// as they are pushed, so they are exact regardless of decimation.
+///
+/// A DecimatedSampleStore is not thread-safe; use one per worker.
+class DecimatedSampleStore {
+ public:
+  /// \brief One stored entry, the mean of `n_samples` consecutive samples
+  struct Entry {
+    /// \brief Mean sampled value
+    Eigen::VectorXd value;
+
+    /// \brief Time (or count) of the first and last merged samples
+    double time_begin;
+    double time_end;
+
+    /// \brief Number of merged samples
+    Index n_samples;
+  };
+
+  /// \brief Constructor
+  DecimatedSampleStore(std::vector<std::string> _component_names,
+                       Index _level_size);
+
+  /// \brief Names of the components of sampled values
+  std::vector<std::string> const component_names;
+
+  /// \brief Maximum number of entries per level
+  Index const level_size;
+
+  /// \brief Add a sample
+  void push(Eigen::VectorXd const &value, double time);
+
+  /// \brief Number of samples pushed
+  Index n_samples() const { return m_n_samples; }
+
+  /// \brief Number of stored entries
+  Index n_entries() const;
+
+  /// \brief Number of levels
+  Index n_levels() const { return m_levels.size(); }
+
+  /// \brief Stored entries, oldest first
+  std::vector<Entry> entries() const;
+
+  /// \brief Stored entry values, oldest first, one row per entry
+  Eigen::MatrixXd values() const;
+
+  /// \brief Mean of all samples pushed
+  Eigen::VectorXd const &mean() const { return m_mean; }
+
+  /// \brief Sample variance of all samples pushed
+  Eigen::VectorXd variance() const;
+
+  /// \brief Remove all samples
+  void reset();
+
+ private:
+  // m_levels[k] holds entries of 2^k samples, oldest at the front
+  std::vector<std::deque<Entry>> m_levels;
+
+  Index m_n_samples;
+
+  // Welford accumulators
+  Eigen::VectorXd m_mean;
+  Eigen::VectorXd m_m2;
+};
+
+/// \brief Make a state sampling function which pushes samples to a
+///     DecimatedSampleStore
+monte::StateSamplingFunction make_decimated_state_sampling_function(
+    std::string name, std::string description,
+    std::function<Eigen::VectorXd()> function,
+    std::shared_ptr<DecimatedSampleStore> store,
+    std::function<double()> get_time_f = nullptr);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef CASM_clexmonte_FiniteSizeScalingStateGenerator
+#define CASM_clexmonte_FiniteSizeScalingStateGenerator
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/run/AdaptiveConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/ConfigGeneratorCache.hh"
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/configuration/copy_configuration.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Generates states along one path of conditions in each of a family
+///     of supercells, for finite-size scaling
+///
+/// The same conditions as the "incremental" method,
+/// \code
+/// initial_conditions + i * conditions_increment
+/// \endcode
+/// for `i` in `[0, n_states)`, are run in each supercell. Supercells are
+/// ordered by volume, smallest first, and the point index of condition `i`
+/// in supercell `s` is `s * n_states + i`, so completed runs are grouped by
+/// supercell size (see `completed_runs_by_supercell`).
+///
+/// The initial configuration of each supercell is the configuration from
+/// the ConfigGenerator, copied and tiled into the supercell if it is not
+/// already in that supercell. Tiled configurations are stored in the
+/// process-wide ConfigGeneratorCache, so each motif is only tiled once per
+/// supercell. With `dependent_runs`, each other run starts from the final
+/// configuration of the previous run in the same supercell.
+///
+/// Each supercell is a line (see `StateGenerator::has_independent_lines`),
+/// so `run_series_parallel` performs the supercells concurrently, one per
+/// worker thread, sharing the System and its supercell data.
+/// `remaining_lines` returns the largest supercells first, so the longest
+/// lines start first and smaller supercells fill in the remaining time of
+/// the other workers.
+///
+/// Notes:
+/// - Completion is tracked per point. When restarting, the point of each
+///   completed run is recovered from its supercell and conditions, and only
+///   the remaining points are run.
+/// - When supercells are performed concurrently, completed runs are recorded
+///   in the order they finish.
+class FiniteSizeScalingStateGenerator
+    : public IncrementalConditionsStateGenerator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _transformation_matrices The supercells, as transformation
+  ///     matrices of the supercell lattice vectors from the prim lattice
+  ///     vectors. Must be non-empty and distinct.
+  ///
+  /// Other parameters are the same as for IncrementalConditionsStateGenerator.
+  FiniteSizeScalingStateGenerator(
+      std::shared_ptr<system_type> system, RunDataOutputParams output_params,
+      std::unique_ptr<ConfigGenerator> _config_generator,
+      monte::ValueMap const &_initial_conditions,
+      monte::ValueMap const &_conditions_increment, Index _n_states,
+      std::vector<Eigen::Matrix3l> const &_transformation_matrices,
+      bool _dependent_runs,
+      std::vector<StateModifyingFunction> const &_modifiers = {})
+      : IncrementalConditionsStateGenerator(
+            system, output_params, std::move(_config_generator),
+            _initial_conditions, _conditions_increment, _n_states,
+            _dependent_runs, _modifiers),
+        m_transformation_matrices(_transformation_matrices),
+        m_is_completed(_transformation_matrices.size() * _n_states, false),
+        m_n_completed_points(0) {
+    if (m_transformation_matrices.empty() || m_n_states < 1) {
+      throw std::runtime_error(
+          "Error constructing FiniteSizeScalingStateGenerator: "
+          "transformation_matrices must be non-empty and n_states >= 1");
+    }
+    for (auto const &T : m_transformation_matrices) {
+      if (T.determinant() == 0) {
+        throw std::runtime_error(
+            "Error constructing FiniteSizeScalingStateGenerator: "
+            "transformation matrix has zero volume");
+      }
+    }
+    std::stable_sort(
+        m_transformation_matrices.begin(), m_transformation_matrices.end(),
+        [](Eigen::Matrix3l const &lhs, Eigen::Matrix3l const &rhs) {
+          return std::abs(lhs.determinant()) < std::abs(rhs.determinant());
+        });
+    for (Index s = 1; s < n_supercells(); ++s) {
+      for (Index r = 0; r < s; ++r) {
+        if (m_transformation_matrices[s] == m_transformation_matrices[r]) {
+          throw std::runtime_error(
+              "Error constructing FiniteSizeScalingStateGenerator: "
+              "transformation matrices must be distinct");
+        }
+      }
+    }
+  }
+
+  /// \brief Number of supercells
+  Index n_supercells() const { return m_transformation_matrices.size(); }
+
+  /// \brief The supercells, smallest volume first
+  std::vector<Eigen::Matrix3l> const &transformation_matrices() const {
+    return m_transformation_matrices;
+  }
+
+  /// \brief Check if all points have been completed
+  bool is_complete() override {
+    return m_n_completed_points == m_is_completed.size();
+  }
+
+  /// \brief Return the state of the next remaining point, in point order
+  state_type next_state() override { return _next_point_state(true); }
+
+  /// \brief Return the state of the next remaining point, in point order,
+  ///     without applying state modifiers
+  state_type next_unmodified_state() override {
+    return _next_point_state(false);
+  }
+
+  /// \brief States are independent only if runs are not dependent
+  bool has_independent_states() const override { return !m_dependent_runs; }
+
+  /// \brief Generate the initial states of all remaining points, in point
+  ///     order
+  std::vector<state_type> remaining_states() override {
+    if (m_dependent_runs) {
+      throw std::runtime_error(
+          "Error in FiniteSizeScalingStateGenerator::remaining_states: "
+          "not allowed when dependent_runs==true");
+    }
+    std::vector<state_type> states;
+    for (Index point = 0; point < m_is_completed.size(); ++point) {
+      if (!m_is_completed[point]) {
+        states.push_back(_make_point_state(point, nullptr));
+      }
+    }
+    return states;
+  }
+
+  /// \brief Warm starts are handled per supercell
+  bool allows_warm_start() const override { return false; }
+
+  /// \brief Supercells are independent of each other
+  bool has_independent_lines() const override { return true; }
+
+  /// \brief The remaining points of each supercell with remaining points,
+  ///     largest supercell first
+  std::vector<std::vector<Index>> remaining_lines() override {
+    std::vector<std::vector<Index>> lines;
+    for (Index s = n_supercells() - 1; s >= 0; --s) {
+      std::vector<Index> points;
+      for (Index i = 0; i < m_n_states; ++i) {
+        Index point = s * m_n_states + i;
+        if (!m_is_completed[point]) {
+          points.push_back(point);
+        }
+      }
+      if (points.size()) {
+        lines.push_back(points);
+      }
+    }
+    return lines;
+  }
+
+  /// \brief Generate the initial state of a point
+  ///
+  /// \param point The point index
+  /// \param previous_configuration If not null, and `dependent_runs`, the
+  ///     final configuration of the previous run in the same supercell, used
+  ///     as the initial configuration. Otherwise, the ConfigGenerator is
+  ///     used.
+  state_type line_state(Index point,
+                        config_type const *previous_configuration) override {
+    if (!m_dependent_runs) {
+      previous_configuration = nullptr;
+    }
+    return _make_point_state(point, previous_configuration);
+  }
+
+  void push_back(RunData const &run_data) override {
+    Index point = point_index(run_data);
+    if (!m_is_completed[point]) {
+      m_is_completed[point] = true;
+      ++m_n_completed_points;
+    }
+    if (m_dependent_runs && run_data.final_state.has_value()) {
+      m_last_point = point;
+      m_last_final_configuration = run_data.final_state->configuration;
+    }
+    IncrementalConditionsStateGenerator::push_back(run_data);
+  }
+
+  void read_completed_runs() override {
+    std::fill(m_is_completed.begin(), m_is_completed.end(), false);
+    m_n_completed_points = 0;
+    m_last_point = -1;
+    m_last_final_configuration.reset();
+    IncrementalConditionsStateGenerator::read_completed_runs();
+
+    // completed_runs.json is read without push_back
+    for (auto const &run_data : m_completed_runs) {
+      Index point = point_index(run_data);
+      if (!m_is_completed[point]) {
+        m_is_completed[point] = true;
+        ++m_n_completed_points;
+      }
+    }
+    if (m_dependent_runs && m_completed_runs.size() &&
+        m_completed_runs.back().final_state.has_value()) {
+      m_last_point = point_index(m_completed_runs.back());
+      m_last_final_configuration =
+          m_completed_runs.back().final_state->configuration;
+    }
+  }
+
+  /// \brief Check if a point has been completed
+  bool is_completed(Index point) const { return m_is_completed[point]; }
+
+  /// \brief The index of a supercell, by transformation matrix
+  ///
+  /// \throws If `T` is not one of the supercells
+  Index supercell_index(Eigen::Matrix3l const &T) const {
+    for (Index s = 0; s < n_supercells(); ++s) {
+      if (m_transformation_matrices[s] == T) {
+        return s;
+      }
+    }
+    throw std::runtime_error(
+        "Error in FiniteSizeScalingStateGenerator: supercell is not one of "
+        "the transformation_matrices");
+  }
+
+  /// \brief The index `i` of conditions on the path
+  ///
+  /// \throws If `conditions` are not within a quarter step of a point
+  Index conditions_index(monte::ValueMap const &conditions) const {
+    if (m_n_states == 1) {
+      return 0;
+    }
+    double t = get_conditions_path_parameter(conditions, m_initial_conditions,
+                                             m_conditions_increment);
+    Index i = std::lround(t);
+    if (!std::isfinite(t) || i < 0 || i >= m_n_states ||
+        std::abs(t - i) > 0.25) {
+      throw std::runtime_error(
+          "Error in FiniteSizeScalingStateGenerator: conditions are not on "
+          "the path");
+    }
+    return i;
+  }
+
+  /// \brief The point index of a completed run, from its supercell and
+  ///     conditions
+  Index point_index(RunData const &run_data) const {
+    return supercell_index(run_data.transformation_matrix_to_super) *
+               m_n_states +
+           conditions_index(run_data.conditions);
+  }
+
+  /// \brief The completed runs of each supercell, smallest supercell first,
+  ///     each in order of conditions
+  std::vector<std::vector<RunData const *>> completed_runs_by_supercell()
+      const {
+    std::vector<std::vector<RunData const *>> result(n_supercells());
+    for (auto const &run_data : m_completed_runs) {
+      result[supercell_index(run_data.transformation_matrix_to_super)]
+          .push_back(&run_data);
+    }
+    for (auto &runs : result) {
+      std::stable_sort(runs.begin(), runs.end(),
+                       [&](RunData const *lhs, RunData const *rhs) {
+                         return conditions_index(lhs->conditions) <
+                                conditions_index(rhs->conditions);
+                       });
+    }
+    return result;
+  }
+
+ private:
+  /// \brief State of the next remaining point in point order, optionally
+  ///     applying the state modifiers
+  state_type _next_point_state(bool apply_modifiers) {
+    for (Index point = 0; point < m_is_completed.size(); ++point) {
+      if (!m_is_completed[point]) {
+        // continue from the previous point of the same supercell, if it was
+        // the last run
+        config_type const *configuration = nullptr;
+        if (m_dependent_runs && (point % m_n_states) != 0 &&
+            point - 1 == m_last_point &&
+            m_last_final_configuration.has_value()) {
+          configuration = &*m_last_final_configuration;
+        }
+        return _make_point_state(point, configuration, apply_modifiers);
+      }
+    }
+    throw std::runtime_error(
+        "Error in FiniteSizeScalingStateGenerator::next_state: complete");
+  }
+
+  /// \brief Make the initial state at a point, optionally applying the
+  ///     state modifiers
+  state_type _make_point_state(Index point, config_type const *configuration,
+                               bool apply_modifiers = true) {
+    Eigen::Matrix3l const &T = m_transformation_matrices[point / m_n_states];
+    monte::ValueMap conditions = make_incremented_values(
+        m_initial_conditions, m_conditions_increment, point % m_n_states);
+    std::optional<config_type> generated;
+    if (!configuration) {
+      generated = _tile((*m_config_generator)(conditions, m_completed_runs), T);
+      configuration = &*generated;
+    }
+    state_type state(*configuration, conditions);
+    if (apply_modifiers) {
+      modify_state(state, nullptr);
+    }
+    return state;
+  }
+
+  /// \brief Copy and tile `motif` into supercell `T`, if it is not already
+  ///     in that supercell
+  config_type _tile(config_type const &motif, Eigen::Matrix3l const &T) {
+    if (motif.supercell->superlattice.transformation_matrix_to_super() == T) {
+      return motif;
+    }
+    std::string key =
+        make_config_cache_key("finite_size_scaling", &T, &motif);
+    return *default_config_generator_cache()->get_or_make(key, [&]() {
+      xtal::UnitCell translation(0, 0, 0);
+      return copy_configuration(0, translation, motif,
+                                get_supercell(*m_system, T));
+    });
+  }
+
+  /// Supercells, smallest volume first
+  std::vector<Eigen::Matrix3l> m_transformation_matrices;
+
+  /// Which points are completed
+  std::vector<bool> m_is_completed;
+  Index m_n_completed_points;
+
+  /// Point and final configuration of the last completed run, if
+  /// `dependent_runs`
+  Index m_last_point = -1;
+  std::optional<config_type> m_last_final_configuration;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
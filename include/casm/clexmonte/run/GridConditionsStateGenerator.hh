@@ -0,0 +1,366 @@
+#ifndef CASM_clexmonte_GridConditionsStateGenerator
+#define CASM_clexmonte_GridConditionsStateGenerator
+
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Generates states on a multi-dimensional grid of conditions,
+///     walking the grid line by line
+///
+/// The conditions of grid point `(i_0, i_1, ...)` are
+/// \code
+/// initial_conditions + i_0 * conditions_increments[0]
+///     + i_1 * conditions_increments[1] + ...
+/// \endcode
+/// for `i_a` in `[0, n_points[a])`. A line is the set of grid points that
+/// differ only in `i_0`. The grid point index is
+/// `i_0 + n_points[0] * (i_1 + n_points[1] * (i_2 + ...))`.
+///
+/// If `independent_lines` is false, the grid is walked in "snake" order:
+/// lines are visited in order, alternately in the direction of increasing
+/// and decreasing `i_0`, so that consecutive grid points are always
+/// neighbors. With `dependent_runs`, each run starts from the final
+/// configuration of the previous grid point, including at the start of each
+/// line, so warm starts are kept across lines.
+///
+/// If `independent_lines` is true, each line is walked in the direction of
+/// increasing `i_0`, and the first grid point of each line uses the
+/// ConfigGenerator. With `dependent_runs`, each other run starts from the
+/// final configuration of the previous grid point on its line. Lines do
+/// not depend on each other, so `run_series_parallel` performs them
+/// concurrently (see `StateGenerator::has_independent_lines`).
+///
+/// Notes:
+/// - Completion is tracked per grid point. When restarting, the grid point
+///   of each completed run is recovered from its conditions, and only the
+///   remaining grid points are run.
+/// - When runs of different lines are performed concurrently, completed
+///   runs are recorded in the order they finish.
+class GridConditionsStateGenerator
+    : public IncrementalConditionsStateGenerator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _initial_conditions The conditions at grid point `(0, 0, ...)`
+  /// \param _conditions_increments The change in conditions per step along
+  ///     each grid axis. Axis 0 is along lines. Keys must also be keys of
+  ///     `_initial_conditions`.
+  /// \param _n_points The number of grid points along each axis
+  /// \param _independent_lines If true, lines are independent of each other
+  ///     and may be performed concurrently
+  ///
+  /// Other parameters are the same as for IncrementalConditionsStateGenerator.
+  GridConditionsStateGenerator(
+      std::shared_ptr<system_type> system, RunDataOutputParams output_params,
+      std::unique_ptr<ConfigGenerator> _config_generator,
+      monte::ValueMap const &_initial_conditions,
+      std::vector<monte::ValueMap> const &_conditions_increments,
+      std::vector<Index> const &_n_points, bool _dependent_runs,
+      bool _independent_lines,
+      std::vector<StateModifyingFunction> const &_modifiers = {})
+      : IncrementalConditionsStateGenerator(
+            system, output_params, std::move(_config_generator),
+            _initial_conditions,
+            _conditions_increments.empty() ? monte::ValueMap()
+                                           : _conditions_increments[0],
+            _total_points(_n_points), _dependent_runs, _modifiers),
+        m_conditions_increments(_conditions_increments),
+        m_n_points(_n_points),
+        m_independent_lines(_independent_lines),
+        m_is_completed(_total_points(_n_points), false),
+        m_n_completed_points(0) {
+    if (m_conditions_increments.empty() ||
+        m_conditions_increments.size() != m_n_points.size()) {
+      throw std::runtime_error(
+          "Error constructing GridConditionsStateGenerator: "
+          "conditions_increments and n_points must be non-empty and have the "
+          "same size");
+    }
+    for (Index n : m_n_points) {
+      if (n < 1) {
+        throw std::runtime_error(
+            "Error constructing GridConditionsStateGenerator: n_points < 1");
+      }
+    }
+    for (auto const &increment : m_conditions_increments) {
+      if (is_mismatched(m_initial_conditions, increment)) {
+        throw std::runtime_error(
+            "Error constructing GridConditionsStateGenerator: Mismatch "
+            "between initial conditions and conditions increments.");
+      }
+    }
+    _make_projection();
+  }
+
+  /// \brief Number of grid points on each line
+  Index line_size() const { return m_n_points[0]; }
+
+  /// \brief Number of lines
+  Index n_lines() const { return m_is_completed.size() / m_n_points[0]; }
+
+  /// \brief Check if all grid points have been completed
+  bool is_complete() override {
+    return m_n_completed_points == m_is_completed.size();
+  }
+
+  /// \brief Return the state of the next remaining grid point in walk order
+  state_type next_state() override { return _next_grid_state(true); }
+
+  /// \brief Return the state of the next remaining grid point in walk
+  ///     order, without applying state modifiers
+  state_type next_unmodified_state() override {
+    return _next_grid_state(false);
+  }
+
+  /// \brief States are independent only if runs are not dependent
+  bool has_independent_states() const override { return !m_dependent_runs; }
+
+  /// \brief Generate the initial states of all remaining grid points, in
+  ///     walk order
+  std::vector<state_type> remaining_states() override {
+    if (m_dependent_runs) {
+      throw std::runtime_error(
+          "Error in GridConditionsStateGenerator::remaining_states: "
+          "not allowed when dependent_runs==true");
+    }
+    std::vector<state_type> states;
+    for (Index point : _walk_order()) {
+      if (!m_is_completed[point]) {
+        states.push_back(_make_grid_state(point, nullptr));
+      }
+    }
+    return states;
+  }
+
+  /// \brief Warm starts are handled per line
+  bool allows_warm_start() const override { return false; }
+
+  /// \brief If true, the lines of the grid may be performed concurrently
+  bool has_independent_lines() const override { return m_independent_lines; }
+
+  /// \brief The remaining grid points of each line with remaining grid
+  ///     points, in walk order
+  std::vector<std::vector<Index>> remaining_lines() override {
+    std::vector<std::vector<Index>> lines;
+    for (Index line = 0; line < n_lines(); ++line) {
+      std::vector<Index> points;
+      for (Index i = 0; i < line_size(); ++i) {
+        Index point = line * line_size() + i;
+        if (!m_is_completed[point]) {
+          points.push_back(point);
+        }
+      }
+      if (points.size()) {
+        lines.push_back(points);
+      }
+    }
+    return lines;
+  }
+
+  /// \brief Generate the initial state of a grid point of a line
+  ///
+  /// \param point The grid point index
+  /// \param previous_configuration If not null, and `dependent_runs`, the
+  ///     final configuration of the previous grid point of the line, used as
+  ///     the initial configuration. Otherwise, the ConfigGenerator is used.
+  state_type line_state(Index point,
+                        config_type const *previous_configuration) override {
+    if (!m_dependent_runs) {
+      previous_configuration = nullptr;
+    }
+    return _make_grid_state(point, previous_configuration);
+  }
+
+  void push_back(RunData const &run_data) override {
+    Index point = grid_point(run_data.conditions);
+    if (!m_is_completed[point]) {
+      m_is_completed[point] = true;
+      ++m_n_completed_points;
+    }
+    if (m_dependent_runs && run_data.final_state.has_value()) {
+      m_last_point = point;
+      m_last_final_configuration = run_data.final_state->configuration;
+    }
+    IncrementalConditionsStateGenerator::push_back(run_data);
+  }
+
+  void read_completed_runs() override {
+    std::fill(m_is_completed.begin(), m_is_completed.end(), false);
+    m_n_completed_points = 0;
+    m_last_point = -1;
+    m_last_final_configuration.reset();
+    IncrementalConditionsStateGenerator::read_completed_runs();
+
+    // completed_runs.json is read without push_back
+    for (auto const &run_data : m_completed_runs) {
+      Index point = grid_point(run_data.conditions);
+      if (!m_is_completed[point]) {
+        m_is_completed[point] = true;
+        ++m_n_completed_points;
+      }
+    }
+    if (m_dependent_runs && m_completed_runs.size() &&
+        m_completed_runs.back().final_state.has_value()) {
+      m_last_point = grid_point(m_completed_runs.back().conditions);
+      m_last_final_configuration =
+          m_completed_runs.back().final_state->configuration;
+    }
+  }
+
+  /// \brief Check if a grid point has been completed
+  bool is_completed(Index point) const { return m_is_completed[point]; }
+
+  /// \brief The grid point index of `conditions`
+  ///
+  /// \throws If `conditions` are not within half a step of a grid point
+  Index grid_point(monte::ValueMap const &conditions) const {
+    Eigen::VectorXd x = _flatten(conditions) - m_initial_vector;
+    Eigen::VectorXd coord = m_projection * x;
+    Index point = 0;
+    Index stride = 1;
+    for (Index a = 0; a < m_n_points.size(); ++a) {
+      Index i = std::lround(coord(a));
+      if (i < 0 || i >= m_n_points[a] || std::abs(coord(a) - i) > 0.25) {
+        throw std::runtime_error(
+            "Error in GridConditionsStateGenerator: conditions are not on "
+            "the grid");
+      }
+      point += i * stride;
+      stride *= m_n_points[a];
+    }
+    return point;
+  }
+
+  /// \brief The conditions at a grid point
+  monte::ValueMap grid_conditions(Index point) const {
+    monte::ValueMap conditions = m_initial_conditions;
+    for (Index a = 0; a < m_n_points.size(); ++a) {
+      Index i = point % m_n_points[a];
+      point /= m_n_points[a];
+      conditions =
+          make_incremented_values(conditions, m_conditions_increments[a], i);
+    }
+    return conditions;
+  }
+
+ private:
+  static Index _total_points(std::vector<Index> const &n_points) {
+    Index total = 1;
+    for (Index n : n_points) {
+      total *= n;
+    }
+    return total;
+  }
+
+  /// \brief Incremented scalar and vector conditions, as one vector
+  Eigen::VectorXd _flatten(monte::ValueMap const &values) const {
+    std::vector<double> x;
+    for (auto const &pair : m_conditions_increments[0].scalar_values) {
+      x.push_back(values.scalar_values.at(pair.first));
+    }
+    for (auto const &pair : m_conditions_increments[0].vector_values) {
+      Eigen::VectorXd const &v = values.vector_values.at(pair.first);
+      x.insert(x.end(), v.data(), v.data() + v.size());
+    }
+    return Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+  }
+
+  /// \brief Make the matrix giving grid coordinates from the change in
+  ///     conditions, as the pseudo-inverse of the increments
+  void _make_projection() {
+    m_initial_vector = _flatten(m_initial_conditions);
+    Eigen::MatrixXd A(m_initial_vector.size(), m_n_points.size());
+    for (Index a = 0; a < m_n_points.size(); ++a) {
+      A.col(a) = _flatten(m_conditions_increments[a]);
+    }
+    Eigen::MatrixXd G = A.transpose() * A;
+    if (Eigen::FullPivLU<Eigen::MatrixXd>(G).rank() != G.rows()) {
+      throw std::runtime_error(
+          "Error constructing GridConditionsStateGenerator: conditions "
+          "increments are not linearly independent");
+    }
+    m_projection = G.inverse() * A.transpose();
+  }
+
+  /// \brief All grid points, in walk order
+  std::vector<Index> _walk_order() const {
+    std::vector<Index> order;
+    for (Index line = 0; line < n_lines(); ++line) {
+      bool reverse = !m_independent_lines && (line % 2 == 1);
+      for (Index i = 0; i < line_size(); ++i) {
+        Index j = reverse ? line_size() - 1 - i : i;
+        order.push_back(line * line_size() + j);
+      }
+    }
+    return order;
+  }
+
+  /// \brief State of the next remaining grid point in walk order,
+  ///     optionally applying the state modifiers
+  state_type _next_grid_state(bool apply_modifiers) {
+    Index previous_point = -1;
+    for (Index point : _walk_order()) {
+      if (!m_is_completed[point]) {
+        // continue from the previous grid point, if it was the last run
+        config_type const *configuration = nullptr;
+        bool is_line_start = (point % line_size()) == 0;
+        if (m_dependent_runs && previous_point >= 0 &&
+            previous_point == m_last_point &&
+            m_last_final_configuration.has_value() &&
+            !(m_independent_lines && is_line_start)) {
+          configuration = &*m_last_final_configuration;
+        }
+        return _make_grid_state(point, configuration, apply_modifiers);
+      }
+      previous_point = point;
+    }
+    throw std::runtime_error(
+        "Error in GridConditionsStateGenerator::next_state: complete");
+  }
+
+  /// \brief Make the initial state at a grid point, optionally applying the
+  ///     state modifiers
+  state_type _make_grid_state(Index point, config_type const *configuration,
+                              bool apply_modifiers = true) {
+    monte::ValueMap conditions = grid_conditions(point);
+    state_type state(configuration ? *configuration
+                                   : (*m_config_generator)(conditions,
+                                                           m_completed_runs),
+                     conditions);
+    if (apply_modifiers) {
+      modify_state(state, nullptr);
+    }
+    return state;
+  }
+
+  std::vector<monte::ValueMap> m_conditions_increments;
+  std::vector<Index> m_n_points;
+  bool m_independent_lines;
+
+  /// Which grid points are completed
+  std::vector<bool> m_is_completed;
+  Index m_n_completed_points;
+
+  /// Grid point and final configuration of the last completed run, if
+  /// `dependent_runs`
+  Index m_last_point = -1;
+  std::optional<config_type> m_last_final_configuration;
+
+  /// Flattened initial conditions
+  Eigen::VectorXd m_initial_vector;
+
+  /// Grid coordinates from flattened change in conditions
+  Eigen::MatrixXd m_projection;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef CASM_clexmonte_run_HistogramSamplingFunction
+#define CASM_clexmonte_run_HistogramSamplingFunction
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/misc/HistogramAccumulator.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+
+class jsonParser;
+
+namespace clexmonte {
+
+/// \brief Accumulates histograms of a sampled quantity in place
+///
+/// Binning the distribution of the potential energy or an order parameter
+/// after a run requires storing every sample. A HistogramSamplingFunction
+/// instead evaluates a source sampling function each time it is sampled,
+/// and adds each component of the value to a HistogramAccumulator, so
+/// memory is O(n_bins) per component rather than O(n_samples). The
+/// histograms can be used directly as input to histogram reweighting or
+/// flat-histogram methods.
+///
+/// Usage:
+/// - `make_histogram_state_sampling_function` makes a state sampling
+///   function that calls `record` each time it is sampled. Its sampled
+///   value is empty, so the sampler stores no data per sample, and it is
+///   not available for convergence checks.
+/// - After a run, `histograms` holds one histogram per component of the
+///   source value. Call `reset` before the next run.
+/// - A HistogramSamplingFunction is not thread-safe; use one per worker.
+class HistogramSamplingFunction {
+ public:
+  /// \brief Constructor
+  HistogramSamplingFunction(std::string _name, std::string _description,
+                            state_sampling_function_type _source,
+                            HistogramAccumulator _prototype);
+
+  /// \brief Sampling function name
+  std::string const name;
+
+  /// \brief Sampling function description
+  std::string const description;
+
+  /// \brief The sampling function whose values are binned
+  state_sampling_function_type const source;
+
+  /// \brief Evaluate the source function and add each component to its
+  ///     histogram
+  void record();
+
+  /// \brief Number of samples recorded
+  Index n_samples() const { return m_n_samples; }
+
+  /// \brief Names of the components of the source value
+  std::vector<std::string> const &component_names() const {
+    return source.component_names;
+  }
+
+  /// \brief Histograms, one per component of the source value
+  std::vector<HistogramAccumulator> const &histograms() const {
+    return m_histograms;
+  }
+
+  /// \brief Remove all samples
+  void reset();
+
+ private:
+  /// Empty histogram, copied for each component
+  HistogramAccumulator m_prototype;
+
+  std::vector<HistogramAccumulator> m_histograms;
+
+  Index m_n_samples;
+};
+
+/// \brief Make a state sampling function which records samples for a
+///     HistogramSamplingFunction
+monte::StateSamplingFunction make_histogram_state_sampling_function(
+    std::shared_ptr<HistogramSamplingFunction> histogram_function);
+
+/// \brief Write HistogramSamplingFunction histograms to JSON
+jsonParser &to_json(HistogramSamplingFunction const &histogram_function,
+                    jsonParser &json);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
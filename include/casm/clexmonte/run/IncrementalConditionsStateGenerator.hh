@@ -1,7 +1,9 @@
 #ifndef CASM_clexmonte_IncrementalConditionsStateGenerator
 #define CASM_clexmonte_IncrementalConditionsStateGenerator
 
+#include <fstream>
 #include <map>
+#include <optional>
 #include <string>
 
 #include "casm/clexmonte/definitions.hh"
@@ -47,9 +49,12 @@ namespace clexmonte {
 /// 4) Apply custom state modifiers, using:
 ///    \code
 ///    for (auto const &f : m_modifiers) {
-///      f(state);
+///      f(state, occ_location);
 ///    }
 ///    \endcode
+///    where `occ_location` is null for `next_state`, and is the run's
+///    occupant location tracker when a series uses `next_unmodified_state`
+///    and `modify_state`.
 /// 5) Return `state`.
 class IncrementalConditionsStateGenerator : public StateGenerator {
  public:
@@ -101,34 +106,60 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
 
   /// \brief Return the next state
   state_type next_state() override {
-    if (m_dependent_runs && m_completed_runs.size() &&
-        !m_completed_runs.back().final_state.has_value()) {
-      throw std::runtime_error(
-          "Error in IncrementalConditionsStateGenerator: when "
-          "dependent_runs==true, must save the final state of the last "
-          "completed run");
-    }
+    _check_dependent_runs();
+    return _make_state(m_completed_runs.size());
+  }
 
-    // Make conditions
-    monte::ValueMap conditions = make_incremented_values(
-        m_initial_conditions, m_conditions_increment, m_completed_runs.size());
+  /// \brief Return the next state, without applying state modifiers
+  state_type next_unmodified_state() override {
+    _check_dependent_runs();
+    return _make_state(m_completed_runs.size(), nullptr, false);
+  }
 
-    // Make configuration
-    config_type configuration =
-        (m_dependent_runs && m_completed_runs.size())
-            ? m_completed_runs.back().final_state->configuration
-            : (*m_config_generator)(conditions, m_completed_runs);
+  /// \brief Apply the state modifiers, using `occ_location` if not null
+  void modify_state(state_type &state,
+                    monte::OccLocation *occ_location) const override {
+    for (auto const &f : m_modifiers) {
+      f(state, occ_location);
+    }
+  }
 
-    // Make state
-    state_type state(configuration, conditions);
+  /// \brief If `dependent_runs` is false, the remaining states can be
+  ///     generated in advance
+  bool has_independent_states() const override { return !m_dependent_runs; }
 
-    // Apply custom modifiers
-    for (auto const &f : m_modifiers) {
-      f(state, static_cast<monte::OccLocation *>(nullptr));
+  /// \brief Generate the initial states of all remaining runs, in order
+  std::vector<state_type> remaining_states() override {
+    if (m_dependent_runs) {
+      throw std::runtime_error(
+          "Error in IncrementalConditionsStateGenerator::remaining_states: "
+          "not allowed when dependent_runs==true");
+    }
+    std::vector<state_type> states;
+    for (Index i = m_completed_runs.size(); i < m_n_states; ++i) {
+      states.push_back(_make_state(i));
     }
+    return states;
+  }
 
-    // Finished
-    return state;
+  /// \brief If `dependent_runs` is true, the next state depends on the
+  ///     previous run only through its final configuration
+  bool allows_warm_start() const override { return m_dependent_runs; }
+
+  /// \brief Generate the initial state of one of the remaining runs,
+  ///     starting from a given configuration
+  std::optional<state_type> warm_start_state(
+      Index n_runs_ahead, config_type const &configuration) override {
+    if (!m_dependent_runs || n_runs_ahead < 0) {
+      throw std::runtime_error(
+          "Error in IncrementalConditionsStateGenerator::warm_start_state: "
+          "requires dependent_runs==true and n_runs_ahead >= 0");
+    }
+    Index i = m_completed_runs.size() + n_runs_ahead;
+    if (i >= m_n_states) {
+      return std::nullopt;
+    }
+    return _make_state(i, &configuration);
   }
 
   void push_back(RunData const &run_data) override {
@@ -153,10 +184,17 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
 
   void read_completed_runs() override {
     m_completed_runs.clear();
+    m_n_written_runs = 0;
     if (m_output_params.output_dir.empty()) {
       return;
     }
 
+    if (m_output_params.append_only &&
+        fs::exists(m_output_params.output_dir / "completed_runs.jsonl")) {
+      _read_completed_runs_jsonl();
+      return;
+    }
+
     fs::path completed_runs_path =
         m_output_params.output_dir / "completed_runs.json";
     if (!fs::exists(completed_runs_path)) {
@@ -164,6 +202,9 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
     }
 
     jsonParser json(completed_runs_path);
+    for (auto &run_data_json : json) {
+      unpack_run_data_json(run_data_json);
+    }
     ParentInputParser parser{json};
     auto subparser = parser.parse_as_with<std::vector<RunData>>(
         parse_array<RunData, config::SupercellSet &>, *m_system->supercells);
@@ -175,6 +216,11 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
     report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
 
     m_completed_runs = *subparser->value;
+
+    // In append-only mode, completed_runs.jsonl is written in full next time
+    if (!m_output_params.append_only) {
+      m_n_written_runs = m_completed_runs.size();
+    }
   }
 
   void write_completed_runs() const override {
@@ -182,6 +228,11 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
       return;
     }
 
+    if (m_output_params.append_only) {
+      _append_completed_runs_jsonl();
+      return;
+    }
+
     fs::path completed_runs_path =
         m_output_params.output_dir / "completed_runs.json";
     fs::create_directories(m_output_params.output_dir);
@@ -189,17 +240,140 @@ class IncrementalConditionsStateGenerator : public StateGenerator {
     file.open(completed_runs_path);
     jsonParser json;
     to_json(m_completed_runs, json, m_output_params.write_initial_states,
-            m_output_params.write_final_states);
+            m_output_params.write_final_states,
+            m_output_params.compress_states);
     json.print(file.ofstream(), -1);
     file.close();
+    m_n_written_runs = m_completed_runs.size();
+  }
+
+ protected:
+  /// \brief Read completed_runs.jsonl
+  ///
+  /// Each complete line is one run. An incomplete last line, from an
+  /// interrupted write, is ignored and removed from the file.
+  void _read_completed_runs_jsonl() {
+    fs::path completed_runs_path =
+        m_output_params.output_dir / "completed_runs.jsonl";
+    std::ifstream file(completed_runs_path);
+    std::string line;
+    std::string complete_lines;
+    bool has_incomplete_line = false;
+    Index line_number = 0;
+    while (std::getline(file, line)) {
+      ++line_number;
+      if (file.eof()) {
+        // no newline: an interrupted write
+        has_incomplete_line = !line.empty();
+        break;
+      }
+      if (line.empty()) {
+        continue;
+      }
+      RunData run_data;
+      try {
+        from_json(run_data, jsonParser::parse(line), *m_system->supercells);
+      } catch (std::exception const &e) {
+        std::stringstream ss;
+        ss << "Error in IncrementalConditionsStateGenerator: failed to read "
+           << completed_runs_path << ", line " << line_number << ": "
+           << e.what();
+        throw std::runtime_error(ss.str());
+      }
+      // apply the same saving rules as during the series
+      push_back(run_data);
+      complete_lines += line + "\n";
+    }
+    file.close();
+
+    if (has_incomplete_line) {
+      SafeOfstream out;
+      out.open(completed_runs_path);
+      out.ofstream() << complete_lines;
+      out.close();
+    }
+    m_n_written_runs = m_completed_runs.size();
+  }
+
+  /// \brief Append runs completed since the last write to
+  ///     completed_runs.jsonl
+  void _append_completed_runs_jsonl() const {
+    fs::path completed_runs_path =
+        m_output_params.output_dir / "completed_runs.jsonl";
+    fs::create_directories(m_output_params.output_dir);
+    if (m_n_written_runs == 0 && fs::exists(completed_runs_path)) {
+      // started from completed_runs.json, or without reading
+      fs::remove(completed_runs_path);
+    }
+    std::ofstream file(completed_runs_path, std::ios::app);
+    for (Index i = m_n_written_runs; i < m_completed_runs.size(); ++i) {
+      jsonParser json;
+      to_json(m_completed_runs[i], json, m_output_params.write_initial_states,
+              m_output_params.write_final_states,
+              m_output_params.compress_states);
+      json.print(file, -1);
+      file << "\n";
+    }
+    file.flush();
+    if (!file) {
+      std::stringstream ss;
+      ss << "Error in IncrementalConditionsStateGenerator: failed to write "
+         << completed_runs_path;
+      throw std::runtime_error(ss.str());
+    }
+    m_n_written_runs = m_completed_runs.size();
+  }
+
+  /// \brief Throw if runs are dependent and the final state of the last
+  ///     completed run was not saved
+  void _check_dependent_runs() const {
+    if (m_dependent_runs && m_completed_runs.size() &&
+        !m_completed_runs.back().final_state.has_value()) {
+      throw std::runtime_error(
+          "Error in IncrementalConditionsStateGenerator: when "
+          "dependent_runs==true, must save the final state of the last "
+          "completed run");
+    }
+  }
+
+  /// \brief Make the initial state for the run with index `i` (starting
+  ///     from 0), optionally starting from a given configuration, and
+  ///     optionally applying the state modifiers
+  state_type _make_state(Index i,
+                         config_type const *warm_start_configuration = nullptr,
+                         bool apply_modifiers = true) {
+    // Make conditions
+    monte::ValueMap conditions = make_incremented_values(
+        m_initial_conditions, m_conditions_increment, i);
+
+    // Make configuration
+    config_type configuration =
+        warm_start_configuration
+            ? *warm_start_configuration
+            : ((m_dependent_runs && m_completed_runs.size())
+                   ? m_completed_runs.back().final_state->configuration
+                   : (*m_config_generator)(conditions, m_completed_runs));
+
+    // Make state
+    state_type state(configuration, conditions);
+
+    // Apply custom modifiers
+    if (apply_modifiers) {
+      modify_state(state, nullptr);
+    }
+
+    // Finished
+    return state;
   }
 
- private:
   /// System data
   std::shared_ptr<system_type> m_system;
 
   RunDataOutputParams m_output_params;
   std::vector<RunData> m_completed_runs;
+
+  /// Number of completed runs already written
+  mutable Index m_n_written_runs = 0;
   std::unique_ptr<ConfigGenerator> m_config_generator;
   monte::ValueMap m_initial_conditions;
   monte::ValueMap m_conditions_increment;
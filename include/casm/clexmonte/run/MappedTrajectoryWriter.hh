@@ -0,0 +1,89 @@
+#ifndef CASM_clexmonte_run_MappedTrajectoryWriter
+#define CASM_clexmonte_run_MappedTrajectoryWriter
+
+#include <cstdint>
+#include <string>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Streams sampled occupations to a memory-mapped binary file
+///
+/// Rather than holding sampled configurations in memory until a run
+/// finishes, each frame is copied into a preallocated, memory-mapped file as
+/// it is sampled. When the file is full its capacity is doubled.
+///
+/// File format (native byte order, which is little-endian on all supported
+/// platforms):
+/// - A 64 byte header:
+///   - `char[8]` magic: "CLXTRAJ1"
+///   - `uint64` n_sites: number of sites per frame
+///   - `uint64` bytes_per_value: 1, 2, or 4, bytes per occupation index
+///   - `uint64` record_size: bytes per frame record
+///   - `uint64` n_frames: number of frames written
+///   - `uint64` capacity: number of frame records allocated
+///   - 16 reserved bytes
+/// - `capacity` frame records, each `record_size` bytes:
+///   - `uint64` sample_index: the per-run index of the sample
+///   - `float64` time: the simulated time of the sample, or NaN if not
+///     time-based
+///   - `n_sites` unsigned occupation indices of `bytes_per_value` bytes,
+///     zero-padded to a multiple of 8 bytes
+///
+/// The header `n_frames` is updated after each frame is written, so a file
+/// may be read while it is being written, and frames written before a crash
+/// remain readable. The file is truncated to `n_frames` records by
+/// `close`. The Python class `libcasm.clexmonte.MappedTrajectory` reads the
+/// file as numpy views without copying.
+class MappedTrajectoryWriter {
+ public:
+  /// \brief Default constructor, which does not open a file
+  MappedTrajectoryWriter();
+
+  /// \brief Constructor, which opens a file (see `open`)
+  MappedTrajectoryWriter(std::string path, Index n_sites,
+                         int max_occupant_index, Index initial_capacity = 1024);
+
+  MappedTrajectoryWriter(MappedTrajectoryWriter const &) = delete;
+  MappedTrajectoryWriter &operator=(MappedTrajectoryWriter const &) = delete;
+
+  ~MappedTrajectoryWriter();
+
+  /// \brief Create, or overwrite, a trajectory file and map it
+  void open(std::string path, Index n_sites, int max_occupant_index,
+            Index initial_capacity = 1024);
+
+  /// \brief Return true if a file is open
+  bool is_open() const;
+
+  /// \brief Write one frame, and return its frame index
+  Index write(Eigen::VectorXi const &occupation, Index sample_index,
+              double time);
+
+  /// \brief Number of frames written to the open file
+  Index n_frames() const;
+
+  /// \brief Unmap, truncate to the frames written, and close the file
+  void close();
+
+ private:
+  void _map(Index capacity);
+  void _unmap();
+
+  std::string m_path;
+  int m_fd;
+  Index m_n_sites;
+  Index m_bytes_per_value;
+  Index m_record_size;
+  Index m_capacity;
+  Index m_n_frames;
+  unsigned char *m_data;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
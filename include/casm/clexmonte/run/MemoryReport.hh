@@ -0,0 +1,108 @@
+#ifndef CASM_clexmonte_run_MemoryReport
+#define CASM_clexmonte_run_MemoryReport
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+
+class jsonParser;
+class Log;
+
+namespace monte {
+class OccLocation;
+}
+
+namespace clexmonte {
+
+/// \brief Approximate memory used by each subsystem of a calculation
+///
+/// Sizes are estimated from the number of stored elements, like the
+/// estimates that are compared with the `System::supercell_data` and
+/// KineticEventDataCache memory budgets, so a report made at the start of a
+/// run in a small supercell can be used to size jobs in larger supercells,
+/// and to choose budgets, before they run out of memory.
+struct MemoryReport {
+  /// \brief Approximate memory used by one subsystem
+  struct Entry {
+    /// \brief Subsystem name
+    std::string name;
+
+    /// \brief Approximate memory used, in bytes
+    std::size_t bytes = 0;
+
+    /// \brief Memory budget of the subsystem, in bytes, if it has one
+    std::optional<std::size_t> max_bytes;
+  };
+
+  /// \brief Subsystems, in the order added
+  std::vector<Entry> entries;
+
+  /// \brief Add a subsystem
+  void add(std::string name, std::size_t bytes,
+           std::optional<std::size_t> max_bytes = std::nullopt);
+
+  /// \brief Approximate memory used by all subsystems, in bytes
+  std::size_t total_bytes() const;
+};
+
+/// \brief Write a MemoryReport to a log, in MB
+void print(Log &log, MemoryReport const &report);
+
+/// \brief Write a MemoryReport to JSON
+jsonParser &to_json(MemoryReport const &report, jsonParser &json);
+
+/// \brief Approximate memory used by an occupant location tracker, in bytes
+std::size_t approximate_memory_usage(monte::OccLocation const &occ_location,
+                                     Index n_sites);
+
+/// \brief Approximate memory used by the sampled data of a sampling
+///     fixture, in bytes
+///
+/// Includes the values of all samplers and the sample count, time, weight,
+/// and clocktime of each sample, which is the part of a sampling fixture
+/// that grows with the number of samples. Sampled JSON values and
+/// trajectories are not included.
+///
+/// \param fixture The sampling fixture
+///
+/// \returns Approximate memory used, in bytes
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+std::size_t approximate_memory_usage(
+    monte::SamplingFixture<ConfigType, StatisticsType, EngineType> const
+        &fixture) {
+  auto const &results = fixture.results();
+  std::size_t bytes = 0;
+  for (auto const &pair : results.samplers) {
+    bytes += pair.second->values().size() * sizeof(double);
+  }
+  bytes += results.sample_count.size() * sizeof(results.sample_count[0]) +
+           results.sample_time.size() * sizeof(double) +
+           results.sample_weight.size() * sizeof(double) +
+           results.sample_clocktime.size() * sizeof(double);
+  return bytes;
+}
+
+/// \brief Add the approximate memory used by the sampled data of each
+///     sampling fixture of a run manager, as subsystem
+///     "sampling_fixture/<label>"
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void add_memory_usage(
+    MemoryReport &report,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager) {
+  for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+    report.add("sampling_fixture/" + fixture_ptr->label(),
+               approximate_memory_usage(*fixture_ptr));
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef CASM_clexmonte_run_MultiHistogramReweighting
+#define CASM_clexmonte_run_MultiHistogramReweighting
+
+#include <vector>
+
+#include "casm/clexmonte/run/RunData.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Thermodynamic averages at one temperature, from
+///     `MultiHistogramReweighting`
+struct ReweightedAverages {
+  /// \brief Temperature
+  double temperature;
+
+  /// \brief Mean potential energy (per unit cell)
+  double potential_energy;
+
+  /// \brief Heat capacity (per unit cell) =
+  ///     var(potential_energy_per_supercell)/(kB*T*T*n_unitcells)
+  double heat_capacity;
+
+  /// \brief Effective number of samples, (sum w)^2 / sum w^2, where w are the
+  ///     sample weights at this temperature
+  ///
+  /// Small values indicate that the runs do not sample the energies that
+  /// are important at this temperature, and the averages are not reliable.
+  double effective_n_samples;
+};
+
+/// \brief Multi-histogram (WHAM) reweighting of potential energy samples
+///     from a series of runs at different temperatures
+///
+/// The samples from all runs are combined, without binning, to estimate the
+/// dimensionless free energy `f_k = -ln(Z_k)` of each run, by iterating
+///
+///     f_k = -ln( sum_n exp(-beta_k*E_n) / sum_j N_j*exp(f_j - beta_j*E_n) ),
+///
+/// where the sum over `n` is over all samples of all runs, `E_n` is the
+/// sample potential energy per supercell, and `N_j` is the number of
+/// samples of run `j`. Averages at any temperature are then weighted sums
+/// over all samples, so dense curves can be calculated from a few runs with
+/// overlapping energy distributions.
+///
+/// Notes:
+/// - The runs must differ only in temperature, and be in the same supercell.
+/// - Samples are treated as independent. Correlated samples do not bias the
+///   averages, but reduce their precision.
+class MultiHistogramReweighting {
+ public:
+  /// \brief Constructor
+  MultiHistogramReweighting(
+      std::vector<double> const &temperatures,
+      std::vector<Eigen::VectorXd> const &potential_energy, Index n_unitcells,
+      double tol = 1e-10, Index max_iterations = 10000);
+
+  /// \brief Number of runs
+  Index n_runs() const { return m_beta.size(); }
+
+  /// \brief Total number of samples
+  Index n_samples() const { return m_energy.size(); }
+
+  /// \brief Dimensionless free energy, `-ln(Z_k)`, of each run, relative to
+  ///     the first run
+  Eigen::VectorXd const &free_energy() const { return m_f; }
+
+  /// \brief True if the free energies converged within `max_iterations`
+  bool converged() const { return m_converged; }
+
+  /// \brief Number of iterations used to solve for the free energies
+  Index n_iterations() const { return m_n_iterations; }
+
+  /// \brief Reweighted averages at a temperature
+  ReweightedAverages averages(double temperature) const;
+
+  /// \brief Reweighted averages at each of a series of temperatures
+  std::vector<ReweightedAverages> averages(
+      std::vector<double> const &temperatures) const;
+
+ private:
+  /// \brief Update `m_log_denominator` from `m_f`
+  void _update_log_denominator();
+
+  Index m_n_unitcells;
+
+  /// \brief 1/(kB*T) of each run
+  Eigen::VectorXd m_beta;
+
+  /// \brief ln(number of samples) of each run
+  Eigen::VectorXd m_log_n_samples;
+
+  /// \brief Potential energy per supercell of all samples of all runs
+  Eigen::VectorXd m_energy;
+
+  /// \brief ln( sum_j N_j*exp(f_j - beta_j*E_n) ), for each sample
+  Eigen::VectorXd m_log_denominator;
+
+  Eigen::VectorXd m_f;
+
+  bool m_converged;
+
+  Index m_n_iterations;
+};
+
+/// \brief Construct multi-histogram reweighting for a completed series of
+///     runs at different temperatures
+MultiHistogramReweighting make_multi_histogram_reweighting(
+    std::vector<RunData> const &completed_runs,
+    std::vector<Eigen::VectorXd> const &potential_energy, double tol = 1e-10,
+    Index max_iterations = 10000);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef CASM_clexmonte_run_ObservationStream
+#define CASM_clexmonte_run_ObservationStream
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Streams sampled observations to a columnar on-disk store
+///
+/// Observations of each sampler are buffered, and appended in chunks of
+/// `chunk_size` rows, to one file per sampler, so writing observations does
+/// not require holding a run's full sampled history in a results file
+/// buffer:
+///
+///     <output_dir>/
+///       run.<run_index>/
+///         observations.json
+///         <sampler_name>.bin
+///
+/// Each "<sampler_name>.bin" file stores values in native byte order,
+/// row-major, with one row of `n_components` values per sample. Values are
+/// float64, except for samplers in `float32_sampler_names`, which are
+/// stored as float32 to halve the output size of long trajectories. Values
+/// are sampled, and statistics are calculated, in double precision either
+/// way. "observations.json" is rewritten with each flush:
+///
+///     {
+///       "<sampler_name>": {
+///         "file": "<sampler_name>.bin",
+///         "dtype": "float64" | "float32",
+///         "component_names": [...],
+///         "n_samples": int
+///       }, ...
+///     }
+///
+/// Usage:
+/// - Sampling functions are wrapped, with
+///   `make_streaming_sampling_functions`, to append each sampled value.
+/// - `begin_run` must be called before each run, and `end_run` or the
+///   destructor flushes the last run.
+/// - An ObservationStream is not thread-safe; use one per worker.
+class ObservationStream {
+ public:
+  /// \brief Constructor
+  ObservationStream(fs::path _output_dir, Index _chunk_size = 1000,
+                    std::set<std::string> _float32_sampler_names = {});
+
+  ObservationStream(ObservationStream const &) = delete;
+  ObservationStream &operator=(ObservationStream const &) = delete;
+
+  ~ObservationStream();
+
+  /// \brief Output directory
+  fs::path const output_dir;
+
+  /// \brief Number of rows buffered per sampler before they are written
+  Index const chunk_size;
+
+  /// \brief Names of samplers whose values are stored as float32
+  std::set<std::string> const float32_sampler_names;
+
+  /// \brief Flush the previous run, and begin writing a new run
+  void begin_run(Index run_index);
+
+  /// \brief Append one sampled value
+  void append(std::string const &sampler_name,
+              std::vector<std::string> const &component_names,
+              Eigen::VectorXd const &value);
+
+  /// \brief Write buffered rows and the index of the current run
+  void flush();
+
+  /// \brief Flush and close the current run
+  void end_run();
+
+ private:
+  struct Column {
+    std::vector<std::string> component_names;
+    std::ofstream file;
+    bool is_float32 = false;
+    std::vector<double> buffer;
+    Index n_samples = 0;
+  };
+
+  void _flush_column(Column &column);
+
+  fs::path m_run_dir;
+
+  bool m_is_open;
+
+  std::map<std::string, Column> m_columns;
+};
+
+/// \brief Wrap sampling functions so that sampled values are also appended
+///     to an ObservationStream
+monte::StateSamplingFunctionMap make_streaming_sampling_functions(
+    monte::StateSamplingFunctionMap sampling_functions,
+    std::vector<std::string> const &sampler_names,
+    std::shared_ptr<ObservationStream> observation_stream);
+
+/// \brief Read the observations of one sampler for one run, written by an
+///     ObservationStream
+Eigen::MatrixXd read_streamed_observations(fs::path const &output_dir,
+                                           Index run_index,
+                                           std::string const &sampler_name);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
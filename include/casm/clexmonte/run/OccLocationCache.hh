@@ -0,0 +1,105 @@
+#ifndef CASM_clexmonte_run_OccLocationCache
+#define CASM_clexmonte_run_OccLocationCache
+
+#include <memory>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/events/OccEvent.hh"
+
+namespace CASM {
+namespace monte {
+class OccLocation;
+}
+
+namespace clexmonte {
+struct SupercellSystemData;
+
+/// \brief Holds an occupant location tracker that is reused by consecutive
+///     runs in the same supercell
+///
+/// A series of runs used to construct a new `monte::OccLocation` for each
+/// run, which for long series of short runs spends a noticeable amount of
+/// time allocating and freeing its occupant and location lists. An
+/// OccLocationCache keeps the occupant location tracker of the last run and,
+/// if the next run is in the same supercell, updates it for the occupation
+/// of the next run:
+///
+/// - If `update_species` is false, the species of each tracked occupant is
+///   compared with the occupation of the next run. In a series of dependent
+///   runs, where each run starts from the final state of the previous run,
+///   nothing has changed and the tracker is used as is. If only a few sites
+///   have changed, for instance by state modifying functions, at most
+///   `max_changed_fraction` of the tracked occupants, the tracker is updated
+///   by applying the changes as one event.
+/// - Otherwise, or if `update_species` is true, so that atom trajectories
+///   must start over, the tracker is re-initialized, reusing its storage.
+///
+/// Notes:
+/// - Holds a shared pointer to the SupercellSystemData of the tracked
+///   supercell, so that the index conversions and candidate list referenced
+///   by the tracker are not evicted from `System::supercell_data`
+/// - Not thread-safe; each thread of a series should use its own
+///   OccLocationCache
+class OccLocationCache {
+ public:
+  /// \brief Constructor
+  explicit OccLocationCache(bool _update_species,
+                            double _max_changed_fraction = 0.1);
+
+  ~OccLocationCache();
+
+  /// \brief Passed to the `monte::OccLocation` constructor
+  bool const update_species;
+
+  /// \brief Maximum fraction of tracked occupants whose species may have
+  ///     changed for the tracker to be updated rather than re-initialized
+  double const max_changed_fraction;
+
+  /// \brief Return an occupant location tracker initialized with the
+  ///     occupation of `state`
+  monte::OccLocation &get(System &system, state_type const &state);
+
+  /// \brief Number of times a new occupant location tracker was constructed
+  Index n_constructed() const { return m_n_constructed; }
+
+  /// \brief Number of times an occupant location tracker was initialized,
+  ///     including when constructed
+  Index n_initialized() const { return m_n_initialized; }
+
+  /// \brief Number of times an occupant location tracker was reused without
+  ///     being initialized
+  Index n_reused() const { return m_n_reused; }
+
+  /// \brief Number of sites which were changed, for the last tracker that
+  ///     was reused
+  Index n_changed_sites() const { return m_n_changed_sites; }
+
+ private:
+  /// \brief Apply the occupation of `state` to a tracker of the same
+  ///     supercell, if few sites changed
+  bool _update(state_type const &state);
+
+  std::shared_ptr<SupercellSystemData> m_supercell_data;
+
+  std::unique_ptr<monte::OccLocation> m_occ_location;
+
+  Index m_n_constructed;
+
+  Index m_n_initialized;
+
+  Index m_n_reused;
+
+  Index m_n_changed_sites;
+
+  /// Scratch event, holding changed sites
+  monte::OccEvent m_event;
+
+  /// Scratch occupation, passed to `monte::OccLocation::apply`
+  Eigen::VectorXi m_occupation;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef CASM_clexmonte_run_RunCheckpoint
+#define CASM_clexmonte_run_RunCheckpoint
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/state/CompactOccupation.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/global/eigen.hh"
+#include "casm/global/filesystem.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Data saved by a mid-run checkpoint
+struct RunCheckpointData {
+  /// \brief Index of the run in the series
+  Index run_index;
+
+  /// \brief Occupation at the checkpoint, stored compactly so that pending
+  ///     checkpoints of large supercells use little memory
+  CompactOccupation occupation;
+
+  /// \brief Random number engine state at the checkpoint, as written by
+  ///     `operator<<`
+  std::string engine_state;
+};
+
+/// \brief Writes mid-run checkpoints from a background thread
+///
+/// A checkpoint consists of the run index, the occupation, and the random
+/// number engine state. Checkpoints are handed off by `write`, and the JSON
+/// file, with a compact packed occupation (see `pack_occupation`), is
+/// written by a background thread. If a new checkpoint is handed off before
+/// the previous one is written, only the newest is written.
+///
+/// Usage:
+/// - Pass the writer to `run_series`, which calls `begin_run` before each
+///   run, resumes a run from a checkpoint written for the same run index,
+///   and calls `end_run` when the run is complete.
+/// - Checkpoints are taken by the "checkpoint" sampling function (see
+///   `make_run_checkpoint_f`), which must be included in the sampler names
+///   of a sampling fixture.
+///
+/// Notes:
+/// - Sampled data and completion check state are held by the monte
+///   sampling fixtures, and are not checkpointed. A resumed run starts
+///   sampling again from the checkpointed occupation and engine state, so
+///   the warm-up is not repeated, but samples taken before the checkpoint
+///   are not included in the results. For kinetic Monte Carlo, the
+///   simulated time and displacements also restart from zero.
+class RunCheckpointWriter {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _checkpoint_path Checkpoint file path
+  /// \param _period_in_s Minimum clocktime between checkpoints, used by
+  ///     the "checkpoint" sampling function
+  RunCheckpointWriter(fs::path _checkpoint_path, double _period_in_s);
+
+  RunCheckpointWriter(RunCheckpointWriter const &) = delete;
+  RunCheckpointWriter &operator=(RunCheckpointWriter const &) = delete;
+
+  /// \brief Destructor, waits for pending checkpoints to be written
+  ~RunCheckpointWriter();
+
+  /// \brief Checkpoint file path
+  fs::path const checkpoint_path;
+
+  /// \brief Minimum clocktime between checkpoints
+  double const period_in_s;
+
+  /// \brief Begin a run, setting the run index of checkpoints
+  void begin_run(Index run_index);
+
+  /// \brief Current run index
+  Index run_index() const;
+
+  /// \brief Return true if a checkpoint is due, by clocktime
+  bool is_due() const;
+
+  /// \brief Hand a checkpoint off to the background thread to be written
+  void write(RunCheckpointData data);
+
+  /// \brief Wait for pending checkpoints to be written
+  void wait();
+
+  /// \brief Wait for pending checkpoints, and remove the checkpoint file
+  void end_run();
+
+  /// \brief Read a checkpoint file, if it exists
+  std::optional<RunCheckpointData> read() const;
+
+ private:
+  void _work();
+
+  typedef std::chrono::steady_clock clock_type;
+
+  Index m_run_index;
+
+  clock_type::time_point m_last_checkpoint;
+
+  mutable std::mutex m_mutex;
+
+  std::condition_variable m_cv;
+
+  std::optional<RunCheckpointData> m_pending;
+
+  bool m_is_writing;
+
+  bool m_stop;
+
+  std::exception_ptr m_error;
+
+  std::thread m_thread;
+};
+
+/// \brief Make a checkpoint sampling function ("checkpoint")
+template <typename CalculationType, typename EngineType>
+state_sampling_function_type make_run_checkpoint_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<EngineType> engine,
+    std::shared_ptr<RunCheckpointWriter> checkpoint_writer);
+
+/// \brief Resume a state and engine from a checkpoint for the current run
+template <typename EngineType>
+bool resume_from_run_checkpoint(RunCheckpointWriter const &checkpoint_writer,
+                                state_type &state, EngineType &engine);
+
+// --- Implementation ---
+
+/// \brief Make a checkpoint sampling function ("checkpoint")
+///
+/// Each time it is sampled, if `checkpoint_writer->is_due()`, the current
+/// occupation and engine state are handed off to `checkpoint_writer`. The
+/// sampled value is 1.0 if a checkpoint was taken, else 0.0.
+///
+/// \param calculation The calculation
+/// \param engine The random number engine used by the run
+/// \param checkpoint_writer The checkpoint writer
+template <typename CalculationType, typename EngineType>
+state_sampling_function_type make_run_checkpoint_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<EngineType> engine,
+    std::shared_ptr<RunCheckpointWriter> checkpoint_writer) {
+  if (!engine || !checkpoint_writer) {
+    throw std::runtime_error(
+        "Error in make_run_checkpoint_f: engine or checkpoint_writer is null");
+  }
+  return state_sampling_function_type(
+      "checkpoint", "1.0 if a mid-run checkpoint was taken, else 0.0",
+      {},  // scalar
+      [calculation, engine, checkpoint_writer]() {
+        if (!checkpoint_writer->is_due()) {
+          return monte::reshaped(0.0);
+        }
+        RunCheckpointData data;
+        data.run_index = checkpoint_writer->run_index();
+        data.occupation =
+            make_compact_occupation(get_occupation(*calculation->state));
+        std::stringstream ss;
+        ss << *engine;
+        data.engine_state = ss.str();
+        checkpoint_writer->write(std::move(data));
+        return monte::reshaped(1.0);
+      });
+}
+
+/// \brief Resume a state and engine from a checkpoint for the current run
+///
+/// \param checkpoint_writer The checkpoint writer, with the current run
+///     index set by `begin_run`
+/// \param state The initial state of the current run. If a checkpoint for
+///     the current run index exists, its occupation is replaced by the
+///     checkpointed occupation.
+/// \param engine If a checkpoint for the current run index exists, the
+///     engine state is replaced by the checkpointed engine state.
+///
+/// \returns True if resumed from a checkpoint, false if no checkpoint exists
+///     for the current run index.
+template <typename EngineType>
+bool resume_from_run_checkpoint(RunCheckpointWriter const &checkpoint_writer,
+                                state_type &state, EngineType &engine) {
+  std::optional<RunCheckpointData> data = checkpoint_writer.read();
+  if (!data.has_value() || data->run_index != checkpoint_writer.run_index()) {
+    return false;
+  }
+  Eigen::VectorXi &occupation = get_occupation(state);
+  if (data->occupation.size() != occupation.size()) {
+    std::stringstream msg;
+    msg << "Error resuming from checkpoint: occupation size mismatch ("
+        << checkpoint_writer.checkpoint_path << ")";
+    throw std::runtime_error(msg.str());
+  }
+  std::stringstream ss(data->engine_state);
+  ss >> engine;
+  if (ss.fail()) {
+    std::stringstream msg;
+    msg << "Error resuming from checkpoint: invalid engine state ("
+        << checkpoint_writer.checkpoint_path << ")";
+    throw std::runtime_error(msg.str());
+  }
+  data->occupation.to_vector(occupation);
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef CASM_clexmonte_run_RunControl
+#define CASM_clexmonte_run_RunControl
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Actions a RunControl predicate may request
+enum class RunControlAction {
+  /// End the run as determined by the completion checks
+  proceed,
+
+  /// End the run now
+  stop,
+
+  /// Do not end the run when the completion checks are met
+  extend
+};
+
+/// \brief Name of a RunControlAction: "proceed", "stop", or "extend"
+std::string run_control_action_name(RunControlAction action);
+
+/// \brief RunControlAction from its name
+RunControlAction run_control_action_from_name(std::string const &name);
+
+/// \brief Adaptive control of a run, by a predicate evaluated after each
+///     sample
+///
+/// A RunControl lets a run end before, or continue after, its completion
+/// checks are met, based on the current results:
+///
+/// - After each new sample is taken by the sampling fixture labeled
+///   `sampling_fixture_label` (or the first sampling fixture, if empty),
+///   `predicate` is called with its results and returns an action.
+/// - `RunControlAction::stop` ends the run immediately. The run is
+///   finalized as usual, so results are written.
+/// - `RunControlAction::extend` keeps the run going even if the completion
+///   checks are met, until the predicate returns another action. A
+///   predicate that always returns `extend` results in a run that never
+///   ends.
+/// - `RunControlAction::proceed` restores the usual behavior.
+///
+/// The requested action is reset to `proceed` at the beginning of each run.
+/// Evaluation of the predicate is only triggered by a change in the number
+/// of samples, so checking for it costs one comparison per step.
+///
+/// Another thread may end a run in progress with `request_stop`, for
+/// example to cancel an asynchronous run. The request is checked with the
+/// completion checks, at every step, and is not cleared by `begin_run`, so
+/// a run that begins after a stop was requested ends immediately.
+class RunControl {
+ public:
+  typedef std::function<RunControlAction(results_type const &)>
+      predicate_type;
+
+  /// \brief Constructor
+  RunControl(predicate_type _predicate,
+             std::string _sampling_fixture_label = "");
+
+  /// \brief Function which returns the requested action, given the results
+  ///     of the sampling fixture
+  predicate_type const predicate;
+
+  /// \brief Label of the sampling fixture whose results are checked, or
+  ///     empty to use the first sampling fixture
+  std::string const sampling_fixture_label;
+
+  /// \brief Reset the requested action and sample count, at the beginning
+  ///     of a run
+  void begin_run();
+
+  /// \brief Evaluate the predicate if the number of samples has changed
+  void check(results_type const &results);
+
+  /// \brief The currently requested action
+  RunControlAction action() const { return m_action; }
+
+  /// \brief Number of times the predicate was evaluated, since the last
+  ///     `begin_run`
+  Index n_evaluations() const { return m_n_evaluations; }
+
+  /// \brief True if the last run was ended by a `stop` action or a stop
+  ///     request
+  bool stopped() const {
+    return m_action == RunControlAction::stop || stop_requested();
+  }
+
+  /// \brief Request that the run in progress, or the next run, ends now
+  ///
+  /// May be called from any thread.
+  void request_stop() { m_stop_requested.store(true); }
+
+  /// \brief Clear a stop request, so that following runs are not ended
+  void clear_stop_request() { m_stop_requested.store(false); }
+
+  /// \brief True if a stop was requested
+  bool stop_requested() const {
+    return m_stop_requested.load(std::memory_order_relaxed);
+  }
+
+ private:
+  RunControlAction m_action;
+
+  std::atomic<bool> m_stop_requested;
+
+  Index m_n_samples;
+
+  Index m_n_evaluations;
+};
+
+/// \brief Find the sampling fixture a RunControl checks
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+monte::SamplingFixture<ConfigType, StatisticsType, EngineType> const *
+find_run_control_fixture(
+    RunControl const &run_control,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager) {
+  if (run_manager.sampling_fixtures.empty()) {
+    return nullptr;
+  }
+  if (!run_control.sampling_fixture_label.empty()) {
+    for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+      if (fixture_ptr->label() == run_control.sampling_fixture_label) {
+        return fixture_ptr.get();
+      }
+    }
+  }
+  return run_manager.sampling_fixtures.front().get();
+}
+
+/// \brief Begin a run with a RunControl, if not null
+inline void begin_run_control(RunControl *run_control) {
+  if (run_control) {
+    run_control->begin_run();
+  }
+}
+
+/// \brief Evaluate a RunControl predicate if a new sample was taken
+///
+/// This is called by run loops after sampling. It does nothing if
+/// `run_control` is null.
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void check_run_control(
+    RunControl *run_control,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager) {
+  if (!run_control) {
+    return;
+  }
+  auto fixture = find_run_control_fixture(*run_control, run_manager);
+  if (fixture) {
+    run_control->check(fixture->results());
+  }
+}
+
+/// \brief Check if a run is complete, according to the run manager and a
+///     RunControl
+///
+/// \param run_control The run control, may be null
+/// \param run_manager The run manager
+///
+/// \returns True if `run_control` requests `stop` or a stop was requested;
+///     otherwise `run_manager.is_complete()`, unless `run_control` requests
+///     `extend`.
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+bool is_run_complete(
+    RunControl const *run_control,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager) {
+  if (!run_control) {
+    return run_manager.is_complete();
+  }
+  if (run_control->action() == RunControlAction::stop ||
+      run_control->stop_requested()) {
+    return true;
+  }
+  return run_manager.is_complete() &&
+         run_control->action() != RunControlAction::extend;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef CASM_clexmonte_RunData
 #define CASM_clexmonte_RunData
 
+#include <map>
 #include <optional>
+#include <string>
 
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexmonte/state/Configuration.hh"
@@ -17,6 +19,20 @@ struct RunData {
   monte::ValueMap conditions;
   Eigen::Matrix3l transformation_matrix_to_super;
   Index n_unitcells;
+
+  /// \brief Number of samples of the "before each run" run, if performed
+  ///     (with automatic equilibration, the equilibration length)
+  std::optional<Index> equilibration_n_samples;
+
+  /// \brief Number of steps of the "before each run" run, if performed
+  std::optional<Index> equilibration_n_steps;
+
+  /// \brief Time, in seconds, of each startup phase (see
+  ///     `System::startup_timings`) timed during this run or since the
+  ///     previous run, such as constructing supercell data, event lists, and
+  ///     the event selector. The first run of a series also includes the
+  ///     phases of constructing the System and calculation.
+  std::map<std::string, double> startup_time_s;
 };
 
 struct RunDataOutputParams {
@@ -35,6 +51,15 @@ struct RunDataOutputParams {
   /// \brief Write saved final_state to completed_runs.json
   bool write_final_states = false;
 
+  /// \brief If true, write the occupation of saved states in a compact,
+  ///     compressed encoding (see `pack_occupation`)
+  bool compress_states = false;
+
+  /// \brief If true, write completed_runs.jsonl, with one run per line,
+  ///     appending only the new runs each time it is written, rather than
+  ///     rewriting completed_runs.json
+  bool append_only = false;
+
   /// \brief Location to save completed_runs.json if not empty
   fs::path output_dir;
 };
@@ -0,0 +1,218 @@
+#ifndef CASM_clexmonte_run_RunSeriesCoordinator
+#define CASM_clexmonte_run_RunSeriesCoordinator
+
+#include <deque>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Bookkeeping of a coordinator that distributes a series of runs
+///     to workers and gathers their results in run order
+///
+/// The coordinator of `run_series_mpi` uses a RunSeriesCoordinator to
+/// decide which run each worker performs, and in which order results are
+/// collected; it only adds the communication. Runs are identified by their
+/// index in the series, `i` in `[0, n_runs)`, and workers by an integer id.
+///
+/// - `ready(worker)`: A worker asks for a run. Returns the next run in the
+///   queue, or nothing if the queue is empty, in which case the worker is
+///   held idle while a failed run may still be requeued.
+/// - `done(i, result)`: A run finished. Returns the results that can now be
+///   gathered in run order, that is all results from the first run not yet
+///   gathered up to the first run not yet finished.
+/// - `failed(worker, i, what)`: A run threw on a worker, which stops taking
+///   runs. The run is requeued, and given to an idle worker if there is
+///   one, unless it was attempted `max_attempts` times.
+/// - `take_workers_to_stop()`: Once all runs are finished, or no runs can
+///   be performed, returns the idle workers, which should be stopped.
+/// - `request_write(worker)` and `write_done()`: Grant permission to write
+///   results to one worker at a time, in request order.
+template <typename ResultType>
+class RunSeriesCoordinator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _n_runs Number of runs in the series
+  /// \param _n_workers Number of workers
+  /// \param _max_attempts Maximum number of times each run is attempted
+  /// \param _first_run_index Run index of run `i == 0`, used in error
+  ///     messages
+  RunSeriesCoordinator(Index _n_runs, Index _n_workers, Index _max_attempts,
+                       Index _first_run_index = 0)
+      : m_n_attempts(_n_runs, 0),
+        m_finished(_n_runs),
+        m_n_gathered(0),
+        m_n_outstanding(0),
+        m_n_active_workers(_n_workers),
+        m_max_attempts(_max_attempts),
+        m_first_run_index(_first_run_index),
+        m_is_write_granted(false) {
+    if (_max_attempts < 1) {
+      throw std::runtime_error(
+          "Error constructing RunSeriesCoordinator: max_attempts < 1");
+    }
+    for (Index i = 0; i < _n_runs; ++i) {
+      m_queue.push_back(i);
+    }
+  }
+
+  /// \brief Number of runs in the series
+  Index n_runs() const { return m_n_attempts.size(); }
+
+  /// \brief Number of times run `i` was attempted
+  Index n_attempts(Index i) const { return m_n_attempts.at(i); }
+
+  /// \brief Number of results gathered
+  Index n_gathered() const { return m_n_gathered; }
+
+  /// \brief Number of workers which have not failed or been stopped
+  Index n_active_workers() const { return m_n_active_workers; }
+
+  /// \brief True if no runs are queued or in progress
+  bool is_finished() const { return m_queue.empty() && m_n_outstanding == 0; }
+
+  /// \brief A worker is ready for a run
+  ///
+  /// \returns The index of the run the worker should perform, or nothing if
+  ///     the worker is held idle
+  std::optional<Index> ready(int worker) {
+    if (m_queue.empty()) {
+      m_idle_workers.push_back(worker);
+      return std::nullopt;
+    }
+    return _take_next();
+  }
+
+  /// \brief Run `i` finished
+  ///
+  /// \returns Results that can be gathered now, in run order
+  std::vector<ResultType> done(Index i, ResultType result) {
+    if (i < m_n_gathered || m_finished.at(i).has_value()) {
+      throw std::runtime_error(
+          "Error in RunSeriesCoordinator::done: run already finished");
+    }
+    --m_n_outstanding;
+    m_finished[i] = std::move(result);
+    std::vector<ResultType> gathered;
+    while (m_n_gathered < n_runs() && m_finished[m_n_gathered].has_value()) {
+      gathered.push_back(std::move(*m_finished[m_n_gathered]));
+      m_finished[m_n_gathered].reset();
+      ++m_n_gathered;
+    }
+    return gathered;
+  }
+
+  /// \brief Run `i` failed on `worker`, which stops taking runs
+  ///
+  /// \returns An idle worker and the requeued run it should perform, if the
+  ///     run was requeued and a worker is idle
+  std::optional<std::pair<int, Index>> failed(int worker, Index i,
+                                              std::string const &what) {
+    --m_n_outstanding;
+    --m_n_active_workers;
+    if (m_n_attempts.at(i) < m_max_attempts) {
+      m_queue.push_front(i);
+      if (m_idle_workers.size()) {
+        int idle_worker = m_idle_workers.front();
+        m_idle_workers.pop_front();
+        return std::make_pair(idle_worker, _take_next());
+      }
+    } else {
+      std::stringstream msg;
+      msg << "Run " << m_first_run_index + i << " failed " << m_n_attempts[i]
+          << " times: " << what;
+      m_errors.push_back(msg.str());
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Idle workers to stop, if all runs are finished
+  ///
+  /// Returned workers are no longer active.
+  std::vector<int> take_workers_to_stop() {
+    std::vector<int> workers;
+    if (!is_finished()) {
+      return workers;
+    }
+    while (m_idle_workers.size()) {
+      workers.push_back(m_idle_workers.front());
+      m_idle_workers.pop_front();
+      --m_n_active_workers;
+    }
+    return workers;
+  }
+
+  /// \brief A worker requests permission to write results
+  ///
+  /// \returns True if permission is granted now; otherwise, the worker
+  ///     waits until it is returned by `write_done`
+  bool request_write(int worker) {
+    if (!m_is_write_granted) {
+      m_is_write_granted = true;
+      return true;
+    }
+    m_write_waiters.push_back(worker);
+    return false;
+  }
+
+  /// \brief The worker granted permission finished writing
+  ///
+  /// \returns The next worker granted permission, if any is waiting
+  std::optional<int> write_done() {
+    if (m_write_waiters.empty()) {
+      m_is_write_granted = false;
+      return std::nullopt;
+    }
+    int worker = m_write_waiters.front();
+    m_write_waiters.pop_front();
+    return worker;
+  }
+
+  /// \brief Errors for runs that failed `max_attempts` times or were not
+  ///     performed because no workers remained
+  std::vector<std::string> errors() const {
+    std::vector<std::string> _errors = m_errors;
+    for (Index i : m_queue) {
+      std::stringstream msg;
+      msg << "Run " << m_first_run_index + i
+          << " was not performed: no workers remaining";
+      _errors.push_back(msg.str());
+    }
+    return _errors;
+  }
+
+ private:
+  Index _take_next() {
+    Index i = m_queue.front();
+    m_queue.pop_front();
+    ++m_n_attempts[i];
+    ++m_n_outstanding;
+    return i;
+  }
+
+  std::deque<Index> m_queue;
+  std::vector<Index> m_n_attempts;
+  std::vector<std::optional<ResultType>> m_finished;
+  Index m_n_gathered;
+  Index m_n_outstanding;
+  Index m_n_active_workers;
+  Index m_max_attempts;
+  Index m_first_run_index;
+  std::deque<int> m_idle_workers;
+  bool m_is_write_granted;
+  std::deque<int> m_write_waiters;
+  std::vector<std::string> m_errors;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef CASM_clexmonte_run_SamplingFunctionProfiler
+#define CASM_clexmonte_run_SamplingFunctionProfiler
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Collects the number of calls and total time of sampling functions
+///
+/// Usage:
+/// - Sampling functions are wrapped, with
+///   `make_profiled_sampling_functions`, to record each call.
+/// - `entries` returns the collected call counts and times, by sampling
+///   function name, which can be used to find the sampling functions that
+///   dominate sampling time.
+/// - A SamplingFunctionProfiler is thread-safe, so one profiler may be
+///   shared by the sampling functions of multiple workers.
+class SamplingFunctionProfiler {
+ public:
+  /// \brief Profile of one sampling function
+  struct Entry {
+    /// \brief Number of calls
+    Index n_calls = 0;
+
+    /// \brief Total time spent in calls, in seconds
+    double total_time_s = 0.0;
+  };
+
+  /// \brief Record one call of a sampling function
+  void record(std::string const &name, double time_s);
+
+  /// \brief Return the profile of each sampling function called
+  std::map<std::string, Entry> entries() const;
+
+  /// \brief Clear all entries
+  void reset();
+
+ private:
+  mutable std::mutex m_mutex;
+  std::map<std::string, Entry> m_entries;
+};
+
+/// \brief Wrap sampling functions so that each call is recorded by a
+///     SamplingFunctionProfiler
+monte::StateSamplingFunctionMap make_profiled_sampling_functions(
+    monte::StateSamplingFunctionMap sampling_functions,
+    std::vector<std::string> const &sampler_names,
+    std::shared_ptr<SamplingFunctionProfiler> profiler);
+
+/// \brief Wrap JSON sampling functions so that each call is recorded by a
+///     SamplingFunctionProfiler
+monte::jsonStateSamplingFunctionMap make_profiled_json_sampling_functions(
+    monte::jsonStateSamplingFunctionMap json_sampling_functions,
+    std::vector<std::string> const &json_sampler_names,
+    std::shared_ptr<SamplingFunctionProfiler> profiler);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
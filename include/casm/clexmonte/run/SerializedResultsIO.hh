@@ -0,0 +1,62 @@
+#ifndef CASM_clexmonte_run_SerializedResultsIO
+#define CASM_clexmonte_run_SerializedResultsIO
+
+#include <memory>
+#include <mutex>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/monte/run_management/SamplingFixture.hh"
+#include "casm/monte/run_management/io/ResultsIO.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A ResultsIO, used by worker threads, that holds a shared mutex
+///     while reading or writing
+///
+/// Results are read and written by the wrapped ResultsIO. All the
+/// SerializedResultsIO of a series share one mutex, so results files which
+/// are read and rewritten to add a run, such as "summary.json", are never
+/// written concurrently by different workers. This is the thread
+/// counterpart of the ResultsIO used by the worker ranks of
+/// `run_series_mpi`.
+class SerializedResultsIO : public results_io_type {
+ public:
+  SerializedResultsIO(std::shared_ptr<results_io_type> _results_io,
+                      std::shared_ptr<std::mutex> _mutex)
+      : m_results_io(std::move(_results_io)), m_mutex(std::move(_mutex)) {}
+
+  std::vector<monte::ValueMap> read_conditions() override {
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    return m_results_io->read_conditions();
+  }
+
+  void write(results_type const &results, monte::ValueMap const &conditions,
+             Index run_index) override {
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    m_results_io->write(results, conditions, run_index);
+  }
+
+ private:
+  std::shared_ptr<results_io_type> m_results_io;
+  std::shared_ptr<std::mutex> m_mutex;
+};
+
+/// \brief Replace the ResultsIO of each sampling fixture with a
+///     SerializedResultsIO using `mutex`
+inline void serialize_results_io(
+    std::vector<sampling_fixture_params_type> &sampling_fixture_params,
+    std::shared_ptr<std::mutex> const &mutex) {
+  for (auto &params : sampling_fixture_params) {
+    if (params.results_io) {
+      std::shared_ptr<results_io_type> results_io(
+          std::move(params.results_io));
+      params.results_io.reset(new SerializedResultsIO(results_io, mutex));
+    }
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_StateGenerator
 #define CASM_clexmonte_StateGenerator
 
+#include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include "casm/casm_io/SafeOfstream.hh"
@@ -36,6 +38,27 @@ class StateGenerator {
   ///     runs
   virtual state_type next_state() = 0;
 
+  /// \brief Generate the next initial state, without applying state
+  ///     modifying functions
+  ///
+  /// A series applies the state modifying functions afterwards with
+  /// `modify_state`, once the run's occupant location tracker is
+  /// initialized, so that modifiers such as "enforce.composition" use it
+  /// rather than full scans or a temporary tracker. The default returns
+  /// `next_state()`, for state generators without state modifying
+  /// functions.
+  virtual state_type next_unmodified_state() { return next_state(); }
+
+  /// \brief Apply the state modifying functions to a state from
+  ///     `next_unmodified_state`
+  ///
+  /// \param state The state to modify
+  /// \param occ_location If not null, an occupant location tracker
+  ///     initialized for `state`. Modifiers that change the occupation must
+  ///     then apply the changes through it, so that it remains up to date.
+  virtual void modify_state(state_type &state,
+                            monte::OccLocation *occ_location) const {}
+
   /// \brief Push back data for a completed run
   virtual void push_back(RunData const &run_data) = 0;
 
@@ -46,6 +69,80 @@ class StateGenerator {
   virtual void read_completed_runs() = 0;
 
   virtual void write_completed_runs() const = 0;
+
+  /// \brief Check if the initial states of all remaining runs can be
+  ///     generated before any of them are run, so that they may be run in
+  ///     parallel
+  virtual bool has_independent_states() const { return false; }
+
+  /// \brief Generate the initial states of all remaining runs, in order
+  ///
+  /// Notes:
+  /// - Only valid if `has_independent_states()` is true
+  virtual std::vector<state_type> remaining_states() {
+    throw std::runtime_error(
+        "Error in StateGenerator::remaining_states: not supported by this "
+        "state generator");
+  }
+
+  /// \brief Check if the remaining runs are partitioned into lines, which
+  ///     are independent of each other and may be performed concurrently
+  ///
+  /// The runs of each line are performed in order, and each run may start
+  /// from the final configuration of the previous run of its line (see
+  /// `line_state`).
+  virtual bool has_independent_lines() const { return false; }
+
+  /// \brief The remaining runs of each line, as state generator specific
+  ///     point indices, in the order they are run
+  ///
+  /// Notes:
+  /// - Only valid if `has_independent_lines()` is true
+  virtual std::vector<std::vector<Index>> remaining_lines() {
+    throw std::runtime_error(
+        "Error in StateGenerator::remaining_lines: not supported by this "
+        "state generator");
+  }
+
+  /// \brief Generate the initial state of a point of a line
+  ///
+  /// Notes:
+  /// - Only valid if `has_independent_lines()` is true
+  ///
+  /// \param point A point index, from `remaining_lines`
+  /// \param previous_configuration The final configuration of the previous
+  ///     run of the line, or null for the first run of the line
+  virtual state_type line_state(Index point,
+                                config_type const *previous_configuration) {
+    throw std::runtime_error(
+        "Error in StateGenerator::line_state: not supported by this "
+        "state generator");
+  }
+
+  /// \brief Check if the initial state of the next run depends on the
+  ///     previous run only through its final configuration, so that it
+  ///     may be generated from a configuration of a previous run that is
+  ///     not yet finished using `warm_start_state`
+  virtual bool allows_warm_start() const { return false; }
+
+  /// \brief Generate the initial state of one of the remaining runs,
+  ///     starting from a given configuration
+  ///
+  /// Notes:
+  /// - Only valid if `allows_warm_start()` is true
+  ///
+  /// \param n_runs_ahead The number of remaining runs before the run whose
+  ///     state is generated. For the next run, use 0.
+  /// \param configuration The initial configuration
+  ///
+  /// \returns The state, or std::nullopt if there are not more than
+  ///     `n_runs_ahead` remaining runs
+  virtual std::optional<state_type> warm_start_state(
+      Index n_runs_ahead, config_type const &configuration) {
+    throw std::runtime_error(
+        "Error in StateGenerator::warm_start_state: not supported by this "
+        "state generator");
+  }
 };
 
 }  // namespace clexmonte
@@ -0,0 +1,263 @@
+#ifndef CASM_clexmonte_run_TelemetryChannel
+#define CASM_clexmonte_run_TelemetryChannel
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/run_management/RunManager.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Progress of a run, published by the run loop to a TelemetryChannel
+struct TelemetryRecord {
+  /// \brief Run index, from the run manager
+  Index run_index = 0;
+
+  /// \brief Label of the sampling fixture the record was made from
+  std::string sampling_fixture_label;
+
+  /// \brief Number of steps, `steps_per_pass * pass + step`
+  Index n_steps = 0;
+
+  /// \brief Number of passes
+  Index n_passes = 0;
+
+  /// \brief Number of accepted events
+  Index n_accept = 0;
+
+  /// \brief Number of rejected events
+  Index n_reject = 0;
+
+  /// \brief `n_accept / (n_accept + n_reject)`, or 0.0 if no events
+  double acceptance_rate = 0.0;
+
+  /// \brief Time the record was made, in seconds since the channel was
+  ///     constructed
+  double clocktime = 0.0;
+
+  /// \brief Steps per second since the previous record of the same run, or
+  ///     0.0 for the first record of a run
+  double events_per_s = 0.0;
+
+  /// \brief Number of samples taken
+  Index n_samples = 0;
+
+  /// \brief The most recent sampled value of each of the channel's
+  ///     `sampler_names`, or an empty vector if not sampled yet
+  std::vector<Eigen::VectorXd> sampled_values;
+
+  /// \brief True if all requested quantities are equilibrated, as of the
+  ///     last completion check
+  bool all_equilibrated = false;
+
+  /// \brief True if all requested quantities are converged, as of the last
+  ///     completion check
+  bool all_converged = false;
+
+  /// \brief True if the sampling fixture is complete, as of the last
+  ///     completion check
+  bool is_complete = false;
+
+  /// \brief True for the record published when a run is finalized
+  bool is_final = false;
+};
+
+/// \brief A bounded, lock-free channel of TelemetryRecord from a run loop
+///     to a consumer
+///
+/// A TelemetryChannel is a single-producer, single-consumer ring buffer of
+/// `capacity` records:
+///
+/// - The run loop publishes a record, with `publish_telemetry`, each time it
+///   checks whether the run status is due, if at least `min_interval_s`
+///   seconds have passed since the last record, and when the run is
+///   finalized. Publishing fills a preallocated slot and never waits for the
+///   consumer; if the buffer is full the record is dropped and counted by
+///   `n_dropped`.
+/// - A consumer, such as a monitoring thread, calls `read` to take all
+///   published records.
+///
+/// Only one run loop may publish to a channel at a time, and only one thread
+/// may read from it at a time.
+class TelemetryChannel {
+ public:
+  typedef std::chrono::steady_clock clock_type;
+
+  /// \brief Constructor
+  TelemetryChannel(Index _capacity = 1024, double _min_interval_s = 0.0,
+                   std::vector<std::string> _sampler_names = {},
+                   std::string _sampling_fixture_label = "");
+
+  TelemetryChannel(TelemetryChannel const &) = delete;
+  TelemetryChannel &operator=(TelemetryChannel const &) = delete;
+
+  /// \brief Maximum number of unread records
+  Index const capacity;
+
+  /// \brief Minimum time between records published during a run, in seconds
+  double const min_interval_s;
+
+  /// \brief Names of the samplers whose most recent values are included in
+  ///     records
+  std::vector<std::string> const sampler_names;
+
+  /// \brief Label of the sampling fixture records are made from, or empty
+  ///     to use the first sampling fixture
+  std::string const sampling_fixture_label;
+
+  /// \brief Seconds since the channel was constructed
+  double clocktime() const;
+
+  /// \brief Producer: True if `min_interval_s` has passed since the last
+  ///     published record
+  bool is_due() const;
+
+  /// \brief Producer: Fill and publish a record, unless the buffer is full
+  template <typename FillF>
+  bool try_publish(FillF fill);
+
+  /// \brief Producer: Record the time and step count of a new record and
+  ///     return the steps per second since the previous record
+  double update_events_per_s(Index run_index, Index n_steps, double now);
+
+  /// \brief Consumer: Take all published records, oldest first
+  std::vector<TelemetryRecord> read();
+
+  /// \brief Number of published records
+  Index n_published() const { return m_head.load(std::memory_order_relaxed); }
+
+  /// \brief Number of records dropped because the buffer was full
+  Index n_dropped() const {
+    return m_n_dropped.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Number of published records not yet read
+  Index n_unread() const {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_acquire);
+  }
+
+ private:
+  clock_type::time_point m_start;
+
+  std::vector<TelemetryRecord> m_slots;
+
+  /// Number of records published; written by the producer only
+  std::atomic<Index> m_head;
+
+  /// Number of records read; written by the consumer only
+  std::atomic<Index> m_tail;
+
+  std::atomic<Index> m_n_dropped;
+
+  // --- Producer-only state ---
+
+  double m_last_time;
+
+  Index m_last_run_index;
+
+  Index m_last_n_steps;
+};
+
+/// \brief Producer: Fill and publish a record, unless the buffer is full
+///
+/// \param fill A function, with signature `void fill(TelemetryRecord &)`,
+///     which sets the record. The record is a reused slot, holding a
+///     previously published record, so `fill` must set every member.
+///
+/// \returns True if the record was published, false if it was dropped
+template <typename FillF>
+bool TelemetryChannel::try_publish(FillF fill) {
+  Index head = m_head.load(std::memory_order_relaxed);
+  Index tail = m_tail.load(std::memory_order_acquire);
+  if (head - tail >= capacity) {
+    m_n_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  fill(m_slots[head % capacity]);
+  m_head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+/// \brief Publish the progress of a run to a TelemetryChannel, if due
+///
+/// This is called by run loops where the run status is checked. It does
+/// nothing if `channel` is null, or if `is_final` is false and
+/// `channel->is_due()` is false.
+///
+/// \param channel The channel, may be null
+/// \param run_manager The run manager of the run in progress
+/// \param is_final If true, publish regardless of `min_interval_s`. Used
+///     when the run is finalized.
+template <typename ConfigType, typename StatisticsType, typename EngineType>
+void publish_telemetry(
+    TelemetryChannel *channel,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> const
+        &run_manager,
+    bool is_final = false) {
+  if (!channel || run_manager.sampling_fixtures.empty()) {
+    return;
+  }
+  if (!is_final && !channel->is_due()) {
+    return;
+  }
+
+  auto fixture = run_manager.sampling_fixtures.front();
+  if (!channel->sampling_fixture_label.empty()) {
+    for (auto const &fixture_ptr : run_manager.sampling_fixtures) {
+      if (fixture_ptr->label() == channel->sampling_fixture_label) {
+        fixture = fixture_ptr;
+        break;
+      }
+    }
+  }
+  auto const &results = fixture->results();
+  auto const &counter = fixture->counter();
+
+  double now = channel->clocktime();
+  Index run_index = run_manager.run_index;
+  Index n_steps = counter.steps_per_pass * counter.pass + counter.step;
+  double events_per_s = channel->update_events_per_s(run_index, n_steps, now);
+
+  channel->try_publish([&](TelemetryRecord &record) {
+    record.run_index = run_index;
+    record.sampling_fixture_label = fixture->label();
+    record.n_steps = n_steps;
+    record.n_passes = counter.pass;
+    record.n_accept = results.n_accept;
+    record.n_reject = results.n_reject;
+    Index n_events = record.n_accept + record.n_reject;
+    record.acceptance_rate =
+        n_events ? double(record.n_accept) / n_events : 0.0;
+    record.clocktime = now;
+    record.events_per_s = events_per_s;
+    record.n_samples = results.sample_count.size();
+    record.sampled_values.resize(channel->sampler_names.size());
+    for (Index i = 0; i < Index(channel->sampler_names.size()); ++i) {
+      auto it = results.samplers.find(channel->sampler_names[i]);
+      if (it == results.samplers.end() || it->second->values().rows() == 0) {
+        record.sampled_values[i].resize(0);
+        continue;
+      }
+      auto const &values = it->second->values();
+      record.sampled_values[i] = values.row(values.rows() - 1).transpose();
+    }
+    auto const &completion = results.completion_check_results;
+    record.all_equilibrated =
+        completion.equilibration_check_results.all_equilibrated;
+    record.all_converged = completion.convergence_check_results.all_converged;
+    record.is_complete = completion.is_complete;
+    record.is_final = is_final;
+  });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CASM_clexmonte_run_ThermodynamicIntegration
+#define CASM_clexmonte_run_ThermodynamicIntegration
+
+#include <vector>
+
+#include "casm/clexmonte/run/RunData.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/ValueMap.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Free energy along a path of conditions, by thermodynamic
+///     integration of the mean values of a series of runs
+///
+/// The free energy per unit cell, `phi`, of the potential sampled as
+/// "potential_energy" satisfies
+///
+///     d(beta*phi) = <u> d(beta) - beta * <x> . d(mu),
+///
+/// where `u` is the potential energy per unit cell, `x` is the parametric
+/// composition, and `mu` is the parametric chemical potential. For
+/// semi-grand canonical runs `phi` is the semi-grand canonical free energy,
+/// and for canonical runs, with no chemical potential, it is the Helmholtz
+/// free energy. The runs are sorted by the path parameter `t`, and
+/// `d(beta)` and each component of `d(mu)` are integrated with the
+/// trapezoid rule, so paths may change temperature, chemical potential, or
+/// both.
+///
+/// The trapezoid error of each interval is estimated from the second
+/// divided differences of the integrands, using the neighboring runs, and
+/// `refinement_t` gives the midpoints of the intervals where it is large, so
+/// that runs are added only where the integrand curvature is high (see
+/// `AdaptiveStepParams::requested_t`).
+///
+/// Notes:
+/// - The free energy is relative to `reference_free_energy`, the free
+///   energy of the run with the smallest `t`, which must be known otherwise,
+///   for instance from a low temperature run in which `phi` is approximately
+///   `u`.
+/// - The statistical error of the mean values is not included in the error
+///   estimate.
+/// - Phase transitions along the path must be avoided, because the mean
+///   values are discontinuous, or hysteretic, at a first-order transition.
+class ThermodynamicIntegration {
+ public:
+  /// \brief Constructor
+  ThermodynamicIntegration(
+      std::vector<double> const &t, std::vector<double> const &temperature,
+      std::vector<Eigen::VectorXd> const &param_chem_pot,
+      std::vector<double> const &potential_energy,
+      std::vector<Eigen::VectorXd> const &param_composition,
+      double reference_free_energy = 0.0);
+
+  /// \brief Number of runs
+  Index n_runs() const { return m_t.size(); }
+
+  /// \brief Path parameter of each run, in increasing order
+  std::vector<double> const &t() const { return m_t; }
+
+  /// \brief The input index of each run, in order of increasing `t`
+  std::vector<Index> const &order() const { return m_order; }
+
+  /// \brief Free energy per unit cell of each run, in order of increasing
+  ///     `t`
+  Eigen::VectorXd const &free_energy() const { return m_free_energy; }
+
+  /// \brief Estimated trapezoid error of the free energy per unit cell
+  ///     accumulated between runs `i` and `i+1`, in order of increasing `t`
+  ///
+  /// Requires at least 3 runs; otherwise the estimates are 0.
+  Eigen::VectorXd const &error_estimate() const { return m_error_estimate; }
+
+  /// \brief Path parameters at which to add runs, the midpoints of the
+  ///     intervals with error estimate larger than `tol`
+  std::vector<double> refinement_t(double tol) const;
+
+ private:
+  std::vector<double> m_t;
+  std::vector<Index> m_order;
+  Eigen::VectorXd m_free_energy;
+  Eigen::VectorXd m_error_estimate;
+};
+
+/// \brief Construct thermodynamic integration for a completed series of
+///     runs along the path `initial_conditions + t * conditions_increment`
+ThermodynamicIntegration make_thermodynamic_integration(
+    std::vector<RunData> const &completed_runs,
+    monte::ValueMap const &initial_conditions,
+    monte::ValueMap const &conditions_increment,
+    std::vector<double> const &potential_energy,
+    std::vector<Eigen::VectorXd> const &param_composition,
+    double reference_free_energy = 0.0);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -20,6 +20,21 @@ results_analysis_function_type make_covariance_f(
     std::vector<std::string> second_component_names,
     std::function<double()> make_normalization_constant_f);
 
+/// \brief Mean energy of each member of an ensemble of potentials,
+///     reweighted from samples of a reference potential
+Eigen::VectorXd ensemble_reweighted_means(
+    Eigen::VectorXd const &reference_energy,
+    Eigen::MatrixXd const &ensemble_energy, double beta_n_unitcells,
+    Eigen::VectorXd *effective_n_samples = nullptr);
+
+/// \brief Make ensemble reweighting analysis function (i.e.
+///     "eci_ensemble.<key>")
+results_analysis_function_type make_ensemble_reweighting_f(
+    std::string name, std::string description,
+    std::string reference_sampler_name, std::string ensemble_sampler_name,
+    std::vector<std::string> component_names,
+    std::function<double()> make_beta_n_unitcells_f);
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -1,11 +1,28 @@
 #ifndef CASM_clexmonte_run_functions
 #define CASM_clexmonte_run_functions
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+
 #include "casm/casm_io/Log.hh"
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/misc/PhaseTimings.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
 #include "casm/clexmonte/misc/to_json.hh"
+#include "casm/clexmonte/run/AutoEquilibration.hh"
+#include "casm/clexmonte/run/BackgroundWriter.hh"
+#include "casm/clexmonte/run/ObservationStream.hh"
+#include "casm/clexmonte/run/OccLocationCache.hh"
+#include "casm/clexmonte/run/RunCheckpoint.hh"
+#include "casm/clexmonte/run/SamplingFunctionProfiler.hh"
+#include "casm/clexmonte/run/SerializedResultsIO.hh"
 #include "casm/clexmonte/run/StateGenerator.hh"
 #include "casm/clexmonte/run/io/json/RunData_json_io.hh"
+#include "casm/clexmonte/run/io/json/jsonIndexedResultsIO.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/state/io/json/State_json_io.hh"
 #include "casm/clexmonte/system/System.hh"
@@ -33,7 +50,73 @@ void run_series(
     std::vector<sampling_fixture_params_type> const &before_first_run =
         std::vector<sampling_fixture_params_type>({}),
     std::vector<sampling_fixture_params_type> const &before_each_run =
-        std::vector<sampling_fixture_params_type>({}));
+        std::vector<sampling_fixture_params_type>({}),
+    std::shared_ptr<RunCheckpointWriter> checkpoint_writer = nullptr,
+    std::shared_ptr<BackgroundWriter> background_writer = nullptr,
+    std::shared_ptr<AutoEquilibration> auto_equilibration = nullptr);
+
+/// \brief Data used by one worker thread of `run_series_parallel`
+template <typename CalculationType>
+struct SeriesWorker {
+  /// \brief The worker's calculation instance, not shared with other workers
+  std::shared_ptr<CalculationType> calculation;
+
+  /// \brief Sampling fixture parameters, with sampling functions that use
+  ///     `calculation`
+  std::vector<sampling_fixture_params_type> sampling_fixture_params;
+
+  /// \brief Optional, sampling fixture parameters for the "before first
+  ///     run" run (see `run_series`)
+  std::vector<sampling_fixture_params_type> before_first_run;
+
+  /// \brief Optional, sampling fixture parameters for the "before each
+  ///     run" runs (see `run_series`)
+  std::vector<sampling_fixture_params_type> before_each_run;
+
+  /// \brief Optional, automatic equilibration of the "before each run"
+  ///     runs (see `run_series`), which may be shared by workers
+  std::shared_ptr<AutoEquilibration> auto_equilibration;
+};
+
+/// \brief Perform the "before each run" run, and record its length
+template <typename CalculationType>
+void run_before_each_run(
+    CalculationType &calculation,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    std::vector<sampling_fixture_params_type> const &before_each_run,
+    bool global_cutoff, AutoEquilibration *auto_equilibration,
+    state_type &state, monte::OccLocation &occ_location, RunData &run_data);
+
+/// \brief Serialize the results reads and writes of all workers
+template <typename CalculationType>
+void serialize_results_io(
+    std::vector<SeriesWorker<CalculationType>> &workers);
+
+/// \brief Perform a series of independent runs, according to a
+///     state_generator, in parallel
+template <typename CalculationType>
+void run_series_parallel(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff = true);
+
+/// \brief Perform the independent lines of a series of runs in parallel
+template <typename CalculationType>
+void run_series_by_lines(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff = true);
+
+/// \brief Perform a series of dependent runs, overlapping the warm-up of
+///     each run with the previous run
+template <typename CalculationType>
+void run_series_pipelined(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff = true);
 
 /// \brief Make default SamplingFixtureParams using jsonResultsIO
 sampling_fixture_params_type make_sampling_fixture_params(
@@ -46,7 +129,11 @@ sampling_fixture_params_type make_sampling_fixture_params(
     std::vector<std::string> analysis_names, bool write_results,
     bool write_trajectory, bool write_observations, bool write_status,
     std::optional<std::string> output_dir, std::optional<std::string> log_file,
-    double log_frequency_in_s);
+    double log_frequency_in_s,
+    std::shared_ptr<ObservationStream> observation_stream = nullptr,
+    std::shared_ptr<SamplingFunctionProfiler> sampling_function_profiler =
+        nullptr,
+    bool write_indexed_results = false);
 
 // --- Implementation ---
 
@@ -70,6 +157,23 @@ sampling_fixture_params_type make_sampling_fixture_params(
 /// \param before_each_run If included, the requested run will be performed
 ///     as a preliminary step before each actual run begins. This may be
 ///     useful when not running in automatic convergence mode.
+/// \param checkpoint_writer If included, a run interrupted after a
+///     mid-run checkpoint was written is resumed from the checkpointed
+///     occupation and engine state, skipping the "before first run" and
+///     "before each run" runs, and the checkpoint is removed when the run
+///     completes. Checkpoints are taken by the "checkpoint" sampling
+///     function (see `RunCheckpointWriter`).
+/// \param background_writer If included, completed runs are written by
+///     `state_generator.write_completed_runs()` on the background thread of
+///     `background_writer`, while the next run proceeds. Each write finishes
+///     before the next run is added to `state_generator`, and before this
+///     function returns. If `checkpoint_writer` is also included, the write
+///     finishes before the checkpoint of the completed run is removed.
+/// \param auto_equilibration If included, each "before each run" run
+///     continues until a drift test passes, up to a cap, rather than
+///     according to the completion checks of `before_each_run` (see
+///     `AutoEquilibration`). The length of each "before each run" run is
+///     recorded in its RunData either way.
 ///
 /// Requires:
 /// - std::shared_ptr<system_type> CalculationType::system: Shared ptr
@@ -86,7 +190,10 @@ void run_series(
     std::vector<sampling_fixture_params_type> const &sampling_fixture_params,
     bool global_cutoff,
     std::vector<sampling_fixture_params_type> const &before_first_run,
-    std::vector<sampling_fixture_params_type> const &before_each_run) {
+    std::vector<sampling_fixture_params_type> const &before_each_run,
+    std::shared_ptr<RunCheckpointWriter> checkpoint_writer,
+    std::shared_ptr<BackgroundWriter> background_writer,
+    std::shared_ptr<AutoEquilibration> auto_equilibration) {
   typedef typename CalculationType::engine_type engine_type;
 
   auto &log = CASM::log();
@@ -101,27 +208,51 @@ void run_series(
   log.indent() << "Found " << state_generator.n_completed_runs() << std::endl
                << std::endl;
 
+  OccLocationCache occ_location_cache(calculation.update_species);
+
+  // Startup phase times as of the previous run, so each run records the
+  // phases timed since; the first run includes constructing the System
+  std::vector<std::pair<std::string, PhaseTimings::Entry>>
+      previous_startup_timings;
+
   // For all states generated, prepare input and run canonical Monte Carlo
   while (!state_generator.is_complete()) {
     run_manager.run_index = state_generator.n_completed_runs() + 1;
 
-    // Get initial state for the next calculation
+    // Get initial state for the next calculation. State modifying
+    // functions are applied once occupant tracking is initialized, so that
+    // they use the run's tracker, unless resuming from a checkpoint.
     log.indent() << "Generating next state..." << std::endl;
-    state_type state = state_generator.next_state();
+    state_type state = state_generator.next_unmodified_state();
+    bool is_modified = false;
+
+    // Optional, resume from a mid-run checkpoint
+    RunData run_data;
+    bool resumed = false;
+    if (checkpoint_writer) {
+      state_generator.modify_state(state, nullptr);
+      is_modified = true;
+      checkpoint_writer->begin_run(run_manager.run_index);
+      run_data.initial_state = state;
+      resumed = resume_from_run_checkpoint(*checkpoint_writer, state, *engine);
+      if (resumed) {
+        log.indent() << "Resuming run " << run_manager.run_index
+                     << " from checkpoint" << std::endl;
+      }
+    }
+
+    // Initialize occupant tracking, reused while the supercell is unchanged
+    monte::OccLocation &occ_location =
+        occ_location_cache.get(*calculation.system, state);
+    if (!is_modified) {
+      state_generator.modify_state(state, &occ_location);
+    }
     log.indent() << qto_json(state.conditions) << std::endl;
     log.indent() << "Done" << std::endl;
 
-    // Construct and initialize occupant tracking
-    monte::Conversions const &convert =
-        get_index_conversions(*calculation.system, state);
-    monte::OccCandidateList const &occ_candidate_list =
-        get_occ_candidate_list(*calculation.system, state);
-    monte::OccLocation occ_location(convert, occ_candidate_list,
-                                    calculation.update_species);
-    occ_location.initialize(get_occupation(state));
-
     // Optional, before first run:
-    if (before_first_run.size() && state_generator.n_completed_runs() == 0) {
+    if (!resumed && before_first_run.size() &&
+        state_generator.n_completed_runs() == 0) {
       run_manager_type<engine_type> tmp_run_manager(engine, before_first_run,
                                                     global_cutoff);
       // Run Monte Carlo at a single condition
@@ -131,22 +262,25 @@ void run_series(
     }
 
     // Optional, before each run:
-    if (before_each_run.size()) {
-      run_manager_type<engine_type> tmp_run_manager(engine, before_each_run,
-                                                    global_cutoff);
+    if (!resumed && before_each_run.size()) {
       // Run Monte Carlo at a single condition
       log.indent() << "Performing \"before-each-run\" run ..." << std::endl;
-      calculation.run(state, occ_location, tmp_run_manager);
-      log.indent() << "\"Before-each-run\" run: Done" << std::endl;
+      run_before_each_run(calculation, engine, before_each_run, global_cutoff,
+                          auto_equilibration.get(), state, occ_location,
+                          run_data);
+      log.indent() << "\"Before-each-run\" run: Done ("
+                   << *run_data.equilibration_n_samples << " samples)"
+                   << std::endl;
     }
 
     // Prepare run data
-    RunData run_data;
     run_data.transformation_matrix_to_super =
         get_transformation_matrix_to_super(state);
     run_data.n_unitcells =
         run_data.transformation_matrix_to_super.determinant();
-    run_data.initial_state = state;
+    if (!resumed) {
+      run_data.initial_state = state;
+    }
     run_data.conditions = state.conditions;
 
     // Run Monte Carlo at a single condition
@@ -158,13 +292,681 @@ void run_series(
 
     // Finalize run data
     run_data.final_state = state;
-    state_generator.push_back(run_data);
-    state_generator.write_completed_runs();
+    for (auto const &pair :
+         phase_times_since(calculation.system->startup_timings,
+                           previous_startup_timings)) {
+      run_data.startup_time_s[pair.first] = pair.second;
+    }
+    previous_startup_timings = calculation.system->startup_timings.entries();
+    if (background_writer) {
+      background_writer->wait();
+      state_generator.push_back(run_data);
+      background_writer->push(
+          [&state_generator]() { state_generator.write_completed_runs(); });
+    } else {
+      state_generator.push_back(run_data);
+      state_generator.write_completed_runs();
+    }
+    if (checkpoint_writer) {
+      if (background_writer) {
+        background_writer->wait();
+      }
+      checkpoint_writer->end_run();
+    }
+  }
+  if (background_writer) {
+    background_writer->wait();
   }
   log.indent() << "Monte Carlo calculation series complete" << std::endl;
 }
 
+/// \brief Perform the "before each run" run, and record its length
+///
+/// \param calculation The calculation
+/// \param engine Random number engine
+/// \param before_each_run Sampling fixture parameters for the "before each
+///     run" run
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete
+/// \param auto_equilibration If not null, `before_each_run` is modified by
+///     `auto_equilibration->make_sampling_fixture_params`, and the number of
+///     samples is recorded by `auto_equilibration->record`
+/// \param state The state, which is updated
+/// \param occ_location Occupant location tracker for `state`
+/// \param run_data Run data, in which the number of samples and steps of the
+///     first sampling fixture are set as the equilibration length
+template <typename CalculationType>
+void run_before_each_run(
+    CalculationType &calculation,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    std::vector<sampling_fixture_params_type> const &before_each_run,
+    bool global_cutoff, AutoEquilibration *auto_equilibration,
+    state_type &state, monte::OccLocation &occ_location, RunData &run_data) {
+  typedef typename CalculationType::engine_type engine_type;
+  run_manager_type<engine_type> run_manager(
+      engine,
+      auto_equilibration
+          ? auto_equilibration->make_sampling_fixture_params(before_each_run)
+          : before_each_run,
+      global_cutoff);
+  calculation.run(state, occ_location, run_manager);
+
+  auto const &fixture = *run_manager.sampling_fixtures.front();
+  auto const &counter = fixture.counter();
+  run_data.equilibration_n_samples = fixture.results().sample_count.size();
+  run_data.equilibration_n_steps =
+      counter.steps_per_pass * counter.pass + counter.step;
+  if (auto_equilibration) {
+    auto_equilibration->record(*run_data.equilibration_n_samples);
+  }
+}
+
+/// \brief Serialize the results reads and writes of all workers
+///
+/// The ResultsIO of every sampling fixture of every worker, including the
+/// "before first run" and "before each run" sampling fixtures, is replaced
+/// by a SerializedResultsIO sharing one mutex. Without this, workers whose
+/// sampling fixtures write to the same output directory could read and
+/// rewrite "summary.json" concurrently, losing runs or corrupting it.
+template <typename CalculationType>
+void serialize_results_io(
+    std::vector<SeriesWorker<CalculationType>> &workers) {
+  auto mutex = std::make_shared<std::mutex>();
+  for (auto &worker : workers) {
+    serialize_results_io(worker.sampling_fixture_params, mutex);
+    serialize_results_io(worker.before_first_run, mutex);
+    serialize_results_io(worker.before_each_run, mutex);
+  }
+}
+
+/// \brief Perform a series of independent runs, according to a
+///     state_generator, in parallel
+///
+/// If `state_generator.has_independent_lines()`, the lines of runs are
+/// performed in parallel by `run_series_by_lines`. Otherwise, if
+/// `state_generator.has_independent_states()`, the initial states of all
+/// remaining runs are generated first, and runs are dispatched to
+/// `n_threads` worker threads as workers become free. Otherwise, the runs
+/// are performed one after another by worker 0, as in `run_series`.
+///
+/// Notes:
+/// - Each worker has its own calculation instance, occupant location
+///   tracker, and run manager, so `CalculationType::run` is never called
+///   concurrently on the same calculation.
+/// - The random number engine for each run is seeded, using
+///   `make_stream_engine`, from one value drawn from `engine` and the run
+///   index, so results do not depend on `n_threads` or on the order in which
+///   runs finish.
+/// - Runs are added to the state generator, and `completed_runs.json` is
+///   written, in run order: a run's data is held until all earlier runs
+///   are complete.
+/// - Each worker's sampling fixtures write their results when that worker's
+///   run finishes. Results reads and writes of all workers are serialized
+///   (see `serialize_results_io`), so workers may share an output
+///   directory, but results are written in the order runs finish.
+///
+/// \param make_worker_f A function, with signature
+///     `SeriesWorker<CalculationType> make_worker_f(Index worker_index)`,
+///     which constructs the data used by each worker.
+/// \param engine Random number engine, used to seed the engine for each run
+/// \param state_generator A StateGenerator, which produces a
+///     a series of initial states
+/// \param n_threads Maximum number of worker threads to use
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete. Otherwise, all sampling fixtures must be
+///     completed for the run to be completed.
+///
+/// Requires:
+/// - The same as `run_series`
+template <typename CalculationType>
+void run_series_parallel(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff) {
+  typedef typename CalculationType::engine_type engine_type;
+
+  if (n_threads < 1) {
+    throw std::runtime_error("Error in run_series_parallel: n_threads < 1");
+  }
+
+  if (state_generator.has_independent_lines() && n_threads > 1) {
+    run_series_by_lines(make_worker_f, engine, state_generator, n_threads,
+                        global_cutoff);
+    return;
+  }
+
+  if (!state_generator.has_independent_states() || n_threads == 1) {
+    SeriesWorker<CalculationType> worker = make_worker_f(0);
+    run_series(*worker.calculation, engine, state_generator,
+               worker.sampling_fixture_params, global_cutoff,
+               worker.before_first_run, worker.before_each_run, nullptr,
+               nullptr, worker.auto_equilibration);
+    return;
+  }
+
+  auto &log = CASM::log();
+  log.begin("Monte Carlo calculation series");
+
+  log.indent() << "Checking for completed runs..." << std::endl;
+  state_generator.read_completed_runs();
+  log.indent() << "Found " << state_generator.n_completed_runs() << std::endl
+               << std::endl;
+
+  log.indent() << "Generating remaining states..." << std::endl;
+  std::vector<state_type> states = state_generator.remaining_states();
+  Index n_runs = states.size();
+  Index n_completed_before = state_generator.n_completed_runs();
+  log.indent() << "Generated " << n_runs << " states" << std::endl;
+
+  n_threads = std::max(Index(1), std::min(n_threads, n_runs));
+  std::vector<SeriesWorker<CalculationType>> workers;
+  for (Index t = 0; t < n_threads; ++t) {
+    workers.push_back(make_worker_f(t));
+  }
+  serialize_results_io(workers);
+
+  std::uint64_t stream_seed = (*engine)();
+  std::mutex mutex;
+  std::atomic<Index> next_run(0);
+  std::atomic<bool> failed(false);
+  std::vector<std::optional<RunData>> finished(n_runs);
+  Index n_pushed = 0;
+
+  auto do_work = [&](Index t) {
+    auto &worker = workers[t];
+    auto &calculation = *worker.calculation;
+    OccLocationCache occ_location_cache(calculation.update_species);
+    try {
+      while (!failed) {
+        Index i = next_run++;
+        if (i >= n_runs) {
+          return;
+        }
+        state_type state = states[i];
+        Index run_index = n_completed_before + i + 1;
+        auto run_engine =
+            make_stream_engine<engine_type>(stream_seed, run_index);
+
+        // Initialize occupant tracking, reused while the supercell is
+        // unchanged
+        monte::OccLocation &occ_location =
+            occ_location_cache.get(*calculation.system, state);
+
+        // Optional, before first run:
+        if (worker.before_first_run.size() && run_index == 1) {
+          run_manager_type<engine_type> tmp_run_manager(
+              run_engine, worker.before_first_run, global_cutoff);
+          calculation.run(state, occ_location, tmp_run_manager);
+        }
+
+        // Optional, before each run:
+        RunData run_data;
+        if (worker.before_each_run.size()) {
+          run_before_each_run(calculation, run_engine, worker.before_each_run,
+                              global_cutoff, worker.auto_equilibration.get(),
+                              state, occ_location, run_data);
+        }
+
+        // Prepare run data
+        run_data.transformation_matrix_to_super =
+            get_transformation_matrix_to_super(state);
+        run_data.n_unitcells =
+            run_data.transformation_matrix_to_super.determinant();
+        run_data.initial_state = state;
+        run_data.conditions = state.conditions;
+
+        // Run Monte Carlo at a single condition
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          log.indent() << "Performing Run " << run_index << "..."
+                       << std::endl;
+        }
+        run_manager_type<engine_type> run_manager(
+            run_engine, worker.sampling_fixture_params, global_cutoff);
+        run_manager.run_index = run_index;
+        calculation.run(state, occ_location, run_manager);
+        run_data.final_state = state;
+
+        // Record completed runs in order
+        std::lock_guard<std::mutex> lock(mutex);
+        log.indent() << "Run " << run_index << " Done" << std::endl;
+        finished[i] = std::move(run_data);
+        while (n_pushed < n_runs && finished[n_pushed].has_value()) {
+          state_generator.push_back(*finished[n_pushed]);
+          finished[n_pushed].reset();
+          ++n_pushed;
+          state_generator.write_completed_runs();
+        }
+      }
+    } catch (...) {
+      failed = true;
+      throw;
+    }
+  };
+
+  ThreadPool pool(n_threads);
+  pool.run(do_work);
+  log.indent() << "Monte Carlo calculation series complete" << std::endl;
+}
+
+/// \brief Perform the independent lines of a series of runs in parallel
+///
+/// Each line of `state_generator.remaining_lines()` is performed by one
+/// worker thread, as workers become free. The runs of a line are performed
+/// in order, and the initial state of each run is generated by
+/// `state_generator.line_state` from the final configuration of the
+/// previous run of the line.
+///
+/// Notes:
+/// - Each worker has its own calculation instance, occupant location
+///   tracker, and run manager, as in `run_series_parallel`.
+/// - The run index of each run is its point index plus one, so it does not
+///   depend on `n_threads` or on which runs were completed before a
+///   restart. The random number engine for each run is seeded, using
+///   `make_stream_engine`, from one value drawn from `engine` and the run
+///   index.
+/// - State generation, and adding completed runs to the state generator,
+///   are done while holding a lock. Runs are added, and
+///   `completed_runs.json` is written, in the order runs finish.
+/// - Results reads and writes are serialized, as in `run_series_parallel`.
+/// - The "before first run" run is performed before the run with point
+///   index 0, if it is remaining.
+///
+/// \param make_worker_f A function, with signature
+///     `SeriesWorker<CalculationType> make_worker_f(Index worker_index)`,
+///     which constructs the data used by each worker.
+/// \param engine Random number engine, used to seed the engine for each run
+/// \param state_generator A StateGenerator, with
+///     `has_independent_lines() == true`
+/// \param n_threads Maximum number of worker threads to use
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete. Otherwise, all sampling fixtures must be
+///     completed for the run to be completed.
+template <typename CalculationType>
+void run_series_by_lines(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff) {
+  typedef typename CalculationType::engine_type engine_type;
+
+  if (n_threads < 1) {
+    throw std::runtime_error("Error in run_series_by_lines: n_threads < 1");
+  }
+
+  auto &log = CASM::log();
+  log.begin("Monte Carlo calculation series");
+
+  log.indent() << "Checking for completed runs..." << std::endl;
+  state_generator.read_completed_runs();
+  log.indent() << "Found " << state_generator.n_completed_runs() << std::endl
+               << std::endl;
+
+  std::vector<std::vector<Index>> lines = state_generator.remaining_lines();
+  Index n_lines = lines.size();
+  log.indent() << "Remaining lines: " << n_lines << std::endl;
+
+  n_threads = std::max(Index(1), std::min(n_threads, n_lines));
+  std::vector<SeriesWorker<CalculationType>> workers;
+  for (Index t = 0; t < n_threads; ++t) {
+    workers.push_back(make_worker_f(t));
+  }
+  serialize_results_io(workers);
+
+  std::uint64_t stream_seed = (*engine)();
+  std::mutex mutex;
+  std::atomic<Index> next_line(0);
+  std::atomic<bool> failed(false);
+
+  auto do_work = [&](Index t) {
+    auto &worker = workers[t];
+    auto &calculation = *worker.calculation;
+    OccLocationCache occ_location_cache(calculation.update_species);
+    try {
+      while (!failed) {
+        Index i_line = next_line++;
+        if (i_line >= n_lines) {
+          return;
+        }
+        std::optional<config_type> previous_configuration;
+        for (Index point : lines[i_line]) {
+          if (failed) {
+            return;
+          }
+          state_type state = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return state_generator.line_state(
+                point, previous_configuration ? &*previous_configuration
+                                              : nullptr);
+          }();
+          Index run_index = point + 1;
+          auto run_engine =
+              make_stream_engine<engine_type>(stream_seed, run_index);
+
+          // Initialize occupant tracking, reused while the supercell is
+          // unchanged
+          monte::OccLocation &occ_location =
+              occ_location_cache.get(*calculation.system, state);
+
+          // Optional, before first run:
+          if (worker.before_first_run.size() && point == 0) {
+            run_manager_type<engine_type> tmp_run_manager(
+                run_engine, worker.before_first_run, global_cutoff);
+            calculation.run(state, occ_location, tmp_run_manager);
+          }
+
+          // Optional, before each run:
+          RunData run_data;
+          if (worker.before_each_run.size()) {
+            run_before_each_run(calculation, run_engine,
+                                worker.before_each_run, global_cutoff,
+                                worker.auto_equilibration.get(), state,
+                                occ_location, run_data);
+          }
+
+          // Prepare run data
+          run_data.transformation_matrix_to_super =
+              get_transformation_matrix_to_super(state);
+          run_data.n_unitcells =
+              run_data.transformation_matrix_to_super.determinant();
+          run_data.initial_state = state;
+          run_data.conditions = state.conditions;
+
+          // Run Monte Carlo at a single condition
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            log.indent() << "Performing Run " << run_index << "..."
+                         << std::endl;
+          }
+          run_manager_type<engine_type> run_manager(
+              run_engine, worker.sampling_fixture_params, global_cutoff);
+          run_manager.run_index = run_index;
+          calculation.run(state, occ_location, run_manager);
+          run_data.final_state = state;
+          previous_configuration = state.configuration;
+
+          // Record completed runs as they finish
+          std::lock_guard<std::mutex> lock(mutex);
+          log.indent() << "Run " << run_index << " Done" << std::endl;
+          state_generator.push_back(run_data);
+          state_generator.write_completed_runs();
+        }
+      }
+    } catch (...) {
+      failed = true;
+      throw;
+    }
+  };
+
+  ThreadPool pool(n_threads);
+  pool.run(do_work);
+  log.indent() << "Monte Carlo calculation series complete" << std::endl;
+}
+
+/// \brief Perform a series of dependent runs, overlapping the warm-up of
+///     each run with the previous run
+///
+/// In `run_series`, with dependent runs, each run starts from the final
+/// state of the previous run, and begins with the optional "before each
+/// run" run, which here acts as a warm-up (equilibration) stage. This
+/// method instead starts the warm-up of each run from the state at the end
+/// of the previous run's warm-up, so that the warm-up of run `k+1` is
+/// performed while run `k` is sampled:
+/// - Thread 0 performs the warm-ups, in order, each starting from the
+///   configuration at the end of the previous warm-up (for the first
+///   remaining run, the state from `state_generator.next_state()`).
+/// - After its warm-up, each run is sampled, starting from the state at
+///   the end of its own warm-up, by the next free thread.
+///
+/// With 2 threads, and warm-up and sampling of similar length, this
+/// roughly halves the time for a long series. The sampled chain of each
+/// run is still a continuation of its own warm-up, so its statistics are
+/// not affected, but the final state of one run is no longer the initial
+/// state of the next.
+///
+/// If `state_generator.allows_warm_start()` is false, `n_threads == 1`, or
+/// worker 0 has no "before each run" sampling fixtures, the runs are
+/// performed by `run_series` instead.
+///
+/// Notes:
+/// - Each worker has its own calculation instance, so
+///   `CalculationType::run` is never called concurrently on the same
+///   calculation.
+/// - The random number engines for the warm-up and sampling of each run
+///   are seeded, using `make_stream_engine`, from one value drawn from
+///   `engine` and the run index, so results do not depend on `n_threads`.
+/// - Runs are added to the state generator, and `completed_runs.json` is
+///   written, in run order.
+/// - As for `run_series_parallel`, each worker's sampling fixtures write
+///   their results when that worker's run finishes, and results reads and
+///   writes are serialized.
+///
+/// \param make_worker_f A function, with signature
+///     `SeriesWorker<CalculationType> make_worker_f(Index worker_index)`,
+///     which constructs the data used by each worker. Worker 0 must have
+///     `before_each_run` sampling fixtures, which are used for the
+///     warm-up of each run.
+/// \param engine Random number engine, used to seed the engine for each run
+/// \param state_generator A StateGenerator, which produces a
+///     a series of initial states
+/// \param n_threads Maximum number of worker threads to use
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete. Otherwise, all sampling fixtures must be
+///     completed for the run to be completed.
+///
+/// Requires:
+/// - The same as `run_series`
+template <typename CalculationType>
+void run_series_pipelined(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, Index n_threads,
+    bool global_cutoff) {
+  typedef typename CalculationType::engine_type engine_type;
+
+  if (n_threads < 1) {
+    throw std::runtime_error("Error in run_series_pipelined: n_threads < 1");
+  }
+
+  std::vector<SeriesWorker<CalculationType>> workers;
+  workers.push_back(make_worker_f(0));
+  if (!state_generator.allows_warm_start() || n_threads == 1 ||
+      workers[0].before_each_run.empty()) {
+    auto &worker = workers[0];
+    run_series(*worker.calculation, engine, state_generator,
+               worker.sampling_fixture_params, global_cutoff,
+               worker.before_first_run, worker.before_each_run, nullptr,
+               nullptr, worker.auto_equilibration);
+    return;
+  }
+  for (Index t = 1; t < n_threads; ++t) {
+    workers.push_back(make_worker_f(t));
+  }
+  serialize_results_io(workers);
+
+  auto &log = CASM::log();
+  log.begin("Monte Carlo calculation series");
+
+  log.indent() << "Checking for completed runs..." << std::endl;
+  state_generator.read_completed_runs();
+  log.indent() << "Found " << state_generator.n_completed_runs() << std::endl
+               << std::endl;
+  if (state_generator.is_complete()) {
+    log.indent() << "Monte Carlo calculation series complete" << std::endl;
+    return;
+  }
+  Index n_completed_before = state_generator.n_completed_runs();
+
+  std::uint64_t stream_seed = (*engine)();
+  std::mutex mutex;
+  std::condition_variable ready_cv;
+  // States after warm-up, by position in the series of remaining runs
+  std::vector<std::optional<state_type>> warm_states;
+  // Run data with the warm-up length, by position
+  std::vector<RunData> warm_run_data;
+  Index next_run = 0;
+  bool warm_up_done = false;
+  bool failed = false;
+  std::vector<std::optional<RunData>> finished;
+  Index n_pushed = 0;
+
+  // Warm-up each run, in order, starting from the previous warm-up
+  auto _warm_up = [&](SeriesWorker<CalculationType> &worker) {
+    auto &calculation = *worker.calculation;
+    OccLocationCache occ_location_cache(calculation.update_species);
+    std::optional<state_type> state;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      state = state_generator.next_state();
+    }
+    for (Index i = 0; state.has_value(); ++i) {
+      Index run_index = n_completed_before + i + 1;
+      auto warm_up_engine =
+          make_stream_engine<engine_type>(stream_seed, 2 * run_index);
+      monte::OccLocation &occ_location =
+          occ_location_cache.get(*calculation.system, *state);
+
+      // Optional, before first run:
+      if (worker.before_first_run.size() && run_index == 1) {
+        run_manager_type<engine_type> tmp_run_manager(
+            warm_up_engine, worker.before_first_run, global_cutoff);
+        calculation.run(*state, occ_location, tmp_run_manager);
+      }
+
+      RunData run_data;
+      run_before_each_run(calculation, warm_up_engine, worker.before_each_run,
+                          global_cutoff, worker.auto_equilibration.get(),
+                          *state, occ_location, run_data);
+
+      std::optional<state_type> next_state;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) {
+          return;
+        }
+        log.indent() << "Run " << run_index << " warm-up: Done" << std::endl;
+        warm_states.push_back(*state);
+        warm_run_data.push_back(std::move(run_data));
+        finished.emplace_back();
+        // Runs after warm-up may have been added to the state generator
+        Index n_runs_ahead =
+            n_completed_before + i + 1 - state_generator.n_completed_runs();
+        next_state = state_generator.warm_start_state(n_runs_ahead,
+                                                      state->configuration);
+      }
+      ready_cv.notify_all();
+      state = std::move(next_state);
+    }
+  };
+
+  // Sample runs after warm-up, recording completed runs in order
+  auto _sample = [&](SeriesWorker<CalculationType> &worker) {
+    auto &calculation = *worker.calculation;
+    OccLocationCache occ_location_cache(calculation.update_species);
+    while (true) {
+      Index i;
+      state_type state;
+      RunData run_data;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready_cv.wait(lock, [&] {
+          return failed || next_run < Index(warm_states.size()) ||
+                 warm_up_done;
+        });
+        if (failed || next_run == Index(warm_states.size())) {
+          return;
+        }
+        i = next_run++;
+        state = std::move(*warm_states[i]);
+        warm_states[i].reset();
+        run_data = std::move(warm_run_data[i]);
+      }
+      Index run_index = n_completed_before + i + 1;
+      auto run_engine =
+          make_stream_engine<engine_type>(stream_seed, 2 * run_index + 1);
+      monte::OccLocation &occ_location =
+          occ_location_cache.get(*calculation.system, state);
+
+      // Prepare run data
+      run_data.transformation_matrix_to_super =
+          get_transformation_matrix_to_super(state);
+      run_data.n_unitcells =
+          run_data.transformation_matrix_to_super.determinant();
+      run_data.initial_state = state;
+      run_data.conditions = state.conditions;
+
+      // Run Monte Carlo at a single condition
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        log.indent() << "Performing Run " << run_index << "..." << std::endl;
+      }
+      run_manager_type<engine_type> run_manager(
+          run_engine, worker.sampling_fixture_params, global_cutoff);
+      run_manager.run_index = run_index;
+      calculation.run(state, occ_location, run_manager);
+      run_data.final_state = state;
+
+      // Record completed runs in order
+      std::lock_guard<std::mutex> lock(mutex);
+      log.indent() << "Run " << run_index << " Done" << std::endl;
+      finished[i] = std::move(run_data);
+      while (n_pushed < Index(finished.size()) &&
+             finished[n_pushed].has_value()) {
+        state_generator.push_back(*finished[n_pushed]);
+        finished[n_pushed].reset();
+        ++n_pushed;
+        state_generator.write_completed_runs();
+      }
+    }
+  };
+
+  auto do_work = [&](Index t) {
+    try {
+      if (t == 0) {
+        _warm_up(workers[t]);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          warm_up_done = true;
+        }
+        ready_cv.notify_all();
+      }
+      _sample(workers[t]);
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = true;
+      }
+      ready_cv.notify_all();
+      throw;
+    }
+  };
+
+  ThreadPool pool(n_threads);
+  pool.run(do_work);
+  log.indent() << "Monte Carlo calculation series complete" << std::endl;
+}
+
 /// \brief Make default SamplingFixtureParams using jsonResultsIO
+///
+/// If `observation_stream` is not null, the sampling functions named in
+/// `sampling_params.sampler_names` are wrapped so that each sampled value is
+/// also streamed, in chunks, to the columnar store of `observation_stream`
+/// (see `ObservationStream`). This can be used instead of, or in addition
+/// to, `write_observations`, which writes observations only at the end of a
+/// run. The caller must call `observation_stream->begin_run(run_index)`
+/// before each run.
+///
+/// If `sampling_function_profiler` is not null, the sampling functions and
+/// JSON sampling functions named in `sampling_params` are wrapped so that the
+/// number of calls and time spent in each is recorded (see
+/// `SamplingFunctionProfiler`). Time spent streaming observations is not
+/// included.
+///
+/// If `write_indexed_results` is true, results are written by
+/// `jsonIndexedResultsIO`, which writes each run to its own directory and
+/// appends a summary line per run to "summary.jsonl", rather than rewriting
+/// "summary.json" with all runs.
 inline sampling_fixture_params_type make_sampling_fixture_params(
     std::string label, monte::StateSamplingFunctionMap sampling_functions,
     monte::jsonStateSamplingFunctionMap json_sampling_functions,
@@ -175,7 +977,10 @@ inline sampling_fixture_params_type make_sampling_fixture_params(
     std::vector<std::string> analysis_names, bool write_results,
     bool write_trajectory, bool write_observations, bool write_status,
     std::optional<std::string> output_dir, std::optional<std::string> log_file,
-    double log_frequency_in_s) {
+    double log_frequency_in_s,
+    std::shared_ptr<ObservationStream> observation_stream,
+    std::shared_ptr<SamplingFunctionProfiler> sampling_function_profiler,
+    bool write_indexed_results) {
   if (!output_dir.has_value()) {
     output_dir = (fs::path("output") / label).string();
   }
@@ -184,7 +989,13 @@ inline sampling_fixture_params_type make_sampling_fixture_params(
   }
 
   std::unique_ptr<results_io_type> results_io;
-  if (write_results) {
+  if (write_results && write_indexed_results) {
+    results_io = std::make_unique<jsonIndexedResultsIO>(
+        *output_dir, write_trajectory, write_observations);
+    if (write_trajectory) {
+      sampling_params.do_sample_trajectory = true;
+    }
+  } else if (write_results) {
     results_io = std::make_unique<monte::jsonResultsIO<results_type>>(
         *output_dir, write_trajectory, write_observations);
     if (write_trajectory) {
@@ -192,6 +1003,20 @@ inline sampling_fixture_params_type make_sampling_fixture_params(
     }
   }
 
+  if (sampling_function_profiler) {
+    sampling_functions = make_profiled_sampling_functions(
+        sampling_functions, sampling_params.sampler_names,
+        sampling_function_profiler);
+    json_sampling_functions = make_profiled_json_sampling_functions(
+        json_sampling_functions, sampling_params.json_sampler_names,
+        sampling_function_profiler);
+  }
+
+  if (observation_stream) {
+    sampling_functions = make_streaming_sampling_functions(
+        sampling_functions, sampling_params.sampler_names, observation_stream);
+  }
+
   monte::MethodLog method_log;
   if (write_status) {
     method_log.logfile_path = *log_file;
@@ -2,6 +2,7 @@
 #define CASM_clexmonte_run_io_RunParams
 
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/run/AutoEquilibration.hh"
 #include "casm/clexmonte/run/StateGenerator.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/external/MersenneTwister/MersenneTwister.h"
@@ -29,7 +30,8 @@ struct RunParams {
             std::vector<sampling_fixture_params_type> _before_first_run =
                 std::vector<sampling_fixture_params_type>({}),
             std::vector<sampling_fixture_params_type> _before_each_run =
-                std::vector<sampling_fixture_params_type>({}));
+                std::vector<sampling_fixture_params_type>({}),
+            std::shared_ptr<AutoEquilibration> _auto_equilibration = nullptr);
 
   /// Random number generator engine
   std::shared_ptr<EngineType> engine;
@@ -53,6 +55,10 @@ struct RunParams {
   /// step before each actual run begins. This may be useful when not
   /// running in automatic convergence mode.
   std::vector<sampling_fixture_params_type> before_each_run;
+
+  /// If included, each "before each run" run continues until a drift test
+  /// passes, up to a cap (see `AutoEquilibration`)
+  std::shared_ptr<AutoEquilibration> auto_equilibration;
 };
 
 /// --- template implementation ---
@@ -65,13 +71,15 @@ RunParams<EngineType>::RunParams(
     std::vector<sampling_fixture_params_type> _sampling_fixture_params,
     bool _global_cutoff,
     std::vector<sampling_fixture_params_type> _before_first_run,
-    std::vector<sampling_fixture_params_type> _before_each_run)
+    std::vector<sampling_fixture_params_type> _before_each_run,
+    std::shared_ptr<AutoEquilibration> _auto_equilibration)
     : engine(_engine),
       state_generator(std::move(_state_generator)),
       global_cutoff(_global_cutoff),
       sampling_fixture_params(std::move(_sampling_fixture_params)),
       before_first_run(std::move(_before_first_run)),
-      before_each_run(std::move(_before_each_run)) {}
+      before_each_run(std::move(_before_each_run)),
+      auto_equilibration(_auto_equilibration) {}
 
 }  // namespace clexmonte
 }  // namespace CASM
@@ -0,0 +1,19 @@
+#ifndef CASM_clexmonte_run_AutoEquilibration_json_io
+#define CASM_clexmonte_run_AutoEquilibration_json_io
+
+namespace CASM {
+
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+
+struct AutoEquilibrationParams;
+
+/// \brief Construct AutoEquilibrationParams from JSON
+void parse(InputParser<AutoEquilibrationParams> &parser);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef CASM_clexmonte_run_ColumnarResultsIO_json_io
+#define CASM_clexmonte_run_ColumnarResultsIO_json_io
+
+namespace CASM {
+
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+
+class ColumnarResultsIO;
+
+/// \brief Construct ColumnarResultsIO from JSON
+void parse(InputParser<ColumnarResultsIO> &parser);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
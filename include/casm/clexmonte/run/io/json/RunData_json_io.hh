@@ -5,26 +5,66 @@
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/casm_io/json/optional.hh"
 #include "casm/clexmonte/run/RunData.hh"
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
 #include "casm/clexmonte/state/io/json/State_json_io.hh"
 #include "casm/monte/io/json/ValueMap_json_io.hh"
 
 namespace CASM {
 
+/// \brief Write RunData to JSON
+///
+/// \param run_data The run data
+/// \param json The JSON to write to
+/// \param write_initial_states If true, write the initial state
+/// \param write_final_states If true, write the final state
+/// \param compress_states If true, write the occupation of states in the
+///     compact encoding of `clexmonte::pack_occupation_json`
 inline jsonParser &to_json(clexmonte::RunData const &run_data, jsonParser &json,
-                           bool write_initial_states, bool write_final_states) {
+                           bool write_initial_states, bool write_final_states,
+                           bool compress_states = false) {
   if (write_initial_states) {
     json["initial_state"] = run_data.initial_state;
+    if (compress_states && run_data.initial_state.has_value()) {
+      clexmonte::pack_occupation_json(json["initial_state"]);
+    }
   }
   if (write_final_states) {
     json["final_state"] = run_data.final_state;
+    if (compress_states && run_data.final_state.has_value()) {
+      clexmonte::pack_occupation_json(json["final_state"]);
+    }
   }
   json["conditions"] = run_data.conditions;
   json["transformation_matrix_to_supercell"] =
       run_data.transformation_matrix_to_super;
   json["n_unitcells"] = run_data.n_unitcells;
+  if (run_data.equilibration_n_samples.has_value()) {
+    json["equilibration"]["n_samples"] = *run_data.equilibration_n_samples;
+  }
+  if (run_data.equilibration_n_steps.has_value()) {
+    json["equilibration"]["n_steps"] = *run_data.equilibration_n_steps;
+  }
+  if (!run_data.startup_time_s.empty()) {
+    json["startup_time_s"] = run_data.startup_time_s;
+  }
   return json;
 }
 
+/// \brief Replace packed occupations, in the JSON for RunData, with the
+///     standard occupation arrays
+inline void unpack_run_data_json(jsonParser &json) {
+  for (std::string key : {"initial_state", "final_state"}) {
+    if (json.contains(key) && json[key].is_obj()) {
+      clexmonte::unpack_occupation_json(json[key]);
+    }
+  }
+}
+
+/// \brief Parse RunData from JSON
+///
+/// Notes:
+/// - States with packed occupations must first be unpacked with
+///   `unpack_run_data_json`. This is done by `from_json`.
 inline void parse(InputParser<clexmonte::RunData> &parser,
                   config::SupercellSet &supercells) {
   parser.value = std::make_unique<clexmonte::RunData>();
@@ -36,11 +76,18 @@ inline void parse(InputParser<clexmonte::RunData> &parser,
   parser.require(run_data.transformation_matrix_to_super,
                  "transformation_matrix_to_supercell");
   parser.require(run_data.n_unitcells, "n_unitcells");
+  parser.optional(run_data.equilibration_n_samples,
+                  fs::path("equilibration") / "n_samples");
+  parser.optional(run_data.equilibration_n_steps,
+                  fs::path("equilibration") / "n_steps");
+  parser.optional(run_data.startup_time_s, "startup_time_s");
 }
 
 inline void from_json(clexmonte::RunData &run_data, jsonParser const &json,
                       config::SupercellSet &supercells) {
-  InputParser<clexmonte::RunData> parser{json, supercells};
+  jsonParser unpacked_json = json;
+  unpack_run_data_json(unpacked_json);
+  InputParser<clexmonte::RunData> parser{unpacked_json, supercells};
 
   std::runtime_error error_if_invalid{
       "Error reading clexmonte::RunData from JSON"};
@@ -56,6 +103,8 @@ inline jsonParser &to_json(clexmonte::RunDataOutputParams &output_params,
   json["save_last_final_state"] = output_params.do_save_last_final_state;
   json["write_initial_states"] = output_params.write_initial_states;
   json["write_final_states"] = output_params.write_final_states;
+  json["compress_states"] = output_params.compress_states;
+  json["append_only"] = output_params.append_only;
   if (!output_params.output_dir.empty()) {
     json["output_dir"] = output_params.output_dir.string();
   }
@@ -87,6 +136,9 @@ inline void parse(InputParser<clexmonte::RunDataOutputParams> &parser) {
                        "write_initial_states", false);
   parser.optional_else(output_params.write_final_states, "write_final_states",
                        false);
+  parser.optional_else(output_params.compress_states, "compress_states",
+                       false);
+  parser.optional_else(output_params.append_only, "append_only", false);
   std::string output_dir;
   parser.optional(output_dir, "output_dir");
   output_params.output_dir = fs::path(output_dir);
@@ -1,9 +1,14 @@
 #ifndef CASM_clexmonte_run_RunParams_json_io_impl
 #define CASM_clexmonte_run_RunParams_json_io_impl
 
+#include "casm/clexmonte/misc/Philox4x32.hh"
 #include "casm/clexmonte/misc/subparse_from_file.hh"
+#include "casm/clexmonte/run/AdaptiveConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/FiniteSizeScalingStateGenerator.hh"
 #include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/GridConditionsStateGenerator.hh"
 #include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/io/json/AutoEquilibration_json_io.hh"
 #include "casm/clexmonte/run/StateGenerator.hh"
 #include "casm/clexmonte/run/io/json/RunParams_json_io.hh"
 #include "casm/clexmonte/run/io/json/StateGenerator_json_io_impl.hh"
@@ -23,7 +28,15 @@ MethodParserMap<state_generator_type> standard_state_generator_methods(
   state_generator_methods.insert(
       sf.make<IncrementalConditionsStateGenerator>(
           "incremental", system, modifying_functions, config_generator_methods,
-          ptr)
+          ptr),
+      sf.make<AdaptiveConditionsStateGenerator>(
+          "adaptive", system, modifying_functions, config_generator_methods,
+          ptr),
+      sf.make<GridConditionsStateGenerator>(
+          "grid", system, modifying_functions, config_generator_methods, ptr),
+      sf.make<FiniteSizeScalingStateGenerator>(
+          "finite_size_scaling", system, modifying_functions,
+          config_generator_methods, ptr)
       // To add additional state generators:
       // sf.make<DerivedClassName>("<name>", ...args...),
   );
@@ -40,8 +53,13 @@ MethodParserMap<state_generator_type> standard_state_generator_methods(
 ///         calculations. Each state is an initial configuration and set of
 ///         thermodynamic conditions (temperature, chemical potential,
 ///         composition, etc.).
-///     "random_number_generator":
-///         (TODO) Options controlling the random number generator.
+///     "random_number_generator": optional JSON object = null
+///         Options controlling the random number generator. Includes:
+///
+///         "seed": optional int (>= 0)
+///             If given, the random number generator engine is seeded with
+///             stream 0 of this seed (see `seed_stream_engine`), so runs are
+///             reproducible. Otherwise, the engine is used as provided.
 ///     "sampling_fixtures": JSON object
 ///         A JSON object, whose keys are labels and values are paths to
 ///         input files for sampling fixtures. A Monte Carlo run continues
@@ -58,6 +76,13 @@ MethodParserMap<state_generator_type> standard_state_generator_methods(
 ///         requested run will be performed as a preliminary step before
 ///         each actual run begins. This may be useful when not running
 ///         in automatic convergence mode.
+///     "auto_equilibration": optional JSON object = null
+///         If included, each "before_each_run" run continues until a
+///         drift test on the sampled potential energy and composition
+///         passes, up to a cap, rather than according to the completion
+///         checks of the "before_each_run" sampling fixtures. The length of
+///         each is reported in completed_runs.json as "equilibration". See
+///         `parse(InputParser<AutoEquilibrationParams> &)` for options.
 ///     "global_cutoff": bool = true
 ///         If true, the entire run is stopped when any sampling fixture
 ///         is completed. Otherwise, all fixtures must complete for the
@@ -75,8 +100,18 @@ void parse(InputParser<RunParams<EngineType>> &parser,
            MethodParserMap<state_generator_type> const &state_generator_methods,
            MethodParserMap<results_io_type> const &results_io_methods,
            bool time_sampling_allowed, ConditionsType const *ptr) {
-  /// TODO: "random_number_generator":
-  ///     (Future) Options controlling the random number generator.
+  // Seed random number generator engine
+  if (parser.self.contains("random_number_generator") &&
+      parser.self["random_number_generator"].contains("seed")) {
+    fs::path seed_path = fs::path("random_number_generator") / "seed";
+    Index seed;
+    parser.require(seed, seed_path);
+    if (seed < 0) {
+      parser.insert_error(seed_path, "Error: \"seed\" must be >= 0");
+    } else {
+      seed_stream_engine(*engine, seed, 0);
+    }
+  }
 
   // Construct state generator
   auto state_generator_subparser =
@@ -126,6 +161,22 @@ void parse(InputParser<RunParams<EngineType>> &parser,
   std::vector<sampling_fixture_params_type> before_each_run =
       _parse_sampling_fixtures("before_each_run", is_required = false);
 
+  std::shared_ptr<AutoEquilibration> auto_equilibration;
+  if (parser.self.contains("auto_equilibration") &&
+      !parser.self["auto_equilibration"].is_null()) {
+    auto auto_equilibration_subparser =
+        parser.template subparse<AutoEquilibrationParams>(
+            "auto_equilibration");
+    if (auto_equilibration_subparser->valid()) {
+      auto_equilibration = std::make_shared<AutoEquilibration>(
+          *auto_equilibration_subparser->value);
+    }
+    if (before_each_run.empty()) {
+      parser.insert_error("auto_equilibration",
+                          "Error: requires \"before_each_run\"");
+    }
+  }
+
   bool global_cutoff;
   parser.optional_else(global_cutoff, "global_cutoff", true);
 
@@ -133,7 +184,7 @@ void parse(InputParser<RunParams<EngineType>> &parser,
     parser.value = std::make_unique<RunParams<EngineType>>(
         engine, std::move(state_generator_subparser->value),
         sampling_fixture_params, global_cutoff, before_first_run,
-        before_each_run);
+        before_each_run, auto_equilibration);
   }
 }
 
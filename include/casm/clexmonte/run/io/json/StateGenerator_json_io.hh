@@ -24,6 +24,30 @@ void parse(InputParser<IncrementalConditionsStateGenerator> &parser,
            MethodParserMap<config_generator_type> config_generator_methods,
            ConditionsType const *ptr = nullptr);
 
+/// \brief Construct GridConditionsStateGenerator from JSON
+template <typename ConditionsType>
+void parse(InputParser<GridConditionsStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr = nullptr);
+
+/// \brief Construct FiniteSizeScalingStateGenerator from JSON
+template <typename ConditionsType>
+void parse(InputParser<FiniteSizeScalingStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr = nullptr);
+
+/// \brief Construct AdaptiveConditionsStateGenerator from JSON
+template <typename ConditionsType>
+void parse(InputParser<AdaptiveConditionsStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr = nullptr);
+
 }  // namespace clexmonte
 }  // namespace CASM
 
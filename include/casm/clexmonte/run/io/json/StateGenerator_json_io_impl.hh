@@ -3,6 +3,9 @@
 
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/AdaptiveConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/FiniteSizeScalingStateGenerator.hh"
+#include "casm/clexmonte/run/GridConditionsStateGenerator.hh"
 #include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
 #include "casm/clexmonte/run/io/json/ConfigGenerator_json_io.hh"
 #include "casm/clexmonte/run/io/json/StateGenerator_json_io.hh"
@@ -158,6 +161,20 @@ namespace clexmonte {
 ///       "write_final_states": bool = false
 ///         If true, write saved final states to completed_runs.json.
 ///
+///       "compress_states": bool = false
+///         If true, write the occupation of written states as "occ_packed",
+///         bit-packed, zlib compressed, and base64 encoded, instead of as
+///         an array of occupation indices. Written states with either form
+///         are read.
+///
+///       "append_only": bool = false
+///         If true, write completed_runs.jsonl, with one completed run per
+///         line, instead of completed_runs.json. Each time it is written,
+///         only the runs completed since the last write are appended, so
+///         earlier lines may include final states that completed_runs.json
+///         would no longer include. If completed_runs.jsonl does not exist
+///         when restarting, an existing completed_runs.json is read.
+///
 ///       "output_dir": str = ""
 ///         If not empty, name of a directory in which to write
 ///         completed_runs.json. If empty, completed_runs.json is not
@@ -237,6 +254,363 @@ void parse(InputParser<IncrementalConditionsStateGenerator> &parser,
   }
 }
 
+/// \brief Construct AdaptiveConditionsStateGenerator from JSON
+///
+/// The "adaptive" state generation method generates states along the same
+/// path of conditions as the "incremental" method, `initial_conditions +
+/// t * conditions_increment` for `t` in `[0, n_states - 1]`, and also
+/// halves the step between completed runs wherever selected observables
+/// change by more than an allowed amount, for instance at a phase
+/// transition (see AdaptiveConditionsStateGenerator).
+///
+/// Expected:
+///   All the parameters of the "incremental" method, and:
+///
+///   adaptive: object (required)
+///     Controls refinement of the step between conditions. Includes:
+///
+///       max_change: object (required)
+///         The observables compared between adjacent runs, and the maximum
+///         allowed change of any component of each. Keys may be
+///         "mol_composition", "param_composition", or the name of a cluster
+///         expansion of the system, such as "formation_energy", which is
+///         compared per unit cell. For example:
+///         `{"mol_composition": 0.05, "formation_energy": 0.005}`.
+///
+///       max_refinement_level: integer (optional, default=4)
+///         Maximum number of times the conditions increment is halved.
+///
+///       requested_t: array of number (optional, default=[])
+///         Additional values of the path parameter `t` at which runs are
+///         performed, for instance where thermodynamic integration along
+///         the path needs more conditions (see
+///         `ThermodynamicIntegration::refinement_t`). Completed runs are not
+///         repeated, so this may be extended and the series restarted.
+///
+///   The runs are performed one at a time, because each next state depends
+///   on the results of the completed runs.
+///
+template <typename ConditionsType>
+void parse(InputParser<AdaptiveConditionsStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr) {
+  /// Parse "initial_configuration"
+  auto config_generator_subparser = parser.subparse<config_generator_type>(
+      "initial_configuration", config_generator_methods);
+
+  /// Parse "initial_conditions"
+  bool is_increment = false;
+  auto initial_conditions_subparser = parser.subparse<ConditionsType>(
+      "initial_conditions", system, is_increment);
+
+  /// Parse "conditions_increment"
+  is_increment = true;
+  auto conditions_increment_subparser = parser.subparse<ConditionsType>(
+      "conditions_increment", system, is_increment);
+
+  /// Parse "modifiers"
+  std::vector<std::string> modifier_names;
+  parser.optional(modifier_names, "modifiers");
+  std::vector<StateModifyingFunction> selected_modifiers;
+  for (auto const &name : modifier_names) {
+    auto it = modifying_functions.find(name);
+    if (it == modifying_functions.end()) {
+      std::stringstream msg;
+      msg << "Error in \"modifiers\": Not a valid function "
+             "name: \""
+          << name << "\"";
+      parser.insert_error("modifiers", msg.str());
+      continue;
+    }
+    selected_modifiers.push_back(it->second);
+  }
+
+  /// Parse "n_states"
+  Index n_states;
+  parser.require(n_states, "n_states");
+
+  /// Parse "dependent_runs"
+  bool dependent_runs = true;
+  parser.optional(dependent_runs, "dependent_runs");
+
+  /// Parse "completed_runs"
+  RunDataOutputParams output_params;
+  parser.optional(output_params, "completed_runs");
+
+  /// Parse "adaptive"
+  AdaptiveStepParams params;
+  parser.require(params.max_change, fs::path("adaptive") / "max_change");
+  parser.optional(params.max_refinement_level,
+                  fs::path("adaptive") / "max_refinement_level");
+  parser.optional(params.requested_t, fs::path("adaptive") / "requested_t");
+  for (auto const &pair : params.max_change) {
+    if (pair.first != "mol_composition" &&
+        pair.first != "param_composition" &&
+        !is_clex_data(*system, pair.first)) {
+      std::stringstream msg;
+      msg << "Error: \"" << pair.first << "\" is not \"mol_composition\", "
+          << "\"param_composition\", or a cluster expansion name";
+      parser.insert_error(fs::path("adaptive") / "max_change", msg.str());
+    }
+    if (!(pair.second > 0.0)) {
+      std::stringstream msg;
+      msg << "Error: the maximum change of \"" << pair.first
+          << "\" must be > 0";
+      parser.insert_error(fs::path("adaptive") / "max_change", msg.str());
+    }
+  }
+  if (params.max_refinement_level < 0) {
+    parser.insert_error(fs::path("adaptive") / "max_refinement_level",
+                        "Error: must be >= 0");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<AdaptiveConditionsStateGenerator>(
+        system, output_params, std::move(config_generator_subparser->value),
+        initial_conditions_subparser->value->to_value_map(false),
+        conditions_increment_subparser->value->to_value_map(true), n_states,
+        dependent_runs, params, selected_modifiers);
+  }
+}
+
+/// \brief Construct GridConditionsStateGenerator from JSON
+///
+/// The "grid" state generation method generates states on a
+/// multi-dimensional grid of conditions, for instance over temperature and
+/// parametric chemical potential for a phase diagram, walking the grid line
+/// by line (see GridConditionsStateGenerator).
+///
+/// Expected:
+///   initial_configuration: ConfigGenerator
+///     Same as for the "incremental" method.
+///
+///   initial_conditions: object
+///     Conditions at the first grid point. Same format as for the
+///     "incremental" method.
+///
+///   conditions_increments: array of object (required)
+///     The change in conditions per step along each grid axis, with the
+///     same format as "conditions_increment" of the "incremental" method.
+///     The first axis is along lines.
+///
+///   n_points: array of integer (required)
+///     Number of grid points along each axis. Must have the same size as
+///     "conditions_increments".
+///
+///   dependent_runs: bool (optional, default=true)
+///     If true, each run starts from the final configuration of the
+///     previous grid point. If false, always use the ConfigGenerator.
+///
+///   independent_lines: bool (optional, default=false)
+///     If false, lines are walked in "snake" order, alternating direction,
+///     so that with "dependent_runs" warm starts continue from one line to
+///     the next. If true, each line starts from the ConfigGenerator and
+///     lines may be run in parallel, one line per thread.
+///
+///   completed_runs: dict (optional)
+///     Same as for the "incremental" method.
+///
+///   modifiers: Array of string (optional, default=[])
+///     Same as for the "incremental" method.
+///
+template <typename ConditionsType>
+void parse(InputParser<GridConditionsStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr) {
+  /// Parse "initial_configuration"
+  auto config_generator_subparser = parser.subparse<config_generator_type>(
+      "initial_configuration", config_generator_methods);
+
+  /// Parse "initial_conditions"
+  bool is_increment = false;
+  auto initial_conditions_subparser = parser.subparse<ConditionsType>(
+      "initial_conditions", system, is_increment);
+
+  /// Parse "conditions_increments"
+  is_increment = true;
+  std::vector<std::shared_ptr<InputParser<ConditionsType>>>
+      conditions_increments_subparsers;
+  if (!parser.self.contains("conditions_increments") ||
+      !parser.self["conditions_increments"].is_array()) {
+    parser.insert_error("conditions_increments",
+                        "Error: required array is missing");
+  } else {
+    for (Index i = 0; i < parser.self["conditions_increments"].size(); ++i) {
+      conditions_increments_subparsers.push_back(
+          parser.subparse<ConditionsType>(
+              fs::path("conditions_increments") / std::to_string(i), system,
+              is_increment));
+    }
+  }
+
+  /// Parse "n_points"
+  std::vector<Index> n_points;
+  parser.require(n_points, "n_points");
+  if (n_points.size() != conditions_increments_subparsers.size()) {
+    parser.insert_error(
+        "n_points",
+        "Error: size must match the size of \"conditions_increments\"");
+  }
+
+  /// Parse "modifiers"
+  std::vector<std::string> modifier_names;
+  parser.optional(modifier_names, "modifiers");
+  std::vector<StateModifyingFunction> selected_modifiers;
+  for (auto const &name : modifier_names) {
+    auto it = modifying_functions.find(name);
+    if (it == modifying_functions.end()) {
+      std::stringstream msg;
+      msg << "Error in \"modifiers\": Not a valid function "
+             "name: \""
+          << name << "\"";
+      parser.insert_error("modifiers", msg.str());
+      continue;
+    }
+    selected_modifiers.push_back(it->second);
+  }
+
+  /// Parse "dependent_runs"
+  bool dependent_runs = true;
+  parser.optional(dependent_runs, "dependent_runs");
+
+  /// Parse "independent_lines"
+  bool independent_lines = false;
+  parser.optional(independent_lines, "independent_lines");
+
+  /// Parse "completed_runs"
+  RunDataOutputParams output_params;
+  parser.optional(output_params, "completed_runs");
+
+  if (parser.valid()) {
+    std::vector<monte::ValueMap> conditions_increments;
+    for (auto const &subparser : conditions_increments_subparsers) {
+      conditions_increments.push_back(subparser->value->to_value_map(true));
+    }
+    parser.value = std::make_unique<GridConditionsStateGenerator>(
+        system, output_params, std::move(config_generator_subparser->value),
+        initial_conditions_subparser->value->to_value_map(false),
+        conditions_increments, n_points, dependent_runs, independent_lines,
+        selected_modifiers);
+  }
+}
+
+/// \brief Construct FiniteSizeScalingStateGenerator from JSON
+///
+/// The "finite_size_scaling" state generation method runs the same path of
+/// conditions as the "incremental" method in each of a family of
+/// supercells, for instance to check or extrapolate the supercell size
+/// dependence of calculated properties (see
+/// FiniteSizeScalingStateGenerator). Each supercell is independent, so with
+/// more than one thread the supercells are run concurrently, largest first.
+///
+/// Expected:
+///   initial_configuration: ConfigGenerator
+///     Same as for the "incremental" method. The generated configuration is
+///     copied and tiled into each supercell that it is not already in.
+///
+///   initial_conditions: object
+///     Same as for the "incremental" method.
+///
+///   conditions_increment: object (required)
+///     Same as for the "incremental" method.
+///
+///   n_states: integer (required)
+///     Number of conditions on the path, run in each supercell.
+///
+///   transformation_matrices: array of array, shape=(n,3,3) (required)
+///     The supercells, as transformation matrices of the supercell lattice
+///     vectors from the prim lattice vectors. Must be distinct.
+///
+///   dependent_runs: bool (optional, default=true)
+///     If true, each run starts from the final configuration of the
+///     previous run in the same supercell. If false, always use the
+///     ConfigGenerator.
+///
+///   completed_runs: dict (optional)
+///     Same as for the "incremental" method.
+///
+///   modifiers: Array of string (optional, default=[])
+///     Same as for the "incremental" method.
+///
+template <typename ConditionsType>
+void parse(InputParser<FiniteSizeScalingStateGenerator> &parser,
+           std::shared_ptr<system_type> const &system,
+           StateModifyingFunctionMap const &modifying_functions,
+           MethodParserMap<config_generator_type> config_generator_methods,
+           ConditionsType const *ptr) {
+  /// Parse "initial_configuration"
+  auto config_generator_subparser = parser.subparse<config_generator_type>(
+      "initial_configuration", config_generator_methods);
+
+  /// Parse "initial_conditions"
+  bool is_increment = false;
+  auto initial_conditions_subparser = parser.subparse<ConditionsType>(
+      "initial_conditions", system, is_increment);
+
+  /// Parse "conditions_increment"
+  is_increment = true;
+  auto conditions_increment_subparser = parser.subparse<ConditionsType>(
+      "conditions_increment", system, is_increment);
+
+  /// Parse "transformation_matrices"
+  std::vector<Eigen::Matrix3l> transformation_matrices;
+  if (!parser.self.contains("transformation_matrices") ||
+      !parser.self["transformation_matrices"].is_array() ||
+      !parser.self["transformation_matrices"].size()) {
+    parser.insert_error("transformation_matrices",
+                        "Error: required non-empty array is missing");
+  } else {
+    for (Index i = 0; i < parser.self["transformation_matrices"].size();
+         ++i) {
+      Eigen::Matrix3l T;
+      parser.require(T, fs::path("transformation_matrices") /
+                            std::to_string(i));
+      transformation_matrices.push_back(T);
+    }
+  }
+
+  /// Parse "modifiers"
+  std::vector<std::string> modifier_names;
+  parser.optional(modifier_names, "modifiers");
+  std::vector<StateModifyingFunction> selected_modifiers;
+  for (auto const &name : modifier_names) {
+    auto it = modifying_functions.find(name);
+    if (it == modifying_functions.end()) {
+      std::stringstream msg;
+      msg << "Error in \"modifiers\": Not a valid function "
+             "name: \""
+          << name << "\"";
+      parser.insert_error("modifiers", msg.str());
+      continue;
+    }
+    selected_modifiers.push_back(it->second);
+  }
+
+  /// Parse "n_states"
+  Index n_states;
+  parser.require(n_states, "n_states");
+
+  /// Parse "dependent_runs"
+  bool dependent_runs = true;
+  parser.optional(dependent_runs, "dependent_runs");
+
+  /// Parse "completed_runs"
+  RunDataOutputParams output_params;
+  parser.optional(output_params, "completed_runs");
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<FiniteSizeScalingStateGenerator>(
+        system, output_params, std::move(config_generator_subparser->value),
+        initial_conditions_subparser->value->to_value_map(false),
+        conditions_increment_subparser->value->to_value_map(true), n_states,
+        transformation_matrices, dependent_runs, selected_modifiers);
+  }
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -0,0 +1,59 @@
+#ifndef CASM_clexmonte_run_jsonIndexedResultsIO
+#define CASM_clexmonte_run_jsonIndexedResultsIO
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/filesystem.hh"
+#include "casm/monte/run_management/io/ResultsIO.hh"
+
+namespace CASM {
+
+template <typename T>
+class InputParser;
+
+namespace clexmonte {
+
+/// \brief Write results with a constant cost per run
+///
+/// `monte::jsonResultsIO` reads and rewrites "summary.json", with the
+/// results of all runs, each time a run is written, so the cost of writing
+/// grows with the number of completed runs. This writes each run to its own
+/// directory, and appends one line per run to an index file:
+///
+/// - "<output_dir>/run.<run_index>/": The results of one run, written by
+///   `monte::jsonResultsIO`, so "summary.json" holds a single run, and the
+///   trajectory and observations, if written, are in "run.0/".
+/// - "<output_dir>/summary.jsonl": One line per written run, in the order
+///   written, with attributes "run_index", "conditions", and "summary" (the
+///   contents of the run's "summary.json").
+///
+/// A line that was only partially written, for instance because the
+/// calculation was stopped, is ignored by `read_conditions`.
+class jsonIndexedResultsIO : public results_io_type {
+ public:
+  jsonIndexedResultsIO(fs::path _output_dir, bool _write_trajectory,
+                       bool _write_observations);
+
+  /// \brief Read the conditions of the runs in the index, in the order
+  ///     written
+  std::vector<monte::ValueMap> read_conditions() override;
+
+  /// \brief Write the results of one run, and append it to the index
+  void write(results_type const &results, monte::ValueMap const &conditions,
+             Index run_index) override;
+
+  /// \brief Directory with the results of run `run_index`
+  fs::path run_dir(Index run_index) const;
+
+ private:
+  fs::path m_output_dir;
+  bool m_write_trajectory;
+  bool m_write_observations;
+};
+
+/// \brief Construct jsonIndexedResultsIO from JSON
+void parse(InputParser<jsonIndexedResultsIO> &parser);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
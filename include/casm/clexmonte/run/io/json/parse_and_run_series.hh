@@ -1,59 +1,99 @@
 #ifndef CASM_clexmonte_parse_and_run_series
 #define CASM_clexmonte_parse_and_run_series
 
+#include <algorithm>
+#include <map>
+#include <type_traits>
+
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexmonte/run/functions.hh"
 #include "casm/clexmonte/run/io/RunParams.hh"
 #include "casm/clexmonte/run/io/json/RunParams_json_io_impl.hh"
+#include "casm/clexmonte/run/run_series_mpi.hh"
+#include "casm/clexmonte/state/Conditions.hh"
 #include "casm/clexmonte/system/io/json/System_json_io.hh"
 
 namespace CASM {
 namespace clexmonte {
 
+namespace parse_and_run_series_impl {
+
+/// \brief Conditions type used to parse run parameters: the calculation's
+///     `conditions_type` if it has one, else clexmonte::Conditions
+template <typename CalculationType, typename = void>
+struct calculation_conditions {
+  typedef clexmonte::Conditions type;
+};
+
+template <typename CalculationType>
+struct calculation_conditions<
+    CalculationType, std::void_t<typename CalculationType::conditions_type>> {
+  typedef typename CalculationType::conditions_type type;
+};
+
+}  // namespace parse_and_run_series_impl
+
+/// \brief Parse and construct a System from a JSON file
+inline std::shared_ptr<System> parse_system_json_file(
+    fs::path system_json_file);
+
+/// \brief Parse and construct a calculation from the "calculation_options"
+///     of run parameters
+template <typename CalculationType>
+std::shared_ptr<CalculationType> parse_calculation(
+    jsonParser const &run_params_json, std::shared_ptr<System> system);
+
+/// \brief Parse run parameters and run a series with an existing
+///     calculation
+template <typename CalculationType>
+void parse_and_run_series(std::shared_ptr<CalculationType> calculation,
+                          jsonParser const &run_params_json,
+                          std::vector<fs::path> search_path);
+
 template <typename CalculationType>
 void parse_and_run_series(fs::path system_json_file,
                           fs::path run_params_json_file);
 
-// --- Implementation ---
+/// \brief Expand a list of run parameters files and directories into a
+///     list of run parameters files
+inline std::vector<fs::path> expand_run_params_json_files(
+    std::vector<fs::path> const &paths);
 
 template <typename CalculationType>
 void parse_and_run_series(fs::path system_json_file,
-                          fs::path run_params_json_file) {
-  typedef typename CalculationType::engine_type engine_type;
+                          std::vector<fs::path> run_params_json_files);
 
-  std::vector<fs::path> search_path;
-  fs::path system_root = system_json_file.parent_path();
-  fs::path run_root = run_params_json_file.parent_path();
+// --- Implementation ---
 
-  /// Parse and construct system
+/// \brief Parse and construct a System from a JSON file
+///
+/// Relative paths in the system JSON are relative to the directory
+/// containing `system_json_file`.
+inline std::shared_ptr<System> parse_system_json_file(
+    fs::path system_json_file) {
   if (!fs::exists(system_json_file)) {
     std::stringstream msg;
-    msg << "Error in CASM::clexmonte::parse_and_run_series: system_json_file "
-           "does not exist: "
+    msg << "Error in CASM::clexmonte::parse_system_json_file: "
+           "system_json_file does not exist: "
         << system_json_file;
     throw std::runtime_error(msg.str());
   }
+  std::vector<fs::path> search_path = {system_json_file.parent_path()};
   jsonParser system_json(system_json_file);
-  InputParser<clexmonte::System> system_parser(system_json,
-                                               search_path = {system_root});
+  InputParser<clexmonte::System> system_parser(system_json, search_path);
   std::runtime_error system_error_if_invalid{
       "Error reading Monte Carlo system JSON input"};
   report_and_throw_if_invalid(system_parser, CASM::log(),
                               system_error_if_invalid);
+  return std::shared_ptr<clexmonte::System>(system_parser.value.release());
+}
 
-  std::shared_ptr<clexmonte::System> system(system_parser.value.release());
-
-  // default seed random number generator engine
-  // TODO: seed from user input via RunParams
-  std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
-  std::random_device device;
-  engine->seed(device());
-
-  // read run_params file
-  jsonParser run_params_json(run_params_json_file);
-
-  // parse and construct calculation options
+/// \brief Parse and construct a calculation from the "calculation_options"
+///     of run parameters
+template <typename CalculationType>
+std::shared_ptr<CalculationType> parse_calculation(
+    jsonParser const &run_params_json, std::shared_ptr<System> system) {
   jsonParser calculation_options_json = jsonParser::object();
   if (run_params_json.contains("calculation_options")) {
     calculation_options_json = run_params_json["calculation_options"];
@@ -64,20 +104,46 @@ void parse_and_run_series(fs::path system_json_file,
       "Error reading Monte Carlo calculation_options JSON input"};
   report_and_throw_if_invalid(calculation_parser, CASM::log(),
                               calculation_error_if_invalid);
+  return std::shared_ptr<CalculationType>(calculation_parser.value.release());
+}
+
+/// \brief Parse run parameters and run a series with an existing
+///     calculation
+///
+/// The "calculation_options" of `run_params_json` are not used; the
+/// calculation, and any event lists or supercell data it keeps from
+/// previous runs, is used as is.
+///
+/// \param calculation The calculation
+/// \param run_params_json Run parameters
+/// \param search_path Directories in which to search for files referred to
+///     by relative paths in `run_params_json`
+template <typename CalculationType>
+void parse_and_run_series(std::shared_ptr<CalculationType> calculation,
+                          jsonParser const &run_params_json,
+                          std::vector<fs::path> search_path) {
+  typedef typename CalculationType::engine_type engine_type;
 
-  std::shared_ptr<CalculationType> calculation(
-      calculation_parser.value.release());
+  // default seed random number generator engine, which may be re-seeded
+  // from user input via RunParams "random_number_generator"
+  std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
+  std::random_device device;
+  engine->seed(device());
 
   /// Make state sampling & analysis functions
   auto sampling_functions =
       CalculationType::standard_sampling_functions(calculation);
+  auto json_sampling_functions =
+      CalculationType::standard_json_sampling_functions(calculation);
   auto analysis_functions =
       CalculationType::standard_analysis_functions(calculation);
   auto modifying_functions =
       CalculationType::standard_modifying_functions(calculation);
 
   /// Make config generator / state generator / results_io JSON parsers
-  CalculationType::conditions_type const *conditions_ptr = nullptr;
+  typedef typename parse_and_run_series_impl::calculation_conditions<
+      CalculationType>::type conditions_type;
+  conditions_type const *conditions_ptr = nullptr;
   auto config_generator_methods =
       clexmonte::standard_config_generator_methods(calculation->system);
   auto state_generator_methods = clexmonte::standard_state_generator_methods(
@@ -86,16 +152,9 @@ void parse_and_run_series(fs::path system_json_file,
   auto results_io_methods = clexmonte::standard_results_io_methods();
 
   /// Parse and construct run parameters
-  if (!fs::exists(run_params_json_file)) {
-    std::stringstream msg;
-    msg << "Error in CASM::clexmonte::parse_and_run_series: "
-           "run_params_json_file does not exist: "
-        << run_params_json_file;
-    throw std::runtime_error(msg.str());
-  }
   InputParser<clexmonte::RunParams<engine_type>> run_params_parser(
-      run_params_json, search_path = {system_root, run_root}, engine,
-      sampling_functions, analysis_functions, state_generator_methods,
+      run_params_json, search_path, engine, sampling_functions,
+      json_sampling_functions, analysis_functions, state_generator_methods,
       results_io_methods, calculation->time_sampling_allowed, conditions_ptr);
   std::runtime_error run_params_error_if_invalid{
       "Error reading Monte Carlo run parameters JSON input"};
@@ -104,10 +163,143 @@ void parse_and_run_series(fs::path system_json_file,
 
   clexmonte::RunParams<engine_type> &run_params = *run_params_parser.value;
 
-  clexmonte::run_series(
-      *calculation, run_params.engine, *run_params.state_generator,
-      run_params.run_manager_params, run_params.sampling_fixture_params,
-      run_params.before_first_run, run_params.before_each_run);
+#ifdef CASM_CLEXMONTE_MPI
+  // launched by mpirun: distribute independent runs over the ranks
+  if (is_mpi_distributed()) {
+    auto make_worker_f = [&](Index worker_index) {
+      SeriesWorker<CalculationType> worker;
+      worker.calculation = calculation;
+      worker.sampling_fixture_params = run_params.sampling_fixture_params;
+      worker.before_first_run = run_params.before_first_run;
+      worker.before_each_run = run_params.before_each_run;
+      worker.auto_equilibration = run_params.auto_equilibration;
+      return worker;
+    };
+    run_series_mpi<CalculationType>(make_worker_f, run_params.engine,
+                                    *run_params.state_generator,
+                                    MPI_COMM_WORLD, run_params.global_cutoff);
+    return;
+  }
+#endif
+
+  clexmonte::run_series(*calculation, run_params.engine,
+                        *run_params.state_generator,
+                        run_params.sampling_fixture_params,
+                        run_params.global_cutoff, run_params.before_first_run,
+                        run_params.before_each_run, nullptr, nullptr,
+                        run_params.auto_equilibration);
+}
+
+template <typename CalculationType>
+void parse_and_run_series(fs::path system_json_file,
+                          fs::path run_params_json_file) {
+  /// Parse and construct system
+  std::shared_ptr<clexmonte::System> system =
+      parse_system_json_file(system_json_file);
+
+  /// Read run parameters
+  if (!fs::exists(run_params_json_file)) {
+    std::stringstream msg;
+    msg << "Error in CASM::clexmonte::parse_and_run_series: "
+           "run_params_json_file does not exist: "
+        << run_params_json_file;
+    throw std::runtime_error(msg.str());
+  }
+  jsonParser run_params_json(run_params_json_file);
+
+  /// Parse and construct calculation options
+  std::shared_ptr<CalculationType> calculation =
+      parse_calculation<CalculationType>(run_params_json, system);
+
+  std::vector<fs::path> search_path = {system_json_file.parent_path(),
+                                       run_params_json_file.parent_path()};
+  parse_and_run_series(calculation, run_params_json, search_path);
+}
+
+/// \brief Expand a list of run parameters files and directories into a
+///     list of run parameters files
+///
+/// \param paths Run parameters JSON files, or directories, which are
+///     replaced by the ".json" files they contain, in order of file name
+///
+/// \returns The run parameters files, in the order given
+inline std::vector<fs::path> expand_run_params_json_files(
+    std::vector<fs::path> const &paths) {
+  std::vector<fs::path> result;
+  for (auto const &path : paths) {
+    if (!fs::exists(path)) {
+      std::stringstream msg;
+      msg << "Error in CASM::clexmonte::expand_run_params_json_files: "
+             "does not exist: "
+          << path;
+      throw std::runtime_error(msg.str());
+    }
+    if (!fs::is_directory(path)) {
+      result.push_back(path);
+      continue;
+    }
+    std::vector<fs::path> files;
+    for (auto const &entry : fs::directory_iterator(path)) {
+      if (entry.path().extension() == ".json" &&
+          !fs::is_directory(entry.path())) {
+        files.push_back(entry.path());
+      }
+    }
+    std::sort(files.begin(), files.end());
+    result.insert(result.end(), files.begin(), files.end());
+  }
+  return result;
+}
+
+/// \brief Parse and run several series for the same system
+///
+/// The system is constructed once, and series with the same
+/// "calculation_options" use the same calculation, so clexulators,
+/// supercell data, and event lists are constructed once and reused. Series
+/// are run one after another, in the order given. The runs of each series
+/// are performed one at a time, except in builds with
+/// CASM_CLEXMONTE_MPI launched by mpirun, where they are distributed over
+/// the ranks.
+///
+/// \param system_json_file The system JSON file
+/// \param run_params_json_files Run parameters JSON files
+template <typename CalculationType>
+void parse_and_run_series(fs::path system_json_file,
+                          std::vector<fs::path> run_params_json_files) {
+  /// Parse and construct system
+  std::shared_ptr<clexmonte::System> system =
+      parse_system_json_file(system_json_file);
+
+  /// Calculations, by "calculation_options"
+  std::map<std::string, std::shared_ptr<CalculationType>> calculations;
+
+  for (auto const &run_params_json_file : run_params_json_files) {
+    if (!fs::exists(run_params_json_file)) {
+      std::stringstream msg;
+      msg << "Error in CASM::clexmonte::parse_and_run_series: "
+             "run_params_json_file does not exist: "
+          << run_params_json_file;
+      throw std::runtime_error(msg.str());
+    }
+    CASM::log().indent() << "Run parameters: " << run_params_json_file
+                         << std::endl;
+    jsonParser run_params_json(run_params_json_file);
+
+    jsonParser calculation_options_json = jsonParser::object();
+    if (run_params_json.contains("calculation_options")) {
+      calculation_options_json = run_params_json["calculation_options"];
+    }
+    std::shared_ptr<CalculationType> &calculation =
+        calculations[calculation_options_json.dump()];
+    if (!calculation) {
+      calculation =
+          parse_calculation<CalculationType>(run_params_json, system);
+    }
+
+    std::vector<fs::path> search_path = {system_json_file.parent_path(),
+                                         run_params_json_file.parent_path()};
+    parse_and_run_series(calculation, run_params_json, search_path);
+  }
 }
 
 }  // namespace clexmonte
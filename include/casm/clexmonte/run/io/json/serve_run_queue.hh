@@ -0,0 +1,202 @@
+#ifndef CASM_clexmonte_serve_run_queue
+#define CASM_clexmonte_serve_run_queue
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "casm/clexmonte/run/io/json/parse_and_run_series.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Options for `serve_run_queue`
+struct RunQueueParams {
+  /// \brief Time to wait between checks for new requests, in seconds
+  double poll_interval_s = 1.0;
+
+  /// \brief If true, return when no requests are pending, rather than
+  ///     waiting for more
+  bool exit_when_empty = false;
+
+  /// \brief Maximum number of distinct "calculation_options" whose
+  ///     calculations are kept between requests
+  Index max_calculations = 8;
+};
+
+/// \brief Counts of requests processed by `serve_run_queue`
+struct RunQueueSummary {
+  Index n_done = 0;
+  Index n_failed = 0;
+};
+
+/// \brief Directories of a run queue
+struct RunQueueDirs {
+  explicit RunQueueDirs(fs::path const &queue_dir)
+      : pending(queue_dir / "pending"),
+        running(queue_dir / "running"),
+        done(queue_dir / "done"),
+        failed(queue_dir / "failed"),
+        stop_file(queue_dir / "stop") {}
+
+  fs::path pending;
+  fs::path running;
+  fs::path done;
+  fs::path failed;
+  fs::path stop_file;
+};
+
+/// \brief Claim the first pending request, by name, returning its path in
+///     the "running" directory, or an empty path if none are pending
+///
+/// A request is claimed by renaming it into the "running" directory, which
+/// is atomic, so each request is claimed by exactly one of several workers
+/// serving the same queue.
+inline fs::path claim_run_request(RunQueueDirs const &dirs) {
+  std::vector<fs::path> pending;
+  for (auto const &entry : fs::directory_iterator(dirs.pending)) {
+    if (entry.path().extension() == ".json") {
+      pending.push_back(entry.path());
+    }
+  }
+  std::sort(pending.begin(), pending.end());
+  for (auto const &path : pending) {
+    fs::path running = dirs.running / path.filename();
+    std::error_code ec;
+    fs::rename(path, running, ec);
+    if (!ec) {
+      return running;
+    }
+  }
+  return fs::path();
+}
+
+/// \brief Serve run requests from a file-based queue, keeping the system
+///     and calculations loaded between requests
+///
+/// The system is parsed once. Each request is a run parameters JSON file,
+/// with the same format as for `parse_and_run_series`, and is processed as
+/// follows:
+///
+/// - Clients submit a request by writing it to `<queue_dir>/pending/`, with
+///   extension ".json". To avoid a worker reading a partially written
+///   file, write it elsewhere, or with another extension, and then rename
+///   it into place.
+/// - Requests are claimed in order of file name, by moving them to
+///   `<queue_dir>/running/`, so several workers may serve one queue.
+/// - On success, the request is moved to `<queue_dir>/done/`. If it fails,
+///   it is moved to `<queue_dir>/failed/`, and the error message is written
+///   next to it, in a file with extension ".error".
+/// - The worker returns when `<queue_dir>/stop` exists, after finishing the
+///   current request, or, if `params.exit_when_empty`, when no requests are
+///   pending.
+///
+/// Requests with the same "calculation_options" share one calculation, so
+/// event lists, supercell data, and other data kept by the calculation
+/// between runs are reused by later requests. Calculations are kept for up
+/// to `params.max_calculations` distinct "calculation_options"; when there
+/// are more, the least recently used is released. Relative paths in a
+/// request are searched for relative to the directory containing
+/// `system_json_file` and to `queue_dir`. Output paths are relative to the
+/// worker's working directory, as for `parse_and_run_series`.
+///
+/// \param system_json_file The system JSON file
+/// \param queue_dir The queue directory. The "pending", "running", "done",
+///     and "failed" directories are created if they do not exist.
+/// \param params Options
+///
+/// \returns Counts of requests processed
+template <typename CalculationType>
+RunQueueSummary serve_run_queue(fs::path system_json_file, fs::path queue_dir,
+                                RunQueueParams const &params = {}) {
+  Log &log = CASM::log();
+  RunQueueDirs dirs(queue_dir);
+  fs::create_directories(dirs.pending);
+  fs::create_directories(dirs.running);
+  fs::create_directories(dirs.done);
+  fs::create_directories(dirs.failed);
+
+  std::shared_ptr<clexmonte::System> system =
+      parse_system_json_file(system_json_file);
+  std::vector<fs::path> search_path = {system_json_file.parent_path(),
+                                       queue_dir};
+
+  // calculations by "calculation_options", with the request count at last
+  // use, for releasing the least recently used
+  std::map<std::string, std::pair<std::shared_ptr<CalculationType>, Index>>
+      calculations;
+
+  RunQueueSummary summary;
+  Index n_requests = 0;
+  log.indent() << "Serving run queue: " << queue_dir << std::endl;
+  while (!fs::exists(dirs.stop_file)) {
+    fs::path request = claim_run_request(dirs);
+    if (request.empty()) {
+      if (params.exit_when_empty) {
+        break;
+      }
+      std::this_thread::sleep_for(
+          std::chrono::duration<double>(params.poll_interval_s));
+      continue;
+    }
+
+    ++n_requests;
+    log.indent() << "Run request: " << request.filename() << " ..."
+                 << std::endl;
+    std::string key;
+    try {
+      jsonParser run_params_json(request);
+      jsonParser calculation_options_json = jsonParser::object();
+      if (run_params_json.contains("calculation_options")) {
+        calculation_options_json = run_params_json["calculation_options"];
+      }
+      key = calculation_options_json.dump();
+      auto it = calculations.find(key);
+      if (it == calculations.end()) {
+        if (Index(calculations.size()) >=
+            std::max(Index(1), params.max_calculations)) {
+          auto oldest = std::min_element(
+              calculations.begin(), calculations.end(),
+              [](auto const &lhs, auto const &rhs) {
+                return lhs.second.second < rhs.second.second;
+              });
+          calculations.erase(oldest);
+        }
+        it = calculations
+                 .emplace(key, std::make_pair(
+                                   parse_calculation<CalculationType>(
+                                       run_params_json, system),
+                                   n_requests))
+                 .first;
+      }
+      it->second.second = n_requests;
+      parse_and_run_series(it->second.first, run_params_json, search_path);
+      fs::rename(request, dirs.done / request.filename());
+      ++summary.n_done;
+      log.indent() << "Run request: " << request.filename() << ": Done"
+                   << std::endl;
+    } catch (std::exception const &e) {
+      // a calculation may be left in an inconsistent state by a failed run
+      calculations.erase(key);
+      fs::path failed = dirs.failed / request.filename();
+      std::error_code ec;
+      fs::rename(request, failed, ec);
+      fs::path error_file = failed;
+      std::ofstream(error_file.replace_extension(".error")) << e.what()
+                                                            << std::endl;
+      ++summary.n_failed;
+      log.indent() << "Run request: " << request.filename()
+                   << ": Failed: " << e.what() << std::endl;
+    }
+  }
+  log.indent() << "Run queue: " << summary.n_done << " done, "
+               << summary.n_failed << " failed" << std::endl;
+  return summary;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
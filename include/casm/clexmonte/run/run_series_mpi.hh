@@ -0,0 +1,436 @@
+#ifndef CASM_clexmonte_run_series_mpi
+#define CASM_clexmonte_run_series_mpi
+
+#ifdef CASM_CLEXMONTE_MPI
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/run/RunSeriesCoordinator.hh"
+#include "casm/clexmonte/run/functions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Initializes MPI for the lifetime of this object, if it is not
+///     already initialized
+///
+/// Used by programs which may be launched by `mpirun`:
+/// \code
+/// int main(int argc, char *argv[]) {
+///   ScopedMPI mpi(&argc, &argv);
+///   ...
+/// }
+/// \endcode
+class ScopedMPI {
+ public:
+  ScopedMPI(int *argc, char ***argv) : m_owner(false) {
+    int is_initialized = 0;
+    MPI_Initialized(&is_initialized);
+    if (!is_initialized) {
+      MPI_Init(argc, argv);
+      m_owner = true;
+    }
+  }
+
+  ScopedMPI(ScopedMPI const &) = delete;
+  ScopedMPI &operator=(ScopedMPI const &) = delete;
+
+  ~ScopedMPI() {
+    if (m_owner) {
+      MPI_Finalize();
+    }
+  }
+
+ private:
+  bool m_owner;
+};
+
+/// \brief Return true if MPI is initialized and `comm` has more than one
+///     rank
+inline bool is_mpi_distributed(MPI_Comm comm = MPI_COMM_WORLD) {
+  int is_initialized = 0;
+  MPI_Initialized(&is_initialized);
+  if (!is_initialized) {
+    return false;
+  }
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  return size > 1;
+}
+
+namespace run_series_mpi_impl {
+
+/// \brief Message tags used by `run_series_mpi`
+enum Tag : int {
+  ready = 1,          // worker -> coordinator: ready for a run
+  work = 2,           // coordinator -> worker: run index `i`
+  stop = 3,           // coordinator -> worker: no more runs
+  done = 4,           // worker -> coordinator: RunData of a finished run
+  failed = 5,         // worker -> coordinator: a run threw; worker stops
+  write_request = 6,  // worker -> coordinator: request to write results
+  write_grant = 7,    // coordinator -> worker: results may be written
+  write_done = 8      // worker -> coordinator: results were written
+};
+
+inline void send_string(MPI_Comm comm, int dest, int tag,
+                        std::string const &str) {
+  MPI_Send(str.data(), str.size(), MPI_CHAR, dest, tag, comm);
+}
+
+/// \brief Receive a message sent by `send_string`
+///
+/// \returns The message, and sets `status` to the status of the received
+///     message
+inline std::string recv_string(MPI_Comm comm, int source, int tag,
+                               MPI_Status &status) {
+  MPI_Probe(source, tag, comm, &status);
+  int count = 0;
+  MPI_Get_count(&status, MPI_CHAR, &count);
+  std::string str(count, '\0');
+  MPI_Recv(str.data(), count, MPI_CHAR, status.MPI_SOURCE, status.MPI_TAG,
+           comm, MPI_STATUS_IGNORE);
+  return str;
+}
+
+inline std::string to_string(jsonParser const &json) {
+  std::stringstream ss;
+  json.print(ss, -1);
+  return ss.str();
+}
+
+/// \brief A ResultsIO, used by worker ranks, that asks the coordinator for
+///     permission before each write
+///
+/// Results are written by the wrapped ResultsIO, usually to a results
+/// directory shared by all ranks. The coordinator grants permission to one
+/// rank at a time, so results files which are read and rewritten to add a
+/// run, such as "summary.json", are never written concurrently.
+class CoordinatedResultsIO : public results_io_type {
+ public:
+  CoordinatedResultsIO(std::shared_ptr<results_io_type> _results_io,
+                       MPI_Comm _comm)
+      : m_results_io(std::move(_results_io)), m_comm(_comm) {}
+
+  std::vector<monte::ValueMap> read_conditions() override {
+    return m_results_io->read_conditions();
+  }
+
+  void write(results_type const &results, monte::ValueMap const &conditions,
+             Index run_index) override {
+    MPI_Status status;
+    send_string(m_comm, 0, Tag::write_request, "");
+    recv_string(m_comm, 0, Tag::write_grant, status);
+    try {
+      m_results_io->write(results, conditions, run_index);
+    } catch (...) {
+      send_string(m_comm, 0, Tag::write_done, "");
+      throw;
+    }
+    send_string(m_comm, 0, Tag::write_done, "");
+  }
+
+ private:
+  std::shared_ptr<results_io_type> m_results_io;
+  MPI_Comm m_comm;
+};
+
+/// \brief Replace the ResultsIO of each sampling fixture with a
+///     CoordinatedResultsIO
+inline void coordinate_results_io(
+    std::vector<sampling_fixture_params_type> &sampling_fixture_params,
+    MPI_Comm comm) {
+  for (auto &params : sampling_fixture_params) {
+    if (params.results_io) {
+      std::shared_ptr<results_io_type> results_io(
+          std::move(params.results_io));
+      params.results_io.reset(new CoordinatedResultsIO(results_io, comm));
+    }
+  }
+}
+
+}  // namespace run_series_mpi_impl
+
+/// \brief Perform a series of independent runs, according to a
+///     state_generator, distributed over the ranks of an MPI communicator
+///
+/// Every rank calls `run_series_mpi` with the same input. Rank 0 is the
+/// coordinator, and every other rank is a worker:
+/// - All ranks read the completed runs, from the shared
+///   `completed_runs.json`, and generate the remaining states. Only run
+///   indices are communicated.
+/// - Workers ask the coordinator for a run, perform it, and send back its
+///   RunData, until the coordinator has no more runs to give out.
+/// - The coordinator adds completed runs to its state generator, and writes
+///   `completed_runs.json`, in run order, as by `run_series_parallel`.
+///   Worker ranks never write the completed runs.
+/// - Worker sampling fixtures write results through the coordinator: each
+///   write must be granted by the coordinator, which grants one at a time.
+///   Results are written to the sampling fixture output directory, which
+///   should be on a filesystem shared by all ranks.
+/// - If a run throws on a worker, the worker reports the failure and stops
+///   taking runs, and the run is requeued for another worker, up to
+///   `max_attempts` attempts in total. If a run can not be completed, or
+///   all workers stop, the coordinator throws after all other runs are
+///   finished. A rank which terminates abnormally usually aborts the MPI
+///   job, in which case the series can be restarted from
+///   `completed_runs.json`.
+/// - As in `run_series_parallel`, the random number engine for each run is
+///   seeded, using `make_stream_engine`, from one value drawn from `engine`
+///   on the coordinator and the run index, so results do not depend on the
+///   number of ranks or the order in which runs finish.
+/// - If `comm` has a single rank, or the state generator does not generate
+///   independent states, the series is performed on rank 0 by
+///   `run_series_parallel`, with one thread, and other ranks wait.
+///
+/// \param make_worker_f A function, with signature
+///     `SeriesWorker<CalculationType> make_worker_f(Index worker_index)`,
+///     which constructs the data used by this rank. It is called once, with
+///     `worker_index == 0`, on each rank. The coordinator only uses the
+///     calculation's system.
+/// \param engine Random number engine, used on rank 0 to seed the engine
+///     for each run
+/// \param state_generator A StateGenerator, which produces a series of
+///     initial states, constructed identically on each rank
+/// \param comm The MPI communicator
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete. Otherwise, all sampling fixtures must be
+///     completed for the run to be completed.
+/// \param max_attempts Maximum number of times each run is attempted
+///
+/// Requires:
+/// - MPI is initialized
+/// - The same as `run_series`
+template <typename CalculationType>
+void run_series_mpi(
+    std::function<SeriesWorker<CalculationType>(Index)> make_worker_f,
+    std::shared_ptr<typename CalculationType::engine_type> engine,
+    state_generator_type &state_generator, MPI_Comm comm,
+    bool global_cutoff = true, Index max_attempts = 2) {
+  using namespace run_series_mpi_impl;
+  typedef typename CalculationType::engine_type engine_type;
+
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  if (max_attempts < 1) {
+    throw std::runtime_error("Error in run_series_mpi: max_attempts < 1");
+  }
+
+  if (size == 1 || !state_generator.has_independent_states()) {
+    if (rank == 0) {
+      run_series_parallel(make_worker_f, engine, state_generator, 1,
+                          global_cutoff);
+    }
+    MPI_Barrier(comm);
+    return;
+  }
+
+  auto &log = CASM::log();
+  if (rank == 0) {
+    log.begin("Monte Carlo calculation series");
+    log.indent() << "Checking for completed runs..." << std::endl;
+  }
+  state_generator.read_completed_runs();
+
+  // all ranks read completed runs before the coordinator writes them
+  MPI_Barrier(comm);
+
+  std::vector<state_type> states = state_generator.remaining_states();
+  std::int64_t counts[2] = {std::int64_t(state_generator.n_completed_runs()),
+                            std::int64_t(states.size())};
+  std::int64_t coordinator_counts[2] = {counts[0], counts[1]};
+  MPI_Bcast(coordinator_counts, 2, MPI_INT64_T, 0, comm);
+  int is_mismatched = (counts[0] != coordinator_counts[0] ||
+                       counts[1] != coordinator_counts[1]);
+  int any_mismatched = 0;
+  MPI_Allreduce(&is_mismatched, &any_mismatched, 1, MPI_INT, MPI_MAX, comm);
+  if (any_mismatched) {
+    throw std::runtime_error(
+        "Error in run_series_mpi: ranks generated different remaining "
+        "states; the completed runs must be readable by all ranks");
+  }
+  Index n_completed_before = counts[0];
+  Index n_runs = counts[1];
+
+  std::uint64_t stream_seed = 0;
+  if (rank == 0) {
+    stream_seed = (*engine)();
+    log.indent() << "Found " << n_completed_before << std::endl << std::endl;
+    log.indent() << "Distributing " << n_runs << " states to " << size - 1
+                 << " workers" << std::endl;
+  }
+  MPI_Bcast(&stream_seed, 1, MPI_UINT64_T, 0, comm);
+
+  // --- Worker ---
+  if (rank != 0) {
+    SeriesWorker<CalculationType> worker = make_worker_f(0);
+    coordinate_results_io(worker.sampling_fixture_params, comm);
+    auto &calculation = *worker.calculation;
+    OccLocationCache occ_location_cache(calculation.update_species);
+    while (true) {
+      MPI_Status status;
+      send_string(comm, 0, Tag::ready, "");
+      std::string message = recv_string(comm, 0, MPI_ANY_TAG, status);
+      if (status.MPI_TAG == Tag::stop) {
+        break;
+      }
+      Index i = std::stoll(message);
+      Index run_index = n_completed_before + i + 1;
+      try {
+        state_type state = states[i];
+        auto run_engine =
+            make_stream_engine<engine_type>(stream_seed, run_index);
+        monte::OccLocation &occ_location =
+            occ_location_cache.get(*calculation.system, state);
+
+        // Optional, before first run:
+        if (worker.before_first_run.size() && run_index == 1) {
+          run_manager_type<engine_type> tmp_run_manager(
+              run_engine, worker.before_first_run, global_cutoff);
+          calculation.run(state, occ_location, tmp_run_manager);
+        }
+
+        // Optional, before each run:
+        RunData run_data;
+        if (worker.before_each_run.size()) {
+          run_before_each_run(calculation, run_engine, worker.before_each_run,
+                              global_cutoff, worker.auto_equilibration.get(),
+                              state, occ_location, run_data);
+        }
+
+        // Prepare run data
+        run_data.transformation_matrix_to_super =
+            get_transformation_matrix_to_super(state);
+        run_data.n_unitcells =
+            run_data.transformation_matrix_to_super.determinant();
+        run_data.initial_state = state;
+        run_data.conditions = state.conditions;
+
+        // Run Monte Carlo at a single condition
+        run_manager_type<engine_type> run_manager(
+            run_engine, worker.sampling_fixture_params, global_cutoff);
+        run_manager.run_index = run_index;
+        calculation.run(state, occ_location, run_manager);
+        run_data.final_state = state;
+
+        jsonParser json;
+        json["index"] = i;
+        to_json(run_data, json["run_data"], true, true, true);
+        send_string(comm, 0, Tag::done, to_string(json));
+      } catch (std::exception const &e) {
+        jsonParser json;
+        json["index"] = i;
+        json["what"] = std::string(e.what());
+        send_string(comm, 0, Tag::failed, to_string(json));
+        break;
+      }
+    }
+    MPI_Barrier(comm);
+    return;
+  }
+
+  // --- Coordinator ---
+  SeriesWorker<CalculationType> coordinator = make_worker_f(0);
+  config::SupercellSet &supercells =
+      *coordinator.calculation->system->supercells;
+  RunSeriesCoordinator<RunData> scheduler(n_runs, size - 1, max_attempts,
+                                          n_completed_before + 1);
+
+  auto give_work = [&](int worker_rank, Index i) {
+    log.indent() << "Performing Run " << n_completed_before + i + 1
+                 << " on rank " << worker_rank << "..." << std::endl;
+    send_string(comm, worker_rank, Tag::work, std::to_string(i));
+  };
+
+  while (scheduler.n_active_workers() > 0) {
+    MPI_Status status;
+    std::string message =
+        recv_string(comm, MPI_ANY_SOURCE, MPI_ANY_TAG, status);
+    int source = status.MPI_SOURCE;
+    switch (status.MPI_TAG) {
+      case Tag::ready: {
+        // idle workers are held while runs may still be requeued
+        std::optional<Index> i = scheduler.ready(source);
+        if (i.has_value()) {
+          give_work(source, *i);
+        }
+        break;
+      }
+      case Tag::done: {
+        jsonParser json = jsonParser::parse(message);
+        Index i = json["index"].get<Index>();
+        RunData run_data;
+        from_json(run_data, json["run_data"], supercells);
+        log.indent() << "Run " << n_completed_before + i + 1 << " Done"
+                     << std::endl;
+        // completed runs are added and written in run order
+        for (RunData &completed : scheduler.done(i, std::move(run_data))) {
+          state_generator.push_back(completed);
+          state_generator.write_completed_runs();
+        }
+        break;
+      }
+      case Tag::failed: {
+        jsonParser json = jsonParser::parse(message);
+        Index i = json["index"].get<Index>();
+        std::string what = json["what"].get<std::string>();
+        log.indent() << "Run " << n_completed_before + i + 1
+                     << " failed on rank " << source << ": " << what
+                     << std::endl;
+        auto requeued = scheduler.failed(source, i, what);
+        if (requeued.has_value()) {
+          give_work(requeued->first, requeued->second);
+        }
+        break;
+      }
+      case Tag::write_request:
+        if (scheduler.request_write(source)) {
+          send_string(comm, source, Tag::write_grant, "");
+        }
+        break;
+      case Tag::write_done: {
+        std::optional<int> next = scheduler.write_done();
+        if (next.has_value()) {
+          send_string(comm, *next, Tag::write_grant, "");
+        }
+        break;
+      }
+      default:
+        throw std::runtime_error(
+            "Error in run_series_mpi: unexpected message tag");
+    }
+    for (int worker_rank : scheduler.take_workers_to_stop()) {
+      send_string(comm, worker_rank, Tag::stop, "");
+    }
+  }
+  MPI_Barrier(comm);
+
+  std::vector<std::string> errors = scheduler.errors();
+  if (errors.size()) {
+    std::stringstream msg;
+    msg << "Error in run_series_mpi: " << errors.size()
+        << " runs were not completed:";
+    for (auto const &e : errors) {
+      msg << "\n  " << e;
+    }
+    throw std::runtime_error(msg.str());
+  }
+  log.indent() << "Monte Carlo calculation series complete" << std::endl;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif  // CASM_CLEXMONTE_MPI
+
+#endif
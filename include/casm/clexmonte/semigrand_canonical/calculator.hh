@@ -74,6 +74,12 @@ struct SemiGrandCanonical {
   /// Results analysis functions
   std::map<std::string, results_analysis_function_type> analysis_functions;
 
+  /// Number of events proposed in the last run
+  Index n_proposed = 0;
+
+  /// Number of events accepted in the last run
+  Index n_accepted = 0;
+
   /// \brief Perform a single run, evolving current state
   void run(state_type &state, monte::OccLocation &occ_location,
            run_manager_type<EngineType> &run_manager);
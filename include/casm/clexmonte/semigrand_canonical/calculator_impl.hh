@@ -58,7 +58,10 @@ void SemiGrandCanonical<EngineType>::run(
   this->potential->set(this->state, this->conditions);
   this->formation_energy = this->potential->formation_energy();
 
+  this->n_proposed = 0;
+  this->n_accepted = 0;
   auto potential_occ_delta_per_supercell_f = [=](monte::OccEvent const &event) {
+    ++this->n_proposed;
     return this->potential->occ_delta_per_supercell(event.linear_site_index,
                                                     event.new_occ);
   };
@@ -75,12 +78,12 @@ void SemiGrandCanonical<EngineType>::run(
   event_generator->set(&state, &occ_location);
 
   auto propose_event_f =
-      [=](monte::RandomNumberGenerator<engine_type> &random_number_generator)
-      -> monte::OccEvent const & {
+      [=](auto &random_number_generator) -> monte::OccEvent const & {
     return event_generator->propose(random_number_generator);
   };
 
   auto apply_event_f = [=](monte::OccEvent const &occ_event) -> void {
+    ++this->n_accepted;
     return event_generator->apply(occ_event);
   };
 
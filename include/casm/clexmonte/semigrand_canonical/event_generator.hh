@@ -99,9 +99,10 @@ class SemiGrandCanonicalEventGenerator {
   /// Notes:
   /// - Must call `set` before `propose` or `apply`
   ///
-  /// \param random_number_generator A random number generator
-  monte::OccEvent const &propose(
-      monte::RandomNumberGenerator<EngineType> &random_number_generator) {
+  /// \param random_number_generator A random number generator, such as
+  ///     `monte::RandomNumberGenerator` or `BufferedRandomNumberGenerator`
+  template <typename GeneratorType>
+  monte::OccEvent const &propose(GeneratorType &random_number_generator) {
     if (this->use_multiswaps) {
       return monte::propose_semigrand_canonical_multiswap_event(
           this->occ_event, *this->occ_location,
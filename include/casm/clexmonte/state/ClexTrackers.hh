@@ -0,0 +1,493 @@
+#ifndef CASM_clexmonte_state_ClexTrackers
+#define CASM_clexmonte_state_ClexTrackers
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "casm/clexulator/ClusterExpansion.hh"
+#include "casm/clexulator/Correlations.hh"
+#include "casm/clexulator/OrderParameter.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Correlations (per_supercell), updated incrementally as events are
+///     applied
+///
+/// The correlations are calculated for the full supercell once, and then
+/// incremented by `correlations->occ_delta` for each applied event, which
+/// only depends on the event's neighborhood. To control round-off drift,
+/// they are recalculated for the full supercell when read after
+/// `reset_interval` events have been applied.
+class CorrelationsTracker {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _correlations Correlations calculator, which must be set to the
+  ///     current configuration
+  /// \param _reset_interval Number of applied events after which the
+  ///     correlations are recalculated for the full supercell when read. If
+  ///     <= 0, they are only calculated at construction.
+  CorrelationsTracker(std::shared_ptr<clexulator::Correlations> _correlations,
+                      Index _reset_interval)
+      : m_correlations(_correlations), m_reset_interval(_reset_interval) {
+    reset();
+  }
+
+  /// \brief Calculate the correlations for the full supercell
+  void reset() {
+    m_per_supercell = m_correlations->per_supercell();
+    m_n_applied = 0;
+  }
+
+  /// \brief Update the correlations for an event, before it is applied to
+  ///     the configuration
+  void apply(monte::OccEvent const &event) {
+    m_per_supercell +=
+        m_correlations->occ_delta(event.linear_site_index, event.new_occ);
+    ++m_n_applied;
+  }
+
+  /// \brief Correlations, normalized per supercell
+  Eigen::VectorXd const &per_supercell() {
+    if (m_reset_interval > 0 && m_n_applied >= m_reset_interval) {
+      reset();
+    }
+    return m_per_supercell;
+  }
+
+  /// \brief Correlations, normalized per unit cell
+  Eigen::VectorXd const &per_unitcell() {
+    return m_correlations->per_unitcell(this->per_supercell());
+  }
+
+  /// \brief The correlations calculator
+  clexulator::Correlations const &correlations() const {
+    return *m_correlations;
+  }
+
+ private:
+  std::shared_ptr<clexulator::Correlations> m_correlations;
+  Index m_reset_interval;
+  Index m_n_applied;
+  Eigen::VectorXd m_per_supercell;
+};
+
+/// \brief Cluster expansion value (per_supercell), updated incrementally as
+///     events are applied
+///
+/// The value is calculated for the full supercell once, and then incremented
+/// by `clex->occ_delta_value` for each applied event. To control round-off
+/// drift, it is recalculated for the full supercell when read after
+/// `reset_interval` events have been applied.
+class ClusterExpansionTracker {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _clex Cluster expansion calculator, which must be set to the
+  ///     current configuration
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _reset_interval Number of applied events after which the value
+  ///     is recalculated for the full supercell when read. If <= 0, it is
+  ///     only calculated at construction.
+  ClusterExpansionTracker(std::shared_ptr<clexulator::ClusterExpansion> _clex,
+                          Index _n_unitcells, Index _reset_interval)
+      : m_clex(_clex),
+        m_n_unitcells(_n_unitcells),
+        m_reset_interval(_reset_interval) {
+    reset();
+  }
+
+  /// \brief Calculate the value for the full supercell
+  void reset() {
+    m_per_supercell = m_clex->per_supercell();
+    m_n_applied = 0;
+  }
+
+  /// \brief Update the value for an event, before it is applied to the
+  ///     configuration
+  void apply(monte::OccEvent const &event) {
+    m_per_supercell +=
+        m_clex->occ_delta_value(event.linear_site_index, event.new_occ);
+    ++m_n_applied;
+  }
+
+  /// \brief Cluster expansion value, normalized per supercell
+  double per_supercell() {
+    if (m_reset_interval > 0 && m_n_applied >= m_reset_interval) {
+      reset();
+    }
+    return m_per_supercell;
+  }
+
+  /// \brief Cluster expansion value, normalized per unit cell
+  double per_unitcell() { return this->per_supercell() / m_n_unitcells; }
+
+ private:
+  std::shared_ptr<clexulator::ClusterExpansion> m_clex;
+  double m_n_unitcells;
+  Index m_reset_interval;
+  Index m_n_applied;
+  double m_per_supercell;
+};
+
+/// \brief Multi-cluster expansion values (per_supercell), updated
+///     incrementally as events are applied
+///
+/// The values are calculated for the full supercell once, and then
+/// incremented by the change in all values due to each applied event, by
+/// default from `multiclex->occ_delta_value`. To control round-off drift,
+/// they are recalculated for the full supercell when read after
+/// `reset_interval` events have been applied.
+class MultiClusterExpansionTracker {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _multiclex Multi-cluster expansion calculator, which must be set
+  ///     to the current configuration
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _reset_interval Number of applied events after which the values
+  ///     are recalculated for the full supercell when read. If <= 0, they
+  ///     are only calculated at construction.
+  /// \param _occ_delta_f If not null, calculates the change in all values
+  ///     due to an event, before it is applied to the configuration, i.e.
+  ///     to reuse changes already evaluated by a potential (see
+  ///     EnsembleClusterExpansion)
+  MultiClusterExpansionTracker(
+      std::shared_ptr<clexulator::MultiClusterExpansion> _multiclex,
+      Index _n_unitcells, Index _reset_interval,
+      std::function<Eigen::VectorXd const &(monte::OccEvent const &)>
+          _occ_delta_f = nullptr)
+      : m_multiclex(_multiclex),
+        m_n_unitcells(_n_unitcells),
+        m_reset_interval(_reset_interval),
+        m_occ_delta_f(_occ_delta_f) {
+    reset();
+  }
+
+  /// \brief Calculate the values for the full supercell
+  void reset() {
+    m_per_supercell = m_multiclex->per_supercell();
+    m_n_applied = 0;
+  }
+
+  /// \brief Update the values for an event, before it is applied to the
+  ///     configuration
+  void apply(monte::OccEvent const &event) {
+    if (m_occ_delta_f) {
+      m_per_supercell += m_occ_delta_f(event);
+    } else {
+      m_per_supercell +=
+          m_multiclex->occ_delta_value(event.linear_site_index, event.new_occ);
+    }
+    ++m_n_applied;
+  }
+
+  /// \brief Multi-cluster expansion values, normalized per supercell
+  Eigen::VectorXd const &per_supercell() {
+    if (m_reset_interval > 0 && m_n_applied >= m_reset_interval) {
+      reset();
+    }
+    return m_per_supercell;
+  }
+
+  /// \brief Multi-cluster expansion values, normalized per unit cell
+  Eigen::VectorXd per_unitcell() {
+    return this->per_supercell() / m_n_unitcells;
+  }
+
+ private:
+  std::shared_ptr<clexulator::MultiClusterExpansion> m_multiclex;
+  double m_n_unitcells;
+  Index m_reset_interval;
+  std::function<Eigen::VectorXd const &(monte::OccEvent const &)>
+      m_occ_delta_f;
+  Index m_n_applied;
+  Eigen::VectorXd m_per_supercell;
+};
+
+/// \brief Order parameter value, updated incrementally as events are applied
+///
+/// The order parameter is a linear projection of the site DoF, so it is
+/// calculated for the full supercell once, and then incremented by
+/// `order_parameter->occ_delta` for each applied event, which only depends
+/// on the event's sites. To control round-off drift, it is recalculated for
+/// the full supercell when read after `reset_interval` events have been
+/// applied.
+class OrderParameterTracker {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _order_parameter Order parameter calculator, which must be set
+  ///     to the current configuration
+  /// \param _reset_interval Number of applied events after which the value
+  ///     is recalculated for the full supercell when read. If <= 0, it is
+  ///     only calculated at construction.
+  OrderParameterTracker(
+      std::shared_ptr<clexulator::OrderParameter> _order_parameter,
+      Index _reset_interval)
+      : m_order_parameter(_order_parameter),
+        m_reset_interval(_reset_interval) {
+    reset();
+  }
+
+  /// \brief Calculate the value for the full supercell
+  void reset() {
+    m_value = m_order_parameter->value();
+    m_n_applied = 0;
+  }
+
+  /// \brief Update the value for an event, before it is applied to the
+  ///     configuration
+  void apply(monte::OccEvent const &event) {
+    m_value +=
+        m_order_parameter->occ_delta(event.linear_site_index, event.new_occ);
+    ++m_n_applied;
+  }
+
+  /// \brief Order parameter value
+  Eigen::VectorXd const &value() {
+    if (m_reset_interval > 0 && m_n_applied >= m_reset_interval) {
+      reset();
+    }
+    return m_value;
+  }
+
+ private:
+  std::shared_ptr<clexulator::OrderParameter> m_order_parameter;
+  Index m_reset_interval;
+  Index m_n_applied;
+  Eigen::VectorXd m_value;
+};
+
+/// \brief Potential energy (per_supercell), updated incrementally as events
+///     are applied
+///
+/// The value is calculated for the full supercell once, and then incremented
+/// by the potential's change for each applied event. To control round-off
+/// drift, it is recalculated for the full supercell when read after
+/// `reset_interval` events have been applied.
+///
+/// Because the potential may depend on other incrementally updated state,
+/// such as component counts or an order parameter potential, events must be
+/// applied to this tracker before they are applied to that state.
+class PotentialTracker {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _per_supercell_f Calculates the potential for the full supercell
+  /// \param _occ_delta_per_supercell_f Calculates the change in potential
+  ///     due to an event, before it is applied to the configuration
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _reset_interval Number of applied events after which the value
+  ///     is recalculated for the full supercell when read. If <= 0, it is
+  ///     only calculated at construction.
+  PotentialTracker(
+      std::function<double()> _per_supercell_f,
+      std::function<double(monte::OccEvent const &)> _occ_delta_per_supercell_f,
+      Index _n_unitcells, Index _reset_interval)
+      : m_per_supercell_f(_per_supercell_f),
+        m_occ_delta_per_supercell_f(_occ_delta_per_supercell_f),
+        m_n_unitcells(_n_unitcells),
+        m_reset_interval(_reset_interval) {
+    reset();
+  }
+
+  /// \brief Calculate the value for the full supercell
+  void reset() {
+    m_per_supercell = m_per_supercell_f();
+    m_n_applied = 0;
+  }
+
+  /// \brief Update the value for an event, before it is applied to the
+  ///     configuration
+  void apply(monte::OccEvent const &event) {
+    m_per_supercell += m_occ_delta_per_supercell_f(event);
+    ++m_n_applied;
+  }
+
+  /// \brief Potential energy, normalized per supercell
+  double per_supercell() {
+    if (m_reset_interval > 0 && m_n_applied >= m_reset_interval) {
+      reset();
+    }
+    return m_per_supercell;
+  }
+
+  /// \brief Potential energy, normalized per unit cell
+  double per_unitcell() { return this->per_supercell() / m_n_unitcells; }
+
+ private:
+  std::function<double()> m_per_supercell_f;
+  std::function<double(monte::OccEvent const &)> m_occ_delta_per_supercell_f;
+  double m_n_unitcells;
+  Index m_reset_interval;
+  Index m_n_applied;
+  double m_per_supercell;
+};
+
+/// \brief Trackers of correlations, cluster expansion values, multi-cluster
+///     expansion values, order parameters, and the potential energy,
+///     updated incrementally as events are applied
+///
+/// Trackers are constructed by sampling functions the first time a quantity
+/// is sampled, and from then on are updated by `apply`, so only sampled
+/// quantities are tracked.
+struct ClexTrackers {
+  /// \brief Constructor
+  ///
+  /// \param _n_unitcells Number of unit cells in the supercell
+  /// \param _reset_interval Number of applied events after which tracked
+  ///     values are recalculated for the full supercell when read. If <= 0,
+  ///     they are only calculated when a tracker is constructed.
+  ClexTrackers(Index _n_unitcells, Index _reset_interval)
+      : n_unitcells(_n_unitcells), reset_interval(_reset_interval) {}
+
+  /// Number of unit cells in the supercell
+  Index n_unitcells;
+
+  /// Number of applied events between full recalculations
+  Index reset_interval;
+
+  /// Basis set correlations, by basis set name
+  std::map<std::string, CorrelationsTracker> corr;
+
+  /// Cluster expansion values, by cluster expansion name
+  std::map<std::string, ClusterExpansionTracker> clex;
+
+  /// Cluster expansion correlations (for non-zero coefficients), by cluster
+  /// expansion name
+  std::map<std::string, CorrelationsTracker> clex_corr;
+
+  /// Multi-cluster expansion values, by multi-cluster expansion name
+  std::map<std::string, MultiClusterExpansionTracker> multiclex;
+
+  /// Order parameter values, by DoF space name
+  std::map<std::string, OrderParameterTracker> order_parameter;
+
+  /// Potential energy
+  std::optional<PotentialTracker> potential;
+
+  /// \brief Get or construct the tracker of basis set correlations
+  CorrelationsTracker &get_corr(
+      std::string const &key,
+      std::shared_ptr<clexulator::Correlations> const &correlations) {
+    auto it = corr.find(key);
+    if (it == corr.end()) {
+      it = corr.emplace(key, CorrelationsTracker(correlations, reset_interval))
+               .first;
+    }
+    return it->second;
+  }
+
+  /// \brief Get or construct the tracker of a cluster expansion value
+  ClusterExpansionTracker &get_clex(
+      std::string const &key,
+      std::shared_ptr<clexulator::ClusterExpansion> const &_clex) {
+    auto it = clex.find(key);
+    if (it == clex.end()) {
+      it = clex.emplace(key, ClusterExpansionTracker(_clex, n_unitcells,
+                                                     reset_interval))
+               .first;
+    }
+    return it->second;
+  }
+
+  /// \brief Get or construct the tracker of cluster expansion correlations
+  ///
+  /// The tracker shares the cluster expansion's correlations calculator.
+  CorrelationsTracker &get_clex_corr(
+      std::string const &key,
+      std::shared_ptr<clexulator::ClusterExpansion> const &_clex) {
+    auto it = clex_corr.find(key);
+    if (it == clex_corr.end()) {
+      std::shared_ptr<clexulator::Correlations> correlations(
+          _clex, &_clex->correlations());
+      it = clex_corr
+               .emplace(key, CorrelationsTracker(correlations, reset_interval))
+               .first;
+    }
+    return it->second;
+  }
+
+  /// \brief Get or construct the tracker of multi-cluster expansion values
+  ///
+  /// \param key Multi-cluster expansion name
+  /// \param _multiclex Multi-cluster expansion calculator
+  /// \param occ_delta_f If not null, and the tracker is constructed, used
+  ///     to calculate the change in all values due to an event
+  MultiClusterExpansionTracker &get_multiclex(
+      std::string const &key,
+      std::shared_ptr<clexulator::MultiClusterExpansion> const &_multiclex,
+      std::function<Eigen::VectorXd const &(monte::OccEvent const &)> const
+          &occ_delta_f = nullptr) {
+    auto it = multiclex.find(key);
+    if (it == multiclex.end()) {
+      it = multiclex
+               .emplace(key, MultiClusterExpansionTracker(
+                                 _multiclex, n_unitcells, reset_interval,
+                                 occ_delta_f))
+               .first;
+    }
+    return it->second;
+  }
+
+  /// \brief Get or construct the tracker of an order parameter value
+  OrderParameterTracker &get_order_parameter(
+      std::string const &key,
+      std::shared_ptr<clexulator::OrderParameter> const &_order_parameter) {
+    auto it = order_parameter.find(key);
+    if (it == order_parameter.end()) {
+      it = order_parameter
+               .emplace(key, OrderParameterTracker(_order_parameter,
+                                                   reset_interval))
+               .first;
+    }
+    return it->second;
+  }
+
+  /// \brief Get or construct the tracker of the potential energy
+  PotentialTracker &get_potential(
+      std::function<double()> const &per_supercell_f,
+      std::function<double(monte::OccEvent const &)> const
+          &occ_delta_per_supercell_f) {
+    if (!potential.has_value()) {
+      potential.emplace(per_supercell_f, occ_delta_per_supercell_f,
+                        n_unitcells, reset_interval);
+    }
+    return *potential;
+  }
+
+  /// \brief Update all trackers for an event, before it is applied to the
+  ///     configuration
+  void apply(monte::OccEvent const &event) {
+    if (potential.has_value()) {
+      potential->apply(event);
+    }
+    for (auto &pair : corr) {
+      pair.second.apply(event);
+    }
+    for (auto &pair : clex) {
+      pair.second.apply(event);
+    }
+    for (auto &pair : clex_corr) {
+      pair.second.apply(event);
+    }
+    for (auto &pair : multiclex) {
+      pair.second.apply(event);
+    }
+    for (auto &pair : order_parameter) {
+      pair.second.apply(event);
+    }
+  }
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
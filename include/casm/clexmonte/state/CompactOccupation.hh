@@ -0,0 +1,90 @@
+#ifndef CASM_clexmonte_state_CompactOccupation
+#define CASM_clexmonte_state_CompactOccupation
+
+#include <cstdint>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Occupation indices stored with 1, 2, 4, or 8 bits per site
+///
+/// The occupation of a state is stored as `Eigen::VectorXi`, 4 bytes per
+/// site, because clexulators and `monte::OccLocation` read it as `int`. A
+/// CompactOccupation holds a copy of an occupation with the fewest bits per
+/// site that hold the maximum occupant index, for example 2 bits per site
+/// with at most 4 occupants per sublattice, which is 16 times smaller. It is
+/// used where occupations are held in addition to the current state, such
+/// as checkpoints.
+///
+/// Values are bit-packed, least significant bits first, so a value never
+/// spans two bytes and `data()` is also the layout used by
+/// `pack_occupation` for the same number of bits per value.
+class CompactOccupation {
+ public:
+  /// \brief Construct an empty occupation
+  CompactOccupation() : m_size(0), m_bits_per_value(1), m_mask(1) {}
+
+  /// \brief Construct with all values zero
+  CompactOccupation(Index _size, int _bits_per_value);
+
+  /// \brief Number of sites
+  Index size() const { return m_size; }
+
+  /// \brief Bits per site, one of 1, 2, 4, or 8
+  int bits_per_value() const { return m_bits_per_value; }
+
+  /// \brief Largest occupation index that can be stored
+  int max_value() const { return m_mask; }
+
+  /// \brief Occupation index of site `l`
+  int get(Index l) const {
+    std::size_t bit = std::size_t(l) * m_bits_per_value;
+    return (m_data[bit >> 3] >> (bit & 7)) & m_mask;
+  }
+
+  /// \brief Set the occupation index of site `l`, which must be in
+  ///     `[0, max_value()]`
+  void set(Index l, int value) {
+    std::size_t bit = std::size_t(l) * m_bits_per_value;
+    std::uint8_t &byte = m_data[bit >> 3];
+    byte = (byte & ~(m_mask << (bit & 7))) | ((value & m_mask) << (bit & 7));
+  }
+
+  /// \brief Occupation index of site `l`
+  int operator[](Index l) const { return get(l); }
+
+  /// \brief Packed bytes
+  std::vector<std::uint8_t> const &data() const { return m_data; }
+
+  /// \brief Packed bytes
+  std::vector<std::uint8_t> &data() { return m_data; }
+
+  /// \brief Copy all values into `occupation`, resizing it if necessary
+  void to_vector(Eigen::VectorXi &occupation) const;
+
+  /// \brief Return all values as `Eigen::VectorXi`
+  Eigen::VectorXi to_vector() const;
+
+ private:
+  Index m_size;
+  int m_bits_per_value;
+  int m_mask;
+  std::vector<std::uint8_t> m_data;
+};
+
+/// \brief Fewest bits per value, of 1, 2, 4, or 8, that can hold
+///     `max_value`
+int compact_bits_per_value(int max_value);
+
+/// \brief Make a CompactOccupation from occupation indices
+CompactOccupation make_compact_occupation(Eigen::VectorXi const &occupation,
+                                          int bits_per_value = 0);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
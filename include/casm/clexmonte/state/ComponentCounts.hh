@@ -0,0 +1,112 @@
+#ifndef CASM_clexmonte_state_ComponentCounts
+#define CASM_clexmonte_state_ComponentCounts
+
+#include <vector>
+
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/composition/CompositionCalculator.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Number of each component in a configuration, updated
+///     incrementally as events are applied
+///
+/// Counting all sites is O(n_sites), but updating the counts for an event
+/// only depends on the number of sites in the event, so the composition can
+/// be sampled at a cost independent of supercell size.
+///
+/// Usage:
+/// - Construct, or call `reset`, with the current occupation
+/// - Call `apply(event, occupation)` for each event, before the event is
+///   applied to `occupation`
+/// - If `occupation` is modified in any other way, call `reset` again
+class ComponentCounts {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param composition_calculator Composition calculator, which defines the
+  ///     components
+  /// \param convert Index conversions for the supercell
+  /// \param occupation The current occupation
+  ComponentCounts(
+      composition::CompositionCalculator const &composition_calculator,
+      monte::Conversions const &convert, Eigen::VectorXi const &occupation)
+      : m_convert(convert),
+        m_species_to_component(
+            enforce_composition_impl::make_species_to_component_index_converter(
+                composition_calculator, convert)),
+        m_n_sublat(composition_calculator.n_sublat()) {
+    reset(occupation);
+  }
+
+  /// \brief Count each component by checking all sites
+  void reset(Eigen::VectorXi const &occupation) {
+    Index n_components = m_species_to_component.size();
+    m_num_each_component = Eigen::VectorXl::Zero(n_components);
+    for (Index l = 0; l < occupation.size(); ++l) {
+      m_num_each_component(_component_index(l, occupation(l))) += 1;
+    }
+    m_volume = occupation.size() / m_n_sublat;
+    m_mean_num_each_component =
+        m_num_each_component.cast<double>() / m_volume;
+  }
+
+  /// \brief Update the counts for an event, before it is applied to
+  ///     `occupation`
+  void apply(monte::OccEvent const &event, Eigen::VectorXi const &occupation) {
+    for (Index i = 0; i < event.linear_site_index.size(); ++i) {
+      Index l = event.linear_site_index[i];
+      _add(_component_index(l, occupation(l)), -1);
+      _add(_component_index(l, event.new_occ[i]), 1);
+    }
+  }
+
+  /// \brief Number of each component, in the supercell
+  Eigen::VectorXl const &num_each_component() const {
+    return m_num_each_component;
+  }
+
+  /// \brief Number of each component, normalized per unit cell
+  ///
+  /// Equivalent to `composition_calculator.mean_num_each_component(
+  /// occupation)`.
+  Eigen::VectorXd const &mean_num_each_component() const {
+    return m_mean_num_each_component;
+  }
+
+ private:
+  Index _component_index(Index l, int occ) const {
+    return m_species_to_component[m_convert.species_index(
+        m_convert.l_to_asym(l), occ)];
+  }
+
+  void _add(Index component_index, Index n) {
+    m_num_each_component(component_index) += n;
+    m_mean_num_each_component(component_index) =
+        m_num_each_component(component_index) / m_volume;
+  }
+
+  monte::Conversions const &m_convert;
+
+  /// Species index to component index
+  std::vector<Index> m_species_to_component;
+
+  /// Number of sublattices
+  Index m_n_sublat;
+
+  /// Number of unit cells
+  double m_volume;
+
+  Eigen::VectorXl m_num_each_component;
+
+  Eigen::VectorXd m_mean_num_each_component;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
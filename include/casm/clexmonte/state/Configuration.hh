@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_state_Configuration
 #define CASM_clexmonte_state_Configuration
 
+#include <cstdint>
+
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexulator/ClusterExpansion.hh"
 #include "casm/clexulator/ConfigDoFValues.hh"
@@ -48,6 +50,20 @@ inline clexulator::ConfigDoFValues &get_dof_values(state_type &state) {
   return state.configuration.dof_values;
 }
 
+/// \brief A fast hash of the occupation of `state`
+///
+/// Used to recognize that a state is unmodified since it was last validated,
+/// without recalculating its composition. Different occupations have the
+/// same fingerprint only by chance.
+inline std::uint64_t get_occupation_fingerprint(state_type const &state) {
+  Eigen::VectorXi const &occupation = get_occupation(state);
+  std::uint64_t h = 14695981039346656037ULL ^ occupation.size();
+  for (Index l = 0; l < occupation.size(); ++l) {
+    h = (h ^ static_cast<std::uint32_t>(occupation(l))) * 1099511628211ULL;
+  }
+  return h;
+}
+
 /// \brief Set calculator so it evaluates using `state`
 inline void set(clexulator::ClusterExpansion &calculator,
                 state_type const &state) {
@@ -0,0 +1,135 @@
+#ifndef CASM_clexmonte_state_ConfigurationSnapshot
+#define CASM_clexmonte_state_ConfigurationSnapshot
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/events/OccEvent.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief An immutable configuration snapshot, which shares unchanged data
+///     with other snapshots
+///
+/// The occupation is stored in blocks of `block_size` sites, and each block,
+/// and each local and global DoF value matrix, is held by a shared pointer
+/// to const data. Snapshots taken by one `ConfigurationSnapshotter` share
+/// every block that did not change between them, so a series of snapshots
+/// of a long run costs memory only for the blocks the simulation modified.
+/// Copying a snapshot copies pointers only.
+struct ConfigurationSnapshot {
+  /// \brief The supercell
+  std::shared_ptr<config::Supercell const> supercell;
+
+  /// \brief Number of sites
+  Index n_sites = 0;
+
+  /// \brief Number of sites per occupation block
+  Index block_size = 0;
+
+  /// \brief Occupation blocks; the last block may be shorter than
+  ///     `block_size`
+  std::vector<std::shared_ptr<Eigen::VectorXi const>> occupation_blocks;
+
+  /// \brief Local continuous DoF values
+  std::map<std::string, std::shared_ptr<Eigen::MatrixXd const>>
+      local_dof_values;
+
+  /// \brief Global continuous DoF values
+  std::map<std::string, std::shared_ptr<Eigen::VectorXd const>>
+      global_dof_values;
+
+  /// \brief Copy the occupation
+  Eigen::VectorXi occupation() const;
+
+  /// \brief Copy the full configuration
+  Configuration configuration() const;
+};
+
+/// \brief Takes configuration snapshots which share unchanged blocks with
+///     the previous snapshot
+///
+/// Taking a snapshot copies only the occupation blocks that changed since
+/// the previous snapshot. Changed blocks are found in one of two ways:
+///
+/// - By default, each block is compared with the previous snapshot. This
+///   reads the whole occupation, but allocates and copies only changed
+///   blocks.
+/// - With `use_modification_tracking`, the caller marks modified sites with
+///   `mark_modified` (for example, for each accepted event, in the function
+///   that applies events) and only marked blocks are copied, so that taking
+///   a snapshot costs O(number of blocks) pointer copies plus the copies of
+///   modified blocks, independent of the number of sites otherwise.
+///
+/// Continuous DoF values are shared between snapshots if unchanged, by
+/// comparison with the previous snapshot.
+///
+/// `record` takes a snapshot and keeps it, for use as a configuration
+/// sampling function (see `make_config_snapshot_f`). A
+/// ConfigurationSnapshotter is not thread-safe; use one per run.
+class ConfigurationSnapshotter {
+ public:
+  /// \brief Constructor
+  explicit ConfigurationSnapshotter(Index _block_size = 1024,
+                                    bool _use_modification_tracking = false);
+
+  /// \brief Number of sites per occupation block
+  Index const block_size;
+
+  /// \brief If true, only blocks marked by `mark_modified` are copied
+  bool const use_modification_tracking;
+
+  /// \brief Take a snapshot
+  std::shared_ptr<ConfigurationSnapshot const> take(
+      Configuration const &configuration);
+
+  /// \brief Take a snapshot and keep it
+  Index record(Configuration const &configuration);
+
+  /// \brief Mark a site as modified since the last snapshot
+  void mark_modified(Index linear_site_index);
+
+  /// \brief Mark the sites changed by an event as modified since the last
+  ///     snapshot
+  void mark_modified(monte::OccEvent const &event);
+
+  /// \brief Mark all sites as modified, so the next snapshot is a full copy
+  void mark_all_modified();
+
+  /// \brief Kept snapshots, in the order recorded
+  std::vector<std::shared_ptr<ConfigurationSnapshot const>> const &snapshots()
+      const {
+    return m_snapshots;
+  }
+
+  /// \brief Total number of occupation blocks copied
+  Index n_blocks_copied() const { return m_n_blocks_copied; }
+
+  /// \brief Total number of occupation blocks shared with the previous
+  ///     snapshot
+  Index n_blocks_shared() const { return m_n_blocks_shared; }
+
+  /// \brief Forget the previous snapshot and kept snapshots
+  void reset();
+
+ private:
+  std::shared_ptr<ConfigurationSnapshot const> m_last;
+
+  /// Blocks marked as modified, with use_modification_tracking
+  std::vector<char> m_modified;
+  bool m_all_modified;
+
+  std::vector<std::shared_ptr<ConfigurationSnapshot const>> m_snapshots;
+
+  Index m_n_blocks_copied;
+  Index m_n_blocks_shared;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
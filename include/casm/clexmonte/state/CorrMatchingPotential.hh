@@ -1,12 +1,15 @@
 #ifndef CASM_clexmonte_state_CorrMatchingPotential
 #define CASM_clexmonte_state_CorrMatchingPotential
 
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexulator/Correlations.hh"
 #include "casm/global/definitions.hh"
 #include "casm/global/eigen.hh"
+#include "casm/monte/events/OccEvent.hh"
 
 namespace CASM {
 
@@ -76,6 +79,83 @@ double delta_corr_matching_potential(Eigen::VectorXd const &corr,
                                      Eigen::VectorXd const &delta_corr,
                                      CorrMatchingParams const &params);
 
+/// \brief Correlation indices of the targets, for constructing a
+///     clexulator::Correlations that only evaluates target correlations
+std::vector<unsigned int> make_corr_matching_indices(
+    CorrMatchingParams const &params);
+
+/// \brief Correlation-matching potential, with changes due to events
+///     calculated from the target correlations only
+///
+/// `delta_corr_matching_potential` requires the full dense change in
+/// correlations for each proposed event. This instead uses a
+/// clexulator::Correlations constructed to only evaluate the target
+/// correlations (see `make_corr_matching_indices`), stores the current value
+/// of each target correlation, and tracks the number of leading exactly
+/// matching targets as events are applied. Target indices are validated
+/// once, at construction.
+class CorrMatchingPotentialCalculator {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param params Correlation-matching potential parameters
+  /// \param correlations Correlations calculator, which must be set to the
+  ///     current configuration. For efficiency, it should be constructed
+  ///     with `make_corr_matching_indices(params)` as correlation indices.
+  /// \param n_unitcells Number of unit cells in the supercell
+  CorrMatchingPotentialCalculator(
+      CorrMatchingParams const &params,
+      std::shared_ptr<clexulator::Correlations> correlations,
+      Index n_unitcells);
+
+  /// \brief Calculate the target correlations for the full supercell
+  void reset();
+
+  /// \brief Update the target correlations for an event, before it is
+  ///     applied to the configuration
+  void apply(monte::OccEvent const &event);
+
+  /// \brief Current correlation-matching potential value
+  ///
+  /// Equivalent to `corr_matching_potential(corr, params)`, with `corr` the
+  /// current correlations normalized per unit cell.
+  double value() const;
+
+  /// \brief Change in correlation-matching potential value due to a series
+  ///     of occupation changes
+  double occ_delta(std::vector<Index> const &linear_site_index,
+                   std::vector<int> const &new_occ);
+
+  /// \brief Number of leading exactly matching targets
+  Index n_exact() const { return m_n_exact; }
+
+  /// \brief Current value of each target correlation, normalized per unit
+  ///     cell
+  Eigen::VectorXd const &target_corr() const { return m_corr; }
+
+ private:
+  /// \brief Number of leading targets matched exactly by `corr`
+  Index _count_n_exact(Eigen::VectorXd const &corr) const;
+
+  CorrMatchingParams m_params;
+  std::shared_ptr<clexulator::Correlations> m_correlations;
+  double m_n_unitcells;
+
+  /// Current value of each target correlation, normalized per unit cell
+  Eigen::VectorXd m_corr;
+
+  /// Current number of leading exactly matching targets
+  Index m_n_exact;
+
+  /// Work space
+  Eigen::VectorXd m_new_corr;
+};
+
+/// \brief Wrap a correlations calculator so that results are cached by
+///     `sublattice_prob`
+CorrCalculatorFunction make_memoized_corr_f(CorrCalculatorFunction corr_f,
+                                            Index max_size = 1000);
+
 struct RandomAlloyCorrMatchingParams : public CorrMatchingParams {
   explicit RandomAlloyCorrMatchingParams(
       CorrCalculatorFunction _random_alloy_corr_f);
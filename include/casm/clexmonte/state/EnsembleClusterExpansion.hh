@@ -0,0 +1,125 @@
+#ifndef CASM_clexmonte_state_EnsembleClusterExpansion
+#define CASM_clexmonte_state_EnsembleClusterExpansion
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "casm/clexulator/ClusterExpansion.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Specifies a multi-cluster expansion used as the formation energy
+///     of a potential
+struct EnsembleClusterExpansionParams {
+  /// Name of the multi-cluster expansion, a key into System::multiclex_data
+  std::string multiclex_key;
+
+  /// Index of the coefficient set used by the potential, or -1 to use the
+  /// mean of all coefficient sets
+  Index member = -1;
+};
+
+/// \brief A cluster expansion value given by one member, or the mean, of an
+///     ensemble of coefficient sets sharing one basis set
+///
+/// The changes in the values of all members due to an event are evaluated
+/// together, from the same correlation changes, by the multi-cluster
+/// expansion. The potential uses the selected member, or the mean, and the
+/// changes of all members for the most recently evaluated event are kept, so
+/// that when that event is accepted a tracker of the ensemble values (see
+/// `MultiClusterExpansionTracker`) reuses them instead of evaluating the
+/// event again.
+///
+/// Notes:
+/// - The kept changes are only valid until the configuration changes, so
+///   `invalidate` must be called whenever an event is applied.
+class EnsembleClusterExpansion {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _multiclex Multi-cluster expansion calculator, which must be set
+  ///     to the current configuration
+  /// \param _member Index of the coefficient set to use, or -1 to use the
+  ///     mean of all coefficient sets
+  EnsembleClusterExpansion(
+      std::shared_ptr<clexulator::MultiClusterExpansion> _multiclex,
+      Index _member)
+      : m_multiclex(_multiclex), m_member(_member), m_is_valid(false) {
+    m_n_members = m_multiclex->per_supercell().size();
+    if (m_member < -1 || m_member >= m_n_members) {
+      throw std::runtime_error(
+          "Error in EnsembleClusterExpansion: member index out of range");
+    }
+  }
+
+  /// \brief Index of the coefficient set used, or -1 for the mean
+  Index member() const { return m_member; }
+
+  /// \brief Number of coefficient sets
+  Index n_members() const { return m_n_members; }
+
+  /// \brief The multi-cluster expansion calculator
+  std::shared_ptr<clexulator::MultiClusterExpansion> const &multiclex() const {
+    return m_multiclex;
+  }
+
+  /// \brief Value of the selected member, or the mean, per supercell
+  double per_supercell() { return _select(m_multiclex->per_supercell()); }
+
+  /// \brief Change in the value of the selected member, or the mean, due to
+  ///     a series of occupation changes
+  ///
+  /// The changes of all members are kept for `occ_delta_values`.
+  double occ_delta_value(std::vector<Index> const &linear_site_index,
+                         std::vector<int> const &new_occ) {
+    m_delta = m_multiclex->occ_delta_value(linear_site_index, new_occ);
+    m_linear_site_index = linear_site_index;
+    m_new_occ = new_occ;
+    m_is_valid = true;
+    return _select(m_delta);
+  }
+
+  /// \brief Change in the values of all members due to an event, reusing
+  ///     the changes from `occ_delta_value` if the event was the most
+  ///     recently evaluated
+  Eigen::VectorXd const &occ_delta_values(monte::OccEvent const &event) {
+    if (!m_is_valid || event.linear_site_index != m_linear_site_index ||
+        event.new_occ != m_new_occ) {
+      m_delta =
+          m_multiclex->occ_delta_value(event.linear_site_index, event.new_occ);
+      m_linear_site_index = event.linear_site_index;
+      m_new_occ = event.new_occ;
+      m_is_valid = true;
+    }
+    return m_delta;
+  }
+
+  /// \brief Discard the kept changes, which must be done whenever the
+  ///     configuration changes
+  void invalidate() { m_is_valid = false; }
+
+ private:
+  double _select(Eigen::VectorXd const &values) const {
+    return m_member == -1 ? values.mean() : values(m_member);
+  }
+
+  std::shared_ptr<clexulator::MultiClusterExpansion> m_multiclex;
+  Index m_member;
+  Index m_n_members;
+
+  // changes of all members for the most recently evaluated event
+  bool m_is_valid;
+  std::vector<Index> m_linear_site_index;
+  std::vector<int> m_new_occ;
+  Eigen::VectorXd m_delta;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
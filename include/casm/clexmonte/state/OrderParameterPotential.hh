@@ -0,0 +1,140 @@
+#ifndef CASM_clexmonte_state_OrderParameterPotential
+#define CASM_clexmonte_state_OrderParameterPotential
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "casm/clexulator/OrderParameter.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/ValueMap.hh"
+#include "casm/monte/events/OccEvent.hh"
+
+namespace CASM {
+namespace xtal {
+class BasicStructure;
+}
+
+namespace monte {
+class Conversions;
+}
+
+namespace clexmonte {
+
+/// \brief Linear and quadratic potential in order parameter, evaluated
+///     incrementally
+///
+/// The potential, per unit cell, is:
+///
+/// \code
+/// Eigen::VectorXd y = order_parameter - target;
+/// double potential = order_parameter_pot.dot(order_parameter) + y.dot(V * y);
+/// \endcode
+///
+/// where `V` is `order_parameter_quad_pot_matrix`, or the diagonal matrix
+/// with `order_parameter_quad_pot_vector` on the diagonal (see
+/// `OptionalOrderPotConditionsMixin`). Either term may be omitted.
+///
+/// The order parameter is a linear projection of the site DoF, so the
+/// contribution of each occupant on each site is tabulated once at
+/// construction and the change in order parameter due to an event is summed
+/// from the table. The change in potential is then O(n_sites_in_event * dim
+/// + dim^2), rather than a projection of the full configuration. The table
+/// takes n_sites * n_occupants * dim values. Only occupation changes are
+/// included.
+class OrderParameterPotential {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param order_parameter Order parameter calculator, which must be set
+  ///     to the current configuration
+  /// \param prim The prim, which defines the allowed occupants on each site
+  /// \param convert Index conversions for the supercell
+  /// \param occupation Current occupation
+  /// \param order_parameter_pot Linear potential coefficients, of size dim,
+  ///     or std::nullopt
+  /// \param target Location of quadratic potential minimum, of size dim, or
+  ///     std::nullopt
+  /// \param V Quadratic potential coefficients, of size dim x dim, or
+  ///     std::nullopt
+  OrderParameterPotential(
+      std::shared_ptr<clexulator::OrderParameter> order_parameter,
+      xtal::BasicStructure const &prim, monte::Conversions const &convert,
+      Eigen::VectorXi const &occupation,
+      std::optional<Eigen::VectorXd> order_parameter_pot,
+      std::optional<Eigen::VectorXd> target,
+      std::optional<Eigen::MatrixXd> V);
+
+  /// \brief Construct if the conditions include "order_parameter_pot", or
+  ///     "order_parameter_quad_pot_target" and either
+  ///     "order_parameter_quad_pot_vector" or
+  ///     "order_parameter_quad_pot_matrix", else return std::nullopt
+  static std::optional<OrderParameterPotential> from_conditions(
+      monte::ValueMap const &conditions,
+      std::shared_ptr<clexulator::OrderParameter> order_parameter,
+      xtal::BasicStructure const &prim, monte::Conversions const &convert,
+      Eigen::VectorXi const &occupation);
+
+  /// \brief Calculate the order parameter for the full supercell, and
+  ///     then update it incrementally with `apply`
+  void reset();
+
+  /// \brief Update the order parameter for an event, before it is applied
+  ///     to the occupation
+  ///
+  /// Only has an effect after `reset` has been called.
+  void apply(monte::OccEvent const &event, Eigen::VectorXi const &occupation);
+
+  /// \brief Calculate (per_supercell) potential value
+  double per_supercell();
+
+  /// \brief Calculate change in (per_supercell) potential value due to a
+  ///     series of occupation changes
+  ///
+  /// \param occupation Current occupation
+  /// \param linear_site_index Sites that change
+  /// \param new_occ New occupation index on each site
+  double occ_delta_per_supercell(Eigen::VectorXi const &occupation,
+                                 std::vector<Index> const &linear_site_index,
+                                 std::vector<int> const &new_occ);
+
+ private:
+  /// \brief Current order parameter, from the tracked value if `reset` has
+  ///     been called, else calculated for the full supercell
+  Eigen::VectorXd const &_value();
+
+  /// \brief Set m_d, the change in order parameter due to an event
+  void _delta(Eigen::VectorXi const &occupation,
+              std::vector<Index> const &linear_site_index,
+              std::vector<int> const &new_occ);
+
+  std::shared_ptr<clexulator::OrderParameter> m_order_parameter;
+  double m_n_unitcells;
+  std::optional<Eigen::VectorXd> m_order_parameter_pot;
+  std::optional<Eigen::VectorXd> m_target;
+  std::optional<Eigen::MatrixXd> m_V;
+  Eigen::MatrixXd m_V_plus_Vt;
+
+  /// Column of m_contribution for occupant 0 on each site
+  std::vector<Index> m_site_offset;
+
+  /// Contribution to the order parameter of each occupant on each site,
+  /// relative to the occupation at construction, (dim x n_site_occupants)
+  Eigen::MatrixXd m_contribution;
+
+  /// If true, m_value is updated by `apply`
+  bool m_tracking;
+
+  /// Order parameter, if m_tracking
+  Eigen::VectorXd m_value;
+
+  /// Work space
+  Eigen::VectorXd m_y;
+  Eigen::VectorXd m_d;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
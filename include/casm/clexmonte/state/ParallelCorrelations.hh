@@ -0,0 +1,86 @@
+#ifndef CASM_clexmonte_state_ParallelCorrelations
+#define CASM_clexmonte_state_ParallelCorrelations
+
+#include <memory>
+#include <vector>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexulator/Clexulator.hh"
+#include "casm/clexulator/ConfigDoFValues.hh"
+#include "casm/clexulator/NeighborList.hh"
+#include "casm/clexulator/SparseCoefficients.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Calculates correlations for the full supercell using multiple
+///     threads
+///
+/// Unit cells are partitioned into blocks of `block_size` consecutive unit
+/// cells. Threads calculate the sum of the correlation contributions of
+/// whole blocks, and the block sums are then added in block order, so
+/// results only depend on `block_size`, not on the number of threads.
+/// Results agree with `clexulator::Correlations::per_supercell` to within
+/// round-off.
+///
+/// Each thread uses its own copy of the clexulator, because a clexulator
+/// holds pointers to the DoF values and neighbor list it is evaluating.
+class ParallelCorrelations {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _supercell_neighbor_list The supercell neighbor list
+  /// \param _clexulator The clexulator, which is copied for each thread
+  /// \param _dof_values The DoF values to be evaluated, which must outlive
+  ///     this object
+  /// \param _n_threads Number of threads, including the calling thread
+  /// \param _block_size Number of unit cells per block
+  ParallelCorrelations(
+      std::shared_ptr<clexulator::SuperNeighborList> _supercell_neighbor_list,
+      clexulator::Clexulator const &_clexulator,
+      clexulator::ConfigDoFValues const *_dof_values, Index _n_threads,
+      Index _block_size = 256);
+
+  ParallelCorrelations(ParallelCorrelations const &) = delete;
+  ParallelCorrelations &operator=(ParallelCorrelations const &) = delete;
+
+  /// \brief Number of threads, including the calling thread
+  Index n_threads() const { return m_pool.n_threads(); }
+
+  /// \brief Set the DoF values to be evaluated
+  void set(clexulator::ConfigDoFValues const *_dof_values) {
+    m_dof_values = _dof_values;
+  }
+
+  /// \brief Correlations, normalized per supercell
+  Eigen::VectorXd const &per_supercell();
+
+  /// \brief Correlations, normalized per unit cell
+  Eigen::VectorXd const &per_unitcell();
+
+  /// \brief Cluster expansion value, normalized per supercell
+  double per_supercell(clexulator::SparseCoefficients const &coefficients);
+
+ private:
+  std::shared_ptr<clexulator::SuperNeighborList> m_supercell_neighbor_list;
+  std::vector<clexulator::Clexulator> m_clexulator;
+  clexulator::ConfigDoFValues const *m_dof_values;
+  Index m_n_unitcells;
+  Index m_block_size;
+  ThreadPool m_pool;
+
+  /// Block sums, column `b` is the sum over block `b`
+  Eigen::MatrixXd m_block_sum;
+
+  /// Correlation contribution of one unit cell, one column per thread
+  Eigen::MatrixXd m_contribution;
+
+  Eigen::VectorXd m_per_supercell;
+  Eigen::VectorXd m_per_unitcell;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
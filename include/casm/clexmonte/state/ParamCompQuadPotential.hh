@@ -0,0 +1,170 @@
+#ifndef CASM_clexmonte_state_ParamCompQuadPotential
+#define CASM_clexmonte_state_ParamCompQuadPotential
+
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/composition/CompositionCalculator.hh"
+#include "casm/composition/CompositionConverter.hh"
+#include "casm/global/eigen.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/ValueMap.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Quadratic potential in parametric composition, evaluated
+///     incrementally
+///
+/// The potential, per unit cell, is:
+///
+/// \code
+/// Eigen::VectorXd y = param_composition - target;
+/// double potential = y.dot(V * y);
+/// \endcode
+///
+/// where `V` is `param_comp_quad_pot_matrix`, or the diagonal matrix with
+/// `param_comp_quad_pot_vector` on the diagonal (see
+/// `OptionalParamCompQuadPotConditionsMixin`).
+///
+/// The change in parametric composition due to an event is summed from a
+/// per-species table, so the change in potential is O(n_sites_in_event *
+/// n_axes + n_axes^2) and does not require the occupation to be scanned.
+class ParamCompQuadPotential {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param composition_calculator Composition calculator, which defines the
+  ///     components
+  /// \param composition_converter Defines the parametric composition
+  /// \param convert Index conversions for the supercell
+  /// \param target Location of potential minimum
+  /// \param V Quadratic potential coefficients, of size n_axes x n_axes
+  ParamCompQuadPotential(
+      composition::CompositionCalculator const &composition_calculator,
+      composition::CompositionConverter const &composition_converter,
+      monte::Conversions const &convert, Eigen::VectorXd const &target,
+      Eigen::MatrixXd const &V)
+      : m_composition_converter(composition_converter),
+        m_convert(convert),
+        m_n_unitcells(convert.l_size() / composition_calculator.n_sublat()),
+        m_target(target),
+        m_V(V),
+        m_V_plus_Vt(V + V.transpose()),
+        m_d(target.size()) {
+    Index n_axes = composition_converter.independent_compositions();
+    if (m_target.size() != n_axes || m_V.rows() != n_axes ||
+        m_V.cols() != n_axes) {
+      throw std::runtime_error(
+          "Error constructing ParamCompQuadPotential: dimensions mismatch");
+    }
+
+    // Change in param_composition due to adding one of each species
+    std::vector<Index> species_to_component =
+        enforce_composition_impl::make_species_to_component_index_converter(
+            composition_calculator, convert);
+    Index n_components = composition_calculator.components().size();
+    m_dparam_per_species.resize(n_axes, species_to_component.size());
+    for (Index s = 0; s < species_to_component.size(); ++s) {
+      Eigen::VectorXd dn = Eigen::VectorXd::Zero(n_components);
+      dn(species_to_component[s]) = 1.0 / m_n_unitcells;
+      m_dparam_per_species.col(s) =
+          composition_converter.dparam_composition(dn);
+    }
+  }
+
+  /// \brief Construct if the conditions include "param_comp_quad_pot_target"
+  ///     and either "param_comp_quad_pot_vector" or
+  ///     "param_comp_quad_pot_matrix", else return std::nullopt
+  static std::optional<ParamCompQuadPotential> from_conditions(
+      monte::ValueMap const &conditions,
+      composition::CompositionCalculator const &composition_calculator,
+      composition::CompositionConverter const &composition_converter,
+      monte::Conversions const &convert) {
+    auto const &vector_values = conditions.vector_values;
+    auto const &matrix_values = conditions.matrix_values;
+    if (!vector_values.count("param_comp_quad_pot_target")) {
+      return std::nullopt;
+    }
+    Eigen::VectorXd const &target =
+        vector_values.at("param_comp_quad_pot_target");
+    if (matrix_values.count("param_comp_quad_pot_matrix")) {
+      return ParamCompQuadPotential(
+          composition_calculator, composition_converter, convert, target,
+          matrix_values.at("param_comp_quad_pot_matrix"));
+    } else if (vector_values.count("param_comp_quad_pot_vector")) {
+      Eigen::MatrixXd V =
+          vector_values.at("param_comp_quad_pot_vector").asDiagonal();
+      return ParamCompQuadPotential(composition_calculator,
+                                    composition_converter, convert, target, V);
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Calculate (per_supercell) potential value
+  ///
+  /// \param mean_num_each_component Current number of each component,
+  ///     normalized per unit cell
+  double per_supercell(Eigen::VectorXd const &mean_num_each_component) {
+    m_y = m_composition_converter.param_composition(mean_num_each_component) -
+          m_target;
+    return m_n_unitcells * m_y.dot(m_V * m_y);
+  }
+
+  /// \brief Calculate change in (per_supercell) potential value due to a
+  ///     series of occupation changes
+  ///
+  /// \param mean_num_each_component Current number of each component,
+  ///     normalized per unit cell
+  /// \param occupation Current occupation
+  /// \param linear_site_index Sites that change
+  /// \param new_occ New occupation index on each site
+  double occ_delta_per_supercell(
+      Eigen::VectorXd const &mean_num_each_component,
+      Eigen::VectorXi const &occupation,
+      std::vector<Index> const &linear_site_index,
+      std::vector<int> const &new_occ) {
+    m_d.setZero();
+    for (Index i = 0; i < linear_site_index.size(); ++i) {
+      Index l = linear_site_index[i];
+      Index asym = m_convert.l_to_asym(l);
+      Index curr_species = m_convert.species_index(asym, occupation(l));
+      Index new_species = m_convert.species_index(asym, new_occ[i]);
+      if (curr_species != new_species) {
+        m_d += m_dparam_per_species.col(new_species) -
+               m_dparam_per_species.col(curr_species);
+      }
+    }
+    if (m_d.isZero(0.0)) {
+      return 0.0;
+    }
+    m_y = m_composition_converter.param_composition(mean_num_each_component) -
+          m_target;
+
+    // (y+d)^T V (y+d) - y^T V y = d^T (V + V^T) y + d^T V d
+    return m_n_unitcells * (m_d.dot(m_V_plus_Vt * m_y) + m_d.dot(m_V * m_d));
+  }
+
+ private:
+  composition::CompositionConverter const &m_composition_converter;
+  monte::Conversions const &m_convert;
+  double m_n_unitcells;
+  Eigen::VectorXd m_target;
+  Eigen::MatrixXd m_V;
+  Eigen::MatrixXd m_V_plus_Vt;
+
+  /// Change in param_composition due to adding one of each species,
+  /// (n_axes x n_species)
+  Eigen::MatrixXd m_dparam_per_species;
+
+  /// Work space
+  Eigen::VectorXd m_y;
+  Eigen::VectorXd m_d;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
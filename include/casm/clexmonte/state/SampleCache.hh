@@ -0,0 +1,60 @@
+#ifndef CASM_clexmonte_state_SampleCache
+#define CASM_clexmonte_state_SampleCache
+
+#include <map>
+#include <string>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Intermediate values shared by sampling functions, calculated once
+///     per sample
+///
+/// Several sampling functions depend on the same intermediate value, such
+/// as "mol_composition" and "param_composition", which both depend on the
+/// mean number of each component, or "order_parameter.<key>" and
+/// "order_parameter.<key>.subspace_magnitudes", which both depend on the
+/// order parameter. Sampling functions get intermediate values by name with
+/// `get_or_make`, so each is calculated by the first sampling function that
+/// needs it, and reused by the others, until the state changes.
+///
+/// Usage:
+/// - Call `invalidate` whenever the state changes, for instance from the
+///   event application function of a run. This is O(1), and does not free
+///   the stored values.
+class SampleCache {
+ public:
+  SampleCache() : m_version(1) {}
+
+  /// \brief Mark all intermediate values out of date
+  void invalidate() { ++m_version; }
+
+  /// \brief Get an intermediate value, calculating it with `make` if it is
+  ///     out of date
+  template <typename MakeF>
+  Eigen::VectorXd const &get_or_make(std::string const &name, MakeF make) {
+    Entry &entry = m_entries[name];
+    if (entry.version != m_version) {
+      entry.value = make();
+      entry.version = m_version;
+    }
+    return entry.value;
+  }
+
+ private:
+  struct Entry {
+    Index version = 0;
+    Eigen::VectorXd value;
+  };
+
+  Index m_version;
+  std::map<std::string, Entry> m_entries;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
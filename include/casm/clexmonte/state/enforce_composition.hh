@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_state_enforce_composition
 #define CASM_clexmonte_state_enforce_composition
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "casm/composition/CompositionCalculator.hh"
@@ -51,25 +53,42 @@ Validator validate_composition_consistency(
 
 namespace enforce_composition_impl {
 
+/// \brief Find the semi-grand canonical swap type which brings the
+///     composition closest to the target composition
+///
+/// \param num_each_component Current number of each component in the
+///     supercell
+/// \param target_mol_composition Target number of each component per unit
+///     cell
+/// \param volume Number of unit cells in the supercell
+///
+/// Distances are in units of mol composition (number per unit cell), and
+/// swaps within `1e-3 / volume` of the best distance are tied, as when the
+/// composition was recalculated from the occupation. The distance to the
+/// target after a swap is evaluated from the current distance and the two
+/// components that change, so the cost is O(1) per swap type and does not
+/// depend on the supercell size.
+///
+/// \returns Iterator to the chosen swap type, or `end` if no swap type
+///     improves the composition
 template <typename GeneratorType>
 std::vector<monte::OccSwap>::const_iterator find_semigrand_canonical_swap(
-    Eigen::VectorXi &occupation, Eigen::VectorXd const &target_mol_composition,
-    composition::CompositionCalculator const &composition_calculator,
+    Eigen::VectorXl const &num_each_component,
+    Eigen::VectorXd const &target_mol_composition, double volume,
     std::vector<Index> const &species_to_component_index_converter,
     GeneratorType &random_number_generator,
     monte::OccLocation const &occ_location,
     std::vector<monte::OccSwap>::const_iterator begin,
     std::vector<monte::OccSwap>::const_iterator end) {
-  Eigen::VectorXd current_mol_composition =
-      composition_calculator.mean_num_each_component(occupation);
+  double dn = 1. / volume;
+  Eigen::VectorXd diff =
+      num_each_component.cast<double>() * dn - target_mol_composition;
   auto const &index_converter = species_to_component_index_converter;
 
-  double original_dist =
-      (current_mol_composition - target_mol_composition).norm();
+  double original_dist_sq = diff.squaredNorm();
+  double original_dist = std::sqrt(original_dist_sq);
   double best_dist = original_dist;
 
-  double volume = occupation.size() / composition_calculator.n_sublat();
-  double dn = 1. / volume;
   double tol = dn * 1e-3;
 
   // store <distance_to_target_mol_composition>:{swap_iterator, number of
@@ -81,10 +100,17 @@ std::vector<monte::OccSwap>::const_iterator find_semigrand_canonical_swap(
   // check each possible swap for how close the composition is afterwards
   for (auto it = begin; it != end; ++it) {
     if (occ_location.cand_size(it->cand_a)) {
-      Eigen::VectorXd tmol_composition = current_mol_composition;
-      tmol_composition[index_converter[it->cand_a.species_index]] -= dn;
-      tmol_composition[index_converter[it->cand_b.species_index]] += dn;
-      double dist = (tmol_composition - target_mol_composition).norm();
+      // |diff - dn e_a + dn e_b|^2
+      //     = |diff|^2 - 2 dn (diff_a - diff_b) + 2 dn^2, if a != b
+      Index a = index_converter[it->cand_a.species_index];
+      Index b = index_converter[it->cand_b.species_index];
+      double dist = original_dist;
+      if (a != b) {
+        dist = std::sqrt(
+            std::max(original_dist_sq - 2.0 * dn * (diff(a) - diff(b)) +
+                         2.0 * dn * dn,
+                     0.0));
+      }
 
       // if no clear improvement, skip
       if (dist > original_dist - tol) {
@@ -179,12 +205,20 @@ void enforce_composition(
       enforce_composition_impl::make_species_to_component_index_converter(
           composition_calculator, convert);
 
+  // count each component once, then update the counts as swaps are applied
+  double volume = occupation.size() / composition_calculator.n_sublat();
+  Eigen::VectorXl num_each_component =
+      (composition_calculator.mean_num_each_component(occupation) * volume)
+          .array()
+          .round()
+          .cast<long>();
+
   auto begin = semigrand_canonical_swaps.begin();
   auto end = semigrand_canonical_swaps.end();
   monte::OccEvent event;
   while (true) {
     auto it = enforce_composition_impl::find_semigrand_canonical_swap(
-        occupation, target_mol_composition, composition_calculator,
+        num_each_component, target_mol_composition, volume,
         species_to_component_index_converter, random_number_generator,
         occ_location, begin, end);
 
@@ -196,6 +230,10 @@ void enforce_composition(
     monte::propose_semigrand_canonical_event_from_swap(event, occ_location, *it,
                                                        random_number_generator);
     occ_location.apply(event, occupation);
+    num_each_component(
+        species_to_component_index_converter[it->cand_a.species_index]) -= 1;
+    num_each_component(
+        species_to_component_index_converter[it->cand_b.species_index]) += 1;
   }
 }
 
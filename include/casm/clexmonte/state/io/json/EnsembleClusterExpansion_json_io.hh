@@ -0,0 +1,23 @@
+#ifndef CASM_clexmonte_state_EnsembleClusterExpansion_json_io
+#define CASM_clexmonte_state_EnsembleClusterExpansion_json_io
+
+#include <optional>
+
+#include "casm/casm_io/json/InputParser_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+class System;
+struct EnsembleClusterExpansionParams;
+
+/// \brief Parse the optional "ensemble_formation_energy" calculation
+///     parameter
+void parse_ensemble_formation_energy(
+    ParentInputParser &parser, System const &system,
+    std::optional<EnsembleClusterExpansionParams> &ensemble_params);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
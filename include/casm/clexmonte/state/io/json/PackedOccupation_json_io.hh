@@ -0,0 +1,55 @@
+#ifndef CASM_clexmonte_state_PackedOccupation_json_io
+#define CASM_clexmonte_state_PackedOccupation_json_io
+
+#include <string>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+
+class jsonParser;
+
+namespace clexmonte {
+
+class CompactOccupation;
+
+/// \brief Encode occupation indices compactly, as text
+std::string pack_occupation(Eigen::VectorXi const &occupation,
+                            int &bits_per_value);
+
+/// \brief Encode a compact occupation as text
+std::string pack_occupation(CompactOccupation const &occupation);
+
+/// \brief Decode occupation indices encoded by `pack_occupation`
+Eigen::VectorXi unpack_occupation(std::string const &data, Index size,
+                                  int bits_per_value);
+
+/// \brief Decode occupation indices encoded by `pack_occupation`, as a
+///     compact occupation
+CompactOccupation unpack_compact_occupation(std::string const &data,
+                                            Index size, int bits_per_value);
+
+/// \brief Write occupation indices to a binary file
+void write_occupation_file(std::string const &path,
+                           Eigen::VectorXi const &occupation);
+
+/// \brief Read occupation indices from a binary file
+Eigen::VectorXi read_occupation_file(std::string const &path);
+
+/// \brief Read occupation indices given in JSON as a packed occupation or
+///     an occupation file, without an element-by-element array
+Eigen::VectorXi read_occupation_json(jsonParser const &json);
+
+/// \brief Replace the occupation of a state or configuration, in JSON, with
+///     its packed encoding
+void pack_occupation_json(jsonParser &json);
+
+/// \brief Replace a packed occupation, in the JSON for a state or
+///     configuration, with the standard occupation array
+bool unpack_occupation_json(jsonParser &json);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
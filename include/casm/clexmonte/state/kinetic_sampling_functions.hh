@@ -30,6 +30,8 @@ namespace clexmonte {
 //   StateType const &, std::string const &key)`
 //   exists for template type `SystemType` (i.e. when
 //   SystemType=clexmonte::System).
+// - that `CalculationType` has a member `KMCDisplacementCache
+//   displacement_cache`, shared by the displacement sampling functions
 // ---
 
 /// \brief Make center of mass isotropic squared displacement sampling function
@@ -69,6 +71,18 @@ template <typename CalculationType>
 state_sampling_function_type make_L_anisotropic_f(
     std::shared_ptr<CalculationType> const &calculation);
 
+/// \brief Make rate-weighted isotropic Onsager kinetic coefficient sampling
+///     function ("L_isotropic_rate_weighted")
+template <typename CalculationType>
+state_sampling_function_type make_L_isotropic_rate_weighted_f(
+    std::shared_ptr<CalculationType> const &calculation);
+
+/// \brief Make rate-weighted anisotropic Onsager kinetic coefficient
+///     sampling function ("L_anisotropic_rate_weighted")
+template <typename CalculationType>
+state_sampling_function_type make_L_anisotropic_rate_weighted_f(
+    std::shared_ptr<CalculationType> const &calculation);
+
 /// \brief Make isotropic tracer diffusion coefficient sampling function
 ///     ("D_tracer_isotropic")
 template <typename CalculationType>
@@ -97,6 +111,12 @@ template <typename CalculationType>
 state_sampling_function_type make_jumps_per_atom_per_event_by_type_f(
     std::shared_ptr<CalculationType> const &calculation);
 
+/// \brief Make total event rate by event type sampling function
+///     ("total_rate_by_event_type")
+template <typename CalculationType>
+state_sampling_function_type make_total_rate_by_event_type_f(
+    std::shared_ptr<CalculationType> const &calculation);
+
 // --- Inline definitions ---
 
 /// \brief Make center of mass isotropic squared displacement sampling function
@@ -110,6 +130,8 @@ state_sampling_function_type make_mean_R_squared_collective_isotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<CollectiveIsotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_isotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -118,20 +140,13 @@ state_sampling_function_type make_mean_R_squared_collective_isotropic_f(
       "mean_R_squared_collective_isotropic",
       R"(Samples \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i} \right) \dot \left(\sum_\zeta \Delta R^\zeta_{j} \right))",
       component_names,  // component names
-      shape, [calculation]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
+      shape, [calculation, layout]() {
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        Eigen::VectorXd result = mean_R_squared_collective_isotropic(
-            name_list, name_index_list, delta_R);
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+
+        Eigen::VectorXd result;
+        layout.mean_R_squared(sums, result);
         return result;
       });
 }
@@ -148,6 +163,8 @@ state_sampling_function_type make_mean_R_squared_collective_anisotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<CollectiveAnisotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_anisotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -156,20 +173,14 @@ state_sampling_function_type make_mean_R_squared_collective_anisotropic_f(
       "mean_R_squared_collective_anisotropic",
       R"(Samples \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i,\alpha} \right) \left(\sum_\zeta \Delta R^\zeta_{j,\beta} \right))",
       component_names,  // component names
-      shape, [calculation]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
+      shape, [calculation, layout]() {
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        return mean_R_squared_collective_anisotropic(name_list, name_index_list,
-                                                     delta_R);
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        return mean_R_squared;
       });
 }
 
@@ -184,6 +195,8 @@ state_sampling_function_type make_mean_R_squared_individual_isotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<IndividualIsotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::individual_isotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -192,20 +205,14 @@ state_sampling_function_type make_mean_R_squared_individual_isotropic_f(
       "mean_R_squared_individual_isotropic",
       R"(Samples \frac{1}{N_i} \sum_\zeta \left(\Delta R^\zeta_{i} \dot \Delta R^\zeta_{i}\right))",
       component_names,  // component names
-      shape, [calculation]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
+      shape, [calculation, layout]() {
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        return mean_R_squared_individual_isotropic(name_list, name_index_list,
-                                                   delta_R);
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        return mean_R_squared;
       });
 }
 
@@ -220,6 +227,8 @@ state_sampling_function_type make_mean_R_squared_individual_anisotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<IndividualAnisotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::individual_anisotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -228,20 +237,14 @@ state_sampling_function_type make_mean_R_squared_individual_anisotropic_f(
       "mean_R_squared_individual_anisotropic",  // individual
       R"(Samples \frac{1}{N_i} \sum_\zeta \left(\Delta R^\zeta_{i,\alpha} \Delta R^\zeta_{i,\beta}\right))",
       component_names,  // component names
-      shape, [calculation]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
+      shape, [calculation, layout]() {
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        return mean_R_squared_individual_anisotropic(name_list, name_index_list,
-                                                     delta_R);
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        return mean_R_squared;
       });
 }
 
@@ -256,6 +259,8 @@ state_sampling_function_type make_L_isotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<CollectiveIsotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_isotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -264,30 +269,21 @@ state_sampling_function_type make_L_isotropic_f(
       "L_isotropic",
       R"(Samples \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i} \right) \dot \left(\sum_\zeta \Delta R^\zeta_{j} \right) / (2 d \Delta t))",
       component_names,  // component names
-      shape, [calculation]() {
+      shape, [calculation, layout]() {
         auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        auto const &time_curr = kmc_data.time;
-        auto const &time_prev =
-            kmc_data.prev_time.at(kmc_data.sampling_fixture_label);
-        double delta_time = time_curr - time_prev;
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+        double delta_time =
+            calculation->displacement_cache.delta_time(kmc_data);
 
         double dim = system.n_dimensions;
         double normalization = (2.0 * dim * delta_time);
 
-        Eigen::VectorXd mean_R_squared = mean_R_squared_collective_isotropic(
-            name_list, name_index_list, delta_R);
-        Eigen::VectorXd L_anisotropic = mean_R_squared / normalization;
-        return L_anisotropic;
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        mean_R_squared /= normalization;
+        return mean_R_squared;
       });
 }
 
@@ -302,6 +298,8 @@ state_sampling_function_type make_L_anisotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<CollectiveAnisotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_anisotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -310,29 +308,136 @@ state_sampling_function_type make_L_anisotropic_f(
       "L_anisotropic",
       R"(Samples \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i} \right) \dot \left(\sum_\zeta \Delta R^\zeta_{j} \right) / (2 \Delta t))",
       component_names,  // component names
-      shape, [calculation]() {
+      shape, [calculation, layout]() {
+        auto const &kmc_data = calculation->kmc_data;
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+        double delta_time =
+            calculation->displacement_cache.delta_time(kmc_data);
+
+        double normalization = (2.0 * delta_time);
+
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        mean_R_squared /= normalization;
+        return mean_R_squared;
+      });
+}
+
+/// \brief Make rate-weighted isotropic Onsager kinetic coefficient sampling
+///     function ("L_isotropic_rate_weighted")
+///
+/// Estimates the same quantity as "L_isotropic", but replaces the sampled
+/// displacement and residence time of each step with their expected values
+/// given the current event rates (see `KMCRateWeightedDiffusionSums`), which
+/// reduces the variance of the estimate.
+///
+/// Requires that `CalculationType` has members
+/// `KMCRateWeightedDiffusionSums rate_weighted_diffusion_sums` and
+/// `std::shared_ptr<EventRateTotals const> event_rate_totals`, which is null
+/// if the totals are not maintained by the current event selector.
+template <typename CalculationType>
+state_sampling_function_type make_L_isotropic_rate_weighted_f(
+    std::shared_ptr<CalculationType> const &calculation) {
+  // Construct component_names && shape
+  auto const &system = *calculation->system;
+  auto event_system = get_event_system(system);
+  auto const &name_list = event_system->atom_name_list;
+  std::vector<std::string> component_names =
+      make_component_names<CollectiveIsotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_isotropic, name_list);
+
+  std::vector<Index> shape;
+  shape.push_back(component_names.size());
+
+  using Snapshot = KMCRateWeightedDiffusionSums::Snapshot;
+  std::shared_ptr<Snapshot> prev = std::make_shared<Snapshot>();
+
+  return state_sampling_function_type(
+      "L_isotropic_rate_weighted",
+      R"(Samples a rate-weighted estimate of \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i} \right) \dot \left(\sum_\zeta \Delta R^\zeta_{j} \right) / (2 d \Delta t))",
+      component_names,  // component names
+      shape, [calculation, layout, prev]() {
+        if (!calculation->event_rate_totals) {
+          throw std::runtime_error(
+              "Error sampling \"L_isotropic_rate_weighted\": event rate "
+              "totals are not maintained by the current event selector");
+        }
         auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
+        auto const &sums = calculation->rate_weighted_diffusion_sums;
 
-        auto const &name_list = event_system->atom_name_list;
-        auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
+        // reset stored data if necessary
+        if (prev->n_steps > sums.sums().n_steps) {
+          *prev = Snapshot();
+        }
 
-        auto const &time_curr = kmc_data.time;
-        auto const &time_prev =
-            kmc_data.prev_time.at(kmc_data.sampling_fixture_label);
-        double delta_time = time_curr - time_prev;
+        Eigen::MatrixXd E;
+        double delta_time = sums.second_moment(*prev, E);
+
+        double dim = system.n_dimensions;
+        double normalization = (2.0 * dim * delta_time);
+
+        Eigen::VectorXd mean_R_squared;
+        layout.collective_mean_R_squared(E, sums.n_atoms(), mean_R_squared);
+        mean_R_squared /= normalization;
+
+        *prev = sums.sums();
+        return mean_R_squared;
+      });
+}
+
+/// \brief Make rate-weighted anisotropic Onsager kinetic coefficient
+///     sampling function ("L_anisotropic_rate_weighted")
+///
+/// Estimates the same quantity as "L_anisotropic", with the requirements
+/// of `make_L_isotropic_rate_weighted_f`.
+template <typename CalculationType>
+state_sampling_function_type make_L_anisotropic_rate_weighted_f(
+    std::shared_ptr<CalculationType> const &calculation) {
+  // Construct component_names && shape
+  auto const &system = *calculation->system;
+  auto event_system = get_event_system(system);
+  auto const &name_list = event_system->atom_name_list;
+  std::vector<std::string> component_names =
+      make_component_names<CollectiveAnisotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_anisotropic, name_list);
+
+  std::vector<Index> shape;
+  shape.push_back(component_names.size());
+
+  using Snapshot = KMCRateWeightedDiffusionSums::Snapshot;
+  std::shared_ptr<Snapshot> prev = std::make_shared<Snapshot>();
+
+  return state_sampling_function_type(
+      "L_anisotropic_rate_weighted",
+      R"(Samples a rate-weighted estimate of \frac{1}{N} \left(\sum_\zeta \Delta R^\zeta_{i} \right) \dot \left(\sum_\zeta \Delta R^\zeta_{j} \right) / (2 \Delta t))",
+      component_names,  // component names
+      shape, [calculation, layout, prev]() {
+        if (!calculation->event_rate_totals) {
+          throw std::runtime_error(
+              "Error sampling \"L_anisotropic_rate_weighted\": event rate "
+              "totals are not maintained by the current event selector");
+        }
+        auto const &sums = calculation->rate_weighted_diffusion_sums;
+
+        // reset stored data if necessary
+        if (prev->n_steps > sums.sums().n_steps) {
+          *prev = Snapshot();
+        }
+
+        Eigen::MatrixXd E;
+        double delta_time = sums.second_moment(*prev, E);
 
         double normalization = (2.0 * delta_time);
 
-        Eigen::VectorXd mean_R_squared = mean_R_squared_collective_anisotropic(
-            name_list, name_index_list, delta_R);
-        Eigen::VectorXd L_anisotropic = mean_R_squared / normalization;
-        return L_anisotropic;
+        Eigen::VectorXd mean_R_squared;
+        layout.collective_mean_R_squared(E, sums.n_atoms(), mean_R_squared);
+        mean_R_squared /= normalization;
+
+        *prev = sums.sums();
+        return mean_R_squared;
       });
 }
 
@@ -347,6 +452,8 @@ state_sampling_function_type make_D_tracer_isotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<IndividualIsotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::individual_isotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -355,30 +462,21 @@ state_sampling_function_type make_D_tracer_isotropic_f(
       "D_tracer_isotropic",
       R"(Samples \frac{1}{N_i} \sum_\zeta \left(\Delta R^\zeta_{i} \dot \Delta R^\zeta_{i}\right) / (2 d \Delta t))",
       component_names,  // component names
-      shape, [calculation]() {
+      shape, [calculation, layout]() {
         auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        auto const &time_curr = kmc_data.time;
-        auto const &time_prev =
-            kmc_data.prev_time.at(kmc_data.sampling_fixture_label);
-        double delta_time = time_curr - time_prev;
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+        double delta_time =
+            calculation->displacement_cache.delta_time(kmc_data);
 
         double dim = system.n_dimensions;
         double normalization = (2.0 * dim * delta_time);
 
-        Eigen::VectorXd mean_R_squared = mean_R_squared_individual_isotropic(
-            name_list, name_index_list, delta_R);
-        Eigen::VectorXd D_tracer_isotropic = mean_R_squared / normalization;
-        return D_tracer_isotropic;
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        mean_R_squared /= normalization;
+        return mean_R_squared;
       });
 }
 
@@ -393,6 +491,8 @@ state_sampling_function_type make_D_tracer_anisotropic_f(
   auto const &name_list = event_system->atom_name_list;
   std::vector<std::string> component_names =
       make_component_names<IndividualAnisotropicCounter>(name_list);
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::individual_anisotropic, name_list);
 
   std::vector<Index> shape;
   shape.push_back(component_names.size());
@@ -401,29 +501,19 @@ state_sampling_function_type make_D_tracer_anisotropic_f(
       "D_tracer_anisotropic",
       R"(Samples \frac{1}{N_i} \sum_\zeta \left(\Delta R^\zeta_{i} \dot \Delta R^\zeta_{i}\right) / (2 \Delta t))",
       component_names,  // component names
-      shape, [calculation]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
+      shape, [calculation, layout]() {
         auto const &kmc_data = calculation->kmc_data;
-        auto const &name_index_list = kmc_data.atom_name_index_list;
-        auto const &R_curr = kmc_data.atom_positions_cart;
-        auto const &R_prev = kmc_data.prev_atom_positions_cart.at(
-            kmc_data.sampling_fixture_label);
-        Eigen::MatrixXd delta_R = R_curr - R_prev;
-
-        auto const &time_curr = kmc_data.time;
-        auto const &time_prev =
-            kmc_data.prev_time.at(kmc_data.sampling_fixture_label);
-        double delta_time = time_curr - time_prev;
+        DiffusionSums const &sums =
+            calculation->displacement_cache.diffusion_sums(kmc_data, layout);
+        double delta_time =
+            calculation->displacement_cache.delta_time(kmc_data);
 
         double normalization = (2.0 * delta_time);
 
-        Eigen::VectorXd mean_R_squared = mean_R_squared_individual_anisotropic(
-            name_list, name_index_list, delta_R);
-        Eigen::VectorXd D_tracer_anisotropic = mean_R_squared / normalization;
-        return D_tracer_anisotropic;
+        Eigen::VectorXd mean_R_squared;
+        layout.mean_R_squared(sums, mean_R_squared);
+        mean_R_squared /= normalization;
+        return mean_R_squared;
       });
 }
 
@@ -443,19 +533,15 @@ state_sampling_function_type make_jumps_per_atom_by_type_f(
   std::shared_ptr<Eigen::VectorXd> prev_sum_n_jumps =
       std::make_shared<Eigen::VectorXd>(
           Eigen::VectorXd::Zero(component_names.size()));
+  std::shared_ptr<Eigen::VectorXd> value =
+      std::make_shared<Eigen::VectorXd>(component_names.size());
 
   return state_sampling_function_type(
       "jumps_per_atom_by_type",  // individual
       R"(Mean number of jumps per atom for each atom type over the last sampling period)",
       component_names,  // component names
-      shape, [calculation, prev_n_events, prev_sum_n_jumps]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
-        auto const &name_index_list =
-            calculation->kmc_data.atom_name_index_list;
-        auto const &n_jumps = calculation->occ_location->current_atom_n_jumps();
+      shape, [calculation, prev_n_events, prev_sum_n_jumps, value]() {
+        auto const &jump_counter = calculation->jump_counter;
 
         auto const &sampling_fixture = *calculation->kmc_data.sampling_fixture;
         auto const &counter = sampling_fixture.counter();
@@ -466,29 +552,22 @@ state_sampling_function_type make_jumps_per_atom_by_type_f(
 
         // reset stored data if necessary
         if (*prev_n_events > n_events) {
-          *prev_sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
+          prev_sum_n_jumps->setZero();
           *prev_n_events = 0;
         }
 
-        Eigen::VectorXd n_atoms = Eigen::VectorXd::Zero(name_list.size());
-        Eigen::VectorXd sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
-        for (Index i = 0; i < n_jumps.size(); ++i) {
-          n_atoms(name_index_list[i]) += 1.0;
-          sum_n_jumps(name_index_list[i]) += n_jumps[i];
-        }
-        Eigen::VectorXd delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
+        Eigen::VectorXd const &n_atoms = jump_counter.n_atoms();
+        Eigen::VectorXd const &sum_n_jumps = jump_counter.sum_n_jumps();
+        Eigen::VectorXd &delta_n_jumps = *value;
+        delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
 
         // jumps_per_atom_by_type = delta_n_jumps(i) / n_atoms(i);
-        Eigen::VectorXd jumps_per_atom_by_type =
-            Eigen::VectorXd::Zero(name_list.size());
-        for (Index i = 0; i < name_list.size(); ++i) {
-          jumps_per_atom_by_type(i) = delta_n_jumps(i) / n_atoms(i);
-        }
+        delta_n_jumps.array() /= n_atoms.array();
 
         *prev_sum_n_jumps = sum_n_jumps;
         *prev_n_events = n_events;
 
-        return jumps_per_atom_by_type;
+        return delta_n_jumps;
       });
 }
 
@@ -508,19 +587,15 @@ state_sampling_function_type make_jumps_per_event_by_type_f(
   std::shared_ptr<Eigen::VectorXd> prev_sum_n_jumps =
       std::make_shared<Eigen::VectorXd>(
           Eigen::VectorXd::Zero(component_names.size()));
+  std::shared_ptr<Eigen::VectorXd> value =
+      std::make_shared<Eigen::VectorXd>(component_names.size());
 
   return state_sampling_function_type(
       "jumps_per_event_by_type",  // individual
       R"(Mean number of jumps per event for each atom type over the last sampling period)",
       component_names,  // component names
-      shape, [calculation, prev_n_events, prev_sum_n_jumps]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
-        auto const &name_index_list =
-            calculation->kmc_data.atom_name_index_list;
-        auto const &n_jumps = calculation->occ_location->current_atom_n_jumps();
+      shape, [calculation, prev_n_events, prev_sum_n_jumps, value]() {
+        auto const &jump_counter = calculation->jump_counter;
 
         auto const &sampling_fixture = *calculation->kmc_data.sampling_fixture;
         auto const &counter = sampling_fixture.counter();
@@ -531,27 +606,23 @@ state_sampling_function_type make_jumps_per_event_by_type_f(
 
         // reset stored data if necessary
         if (*prev_n_events > n_events) {
-          *prev_sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
+          prev_sum_n_jumps->setZero();
           *prev_n_events = 0;
         }
         double delta_n_events = n_events - *prev_n_events;
 
-        Eigen::VectorXd n_atoms = Eigen::VectorXd::Zero(name_list.size());
-        Eigen::VectorXd sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
-        for (Index i = 0; i < n_jumps.size(); ++i) {
-          n_atoms(name_index_list[i]) += 1.0;
-          sum_n_jumps(name_index_list[i]) += n_jumps[i];
-        }
-        Eigen::VectorXd delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
+        Eigen::VectorXd const &n_atoms = jump_counter.n_atoms();
+        Eigen::VectorXd const &sum_n_jumps = jump_counter.sum_n_jumps();
+        Eigen::VectorXd &delta_n_jumps = *value;
+        delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
 
         // jumps_per_event_by_type = delta_n_jumps(i) / delta_n_events;
-        Eigen::VectorXd jumps_per_event_by_type =
-            delta_n_jumps / delta_n_events;
+        delta_n_jumps /= delta_n_events;
 
         *prev_sum_n_jumps = sum_n_jumps;
         *prev_n_events = n_events;
 
-        return jumps_per_event_by_type;
+        return delta_n_jumps;
       });
 }
 
@@ -572,19 +643,15 @@ state_sampling_function_type make_jumps_per_atom_per_event_by_type_f(
   std::shared_ptr<Eigen::VectorXd> prev_sum_n_jumps =
       std::make_shared<Eigen::VectorXd>(
           Eigen::VectorXd::Zero(component_names.size()));
+  std::shared_ptr<Eigen::VectorXd> value =
+      std::make_shared<Eigen::VectorXd>(component_names.size());
 
   return state_sampling_function_type(
       "jumps_per_atom_per_event_by_type",  // individual
       R"(Mean number of jumps per event for each atom type over the last sampling period)",
       component_names,  // component names
-      shape, [calculation, prev_n_events, prev_sum_n_jumps]() {
-        auto const &system = *calculation->system;
-        auto event_system = get_event_system(system);
-
-        auto const &name_list = event_system->atom_name_list;
-        auto const &name_index_list =
-            calculation->kmc_data.atom_name_index_list;
-        auto const &n_jumps = calculation->occ_location->current_atom_n_jumps();
+      shape, [calculation, prev_n_events, prev_sum_n_jumps, value]() {
+        auto const &jump_counter = calculation->jump_counter;
 
         auto const &sampling_fixture = *calculation->kmc_data.sampling_fixture;
         auto const &counter = sampling_fixture.counter();
@@ -595,32 +662,70 @@ state_sampling_function_type make_jumps_per_atom_per_event_by_type_f(
 
         // reset stored data if necessary
         if (*prev_n_events > n_events) {
-          *prev_sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
+          prev_sum_n_jumps->setZero();
           *prev_n_events = 0;
         }
         double delta_n_events = n_events - *prev_n_events;
 
-        Eigen::VectorXd n_atoms = Eigen::VectorXd::Zero(name_list.size());
-        Eigen::VectorXd sum_n_jumps = Eigen::VectorXd::Zero(name_list.size());
-        for (Index i = 0; i < n_jumps.size(); ++i) {
-          n_atoms(name_index_list[i]) += 1.0;
-          sum_n_jumps(name_index_list[i]) += n_jumps[i];
-        }
-        Eigen::VectorXd delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
+        Eigen::VectorXd const &n_atoms = jump_counter.n_atoms();
+        Eigen::VectorXd const &sum_n_jumps = jump_counter.sum_n_jumps();
+        Eigen::VectorXd &delta_n_jumps = *value;
+        delta_n_jumps = sum_n_jumps - *prev_sum_n_jumps;
 
         // jumps_per_atom_per_event_by_type = delta_n_jumps(i) / n_atoms(i) /
         // delta_n_events;
-        Eigen::VectorXd jumps_per_atom_per_event_by_type =
-            Eigen::VectorXd::Zero(name_list.size());
-        for (Index i = 0; i < name_list.size(); ++i) {
-          jumps_per_atom_per_event_by_type(i) =
-              delta_n_jumps(i) / n_atoms(i) / delta_n_events;
-        }
+        delta_n_jumps.array() /= n_atoms.array() * delta_n_events;
 
         *prev_sum_n_jumps = sum_n_jumps;
         *prev_n_events = n_events;
 
-        return jumps_per_atom_per_event_by_type;
+        return delta_n_jumps;
+      });
+}
+
+/// \brief Make total event rate by event type sampling function
+///     ("total_rate_by_event_type")
+///
+/// Requires that `CalculationType` has a member
+/// `std::shared_ptr<EventRateTotals const> event_rate_totals`, which is null
+/// if the totals are not maintained by the current event selector, and a
+/// member `event_data->prim_event_list`.
+template <typename CalculationType>
+state_sampling_function_type make_total_rate_by_event_type_f(
+    std::shared_ptr<CalculationType> const &calculation) {
+  // Construct component_names && shape
+  auto const &system = *calculation->system;
+  std::vector<std::string> component_names;
+  for (auto const &pair : get_event_type_data(system)) {
+    component_names.push_back(pair.first);
+  }
+
+  std::vector<Index> shape;
+  shape.push_back(component_names.size());
+
+  return state_sampling_function_type(
+      "total_rate_by_event_type",  // individual
+      R"(Total rate of events of each type, as currently stored by the event selector)",
+      component_names,  // component names
+      shape, [calculation, component_names]() {
+        auto const &event_rate_totals = calculation->event_rate_totals;
+        if (!event_rate_totals) {
+          throw std::runtime_error(
+              "Error sampling \"total_rate_by_event_type\": event rate "
+              "totals are not maintained by the current event selector");
+        }
+        auto const &prim_event_list = calculation->event_data->prim_event_list;
+        std::vector<double> const &prim_event_total_rate =
+            event_rate_totals->prim_event_total_rate();
+        Eigen::VectorXd value = Eigen::VectorXd::Zero(component_names.size());
+        for (Index p = 0; p < prim_event_list.size(); ++p) {
+          auto it = std::lower_bound(component_names.begin(),
+                                     component_names.end(),
+                                     prim_event_list[p].event_type_name);
+          value(std::distance(component_names.begin(), it)) +=
+              prim_event_total_rate[p];
+        }
+        return value;
       });
 }
 
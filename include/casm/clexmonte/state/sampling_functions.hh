@@ -1,9 +1,14 @@
 #ifndef CASM_clexmonte_state_sampling_functions
 #define CASM_clexmonte_state_sampling_functions
 
+#include <functional>
+#include <limits>
+
 #include "casm/clexmonte/misc/eigen.hh"
 #include "casm/clexmonte/misc/to_json.hh"
+#include "casm/clexmonte/run/MappedTrajectoryWriter.hh"
 #include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/ConfigurationSnapshot.hh"
 #include "casm/clexulator/Clexulator.hh"
 #include "casm/clexulator/ClusterExpansion.hh"
 #include "casm/clexulator/Correlations.hh"
@@ -92,6 +97,19 @@ template <typename CalculationType>
 json_state_sampling_function_type make_config_f(
     std::shared_ptr<CalculationType> const &calculation);
 
+/// \brief Make trajectory frame sampling function ("trajectory_frame")
+template <typename CalculationType>
+state_sampling_function_type make_trajectory_frame_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<MappedTrajectoryWriter> writer,
+    std::function<double()> time_f = nullptr);
+
+/// \brief Make configuration snapshot sampling function ("config_snapshot")
+template <typename CalculationType>
+state_sampling_function_type make_config_snapshot_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<ConfigurationSnapshotter> snapshotter);
+
 // --- Inline definitions ---
 
 /// \brief Make temperature sampling function ("temperature")
@@ -395,6 +413,69 @@ json_state_sampling_function_type make_config_f(
       });
 }
 
+/// \brief Make trajectory frame sampling function ("trajectory_frame")
+///
+/// Each time it is sampled, the current occupation is written to `writer` as
+/// a new frame, and the frame index is returned. This streams the trajectory
+/// to disk, rather than holding sampled configurations in memory as
+/// `do_sample_trajectory` does.
+///
+/// \param calculation The calculation
+/// \param writer Trajectory writer, which must be opened for each run before
+///     sampling (i.e. with a distinct file per run)
+/// \param time_f Optional function returning the simulated time to record
+///     with each frame. If null, NaN is recorded.
+template <typename CalculationType>
+state_sampling_function_type make_trajectory_frame_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<MappedTrajectoryWriter> writer,
+    std::function<double()> time_f) {
+  if (!writer) {
+    throw std::runtime_error(
+        "Error in make_trajectory_frame_f: writer is null");
+  }
+  return state_sampling_function_type(
+      "trajectory_frame",
+      "Index of the frame written to the memory-mapped trajectory file",
+      {},  // scalar
+      [calculation, writer, time_f]() {
+        double time =
+            time_f ? time_f() : std::numeric_limits<double>::quiet_NaN();
+        Index frame = writer->write(get_occupation(*calculation->state),
+                                    writer->n_frames(), time);
+        return monte::reshaped(double(frame));
+      });
+}
+
+/// \brief Make configuration snapshot sampling function ("config_snapshot")
+///
+/// Each time it is sampled, a snapshot of the current configuration is kept
+/// by `snapshotter`, and the snapshot index is returned. Snapshots share
+/// unchanged blocks with the previous snapshot (see
+/// `ConfigurationSnapshotter`), so sampling configurations frequently is much
+/// cheaper, in time and memory, than the "config" JSON sampling function.
+/// Use `snapshotter->snapshots()[i]->configuration()` to obtain a sampled
+/// configuration.
+///
+/// \param calculation The calculation
+/// \param snapshotter Keeps the snapshots; it should be reset before each run
+template <typename CalculationType>
+state_sampling_function_type make_config_snapshot_f(
+    std::shared_ptr<CalculationType> const &calculation,
+    std::shared_ptr<ConfigurationSnapshotter> snapshotter) {
+  if (!snapshotter) {
+    throw std::runtime_error(
+        "Error in make_config_snapshot_f: snapshotter is null");
+  }
+  return state_sampling_function_type(
+      "config_snapshot", "Index of the kept configuration snapshot",
+      {},  // scalar
+      [calculation, snapshotter]() {
+        Index index = snapshotter->record(calculation->state->configuration);
+        return monte::reshaped(double(index));
+      });
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -0,0 +1,100 @@
+#ifndef CASM_clexmonte_system_ClexulatorCache
+#define CASM_clexmonte_system_ClexulatorCache
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief An exclusive advisory lock on a file, held while in scope
+///
+/// Used to serialize populating a cache entry between processes. The lock
+/// file is created if it does not exist, and is not removed.
+class FileLock {
+ public:
+  explicit FileLock(fs::path _path);
+  ~FileLock();
+
+  FileLock(FileLock const &) = delete;
+  FileLock &operator=(FileLock const &) = delete;
+
+ private:
+  fs::path m_path;
+  int m_fd;
+};
+
+/// \brief A locked entry of a content-addressed, on-disk cache of copies
+///     of source directories
+struct SourceDirCacheEntry {
+  /// \brief Path to the entry directory, which holds a copy of the source
+  ///     directory
+  fs::path dir;
+
+  /// \brief The entry lock, which should be held until the source is
+  ///     compiled and loaded
+  std::unique_ptr<FileLock> lock;
+};
+
+/// \brief Lock, and populate if necessary, the cache entry for a source
+///     directory
+SourceDirCacheEntry acquire_source_dir_cache_entry(
+    fs::path const &cache_dir, fs::path const &source_dir,
+    std::vector<std::string> const &key_data);
+
+/// \brief A content-addressed, on-disk cache of compiled clexulators
+///
+/// Each entry is a copy of the directory containing a clexulator source
+/// file, i.e. "basis_sets/bset.<name>", in which the clexulator is compiled
+/// once and reused by later jobs:
+///
+///     <cache_dir>/
+///       <key>/
+///         <copy of the source directory, and compiled clexulator files>
+///       <key>.lock
+///
+/// The key is a hash of the contents of the source directory (except
+/// compiled files), the basis set input, and the compiler environment
+/// variables (CASM_CXX, CASM_CXXFLAGS, CASM_SOFLAGS, CASM_PREFIX,
+/// CASM_INCLUDEDIR, CASM_LIBDIR), so a change to any of them makes a new
+/// entry.
+///
+/// Concurrent jobs sharing one cache directory, including jobs on different
+/// nodes of a file system that supports `flock`, take the entry's lock
+/// while it is populated, compiled, and loaded, so only the first job
+/// compiles and the others load the result.
+class ClexulatorCache {
+ public:
+  explicit ClexulatorCache(fs::path _cache_dir);
+
+  /// \brief Cache directory
+  fs::path const cache_dir;
+
+  /// \brief A locked cache entry
+  struct Entry {
+    /// \brief Path to the copy of the source file in the cache entry
+    fs::path source;
+
+    /// \brief The entry lock, which should be held until the clexulator is
+    ///     compiled and loaded
+    std::unique_ptr<FileLock> lock;
+  };
+
+  /// \brief Lock, and populate if necessary, the cache entry for a
+  ///     clexulator source file
+  Entry acquire(fs::path source, std::string const &basis_set_input) const;
+};
+
+/// \brief Return the clexulator cache directory, from the JSON input or the
+///     CASM_CLEXULATOR_CACHE_DIR environment variable, if set
+std::optional<fs::path> default_clexulator_cache_dir(
+    std::optional<std::string> cache_dir_input);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
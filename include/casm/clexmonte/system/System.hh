@@ -1,8 +1,17 @@
 #ifndef CASM_clexmonte_system_System
 #define CASM_clexmonte_system_System
 
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+#include "casm/casm_io/json/jsonParser.hh"
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexmonte/misc/Matrix3lCompare.hh"
+#include "casm/clexmonte/misc/PhaseTimings.hh"
 #include "casm/clexmonte/system/system_data.hh"
 #include "casm/clexulator/ClusterExpansion.hh"
 #include "casm/clexulator/DoFSpace.hh"
@@ -18,6 +27,7 @@
 #include "casm/configuration/occ_events/OccEventRep.hh"
 #include "casm/configuration/occ_events/OccSystem.hh"
 #include "casm/crystallography/BasicStructure.hh"
+#include "casm/global/filesystem.hh"
 #include "casm/monte/Conversions.hh"
 #include "casm/monte/ValueMap.hh"
 #include "casm/monte/events/OccCandidate.hh"
@@ -34,6 +44,141 @@ namespace clexmonte {
 struct System;
 struct SupercellSystemData;
 
+/// \brief Thread-safe, optionally size-bounded, cache of SupercellSystemData,
+///     by transformation_matrix_to_super
+///
+/// Notes:
+/// - Entries are constructed on first access by `get_or_make`, which may be
+///   called concurrently
+/// - If `max_size_in_bytes` is set, least recently used entries are evicted
+///   when a new entry is constructed, or when the limit is set, until the
+///   estimated total size (see `SupercellSystemData::size_in_bytes`) is
+///   within the limit. The most recently used entry, and entries held by a
+///   `std::shared_ptr` outside the cache, such as by a running calculation's
+///   StateData, are not evicted.
+/// - Supercells with the same lattice and the same site ordering, such as
+///   the same supercell specified by a different transformation matrix,
+///   share one entry, so that the supercell neighbor list and calculators
+///   are constructed once. The shared entry's `convert` has the
+///   transformation matrix of the first supercell constructed.
+/// - Copies of a cache have the same limit, and are empty, so that copying a
+///   System does not share supercell-specific calculators
+class SupercellSystemDataCache {
+ public:
+  SupercellSystemDataCache() = default;
+  SupercellSystemDataCache(SupercellSystemDataCache const &other)
+      : m_max_size_in_bytes(other.max_size_in_bytes()) {}
+  SupercellSystemDataCache &operator=(SupercellSystemDataCache const &other) {
+    clear();
+    set_max_size_in_bytes(other.max_size_in_bytes());
+    return *this;
+  }
+
+  /// \brief Get SupercellSystemData, constructing as necessary
+  std::shared_ptr<SupercellSystemData> get_or_make(
+      System const &system,
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  /// \brief Get SupercellSystemData if it exists, else nullptr
+  std::shared_ptr<SupercellSystemData> find(
+      Eigen::Matrix3l const &transformation_matrix_to_super) const;
+
+  /// \brief Number of distinct entries (equivalent supercells count once)
+  Index size() const;
+
+  /// \brief Estimated total size, in bytes, of all entries
+  Index size_in_bytes() const;
+
+  /// \brief Maximum estimated total size, in bytes, or std::nullopt for no
+  ///     limit
+  std::optional<Index> max_size_in_bytes() const;
+
+  /// \brief Set the maximum estimated total size, in bytes, evicting entries
+  ///     as necessary
+  void set_max_size_in_bytes(std::optional<Index> _max_size_in_bytes);
+
+  /// \brief Remove all entries
+  void clear();
+
+ private:
+  typedef std::list<Eigen::Matrix3l> lru_list_type;
+
+  struct Entry {
+    std::shared_ptr<SupercellSystemData> data;
+
+    /// Position in m_lru
+    lru_list_type::iterator lru_it;
+
+    /// Other transformation matrices that share this entry
+    std::vector<Eigen::Matrix3l> aliases;
+  };
+
+  typedef std::map<Eigen::Matrix3l, Entry, Matrix3lCompare> data_map_type;
+
+  data_map_type::iterator _find(
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  data_map_type::const_iterator _find(
+      Eigen::Matrix3l const &transformation_matrix_to_super) const;
+
+  Index _size_in_bytes() const;
+
+  void _evict();
+
+  /// Protects all members
+  mutable std::mutex m_mutex;
+
+  std::optional<Index> m_max_size_in_bytes;
+
+  /// Keys, from most to least recently used
+  lru_list_type m_lru;
+
+  data_map_type m_data;
+
+  /// Transformation matrix -> key in m_data of the entry it shares
+  std::map<Eigen::Matrix3l, Eigen::Matrix3l, Matrix3lCompare> m_alias;
+};
+
+/// \brief Thread-safe cache of local basis set site neighborhoods
+///
+/// Notes:
+/// - Neighborhoods are cached by local basis set name, equivalent index, and
+///   the sorted, unique indices of the basis functions with non-zero
+///   coefficients, so prim events sharing a local basis set and coefficient
+///   sparsity pattern construct each neighborhood once
+/// - Neighborhoods are stored as sorted vectors, and references remain valid
+///   until `clear` is called
+/// - Copies of a cache are empty
+class LocalSiteNeighborhoodCache {
+ public:
+  typedef std::tuple<std::string, Index, std::vector<unsigned int>> key_type;
+
+  LocalSiteNeighborhoodCache() = default;
+  LocalSiteNeighborhoodCache(LocalSiteNeighborhoodCache const &) {}
+  LocalSiteNeighborhoodCache &operator=(
+      LocalSiteNeighborhoodCache const &) {
+    clear();
+    return *this;
+  }
+
+  /// \brief Get a neighborhood, constructing it with `make` as necessary
+  std::vector<xtal::UnitCellCoord> const &get_or_make(
+      key_type const &key,
+      std::function<std::vector<xtal::UnitCellCoord>()> const &make) const;
+
+  /// \brief Number of cached neighborhoods
+  Index size() const;
+
+  /// \brief Remove all entries, invalidating references
+  void clear();
+
+ private:
+  /// Protects m_data
+  mutable std::mutex m_mutex;
+
+  mutable std::map<key_type, std::vector<xtal::UnitCellCoord>> m_data;
+};
+
 /// \brief Data structure for holding Monte Carlo calculation data and methods
 ///     that should only exist once, and should be accessible by
 ///     sampling functions - occupation DoF
@@ -45,12 +190,33 @@ struct SupercellSystemData;
 /// - Use the standalone `get_clex` helper method to get
 ///   supercell-specific clexulator::ClusterExpansion instance for a given
 ///   state, constructing it as necessary
+///
+/// Thread safety:
+/// - Apart from `supercell_data`, System data is not modified by the
+///   standalone helper methods, and may be shared by threads
+/// - `supercell_data` is a thread-safe cache, so the `get_supercell_data`
+///   style helpers may be called concurrently
+/// - The calculators returned by `get_corr`, `get_clex`, etc. are shared by
+///   all users of the same supercell and hold evaluation state (the
+///   ConfigDoFValues pointer and Clexulator scratch space). Threads
+///   evaluating concurrently should each use calculators from the
+///   `make_independent_clex` style helpers, which share only the immutable
+///   basis set, coefficients, and supercell neighbor list.
 struct System {
   /// \brief Constructor
   System(std::shared_ptr<xtal::BasicStructure const> const &_shared_prim,
          composition::CompositionConverter const &_composition_converter,
          Index _n_dimensions = 3);
 
+  // --- Startup timing
+
+  /// Wall-clock times of startup phases: prim symmetry, parsing, supercell
+  /// data, and the KMC event lists of calculations using this System.
+  /// Declared first so that it is available while constructing the other
+  /// members, and mutable because phases are timed through `System const &`
+  /// (PhaseTimings is thread-safe).
+  mutable PhaseTimings startup_timings;
+
   // --- Crystal structure
 
   /// Primitive crystal structure and allowed degrees of freedom (DoF)
@@ -172,6 +338,14 @@ struct System {
   /// KMC events
   std::map<std::string, OccEventTypeData> event_type_data;
 
+  /// Optional path of a binary snapshot of the prim event cluster expansion
+  /// update neighborhoods (see `load_or_make_prim_impact_info_list`)
+  std::optional<fs::path> prim_impact_info_snapshot_path;
+
+  /// Local basis set site neighborhoods, used to construct impact tables
+  /// (see `get_required_update_neighborhood`)
+  LocalSiteNeighborhoodCache local_site_neighborhoods;
+
   // --- Supercells
 
   /// Supercells
@@ -179,8 +353,17 @@ struct System {
 
   /// Supercell specific formation energy calculation data and methods (using
   /// transformation_matrix_to_super as key).
-  std::map<Eigen::Matrix3l, SupercellSystemData, Matrix3lCompare>
-      supercell_data;
+  SupercellSystemDataCache supercell_data;
+
+  // --- Input
+
+  /// JSON input the System was parsed from, if any, with
+  /// "clexulator_cache_dir" set to the clexulator cache directory that was
+  /// used. Allows constructing an equivalent System in another process.
+  std::optional<jsonParser> input;
+
+  /// Absolute paths of the search path used to parse `input`
+  std::vector<fs::path> input_search_path;
 };
 
 /// \brief Data structure for holding supercell-specific Monte Carlo calculation
@@ -191,6 +374,9 @@ struct SupercellSystemData {
   SupercellSystemData(System const &system,
                       Eigen::Matrix3l const &transformation_matrix_to_super);
 
+  SupercellSystemData(SupercellSystemData const &) = delete;
+  SupercellSystemData &operator=(SupercellSystemData const &) = delete;
+
   /// Number of unit cells in the supercell
   Index n_unitcells;
 
@@ -202,49 +388,88 @@ struct SupercellSystemData {
   /// List of unique pairs of (asymmetric unit index, species index)
   monte::OccCandidateList occ_candidate_list;
 
-  // --- Cluster expansion
+  // --- Lazily constructed members
+  //
+  // The following are constructed on first access, so that a run only
+  // constructs the calculators it uses. Construction is thread-safe, but
+  // the returned calculators are shared and are not.
 
   /// SuperNeighborList, used for evaluating correlations in a particular
-  /// supercell
-  std::shared_ptr<clexulator::SuperNeighborList> supercell_neighbor_list;
-
-  // --- Order parameter
+  /// supercell, or nullptr if the system has no prim neighbor list
+  std::shared_ptr<clexulator::SuperNeighborList> const &
+  supercell_neighbor_list();
 
-  /// Order parameter calculators
-  std::map<std::string, std::shared_ptr<clexulator::OrderParameter>>
-      order_parameters;
+  /// Estimated size, in bytes, of the index conversions and, if it has been
+  /// constructed, the supercell neighbor list
+  Index size_in_bytes() const;
 
-  // --- Cluster expansion
+  /// Order parameter calculator
+  std::shared_ptr<clexulator::OrderParameter> order_parameter(
+      std::string const &key);
 
-  /// CASM::monte correlation calculators - calculate all correlations
-  std::map<std::string, std::shared_ptr<clexulator::Correlations>> corr;
+  /// CASM::monte correlation calculator - calculate all correlations
+  std::shared_ptr<clexulator::Correlations> corr(std::string const &key);
 
-  /// CASM::monte local correlation calculators - calculate all correlations
-  std::map<std::string, std::shared_ptr<clexulator::LocalCorrelations>>
-      local_corr;
+  /// CASM::monte local correlation calculator - calculate all correlations
+  std::shared_ptr<clexulator::LocalCorrelations> local_corr(
+      std::string const &key);
 
-  /// CASM::monte compatible cluster expansion calculators. Contains:
+  /// CASM::monte compatible cluster expansion calculator. Contains:
   /// -  clexulator::Correlations - calculate non-zero eci correlations
   /// -  clexulator::SparseCoefficients
-  std::map<std::string, std::shared_ptr<clexulator::ClusterExpansion>> clex;
+  std::shared_ptr<clexulator::ClusterExpansion> clex(std::string const &key);
 
-  /// CASM::monte compatible cluster expansion calculators. Contains:
+  /// CASM::monte compatible cluster expansion calculator. Contains:
   /// -  clexulator::Correlations
   /// -  clexulator::SparseCoefficients
-  std::map<std::string, std::shared_ptr<clexulator::MultiClusterExpansion>>
-      multiclex;
+  std::shared_ptr<clexulator::MultiClusterExpansion> multiclex(
+      std::string const &key);
 
-  /// CASM::monte compatible local cluster expansion calculators. Contains:
+  /// CASM::monte compatible local cluster expansion calculator. Contains:
   /// -  clexulator::LocalCorrelations
   /// -  clexulator::SparseCoefficients
-  std::map<std::string, std::shared_ptr<clexulator::LocalClusterExpansion>>
-      local_clex;
+  std::shared_ptr<clexulator::LocalClusterExpansion> local_clex(
+      std::string const &key);
 
-  /// CASM::monte compatible local cluster expansion calculators. Contains:
+  /// CASM::monte compatible local cluster expansion calculator. Contains:
   /// -  clexulator::LocalCorrelations
   /// -  clexulator::SparseCoefficients
+  std::shared_ptr<clexulator::MultiLocalClusterExpansion> local_multiclex(
+      std::string const &key);
+
+  /// CASM::monte compatible local cluster expansion calculator, using only
+  /// the named coefficient sets, in the given order. Only basis functions
+  /// with a non-zero coefficient in one of those sets are evaluated.
+  std::shared_ptr<clexulator::MultiLocalClusterExpansion> local_multiclex(
+      std::string const &key,
+      std::vector<std::string> const &coefficient_names);
+
+ private:
+  /// The system, which must outlive this
+  System const &m_system;
+
+  std::once_flag m_supercell_neighbor_list_flag;
+  std::atomic<bool> m_has_supercell_neighbor_list{false};
+  std::shared_ptr<clexulator::SuperNeighborList> m_supercell_neighbor_list;
+
+  /// Protects the lazily constructed maps
+  std::mutex m_mutex;
+
+  std::map<std::string, std::shared_ptr<clexulator::OrderParameter>>
+      m_order_parameters;
+  std::map<std::string, std::shared_ptr<clexulator::Correlations>> m_corr;
+  std::map<std::string, std::shared_ptr<clexulator::LocalCorrelations>>
+      m_local_corr;
+  std::map<std::string, std::shared_ptr<clexulator::ClusterExpansion>> m_clex;
+  std::map<std::string, std::shared_ptr<clexulator::MultiClusterExpansion>>
+      m_multiclex;
+  std::map<std::string, std::shared_ptr<clexulator::LocalClusterExpansion>>
+      m_local_clex;
   std::map<std::string, std::shared_ptr<clexulator::MultiLocalClusterExpansion>>
-      local_multiclex;
+      m_local_multiclex;
+  std::map<std::pair<std::string, std::vector<std::string>>,
+           std::shared_ptr<clexulator::MultiLocalClusterExpansion>>
+      m_local_multiclex_subset;
 };
 
 // ---
@@ -362,13 +587,20 @@ LocalClexData const &get_local_clex_data(System const &system,
 LocalMultiClexData const &get_local_multiclex_data(System const &system,
                                                    std::string const &key);
 
-/// \brief Construct impact tables
+/// \brief Sites used to evaluate a cluster expansion, relative to the origin
+///     unit cell
 std::set<xtal::UnitCellCoord> get_required_update_neighborhood(
+    System const &system, ClexData const &clex_data);
+
+/// \brief Sites used to evaluate a local cluster expansion, relative to the
+///     origin unit cell, as a sorted vector
+std::vector<xtal::UnitCellCoord> const &get_required_update_neighborhood(
     System const &system, LocalClexData const &local_clex_data,
     Index equivalent_index);
 
-/// \brief Construct impact tables
-std::set<xtal::UnitCellCoord> get_required_update_neighborhood(
+/// \brief Sites used to evaluate a local multi-cluster expansion, relative
+///     to the origin unit cell, as a sorted vector
+std::vector<xtal::UnitCellCoord> const &get_required_update_neighborhood(
     System const &system, LocalMultiClexData const &local_multiclex_data,
     Index equivalent_index);
 
@@ -403,6 +635,14 @@ CorrCalculatorFunction get_random_alloy_corr_f(System const &system);
 
 // --- Supercell-specific
 
+/// \brief Helper to get shared SupercellSystemData for a particular
+///     state's supercell, constructing as necessary
+std::shared_ptr<SupercellSystemData> get_shared_supercell_data(
+    System &system, state_type const &state);
+
+/// \brief Remove all SupercellSystemData
+void clear_supercell_data(System &system);
+
 /// \brief Helper to get the correct clexulator::Correlations for a
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::Correlations> get_corr(System &system,
@@ -436,11 +676,58 @@ std::shared_ptr<clexulator::LocalClusterExpansion> get_local_clex(
 std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
     System &system, state_type const &state, std::string const &key);
 
+/// \brief Helper to get a clexulator::MultiLocalClusterExpansion, using only
+///     the named coefficient sets, for a particular state's supercell,
+///     constructing as necessary
+std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
+    System &system, state_type const &state, std::string const &key,
+    std::vector<std::string> const &coefficient_names);
+
 /// \brief Helper to get the supercell neighbor list for a
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::SuperNeighborList> get_supercell_neighbor_list(
     System &system, state_type const &state);
 
+/// \brief Construct a clexulator::ClusterExpansion for a particular state's
+///     supercell, which is not shared with other calculators
+std::shared_ptr<clexulator::ClusterExpansion> make_independent_clex(
+    System &system, state_type const &state, std::string const &key);
+
+/// \brief Construct a clexulator::Correlations for a particular state's
+///     supercell, which is not shared with other calculators
+std::shared_ptr<clexulator::Correlations> make_independent_corr(
+    System &system, state_type const &state, std::string const &key);
+
+/// \brief Construct a clexulator::MultiClusterExpansion for a particular
+///     state's supercell, which is not shared with other calculators
+std::shared_ptr<clexulator::MultiClusterExpansion> make_independent_multiclex(
+    System &system, state_type const &state, std::string const &key);
+
+/// \brief Construct a clexulator::LocalClusterExpansion for a particular
+///     state's supercell, which is not shared with other calculators
+std::shared_ptr<clexulator::LocalClusterExpansion> make_independent_local_clex(
+    System &system, state_type const &state, std::string const &key);
+
+/// \brief Construct a clexulator::MultiLocalClusterExpansion for a
+///     particular state's supercell, which is not shared with other
+///     calculators
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+make_independent_local_multiclex(System &system, state_type const &state,
+                                 std::string const &key);
+
+/// \brief Construct a clexulator::MultiLocalClusterExpansion, using only the
+///     named coefficient sets, for a particular state's supercell, which is
+///     not shared with other calculators
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+make_independent_local_multiclex(
+    System &system, state_type const &state, std::string const &key,
+    std::vector<std::string> const &coefficient_names);
+
+/// \brief Select coefficient sets of a local multi-cluster expansion by name
+std::vector<clexulator::SparseCoefficients> select_coefficients(
+    LocalMultiClexData const &data,
+    std::vector<std::string> const &coefficient_names);
+
 /// \brief Helper to get the correct order parameter calculators for a
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::OrderParameter> get_order_parameter(
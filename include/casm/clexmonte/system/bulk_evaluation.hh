@@ -0,0 +1,48 @@
+#ifndef CASM_clexmonte_system_bulk_evaluation
+#define CASM_clexmonte_system_bulk_evaluation
+
+#include <string>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Occupations of many configurations in one supercell, one row per
+///     configuration and one column per site
+typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    bulk_occupation_type;
+
+/// \brief Evaluate a cluster expansion (per unit cell) for many
+///     configurations in one supercell
+Eigen::VectorXd bulk_clex_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads = 1);
+
+/// \brief Evaluate a multi-cluster expansion (per unit cell) for many
+///     configurations in one supercell
+Eigen::MatrixXd bulk_multiclex_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads = 1);
+
+/// \brief Evaluate correlations (per unit cell) for many configurations in
+///     one supercell
+Eigen::MatrixXd bulk_corr_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads = 1);
+
+/// \brief Evaluate an order parameter for many configurations in one
+///     supercell
+Eigen::MatrixXd bulk_order_parameter(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads = 1);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -171,5 +171,11 @@ files = unit_test_source_files("unit/clexmonte", additional)
 cmake_file_strings = as_cmake_file_strings(files)
 cmakelists = cmakelists.replace("@casm_unit_clexmonte_source_files@", cmake_file_strings)
 
+files = unit_test_source_files("benchmark", [])
+cmake_file_strings = as_cmake_file_strings(files)
+cmakelists = cmakelists.replace(
+    "@casm_clexmonte_benchmarks_source_files@", cmake_file_strings
+)
+
 with open("CMakeLists.txt", "w") as f:
     f.write(cmakelists)
@@ -0,0 +1,148 @@
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/nfold/canonical_nfold.hh"
+#include "casm/clexmonte/nfold/canonical_nfold_json_io.hh"
+#include "casm/clexmonte/run/io/json/parse_and_run_series.hh"
+#include "casm/clexmonte/run/io/json/serve_run_queue.hh"
+
+using namespace CASM;
+
+// ///////////////////////////////////////
+// ccasm-clexmonte-canonical-nfold main:
+
+void print_help() {
+  int verbosity = Log::standard;
+  bool show_clock = false;
+  int indent_space = 4;
+  Log log(std::cout, verbosity, show_clock, indent_space);
+  log.set_width(80);
+
+  log.paragraph(
+      "usage: ccasm-clexmonte-canonical-nfold [-h] [-V] system.json "
+      "run_params.json [run_params.json ...]");
+  log.paragraph(
+      "       ccasm-clexmonte-canonical-nfold system.json --queue "
+      "queue_dir");
+  log << std::endl;
+
+  log.paragraph(
+      "ccasm-clexmonte-canonical-nfold is a program for running "
+      "N-fold way canonical Monte Carlo calculations using cluster "
+      "expansions "
+      "generated by CASM.");
+  log << std::endl;
+
+  log << "Options:" << std::endl << std::endl;
+
+  // ## positional arguments
+  log << "positional arguments:" << std::endl;
+  log.increase_indent();
+
+  // ### systemfile
+  log.indent() << "system.json" << std::endl;
+  log.increase_indent();
+  log.paragraph("JSON formatted file specifying the Monte Carlo system");
+  log.decrease_indent();
+  log << std::endl;
+
+  // ### run_params_json_file
+  log.indent() << "run_params.json [run_params.json ...]" << std::endl;
+  log.increase_indent();
+  log.paragraph(
+      "One or more JSON formatted files specifying Monte Carlo run "
+      "parameters, or directories of them. Each series is run in turn, "
+      "with the system constructed once, and with the calculation reused "
+      "by series with the same \"calculation_options\".");
+  log.decrease_indent();
+  log << std::endl;
+
+  log.decrease_indent();
+  log << std::endl;
+
+  // ## optional arguments
+  log << "optional arguments:" << std::endl;
+  log.increase_indent();
+
+  // ### -h
+  log.indent() << "-h, --help" << std::endl;
+  log.increase_indent();
+  log.paragraph("Print help message and exit");
+  log.decrease_indent();
+  log << std::endl;
+
+  // ### -V
+  log.indent() << "-V, --version" << std::endl;
+  log.increase_indent();
+  log.paragraph("Print version number and exit");
+  log.decrease_indent();
+  log << std::endl;
+
+  // ### --queue
+  log.indent() << "--queue queue_dir" << std::endl;
+  log.increase_indent();
+  log.paragraph(
+      "Instead of a single run_params.json, keep the system loaded and run "
+      "each run_params JSON file written to queue_dir/pending/, in order of "
+      "file name. Finished requests are moved to queue_dir/done/, or to "
+      "queue_dir/failed/ with an error message. Stops when the file "
+      "queue_dir/stop exists.");
+  log.decrease_indent();
+  log << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+#ifdef CASM_CLEXMONTE_MPI
+  CASM::clexmonte::ScopedMPI mpi(&argc, &argv);
+#endif
+  if (argc < 2) {
+    print_help();
+    return 1;
+  }
+
+  std::string param = argv[1];
+
+  if (param == "-h" || param == "--help") {
+    print_help();
+    return 0;
+  } else if (param == "-V" || param == "--version") {
+    log() << "2.0.0-alpha" << std::endl;
+    return 0;
+  } else if (argc == 4 && std::string(argv[2]) == "--queue") {
+    using namespace CASM::clexmonte;
+    using namespace CASM::clexmonte::nfold;
+    try {
+      serve_run_queue<CanonicalNfold_mt19937_64>(argv[1], argv[3]);
+    } catch (std::exception &e) {
+      log() << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  } else if (argc < 3) {
+    print_help();
+    return 1;
+  }
+
+  fs::path system_json_file = argv[1];
+  std::vector<fs::path> run_params_paths(argv + 2, argv + argc);
+
+  if (!fs::exists(system_json_file)) {
+    log() << "Error: file does not exist: " << system_json_file << std::endl;
+    return 1;
+  }
+  for (auto const &path : run_params_paths) {
+    if (!fs::exists(path)) {
+      log() << "Error: file does not exist: " << path << std::endl;
+      return 1;
+    }
+  }
+
+  using namespace CASM::clexmonte;
+  using namespace CASM::clexmonte::nfold;
+  try {
+    parse_and_run_series<CanonicalNfold_mt19937_64>(
+        system_json_file, expand_run_params_json_files(run_params_paths));
+  } catch (std::exception &e) {
+    log() << e.what() << std::endl;
+  }
+
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include "casm/casm_io/Log.hh"
 #include "casm/clexmonte/run/io/json/parse_and_run_series.hh"
+#include "casm/clexmonte/run/io/json/serve_run_queue.hh"
 #include "casm/clexmonte/semigrand_canonical/calculator.hh"
 #include "casm/clexmonte/semigrand_canonical/json_io.hh"
 
@@ -17,7 +18,10 @@ void print_help() {
 
   log.paragraph(
       "usage: ccasm-clexmonte-semigrand-canonical [-h] [-V] system.json "
-      "run_params.json");
+      "run_params.json [run_params.json ...]");
+  log.paragraph(
+      "       ccasm-clexmonte-semigrand-canonical system.json --queue "
+      "queue_dir");
   log << std::endl;
 
   log.paragraph(
@@ -40,9 +44,13 @@ void print_help() {
   log << std::endl;
 
   // ### run_params_json_file
-  log.indent() << "run_params.json" << std::endl;
+  log.indent() << "run_params.json [run_params.json ...]" << std::endl;
   log.increase_indent();
-  log.paragraph("JSON formatted file specifying Monte Carlo run parameters");
+  log.paragraph(
+      "One or more JSON formatted files specifying Monte Carlo run "
+      "parameters, or directories of them. Each series is run in turn, "
+      "with the system constructed once, and with the calculation reused "
+      "by series with the same \"calculation_options\".");
   log.decrease_indent();
   log << std::endl;
 
@@ -66,9 +74,24 @@ void print_help() {
   log.paragraph("Print version number and exit");
   log.decrease_indent();
   log << std::endl;
+
+  // ### --queue
+  log.indent() << "--queue queue_dir" << std::endl;
+  log.increase_indent();
+  log.paragraph(
+      "Instead of a single run_params.json, keep the system loaded and run "
+      "each run_params JSON file written to queue_dir/pending/, in order of "
+      "file name. Finished requests are moved to queue_dir/done/, or to "
+      "queue_dir/failed/ with an error message. Stops when the file "
+      "queue_dir/stop exists.");
+  log.decrease_indent();
+  log << std::endl;
 }
 
 int main(int argc, char *argv[]) {
+#ifdef CASM_CLEXMONTE_MPI
+  CASM::clexmonte::ScopedMPI mpi(&argc, &argv);
+#endif
   if (argc < 2) {
     print_help();
     return 1;
@@ -82,29 +105,40 @@ int main(int argc, char *argv[]) {
   } else if (param == "-V" || param == "--version") {
     log() << "2.0.0-alpha" << std::endl;
     return 0;
-  } else if (argc != 3) {
+  } else if (argc == 4 && std::string(argv[2]) == "--queue") {
+    using namespace CASM::clexmonte;
+    using namespace CASM::clexmonte::semigrand_canonical;
+    try {
+      serve_run_queue<SemiGrandCanonical_mt19937_64>(argv[1], argv[3]);
+    } catch (std::exception &e) {
+      log() << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  } else if (argc < 3) {
     print_help();
     return 1;
   }
 
   fs::path system_json_file = argv[1];
-  fs::path run_params_json_file = argv[2];
+  std::vector<fs::path> run_params_paths(argv + 2, argv + argc);
 
   if (!fs::exists(system_json_file)) {
     log() << "Error: file does not exist: " << system_json_file << std::endl;
     return 1;
   }
-  if (!fs::exists(run_params_json_file)) {
-    log() << "Error: file does not exist: " << run_params_json_file
-          << std::endl;
-    return 1;
+  for (auto const &path : run_params_paths) {
+    if (!fs::exists(path)) {
+      log() << "Error: file does not exist: " << path << std::endl;
+      return 1;
+    }
   }
 
   using namespace CASM::clexmonte;
   using namespace CASM::clexmonte::semigrand_canonical;
   try {
-    parse_and_run_series<SemiGrandCanonical_mt19937_64>(system_json_file,
-                                                        run_params_json_file);
+    parse_and_run_series<SemiGrandCanonical_mt19937_64>(
+        system_json_file, expand_run_params_json_files(run_params_paths));
   } catch (std::exception &e) {
     log() << e.what() << std::endl;
   }
@@ -0,0 +1,225 @@
+import copy
+import json
+import threading
+from typing import Any, Callable, Optional
+
+import numpy as np
+
+import libcasm.monte as monte
+from libcasm.configuration import (
+    Configuration,
+)
+
+from ._RunData import (
+    RunData,
+)
+
+
+class ConfigGeneratorCache:
+    """Stores generated configurations by key, so that identical expensive
+    configuration generation is only done once
+
+    Notes
+    -----
+
+    - Generating an initial configuration can require symmetry analysis and
+      copying a motif into a large supercell. A ConfigGeneratorCache stores the
+      result by a key that identifies the inputs, for example the motif, the
+      transformation matrix of the supercell, and a subset of the conditions
+      (see :func:`make_config_cache_key`).
+    - Thread-safe; one cache may be shared by the configuration generators of
+      all parallel workers of a series.
+    - Stored configurations are never modified; :func:`get_or_make` returns
+      a copy.
+
+    """
+
+    def __init__(self):
+        self._configurations = {}
+        self._lock = threading.Lock()
+        self.n_hits = 0
+        """int: Number of :func:`get_or_make` calls that returned a stored
+        configuration"""
+
+        self.n_misses = 0
+        """int: Number of :func:`get_or_make` calls that generated a
+        configuration"""
+
+    def get_or_make(
+        self,
+        key: str,
+        make_f: Callable[[], Configuration],
+    ) -> Configuration:
+        """Return a copy of the configuration stored by `key`, calling `make_f`
+        to generate and store it if it is not yet stored
+
+        Parameters
+        ----------
+        key: str
+            Identifies the inputs of the generated configuration.
+        make_f: Callable[[], libcasm.configuration.Configuration]
+            Generates the configuration.
+
+        Returns
+        -------
+        configuration: libcasm.configuration.Configuration
+            A copy of the stored configuration.
+        """
+        with self._lock:
+            configuration = self._configurations.get(key)
+            if configuration is not None:
+                self.n_hits += 1
+                return copy.copy(configuration)
+        configuration = make_f()
+        with self._lock:
+            self.n_misses += 1
+            configuration = self._configurations.setdefault(key, configuration)
+            return copy.copy(configuration)
+
+    def __len__(self):
+        with self._lock:
+            return len(self._configurations)
+
+    def clear(self):
+        """Remove all stored configurations"""
+        with self._lock:
+            self._configurations.clear()
+
+
+_default_config_generator_cache = ConfigGeneratorCache()
+
+
+def default_config_generator_cache() -> ConfigGeneratorCache:
+    """A ConfigGeneratorCache shared by all configuration generators of this
+    process
+
+    Used by :class:`~libcasm.clexmonte.FixedConfigGenerator` to store motifs
+    tiled into supercells.
+    """
+    return _default_config_generator_cache
+
+
+def make_config_cache_key(
+    prefix: str,
+    transformation_matrix_to_super: Optional[np.ndarray] = None,
+    motif: Optional[Configuration] = None,
+    conditions: Optional[monte.ValueMap] = None,
+    condition_keys: list[str] = [],
+    **kwargs: Any,
+) -> str:
+    """Make a ConfigGeneratorCache key
+
+    Parameters
+    ----------
+    prefix: str
+        Identifies the generation method.
+    transformation_matrix_to_super: Optional[np.ndarray] = None
+        If not None, the transformation matrix of the generated configuration's
+        supercell.
+    motif: Optional[libcasm.configuration.Configuration] = None
+        If not None, a configuration the generated configuration is made from.
+        The key includes the motif's prim, so motifs of different systems have
+        different keys.
+    conditions: Optional[libcasm.monte.ValueMap] = None
+        If not None, the conditions the generated configuration is made for.
+    condition_keys: list[str] = []
+        Names of the `conditions` included in the key. Conditions not in
+        `conditions` are ignored.
+    **kwargs: Any
+        Additional JSON-serializable values included in the key.
+
+    Returns
+    -------
+    key: str
+        A compact JSON string with all the given values.
+    """
+    data = {"prefix": prefix}
+    if transformation_matrix_to_super is not None:
+        data["T"] = np.array(transformation_matrix_to_super, dtype=int).tolist()
+    if motif is not None:
+        data["prim"] = motif.supercell.prim.xtal_prim.to_dict()
+        data["motif"] = motif.to_dict()
+    if conditions is not None:
+        if isinstance(conditions, monte.ValueMap):
+            conditions = conditions.to_dict()
+        data["conditions"] = {
+            name: conditions[name] for name in condition_keys if name in conditions
+        }
+    data.update(kwargs)
+    return json.dumps(data, sort_keys=True, separators=(",", ":"))
+
+
+class CachedConfigGenerator:
+    """A `ConfigGenerator` that stores the configurations generated by another
+    config generator by a subset of the conditions
+
+    Notes
+    -----
+
+    - Generated configurations are stored in a :class:`ConfigGeneratorCache` by
+      the values of the conditions named in `condition_keys`, so the wrapped
+      generator is only called once for each distinct combination. For
+      example, a generator that makes a configuration for a composition can be
+      cached by ``["mol_composition"]``, so that runs which vary the
+      temperature reuse the configuration.
+    - The wrapped generator must only depend on those conditions; the
+      completed runs are only passed to it when it is called.
+
+    """
+
+    def __init__(
+        self,
+        config_generator: Callable[[monte.ValueMap, list[RunData]], Configuration],
+        condition_keys: list[str],
+        cache: Optional[ConfigGeneratorCache] = None,
+        key_prefix: str = "",
+    ):
+        """
+        .. rubric:: Constructor
+
+        Parameters
+        ----------
+        config_generator: Callable[[libcasm.monte.ValueMap, list[RunData]], \
+        libcasm.configuration.Configuration]
+            The wrapped configuration generator.
+        condition_keys: list[str]
+            Names of the conditions that the generated configuration depends on.
+        cache: Optional[ConfigGeneratorCache] = None
+            Where configurations are stored. May be shared by several
+            generators. If None, a new cache is used.
+        key_prefix: str = ""
+            Distinguishes generators that share a cache.
+        """
+        self.config_generator = config_generator
+        self.condition_keys = list(condition_keys)
+        self.cache = cache if cache is not None else ConfigGeneratorCache()
+        self.key_prefix = key_prefix
+
+    def __call__(
+        self,
+        conditions: monte.ValueMap,
+        completed_runs: list[RunData],
+    ) -> Configuration:
+        """Return the stored configuration for `conditions`, generating it if
+        necessary
+
+        Parameters
+        ----------
+        conditions: libcasm.monte.ValueMap
+            The thermodynamic conditions at which the next state will be run
+        completed_runs: list[RunData]
+            Passed to the wrapped generator if it is called.
+
+        Returns
+        -------
+        configuration:  libcasm.configuration.Configuration
+            The generated configuration.
+        """
+        key = make_config_cache_key(
+            self.key_prefix,
+            conditions=conditions,
+            condition_keys=self.condition_keys,
+        )
+        return self.cache.get_or_make(
+            key, lambda: self.config_generator(conditions, completed_runs)
+        )
@@ -11,6 +11,11 @@ from libcasm.configuration import (
     copy_transformed_configuration,
 )
 
+from ._ConfigGeneratorCache import (
+    ConfigGeneratorCache,
+    default_config_generator_cache,
+    make_config_cache_key,
+)
 from ._RunData import (
     RunData,
 )
@@ -36,6 +41,7 @@ class FixedConfigGenerator:
         configuration: Optional[Configuration] = None,
         supercell: Optional[Supercell] = None,
         motif: Optional[Configuration] = None,
+        cache: Optional[ConfigGeneratorCache] = None,
     ):
         """
         .. rubric:: Constructor
@@ -55,6 +61,12 @@ class FixedConfigGenerator:
             no perfect tiling and the `motif` is used without reorientation
             to fill the supercell imperfectly. If `supercell` is given but
             no `motif` is provided, the default configuration is used.
+        cache: Optional[ConfigGeneratorCache] = None
+            Where the configuration made by tiling `motif` into `supercell` is
+            stored, so that constructing a FixedConfigGenerator again with the
+            same `motif` and `supercell`, for instance once per series, does not
+            repeat the symmetry analysis and copying. If None, the cache
+            returned by :func:`default_config_generator_cache` is used.
 
         """
         self._configuration = None
@@ -69,34 +81,51 @@ class FixedConfigGenerator:
             if motif is None:
                 self._motif = Configuration(self._supercell)
                 self._default_motif = True
-                fg_index = 0
             else:
                 self._motif = motif
                 self._default_motif = False
-                factor_group = supercell.prim.factor_group
-                (
-                    is_equivalent,
-                    T,
-                    fg_index,
-                ) = supercell.superlattice.is_equivalent_superlattice_of(
-                    self._motif.superlattice, factor_group.elements
-                )
-                if not is_equivalent:
-                    print(
-                        "Warning: `motif` cannot tile `supercell`. "
-                        "Will fill imperfectly."
-                    )
-                elif fg_index != 0:
-                    print(
-                        f"Note: `motif` fills `supercell` after applying factor "
-                        f"group operation {fg_index} (indexing from 0)."
+
+            def make_f():
+                if self._default_motif:
+                    fg_index = 0
+                else:
+                    factor_group = supercell.prim.factor_group
+                    (
+                        is_equivalent,
+                        T,
+                        fg_index,
+                    ) = supercell.superlattice.is_equivalent_superlattice_of(
+                        self._motif.superlattice, factor_group.elements
                     )
-            self._configuration = copy_transformed_configuration(
-                prim_factor_group_index=fg_index,
-                translation=[0, 0, 0],
+                    if not is_equivalent:
+                        print(
+                            "Warning: `motif` cannot tile `supercell`. "
+                            "Will fill imperfectly."
+                        )
+                    elif fg_index != 0:
+                        print(
+                            f"Note: `motif` fills `supercell` after applying "
+                            f"factor group operation {fg_index} (indexing "
+                            f"from 0)."
+                        )
+                return copy_transformed_configuration(
+                    prim_factor_group_index=fg_index,
+                    translation=[0, 0, 0],
+                    motif=self._motif,
+                    supercell=self._supercell,
+                )
+
+            # the same motif and supercell are only tiled once per process
+            if cache is None:
+                cache = default_config_generator_cache()
+            key = make_config_cache_key(
+                "fixed",
+                transformation_matrix_to_super=(
+                    self._supercell.transformation_matrix_to_super
+                ),
                 motif=self._motif,
-                supercell=self._supercell,
             )
+            self._configuration = cache.get_or_make(key, make_f)
         else:
             raise Exception(
                 "Error constructing FixedConfigGenerator: "
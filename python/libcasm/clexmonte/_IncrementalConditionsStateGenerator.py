@@ -67,6 +67,7 @@ class IncrementalConditionsStateGenerator:
             is returned. This can be used to apply custom constraints.
         """
         self._completed_runs = []
+        self._n_written_runs = 0
         self._output_params = output_params
         self._config_generator = config_generator
         self._initial_conditions = ValueMap(initial_conditions)
@@ -162,14 +163,23 @@ class IncrementalConditionsStateGenerator:
 
         Notes
         -----
-        - Reads from ``output_params.output_dir / "completed_runs.json"``.
+        - Reads from ``output_params.output_dir / "completed_runs.json"``, or, if
+          `output_params.append_only` is True and it exists,
+          ``output_params.output_dir / "completed_runs.jsonl"``.
         - Skips if file does not exist or `output_params.output_dir` is None.
         """
+        self._completed_runs = []
+        self._n_written_runs = 0
         if self._output_params.output_dir is None:
             return
 
         output_dir = pathlib.Path(self._output_params.output_dir)
         output_dir.mkdir(parents=True, exist_ok=True)
+        jsonl_path = output_dir / "completed_runs.jsonl"
+        if self._output_params.append_only and jsonl_path.exists():
+            self._read_completed_runs_jsonl(jsonl_path)
+            return
+
         completed_runs_path = output_dir / "completed_runs.json"
         if not completed_runs_path.exists():
             return
@@ -183,19 +193,62 @@ class IncrementalConditionsStateGenerator:
                     f"Error in IncrementalConditionsStateGenerator: "
                     f"failed to read {completed_runs_path}"
                 )
+        if not self._output_params.append_only:
+            self._n_written_runs = len(self._completed_runs)
+
+    def _read_completed_runs_jsonl(self, jsonl_path: pathlib.Path):
+        """Read completed_runs.jsonl, one run per line, ignoring and removing an
+        incomplete last line from an interrupted write"""
+        with open(jsonl_path, "r") as f:
+            text = f.read()
+        lines = text.split("\n")
+        incomplete_line = lines.pop()
+        for i, line in enumerate(lines):
+            if not line:
+                continue
+            try:
+                # apply the same saving rules as during the series
+                self.append(RunData.from_dict(json.loads(line)))
+            except Exception as e:
+                print("what:", e)
+                raise Exception(
+                    f"Error in IncrementalConditionsStateGenerator: "
+                    f"failed to read {jsonl_path}, line {i + 1}"
+                )
+        if incomplete_line:
+            with open(jsonl_path, "w") as f:
+                f.write(text[: len(text) - len(incomplete_line)])
+        self._n_written_runs = len(self._completed_runs)
 
     def write_completed_runs(self):
         """Write completed runs data
 
         Notes
         -----
-        - Writes to ``output_params.output_dir / "completed_runs.json"``.
+        - Writes to ``output_params.output_dir / "completed_runs.json"``, or, if
+          `output_params.append_only` is True, appends runs completed since the
+          last write to ``output_params.output_dir / "completed_runs.jsonl"``.
         """
         if self._output_params.output_dir is None:
             return
 
         output_dir = pathlib.Path(self._output_params.output_dir)
         output_dir.mkdir(parents=True, exist_ok=True)
+        if self._output_params.append_only:
+            jsonl_path = output_dir / "completed_runs.jsonl"
+            # started from completed_runs.json, or without reading: write in full
+            mode = "a" if self._n_written_runs else "w"
+            with open(jsonl_path, mode) as f:
+                for x in self._completed_runs[self._n_written_runs :]:
+                    data = x.to_dict(
+                        write_initial_states=self._output_params.write_initial_states,
+                        write_final_states=self._output_params.write_final_states,
+                        write_prim_basis=self._output_params.write_prim_basis,
+                    )
+                    f.write(json.dumps(data) + "\n")
+            self._n_written_runs = len(self._completed_runs)
+            return
+
         completed_runs_path = output_dir / "completed_runs.json"
         with open(completed_runs_path, "w") as f:
             data = [
@@ -207,6 +260,7 @@ class IncrementalConditionsStateGenerator:
                 for x in self._completed_runs
             ]
             f.write(json.dumps(data))
+        self._n_written_runs = len(self._completed_runs)
 
     @staticmethod
     def methodname() -> str:
@@ -0,0 +1,95 @@
+import pathlib
+from typing import Union
+
+import numpy as np
+
+_header_dtype = np.dtype(
+    [
+        ("magic", "S8"),
+        ("n_sites", "<u8"),
+        ("bytes_per_value", "<u8"),
+        ("record_size", "<u8"),
+        ("n_frames", "<u8"),
+        ("capacity", "<u8"),
+        ("reserved", "V16"),
+    ]
+)
+
+_value_dtypes = {1: "<u1", 2: "<u2", 4: "<u4"}
+
+
+class MappedTrajectory:
+    """Read a trajectory file written by the "trajectory_frame" sampling function
+
+    The file is memory-mapped, and frames are exposed as numpy views of the
+    file, without copying. The file may be read while it is being written, in
+    which case only the frames written when the MappedTrajectory was
+    constructed are included.
+
+    Attributes
+    ----------
+    occupation: np.ndarray[np.uint[n_frames, n_sites]]
+        The occupation of each frame, as a read-only view of the file.
+    sample_index: np.ndarray[np.uint64[n_frames]]
+        The per-run sample index of each frame.
+    time: np.ndarray[np.float64[n_frames]]
+        The simulated time of each frame, or NaN if not time-based.
+    """
+
+    def __init__(self, path: Union[str, pathlib.Path]):
+        """
+        .. rubric:: Constructor
+
+        Parameters
+        ----------
+        path: Union[str, pathlib.Path]
+            Path to the trajectory file.
+        """
+        header = np.fromfile(path, dtype=_header_dtype, count=1)
+        if len(header) != 1 or header["magic"][0] != b"CLXTRAJ1":
+            raise Exception(f"Error in MappedTrajectory: not a trajectory: {path}")
+        n_sites = int(header["n_sites"][0])
+        bytes_per_value = int(header["bytes_per_value"][0])
+        record_size = int(header["record_size"][0])
+        n_frames = int(header["n_frames"][0])
+        if bytes_per_value not in _value_dtypes:
+            raise Exception(
+                f"Error in MappedTrajectory: invalid bytes_per_value: {path}"
+            )
+
+        self.record_dtype = np.dtype(
+            {
+                "names": ["sample_index", "time", "occupation"],
+                "formats": [
+                    "<u8",
+                    "<f8",
+                    (_value_dtypes[bytes_per_value], (n_sites,)),
+                ],
+                "offsets": [0, 8, 16],
+                "itemsize": record_size,
+            }
+        )
+        """np.dtype: The numpy dtype of a frame record"""
+
+        if n_frames == 0:
+            self.records = np.zeros((0,), dtype=self.record_dtype)
+        else:
+            self.records = np.memmap(
+                path,
+                dtype=self.record_dtype,
+                mode="r",
+                offset=_header_dtype.itemsize,
+                shape=(n_frames,),
+            )
+        """np.ndarray: The frame records, as a read-only view of the file"""
+
+        self.occupation = self.records["occupation"]
+        self.sample_index = self.records["sample_index"]
+        self.time = self.records["time"]
+
+    def __len__(self):
+        return len(self.records)
+
+    def __getitem__(self, i):
+        """Return the occupation of frame `i`, as a view of the file"""
+        return self.occupation[i]
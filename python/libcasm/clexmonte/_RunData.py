@@ -161,6 +161,7 @@ class RunDataOutputParams:
         write_final_states: bool = False,
         write_prim_basis: bool = False,
         output_dir: Optional[str] = None,
+        append_only: bool = False,
     ):
         """
         .. rubric:: Constructor
@@ -184,6 +185,10 @@ class RunDataOutputParams:
             Default (False) is to use the standard basis.
         output_dir: Optional[str] = None
             Location to save completed_runs.json if not None
+        append_only: bool = False
+            If True, write completed_runs.jsonl, with one completed run per line,
+            appending only the runs completed since the last write, instead of
+            rewriting completed_runs.json.
         """
         self.do_save_all_initial_states = do_save_all_initial_states
         """bool: Save all initial states in the state generator's completed runs list"""
@@ -209,6 +214,10 @@ class RunDataOutputParams:
         self.output_dir = output_dir
         """Optional[str]: Location to save completed_runs.json if not None"""
 
+        self.append_only = append_only
+        """bool: If True, append new runs to completed_runs.jsonl instead of \
+        rewriting completed_runs.json"""
+
     def to_dict(
         self,
         write_initial_states: bool = False,
@@ -223,6 +232,7 @@ class RunDataOutputParams:
         to_dict(self.write_final_states, data, "write_final_states")
         to_dict(self.write_prim_basis, data, "write_prim_basis")
         to_dict(self.output_dir, data, "output_dir")
+        to_dict(self.append_only, data, "append_only")
         return data
 
     @staticmethod
@@ -250,4 +260,7 @@ class RunDataOutputParams:
                 bool, data, "write_prim_basis", default_value=False
             ),
             output_dir=optional_from_dict(str, data, "output_dir", default_value=None),
+            append_only=optional_from_dict(
+                bool, data, "append_only", default_value=False
+            ),
         )
@@ -8,11 +8,19 @@ from ._auto_configuration import (
 )
 from ._clexmonte_functions import (
     enforce_composition,
+    kernel_isa,
+    make_random_number_engine,
 )
 from ._clexmonte_monte_calculator import (
+    AsyncRun,
+    AsyncRunPool,
+    BatchedSamplingFunction,
+    HistogramSamplingFunction,
     MonteCalculator,
     MontePotential,
+    RunControl,
     StateData,
+    TelemetryChannel,
 )
 from ._clexmonte_run_management import (
     Results,
@@ -23,6 +31,7 @@ from ._clexmonte_run_management import (
     SamplingFixtureParams,
 )
 from ._clexmonte_state import (
+    CompactOccupation,
     MonteCarloState,
     StateModifyingFunction,
     StateModifyingFunctionMap,
@@ -30,13 +39,25 @@ from ._clexmonte_state import (
 from ._clexmonte_system import (
     System,
 )
+from ._ConfigGeneratorCache import (
+    CachedConfigGenerator,
+    ConfigGeneratorCache,
+    default_config_generator_cache,
+    make_config_cache_key,
+)
 from ._FixedConfigGenerator import (
     FixedConfigGenerator,
 )
 from ._IncrementalConditionsStateGenerator import (
     IncrementalConditionsStateGenerator,
 )
+from ._MappedTrajectory import (
+    MappedTrajectory,
+)
 from ._RunData import (
     RunData,
     RunDataOutputParams,
 )
+from ._run_series import (
+    run_series,
+)
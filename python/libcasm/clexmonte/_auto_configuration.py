@@ -13,6 +13,10 @@ from ._clexmonte_monte_calculator import MonteCalculator
 from ._clexmonte_state import (
     MonteCarloState,
 )
+from ._ConfigGeneratorCache import (
+    default_config_generator_cache,
+    make_config_cache_key,
+)
 
 
 def scale_supercell(
@@ -61,28 +65,37 @@ def transform_configuration(
     prim_factor_group_index: int,
     config: casmconfig.Configuration,
 ):
-    prim = config.supercell.prim
-    symop = prim.factor_group.elements[prim_factor_group_index]
-    P = prim.xtal_prim.lattice()
-    S1 = config.supercell.superlattice
-    S2 = xtal.make_canonical_lattice(symop * S1)
-    is_superlattice_of, T2 = S2.is_superlattice_of(P)
-    if not is_superlattice_of:
-        raise Exception(
-            "Error in transform_configuration: "
-            "construction of transformed supercell failed"
+    def make_f():
+        prim = config.supercell.prim
+        symop = prim.factor_group.elements[prim_factor_group_index]
+        P = prim.xtal_prim.lattice()
+        S1 = config.supercell.superlattice
+        S2 = xtal.make_canonical_lattice(symop * S1)
+        is_superlattice_of, T2 = S2.is_superlattice_of(P)
+        if not is_superlattice_of:
+            raise Exception(
+                "Error in transform_configuration: "
+                "construction of transformed supercell failed"
+            )
+        supercell = casmconfig.Supercell(
+            prim=prim,
+            transformation_matrix_to_super=np.rint(T2).astype(int),
         )
-    supercell = casmconfig.Supercell(
-        prim=prim,
-        transformation_matrix_to_super=np.rint(T2).astype(int),
-    )
-    return casmconfig.copy_transformed_configuration(
-        prim_factor_group_index=prim_factor_group_index,
-        translation=[0, 0, 0],
+        return casmconfig.copy_transformed_configuration(
+            prim_factor_group_index=prim_factor_group_index,
+            translation=[0, 0, 0],
+            motif=config,
+            supercell=supercell,
+            origin=[0, 0, 0],
+        )
+
+    # each orientation of a motif is only constructed once per process
+    key = make_config_cache_key(
+        "transform",
         motif=config,
-        supercell=supercell,
-        origin=[0, 0, 0],
+        prim_factor_group_index=prim_factor_group_index,
     )
+    return default_config_generator_cache().get_or_make(key, make_f)
 
 
 class FindMinPotentialConfigs:
@@ -467,21 +480,31 @@ def make_initial_state(
         dirs=dirs,
         min_volume=min_volume,
     )
-    supercell = casmconfig.Supercell(
-        prim=motif.supercell.prim,
-        transformation_matrix_to_super=T,
-    )
-    is_superlattice_of, T = supercell.superlattice.is_superlattice_of(
-        motif.supercell.superlattice
-    )
-    if not is_superlattice_of:
-        raise Exception(
-            "Error in make_initial_state: Failed to tile motif into supercell"
+
+    def make_f():
+        supercell = casmconfig.Supercell(
+            prim=motif.supercell.prim,
+            transformation_matrix_to_super=T,
+        )
+        is_superlattice_of, _ = supercell.superlattice.is_superlattice_of(
+            motif.supercell.superlattice
         )
-    config = casmconfig.copy_configuration(
+        if not is_superlattice_of:
+            raise Exception(
+                "Error in make_initial_state: Failed to tile motif into supercell"
+            )
+        return casmconfig.copy_configuration(
+            motif=motif,
+            supercell=supercell,
+        )
+
+    # the same motif is only tiled into the same supercell once per process
+    key = make_config_cache_key(
+        "tile",
+        transformation_matrix_to_super=T,
         motif=motif,
-        supercell=supercell,
     )
+    config = default_config_generator_cache().get_or_make(key, make_f)
     return (
         MonteCarloState(
             configuration=config,
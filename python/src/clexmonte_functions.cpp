@@ -11,6 +11,8 @@
 #include "pybind11_json/pybind11_json.hpp"
 
 // clexmonte
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+#include "casm/clexmonte/misc/Philox4x32.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/state/enforce_composition.hh"
 #include "casm/clexmonte/system/System.hh"
@@ -170,6 +172,57 @@ PYBIND11_MODULE(_clexmonte_functions, m) {
       py::arg("occ_location") = static_cast<monte::OccLocation *>(nullptr),
       py::arg("engine") = std::nullopt);
 
+  m.def(
+      "make_random_number_engine",
+      [](std::uint64_t seed, std::uint64_t stream) {
+        return clexmonte::make_stream_engine<engine_type>(seed, stream);
+      },
+      R"pbdoc(
+            Make a random number engine seeded for one of many independent
+            streams
+
+            The engine is seeded from values drawn from a Philox4x32-10
+            counter-based generator with key `seed` and stream index `stream`,
+            so engines for different streams, such as one per replica or
+            parallel run, are statistically independent and the whole set is
+            reproducible from `seed`.
+
+            Parameters
+            ----------
+            seed: int
+                The seed shared by all streams, in :math:`[0, 2^{64})`.
+            stream: int = 0
+                The stream index, in :math:`[0, 2^{64})`.
+
+            Returns
+            -------
+            engine: libcasm.monte.RandomNumberEngine
+                The seeded random number engine.
+            )pbdoc",
+      py::arg("seed"), py::arg("stream") = 0);
+
+  m.def(
+      "kernel_isa",
+      []() {
+        return clexmonte::kinetic::to_string(clexmonte::kinetic::kernel_isa());
+      },
+      R"pbdoc(
+            The instruction set variant used by the vectorized kinetic Monte
+            Carlo kernels
+
+            The vectorized kernels (batched event rates and cluster expansion
+            evaluation) are compiled for several instruction sets, and the
+            best variant supported by the CPU is selected on first use. The
+            environment variable ``CASM_CLEXMONTE_KERNEL_ISA`` may be set to
+            "baseline" or "avx2" to limit the variant. All variants give
+            identical results.
+
+            Returns
+            -------
+            kernel_isa: str
+                One of "baseline", "avx2", or "avx512".
+            )pbdoc");
+
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
 #else
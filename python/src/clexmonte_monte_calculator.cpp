@@ -1,4 +1,6 @@
 #include <pybind11/eigen.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -11,14 +13,25 @@
 #include "pybind11_json/pybind11_json.hpp"
 
 // clexmonte/semigrand_canonical
+#include "casm/clexmonte/kinetic/kinetic_events.hh"
 #include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
 #include "casm/clexmonte/monte_calculator/io/json/MonteCalculator_json_io.hh"
+#include "casm/clexmonte/monte_calculator/run_series.hh"
+#include "casm/clexmonte/run/AsyncRunPool.hh"
+#include "casm/clexmonte/run/BatchedSamplingFunction.hh"
+#include "casm/clexmonte/run/HistogramSamplingFunction.hh"
+#include "casm/clexmonte/run/RunControl.hh"
 #include "casm/clexmonte/run/StateModifyingFunction.hh"
+#include "casm/clexmonte/run/TelemetryChannel.hh"
+#include "casm/clexmonte/run/io/json/AutoEquilibration_json_io.hh"
+#include "casm/clexmonte/run/io/json/RunData_json_io.hh"
 #include "casm/clexmonte/run/io/json/RunParams_json_io.hh"
+#include "casm/clexmonte/state/Configuration.hh"
 #include "casm/monte/RandomNumberGenerator.hh"
 #include "casm/monte/run_management/RunManager.hh"
 #include "casm/monte/run_management/io/json/SamplingFixtureParams_json_io.hh"
 #include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
 
 #define STRINGIFY(x) #x
 #define MACRO_STRINGIFY(x) STRINGIFY(x)
@@ -33,6 +46,10 @@ CASM::clexmonte::BaseMonteCalculator *make_SemiGrandCanonicalCalculator();
 /// \brief Returns a clexmonte::BaseMonteCalculator* owning a
 /// CanonicalCalculator
 CASM::clexmonte::BaseMonteCalculator *make_CanonicalCalculator();
+
+/// \brief Returns a clexmonte::BaseMonteCalculator* owning a
+/// KineticCalculator
+CASM::clexmonte::BaseMonteCalculator *make_KineticCalculator();
 }
 
 /// CASM - Python binding code
@@ -86,6 +103,16 @@ std::shared_ptr<clexmonte::MonteCalculator> make_shared_CanonicalCalculator(
       lib);
 }
 
+std::shared_ptr<clexmonte::MonteCalculator> make_shared_KineticCalculator(
+    jsonParser const &params, std::shared_ptr<system_type> system) {
+  std::shared_ptr<RuntimeLibrary> lib = nullptr;
+  return clexmonte::make_monte_calculator(
+      params, system,
+      std::unique_ptr<clexmonte::BaseMonteCalculator>(
+          make_KineticCalculator()),
+      lib);
+}
+
 std::shared_ptr<clexmonte::StateData> make_state_data(
     std::shared_ptr<system_type> system, state_type &state,
     monte::OccLocation *occ_location) {
@@ -105,6 +132,8 @@ std::shared_ptr<clexmonte::MonteCalculator> make_monte_calculator(
     return make_shared_SemiGrandCanonicalCalculator(_params, system);
   } else if (method == "canonical") {
     return make_shared_CanonicalCalculator(_params, system);
+  } else if (method == "kinetic") {
+    return make_shared_KineticCalculator(_params, system);
   } else {
     std::stringstream msg;
     msg << "Error in make_monte_calculator: method='" << method
@@ -113,12 +142,34 @@ std::shared_ptr<clexmonte::MonteCalculator> make_monte_calculator(
   }
 }
 
+/// \brief Pickle a MonteCalculator as (method, system, params)
+///
+/// \throws If `calculator` was not constructed with a built-in method
+py::tuple monte_calculator_getstate(
+    std::shared_ptr<clexmonte::MonteCalculator> const &calculator) {
+  static std::map<std::string, std::string> const methods = {
+      {"SemiGrandCanonicalCalculator", "semigrand_canonical"},
+      {"CanonicalCalculator", "canonical"},
+      {"KineticCalculator", "kinetic"}};
+  auto it = methods.find(calculator->calculator_name());
+  if (it == methods.end()) {
+    std::stringstream msg;
+    msg << "Error pickling libcasm.clexmonte.MonteCalculator: calculator '"
+        << calculator->calculator_name()
+        << "' is not a built-in method and cannot be pickled";
+    throw std::runtime_error(msg.str());
+  }
+  return py::make_tuple(it->second, py::cast(calculator->system()),
+                        static_cast<nlohmann::json>(calculator->params()));
+}
+
 std::shared_ptr<clexmonte::MonteCalculator> make_custom_monte_calculator(
     std::shared_ptr<system_type> system, std::string source,
     std::optional<nlohmann::json> params,
     std::optional<std::string> compile_options,
     std::optional<std::string> so_options,
-    std::optional<std::vector<std::string>> search_path) {
+    std::optional<std::vector<std::string>> search_path,
+    std::optional<std::string> cache_dir) {
   // fs::path dirpath, std::string calculator_name
 
   jsonParser _params = jsonParser::object();
@@ -134,7 +185,10 @@ std::shared_ptr<clexmonte::MonteCalculator> make_custom_monte_calculator(
     json["compile_options"] = compile_options.value();
   }
   if (so_options.has_value()) {
-    json["so_options"] = compile_options.value();
+    json["so_options"] = so_options.value();
+  }
+  if (cache_dir.has_value()) {
+    json["cache_dir"] = cache_dir.value();
   }
 
   std::vector<fs::path> _search_path;
@@ -159,11 +213,285 @@ std::shared_ptr<run_manager_type> monte_calculator_run(
   std::unique_ptr<monte::OccLocation> tmp;
   make_temporary_if_necessary(state, occ_location, tmp, self);
 
-  // run
-  self.run(state, *occ_location, *run_manager);
+  // run, without holding the GIL; Python-defined sampling functions,
+  // analysis functions, and modifiers are wrapped by pybind11 so that they
+  // reacquire the GIL when called
+  {
+    py::gil_scoped_release release;
+    self.run(state, *occ_location, *run_manager);
+  }
+  return run_manager;
+}
+
+/// \brief Python handle of a run started by `MonteCalculator.run_async`
+struct AsyncRunHandle {
+  std::shared_ptr<clexmonte::AsyncRun> run;
+  std::shared_ptr<run_manager_type> run_manager;
+};
+
+/// \brief Shares a Python object with C++ owners that may be destroyed
+///     without the GIL
+std::shared_ptr<py::object> make_gil_safe_shared(py::object obj) {
+  return std::shared_ptr<py::object>(new py::object(std::move(obj)),
+                                     [](py::object *ptr) {
+                                       py::gil_scoped_acquire acquire;
+                                       delete ptr;
+                                     });
+}
+
+std::shared_ptr<clexmonte::AsyncRunPool> make_async_run_pool(
+    std::optional<Index> n_workers) {
+  Index _n_workers = n_workers.has_value()
+                         ? n_workers.value()
+                         : std::max(1u, std::thread::hardware_concurrency());
+  // the destructor waits for running runs, which may need the GIL
+  return std::shared_ptr<clexmonte::AsyncRunPool>(
+      new clexmonte::AsyncRunPool(_n_workers),
+      [](clexmonte::AsyncRunPool *ptr) {
+        if (PyGILState_Check()) {
+          py::gil_scoped_release release;
+          delete ptr;
+        } else {
+          delete ptr;
+        }
+      });
+}
+
+/// \brief Pool used by `run_async` if none is given
+///
+/// Never destroyed, so that interpreter shutdown does not wait for runs.
+std::shared_ptr<clexmonte::AsyncRunPool> default_async_run_pool() {
+  static auto *pool = new std::shared_ptr<clexmonte::AsyncRunPool>(
+      make_async_run_pool(std::nullopt));
+  return *pool;
+}
+
+std::shared_ptr<AsyncRunHandle> monte_calculator_run_async(
+    py::object self_obj, py::object state_obj, py::object run_manager_obj,
+    py::object occ_location_obj, std::shared_ptr<clexmonte::AsyncRunPool> pool,
+    std::shared_ptr<clexmonte::TelemetryChannel> telemetry) {
+  auto *self = self_obj.cast<calculator_type *>();
+  auto *state = state_obj.cast<state_type *>();
+  auto run_manager =
+      run_manager_obj.cast<std::shared_ptr<run_manager_type>>();
+  monte::OccLocation *occ_location = nullptr;
+  if (!occ_location_obj.is_none()) {
+    occ_location = occ_location_obj.cast<monte::OccLocation *>();
+  }
+
+  // Need to check for an OccLocation; it is made now, so that errors are
+  // raised by `run_async`
+  std::unique_ptr<monte::OccLocation> tmp;
+  make_temporary_if_necessary(*state, occ_location, tmp, *self);
+  std::shared_ptr<monte::OccLocation> tmp_occ_location(std::move(tmp));
+
+  // the run is stopped on cancellation by a RunControl; if the calculator
+  // does not have one, one that never changes the completion checks is used
+  std::shared_ptr<clexmonte::RunControl> run_control = self->run_control();
+  if (run_control) {
+    run_control->clear_stop_request();
+  } else {
+    run_control = std::make_shared<clexmonte::RunControl>(
+        [](clexmonte::results_type const &results) {
+          return clexmonte::RunControlAction::proceed;
+        });
+  }
+  if (!telemetry) {
+    telemetry = self->telemetry();
+  }
+  if (!pool) {
+    pool = default_async_run_pool();
+  }
+
+  // the Python objects are kept alive until the run is done
+  auto keep_alive = make_gil_safe_shared(
+      py::make_tuple(self_obj, state_obj, run_manager_obj, occ_location_obj));
+  auto run = [=]() {
+    (void)keep_alive;
+    (void)tmp_occ_location;
+    auto prev_run_control = self->run_control();
+    auto prev_telemetry = self->telemetry();
+    self->set_run_control(run_control);
+    self->set_telemetry(telemetry);
+    try {
+      self->run(*state, *occ_location, *run_manager);
+    } catch (...) {
+      self->set_run_control(prev_run_control);
+      self->set_telemetry(prev_telemetry);
+      throw;
+    }
+    self->set_run_control(prev_run_control);
+    self->set_telemetry(prev_telemetry);
+  };
+  auto handle = std::make_shared<AsyncRunHandle>();
+  handle->run =
+      std::make_shared<clexmonte::AsyncRun>(run, run_control, telemetry);
+  handle->run_manager = run_manager;
+  pool->submit(handle->run);
+  return handle;
+}
+
+/// \brief Wait for a run, without holding the GIL
+///
+/// \returns True if the run is done
+bool async_run_wait(AsyncRunHandle const &self, std::optional<double> timeout) {
+  py::gil_scoped_release release;
+  if (!timeout.has_value()) {
+    self.run->wait();
+    return true;
+  }
+  return self.run->wait_for(timeout.value());
+}
+
+/// \brief Return the run manager of a finished run, or raise the exception
+///     that ended a failed run, or `concurrent.futures.CancelledError` for a
+///     cancelled run
+std::shared_ptr<run_manager_type> async_run_result(
+    AsyncRunHandle const &self, std::optional<double> timeout) {
+  if (!async_run_wait(self, timeout)) {
+    py::object error_type =
+        py::module_::import("concurrent.futures").attr("TimeoutError");
+    PyErr_SetString(error_type.ptr(), "run is not done");
+    throw py::error_already_set();
+  }
+  self.run->rethrow_if_failed();
+  if (self.run->status() == clexmonte::AsyncRunStatus::cancelled) {
+    py::object error_type =
+        py::module_::import("concurrent.futures").attr("CancelledError");
+    PyErr_SetString(error_type.ptr(), "run was cancelled");
+    throw py::error_already_set();
+  }
+  return self.run_manager;
+}
+
+void async_run_add_done_callback(std::shared_ptr<AsyncRunHandle> self,
+                                 py::function function) {
+  // the callback owns the handle until the run is done
+  auto f = make_gil_safe_shared(function);
+  self->run->add_done_callback([f, self]() {
+    py::gil_scoped_acquire acquire;
+    try {
+      (*f)(self);
+    } catch (py::error_already_set &e) {
+      e.discard_as_unraisable("AsyncRun done callback");
+    }
+  });
+}
+
+/// \brief Make a `concurrent.futures.Future` that is completed when a run is
+///     done
+///
+/// Cancelling the future cancels the run.
+py::object async_run_as_concurrent_future(
+    std::shared_ptr<AsyncRunHandle> self) {
+  py::object future =
+      py::module_::import("concurrent.futures").attr("Future")();
+  std::weak_ptr<clexmonte::AsyncRun> weak_run = self->run;
+  future.attr("add_done_callback")(py::cpp_function([weak_run](py::object f) {
+    auto run = weak_run.lock();
+    if (run && f.attr("cancelled")().cast<bool>()) {
+      run->cancel();
+    }
+  }));
+  auto _future = make_gil_safe_shared(future);
+  self->run->add_done_callback([self, _future]() {
+    py::gil_scoped_acquire acquire;
+    py::object &future = *_future;
+    if (future.attr("done")().cast<bool>()) {
+      return;
+    }
+    if (self->run->status() == clexmonte::AsyncRunStatus::cancelled) {
+      future.attr("cancel")();
+      return;
+    }
+    try {
+      self->run->rethrow_if_failed();
+      future.attr("set_result")(self->run_manager);
+    } catch (py::error_already_set &e) {
+      future.attr("set_exception")(e.value());
+    } catch (std::exception &e) {
+      future.attr("set_exception")(
+          py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(e.what()));
+    }
+  });
+  return future;
+}
+
+std::shared_ptr<run_manager_type> monte_calculator_run_parallel_chains(
+    calculator_type &self, state_type &state,
+    std::shared_ptr<run_manager_type> run_manager, Index n_chains) {
+  if (n_chains < 1) {
+    throw std::runtime_error(
+        "Error in MonteCalculator.run_parallel_chains: n_chains < 1");
+  }
+  std::vector<state_type> states(n_chains, state);
+  std::vector<monte::OccLocation> occ_locations;
+  for (auto &chain_state : states) {
+    monte::OccLocation *occ_location = nullptr;
+    std::unique_ptr<monte::OccLocation> tmp;
+    make_temporary_if_necessary(chain_state, occ_location, tmp, self);
+    occ_locations.push_back(*occ_location);
+  }
+
+  // run, without holding the GIL
+  {
+    py::gil_scoped_release release;
+    self.run_parallel_chains(states, occ_locations, *run_manager);
+  }
+
+  // Leave the final state of the first chain as the current state
+  state = states[0];
+  self.set_state_and_potential(state, nullptr);
   return run_manager;
 }
 
+nlohmann::json monte_calculator_run_wang_landau(
+    calculator_type &self, state_type &state, double energy_min,
+    double energy_max, double bin_width, Index n_windows,
+    double window_overlap, double flatness, double ln_f_final,
+    bool one_over_t, Index check_period, Index max_passes,
+    std::shared_ptr<engine_type> engine) {
+  if (!engine) {
+    engine = std::make_shared<engine_type>();
+    std::random_device device;
+    engine->seed(device());
+  }
+  clexmonte::WangLandauParams params;
+  params.energy_min = energy_min;
+  params.energy_max = energy_max;
+  params.bin_width = bin_width;
+  params.n_windows = n_windows;
+  params.window_overlap = window_overlap;
+  params.flatness = flatness;
+  params.ln_f_final = ln_f_final;
+  params.one_over_t = one_over_t;
+  params.check_period = check_period;
+  params.max_passes = max_passes;
+
+  std::vector<state_type> states(n_windows, state);
+  std::vector<monte::OccLocation> occ_locations;
+  for (auto &walker_state : states) {
+    monte::OccLocation *occ_location = nullptr;
+    std::unique_ptr<monte::OccLocation> tmp;
+    make_temporary_if_necessary(walker_state, occ_location, tmp, self);
+    occ_locations.push_back(*occ_location);
+  }
+
+  // run, without holding the GIL
+  {
+    py::gil_scoped_release release;
+    self.run_wang_landau(states, occ_locations, params, engine);
+  }
+
+  // Leave the final state of the first walker as the current state
+  state = states[0];
+  self.set_state_and_potential(state, nullptr);
+
+  jsonParser json;
+  to_json(self.wang_landau_results(), json);
+  return static_cast<nlohmann::json>(json);
+}
+
 std::shared_ptr<sampling_fixture_type> monte_calculator_run_fixture(
     calculator_type &self, state_type &state,
     sampling_fixture_params_type &sampling_fixture_params,
@@ -184,6 +512,151 @@ std::shared_ptr<sampling_fixture_type> monte_calculator_run_fixture(
   return run_manager->sampling_fixtures.at(0);
 }
 
+nlohmann::json monte_calculator_run_series(
+    std::shared_ptr<calculator_type> &self,
+    nlohmann::json const &state_generation,
+    std::vector<sampling_fixture_params_type> const &sampling_fixture_params,
+    std::shared_ptr<engine_type> engine, Index n_threads, bool global_cutoff,
+    std::vector<sampling_fixture_params_type> const &before_first_run,
+    std::vector<sampling_fixture_params_type> const &before_each_run,
+    std::optional<nlohmann::json> const &auto_equilibration) {
+  if (!engine) {
+    engine = std::make_shared<engine_type>();
+    std::random_device device;
+    engine->seed(device());
+  }
+  jsonParser state_generation_json{state_generation};
+  std::unique_ptr<clexmonte::state_generator_type> state_generator =
+      clexmonte::monte_calculator::make_state_generator(state_generation_json,
+                                                        self);
+  std::shared_ptr<clexmonte::AutoEquilibration> _auto_equilibration;
+  if (auto_equilibration.has_value()) {
+    jsonParser auto_equilibration_json{*auto_equilibration};
+    InputParser<clexmonte::AutoEquilibrationParams> parser(
+        auto_equilibration_json);
+    std::runtime_error error_if_invalid{
+        "Error in MonteCalculator.run_series: invalid auto_equilibration"};
+    report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+    _auto_equilibration =
+        std::make_shared<clexmonte::AutoEquilibration>(*parser.value);
+  }
+
+  // run, without holding the GIL
+  std::vector<clexmonte::RunData> completed_runs;
+  {
+    py::gil_scoped_release release;
+    completed_runs = clexmonte::monte_calculator::run_series(
+        self, engine, *state_generator, sampling_fixture_params,
+        global_cutoff, before_first_run, before_each_run, n_threads,
+        _auto_equilibration);
+  }
+
+  jsonParser json = jsonParser::array();
+  for (clexmonte::RunData const &run_data : completed_runs) {
+    jsonParser run_data_json;
+    bool write_initial_states = true;
+    bool write_final_states = true;
+    to_json(run_data, run_data_json, write_initial_states, write_final_states);
+    json.push_back(run_data_json);
+  }
+  return static_cast<nlohmann::json>(json);
+}
+
+std::shared_ptr<clexmonte::BatchedSamplingFunction>
+make_batched_sampling_function(
+    std::string name, std::string description,
+    std::vector<std::string> component_names, Index batch_size,
+    clexmonte::BatchedSamplingFunction::batch_function_type function,
+    std::shared_ptr<calculator_type> calculator) {
+  if (!calculator) {
+    throw std::runtime_error(
+        "Error constructing BatchedSamplingFunction: calculator is None");
+  }
+  auto get_occupation = [calculator]() -> Eigen::VectorXi const & {
+    return clexmonte::get_occupation(*calculator->state_data()->state);
+  };
+  return std::make_shared<clexmonte::BatchedSamplingFunction>(
+      name, description, component_names, batch_size, function,
+      get_occupation);
+}
+
+std::shared_ptr<clexmonte::HistogramSamplingFunction>
+make_histogram_sampling_function(monte::StateSamplingFunction source,
+                                 std::optional<std::string> name,
+                                 std::optional<double> min,
+                                 std::optional<double> max, Index n_bins,
+                                 std::optional<double> bin_width,
+                                 Index max_bins) {
+  if (!name.has_value()) {
+    name = source.name + ".histogram";
+  }
+  std::string description = "Histogram of " + source.name;
+  if (min.has_value() && max.has_value()) {
+    return std::make_shared<clexmonte::HistogramSamplingFunction>(
+        *name, description, source,
+        clexmonte::HistogramAccumulator(*min, *max, n_bins));
+  }
+  if (min.has_value() || max.has_value() || !bin_width.has_value()) {
+    throw std::runtime_error(
+        "Error constructing HistogramSamplingFunction: requires either "
+        "`min` and `max`, for fixed bins, or `bin_width`, for adaptive bins");
+  }
+  return std::make_shared<clexmonte::HistogramSamplingFunction>(
+      *name, description, source,
+      clexmonte::HistogramAccumulator::adaptive(*bin_width, max_bins));
+}
+
+py::dict telemetry_record_to_dict(
+    clexmonte::TelemetryRecord const &record,
+    std::vector<std::string> const &sampler_names) {
+  py::dict sampled_values;
+  for (Index i = 0; i < Index(sampler_names.size()); ++i) {
+    if (record.sampled_values[i].size()) {
+      sampled_values[py::str(sampler_names[i])] = record.sampled_values[i];
+    }
+  }
+  py::dict d;
+  d["run_index"] = record.run_index;
+  d["sampling_fixture_label"] = record.sampling_fixture_label;
+  d["n_steps"] = record.n_steps;
+  d["n_passes"] = record.n_passes;
+  d["n_accept"] = record.n_accept;
+  d["n_reject"] = record.n_reject;
+  d["acceptance_rate"] = record.acceptance_rate;
+  d["clocktime"] = record.clocktime;
+  d["events_per_s"] = record.events_per_s;
+  d["n_samples"] = record.n_samples;
+  d["sampled_values"] = sampled_values;
+  d["all_equilibrated"] = record.all_equilibrated;
+  d["all_converged"] = record.all_converged;
+  d["is_complete"] = record.is_complete;
+  d["is_final"] = record.is_final;
+  return d;
+}
+
+std::shared_ptr<clexmonte::RunControl> make_run_control(
+    py::function function, std::string sampling_fixture_label) {
+  // the predicate may be copied and destroyed without the GIL, by
+  // `MonteCalculator::make_independent_copy`, so the Python function is
+  // shared and only released while holding the GIL
+  std::shared_ptr<py::function> f(new py::function(function),
+                                  [](py::function *ptr) {
+                                    py::gil_scoped_acquire acquire;
+                                    delete ptr;
+                                  });
+  auto predicate = [f](clexmonte::results_type const &results) {
+    py::gil_scoped_acquire acquire;
+    py::object action =
+        (*f)(py::cast(&results, py::return_value_policy::reference));
+    if (action.is_none()) {
+      return clexmonte::RunControlAction::proceed;
+    }
+    return clexmonte::run_control_action_from_name(action.cast<std::string>());
+  };
+  return std::make_shared<clexmonte::RunControl>(predicate,
+                                                 sampling_fixture_label);
+}
+
 }  // namespace CASMpy
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>);
@@ -402,12 +875,96 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
               The order parameter calculator for `key`, set to calculate for
               the current state.
           )pbdoc",
+          py::arg("key"))
+      .def(
+          "set_parallel_corr",
+          [](clexmonte::StateData &m, Index n_threads) {
+            clexmonte::set_parallel_corr(m, n_threads);
+          },
+          R"pbdoc(
+          Calculate full supercell correlations using multiple threads
+
+          Unit cells are partitioned into fixed blocks, and the sums over
+          blocks are added in block order, so results do not depend on the
+          number of threads and differ from the single-threaded calculation
+          only by round-off. Once set, :func:`StateData.per_supercell_corr`,
+          :func:`StateData.per_supercell_clex`, and the "corr.<key>" and
+          "clex.<key>" sampling functions use multiple threads when they
+          calculate values for the full supercell.
+
+          Parameters
+          ----------
+          n_threads : int
+              Number of threads. If <= 1, correlations are calculated on the
+              calling thread.
+          )pbdoc",
+          py::arg("n_threads"))
+      .def(
+          "per_supercell_corr",
+          [](clexmonte::StateData &m, std::string key) -> Eigen::VectorXd {
+            auto it = m.parallel_corr.find(key);
+            if (it != m.parallel_corr.end()) {
+              return it->second->per_supercell();
+            }
+            return m.corr.at(key)->per_supercell();
+          },
+          R"pbdoc(
+          Calculate correlations for the full supercell
+
+          Uses multiple threads if set by :func:`StateData.set_parallel_corr`.
+
+          Parameters
+          ----------
+          key : str
+              Basis set name
+
+          Returns
+          -------
+          corr : np.ndarray[np.float64]
+              The correlations of the current state, normalized per
+              supercell.
+          )pbdoc",
+          py::arg("key"))
+      .def(
+          "per_supercell_clex",
+          [](clexmonte::StateData &m, std::string key) -> double {
+            auto const &data = clexmonte::get_clex_data(*m.system, key);
+            auto it = m.parallel_corr.find(data.basis_set_name);
+            if (it != m.parallel_corr.end()) {
+              return it->second->per_supercell(data.coefficients);
+            }
+            return m.clex.at(key)->per_supercell();
+          },
+          R"pbdoc(
+          Calculate a cluster expansion value for the full supercell
+
+          Uses multiple threads if set by :func:`StateData.set_parallel_corr`.
+
+          Parameters
+          ----------
+          key : str
+              Cluster expansion name
+
+          Returns
+          -------
+          value : float
+              The cluster expansion value of the current state, normalized
+              per supercell.
+          )pbdoc",
           py::arg("key"));
 
   py::class_<calculator_type, std::shared_ptr<calculator_type>>
       pyMonteCalculator(m, "MonteCalculator",
                         R"pbdoc(
       Interface for running Monte Carlo calculations
+
+      .. rubric:: Special Methods
+
+      - A MonteCalculator constructed with a built-in `method` may be pickled,
+        for use with `multiprocessing` or `concurrent.futures`. It is pickled
+        as its method, system, and parameters, so the unpickled calculator
+        has the standard sampling, analysis, and modifying functions, and no
+        current state.
       )pbdoc");
 
   py::class_<potential_type>(m, "MontePotential",
@@ -464,7 +1021,48 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
               The change in potential per supercell from the current state
               to the state with the new occupation.
           )pbdoc",
-           py::arg("linear_site_index"), py::arg("new_occ"));
+           py::arg("linear_site_index"), py::arg("new_occ"))
+      .def(
+          "occ_delta_per_supercell_batch",
+          [](potential_type &self,
+             Eigen::Ref<potential_type::site_index_batch_type const> const
+                 &linear_site_index,
+             Eigen::Ref<potential_type::occ_batch_type const> const &new_occ)
+              -> Eigen::VectorXd {
+            Eigen::VectorXd delta(linear_site_index.rows());
+            py::gil_scoped_release release;
+            self.occ_delta_per_supercell_batch(linear_site_index, new_occ,
+                                               delta);
+            return delta;
+          },
+          R"pbdoc(
+          Calculate the change in potential per supercell of many independent
+          events in one call
+
+          Each event is evaluated relative to the current state, as by
+          :func:`~MontePotential.occ_delta_per_supercell`, without the
+          per-call overhead of the Python bindings. The GIL is released
+          while events are evaluated, but the potential must not be used or
+          the state modified from other threads in the meantime.
+
+          Parameters
+          ----------
+          linear_site_index: np.ndarray[np.int64]
+              The linear site indices of the sites changing occupation, with
+              shape ``(n_events, n_sites)`` and one row per event. Entries
+              < 0 are ignored, so events changing fewer than `n_sites` sites
+              may be padded with -1.
+          new_occ: np.ndarray[np.int32]
+              The new occupation indices on the sites, with the same shape
+              as `linear_site_index`.
+
+          Returns
+          -------
+          delta: np.ndarray[np.float64]
+              The change in potential per supercell of each event, with
+              shape ``(n_events,)``.
+          )pbdoc",
+          py::arg("linear_site_index"), py::arg("new_occ"));
 
   pyMonteCalculator
       .def(py::init<>(&make_monte_calculator),
@@ -484,7 +1082,10 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
                 `"param_composition"` or `"mol_composition"` conditions.
               - TODO "lte": `Low-temperature expansion <todo>`_, for the
                 semi-grand canonical ensemble
-              - TODO "kinetic": `Kinetic Monte Carlo <todo>`_
+              - "kinetic": `Kinetic Monte Carlo <todo>`_.
+                Input states require `"temperature"` and one of
+                `"param_composition"` or `"mol_composition"` conditions.
+                The system requires KMC events.
               - TODO "flex": Allows a range of custom potentials, including
                 composition and order parameter variance-constrained potentials,
                 and correlation-matching potentials
@@ -501,10 +1102,29 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
 
               - "enumeration": `Save states <todo>`_ encountered during the
                 calculation.
+              - For "kinetic", the KMC options "event_selector" (event
+                selector method), "event_list_params" (impact table and
+                event storage layout), "n_threads", "event_filters",
+                "split_impact_neighborhoods", "local_environment_cache_size",
+                "store_event_states", "active_event_set", "barrier_models",
+                and "event_data_cache_size_mb".
 
           )pbdoc",
            py::arg("method"), py::arg("system"),
            py::arg("params") = std::nullopt)
+      .def(py::pickle(
+          &monte_calculator_getstate,
+          [](py::tuple t) {
+            if (t.size() != 3) {
+              throw std::runtime_error(
+                  "Error unpickling libcasm.clexmonte.MonteCalculator: "
+                  "invalid state");
+            }
+            return make_monte_calculator(
+                t[0].cast<std::string>(),
+                t[1].cast<std::shared_ptr<system_type>>(),
+                t[2].cast<nlohmann::json>());
+          }))
       .def(
           "make_default_sampling_fixture_params",
           [](std::shared_ptr<calculator_type> &self, std::string label,
@@ -564,6 +1184,14 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
               expansion basis functions with non-zero coefficients (using
               multiclex key),
 
+          - Other standard analysis functions which are not included by
+            default are:
+
+            - "eci_ensemble.<key>": Formation energy of each coefficient set
+              of a multi-cluster expansion, reweighted from samples of
+              "clex.formation_energy" (using multiclex key; requires sampling
+              "clex.formation_energy" and "multiclex.<key>"),
+
 
           Parameters
           ----------
@@ -605,6 +1233,59 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           py::arg("output_dir") = std::nullopt,
           py::arg("log_file") = std::nullopt,
           py::arg("log_frequency_in_s") = 600.0)
+      .def(
+          "make_screening_sampling_fixture_params",
+          [](std::shared_ptr<calculator_type> &self, std::string label,
+             bool write_results, std::optional<std::string> output_dir)
+              -> sampling_fixture_params_type {
+            return self->make_screening_sampling_fixture_params(
+                self, label, write_results, output_dir);
+          },
+          R"pbdoc(
+          Construct lean sampling fixture parameters for fast screening runs
+
+          Notes
+          -----
+
+          Screening fixtures are meant for running many short calculations,
+          such as for phase boundary screening, at close to the speed of the
+          Monte Carlo steps themselves:
+
+          - Sampling occurs linearly, by pass, with period 1, for only:
+
+            - "mol_composition": Mol composition, :math:`\vec{n}`, per unitcell
+            - "potential_energy": Potential energy, per unitcell
+
+            During a run, both are tracked incrementally as events are
+            applied, so sampling cost does not depend on the supercell size.
+
+          - No convergence is requested and no analysis functions are
+            evaluated, so cutoffs must be set (i.e.
+            ``completion_check_params.cutoff_params.max_count``).
+          - No status, trajectory, or observations files are written. Results
+            are written once the run is complete, if `write_results`.
+
+          Currently only the "semigrand_canonical" calculator provides
+          screening sampling fixture parameters.
+
+          Parameters
+          ----------
+          label: str
+              Label for the :class:`SamplingFixture`.
+          write_results: bool = True
+              If True, write results to summary file upon completion. If a
+              results summary file already exists, the new results are appended.
+          output_dir: Optional[str] = None
+              Directory in which write results. If None, uses
+              ``"output" / label``.
+
+          Returns
+          -------
+          sampling_fixture_params: libcasm.clexmonte.SamplingFixtureParams
+              Screening sampling fixture parameters.
+          )pbdoc",
+          py::arg("label"), py::arg("write_results") = true,
+          py::arg("output_dir") = std::nullopt)
       .def(
           "make_sampling_fixture_params_from_dict",
           [](std::shared_ptr<calculator_type> &self, const nlohmann::json &data,
@@ -684,9 +1365,212 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           -------
           run_manager: libcasm.clexmonte.RunManager
               The input `run_manager` with collected results.
+
+          Notes
+          -----
+          The GIL is released for the duration of the run and reacquired only
+          to call Python-defined sampling functions, analysis functions, and
+          state modifying functions, so other Python threads may run
+          concurrently. Those functions are called from the thread that
+          called `run`. While a run is in progress, other threads must not
+          access or modify this calculator, `state`, `occ_location`, or
+          `run_manager`, or any objects they reference. Independent runs may
+          be performed concurrently from separate threads using separate
+          calculators, states, occupant location lists, and run managers.
           )pbdoc",
            py::arg("state"), py::arg("run_manager"),
            py::arg("occ_location") = static_cast<monte::OccLocation *>(nullptr))
+      .def("run_async", &monte_calculator_run_async,
+           R"pbdoc(
+          Start a single run on a worker thread, and return immediately
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              The input state.
+          run_manager: libcasm.clexmonte.RunManager
+              Specifies sampling and convergence criteria and collects results
+          occ_location: Optional[libcasm.monte.events.OccLocation] = None
+              Current occupant location list. If provided, the user is
+              responsible for ensuring it is up-to-date with the current
+              occupation of `state` and it is used and updated during the run.
+              If None, a occupant location list is generated now.
+          pool: Optional[AsyncRunPool] = None
+              The pool whose workers perform the run. If None, a shared pool
+              with one worker per hardware thread is used.
+          telemetry: Optional[TelemetryChannel] = None
+              If not None, :py:attr:`MonteCalculator.telemetry` is set to
+              this channel for the duration of the run. Otherwise, the
+              calculator's current channel, if any, is used.
+
+          Returns
+          -------
+          run: AsyncRun
+              A handle to the run, which can be waited for, cancelled, and
+              awaited, and whose :py:attr:`~AsyncRun.telemetry` reports
+              progress.
+
+          Notes
+          -----
+          The run is the same as :func:`MonteCalculator.run`, performed on a
+          worker thread of `pool`. Until the run is done, other threads must
+          not access or modify this calculator, `state`, `occ_location`, or
+          `run_manager`, or any objects they reference. Concurrent runs must
+          use separate calculators, states, occupant location lists, and run
+          managers.
+
+          Cancelling a run in progress is done by
+          :py:attr:`MonteCalculator.run_control`, so it only stops methods
+          that honor a RunControl (single state Metropolis runs); other runs
+          can only be cancelled before they start. If the calculator does
+          not have a RunControl, one that does not change the completion
+          checks is set for the duration of the run. If it does, a previous
+          stop request is cleared when the run is started.
+          )pbdoc",
+           py::arg("state"), py::arg("run_manager"),
+           py::arg("occ_location") = py::none(),
+           py::arg("pool") = py::none(), py::arg("telemetry") = py::none())
+      .def("run_parallel_chains", &monte_calculator_run_parallel_chains,
+           R"pbdoc(
+          Perform a run of independent chains of the input state, with pooled
+          observations
+
+          Each chain starts from a copy of `state`, at the same conditions,
+          and has its own random number stream and occupant location list.
+          Chains are evolved concurrently, using up to "n_threads" threads
+          (a calculator parameter), and all chains are sampled by
+          `run_manager`, so the completion check uses the pooled
+          observations. With `n_chains` chains on idle cores, a requested
+          precision is reached in roughly `1 / n_chains` of the time, after
+          the equilibration of each chain.
+
+          Samples are taken at the end of each pass, so sampling periods
+          should be a whole number of passes and a multiple of `n_chains`.
+          Consecutive observations come from different chains, so sampling
+          periods should be longer than the correlation time of a chain for
+          precision estimates to be reliable.
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              The input state. On return, it is set to the final state of
+              the first chain.
+          run_manager: libcasm.clexmonte.RunManager
+              Specifies sampling and convergence criteria and collects the
+              pooled results.
+          n_chains: int
+              The number of independent chains.
+
+          Returns
+          -------
+          run_manager: libcasm.clexmonte.RunManager
+              The input `run_manager` with collected results.
+          )pbdoc",
+           py::arg("state"), py::arg("run_manager"), py::arg("n_chains"))
+      .def("run_wang_landau", &monte_calculator_run_wang_landau,
+           R"pbdoc(
+          Estimate the density of states of the potential energy by
+          Wang-Landau sampling
+
+          The energy range is split into `n_windows` overlapping windows,
+          each sampled by one walker starting from a copy of `state`. Each
+          walker first moves to its window, then performs flat-histogram
+          sampling until the modification factor, :math:`\ln f`, is smaller
+          than `ln_f_final`. Walkers are evolved concurrently, using up to
+          "n_threads" threads (a calculator parameter), and the windows are
+          joined at the end. One run gives thermodynamic averages at all
+          temperatures, rather than one run per temperature (see
+          :func:`~MonteCalculator.wang_landau_thermodynamics`).
+
+          Currently only the "canonical" calculator allows Wang-Landau runs.
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              The input state, which sets the composition. On return, it is
+              set to the final state of the first walker.
+          energy_min: float
+              Lower bound of the energy range, normalized per unit cell.
+          energy_max: float
+              Upper bound of the energy range, normalized per unit cell.
+          bin_width: float
+              Width of the energy bins, normalized per unit cell.
+          n_windows: int = 1
+              Number of energy windows, and walkers.
+          window_overlap: float = 0.5
+              Fraction of the bins of a window shared with the next window.
+          flatness: float = 0.8
+              A histogram is flat when the smallest count of its visited bins
+              is at least `flatness` times their mean count.
+          ln_f_final: float = 1e-6
+              Walkers are done when :math:`\ln f` is smaller than this.
+          one_over_t: bool = True
+              If True, use the :math:`1/t` schedule for :math:`\ln f` once it
+              is smaller than the number of bins of a window divided by its
+              number of steps.
+          check_period: int = 10
+              Number of passes between histogram flatness checks.
+          max_passes: int = 0
+              If > 0, the maximum number of passes of each walker.
+          engine: Optional[libcasm.monte.RandomNumberEngine] = None
+              Random number engine, used to seed the walkers. If None, a
+              random number engine is constructed and seeded using
+              std::random_device.
+
+          Returns
+          -------
+          results: dict
+              The density of states, with "energy", the energy of each
+              visited bin, "ln_g", the logarithm of the density of states of
+              each visited bin, up to a constant, and "windows", a summary of
+              each window.
+          )pbdoc",
+           py::arg("state"), py::arg("energy_min"), py::arg("energy_max"),
+           py::arg("bin_width"), py::arg("n_windows") = 1,
+           py::arg("window_overlap") = 0.5, py::arg("flatness") = 0.8,
+           py::arg("ln_f_final") = 1e-6, py::arg("one_over_t") = true,
+           py::arg("check_period") = 10, py::arg("max_passes") = 0,
+           py::arg("engine") = nullptr)
+      .def(
+          "wang_landau_thermodynamics",
+          [](calculator_type &self, std::vector<double> const &temperatures) {
+            std::vector<double> energy;
+            std::vector<double> heat_capacity;
+            std::vector<double> free_energy;
+            for (double temperature : temperatures) {
+              clexmonte::WangLandauThermodynamics thermo =
+                  clexmonte::wang_landau_thermodynamics(
+                      self.wang_landau_results(), temperature);
+              energy.push_back(thermo.energy);
+              heat_capacity.push_back(thermo.heat_capacity);
+              free_energy.push_back(thermo.free_energy);
+            }
+            jsonParser json;
+            json["temperature"] = temperatures;
+            json["energy"] = energy;
+            json["heat_capacity"] = heat_capacity;
+            json["free_energy"] = free_energy;
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          Thermodynamic averages from the density of states of the last
+          Wang-Landau run
+
+          Parameters
+          ----------
+          temperatures: list[float]
+              The temperatures, in K.
+
+          Returns
+          -------
+          thermo: dict
+              With "temperature", and at each temperature, the mean
+              potential "energy", normalized per unit cell, the
+              "heat_capacity", normalized per unit cell, and
+              the "free_energy", normalized per unit cell, up to a constant
+              times the temperature.
+          )pbdoc",
+          py::arg("temperatures"))
       .def("run_fixture", &monte_calculator_run_fixture,
            R"pbdoc(
           Perform a single run, evolving the input state
@@ -711,10 +1595,82 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           sampling_fixture: libcasm.clexmonte.SamplingFixture
               A SamplingFixture with collected results.
 
+          Notes
+          -----
+          The GIL is released for the duration of the run, with the same
+          thread-safety requirements as :func:`MonteCalculator.run`.
           )pbdoc",
            py::arg("state"), py::arg("sampling_fixture_params"),
            py::arg("engine") = nullptr,
            py::arg("occ_location") = static_cast<monte::OccLocation *>(nullptr))
+      .def("run_series", &monte_calculator_run_series,
+           R"pbdoc(
+          Perform a series of runs, according to a state generator
+
+          The series is run in C++, with the GIL released, as by
+          :func:`MonteCalculator.run`. Use :func:`libcasm.clexmonte.run_series`
+          to get the completed runs as :class:`~libcasm.clexmonte.RunData`.
+
+          Parameters
+          ----------
+          state_generation : dict
+              The state generator, in the "state_generation" format of the
+              run parameters input file, for example
+              ``{"method": "incremental", "kwargs": {...}}``. State
+              modifying functions named in "modifiers" must be in
+              :py:attr:`~MonteCalculator.modifying_functions`.
+          sampling_fixture_params : list[libcasm.clexmonte.SamplingFixtureParams]
+              Sampling fixture parameters for each run.
+          engine : Optional[libcasm.monte.RandomNumberEngine] = None
+              Optional random number engine to use. If None, one is
+              constructed and seeded from std::random_device.
+          n_threads : int = 1
+              Maximum number of threads. If > 1, and the state generator
+              generates independent states (``"dependent_runs": false``),
+              runs are performed in parallel. Each additional thread uses its
+              own calculator, with the same method and parameters, and the
+              standard sampling functions of the same names as those in
+              `sampling_fixture_params`, so requested sampling functions must
+              be standard sampling functions. Runs finishing on different
+              threads may write sampling fixture results at the same time,
+              so sampling fixtures should not write results to the same
+              location.
+          global_cutoff : bool = True
+              If True, each run is complete if any sampling fixture is
+              complete. Otherwise, all sampling fixtures must be completed.
+          before_first_run : list[libcasm.clexmonte.SamplingFixtureParams] = []
+              Optional sampling fixture parameters for a run performed
+              before the first run.
+          before_each_run : list[libcasm.clexmonte.SamplingFixtureParams] = []
+              Optional sampling fixture parameters for a run performed
+              before each run.
+          auto_equilibration : Optional[dict] = None
+              If given, each "before each run" run continues until a drift
+              test on the sampled potential energy and composition passes,
+              up to a cap, rather than according to the completion checks
+              of `before_each_run`. Options are "sampler_names",
+              "confidence", "min_n_samples", "max_n_samples" (the cap),
+              "learn_length", and "learned_length_fraction". With
+              ``"learn_length": true``, the lengths of previous runs in the
+              series set the minimum length of later ones. The length of
+              each "before each run" run is reported in the completed runs
+              as ``"equilibration": {"n_samples": ..., "n_steps": ...}``.
+
+          Returns
+          -------
+          completed_runs : list[dict]
+              The completed runs of the state generator, as RunData dicts,
+              including runs read from its output directory that were
+              completed before this call.
+          )pbdoc",
+           py::arg("state_generation"), py::arg("sampling_fixture_params"),
+           py::arg("engine") = nullptr, py::arg("n_threads") = 1,
+           py::arg("global_cutoff") = true,
+           py::arg("before_first_run") =
+               std::vector<sampling_fixture_params_type>(),
+           py::arg("before_each_run") =
+               std::vector<sampling_fixture_params_type>(),
+           py::arg("auto_equilibration") = std::nullopt)
       .def_readwrite("sampling_functions", &calculator_type::sampling_functions,
                      R"pbdoc(
           libcasm.monte.StateSamplingFunctionMap: Sampling functions
@@ -751,6 +1707,243 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           )pbdoc")
       .def_property_readonly("potential", &calculator_type::potential, R"pbdoc(
           MontePotential : The potential calculator for the current state.
+          )pbdoc")
+      .def_property_readonly(
+          "kmc_data",
+          [](calculator_type &self) {
+            auto const &kmc_data = *self.kmc_data();
+            jsonParser json = jsonParser::object();
+            json["time"] = kmc_data.time;
+            json["prev_time"] = kmc_data.prev_time;
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          dict : KMC data of the current or last run, for KMC methods \
+          ("kinetic"): the simulated "time", and the time of the previous \
+          sample of each sampling fixture, "prev_time". Raises if the \
+          method does not have KMC data. See `kmc_atom_positions_cart` and \
+          `kmc_atom_name_index_list` for atom data.
+          )pbdoc")
+      .def(
+          "kmc_atom_positions_cart",
+          [](py::object self_obj, bool writable) -> py::object {
+            auto &self = self_obj.cast<calculator_type &>();
+            Eigen::MatrixXd &R = self.kmc_data()->atom_positions_cart;
+            if (writable) {
+              return py::cast(R, py::return_value_policy::reference_internal,
+                              self_obj);
+            }
+            return py::cast(static_cast<Eigen::MatrixXd const &>(R),
+                            py::return_value_policy::reference_internal,
+                            self_obj);
+          },
+          R"pbdoc(
+          Return a view of the current atom positions, without copying
+
+          Parameters
+          ----------
+          writable: bool = False
+              If True, the view is writable.
+
+          Returns
+          -------
+          atom_positions_cart: numpy.ndarray[numpy.float64[3, n_atoms]]
+              A view of the Cartesian coordinates of each atom, as columns,
+              at the last sample of the current or last KMC run, which keeps
+              this calculator alive. Read-only unless `writable` is True. The
+              view is invalidated by the next run. Raises if the method does
+              not have KMC data.
+          )pbdoc",
+          py::arg("writable") = false)
+      .def(
+          "kmc_atom_name_index_list",
+          [](py::object self_obj, bool writable) -> py::object {
+            auto &self = self_obj.cast<calculator_type &>();
+            std::vector<Index> &list = self.kmc_data()->atom_name_index_list;
+            py::array_t<Index> array({py::ssize_t(list.size())},
+                                     {py::ssize_t(sizeof(Index))}, list.data(),
+                                     self_obj);
+            if (!writable) {
+              array.attr("setflags")(py::arg("write") = false);
+            }
+            return std::move(array);
+          },
+          R"pbdoc(
+          Return a view of the atom name index of each atom, without copying
+
+          Parameters
+          ----------
+          writable: bool = False
+              If True, the view is writable.
+
+          Returns
+          -------
+          atom_name_index_list: numpy.ndarray[numpy.int64[n_atoms]]
+              A view of the index into the event system's atom names of each
+              atom, in the order of the columns of `kmc_atom_positions_cart`,
+              which keeps this calculator alive. Read-only unless `writable`
+              is True. The view is invalidated by the next run. Raises if the
+              method does not have KMC data.
+          )pbdoc",
+          py::arg("writable") = false)
+      .def(
+          "kmc_event_list_arrays",
+          [](calculator_type &self) {
+            clexmonte::kinetic::EventListArrays arrays =
+                clexmonte::kinetic::make_event_list_arrays(
+                    *self.kinetic_event_data());
+            py::dict data;
+            data["linear_index"] = py::cast(std::move(arrays.linear_index));
+            data["prim_event_index"] =
+                py::cast(std::move(arrays.prim_event_index));
+            data["unitcell_index"] = py::cast(std::move(arrays.unitcell_index));
+            data["linear_site_index"] =
+                py::cast(std::move(arrays.linear_site_index));
+            return data;
+          },
+          R"pbdoc(
+          Return the complete KMC event list as arrays
+
+          Events are ordered by increasing linear index,
+          ``unitcell_index * n_prim_events + prim_event_index``, which is also
+          the order of :func:`~MonteCalculator.kmc_event_state_arrays` and
+          :func:`~MonteCalculator.kmc_calculate_event_rates`.
+
+          Returns
+          -------
+          event_list : dict[str, numpy.ndarray]
+              The event list of the current or last KMC run, with:
+
+              - "linear_index": numpy.ndarray[numpy.int64[n_events]], the
+                linear index of each event,
+              - "prim_event_index": numpy.ndarray[numpy.int64[n_events]],
+                the prim event index of each event,
+              - "unitcell_index": numpy.ndarray[numpy.int64[n_events]], the
+                unit cell index of each event,
+              - "linear_site_index": numpy.ndarray[numpy.int64[n_events, max_n_sites]],
+                the linear site indices of each event, one row per event,
+                padded with -1.
+
+              Raises if the method does not have KMC event data, or the
+              complete event list is not constructed ("defect" event
+              selector).
+          )pbdoc")
+      .def(
+          "kmc_event_state_arrays",
+          [](calculator_type &self) {
+            clexmonte::kinetic::EventStateArrays arrays =
+                clexmonte::kinetic::make_event_state_arrays(
+                    *self.kinetic_event_data());
+            py::dict data;
+            data["is_calculated"] = py::cast(std::move(arrays.is_calculated));
+            data["is_allowed"] = py::cast(std::move(arrays.is_allowed));
+            data["is_normal"] = py::cast(std::move(arrays.is_normal));
+            data["dE_activated"] = py::cast(std::move(arrays.dE_activated));
+            data["rate"] = py::cast(std::move(arrays.rate));
+            if (arrays.freq.size()) {
+              data["dE_final"] = py::cast(std::move(arrays.dE_final));
+              data["Ekra"] = py::cast(std::move(arrays.Ekra));
+              data["freq"] = py::cast(std::move(arrays.freq));
+            }
+            return data;
+          },
+          R"pbdoc(
+          Return the stored KMC event states as arrays
+
+          Requires the KMC option "store_event_states".
+
+          Returns
+          -------
+          event_states : dict[str, numpy.ndarray]
+              The most recently calculated state of each event, in the order
+              of :func:`~MonteCalculator.kmc_event_list_arrays`, with boolean
+              arrays "is_calculated", "is_allowed", and "is_normal", and float
+              arrays "dE_activated" and "rate". If the number of events is at
+              most "max_full_event_states", also includes "dE_final", "Ekra",
+              and "freq". Values of events not yet calculated are 0.0 or
+              False.
+          )pbdoc")
+      .def(
+          "kmc_calculate_event_rates",
+          [](calculator_type &self) {
+            std::shared_ptr<clexmonte::kinetic::KineticEventData> event_data =
+                self.kinetic_event_data();
+            Eigen::VectorXd rates;
+            {
+              py::gil_scoped_release release;
+              rates = clexmonte::kinetic::calculate_event_list_rates(
+                  *event_data);
+            }
+            return rates;
+          },
+          R"pbdoc(
+          Calculate the current rate of every KMC event
+
+          Rates are calculated with the event calculators of the last KMC
+          run, for the current occupation of that run's state and the
+          conditions of that run, without constructing event objects. The
+          state of the last run must still exist; its occupation may have
+          been changed since the run. The GIL is released during the
+          calculation.
+
+          Returns
+          -------
+          rates : numpy.ndarray[numpy.float64[n_events]]
+              The rate of each event, in the order of
+              :func:`~MonteCalculator.kmc_event_list_arrays`.
+          )pbdoc")
+      .def_property_readonly(
+          "loop_profile",
+          [](calculator_type const &self) {
+            clexmonte::LoopProfile const &profile = self.loop_profile();
+            jsonParser json = jsonParser::object();
+            for (int i = 0; i < clexmonte::n_loop_phases; ++i) {
+              std::string name = clexmonte::loop_phase_name(
+                  static_cast<clexmonte::LoopPhase>(i));
+              json[name]["n_calls"] = profile.n_calls[i];
+              json[name]["total_time_s"] = profile.total_time_s[i];
+            }
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          dict : Call counts, "n_calls", and total times in seconds, \
+          "total_time_s", of each phase of the main loop ("propose", \
+          "delta_potential", "accept", "apply", "sample", "status"), from \
+          the last single state Metropolis run. Only collected if \
+          libcasm-clexmonte is built with CASM_CLEXMONTE_LOOP_PROFILE, \
+          otherwise all values are zero.
+          )pbdoc")
+      .def_property_readonly(
+          "memory_report",
+          [](calculator_type const &self) {
+            jsonParser json;
+            to_json(self.memory_report(), json);
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          dict : Approximate memory used by each subsystem, in bytes, from \
+          the current or last run. Includes "subsystems", with "bytes", and \
+          "max_bytes" for subsystems with a memory budget, for each of \
+          "supercell_data", the KMC events, impact table, event states, \
+          calculators, selector, and event data cache, "occ_location", and \
+          "sampling_fixture/<label>", and "total_bytes". The KMC \
+          calculator reports at the start of each run, which is also \
+          written to the log, and again at the end of the run, to include \
+          sampled data. Other methods return an empty report.
+          )pbdoc")
+      .def_property("telemetry", &calculator_type::telemetry,
+                    &calculator_type::set_telemetry,
+                    R"pbdoc(
+          Optional[TelemetryChannel] : If not None, single state Metropolis \
+          runs publish their progress to this channel, which can be read \
+          from another thread while the run is in progress.
+          )pbdoc")
+      .def_property("run_control", &calculator_type::run_control,
+                    &calculator_type::set_run_control,
+                    R"pbdoc(
+          Optional[RunControl] : If not None, single state Metropolis runs \
+          evaluate its function after each sample, which may stop a run \
+          early or extend it past its completion checks.
           )pbdoc");
 
   m.def("make_custom_monte_calculator", &make_custom_monte_calculator, R"pbdoc(
@@ -764,7 +1957,14 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
 
           source: str
               Path to a MonteCalculator source file implementing a custom Monte
-              Carlo method to use instead of a standard implementation.
+              Carlo method to use instead of a standard implementation. The
+              source file should include
+              "casm/clexmonte/monte_calculator/plugin.hh", which provides the
+              calculator interface and the building blocks of the standard
+              calculators, and use ``CASM_CLEXMONTE_PLUGIN(<name>)`` to declare
+              the plugin API version it is compiled against, where ``<name>``
+              is the file name without extension. A plugin compiled against a
+              different plugin API version fails to load.
 
           params: Optional[dict] = None
               Monte Carlo calculation method parameters. Expected values
@@ -810,11 +2010,655 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           search_path: Optional[list[str]] = None
               An optional search path for the `source` file.
 
+          cache_dir: Optional[str] = None
+              If given, or if the CASM_MONTE_CALCULATOR_CACHE_DIR environment
+              variable is set, the calculator is compiled in an entry of a
+              cache in this directory, keyed by the contents of the source
+              file's directory, the compile and shared object options, and
+              the plugin API version. Workers that use the same source and
+              options, including separate processes sharing the directory,
+              load the compiled library from the cache instead of compiling
+              again. Cache entries are populated under a file lock.
+
           )pbdoc",
         py::arg("system"), py::arg("source"), py::arg("params") = std::nullopt,
         py::arg("compile_options") = std::nullopt,
         py::arg("so_options") = std::nullopt,
-        py::arg("search_path") = std::nullopt);
+        py::arg("search_path") = std::nullopt,
+        py::arg("cache_dir") = std::nullopt);
+
+  py::class_<clexmonte::BatchedSamplingFunction,
+             std::shared_ptr<clexmonte::BatchedSamplingFunction>>(
+      m, "BatchedSamplingFunction",
+      R"pbdoc(
+      Evaluates a sampling function for batches of occupation snapshots
+
+      Calling a Python-defined :class:`~libcasm.monte.sampling.StateSamplingFunction`
+      once per sample has a fixed interpreter overhead, which can dominate
+      run time when sampling is frequent. A BatchedSamplingFunction instead
+      copies the current occupation into a preallocated buffer each time it
+      is sampled, and calls `function` once per `batch_size` samples with
+      the buffered occupations.
+
+      Usage:
+
+      - Add the state sampling function returned by
+        :func:`~BatchedSamplingFunction.sampling_function` to the sampling
+        functions of a :class:`~libcasm.clexmonte.SamplingFixtureParams`, and
+        include its name in the requested quantities.
+      - After the run, :py:attr:`~BatchedSamplingFunction.values` evaluates
+        the last partial batch and returns the batched values, one row per
+        sample.
+
+      The sampled value stored by the sampler is the row of
+      :py:attr:`~BatchedSamplingFunction.values` where the value of each
+      sample is stored. Batched values are therefore not available for
+      convergence checks. A BatchedSamplingFunction is not thread-safe; use
+      one per calculator.
+      )pbdoc")
+      .def(py::init<>(&make_batched_sampling_function),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          name : str
+              Name of the sampled quantity.
+          description : str
+              Description of the function.
+          component_names : list[str]
+              Names of the components of the batched values.
+          batch_size : int
+              Number of samples per call of `function`.
+          function : Callable[[np.ndarray[np.int32]], np.ndarray[np.float64]]
+              A function which takes a read-only array of shape
+              ``(n_samples, n_sites)``, the occupations of up to
+              `batch_size` samples with one row per sample, and returns an
+              array of shape ``(n_samples, len(component_names))``, the
+              value of each sample. The input array is a view of the buffer,
+              which is only valid for the duration of the call; copy it to
+              keep it.
+          calculator : libcasm.clexmonte.MonteCalculator
+              The calculator whose current state is sampled.
+          )pbdoc",
+           py::arg("name"), py::arg("description"),
+           py::arg("component_names"), py::arg("batch_size"),
+           py::arg("function"), py::arg("calculator"))
+      .def_readonly("name", &clexmonte::BatchedSamplingFunction::name,
+                    R"pbdoc(
+          str : Name of the sampled quantity.
+          )pbdoc")
+      .def_readonly("description",
+                    &clexmonte::BatchedSamplingFunction::description,
+                    R"pbdoc(
+          str : Description of the function.
+          )pbdoc")
+      .def_readonly("component_names",
+                    &clexmonte::BatchedSamplingFunction::component_names,
+                    R"pbdoc(
+          list[str] : Names of the components of the batched values.
+          )pbdoc")
+      .def_readonly("batch_size",
+                    &clexmonte::BatchedSamplingFunction::batch_size,
+                    R"pbdoc(
+          int : Number of samples per call of `function`.
+          )pbdoc")
+      .def(
+          "sampling_function",
+          [](std::shared_ptr<clexmonte::BatchedSamplingFunction> self) {
+            return clexmonte::make_batched_state_sampling_function(self);
+          },
+          R"pbdoc(
+          Return a state sampling function which records samples
+
+          Returns
+          -------
+          f : libcasm.monte.sampling.StateSamplingFunction
+              A scalar state sampling function, with the same name and
+              description, which records the current occupation and returns
+              the row of :py:attr:`~BatchedSamplingFunction.values` where the
+              value of the sample is stored.
+          )pbdoc")
+      .def_property_readonly("values",
+                             &clexmonte::BatchedSamplingFunction::values,
+                             R"pbdoc(
+          np.ndarray[np.float64] : The batched values, with shape
+          ``(n_samples, len(component_names))``. Buffered samples are
+          evaluated first.
+          )pbdoc")
+      .def_property_readonly("n_samples",
+                             &clexmonte::BatchedSamplingFunction::n_samples,
+                             R"pbdoc(
+          int : Number of samples recorded, including buffered samples.
+          )pbdoc")
+      .def_property_readonly("n_batches",
+                             &clexmonte::BatchedSamplingFunction::n_batches,
+                             R"pbdoc(
+          int : Number of calls of `function`.
+          )pbdoc")
+      .def("flush", &clexmonte::BatchedSamplingFunction::flush,
+           R"pbdoc(
+          Evaluate buffered samples
+          )pbdoc")
+      .def("reset", &clexmonte::BatchedSamplingFunction::reset,
+           R"pbdoc(
+          Clear buffered samples and batched values
+          )pbdoc");
+
+  py::class_<clexmonte::HistogramSamplingFunction,
+             std::shared_ptr<clexmonte::HistogramSamplingFunction>>(
+      m, "HistogramSamplingFunction",
+      R"pbdoc(
+      Accumulates histograms of a sampled quantity in place
+
+      Binning the distribution of the potential energy or an order parameter
+      after a run requires storing every sample. A
+      HistogramSamplingFunction instead evaluates a source sampling function
+      each time it is sampled, and adds each component of the value to a
+      histogram, so memory is O(n_bins) per component rather than
+      O(n_samples). The histograms can be used directly as input to
+      histogram reweighting or flat-histogram methods.
+
+      Bins are either fixed, `n_bins` bins spanning ``[min, max)`` with
+      values outside the range counted as underflow or overflow, or
+      adaptive, bins of width `bin_width` aligned to multiples of the width,
+      with the range growing to include every value, and the width doubled
+      whenever more than `max_bins` bins would be needed.
+
+      Usage:
+
+      - Add the state sampling function returned by
+        :func:`~HistogramSamplingFunction.sampling_function` to the sampling
+        functions of a :class:`~libcasm.clexmonte.SamplingFixtureParams`, and
+        include its name in the requested quantities.
+      - After the run, :func:`~HistogramSamplingFunction.to_dict` returns
+        the histograms. Call :func:`~HistogramSamplingFunction.reset` before
+        the next run.
+
+      The sampled value stored by the sampler is empty, so histograms are
+      not available for convergence checks. A HistogramSamplingFunction is
+      not thread-safe; use one per calculator.
+      )pbdoc")
+      .def(py::init<>(&make_histogram_sampling_function),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          source : libcasm.monte.sampling.StateSamplingFunction
+              The sampling function whose values are binned, such as the
+              calculator's "potential_energy" or "order_parameter.<key>"
+              sampling function.
+          name : Optional[str] = None
+              Name of the histogram sampling function. The default is
+              ``source.name + ".histogram"``.
+          min : Optional[float] = None
+              Lower edge of the first fixed bin.
+          max : Optional[float] = None
+              Upper edge of the last fixed bin.
+          n_bins : int = 100
+              Number of fixed bins.
+          bin_width : Optional[float] = None
+              Initial width of adaptive bins, used if `min` and `max` are
+              not given.
+          max_bins : int = 1000
+              Maximum number of adaptive bins.
+          )pbdoc",
+           py::arg("source"), py::arg("name") = std::nullopt,
+           py::arg("min") = std::nullopt, py::arg("max") = std::nullopt,
+           py::arg("n_bins") = 100, py::arg("bin_width") = std::nullopt,
+           py::arg("max_bins") = 1000)
+      .def_readonly("name", &clexmonte::HistogramSamplingFunction::name,
+                    R"pbdoc(
+          str : Name of the histogram sampling function.
+          )pbdoc")
+      .def_property_readonly(
+          "component_names",
+          &clexmonte::HistogramSamplingFunction::component_names,
+          R"pbdoc(
+          list[str] : Names of the components of the source value, one
+          histogram per component.
+          )pbdoc")
+      .def_property_readonly("n_samples",
+                             &clexmonte::HistogramSamplingFunction::n_samples,
+                             R"pbdoc(
+          int : Number of samples recorded.
+          )pbdoc")
+      .def(
+          "sampling_function",
+          [](std::shared_ptr<clexmonte::HistogramSamplingFunction> self) {
+            return clexmonte::make_histogram_state_sampling_function(self);
+          },
+          R"pbdoc(
+          Return a state sampling function which records samples
+
+          Returns
+          -------
+          f : libcasm.monte.sampling.StateSamplingFunction
+              A state sampling function, with the same name and description,
+              which adds the current value of the source function to the
+              histograms and returns an empty value.
+          )pbdoc")
+      .def(
+          "to_dict",
+          [](clexmonte::HistogramSamplingFunction const &self) {
+            jsonParser json;
+            to_json(self, json);
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          Return the histograms as a Python dict
+
+          Returns
+          -------
+          data : dict
+              With "n_samples", "component_names", and "histograms", a list
+              with one histogram per component. Each histogram has
+              "bin_edges", "counts", "count", and, for fixed bins,
+              "n_underflow" and "n_overflow".
+          )pbdoc")
+      .def("reset", &clexmonte::HistogramSamplingFunction::reset,
+           R"pbdoc(
+          Remove all samples
+          )pbdoc");
+
+  py::class_<clexmonte::TelemetryChannel,
+             std::shared_ptr<clexmonte::TelemetryChannel>>(
+      m, "TelemetryChannel",
+      R"pbdoc(
+      A bounded, lock-free channel of run progress records
+
+      Monitoring a run by reading the "status.json" file requires file I/O
+      by both the run and the reader. A TelemetryChannel instead receives
+      progress records from the run loop in memory:
+
+      - Set :py:attr:`MonteCalculator.telemetry` to a TelemetryChannel. Single
+        state Metropolis runs then publish a record each time they check
+        whether the run status is due (once per pass), if at least
+        `min_interval_s` seconds have passed since the last record, and when
+        each run is finalized.
+      - Call :func:`~TelemetryChannel.read` from another thread, for example
+        a dashboard or adaptive controller, to take all published records.
+        Runs release the GIL, so Python threads may read while a run is in
+        progress.
+
+      Publishing copies a record into a preallocated slot and never waits
+      for the reader. If `capacity` records are unread, new records are
+      dropped and counted by :py:attr:`~TelemetryChannel.n_dropped`. Only one
+      calculator may publish to a channel at a time.
+
+      Each record is a dict with:
+
+      - "run_index": int, the run index
+      - "sampling_fixture_label": str, the sampling fixture the record was
+        made from
+      - "n_steps", "n_passes": int, the number of steps and passes
+      - "n_accept", "n_reject": int, the number of accepted and rejected
+        events
+      - "acceptance_rate": float
+      - "clocktime": float, seconds since the channel was constructed
+      - "events_per_s": float, steps per second since the previous record of
+        the same run, or 0.0 for the first record of a run
+      - "n_samples": int, the number of samples taken
+      - "sampled_values": dict[str, np.ndarray], the most recent value of
+        each of `sampler_names` that has been sampled
+      - "all_equilibrated", "all_converged", "is_complete": bool, as of the
+        last completion check
+      - "is_final": bool, true for the record published when a run is
+        finalized
+      )pbdoc")
+      .def(py::init<Index, double, std::vector<std::string>, std::string>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          capacity : int = 1024
+              Maximum number of unread records.
+          min_interval_s : float = 0.0
+              Minimum time between records published during a run, in
+              seconds.
+          sampler_names : list[str] = []
+              Names of the samplers whose most recent values are included in
+              records.
+          sampling_fixture_label : str = ""
+              Label of the sampling fixture records are made from. If empty,
+              or if no sampling fixture has this label, the first sampling
+              fixture is used.
+          )pbdoc",
+           py::arg("capacity") = 1024, py::arg("min_interval_s") = 0.0,
+           py::arg("sampler_names") = std::vector<std::string>(),
+           py::arg("sampling_fixture_label") = std::string())
+      .def_readonly("capacity", &clexmonte::TelemetryChannel::capacity,
+                    R"pbdoc(
+          int : Maximum number of unread records.
+          )pbdoc")
+      .def_readonly("min_interval_s",
+                    &clexmonte::TelemetryChannel::min_interval_s,
+                    R"pbdoc(
+          float : Minimum time between records published during a run, in \
+          seconds.
+          )pbdoc")
+      .def_readonly("sampler_names",
+                    &clexmonte::TelemetryChannel::sampler_names,
+                    R"pbdoc(
+          list[str] : Names of the samplers whose most recent values are \
+          included in records.
+          )pbdoc")
+      .def_readonly("sampling_fixture_label",
+                    &clexmonte::TelemetryChannel::sampling_fixture_label,
+                    R"pbdoc(
+          str : Label of the sampling fixture records are made from.
+          )pbdoc")
+      .def(
+          "read",
+          [](clexmonte::TelemetryChannel &self) {
+            std::vector<clexmonte::TelemetryRecord> records = self.read();
+            py::list result;
+            for (auto const &record : records) {
+              result.append(
+                  telemetry_record_to_dict(record, self.sampler_names));
+            }
+            return result;
+          },
+          R"pbdoc(
+          Take all published records, oldest first
+
+          Returns
+          -------
+          records : list[dict]
+              The records published since the last call, excluding dropped
+              records.
+          )pbdoc")
+      .def_property_readonly("n_published",
+                             &clexmonte::TelemetryChannel::n_published,
+                             R"pbdoc(
+          int : Number of published records.
+          )pbdoc")
+      .def_property_readonly("n_dropped",
+                             &clexmonte::TelemetryChannel::n_dropped,
+                             R"pbdoc(
+          int : Number of records dropped because `capacity` records were \
+          unread.
+          )pbdoc")
+      .def_property_readonly("n_unread",
+                             &clexmonte::TelemetryChannel::n_unread,
+                             R"pbdoc(
+          int : Number of published records not yet read.
+          )pbdoc");
+
+  py::class_<clexmonte::RunControl, std::shared_ptr<clexmonte::RunControl>>(
+      m, "RunControl",
+      R"pbdoc(
+      Adaptive control of runs, by a function evaluated after each sample
+
+      A run normally ends when the completion checks of its sampling
+      fixtures are met. A RunControl can end a run earlier, for example when
+      the current statistics show a condition point is not of interest, or
+      keep it going longer:
+
+      - Set :py:attr:`MonteCalculator.run_control` to a RunControl. During
+        single state Metropolis runs, after each new sample is taken by the
+        sampling fixture labeled `sampling_fixture_label` (or the first
+        sampling fixture), `function` is called with its
+        :class:`~libcasm.clexmonte.Results` and returns an action:
+
+        - ``"stop"``: End the run now. The run is finalized as usual, so
+          results are written.
+        - ``"extend"``: Do not end the run when the completion checks are
+          met, until `function` returns another action. A function that
+          always returns ``"extend"`` results in a run that never ends.
+        - ``"proceed"`` or None: End the run as determined by the
+          completion checks.
+
+      The action is reset to ``"proceed"`` at the beginning of each run.
+      The results passed to `function` are only valid for the duration of
+      the call.
+      )pbdoc")
+      .def(py::init<>(&make_run_control),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          function : Callable[[libcasm.clexmonte.Results], Optional[str]]
+              A function which takes the results of the sampling fixture,
+              after a new sample, and returns ``"proceed"``, ``"stop"``,
+              ``"extend"``, or None.
+          sampling_fixture_label : str = ""
+              Label of the sampling fixture whose results are checked. If
+              empty, or if no sampling fixture has this label, the first
+              sampling fixture is used.
+          )pbdoc",
+           py::arg("function"),
+           py::arg("sampling_fixture_label") = std::string())
+      .def_readonly("sampling_fixture_label",
+                    &clexmonte::RunControl::sampling_fixture_label,
+                    R"pbdoc(
+          str : Label of the sampling fixture whose results are checked.
+          )pbdoc")
+      .def_property_readonly(
+          "action",
+          [](clexmonte::RunControl const &self) {
+            return clexmonte::run_control_action_name(self.action());
+          },
+          R"pbdoc(
+          str : The currently requested action, ``"proceed"``, ``"stop"``, \
+          or ``"extend"``.
+          )pbdoc")
+      .def_property_readonly("n_evaluations",
+                             &clexmonte::RunControl::n_evaluations,
+                             R"pbdoc(
+          int : Number of times `function` was evaluated during the current \
+          or last run.
+          )pbdoc")
+      .def_property_readonly("stopped", &clexmonte::RunControl::stopped,
+                             R"pbdoc(
+          bool : True if the current or last run was ended by a ``"stop"`` \
+          action or a stop request.
+          )pbdoc")
+      .def("request_stop", &clexmonte::RunControl::request_stop,
+           R"pbdoc(
+          Request that the run in progress, or the next run, ends now
+
+          May be called from any thread. The run is finalized as usual, so
+          results are written. Unlike the action, the request is not reset
+          at the beginning of each run; use :func:`clear_stop_request`.
+          )pbdoc")
+      .def("clear_stop_request", &clexmonte::RunControl::clear_stop_request,
+           R"pbdoc(
+          Clear a stop request, so that following runs are not ended
+          )pbdoc")
+      .def_property_readonly("stop_requested",
+                             &clexmonte::RunControl::stop_requested,
+                             R"pbdoc(
+          bool : True if a stop was requested.
+          )pbdoc");
+
+  py::class_<clexmonte::AsyncRunPool,
+             std::shared_ptr<clexmonte::AsyncRunPool>>(m, "AsyncRunPool",
+                                                        R"pbdoc(
+      Worker threads that perform runs started by
+      :func:`MonteCalculator.run_async`
+
+      Runs are started in submission order, as workers become free. When a
+      pool is destroyed, runs that have not started are cancelled, and
+      running runs are waited for.
+      )pbdoc")
+      .def(py::init<>(&make_async_run_pool),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          n_workers : Optional[int] = None
+              Number of worker threads, which is the maximum number of runs
+              in progress at once. If None, one per hardware thread.
+          )pbdoc",
+           py::arg("n_workers") = std::nullopt)
+      .def_property_readonly("n_workers",
+                             &clexmonte::AsyncRunPool::n_workers,
+                             R"pbdoc(
+          int : Number of worker threads.
+          )pbdoc")
+      .def_property_readonly("n_pending",
+                             &clexmonte::AsyncRunPool::n_pending,
+                             R"pbdoc(
+          int : Number of submitted runs not yet started.
+          )pbdoc");
+
+  py::class_<AsyncRunHandle, std::shared_ptr<AsyncRunHandle>>(m, "AsyncRun",
+                                                              R"pbdoc(
+      A run started by :func:`MonteCalculator.run_async`
+
+      An AsyncRun follows the interface of :class:`concurrent.futures.Future`:
+
+      - :func:`result` waits for the run and returns its run manager, or
+        raises the exception that ended it.
+      - :func:`cancel` cancels a run that has not started, or stops a run
+        in progress by its RunControl.
+      - :func:`add_done_callback` adds a function that is called, from a
+        worker thread, when the run is done.
+
+      It may also be awaited from a coroutine, which returns the run
+      manager, and converted with :func:`as_concurrent_future` for use with
+      :func:`concurrent.futures.wait` and :func:`asyncio.wrap_future`.
+      )pbdoc")
+      .def_property_readonly(
+          "status",
+          [](AsyncRunHandle const &self) {
+            return clexmonte::async_run_status_name(self.run->status());
+          },
+          R"pbdoc(
+          str : One of ``"pending"``, ``"running"``, ``"finished"``, \
+          ``"cancelled"``, or ``"failed"``.
+          )pbdoc")
+      .def(
+          "done", [](AsyncRunHandle const &self) { return self.run->done(); },
+          R"pbdoc(
+          Return True if the run is finished, cancelled, or failed
+          )pbdoc")
+      .def(
+          "running",
+          [](AsyncRunHandle const &self) {
+            return self.run->status() == clexmonte::AsyncRunStatus::running;
+          },
+          R"pbdoc(
+          Return True if the run is in progress
+          )pbdoc")
+      .def(
+          "cancelled",
+          [](AsyncRunHandle const &self) {
+            return self.run->status() == clexmonte::AsyncRunStatus::cancelled;
+          },
+          R"pbdoc(
+          Return True if the run was cancelled
+          )pbdoc")
+      .def(
+          "cancel",
+          [](AsyncRunHandle &self) {
+            self.run->cancel();
+            return !self.run->done() ||
+                   self.run->status() == clexmonte::AsyncRunStatus::cancelled;
+          },
+          R"pbdoc(
+          Cancel the run
+
+          A run that has not started is never started. A run in progress is
+          stopped by :func:`RunControl.request_stop`, and finalized as
+          usual, so `run_manager` holds the results collected so far. Runs
+          by methods that do not honor a RunControl are not stopped.
+
+          Returns
+          -------
+          result : bool
+              False if the run was already finished or failed; otherwise
+              True.
+          )pbdoc")
+      .def("wait", &async_run_wait,
+           R"pbdoc(
+          Wait until the run is done, without holding the GIL
+
+          Parameters
+          ----------
+          timeout : Optional[float] = None
+              Maximum time to wait, in seconds. If None, wait without limit.
+
+          Returns
+          -------
+          done : bool
+              True if the run is done.
+          )pbdoc",
+           py::arg("timeout") = std::nullopt)
+      .def("result", &async_run_result,
+           R"pbdoc(
+          Wait until the run is done, and return its run manager
+
+          Parameters
+          ----------
+          timeout : Optional[float] = None
+              Maximum time to wait, in seconds. If None, wait without limit.
+
+          Returns
+          -------
+          run_manager: libcasm.clexmonte.RunManager
+              The `run_manager` given to `run_async`, with collected results.
+
+          Raises
+          ------
+          concurrent.futures.TimeoutError
+              If the run is not done after `timeout` seconds.
+          concurrent.futures.CancelledError
+              If the run was cancelled.
+          Exception
+              The exception that ended the run, if it failed.
+          )pbdoc",
+           py::arg("timeout") = std::nullopt)
+      .def("add_done_callback", &async_run_add_done_callback,
+           R"pbdoc(
+          Add a function to call when the run is done
+
+          Parameters
+          ----------
+          function : Callable[[AsyncRun], None]
+              Called with this AsyncRun when the run is done, from the worker
+              thread that performed it, or immediately if the run is already
+              done. Exceptions raised by `function` are reported as
+              unraisable and otherwise ignored.
+          )pbdoc",
+           py::arg("function"))
+      .def("as_concurrent_future", &async_run_as_concurrent_future,
+           R"pbdoc(
+          Return a :class:`concurrent.futures.Future` that is completed when
+          the run is done
+
+          The future's result is the run manager. Cancelling the future
+          cancels the run.
+          )pbdoc")
+      .def(
+          "__await__",
+          [](std::shared_ptr<AsyncRunHandle> self) {
+            py::object future = async_run_as_concurrent_future(self);
+            return py::module_::import("asyncio")
+                .attr("wrap_future")(future)
+                .attr("__await__")();
+          },
+          R"pbdoc(
+          Await the run from a coroutine, returning its run manager
+          )pbdoc")
+      .def_property_readonly(
+          "telemetry",
+          [](AsyncRunHandle const &self) { return self.run->telemetry; },
+          R"pbdoc(
+          Optional[TelemetryChannel] : The channel the run publishes its \
+          progress to, if any.
+          )pbdoc")
+      .def_property_readonly(
+          "run_control",
+          [](AsyncRunHandle const &self) { return self.run->run_control; },
+          R"pbdoc(
+          RunControl : The RunControl used to stop the run.
+          )pbdoc");
 
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
@@ -77,6 +77,25 @@ results_type make_results(sampling_fixture_params_type const &params) {
       params.analysis_functions);
 }
 
+sampling_fixture_params_type make_sampling_fixture_params(
+    std::string label, monte::StateSamplingFunctionMap sampling_functions,
+    monte::jsonStateSamplingFunctionMap json_sampling_functions,
+    analysis_function_map_type analysis_functions,
+    monte::SamplingParams sampling_params,
+    monte::CompletionCheckParams<statistics_type> completion_check_params,
+    std::vector<std::string> analysis_names, bool write_results,
+    bool write_trajectory, bool write_observations, bool write_status,
+    std::optional<std::string> output_dir, std::optional<std::string> log_file,
+    double log_frequency_in_s,
+    std::shared_ptr<clexmonte::SamplingFunctionProfiler>
+        sampling_function_profiler) {
+  return clexmonte::make_sampling_fixture_params(
+      label, sampling_functions, json_sampling_functions, analysis_functions,
+      sampling_params, completion_check_params, analysis_names, write_results,
+      write_trajectory, write_observations, write_status, output_dir, log_file,
+      log_frequency_in_s, nullptr, sampling_function_profiler);
+}
+
 }  // namespace CASMpy
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>);
@@ -185,13 +204,54 @@ PYBIND11_MODULE(_clexmonte_run_management, m) {
     )pbdoc",
                                            py::module_local(false));
 
+  py::class_<clexmonte::SamplingFunctionProfiler,
+             std::shared_ptr<clexmonte::SamplingFunctionProfiler>>(
+      m, "SamplingFunctionProfiler",
+      R"pbdoc(
+      Collects the number of calls and total time of sampling functions
+
+      A SamplingFunctionProfiler given to the :class:`SamplingFixtureParams`
+      constructor records each call of the sampling functions and JSON
+      sampling functions that are sampled, which can be used to find the
+      sampling functions that dominate sampling time. One profiler may be
+      shared by multiple sampling fixtures.
+      )pbdoc")
+      .def(py::init<>(), R"pbdoc(
+          .. rubric:: Constructor
+
+          Default constructor only.
+          )pbdoc")
+      .def(
+          "to_dict",
+          [](clexmonte::SamplingFunctionProfiler const &self) {
+            jsonParser json = jsonParser::object();
+            for (auto const &pair : self.entries()) {
+              json[pair.first]["n_calls"] = pair.second.n_calls;
+              json[pair.first]["total_time_s"] = pair.second.total_time_s;
+            }
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          Return the profile of each sampling function called
+
+          Returns
+          -------
+          data: dict
+              A dict of ``{"n_calls": int, "total_time_s": float}``, by
+              sampling function name.
+          )pbdoc")
+      .def("reset", &clexmonte::SamplingFunctionProfiler::reset,
+           R"pbdoc(
+          Clear all collected data
+          )pbdoc");
+
   py::class_<sampling_fixture_params_type>(m, "SamplingFixtureParams",
                                            R"pbdoc(
       Sampling fixture parameters
 
       Specifies what to sample, when, and how to check for completion.
       )pbdoc")
-      .def(py::init<>(&clexmonte::make_sampling_fixture_params),
+      .def(py::init<>(&make_sampling_fixture_params),
            R"pbdoc(
           .. rubric:: Constructor
 
@@ -233,6 +293,9 @@ PYBIND11_MODULE(_clexmonte_run_management, m) {
               so if the `sampling_params` are such that the time between
               samples is longer than `log_frequency_is_s` the status log will
               be written less frequently.
+          sampling_function_profiler: Optional[SamplingFunctionProfiler] = None
+              If provided, the number of calls and time spent in each sampled
+              sampling function are recorded by `sampling_function_profiler`.
           )pbdoc",
            py::arg("label"), py::arg("sampling_functions"),
            py::arg("json_sampling_functions"), py::arg("analysis_functions"),
@@ -242,7 +305,8 @@ PYBIND11_MODULE(_clexmonte_run_management, m) {
            py::arg("write_observations") = false,
            py::arg("write_status") = true, py::arg("output_dir") = std::nullopt,
            py::arg("log_file") = std::nullopt,
-           py::arg("log_frequency_in_s") = 600.0)
+           py::arg("log_frequency_in_s") = 600.0,
+           py::arg("sampling_function_profiler") = nullptr)
       .def_readwrite("label", &sampling_fixture_params_type::label, R"pbdoc(
           str: Label, to name output and distinguish multiple sampling fixtures
           )pbdoc")
@@ -501,6 +565,37 @@ PYBIND11_MODULE(_clexmonte_run_management, m) {
                      R"pbdoc(
           libcasm.monte.sampling.SamplerMap : Sampled data
           )pbdoc")
+      .def(
+          "sampler_values",
+          [](py::object self_obj, std::string name) -> py::object {
+            auto const &self = self_obj.cast<results_type const &>();
+            auto it = self.samplers.find(name);
+            if (it == self.samplers.end()) {
+              throw std::runtime_error(
+                  "Error in Results.sampler_values: no sampler '" + name +
+                  "'");
+            }
+            Eigen::Ref<Eigen::MatrixXd const> values = it->second->values();
+            return py::cast(values,
+                            py::return_value_policy::reference_internal,
+                            self_obj);
+          },
+          R"pbdoc(
+          Return a read-only view of sampled values, without copying
+
+          Parameters
+          ----------
+          name: str
+              The sampler name, a key in `samplers`.
+
+          Returns
+          -------
+          values: numpy.ndarray[numpy.float64[n_samples, n_components]]
+              A read-only view of the sampled values, with one row per
+              sample, which keeps these results alive. Taking more samples,
+              or modifying `samplers`, invalidates the view.
+          )pbdoc",
+          py::arg("name"))
       .def_readwrite("json_samplers", &results_type::json_samplers,
                      R"pbdoc(
           libcasm.monte.sampling.jsonSamplerMap : JSON sampled data
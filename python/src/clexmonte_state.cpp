@@ -1,5 +1,6 @@
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -14,8 +15,10 @@
 
 // clexmonte
 #include "casm/clexmonte/run/StateModifyingFunction.hh"
+#include "casm/clexmonte/state/CompactOccupation.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
 #include "casm/clexmonte/state/io/json/State_json_io.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/clexmonte/system/io/json/System_json_io.hh"
@@ -91,6 +94,121 @@ PYBIND11_MODULE(_clexmonte_state, m) {
   py::module::import("libcasm.monte.events");
   py::module::import("libcasm.xtal");
 
+  py::class_<clexmonte::CompactOccupation>(m, "CompactOccupation",
+                                          R"pbdoc(
+      Occupation indices stored with 1, 2, 4, or 8 bits per site
+
+      A MonteCarloState stores its occupation with 4 bytes per site, as
+      required by clexulators. A CompactOccupation holds a copy with the
+      fewest bits per site that hold the maximum occupant index, for example
+      2 bits per site with at most 4 occupants per sublattice, so that many
+      occupations of a large supercell can be kept in memory.
+      )pbdoc")
+      .def(py::init<>(&clexmonte::make_compact_occupation),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          occupation : numpy.ndarray[numpy.int32[n_sites]]
+              Occupation indices, in [0, 255].
+          bits_per_value : int = 0
+              Bits per site, one of 1, 2, 4, or 8. If 0, the fewest bits that
+              hold the maximum occupation index are used.
+          )pbdoc",
+           py::arg("occupation"), py::arg("bits_per_value") = 0)
+      .def_property_readonly("size", &clexmonte::CompactOccupation::size,
+                             R"pbdoc(
+          int : Number of sites.
+          )pbdoc")
+      .def_property_readonly("bits_per_value",
+                             &clexmonte::CompactOccupation::bits_per_value,
+                             R"pbdoc(
+          int : Bits per site, one of 1, 2, 4, or 8.
+          )pbdoc")
+      .def_property_readonly(
+          "nbytes",
+          [](clexmonte::CompactOccupation const &self) {
+            return self.data().size();
+          },
+          R"pbdoc(
+          int : Number of bytes used to store the occupation.
+          )pbdoc")
+      .def("__len__", &clexmonte::CompactOccupation::size)
+      .def("__getitem__",
+           [](clexmonte::CompactOccupation const &self, Index l) {
+             if (l < 0 || l >= self.size()) {
+               throw py::index_error("CompactOccupation index out of range");
+             }
+             return self.get(l);
+           })
+      .def(
+          "to_array",
+          [](clexmonte::CompactOccupation const &self) {
+            return self.to_vector();
+          },
+          R"pbdoc(
+          Return the occupation as an array
+
+          Returns
+          -------
+          occupation : numpy.ndarray[numpy.int32[n_sites]]
+              The occupation indices.
+          )pbdoc")
+      .def(
+          "packed_bytes",
+          [](clexmonte::CompactOccupation const &self) {
+            return py::array_t<std::uint8_t>(self.data().size(),
+                                             self.data().data());
+          },
+          R"pbdoc(
+          Return a copy of the packed bytes
+
+          Values are bit-packed, least significant bits first.
+
+          Returns
+          -------
+          data : numpy.ndarray[numpy.uint8[nbytes]]
+              The packed bytes.
+          )pbdoc")
+      .def(
+          "to_dict",
+          [](clexmonte::CompactOccupation const &self) {
+            jsonParser json;
+            json["encoding"] = "bitpacked_zlib_base64";
+            json["size"] = self.size();
+            json["bits_per_value"] = self.bits_per_value();
+            json["data"] = clexmonte::pack_occupation(self);
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          Represent the CompactOccupation as a Python dict
+
+          The dict has the same format as the "occ_packed" attribute of
+          states written with packed occupation: "encoding"
+          ("bitpacked_zlib_base64"), "size", "bits_per_value", and "data".
+          )pbdoc")
+      .def_static(
+          "from_dict",
+          [](nlohmann::json const &data) {
+            jsonParser json{data};
+            std::string encoding;
+            from_json(encoding, json["encoding"]);
+            if (encoding != "bitpacked_zlib_base64") {
+              throw std::runtime_error(
+                  "Error in CompactOccupation.from_dict: unknown encoding '" +
+                  encoding + "'");
+            }
+            return clexmonte::unpack_compact_occupation(
+                json["data"].get<std::string>(), json["size"].get<Index>(),
+                json["bits_per_value"].get<int>());
+          },
+          R"pbdoc(
+          Construct a CompactOccupation from a Python dict, as written by
+          :func:`~CompactOccupation.to_dict`
+          )pbdoc",
+          py::arg("data"));
+
   py::class_<clexmonte::state_type>(m, "MonteCarloState",
                                     R"pbdoc(
       Cluster expansion model state for Monte Carlo simulations
@@ -104,6 +222,9 @@ PYBIND11_MODULE(_clexmonte_state, m) {
       .. rubric:: Special Methods
 
       - MonteCarloState may be copied with `copy.copy` or `copy.deepcopy`.
+      - MonteCarloState may be pickled. Its configuration is unpickled in a
+        new :class:`~libcasm.configuration.SupercellSet`, with a prim
+        constructed from the pickled :class:`~libcasm.xtal.Prim`.
 
 
       )pbdoc")
@@ -133,6 +254,82 @@ PYBIND11_MODULE(_clexmonte_state, m) {
                      R"pbdoc(
           libcasm.configuration.Configuration: The configuration
           )pbdoc")
+      .def(
+          "occupation",
+          [](py::object self_obj, bool writable) -> py::object {
+            auto &self = self_obj.cast<clexmonte::state_type &>();
+            Eigen::VectorXi &occupation = clexmonte::get_occupation(self);
+            if (writable) {
+              return py::cast(occupation,
+                              py::return_value_policy::reference_internal,
+                              self_obj);
+            }
+            return py::cast(static_cast<Eigen::VectorXi const &>(occupation),
+                            py::return_value_policy::reference_internal,
+                            self_obj);
+          },
+          R"pbdoc(
+          Return a view of the occupation vector, without copying
+
+          Parameters
+          ----------
+          writable: bool = False
+              If True, the view is writable, and changes modify the state's
+              occupation. Changing the occupation during a run, or of a
+              state with an occupation location tracker, invalidates the
+              tracker.
+
+          Returns
+          -------
+          occupation: numpy.ndarray[numpy.int32[n_sites]]
+              A view of the occupation vector, which keeps this state alive.
+              Read-only unless `writable` is True. Reassigning
+              `configuration` invalidates the view.
+          )pbdoc",
+          py::arg("writable") = false)
+      .def(
+          "compact_occupation",
+          [](clexmonte::state_type const &self, int bits_per_value) {
+            return clexmonte::make_compact_occupation(
+                clexmonte::get_occupation(self), bits_per_value);
+          },
+          R"pbdoc(
+          Return a compact copy of the occupation
+
+          Parameters
+          ----------
+          bits_per_value : int = 0
+              Bits per site, one of 1, 2, 4, or 8. If 0, the fewest bits that
+              hold the maximum occupation index are used.
+
+          Returns
+          -------
+          compact_occupation : CompactOccupation
+              A copy of the occupation.
+          )pbdoc",
+          py::arg("bits_per_value") = 0)
+      .def(
+          "set_compact_occupation",
+          [](clexmonte::state_type &self,
+             clexmonte::CompactOccupation const &compact_occupation) {
+            Eigen::VectorXi &occupation = clexmonte::get_occupation(self);
+            if (compact_occupation.size() != occupation.size()) {
+              throw std::runtime_error(
+                  "Error in MonteCarloState.set_compact_occupation: size "
+                  "mismatch");
+            }
+            compact_occupation.to_vector(occupation);
+          },
+          R"pbdoc(
+          Set the occupation from a compact occupation
+
+          Parameters
+          ----------
+          compact_occupation : CompactOccupation
+              The occupation, which must have the same number of sites as
+              this state.
+          )pbdoc",
+          py::arg("compact_occupation"))
       .def_readwrite("conditions", &clexmonte::state_type::conditions,
                      R"pbdoc(
          libcasm.monte.ValueMap: The thermodynamic conditions
@@ -211,7 +408,39 @@ PYBIND11_MODULE(_clexmonte_state, m) {
           data : json
               The `MonteCarloState reference (TODO) <https://prisms-center.github.io/CASMcode_docs/formats/casm/clex/Configuration/>`_ documents the expected format for MonteCarloState."
           )pbdoc",
-          py::arg("write_prim_basis") = false);
+          py::arg("write_prim_basis") = false)
+      .def(py::pickle(
+          [](clexmonte::state_type const &self) {
+            // the prim is pickled as an xtal.Prim dict
+            py::object prim = py::cast(self.configuration.supercell->prim);
+            py::object xtal_prim_data =
+                prim.attr("xtal_prim").attr("to_dict")();
+            jsonParser json;
+            to_json(self, json);
+            return py::make_tuple(xtal_prim_data,
+                                  static_cast<nlohmann::json>(json));
+          },
+          [](py::tuple t) {
+            if (t.size() != 2) {
+              throw std::runtime_error(
+                  "Error unpickling libcasm.clexmonte.MonteCarloState: invalid "
+                  "state");
+            }
+            py::module configuration =
+                py::module::import("libcasm.configuration");
+            py::object xtal_prim = py::module::import("libcasm.xtal")
+                                       .attr("Prim")
+                                       .attr("from_dict")(t[0]);
+            auto supercells = configuration.attr("SupercellSet")(
+                                  configuration.attr("Prim")(xtal_prim))
+                                  .cast<std::shared_ptr<config::SupercellSet>>();
+            jsonParser json{t[1].cast<nlohmann::json>()};
+            InputParser<clexmonte::state_type> parser(json, *supercells);
+            std::runtime_error error_if_invalid{
+                "Error unpickling libcasm.clexmonte.MonteCarloState"};
+            report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+            return std::move(*parser.value);
+          }));
 
   py::class_<clexmonte::StateModifyingFunction>(m, "StateModifyingFunction",
                                                 R"pbdoc(
@@ -13,6 +13,7 @@
 // clexmonte
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/system/System.hh"
+#include "casm/clexmonte/system/bulk_evaluation.hh"
 #include "casm/clexmonte/system/io/json/System_json_io.hh"
 
 #define STRINGIFY(x) #x
@@ -33,6 +34,20 @@ std::shared_ptr<clexmonte::System> make_system(
       _shared_prim, _composition_converter, _n_dimensions);
 }
 
+/// \brief Parse a System, throwing with `error_message` if the input is
+///     invalid
+std::shared_ptr<clexmonte::System> parse_system(
+    nlohmann::json const &data, std::vector<std::string> const &_search_path,
+    std::string error_message) {
+  jsonParser json{data};
+  std::vector<fs::path> search_path(_search_path.begin(), _search_path.end());
+  InputParser<clexmonte::System> parser(json, search_path);
+  std::runtime_error error_if_invalid{error_message};
+  report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+  std::shared_ptr<clexmonte::System> system(parser.value.release());
+  return system;
+}
+
 template <typename T>
 std::vector<std::string> get_keys(std::map<std::string, T> map) {
   std::vector<std::string> keys;
@@ -69,6 +84,14 @@ PYBIND11_MODULE(_clexmonte_system, m) {
         parametric composition axes, order parameter definitions, neighbor
         lists, and cluster expansion basis sets and coefficients.
 
+      A System constructed by :func:`System.from_dict` can be pickled, for
+      use with `multiprocessing` or `concurrent.futures`. It is pickled as its
+      input and absolute search path, and unpickled by parsing the input
+      again. Compiled clexulators are loaded rather than recompiled if they
+      are up to date, or are found in the clexulator cache
+      ("clexulator_cache_dir"), which is pickled as an absolute path.
+      Cached supercell data is not pickled.
+
       )pbdoc")
       .def(py::init<>(&make_system),
            R"pbdoc(
@@ -115,6 +138,19 @@ PYBIND11_MODULE(_clexmonte_system, m) {
           libcasm.composition.CompositionCalculator: Calculator for total and \
           sublattice compositions from an integer occupation array.
           )pbdoc")
+      .def_property_readonly(
+          "startup_timings",
+          [](clexmonte::System const &m) -> nlohmann::json {
+            jsonParser json;
+            to_json(m.startup_timings, json);
+            return static_cast<nlohmann::json>(json);
+          },
+          R"pbdoc(
+          dict: Wall-clock times of startup phases, such as parsing the \
+          system input, compiling clexulators, and constructing supercell \
+          data and KMC event lists. Each phase name maps to a dict with \
+          "n_calls" and "total_time_s".
+          )pbdoc")
       .def_property_readonly(
           "species_list",
           [](clexmonte::System &m) -> std::vector<xtal::Molecule> const & {
@@ -464,6 +500,146 @@ PYBIND11_MODULE(_clexmonte_system, m) {
           )pbdoc",
           py::arg("state"), py::arg("key"))
       //
+      .def(
+          "bulk_clex_per_unitcell",
+          [](clexmonte::System &m, clexmonte::state_type const &state,
+             std::string key,
+             Eigen::Ref<clexmonte::bulk_occupation_type const> const
+                 &occupation,
+             Index n_threads) -> Eigen::VectorXd {
+            py::gil_scoped_release release;
+            return clexmonte::bulk_clex_per_unitcell(m, state, key, occupation,
+                                                     n_threads);
+          },
+          R"pbdoc(
+          Evaluate a cluster expansion for many configurations in one supercell
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              A state in the supercell, which gives the supercell and any
+              DoF values other than occupation. Its occupation is not used.
+          key : str
+              Cluster expansion name
+          occupation : numpy.ndarray[numpy.int32[n_configurations, n_sites]]
+              Occupations, one row per configuration.
+          n_threads : int = 1
+              Number of threads. Each thread uses its own calculator, and
+              all share the supercell neighbor list.
+
+          Returns
+          -------
+          value : numpy.ndarray[numpy.float64[n_configurations]]
+              The cluster expansion value, per unit cell, of each
+              configuration.
+          )pbdoc",
+          py::arg("state"), py::arg("key"), py::arg("occupation"),
+          py::arg("n_threads") = 1)
+      .def(
+          "bulk_multiclex_per_unitcell",
+          [](clexmonte::System &m, clexmonte::state_type const &state,
+             std::string key,
+             Eigen::Ref<clexmonte::bulk_occupation_type const> const
+                 &occupation,
+             Index n_threads) -> Eigen::MatrixXd {
+            py::gil_scoped_release release;
+            return clexmonte::bulk_multiclex_per_unitcell(
+                m, state, key, occupation, n_threads);
+          },
+          R"pbdoc(
+          Evaluate a multi-cluster expansion for many configurations in one
+          supercell
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              A state in the supercell, which gives the supercell and any
+              DoF values other than occupation. Its occupation is not used.
+          key : str
+              Multi-cluster expansion name
+          occupation : numpy.ndarray[numpy.int32[n_configurations, n_sites]]
+              Occupations, one row per configuration.
+          n_threads : int = 1
+              Number of threads. Each thread uses its own calculator, and
+              all share the supercell neighbor list.
+
+          Returns
+          -------
+          value : numpy.ndarray[numpy.float64[n_configurations, n_coefficients]]
+              The multi-cluster expansion values, per unit cell, with one
+              row per configuration.
+          )pbdoc",
+          py::arg("state"), py::arg("key"), py::arg("occupation"),
+          py::arg("n_threads") = 1)
+      .def(
+          "bulk_corr_per_unitcell",
+          [](clexmonte::System &m, clexmonte::state_type const &state,
+             std::string key,
+             Eigen::Ref<clexmonte::bulk_occupation_type const> const
+                 &occupation,
+             Index n_threads) -> Eigen::MatrixXd {
+            py::gil_scoped_release release;
+            return clexmonte::bulk_corr_per_unitcell(m, state, key, occupation,
+                                                     n_threads);
+          },
+          R"pbdoc(
+          Evaluate correlations for many configurations in one supercell
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              A state in the supercell, which gives the supercell and any
+              DoF values other than occupation. Its occupation is not used.
+          key : str
+              Basis set name
+          occupation : numpy.ndarray[numpy.int32[n_configurations, n_sites]]
+              Occupations, one row per configuration.
+          n_threads : int = 1
+              Number of threads. Each thread uses its own calculator, and
+              all share the supercell neighbor list.
+
+          Returns
+          -------
+          corr : numpy.ndarray[numpy.float64[n_configurations, n_corr]]
+              The correlations, per unit cell, with one row per
+              configuration.
+          )pbdoc",
+          py::arg("state"), py::arg("key"), py::arg("occupation"),
+          py::arg("n_threads") = 1)
+      .def(
+          "bulk_order_parameter",
+          [](clexmonte::System &m, clexmonte::state_type const &state,
+             std::string key,
+             Eigen::Ref<clexmonte::bulk_occupation_type const> const
+                 &occupation,
+             Index n_threads) -> Eigen::MatrixXd {
+            py::gil_scoped_release release;
+            return clexmonte::bulk_order_parameter(m, state, key, occupation,
+                                                   n_threads);
+          },
+          R"pbdoc(
+          Evaluate an order parameter for many configurations in one supercell
+
+          Parameters
+          ----------
+          state : libcasm.clexmonte.MonteCarloState
+              A state in the supercell, which gives the supercell and any
+              DoF values other than occupation. Its occupation is not used.
+          key : str
+              Order parameter name
+          occupation : numpy.ndarray[numpy.int32[n_configurations, n_sites]]
+              Occupations, one row per configuration.
+          n_threads : int = 1
+              Number of threads. Each thread uses its own calculator, and
+              all share the supercell neighbor list.
+
+          Returns
+          -------
+          value : numpy.ndarray[numpy.float64[n_configurations, n_components]]
+              The order parameter values, with one row per configuration.
+          )pbdoc",
+          py::arg("state"), py::arg("key"), py::arg("occupation"),
+          py::arg("n_threads") = 1)
       .def_property_readonly(
           "dof_space_keys",
           [](clexmonte::System &m) -> std::vector<std::string> {
@@ -600,20 +776,45 @@ PYBIND11_MODULE(_clexmonte_system, m) {
               The multi-site swap types for semi-grand canonical Monte Carlo
               events. May be empty.
           )pbdoc")
+      .def_property(
+          "supercell_data_max_size_in_bytes",
+          [](clexmonte::System &m) -> std::optional<Index> {
+            return m.supercell_data.max_size_in_bytes();
+          },
+          [](clexmonte::System &m, std::optional<Index> max_size_in_bytes) {
+            m.supercell_data.set_max_size_in_bytes(max_size_in_bytes);
+          },
+          R"pbdoc(
+          Optional[int]: Maximum estimated total size, in bytes, of cached \
+          supercell-specific data (neighbor lists, index conversions, and \
+          calculators). If set, least recently used supercells are evicted as \
+          necessary. If None (default), supercell data is not evicted.
+          )pbdoc")
+      .def_property_readonly(
+          "supercell_data_size_in_bytes",
+          [](clexmonte::System &m) -> Index {
+            return m.supercell_data.size_in_bytes();
+          },
+          R"pbdoc(
+          int: Estimated total size, in bytes, of cached supercell-specific \
+          data.
+          )pbdoc")
+      .def(
+          "clear_supercell_data",
+          [](clexmonte::System &m) { clexmonte::clear_supercell_data(m); },
+          R"pbdoc(
+          Remove all cached supercell-specific data
+
+          Supercell data in use by a running calculation remains valid until
+          the calculation no longer uses it.
+          )pbdoc")
       //
       .def_static(
           "from_dict",
           [](const nlohmann::json &data,
              std::vector<std::string> _search_path) {
-            jsonParser json{data};
-            std::vector<fs::path> search_path(_search_path.begin(),
-                                              _search_path.end());
-            InputParser<clexmonte::System> parser(json, search_path);
-            std::runtime_error error_if_invalid{
-                "Error in libcasm.clexmonte.System.from_dict"};
-            report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
-            std::shared_ptr<clexmonte::System> system(parser.value.release());
-            return system;
+            return parse_system(data, _search_path,
+                                "Error in libcasm.clexmonte.System.from_dict");
           },
           R"pbdoc(
           Construct a System from a Python dict.
@@ -628,6 +829,29 @@ PYBIND11_MODULE(_clexmonte_system, m) {
               to the paths specified by `search_path`.
           )pbdoc",
           py::arg("data"), py::arg("search_path") = std::vector<std::string>())
+      .def(py::pickle(
+          [](clexmonte::System const &m) {
+            if (!m.input.has_value()) {
+              throw std::runtime_error(
+                  "Error pickling libcasm.clexmonte.System: only a System "
+                  "constructed by System.from_dict can be pickled");
+            }
+            std::vector<std::string> search_path;
+            for (fs::path const &path : m.input_search_path) {
+              search_path.push_back(path.string());
+            }
+            return py::make_tuple(static_cast<nlohmann::json>(*m.input),
+                                  search_path);
+          },
+          [](py::tuple t) {
+            if (t.size() != 2) {
+              throw std::runtime_error(
+                  "Error unpickling libcasm.clexmonte.System: invalid state");
+            }
+            return parse_system(t[0].cast<nlohmann::json>(),
+                                t[1].cast<std::vector<std::string>>(),
+                                "Error unpickling libcasm.clexmonte.System");
+          }))
       .def("make_default_configuration", &clexmonte::make_default_configuration,
            R"pbdoc(
           Construct a default configuration in a specified supercell
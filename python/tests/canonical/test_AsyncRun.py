@@ -0,0 +1,164 @@
+import asyncio
+import concurrent.futures
+import threading
+
+import pytest
+
+import libcasm.clexmonte as clexmonte
+import libcasm.monte as monte
+
+
+def make_run_manager(calculator, output_dir, count):
+    thermo = calculator.make_sampling_fixture_params_from_dict(
+        data={
+            "sampling": {
+                "sample_by": "pass",
+                "spacing": "linear",
+                "begin": 0,
+                "period": 1,
+                "quantities": ["potential_energy"],
+            },
+            "completion_check": {
+                "cutoff": {"count": {"min": count, "max": count}},
+            },
+            "results_io": {
+                "method": "json",
+                "kwargs": {"output_dir": str(output_dir)},
+            },
+        },
+        label="thermo",
+    )
+    return clexmonte.RunManager(
+        engine=monte.RandomNumberEngine(),
+        sampling_fixture_params=[thermo],
+        global_cutoff=True,
+    )
+
+
+def make_state(calculator):
+    initial_state, motif = clexmonte.make_canonical_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_composition": [0.5],
+        },
+        min_volume=100,
+    )
+    return initial_state
+
+
+def test_AsyncRun_1(Clex_ZrO_Occ_System, tmp_path):
+    """Runs started by run_async finish, report telemetry, and are awaitable"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+    pool = clexmonte.AsyncRunPool(n_workers=2)
+    assert pool.n_workers == 2
+
+    telemetry = clexmonte.TelemetryChannel()
+    run_manager = make_run_manager(calculator, tmp_path / "output", 20)
+    run = calculator.run_async(
+        state=make_state(calculator),
+        run_manager=run_manager,
+        pool=pool,
+        telemetry=telemetry,
+    )
+    done = []
+    callback_called = threading.Event()
+
+    def on_done(r):
+        done.append(r.status)
+        callback_called.set()
+
+    run.add_done_callback(on_done)
+    assert run.telemetry is telemetry
+
+    assert run.result(timeout=60.0) is run_manager
+    assert run.status == "finished"
+    assert run.done() is True
+    assert callback_called.wait(timeout=60.0) is True
+    assert done == ["finished"]
+    assert run_manager.sampling_fixtures[0].results.sample_count[-1] >= 19
+    records = telemetry.read()
+    assert len(records) > 0
+    assert records[-1]["is_final"] is True
+
+    # the temporary telemetry channel and RunControl are removed
+    assert calculator.telemetry is None
+    assert calculator.run_control is None
+
+    # await, and concurrent.futures
+    async def main():
+        return await calculator.run_async(
+            state=make_state(calculator),
+            run_manager=make_run_manager(calculator, tmp_path / "output2", 10),
+            pool=pool,
+        )
+
+    assert isinstance(asyncio.run(main()), clexmonte.RunManager)
+
+    future = calculator.run_async(
+        state=make_state(calculator),
+        run_manager=make_run_manager(calculator, tmp_path / "output3", 10),
+        pool=pool,
+    ).as_concurrent_future()
+    assert isinstance(future.result(timeout=60.0), clexmonte.RunManager)
+
+
+def test_AsyncRun_2(Clex_ZrO_Occ_System, tmp_path):
+    """Cancelling stops a running run and prevents a pending run"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+    other_calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+    pool = clexmonte.AsyncRunPool(n_workers=1)
+
+    # a run that never completes on its own
+    calculator.run_control = clexmonte.RunControl(function=lambda r: "extend")
+    telemetry = clexmonte.TelemetryChannel()
+    run_manager = make_run_manager(calculator, tmp_path / "output", 10)
+    running = calculator.run_async(
+        state=make_state(calculator),
+        run_manager=run_manager,
+        pool=pool,
+        telemetry=telemetry,
+    )
+    pending = other_calculator.run_async(
+        state=make_state(other_calculator),
+        run_manager=make_run_manager(other_calculator, tmp_path / "output2", 10),
+        pool=pool,
+    )
+    while len(telemetry.read()) == 0:
+        assert running.wait(timeout=0.01) is False
+    assert running.running() is True
+    assert pool.n_pending == 1
+
+    assert pending.cancel() is True
+    assert running.cancel() is True
+    assert running.wait(timeout=60.0) is True
+    assert pending.wait(timeout=60.0) is True
+
+    assert running.cancelled() is True
+    assert pending.cancelled() is True
+    with pytest.raises(concurrent.futures.CancelledError):
+        running.result()
+    assert calculator.run_control.stopped is True
+    assert len(run_manager.sampling_fixtures[0].results.sample_count) > 0
+
+    # a finished run cannot be cancelled
+    calculator.run_control = None
+    run = calculator.run_async(
+        state=make_state(calculator),
+        run_manager=make_run_manager(calculator, tmp_path / "output3", 10),
+        pool=pool,
+    )
+    run.wait()
+    assert run.cancel() is False
+    assert run.status == "finished"
@@ -0,0 +1,75 @@
+import numpy as np
+
+import libcasm.clexmonte as clexmonte
+
+
+def test_BatchedSamplingFunction_1(Clex_ZrO_Occ_System, tmp_path):
+    """Batched values match the occupations sampled during a run"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+
+    batch_sizes = []
+
+    def occupation_sum(occupation):
+        assert not occupation.flags.writeable
+        batch_sizes.append(occupation.shape[0])
+        return np.sum(occupation, axis=1).reshape((-1, 1)).astype("float64")
+
+    f = clexmonte.BatchedSamplingFunction(
+        name="occupation_sum",
+        description="Sum of occupation indices",
+        component_names=["0"],
+        batch_size=16,
+        function=occupation_sum,
+        calculator=calculator,
+    )
+    calculator.sampling_functions[f.name] = f.sampling_function()
+
+    thermo = calculator.make_sampling_fixture_params_from_dict(
+        data={
+            "sampling": {
+                "sample_by": "pass",
+                "spacing": "linear",
+                "begin": 0,
+                "period": 1,
+                "quantities": ["potential_energy", "occupation_sum"],
+            },
+            "completion_check": {
+                "cutoff": {"count": {"min": 40, "max": 40}},
+            },
+            "results_io": {
+                "method": "json",
+                "kwargs": {"output_dir": str(tmp_path / "output")},
+            },
+        },
+        label="thermo",
+    )
+
+    initial_state, motif = clexmonte.make_canonical_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_composition": [0.5],
+        },
+        min_volume=100,
+    )
+    expected_sum = np.sum(initial_state.configuration.occupation)
+
+    sampling_fixture = calculator.run_fixture(
+        state=initial_state,
+        sampling_fixture_params=thermo,
+    )
+    sampled_rows = sampling_fixture.results.sampler_values("occupation_sum")
+    n_samples = sampled_rows.shape[0]
+    assert n_samples == 40
+    assert np.allclose(sampled_rows[:, 0], np.arange(n_samples))
+
+    # canonical runs conserve composition, so every sample has the same sum
+    values = f.values
+    assert values.shape == (n_samples, 1)
+    assert np.allclose(values[:, 0], expected_sum)
+    assert batch_sizes == [16, 16, 8]
+    assert f.n_batches == 3
@@ -2,6 +2,7 @@ import numpy as np
 import pytest
 
 import libcasm.clexmonte as clexmonte
+import libcasm.monte as monte
 import libcasm.xtal as xtal
 
 
@@ -126,3 +127,117 @@ def test_run_fixture_1(Clex_ZrO_Occ_System, tmp_path):
         expected_size=1,
         is_canonical=True,
     )
+
+
+def test_run_parallel_chains_1(Clex_ZrO_Occ_System, tmp_path):
+    """Independent chains of one state, with pooled observations"""
+    system = Clex_ZrO_Occ_System
+    output_dir = tmp_path / "output"
+    summary_file = output_dir / "summary.json"
+
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+        params={"n_threads": 2},
+    )
+
+    thermo = calculator.make_default_sampling_fixture_params(
+        label="thermo",
+        output_dir=str(output_dir),
+    )
+    run_manager = clexmonte.RunManager(
+        engine=monte.RandomNumberEngine(),
+        sampling_fixture_params=[thermo],
+        global_cutoff=True,
+    )
+
+    initial_state, motif = clexmonte.make_canonical_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_composition": [0.5],
+        },
+        min_volume=1000,
+    )
+
+    run_manager = calculator.run_parallel_chains(
+        state=initial_state,
+        run_manager=run_manager,
+        n_chains=4,
+    )
+    assert isinstance(run_manager, clexmonte.RunManager)
+
+    # The chains do not change the composition, and the final state of the
+    # first chain is the current state
+    composition_calculator = system.composition_calculator
+    assert np.allclose(
+        composition_calculator.mean_num_each_component(
+            initial_state.configuration.occupation
+        ),
+        [2.0, 1.0, 1.0],
+    )
+    assert isinstance(calculator.state_data, clexmonte.StateData)
+
+    pytest.helpers.validate_summary_file(
+        summary_file=summary_file,
+        expected_size=1,
+        is_canonical=True,
+    )
+
+
+def test_run_check_by_pass_1(Clex_ZrO_Occ_System, tmp_path):
+    """Checking sampling and completion once per pass gives the same run"""
+    system = Clex_ZrO_Occ_System
+
+    def run(metropolis_check_by_pass, sample_by):
+        calculator = clexmonte.MonteCalculator(
+            method="canonical",
+            system=system,
+            params={"metropolis_check_by_pass": metropolis_check_by_pass},
+        )
+        thermo = calculator.make_sampling_fixture_params_from_dict(
+            data={
+                "sampling": {
+                    "sample_by": sample_by,
+                    "spacing": "linear",
+                    "begin": 0,
+                    "period": 1,
+                    "quantities": ["potential_energy"],
+                },
+                "completion_check": {
+                    "cutoff": {"count": {"min": 20, "max": 20}},
+                },
+                "results_io": {
+                    "method": "json",
+                    "kwargs": {"output_dir": str(tmp_path / "output")},
+                },
+            },
+            label="thermo",
+        )
+        engine = monte.RandomNumberEngine()
+        engine.seed(1234)
+        run_manager = clexmonte.RunManager(
+            engine=engine,
+            sampling_fixture_params=[thermo],
+            global_cutoff=True,
+        )
+        initial_state, motif = clexmonte.make_canonical_initial_state(
+            calculator=calculator,
+            conditions={
+                "temperature": 300.0,
+                "param_composition": [0.5],
+            },
+            min_volume=64,
+        )
+        calculator.run(state=initial_state, run_manager=run_manager)
+        results = run_manager.sampling_fixtures[0].results
+        return (initial_state.configuration.occupation, results.sample_count)
+
+    occupation, sample_count = run(False, "pass")
+    occupation_by_pass, sample_count_by_pass = run(True, "pass")
+    assert np.array_equal(occupation, occupation_by_pass)
+    assert list(sample_count) == list(sample_count_by_pass)
+
+    # samples due by step may be due at any step
+    with pytest.raises(RuntimeError):
+        run(True, "step")
@@ -0,0 +1,64 @@
+import libcasm.clexmonte as clexmonte
+
+
+def test_RunControl_1(Clex_ZrO_Occ_System, tmp_path):
+    """A RunControl stops a run before its completion checks are met"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+
+    n_calls = []
+
+    def stop_after_10_samples(results):
+        n_calls.append(len(results.sample_count))
+        if len(results.sample_count) >= 10:
+            return "stop"
+        return None
+
+    run_control = clexmonte.RunControl(function=stop_after_10_samples)
+    calculator.run_control = run_control
+    assert calculator.run_control is run_control
+    assert run_control.action == "proceed"
+
+    thermo = calculator.make_sampling_fixture_params_from_dict(
+        data={
+            "sampling": {
+                "sample_by": "pass",
+                "spacing": "linear",
+                "begin": 0,
+                "period": 1,
+                "quantities": ["potential_energy"],
+            },
+            "completion_check": {
+                "cutoff": {"count": {"min": 100, "max": 100}},
+            },
+            "results_io": {
+                "method": "json",
+                "kwargs": {"output_dir": str(tmp_path / "output")},
+            },
+        },
+        label="thermo",
+    )
+
+    initial_state, motif = clexmonte.make_canonical_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_composition": [0.5],
+        },
+        min_volume=100,
+    )
+
+    sampling_fixture = calculator.run_fixture(
+        state=initial_state,
+        sampling_fixture_params=thermo,
+    )
+    results = sampling_fixture.results
+    assert len(results.sample_count) == 10
+    assert n_calls == list(range(1, 11))
+    assert run_control.n_evaluations == 10
+    assert run_control.action == "stop"
+    assert run_control.stopped is True
+
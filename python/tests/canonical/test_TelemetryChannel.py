@@ -0,0 +1,70 @@
+import libcasm.clexmonte as clexmonte
+
+
+def test_TelemetryChannel_1(Clex_ZrO_Occ_System, tmp_path):
+    """Run progress is published to a TelemetryChannel"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="canonical",
+        system=system,
+    )
+    telemetry = clexmonte.TelemetryChannel(
+        capacity=1000,
+        sampler_names=["potential_energy"],
+    )
+    calculator.telemetry = telemetry
+    assert calculator.telemetry is telemetry
+
+    thermo = calculator.make_sampling_fixture_params_from_dict(
+        data={
+            "sampling": {
+                "sample_by": "pass",
+                "spacing": "linear",
+                "begin": 0,
+                "period": 1,
+                "quantities": ["potential_energy"],
+            },
+            "completion_check": {
+                "cutoff": {"count": {"min": 20, "max": 20}},
+            },
+            "results_io": {
+                "method": "json",
+                "kwargs": {"output_dir": str(tmp_path / "output")},
+            },
+        },
+        label="thermo",
+    )
+
+    initial_state, motif = clexmonte.make_canonical_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_composition": [0.5],
+        },
+        min_volume=100,
+    )
+
+    calculator.run_fixture(
+        state=initial_state,
+        sampling_fixture_params=thermo,
+    )
+
+    records = telemetry.read()
+    assert len(records) == telemetry.n_published
+    assert telemetry.n_dropped == 0
+    assert telemetry.n_unread == 0
+    assert len(records) >= 2
+
+    n_steps = [r["n_steps"] for r in records]
+    assert n_steps == sorted(n_steps)
+    for r in records:
+        assert r["sampling_fixture_label"] == "thermo"
+        assert r["n_accept"] + r["n_reject"] == r["n_steps"]
+        assert 0.0 <= r["acceptance_rate"] <= 1.0
+
+    final = records[-1]
+    assert final["is_final"] is True
+    assert final["is_complete"] is True
+    assert final["n_passes"] == 20
+    assert final["sampled_values"]["potential_energy"].shape == (1,)
+    assert telemetry.read() == []
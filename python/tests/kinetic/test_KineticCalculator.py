@@ -0,0 +1,120 @@
+import numpy as np
+import pytest
+
+import libcasm.clexmonte as clexmonte
+
+
+def test_constructors_1(FCCBinaryVacancy_kmc_System):
+    system = FCCBinaryVacancy_kmc_System
+    assert system.composition_calculator.components() == ["A", "B", "Va"]
+
+    calculator = clexmonte.MonteCalculator(
+        method="kinetic",
+        system=system,
+        params={
+            "event_list_params": {"impact_table": "csr"},
+            "event_selector": {"type": "sum_tree"},
+            "n_threads": 2,
+        },
+    )
+    assert isinstance(calculator, clexmonte.MonteCalculator)
+    assert calculator.time_sampling_allowed is True
+
+    # default configuration is occupied by A: [1.0, 0.0, 0.0], which
+    # corresponds to the origin composition
+    state = clexmonte.MonteCarloState(
+        configuration=system.make_default_configuration(
+            transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+        ),
+        conditions={
+            "temperature": 600.0,
+            "param_composition": [0.0, 0.0],
+        },
+    )
+    calculator.set_state_and_potential(state=state)
+    assert isinstance(calculator.potential, clexmonte.MontePotential)
+    assert isinstance(calculator.state_data, clexmonte.StateData)
+    assert np.allclose(
+        state.conditions.vector_values["mol_composition"], [1.0, 0.0, 0.0]
+    )
+
+    assert "mean_R_squared_collective_isotropic" in calculator.sampling_functions
+    assert "total_rate_by_event_type" in calculator.sampling_functions
+
+
+def test_invalid_params_1(FCCBinaryVacancy_kmc_System):
+    system = FCCBinaryVacancy_kmc_System
+
+    # the "lotto_rejection_free" event selector requires the "map" impact table
+    with pytest.raises(Exception):
+        clexmonte.MonteCalculator(
+            method="kinetic",
+            system=system,
+            params={
+                "event_list_params": {"impact_table": "csr"},
+                "event_selector": {"type": "lotto_rejection_free"},
+            },
+        )
+
+
+def test_event_list_arrays_1(FCCBinaryVacancy_kmc_System, tmp_path):
+    system = FCCBinaryVacancy_kmc_System
+    calculator = clexmonte.MonteCalculator(
+        method="kinetic",
+        system=system,
+        params={
+            "event_selector": {"type": "sum_tree"},
+            "store_event_states": True,
+        },
+    )
+    kinetics = calculator.make_sampling_fixture_params_from_dict(
+        data={
+            "sampling": {
+                "sample_by": "step",
+                "spacing": "linear",
+                "begin": 0,
+                "period": 1,
+                "quantities": ["potential_energy"],
+            },
+            "completion_check": {
+                "cutoff": {"count": {"min": 20, "max": 20}},
+            },
+            "results_io": {
+                "method": "json",
+                "kwargs": {"output_dir": str(tmp_path / "output")},
+            },
+        },
+        label="kinetics",
+    )
+    state = clexmonte.MonteCarloState(
+        configuration=system.make_default_configuration(
+            transformation_matrix_to_super=np.eye(3, dtype="int") * 4,
+        ),
+        conditions={
+            "temperature": 600.0,
+            "mol_composition": [0.875, 0.0625, 0.0625],
+        },
+    )
+    calculator.run_fixture(state=state, sampling_fixture_params=kinetics)
+
+    event_list = calculator.kmc_event_list_arrays()
+    n_events = event_list["linear_index"].shape[0]
+    assert n_events > 0
+    assert event_list["prim_event_index"].shape == (n_events,)
+    assert event_list["unitcell_index"].shape == (n_events,)
+    assert event_list["linear_site_index"].shape[0] == n_events
+    assert np.all(np.diff(event_list["linear_index"]) > 0)
+    assert np.all(event_list["unitcell_index"] < 64)
+    assert np.all(event_list["linear_site_index"][:, 0] >= 0)
+
+    event_states = calculator.kmc_event_state_arrays()
+    assert event_states["rate"].shape == (n_events,)
+    assert event_states["is_allowed"].dtype == np.bool_
+    assert "freq" in event_states
+
+    # the sum_tree selector keeps the rates of all events current
+    rates = calculator.kmc_calculate_event_rates()
+    assert rates.shape == (n_events,)
+    assert np.all(rates >= 0.0)
+    assert np.count_nonzero(rates) > 0
+    assert np.allclose(rates, event_states["rate"])
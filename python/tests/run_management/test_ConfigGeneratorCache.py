@@ -0,0 +1,105 @@
+import threading
+
+import numpy as np
+
+import libcasm.clexmonte as clexmonte
+import libcasm.configuration as casmconfig
+
+
+def test_FixedConfigGenerator_cache(Clex_ZrO_Occ_System):
+    system = Clex_ZrO_Occ_System
+    cache = clexmonte.ConfigGeneratorCache()
+
+    T = np.eye(3, dtype="int") * 4
+    supercell = casmconfig.Supercell(
+        prim=system.prim,
+        transformation_matrix_to_super=T,
+    )
+    motif = casmconfig.Configuration(
+        casmconfig.Supercell(
+            prim=system.prim,
+            transformation_matrix_to_super=np.eye(3, dtype="int"),
+        )
+    )
+
+    # the same motif and supercell are only tiled once
+    for i in range(5):
+        config_generator = clexmonte.FixedConfigGenerator(
+            supercell=supercell,
+            motif=motif,
+            cache=cache,
+        )
+        config = config_generator(None, [])
+        assert config.supercell == supercell
+    assert len(cache) == 1
+    assert cache.n_misses == 1
+    assert cache.n_hits == 4
+
+    # a different supercell is tiled again
+    clexmonte.FixedConfigGenerator(
+        supercell=casmconfig.Supercell(
+            prim=system.prim,
+            transformation_matrix_to_super=T * 2,
+        ),
+        motif=motif,
+        cache=cache,
+    )
+    assert len(cache) == 2
+
+
+def test_CachedConfigGenerator(Clex_ZrO_Occ_System):
+    system = Clex_ZrO_Occ_System
+    default_state = system.make_default_state(
+        transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+    )
+
+    n_calls = [0]
+
+    def config_generator(conditions, completed_runs):
+        n_calls[0] += 1
+        return default_state.configuration
+
+    cached = clexmonte.CachedConfigGenerator(
+        config_generator=config_generator,
+        condition_keys=["param_chem_pot"],
+    )
+
+    # varying temperature reuses the stored configuration
+    for temperature in [300.0, 400.0, 500.0]:
+        conditions = {"temperature": temperature, "param_chem_pot": [0.0]}
+        config = cached(conditions, [])
+        assert config.supercell == default_state.configuration.supercell
+    assert n_calls[0] == 1
+
+    # a different chemical potential generates a new configuration
+    cached({"temperature": 300.0, "param_chem_pot": [1.0]}, [])
+    assert n_calls[0] == 2
+    assert len(cached.cache) == 2
+
+
+def test_ConfigGeneratorCache_threads(Clex_ZrO_Occ_System):
+    system = Clex_ZrO_Occ_System
+    default_state = system.make_default_state(
+        transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+    )
+    cache = clexmonte.ConfigGeneratorCache()
+    key = clexmonte.make_config_cache_key(
+        "test",
+        transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+    )
+
+    results = [None] * 4
+
+    def work(i):
+        results[i] = cache.get_or_make(key, lambda: default_state.configuration)
+
+    threads = [threading.Thread(target=work, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert len(cache) == 1
+    assert cache.n_hits + cache.n_misses == 4
+    for x in results:
+        assert x.supercell == default_state.configuration.supercell
@@ -1,3 +1,4 @@
+import numpy as np
 import pytest
 
 import libcasm.clexmonte as clexmonte
@@ -112,3 +113,118 @@ def test_run_series_1(Clex_ZrO_Occ_System, tmp_path):
     pytest.helpers.validate_summary_file(
         summary_file=summary_file, expected_size=n_states
     )
+
+
+def test_run_series_2(Clex_ZrO_Occ_System, tmp_path):
+    """Independent runs, using the C++ series driver with 2 threads"""
+    system = Clex_ZrO_Occ_System
+
+    # construct a semi-grand canonical MonteCalculator
+    mc_calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical", system=system
+    )
+
+    # construct default sampling fixture parameters, without output
+    thermo = mc_calculator.make_default_sampling_fixture_params(
+        label="thermo",
+        write_results=False,
+    )
+
+    n_states = 4
+    state_generation = {
+        "method": "incremental",
+        "kwargs": {
+            "initial_configuration": {
+                "method": "fixed",
+                "kwargs": {
+                    "transformation_matrix_to_supercell": (
+                        np.eye(3, dtype="int") * 5
+                    ).tolist(),
+                },
+            },
+            "initial_conditions": {
+                "temperature": 300.0,
+                "param_chem_pot": [-4.0],
+            },
+            "conditions_increment": {
+                "temperature": 0.0,
+                "param_chem_pot": [0.5],
+            },
+            "n_states": n_states,
+            "dependent_runs": False,
+        },
+    }
+
+    completed_runs = clexmonte.run_series(
+        calculator=mc_calculator,
+        state_generation=state_generation,
+        sampling_fixture_params=[thermo],
+        engine=monte.RandomNumberEngine(),
+        n_threads=2,
+    )
+    assert len(completed_runs) == n_states
+    param_chem_pot = sorted(
+        run_data.conditions.vector_values["param_chem_pot"][0]
+        for run_data in completed_runs
+    )
+    assert np.allclose(param_chem_pot, [-4.0, -3.5, -3.0, -2.5])
+    for run_data in completed_runs:
+        assert isinstance(run_data, clexmonte.RunData)
+        assert isinstance(run_data.final_state, clexmonte.MonteCarloState)
+
+
+def test_run_series_3(Clex_ZrO_Occ_System, tmp_path):
+    """Independent runs with 4 threads, writing results to one directory"""
+    system = Clex_ZrO_Occ_System
+    output_dir = tmp_path / "output"
+    summary_file = output_dir / "summary.json"
+
+    # construct a semi-grand canonical MonteCalculator
+    mc_calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical", system=system
+    )
+
+    # construct default sampling fixture parameters, shared by all workers
+    thermo = mc_calculator.make_default_sampling_fixture_params(
+        label="thermo",
+        output_dir=str(output_dir),
+    )
+
+    n_states = 8
+    state_generation = {
+        "method": "incremental",
+        "kwargs": {
+            "initial_configuration": {
+                "method": "fixed",
+                "kwargs": {
+                    "transformation_matrix_to_supercell": (
+                        np.eye(3, dtype="int") * 3
+                    ).tolist(),
+                },
+            },
+            "initial_conditions": {
+                "temperature": 300.0,
+                "param_chem_pot": [-4.0],
+            },
+            "conditions_increment": {
+                "temperature": 0.0,
+                "param_chem_pot": [0.5],
+            },
+            "n_states": n_states,
+            "dependent_runs": False,
+        },
+    }
+
+    completed_runs = clexmonte.run_series(
+        calculator=mc_calculator,
+        state_generation=state_generation,
+        sampling_fixture_params=[thermo],
+        engine=monte.RandomNumberEngine(),
+        n_threads=4,
+    )
+    assert len(completed_runs) == n_states
+
+    # every run is in summary.json, though runs finish in any order
+    pytest.helpers.validate_summary_file(
+        summary_file=summary_file, expected_size=n_states
+    )
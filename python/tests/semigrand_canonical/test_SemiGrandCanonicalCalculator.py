@@ -1,3 +1,6 @@
+import math
+import pickle
+
 import numpy as np
 import pytest
 
@@ -132,6 +135,56 @@ def test_run_fixture_2(Clex_ZrO_Occ_System, tmp_path):
     )
 
 
+def test_run_fixture_screening_1(Clex_ZrO_Occ_System, tmp_path):
+    """Screening runs, for a range of param_chem_pot"""
+    system = Clex_ZrO_Occ_System
+
+    output_dir = tmp_path / "output"
+    summary_file = output_dir / "summary.json"
+
+    # construct a semi-grand canonical MonteCalculator
+    calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical",
+        system=system,
+    )
+
+    # construct screening sampling fixture parameters, with a cutoff
+    screening = calculator.make_screening_sampling_fixture_params(
+        label="screening",
+        output_dir=str(output_dir),
+    )
+    assert screening.sampling_params.sampler_names == [
+        "mol_composition",
+        "potential_energy",
+    ]
+    screening.completion_check_params.cutoff_params.max_count = 20
+
+    # construct the initial state (default configuration)
+    state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [-1.0],
+        },
+        min_volume=1000,
+    )
+
+    # Run several, w/ dependent runs
+    x_list = np.arange(-4.0, 0.01, step=1.0)
+    for x in x_list:
+        state.conditions.vector_values["param_chem_pot"] = [x]
+        sampling_fixture = calculator.run_fixture(
+            state=state,
+            sampling_fixture_params=screening,
+        )
+        assert isinstance(sampling_fixture, clexmonte.SamplingFixture)
+
+    pytest.helpers.validate_summary_file(
+        summary_file=summary_file, expected_size=len(x_list)
+    )
+    assert not (output_dir / "status.json").exists()
+
+
 def test_run_1(Clex_ZrO_Occ_System, tmp_path):
     """A single run, using RunManager"""
     system = Clex_ZrO_Occ_System
@@ -184,3 +237,97 @@ def test_run_1(Clex_ZrO_Occ_System, tmp_path):
     pytest.helpers.validate_summary_file(
         summary_file=summary_file, expected_size=len(x_list)
     )
+
+
+def test_occ_delta_per_supercell_batch_1(Clex_ZrO_Occ_System):
+    """Batched potential changes match one event per call"""
+    system = Clex_ZrO_Occ_System
+    calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical",
+        system=system,
+    )
+    state = clexmonte.MonteCarloState(
+        configuration=system.make_default_configuration(
+            transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+        ),
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [0.5],
+        },
+    )
+    calculator.set_state_and_potential(state=state)
+    potential = calculator.potential
+
+    # sites with more than one allowed occupant
+    n_unitcells = 8
+    occ_dof = system.prim.xtal_prim.occ_dof()
+    sites = [
+        b * n_unitcells + i
+        for b in range(len(occ_dof))
+        if len(occ_dof[b]) > 1
+        for i in range(n_unitcells)
+    ]
+
+    # events changing one or two sites, padded with -1
+    rng = np.random.default_rng(0)
+    n_events = 50
+    linear_site_index = np.full((n_events, 2), -1, dtype=np.int64)
+    new_occ = np.zeros((n_events, 2), dtype=np.int32)
+    for i in range(n_events):
+        n_sites = 1 + i % 2
+        linear_site_index[i, :n_sites] = rng.choice(sites, n_sites, replace=False)
+        new_occ[i, :n_sites] = 1
+
+    delta = potential.occ_delta_per_supercell_batch(
+        linear_site_index=linear_site_index,
+        new_occ=new_occ,
+    )
+    assert delta.shape == (n_events,)
+    for i in range(n_events):
+        mask = linear_site_index[i] >= 0
+        expected = potential.occ_delta_per_supercell(
+            linear_site_index=linear_site_index[i][mask].tolist(),
+            new_occ=new_occ[i][mask].tolist(),
+        )
+        assert np.isclose(delta[i], expected)
+
+    with pytest.raises(Exception):
+        potential.occ_delta_per_supercell_batch(
+            linear_site_index=linear_site_index,
+            new_occ=new_occ[:, :1],
+        )
+
+
+def test_pickle_1(Clex_ZrO_Occ_System):
+    system = Clex_ZrO_Occ_System
+
+    calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical",
+        system=system,
+    )
+    state = clexmonte.MonteCarloState(
+        configuration=system.make_default_configuration(
+            transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+        ),
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [0.0],
+        },
+    )
+    state.configuration.set_occ(0, 1)
+
+    # the system is pickled once, with the calculator
+    calculator_2, state_2 = pickle.loads(pickle.dumps((calculator, state)))
+    assert isinstance(calculator_2, clexmonte.MonteCalculator)
+    assert calculator_2.name == calculator.name
+    assert calculator_2.system.clex_keys == system.clex_keys
+    assert isinstance(state_2, clexmonte.MonteCarloState)
+    assert (state_2.configuration.occupation == state.configuration.occupation).all()
+    assert state_2.conditions.to_dict() == state.conditions.to_dict()
+
+    calculator.set_state_and_potential(state=state)
+    calculator_2.set_state_and_potential(state=state_2)
+    assert math.isclose(
+        calculator_2.potential.per_supercell(),
+        calculator.potential.per_supercell(),
+    )
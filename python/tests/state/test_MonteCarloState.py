@@ -1,10 +1,12 @@
 import copy
 
 import numpy as np
+import pytest
 
 import libcasm.configuration as casmconfig
 import libcasm.monte as monte
 from libcasm.clexmonte import (
+    CompactOccupation,
     MonteCarloState,
 )
 
@@ -116,3 +118,66 @@ def test_MonteCarloState_to_from_dict(
         mc_state.conditions.vector_values["param_chem_pot"],
         mc_state_2.conditions.vector_values["param_chem_pot"],
     )
+
+
+def test_MonteCarloState_occupation_view_1(
+    FCCBinaryVacancy_prim_config,
+):
+    mc_state = MonteCarloState(
+        configuration=FCCBinaryVacancy_prim_config,
+    )
+    occupation = mc_state.occupation()
+    assert occupation.shape == (1,)
+    assert occupation[0] == 0
+    assert not occupation.flags.writeable
+    with pytest.raises(ValueError):
+        occupation[0] = 1
+
+    # a writable view modifies the state, and is seen by read-only views
+    writable_occupation = mc_state.occupation(writable=True)
+    assert writable_occupation.flags.writeable
+    writable_occupation[0] = 1
+    assert occupation[0] == 1
+    assert mc_state.configuration.occupation[0] == 1
+
+    # the view keeps the state alive
+    del mc_state
+    assert occupation[0] == 1
+
+
+def test_MonteCarloState_compact_occupation_1(
+    FCCBinaryVacancy_xtal_prim,
+):
+    prim = casmconfig.Prim(FCCBinaryVacancy_xtal_prim)
+    supercell = casmconfig.Supercell(
+        prim=prim,
+        transformation_matrix_to_super=np.eye(3, dtype="int") * 4,
+    )
+    mc_state = MonteCarloState(
+        configuration=casmconfig.Configuration(supercell=supercell),
+    )
+    occupation = mc_state.occupation(writable=True)
+    occupation[:] = np.arange(occupation.shape[0]) % 3
+    expected = occupation.copy()
+
+    compact = mc_state.compact_occupation()
+    assert isinstance(compact, CompactOccupation)
+    assert compact.bits_per_value == 2
+    assert len(compact) == 64
+    assert compact.nbytes == 16
+    assert compact[5] == expected[5]
+    assert np.array_equal(compact.to_array(), expected)
+    assert compact.packed_bytes().dtype == np.uint8
+
+    # round trip through a dict
+    data = compact.to_dict()
+    assert data["bits_per_value"] == 2
+    compact_2 = CompactOccupation.from_dict(data)
+    assert np.array_equal(compact_2.to_array(), expected)
+
+    occupation[:] = 0
+    mc_state.set_compact_occupation(compact_2)
+    assert np.array_equal(mc_state.occupation(), expected)
+
+    with pytest.raises(Exception):
+        CompactOccupation(expected, bits_per_value=1)
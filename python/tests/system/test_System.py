@@ -1,3 +1,8 @@
+import pickle
+
+import numpy as np
+import pytest
+
 import libcasm.configuration as casmconfig
 import libcasm.xtal as xtal
 from libcasm.clexmonte import (
@@ -109,3 +114,89 @@ def test_kmc_System_1(FCCBinaryVacancy_kmc_System):
     assert isinstance(system.composition_converter, CompositionConverter)
     assert isinstance(system.composition_calculator, CompositionCalculator)
     assert isinstance(system.prim_neighbor_list, PrimNeighborList)
+
+
+def test_System_pickle_1(FCCBinaryVacancy_System):
+    system = pickle.loads(pickle.dumps(FCCBinaryVacancy_System))
+    assert isinstance(system, System)
+    assert system.basis_set_keys == FCCBinaryVacancy_System.basis_set_keys
+    assert system.clex_keys == FCCBinaryVacancy_System.clex_keys
+    assert (
+        system.composition_converter.components()
+        == FCCBinaryVacancy_System.composition_converter.components()
+    )
+
+
+def test_System_pickle_2(
+    FCCBinaryVacancy_xtal_prim,
+    FCCBinaryVacancy_CompositionConverter,
+):
+    # Only a System constructed from a dict can be pickled
+    system = System(
+        xtal_prim=FCCBinaryVacancy_xtal_prim,
+        composition_converter=FCCBinaryVacancy_CompositionConverter,
+    )
+    with pytest.raises(RuntimeError):
+        pickle.dumps(system)
+
+
+def test_System_bulk_evaluation_1(Clex_ZrO_Occ_System):
+    system = Clex_ZrO_Occ_System
+    state = system.make_default_state(
+        transformation_matrix_to_super=np.eye(3, dtype="int") * 2,
+    )
+
+    # sites with more than one allowed occupant
+    n_unitcells = 8
+    occ_dof = system.prim.xtal_prim.occ_dof()
+    sites = [
+        b * n_unitcells + i
+        for b in range(len(occ_dof))
+        if len(occ_dof[b]) > 1
+        for i in range(n_unitcells)
+    ]
+
+    # random configurations of those sites
+    rng = np.random.default_rng(0)
+    n_configurations = 20
+    default_occupation = np.array(state.configuration.occupation, dtype=np.int32)
+    occupation = np.tile(default_occupation, (n_configurations, 1))
+    for i in range(n_configurations):
+        occupation[i, sites] = rng.integers(0, 2, len(sites))
+
+    value = system.bulk_clex_per_unitcell(
+        state=state,
+        key="formation_energy",
+        occupation=occupation,
+        n_threads=3,
+    )
+    corr = system.bulk_corr_per_unitcell(
+        state=state,
+        key="formation_energy",
+        occupation=occupation,
+        n_threads=3,
+    )
+    assert value.shape == (n_configurations,)
+    assert corr.shape[0] == n_configurations
+    for i in range(n_configurations):
+        for site in sites:
+            state.configuration.set_occ(site, occupation[i, site])
+        clex = system.clex(state=state, key="formation_energy")
+        assert np.isclose(value[i], clex.per_unitcell())
+
+    # results do not depend on the number of threads
+    assert np.allclose(
+        corr,
+        system.bulk_corr_per_unitcell(
+            state=state,
+            key="formation_energy",
+            occupation=occupation,
+        ),
+    )
+
+    with pytest.raises(Exception):
+        system.bulk_clex_per_unitcell(
+            state=state,
+            key="formation_energy",
+            occupation=occupation[:, :-1],
+        )
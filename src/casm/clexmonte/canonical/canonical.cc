@@ -33,6 +33,34 @@ void CanonicalPotential::set(state_type const *state,
   m_conditions = conditions;
 }
 
+/// \brief Reset pointer to state currently being calculated, using the
+///     given formation energy cluster expansion
+///
+/// This allows sharing a formation energy cluster expansion that is already
+/// set to evaluate `state`, such as that of the KMC event calculators,
+/// without looking it up again.
+///
+/// \param state State to calculate
+/// \param conditions Conditions to calculate
+/// \param formation_energy_clex Formation energy cluster expansion, which
+///     must be set to evaluate `state`
+void CanonicalPotential::set(
+    state_type const *state, std::shared_ptr<Conditions> conditions,
+    std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex) {
+  m_state = state;
+  if (m_state == nullptr) {
+    throw std::runtime_error(
+        "Error setting CanonicalPotential state: state is empty");
+  }
+  if (formation_energy_clex == nullptr) {
+    throw std::runtime_error(
+        "Error setting CanonicalPotential state: formation energy cluster "
+        "expansion is empty");
+  }
+  m_formation_energy_clex = formation_energy_clex;
+  m_conditions = conditions;
+}
+
 /// \brief Pointer to current state
 state_type const *CanonicalPotential::state() const { return m_state; }
 
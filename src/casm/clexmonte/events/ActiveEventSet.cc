@@ -0,0 +1,97 @@
+#include "casm/clexmonte/events/ActiveEventSet.hh"
+
+#include <algorithm>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _prim_event_list The prim events
+/// \param _event_list The complete event list
+/// \param _occupation The current occupation
+ActiveEventSet::ActiveEventSet(
+    std::vector<PrimEventData> const &_prim_event_list,
+    EventDataList const &_event_list, Eigen::VectorXi const &_occupation)
+    : m_prim_event_list(&_prim_event_list),
+      m_event_list(&_event_list),
+      m_occupation(&_occupation),
+      m_is_active(_event_list.n_slots(), false),
+      m_size(0) {
+  // count events per site, then fill
+  Index n_sites = _occupation.size();
+  m_site_offsets.assign(n_sites + 1, 0);
+  for (auto const &event : *m_event_list) {
+    for (Index l : m_event_list->event_sites(event.first, m_sites)) {
+      ++m_site_offsets[l + 1];
+    }
+  }
+  for (Index l = 0; l < n_sites; ++l) {
+    m_site_offsets[l + 1] += m_site_offsets[l];
+  }
+  m_site_events.resize(m_site_offsets[n_sites]);
+  std::vector<Index> position(m_site_offsets.begin(),
+                              m_site_offsets.end() - 1);
+  for (auto const &event : *m_event_list) {
+    Index linear_index = m_event_list->linear_index(event.first);
+    for (Index l : m_event_list->event_sites(event.first, m_sites)) {
+      m_site_events[position[l]++] = linear_index;
+    }
+  }
+  reset();
+}
+
+/// \brief Set the occupation, and re-check all events
+void ActiveEventSet::reset(Eigen::VectorXi const &_occupation) {
+  m_occupation = &_occupation;
+  reset();
+}
+
+/// \brief Re-check all events
+void ActiveEventSet::reset() {
+  std::fill(m_is_active.begin(), m_is_active.end(), false);
+  m_size = 0;
+  for (auto const &event : *m_event_list) {
+    _set(m_event_list->linear_index(event.first), _check(event.first));
+  }
+}
+
+/// \brief Re-check events that share a site with `event_id`, after it
+///     occurred
+///
+/// Only the sites of `event_id` change occupation, so only events that
+/// include one of those sites may change from active to inactive or
+/// inactive to active.
+void ActiveEventSet::set_occurred(EventID const &event_id) {
+  EventSites sites = m_event_list->event_sites(event_id, m_sites);
+  m_occurred_sites.assign(sites.begin(), sites.end());
+  Index n_prim_events = m_event_list->n_prim_events();
+  for (Index l : m_occurred_sites) {
+    for (Index k = m_site_offsets[l]; k < m_site_offsets[l + 1]; ++k) {
+      Index linear_index = m_site_events[k];
+      _set(linear_index, _check(make_event_id(linear_index, n_prim_events)));
+    }
+  }
+}
+
+bool ActiveEventSet::_check(EventID const &event_id) {
+  std::vector<int> const &occ_init =
+      (*m_prim_event_list)[event_id.prim_event_index].occ_init;
+  EventSites sites = m_event_list->event_sites(event_id, m_sites);
+  for (Index i = 0; i < sites.size(); ++i) {
+    if ((*m_occupation)(sites[i]) != occ_init[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ActiveEventSet::_set(Index linear_index, bool value) {
+  if (m_is_active[linear_index] != value) {
+    m_is_active[linear_index] = value;
+    m_size += value ? 1 : -1;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,17 +1,152 @@
 #include "casm/clexmonte/events/CompleteEventList.hh"
 
+#include <algorithm>
+
+#include "casm/clexmonte/events/SharedImpactTable.hh"
 #include "casm/clexmonte/events/event_methods.hh"
+#include "casm/clexmonte/methods/thread_pool.hh"
 #include "casm/monte/Conversions.hh"
 #include "casm/monte/events/OccLocation.hh"
 
 namespace CASM {
 namespace clexmonte {
 
+EventDataBuilder::EventDataBuilder(
+    std::vector<PrimEventData> const &_prim_event_list,
+    monte::OccLocation const &_occ_location)
+    : m_prim_event_list(&_prim_event_list), m_occ_location(&_occ_location) {}
+
+/// \brief Reset the occupant location tracker used to construct events
+///
+/// This must be called if the monte::OccLocation used at construction is
+/// replaced, for instance when a new run uses the same supercell.
+void EventDataBuilder::set_occ_location(
+    monte::OccLocation const &_occ_location) {
+  m_occ_location = &_occ_location;
+}
+
+/// \brief Construct EventData for an event, valid until the next call
+EventData const &EventDataBuilder::operator()(EventID const &id) const {
+  auto const &unitcell_index_converter =
+      m_occ_location->convert().unitcell_index_converter();
+  m_event_data.unitcell_index = id.unitcell_index;
+  set_event(m_event_data.event, m_prim_event_list->at(id.prim_event_index),
+            unitcell_index_converter(id.unitcell_index), *m_occ_location);
+  return m_event_data;
+}
+
+/// \brief Construct EventData for an event, using already calculated linear
+///     site indices, valid until the next call
+EventData const &EventDataBuilder::operator()(
+    EventID const &id, Index const *linear_site_index) const {
+  auto const &unitcell_index_converter =
+      m_occ_location->convert().unitcell_index_converter();
+  m_event_data.unitcell_index = id.unitcell_index;
+  set_event(m_event_data.event, m_prim_event_list->at(id.prim_event_index),
+            unitcell_index_converter(id.unitcell_index), linear_site_index,
+            *m_occ_location);
+  return m_event_data;
+}
+
+/// \brief Set only the linear site indices of an event
+///
+/// This is cheaper than constructing the complete EventData, and is
+/// sufficient for calculating event rates.
+void EventDataBuilder::set_linear_site_index(
+    std::vector<Index> &linear_site_index, EventID const &id) const {
+  auto const &convert = m_occ_location->convert();
+  xtal::UnitCell translation =
+      convert.unitcell_index_converter()(id.unitcell_index);
+  auto const &sites = m_prim_event_list->at(id.prim_event_index).sites;
+  linear_site_index.resize(sites.size());
+  for (Index i = 0; i < sites.size(); ++i) {
+    linear_site_index[i] = convert.index_converter()(sites[i] + translation);
+  }
+}
+
+/// \brief Constructor
+///
+/// \param event_filters Filters, specifying which events are included in
+///     which unit cells. If a unit cell is listed by more than one filter,
+///     the first applies.
+/// \param _n_unitcells Number of unit cells in the supercell
+/// \param _n_prim_events Number of prim events
+EventFilterIndex::EventFilterIndex(
+    std::vector<EventFilterGroup> const &event_filters, Index _n_unitcells,
+    Index _n_prim_events)
+    : m_n_prim_events(_n_prim_events),
+      m_group(_n_unitcells, 0),
+      m_is_included((event_filters.size() + 1) * _n_prim_events, true),
+      m_is_excluded_everywhere(_n_prim_events, false) {
+  for (Index g = 0; g < event_filters.size(); ++g) {
+    EventFilterGroup const &filter = event_filters[g];
+    char *row = m_is_included.data() + (g + 1) * m_n_prim_events;
+    for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+         ++prim_event_index) {
+      bool is_listed = filter.prim_event_index.count(prim_event_index);
+      row[prim_event_index] = (filter.include_by_default != is_listed);
+    }
+    for (Index unitcell_index : filter.unitcell_index) {
+      if (unitcell_index >= 0 && unitcell_index < _n_unitcells &&
+          m_group[unitcell_index] == 0) {
+        m_group[unitcell_index] = g + 1;
+      }
+    }
+  }
+
+  // a prim event is excluded everywhere if every group that is used by
+  // some unit cell excludes it
+  std::vector<char> is_used(event_filters.size() + 1, false);
+  for (Index group : m_group) {
+    is_used[group] = true;
+  }
+  for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+       ++prim_event_index) {
+    bool excluded = true;
+    for (Index group = 0; group < is_used.size(); ++group) {
+      if (is_used[group] &&
+          m_is_included[group * m_n_prim_events + prim_event_index]) {
+        excluded = false;
+        break;
+      }
+    }
+    m_is_excluded_everywhere[prim_event_index] = excluded;
+  }
+}
+
+/// \brief Construct the complete list of events in a supercell
+///
+/// \param prim_event_list The prim events
+/// \param prim_impact_info_list Impact information for each prim event
+/// \param occ_location Occupant location tracker for the supercell
+/// \param event_filters Optional filters, specifying which events are
+///     included in which unit cells
+/// \param params Options controlling how the event list is stored. If
+///     `params.store_event_data` is false, or `params.store_site_arrays` is
+///     true, EventData is constructed on demand from `prim_event_list` and
+///     `occ_location`, which must then outlive the returned event list. Only the impact table selected by
+///     `params.impact_table_type` is constructed. If
+///     `params.skip_impossible_events` is true, prim events with an initial
+///     occupant species that is not present in the current state of
+///     `occ_location` are not included. If
+///     `params.shared_impact_table_dir` is set, a "csr" impact table is
+///     memory-mapped from a file shared with other processes. The event list
+///     and impact table are constructed using `params.n_threads` threads,
+///     with identical results for any number of threads.
+///
+/// Events excluded by `event_filters`, or skipped as impossible, are also
+/// removed from the impact table, so that they are not updated when a
+/// neighboring event occurs. The "map", "supercell", and non-shared "csr"
+/// impact tables are compacted to only contain included events. The
+/// "relative" impact table only omits prim events that are excluded in
+/// every unit cell, and a shared "csr" impact table is not compacted, so
+/// that it remains shared.
 CompleteEventList make_complete_event_list(
     std::vector<PrimEventData> const &prim_event_list,
     std::vector<EventImpactInfo> const &prim_impact_info_list,
     monte::OccLocation const &occ_location,
-    std::vector<EventFilterGroup> const &event_filters) {
+    std::vector<EventFilterGroup> const &event_filters,
+    CompleteEventListParams const &params) {
   CompleteEventList event_list;
 
   if (prim_event_list.size() != prim_impact_info_list.size()) {
@@ -23,50 +158,163 @@ CompleteEventList make_complete_event_list(
   auto const &unitcell_index_converter =
       occ_location.convert().unitcell_index_converter();
   Index n_unitcells = unitcell_index_converter.total_sites();
+  auto const &unitcellcoord_index_converter =
+      occ_location.convert().index_converter();
 
-  RelativeEventImpactTable relative_impact_table(prim_impact_info_list,
-                                                 unitcell_index_converter);
+  EventFilterIndex filter_index(event_filters, n_unitcells,
+                                prim_event_list.size());
+  std::vector<bool> is_possible(prim_event_list.size(), true);
+  if (params.skip_impossible_events) {
+    is_possible = find_possible_prim_events(prim_event_list, occ_location);
+  }
+  auto is_event_included = [&](EventID const &id) {
+    return is_possible[id.prim_event_index] &&
+           filter_index.is_included(id.unitcell_index, id.prim_event_index);
+  };
 
-  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
-       ++unitcell_index) {
-    EventFilterGroup const *filter = nullptr;
-    for (auto const &test_filter : event_filters) {
-      if (test_filter.unitcell_index.count(unitcell_index)) {
-        filter = &test_filter;
-        break;
-      }
+  // prim events excluded in every unit cell are not in any impact list
+  std::vector<std::vector<RelativeEventID>> relative_impact_list =
+      make_relative_impact_table(prim_impact_info_list);
+  for (auto &impacted : relative_impact_list) {
+    impacted.erase(
+        std::remove_if(impacted.begin(), impacted.end(),
+                       [&](RelativeEventID const &id) {
+                         return !is_possible[id.prim_event_index] ||
+                                filter_index.is_excluded_everywhere(
+                                    id.prim_event_index);
+                       }),
+        impacted.end());
+  }
+
+  event_list.impact_table_type = params.impact_table_type;
+  bool use_map_impact_table =
+      (params.impact_table_type == ImpactTableType::map);
+  RelativeEventImpactTable relative_impact_table(
+      std::move(relative_impact_list), unitcell_index_converter);
+  if (params.impact_table_type == ImpactTableType::relative) {
+    event_list.relative_impact_table =
+        std::make_shared<RelativeEventImpactTable>(relative_impact_table);
+  } else if (params.impact_table_type == ImpactTableType::supercell) {
+    event_list.supercell_impact_table =
+        std::make_shared<SupercellEventImpactTable>(
+            prim_impact_info_list, unitcell_index_converter, params.n_threads);
+  } else if (params.impact_table_type == ImpactTableType::csr) {
+    if (params.shared_impact_table_dir.has_value()) {
+      event_list.csr_impact_table = make_shared_csr_event_impact_table(
+          prim_impact_info_list, unitcell_index_converter,
+          occ_location.convert().transformation_matrix_to_super(),
+          *params.shared_impact_table_dir);
+    } else {
+      event_list.csr_impact_table = std::make_shared<CsrEventImpactTable>(
+          prim_impact_info_list, unitcell_index_converter, params.n_threads);
     }
+  }
 
-    for (Index prim_event_index = 0; prim_event_index < prim_event_list.size();
-         ++prim_event_index) {
-      if (filter) {
-        if (filter->include_by_default == true &&
-            filter->prim_event_index.count(prim_event_index)) {
-          continue;
-        }
-        if (filter->include_by_default == false &&
-            !filter->prim_event_index.count(prim_event_index)) {
+  // with site arrays, EventData is always constructed on demand, from the
+  // stored sites, rather than storing a second copy of the sites in each
+  // monte::OccEvent
+  bool store_event_data = params.store_event_data && !params.store_site_arrays;
+  if (store_event_data) {
+    event_list.events = EventDataList(n_unitcells, prim_event_list.size());
+  } else {
+    event_list.events = EventDataList(
+        n_unitcells, prim_event_list.size(),
+        std::make_shared<EventDataBuilder>(prim_event_list, occ_location));
+  }
+  if (params.store_site_arrays) {
+    std::vector<Index> n_sites_by_prim_event;
+    for (auto const &prim_event_data : prim_event_list) {
+      n_sites_by_prim_event.push_back(prim_event_data.sites.size());
+    }
+    event_list.events.init_site_arrays(n_sites_by_prim_event);
+  }
+
+  // Each thread fills the slots of a contiguous range of unit cells. Impact
+  // vectors for the "map" impact table are collected by linear index and
+  // inserted afterwards, in order.
+  std::vector<std::vector<EventID>> impact_vectors;
+  if (use_map_impact_table) {
+    impact_vectors.resize(event_list.events.n_slots());
+  }
+  EventDataList &events = event_list.events;
+  parallel_for_blocks(n_unitcells, params.n_threads, [&](Index begin,
+                                                         Index end, Index) {
+    // RelativeEventImpactTable::operator() uses scratch space
+    RelativeEventImpactTable thread_impact_table(relative_impact_table);
+    EventData event_data;
+    for (Index unitcell_index = begin; unitcell_index < end;
+         ++unitcell_index) {
+      for (Index prim_event_index = 0;
+           prim_event_index < prim_event_list.size(); ++prim_event_index) {
+        // set event_id
+        EventID event_id;
+        event_id.prim_event_index = prim_event_index;
+        event_id.unitcell_index = unitcell_index;
+        if (!is_event_included(event_id)) {
           continue;
         }
-      }
 
-      PrimEventData const &prim_event_data = prim_event_list[prim_event_index];
+        PrimEventData const &prim_event_data =
+            prim_event_list[prim_event_index];
+        Index i = events.linear_index(event_id);
 
-      // set event_id
-      EventID event_id;
-      event_id.prim_event_index = prim_event_index;
-      event_id.unitcell_index = unitcell_index;
+        xtal::UnitCell translation = unitcell_index_converter(unitcell_index);
+        if (use_map_impact_table) {
+          std::vector<EventID> &impacted = impact_vectors[i];
+          for (EventID const &impacted_id : thread_impact_table(event_id)) {
+            if (is_event_included(impacted_id)) {
+              impacted.push_back(impacted_id);
+            }
+          }
+        }
 
-      // set event_data
-      EventData event_data;
-      event_data.unitcell_index = unitcell_index;
-      xtal::UnitCell translation = unitcell_index_converter(unitcell_index);
-      set_event(event_data.event, prim_event_data, translation, occ_location);
+        if (store_event_data) {
+          // set event_data
+          event_data.unitcell_index = unitcell_index;
+          set_event(event_data.event, prim_event_data, translation,
+                    occ_location);
+          events.include_unchecked(i, &event_data);
+        } else {
+          events.include_unchecked(i, nullptr);
+          if (params.store_site_arrays) {
+            Index *sites = events.linear_site_index(i);
+            for (auto const &site : prim_event_data.sites) {
+              *sites++ = unitcellcoord_index_converter(site + translation);
+            }
+          }
+        }
+      }
+    }
+  });
+  events.recount();
+
+  // remove excluded events from the explicitly stored impact tables
+  if (events.size() != events.n_slots()) {
+    bool compact_csr_impact_table = event_list.csr_impact_table &&
+                                    !params.shared_impact_table_dir.has_value();
+    if (event_list.supercell_impact_table || compact_csr_impact_table) {
+      std::vector<bool> is_included(events.n_slots());
+      for (Index i = 0; i < events.n_slots(); ++i) {
+        is_included[i] = events.is_included(i);
+      }
+      if (event_list.supercell_impact_table) {
+        event_list.supercell_impact_table->compact(is_included,
+                                                   params.n_threads);
+      } else {
+        event_list.csr_impact_table = std::make_shared<CsrEventImpactTable>(
+            make_compacted_csr_event_impact_table(*event_list.csr_impact_table,
+                                                  is_included));
+      }
+    }
+  }
 
-      // add to lists
-      event_list.impact_table.emplace(event_id,
-                                      relative_impact_table(event_id));
-      event_list.events.emplace(event_id, event_data);
+  if (use_map_impact_table) {
+    for (Index i = 0; i < events.n_slots(); ++i) {
+      if (events.is_included(i)) {
+        event_list.impact_table.emplace_hint(event_list.impact_table.end(),
+                                             events.event_id(i),
+                                             std::move(impact_vectors[i]));
+      }
     }
   }
   return event_list;
@@ -90,5 +338,136 @@ std::vector<EventID> make_complete_event_id_list(
   return event_id_list;
 }
 
+/// \brief Construct a vector of the EventID included in an event list
+///
+/// Does not construct EventData, so it is also efficient if event data is
+/// constructed on demand.
+std::vector<EventID> make_included_event_id_list(
+    EventDataList const &event_list) {
+  std::vector<EventID> event_id_list;
+  event_id_list.reserve(event_list.size());
+  for (Index i = 0; i < event_list.n_slots(); ++i) {
+    if (event_list.is_included(i)) {
+      event_id_list.push_back(event_list.event_id(i));
+    }
+  }
+  return event_id_list;
+}
+
+/// \brief Find which prim events may be allowed, given the species present
+///
+/// A prim event is possible if every species in its initial occupation is
+/// present somewhere in the supercell. If the number of each species is
+/// conserved, as in KMC, events that are not possible can never be allowed
+/// in any translation.
+///
+/// \param prim_event_list The prim events
+/// \param occ_location Occupant location tracker for the current state
+///
+/// \returns For each prim event, true if it is possible
+std::vector<bool> find_possible_prim_events(
+    std::vector<PrimEventData> const &prim_event_list,
+    monte::OccLocation const &occ_location) {
+  monte::Conversions const &convert = occ_location.convert();
+
+  // count of each species, over all asymmetric units
+  std::vector<Index> species_count(convert.species_size(), 0);
+  for (auto const &cand : occ_location.candidate_list()) {
+    species_count[cand.species_index] += occ_location.cand_size(cand);
+  }
+
+  std::vector<bool> is_possible;
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    bool possible = true;
+    for (Index i = 0; i < prim_event_data.sites.size(); ++i) {
+      Index l = convert.index_converter()(prim_event_data.sites[i]);
+      Index species_index = convert.species_index(
+          convert.l_to_asym(l), prim_event_data.occ_init[i]);
+      if (species_count[species_index] == 0) {
+        possible = false;
+        break;
+      }
+    }
+    is_possible.push_back(possible);
+  }
+  return is_possible;
+}
+
+/// \brief Approximate memory used by a complete event list, in bytes
+///
+/// Includes the stored events, site arrays, and impact table. The estimate
+/// counts the sizes of the stored elements, and approximates container
+/// overhead, so it is intended for comparing against a memory budget rather
+/// than exact accounting.
+///
+/// \param event_list The complete event list
+///
+/// \returns Approximate memory used, in bytes
+std::size_t approximate_memory_usage(CompleteEventList const &event_list) {
+  return approximate_events_memory_usage(event_list) +
+         approximate_impact_table_memory_usage(event_list);
+}
+
+/// \brief Approximate memory used by the stored events and site arrays of a
+///     complete event list, in bytes
+///
+/// \param event_list The complete event list
+///
+/// \returns Approximate memory used, in bytes
+std::size_t approximate_events_memory_usage(
+    CompleteEventList const &event_list) {
+  EventDataList const &events = event_list.events;
+  std::size_t n_slots = events.n_slots();
+  std::size_t bytes = n_slots * sizeof(char);
+  if (events.has_site_arrays()) {
+    bytes += n_slots * events.site_stride() * sizeof(Index);
+  }
+  if (events.stores_event_data()) {
+    bytes += n_slots * sizeof(EventData);
+    for (auto const &event : events) {
+      monte::OccEvent const &e = event.second.event;
+      bytes += e.linear_site_index.size() * sizeof(Index) +
+               e.new_occ.size() * sizeof(int) +
+               e.occ_transform.size() * sizeof(monte::OccTransform) +
+               e.atom_traj.size() * sizeof(monte::AtomTraj);
+    }
+  }
+  return bytes;
+}
+
+/// \brief Approximate memory used by the impact table of a complete event
+///     list, in bytes
+///
+/// \param event_list The complete event list
+///
+/// \returns Approximate memory used, in bytes
+std::size_t approximate_impact_table_memory_usage(
+    CompleteEventList const &event_list) {
+  EventDataList const &events = event_list.events;
+  std::size_t n_slots = events.n_slots();
+  std::size_t bytes = 0;
+
+  // approximate size of a std::map node, excluding the value
+  std::size_t const map_node_overhead = 4 * sizeof(void *);
+  if (event_list.impact_table_type == ImpactTableType::map) {
+    for (auto const &pair : event_list.impact_table) {
+      bytes += map_node_overhead + sizeof(pair) +
+               pair.second.size() * sizeof(EventID);
+    }
+  } else if (event_list.impact_table_type == ImpactTableType::supercell &&
+             event_list.supercell_impact_table) {
+    auto const &table = *event_list.supercell_impact_table;
+    for (Index i = 0; i < n_slots; ++i) {
+      bytes += sizeof(std::vector<EventID>) +
+               table(events.event_id(i)).size() * sizeof(EventID);
+    }
+  } else if (event_list.impact_table_type == ImpactTableType::csr &&
+             event_list.csr_impact_table) {
+    bytes += (n_slots + 1) * sizeof(Index) +
+             event_list.csr_impact_table->n_impacted() * sizeof(PackedEventID);
+  }
+  return bytes;
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
@@ -0,0 +1,230 @@
+#include "casm/clexmonte/events/EventJournal.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+struct EventJournalHeader {
+  char magic[8];
+  std::uint64_t version;
+  std::int64_t n_unitcells;
+  std::int64_t n_prim_events;
+};
+
+char const event_journal_magic[8] = {'C', 'L', 'X', 'K', 'M', 'C', 'J', '1'};
+
+std::uint64_t const event_journal_version = 1;
+
+/// Maximum bytes in one record: a 10 byte varint and a double
+Index const max_record_bytes = 18;
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _path File to write, which is overwritten if it exists
+/// \param _n_unitcells Number of unit cells in the supercell
+/// \param _n_prim_events Number of prim events
+/// \param _buffer_bytes Records are written to the file when at least this
+///     many bytes are buffered
+EventJournalWriter::EventJournalWriter(fs::path const &_path,
+                                       Index _n_unitcells,
+                                       Index _n_prim_events,
+                                       Index _buffer_bytes)
+    : m_n_prim_events(_n_prim_events),
+      m_buffer_bytes(std::max(Index(1), _buffer_bytes)),
+      m_out(_path, std::ios::binary | std::ios::trunc),
+      m_n_events(0) {
+  if (!m_out) {
+    std::stringstream msg;
+    msg << "Error constructing EventJournalWriter: could not open "
+        << _path.string();
+    throw std::runtime_error(msg.str());
+  }
+  EventJournalHeader header;
+  std::memcpy(header.magic, event_journal_magic, 8);
+  header.version = event_journal_version;
+  header.n_unitcells = _n_unitcells;
+  header.n_prim_events = _n_prim_events;
+  m_out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  m_buffer.reserve(m_buffer_bytes + max_record_bytes);
+}
+
+/// \brief Destructor, writes buffered records
+EventJournalWriter::~EventJournalWriter() {
+  try {
+    flush();
+  } catch (...) {
+  }
+}
+
+/// \brief Record an event
+///
+/// \param event_id The selected event
+/// \param time_increment The time increment before the event occurs
+void EventJournalWriter::record(EventID const &event_id,
+                                double time_increment) {
+  std::uint64_t value =
+      event_id.unitcell_index * m_n_prim_events + event_id.prim_event_index;
+  while (value >= 0x80) {
+    m_buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  m_buffer.push_back(static_cast<char>(value));
+  char bytes[sizeof(double)];
+  std::memcpy(bytes, &time_increment, sizeof(double));
+  m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(double));
+  ++m_n_events;
+  if (Index(m_buffer.size()) >= m_buffer_bytes) {
+    flush();
+  }
+}
+
+/// \brief Write buffered records to the file
+void EventJournalWriter::flush() {
+  if (!m_buffer.empty()) {
+    m_out.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+  m_out.flush();
+  if (!m_out) {
+    throw std::runtime_error("Error in EventJournalWriter: write failed");
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _path File written by EventJournalWriter
+/// \param _buffer_bytes Number of bytes read from the file at a time
+EventJournalReader::EventJournalReader(fs::path const &_path,
+                                       Index _buffer_bytes)
+    : m_buffer_bytes(std::max(max_record_bytes, _buffer_bytes)),
+      m_in(_path, std::ios::binary),
+      m_begin(0),
+      m_end(0),
+      m_n_events(0) {
+  std::stringstream msg;
+  msg << "Error constructing EventJournalReader: ";
+  if (!m_in) {
+    msg << "could not open " << _path.string();
+    throw std::runtime_error(msg.str());
+  }
+  EventJournalHeader header;
+  m_in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (m_in.gcount() != sizeof(header) ||
+      std::memcmp(header.magic, event_journal_magic, 8) != 0) {
+    msg << _path.string() << " is not an event journal";
+    throw std::runtime_error(msg.str());
+  }
+  if (header.version != event_journal_version) {
+    msg << "unsupported version " << header.version;
+    throw std::runtime_error(msg.str());
+  }
+  m_n_unitcells = header.n_unitcells;
+  m_n_prim_events = header.n_prim_events;
+  if (m_n_prim_events <= 0) {
+    msg << "invalid number of prim events";
+    throw std::runtime_error(msg.str());
+  }
+  m_buffer.resize(m_buffer_bytes);
+}
+
+/// \brief Read the next event, returning false if there are no more
+///
+/// \param event_id Set to the event
+/// \param time_increment Set to the time increment before the event occurs
+///
+/// \returns True if an event was read, false if all events have been read
+bool EventJournalReader::read(EventID &event_id, double &time_increment) {
+  if (!_fill(1)) {
+    return false;
+  }
+  _fill(max_record_bytes);
+  std::uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (m_begin == m_end || shift > 63) {
+      throw std::runtime_error("Error in EventJournalReader: truncated file");
+    }
+    unsigned char byte = static_cast<unsigned char>(m_buffer[m_begin++]);
+    value |= std::uint64_t(byte & 0x7f) << shift;
+    shift += 7;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  if (m_end - m_begin < Index(sizeof(double))) {
+    throw std::runtime_error("Error in EventJournalReader: truncated file");
+  }
+  std::memcpy(&time_increment, m_buffer.data() + m_begin, sizeof(double));
+  m_begin += sizeof(double);
+  event_id.prim_event_index = value % m_n_prim_events;
+  event_id.unitcell_index = value / m_n_prim_events;
+  ++m_n_events;
+  return true;
+}
+
+/// \brief Make at least `n` bytes available in the buffer, if the file has
+///     them
+bool EventJournalReader::_fill(Index n) {
+  if (m_end - m_begin >= n) {
+    return true;
+  }
+  std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end,
+            m_buffer.begin());
+  m_end -= m_begin;
+  m_begin = 0;
+  if (m_in) {
+    m_in.read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    m_end += m_in.gcount();
+  }
+  return m_end - m_begin >= n;
+}
+
+/// \brief Constructor
+///
+/// \param _journal The journal
+/// \param _n_unitcells Number of unit cells, which must match the journal
+/// \param _n_prim_events Number of prim events, which must match the
+///     journal
+ReplayEventSelector::ReplayEventSelector(
+    std::shared_ptr<EventJournalReader> _journal, Index _n_unitcells,
+    Index _n_prim_events)
+    : m_journal(std::move(_journal)) {
+  if (!m_journal) {
+    throw std::runtime_error(
+        "Error constructing ReplayEventSelector: journal is empty");
+  }
+  if (m_journal->n_unitcells() != _n_unitcells ||
+      m_journal->n_prim_events() != _n_prim_events) {
+    std::stringstream msg;
+    msg << "Error constructing ReplayEventSelector: the journal has "
+        << m_journal->n_unitcells() << " unit cells and "
+        << m_journal->n_prim_events() << " prim events, but the calculation "
+        << "has " << _n_unitcells << " unit cells and " << _n_prim_events
+        << " prim events";
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/// \brief Return the next journaled event
+///
+/// \returns (event_id, time_increment)
+std::pair<EventID, double> ReplayEventSelector::select_event() {
+  if (!m_journal->read(m_result.first, m_result.second)) {
+    std::stringstream msg;
+    msg << "Error in ReplayEventSelector: all " << m_journal->n_events()
+        << " journaled events have been replayed, but the run is not "
+           "complete";
+    throw std::runtime_error(msg.str());
+  }
+  return m_result;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,5 +1,13 @@
 #include "casm/clexmonte/events/ImpactTable.hh"
 
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/crystallography/BasicStructure.hh"
+
 namespace CASM {
 namespace clexmonte {
 
@@ -14,32 +22,256 @@ RelativeEventImpactTable::RelativeEventImpactTable(
     : m_impact_table(make_relative_impact_table(prim_event_list)),
       m_unitcell_converter(unitcell_converter) {}
 
+/// \brief Constructor, from a relative impact table
+///
+/// \param _impact_table Relative impact table, as from
+///     `make_relative_impact_table` or `make_relative_impact_table_within`
+/// \param unitcell_converter Convert unit cell indices
+RelativeEventImpactTable::RelativeEventImpactTable(
+    std::vector<std::vector<RelativeEventID>> _impact_table,
+    xtal::UnitCellIndexConverter const &unitcell_converter)
+    : m_impact_table(std::move(_impact_table)),
+      m_unitcell_converter(unitcell_converter) {}
+
 /// \brief Constructor
 ///
 /// \param prim_event_list A vector of EventImpactInfo, providing the impact
 ///     information for all possible events in the origin unit cell.
 /// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads used to construct the table. Each
+///     thread fills the impact vectors of a contiguous range of unit cells,
+///     so the result does not depend on `n_threads`.
 SupercellEventImpactTable::SupercellEventImpactTable(
     std::vector<EventImpactInfo> const &prim_event_list,
-    xtal::UnitCellIndexConverter const &unitcell_converter)
+    xtal::UnitCellIndexConverter const &unitcell_converter, Index n_threads)
     : m_n_prim_events(prim_event_list.size()) {
   RelativeEventImpactTable relative_impact_table(prim_event_list,
                                                  unitcell_converter);
 
   Index n_unitcells = unitcell_converter.total_sites();
+  m_impact_table.resize(n_unitcells * m_n_prim_events);
+
+  // index order matters, it must be consistent
+  //   with the linear_index definition in operator()
+  parallel_for_blocks(
+      n_unitcells, n_threads, [&](Index begin, Index end, Index) {
+        // RelativeEventImpactTable::operator() uses scratch space
+        RelativeEventImpactTable thread_impact_table(relative_impact_table);
+        EventID event_id;
+        for (Index unitcell_index = begin; unitcell_index < end;
+             ++unitcell_index) {
+          for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+               ++prim_event_index) {
+            event_id.prim_event_index = prim_event_index;
+            event_id.unitcell_index = unitcell_index;
+            m_impact_table[linear_index(event_id, m_n_prim_events)] =
+                thread_impact_table(event_id);
+          }
+        }
+      });
+}
+
+/// \brief Remove events which are not included, and free unused memory
+///
+/// After compacting, the impact vector of an event which is not included is
+/// empty, and the impact vectors of included events only contain included
+/// events, in the same order as before.
+///
+/// \param is_included Whether the event with a given linear index is
+///     included, with size `n_unitcells * n_prim_events`
+/// \param n_threads Number of threads used to compact the table
+void SupercellEventImpactTable::compact(std::vector<bool> const &is_included,
+                                        Index n_threads) {
+  if (is_included.size() != m_impact_table.size()) {
+    throw std::runtime_error(
+        "Error in SupercellEventImpactTable::compact: is_included size "
+        "mismatch");
+  }
+  Index n_unitcells = m_n_prim_events ? m_impact_table.size() / m_n_prim_events
+                                      : 0;
+  parallel_for_blocks(
+      n_unitcells, n_threads, [&](Index begin, Index end, Index) {
+        for (Index i = begin * m_n_prim_events; i < end * m_n_prim_events;
+             ++i) {
+          std::vector<EventID> &impacted = m_impact_table[i];
+          if (!is_included[i]) {
+            std::vector<EventID>().swap(impacted);
+            continue;
+          }
+          impacted.erase(
+              std::remove_if(impacted.begin(), impacted.end(),
+                             [&](EventID const &id) {
+                               return !is_included[linear_index(
+                                   id, m_n_prim_events)];
+                             }),
+              impacted.end());
+          impacted.shrink_to_fit();
+        }
+      });
+}
+
+/// \brief Constructor
+///
+/// \param prim_event_list A vector of EventImpactInfo, providing the impact
+///     information for all possible events in the origin unit cell.
+/// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads used to construct the table. The
+///     offsets are calculated directly, and each thread fills the impacted
+///     events of a contiguous range of unit cells, so the result does not
+///     depend on `n_threads`.
+CsrEventImpactTable::CsrEventImpactTable(
+    std::vector<EventImpactInfo> const &prim_event_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter, Index n_threads)
+    : m_n_prim_events(prim_event_list.size()) {
+  Index n_unitcells = unitcell_converter.total_sites();
+  if (m_n_prim_events > PackedEventID::max_n_prim_events ||
+      n_unitcells > PackedEventID::max_n_unitcells) {
+    std::stringstream msg;
+    msg << "Error constructing CsrEventImpactTable: too many events to "
+           "pack (n_prim_events="
+        << m_n_prim_events << ", n_unitcells=" << n_unitcells << ").";
+    throw std::runtime_error(msg.str());
+  }
+
+  RelativeEventImpactTable relative_impact_table(prim_event_list,
+                                                 unitcell_converter);
   EventID event_id;
 
-  // loop order matters, it must be consistent
+  // the number of impacted events only depends on prim_event_index, so
+  // the offsets of unit cell `l` are those of unit cell 0 plus
+  // `l * n_impacted_per_unitcell`
+  std::vector<Index> prim_offsets(m_n_prim_events + 1, 0);
+  for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+       ++prim_event_index) {
+    event_id.prim_event_index = prim_event_index;
+    event_id.unitcell_index = 0;
+    prim_offsets[prim_event_index + 1] =
+        prim_offsets[prim_event_index] +
+        relative_impact_table(event_id).size();
+  }
+  Index n_impacted_per_unitcell = prim_offsets[m_n_prim_events];
+
+  struct Arrays {
+    std::vector<Index> offsets;
+    std::vector<PackedEventID> impacted;
+  };
+  auto arrays = std::make_shared<Arrays>();
+  std::vector<Index> &offsets = arrays->offsets;
+  std::vector<PackedEventID> &impacted_list = arrays->impacted;
+  offsets.resize(n_unitcells * m_n_prim_events + 1);
+  impacted_list.resize(n_unitcells * n_impacted_per_unitcell);
+
+  // index order matters, it must be consistent
   //   with the linear_index definition in operator()
-  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
-       ++unitcell_index) {
-    for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
-         ++prim_event_index) {
-      event_id.prim_event_index = prim_event_index;
-      event_id.unitcell_index = unitcell_index;
-      m_impact_table.push_back(relative_impact_table(event_id));
+  parallel_for_blocks(
+      n_unitcells, n_threads, [&](Index begin, Index end, Index) {
+        // RelativeEventImpactTable::operator() uses scratch space
+        RelativeEventImpactTable thread_impact_table(relative_impact_table);
+        EventID id;
+        for (Index unitcell_index = begin; unitcell_index < end;
+             ++unitcell_index) {
+          Index unitcell_offset = unitcell_index * n_impacted_per_unitcell;
+          for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+               ++prim_event_index) {
+            id.prim_event_index = prim_event_index;
+            id.unitcell_index = unitcell_index;
+            Index offset = unitcell_offset + prim_offsets[prim_event_index];
+            offsets[linear_index(id, m_n_prim_events)] = offset;
+            std::vector<EventID> const &impacted = thread_impact_table(id);
+            if (offset + Index(impacted.size()) !=
+                unitcell_offset + prim_offsets[prim_event_index + 1]) {
+              throw std::runtime_error(
+                  "Error constructing CsrEventImpactTable: number of "
+                  "impacted events depends on unit cell");
+            }
+            for (EventID const &impacted_id : impacted) {
+              impacted_list[offset++] = pack(impacted_id);
+            }
+          }
+        }
+      });
+  offsets.back() = impacted_list.size();
+
+  m_n_offsets = offsets.size();
+  m_offsets = offsets.data();
+  m_n_impacted = impacted_list.size();
+  m_impacted = impacted_list.data();
+  m_storage = arrays;
+}
+
+/// \brief Constructor, using arrays kept valid by `_storage`
+///
+/// \param _n_prim_events Number of prim events
+/// \param _n_offsets Size of `_offsets`, `n_unitcells * n_prim_events + 1`
+/// \param _offsets Offsets array
+/// \param _n_impacted Size of `_impacted`
+/// \param _impacted Impacted events array
+/// \param _storage Owner of the arrays, such as a memory-mapped file
+CsrEventImpactTable::CsrEventImpactTable(Index _n_prim_events,
+                                         Index _n_offsets,
+                                         Index const *_offsets,
+                                         Index _n_impacted,
+                                         PackedEventID const *_impacted,
+                                         std::shared_ptr<void const> _storage)
+    : m_n_prim_events(_n_prim_events),
+      m_n_offsets(_n_offsets),
+      m_offsets(_offsets),
+      m_n_impacted(_n_impacted),
+      m_impacted(_impacted),
+      m_storage(_storage) {
+  if (m_n_offsets < 1 || m_offsets[0] != 0 ||
+      m_offsets[m_n_offsets - 1] != m_n_impacted) {
+    throw std::runtime_error(
+        "Error constructing CsrEventImpactTable: invalid offsets");
+  }
+}
+
+/// \brief Return a CsrEventImpactTable without the events which are not
+///     included
+///
+/// The impact range of an event which is not included is empty, and the
+/// impact ranges of included events only contain included events, in the
+/// same order as in `impact_table`. The returned table owns its arrays, so
+/// compacting a memory-mapped shared table makes a private copy.
+///
+/// \param impact_table The impact table to compact
+/// \param is_included Whether the event with a given linear index is
+///     included, with size `impact_table.n_offsets() - 1`
+CsrEventImpactTable make_compacted_csr_event_impact_table(
+    CsrEventImpactTable const &impact_table,
+    std::vector<bool> const &is_included) {
+  Index n_events = impact_table.n_offsets() - 1;
+  if (Index(is_included.size()) != n_events) {
+    throw std::runtime_error(
+        "Error in make_compacted_csr_event_impact_table: is_included size "
+        "mismatch");
+  }
+  Index n_prim_events = impact_table.n_prim_events();
+  Index const *offsets = impact_table.offsets();
+  PackedEventID const *impacted = impact_table.impacted();
+
+  struct Arrays {
+    std::vector<Index> offsets;
+    std::vector<PackedEventID> impacted;
+  };
+  auto arrays = std::make_shared<Arrays>();
+  arrays->offsets.reserve(n_events + 1);
+  arrays->offsets.push_back(0);
+  for (Index i = 0; i < n_events; ++i) {
+    if (is_included[i]) {
+      for (Index j = offsets[i]; j < offsets[i + 1]; ++j) {
+        if (is_included[linear_index(impacted[j], n_prim_events)]) {
+          arrays->impacted.push_back(impacted[j]);
+        }
+      }
     }
+    arrays->offsets.push_back(arrays->impacted.size());
   }
+  arrays->impacted.shrink_to_fit();
+
+  return CsrEventImpactTable(n_prim_events, arrays->offsets.size(),
+                             arrays->offsets.data(), arrays->impacted.size(),
+                             arrays->impacted.data(), arrays);
 }
 
 namespace {
@@ -103,5 +335,121 @@ std::vector<std::vector<RelativeEventID>> make_relative_impact_table(
   return impact_table;
 }
 
+/// \brief Return the part of the relative impact table for which the
+///     impacted event is within a distance of the occurring event
+///
+/// \param prim_event_list A vector of EventImpactInfo, providing the impact
+///     information for all possible events in the origin unit cell.
+/// \param prim The prim structure, used to calculate site coordinates
+/// \param radius Maximum distance, in Angstrom, from a phenomenal site of
+///     the occurring event to a phenomenal site of the impacted event.
+///     Impacted events that share a site with the occurring event are
+///     always included.
+///
+/// \returns relative_impact_table, the entries of
+///     `make_relative_impact_table(prim_event_list)` which satisfy the
+///     distance criteria, in the same order
+///
+std::vector<std::vector<RelativeEventID>> make_relative_impact_table_within(
+    std::vector<EventImpactInfo> const &prim_event_list,
+    xtal::BasicStructure const &prim, double radius) {
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  double tol = prim.lattice().tol();
+  auto cart = [&](xtal::UnitCellCoord const &site,
+                  xtal::UnitCell const &translation) -> Eigen::Vector3d {
+    return prim.basis()[site.sublattice()].const_cart() +
+           L * (site.unitcell() + translation).cast<double>();
+  };
+
+  std::vector<std::vector<RelativeEventID>> impact_table =
+      make_relative_impact_table(prim_event_list);
+  xtal::UnitCell zero_translation(0, 0, 0);
+  for (Index j = 0; j < impact_table.size(); ++j) {
+    auto const &occurring_sites = prim_event_list[j].phenomenal_sites;
+    std::vector<RelativeEventID> within;
+    for (RelativeEventID const &impacted : impact_table[j]) {
+      auto const &impacted_sites =
+          prim_event_list[impacted.prim_event_index].phenomenal_sites;
+      bool is_within = false;
+      for (xtal::UnitCellCoord const &a : occurring_sites) {
+        for (xtal::UnitCellCoord const &b : impacted_sites) {
+          if ((cart(b, impacted.translation) - cart(a, zero_translation))
+                  .norm() <= radius + tol) {
+            is_within = true;
+            break;
+          }
+        }
+        if (is_within) {
+          break;
+        }
+      }
+      if (is_within) {
+        within.push_back(impacted);
+      }
+    }
+    impact_table[j] = std::move(within);
+  }
+  return impact_table;
+}
+
+/// \brief Return an impact table for events in the origin unit cell, which
+///     also specifies which parts of the impacted events' states are changed
+///
+/// \param prim_event_list A vector of EventImpactInfo, providing the impact
+///     information for all possible events in the origin unit cell.
+///
+/// \returns relative_update_table, where relative_update_table[i] is the
+///     vector of events (specified relative to the origin unit cell) which are
+///     impacted by the occurance of event `prim_event_list[i]` in the origin
+///     unit cell, in the same order as `make_relative_impact_table`, along
+///     with EventUpdateFlags. The `update_dE_final` flag is set if the
+///     occuring event changes sites in the impacted event's
+///     `clex_update_neighborhood`, and the `update_local_clex` flag is set if
+///     it changes sites in the impacted event's
+///     `local_clex_update_neighborhood`. If an impacted event has neither
+///     split neighborhood set, `update_all` is used.
+///
+std::vector<std::vector<RelativeEventUpdate>> make_relative_update_table(
+    std::vector<EventImpactInfo> const &prim_event_list) {
+  std::vector<std::vector<RelativeEventUpdate>> update_table;
+  update_table.resize(prim_event_list.size());
+  RelativeEventUpdate update;
+
+  for (Index i = 0; i < prim_event_list.size(); ++i) {
+    EventImpactInfo const &impacted = prim_event_list[i];
+    bool is_split = !impacted.local_clex_update_neighborhood.empty() ||
+                    !impacted.clex_update_neighborhood.empty();
+    for (Index j = 0; j < prim_event_list.size(); ++j) {
+      std::vector<xtal::UnitCellCoord> const &phenomenal_sites =
+          prim_event_list[j].phenomenal_sites;
+      std::set<xtal::UnitCell> translations = make_impact_translations(
+          impacted.required_update_neighborhood, phenomenal_sites);
+      std::set<xtal::UnitCell> local_clex_translations =
+          make_impact_translations(impacted.local_clex_update_neighborhood,
+                                   phenomenal_sites);
+      std::set<xtal::UnitCell> clex_translations = make_impact_translations(
+          impacted.clex_update_neighborhood, phenomenal_sites);
+
+      for (xtal::UnitCell const &trans : translations) {
+        update.event.prim_event_index = i;
+        update.event.translation = -trans;
+        if (!is_split) {
+          update.flags = update_all;
+        } else {
+          update.flags = update_none;
+          if (clex_translations.count(trans)) {
+            update.flags |= update_dE_final;
+          }
+          if (local_clex_translations.count(trans)) {
+            update.flags |= update_local_clex;
+          }
+        }
+        update_table[j].push_back(update);
+      }
+    }
+  }
+  return update_table;
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
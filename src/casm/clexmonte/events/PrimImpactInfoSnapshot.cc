@@ -0,0 +1,248 @@
+#include "casm/clexmonte/events/PrimImpactInfoSnapshot.hh"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/clexmonte/events/event_methods.hh"
+#include "casm/clexmonte/misc/ContentHash.hh"
+#include "casm/clexmonte/system/System.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+char const snapshot_magic[8] = {'C', 'L', 'X', 'P', 'I', 'M', 'P', '1'};
+
+void _update(ContentHash &hash, xtal::UnitCellCoord const &site) {
+  hash.update_value(site.sublattice());
+  for (int i = 0; i < 3; ++i) {
+    hash.update_value(site.unitcell()(i));
+  }
+}
+
+void _update(ContentHash &hash, std::string const &name,
+             BasisSetClusterInfo const *cluster_info,
+             clexulator::SparseCoefficients const &coefficients) {
+  if (cluster_info == nullptr) {
+    std::stringstream msg;
+    msg << "Error in make_prim_impact_info_snapshot_key: '" << name
+        << "' does not have cluster_info";
+    throw std::runtime_error(msg.str());
+  }
+  hash.update(name);
+  hash.update_value(coefficients.index.size());
+  for (Index function_index : coefficients.index) {
+    hash.update_value(function_index);
+    Index orbit_index = cluster_info->function_to_orbit_index[function_index];
+    auto const &orbit = cluster_info->orbits[orbit_index];
+    hash.update_value(orbit.size());
+    for (auto const &cluster : orbit) {
+      hash.update_value(cluster.elements().size());
+      for (auto const &site : cluster.elements()) {
+        _update(hash, site);
+      }
+    }
+  }
+}
+
+void _write_value(std::ostream &out, std::int64_t value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+bool _read_value(std::istream &in, std::int64_t &value) {
+  return bool(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+}  // namespace
+
+/// \brief Make the key identifying a prim impact info snapshot
+///
+/// \param system The system
+/// \param local_impact The event impact info for each prim event, with
+///     phenomenal sites set. Other members are ignored.
+/// \param clex_names Cluster expansions included in the impact neighborhoods
+/// \param multiclex_names Multi-cluster expansions included in the impact
+///     neighborhoods
+///
+/// The key is a hash of everything that determines the cluster expansion
+/// update neighborhoods: the phenomenal sites of each prim event, and the
+/// coefficient indices and corresponding cluster orbits of each cluster
+/// expansion.
+std::string make_prim_impact_info_snapshot_key(
+    System const &system, std::vector<EventImpactInfo> const &local_impact,
+    std::vector<std::string> const &clex_names,
+    std::vector<std::string> const &multiclex_names) {
+  ContentHash hash;
+  hash.update_value(prim_impact_info_snapshot_version);
+  hash.update_value(local_impact.size());
+  for (auto const &impact : local_impact) {
+    hash.update_value(impact.phenomenal_sites.size());
+    for (auto const &site : impact.phenomenal_sites) {
+      _update(hash, site);
+    }
+  }
+  hash.update_value(clex_names.size());
+  for (auto const &name : clex_names) {
+    ClexData const &clex_data = get_clex_data(system, name);
+    _update(hash, name, clex_data.cluster_info.get(), clex_data.coefficients);
+  }
+  hash.update_value(multiclex_names.size());
+  for (auto const &name : multiclex_names) {
+    MultiClexData const &multiclex_data = get_multiclex_data(system, name);
+    hash.update_value(multiclex_data.coefficients.size());
+    for (auto const &coeffs : multiclex_data.coefficients) {
+      _update(hash, name, multiclex_data.cluster_info.get(), coeffs);
+    }
+  }
+  return hash.hex();
+}
+
+/// \brief Write a prim impact info snapshot
+///
+/// Binary format, in native byte order:
+/// - "CLXPIMP1", 8 bytes
+/// - version, int64
+/// - key size, int64, and key
+/// - number of prim events, int64
+/// - for each prim event, the number of sites in the clex update
+///   neighborhood, int64, followed by (b, i, j, k) for each site, int64
+///
+/// The file is written to a temporary file and renamed, so readers never see
+/// a partially written snapshot.
+void write_prim_impact_info_snapshot(
+    fs::path const &snapshot_path, std::string const &key,
+    std::vector<EventImpactInfo> const &prim_impact_info_list) {
+  if (!snapshot_path.parent_path().empty()) {
+    fs::create_directories(snapshot_path.parent_path());
+  }
+  fs::path tmp_path = snapshot_path;
+  tmp_path += ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(snapshot_magic, sizeof(snapshot_magic));
+    _write_value(out, prim_impact_info_snapshot_version);
+    _write_value(out, key.size());
+    out.write(key.data(), key.size());
+    _write_value(out, prim_impact_info_list.size());
+    for (auto const &impact : prim_impact_info_list) {
+      _write_value(out, impact.clex_update_neighborhood.size());
+      for (auto const &site : impact.clex_update_neighborhood) {
+        _write_value(out, site.sublattice());
+        for (int i = 0; i < 3; ++i) {
+          _write_value(out, site.unitcell()(i));
+        }
+      }
+    }
+    if (!out) {
+      std::stringstream msg;
+      msg << "Error in write_prim_impact_info_snapshot: failed writing "
+          << tmp_path;
+      throw std::runtime_error(msg.str());
+    }
+  }
+  fs::rename(tmp_path, snapshot_path);
+}
+
+/// \brief Read the clex update neighborhoods from a prim impact info
+///     snapshot, if it exists and is current
+///
+/// \returns The clex update neighborhood of each prim event, or
+///     std::nullopt if the snapshot does not exist, is not readable, has a
+///     different version, or has a different key.
+std::optional<std::vector<std::set<xtal::UnitCellCoord>>>
+read_prim_impact_info_snapshot(fs::path const &snapshot_path,
+                               std::string const &key) {
+  std::ifstream in(snapshot_path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  char magic[sizeof(snapshot_magic)];
+  std::int64_t version;
+  std::int64_t key_size;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0 ||
+      !_read_value(in, version) ||
+      version != std::int64_t(prim_impact_info_snapshot_version) ||
+      !_read_value(in, key_size) || key_size != std::int64_t(key.size())) {
+    return std::nullopt;
+  }
+  std::string snapshot_key(key_size, '\0');
+  if (!in.read(&snapshot_key[0], key_size) || snapshot_key != key) {
+    return std::nullopt;
+  }
+
+  std::int64_t n_events;
+  if (!_read_value(in, n_events) || n_events < 0) {
+    return std::nullopt;
+  }
+  std::vector<std::set<xtal::UnitCellCoord>> neighborhoods(n_events);
+  for (auto &neighborhood : neighborhoods) {
+    std::int64_t n_sites;
+    if (!_read_value(in, n_sites) || n_sites < 0) {
+      return std::nullopt;
+    }
+    for (std::int64_t s = 0; s < n_sites; ++s) {
+      std::int64_t v[4];
+      for (auto &x : v) {
+        if (!_read_value(in, x)) {
+          return std::nullopt;
+        }
+      }
+      neighborhood.emplace_hint(neighborhood.end(), v[0], v[1], v[2], v[3]);
+    }
+  }
+  return neighborhoods;
+}
+
+/// \brief Construct the list of event impact neighborhoods, reading and
+///     writing a snapshot of the cluster expansion neighborhoods
+///
+/// If `system.prim_impact_info_snapshot_path` is not set, this is
+/// equivalent to `make_prim_impact_info_list`.
+///
+/// Otherwise, the phenomenal sites and local cluster expansion neighborhoods
+/// are constructed, and the cluster expansion neighborhoods, which are
+/// the expensive part for large prim event lists and cluster expansions, are
+/// read from the snapshot if it is current. If the snapshot does not exist,
+/// or is stale, they are constructed and the snapshot is written.
+std::vector<EventImpactInfo> load_or_make_prim_impact_info_list(
+    System const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names,
+    std::vector<std::string> const &multiclex_names) {
+  if (!system.prim_impact_info_snapshot_path.has_value()) {
+    return make_prim_impact_info_list(system, prim_event_list, clex_names,
+                                      multiclex_names);
+  }
+  fs::path const &snapshot_path = *system.prim_impact_info_snapshot_path;
+
+  std::vector<EventImpactInfo> prim_impact_info_list =
+      make_prim_impact_info_list(system, prim_event_list, {}, {});
+  std::string key = make_prim_impact_info_snapshot_key(
+      system, prim_impact_info_list, clex_names, multiclex_names);
+  auto neighborhoods = read_prim_impact_info_snapshot(snapshot_path, key);
+  if (!neighborhoods.has_value() ||
+      neighborhoods->size() != prim_impact_info_list.size()) {
+    prim_impact_info_list = make_prim_impact_info_list(
+        system, prim_event_list, clex_names, multiclex_names);
+    write_prim_impact_info_snapshot(snapshot_path, key,
+                                    prim_impact_info_list);
+    return prim_impact_info_list;
+  }
+
+  for (Index i = 0; i < prim_impact_info_list.size(); ++i) {
+    EventImpactInfo &impact = prim_impact_info_list[i];
+    impact.clex_update_neighborhood = std::move((*neighborhoods)[i]);
+    impact.required_update_neighborhood.insert(
+        impact.clex_update_neighborhood.begin(),
+        impact.clex_update_neighborhood.end());
+  }
+  return prim_impact_info_list;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,231 @@
+#include "casm/clexmonte/events/SharedImpactTable.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/clexmonte/misc/ContentHash.hh"
+#include "casm/clexmonte/system/ClexulatorCache.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// File header, followed by the offsets and impacted arrays. The header
+/// size is a multiple of 8 bytes, so the arrays are aligned.
+struct SharedImpactTableHeader {
+  char magic[8];
+  std::uint64_t version;
+  char key[32];
+  std::int64_t n_prim_events;
+  std::int64_t n_offsets;
+  std::int64_t n_impacted;
+};
+
+char const shared_impact_table_magic[8] = {'C', 'L', 'X', 'C',
+                                           'S', 'R', 'I', '1'};
+
+void _update(ContentHash &hash, xtal::UnitCellCoord const &site) {
+  hash.update_value(site.sublattice());
+  for (int i = 0; i < 3; ++i) {
+    hash.update_value(site.unitcell()(i));
+  }
+}
+
+/// \brief Read-only memory mapping of a file, unmapped on destruction
+class MappedFile {
+ public:
+  MappedFile(void *_data, std::size_t _size) : m_data(_data), m_size(_size) {}
+  ~MappedFile() { ::munmap(m_data, m_size); }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  char const *data() const { return static_cast<char const *>(m_data); }
+  std::size_t size() const { return m_size; }
+
+ private:
+  void *m_data;
+  std::size_t m_size;
+};
+
+}  // namespace
+
+/// \brief Make the key identifying a shared CsrEventImpactTable file
+///
+/// The key is a hash of the file format version, the phenomenal sites and
+/// required update neighborhood of each prim event, which determine the
+/// relative impact table, and the supercell.
+std::string make_shared_impact_table_key(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  ContentHash hash;
+  hash.update_value(shared_impact_table_version);
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      hash.update_value(transformation_matrix_to_super(i, j));
+    }
+  }
+  hash.update_value(prim_impact_info_list.size());
+  for (auto const &impact : prim_impact_info_list) {
+    hash.update_value(impact.phenomenal_sites.size());
+    for (auto const &site : impact.phenomenal_sites) {
+      _update(hash, site);
+    }
+    hash.update_value(impact.required_update_neighborhood.size());
+    for (auto const &site : impact.required_update_neighborhood) {
+      _update(hash, site);
+    }
+  }
+  return hash.hex();
+}
+
+/// \brief Write a CsrEventImpactTable to a file that can be memory-mapped
+///
+/// Binary format, in native byte order: a header (see
+/// `map_csr_event_impact_table`), the offsets array, and the impacted events
+/// array. The file is written to a temporary file and renamed, so readers
+/// never see a partially written file.
+void write_csr_event_impact_table(fs::path const &path, std::string const &key,
+                                  CsrEventImpactTable const &table) {
+  SharedImpactTableHeader header;
+  if (key.size() != sizeof(header.key)) {
+    throw std::runtime_error(
+        "Error in write_csr_event_impact_table: invalid key size");
+  }
+  std::memcpy(header.magic, shared_impact_table_magic, sizeof(header.magic));
+  header.version = shared_impact_table_version;
+  std::memcpy(header.key, key.data(), sizeof(header.key));
+  header.n_prim_events = table.n_prim_events();
+  header.n_offsets = table.n_offsets();
+  header.n_impacted = table.n_impacted();
+
+  if (!path.parent_path().empty()) {
+    fs::create_directories(path.parent_path());
+  }
+  fs::path tmp_path = path;
+  tmp_path += ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    out.write(reinterpret_cast<char const *>(table.offsets()),
+              table.n_offsets() * sizeof(Index));
+    out.write(reinterpret_cast<char const *>(table.impacted()),
+              table.n_impacted() * sizeof(PackedEventID));
+    if (!out) {
+      std::stringstream msg;
+      msg << "Error in write_csr_event_impact_table: failed writing "
+          << tmp_path;
+      throw std::runtime_error(msg.str());
+    }
+  }
+  fs::rename(tmp_path, path);
+}
+
+/// \brief Memory-map a CsrEventImpactTable file, read-only
+///
+/// The file is mapped with MAP_SHARED, so all processes on a node that map
+/// the same file share one copy of it in the page cache.
+///
+/// \returns The table, or nullptr if the file does not exist, or has a
+///     different version or key, or an inconsistent size.
+std::shared_ptr<CsrEventImpactTable> map_csr_event_impact_table(
+    fs::path const &path, std::string const &key) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      st.st_size < std::int64_t(sizeof(SharedImpactTableHeader))) {
+    ::close(fd);
+    return nullptr;
+  }
+  std::size_t size = st.st_size;
+  void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  auto file = std::make_shared<MappedFile>(data, size);
+
+  SharedImpactTableHeader header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, shared_impact_table_magic,
+                  sizeof(header.magic)) != 0 ||
+      header.version != shared_impact_table_version ||
+      key.size() != sizeof(header.key) ||
+      std::memcmp(header.key, key.data(), sizeof(header.key)) != 0 ||
+      header.n_offsets < 1 || header.n_impacted < 0) {
+    return nullptr;
+  }
+  std::size_t expected_size = sizeof(header) +
+                              header.n_offsets * sizeof(Index) +
+                              header.n_impacted * sizeof(PackedEventID);
+  if (size != expected_size) {
+    return nullptr;
+  }
+
+  char const *begin = file->data() + sizeof(header);
+  Index const *offsets = reinterpret_cast<Index const *>(begin);
+  PackedEventID const *impacted = reinterpret_cast<PackedEventID const *>(
+      begin + header.n_offsets * sizeof(Index));
+  return std::make_shared<CsrEventImpactTable>(
+      header.n_prim_events, header.n_offsets, offsets, header.n_impacted,
+      impacted, file);
+}
+
+/// \brief Construct a CsrEventImpactTable backed by a memory-mapped file
+///     shared by all processes using the same directory
+///
+/// \param prim_impact_info_list Impact information for each prim event
+/// \param unitcell_converter Convert unit cell indices
+/// \param transformation_matrix_to_super The supercell
+/// \param shared_dir Directory containing shared impact table files, named
+///     "csr_impact_table.<key>.bin"
+///
+/// The first process to lock the file constructs the table and writes the
+/// file; it and all other processes then map the file read-only, so the
+/// table is stored once per node rather than once per process.
+std::shared_ptr<CsrEventImpactTable> make_shared_csr_event_impact_table(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter,
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    fs::path const &shared_dir) {
+  std::string key = make_shared_impact_table_key(
+      prim_impact_info_list, transformation_matrix_to_super);
+  fs::path path = shared_dir / ("csr_impact_table." + key + ".bin");
+
+  auto table = map_csr_event_impact_table(path, key);
+  if (table) {
+    return table;
+  }
+
+  fs::create_directories(shared_dir);
+  FileLock lock(shared_dir / ("csr_impact_table." + key + ".lock"));
+  table = map_csr_event_impact_table(path, key);
+  if (table) {
+    return table;
+  }
+  write_csr_event_impact_table(
+      path, key,
+      CsrEventImpactTable(prim_impact_info_list, unitcell_converter));
+  table = map_csr_event_impact_table(path, key);
+  if (!table) {
+    std::stringstream msg;
+    msg << "Error in make_shared_csr_event_impact_table: failed to map "
+        << path;
+    throw std::runtime_error(msg.str());
+  }
+  return table;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,157 @@
+#include "casm/clexmonte/events/SublatticeDecomposition.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return, along each lattice vector, the maximum separation in unit
+///     cells of the origin unit cells of two events such that the occurrence
+///     of one may impact the other
+///
+/// An event with origin unit cell `u_A` impacts an event with origin unit
+/// cell `u_B` if one of its phenomenal sites, `u_A + p`, is a site in the
+/// impact neighborhood, or one of the phenomenal sites, of the other event,
+/// `u_B + n`. So the reach along lattice vector `k` is the maximum of
+/// `|n(k) - p(k)|` over the sites of all prim events.
+///
+/// \param prim_impact_info_list Impact information of each prim event
+Eigen::Vector3l event_impact_reach(
+    std::vector<EventImpactInfo> const &prim_impact_info_list) {
+  Eigen::Vector3l reach = Eigen::Vector3l::Zero();
+  if (prim_impact_info_list.empty()) {
+    return reach;
+  }
+  Eigen::Vector3l p_min, p_max, n_min, n_max;
+  bool is_first_p = true;
+  bool is_first_n = true;
+  auto expand = [](Eigen::Vector3l &min, Eigen::Vector3l &max,
+                   bool &is_first, xtal::UnitCell const &unitcell) {
+    for (Index k = 0; k < 3; ++k) {
+      if (is_first || unitcell(k) < min(k)) {
+        min(k) = unitcell(k);
+      }
+      if (is_first || unitcell(k) > max(k)) {
+        max(k) = unitcell(k);
+      }
+    }
+    is_first = false;
+  };
+  for (EventImpactInfo const &info : prim_impact_info_list) {
+    for (xtal::UnitCellCoord const &site : info.phenomenal_sites) {
+      expand(p_min, p_max, is_first_p, site.unitcell());
+      expand(n_min, n_max, is_first_n, site.unitcell());
+    }
+    for (xtal::UnitCellCoord const &site : info.required_update_neighborhood) {
+      expand(n_min, n_max, is_first_n, site.unitcell());
+    }
+  }
+  if (is_first_p) {
+    return reach;
+  }
+  for (Index k = 0; k < 3; ++k) {
+    reach(k) =
+        std::max(std::abs(n_max(k) - p_min(k)), std::abs(n_min(k) - p_max(k)));
+  }
+  return reach;
+}
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Supercell transformation matrix.
+///     Must be diagonal.
+/// \param reach Impact reach along each lattice vector, from
+///     `event_impact_reach`
+/// \param n_prim_events Number of prim events
+/// \param event_id_list Events which may be selected
+/// \param domain_shape Number of domains along each lattice vector. Values
+///     <= 0 are replaced by the maximum number of domains for which each
+///     sector is wider than `reach`, or 1 if that is less than 2.
+SublatticeDecomposition::SublatticeDecomposition(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    Eigen::Vector3l const &reach, Index n_prim_events,
+    std::vector<EventID> const &event_id_list, Eigen::Vector3l domain_shape)
+    : m_domain_shape(domain_shape) {
+  Eigen::Matrix3l const &T = transformation_matrix_to_super;
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      if (i != j && T(i, j) != 0) {
+        throw std::runtime_error(
+            "Error constructing SublatticeDecomposition: the supercell "
+            "transformation matrix must be diagonal");
+      }
+    }
+  }
+
+  // domain and sector of each unit cell coordinate, along each lattice vector
+  Index n_sectors_along[3];
+  std::vector<Index> domain_of[3];
+  std::vector<Index> sector_of[3];
+  for (Index k = 0; k < 3; ++k) {
+    Index n = T(k, k);
+    Index min_width = reach(k) + 1;
+    if (m_domain_shape(k) <= 0) {
+      m_domain_shape(k) = n / (2 * min_width);
+      if (m_domain_shape(k) < 2) {
+        m_domain_shape(k) = 1;
+      }
+    }
+    Index n_domains = m_domain_shape(k);
+    n_sectors_along[k] = (n_domains > 1) ? 2 : 1;
+    domain_of[k].resize(n);
+    sector_of[k].resize(n);
+    for (Index d = 0; d < n_domains; ++d) {
+      Index begin = (n * d) / n_domains;
+      Index end = (n * (d + 1)) / n_domains;
+      Index mid = begin + (end - begin) / 2;
+      if (n_domains > 1 &&
+          (mid - begin < min_width || end - mid < min_width)) {
+        std::stringstream msg;
+        msg << "Error constructing SublatticeDecomposition: " << n_domains
+            << " domains along lattice vector " << k << " of a supercell "
+            << n << " unit cells long give sectors narrower than "
+            << min_width << " unit cells (the impact reach + 1).";
+        throw std::runtime_error(msg.str());
+      }
+      for (Index x = begin; x < end; ++x) {
+        domain_of[k][x] = d;
+        sector_of[k][x] = (n_domains > 1 && x >= mid) ? 1 : 0;
+      }
+    }
+  }
+  m_n_domains = m_domain_shape.prod();
+  m_n_sectors = n_sectors_along[0] * n_sectors_along[1] * n_sectors_along[2];
+
+  // assign events to tasks
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  Index n_unitcells = unitcell_converter.total_sites();
+  m_task_events.resize(m_n_sectors * m_n_domains);
+  m_task_index.assign(n_unitcells * n_prim_events, -1);
+  m_local_index.assign(n_unitcells * n_prim_events, -1);
+  for (EventID const &event_id : event_id_list) {
+    xtal::UnitCell unitcell = unitcell_converter(event_id.unitcell_index);
+    Index d[3];
+    Index s[3];
+    for (Index k = 0; k < 3; ++k) {
+      Index x = ((unitcell(k) % T(k, k)) + T(k, k)) % T(k, k);
+      d[k] = domain_of[k][x];
+      s[k] = sector_of[k][x];
+    }
+    Index domain_index =
+        d[0] + m_domain_shape(0) * (d[1] + m_domain_shape(1) * d[2]);
+    Index sector_index =
+        s[0] + n_sectors_along[0] * (s[1] + n_sectors_along[1] * s[2]);
+    Index task_index = sector_index * m_n_domains + domain_index;
+    Index i = linear_index(event_id, n_prim_events);
+    m_task_index[i] = task_index;
+    m_local_index[i] = m_task_events[task_index].size();
+    m_task_events[task_index].push_back(event_id);
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -57,17 +57,14 @@ std::vector<PrimEventData> make_prim_event_list(
   return prim_event_list;
 }
 
+namespace {
+
 /// \brief Sets a monte::OccEvent consistent with the PrimEventData and
-/// OccLocation
-///
-/// Notes:
-/// - This doesn't need the current occupation state, just unchanging indices
-///   into OccLocation, so monte::OccEvent can be set once per supercell and
-///   does not need to be updated after an event occurs.
-monte::OccEvent &set_event(monte::OccEvent &event,
-                           PrimEventData const &prim_event_data,
-                           xtal::UnitCell const &translation,
-                           monte::OccLocation const &occ_location) {
+/// OccLocation, given `event.linear_site_index` is already set
+monte::OccEvent &_set_event_from_sites(
+    monte::OccEvent &event, PrimEventData const &prim_event_data,
+    xtal::UnitCell const &translation,
+    monte::OccLocation const &occ_location) {
   for (auto const &traj : prim_event_data.event) {
     for (auto const &pos : traj.position) {
       // if (pos.is_in_resevoir) {
@@ -85,18 +82,10 @@ monte::OccEvent &set_event(monte::OccEvent &event,
   Index n_sites = prim_event_data.sites.size();
   Index n_atoms = prim_event_data.event.size();
   monte::Conversions const &convert = occ_location.convert();
-  auto const &unitcellcoord_index_converter = convert.index_converter();
 
   // set e.new_occ --- specify new site occupation
   event.new_occ = prim_event_data.occ_final;
 
-  // set e.linear_site_index --- specify sites being transformed
-  event.linear_site_index.resize(n_sites);
-  for (Index i = 0; i < n_sites; ++i) {
-    event.linear_site_index[i] =
-        unitcellcoord_index_converter(prim_event_data.sites[i] + translation);
-  }
-
   // set e.occ_transform --- specify change in occupation variable
   event.occ_transform.resize(n_sites);
   for (Index i = 0; i < n_sites; ++i) {
@@ -142,5 +131,54 @@ monte::OccEvent &set_event(monte::OccEvent &event,
   return event;
 }
 
+}  // namespace
+
+/// \brief Sets a monte::OccEvent consistent with the PrimEventData and
+/// OccLocation
+///
+/// Notes:
+/// - This doesn't need the current occupation state, just unchanging indices
+///   into OccLocation, so monte::OccEvent can be set once per supercell and
+///   does not need to be updated after an event occurs.
+monte::OccEvent &set_event(monte::OccEvent &event,
+                           PrimEventData const &prim_event_data,
+                           xtal::UnitCell const &translation,
+                           monte::OccLocation const &occ_location) {
+  Index n_sites = prim_event_data.sites.size();
+  auto const &unitcellcoord_index_converter =
+      occ_location.convert().index_converter();
+
+  // set e.linear_site_index --- specify sites being transformed
+  event.linear_site_index.resize(n_sites);
+  for (Index i = 0; i < n_sites; ++i) {
+    event.linear_site_index[i] =
+        unitcellcoord_index_converter(prim_event_data.sites[i] + translation);
+  }
+  return _set_event_from_sites(event, prim_event_data, translation,
+                               occ_location);
+}
+
+/// \brief Sets a monte::OccEvent consistent with the PrimEventData and
+/// OccLocation, using already calculated linear site indices
+///
+/// \param linear_site_index Pointer to the first of
+///     `prim_event_data.sites.size()` linear site indices of the event, for
+///     instance from `EventDataList::linear_site_index`.
+///
+/// Notes:
+/// - Same as the other `set_event` overload, but avoids re-calculating the
+///   linear site indices of the event sites
+monte::OccEvent &set_event(monte::OccEvent &event,
+                           PrimEventData const &prim_event_data,
+                           xtal::UnitCell const &translation,
+                           Index const *linear_site_index,
+                           monte::OccLocation const &occ_location) {
+  Index n_sites = prim_event_data.sites.size();
+  event.linear_site_index.assign(linear_site_index,
+                                 linear_site_index + n_sites);
+  return _set_event_from_sites(event, prim_event_data, translation,
+                               occ_location);
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
@@ -0,0 +1,136 @@
+#include "casm/clexmonte/events/io/json/CompleteEventListParams_json_io.hh"
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/events/CompleteEventList.hh"
+
+namespace CASM {
+
+namespace {
+
+std::map<std::string, clexmonte::ImpactTableType> const &
+impact_table_type_names() {
+  static std::map<std::string, clexmonte::ImpactTableType> const names = {
+      {"map", clexmonte::ImpactTableType::map},
+      {"relative", clexmonte::ImpactTableType::relative},
+      {"supercell", clexmonte::ImpactTableType::supercell},
+      {"csr", clexmonte::ImpactTableType::csr}};
+  return names;
+}
+
+}  // namespace
+
+jsonParser &to_json(clexmonte::CompleteEventListParams const &params,
+                    jsonParser &json) {
+  json.put_obj();
+  json["store_site_arrays"] = params.store_site_arrays;
+  json["store_event_data"] = params.store_event_data;
+  json["skip_impossible_events"] = params.skip_impossible_events;
+  if (params.shared_impact_table_dir.has_value()) {
+    json["shared_impact_table_dir"] = params.shared_impact_table_dir->string();
+  }
+  for (auto const &pair : impact_table_type_names()) {
+    if (pair.second == params.impact_table_type) {
+      json["impact_table"] = pair.first;
+    }
+  }
+  json["n_threads"] = params.n_threads;
+  return json;
+}
+
+/// \brief Parse clexmonte::CompleteEventListParams
+///
+/// Expected format:
+/// \code
+///   "store_site_arrays": bool (optional, default=false)
+///       If true, store the sites of all events in a contiguous
+///       structure-of-arrays layout, which is used for event rate
+///       calculations. Event data is then constructed on demand from the
+///       stored sites, and "store_event_data" is ignored.
+///   "store_event_data": bool (optional, default=true)
+///       If true, store the translated event data for every event. If false,
+///       only which events are included is stored and event data is
+///       constructed on demand, which reduces memory use for large
+///       supercells at the cost of re-constructing events as they are used.
+///   "impact_table": string (optional, default="map")
+///       How the impact table, listing which events must have their rates
+///       updated after an event occurs, is stored. One of:
+///       - "map": A std::map of impact vectors for each event, as required by
+///         the lotto rejection-free event selector.
+///       - "relative": Impact vectors are generated on request from the
+///         impact vectors of events in the origin unit cell. Lowest memory
+///         use, but slower.
+///       - "supercell": The impact vectors of all events in the supercell are
+///         stored explicitly.
+///       - "csr": As "supercell", but all impact vectors are stored in a
+///         single compressed array.
+///       For options other than "map", the default event selector is the
+///       sum tree event selector, which uses the impact table directly.
+///   "skip_impossible_events": bool (optional, default=false)
+///       If true, do not include events with an initial occupant species that
+///       is not present anywhere in the supercell. Such events can never be
+///       allowed if the number of each species is conserved, as in KMC.
+///   "shared_impact_table_dir": string (optional)
+///       If given, with "impact_table" = "csr", the impact table is written
+///       once to a file in this directory and memory-mapped read-only, so
+///       that processes on one node running the same system and supercell,
+///       such as one process per core, share one copy of the impact table.
+///       Files are named by a hash of the prim event impact neighborhoods
+///       and the supercell.
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to construct the event list and impact
+///       table. Each thread handles a contiguous range of unit cells, and
+///       the result is identical for any number of threads.
+/// \endcode
+void parse(InputParser<clexmonte::CompleteEventListParams> &parser) {
+  auto ptr = std::make_unique<clexmonte::CompleteEventListParams>();
+  clexmonte::CompleteEventListParams &params = *ptr;
+  parser.optional(params.store_site_arrays, "store_site_arrays");
+  parser.optional(params.store_event_data, "store_event_data");
+  parser.optional(params.skip_impossible_events, "skip_impossible_events");
+
+  std::string impact_table = "map";
+  parser.optional(impact_table, "impact_table");
+  auto it = impact_table_type_names().find(impact_table);
+  if (it == impact_table_type_names().end()) {
+    std::stringstream msg;
+    msg << "Error: invalid \"impact_table\" value: \"" << impact_table
+        << "\". Options are: \"map\", \"relative\", \"supercell\", "
+        << "\"csr\".";
+    parser.insert_error("impact_table", msg.str());
+  } else {
+    params.impact_table_type = it->second;
+  }
+
+  std::optional<std::string> shared_impact_table_dir;
+  parser.optional(shared_impact_table_dir, "shared_impact_table_dir");
+  if (shared_impact_table_dir.has_value()) {
+    if (params.impact_table_type != clexmonte::ImpactTableType::csr) {
+      parser.insert_error("shared_impact_table_dir",
+                          "Error: \"shared_impact_table_dir\" requires "
+                          "\"impact_table\": \"csr\"");
+    } else {
+      params.shared_impact_table_dir = fs::path(*shared_impact_table_dir);
+    }
+  }
+
+  parser.optional(params.n_threads, "n_threads");
+  if (params.n_threads < 1) {
+    parser.insert_error("n_threads", "Error: \"n_threads\" must be >= 1");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::move(ptr);
+  }
+}
+
+void from_json(clexmonte::CompleteEventListParams &params,
+               jsonParser const &json) {
+  InputParser<clexmonte::CompleteEventListParams> parser{json};
+  std::stringstream ss;
+  ss << "Error: Invalid clexmonte::CompleteEventListParams object";
+  report_and_throw_if_invalid(parser, err_log(), std::runtime_error{ss.str()});
+  params = std::move(*parser.value);
+}
+
+}  // namespace CASM
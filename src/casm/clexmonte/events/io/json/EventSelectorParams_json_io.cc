@@ -0,0 +1,243 @@
+#include "casm/clexmonte/events/io/json/EventSelectorParams_json_io.hh"
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/events/EventSelectorParams.hh"
+
+namespace CASM {
+
+namespace {
+
+std::map<std::string, clexmonte::EventSelectorType> const &
+event_selector_type_names() {
+  static std::map<std::string, clexmonte::EventSelectorType> const names = {
+      {"lotto_rejection_free",
+       clexmonte::EventSelectorType::lotto_rejection_free},
+      {"sum_tree", clexmonte::EventSelectorType::sum_tree},
+      {"grouped_sum_tree", clexmonte::EventSelectorType::grouped_sum_tree},
+      {"composition_rejection",
+       clexmonte::EventSelectorType::composition_rejection},
+      {"rejection", clexmonte::EventSelectorType::rejection},
+      {"defect", clexmonte::EventSelectorType::defect},
+      {"synchronous_sublattice",
+       clexmonte::EventSelectorType::synchronous_sublattice}};
+  return names;
+}
+
+}  // namespace
+
+jsonParser &to_json(clexmonte::EventSelectorParams const &params,
+                    jsonParser &json) {
+  json.put_obj();
+  for (auto const &pair : event_selector_type_names()) {
+    if (pair.second == params.type) {
+      json["type"] = pair.first;
+    }
+  }
+  if (params.type == clexmonte::EventSelectorType::rejection) {
+    json["max_rate"] = params.max_rate;
+    json["max_rate_factor"] = params.max_rate_factor;
+    if (!params.max_rate_by_event_type.empty()) {
+      json["max_rate_by_event_type"] = params.max_rate_by_event_type;
+    }
+  }
+  if (params.type == clexmonte::EventSelectorType::defect) {
+    json["defect_species"] = params.defect_species;
+  }
+  if (params.type == clexmonte::EventSelectorType::synchronous_sublattice) {
+    json["time_horizon"] = params.time_horizon;
+    json["domain_shape"] = params.domain_shape;
+  }
+  if (params.type == clexmonte::EventSelectorType::sum_tree &&
+      params.deferred_update_interval > 1) {
+    json["deferred_update_interval"] = params.deferred_update_interval;
+    json["deferred_update_radius"] = params.deferred_update_radius;
+  }
+  if (params.type == clexmonte::EventSelectorType::sum_tree &&
+      params.superbasin_n_recurrence > 0) {
+    json["superbasin_n_recurrence"] = params.superbasin_n_recurrence;
+    json["superbasin_scale_factor"] = params.superbasin_scale_factor;
+    json["superbasin_min_scale"] = params.superbasin_min_scale;
+  }
+  return json;
+}
+
+/// \brief Parse clexmonte::EventSelectorParams
+///
+/// Expected format:
+/// \code
+///   "type": string (required)
+///       The event selector method. One of:
+///       - "lotto_rejection_free": The lotto rejection-free event selector,
+///         which requires the "map" impact table.
+///       - "sum_tree": A rejection-free selector using a flat binary sum
+///         tree. Selection and rate updates are O(log(n_events)).
+///       - "grouped_sum_tree": A rejection-free selector which first chooses
+///         a prim event, then chooses a translation from a sum tree with
+///         one leaf per unit cell. Trees are smaller and more cache-friendly
+///         than "sum_tree" for large supercells.
+///       - "composition_rejection": A rejection-free selector which bins
+///         events by rate, in powers of 2. Rate updates are O(1) and
+///         selection is O(number of bins), which is efficient when rates
+///         span many orders of magnitude.
+///       - "rejection": Rejection KMC. Events are proposed in proportion
+///         to the upper bound on the rates of their prim event, and
+///         accepted with probability rate / max_rate. Only the rates of
+///         proposed events are calculated, no rates are stored, and the
+///         impact table is not constructed. The rejection fraction is
+///         written to the event log after each KMC run.
+///       - "defect": A rejection-free selector which only tracks events
+///         that include a site occupied by a defect species, and does not
+///         construct the complete event list. Memory use and the cost per
+///         event depend on the number of defects, not the supercell size.
+///         Every prim event must have a defect species in its initial
+///         occupation. Only available for KMC.
+///       - "synchronous_sublattice": Parallel KMC using the synchronous
+///         sublattice algorithm. The supercell is divided into domains
+///         wider than twice the event impact reach, each split into
+///         sectors, and events in the same sector of all domains are
+///         selected concurrently up to a time horizon. Requires a diagonal
+///         supercell transformation matrix and stored event data. Only
+///         available for KMC.
+///   "max_rate": number (optional, default=0.0)
+///       For "rejection", the upper bound on event rates of event types not
+///       in "max_rate_by_event_type". If <= 0.0, the upper bound for each
+///       prim event is "max_rate_factor" times the maximum initial rate of
+///       its events.
+///   "max_rate_factor": number (optional, default=10.0)
+///       For "rejection", used if "max_rate" <= 0.0.
+///   "max_rate_by_event_type": object (optional, default={})
+///       For "rejection" in KMC, the upper bound on event rates by event
+///       type name, as `{"<event_type_name>": max_rate, ...}`. Values must
+///       be > 0.0. Tighter upper bounds give a lower rejection fraction.
+///   "defect_species": array of string (optional, default=["Va"])
+///       For "defect", the names of the defect species.
+///   "deferred_update_interval": int (optional, default=1)
+///       For "sum_tree" in KMC, if > 1, enables approximate deferred rate
+///       updates: events impacted by an occurring event, but without a site
+///       within "deferred_update_radius" of its sites, are only updated
+///       every "deferred_update_interval" events. Rate error diagnostics
+///       are written to the event log after each run.
+///   "deferred_update_radius": number (optional, default=0.0)
+///       For "deferred_update_interval" > 1, the distance (Angstrom) within
+///       which impacted events are updated after every event.
+///   "time_horizon": number (optional, default=0.0)
+///       For "synchronous_sublattice", the time each sector is evolved in
+///       each phase. Smaller values are more accurate, and larger values
+///       give more events per phase. If <= 0.0, it is chosen so that about
+///       one event occurs per domain per phase.
+///   "domain_shape": array of 3 int (optional, default=[0, 0, 0])
+///       For "synchronous_sublattice", the number of domains along each
+///       supercell lattice vector. Values <= 0 are replaced by the maximum
+///       number allowed by the event impact reach.
+///   "superbasin_n_recurrence": int (optional, default=0)
+///       For "sum_tree" in KMC, if > 0, enables superbasin acceleration: a
+///       pair of events is recurrent each time one is selected directly
+///       after the other, as for a vacancy hopping back and forth, and
+///       after every "superbasin_n_recurrence" recurrences the rates of both
+///       are multiplied by "superbasin_scale_factor" (their barriers are
+///       raised by kT*ln(1/superbasin_scale_factor)). Time increments use
+///       the scaled rates. All scaling is removed when an event outside
+///       the tracked pairs occurs. Diagnostics are written to the event
+///       log after each run.
+///   "superbasin_scale_factor": number (optional, default=0.5)
+///       For "superbasin_n_recurrence" > 0, the rate scale factor, in
+///       (0.0, 1.0).
+///   "superbasin_min_scale": number (optional, default=1e-6)
+///       For "superbasin_n_recurrence" > 0, the lower bound on the
+///       accumulated scale of any event rate, in (0.0, 1.0].
+/// \endcode
+void parse(InputParser<clexmonte::EventSelectorParams> &parser) {
+  auto ptr = std::make_unique<clexmonte::EventSelectorParams>();
+  clexmonte::EventSelectorParams &params = *ptr;
+
+  std::string type;
+  parser.require(type, "type");
+  if (parser.valid()) {
+    auto it = event_selector_type_names().find(type);
+    if (it == event_selector_type_names().end()) {
+      std::stringstream msg;
+      msg << "Error: invalid \"type\" value: \"" << type
+          << "\". Options are: \"lotto_rejection_free\", \"sum_tree\", "
+          << "\"grouped_sum_tree\", \"composition_rejection\", "
+          << "\"rejection\", \"defect\", \"synchronous_sublattice\".";
+      parser.insert_error("type", msg.str());
+    } else {
+      params.type = it->second;
+    }
+  }
+  parser.optional(params.max_rate, "max_rate");
+  parser.optional(params.max_rate_factor, "max_rate_factor");
+  parser.optional(params.max_rate_by_event_type, "max_rate_by_event_type");
+  for (auto const &pair : params.max_rate_by_event_type) {
+    if (!(pair.second > 0.0)) {
+      parser.insert_error("max_rate_by_event_type",
+                          "Error: \"max_rate_by_event_type\" values must be "
+                          "> 0.0");
+    }
+  }
+  if (!params.max_rate_by_event_type.empty() &&
+      params.type != clexmonte::EventSelectorType::rejection) {
+    parser.insert_error("max_rate_by_event_type",
+                        "Error: \"max_rate_by_event_type\" requires "
+                        "\"type\": \"rejection\"");
+  }
+  parser.optional(params.defect_species, "defect_species");
+  parser.optional(params.deferred_update_interval, "deferred_update_interval");
+  parser.optional(params.deferred_update_radius, "deferred_update_radius");
+  if (params.deferred_update_interval > 1 &&
+      params.type != clexmonte::EventSelectorType::sum_tree) {
+    parser.insert_error("deferred_update_interval",
+                        "Error: \"deferred_update_interval\" > 1 requires "
+                        "\"type\": \"sum_tree\"");
+  }
+  parser.optional(params.time_horizon, "time_horizon");
+  parser.optional(params.domain_shape, "domain_shape");
+  if (params.domain_shape.size() != 3) {
+    parser.insert_error("domain_shape",
+                        "Error: \"domain_shape\" must have 3 values");
+  }
+  parser.optional(params.superbasin_n_recurrence, "superbasin_n_recurrence");
+  parser.optional(params.superbasin_scale_factor, "superbasin_scale_factor");
+  parser.optional(params.superbasin_min_scale, "superbasin_min_scale");
+  if (params.superbasin_n_recurrence > 0 &&
+      params.type != clexmonte::EventSelectorType::sum_tree) {
+    parser.insert_error("superbasin_n_recurrence",
+                        "Error: \"superbasin_n_recurrence\" > 0 requires "
+                        "\"type\": \"sum_tree\"");
+  }
+  if (!(params.superbasin_scale_factor > 0.0 &&
+        params.superbasin_scale_factor < 1.0)) {
+    parser.insert_error("superbasin_scale_factor",
+                        "Error: \"superbasin_scale_factor\" must be in "
+                        "(0.0, 1.0)");
+  }
+  if (!(params.superbasin_min_scale > 0.0 &&
+        params.superbasin_min_scale <= 1.0)) {
+    parser.insert_error("superbasin_min_scale",
+                        "Error: \"superbasin_min_scale\" must be in "
+                        "(0.0, 1.0]");
+  }
+  if (params.deferred_update_radius < 0.0) {
+    parser.insert_error("deferred_update_radius",
+                        "Error: \"deferred_update_radius\" must be >= 0.0");
+  }
+  if (!(params.max_rate_factor > 0.0)) {
+    parser.insert_error("max_rate_factor",
+                        "Error: \"max_rate_factor\" must be > 0.0");
+  }
+  if (parser.valid()) {
+    parser.value = std::move(ptr);
+  }
+}
+
+void from_json(clexmonte::EventSelectorParams &params,
+               jsonParser const &json) {
+  InputParser<clexmonte::EventSelectorParams> parser{json};
+  std::stringstream ss;
+  ss << "Error: Invalid clexmonte::EventSelectorParams object";
+  report_and_throw_if_invalid(parser, err_log(), std::runtime_error{ss.str()});
+  params = std::move(*parser.value);
+}
+
+}  // namespace CASM
@@ -0,0 +1,105 @@
+#include "casm/clexmonte/kinetic/AutoTuner.hh"
+
+#include <stdexcept>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor
+///
+/// \param _candidate_values The options given for each candidate
+/// \param _n_steps Number of steps timed for each candidate
+/// \param _output_file If not empty, the calibration results of all tuned
+///     supercells are written to this JSON file after each is tuned
+AutoTuner::AutoTuner(std::vector<jsonParser> _candidate_values,
+                     Index _n_steps, std::string _output_file)
+    : candidate_values(std::move(_candidate_values)),
+      n_steps(_n_steps),
+      output_file(std::move(_output_file)),
+      m_results(jsonParser::array()) {
+  if (candidate_values.empty()) {
+    throw std::runtime_error(
+        "Error constructing AutoTuner: no candidates");
+  }
+}
+
+/// \brief Index of the fastest candidate for a supercell, calibrating if
+///     the supercell has not been tuned yet
+///
+/// \param transformation_matrix_to_super The supercell
+/// \param steps_per_second_f Calibrates a candidate. Only called the first
+///     time a supercell is seen.
+Index AutoTuner::choose(Eigen::Matrix3l const &transformation_matrix_to_super,
+                        steps_per_second_f_type const &steps_per_second_f) {
+  for (auto const &pair : m_choices) {
+    if (pair.first == transformation_matrix_to_super) {
+      return pair.second;
+    }
+  }
+  Index choice = _calibrate(transformation_matrix_to_super, steps_per_second_f);
+  m_choices.emplace_back(transformation_matrix_to_super, choice);
+  return choice;
+}
+
+/// \brief Calibrate each candidate, and return the index of the candidate
+///     with the most steps per second
+///
+/// Ties are resolved in favor of the first candidate. Throws if all
+/// candidates fail.
+Index AutoTuner::_calibrate(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    steps_per_second_f_type const &steps_per_second_f) {
+  Log &log = CASM::log();
+  log.indent() << "Auto-tuning KMC options (" << candidate_values.size()
+               << " candidates) ..." << std::endl;
+
+  jsonParser record;
+  to_json(transformation_matrix_to_super,
+          record["transformation_matrix_to_super"]);
+  record["n_steps"] = n_steps;
+  record["kernel_isa"] = to_string(kernel_isa());
+  record["candidates"] = jsonParser::array();
+  Index best = -1;
+  double best_steps_per_second = 0.0;
+  for (Index i = 0; i < Index(candidate_values.size()); ++i) {
+    jsonParser entry;
+    entry["params"] = candidate_values[i];
+    try {
+      double steps_per_second = steps_per_second_f(i);
+      entry["steps_per_second"] = steps_per_second;
+      log.indent() << "- candidate " << i << ": " << steps_per_second
+                   << " steps/s" << std::endl;
+      if (best < 0 || steps_per_second > best_steps_per_second) {
+        best = i;
+        best_steps_per_second = steps_per_second;
+      }
+    } catch (std::exception const &e) {
+      entry["error"] = std::string(e.what());
+      log.indent() << "- candidate " << i << ": failed: " << e.what()
+                   << std::endl;
+    }
+    record["candidates"].push_back(entry);
+  }
+  if (best < 0) {
+    throw std::runtime_error(
+        "Error in AutoTuner: all \"auto_tune\" candidates failed");
+  }
+  record["choice"] = best;
+  log.indent() << "Auto-tuning KMC options: Done (chose candidate " << best
+               << ")" << std::endl;
+
+  m_results.push_back(record);
+  if (!output_file.empty()) {
+    m_results.write(output_file);
+  }
+  return best;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,149 @@
+#include "casm/clexmonte/kinetic/EventTriggeredSampler.hh"
+
+#include <stdexcept>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor
+///
+/// \param _params Parameters
+/// \param sampling_functions Available sampling functions, which must
+///     include all of `_params.sampler_names`
+EventTriggeredSampler::EventTriggeredSampler(
+    EventTriggeredSamplingParams _params,
+    std::map<std::string, state_sampling_function_type> const
+        &sampling_functions)
+    : params(std::move(_params)) {
+  if (params.prim_event_index.empty() && params.event_type_name.empty()) {
+    throw std::runtime_error(
+        "Error constructing EventTriggeredSampler: no prim_event_index or "
+        "event_type_name is given");
+  }
+  for (std::string const &name : params.sampler_names) {
+    auto it = sampling_functions.find(name);
+    if (it == sampling_functions.end()) {
+      throw std::runtime_error(
+          "Error constructing EventTriggeredSampler: no sampling function "
+          "named '" +
+          name + "'");
+    }
+    m_sampling_functions.emplace(name, it->second);
+  }
+}
+
+/// \brief Begin a run
+///
+/// Clears the samples of the previous run, and sets which prim events
+/// trigger a sample.
+///
+/// \param prim_event_type_names The event type name of each prim event,
+///     by prim event index
+///
+/// \throws If a prim event index of `params.prim_event_index` is out of
+///     range, or an event type name of `params.event_type_name` is not the
+///     type of any prim event
+void EventTriggeredSampler::reset(
+    std::vector<std::string> const &prim_event_type_names) {
+  Index n_prim_events = prim_event_type_names.size();
+  m_is_trigger.assign(n_prim_events, false);
+  for (Index i : params.prim_event_index) {
+    if (i < 0 || i >= n_prim_events) {
+      throw std::runtime_error(
+          "Error in EventTriggeredSampler::reset: prim_event_index " +
+          std::to_string(i) + " is out of range");
+    }
+    m_is_trigger[i] = true;
+  }
+  for (std::string const &name : params.event_type_name) {
+    bool found = false;
+    for (Index i = 0; i < n_prim_events; ++i) {
+      if (prim_event_type_names[i] == name) {
+        m_is_trigger[i] = true;
+        found = true;
+      }
+    }
+    if (!found) {
+      throw std::runtime_error(
+          "Error in EventTriggeredSampler::reset: no prim event has "
+          "event_type_name '" +
+          name + "'");
+    }
+  }
+
+  m_n_events = 0;
+  m_pending_prim_event_index = -1;
+  m_sample_time.clear();
+  m_sample_n_events.clear();
+  m_sample_prim_event_index.clear();
+  m_values.clear();
+  for (auto const &pair : m_sampling_functions) {
+    m_values[pair.first];
+  }
+}
+
+/// \brief Sampled values, as a matrix with one row per sample
+Eigen::MatrixXd EventTriggeredSampler::values(
+    std::string const &sampler_name) const {
+  auto it = m_values.find(sampler_name);
+  if (it == m_values.end()) {
+    throw std::runtime_error(
+        "Error in EventTriggeredSampler::values: no sampling function "
+        "named '" +
+        sampler_name + "'");
+  }
+  std::vector<Eigen::VectorXd> const &v = it->second;
+  Index n_components = v.empty() ? 0 : v[0].size();
+  Eigen::MatrixXd result(v.size(), n_components);
+  for (Index i = 0; i < Index(v.size()); ++i) {
+    result.row(i) = v[i].transpose();
+  }
+  return result;
+}
+
+void EventTriggeredSampler::_sample() {
+  m_sample_time.push_back(m_pending_time);
+  m_sample_n_events.push_back(m_pending_n_events);
+  m_sample_prim_event_index.push_back(m_pending_prim_event_index);
+  for (auto const &pair : m_sampling_functions) {
+    m_values[pair.first].push_back(pair.second.function());
+  }
+  m_pending_prim_event_index = -1;
+}
+
+/// \brief Write EventTriggeredSampler samples to JSON
+///
+/// Format:
+///
+///   time: array of number
+///       Time of the triggering event of each sample.
+///   n_events: array of int
+///       Number of events since the start of the run, including the
+///       triggering event, of each sample.
+///   prim_event_index: array of int
+///       Prim event index of the triggering event of each sample.
+///   samplers: dict
+///       By sampling function name, an object with "component_names" and
+///       "value", the sampled values with one row per sample.
+jsonParser &to_json(EventTriggeredSampler const &sampler, jsonParser &json) {
+  json.put_obj();
+  json["time"] = sampler.sample_time();
+  json["n_events"] = sampler.sample_n_events();
+  json["prim_event_index"] = sampler.sample_prim_event_index();
+  json["samplers"] = jsonParser::object();
+  for (auto const &pair : sampler.sampling_functions()) {
+    jsonParser &sampler_json = json["samplers"][pair.first];
+    sampler_json["component_names"] = pair.second.component_names;
+    to_json(sampler.values(pair.first), sampler_json["value"],
+            jsonParser::as_array());
+  }
+  return json;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,133 @@
+#include "casm/clexmonte/kinetic/NonNormalEventLog.hh"
+
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor
+///
+/// \param _n_prim_events Number of prim events
+/// \param _max_examples Maximum number of non-normal events written in full.
+///     If < 0, all non-normal events are written.
+/// \param _out Stream examples are written to. Must outlive the
+///     NonNormalEventLog.
+/// \param _async If true, examples are written by a background thread
+NonNormalEventLog::NonNormalEventLog(Index _n_prim_events, Index _max_examples,
+                                     std::ostream &_out, bool _async)
+    : m_max_examples(_max_examples),
+      m_out(_out),
+      m_total_count(0),
+      m_count_by_prim_event(_n_prim_events),
+      m_writing(false),
+      m_stop(false) {
+  if (_n_prim_events < 0) {
+    throw std::runtime_error(
+        "Error constructing NonNormalEventLog: n_prim_events < 0");
+  }
+  for (auto &count : m_count_by_prim_event) {
+    count.store(0);
+  }
+  if (_async) {
+    m_writer = std::thread(&NonNormalEventLog::_run_writer, this);
+  }
+}
+
+/// \brief Destructor, writes any remaining examples
+NonNormalEventLog::~NonNormalEventLog() {
+  if (m_writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+  }
+}
+
+/// \brief Write an example
+///
+/// If `async` is true, the message is queued and this returns immediately,
+/// else the message is written to the output stream.
+void NonNormalEventLog::write(std::string message) {
+  if (m_writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.push_back(std::move(message));
+    }
+    m_cv.notify_all();
+  } else {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_out << message;
+  }
+}
+
+/// \brief Wait until all examples have been written
+void NonNormalEventLog::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return m_queue.empty() && !m_writing; });
+  m_out.flush();
+}
+
+/// \brief Total number of non-normal events counted
+Index NonNormalEventLog::total_count() const { return m_total_count.load(); }
+
+/// \brief Number of non-normal events counted, for one prim event
+Index NonNormalEventLog::count_by_prim_event(Index prim_event_index) const {
+  return m_count_by_prim_event.at(prim_event_index).load();
+}
+
+/// \brief Number of non-normal events counted, for each prim event
+std::vector<Index> NonNormalEventLog::counts_by_prim_event() const {
+  std::vector<Index> counts;
+  for (auto const &count : m_count_by_prim_event) {
+    counts.push_back(count.load());
+  }
+  return counts;
+}
+
+/// \brief Print number of non-normal events by prim event
+///
+/// Prints the total count, then one line `prim_event_index: count` for each
+/// prim event with a non-zero count.
+void NonNormalEventLog::print_summary(std::ostream &sout) const {
+  Index total = total_count();
+  sout << "Non-normal events: " << total;
+  if (m_max_examples >= 0 && total > m_max_examples) {
+    sout << " (first " << m_max_examples << " written)";
+  }
+  sout << std::endl;
+  for (Index i = 0; i < m_count_by_prim_event.size(); ++i) {
+    Index count = m_count_by_prim_event[i].load();
+    if (count) {
+      sout << "  prim_event_index " << i << ": " << count << std::endl;
+    }
+  }
+}
+
+void NonNormalEventLog::_run_writer() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      // m_stop is true and all messages are written
+      return;
+    }
+    std::deque<std::string> batch;
+    batch.swap(m_queue);
+    m_writing = true;
+    lock.unlock();
+    for (std::string const &message : batch) {
+      m_out << message;
+    }
+    m_out.flush();
+    lock.lock();
+    m_writing = false;
+    m_cv.notify_all();
+  }
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,148 @@
+#include "casm/clexmonte/kinetic/SelectiveAtomTracker.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor
+///
+/// \param prim The prim structure
+/// \param _n_unitcells Number of unit cells in the supercell
+AtomDisplacementCalculator::AtomDisplacementCalculator(
+    xtal::BasicStructure const &prim, Index _n_unitcells)
+    : n_unitcells(_n_unitcells),
+      m_basis_cart(3, prim.basis().size()),
+      m_lattice_column_mat(prim.lattice().lat_column_mat()) {
+  for (Index b = 0; b < prim.basis().size(); ++b) {
+    m_basis_cart.col(b) = prim.basis()[b].const_cart();
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _tracked_atom_names Names of the atom types to track, as in
+///     `occ_events::OccSystem::atom_name_list`
+SelectiveAtomTracker::SelectiveAtomTracker(
+    std::set<std::string> _tracked_atom_names)
+    : tracked_atom_names(std::move(_tracked_atom_names)),
+      m_max_n_components(0) {}
+
+/// \brief Find the tracked atoms in the current occupation
+///
+/// \param occ_location Occupant location tracker, whose species are
+///     current. It does not need to track atoms.
+/// \param occ_system The event system
+/// \param prim The prim structure, used for atom positions
+void SelectiveAtomTracker::reset(monte::OccLocation const &occ_location,
+                                 occ_events::OccSystem const &occ_system,
+                                 xtal::BasicStructure const &prim) {
+  monte::Conversions const &convert = occ_location.convert();
+  if (convert.species_size() != occ_system.orientation_name_list.size()) {
+    throw std::runtime_error(
+        "Error in SelectiveAtomTracker::reset: mismatch between "
+        "monte::Conversions and occ_events::OccSystem.");
+  }
+  for (std::string const &name : tracked_atom_names) {
+    if (std::find(occ_system.atom_name_list.begin(),
+                  occ_system.atom_name_list.end(),
+                  name) == occ_system.atom_name_list.end()) {
+      throw std::runtime_error(
+          "Error in SelectiveAtomTracker::reset: no atom named '" + name +
+          "'");
+    }
+  }
+
+  std::vector<bool> is_tracked_name;
+  for (std::string const &name : occ_system.atom_name_list) {
+    is_tracked_name.push_back(tracked_atom_names.count(name));
+  }
+
+  m_max_n_components = 1;
+  for (auto const &sublattice : occ_system.atom_position_to_name_index) {
+    for (auto const &occupant : sublattice) {
+      m_max_n_components =
+          std::max(m_max_n_components, Index(occupant.size()));
+    }
+  }
+
+  Index n_sites = convert.l_size();
+  m_displacement_f = std::make_unique<AtomDisplacementCalculator>(
+      prim, n_sites / prim.basis().size());
+  Eigen::MatrixXd const &basis_cart = m_displacement_f->basis_cart();
+  Eigen::Matrix3d const &L = m_displacement_f->lattice_column_mat();
+  m_site_atom.assign(n_sites * m_max_n_components, -1);
+  m_atom_name_index_list.clear();
+  std::vector<Eigen::Vector3d> positions;
+  for (Index mol_id = 0; mol_id < occ_location.mol_size(); ++mol_id) {
+    monte::Mol const &mol = occ_location.mol(mol_id);
+    Index b = convert.l_to_b(mol.l);
+    Index occupant_index =
+        occ_system.orientation_to_occupant_index[b][mol.species_index];
+    auto const &atom_names =
+        occ_system.atom_position_to_name_index[b][occupant_index];
+    for (Index mol_comp = 0; mol_comp < atom_names.size(); ++mol_comp) {
+      Index atom_name_index = atom_names[mol_comp];
+      if (!is_tracked_name[atom_name_index]) {
+        continue;
+      }
+      m_site_atom[mol.l * m_max_n_components + mol_comp] =
+          m_atom_name_index_list.size();
+      m_atom_name_index_list.push_back(atom_name_index);
+      Eigen::Vector3d ijk =
+          convert.l_to_bijk(mol.l).unitcell().cast<double>();
+      positions.push_back(basis_cart.col(b) + L * ijk);
+    }
+  }
+
+  m_atom_positions_cart.resize(3, positions.size());
+  for (Index i = 0; i < positions.size(); ++i) {
+    m_atom_positions_cart.col(i) = positions[i];
+  }
+  m_moved_atoms.clear();
+  m_moved_atom_displacements.clear();
+}
+
+/// \brief Move the tracked atoms of an event
+///
+/// The trajectories of an event occur simultaneously, so this may be called
+/// before or after the event is applied to the occupant location tracker,
+/// but must be called exactly once per event.
+///
+/// \param event The event, with `atom_traj` set
+void SelectiveAtomTracker::apply(monte::OccEvent const &event) {
+  m_moved_atoms.clear();
+  m_moved_atom_displacements.clear();
+  Index n_traj = event.atom_traj.size();
+  m_traj_atom.resize(n_traj);
+  for (Index i = 0; i < n_traj; ++i) {
+    monte::AtomTraj const &traj = event.atom_traj[i];
+    Index &site_atom =
+        m_site_atom[traj.from.l * m_max_n_components + traj.from.mol_comp];
+    m_traj_atom[i] = site_atom;
+    site_atom = -1;
+  }
+  for (Index i = 0; i < n_traj; ++i) {
+    Index atom = m_traj_atom[i];
+    if (atom == -1) {
+      continue;
+    }
+    monte::AtomTraj const &traj = event.atom_traj[i];
+    m_site_atom[traj.to.l * m_max_n_components + traj.to.mol_comp] = atom;
+    Eigen::Vector3d dR = (*m_displacement_f)(traj);
+    m_atom_positions_cart.col(atom) += dR;
+    m_moved_atoms.push_back(atom);
+    m_moved_atom_displacements.push_back(dR);
+  }
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,194 @@
+#include "casm/clexmonte/kinetic/TimeResolvedSampler.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor
+///
+/// \param _params Parameters
+/// \param sampling_functions Available sampling functions, which must
+///     include all of `_params.sampler_names`
+TimeResolvedSampler::TimeResolvedSampler(
+    TimeResolvedSamplingParams _params,
+    std::map<std::string, state_sampling_function_type> const
+        &sampling_functions)
+    : params(std::move(_params)) {
+  if (!(params.period > 0.0)) {
+    throw std::runtime_error(
+        "Error constructing TimeResolvedSampler: period must be > 0.0");
+  }
+  if (params.begin < 0.0) {
+    throw std::runtime_error(
+        "Error constructing TimeResolvedSampler: begin must be >= 0.0");
+  }
+  if (!(params.lookahead_fraction > 0.0 && params.lookahead_fraction <= 1.0)) {
+    throw std::runtime_error(
+        "Error constructing TimeResolvedSampler: lookahead_fraction must be "
+        "in (0.0, 1.0]");
+  }
+  for (std::string const &name : params.sampler_names) {
+    auto it = sampling_functions.find(name);
+    if (it == sampling_functions.end()) {
+      throw std::runtime_error(
+          "Error constructing TimeResolvedSampler: no sampling function "
+          "named '" +
+          name + "'");
+    }
+    m_sampling_functions.emplace(name, it->second);
+  }
+}
+
+/// \brief Begin a run
+///
+/// Clears the samples of the previous run.
+void TimeResolvedSampler::reset() {
+  m_time = 0.0;
+  m_n_events = 0;
+  m_next_sample_index = 0;
+  m_next_sample_time = params.begin;
+  m_n_skip = 0;
+  m_n_checks = 0;
+  m_rate_ref_time = 0.0;
+  m_rate_ref_n_events = 0;
+  m_sample_time.clear();
+  m_sample_n_events.clear();
+  m_sample_is_exact.clear();
+  m_values.clear();
+  for (auto const &pair : m_sampling_functions) {
+    m_values[pair.first];
+  }
+}
+
+/// \brief Sampled values, as a matrix with one row per sample
+Eigen::MatrixXd TimeResolvedSampler::values(
+    std::string const &sampler_name) const {
+  auto it = m_values.find(sampler_name);
+  if (it == m_values.end()) {
+    throw std::runtime_error(
+        "Error in TimeResolvedSampler::values: no sampling function "
+        "named '" +
+        sampler_name + "'");
+  }
+  std::vector<Eigen::VectorXd> const &v = it->second;
+  Index n_components = v.empty() ? 0 : v[0].size();
+  Eigen::MatrixXd result(v.size(), n_components);
+  for (Index i = 0; i < Index(v.size()); ++i) {
+    result.row(i) = v[i].transpose();
+  }
+  return result;
+}
+
+/// \brief Sample each sample time before `event_time`, then set the number
+///     of events to skip checking
+///
+/// The current state is the state after the previous event, at `m_time`,
+/// until `event_time`. As for an event at `event_time`, the sample at a
+/// sample time equal to `m_time` is the state before the previous event, so
+/// sample times in `(m_time, event_time]`, or `[0.0, event_time]` for the
+/// first event, are sampled exactly from the current state; earlier sample
+/// times were passed while checks were skipped.
+void TimeResolvedSampler::_check(double event_time) {
+  ++m_n_checks;
+  if (event_time >= m_next_sample_time) {
+    std::map<std::string, Eigen::VectorXd> current;
+    for (auto const &pair : m_sampling_functions) {
+      current.emplace(pair.first, pair.second.function());
+    }
+    Index n_events_applied = m_n_events - 1;
+    while (event_time >= m_next_sample_time) {
+      bool is_exact = m_next_sample_time > m_time || n_events_applied == 0;
+      _sample(m_next_sample_time, n_events_applied, is_exact, current);
+      ++m_next_sample_index;
+      m_next_sample_time =
+          params.begin + m_next_sample_index * params.period;
+    }
+
+    // estimate the events until the next sample time from the event rate
+    // since the last check which sampled
+    if (params.lookahead) {
+      double dt = event_time - m_rate_ref_time;
+      Index dn = m_n_events - m_rate_ref_n_events;
+      if (dt > 0.0 && dn >= params.lookahead_min_events) {
+        double n_expected = (m_next_sample_time - event_time) * dn / dt;
+        m_n_skip = static_cast<Index>(
+            std::floor(params.lookahead_fraction * n_expected));
+      }
+      m_rate_ref_time = event_time;
+      m_rate_ref_n_events = m_n_events;
+    }
+  }
+  m_time = event_time;
+}
+
+void TimeResolvedSampler::_sample(
+    double sample_time, Index n_events_applied, bool is_exact,
+    std::map<std::string, Eigen::VectorXd> const &current) {
+  // interpolate between the previous sample and the current state, which
+  // begins at m_time
+  double f = 1.0;
+  if (!is_exact && params.interpolate && m_sample_time.size() &&
+      m_time > m_sample_time.back()) {
+    f = (sample_time - m_sample_time.back()) / (m_time - m_sample_time.back());
+  }
+  m_sample_time.push_back(sample_time);
+  m_sample_n_events.push_back(n_events_applied);
+  m_sample_is_exact.push_back(is_exact);
+  for (auto const &pair : current) {
+    std::vector<Eigen::VectorXd> &v = m_values[pair.first];
+    if (f < 1.0) {
+      Eigen::VectorXd prev = v.back();
+      v.push_back(prev + f * (pair.second - prev));
+    } else {
+      v.push_back(pair.second);
+    }
+  }
+}
+
+/// \brief Write TimeResolvedSampler samples to JSON
+///
+/// Format:
+///
+///   time: array of number
+///       Time of each sample.
+///   n_events: array of int
+///       Number of events applied before each sample.
+///   is_exact: array of bool
+///       For each sample, true if it is the state at the sample time, false
+///       if the sample time was passed while checks were skipped, in which
+///       case the sample is the state, or interpolated value, when the
+///       passed sample time was detected.
+///   n_checks: int
+///       Number of times an event time was compared with the next sample
+///       time.
+///   samplers: dict
+///       By sampling function name, an object with "component_names" and
+///       "value", the sampled values with one row per sample.
+jsonParser &to_json(TimeResolvedSampler const &sampler, jsonParser &json) {
+  json.put_obj();
+  json["time"] = sampler.sample_time();
+  json["n_events"] = sampler.sample_n_events();
+  json["is_exact"] = jsonParser::array();
+  for (bool is_exact : sampler.sample_is_exact()) {
+    json["is_exact"].push_back(is_exact);
+  }
+  json["n_checks"] = sampler.n_checks();
+  json["samplers"] = jsonParser::object();
+  for (auto const &pair : sampler.sampling_functions()) {
+    jsonParser &sampler_json = json["samplers"][pair.first];
+    sampler_json["component_names"] = pair.second.component_names;
+    to_json(sampler.values(pair.first), sampler_json["value"],
+            jsonParser::as_array());
+  }
+  return json;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
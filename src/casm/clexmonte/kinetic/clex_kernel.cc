@@ -0,0 +1,244 @@
+#include "casm/clexmonte/kinetic/clex_kernel.hh"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+#include "casm/clexmonte/misc/ContentHash.hh"
+#include "casm/system/RuntimeLibrary.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Flatten the coefficients of cluster expansions, one per property
+///
+/// \param coefficients The sparse coefficients of each property
+/// \return The coefficients, in one set of contiguous arrays, to be used
+///     by `evaluate_clex_batch`
+FlatCoefficientTable make_flat_coefficient_table(
+    std::vector<clexulator::SparseCoefficients> const &coefficients) {
+  FlatCoefficientTable table;
+  table.n_properties = coefficients.size();
+  table.offsets.push_back(0);
+  for (auto const &c : coefficients) {
+    if (c.index.size() != c.value.size()) {
+      throw std::runtime_error(
+          "Error in make_flat_coefficient_table: index and value sizes do "
+          "not match");
+    }
+    for (Index k = 0; k < c.index.size(); ++k) {
+      Index j = c.index[k];
+      table.index.push_back(j);
+      table.value.push_back(c.value[k]);
+      if (j + 1 > table.n_corr) {
+        table.n_corr = j + 1;
+      }
+    }
+    table.offsets.push_back(table.index.size());
+  }
+  return table;
+}
+
+namespace {
+
+CASM_CLEXMONTE_ALWAYS_INLINE void _evaluate_clex_batch_impl(
+    FlatCoefficientTable const &table, Index n, double const *corr,
+    double *values) {
+  for (Index p = 0; p < table.n_properties; ++p) {
+    double *v = values + p * n;
+    for (Index i = 0; i < n; ++i) {
+      v[i] = 0.0;
+    }
+    for (Index k = table.offsets[p]; k < table.offsets[p + 1]; ++k) {
+      double coeff = table.value[k];
+      double const *c = corr + table.index[k] * n;
+      for (Index i = 0; i < n; ++i) {
+        v[i] += coeff * c[i];
+      }
+    }
+  }
+}
+
+CASM_CLEXMONTE_TARGET_AVX512 void _evaluate_clex_batch_avx512(
+    FlatCoefficientTable const &table, Index n, double const *corr,
+    double *values) {
+  _evaluate_clex_batch_impl(table, n, corr, values);
+}
+
+CASM_CLEXMONTE_TARGET_AVX2 void _evaluate_clex_batch_avx2(
+    FlatCoefficientTable const &table, Index n, double const *corr,
+    double *values) {
+  _evaluate_clex_batch_impl(table, n, corr, values);
+}
+
+}  // namespace
+
+/// \brief Evaluate cluster expansions for a batch of correlation vectors
+///
+/// For each coefficient the inner loop is over events, reading correlations
+/// and writing values contiguously, with no branches, so that the compiler
+/// can vectorize it. It is compiled for several instruction sets, and the
+/// variant selected by `kernel_isa` is used. Each value is the sum
+/// of the coefficient-correlation products, accumulated in coefficient
+/// order, so results are identical to evaluating one event at a time with
+/// the same coefficient order.
+///
+/// \param table The flattened coefficients
+/// \param n Number of events
+/// \param corr Correlations, `corr[j * n + i]` is correlation `j` of event
+///     `i`, size `table.n_corr * n`
+/// \param values Set to property values, `values[p * n + i]` is the value
+///     of property `p` for event `i`, size `table.n_properties * n`
+void evaluate_clex_batch(FlatCoefficientTable const &table, Index n,
+                         double const *corr, double *values) {
+  KernelISA isa = kernel_isa();
+  if (isa == KernelISA::avx512) {
+    _evaluate_clex_batch_avx512(table, n, corr, values);
+  } else if (isa == KernelISA::avx2) {
+    _evaluate_clex_batch_avx2(table, n, corr, values);
+  } else {
+    _evaluate_clex_batch_impl(table, n, corr, values);
+  }
+}
+
+/// \brief Write the source of a batch kernel specialized for fixed
+///     coefficients
+///
+/// The source defines
+/// `extern "C" void <function_name>(long n, double const *corr,
+/// double *values)`, which is equivalent to
+/// `evaluate_clex_batch(table, n, corr, values)`. Coefficients are written
+/// as hexadecimal floating point literals, so they are exact, and are
+/// accumulated in the same order, so results are identical. The source has
+/// no includes or dependencies.
+///
+/// \param sout Stream to write to
+/// \param table The coefficients
+/// \param function_name Name of the kernel function, which must be a valid
+///     C identifier
+void write_specialized_clex_kernel_source(std::ostream &sout,
+                                          FlatCoefficientTable const &table,
+                                          std::string const &function_name) {
+  bool is_valid_name =
+      !function_name.empty() &&
+      !std::isdigit(static_cast<unsigned char>(function_name[0]));
+  for (char c : function_name) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+      is_valid_name = false;
+    }
+  }
+  if (!is_valid_name) {
+    throw std::runtime_error(
+        "Error in write_specialized_clex_kernel_source: invalid function "
+        "name '" +
+        function_name + "'");
+  }
+
+  sout << "// Cluster expansion batch kernel with fixed coefficients\n"
+       << "// n_properties: " << table.n_properties << "\n"
+       << "// n_corr: " << table.n_corr << "\n\n";
+
+  // coefficient tables
+  sout << "namespace {\n\n";
+  for (Index p = 0; p < table.n_properties; ++p) {
+    Index begin = table.offsets[p];
+    Index end = table.offsets[p + 1];
+    if (begin == end) {
+      continue;
+    }
+    sout << "constexpr long index_" << p << "[" << end - begin << "] = {";
+    for (Index k = begin; k < end; ++k) {
+      sout << (k == begin ? "" : ", ") << table.index[k];
+    }
+    sout << "};\n";
+    sout << "constexpr double value_" << p << "[" << end - begin << "] = {";
+    sout << std::hexfloat;
+    for (Index k = begin; k < end; ++k) {
+      sout << (k == begin ? "" : ", ") << table.value[k];
+    }
+    sout << std::defaultfloat;
+    sout << "};\n\n";
+  }
+  sout << "}  // namespace\n\n";
+
+  // kernel, with the coefficient loop unrolled
+  sout << "extern \"C\" void " << function_name
+       << "(long n, double const *corr, double *values) {\n";
+  for (Index p = 0; p < table.n_properties; ++p) {
+    Index begin = table.offsets[p];
+    Index end = table.offsets[p + 1];
+    sout << "  {\n"
+         << "    double *v = values + " << p << " * n;\n"
+         << "    for (long i = 0; i < n; ++i) {\n"
+         << "      double x = 0.0;\n";
+    for (Index k = 0; k < end - begin; ++k) {
+      sout << "      x += value_" << p << "[" << k << "] * corr[index_" << p
+           << "[" << k << "] * n + i];\n";
+    }
+    sout << "      v[i] = x;\n"
+         << "    }\n"
+         << "  }\n";
+  }
+  sout << "}\n";
+}
+
+/// \brief Constructor, compiling the kernel if necessary
+///
+/// \param _table The coefficients
+/// \param dirpath Directory where the kernel source and library are
+///     written, which is created if it does not exist
+/// \param name Kernel name, used for the function and file names, which
+///     must be a valid C identifier
+/// \param compile_options Options used to compile the source. If empty,
+///     `RuntimeLibrary::default_cxx()` and
+///     `RuntimeLibrary::default_cxxflags()` are used.
+/// \param so_options Options used to make the shared library. If empty,
+///     `RuntimeLibrary::default_cxx()` and
+///     `RuntimeLibrary::default_soflags()` are used.
+SpecializedClexKernel::SpecializedClexKernel(FlatCoefficientTable const &_table,
+                                             fs::path dirpath,
+                                             std::string name,
+                                             std::string compile_options,
+                                             std::string so_options)
+    : table(_table) {
+  std::stringstream source;
+  write_specialized_clex_kernel_source(source, table, name);
+  ContentHash hash;
+  hash.update(source.str());
+  std::string function_name = name + "_" + hash.hex();
+
+  std::stringstream function_source;
+  write_specialized_clex_kernel_source(function_source, table, function_name);
+  fs::create_directories(dirpath);
+  fs::path filename_base = dirpath / function_name;
+  fs::path source_path = filename_base.string() + ".cc";
+  if (!fs::exists(source_path)) {
+    std::ofstream file(source_path);
+    file << function_source.str();
+    if (!file) {
+      throw std::runtime_error(
+          "Error constructing SpecializedClexKernel: could not write " +
+          source_path.string());
+    }
+  }
+
+  if (compile_options.empty()) {
+    compile_options = RuntimeLibrary::default_cxx().first + " " +
+                      RuntimeLibrary::default_cxxflags().first;
+  }
+  if (so_options.empty()) {
+    so_options = RuntimeLibrary::default_cxx().first + " " +
+                 RuntimeLibrary::default_soflags().first;
+  }
+  m_lib = std::make_shared<RuntimeLibrary>(filename_base.string(),
+                                           compile_options, so_options);
+  m_f = m_lib->get_function<void(Index, double const *, double *)>(
+      function_name);
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,101 @@
+#include "casm/clexmonte/kinetic/io/json/BarrierModel_json_io.hh"
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/kinetic/rate_kernel.hh"
+
+namespace CASM {
+
+namespace {
+
+std::map<std::string, clexmonte::kinetic::BarrierModelType> const &
+barrier_model_type_names() {
+  static std::map<std::string, clexmonte::kinetic::BarrierModelType> const
+      names = {{"kra", clexmonte::kinetic::BarrierModelType::kra},
+               {"fixed", clexmonte::kinetic::BarrierModelType::fixed},
+               {"bep", clexmonte::kinetic::BarrierModelType::bep}};
+  return names;
+}
+
+}  // namespace
+
+jsonParser &to_json(clexmonte::kinetic::BarrierModel const &model,
+                    jsonParser &json) {
+  json.put_obj();
+  for (auto const &pair : barrier_model_type_names()) {
+    if (pair.second == model.type) {
+      json["type"] = pair.first;
+    }
+  }
+  if (model.type == clexmonte::kinetic::BarrierModelType::fixed) {
+    json["barrier"] = model.barrier;
+  }
+  if (model.type == clexmonte::kinetic::BarrierModelType::bep) {
+    json["intercept"] = model.intercept;
+    json["slope"] = model.slope;
+  }
+  return json;
+}
+
+/// \brief Parse clexmonte::kinetic::BarrierModel
+///
+/// Expected format:
+/// \code
+///   "type": string (required)
+///       The barrier model, which determines the activation energy,
+///       dE_activated, from the change in energy to the final state,
+///       dE_final. One of:
+///       - "kra": The KRA midpoint formula, dE_activated = 0.5 * dE_final +
+///         Ekra, where Ekra is calculated by the "kra" event local cluster
+///         expansion.
+///       - "fixed": A fixed activation energy, dE_activated = barrier.
+///       - "bep": Bronsted-Evans-Polanyi scaling, dE_activated = intercept +
+///         slope * dE_final.
+///       For all models, dE_activated is then clamped to be no less than
+///       dE_final or 0.0.
+///   "barrier": number (required for "fixed")
+///       The activation energy.
+///   "intercept": number (required for "bep")
+///       The activation energy if dE_final is 0.0.
+///   "slope": number (optional, default=0.5)
+///       For "bep", the change in activation energy per change in dE_final.
+/// \endcode
+void parse(InputParser<clexmonte::kinetic::BarrierModel> &parser) {
+  auto ptr = std::make_unique<clexmonte::kinetic::BarrierModel>();
+  clexmonte::kinetic::BarrierModel &model = *ptr;
+
+  std::string type;
+  parser.require(type, "type");
+  if (parser.valid()) {
+    auto it = barrier_model_type_names().find(type);
+    if (it == barrier_model_type_names().end()) {
+      std::stringstream msg;
+      msg << "Error: invalid \"type\" value: \"" << type
+          << "\". Options are: \"kra\", \"fixed\", \"bep\".";
+      parser.insert_error("type", msg.str());
+    } else {
+      model.type = it->second;
+    }
+  }
+  if (model.type == clexmonte::kinetic::BarrierModelType::fixed) {
+    parser.require(model.barrier, "barrier");
+  }
+  if (model.type == clexmonte::kinetic::BarrierModelType::bep) {
+    parser.require(model.intercept, "intercept");
+    parser.optional(model.slope, "slope");
+  }
+  if (parser.valid()) {
+    parser.value = std::move(ptr);
+  }
+}
+
+void from_json(clexmonte::kinetic::BarrierModel &model,
+               jsonParser const &json) {
+  InputParser<clexmonte::kinetic::BarrierModel> parser{json};
+  std::stringstream ss;
+  ss << "Error: Invalid clexmonte::kinetic::BarrierModel object";
+  report_and_throw_if_invalid(parser, err_log(), std::runtime_error{ss.str()});
+  model = std::move(*parser.value);
+}
+
+}  // namespace CASM
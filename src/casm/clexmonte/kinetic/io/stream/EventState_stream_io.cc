@@ -40,13 +40,21 @@ void print(std::ostream &out, kinetic::EventState const &event_state,
 
 void print(std::ostream &out, kinetic::EventState const &event_state,
            EventData const &event_data, PrimEventData const &prim_event_data) {
+  print(out, event_state, event_data.unitcell_index,
+        event_data.event.linear_site_index, prim_event_data);
+}
+
+void print(std::ostream &out, kinetic::EventState const &event_state,
+           Index unitcell_index, EventSites linear_site_index,
+           PrimEventData const &prim_event_data) {
   out << "prim_event_index: " << prim_event_data.prim_event_index << std::endl;
-  out << "unitcell_index: " << event_data.unitcell_index << std::endl;
+  out << "unitcell_index: " << unitcell_index << std::endl;
   out << "event_type_name: " << prim_event_data.event_type_name << std::endl;
   out << "equivalent_index: " << prim_event_data.equivalent_index << std::endl;
   out << "is_forward: " << std::boolalpha << prim_event_data.is_forward
       << std::endl;
-  out << "linear_site_index: " << event_data.event.linear_site_index
+  out << "linear_site_index: "
+      << std::vector<Index>(linear_site_index.begin(), linear_site_index.end())
       << std::endl;
   out << "occ_init: " << prim_event_data.occ_init << std::endl;
   out << "occ_final: " << prim_event_data.occ_final << std::endl;
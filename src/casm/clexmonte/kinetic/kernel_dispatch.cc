@@ -0,0 +1,75 @@
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+namespace {
+
+/// \brief Select the kernel instruction set variant
+///
+/// The environment variable `CASM_CLEXMONTE_KERNEL_ISA` ("baseline",
+/// "avx2", or "avx512") may be set to limit the variant, for example to
+/// compare results or timings; it never selects a variant that the CPU
+/// does not support.
+KernelISA _select_kernel_isa() {
+  KernelISA isa = detect_kernel_isa();
+  char const *requested = std::getenv("CASM_CLEXMONTE_KERNEL_ISA");
+  if (requested != nullptr) {
+    for (KernelISA limit :
+         {KernelISA::baseline, KernelISA::avx2, KernelISA::avx512}) {
+      if (to_string(limit) == requested) {
+        isa = std::min(isa, limit);
+      }
+    }
+  }
+  return isa;
+}
+
+}  // namespace
+
+/// \brief Name of a kernel instruction set variant: "baseline", "avx2", or
+///     "avx512"
+std::string to_string(KernelISA isa) {
+  if (isa == KernelISA::avx512) {
+    return "avx512";
+  } else if (isa == KernelISA::avx2) {
+    return "avx2";
+  }
+  return "baseline";
+}
+
+/// \brief Best kernel instruction set variant supported by this CPU
+KernelISA detect_kernel_isa() {
+#ifdef CASM_CLEXMONTE_KERNEL_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return KernelISA::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return KernelISA::avx2;
+  }
+#endif
+  return KernelISA::baseline;
+}
+
+/// \brief Kernel instruction set variant used by the vectorized kernels,
+///     selected on first use
+///
+/// The variant is selected once per process, by `detect_kernel_isa`, and
+/// limited by the environment variable `CASM_CLEXMONTE_KERNEL_ISA`, if set.
+/// All variants give identical results: they evaluate the same operations
+/// in the same order, and the kernel sources are compiled without floating
+/// point contraction, so the AVX-512 variant does not use fused
+/// multiply-add.
+KernelISA kernel_isa() {
+  static KernelISA const isa = _select_kernel_isa();
+  return isa;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -41,6 +41,82 @@ std::vector<Index> make_atom_name_index_list(
   return atom_name_index_list;
 }
 
+/// \brief Construct the atom displacements of each prim event
+///
+/// \param prim_event_list The prim events
+/// \param occ_system The event system, whose `atom_name_list` gives the
+///     atom types
+/// \param displacement_f Gives the prim basis and lattice
+///
+/// \returns The displacement and atom type of each atom moved by each prim
+///     event, by prim event index. Displacements are the same for all
+///     translations of a prim event. Trajectories to or from the reservoir
+///     are skipped.
+std::vector<std::vector<PrimEventAtomDisplacement>>
+make_prim_event_atom_displacements(
+    std::vector<PrimEventData> const &prim_event_list,
+    occ_events::OccSystem const &occ_system,
+    AtomDisplacementCalculator const &displacement_f) {
+  Eigen::MatrixXd const &basis_cart = displacement_f.basis_cart();
+  Eigen::Matrix3d const &L = displacement_f.lattice_column_mat();
+  std::vector<std::vector<PrimEventAtomDisplacement>> result;
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    std::vector<PrimEventAtomDisplacement> prim_event_dR;
+    for (Index i = 0; i < Index(prim_event_data.event.size()); ++i) {
+      occ_events::OccTrajectory const &occ_traj = prim_event_data.event[i];
+      if (occ_traj.position.size() != 2) {
+        throw std::runtime_error(
+            "Error in make_prim_event_atom_displacements: KMC event "
+            "trajectories must be size 2.");
+      }
+      occ_events::OccPosition const &from = occ_traj.position[0];
+      occ_events::OccPosition const &to = occ_traj.position[1];
+      if (from.is_in_resevoir || to.is_in_resevoir) {
+        continue;
+      }
+      Index b_from = from.integral_site_coordinate.sublattice();
+      Index b_to = to.integral_site_coordinate.sublattice();
+      PrimEventAtomDisplacement d;
+      d.atom_name_index =
+          occ_system.atom_position_to_name_index[b_from][from.occupant_index]
+                                                [from.atom_position_index];
+      d.dR = basis_cart.col(b_to) - basis_cart.col(b_from) +
+             L * (to.integral_site_coordinate.unitcell() -
+                  from.integral_site_coordinate.unitcell())
+                     .cast<double>();
+      prim_event_dR.push_back(d);
+    }
+    result.push_back(std::move(prim_event_dR));
+  }
+  return result;
+}
+
+/// \brief Construct a list, indexed by species index, of which species are
+///     defects
+///
+/// \param occ_system The event system, whose `orientation_name_list` gives
+///     the species names in the order of monte::Conversions species indices
+/// \param defect_species Names of the defect species
+///
+/// \returns `is_defect_species`, with `is_defect_species[species_index]`
+///     true if the species is a defect
+std::vector<bool> make_is_defect_species(
+    occ_events::OccSystem const &occ_system,
+    std::vector<std::string> const &defect_species) {
+  auto const &name_list = occ_system.orientation_name_list;
+  std::vector<bool> is_defect_species(name_list.size(), false);
+  for (std::string const &name : defect_species) {
+    auto it = std::find(name_list.begin(), name_list.end(), name);
+    if (it == name_list.end()) {
+      throw std::runtime_error(
+          "Error in CASM::clexmonte::kinetic::make_is_defect_species: \"" +
+          name + "\" is not an occupant name");
+    }
+    is_defect_species[std::distance(name_list.begin(), it)] = true;
+  }
+  return is_defect_species;
+}
+
 /// \brief Helper for making a conditions ValueMap for canonical Monte
 ///     Carlo calculations
 ///
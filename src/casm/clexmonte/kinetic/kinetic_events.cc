@@ -1,8 +1,14 @@
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 
+#include <algorithm>
+#include <cstring>
+
+#include "casm/clexmonte/events/PrimImpactInfoSnapshot.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/kinetic/io/stream/EventState_stream_io.hh"
+#include "casm/clexmonte/run/MemoryReport.hh"
 #include "casm/clexmonte/state/Conditions.hh"
+#include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/system/System.hh"
 
 namespace CASM {
@@ -10,56 +16,347 @@ namespace clexmonte {
 namespace kinetic {
 
 /// \brief Constructor
+///
+/// \param prim_impact_info_list Impact information for each prim event, with
+///     split impact neighborhoods
+/// \param unitcell_converter Convert unit cell indices
+EventStateCache::EventStateCache(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter)
+    : n_prim_events(prim_impact_info_list.size()),
+      m_update_table(make_relative_update_table(prim_impact_info_list)),
+      m_unitcell_converter(unitcell_converter) {
+  Index n_events = unitcell_converter.total_sites() * n_prim_events;
+  dE_final.resize(n_events, 0.0);
+  Ekra.resize(n_events, 0.0);
+  freq.resize(n_events, 0.0);
+  update_flags.resize(n_events, update_all);
+}
+
+/// \brief Mark all parts of all events out of date
+void EventStateCache::invalidate() {
+  std::fill(update_flags.begin(), update_flags.end(), update_all);
+}
+
+/// \brief Mark parts of events impacted by `event_id` out of date
+void EventStateCache::set_occurred(EventID const &event_id) {
+  xtal::UnitCell translation = m_unitcell_converter(event_id.unitcell_index);
+  for (RelativeEventUpdate const &update :
+       m_update_table[event_id.prim_event_index]) {
+    Index unitcell_index =
+        m_unitcell_converter(translation + update.event.translation);
+    Index linear_index =
+        unitcell_index * n_prim_events + update.event.prim_event_index;
+    update_flags[linear_index] |= update.flags;
+  }
+}
+
+/// \brief Constructor
+///
+/// \param prim_impact_info_list Impact information for each prim event
+/// \param index_converter Convert between UnitCellCoord and linear site
+///     index in the supercell
+/// \param unitcell_converter Convert between UnitCell and linear unit cell
+///     index in the supercell
+/// \param _max_size Maximum number of entries
+LocalEnvironmentCache::LocalEnvironmentCache(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    xtal::UnitCellCoordIndexConverter const &index_converter,
+    xtal::UnitCellIndexConverter const &unitcell_converter, Index _max_size)
+    : m_index_converter(index_converter),
+      m_unitcell_converter(unitcell_converter),
+      m_max_size(_max_size),
+      m_n_hits(0),
+      m_n_misses(0),
+      m_n_clears(0) {
+  if (m_max_size < 1) {
+    throw std::runtime_error(
+        "Error constructing LocalEnvironmentCache: max_size < 1");
+  }
+  for (EventImpactInfo const &impact : prim_impact_info_list) {
+    m_neighborhood.emplace_back(impact.required_update_neighborhood.begin(),
+                                impact.required_update_neighborhood.end());
+  }
+}
+
+/// \brief Find stored rate inputs of an event
+///
+/// \param state If found, `dE_final`, `Ekra`, and `freq` are set
+/// \param prim_event_index Prim event index of the event
+/// \param unitcell_index Linear unit cell index of the event
+/// \param occupation The current occupation
+///
+/// \returns True if found. If false, the event's key is kept for `insert`.
+bool LocalEnvironmentCache::find(EventState &state, Index prim_event_index,
+                                 Index unitcell_index,
+                                 Eigen::VectorXi const &occupation) {
+  std::vector<xtal::UnitCellCoord> const &neighborhood =
+      m_neighborhood[prim_event_index];
+  xtal::UnitCell translation = m_unitcell_converter(unitcell_index);
+  m_key.resize(sizeof(Index) + neighborhood.size());
+  std::memcpy(&m_key[0], &prim_event_index, sizeof(Index));
+  char *occ = &m_key[sizeof(Index)];
+  for (xtal::UnitCellCoord const &site : neighborhood) {
+    Index l = m_index_converter(site + translation);
+    *occ++ = static_cast<char>(occupation(l));
+  }
+
+  auto it = m_entries.find(m_key);
+  if (it == m_entries.end()) {
+    ++m_n_misses;
+    return false;
+  }
+  ++m_n_hits;
+  state.dE_final = it->second.dE_final;
+  state.Ekra = it->second.Ekra;
+  state.freq = it->second.freq;
+  return true;
+}
+
+/// \brief Store rate inputs for the event of the last unsuccessful `find`
+void LocalEnvironmentCache::insert(EventState const &state) {
+  if (Index(m_entries.size()) >= m_max_size) {
+    m_entries.clear();
+    ++m_n_clears;
+  }
+  m_entries.emplace(m_key, Entry{state.dE_final, state.Ekra, state.freq});
+}
+
+/// \brief Construct a cache for the same events, with no entries
+std::shared_ptr<LocalEnvironmentCache> LocalEnvironmentCache::make_empty_copy()
+    const {
+  auto result = std::make_shared<LocalEnvironmentCache>(*this);
+  result->m_entries.clear();
+  result->m_n_hits = 0;
+  result->m_n_misses = 0;
+  result->m_n_clears = 0;
+  return result;
+}
+
+/// \brief Constructor
+///
+/// \param _n_events Number of events, including events not included in the
+///     event list (i.e. `n_unitcells * n_prim_events`)
+/// \param _max_full_size If `_n_events` is greater than this, only `rate`,
+///     `dE_activated`, `is_allowed`, and `is_normal` are stored
+EventStateStore::EventStateStore(Index _n_events, Index _max_full_size)
+    : m_is_full(_n_events <= _max_full_size) {
+  if (m_is_full) {
+    m_event_state.resize(_n_events);
+  } else {
+    m_rate.resize(_n_events, 0.0f);
+    m_dE_activated.resize(_n_events, 0.0f);
+  }
+  m_is_calculated.resize(_n_events, false);
+  m_is_allowed.resize(_n_events, false);
+  m_is_normal.resize(_n_events, false);
+}
+
+/// \brief Store the state of an event
+void EventStateStore::set(Index linear_index, EventState const &event_state) {
+  if (m_is_full) {
+    m_event_state[linear_index] = event_state;
+  } else {
+    m_rate[linear_index] = event_state.rate;
+    m_dE_activated[linear_index] = event_state.dE_activated;
+  }
+  m_is_calculated[linear_index] = true;
+  m_is_allowed[linear_index] = event_state.is_allowed;
+  m_is_normal[linear_index] = event_state.is_normal;
+}
+
+/// \brief The complete stored state of an event, requires `is_full()`
+EventState const &EventStateStore::event_state(Index linear_index) const {
+  if (!m_is_full) {
+    throw std::runtime_error(
+        "Error in EventStateStore::event_state: complete event states are "
+        "not stored, the number of events exceeds the memory limit");
+  }
+  return m_event_state[linear_index];
+}
+
+/// \brief Constructor
+///
+/// \param _n_events Number of events, as `EventDataList::n_slots()`
+/// \param _n_prim_events Number of prim events
+EventRateTotals::EventRateTotals(Index _n_events, Index _n_prim_events)
+    : m_n_prim_events(_n_prim_events),
+      m_rate(_n_events, 0.0),
+      m_total(_n_prim_events),
+      m_prim_event_total_rate(_n_prim_events, 0.0) {
+  if (m_n_prim_events < 1) {
+    throw std::runtime_error(
+        "Error constructing EventRateTotals: n_prim_events < 1");
+  }
+}
+
+/// \brief Re-sum totals from the stored rates
+void EventRateTotals::resum() {
+  for (Index p = 0; p < m_n_prim_events; ++p) {
+    resum(p);
+  }
+}
+
+/// \brief Re-sum the total of one prim event from its stored rates
+///
+/// Events of one prim event are strided by `n_prim_events` in the stored
+/// rates, so this is O(size() / n_prim_events).
+void EventRateTotals::resum(Index prim_event_index) {
+  CompensatedSum &total = m_total[prim_event_index];
+  total.reset();
+  for (Index i = prim_event_index; i < m_rate.size(); i += m_n_prim_events) {
+    total.add(m_rate[i]);
+  }
+  m_prim_event_total_rate[prim_event_index] = total.value();
+}
+
+/// \brief Set all stored rates and totals to 0.0
+void EventRateTotals::reset() {
+  std::fill(m_rate.begin(), m_rate.end(), 0.0);
+  for (CompensatedSum &total : m_total) {
+    total.reset();
+  }
+  std::fill(m_prim_event_total_rate.begin(), m_prim_event_total_rate.end(),
+            0.0);
+}
+
+/// \brief Constructor
+///
+/// \param _system System data
+/// \param _event_type_name Event type name
+/// \param _barrier_model Barrier model used to calculate activation
+///     energies. The "kra" event local cluster expansion is only required if
+///     the barrier model uses it.
 EventStateCalculator::EventStateCalculator(std::shared_ptr<system_type> _system,
-                                           std::string _event_type_name)
-    : m_system(_system), m_event_type_name(_event_type_name) {}
+                                           std::string _event_type_name,
+                                           BarrierModel _barrier_model)
+    : m_data(std::make_shared<Data>()) {
+  m_data->system = _system;
+  m_data->event_type_name = _event_type_name;
+  m_data->barrier_model = _barrier_model;
+}
 
 /// \brief Reset pointer to state currently being calculated
 void EventStateCalculator::set(state_type const *state,
                                std::shared_ptr<Conditions> conditions) {
+  if (state == nullptr) {
+    throw std::runtime_error(
+        "Error setting EventStateCalculator state: state is empty");
+  }
+  set(state, conditions, get_clex(*m_data->system, *state, "formation_energy"),
+      get_local_multiclex(*m_data->system, *state, m_data->event_type_name,
+                          event_clex_coefficient_names()));
+}
+
+/// \brief Reset pointer to state currently being calculated, using the
+///     given cluster expansion objects
+///
+/// \param state State to calculate
+/// \param conditions Conditions to calculate
+/// \param formation_energy_clex Formation energy cluster expansion, which
+///     must be set to evaluate `state`
+/// \param event_clex Event local cluster expansion (i.e. "kra" and "freq"),
+///     which must be set to evaluate `state`. This may either include all
+///     coefficient sets of the event type's local multi-cluster expansion,
+///     or only those named by `event_clex_coefficient_names()`, in that
+///     order, in which case unused basis functions are not evaluated.
+void EventStateCalculator::set(
+    state_type const *state, std::shared_ptr<Conditions> conditions,
+    std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex,
+    std::shared_ptr<clexulator::MultiLocalClusterExpansion> event_clex) {
   // supercell-specific
-  m_state = state;
-  if (m_state == nullptr) {
+  m_data->state = state;
+  if (m_data->state == nullptr) {
     throw std::runtime_error(
         "Error setting EventStateCalculator state: state is empty");
   }
-  m_formation_energy_clex = get_clex(*m_system, *m_state, "formation_energy");
+  m_data->formation_energy_clex = formation_energy_clex;
 
   // set and validate event clex
   LocalMultiClexData event_local_multiclex_data =
-      get_local_multiclex_data(*m_system, m_event_type_name);
-  m_event_clex = get_local_multiclex(*m_system, *m_state, m_event_type_name);
+      get_local_multiclex_data(*m_data->system, m_data->event_type_name);
+  m_data->event_clex = event_clex;
   std::map<std::string, Index> _glossary =
       event_local_multiclex_data.coefficients_glossary;
 
   auto _check_coeffs = [&](Index &coeff_index, std::string key) {
     if (!_glossary.count(key)) {
       std::stringstream ss;
-      ss << "Error constructing " << m_event_type_name
+      ss << "Error constructing " << m_data->event_type_name
          << " EventStateCalculator: No " << key << " cluster expansion";
       throw std::runtime_error(ss.str());
     }
     coeff_index = _glossary.at(key);
-    if (coeff_index < 0 || coeff_index >= m_event_clex->coefficients().size()) {
+    if (coeff_index < 0 ||
+        coeff_index >= m_data->event_clex->coefficients().size()) {
       std::stringstream ss;
-      ss << "Error constructing " << m_event_type_name
+      ss << "Error constructing " << m_data->event_type_name
          << " EventStateCalculator: " << key << " index out of range";
       throw std::runtime_error(ss.str());
     }
   };
-  _check_coeffs(m_kra_index, "kra");
-  _check_coeffs(m_freq_index, "freq");
+  m_data->kra_index = -1;
+  std::vector<std::string> names = event_clex_coefficient_names();
+  if (m_data->event_clex->coefficients().size() == names.size()) {
+    // event_clex only includes the coefficient sets that are used, in
+    // glossary order, so they are indexed by position
+    for (Index i = 0; i < names.size(); ++i) {
+      if (names[i] == "kra") {
+        m_data->kra_index = i;
+      } else if (names[i] == "freq") {
+        m_data->freq_index = i;
+      }
+    }
+  } else {
+    if (m_data->barrier_model.uses_kra() || _glossary.count("kra")) {
+      _check_coeffs(m_data->kra_index, "kra");
+    }
+    _check_coeffs(m_data->freq_index, "freq");
+  }
 
   // conditions-specific
-  m_conditions = conditions;
+  m_data->conditions = conditions;
+}
+
+/// \brief Names of the event local cluster expansion coefficient sets
+///     used to calculate event states
+///
+/// This is "freq", and "kra" if the barrier model uses it or it exists,
+/// ordered by index in the local multi-cluster expansion coefficients
+/// glossary. A local multi-cluster expansion constructed with only these
+/// coefficient sets (see `get_local_multiclex`) evaluates only the basis
+/// functions that are needed, in one pass.
+std::vector<std::string> EventStateCalculator::event_clex_coefficient_names()
+    const {
+  std::map<std::string, Index> const &glossary =
+      get_local_multiclex_data(*m_data->system, m_data->event_type_name)
+          .coefficients_glossary;
+  std::vector<std::pair<Index, std::string>> used;
+  for (std::string key : {"kra", "freq"}) {
+    auto it = glossary.find(key);
+    if (it != glossary.end()) {
+      used.emplace_back(it->second, key);
+    } else if (key == "freq" || m_data->barrier_model.uses_kra()) {
+      std::stringstream ss;
+      ss << "Error in " << m_data->event_type_name
+         << " EventStateCalculator: No " << key << " cluster expansion";
+      throw std::runtime_error(ss.str());
+    }
+  }
+  std::sort(used.begin(), used.end());
+  std::vector<std::string> names;
+  for (auto const &pair : used) {
+    names.push_back(pair.second);
+  }
+  return names;
 }
 
 /// \brief Pointer to current state
-state_type const *EventStateCalculator::state() const { return m_state; }
+state_type const *EventStateCalculator::state() const { return m_data->state; }
 
 /// \brief Pointer to current conditions
 std::shared_ptr<Conditions> const &EventStateCalculator::conditions() const {
-  return m_conditions;
+  return m_data->conditions;
 }
 
 /// \brief Calculate the state of an event
@@ -75,50 +372,357 @@ std::shared_ptr<Conditions> const &EventStateCalculator::conditions() const {
 void EventStateCalculator::calculate_event_state(
     EventState &state, EventData const &event_data,
     PrimEventData const &prim_event_data) const {
-  clexulator::ConfigDoFValues const *dof_values =
-      m_formation_energy_clex->get();
+  calculate_event_state(state, event_data.unitcell_index,
+                        event_data.event.linear_site_index, prim_event_data);
+}
 
+/// \brief Calculate the state of an event, given its linear site indices
+///
+/// \param state Stores whether the event is allowed, is "normal",
+///     energy barriers, and event rate
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+void EventStateCalculator::calculate_event_state(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data) const {
+  if (calculate_rate_inputs(state, unitcell_index, linear_site_index,
+                            prim_event_data)) {
+    set_rate(state);
+  }
+}
+
+/// \brief Calculate whether an event is allowed, and if it is, the change
+///     in energy, KRA, and attempt frequency, but not the rate
+///
+/// \param state Sets `is_allowed`. If allowed, sets `dE_final`, `Ekra`, and
+///     `freq`, else sets `rate` to 0.0.
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+///
+/// \returns `state.is_allowed`
+bool EventStateCalculator::calculate_rate_inputs(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data) const {
+  if (!_is_allowed(linear_site_index, prim_event_data)) {
+    state.is_allowed = false;
+    state.rate = 0.0;
+    return false;
+  }
+  state.is_allowed = true;
+  _calculate_energies(state, unitcell_index, linear_site_index,
+                      prim_event_data, update_all);
+  return true;
+}
+
+/// \brief Calculate the state of an event, reusing cached parts which are
+///     not out of date
+///
+/// \param state Stores whether the event is allowed, is "normal",
+///     energy barriers, and event rate
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+/// \param cache Cached event state parts. Only the parts marked out of date
+///     are recalculated, then the cache is updated.
+/// \param linear_index The event linear index, used to index `cache`
+void EventStateCalculator::calculate_event_state(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data, EventStateCache &cache,
+    Index linear_index) const {
+  if (calculate_rate_inputs(state, unitcell_index, linear_site_index,
+                            prim_event_data, cache, linear_index)) {
+    set_rate(state);
+  }
+}
+
+/// \brief Calculate whether an event is allowed, and if it is, the change
+///     in energy, KRA, and attempt frequency, reusing cached parts which are
+///     not out of date, but not the rate
+///
+/// \param state Sets `is_allowed`. If allowed, sets `dE_final`, `Ekra`, and
+///     `freq`, else sets `rate` to 0.0.
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+/// \param cache Cached event state parts. Only the parts marked out of date
+///     are recalculated, then the cache is updated.
+/// \param linear_index The event linear index, used to index `cache`
+///
+/// \returns `state.is_allowed`
+bool EventStateCalculator::calculate_rate_inputs(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data, EventStateCache &cache,
+    Index linear_index) const {
+  if (!_is_allowed(linear_site_index, prim_event_data)) {
+    state.is_allowed = false;
+    state.rate = 0.0;
+    // cached parts are not calculated for events that are not allowed
+    cache.update_flags[linear_index] = update_all;
+    return false;
+  }
+  state.is_allowed = true;
+
+  unsigned char flags = cache.update_flags[linear_index];
+  _calculate_energies(state, unitcell_index, linear_site_index,
+                      prim_event_data, flags);
+
+  if (flags & update_dE_final) {
+    cache.dE_final[linear_index] = state.dE_final;
+  } else {
+    state.dE_final = cache.dE_final[linear_index];
+  }
+  if (flags & update_local_clex) {
+    cache.Ekra[linear_index] = state.Ekra;
+    cache.freq[linear_index] = state.freq;
+  } else {
+    state.Ekra = cache.Ekra[linear_index];
+    state.freq = cache.freq[linear_index];
+  }
+  cache.update_flags[linear_index] = update_none;
+  return true;
+}
+
+/// \brief Return true if the event sites have the initial occupation
+bool EventStateCalculator::_is_allowed(
+    EventSites linear_site_index, PrimEventData const &prim_event_data) const {
+  clexulator::ConfigDoFValues const *dof_values =
+      m_data->formation_energy_clex->get();
   int i = 0;
-  for (Index l : event_data.event.linear_site_index) {
+  for (Index l : linear_site_index) {
     if (dof_values->occupation(l) != prim_event_data.occ_init[i]) {
-      state.is_allowed = false;
-      state.rate = 0.0;
-      return;
+      return false;
     }
     ++i;
   }
-  state.is_allowed = true;
+  return true;
+}
 
+/// \brief Calculate the parts of an allowed event's state selected by
+///     `flags` (see EventUpdateFlags)
+///
+/// This is the single place where the formation energy change and the event
+/// local cluster expansion values are evaluated. Both read the occupation
+/// of overlapping neighborhoods of the event sites from the same
+/// ConfigDoFValues, so they are evaluated back to back, while the
+/// neighborhood is in cache.
+void EventStateCalculator::_calculate_energies(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data, unsigned char flags) const {
   // calculate change in energy to final state
-  state.dE_final = m_formation_energy_clex->occ_delta_value(
-      event_data.event.linear_site_index, prim_event_data.occ_final);
+  if (flags & update_dE_final) {
+    // clexulator::ClusterExpansion takes the sites as std::vector, so they
+    // are copied into a buffer that is reused by each thread
+    thread_local std::vector<Index> sites;
+    sites.assign(linear_site_index.begin(), linear_site_index.end());
+    state.dE_final = m_data->formation_energy_clex->occ_delta_value(
+        sites, prim_event_data.occ_final);
+  }
 
   // calculate KRA and attempt frequency
-  Eigen::VectorXd const &event_values = m_event_clex->values(
-      event_data.unitcell_index, prim_event_data.equivalent_index);
-  state.Ekra = event_values[m_kra_index];
-  state.freq = event_values[m_freq_index];
+  if (flags & update_local_clex) {
+    Eigen::VectorXd const &event_values = m_data->event_clex->values(
+        unitcell_index, prim_event_data.equivalent_index);
+    state.Ekra =
+        (m_data->kra_index >= 0) ? event_values[m_data->kra_index] : 0.0;
+    state.freq = event_values[m_data->freq_index];
+  }
+}
+
+/// \brief Calculate the state of an event, reusing the rate inputs of
+///     events with the same local environment
+///
+/// \param state Stores whether the event is allowed, is "normal",
+///     energy barriers, and event rate
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+/// \param cache Memoized rate inputs, by local environment
+void EventStateCalculator::calculate_event_state(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data, LocalEnvironmentCache &cache) const {
+  if (calculate_rate_inputs(state, unitcell_index, linear_site_index,
+                            prim_event_data, cache)) {
+    set_rate(state);
+  }
+}
+
+/// \brief Calculate whether an event is allowed, and if it is, the change
+///     in energy, KRA, and attempt frequency, reusing those of events with
+///     the same local environment, but not the rate
+///
+/// \param state Sets `is_allowed`. If allowed, sets `dE_final`, `Ekra`, and
+///     `freq`, else sets `rate` to 0.0.
+/// \param unitcell_index Linear unit cell index of the event
+/// \param linear_site_index Linear site indices of the event sites, in the
+///     order of `prim_event_data.sites`
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance, such as the
+///     initial and final occupation variables.
+/// \param cache Memoized rate inputs, by local environment. If the event's
+///     environment is not found, the calculated values are inserted.
+///
+/// \returns `state.is_allowed`
+bool EventStateCalculator::calculate_rate_inputs(
+    EventState &state, Index unitcell_index, EventSites linear_site_index,
+    PrimEventData const &prim_event_data, LocalEnvironmentCache &cache) const {
+  if (!_is_allowed(linear_site_index, prim_event_data)) {
+    state.is_allowed = false;
+    state.rate = 0.0;
+    return false;
+  }
+  state.is_allowed = true;
+  if (cache.find(state, prim_event_data.prim_event_index, unitcell_index,
+                 m_data->formation_energy_clex->get()->occupation)) {
+    return true;
+  }
+  _calculate_energies(state, unitcell_index, linear_site_index,
+                      prim_event_data, update_all);
+  cache.insert(state);
+  return true;
+}
 
-  // calculate energy in activated state, check if "normal", calculate rate
-  state.dE_activated = state.dE_final * 0.5 + state.Ekra;
-  state.is_normal =
-      (state.dE_activated > 0.0) && (state.dE_activated > state.dE_final);
-  if (state.dE_activated < state.dE_final) state.dE_activated = state.dE_final;
-  if (state.dE_activated < 0.0) state.dE_activated = 0.0;
-  state.rate = state.freq * exp(-m_conditions->beta * state.dE_activated);
+/// \brief Set normal / activated energy / rate, given dE_final, Ekra, freq
+///
+/// Uses `calculate_arrhenius_rate` with the barrier model, which evaluates
+/// the rate with `std::exp`. The batched kernel,
+/// `calculate_arrhenius_rates`, is only used by `calculate_rates`.
+void EventStateCalculator::set_rate(EventState &state) const {
+  double beta = m_data->conditions->beta;
+  m_data->barrier_model.visit([&](auto const &model) {
+    calculate_arrhenius_rate(model, state.dE_final, state.Ekra, state.freq,
+                             beta, state.dE_activated, state.is_normal,
+                             state.rate);
+  });
 }
 
+namespace {
+
+/// \brief Return the barrier model for an event type, or the default (KRA
+///     midpoint formula) if not specified
+BarrierModel _get_barrier_model(
+    std::map<std::string, BarrierModel> const &barrier_models,
+    std::string const &event_type_name) {
+  auto it = barrier_models.find(event_type_name);
+  if (it == barrier_models.end()) {
+    return BarrierModel();
+  }
+  return it->second;
+}
+
+}  // namespace
+
 /// \brief Construct a vector EventStateCalculator, one per event in a
 ///     vector of PrimEventData
+///
+/// Prim events of the same type share one calculator (see
+/// `EventStateCalculator::is_shared_with`), which is constructed and set
+/// once, so setup time and memory scale with the number of event types
+/// rather than the number of prim events.
+///
+/// \param system System data
+/// \param state State to calculate
+/// \param prim_event_list Prim events
+/// \param conditions Conditions to calculate
+/// \param barrier_models Barrier models, by event type name. Event types not
+///     included use the KRA midpoint formula.
 std::vector<EventStateCalculator> make_prim_event_calculators(
     std::shared_ptr<system_type> system, state_type const &state,
     std::vector<PrimEventData> const &prim_event_list,
-    std::shared_ptr<Conditions> conditions) {
+    std::shared_ptr<Conditions> conditions,
+    std::map<std::string, BarrierModel> const &barrier_models) {
+  std::map<std::string, EventStateCalculator> by_type;
+  std::vector<EventStateCalculator> prim_event_calculators;
+  for (auto const &prim_event_data : prim_event_list) {
+    std::string const &name = prim_event_data.event_type_name;
+    auto it = by_type.find(name);
+    if (it == by_type.end()) {
+      EventStateCalculator calculator(system, name,
+                                      _get_barrier_model(barrier_models, name));
+      calculator.set(&state, conditions);
+      it = by_type.emplace(name, calculator).first;
+    }
+    prim_event_calculators.push_back(it->second);
+  }
+  return prim_event_calculators;
+}
+
+/// \brief Reset the state of a vector of EventStateCalculator, setting
+///     calculators shared by several prim events once
+///
+/// The result is the same as calling `set(state, conditions)` for each
+/// calculator.
+///
+/// \param prim_event_calculators Calculators to set
+/// \param state State to calculate
+/// \param conditions Conditions to calculate
+void set_prim_event_calculators(
+    std::vector<EventStateCalculator> &prim_event_calculators,
+    state_type const *state, std::shared_ptr<Conditions> conditions) {
+  for (Index i = 0; i < prim_event_calculators.size(); ++i) {
+    bool is_set = false;
+    for (Index j = 0; j < i; ++j) {
+      if (prim_event_calculators[i].is_shared_with(prim_event_calculators[j])) {
+        is_set = true;
+        break;
+      }
+    }
+    if (!is_set) {
+      prim_event_calculators[i].set(state, conditions);
+    }
+  }
+}
+
+/// \brief Construct a vector EventStateCalculator, one per event in a
+///     vector of PrimEventData, which use their own cluster expansion objects
+///
+/// The returned calculators use newly constructed cluster expansion objects,
+/// with copies of the system's clexulators, rather than the
+/// supercell-specific objects shared through the System. Prim events of the
+/// same type share one calculator, as with `make_prim_event_calculators`.
+/// This allows the returned calculators to be used on a different thread
+/// than calculators constructed by `make_prim_event_calculators`.
+///
+/// \param barrier_models Barrier models, by event type name. Event types not
+///     included use the KRA midpoint formula.
+std::vector<EventStateCalculator> make_independent_prim_event_calculators(
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::vector<PrimEventData> const &prim_event_list,
+    std::shared_ptr<Conditions> conditions,
+    std::map<std::string, BarrierModel> const &barrier_models) {
+  auto formation_energy_clex =
+      make_independent_clex(*system, state, "formation_energy");
+
+  std::map<std::string, EventStateCalculator> by_type;
   std::vector<EventStateCalculator> prim_event_calculators;
   for (auto const &prim_event_data : prim_event_list) {
-    prim_event_calculators.emplace_back(system,
-                                        prim_event_data.event_type_name);
-    prim_event_calculators.back().set(&state, conditions);
+    std::string const &name = prim_event_data.event_type_name;
+    auto it = by_type.find(name);
+    if (it == by_type.end()) {
+      EventStateCalculator calculator(system, name,
+                                      _get_barrier_model(barrier_models, name));
+      auto event_clex = make_independent_local_multiclex(
+          *system, state, name, calculator.event_clex_coefficient_names());
+      calculator.set(&state, conditions, formation_energy_clex, event_clex);
+      it = by_type.emplace(name, calculator).first;
+    }
+    prim_event_calculators.push_back(it->second);
   }
   return prim_event_calculators;
 }
@@ -128,7 +732,7 @@ std::vector<EventStateCalculator> make_prim_event_calculators(
 CompleteEventCalculator::CompleteEventCalculator(
     std::vector<PrimEventData> const &_prim_event_list,
     std::vector<EventStateCalculator> const &_prim_event_calculators,
-    std::map<EventID, EventData> const &_event_list, Log &_event_log)
+    EventDataList const &_event_list, Log &_event_log)
     : prim_event_list(_prim_event_list),
       prim_event_calculators(_prim_event_calculators),
       event_list(_event_list),
@@ -136,28 +740,265 @@ CompleteEventCalculator::CompleteEventCalculator(
       not_normal_count(0) {}
 
 /// \brief Get CASM::monte::OccEvent corresponding to given event ID
+///
+/// Notes:
+/// - If `event_list` stores event sites in structure-of-arrays layout, the
+///   event sites are read from there rather than from the event's
+///   monte::OccEvent
+/// - If `event_list` does not store EventData, only the event sites are
+///   constructed on demand
 double CompleteEventCalculator::calculate_rate(EventID const &id) {
-  EventData const &event_data = event_list.at(id);
-  PrimEventData const &prim_event_data =
-      prim_event_list.at(id.prim_event_index);
-  // Note: to keep all event state calculations, uncomment this:
-  // EventState &event_state = event_data.event_state;
-  prim_event_calculators.at(id.prim_event_index)
-      .calculate_event_state(event_state, event_data, prim_event_data);
+  return _calculate_rate(id, prim_event_list.at(id.prim_event_index),
+                         prim_event_calculators.at(id.prim_event_index));
+}
+
+/// \brief Calculate the rates of a batch of events
+///
+/// Events are grouped by prim_event_index and calculated one group at a
+/// time, so each group is evaluated in one loop using the same
+/// PrimEventData, EventStateCalculator, and local clexulator. Then the
+/// rates of the allowed events of the group are calculated together with
+/// `calculate_arrhenius_rates`. The results are the same as calling
+/// `calculate_rate` for each event, to within a relative error of 1e-15
+/// (see `vectorizable_exp`).
+///
+/// \param event_id_list Events to calculate
+/// \param rates Set to the event rates, with `rates[i]` being the rate of
+///     `event_id_list[i]`
+void CompleteEventCalculator::calculate_rates(
+    std::vector<EventID> const &event_id_list, std::vector<double> &rates) {
+  Index n_prim_events = prim_event_list.size();
+  Index n_events = event_id_list.size();
+  rates.resize(n_events);
+
+  // counting sort of event_id_list by prim_event_index
+  batch_offsets.assign(n_prim_events + 1, 0);
+  for (EventID const &id : event_id_list) {
+    if (id.prim_event_index < 0 || id.prim_event_index >= n_prim_events) {
+      throw std::out_of_range(
+          "Error in CompleteEventCalculator::calculate_rates: "
+          "prim_event_index out of range");
+    }
+    ++batch_offsets[id.prim_event_index + 1];
+  }
+  for (Index p = 0; p < n_prim_events; ++p) {
+    batch_offsets[p + 1] += batch_offsets[p];
+  }
+  batch_order.resize(n_events);
+  for (Index i = 0; i < n_events; ++i) {
+    batch_order[batch_offsets[event_id_list[i].prim_event_index]++] = i;
+  }
+  // batch_offsets[p] is now the end of group p, shift back to the beginning
+  for (Index p = n_prim_events; p > 0; --p) {
+    batch_offsets[p] = batch_offsets[p - 1];
+  }
+  batch_offsets[0] = 0;
+
+  for (Index p = 0; p < n_prim_events; ++p) {
+    PrimEventData const &prim_event_data = prim_event_list[p];
+    EventStateCalculator const &prim_event_calculator =
+        prim_event_calculators[p];
+
+    // calculate dE_final, Ekra, freq of allowed events
+    rate_batch.clear();
+    batch_allowed.clear();
+    for (Index k = batch_offsets[p]; k < batch_offsets[p + 1]; ++k) {
+      Index i = batch_order[k];
+      EventID const &id = event_id_list[i];
+      if (_calculate_rate_inputs(id, prim_event_data, prim_event_calculator)) {
+        rate_batch.push_back(event_state.dE_final, event_state.Ekra,
+                             event_state.freq);
+        batch_allowed.push_back(i);
+      } else {
+        rates[i] = event_state.rate;
+        _finish_event_state(id, prim_event_data);
+      }
+    }
+
+    // calculate rates of allowed events together
+    rate_batch.calculate(prim_event_calculator.barrier_model(),
+                         prim_event_calculator.conditions()->beta);
+    for (Index j = 0; j < batch_allowed.size(); ++j) {
+      Index i = batch_allowed[j];
+      event_state.is_allowed = true;
+      event_state.is_normal = rate_batch.is_normal[j];
+      event_state.dE_final = rate_batch.dE_final[j];
+      event_state.Ekra = rate_batch.Ekra[j];
+      event_state.dE_activated = rate_batch.dE_activated[j];
+      event_state.freq = rate_batch.freq[j];
+      event_state.rate = rate_batch.rate[j];
+      rates[i] = event_state.rate;
+      _finish_event_state(event_id_list[i], prim_event_data);
+    }
+  }
+}
+
+/// \brief Notify that an event occurred, before the rates of impacted
+///     events are recalculated
+///
+/// If `event_state_cache` is not null, this marks the parts of the impacted
+/// event states that must be recalculated. If `active_event_set` is not
+/// null, this updates which events are active.
+void CompleteEventCalculator::set_occurred_event(EventID const &id) {
+  if (event_state_cache) {
+    event_state_cache->set_occurred(id);
+  }
+  if (active_event_set) {
+    active_event_set->set_occurred(id);
+  }
+}
+
+double CompleteEventCalculator::_calculate_rate(
+    EventID const &id, PrimEventData const &prim_event_data,
+    EventStateCalculator const &prim_event_calculator) {
+  if (_calculate_rate_inputs(id, prim_event_data, prim_event_calculator)) {
+    prim_event_calculator.set_rate(event_state);
+  }
+  _finish_event_state(id, prim_event_data);
+  return event_state.rate;
+}
+
+/// \brief Set `event_state`, except the rate and activation energy of
+///     allowed events
+///
+/// \returns `event_state.is_allowed`
+bool CompleteEventCalculator::_calculate_rate_inputs(
+    EventID const &id, PrimEventData const &prim_event_data,
+    EventStateCalculator const &prim_event_calculator) {
+  if (active_event_set &&
+      !active_event_set->is_active(event_list.linear_index(id))) {
+    event_state.is_allowed = false;
+    event_state.rate = 0.0;
+    if (event_state_cache) {
+      event_state_cache->update_flags[event_list.linear_index(id)] =
+          update_all;
+    }
+    return false;
+  }
+
+  EventSites event_sites = event_list.event_sites(id, linear_site_index);
+
+  if (event_state_cache) {
+    return prim_event_calculator.calculate_rate_inputs(
+        event_state, id.unitcell_index, event_sites, prim_event_data,
+        *event_state_cache, event_list.linear_index(id));
+  }
+  if (local_environment_cache) {
+    return prim_event_calculator.calculate_rate_inputs(
+        event_state, id.unitcell_index, event_sites, prim_event_data,
+        *local_environment_cache);
+  }
+  return prim_event_calculator.calculate_rate_inputs(
+      event_state, id.unitcell_index, event_sites, prim_event_data);
+}
+
+/// \brief Store the completed `event_state`, and handle non-normal events
+void CompleteEventCalculator::_finish_event_state(
+    EventID const &id, PrimEventData const &prim_event_data) {
+  if (event_state_store) {
+    event_state_store->set(event_list.linear_index(id), event_state);
+  }
+  if (event_rate_totals) {
+    event_rate_totals->set(event_list.linear_index(id), event_state.rate);
+  }
 
   // ---
   // can check event state and handle non-normal event states here
   // ---
   if (event_state.is_allowed && !event_state.is_normal) {
+    ++not_normal_count;
+    if (!non_normal_event_log ||
+        non_normal_event_log->count(id.prim_event_index)) {
+      _write_not_normal(id, event_list.event_sites(id, linear_site_index),
+                        prim_event_data);
+    }
+  }
+}
+
+namespace {
+
+/// \brief Write a non-normal event state
+///
+/// Writes to `non_normal_event_log` if not null, else to `event_log`.
+void _write_not_normal_event_state(
+    std::shared_ptr<NonNormalEventLog> const &non_normal_event_log,
+    Log &event_log, EventState const &event_state, EventID const &id,
+    EventSites event_sites, PrimEventData const &prim_event_data) {
+  if (!non_normal_event_log) {
     event_log << "---" << std::endl;
-    print(event_log.ostream(), event_state, event_data, prim_event_data);
+    print(event_log.ostream(), event_state, id.unitcell_index, event_sites,
+          prim_event_data);
     event_log << std::endl;
-    ++not_normal_count;
+    return;
   }
+  std::stringstream ss;
+  ss << "---" << std::endl;
+  print(ss, event_state, id.unitcell_index, event_sites, prim_event_data);
+  ss << std::endl;
+  non_normal_event_log->write(ss.str());
+}
 
+}  // namespace
+
+/// \brief Write the current non-normal `event_state`
+///
+/// Writes to `non_normal_event_log` if not null, else to `event_log`.
+void CompleteEventCalculator::_write_not_normal(
+    EventID const &id, EventSites event_sites,
+    PrimEventData const &prim_event_data) {
+  _write_not_normal_event_state(non_normal_event_log, event_log, event_state,
+                                id, event_sites, prim_event_data);
+}
+
+// OnDemandEventCalculator
+
+OnDemandEventCalculator::OnDemandEventCalculator(
+    std::vector<PrimEventData> const &_prim_event_list,
+    std::vector<EventStateCalculator> const &_prim_event_calculators,
+    monte::OccLocation const &_occ_location, Log &_event_log)
+    : prim_event_list(_prim_event_list),
+      prim_event_calculators(_prim_event_calculators),
+      event_builder(_prim_event_list, _occ_location),
+      event_log(_event_log),
+      not_normal_count(0) {}
+
+/// \brief Calculate the rate of an event
+///
+/// Event sites are constructed from the event translation. Events that are
+/// not allowed by the current occupation have rate 0.0.
+double OnDemandEventCalculator::calculate_rate(EventID const &id) {
+  PrimEventData const &prim_event_data =
+      prim_event_list.at(id.prim_event_index);
+  event_builder.set_linear_site_index(linear_site_index, id);
+  prim_event_calculators.at(id.prim_event_index)
+      .calculate_event_state(event_state, id.unitcell_index,
+                             linear_site_index, prim_event_data);
+
+  if (event_state.is_allowed && !event_state.is_normal) {
+    ++not_normal_count;
+    if (!non_normal_event_log ||
+        non_normal_event_log->count(id.prim_event_index)) {
+      _write_not_normal_event_state(non_normal_event_log, event_log,
+                                    event_state, id, linear_site_index,
+                                    prim_event_data);
+    }
+  }
   return event_state.rate;
 }
 
+/// \brief Calculate the rates of a batch of events
+///
+/// \param event_id_list Events to calculate
+/// \param rates Set to the event rates, with `rates[i]` being the rate of
+///     `event_id_list[i]`
+void OnDemandEventCalculator::calculate_rates(
+    std::vector<EventID> const &event_id_list, std::vector<double> &rates) {
+  rates.resize(event_id_list.size());
+  for (Index i = 0; i < event_id_list.size(); ++i) {
+    rates[i] = calculate_rate(event_id_list[i]);
+  }
+}
+
 KineticEventData::KineticEventData(std::shared_ptr<system_type> _system)
     : system(_system) {
   if (!is_clex_data(*system, "formation_energy")) {
@@ -165,8 +1006,13 @@ KineticEventData::KineticEventData(std::shared_ptr<system_type> _system)
         "Error constructing KineticEventData: no 'formation_energy' clex.");
   }
 
+  PhaseTimer prim_event_list_timer(system->startup_timings, "prim_event_list");
   prim_event_list = clexmonte::make_prim_event_list(*system);
-  prim_impact_info_list = clexmonte::make_prim_impact_info_list(
+  prim_event_list_timer.stop();
+
+  PhaseTimer prim_impact_info_list_timer(system->startup_timings,
+                                         "prim_impact_info_list");
+  prim_impact_info_list = clexmonte::load_or_make_prim_impact_info_list(
       *system, prim_event_list, {"formation_energy"});
 }
 
@@ -181,16 +1027,672 @@ void KineticEventData::update(
   // These are constructed/re-constructed so cluster expansions point
   // at the current state
   prim_event_calculators = clexmonte::kinetic::make_prim_event_calculators(
-      system, state, prim_event_list, conditions);
+      system, state, prim_event_list, conditions, barrier_models);
 
-  // TODO: rejection-clexmonte option does not require impact table
-  event_list = clexmonte::make_complete_event_list(
-      prim_event_list, prim_impact_info_list, occ_location, event_filters);
+  // Rejection KMC only calculates the rates of proposed events, so the
+  // supercell impact table is not constructed
+  on_demand_event_calculator.reset();
+  if (on_demand_events) {
+    event_list = clexmonte::CompleteEventList();
+    on_demand_event_calculator = std::make_shared<OnDemandEventCalculator>(
+        prim_event_list, prim_event_calculators, occ_location);
+  } else {
+    CompleteEventListParams list_params = event_list_params;
+    if (!require_impact_table) {
+      list_params.impact_table_type = ImpactTableType::relative;
+    }
+    PhaseTimer timer(system->startup_timings, "complete_event_list");
+    event_list = clexmonte::make_complete_event_list(
+        prim_event_list, prim_impact_info_list, occ_location, event_filters,
+        list_params);
+  }
+  possible_prim_events.assign(prim_event_list.size(), true);
+  if (event_list_params.skip_impossible_events) {
+    possible_prim_events =
+        find_possible_prim_events(prim_event_list, occ_location);
+  }
 
   // Construct CompleteEventCalculator
   event_calculator =
       std::make_shared<clexmonte::kinetic::CompleteEventCalculator>(
           prim_event_list, prim_event_calculators, event_list.events);
+
+  // Construct EventStateCache
+  event_state_cache.reset();
+  if (split_impact_neighborhoods) {
+    event_state_cache = std::make_shared<EventStateCache>(
+        prim_impact_info_list,
+        occ_location.convert().unitcell_index_converter());
+    event_calculator->event_state_cache = event_state_cache;
+  }
+
+  // Construct EventStateStore
+  event_state_store.reset();
+  if (store_event_states) {
+    event_state_store = std::make_shared<EventStateStore>(
+        event_list.events.n_slots(), max_full_event_states);
+    event_calculator->event_state_store = event_state_store;
+  }
+
+  // Construct EventRateTotals
+  event_rate_totals.reset();
+  if (!on_demand_events) {
+    event_rate_totals = std::make_shared<EventRateTotals>(
+        event_list.events.n_slots(), prim_event_list.size());
+    event_calculator->event_rate_totals = event_rate_totals;
+  }
+
+  // Construct LocalEnvironmentCache
+  local_environment_cache.reset();
+  if (local_environment_cache_size > 0 && !on_demand_events) {
+    local_environment_cache = std::make_shared<LocalEnvironmentCache>(
+        prim_impact_info_list, occ_location.convert().index_converter(),
+        occ_location.convert().unitcell_index_converter(),
+        local_environment_cache_size);
+    event_calculator->local_environment_cache = local_environment_cache;
+  }
+
+  // Construct ActiveEventSet
+  active_event_set.reset();
+  if (use_active_event_set) {
+    active_event_set = std::make_shared<ActiveEventSet>(
+        prim_event_list, event_list.events, get_occupation(state));
+    event_calculator->active_event_set = active_event_set;
+  }
+
+  // Construct NonNormalEventLog
+  non_normal_event_log.reset();
+  if (max_non_normal_examples >= 0 || async_event_log) {
+    non_normal_event_log = std::make_shared<NonNormalEventLog>(
+        prim_event_list.size(), max_non_normal_examples,
+        event_calculator->event_log.ostream(), async_event_log);
+    event_calculator->non_normal_event_log = non_normal_event_log;
+    if (on_demand_event_calculator) {
+      on_demand_event_calculator->non_normal_event_log = non_normal_event_log;
+    }
+  }
+
+  update_parallel_event_calculator(state, conditions);
+}
+
+/// \brief Construct `parallel_event_calculator` for the current state
+///
+/// If `n_threads > 1`, constructs `parallel_event_calculator` using
+/// `event_calculator` for the calling thread, else sets it to nullptr. This
+/// must be called after `update` and whenever `prim_event_calculators` are
+/// re-set to a different state or conditions.
+void KineticEventData::update_parallel_event_calculator(
+    state_type const &state, std::shared_ptr<Conditions> conditions) {
+  // Destroy the existing worker threads before constructing new ones
+  parallel_event_calculator.reset();
+  if (n_threads > 1) {
+    parallel_event_calculator =
+        std::make_shared<ParallelCompleteEventCalculator>(
+            event_calculator, system, state, conditions, n_threads);
+  }
+}
+
+namespace {
+
+/// \brief Approximate memory used by `event_state_cache`,
+///     `event_state_store`, and `event_rate_totals`, in bytes
+std::size_t approximate_event_states_memory_usage(
+    KineticEventData const &event_data) {
+  auto const &event_state_cache = event_data.event_state_cache;
+  auto const &event_rate_totals = event_data.event_rate_totals;
+  auto const &event_state_store = event_data.event_state_store;
+  std::size_t bytes = 0;
+  if (event_state_cache) {
+    bytes += event_state_cache->update_flags.size() *
+             (3 * sizeof(double) + sizeof(unsigned char));
+  }
+  if (event_rate_totals) {
+    bytes += event_rate_totals->size() * sizeof(double);
+  }
+  if (event_state_store) {
+    std::size_t n = event_state_store->size();
+    bytes += n * 3;  // is_calculated, is_allowed, is_normal flags
+    if (event_state_store->is_full()) {
+      bytes += n * sizeof(EventState);
+    } else {
+      bytes += n * 2 * sizeof(float);
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+/// \brief Approximate memory used by supercell-specific data, in bytes
+///
+/// Includes `event_list`, `event_state_cache`, `event_state_store`, and
+/// `event_rate_totals`, which are the parts that scale with the number of
+/// events.
+std::size_t KineticEventData::approximate_memory_usage() const {
+  return clexmonte::approximate_memory_usage(event_list) +
+         approximate_event_states_memory_usage(*this);
+}
+
+/// \brief Add the approximate memory used by the events, impact table,
+///     event states, and calculators to a memory report
+///
+/// Adds subsystems "kmc_events", "kmc_impact_table", "kmc_event_states"
+/// (`event_state_cache`, `event_state_store`, and `event_rate_totals`), and
+/// "kmc_event_calculators" (`local_environment_cache` and the worker
+/// threads of `parallel_event_calculator`).
+void KineticEventData::add_memory_usage(MemoryReport &report) const {
+  report.add("kmc_events",
+             clexmonte::approximate_events_memory_usage(event_list));
+  report.add("kmc_impact_table",
+             clexmonte::approximate_impact_table_memory_usage(event_list));
+  report.add("kmc_event_states", approximate_event_states_memory_usage(*this));
+
+  // approximate size of an unordered_map node with a short string key
+  std::size_t const cache_node_overhead = 8 * sizeof(void *);
+  std::size_t cache_bytes = 0;
+  if (local_environment_cache) {
+    cache_bytes = local_environment_cache->size() *
+                  (cache_node_overhead + 3 * sizeof(double));
+  }
+  std::size_t bytes = cache_bytes;
+  if (parallel_event_calculator) {
+    // each worker thread has its own copy of the prim event calculators and
+    // its own cache, assumed to be about as full as `local_environment_cache`
+    std::size_t n_workers = parallel_event_calculator->n_threads() - 1;
+    bytes += n_workers * (prim_event_calculators.size() *
+                              sizeof(EventStateCalculator) +
+                          cache_bytes);
+  }
+  report.add("kmc_event_calculators", bytes);
+}
+
+/// \brief Construct KineticEventData with the same options, but no
+///     supercell-specific data
+///
+/// Copies the system, prim events, and all options, but not the event list
+/// or calculators. `KineticEventData::update` must be called before use.
+std::shared_ptr<KineticEventData> make_event_data_with_same_options(
+    KineticEventData const &event_data) {
+  auto result = std::make_shared<KineticEventData>(event_data.system);
+  result->event_list_params = event_data.event_list_params;
+  result->n_threads = event_data.n_threads;
+  result->split_impact_neighborhoods = event_data.split_impact_neighborhoods;
+  result->store_event_states = event_data.store_event_states;
+  result->max_full_event_states = event_data.max_full_event_states;
+  result->local_environment_cache_size =
+      event_data.local_environment_cache_size;
+  result->use_active_event_set = event_data.use_active_event_set;
+  result->max_non_normal_examples = event_data.max_non_normal_examples;
+  result->async_event_log = event_data.async_event_log;
+  result->on_demand_events = event_data.on_demand_events;
+  result->require_impact_table = event_data.require_impact_table;
+  result->barrier_models = event_data.barrier_models;
+  return result;
+}
+
+namespace {
+
+/// \brief Linear indices of the included events, in increasing order
+std::vector<Index> included_linear_indices(EventDataList const &events) {
+  std::vector<Index> result;
+  result.reserve(events.size());
+  for (Index l = 0; l < events.n_slots(); ++l) {
+    if (events.is_included(l)) {
+      result.push_back(l);
+    }
+  }
+  return result;
+}
+
+void throw_if_no_event_list(KineticEventData const &event_data,
+                            std::string const &where) {
+  if (event_data.on_demand_events) {
+    throw std::runtime_error("Error in " + where +
+                             ": the complete event list is not constructed "
+                             "with the \"defect\" event selector");
+  }
+}
+
+}  // namespace
+
+/// \brief Make the complete event list arrays
+///
+/// \param event_data KMC event data, updated for a supercell
+///
+/// \returns The linear index, prim event index, unit cell index, and
+///     linear site indices of every event in the complete event list
+EventListArrays make_event_list_arrays(KineticEventData const &event_data) {
+  throw_if_no_event_list(event_data, "make_event_list_arrays");
+  EventDataList const &events = event_data.event_list.events;
+  std::vector<Index> linear_indices = included_linear_indices(events);
+  Index n_events = linear_indices.size();
+  Index n_prim_events = events.n_prim_events();
+
+  Index max_n_sites = 0;
+  for (auto const &prim_event_data : event_data.prim_event_list) {
+    max_n_sites =
+        std::max(max_n_sites, Index(prim_event_data.sites.size()));
+  }
+
+  EventListArrays arrays;
+  arrays.linear_index.resize(n_events);
+  arrays.prim_event_index.resize(n_events);
+  arrays.unitcell_index.resize(n_events);
+  arrays.linear_site_index.setConstant(n_events, max_n_sites, -1);
+  std::vector<Index> scratch;
+  for (Index i = 0; i < n_events; ++i) {
+    Index l = linear_indices[i];
+    EventID id = events.event_id(l);
+    arrays.linear_index(i) = l;
+    arrays.prim_event_index(i) = l % n_prim_events;
+    arrays.unitcell_index(i) = l / n_prim_events;
+    EventSites sites = events.event_sites(id, scratch);
+    for (Index j = 0; j < Index(sites.size()); ++j) {
+      arrays.linear_site_index(i, j) = sites[j];
+    }
+  }
+  return arrays;
+}
+
+/// \brief Make the stored event state arrays
+///
+/// \param event_data KMC event data, updated for a supercell, with
+///     `store_event_states` true
+///
+/// \returns The most recently calculated state of every event in the
+///     complete event list, in the order of `make_event_list_arrays`
+EventStateArrays make_event_state_arrays(KineticEventData const &event_data) {
+  throw_if_no_event_list(event_data, "make_event_state_arrays");
+  if (!event_data.event_state_store) {
+    throw std::runtime_error(
+        "Error in make_event_state_arrays: event states are not stored; use "
+        "the KMC option \"store_event_states\"");
+  }
+  EventStateStore const &store = *event_data.event_state_store;
+  std::vector<Index> linear_indices =
+      included_linear_indices(event_data.event_list.events);
+  Index n_events = linear_indices.size();
+
+  EventStateArrays arrays;
+  arrays.is_calculated.resize(n_events);
+  arrays.is_allowed.resize(n_events);
+  arrays.is_normal.resize(n_events);
+  arrays.dE_activated.resize(n_events);
+  arrays.rate.resize(n_events);
+  if (store.is_full()) {
+    arrays.dE_final.resize(n_events);
+    arrays.Ekra.resize(n_events);
+    arrays.freq.resize(n_events);
+  }
+  for (Index i = 0; i < n_events; ++i) {
+    Index l = linear_indices[i];
+    bool is_calculated = store.is_calculated(l);
+    arrays.is_calculated(i) = is_calculated;
+    arrays.is_allowed(i) = is_calculated && store.is_allowed(l);
+    arrays.is_normal(i) = is_calculated && store.is_normal(l);
+    arrays.dE_activated(i) = is_calculated ? store.dE_activated(l) : 0.0;
+    arrays.rate(i) = is_calculated ? store.rate(l) : 0.0;
+    if (store.is_full()) {
+      EventState const &event_state = store.event_state(l);
+      arrays.dE_final(i) = is_calculated ? event_state.dE_final : 0.0;
+      arrays.Ekra(i) = is_calculated ? event_state.Ekra : 0.0;
+      arrays.freq(i) = is_calculated ? event_state.freq : 0.0;
+    }
+  }
+  return arrays;
+}
+
+/// \brief Calculate the current rate of every event in the complete event
+///     list
+///
+/// Rates are calculated by the event calculator of the last run, for the
+/// current occupation of the state and the conditions of that run. Cached
+/// event state parts and the active event set are reset first, so the
+/// occupation may have been changed since the run. Stored event states and
+/// rate totals are updated.
+///
+/// \param event_data KMC event data, updated for a supercell
+///
+/// \returns The rate of every event, in the order of
+///     `make_event_list_arrays`
+Eigen::VectorXd calculate_event_list_rates(KineticEventData &event_data) {
+  throw_if_no_event_list(event_data, "calculate_event_list_rates");
+  if (!event_data.event_calculator) {
+    throw std::runtime_error(
+        "Error in calculate_event_list_rates: no event calculator; perform a "
+        "run first");
+  }
+  if (event_data.event_state_cache) {
+    event_data.event_state_cache->invalidate();
+  }
+  if (event_data.active_event_set) {
+    event_data.active_event_set->reset();
+  }
+
+  EventDataList const &events = event_data.event_list.events;
+  std::vector<EventID> event_id_list;
+  event_id_list.reserve(events.size());
+  for (Index l : included_linear_indices(events)) {
+    event_id_list.push_back(events.event_id(l));
+  }
+
+  std::vector<double> rates;
+  if (event_data.parallel_event_calculator) {
+    event_data.parallel_event_calculator->calculate_rates(event_id_list,
+                                                          rates);
+  } else {
+    event_data.event_calculator->calculate_rates(event_id_list, rates);
+  }
+  return Eigen::Map<Eigen::VectorXd>(rates.data(), rates.size());
+}
+
+// KineticEventDataCache
+
+/// \brief Set the maximum memory, removing entries if necessary
+void KineticEventDataCache::set_max_bytes(std::size_t _max_bytes) {
+  m_max_bytes = _max_bytes;
+  _evict();
+}
+
+/// \brief Remove and return the event data for a supercell, or nullptr if
+///     not cached
+std::shared_ptr<KineticEventData> KineticEventDataCache::take(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  auto it = m_entries.find(transformation_matrix_to_super);
+  if (it == m_entries.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<KineticEventData> event_data = it->second.event_data;
+  m_bytes -= it->second.bytes;
+  m_entries.erase(it);
+  return event_data;
+}
+
+/// \brief Insert event data for a supercell, then remove the least
+///     recently used entries until within `max_bytes`
+///
+/// The memory used is estimated once, on insertion. If an entry for the
+/// supercell exists, it is replaced.
+void KineticEventDataCache::insert(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    std::shared_ptr<KineticEventData> event_data) {
+  take(transformation_matrix_to_super);
+  if (!event_data) {
+    return;
+  }
+  Entry entry;
+  entry.bytes = event_data->approximate_memory_usage();
+  entry.event_data = std::move(event_data);
+  entry.last_used = m_counter++;
+  m_bytes += entry.bytes;
+  m_entries.emplace(transformation_matrix_to_super, std::move(entry));
+  _evict();
+}
+
+/// \brief Remove all entries
+void KineticEventDataCache::clear() {
+  m_entries.clear();
+  m_bytes = 0;
+}
+
+/// \brief Remove least recently used entries until within `max_bytes`
+void KineticEventDataCache::_evict() {
+  while (!m_entries.empty() &&
+         (m_max_bytes == 0 || m_bytes > m_max_bytes)) {
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+      if (it->second.last_used < oldest->second.last_used) {
+        oldest = it;
+      }
+    }
+    m_bytes -= oldest->second.bytes;
+    m_entries.erase(oldest);
+  }
+}
+
+// ParallelCompleteEventCalculator
+
+ParallelCompleteEventCalculator::Worker::Worker(
+    std::vector<EventStateCalculator> _prim_event_calculators,
+    CompleteEventCalculator const &main_calculator)
+    : prim_event_calculators(std::move(_prim_event_calculators)),
+      log(log_stream),
+      calculator(main_calculator.prim_event_list, prim_event_calculators,
+                 main_calculator.event_list, log) {
+  calculator.event_state_cache = main_calculator.event_state_cache;
+  calculator.event_state_store = main_calculator.event_state_store;
+  calculator.non_normal_event_log = main_calculator.non_normal_event_log;
+  calculator.active_event_set = main_calculator.active_event_set;
+  if (main_calculator.local_environment_cache) {
+    calculator.local_environment_cache =
+        main_calculator.local_environment_cache->make_empty_copy();
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _calculator Calculator used on the calling thread
+/// \param _system System data
+/// \param _state State being calculated
+/// \param _conditions Conditions being calculated
+/// \param _n_threads Total number of threads, including the calling thread
+/// \param _min_batch_size Batches smaller than this are calculated serially
+///     on the calling thread
+ParallelCompleteEventCalculator::ParallelCompleteEventCalculator(
+    std::shared_ptr<CompleteEventCalculator> _calculator,
+    std::shared_ptr<system_type> _system, state_type const &_state,
+    std::shared_ptr<Conditions> _conditions, Index _n_threads,
+    Index _min_batch_size)
+    : m_calculator(_calculator),
+      m_min_batch_size(_min_batch_size),
+      m_generation(0),
+      m_n_pending(0),
+      m_stop(false),
+      m_event_id_list(nullptr),
+      m_rates(nullptr),
+      m_n_chunks(0) {
+  if (m_calculator == nullptr) {
+    throw std::runtime_error(
+        "Error constructing ParallelCompleteEventCalculator: calculator is "
+        "empty");
+  }
+  if (_n_threads < 1) {
+    throw std::runtime_error(
+        "Error constructing ParallelCompleteEventCalculator: n_threads < 1");
+  }
+  // worker calculators use the same barrier models
+  std::map<std::string, BarrierModel> barrier_models;
+  for (Index p = 0; p < m_calculator->prim_event_list.size(); ++p) {
+    barrier_models[m_calculator->prim_event_list[p].event_type_name] =
+        m_calculator->prim_event_calculators[p].barrier_model();
+  }
+  for (Index i = 1; i < _n_threads; ++i) {
+    m_workers.push_back(std::make_unique<Worker>(
+        make_independent_prim_event_calculators(
+            _system, _state, m_calculator->prim_event_list, _conditions,
+            barrier_models),
+        *m_calculator));
+  }
+  for (Index i = 0; i < m_workers.size(); ++i) {
+    m_threads.emplace_back(&ParallelCompleteEventCalculator::_run_worker, this,
+                           i);
+  }
+}
+
+ParallelCompleteEventCalculator::~ParallelCompleteEventCalculator() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start_cv.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/// \brief Calculate the rate of a single event, on the calling thread
+double ParallelCompleteEventCalculator::calculate_rate(EventID const &id) {
+  return m_calculator->calculate_rate(id);
+}
+
+/// \brief Notify that an event occurred, before the rates of impacted
+///     events are recalculated
+///
+/// Workers share the `event_state_cache` of the main calculator, so only the
+/// main calculator is notified.
+void ParallelCompleteEventCalculator::set_occurred_event(EventID const &id) {
+  m_calculator->set_occurred_event(id);
+}
+
+/// \brief Calculate the rates of a batch of events
+///
+/// \param event_id_list Events to calculate
+/// \param rates Set to the event rates, with `rates[i]` being the rate of
+///     `event_id_list[i]`
+void ParallelCompleteEventCalculator::calculate_rates(
+    std::vector<EventID> const &event_id_list, std::vector<double> &rates) {
+  if (m_workers.empty() || event_id_list.size() < m_min_batch_size) {
+    m_calculator->calculate_rates(event_id_list, rates);
+    return;
+  }
+  rates.resize(event_id_list.size());
+
+  // start workers on chunks 1, 2, ...
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_event_id_list = &event_id_list;
+    m_rates = rates.data();
+    m_n_chunks = m_workers.size() + 1;
+    m_n_pending = m_workers.size();
+    ++m_generation;
+  }
+  m_start_cv.notify_all();
+
+  // calculate chunk 0 on the calling thread
+  _calculate_chunk(*m_calculator, 0);
+
+  // wait for workers
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [&] { return m_n_pending == 0; });
+    m_event_id_list = nullptr;
+    m_rates = nullptr;
+  }
+
+  // worker calculators do not share `event_rate_totals`, so it is updated
+  // here, on the calling thread
+  auto const &event_rate_totals = m_calculator->event_rate_totals;
+  if (event_rate_totals) {
+    EventDataList const &event_list = m_calculator->event_list;
+    Index n_events = event_id_list.size();
+    Index end = n_events / m_n_chunks;
+    for (Index i = end; i < n_events; ++i) {
+      event_rate_totals->set(event_list.linear_index(event_id_list[i]),
+                             rates[i]);
+    }
+  }
+
+  // merge worker logs, in chunk order
+  for (auto &worker : m_workers) {
+    if (worker->calculator.not_normal_count) {
+      m_calculator->not_normal_count += worker->calculator.not_normal_count;
+      worker->calculator.not_normal_count = 0;
+      m_calculator->event_log.ostream() << worker->log_stream.str();
+      worker->log_stream.str("");
+    }
+  }
+}
+
+/// \brief Local environment caches of the worker calculators, if any
+std::vector<std::shared_ptr<LocalEnvironmentCache const>>
+ParallelCompleteEventCalculator::worker_local_environment_caches() const {
+  std::vector<std::shared_ptr<LocalEnvironmentCache const>> result;
+  for (auto const &worker : m_workers) {
+    if (worker->calculator.local_environment_cache) {
+      result.push_back(worker->calculator.local_environment_cache);
+    }
+  }
+  return result;
+}
+
+void ParallelCompleteEventCalculator::_run_worker(Index worker_index) {
+  Index generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start_cv.wait(lock,
+                      [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    _calculate_chunk(m_workers[worker_index]->calculator, worker_index + 1);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_n_pending;
+    }
+    m_done_cv.notify_one();
+  }
+}
+
+/// \brief Calculate rates for one contiguous chunk of the current batch
+void ParallelCompleteEventCalculator::_calculate_chunk(
+    CompleteEventCalculator &calculator, Index chunk_index) const {
+  std::vector<EventID> const &event_id_list = *m_event_id_list;
+  Index n_events = event_id_list.size();
+  Index begin = (n_events * chunk_index) / m_n_chunks;
+  Index end = (n_events * (chunk_index + 1)) / m_n_chunks;
+  for (Index i = begin; i < end; ++i) {
+    m_rates[i] = calculator.calculate_rate(event_id_list[i]);
+  }
+}
+
+// IndependentEventCalculator
+
+IndependentEventCalculator::IndependentEventCalculator(
+    std::vector<EventStateCalculator> _prim_event_calculators,
+    CompleteEventCalculator const &main_calculator)
+    : prim_event_calculators(std::move(_prim_event_calculators)),
+      log(log_stream),
+      calculator(main_calculator.prim_event_list, prim_event_calculators,
+                 main_calculator.event_list, log) {
+  calculator.non_normal_event_log = main_calculator.non_normal_event_log;
+}
+
+/// \brief Construct independent event calculators, one per thread
+///
+/// \param main_calculator Calculator whose prim events, event list, and
+///     barrier models are used
+/// \param system System data
+/// \param state State being calculated
+/// \param conditions Conditions being calculated
+/// \param n_threads Number of calculators to construct
+std::vector<std::shared_ptr<IndependentEventCalculator>>
+make_independent_event_calculators(
+    CompleteEventCalculator const &main_calculator,
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::shared_ptr<Conditions> conditions, Index n_threads) {
+  if (n_threads < 1) {
+    throw std::runtime_error(
+        "Error in make_independent_event_calculators: n_threads < 1");
+  }
+  std::map<std::string, BarrierModel> barrier_models;
+  for (Index p = 0; p < main_calculator.prim_event_list.size(); ++p) {
+    barrier_models[main_calculator.prim_event_list[p].event_type_name] =
+        main_calculator.prim_event_calculators[p].barrier_model();
+  }
+  std::vector<std::shared_ptr<IndependentEventCalculator>> calculators;
+  for (Index i = 0; i < n_threads; ++i) {
+    calculators.push_back(std::make_shared<IndependentEventCalculator>(
+        make_independent_prim_event_calculators(system, state,
+                                                main_calculator.prim_event_list,
+                                                conditions, barrier_models),
+        main_calculator));
+  }
+  return calculators;
 }
 
 }  // namespace kinetic
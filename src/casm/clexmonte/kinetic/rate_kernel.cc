@@ -0,0 +1,135 @@
+#include "casm/clexmonte/kinetic/rate_kernel.hh"
+
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+namespace {
+
+/// \brief Batched rate calculation, specialized for a barrier model
+///
+/// The loops have no branches or function calls, so that the compiler can
+/// vectorize them for the instruction set of the calling variant (see
+/// `_calculate_arrhenius_rates`). The "normal" flags are set in a separate
+/// loop because mixing `char` and `double` results in one loop prevents
+/// vectorization.
+template <typename ModelType>
+CASM_CLEXMONTE_ALWAYS_INLINE void _calculate_arrhenius_rates_impl(
+    ModelType const &model, Index n, double beta, double const *dE_final,
+    double const *Ekra, double const *freq, double *dE_activated,
+    unsigned char *is_normal, double *rate) {
+  for (Index i = 0; i < n; ++i) {
+    is_normal[i] = is_normal_event(model, dE_final[i], Ekra[i]);
+  }
+  for (Index i = 0; i < n; ++i) {
+    double dEa = clamped_activation_energy(model, dE_final[i], Ekra[i]);
+    dE_activated[i] = dEa;
+    rate[i] = freq[i] * vectorizable_exp(-beta * dEa);
+  }
+}
+
+template <typename ModelType>
+CASM_CLEXMONTE_TARGET_AVX512 void _calculate_arrhenius_rates_avx512(
+    ModelType const &model, Index n, double beta, double const *dE_final,
+    double const *Ekra, double const *freq, double *dE_activated,
+    unsigned char *is_normal, double *rate) {
+  _calculate_arrhenius_rates_impl(model, n, beta, dE_final, Ekra, freq,
+                                  dE_activated, is_normal, rate);
+}
+
+template <typename ModelType>
+CASM_CLEXMONTE_TARGET_AVX2 void _calculate_arrhenius_rates_avx2(
+    ModelType const &model, Index n, double beta, double const *dE_final,
+    double const *Ekra, double const *freq, double *dE_activated,
+    unsigned char *is_normal, double *rate) {
+  _calculate_arrhenius_rates_impl(model, n, beta, dE_final, Ekra, freq,
+                                  dE_activated, is_normal, rate);
+}
+
+template <typename ModelType>
+void _calculate_arrhenius_rates_baseline(
+    ModelType const &model, Index n, double beta, double const *dE_final,
+    double const *Ekra, double const *freq, double *dE_activated,
+    unsigned char *is_normal, double *rate) {
+  _calculate_arrhenius_rates_impl(model, n, beta, dE_final, Ekra, freq,
+                                  dE_activated, is_normal, rate);
+}
+
+/// \brief Batched rate calculation, using the instruction set variant
+///     selected by `kernel_isa`
+template <typename ModelType>
+void _calculate_arrhenius_rates(ModelType const &model, Index n, double beta,
+                                double const *dE_final, double const *Ekra,
+                                double const *freq, double *dE_activated,
+                                unsigned char *is_normal, double *rate) {
+  KernelISA isa = kernel_isa();
+  if (isa == KernelISA::avx512) {
+    _calculate_arrhenius_rates_avx512(model, n, beta, dE_final, Ekra, freq,
+                                      dE_activated, is_normal, rate);
+  } else if (isa == KernelISA::avx2) {
+    _calculate_arrhenius_rates_avx2(model, n, beta, dE_final, Ekra, freq,
+                                    dE_activated, is_normal, rate);
+  } else {
+    _calculate_arrhenius_rates_baseline(model, n, beta, dE_final, Ekra, freq,
+                                        dE_activated, is_normal, rate);
+  }
+}
+
+}  // namespace
+
+/// \brief Calculate activation energies, "normal" flags, and rates of a
+///     batch of events, using the KRA midpoint formula
+///
+/// Gives the same results as `calculate_arrhenius_rate` for each event,
+/// except that rates use `vectorizable_exp` and so differ from those by a
+/// relative error of less than 1e-15.
+///
+/// \param n Number of events
+/// \param beta Reciprocal temperature, `1 / (k_B * T)`
+/// \param dE_final Change in energy to the final state, size `n`
+/// \param Ekra KRA energy, size `n`
+/// \param freq Attempt frequency, size `n`
+/// \param dE_activated Set to the clamped activation energy, size `n`
+/// \param is_normal Set to 1 if an event is "normal", else 0, size `n`
+/// \param rate Set to the event rate, size `n`
+void calculate_arrhenius_rates(Index n, double beta, double const *dE_final,
+                               double const *Ekra, double const *freq,
+                               double *dE_activated, unsigned char *is_normal,
+                               double *rate) {
+  _calculate_arrhenius_rates(KRABarrierModel{}, n, beta, dE_final, Ekra, freq,
+                             dE_activated, is_normal, rate);
+}
+
+/// \brief Calculate activation energies, "normal" flags, and rates of a
+///     batch of events, using the given barrier model
+///
+/// The barrier model type is checked once, then a loop specialized for the
+/// concrete barrier model is used for all events. Gives the same results as
+/// `calculate_arrhenius_rate` for each event, except that rates use
+/// `vectorizable_exp` and so differ by a relative error of less than 1e-15.
+///
+/// \param model The barrier model
+/// \param n Number of events
+/// \param beta Reciprocal temperature, `1 / (k_B * T)`
+/// \param dE_final Change in energy to the final state, size `n`
+/// \param Ekra KRA energy, size `n`. Not used by all barrier models.
+/// \param freq Attempt frequency, size `n`
+/// \param dE_activated Set to the clamped activation energy, size `n`
+/// \param is_normal Set to 1 if an event is "normal", else 0, size `n`
+/// \param rate Set to the event rate, size `n`
+void calculate_arrhenius_rates(BarrierModel const &model, Index n,
+                               double beta, double const *dE_final,
+                               double const *Ekra, double const *freq,
+                               double *dE_activated, unsigned char *is_normal,
+                               double *rate) {
+  model.visit([&](auto const &concrete_model) {
+    _calculate_arrhenius_rates(concrete_model, n, beta, dE_final, Ekra, freq,
+                               dE_activated, is_normal, rate);
+  });
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
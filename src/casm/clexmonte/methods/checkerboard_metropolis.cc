@@ -0,0 +1,170 @@
+#include "casm/clexmonte/methods/checkerboard_metropolis.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/clexmonte/misc/MortonOrder.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return the maximum distance, in unit cells along any lattice
+///     vector, of a neighborhood from the origin unit cell
+///
+/// \param neighborhood Sites, relative to the origin unit cell, such as from
+///     `get_required_update_neighborhood`
+Index unitcell_reach(std::set<xtal::UnitCellCoord> const &neighborhood) {
+  Index reach = 0;
+  for (auto const &site : neighborhood) {
+    xtal::UnitCell const &unitcell = site.unitcell();
+    for (Index k = 0; k < 3; ++k) {
+      reach = std::max(reach, Index(std::abs(unitcell(k))));
+    }
+  }
+  return reach;
+}
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Supercell transformation matrix.
+///     Must be diagonal, with each diagonal element either 1 or a multiple
+///     of `spacing`.
+/// \param spacing Minimum distance between unit cells of the same color,
+///     along some lattice vector
+CheckerboardColoring::CheckerboardColoring(
+    Eigen::Matrix3l const &transformation_matrix_to_super, Index spacing)
+    : m_spacing(spacing) {
+  Eigen::Matrix3l const &T = transformation_matrix_to_super;
+  if (m_spacing < 1) {
+    throw std::runtime_error(
+        "Error constructing CheckerboardColoring: spacing < 1");
+  }
+  Index s[3];
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      if (i != j && T(i, j) != 0) {
+        throw std::runtime_error(
+            "Error constructing CheckerboardColoring: the supercell "
+            "transformation matrix must be diagonal");
+      }
+    }
+    // a single unit cell along a lattice vector needs only one color
+    s[i] = (T(i, i) == 1) ? 1 : m_spacing;
+    if (T(i, i) % s[i] != 0) {
+      std::stringstream msg;
+      msg << "Error constructing CheckerboardColoring: the supercell "
+             "transformation matrix diagonal elements must be 1 or a multiple "
+             "of "
+          << m_spacing << " (the color spacing required by the cluster "
+          << "expansion neighborhood), found " << T(i, i) << ".";
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  Index n_unitcells = unitcell_converter.total_sites();
+  m_colors.resize(s[0] * s[1] * s[2]);
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+    Index c[3];
+    for (Index k = 0; k < 3; ++k) {
+      c[k] = ((unitcell(k) % s[k]) + s[k]) % s[k];
+    }
+    m_colors[c[0] + s[0] * (c[1] + s[1] * c[2])].push_back(unitcell_index);
+  }
+  for (auto &color : m_colors) {
+    sort_by_morton_order(color, unitcell_converter);
+  }
+}
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Supercell transformation matrix
+/// \param convert Index conversions for the supercell, which must outlive
+///     the proposer
+/// \param swaps For canonical events, the canonical swaps. For semi-grand
+///     canonical events, the semi-grand canonical single site swaps.
+/// \param is_canonical If true, propose canonical swaps, else semi-grand
+///     canonical single site changes
+CheckerboardEventProposer::CheckerboardEventProposer(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    monte::Conversions const &convert, std::vector<monte::OccSwap> const &swaps,
+    bool is_canonical)
+    : m_convert(convert),
+      m_is_canonical(is_canonical),
+      m_n_species(convert.species_size()),
+      m_n_asym(convert.asym_size()) {
+  if (swaps.size() == 0) {
+    throw std::runtime_error(
+        "Error constructing CheckerboardEventProposer: no swaps (checkerboard "
+        "Metropolis requires canonical swaps or semi-grand canonical single "
+        "site swaps)");
+  }
+
+  xtal::UnitCellIndexConverter unitcell_converter(
+      transformation_matrix_to_super);
+  Index n_unitcells = unitcell_converter.total_sites();
+  m_n_sublat = convert.l_size() / n_unitcells;
+
+  m_site_l.resize(n_unitcells * m_n_sublat);
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+    for (Index b = 0; b < m_n_sublat; ++b) {
+      m_site_l[unitcell_index * m_n_sublat + b] =
+          convert.bijk_to_l(xtal::UnitCellCoord(b, unitcell));
+    }
+  }
+
+  if (m_is_canonical) {
+    std::vector<xtal::UnitCell> directions(
+        {xtal::UnitCell(0, 0, 0), xtal::UnitCell(1, 0, 0),
+         xtal::UnitCell(-1, 0, 0), xtal::UnitCell(0, 1, 0),
+         xtal::UnitCell(0, -1, 0), xtal::UnitCell(0, 0, 1),
+         xtal::UnitCell(0, 0, -1)});
+    m_neighbor_unitcell.resize(n_unitcells * 7);
+    for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+         ++unitcell_index) {
+      xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+      for (Index d = 0; d < 7; ++d) {
+        m_neighbor_unitcell[unitcell_index * 7 + d] =
+            unitcell_converter(unitcell + directions[d]);
+      }
+    }
+
+    Index n_cand = m_n_asym * m_n_species;
+    m_swap_allowed.resize(n_cand * n_cand, 0);
+    for (auto const &swap : swaps) {
+      Index a = swap.cand_a.asym * m_n_species + swap.cand_a.species_index;
+      Index b = swap.cand_b.asym * m_n_species + swap.cand_b.species_index;
+      m_swap_allowed[a * n_cand + b] = 1;
+      m_swap_allowed[b * n_cand + a] = 1;
+    }
+  } else {
+    m_flip_options.resize(m_n_asym * m_n_species);
+    auto _add = [&](Index asym, Index from_species, Index to_species) {
+      auto &options = m_flip_options[asym * m_n_species + from_species];
+      if (std::find(options.begin(), options.end(), to_species) ==
+          options.end()) {
+        options.push_back(to_species);
+      }
+    };
+    for (auto const &swap : swaps) {
+      if (swap.cand_a.asym != swap.cand_b.asym) {
+        throw std::runtime_error(
+            "Error constructing CheckerboardEventProposer: semi-grand "
+            "canonical swaps must change the species on one site");
+      }
+      _add(swap.cand_a.asym, swap.cand_a.species_index,
+           swap.cand_b.species_index);
+      _add(swap.cand_a.asym, swap.cand_b.species_index,
+           swap.cand_a.species_index);
+    }
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
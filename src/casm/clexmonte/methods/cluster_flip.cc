@@ -0,0 +1,190 @@
+#include "casm/clexmonte/methods/cluster_flip.hh"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Make nearest neighbor bonds between sites of the same asymmetric
+///     unit
+///
+/// Neighbors are searched for in the unit cells within 2 lattice translations
+/// of the origin unit cell along each lattice vector.
+///
+/// \param prim The prim structure
+/// \param convert Index conversions, used for the asymmetric unit of each
+///     sublattice
+///
+/// \returns Bonds, where `bonds[b]` are the nearest neighbors of the site on
+///     sublattice `b` in the origin unit cell, among sites with the same
+///     asymmetric unit index. "Nearest" is by Cartesian distance, for each
+///     asymmetric unit separately.
+std::vector<std::vector<xtal::UnitCellCoord>> make_nearest_neighbor_bonds(
+    xtal::BasicStructure const &prim, monte::Conversions const &convert) {
+  Index n_sublat = prim.basis().size();
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  double tol = prim.lattice().tol();
+  Index reach = 2;
+
+  auto _distance = [&](Index b, xtal::UnitCellCoord const &site) {
+    Eigen::Vector3d r = prim.basis()[site.sublattice()].const_cart() +
+                        L * site.unitcell().cast<double>() -
+                        prim.basis()[b].const_cart();
+    return r.norm();
+  };
+
+  // Nearest neighbor distance, by asymmetric unit
+  std::vector<double> min_distance(convert.asym_size(),
+                                   std::numeric_limits<double>::max());
+  std::vector<std::vector<xtal::UnitCellCoord>> candidates(n_sublat);
+  for (Index b = 0; b < n_sublat; ++b) {
+    Index asym = convert.b_to_asym(b);
+    for (Index b_nbor : convert.asym_to_b(asym)) {
+      for (Index i = -reach; i <= reach; ++i) {
+        for (Index j = -reach; j <= reach; ++j) {
+          for (Index k = -reach; k <= reach; ++k) {
+            xtal::UnitCellCoord site(b_nbor, i, j, k);
+            double d = _distance(b, site);
+            if (d < tol) {
+              continue;
+            }
+            candidates[b].push_back(site);
+            min_distance[asym] = std::min(min_distance[asym], d);
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<xtal::UnitCellCoord>> bonds(n_sublat);
+  for (Index b = 0; b < n_sublat; ++b) {
+    Index asym = convert.b_to_asym(b);
+    for (auto const &site : candidates[b]) {
+      if (_distance(b, site) < min_distance[asym] + tol) {
+        bonds[b].push_back(site);
+      }
+    }
+  }
+  return bonds;
+}
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Supercell transformation matrix
+/// \param convert Index conversions for the supercell, which must outlive
+///     the proposer
+/// \param bonds Bonds, where `bonds[b]` are the sites, relative to the
+///     origin unit cell, bonded to the site on sublattice `b` in the origin
+///     unit cell, such as from `make_nearest_neighbor_bonds`. Must be
+///     between sites with the same asymmetric unit, and symmetric (if site
+///     `(b, 0)` is bonded to `(b', t)`, then `(b', 0)` must be bonded to `(b,
+///     -t)`).
+/// \param swaps The semi-grand canonical single site swaps
+/// \param bond_probability Probability of adding a bond to the domain, in
+///     `[0.0, 1.0)`
+ClusterFlipEventProposer::ClusterFlipEventProposer(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    monte::Conversions const &convert,
+    std::vector<std::vector<xtal::UnitCellCoord>> const &bonds,
+    std::vector<monte::OccSwap> const &swaps, double bond_probability)
+    : m_convert(convert),
+      m_bond_probability(bond_probability),
+      m_log_bond_rejection(std::log(1.0 - bond_probability)),
+      m_n_species(convert.species_size()) {
+  if (m_bond_probability < 0.0 || m_bond_probability >= 1.0) {
+    std::stringstream msg;
+    msg << "Error constructing ClusterFlipEventProposer: bond_probability "
+           "must be in [0.0, 1.0), found "
+        << m_bond_probability << ".";
+    throw std::runtime_error(msg.str());
+  }
+  if (swaps.size() == 0) {
+    throw std::runtime_error(
+        "Error constructing ClusterFlipEventProposer: no swaps (cluster flip "
+        "events require semi-grand canonical single site swaps)");
+  }
+
+  // Allowed species changes
+  Index n_asym = convert.asym_size();
+  m_flip_options.resize(n_asym * m_n_species);
+  auto _add = [&](Index asym, Index from_species, Index to_species) {
+    auto &options = m_flip_options[asym * m_n_species + from_species];
+    if (std::find(options.begin(), options.end(), to_species) ==
+        options.end()) {
+      options.push_back(to_species);
+    }
+  };
+  std::vector<unsigned char> asym_can_flip(n_asym, 0);
+  for (auto const &swap : swaps) {
+    if (swap.cand_a.asym != swap.cand_b.asym) {
+      throw std::runtime_error(
+          "Error constructing ClusterFlipEventProposer: semi-grand canonical "
+          "swaps must change the species on one site");
+    }
+    _add(swap.cand_a.asym, swap.cand_a.species_index,
+         swap.cand_b.species_index);
+    _add(swap.cand_a.asym, swap.cand_b.species_index,
+         swap.cand_a.species_index);
+    asym_can_flip[swap.cand_a.asym] = 1;
+  }
+
+  // Neighbors of each site, in the supercell
+  xtal::UnitCellIndexConverter unitcell_converter(
+      transformation_matrix_to_super);
+  Index n_unitcells = unitcell_converter.total_sites();
+  Index n_sites = convert.l_size();
+  Index n_sublat = n_sites / n_unitcells;
+  if (bonds.size() != n_sublat) {
+    throw std::runtime_error(
+        "Error constructing ClusterFlipEventProposer: bonds.size() does not "
+        "match the number of sublattices");
+  }
+
+  m_neighbor_begin.resize(n_sites + 1);
+  std::vector<Index> site_neighbors;
+  for (Index l = 0; l < n_sites; ++l) {
+    m_neighbor_begin[l] = m_neighbor_l.size();
+    xtal::UnitCellCoord bijk = convert.l_to_bijk(l);
+    Index asym = convert.l_to_asym(l);
+    if (asym_can_flip[asym]) {
+      m_seed_l.push_back(l);
+    }
+
+    // Periodic images in small supercells may repeat a neighbor, or be the
+    // site itself; each distinct neighbor is one bond
+    site_neighbors.clear();
+    for (auto const &site : bonds[bijk.sublattice()]) {
+      Index l_nbor = convert.bijk_to_l(
+          xtal::UnitCellCoord(site.sublattice(), bijk.unitcell() +
+                                                     site.unitcell()));
+      if (convert.l_to_asym(l_nbor) != asym) {
+        throw std::runtime_error(
+            "Error constructing ClusterFlipEventProposer: bonds must be "
+            "between sites of the same asymmetric unit");
+      }
+      if (l_nbor != l && std::find(site_neighbors.begin(), site_neighbors.end(),
+                                   l_nbor) == site_neighbors.end()) {
+        site_neighbors.push_back(l_nbor);
+      }
+    }
+    m_neighbor_l.insert(m_neighbor_l.end(), site_neighbors.begin(),
+                        site_neighbors.end());
+  }
+  m_neighbor_begin[n_sites] = m_neighbor_l.size();
+
+  if (m_seed_l.empty()) {
+    throw std::runtime_error(
+        "Error constructing ClusterFlipEventProposer: no sites may change "
+        "species");
+  }
+  m_in_domain.resize(n_sites, 0);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
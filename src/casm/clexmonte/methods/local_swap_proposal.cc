@@ -0,0 +1,190 @@
+#include "casm/clexmonte/methods/local_swap_proposal.hh"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// Call `f(b_a, b_b, unitcell, distance)` for each pair of included sites,
+/// `(b_a, origin unit cell)` and `(b_b, unitcell)`, which may be within
+/// `cutoff` of each other, excluding a site and itself
+template <typename F>
+void _for_each_site_pair(xtal::BasicStructure const &prim,
+                         std::vector<bool> const &is_included, double cutoff,
+                         F f) {
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  Eigen::Matrix3d L_inv = L.inverse();
+  Index n[3];
+  for (Index i = 0; i < 3; ++i) {
+    n[i] = Index(std::ceil(cutoff * L_inv.row(i).norm())) + 1;
+  }
+  Index n_sublat = prim.basis().size();
+  for (Index b_a = 0; b_a < n_sublat; ++b_a) {
+    if (!is_included[b_a]) {
+      continue;
+    }
+    Eigen::Vector3d r_a = prim.basis()[b_a].const_cart();
+    for (Index b_b = 0; b_b < n_sublat; ++b_b) {
+      if (!is_included[b_b]) {
+        continue;
+      }
+      Eigen::Vector3d r_b = prim.basis()[b_b].const_cart();
+      for (Index i = -n[0]; i <= n[0]; ++i) {
+        for (Index j = -n[1]; j <= n[1]; ++j) {
+          for (Index k = -n[2]; k <= n[2]; ++k) {
+            if (b_a == b_b && i == 0 && j == 0 && k == 0) {
+              continue;
+            }
+            xtal::UnitCell unitcell(i, j, k);
+            double distance =
+                (r_b + L * unitcell.cast<double>() - r_a).norm();
+            f(b_a, b_b, unitcell, distance);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Return the neighbors of each sublattice of a prim within a
+///     distance shell
+///
+/// The neighbor relation is symmetric: if site `(b_b, unitcell)` is a
+/// neighbor of `(b_a, 0, 0, 0)`, then `(b_a, -unitcell)` is a neighbor of
+/// `(b_b, 0, 0, 0)`.
+///
+/// \param prim The prim structure
+/// \param is_included Size `prim.basis().size()`, true for the sublattices
+///     whose sites are neighbors of each other. Other sublattices have no
+///     neighbors and are not neighbors.
+/// \param max_distance Sites within this Cartesian distance of each other
+///     (with tolerance `CASM::TOL`) are neighbors. If <= 0.0, the distance
+///     of the nearest pair of sites of the included sublattices is used, so
+///     that each included site has its nearest neighbor shell.
+///
+/// \returns Neighbors of `(b, 0, 0, 0)`, for each sublattice `b`
+std::vector<std::vector<xtal::UnitCellCoord>> make_local_swap_neighbors(
+    xtal::BasicStructure const &prim, std::vector<bool> const &is_included,
+    double max_distance) {
+  Index n_sublat = prim.basis().size();
+  if (Index(is_included.size()) != n_sublat) {
+    throw std::runtime_error(
+        "Error in make_local_swap_neighbors: is_included size does not match "
+        "the number of sublattices");
+  }
+
+  if (max_distance <= 0.0) {
+    // Each site has a periodic image one lattice vector away
+    Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+    double cutoff = L.colwise().norm().maxCoeff();
+    max_distance = std::numeric_limits<double>::infinity();
+    _for_each_site_pair(
+        prim, is_included, cutoff,
+        [&](Index b_a, Index b_b, xtal::UnitCell const &unitcell,
+            double distance) {
+          max_distance = std::min(max_distance, distance);
+        });
+    if (!std::isfinite(max_distance)) {
+      throw std::runtime_error(
+          "Error in make_local_swap_neighbors: no included sublattices");
+    }
+  }
+
+  std::vector<std::vector<xtal::UnitCellCoord>> neighbors(n_sublat);
+  _for_each_site_pair(
+      prim, is_included, max_distance,
+      [&](Index b_a, Index b_b, xtal::UnitCell const &unitcell,
+          double distance) {
+        if (distance <= max_distance + CASM::TOL) {
+          neighbors[b_a].emplace_back(b_b, unitcell);
+        }
+      });
+  return neighbors;
+}
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Supercell transformation matrix
+/// \param convert Index conversions for the supercell, which must outlive
+///     the proposer
+/// \param swaps The canonical swaps. Sites of sublattices with a candidate
+///     in some swap may be swapped.
+/// \param prim The prim structure, used to find neighbors
+/// \param max_distance The neighbor shell, see `make_local_swap_neighbors`.
+///     If <= 0.0, the nearest neighbor shell is used.
+LocalSwapProposer::LocalSwapProposer(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    monte::Conversions const &convert, std::vector<monte::OccSwap> const &swaps,
+    xtal::BasicStructure const &prim, double max_distance)
+    : m_convert(convert),
+      m_n_species(convert.species_size()),
+      m_n_asym(convert.asym_size()) {
+  if (swaps.size() == 0) {
+    throw std::runtime_error(
+        "Error constructing LocalSwapProposer: no canonical swaps");
+  }
+
+  Index n_cand = m_n_asym * m_n_species;
+  m_swap_allowed.resize(n_cand * n_cand, 0);
+  std::vector<bool> is_swap_asym(m_n_asym, false);
+  for (auto const &swap : swaps) {
+    Index a = swap.cand_a.asym * m_n_species + swap.cand_a.species_index;
+    Index b = swap.cand_b.asym * m_n_species + swap.cand_b.species_index;
+    m_swap_allowed[a * n_cand + b] = 1;
+    m_swap_allowed[b * n_cand + a] = 1;
+    is_swap_asym[swap.cand_a.asym] = true;
+    is_swap_asym[swap.cand_b.asym] = true;
+  }
+
+  Index n_sublat = prim.basis().size();
+  std::vector<bool> is_included(n_sublat);
+  for (Index b = 0; b < n_sublat; ++b) {
+    Index l = convert.bijk_to_l(xtal::UnitCellCoord(b, 0, 0, 0));
+    is_included[b] = is_swap_asym[convert.l_to_asym(l)];
+  }
+  std::vector<std::vector<xtal::UnitCellCoord>> neighbors =
+      make_local_swap_neighbors(prim, is_included, max_distance);
+  for (Index b = 0; b < n_sublat; ++b) {
+    if (is_included[b] && neighbors[b].empty()) {
+      std::stringstream msg;
+      msg << "Error constructing LocalSwapProposer: sublattice " << b
+          << " has no neighbors within the local swap distance";
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  xtal::UnitCellIndexConverter unitcell_converter(
+      transformation_matrix_to_super);
+  Index n_unitcells = unitcell_converter.total_sites();
+  m_neighbor_begin.push_back(0);
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+    for (Index b = 0; b < n_sublat; ++b) {
+      if (!is_included[b]) {
+        continue;
+      }
+      m_site_l.push_back(convert.bijk_to_l(xtal::UnitCellCoord(b, unitcell)));
+      for (auto const &site : neighbors[b]) {
+        xtal::UnitCell neighbor_unitcell =
+            unitcell_converter(unitcell_converter(unitcell + site.unitcell()));
+        m_neighbor_l.push_back(convert.bijk_to_l(
+            xtal::UnitCellCoord(site.sublattice(), neighbor_unitcell)));
+      }
+      m_neighbor_begin.push_back(m_neighbor_l.size());
+    }
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,230 @@
+#include "casm/clexmonte/methods/sqs_search.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief Keeps the `n_best` results with lowest potential, shared by all
+///     chains
+class SQSBestResults {
+ public:
+  explicit SQSBestResults(Index _n_best) : m_n_best(_n_best) {}
+
+  /// \brief Return true if a result with `potential` would be kept
+  bool accepts(double potential) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _accepts(potential);
+  }
+
+  /// \brief Insert a result, if it is among the best
+  void insert(SQSResult const &result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!_accepts(result.potential)) {
+      return;
+    }
+    auto it =
+        std::upper_bound(m_results.begin(), m_results.end(), result,
+                         [](SQSResult const &lhs, SQSResult const &rhs) {
+                           return lhs.potential < rhs.potential;
+                         });
+    m_results.insert(it, result);
+    if (m_results.size() > m_n_best) {
+      m_results.pop_back();
+    }
+  }
+
+  std::vector<SQSResult> results() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_results;
+  }
+
+ private:
+  bool _accepts(double potential) const {
+    return m_results.size() < m_n_best ||
+           potential < m_results.back().potential;
+  }
+
+  Index m_n_best;
+  std::mutex m_mutex;
+  std::vector<SQSResult> m_results;
+};
+
+/// \brief Run one annealing chain
+void run_sqs_chain(System &system, Index supercell_index, Index chain_index,
+                   Eigen::Matrix3l const &T,
+                   Eigen::VectorXd const &target_mol_composition,
+                   CorrMatchingParams const &corr_matching_params,
+                   SQSSearchParams const &search_params,
+                   SQSBestResults &best_results, std::atomic<bool> &stop) {
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(search_params.seed + chain_index));
+
+  // Random initial configuration at the target composition
+  state_type state(make_default_configuration(system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  monte::OccLocation occ_location(get_index_conversions(system, state),
+                                  get_occ_candidate_list(system, state));
+  occ_location.initialize(occupation);
+  enforce_composition(occupation, target_mol_composition,
+                      get_composition_calculator(system),
+                      get_semigrand_canonical_swaps(system), occ_location,
+                      random_number_generator);
+  std::vector<monte::OccSwap> const &canonical_swaps =
+      get_canonical_swaps(system);
+  monte::OccEvent event;
+  for (Index i = 0; i < occupation.size(); ++i) {
+    monte::propose_canonical_event(event, occ_location, canonical_swaps,
+                                   random_number_generator);
+    occ_location.apply(event, occupation);
+  }
+
+  // Only evaluate the target correlations, with a Clexulator that is not
+  // shared with other chains
+  auto correlations = std::make_shared<clexulator::Correlations>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<clexulator::Clexulator>(
+          *get_basis_set(system, search_params.basis_set_key)),
+      make_corr_matching_indices(corr_matching_params));
+  correlations->set(&get_dof_values(state));
+  CorrMatchingPotentialCalculator potential(
+      corr_matching_params, correlations, T.determinant());
+  Index n_targets = corr_matching_params.targets.size();
+
+  auto finish_pass = [&]() {
+    // controls round-off drift
+    potential.reset();
+    double value = potential.value();
+    if (best_results.accepts(value)) {
+      SQSResult result;
+      result.supercell_index = supercell_index;
+      result.chain_index = chain_index;
+      result.transformation_matrix_to_super = T;
+      result.occupation = occupation;
+      result.potential = value;
+      result.n_exact = potential.n_exact();
+      best_results.insert(result);
+    }
+    if (search_params.stop_if_exact && potential.n_exact() == n_targets) {
+      stop = true;
+    }
+  };
+
+  finish_pass();
+  Index n_steps_per_pass = occupation.size();
+  double T_init = search_params.initial_temperature;
+  double T_final = search_params.final_temperature;
+  for (Index pass = 0; pass < search_params.n_passes; ++pass) {
+    if (stop) {
+      return;
+    }
+    double f = (search_params.n_passes > 1)
+                   ? double(pass) / (search_params.n_passes - 1)
+                   : 1.0;
+    double beta = 1.0 / (T_init * std::pow(T_final / T_init, f));
+    for (Index step = 0; step < n_steps_per_pass; ++step) {
+      monte::propose_canonical_event(event, occ_location, canonical_swaps,
+                                     random_number_generator);
+      double delta =
+          potential.occ_delta(event.linear_site_index, event.new_occ);
+      if (monte::metropolis_acceptance(delta, beta, random_number_generator)) {
+        potential.apply(event);
+        occ_location.apply(event, occupation);
+      }
+    }
+    finish_pass();
+  }
+}
+
+}  // namespace
+
+/// \brief Search for special quasirandom structures (SQS) by running
+///     independent annealing chains over candidate supercells in parallel
+///
+/// Each chain starts from a random configuration at the target composition
+/// in one of the candidate supercells, and anneals it using canonical swaps
+/// and the correlation-matching potential. Chains are distributed over
+/// `search_params.n_threads` threads, and the configuration at the end of
+/// each pass is kept if it is among the `search_params.n_best`
+/// configurations with lowest potential found by any chain. With
+/// `search_params.stop_if_exact`, all chains stop once a configuration
+/// exactly matches all target correlations.
+///
+/// \param system System data
+/// \param supercells Candidate supercell transformation matrices. Each is
+///     used by `search_params.n_chains_per_supercell` chains.
+/// \param target_mol_composition Composition enforced in each initial
+///     configuration, as with `enforce_composition`
+/// \param corr_matching_params Target correlations, for example from
+///     `RandomAlloyCorrMatchingParams`
+/// \param search_params Search parameters
+///
+/// \returns The best configurations, sorted by increasing potential
+std::vector<SQSResult> sqs_search(
+    System &system, std::vector<Eigen::Matrix3l> const &supercells,
+    Eigen::VectorXd const &target_mol_composition,
+    CorrMatchingParams const &corr_matching_params,
+    SQSSearchParams const &search_params) {
+  if (search_params.n_chains_per_supercell < 1 || search_params.n_best < 1 ||
+      search_params.n_threads < 1) {
+    throw std::runtime_error(
+        "Error in sqs_search: n_chains_per_supercell, n_best, and n_threads "
+        "must be >= 1");
+  }
+  if (!(search_params.initial_temperature > 0.0) ||
+      !(search_params.final_temperature > 0.0)) {
+    throw std::runtime_error(
+        "Error in sqs_search: temperatures must be > 0.0");
+  }
+
+  if (get_canonical_swaps(system).empty()) {
+    throw std::runtime_error("Error in sqs_search: no canonical swaps");
+  }
+
+  SQSBestResults best_results(search_params.n_best);
+  std::atomic<bool> stop(false);
+  std::atomic<Index> next_chain(0);
+  Index n_chains = supercells.size() * search_params.n_chains_per_supercell;
+
+  // Chains are claimed dynamically, because their cost depends on the
+  // supercell volume
+  auto run_chains = [&](Index thread_index) {
+    Index chain_index;
+    while (!stop && (chain_index = next_chain++) < n_chains) {
+      Index supercell_index =
+          chain_index / search_params.n_chains_per_supercell;
+      run_sqs_chain(system, supercell_index, chain_index,
+                    supercells[supercell_index], target_mol_composition,
+                    corr_matching_params, search_params, best_results, stop);
+    }
+  };
+
+  Index n_threads =
+      std::min(search_params.n_threads, std::max(n_chains, Index(1)));
+  if (n_threads <= 1) {
+    run_chains(0);
+  } else {
+    ThreadPool pool(n_threads);
+    pool.run(run_chains);
+  }
+  return best_results.results();
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,101 @@
+#include "casm/clexmonte/methods/thread_pool.hh"
+
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _n_threads Total number of threads, including the calling thread
+ThreadPool::ThreadPool(Index _n_threads)
+    : m_generation(0), m_n_pending(0), m_stop(false), m_f(nullptr) {
+  if (_n_threads < 1) {
+    throw std::runtime_error("Error constructing ThreadPool: n_threads < 1");
+  }
+  for (Index i = 1; i < _n_threads; ++i) {
+    m_threads.emplace_back(&ThreadPool::_run_worker, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start_cv.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/// \brief Call `f(thread_index)` for each `thread_index` in
+///     `[0, n_threads())`, and wait for all calls to finish
+///
+/// `f(0)` is called on the calling thread. If any call throws, the first
+/// exception is rethrown after all calls finish.
+void ThreadPool::run(std::function<void(Index)> const &f) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_f = &f;
+    m_exception = nullptr;
+    m_n_pending = m_threads.size();
+    ++m_generation;
+  }
+  m_start_cv.notify_all();
+
+  std::exception_ptr exception;
+  try {
+    f(0);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [&] { return m_n_pending == 0; });
+    m_f = nullptr;
+    if (!exception) {
+      exception = m_exception;
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::_run_worker(Index thread_index) {
+  Index generation = 0;
+  while (true) {
+    std::function<void(Index)> const *f;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start_cv.wait(lock,
+                      [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+      f = m_f;
+    }
+
+    std::exception_ptr exception;
+    try {
+      (*f)(thread_index);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (exception && !m_exception) {
+        m_exception = exception;
+      }
+      --m_n_pending;
+    }
+    m_done_cv.notify_one();
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -126,6 +126,130 @@ void BaseMonteCalculator::_check_params() const {
   }
 }
 
+/// \brief Perform a replica exchange (parallel tempering) run, evolving
+///     each state at its own conditions with its own run manager
+///
+/// Implementations should set `multistate_data` and `multistate_potential`,
+/// with one element per state, and call `set_thread_current_state` so that
+/// sampling functions use the state data of the state being sampled. The
+/// default implementation throws.
+///
+/// \param states The states, one per replica, ordered so that neighbors
+///     have similar conditions. Configurations are exchanged between states
+///     at neighboring conditions.
+/// \param occ_locations Occupant location trackers, one per state, each
+///     already initialized with the corresponding state.
+/// \param run_managers Run managers, one per state, which sample the
+///     conditions of the corresponding state and after completion hold its
+///     final results.
+void BaseMonteCalculator::run_replica_exchange(
+    std::vector<state_type> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    std::vector<std::shared_ptr<run_manager_type<engine_type>>> const
+        &run_managers) {
+  std::stringstream msg;
+  msg << "Error: " << this->calculator_name
+      << " does not allow replica exchange runs";
+  throw std::runtime_error(msg.str());
+}
+
+/// \brief Construct lean SamplingFixtureParams for fast screening runs
+///
+/// Screening fixtures sample only a few quantities that are tracked
+/// incrementally during a run, do not check convergence, and write no files
+/// until the run is complete. The default implementation throws.
+///
+/// \param calculation The calculator, used to get sampling functions
+/// \param label Label for the sampling fixture
+/// \param write_results If true, write results when the run is complete
+/// \param output_dir Directory in which to write results. If not given,
+///     uses `"output" / label`.
+sampling_fixture_params_type
+BaseMonteCalculator::make_screening_sampling_fixture_params(
+    std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+    bool write_results, std::optional<std::string> output_dir) const {
+  std::stringstream msg;
+  msg << "Error: " << this->calculator_name
+      << " does not have screening sampling fixture parameters";
+  throw std::runtime_error(msg.str());
+}
+
+/// \brief Perform a run of independent chains of the same state, with
+///     observations of all chains pooled by one run manager
+///
+/// Implementations should set `multistate_data` and `multistate_potential`,
+/// with one element per chain, and call `set_thread_current_state` so that
+/// sampling functions use the state data of the chain being sampled. The
+/// default implementation throws.
+///
+/// \param states The states, one per chain, with the same conditions.
+/// \param occ_locations Occupant location trackers, one per state, each
+///     already initialized with the corresponding state.
+/// \param run_manager Samples all chains, so its completion check uses the
+///     pooled observations, and after completion holds final results.
+void BaseMonteCalculator::run_parallel_chains(
+    std::vector<state_type> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    run_manager_type<engine_type> &run_manager) {
+  std::stringstream msg;
+  msg << "Error: " << this->calculator_name
+      << " does not allow parallel chain runs";
+  throw std::runtime_error(msg.str());
+}
+
+/// \brief Perform a Wang-Landau run, estimating the density of states
+///     with one walker per energy window
+///
+/// Implementations should set `multistate_data` and `multistate_potential`,
+/// with one element per walker, call `set_thread_current_state` so that
+/// each walker's potential uses its own state data, and set
+/// `wang_landau_results`. The default implementation throws.
+///
+/// \param states The initial states, one per energy window, with the same
+///     conditions.
+/// \param occ_locations Occupant location trackers, one per state, each
+///     already initialized with the corresponding state.
+/// \param params Wang-Landau parameters
+/// \param engine Random number engine, used to seed the walker streams
+void BaseMonteCalculator::run_wang_landau(
+    std::vector<state_type> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    WangLandauParams const &params, std::shared_ptr<engine_type> engine) {
+  std::stringstream msg;
+  msg << "Error: " << this->calculator_name
+      << " does not allow Wang-Landau runs";
+  throw std::runtime_error(msg.str());
+}
+
+namespace {
+
+/// \brief The calculator and state index evolved by the calling thread
+///     during a multi-state run
+struct ThreadCurrentState {
+  BaseMonteCalculator const *calculator = nullptr;
+  int state_index = -1;
+};
+
+thread_local ThreadCurrentState thread_current_state_data;
+
+}  // namespace
+
+/// \brief Index of the state evolved by the calling thread during a
+///     multi-state run of this calculator, else -1
+int BaseMonteCalculator::thread_current_state() const {
+  if (thread_current_state_data.calculator != this) {
+    return -1;
+  }
+  return thread_current_state_data.state_index;
+}
+
+/// \brief Set the index of the state evolved by the calling thread during
+///     a multi-state run of this calculator, or -1 if none
+void BaseMonteCalculator::set_thread_current_state(int state_index) const {
+  thread_current_state_data.calculator = (state_index < 0) ? nullptr : this;
+  thread_current_state_data.state_index = state_index;
+}
+
 /// \brief Clone the BaseMonteCalculator
 std::unique_ptr<BaseMonteCalculator> BaseMonteCalculator::clone() const {
   return std::unique_ptr<BaseMonteCalculator>(this->_clone());
@@ -1,12 +1,21 @@
+#include <limits>
+
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/methods/checkerboard_metropolis.hh"
+#include "casm/clexmonte/methods/local_swap_proposal.hh"
+#include "casm/clexmonte/methods/neighborhood_prefetch.hh"
 #include "casm/clexmonte/methods/occupation_metropolis.hh"
+#include "casm/clexmonte/methods/parallel_chains_metropolis.hh"
+#include "casm/clexmonte/methods/swap_proposal_stream.hh"
 #include "casm/clexmonte/monte_calculator/BaseMonteCalculator.hh"
 #include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
 #include "casm/clexmonte/monte_calculator/analysis_functions.hh"
 #include "casm/clexmonte/monte_calculator/modifying_functions.hh"
 #include "casm/clexmonte/monte_calculator/sampling_functions.hh"
 #include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/EnsembleClusterExpansion.hh"
 #include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/state/io/json/EnsembleClusterExpansion_json_io.hh"
 #include "casm/configuration/io/json/Configuration_json_io.hh"
 #include "casm/monte/events/OccEventProposal.hh"
 #include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
@@ -49,6 +58,21 @@ class CanonicalEventGenerator {
   /// \brief The current proposed event
   monte::OccEvent occ_event;
 
+  /// \brief If set, events are proposed from blocks of pre-drawn proposals
+  std::optional<SwapProposalStream> proposal_stream;
+
+  /// \brief If set, and `proposal_stream` is set, the neighborhoods of the
+  ///     sites of the next proposal are prefetched after each proposal
+  std::optional<NeighborhoodPrefetcher> prefetcher;
+
+  /// \brief If set, events are swaps of a site and one of its neighbors
+  std::optional<LocalSwapProposer> local_swap_proposer;
+
+  /// \brief Index conversions and neighbor shell `local_swap_proposer` was
+  ///     made for
+  monte::Conversions const *local_swap_convert = nullptr;
+  double local_swap_max_distance = 0.0;
+
  public:
   /// \brief Set the current Monte Carlo state and occupant locations
   ///
@@ -67,16 +91,102 @@ class CanonicalEventGenerator {
     this->occ_location = throw_if_null(_occ_location,
                                        "Error in CanonicalEventGenerator::set: "
                                        "_occ_location==nullptr");
+    if (this->proposal_stream.has_value()) {
+      this->proposal_stream->reset();
+    }
+  }
+
+  /// \brief Set the number of proposals drawn at once
+  ///
+  /// \param block_size If > 1, events are proposed from blocks of
+  ///     `block_size` pre-drawn proposals (see SwapProposalStream). If 1,
+  ///     each event is proposed by `monte::propose_canonical_event`.
+  void set_proposal_block_size(Index block_size) {
+    if (block_size > 1) {
+      if (!this->proposal_stream.has_value() ||
+          this->proposal_stream->block_size != block_size) {
+        this->proposal_stream.emplace(this->canonical_swaps, true, block_size);
+      }
+    } else {
+      this->proposal_stream.reset();
+    }
+  }
+
+  /// \brief Prefetch the neighborhoods of the sites of the next proposal
+  ///
+  /// \param neighbor_list If not null, and events are proposed from blocks
+  ///     of pre-drawn proposals, the neighbor list entries and occupation of
+  ///     the sites of the next proposal are prefetched after each proposal.
+  ///     Must outlive the use of the event generator. Must be called after
+  ///     `set`.
+  void set_prefetch(clexulator::SuperNeighborList const *neighbor_list) {
+    if (neighbor_list && this->proposal_stream.has_value()) {
+      this->prefetcher.emplace(*neighbor_list, get_occupation(*this->state));
+    } else {
+      this->prefetcher.reset();
+    }
+  }
+
+  /// \brief Propose swaps of a site and one of its neighbors
+  ///
+  /// \param system If not null, events are proposed by a LocalSwapProposer
+  ///     for the supercell of the current state, which is only remade if the
+  ///     supercell or `max_distance` changed. If null, events are proposed
+  ///     from all canonical swaps. Must be called after `set`.
+  /// \param max_distance The neighbor shell, see `make_local_swap_neighbors`
+  void set_local_swap(system_type *system, double max_distance) {
+    if (system == nullptr) {
+      this->local_swap_proposer.reset();
+      this->local_swap_convert = nullptr;
+      return;
+    }
+    monte::Conversions const &convert =
+        get_index_conversions(*system, *this->state);
+    if (this->local_swap_proposer.has_value() &&
+        this->local_swap_convert == &convert &&
+        this->local_swap_max_distance == max_distance) {
+      return;
+    }
+    this->local_swap_proposer.emplace(
+        get_transformation_matrix_to_super(*this->state), convert,
+        this->canonical_swaps, *get_prim_basicstructure(*system),
+        max_distance);
+    this->local_swap_convert = &convert;
+    this->local_swap_max_distance = max_distance;
   }
 
   /// \brief Propose a Monte Carlo occupation event, returning a reference
   ///
   /// Notes:
   /// - Must call `set` before `propose` or `apply`
+  /// - With `set_local_swap`, a proposal which does not change the
+  ///   occupation returns an event with no sites (see `is_null_event`),
+  ///   which must be rejected
   ///
-  /// \param random_number_generator A random number generator
-  monte::OccEvent const &propose(
-      monte::RandomNumberGenerator<engine_type> &random_number_generator) {
+  /// \param random_number_generator A random number generator, such as
+  ///     `monte::RandomNumberGenerator` or `BufferedRandomNumberGenerator`
+  template <typename GeneratorType>
+  monte::OccEvent const &propose(GeneratorType &random_number_generator) {
+    if (this->local_swap_proposer.has_value()) {
+      if (!this->local_swap_proposer->propose(
+              this->occ_event, get_occupation(*this->state),
+              *this->occ_location, random_number_generator)) {
+        this->occ_event.linear_site_index.clear();
+        this->occ_event.new_occ.clear();
+        this->occ_event.occ_transform.clear();
+        this->occ_event.atom_traj.clear();
+      }
+      return this->occ_event;
+    }
+    if (this->proposal_stream.has_value()) {
+      this->proposal_stream->propose(this->occ_event, *this->occ_location,
+                                     random_number_generator);
+      if (this->prefetcher.has_value()) {
+        this->proposal_stream->prefetch_next(*this->occ_location,
+                                             *this->prefetcher);
+      }
+      return this->occ_event;
+    }
     return monte::propose_canonical_event(this->occ_event, *this->occ_location,
                                           this->canonical_swaps,
                                           random_number_generator);
@@ -85,12 +195,43 @@ class CanonicalEventGenerator {
   /// \brief Update the occupation of the current state using the provided event
   void apply(monte::OccEvent const &e) {
     this->occ_location->apply(e, get_occupation(*this->state));
+    if (this->proposal_stream.has_value()) {
+      this->proposal_stream->notify_applied(e);
+    }
   }
 };
 
-class CanonicalPotential : public BaseMontePotential {
+/// \brief True for a proposed event which does not change the occupation
+inline bool is_null_event(monte::OccEvent const &event) {
+  return event.linear_site_index.empty();
+}
+
+/// \brief Canonical potential, the formation energy
+///
+/// The formation energy is the "formation_energy" cluster expansion, or if
+/// the "ensemble_formation_energy" calculation parameter is given, one
+/// member, or the mean, of an ensemble of coefficient sets (see
+/// EnsembleClusterExpansion).
+///
+/// This class is `final`, so calls through a `CanonicalPotential` reference
+/// are not virtual.
+class CanonicalPotential final : public BaseMontePotential {
  public:
-  CanonicalPotential(std::shared_ptr<StateData> _state_data)
+  /// \brief Constructor
+  ///
+  /// \param _state_data State data
+  /// \param _formation_energy_clex If not null, the formation energy cluster
+  ///     expansion calculator to use, i.e. from `make_independent_clex` for
+  ///     use on another thread. If null, `get_clex` is used.
+  /// \param _ensemble_params If given, use one member, or the mean, of
+  ///     the multi-cluster expansion `state_data->multiclex` as the
+  ///     formation energy
+  CanonicalPotential(
+      std::shared_ptr<StateData> _state_data,
+      std::shared_ptr<clexulator::ClusterExpansion> _formation_energy_clex =
+          nullptr,
+      std::optional<EnsembleClusterExpansionParams> const &_ensemble_params =
+          std::nullopt)
       : BaseMontePotential(_state_data),
         state(*state_data->state),
         n_unitcells(state_data->n_unitcells),
@@ -103,12 +244,19 @@ class CanonicalPotential : public BaseMontePotential {
         param_composition(
             get_param_composition(*this->state_data->system, state.conditions)),
         formation_energy_clex(
-            get_clex(*state_data->system, state, "formation_energy")) {
+            _formation_energy_clex
+                ? _formation_energy_clex
+                : get_clex(*state_data->system, state, "formation_energy")) {
     if (param_composition.size() !=
         composition_converter.independent_compositions()) {
       throw std::runtime_error(
           "Error in CanonicalPotential: param_composition size error");
     }
+    if (_ensemble_params.has_value()) {
+      ensemble.emplace(
+          state_data->multiclex.at(_ensemble_params->multiclex_key),
+          _ensemble_params->member);
+    }
   }
 
   // --- Data used in the potential calculation: ---
@@ -122,13 +270,23 @@ class CanonicalPotential : public BaseMontePotential {
   Eigen::VectorXd param_composition;
   std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex;
 
+  /// Optional ensemble formation energy, used instead of
+  /// `formation_energy_clex` if set
+  std::optional<EnsembleClusterExpansion> ensemble;
+
   /// \brief Calculate (per_supercell) potential value
   double per_supercell() override {
+    if (ensemble.has_value()) {
+      return ensemble->per_supercell();
+    }
     return formation_energy_clex->per_supercell();
   }
 
   /// \brief Calculate (per_unitcell) potential value
   double per_unitcell() override {
+    if (ensemble.has_value()) {
+      return ensemble->per_supercell() / n_unitcells;
+    }
     return formation_energy_clex->per_unitcell();
   }
 
@@ -136,8 +294,29 @@ class CanonicalPotential : public BaseMontePotential {
   ///     to a series of occupation changes
   double occ_delta_per_supercell(std::vector<Index> const &linear_site_index,
                                  std::vector<int> const &new_occ) override {
+    if (ensemble.has_value()) {
+      return ensemble->occ_delta_value(linear_site_index, new_occ);
+    }
     return formation_energy_clex->occ_delta_value(linear_site_index, new_occ);
   }
+
+  /// \brief Calculate change in (per_supercell) potential value due to each
+  ///     of a batch of events, each relative to the current state
+  void occ_delta_per_supercell_batch(std::vector<monte::OccEvent> const &events,
+                                     Index n_events, double *delta) override {
+    if (ensemble.has_value()) {
+      for (Index i = 0; i < n_events; ++i) {
+        delta[i] = ensemble->occ_delta_value(events[i].linear_site_index,
+                                             events[i].new_occ);
+      }
+      return;
+    }
+    clexulator::ClusterExpansion &clex = *formation_energy_clex;
+    for (Index i = 0; i < n_events; ++i) {
+      delta[i] = clex.occ_delta_value(events[i].linear_site_index,
+                                      events[i].new_occ);
+    }
+  }
 };
 
 class CanonicalCalculator : public BaseMonteCalculator {
@@ -202,6 +381,10 @@ class CanonicalCalculator : public BaseMonteCalculator {
       std::shared_ptr<MonteCalculator> const &calculation) const override {
     std::vector<results_analysis_function_type> functions = {
         monte_calculator::make_heat_capacity_f(calculation)};
+    for (auto const &pair : get_system(calculation).multiclex_data) {
+      functions.push_back(
+          monte_calculator::make_eci_ensemble_f(calculation, pair.first));
+    }
 
     std::map<std::string, results_analysis_function_type> function_map;
     for (auto const &f : functions) {
@@ -366,6 +549,15 @@ class CanonicalCalculator : public BaseMonteCalculator {
   ///     If both are not present, one is set from the other.
   /// \param occ_location Optional occupation location tracking. Not required
   ///     for potential evaluation. Required for a Monte Carlo run.
+  ///
+  /// If "reuse_state_data" is true, and `state` and `occ_location` are the
+  /// same objects, in the same supercell, as for the previous call, and the
+  /// composition conditions are unchanged, then the existing state data and
+  /// potential are kept, and only the conditions are validated and updated.
+  ///
+  /// Otherwise, if `state` has the same supercell and occupation fingerprint
+  /// as the final state of the previous run, and the composition conditions
+  /// are unchanged, the occupation composition is not recalculated.
   void set_state_and_potential(state_type &state,
                                monte::OccLocation *occ_location) override {
     // Validate system
@@ -374,8 +566,17 @@ class CanonicalCalculator : public BaseMonteCalculator {
           "Error in CanonicalCalculator::run: system==nullptr");
     }
 
-    // Validate state
-    Validator v = this->validate_state(state);
+    if (this->reuse_state_data &&
+        this->_rebind_conditions(state, occ_location)) {
+      return;
+    }
+
+    // Validate state, skipping the composition check of the occupation if
+    // it is unmodified since the end of the previous run
+    Validator v = this->validate_conditions(state);
+    if (v.valid() && !this->_is_trusted_state(state)) {
+      v = this->validate_state(state);
+    }
     print(CASM::log(), v);
     if (!v.valid()) {
       throw std::runtime_error(
@@ -385,9 +586,16 @@ class CanonicalCalculator : public BaseMonteCalculator {
     // Make state data
     this->state_data =
         std::make_shared<StateData>(this->system, &state, occ_location);
+    set_parallel_corr(*this->state_data, this->clex_n_threads);
 
     // Make potential calculator
-    this->potential = std::make_shared<CanonicalPotential>(this->state_data);
+    this->potential = std::make_shared<CanonicalPotential>(
+        this->state_data, nullptr, this->ensemble_params);
+
+    // Canonical events do not change the composition, so the occupation
+    // remains consistent with these composition conditions
+    this->validated_mol_composition =
+        get_mol_composition(*this->system, state.conditions);
   }
 
   /// \brief Perform a single run, evolving current state
@@ -405,36 +613,139 @@ class CanonicalCalculator : public BaseMonteCalculator {
     //    random_number_generator);
 
     // Get temperature
-    double temperature = state.conditions.scalar_values.at("temperature");
+    double temperature = this->state_data->conditions->temperature;
+
+    if (this->metropolis_method == "checkerboard") {
+      this->_run_checkerboard(state, occ_location, temperature, run_manager);
+      this->_trust_state(state);
+      return;
+    }
 
-    // Make delta potential function
+    // The potential and event generator are used through their concrete
+    // types, so that the Metropolis step is inlined
+    CanonicalPotential &potential =
+        static_cast<CanonicalPotential &>(*this->potential);
+
+    // Make delta potential function; proposals which do not change the
+    // occupation are rejected
     auto potential_occ_delta_per_supercell_f =
-        [=](monte::OccEvent const &event) {
-          return this->potential->occ_delta_per_supercell(
-              event.linear_site_index, event.new_occ);
+        [&](monte::OccEvent const &event) {
+          if (is_null_event(event)) {
+            return std::numeric_limits<double>::infinity();
+          }
+          return potential.occ_delta_per_supercell(event.linear_site_index,
+                                                   event.new_occ);
         };
 
-    // Make event generator
-    auto event_generator = std::make_shared<CanonicalEventGenerator>(
-        get_canonical_swaps(*this->system));
-    event_generator->set(&state, &occ_location);
+    // Make event generator, or reuse it if the system is unchanged
+    if (this->event_generator == nullptr ||
+        this->event_generator_system != this->system) {
+      this->event_generator = std::make_shared<CanonicalEventGenerator>(
+          get_canonical_swaps(*this->system));
+      this->event_generator_system = this->system;
+    }
+    CanonicalEventGenerator &event_generator = *this->event_generator;
+    event_generator.set_proposal_block_size(
+        this->metropolis_proposal_block_size);
+    event_generator.set(&state, &occ_location);
+    event_generator.set_local_swap(
+        this->metropolis_proposal == "local" ? this->system.get() : nullptr,
+        this->local_swap_max_distance);
+    std::shared_ptr<clexulator::SuperNeighborList> prefetch_neighbor_list;
+    if (this->metropolis_prefetch) {
+      prefetch_neighbor_list =
+          get_supercell_neighbor_list(*this->system, state);
+    }
+    event_generator.set_prefetch(prefetch_neighbor_list.get());
 
     // Make event proposal function
     auto propose_event_f =
-        [=](monte::RandomNumberGenerator<engine_type> &random_number_generator)
-        -> monte::OccEvent const & {
-      return event_generator->propose(random_number_generator);
+        [&](auto &random_number_generator) -> monte::OccEvent const & {
+      return event_generator.propose(random_number_generator);
     };
 
+    // Track the number of each component as events are applied, so that
+    // composition sampling does not depend on the supercell size
+    this->state_data->component_counts = std::make_shared<ComponentCounts>(
+        get_composition_calculator(*this->system), *this->state_data->convert,
+        get_occupation(state));
+    ComponentCounts &component_counts = *this->state_data->component_counts;
+
+    // Track sampled correlations and cluster expansion values as events are
+    // applied, so that sampling does not depend on the supercell size
+    this->state_data->clex_trackers = std::make_shared<ClexTrackers>(
+        this->state_data->n_unitcells, this->clex_tracker_reset_interval);
+    ClexTrackers &clex_trackers = *this->state_data->clex_trackers;
+
+    // Calculate intermediate values shared by sampling functions once per
+    // sample
+    this->state_data->sample_cache = std::make_shared<SampleCache>();
+    SampleCache &sample_cache = *this->state_data->sample_cache;
+
+    // Time the phases of the main loop, if built with
+    // CASM_CLEXMONTE_LOOP_PROFILE
+    this->loop_profile.reset();
+
+    // With an ensemble formation energy, track the values of all members,
+    // reusing the changes the potential evaluated for accepted events
+    EnsembleClusterExpansion *ensemble = nullptr;
+    if (potential.ensemble.has_value()) {
+      ensemble = &potential.ensemble.value();
+      clex_trackers.get_multiclex(
+          this->ensemble_params->multiclex_key, ensemble->multiclex(),
+          [=](monte::OccEvent const &event) -> Eigen::VectorXd const & {
+            return ensemble->occ_delta_values(event);
+          });
+    }
+
     // Make event application function
-    auto apply_event_f = [=](monte::OccEvent const &occ_event) -> void {
-      return event_generator->apply(occ_event);
+    auto apply_event_f = [&](monte::OccEvent const &occ_event) -> void {
+      clex_trackers.apply(occ_event);
+      if (ensemble) {
+        ensemble->invalidate();
+      }
+      component_counts.apply(occ_event, get_occupation(state));
+      sample_cache.invalidate();
+      event_generator.apply(occ_event);
     };
 
-    // Run Monte Carlo at a single condition
-    clexmonte::occupation_metropolis_v2(
-        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
-        propose_event_f, apply_event_f, run_manager);
+    // Check for due samples and completion every step, or once per pass
+    Index steps_per_check =
+        this->metropolis_check_by_pass ? occ_location.mol_size() : 1;
+
+    if (this->metropolis_batch_size > 1) {
+      // Make batched delta potential function
+      auto potential_occ_delta_batch_f =
+          [&](std::vector<monte::OccEvent> const &events, Index n_events,
+              double *delta) {
+            potential.occ_delta_per_supercell_batch(events, n_events, delta);
+          };
+
+      // Run Monte Carlo at a single condition
+      clexmonte::occupation_metropolis_batched(
+          state, occ_location, temperature, potential_occ_delta_batch_f,
+          propose_event_f, apply_event_f, this->metropolis_batch_size,
+          run_manager, this->metropolis_acceptance_table_params,
+          &this->loop_profile, this->telemetry.get(), this->run_control.get(),
+          steps_per_check, this->metropolis_buffered_random_numbers);
+    } else {
+      // Run Monte Carlo at a single condition
+      clexmonte::occupation_metropolis_v2(
+          state, occ_location, temperature,
+          potential_occ_delta_per_supercell_f, propose_event_f, apply_event_f,
+          run_manager, this->metropolis_acceptance_table_params,
+          &this->loop_profile, this->telemetry.get(), this->run_control.get(),
+          steps_per_check, this->metropolis_buffered_random_numbers);
+    }
+
+    print_loop_profile(CASM::log(), this->loop_profile);
+
+    // Occupation may be modified outside of the run
+    this->state_data->component_counts.reset();
+    this->state_data->clex_trackers.reset();
+    this->state_data->sample_cache.reset();
+
+    this->_trust_state(state);
   }
 
   /// \brief Perform a single run, evolving one or more states
@@ -445,9 +756,355 @@ class CanonicalCalculator : public BaseMonteCalculator {
         "Error: CanonicalCalculator does not allow multi-state runs");
   }
 
+  /// \brief Perform a replica exchange (parallel tempering) run, evolving
+  ///     each state at its own conditions with its own run manager
+  ///
+  /// Replicas are evolved concurrently using up to "n_threads" threads, and
+  /// configurations of neighboring replicas are exchanged every
+  /// "replica_exchange_interval" passes. States must have the same
+  /// composition, and may differ in temperature. See
+  /// `replica_exchange_metropolis` for details.
+  void run_replica_exchange(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<std::shared_ptr<run_manager_type<engine_type>>> const
+          &run_managers) override {
+    if (this->metropolis_method != "serial") {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_replica_exchange: "
+          "replica exchange requires \"metropolis_method\"=\"serial\"");
+    }
+    if (occ_locations.size() != states.size()) {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_replica_exchange: "
+          "states.size() != occ_locations.size()");
+    }
+
+    std::vector<double> temperatures;
+    std::vector<MetropolisReplica<engine_type>> replicas =
+        this->_make_replicas(states, occ_locations, temperatures);
+
+    auto set_current_replica_f = [=](Index i) {
+      this->set_thread_current_state(i);
+    };
+
+    clexmonte::replica_exchange_metropolis(
+        states, occ_locations, temperatures, replicas, set_current_replica_f,
+        this->replica_exchange_interval, this->n_threads, run_managers,
+        this->replica_exchange_counts);
+    this->set_thread_current_state(-1);
+
+    // Leave the first replica as the current state
+    this->current_state = 0;
+    this->state_data = this->multistate_data[0];
+    this->potential = this->multistate_potential[0];
+
+    print_replica_exchange_counts(CASM::log(), this->replica_exchange_counts);
+  }
+
+  /// \brief Perform a run of independent chains of the same state, with
+  ///     pooled observations
+  ///
+  /// Chains are evolved concurrently using up to "n_threads" threads, and
+  /// all chains are sampled by `run_manager`, so the completion check uses
+  /// the pooled observations. States must have the same conditions. See
+  /// `parallel_chains_metropolis` for details.
+  void run_parallel_chains(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      run_manager_type<engine_type> &run_manager) override {
+    if (this->metropolis_method != "serial") {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_parallel_chains: "
+          "parallel chains require \"metropolis_method\"=\"serial\"");
+    }
+    if (occ_locations.size() != states.size()) {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_parallel_chains: "
+          "states.size() != occ_locations.size()");
+    }
+
+    std::vector<double> temperatures;
+    std::vector<MetropolisReplica<engine_type>> chains =
+        this->_make_replicas(states, occ_locations, temperatures);
+    for (double temperature : temperatures) {
+      if (!CASM::almost_equal(temperature, temperatures[0])) {
+        throw std::runtime_error(
+            "Error in CanonicalCalculator::run_parallel_chains: all states "
+            "must have the same temperature");
+      }
+    }
+
+    auto set_current_chain_f = [=](Index i) {
+      this->set_thread_current_state(i);
+    };
+
+    clexmonte::parallel_chains_metropolis(
+        states, occ_locations, temperatures[0], chains, set_current_chain_f,
+        this->n_threads, run_manager);
+    this->set_thread_current_state(-1);
+
+    // Leave the first chain as the current state
+    this->current_state = 0;
+    this->state_data = this->multistate_data[0];
+    this->potential = this->multistate_potential[0];
+  }
+
+  /// \brief Perform a Wang-Landau run, estimating the density of states
+  ///     of the formation energy with one walker per energy window
+  ///
+  /// Walkers are evolved concurrently using up to "n_threads" threads.
+  /// States must have the same composition; their temperature is not used.
+  /// See `wang_landau_metropolis` for details.
+  void run_wang_landau(std::vector<state_type> &states,
+                       std::vector<monte::OccLocation> &occ_locations,
+                       WangLandauParams const &params,
+                       std::shared_ptr<engine_type> engine) override {
+    if (occ_locations.size() != states.size()) {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_wang_landau: "
+          "states.size() != occ_locations.size()");
+    }
+    if (!engine) {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_wang_landau: engine==nullptr");
+    }
+    if (this->metropolis_proposal != "global") {
+      throw std::runtime_error(
+          "Error in CanonicalCalculator::run_wang_landau: Wang-Landau runs "
+          "require \"metropolis_proposal\"=\"global\"");
+    }
+
+    std::vector<double> temperatures;
+    std::vector<MetropolisReplica<engine_type>> walkers =
+        this->_make_replicas(states, occ_locations, temperatures);
+
+    auto set_current_walker_f = [=](Index i) {
+      this->set_thread_current_state(i);
+    };
+
+    this->wang_landau_results = clexmonte::wang_landau_metropolis(
+        occ_locations, walkers, set_current_walker_f,
+        this->state_data->n_unitcells, params, this->n_threads, *engine);
+    this->set_thread_current_state(-1);
+
+    // Leave the first walker as the current state
+    this->current_state = 0;
+    this->state_data = this->multistate_data[0];
+    this->potential = this->multistate_potential[0];
+  }
+
+  /// \brief Set state data and construct potential calculator and event
+  ///     generator for each of several states, which must have the same
+  ///     composition
+  ///
+  /// \param states The states
+  /// \param occ_locations Occupant location trackers, one per state
+  /// \param temperatures Set to the temperature of each state
+  /// \return The functions used to evolve each state
+  std::vector<MetropolisReplica<engine_type>> _make_replicas(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<double> &temperatures) {
+    // Set state data and construct potential calculator and event generator,
+    // for each replica. Each potential uses the formation energy cluster
+    // expansion of its own StateData, so replicas are independent.
+    this->multistate_data.clear();
+    this->multistate_potential.clear();
+    temperatures.clear();
+    std::vector<MetropolisReplica<engine_type>> replicas;
+    for (Index i = 0; i < states.size(); ++i) {
+      this->set_state_and_potential(states[i], &occ_locations[i]);
+      auto potential = std::make_shared<CanonicalPotential>(
+          this->state_data, this->state_data->clex.at("formation_energy"),
+          this->ensemble_params);
+      this->multistate_data.push_back(this->state_data);
+      this->multistate_potential.push_back(potential);
+      temperatures.push_back(this->state_data->conditions->temperature);
+
+      // Configurations must be consistent with the conditions of all states
+      if (!CASM::almost_equal(
+              get_mol_composition(*this->system, states[i].conditions),
+              get_mol_composition(*this->system, states[0].conditions),
+              this->mol_composition_tol)) {
+        throw std::runtime_error(
+            "Error in CanonicalCalculator::_make_replicas: all states "
+            "must have the same composition");
+      }
+
+      auto event_generator = std::make_shared<CanonicalEventGenerator>(
+          get_canonical_swaps(*this->system));
+      event_generator->set(&states[i], &occ_locations[i]);
+      event_generator->set_local_swap(
+          this->metropolis_proposal == "local" ? this->system.get() : nullptr,
+          this->local_swap_max_distance);
+
+      MetropolisReplica<engine_type> replica;
+      replica.potential_occ_delta_per_supercell_f =
+          [=](monte::OccEvent const &event) {
+            if (is_null_event(event)) {
+              return std::numeric_limits<double>::infinity();
+            }
+            return potential->occ_delta_per_supercell(event.linear_site_index,
+                                                      event.new_occ);
+          };
+      replica.potential_per_supercell_f = [=]() {
+        return potential->per_supercell();
+      };
+      replica.propose_event_f =
+          [=](monte::RandomNumberGenerator<engine_type>
+                  &random_number_generator) -> monte::OccEvent const & {
+        return event_generator->propose(random_number_generator);
+      };
+      replica.apply_event_f = [=](monte::OccEvent const &occ_event) {
+        event_generator->apply(occ_event);
+      };
+      replicas.push_back(replica);
+    }
+    return replicas;
+  }
+
+  /// \brief Keep the current state data and potential, updating only the
+  ///     conditions, if they were made for the same state, occupant tracker,
+  ///     and supercell, at the same composition
+  ///
+  /// \returns True if the conditions were updated, false if the state data
+  ///     and potential must be constructed
+  bool _rebind_conditions(state_type &state, monte::OccLocation *occ_location) {
+    if (this->state_data == nullptr || this->potential == nullptr ||
+        this->state_data->system != this->system ||
+        this->state_data->state != &state ||
+        this->state_data->occ_location != occ_location ||
+        this->state_data->transformation_matrix_to_super !=
+            get_transformation_matrix_to_super(state)) {
+      return false;
+    }
+
+    // Only the conditions need validation; the occupation composition is
+    // not recalculated, because it can not have changed if the composition
+    // conditions are unchanged and the occupation was only changed by
+    // canonical events since the last full validation
+    Validator v = this->validate_conditions(state);
+    if (!v.valid()) {
+      return false;
+    }
+    if (!CASM::almost_equal(
+            get_mol_composition(*this->system, state.conditions),
+            this->validated_mol_composition, this->mol_composition_tol)) {
+      return false;
+    }
+
+    this->state_data->conditions = make_conditions(*this->system, state);
+    CanonicalPotential &potential =
+        static_cast<CanonicalPotential &>(*this->potential);
+    potential.param_composition =
+        get_param_composition(*this->system, state.conditions);
+    return true;
+  }
+
+  /// \brief Record that the occupation of `state`, in its supercell, is
+  ///     consistent with the validated composition
+  ///
+  /// Called at the end of a run, because canonical events do not change the
+  /// composition.
+  void _trust_state(state_type const &state) {
+    this->trusted_system = this->system;
+    this->trusted_transformation_matrix_to_super =
+        get_transformation_matrix_to_super(state);
+    this->trusted_occupation_fingerprint = get_occupation_fingerprint(state);
+  }
+
+  /// \brief Check if `state` has the occupation recorded by `_trust_state`,
+  ///     and composition conditions equal to the validated composition
+  ///
+  /// The conditions of `state` must already be validated. Only the
+  /// fingerprint is O(N), so this avoids calculating the composition for
+  /// the states of a series of dependent runs.
+  bool _is_trusted_state(state_type const &state) const {
+    if (!this->trusted_occupation_fingerprint.has_value() ||
+        this->trusted_system != this->system ||
+        this->trusted_transformation_matrix_to_super !=
+            get_transformation_matrix_to_super(state)) {
+      return false;
+    }
+    if (!CASM::almost_equal(
+            get_mol_composition(*this->system, state.conditions),
+            this->validated_mol_composition, this->mol_composition_tol)) {
+      return false;
+    }
+    return *this->trusted_occupation_fingerprint ==
+           get_occupation_fingerprint(state);
+  }
+
+  /// \brief Run checkerboard Metropolis Monte Carlo at a single condition
+  void _run_checkerboard(state_type &state, monte::OccLocation &occ_location,
+                         double temperature,
+                         run_manager_type<engine_type> &run_manager) {
+    Eigen::Matrix3l const &T = get_transformation_matrix_to_super(state);
+    CheckerboardEventProposer proposer(
+        T, get_index_conversions(*this->system, state),
+        get_canonical_swaps(*this->system), true /*is_canonical*/);
+    Index reach = unitcell_reach(get_required_update_neighborhood(
+        *this->system, get_clex_data(*this->system, "formation_energy")));
+    CheckerboardColoring coloring(T, proposer.required_spacing(reach));
+
+    // One potential calculator per thread, the first using this->potential
+    std::vector<std::shared_ptr<CanonicalPotential>> potentials;
+    potentials.push_back(
+        std::static_pointer_cast<CanonicalPotential>(this->potential));
+    for (Index i = 1; i < this->n_threads; ++i) {
+      potentials.push_back(std::make_shared<CanonicalPotential>(
+          this->state_data,
+          make_independent_clex(*this->system, state, "formation_energy")));
+    }
+    std::vector<std::function<double(monte::OccEvent const &)>>
+        potential_occ_delta_per_supercell_f;
+    for (auto const &potential : potentials) {
+      potential_occ_delta_per_supercell_f.push_back(
+          [=](monte::OccEvent const &event) {
+            return potential->occ_delta_per_supercell(event.linear_site_index,
+                                                      event.new_occ);
+          });
+    }
+
+    clexmonte::checkerboard_occupation_metropolis(
+        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
+        proposer, coloring, run_manager);
+  }
+
   // --- Parameters ---
   int verbosity_level = 10;
   double mol_composition_tol = CASM::TOL;
+  std::string metropolis_method = "serial";
+  Index n_threads = 1;
+  Index replica_exchange_interval = 1;
+  Index metropolis_batch_size = 1;
+  bool metropolis_check_by_pass = false;
+  bool metropolis_buffered_random_numbers = false;
+  Index metropolis_proposal_block_size = 1;
+  bool metropolis_prefetch = false;
+  std::string metropolis_proposal = "global";
+  double local_swap_max_distance = 0.0;
+  MetropolisAcceptanceTableParams metropolis_acceptance_table_params;
+  Index clex_tracker_reset_interval = 10000;
+  Index clex_n_threads = 1;
+  bool reuse_state_data = false;
+  std::optional<EnsembleClusterExpansionParams> ensemble_params;
+
+  // --- Reused by `set_state_and_potential` and `run`: ---
+
+  /// \brief Target composition the current state data was validated for
+  Eigen::VectorXd validated_mol_composition;
+
+  /// \brief Supercell and occupation fingerprint of the final state of the
+  ///     previous run, which is consistent with `validated_mol_composition`
+  std::shared_ptr<system_type> trusted_system;
+  Eigen::Matrix3l trusted_transformation_matrix_to_super;
+  std::optional<std::uint64_t> trusted_occupation_fingerprint;
+
+  /// \brief Event generator, and the system it was made for
+  std::shared_ptr<CanonicalEventGenerator> event_generator;
+  std::shared_ptr<system_type> event_generator_system;
 
   /// \brief Reset the derived Monte Carlo calculator
   ///
@@ -459,6 +1116,110 @@ class CanonicalCalculator : public BaseMonteCalculator {
   ///       - "standard" is equivalent to integer value 10
   ///       - "verbose" is equivalent to integer value 20
   ///       - "debug" is equivalent to integer value 100
+  ///   metropolis_method: str, default="serial"
+  ///       One of:
+  ///       - "serial": propose and accept or reject one event at a time
+  ///       - "checkerboard": propose events in non-interacting unit cells
+  ///         concurrently, using "n_threads" threads. Events are swaps
+  ///         between a site and a site in the same or a neighboring unit
+  ///         cell. Requires a diagonal supercell transformation matrix, with
+  ///         each diagonal element 1 or a multiple of the color spacing
+  ///         required by the formation energy cluster expansion neighborhood.
+  ///   metropolis_batch_size: int, default=1
+  ///       For "serial", the number of events proposed from the current state
+  ///       and evaluated together. Events are then accepted or rejected in
+  ///       order until one is accepted, and the rest are discarded, so
+  ///       results are statistically identical to one event at a time.
+  ///       Values > 1 reduce per-event overhead when the acceptance rate is
+  ///       low.
+  ///   metropolis_check_by_pass: bool, default=false
+  ///       For "serial", if true, check for due samples and for completion
+  ///       once per pass, on pass boundaries, rather than after every step.
+  ///       Requires that no sampling fixture samples by step. Cutoffs in
+  ///       steps may be exceeded by less than one pass.
+  ///   metropolis_buffered_random_numbers: bool, default=false
+  ///       For "serial", if true, random numbers for event proposal and
+  ///       acceptance are drawn in blocks (see
+  ///       `BufferedRandomNumberGenerator`), which reduces the cost per
+  ///       draw. Results for a given seed differ from those with the
+  ///       default.
+  ///   metropolis_proposal_block_size: int, default=1
+  ///       For "serial", if > 1, swaps are proposed from blocks of this many
+  ///       pre-drawn proposals, which are discarded only when an accepted
+  ///       event changes the number of candidates of some type. Proposals
+  ///       have the same distribution, but results for a given seed differ
+  ///       from those with the default value of 1.
+  ///   metropolis_prefetch: bool, default=false
+  ///       For "serial", with "metropolis_proposal_block_size" > 1, if true,
+  ///       the supercell neighbor list entries and occupation of the sites
+  ///       of the next proposal are prefetched while the current proposal is
+  ///       evaluated. May improve performance in large supercells.
+  ///   metropolis_proposal: str, default="global"
+  ///       For "serial", and for replica exchange and parallel chain runs,
+  ///       one of:
+  ///       - "global": swap two random sites anywhere in the supercell
+  ///       - "local": swap a random site with a random neighbor (local,
+  ///         or Kawasaki, exchange), which is accepted more often at low
+  ///         temperature and near ordered states. A proposal of a swap of
+  ///         identical species counts as a rejected event. Not supported
+  ///         with "metropolis_batch_size" > 1,
+  ///         "metropolis_proposal_block_size" > 1, or Wang-Landau runs.
+  ///   local_swap_max_distance: float, default=0.0
+  ///       For "metropolis_proposal"="local", sites within this Cartesian
+  ///       distance are neighbors. If 0.0, the nearest neighbor shell of
+  ///       the sublattices with canonical swaps is used.
+  ///   metropolis_acceptance_tol: float, default=0.0
+  ///       For "serial", if > 0.0, changes in potential energy are rounded to
+  ///       the nearest multiple of this value and acceptance probabilities
+  ///       are read from a precomputed table rather than calculated with
+  ///       `exp`. Useful when energy changes take a small set of discrete
+  ///       values, as for integer-like ECI. The table is disabled
+  ///       automatically if energy changes are too widely distributed. If
+  ///       0.0, no table is used.
+  ///   metropolis_acceptance_table_size: int, default=4096
+  ///       Maximum number of entries in the acceptance probability table.
+  ///   clex_tracker_reset_interval: int, default=10000
+  ///       For "serial", sampled correlations, cluster expansion values,
+  ///       and order parameters are updated incrementally as events are
+  ///       applied, and recalculated for the full supercell when sampled
+  ///       after this many events have been applied, to control round-off
+  ///       drift.
+  ///   clex_n_threads: int, default=1
+  ///       Number of threads used to calculate correlations and cluster
+  ///       expansion values for the full supercell when they are sampled
+  ///       and not updated incrementally. Results only differ by round-off
+  ///       from the single-threaded calculation.
+  ///   reuse_state_data: bool, default=false
+  ///       If true, runs on the same state object and supercell as the
+  ///       previous run, at the same composition, reuse the state data,
+  ///       potential, and event generator, and only update the conditions.
+  ///       Useful for sweeps over many temperatures with "dependent_runs".
+  ///       Requires that the occupation is only changed by canonical runs
+  ///       between runs, because it is not re-validated.
+  ///
+  ///   ensemble_formation_energy: dict, optional
+  ///       If given, the formation energy is one coefficient set, or the
+  ///       mean of all coefficient sets, of a multi-cluster expansion, for
+  ///       instance an ensemble of bootstrap fits, rather than the
+  ///       "formation_energy" cluster expansion. The changes of all
+  ///       coefficient sets due to each proposed event are evaluated
+  ///       together, and for "serial" runs they are reused to update
+  ///       "multiclex.<key>" when events are accepted. Not supported with
+  ///       "checkerboard". Format:
+  ///
+  ///           {
+  ///             "multiclex": str,  // multi-cluster expansion name
+  ///             "member": "mean" | str | int  // default="mean"
+  ///           }
+  ///
+  ///   n_threads: int, default=1
+  ///       For "checkerboard", the number of threads. For replica exchange,
+  ///       parallel chain, and Wang-Landau runs, the maximum number of
+  ///       threads replicas, chains, or walkers are evolved on.
+  ///
+  ///   replica_exchange_interval: int, default=1
+  ///       For replica exchange runs, the number of passes between attempts
+  ///       to exchange the configurations of neighboring replicas.
   void _reset() override {
     ParentInputParser parser{params};
 
@@ -470,6 +1231,145 @@ class CanonicalCalculator : public BaseMonteCalculator {
     this->mol_composition_tol = CASM::TOL;
     parser.optional(this->mol_composition_tol, "mol_composition_tol");
 
+    // "metropolis_method": str, default="serial"
+    this->metropolis_method = "serial";
+    parser.optional(this->metropolis_method, "metropolis_method");
+    if (this->metropolis_method != "serial" &&
+        this->metropolis_method != "checkerboard") {
+      parser.insert_error("metropolis_method",
+                          "Error: \"metropolis_method\" must be one of "
+                          "\"serial\", \"checkerboard\"");
+    }
+
+    // "n_threads": int, default=1
+    this->n_threads = 1;
+    parser.optional(this->n_threads, "n_threads");
+    if (this->n_threads < 1) {
+      parser.insert_error("n_threads", "Error: \"n_threads\" must be >= 1");
+    }
+
+    // "metropolis_batch_size": int, default=1
+    this->metropolis_batch_size = 1;
+    parser.optional(this->metropolis_batch_size, "metropolis_batch_size");
+    if (this->metropolis_batch_size < 1) {
+      parser.insert_error("metropolis_batch_size",
+                          "Error: \"metropolis_batch_size\" must be >= 1");
+    }
+
+    // "metropolis_check_by_pass": bool, default=false
+    this->metropolis_check_by_pass = false;
+    parser.optional(this->metropolis_check_by_pass,
+                    "metropolis_check_by_pass");
+
+    // "metropolis_buffered_random_numbers": bool, default=false
+    this->metropolis_buffered_random_numbers = false;
+    parser.optional(this->metropolis_buffered_random_numbers,
+                    "metropolis_buffered_random_numbers");
+
+    // "metropolis_proposal_block_size": int, default=1
+    this->metropolis_proposal_block_size = 1;
+    parser.optional(this->metropolis_proposal_block_size,
+                    "metropolis_proposal_block_size");
+    if (this->metropolis_proposal_block_size < 1) {
+      parser.insert_error(
+          "metropolis_proposal_block_size",
+          "Error: \"metropolis_proposal_block_size\" must be >= 1");
+    }
+
+    // "metropolis_prefetch": bool, default=false
+    this->metropolis_prefetch = false;
+    parser.optional(this->metropolis_prefetch, "metropolis_prefetch");
+
+    // "metropolis_proposal": str, default="global"
+    this->metropolis_proposal = "global";
+    parser.optional(this->metropolis_proposal, "metropolis_proposal");
+    if (this->metropolis_proposal != "global" &&
+        this->metropolis_proposal != "local") {
+      parser.insert_error("metropolis_proposal",
+                          "Error: \"metropolis_proposal\" must be one of "
+                          "\"global\", \"local\"");
+    }
+    if (this->metropolis_proposal == "local" &&
+        (this->metropolis_method != "serial" ||
+         this->metropolis_batch_size > 1 ||
+         this->metropolis_proposal_block_size > 1)) {
+      parser.insert_error(
+          "metropolis_proposal",
+          "Error: \"metropolis_proposal\"=\"local\" requires "
+          "\"metropolis_method\"=\"serial\", \"metropolis_batch_size\"=1, "
+          "and \"metropolis_proposal_block_size\"=1");
+    }
+
+    // "local_swap_max_distance": float, default=0.0
+    this->local_swap_max_distance = 0.0;
+    parser.optional(this->local_swap_max_distance, "local_swap_max_distance");
+    if (this->local_swap_max_distance < 0.0) {
+      parser.insert_error("local_swap_max_distance",
+                          "Error: \"local_swap_max_distance\" must be >= 0.0");
+    }
+
+    // "metropolis_acceptance_tol": float, default=0.0
+    this->metropolis_acceptance_table_params =
+        MetropolisAcceptanceTableParams();
+    parser.optional(this->metropolis_acceptance_table_params.tolerance,
+                    "metropolis_acceptance_tol");
+    if (this->metropolis_acceptance_table_params.tolerance < 0.0) {
+      parser.insert_error(
+          "metropolis_acceptance_tol",
+          "Error: \"metropolis_acceptance_tol\" must be >= 0.0");
+    }
+
+    // "metropolis_acceptance_table_size": int, default=4096
+    parser.optional(this->metropolis_acceptance_table_params.max_size,
+                    "metropolis_acceptance_table_size");
+    if (this->metropolis_acceptance_table_params.max_size < 1) {
+      parser.insert_error(
+          "metropolis_acceptance_table_size",
+          "Error: \"metropolis_acceptance_table_size\" must be >= 1");
+    }
+
+    // "clex_tracker_reset_interval": int, default=10000
+    this->clex_tracker_reset_interval = 10000;
+    parser.optional(this->clex_tracker_reset_interval,
+                    "clex_tracker_reset_interval");
+    if (this->clex_tracker_reset_interval < 1) {
+      parser.insert_error(
+          "clex_tracker_reset_interval",
+          "Error: \"clex_tracker_reset_interval\" must be >= 1");
+    }
+
+    // "clex_n_threads": int, default=1
+    this->clex_n_threads = 1;
+    parser.optional(this->clex_n_threads, "clex_n_threads");
+    if (this->clex_n_threads < 1) {
+      parser.insert_error("clex_n_threads",
+                          "Error: \"clex_n_threads\" must be >= 1");
+    }
+
+    // "reuse_state_data": bool, default=false
+    this->reuse_state_data = false;
+    parser.optional(this->reuse_state_data, "reuse_state_data");
+
+    // "ensemble_formation_energy": dict, optional
+    parse_ensemble_formation_energy(parser, *this->system,
+                                    this->ensemble_params);
+    if (this->ensemble_params.has_value() &&
+        this->metropolis_method == "checkerboard") {
+      parser.insert_error("ensemble_formation_energy",
+                          "Error: \"ensemble_formation_energy\" is not "
+                          "supported with \"metropolis_method\"="
+                          "\"checkerboard\"");
+    }
+
+    // "replica_exchange_interval": int, default=1
+    this->replica_exchange_interval = 1;
+    parser.optional(this->replica_exchange_interval,
+                    "replica_exchange_interval");
+    if (this->replica_exchange_interval < 1) {
+      parser.insert_error("replica_exchange_interval",
+                          "Error: \"replica_exchange_interval\" must be >= 1");
+    }
+
     // TODO: enumeration
 
     std::stringstream ss;
@@ -0,0 +1,796 @@
+#include <chrono>
+
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/kinetic/AutoTuner.hh"
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+#include "casm/clexmonte/kinetic/kinetic.hh"
+#include "casm/clexmonte/kinetic/kinetic_json_io.hh"
+#include "casm/clexmonte/monte_calculator/BaseMonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/analysis_functions.hh"
+#include "casm/clexmonte/monte_calculator/modifying_functions.hh"
+#include "casm/clexmonte/monte_calculator/sampling_functions.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Kinetic Monte Carlo potential, the formation energy
+///
+/// The potential is not used to select events; it is only used by the
+/// "potential_energy" sampling function.
+class KineticPotential final : public BaseMontePotential {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _state_data State data
+  KineticPotential(std::shared_ptr<StateData> _state_data)
+      : BaseMontePotential(_state_data),
+        formation_energy_clex(get_clex(*state_data->system,
+                                       *state_data->state,
+                                       "formation_energy")) {}
+
+  std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex;
+
+  /// \brief Calculate (per_supercell) potential value
+  double per_supercell() override {
+    return formation_energy_clex->per_supercell();
+  }
+
+  /// \brief Calculate (per_unitcell) potential value
+  double per_unitcell() override {
+    return formation_energy_clex->per_unitcell();
+  }
+
+  /// \brief Calculate change in (per_supercell) potential value due
+  ///     to a series of occupation changes
+  double occ_delta_per_supercell(std::vector<Index> const &linear_site_index,
+                                 std::vector<int> const &new_occ) override {
+    return formation_energy_clex->occ_delta_value(linear_site_index, new_occ);
+  }
+};
+
+/// \brief Implements kinetic Monte Carlo calculations
+///
+/// This is a MonteCalculator front end for `kinetic::Kinetic`, which
+/// constructs the event list and event calculators and runs KMC. The
+/// "params" are the same as the Kinetic "calculation_options" (see
+/// `kinetic::parse`), so the event selector, impact table, event storage,
+/// and threading options are all available. With "auto_tune", the fastest
+/// of several candidate sets of these options is chosen for each supercell
+/// by timing short calibration runs.
+class KineticCalculator : public BaseMonteCalculator {
+ public:
+  using BaseMonteCalculator::engine_type;
+  typedef kinetic::Kinetic<engine_type> kinetic_type;
+
+  KineticCalculator()
+      : BaseMonteCalculator("KineticCalculator",   // calculator_name
+                            {},                    // required_basis_set,
+                            {},                    // required_local_basis_set,
+                            {"formation_energy"},  // required_clex,
+                            {},                    // required_multiclex,
+                            {},                    // required_local_clex,
+                            {},                    // required_local_multiclex,
+                            {},                    // required_dof_spaces,
+                            {},                    // required_params,
+                            kinetic_params(),      // optional_params,
+                            true,                  // time_sampling_allowed,
+                            true,                  // update_species,
+                            false                  // is_multistate_method,
+        ) {}
+
+  /// \brief Names of the optional parameters
+  static std::set<std::string> kinetic_params() {
+    return {"verbosity",
+            "mol_composition_tol",
+            "event_filters",
+            "event_list_params",
+            "event_selector",
+            "n_threads",
+            "split_impact_neighborhoods",
+            "local_environment_cache_size",
+            "store_event_states",
+            "max_full_event_states",
+            "max_non_normal_examples",
+            "async_event_log",
+            "active_event_set",
+            "barrier_models",
+            "event_data_cache_size_mb",
+            "auto_tune",
+            "event_triggered_sampling",
+            "time_resolved_sampling"};
+  }
+
+  /// \brief Names of the parameters that "auto_tune" candidates may set
+  static std::set<std::string> auto_tune_candidate_params() {
+    return {"event_list_params",
+            "event_selector",
+            "n_threads",
+            "split_impact_neighborhoods",
+            "local_environment_cache_size",
+            "store_event_states",
+            "max_full_event_states",
+            "async_event_log",
+            "active_event_set"};
+  }
+
+  /// \brief Construct functions that may be used to sample various quantities
+  ///     of the Monte Carlo calculation as it runs
+  ///
+  /// Includes the common sampling functions, and the KMC sampling functions
+  /// of `kinetic::Kinetic` ("mean_R_squared_*", "L_*", "D_tracer_*",
+  /// "jumps_per_*", and "total_rate_by_event_type").
+  std::map<std::string, state_sampling_function_type>
+  standard_sampling_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<state_sampling_function_type> functions =
+        monte_calculator::common_sampling_functions(
+            calculation, "potential_energy",
+            "Potential energy of the state (normalized per primitive cell)");
+
+    std::map<std::string, state_sampling_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+
+    // Specific to kinetic
+    for (auto const &pair :
+         kinetic_type::standard_sampling_functions(this->kinetic)) {
+      function_map.emplace(pair.first, pair.second);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to sample various quantities
+  ///     of the Monte Carlo calculation as it runs
+  std::map<std::string, json_state_sampling_function_type>
+  standard_json_sampling_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<json_state_sampling_function_type> functions =
+        monte_calculator::common_json_sampling_functions(calculation);
+
+    std::map<std::string, json_state_sampling_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to analyze Monte Carlo
+  ///     calculation results
+  std::map<std::string, results_analysis_function_type>
+  standard_analysis_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<results_analysis_function_type> functions = {
+        monte_calculator::make_heat_capacity_f(calculation)};
+
+    std::map<std::string, results_analysis_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to modify states
+  StateModifyingFunctionMap standard_modifying_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<StateModifyingFunction> functions = {
+        monte_calculator::make_match_composition_f(calculation),
+        monte_calculator::make_enforce_composition_f(calculation)};
+
+    StateModifyingFunctionMap function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct default SamplingFixtureParams
+  sampling_fixture_params_type make_default_sampling_fixture_params(
+      std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+      bool write_results, bool write_trajectory, bool write_observations,
+      bool write_status, std::optional<std::string> output_dir,
+      std::optional<std::string> log_file,
+      double log_frequency_in_s) const override {
+    monte::SamplingParams sampling_params;
+    {
+      auto &s = sampling_params;
+      s.sampler_names = {"clex.formation_energy", "potential_energy",
+                         "mol_composition", "param_composition"};
+      std::string prefix;
+      prefix = "order_parameter_";
+      for (auto const &pair : calculation->system()->dof_spaces) {
+        s.sampler_names.push_back(prefix + pair.first);
+      }
+      prefix = "subspace_order_parameter_";
+      for (auto const &pair : calculation->system()->dof_subspaces) {
+        s.sampler_names.push_back(prefix + pair.first);
+      }
+      if (write_trajectory) {
+        s.do_sample_trajectory = true;
+      }
+    }
+
+    monte::CompletionCheckParams<statistics_type> completion_check_params;
+    {
+      auto &c = completion_check_params;
+      c.equilibration_check_f = monte::default_equilibration_check;
+      c.calc_statistics_f =
+          monte::default_statistics_calculator<statistics_type>();
+
+      converge(calculation->sampling_functions, completion_check_params)
+          .set_abs_precision("potential_energy", 0.001);
+    }
+
+    std::vector<std::string> analysis_names = {"heat_capacity"};
+
+    return clexmonte::make_sampling_fixture_params(
+        label, calculation->sampling_functions,
+        calculation->json_sampling_functions, calculation->analysis_functions,
+        sampling_params, completion_check_params, analysis_names, write_results,
+        write_trajectory, write_observations, write_status, output_dir,
+        log_file, log_frequency_in_s);
+  }
+
+  /// \brief Validate the state's configuration
+  ///
+  /// Notes:
+  /// - All configurations are valid (the composition is enforced to match
+  ///   the conditions at the start of each run)
+  Validator validate_configuration(state_type &state) const override {
+    return Validator{};
+  }
+
+  /// \brief Validate state's conditions
+  ///
+  /// Notes:
+  /// - requires scalar temperature
+  /// - requires one of vector mol_composition or param_composition
+  /// - warnings if other conditions are present
+  Validator validate_conditions(state_type &state) const override {
+    // Validate system
+    if (this->system == nullptr) {
+      throw std::runtime_error(
+          "Error in KineticCalculator::validate_conditions: system==nullptr");
+    }
+
+    // validate state.conditions
+    monte::ValueMap const &conditions = state.conditions;
+    Validator v;
+    v.insert(validate_keys(conditions.scalar_values,
+                           {"temperature"} /*required*/, {} /*optional*/,
+                           "scalar", "condition", false /*throw_if_invalid*/));
+    v.insert(
+        validate_keys(conditions.vector_values, {} /*required*/,
+                      {"param_composition", "mol_composition"} /*optional*/,
+                      "vector", "condition", false /*throw_if_invalid*/));
+    v.insert(validate_composition_consistency(
+        state, get_composition_converter(*this->system),
+        this->mol_composition_tol));
+    return v;
+  }
+
+  /// \brief Validate state
+  Validator validate_state(state_type &state) const override {
+    Validator v;
+    v.insert(this->validate_configuration(state));
+    v.insert(this->validate_conditions(state));
+    return v;
+  }
+
+  /// \brief Validate and set the current state, construct state_data, construct
+  ///     potential
+  ///
+  /// \param state Conditions is required to have `mol_composition` or
+  ///     `param_composition`. If both are not present, one is set from the
+  ///     other.
+  /// \param occ_location Optional occupation location tracking. Not required
+  ///     for potential evaluation. Required for a Monte Carlo run.
+  void set_state_and_potential(state_type &state,
+                               monte::OccLocation *occ_location) override {
+    // Validate system
+    if (this->system == nullptr) {
+      throw std::runtime_error(
+          "Error in KineticCalculator::run: system==nullptr");
+    }
+
+    // Validate state
+    Validator v = this->validate_state(state);
+    print(CASM::log(), v);
+    if (!v.valid()) {
+      throw std::runtime_error(
+          "Error in KineticCalculator::run: Invalid initial state");
+    }
+    enforce_composition_consistency(state,
+                                    get_composition_converter(*this->system),
+                                    this->mol_composition_tol);
+
+    // Make state data
+    this->state_data =
+        std::make_shared<StateData>(this->system, &state, occ_location);
+
+    // Make potential calculator
+    this->potential = std::make_shared<KineticPotential>(this->state_data);
+  }
+
+  /// \brief Perform a single run, evolving current state
+  ///
+  /// The event list and event calculators are constructed by
+  /// `kinetic::Kinetic::run`, and kept for later runs in the same supercell.
+  /// `kmc_data` refers to the KMC data of `kinetic`, so it is current
+  /// during and after the run.
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<engine_type> &run_manager) override {
+    // Set state data and construct potential calculator
+    this->set_state_and_potential(state, &occ_location);
+
+    if (this->auto_tune_params.has_value() &&
+        this->kinetic->replay_event_journal_path.empty()) {
+      this->_auto_tune(state, run_manager);
+    }
+
+    this->kinetic->run(state, occ_location, run_manager);
+
+    // Report memory again at the end of the run, to include sampled data
+    this->kinetic->memory_report =
+        this->kinetic->make_memory_report(state, occ_location, run_manager);
+  }
+
+  /// \brief KMC event list and event calculators of the current or last run
+  std::shared_ptr<kinetic::KineticEventData> kinetic_event_data()
+      const override {
+    return this->kinetic ? this->kinetic->event_data : nullptr;
+  }
+
+  /// \brief Approximate memory used by each subsystem, at the end of the
+  ///     last run, or at the start of the current run
+  MemoryReport memory_report() const override {
+    return this->kinetic ? this->kinetic->memory_report : MemoryReport();
+  }
+
+  /// \brief Perform a single run, evolving one or more states
+  void run(int current_state, std::vector<state_type> &states,
+           std::vector<monte::OccLocation> &occ_locations,
+           run_manager_type<engine_type> &run_manager) override {
+    throw std::runtime_error(
+        "Error: KineticCalculator does not allow multi-state runs");
+  }
+
+  // --- Parameters ---
+  int verbosity_level = 10;
+  double mol_composition_tol = CASM::TOL;
+
+  /// \brief The KMC implementation, constructed from the parameters by
+  ///     `_reset`
+  ///
+  /// Note: Clones share `kinetic`, so they share event data.
+  std::shared_ptr<kinetic_type> kinetic;
+
+  /// \brief Auto-tune parameters
+  struct AutoTuneParams {
+    /// \brief Complete KMC parameters of each candidate, the calculator
+    ///     parameters with the candidate's values
+    std::vector<jsonParser> candidates;
+
+    /// \brief The values given for each candidate
+    std::vector<jsonParser> candidate_values;
+
+    /// \brief Number of steps timed for each candidate
+    Index n_steps = 10000;
+
+    /// \brief Number of steps run for each candidate before timing
+    Index n_warmup_steps = 1000;
+
+    /// \brief If not empty, auto-tune results are written to this file
+    std::string output_file;
+  };
+
+  /// \brief Auto-tune parameters, if "auto_tune" is given
+  std::optional<AutoTuneParams> auto_tune_params;
+
+  /// \brief Auto-tune choices and results, if "auto_tune" is given
+  ///
+  /// Note: Clones share `auto_tuner`, as they share `kinetic`.
+  std::shared_ptr<kinetic::AutoTuner> auto_tuner;
+
+  /// \brief Reset the derived Monte Carlo calculator
+  ///
+  /// Parameters:
+  ///   verbosity: str or int, default=10
+  ///       If integer, the allowed range is `[0,100]`. If string, then:
+  ///       - "none" is equivalent to integer value 0
+  ///       - "quiet" is equivalent to integer value 5
+  ///       - "standard" is equivalent to integer value 10
+  ///       - "verbose" is equivalent to integer value 20
+  ///       - "debug" is equivalent to integer value 100
+  ///   mol_composition_tol: float, default=CASM::TOL
+  ///       Tolerance for checking the consistency of the "mol_composition"
+  ///       and "param_composition" conditions.
+  ///
+  ///   The other parameters are the kinetic Monte Carlo options
+  ///   "event_filters", "event_list_params" (including the impact table
+  ///   and event storage layout), "event_selector", "n_threads",
+  ///   "split_impact_neighborhoods", "local_environment_cache_size",
+  ///   "store_event_states", "max_full_event_states",
+  ///   "max_non_normal_examples", "async_event_log", "active_event_set",
+  ///   "barrier_models", and "event_data_cache_size_mb". See
+  ///   `kinetic::parse` for their format and defaults.
+  ///
+  ///   auto_tune: dict, optional
+  ///       If given, before the first run in each supercell, short
+  ///       calibration runs of each candidate set of KMC options are timed,
+  ///       starting from copies of the initial state and random number
+  ///       engine, and the options of the candidate with the most steps per
+  ///       second are used for all runs in that supercell. The choice and
+  ///       the steps per second of each candidate are written to the log.
+  ///       Not used when replaying an event journal. Includes:
+  ///
+  ///       candidates: List[dict]
+  ///           Each candidate is an object with values for some of
+  ///           "event_list_params", "event_selector", "n_threads",
+  ///           "split_impact_neighborhoods", "local_environment_cache_size",
+  ///           "store_event_states", "max_full_event_states",
+  ///           "async_event_log", and "active_event_set", which replace the
+  ///           values of the calculator parameters. An empty object
+  ///           calibrates the calculator parameters as given.
+  ///       n_steps: int, default=10000
+  ///           Number of KMC steps timed for each candidate.
+  ///       n_warmup_steps: int, default=1000
+  ///           Number of KMC steps run for each candidate before timing,
+  ///           which also constructs the candidate's event list, so that
+  ///           construction is not timed.
+  ///       output_file: str, optional
+  ///           If given, the calibration results of all tuned supercells
+  ///           are written to this JSON file after each is tuned.
+  ///
+  ///   event_triggered_sampling: dict, optional
+  ///       If given, the state is also sampled after each occurrence of
+  ///       selected events, such as rare solute jumps, without sampling
+  ///       after every event (see `kinetic::EventTriggeredSampler`). The
+  ///       samples of each run are available from
+  ///       `kinetic->event_triggered_sampler`. Includes:
+  ///
+  ///       prim_event_index: List[int], optional
+  ///           Prim event indices of the events which trigger a sample.
+  ///       event_type_name: List[str], optional
+  ///           Event type names of the events which trigger a sample. At
+  ///           least one prim event index or event type name is required.
+  ///       sampler_names: List[str]
+  ///           Names of the KMC sampling functions evaluated for each
+  ///           sample, such as "formation_energy" or "mol_composition".
+  ///           The displacement based "mean_R_squared_*", "L_*", and
+  ///           "D_tracer_*" functions are not allowed.
+  ///       output_file: str, optional
+  ///           If given, the samples of each run are written to this JSON
+  ///           file at the end of the run, overwriting it.
+  ///
+  ///   time_resolved_sampling: dict, optional
+  ///       If given, the state is also sampled at regular times. After each
+  ///       sample, the number of events until the next sample time is
+  ///       estimated from the event rate, and the sample time is only
+  ///       checked after a fraction of them (see
+  ///       `kinetic::TimeResolvedSampler`). The samples of each run are
+  ///       available from `kinetic->time_resolved_sampler`. Includes:
+  ///
+  ///       period: float
+  ///           Time between samples.
+  ///       begin: float, default=0.0
+  ///           Time of the first sample.
+  ///       sampler_names: List[str]
+  ///           Names of the KMC sampling functions evaluated for each
+  ///           sample. The displacement based "mean_R_squared_*", "L_*",
+  ///           and "D_tracer_*" functions are not allowed.
+  ///       lookahead: bool, default=True
+  ///           If true, skip checking the sample time for a fraction of
+  ///           the expected number of events until the next sample time.
+  ///           If false, the sample time is checked after every event, and
+  ///           all samples are exact.
+  ///       lookahead_fraction: float, default=0.5
+  ///           Fraction, in (0.0, 1.0], of the expected number of events
+  ///           until the next sample time which are not checked.
+  ///       lookahead_min_events: int, default=100
+  ///           Minimum number of events since the previous sample for the
+  ///           event rate to be used to skip checks.
+  ///       interpolate: bool, default=False
+  ///           If true, a sample time passed while checks were skipped, which
+  ///           may happen if the event rate decreases, is sampled by linear
+  ///           interpolation between the previous sample and the current
+  ///           state. Otherwise, the current state is sampled. Such samples
+  ///           are marked in the output "is_exact" array.
+  ///       output_file: str, optional
+  ///           If given, the samples of each run are written to this JSON
+  ///           file at the end of the run, overwriting it.
+  void _reset() override {
+    ParentInputParser parser{params};
+
+    // "verbosity": str or int, default=10
+    this->verbosity_level = parse_verbosity(parser);
+    CASM::log().set_verbosity(this->verbosity_level);
+
+    // "mol_composition_tol": float, default=CASM::TOL
+    this->mol_composition_tol = CASM::TOL;
+    parser.optional(this->mol_composition_tol, "mol_composition_tol");
+
+    std::stringstream ss;
+    ss << "Error in KineticCalculator: error reading calculation "
+          "parameters.";
+    std::runtime_error error_if_invalid{ss.str()};
+
+    // "auto_tune": dict, optional
+    this->auto_tune_params.reset();
+    this->auto_tuner.reset();
+    if (params.contains("auto_tune")) {
+      AutoTuneParams tune;
+      fs::path option("auto_tune");
+      parser.optional(tune.n_steps, option / "n_steps");
+      parser.optional(tune.n_warmup_steps, option / "n_warmup_steps");
+      parser.optional(tune.output_file, option / "output_file");
+      if (tune.n_steps < 1) {
+        parser.insert_error(option / "n_steps", "Error: must be >= 1");
+      }
+      if (tune.n_warmup_steps < 1) {
+        parser.insert_error(option / "n_warmup_steps", "Error: must be >= 1");
+      }
+      _parse_auto_tune_candidates(parser, tune);
+      if (parser.valid()) {
+        this->auto_tuner = std::make_shared<kinetic::AutoTuner>(
+            tune.candidate_values, tune.n_steps, tune.output_file);
+      }
+      this->auto_tune_params = std::move(tune);
+    }
+
+    // "event_triggered_sampling": dict, optional
+    std::optional<kinetic::EventTriggeredSamplingParams> sampling_params;
+    if (params.contains("event_triggered_sampling")) {
+      kinetic::EventTriggeredSamplingParams p;
+      fs::path option("event_triggered_sampling");
+      parser.optional(p.prim_event_index, option / "prim_event_index");
+      parser.optional(p.event_type_name, option / "event_type_name");
+      parser.require(p.sampler_names, option / "sampler_names");
+      std::string output_file;
+      parser.optional(output_file, option / "output_file");
+      p.output_file = output_file;
+      if (p.prim_event_index.empty() && p.event_type_name.empty()) {
+        parser.insert_error(
+            option, "Error: requires \"prim_event_index\" or "
+                    "\"event_type_name\"");
+      }
+      for (std::string const &name : p.sampler_names) {
+        if (name.rfind("mean_R_squared_", 0) == 0 || name.rfind("L_", 0) == 0 ||
+            name.rfind("D_tracer_", 0) == 0) {
+          parser.insert_error(
+              option / "sampler_names",
+              "Error: displacement based sampling function '" + name +
+                  "' cannot be used for event-triggered sampling");
+        }
+      }
+      sampling_params = std::move(p);
+    }
+
+    // "time_resolved_sampling": dict, optional
+    std::optional<kinetic::TimeResolvedSamplingParams> time_sampling_params;
+    if (params.contains("time_resolved_sampling")) {
+      kinetic::TimeResolvedSamplingParams p;
+      fs::path option("time_resolved_sampling");
+      parser.require(p.period, option / "period");
+      parser.optional(p.begin, option / "begin");
+      parser.require(p.sampler_names, option / "sampler_names");
+      parser.optional(p.lookahead, option / "lookahead");
+      parser.optional(p.lookahead_fraction, option / "lookahead_fraction");
+      parser.optional(p.lookahead_min_events,
+                      option / "lookahead_min_events");
+      parser.optional(p.interpolate, option / "interpolate");
+      std::string output_file;
+      parser.optional(output_file, option / "output_file");
+      p.output_file = output_file;
+      if (!(p.period > 0.0)) {
+        parser.insert_error(option / "period", "Error: must be > 0.0");
+      }
+      if (p.begin < 0.0) {
+        parser.insert_error(option / "begin", "Error: must be >= 0.0");
+      }
+      if (!(p.lookahead_fraction > 0.0 && p.lookahead_fraction <= 1.0)) {
+        parser.insert_error(option / "lookahead_fraction",
+                            "Error: must be in (0.0, 1.0]");
+      }
+      for (std::string const &name : p.sampler_names) {
+        if (name.rfind("mean_R_squared_", 0) == 0 || name.rfind("L_", 0) == 0 ||
+            name.rfind("D_tracer_", 0) == 0) {
+          parser.insert_error(
+              option / "sampler_names",
+              "Error: displacement based sampling function '" + name +
+                  "' cannot be used for time-resolved sampling");
+        }
+      }
+      time_sampling_params = std::move(p);
+    }
+    report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+
+    // KMC options
+    InputParser<kinetic_type> kinetic_parser{params, this->system};
+    report_and_throw_if_invalid(kinetic_parser, CASM::log(),
+                                error_if_invalid);
+    this->kinetic = std::shared_ptr<kinetic_type>(
+        std::move(kinetic_parser.value));
+
+    // KMC data for sampling functions is owned by `kinetic`
+    this->kmc_data =
+        std::shared_ptr<kmc_data_type>(this->kinetic, &this->kinetic->kmc_data);
+
+    // The samplers are owned by `kinetic`, so their sampling functions refer
+    // to `kinetic` without owning it, to avoid a reference cycle
+    std::shared_ptr<kinetic_type> unowned(std::shared_ptr<kinetic_type>(),
+                                          this->kinetic.get());
+    if (sampling_params.has_value()) {
+      this->kinetic->event_triggered_sampler =
+          std::make_shared<kinetic::EventTriggeredSampler>(
+              std::move(*sampling_params),
+              kinetic_type::standard_sampling_functions(unowned));
+    }
+    if (time_sampling_params.has_value()) {
+      this->kinetic->time_resolved_sampler =
+          std::make_shared<kinetic::TimeResolvedSampler>(
+              std::move(*time_sampling_params),
+              kinetic_type::standard_sampling_functions(unowned));
+    }
+
+    CASM::log().indent() << "Vectorized kernels: "
+                         << kinetic::to_string(kinetic::kernel_isa())
+                         << std::endl;
+  }
+
+  /// \brief Parse "auto_tune"/"candidates"
+  void _parse_auto_tune_candidates(ParentInputParser &parser,
+                                   AutoTuneParams &tune) const {
+    fs::path option = fs::path("auto_tune") / "candidates";
+    jsonParser const &json = params["auto_tune"];
+    if (!json.contains("candidates") || !json["candidates"].is_array() ||
+        json["candidates"].size() == 0) {
+      parser.insert_error(option,
+                          "Error: must be a non-empty array of objects");
+      return;
+    }
+    std::set<std::string> allowed = auto_tune_candidate_params();
+    jsonParser base = params;
+    base.erase("auto_tune");
+    for (auto const &candidate : json["candidates"]) {
+      if (!candidate.is_obj()) {
+        parser.insert_error(option, "Error: candidates must be objects");
+        return;
+      }
+      jsonParser complete = base;
+      for (auto it = candidate.begin(); it != candidate.end(); ++it) {
+        if (!allowed.count(it.name())) {
+          parser.insert_error(option, "Error: \"" + it.name() +
+                                          "\" may not be set by a candidate");
+          return;
+        }
+        complete[it.name()] = *it;
+      }
+      InputParser<kinetic_type> candidate_parser{complete, this->system};
+      std::stringstream msg;
+      msg << "Error in KineticCalculator: invalid \"auto_tune\" candidate "
+          << tune.candidates.size();
+      std::runtime_error error_if_invalid{msg.str()};
+      report_and_throw_if_invalid(candidate_parser, CASM::log(),
+                                  error_if_invalid);
+      tune.candidates.push_back(std::move(complete));
+      tune.candidate_values.push_back(candidate);
+    }
+  }
+
+  /// \brief Use the options of the fastest auto-tune candidate for the
+  ///     state's supercell, running calibration runs if the supercell has
+  ///     not been tuned yet
+  void _auto_tune(state_type const &state,
+                  run_manager_type<engine_type> &run_manager) {
+    AutoTuneParams const &tune = *this->auto_tune_params;
+    kinetic::AutoTuner &tuner = *this->auto_tuner;
+    Index choice = tuner.choose(
+        get_transformation_matrix_to_super(state), [&](Index i) {
+          // copy the engine, so that calibration does not change the random
+          // numbers of the production runs
+          return _steps_per_second(
+              state, tune.candidates[i],
+              std::make_shared<engine_type>(*run_manager.engine));
+        });
+    if (choice == tuner.applied) {
+      return;
+    }
+
+    // The chosen options are used with new event data, so the event list is
+    // re-constructed for the next run
+    InputParser<kinetic_type> parser{tune.candidates[choice], this->system};
+    kinetic_type const &chosen = *parser.value;
+    this->kinetic->event_selector_params = chosen.event_selector_params;
+    this->kinetic->event_data =
+        kinetic::make_event_data_with_same_options(*chosen.event_data);
+    this->kinetic->event_data_cache.clear();
+    this->kinetic->transformation_matrix_to_super.setZero();
+    tuner.applied = choice;
+  }
+
+  /// \brief Steps per second of a calibration run
+  ///
+  /// Runs `n_warmup_steps` and then times `n_steps`, starting from a copy
+  /// of `state`, with a new kinetic::Kinetic constructed from
+  /// `candidate_params`.
+  double _steps_per_second(state_type const &state,
+                           jsonParser const &candidate_params,
+                           std::shared_ptr<engine_type> engine) {
+    AutoTuneParams const &tune = *this->auto_tune_params;
+    InputParser<kinetic_type> parser{candidate_params, this->system};
+    std::runtime_error error_if_invalid{
+        "Error in KineticCalculator: invalid \"auto_tune\" candidate"};
+    report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+    kinetic_type &candidate = *parser.value;
+
+    state_type calibration_state = state;
+    monte::OccLocation *occ_location = nullptr;
+    std::unique_ptr<monte::OccLocation> tmp;
+    make_temporary_if_necessary(calibration_state, occ_location, tmp,
+                                *this->system, candidate.update_species);
+
+    _calibration_run(candidate, calibration_state, *occ_location, engine,
+                     tune.n_warmup_steps);
+    auto begin = std::chrono::steady_clock::now();
+    Index n_steps = _calibration_run(candidate, calibration_state,
+                                     *occ_location, engine, tune.n_steps);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    return n_steps / std::max(elapsed.count(), 1e-9);
+  }
+
+  /// \brief Run `n_steps` KMC steps without sampling, and return the number
+  ///     of steps performed
+  Index _calibration_run(kinetic_type &candidate, state_type &state,
+                         monte::OccLocation &occ_location,
+                         std::shared_ptr<engine_type> engine, Index n_steps) {
+    monte::SamplingParams sampling_params;
+    sampling_params.sample_mode = monte::SAMPLE_MODE::BY_STEP;
+
+    monte::CompletionCheckParams<statistics_type> completion_check_params;
+    {
+      auto &c = completion_check_params;
+      c.equilibration_check_f = monte::default_equilibration_check;
+      c.calc_statistics_f =
+          monte::default_statistics_calculator<statistics_type>();
+      c.cutoff_params.min_count = n_steps;
+      c.cutoff_params.max_count = n_steps;
+    }
+
+    std::vector<sampling_fixture_params_type> sampling_fixture_params;
+    sampling_fixture_params.push_back(clexmonte::make_sampling_fixture_params(
+        "auto_tune", {}, {}, {}, sampling_params, completion_check_params,
+        {} /*analysis_names*/, false /*write_results*/,
+        false /*write_trajectory*/, false /*write_observations*/,
+        false /*write_status*/, std::nullopt /*output_dir*/,
+        std::nullopt /*log_file*/, 600.0 /*log_frequency_in_s*/));
+    bool global_cutoff = true;
+    run_manager_type<engine_type> run_manager(engine, sampling_fixture_params,
+                                              global_cutoff);
+    candidate.run(state, occ_location, run_manager);
+
+    auto const &counter = run_manager.sampling_fixtures.front()->counter();
+    return counter.steps_per_pass * counter.pass + counter.step;
+  }
+
+  /// \brief Clone the KineticCalculator
+  KineticCalculator *_clone() const override {
+    return new KineticCalculator(*this);
+  }
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+extern "C" {
+/// \brief Returns a clexmonte::BaseMonteCalculator* owning a
+/// KineticCalculator
+CASM::clexmonte::BaseMonteCalculator *make_KineticCalculator() {
+  return new CASM::clexmonte::KineticCalculator();
+}
+}
@@ -1,10 +1,15 @@
 
 #include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
 
+#include <algorithm>
 #include <filesystem>
+#include <sstream>
 
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/monte_calculator/plugin_api_version.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccLocation.hh"
 #include "casm/system/RuntimeLibrary.hh"
 
 namespace CASM {
@@ -59,6 +64,78 @@ std::shared_ptr<RuntimeLibrary> make_shared_runtime_lib(
 
 }  // namespace MonteCalculator_impl
 
+/// \brief Calculate the change in (per_supercell) potential value due to
+///     each of a batch of independent events, given as arrays
+///
+/// Each event is evaluated relative to the current state, by the potential's
+/// `occ_delta_per_supercell_batch` method, in chunks of events whose
+/// `OccEvent::occ_transform` are set from the current occupation.
+///
+/// \param linear_site_index Linear site indices of the sites changing
+///     occupation, with one row per event. Entries < 0 are ignored, so
+///     events changing fewer sites may be padded with -1.
+/// \param new_occ New occupation indices, with the same shape as
+///     `linear_site_index`
+/// \param delta Set to the change in potential value of each event, size
+///     `linear_site_index.rows()`
+void MontePotential::occ_delta_per_supercell_batch(
+    Eigen::Ref<site_index_batch_type const> const &linear_site_index,
+    Eigen::Ref<occ_batch_type const> const &new_occ,
+    Eigen::Ref<Eigen::VectorXd> delta) {
+  if (new_occ.rows() != linear_site_index.rows() ||
+      new_occ.cols() != linear_site_index.cols()) {
+    throw std::runtime_error(
+        "Error in MontePotential::occ_delta_per_supercell_batch: "
+        "linear_site_index and new_occ shapes do not match");
+  }
+  if (delta.size() != linear_site_index.rows()) {
+    throw std::runtime_error(
+        "Error in MontePotential::occ_delta_per_supercell_batch: delta size "
+        "does not match the number of events");
+  }
+  StateData const &state_data = *m_pot->state_data;
+  monte::Conversions const &convert = *state_data.convert;
+  Eigen::VectorXi const &occupation = get_occupation(*state_data.state);
+  monte::OccLocation const *occ_location = state_data.occ_location;
+
+  Index n_events = linear_site_index.rows();
+  Index chunk_size = std::min(n_events, Index(256));
+  std::vector<monte::OccEvent> events(chunk_size);
+  for (Index begin = 0; begin < n_events; begin += chunk_size) {
+    Index n = std::min(chunk_size, n_events - begin);
+    for (Index i = 0; i < n; ++i) {
+      monte::OccEvent &event = events[i];
+      event.linear_site_index.clear();
+      event.new_occ.clear();
+      event.occ_transform.clear();
+      for (Index j = 0; j < linear_site_index.cols(); ++j) {
+        Index l = linear_site_index(begin + i, j);
+        if (l < 0) {
+          continue;
+        }
+        if (l >= occupation.size()) {
+          std::stringstream msg;
+          msg << "Error in MontePotential::occ_delta_per_supercell_batch: "
+              << "linear site index " << l << " is out of range";
+          throw std::runtime_error(msg.str());
+        }
+        int occ = new_occ(begin + i, j);
+        Index asym = convert.l_to_asym(l);
+        event.linear_site_index.push_back(l);
+        event.new_occ.push_back(occ);
+        monte::OccTransform transform;
+        transform.l = l;
+        transform.mol_id = occ_location ? occ_location->l_to_mol_id(l) : -1;
+        transform.asym = asym;
+        transform.from_species = convert.species_index(asym, occupation(l));
+        transform.to_species = convert.species_index(asym, occ);
+        event.occ_transform.push_back(transform);
+      }
+    }
+    m_pot->occ_delta_per_supercell_batch(events, n, delta.data() + begin);
+  }
+}
+
 /// \brief MonteCalculator factory function
 ///
 /// This does the following:
@@ -105,7 +182,36 @@ std::shared_ptr<MonteCalculator> make_monte_calculator(
   return calculator;
 }
 
+/// \brief Construct a MonteCalculator with the same implementation,
+///     parameters, and system, and its own standard functions, which
+///     shares no calculation data with this one
+///
+/// This can be used to give each thread of a parallel calculation its own
+/// calculator. Sampling, analysis, and modifying functions added to this
+/// calculator after construction are not copied, and the copy does not
+/// publish to this calculator's telemetry channel, which allows only one
+/// publisher. If this calculator has a run control, the copy has its own
+/// run control with the same predicate.
+std::shared_ptr<MonteCalculator> MonteCalculator::make_independent_copy()
+    const {
+  auto calculator =
+      make_monte_calculator(params(), system(), m_calc->clone(), m_lib);
+  calculator->set_telemetry(nullptr);
+  if (m_calc->run_control) {
+    calculator->set_run_control(std::make_shared<RunControl>(
+        m_calc->run_control->predicate,
+        m_calc->run_control->sampling_fixture_label));
+  }
+  return calculator;
+}
+
 /// \brief MonteCalculator factory function, from source
+///
+/// The source file must define `extern "C" BaseMonteCalculator
+/// *make_<calculator_name>()`. If it also declares its plugin API version
+/// with `CASM_CLEXMONTE_PLUGIN(<calculator_name>)` (see
+/// "casm/clexmonte/monte_calculator/plugin.hh"), loading a library compiled
+/// against a different version throws.
 std::shared_ptr<MonteCalculator> make_monte_calculator_from_source(
     fs::path dirpath, std::string calculator_name, jsonParser const &params,
     std::shared_ptr<system_type> system, std::string compile_options,
@@ -124,6 +230,30 @@ std::shared_ptr<MonteCalculator> make_monte_calculator_from_source(
     throw;
   }
 
+  // Check the plugin API version, if declared by CASM_CLEXMONTE_PLUGIN
+  std::function<int(void)> plugin_api_version_f;
+  try {
+    plugin_api_version_f =
+        lib->get_function<int(void)>(calculator_name + "_plugin_api_version");
+  } catch (std::exception &e) {
+    CASM::log() << "Warning: MonteCalculator '" << calculator_name
+                << "' does not declare a plugin API version with "
+                   "CASM_CLEXMONTE_PLUGIN; compatibility is not checked."
+                << std::endl;
+  }
+  if (plugin_api_version_f) {
+    int plugin_api_version = plugin_api_version_f();
+    if (plugin_api_version != CASM_CLEXMONTE_PLUGIN_API_VERSION) {
+      std::stringstream msg;
+      msg << "Error in make_monte_calculator_from_source: MonteCalculator '"
+          << calculator_name << "' was compiled against plugin API version "
+          << plugin_api_version << ", but this library has version "
+          << CASM_CLEXMONTE_PLUGIN_API_VERSION
+          << ". Remove the compiled files and compile it again.";
+      throw std::runtime_error(msg.str());
+    }
+  }
+
   // Get the factory function
   std::function<clexmonte::BaseMonteCalculator *(void)> factory;
   factory = lib->get_function<clexmonte::BaseMonteCalculator *(void)>(
@@ -0,0 +1,60 @@
+#include "casm/clexmonte/monte_calculator/MonteCalculatorCache.hh"
+
+#include <cstdlib>
+
+#include "casm/clexmonte/monte_calculator/plugin_api_version.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+MonteCalculatorCache::MonteCalculatorCache(fs::path _cache_dir)
+    : cache_dir(_cache_dir) {}
+
+/// \brief Lock, and populate if necessary, the cache entry for a
+///     MonteCalculator source file
+///
+/// \param dirpath Directory containing the MonteCalculator source file,
+///     which is copied into the cache entry
+/// \param calculator_name Name of the MonteCalculator source file
+///     (excluding .cc extension)
+/// \param compile_options Options used to compile the source file
+/// \param so_options Options used to compile the shared object file
+///
+/// \returns The cache entry, which is locked until `lock` is destroyed.
+///     The entry directory should be used in place of `dirpath` to compile
+///     and load the calculator while the lock is held.
+SourceDirCacheEntry MonteCalculatorCache::acquire(
+    fs::path dirpath, std::string calculator_name,
+    std::string const &compile_options, std::string const &so_options) const {
+  if (dirpath.empty()) {
+    dirpath = ".";
+  }
+  return acquire_source_dir_cache_entry(
+      cache_dir, dirpath,
+      {"MonteCalculator", calculator_name, compile_options, so_options,
+       "plugin_api_version=" +
+           std::to_string(CASM_CLEXMONTE_PLUGIN_API_VERSION)});
+}
+
+/// \brief Return the MonteCalculator cache directory, from the JSON input or
+///     the CASM_MONTE_CALCULATOR_CACHE_DIR environment variable, if set
+///
+/// \param cache_dir_input Optional cache directory given by the JSON input,
+///     which takes precedence over the environment variable
+///
+/// \returns The cache directory, or std::nullopt if the cache is not
+///     enabled
+std::optional<fs::path> default_monte_calculator_cache_dir(
+    std::optional<std::string> cache_dir_input) {
+  if (cache_dir_input.has_value()) {
+    return fs::path(*cache_dir_input);
+  }
+  char const *value = std::getenv("CASM_MONTE_CALCULATOR_CACHE_DIR");
+  if (value != nullptr && std::string(value).size()) {
+    return fs::path(value);
+  }
+  return std::nullopt;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
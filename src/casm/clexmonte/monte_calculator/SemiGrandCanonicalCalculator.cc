@@ -1,9 +1,21 @@
+#include <limits>
+
+#include "casm/clexmonte/methods/checkerboard_metropolis.hh"
+#include "casm/clexmonte/methods/cluster_flip.hh"
+#include "casm/clexmonte/methods/neighborhood_prefetch.hh"
 #include "casm/clexmonte/methods/occupation_metropolis.hh"
+#include "casm/clexmonte/methods/parallel_chains_metropolis.hh"
+#include "casm/clexmonte/methods/swap_proposal_stream.hh"
+#include "casm/clexmonte/methods/weighted_swap_proposal.hh"
 #include "casm/clexmonte/monte_calculator/BaseMonteCalculator.hh"
 #include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
 #include "casm/clexmonte/monte_calculator/analysis_functions.hh"
 #include "casm/clexmonte/monte_calculator/sampling_functions.hh"
 #include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/EnsembleClusterExpansion.hh"
+#include "casm/clexmonte/state/OrderParameterPotential.hh"
+#include "casm/clexmonte/state/ParamCompQuadPotential.hh"
+#include "casm/clexmonte/state/io/json/EnsembleClusterExpansion_json_io.hh"
 #include "casm/configuration/io/json/Configuration_json_io.hh"
 #include "casm/monte/events/OccEventProposal.hh"
 #include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
@@ -73,6 +85,23 @@ class SemiGrandCanonicalEventGenerator {
   /// \brief The current proposed event
   monte::OccEvent occ_event;
 
+  /// \brief If set, single site events are proposed from blocks of
+  ///     pre-drawn proposals
+  std::optional<SwapProposalStream> proposal_stream;
+
+  /// \brief If set, and `proposal_stream` is set, the neighborhoods of the
+  ///     sites of the next proposal are prefetched after each proposal
+  std::optional<NeighborhoodPrefetcher> prefetcher;
+
+  /// \brief If not null, single site events are proposed with swap type
+  ///     weights adapted to acceptance rates
+  WeightedSwapProposer *weighted_proposer = nullptr;
+
+  /// \brief Log of the proposal ratio, `log(P(propose reverse event) /
+  ///     P(propose event))`, of the current proposed event. Always 0.0
+  ///     unless `weighted_proposer` is set.
+  double log_proposal_ratio = 0.0;
+
  public:
   /// \brief Set the current Monte Carlo state and occupant locations
   ///
@@ -93,6 +122,59 @@ class SemiGrandCanonicalEventGenerator {
         throw_if_null(_occ_location,
                       "Error in SemiGrandCanonicalEventGenerator::set: "
                       "_occ_location==nullptr");
+    if (this->proposal_stream.has_value()) {
+      this->proposal_stream->reset();
+    }
+  }
+
+  /// \brief Set the number of proposals drawn at once
+  ///
+  /// \param block_size If > 1, and single site swaps are used, events are
+  ///     proposed from blocks of `block_size` pre-drawn proposals (see
+  ///     SwapProposalStream). If 1, each event is proposed by
+  ///     `monte::propose_semigrand_canonical_event`. Multiswap events are
+  ///     always proposed by
+  ///     `monte::propose_semigrand_canonical_multiswap_event`.
+  void set_proposal_block_size(Index block_size) {
+    if (block_size > 1 && !this->use_multiswaps) {
+      if (!this->proposal_stream.has_value() ||
+          this->proposal_stream->block_size != block_size) {
+        this->proposal_stream.emplace(this->semigrand_canonical_swaps, false,
+                                      block_size);
+      }
+    } else {
+      this->proposal_stream.reset();
+    }
+  }
+
+  /// \brief Prefetch the neighborhoods of the sites of the next proposal
+  ///
+  /// \param neighbor_list If not null, and events are proposed from blocks
+  ///     of pre-drawn proposals, the neighbor list entries and occupation of
+  ///     the sites of the next proposal are prefetched after each proposal.
+  ///     Must outlive the use of the event generator. Must be called after
+  ///     `set`.
+  void set_prefetch(clexulator::SuperNeighborList const *neighbor_list) {
+    if (neighbor_list && this->proposal_stream.has_value()) {
+      this->prefetcher.emplace(*neighbor_list, get_occupation(*this->state));
+    } else {
+      this->prefetcher.reset();
+    }
+  }
+
+  /// \brief Propose single site events with adaptive swap type weights
+  ///
+  /// \param _weighted_proposer If not null, single site events are proposed
+  ///     by `_weighted_proposer`, which sets `log_proposal_ratio`. Must
+  ///     outlive the use of the event generator. Requires single site swaps.
+  void set_weighted_proposer(WeightedSwapProposer *_weighted_proposer) {
+    if (_weighted_proposer && this->use_multiswaps) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalEventGenerator::set_weighted_proposer: "
+          "weighted proposals require single site swaps");
+    }
+    this->weighted_proposer = _weighted_proposer;
+    this->log_proposal_ratio = 0.0;
   }
 
   /// \brief Propose a Monte Carlo occupation event, returning a reference
@@ -100,13 +182,26 @@ class SemiGrandCanonicalEventGenerator {
   /// Notes:
   /// - Must call `set` before `propose` or `apply`
   ///
-  /// \param random_number_generator A random number generator
-  monte::OccEvent const &propose(
-      monte::RandomNumberGenerator<engine_type> &random_number_generator) {
-    if (this->use_multiswaps) {
+  /// \param random_number_generator A random number generator, such as
+  ///     `monte::RandomNumberGenerator` or `BufferedRandomNumberGenerator`
+  template <typename GeneratorType>
+  monte::OccEvent const &propose(GeneratorType &random_number_generator) {
+    if (this->weighted_proposer) {
+      return this->weighted_proposer->propose(
+          this->occ_event, this->log_proposal_ratio, *this->occ_location,
+          random_number_generator);
+    } else if (this->use_multiswaps) {
       return monte::propose_semigrand_canonical_multiswap_event(
           this->occ_event, *this->occ_location,
           this->semigrand_canonical_multiswaps, random_number_generator);
+    } else if (this->proposal_stream.has_value()) {
+      this->proposal_stream->propose(this->occ_event, *this->occ_location,
+                                     random_number_generator);
+      if (this->prefetcher.has_value()) {
+        this->proposal_stream->prefetch_next(*this->occ_location,
+                                             *this->prefetcher);
+      }
+      return this->occ_event;
     } else {
       return monte::propose_semigrand_canonical_event(
           this->occ_event, *this->occ_location, this->semigrand_canonical_swaps,
@@ -117,12 +212,39 @@ class SemiGrandCanonicalEventGenerator {
   /// \brief Update the occupation of the current state using the provided event
   void apply(monte::OccEvent const &e) {
     this->occ_location->apply(e, get_occupation(*this->state));
+    if (this->proposal_stream.has_value()) {
+      this->proposal_stream->notify_applied(e);
+    }
+    if (this->weighted_proposer && &e == &this->occ_event) {
+      this->weighted_proposer->notify_accepted();
+    }
   }
 };
 
-class SemiGrandCanonicalPotential : public BaseMontePotential {
+/// \brief Semi-grand canonical potential
+///
+/// The formation energy is the "formation_energy" cluster expansion, or if
+/// the "ensemble_formation_energy" calculation parameter is given, one
+/// member, or the mean, of an ensemble of coefficient sets (see
+/// EnsembleClusterExpansion).
+///
+/// This class is `final`, so calls through a `SemiGrandCanonicalPotential`
+/// reference are not virtual.
+class SemiGrandCanonicalPotential final : public BaseMontePotential {
  public:
-  SemiGrandCanonicalPotential(std::shared_ptr<StateData> _state_data)
+  /// \brief Constructor
+  ///
+  /// \param _state_data State data
+  /// \param _formation_energy_clex If not null, the formation energy cluster
+  ///     expansion calculator to use, i.e. from `make_independent_clex` for
+  ///     use on another thread. If null, `get_clex` is used.
+  SemiGrandCanonicalPotential(
+      std::shared_ptr<StateData> _state_data,
+      std::shared_ptr<clexulator::ClusterExpansion> _formation_energy_clex =
+          nullptr,
+      std::optional<std::string> _order_parameter_pot_key = std::nullopt,
+      std::optional<EnsembleClusterExpansionParams> const &_ensemble_params =
+          std::nullopt)
       : BaseMontePotential(_state_data),
         state(*state_data->state),
         n_unitcells(state_data->n_unitcells),
@@ -132,17 +254,29 @@ class SemiGrandCanonicalPotential : public BaseMontePotential {
             get_composition_calculator(*this->state_data->system)),
         composition_converter(
             get_composition_converter(*this->state_data->system)),
-        param_chem_pot(state.conditions.vector_values.at("param_chem_pot")),
+        conditions(*state_data->conditions),
         formation_energy_clex(
-            get_clex(*state_data->system, state, "formation_energy")) {
-    if (param_chem_pot.size() !=
-        composition_converter.independent_compositions()) {
+            _formation_energy_clex
+                ? _formation_energy_clex
+                : get_clex(*state_data->system, state, "formation_energy")),
+        param_comp_quad_pot(ParamCompQuadPotential::from_conditions(
+            state.conditions, composition_calculator, composition_converter,
+            convert)),
+        order_parameter_pot(make_order_parameter_pot(
+            *state_data, _order_parameter_pot_key)) {
+    if (!conditions.param_chem_pot.has_value() ||
+        conditions.param_chem_pot->size() !=
+            composition_converter.independent_compositions()) {
       throw std::runtime_error(
           "Error in SemiGrandCanonicalPotential: param_chem_pot size error");
     }
-
-    exchange_chem_pot =
-        make_exchange_chemical_potential(param_chem_pot, composition_converter);
+    param_chem_pot = *conditions.param_chem_pot;
+    exchange_chem_pot = *conditions.exchange_chem_pot;
+    if (_ensemble_params.has_value()) {
+      ensemble.emplace(
+          state_data->multiclex.at(_ensemble_params->multiclex_key),
+          _ensemble_params->member);
+    }
   }
 
   // --- Data used in the potential calculation: ---
@@ -153,19 +287,49 @@ class SemiGrandCanonicalPotential : public BaseMontePotential {
   monte::Conversions const &convert;
   composition::CompositionCalculator const &composition_calculator;
   composition::CompositionConverter const &composition_converter;
+  Conditions const &conditions;
   Eigen::VectorXd param_chem_pot;
   std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex;
   Eigen::MatrixXd exchange_chem_pot;
 
+  /// Optional quadratic potential in param_composition, included if the
+  /// conditions include "param_comp_quad_pot_target" and either
+  /// "param_comp_quad_pot_vector" or "param_comp_quad_pot_matrix"
+  std::optional<ParamCompQuadPotential> param_comp_quad_pot;
+
+  /// Optional linear and quadratic potential in order parameter, included
+  /// if the conditions include "order_parameter_pot" or
+  /// "order_parameter_quad_pot_target" and either
+  /// "order_parameter_quad_pot_vector" or "order_parameter_quad_pot_matrix"
+  std::optional<OrderParameterPotential> order_parameter_pot;
+
+  /// Optional ensemble formation energy, used instead of
+  /// `formation_energy_clex` if set
+  std::optional<EnsembleClusterExpansion> ensemble;
+
   /// \brief Calculate (per_supercell) potential value
+  ///
+  /// Notes:
+  /// - Uses `state_data->component_counts`, if it is set, rather than
+  ///   counting components from the occupation
   double per_supercell() override {
-    Eigen::VectorXd mol_composition =
-        composition_calculator.mean_num_each_component(occupation);
+    Eigen::VectorXd const &mean_num_each_component =
+        this->mean_num_each_component();
     Eigen::VectorXd param_composition =
-        composition_converter.param_composition(mol_composition);
+        composition_converter.param_composition(mean_num_each_component);
 
-    return formation_energy_clex->per_supercell() -
-           n_unitcells * param_chem_pot.dot(param_composition);
+    double formation_energy = ensemble.has_value()
+                                  ? ensemble->per_supercell()
+                                  : formation_energy_clex->per_supercell();
+    double value =
+        formation_energy - n_unitcells * param_chem_pot.dot(param_composition);
+    if (param_comp_quad_pot.has_value()) {
+      value += param_comp_quad_pot->per_supercell(mean_num_each_component);
+    }
+    if (order_parameter_pot.has_value()) {
+      value += order_parameter_pot->per_supercell();
+    }
+    return value;
   }
 
   /// \brief Calculate (per_unitcell) potential value
@@ -176,7 +340,7 @@ class SemiGrandCanonicalPotential : public BaseMontePotential {
   double occ_delta_per_supercell(std::vector<Index> const &linear_site_index,
                                  std::vector<int> const &new_occ) override {
     double delta_formation_energy =
-        formation_energy_clex->occ_delta_value(linear_site_index, new_occ);
+        this->_occ_delta_formation_energy(linear_site_index, new_occ);
     double delta_potential_energy = delta_formation_energy;
     for (Index i = 0; i < linear_site_index.size(); ++i) {
       Index l = linear_site_index[i];
@@ -185,9 +349,114 @@ class SemiGrandCanonicalPotential : public BaseMontePotential {
       Index new_species = convert.species_index(asym, new_occ[i]);
       delta_potential_energy -= exchange_chem_pot(new_species, curr_species);
     }
+    delta_potential_energy +=
+        this->_occ_delta_optional_terms(linear_site_index, new_occ);
+    return delta_potential_energy;
+  }
 
+  /// \brief Calculate change in (per_supercell) semi-grand potential value due
+  ///     to a proposed event
+  ///
+  /// Equivalent to `occ_delta_per_supercell(event.linear_site_index,
+  /// event.new_occ)`, but the exchange chemical potential is read using the
+  /// species in `event.occ_transform`, which event proposers set, so no index
+  /// conversions are done per site.
+  double occ_delta_per_supercell(monte::OccEvent const &event) {
+    double delta_potential_energy = this->_occ_delta_formation_energy(
+        event.linear_site_index, event.new_occ);
+    for (monte::OccTransform const &t : event.occ_transform) {
+      delta_potential_energy -= exchange_chem_pot(t.to_species, t.from_species);
+    }
+    delta_potential_energy +=
+        this->_occ_delta_optional_terms(event.linear_site_index, event.new_occ);
     return delta_potential_energy;
   }
+
+  /// \brief Calculate change in (per_supercell) semi-grand potential value
+  ///     due to each of a batch of events, each relative to the current state
+  void occ_delta_per_supercell_batch(std::vector<monte::OccEvent> const &events,
+                                     Index n_events, double *delta) override {
+    for (Index i = 0; i < n_events; ++i) {
+      delta[i] = this->occ_delta_per_supercell(events[i]);
+    }
+  }
+
+ private:
+  /// \brief Change in the formation energy
+  double _occ_delta_formation_energy(
+      std::vector<Index> const &linear_site_index,
+      std::vector<int> const &new_occ) {
+    if (ensemble.has_value()) {
+      return ensemble->occ_delta_value(linear_site_index, new_occ);
+    }
+    return formation_energy_clex->occ_delta_value(linear_site_index, new_occ);
+  }
+
+  /// \brief Change in the optional parametric composition and order
+  ///     parameter potential terms
+  double _occ_delta_optional_terms(std::vector<Index> const &linear_site_index,
+                                   std::vector<int> const &new_occ) {
+    double delta_potential_energy = 0.0;
+    if (param_comp_quad_pot.has_value()) {
+      delta_potential_energy += param_comp_quad_pot->occ_delta_per_supercell(
+          this->mean_num_each_component(), occupation, linear_site_index,
+          new_occ);
+    }
+    if (order_parameter_pot.has_value()) {
+      delta_potential_energy += order_parameter_pot->occ_delta_per_supercell(
+          occupation, linear_site_index, new_occ);
+    }
+    return delta_potential_energy;
+  }
+
+  /// \brief Construct the order parameter potential, if the conditions
+  ///     include it
+  ///
+  /// \param key Key into `state_data.order_parameters`. If std::nullopt,
+  ///     there must be exactly one order parameter.
+  static std::optional<OrderParameterPotential> make_order_parameter_pot(
+      StateData const &state_data, std::optional<std::string> const &key) {
+    monte::ValueMap const &conditions = state_data.state->conditions;
+    if (!conditions.vector_values.count("order_parameter_pot") &&
+        !conditions.vector_values.count("order_parameter_quad_pot_target")) {
+      return std::nullopt;
+    }
+    std::shared_ptr<clexulator::OrderParameter> order_parameter;
+    if (key.has_value()) {
+      auto it = state_data.order_parameters.find(*key);
+      if (it == state_data.order_parameters.end()) {
+        std::stringstream ss;
+        ss << "Error in SemiGrandCanonicalPotential: order_parameter_pot_key '"
+           << *key << "' is not found in dof_spaces";
+        throw std::runtime_error(ss.str());
+      }
+      order_parameter = it->second;
+    } else if (state_data.order_parameters.size() == 1) {
+      order_parameter = state_data.order_parameters.begin()->second;
+    } else {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalPotential: order parameter potential "
+          "conditions require \"order_parameter_pot_key\" unless there is "
+          "exactly one DoFSpace");
+    }
+    return OrderParameterPotential::from_conditions(
+        conditions, order_parameter,
+        *get_prim_basicstructure(*state_data.system), *state_data.convert,
+        get_occupation(*state_data.state));
+  }
+
+  /// Current number of each component, normalized per unit cell, from
+  /// `state_data->component_counts` if it is set, else from the occupation
+  Eigen::VectorXd const &mean_num_each_component() {
+    if (state_data->component_counts) {
+      return state_data->component_counts->mean_num_each_component();
+    }
+    m_mean_num_each_component =
+        composition_calculator.mean_num_each_component(occupation);
+    return m_mean_num_each_component;
+  }
+
+  Eigen::VectorXd m_mean_num_each_component;
 };
 
 class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
@@ -256,6 +525,10 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
         monte_calculator::make_param_susc_f(calculation),
         monte_calculator::make_mol_thermochem_susc_f(calculation),
         monte_calculator::make_param_thermochem_susc_f(calculation)};
+    for (auto const &pair : get_system(calculation).multiclex_data) {
+      functions.push_back(
+          monte_calculator::make_eci_ensemble_f(calculation, pair.first));
+    }
 
     std::map<std::string, results_analysis_function_type> function_map;
     for (auto const &f : functions) {
@@ -320,6 +593,42 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
         log_file, log_frequency_in_s);
   }
 
+  /// \brief Construct lean SamplingFixtureParams for fast screening runs
+  ///
+  /// Notes:
+  /// - Samples only "mol_composition" and "potential_energy", by pass, with
+  ///   period 1. During a run both are tracked incrementally as events are
+  ///   applied, so sampling does not depend on the supercell size.
+  /// - No convergence is requested and no analysis functions are evaluated,
+  ///   so completion is determined by cutoffs only, which must be set.
+  /// - No status, trajectory, or observations files are written. If
+  ///   `write_results`, results are written once the run is complete.
+  sampling_fixture_params_type make_screening_sampling_fixture_params(
+      std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+      bool write_results,
+      std::optional<std::string> output_dir) const override {
+    monte::SamplingParams sampling_params;
+    sampling_params.sampler_names = {"mol_composition", "potential_energy"};
+
+    monte::CompletionCheckParams<statistics_type> completion_check_params;
+    {
+      auto &c = completion_check_params;
+      c.equilibration_check_f = monte::default_equilibration_check;
+      c.calc_statistics_f =
+          monte::default_statistics_calculator<statistics_type>();
+    }
+
+    std::vector<std::string> analysis_names;
+
+    return clexmonte::make_sampling_fixture_params(
+        label, calculation->sampling_functions,
+        calculation->json_sampling_functions, calculation->analysis_functions,
+        sampling_params, completion_check_params, analysis_names, write_results,
+        false /*write_trajectory*/, false /*write_observations*/,
+        false /*write_status*/, output_dir, std::nullopt /*log_file*/,
+        600.0 /*log_frequency_in_s*/);
+  }
+
   /// \brief Validate the state's configuration (all are valid)
   Validator validate_configuration(state_type &state) const override {
     return Validator{};
@@ -330,6 +639,12 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
   /// Notes:
   /// - requires scalar temperature
   /// - requires vector param_chem_pot
+  /// - optional vector param_comp_quad_pot_target, vector
+  ///   param_comp_quad_pot_vector, and matrix param_comp_quad_pot_matrix
+  /// - optional vector order_parameter_pot, vector
+  ///   order_parameter_quad_pot_target, vector
+  ///   order_parameter_quad_pot_vector, and matrix
+  ///   order_parameter_quad_pot_matrix
   /// - warnings if other conditions are present
   Validator validate_conditions(state_type &state) const override {
     // validate state.conditions
@@ -338,9 +653,16 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
     v.insert(validate_keys(conditions.scalar_values,
                            {"temperature"} /*required*/, {} /*optional*/,
                            "scalar", "condition", false /*throw_if_invalid*/));
-    v.insert(validate_keys(conditions.vector_values,
-                           {"param_chem_pot"} /*required*/, {} /*optional*/,
-                           "vector", "condition", false /*throw_if_invalid*/));
+    v.insert(validate_keys(
+        conditions.vector_values, {"param_chem_pot"} /*required*/,
+        {"param_comp_quad_pot_target", "param_comp_quad_pot_vector",
+         "order_parameter_pot", "order_parameter_quad_pot_target",
+         "order_parameter_quad_pot_vector"} /*optional*/,
+        "vector", "condition", false /*throw_if_invalid*/));
+    v.insert(validate_keys(conditions.matrix_values, {} /*required*/,
+                           {"param_comp_quad_pot_matrix",
+                            "order_parameter_quad_pot_matrix"} /*optional*/,
+                           "matrix", "condition", false /*throw_if_invalid*/));
 
     return v;
   }
@@ -374,10 +696,12 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
     // Make state data
     this->state_data =
         std::make_shared<StateData>(this->system, &state, occ_location);
+    set_parallel_corr(*this->state_data, this->clex_n_threads);
 
     // Make potential calculator
-    this->potential =
-        std::make_shared<SemiGrandCanonicalPotential>(this->state_data);
+    this->potential = std::make_shared<SemiGrandCanonicalPotential>(
+        this->state_data, nullptr, this->order_parameter_pot_key,
+        this->ensemble_params);
   }
 
   /// \brief Perform a single run, evolving current state
@@ -386,38 +710,209 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
     this->set_state_and_potential(state, &occ_location);
 
     // Get temperature
-    double temperature = state.conditions.scalar_values.at("temperature");
+    double temperature = this->state_data->conditions->temperature;
 
-    auto potential_occ_delta_per_supercell_f =
-        [=](monte::OccEvent const &event) {
-          return this->potential->occ_delta_per_supercell(
-              event.linear_site_index, event.new_occ);
-        };
+    if (this->metropolis_method == "checkerboard") {
+      this->_run_checkerboard(state, occ_location, temperature, run_manager);
+      return;
+    }
+
+    // The potential and event generator are used through their concrete
+    // types, so that the Metropolis step is inlined
+    SemiGrandCanonicalPotential &potential =
+        static_cast<SemiGrandCanonicalPotential &>(*this->potential);
 
     // Random number generator
     monte::RandomNumberGenerator<engine_type> random_number_generator(
         run_manager.engine);
 
     // Make event generator
-    auto event_generator = std::make_shared<SemiGrandCanonicalEventGenerator>(
+    SemiGrandCanonicalEventGenerator event_generator(
         get_semigrand_canonical_swaps(*this->system),
         get_semigrand_canonical_multiswaps(*this->system));
-    event_generator->set(&state, &occ_location);
+    event_generator.set_proposal_block_size(
+        this->metropolis_proposal_block_size);
+    event_generator.set(&state, &occ_location);
+    std::shared_ptr<clexulator::SuperNeighborList> prefetch_neighbor_list;
+    if (this->metropolis_prefetch) {
+      prefetch_neighbor_list =
+          get_supercell_neighbor_list(*this->system, state);
+    }
+    event_generator.set_prefetch(prefetch_neighbor_list.get());
+
+    // Adapt swap type weights to acceptance rates during the first passes,
+    // keeping acceptance statistics between runs
+    if (this->metropolis_proposal_weighting) {
+      if (this->weighted_swap_proposer == nullptr ||
+          this->weighted_swap_proposer_system != this->system) {
+        this->weighted_swap_proposer = std::make_shared<WeightedSwapProposer>(
+            get_semigrand_canonical_swaps(*this->system),
+            this->proposal_weight_min, this->proposal_weight_update_interval);
+        this->weighted_swap_proposer_system = this->system;
+      }
+      this->weighted_swap_proposer->begin_adaptation(
+          this->proposal_weight_adaptation_passes * occ_location.mol_size());
+      event_generator.set_weighted_proposer(
+          this->weighted_swap_proposer.get());
+    }
+
+    // Make delta potential function, including the proposal ratio of
+    // weighted proposals so that detailed balance is satisfied
+    double beta = this->state_data->conditions->beta;
+    auto potential_occ_delta_per_supercell_f =
+        [&](monte::OccEvent const &event) {
+          return potential.occ_delta_per_supercell(event) -
+                 event_generator.log_proposal_ratio / beta;
+        };
 
     auto propose_event_f =
-        [=](monte::RandomNumberGenerator<engine_type> &random_number_generator)
-        -> monte::OccEvent const & {
-      return event_generator->propose(random_number_generator);
+        [&](auto &random_number_generator) -> monte::OccEvent const & {
+      return event_generator.propose(random_number_generator);
     };
 
-    auto apply_event_f = [=](monte::OccEvent const &occ_event) -> void {
-      return event_generator->apply(occ_event);
+    // Track the number of each component as events are applied, so that
+    // composition sampling does not depend on the supercell size
+    this->state_data->component_counts = std::make_shared<ComponentCounts>(
+        get_composition_calculator(*this->system), *this->state_data->convert,
+        get_occupation(state));
+    ComponentCounts &component_counts = *this->state_data->component_counts;
+
+    // Track the order parameter of the order parameter potential, if any, as
+    // events are applied
+    if (potential.order_parameter_pot.has_value()) {
+      potential.order_parameter_pot->reset();
+    }
+
+    // Track sampled correlations and cluster expansion values as events are
+    // applied, so that sampling does not depend on the supercell size
+    this->state_data->clex_trackers = std::make_shared<ClexTrackers>(
+        this->state_data->n_unitcells, this->clex_tracker_reset_interval);
+    ClexTrackers &clex_trackers = *this->state_data->clex_trackers;
+
+    // Calculate intermediate values shared by sampling functions once per
+    // sample
+    this->state_data->sample_cache = std::make_shared<SampleCache>();
+    SampleCache &sample_cache = *this->state_data->sample_cache;
+
+    // Time the phases of the main loop, if built with
+    // CASM_CLEXMONTE_LOOP_PROFILE
+    this->loop_profile.reset();
+
+    // With an ensemble formation energy, track the values of all members,
+    // reusing the changes the potential evaluated for accepted events
+    EnsembleClusterExpansion *ensemble = nullptr;
+    if (potential.ensemble.has_value()) {
+      ensemble = &potential.ensemble.value();
+      clex_trackers.get_multiclex(
+          this->ensemble_params->multiclex_key, ensemble->multiclex(),
+          [=](monte::OccEvent const &event) -> Eigen::VectorXd const & {
+            return ensemble->occ_delta_values(event);
+          });
+    }
+
+    // Make event application function. The tracked potential energy change
+    // depends on the component counts and order parameter potential, so
+    // trackers are updated first.
+    auto apply_event_f = [&](monte::OccEvent const &occ_event) -> void {
+      clex_trackers.apply(occ_event);
+      if (ensemble) {
+        ensemble->invalidate();
+      }
+      component_counts.apply(occ_event, get_occupation(state));
+      if (potential.order_parameter_pot.has_value()) {
+        potential.order_parameter_pot->apply(occ_event, get_occupation(state));
+      }
+      sample_cache.invalidate();
+      event_generator.apply(occ_event);
     };
 
-    // Run Monte Carlo at a single condition
-    clexmonte::occupation_metropolis_v2(
-        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
-        propose_event_f, apply_event_f, run_manager);
+    // Check for due samples and completion every step, or once per pass
+    Index steps_per_check =
+        this->metropolis_check_by_pass ? occ_location.mol_size() : 1;
+
+    if (this->cluster_flip_fraction > 0.0) {
+      // Make cluster flip event proposer
+      monte::Conversions const &convert = *this->state_data->convert;
+      ClusterFlipEventProposer cluster_flip_proposer(
+          get_transformation_matrix_to_super(state), convert,
+          make_nearest_neighbor_bonds(*get_prim_basicstructure(*this->system),
+                                      convert),
+          get_semigrand_canonical_swaps(*this->system),
+          this->cluster_flip_bond_probability);
+      monte::OccEvent cluster_flip_event;
+      double log_proposal_ratio = 0.0;
+
+      // Propose a cluster flip with probability `cluster_flip_fraction`,
+      // else a single site event
+      auto propose_mixed_event_f =
+          [&](auto &random_number_generator) -> monte::OccEvent const & {
+        log_proposal_ratio = 0.0;
+        if (random_number_generator.random_real(1.0) >=
+            this->cluster_flip_fraction) {
+          monte::OccEvent const &event =
+              event_generator.propose(random_number_generator);
+          log_proposal_ratio = event_generator.log_proposal_ratio;
+          return event;
+        }
+        if (!cluster_flip_proposer.propose(
+                cluster_flip_event, log_proposal_ratio, get_occupation(state),
+                occ_location, random_number_generator)) {
+          // no change is possible, the empty event is always rejected
+          cluster_flip_event.linear_site_index.clear();
+          cluster_flip_event.new_occ.clear();
+          cluster_flip_event.occ_transform.clear();
+          cluster_flip_event.atom_traj.clear();
+        }
+        return cluster_flip_event;
+      };
+
+      // Include the proposal ratio, so that detailed balance is satisfied
+      auto potential_occ_delta_mixed_f = [&](monte::OccEvent const &event) {
+        if (event.linear_site_index.empty()) {
+          return std::numeric_limits<double>::infinity();
+        }
+        return potential.occ_delta_per_supercell(event) -
+               log_proposal_ratio / beta;
+      };
+
+      // Run Monte Carlo at a single condition
+      clexmonte::occupation_metropolis_v2(
+          state, occ_location, temperature, potential_occ_delta_mixed_f,
+          propose_mixed_event_f, apply_event_f, run_manager,
+          this->metropolis_acceptance_table_params, &this->loop_profile,
+          this->telemetry.get(), this->run_control.get(), steps_per_check,
+          this->metropolis_buffered_random_numbers);
+    } else if (this->metropolis_batch_size > 1) {
+      // Make batched delta potential function
+      auto potential_occ_delta_batch_f =
+          [&](std::vector<monte::OccEvent> const &events, Index n_events,
+              double *delta) {
+            potential.occ_delta_per_supercell_batch(events, n_events, delta);
+          };
+
+      // Run Monte Carlo at a single condition
+      clexmonte::occupation_metropolis_batched(
+          state, occ_location, temperature, potential_occ_delta_batch_f,
+          propose_event_f, apply_event_f, this->metropolis_batch_size,
+          run_manager, this->metropolis_acceptance_table_params,
+          &this->loop_profile, this->telemetry.get(), this->run_control.get(),
+          steps_per_check, this->metropolis_buffered_random_numbers);
+    } else {
+      // Run Monte Carlo at a single condition
+      clexmonte::occupation_metropolis_v2(
+          state, occ_location, temperature,
+          potential_occ_delta_per_supercell_f, propose_event_f, apply_event_f,
+          run_manager, this->metropolis_acceptance_table_params,
+          &this->loop_profile, this->telemetry.get(), this->run_control.get(),
+          steps_per_check, this->metropolis_buffered_random_numbers);
+    }
+
+    print_loop_profile(CASM::log(), this->loop_profile);
+
+    // Occupation may be modified outside of the run
+    this->state_data->component_counts.reset();
+    this->state_data->clex_trackers.reset();
+    this->state_data->sample_cache.reset();
   }
 
   /// \brief Perform a single run, evolving one or more states
@@ -428,8 +923,233 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
         "Error: SemiGrandCanonicalCalculator does not allow multi-state runs");
   }
 
+  /// \brief Perform a replica exchange (parallel tempering) run, evolving
+  ///     each state at its own conditions with its own run manager
+  ///
+  /// Replicas are evolved concurrently using up to "n_threads" threads, and
+  /// configurations of neighboring replicas are exchanged every
+  /// "replica_exchange_interval" passes. States may differ in temperature,
+  /// param_chem_pot, or both. See `replica_exchange_metropolis` for details.
+  void run_replica_exchange(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<std::shared_ptr<run_manager_type<engine_type>>> const
+          &run_managers) override {
+    if (this->metropolis_method != "serial") {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run_replica_exchange: "
+          "replica exchange requires \"metropolis_method\"=\"serial\"");
+    }
+    if (occ_locations.size() != states.size()) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run_replica_exchange: "
+          "states.size() != occ_locations.size()");
+    }
+
+    std::vector<double> temperatures;
+    std::vector<MetropolisReplica<engine_type>> replicas =
+        this->_make_replicas(states, occ_locations, temperatures);
+
+    auto set_current_replica_f = [=](Index i) {
+      this->set_thread_current_state(i);
+    };
+
+    clexmonte::replica_exchange_metropolis(
+        states, occ_locations, temperatures, replicas, set_current_replica_f,
+        this->replica_exchange_interval, this->n_threads, run_managers,
+        this->replica_exchange_counts);
+    this->set_thread_current_state(-1);
+
+    // Leave the first replica as the current state
+    this->current_state = 0;
+    this->state_data = this->multistate_data[0];
+    this->potential = this->multistate_potential[0];
+
+    print_replica_exchange_counts(CASM::log(), this->replica_exchange_counts);
+  }
+
+  /// \brief Perform a run of independent chains of the same state, with
+  ///     pooled observations
+  ///
+  /// Chains are evolved concurrently using up to "n_threads" threads, and
+  /// all chains are sampled by `run_manager`, so the completion check uses
+  /// the pooled observations. States must have the same conditions. See
+  /// `parallel_chains_metropolis` for details.
+  void run_parallel_chains(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      run_manager_type<engine_type> &run_manager) override {
+    if (this->metropolis_method != "serial") {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run_parallel_chains: "
+          "parallel chains require \"metropolis_method\"=\"serial\"");
+    }
+    if (occ_locations.size() != states.size()) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run_parallel_chains: "
+          "states.size() != occ_locations.size()");
+    }
+
+    std::vector<double> temperatures;
+    std::vector<MetropolisReplica<engine_type>> chains =
+        this->_make_replicas(states, occ_locations, temperatures);
+    for (double temperature : temperatures) {
+      if (!CASM::almost_equal(temperature, temperatures[0])) {
+        throw std::runtime_error(
+            "Error in SemiGrandCanonicalCalculator::run_parallel_chains: all "
+            "states must have the same temperature");
+      }
+    }
+
+    auto set_current_chain_f = [=](Index i) {
+      this->set_thread_current_state(i);
+    };
+
+    clexmonte::parallel_chains_metropolis(
+        states, occ_locations, temperatures[0], chains, set_current_chain_f,
+        this->n_threads, run_manager);
+    this->set_thread_current_state(-1);
+
+    // Leave the first chain as the current state
+    this->current_state = 0;
+    this->state_data = this->multistate_data[0];
+    this->potential = this->multistate_potential[0];
+  }
+
+  /// \brief Set state data and construct potential calculator and event
+  ///     generator for each of several states
+  ///
+  /// \param states The states
+  /// \param occ_locations Occupant location trackers, one per state
+  /// \param temperatures Set to the temperature of each state
+  /// \return The functions used to evolve each state
+  std::vector<MetropolisReplica<engine_type>> _make_replicas(
+      std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<double> &temperatures) {
+    // Set state data and construct potential calculator and event generator,
+    // for each replica. Each potential uses the formation energy cluster
+    // expansion of its own StateData, so replicas are independent.
+    this->multistate_data.clear();
+    this->multistate_potential.clear();
+    temperatures.clear();
+    std::vector<MetropolisReplica<engine_type>> replicas;
+    for (Index i = 0; i < states.size(); ++i) {
+      this->set_state_and_potential(states[i], &occ_locations[i]);
+      auto potential = std::make_shared<SemiGrandCanonicalPotential>(
+          this->state_data, this->state_data->clex.at("formation_energy"),
+          this->order_parameter_pot_key, this->ensemble_params);
+      this->multistate_data.push_back(this->state_data);
+      this->multistate_potential.push_back(potential);
+      temperatures.push_back(this->state_data->conditions->temperature);
+
+      auto event_generator =
+          std::make_shared<SemiGrandCanonicalEventGenerator>(
+              get_semigrand_canonical_swaps(*this->system),
+              get_semigrand_canonical_multiswaps(*this->system));
+      event_generator->set(&states[i], &occ_locations[i]);
+
+      MetropolisReplica<engine_type> replica;
+      replica.potential_occ_delta_per_supercell_f =
+          [=](monte::OccEvent const &event) {
+            return potential->occ_delta_per_supercell(event);
+          };
+      replica.potential_per_supercell_f = [=]() {
+        return potential->per_supercell();
+      };
+      replica.propose_event_f =
+          [=](monte::RandomNumberGenerator<engine_type>
+                  &random_number_generator) -> monte::OccEvent const & {
+        return event_generator->propose(random_number_generator);
+      };
+      replica.apply_event_f = [=](monte::OccEvent const &occ_event) {
+        event_generator->apply(occ_event);
+      };
+      replicas.push_back(replica);
+    }
+    return replicas;
+  }
+
+  /// \brief Run checkerboard Metropolis Monte Carlo at a single condition
+  void _run_checkerboard(state_type &state, monte::OccLocation &occ_location,
+                         double temperature,
+                         run_manager_type<engine_type> &run_manager) {
+    if (get_semigrand_canonical_swaps(*this->system).size() == 0) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run: \"checkerboard\" "
+          "metropolis_method requires single site semi-grand canonical swaps");
+    }
+    Eigen::Matrix3l const &T = get_transformation_matrix_to_super(state);
+    CheckerboardEventProposer proposer(
+        T, get_index_conversions(*this->system, state),
+        get_semigrand_canonical_swaps(*this->system), false /*is_canonical*/);
+    Index reach = unitcell_reach(get_required_update_neighborhood(
+        *this->system, get_clex_data(*this->system, "formation_energy")));
+    CheckerboardColoring coloring(T, proposer.required_spacing(reach));
+
+    // One potential calculator per thread, the first using this->potential
+    std::vector<std::shared_ptr<SemiGrandCanonicalPotential>> potentials;
+    potentials.push_back(
+        std::static_pointer_cast<SemiGrandCanonicalPotential>(this->potential));
+    if (potentials[0]->param_comp_quad_pot.has_value()) {
+      // the composition changes of concurrently proposed events are not
+      // independent
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run: \"checkerboard\" "
+          "metropolis_method does not support param_comp_quad_pot "
+          "conditions");
+    }
+    if (potentials[0]->order_parameter_pot.has_value()) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonicalCalculator::run: \"checkerboard\" "
+          "metropolis_method does not support order parameter potential "
+          "conditions");
+    }
+    for (Index i = 1; i < this->n_threads; ++i) {
+      potentials.push_back(std::make_shared<SemiGrandCanonicalPotential>(
+          this->state_data,
+          make_independent_clex(*this->system, state, "formation_energy")));
+    }
+    std::vector<std::function<double(monte::OccEvent const &)>>
+        potential_occ_delta_per_supercell_f;
+    for (auto const &potential : potentials) {
+      potential_occ_delta_per_supercell_f.push_back(
+          [=](monte::OccEvent const &event) {
+            return potential->occ_delta_per_supercell(event);
+          });
+    }
+
+    clexmonte::checkerboard_occupation_metropolis(
+        state, occ_location, temperature, potential_occ_delta_per_supercell_f,
+        proposer, coloring, run_manager);
+  }
+
   // --- Parameters ---
   int verbosity_level = 10;
+  std::string metropolis_method = "serial";
+  Index n_threads = 1;
+  Index replica_exchange_interval = 1;
+  Index metropolis_batch_size = 1;
+  bool metropolis_check_by_pass = false;
+  bool metropolis_buffered_random_numbers = false;
+  Index metropolis_proposal_block_size = 1;
+  bool metropolis_prefetch = false;
+  bool metropolis_proposal_weighting = false;
+  double proposal_weight_min = 0.01;
+  Index proposal_weight_update_interval = 10000;
+  Index proposal_weight_adaptation_passes = 100;
+  MetropolisAcceptanceTableParams metropolis_acceptance_table_params;
+  Index clex_tracker_reset_interval = 10000;
+  Index clex_n_threads = 1;
+  double cluster_flip_fraction = 0.0;
+  double cluster_flip_bond_probability = 0.5;
+  std::optional<std::string> order_parameter_pot_key;
+  std::optional<EnsembleClusterExpansionParams> ensemble_params;
+
+  /// \brief Weighted swap proposer, kept between runs with its acceptance
+  ///     statistics, and the system it was made for
+  std::shared_ptr<WeightedSwapProposer> weighted_swap_proposer;
+  std::shared_ptr<system_type> weighted_swap_proposer_system;
 
   /// \brief Reset the derived Monte Carlo calculator
   ///
@@ -442,6 +1162,130 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
   ///       - "standard" is equivalent to integer value 10
   ///       - "verbose" is equivalent to integer value 20
   ///       - "debug" is equivalent to integer value 100
+  ///
+  ///   metropolis_method: str, default="serial"
+  ///       One of:
+  ///       - "serial": propose and accept or reject one event at a time
+  ///       - "checkerboard": propose events in non-interacting unit cells
+  ///         concurrently, using "n_threads" threads. Requires single site
+  ///         semi-grand canonical swaps, and a diagonal supercell
+  ///         transformation matrix, with each diagonal element 1 or a
+  ///         multiple of the color spacing required by the formation energy
+  ///         cluster expansion neighborhood.
+  ///
+  ///   metropolis_batch_size: int, default=1
+  ///       For "serial", the number of events proposed from the current state
+  ///       and evaluated together. Events are then accepted or rejected in
+  ///       order until one is accepted, and the rest are discarded, so
+  ///       results are statistically identical to one event at a time.
+  ///       Values > 1 reduce per-event overhead when the acceptance rate is
+  ///       low.
+  ///   metropolis_check_by_pass: bool, default=false
+  ///       For "serial", if true, check for due samples and for completion
+  ///       once per pass, on pass boundaries, rather than after every step.
+  ///       Requires that no sampling fixture samples by step. Cutoffs in
+  ///       steps may be exceeded by less than one pass.
+  ///   metropolis_buffered_random_numbers: bool, default=false
+  ///       For "serial", if true, random numbers for event proposal and
+  ///       acceptance are drawn in blocks (see
+  ///       `BufferedRandomNumberGenerator`), which reduces the cost per
+  ///       draw. Results for a given seed differ from those with the
+  ///       default.
+  ///   metropolis_proposal_block_size: int, default=1
+  ///       For "serial" with single site swaps, if > 1, events are proposed
+  ///       from blocks of this many pre-drawn proposals, which are discarded
+  ///       when an event is accepted. Proposals have the same distribution,
+  ///       but results for a given seed differ from those with the default
+  ///       value of 1.
+  ///   metropolis_prefetch: bool, default=false
+  ///       For "serial", with "metropolis_proposal_block_size" > 1, if true,
+  ///       the supercell neighbor list entries and occupation of the sites
+  ///       of the next proposal are prefetched while the current proposal is
+  ///       evaluated. May improve performance in large supercells.
+  ///   metropolis_proposal_weighting: bool, default=false
+  ///       For "serial" with single site swaps, if true, swap types are
+  ///       proposed with weights adapted to their acceptance rates, so that
+  ///       fewer proposals are wasted on flips of majority species when some
+  ///       species are dilute (see `WeightedSwapProposer`). The proposal
+  ///       ratio is included in the acceptance probability. Weights are
+  ///       adapted during the first "proposal_weight_adaptation_passes"
+  ///       passes of each run and fixed afterwards, and acceptance
+  ///       statistics are kept between runs. Requires
+  ///       "metropolis_batch_size" == 1 and
+  ///       "metropolis_proposal_block_size" == 1.
+  ///   proposal_weight_min: float, default=0.01
+  ///       Minimum weight of a swap type, relative to the largest, in
+  ///       `(0.0, 1.0]`.
+  ///   proposal_weight_update_interval: int, default=10000
+  ///       Number of proposals between weight updates, while adapting.
+  ///   proposal_weight_adaptation_passes: int, default=100
+  ///       Number of passes at the beginning of each run during which
+  ///       weights are adapted. Samples taken during adaptation are not
+  ///       exactly from the equilibrium distribution, so this should not
+  ///       exceed the equilibration period.
+  ///   metropolis_acceptance_tol: float, default=0.0
+  ///       For "serial", if > 0.0, changes in potential energy are rounded to
+  ///       the nearest multiple of this value and acceptance probabilities
+  ///       are read from a precomputed table rather than calculated with
+  ///       `exp`. Useful when energy changes take a small set of discrete
+  ///       values, as for integer-like ECI. The table is disabled
+  ///       automatically if energy changes are too widely distributed. If
+  ///       0.0, no table is used.
+  ///   metropolis_acceptance_table_size: int, default=4096
+  ///       Maximum number of entries in the acceptance probability table.
+  ///   clex_tracker_reset_interval: int, default=10000
+  ///       For "serial", sampled correlations, cluster expansion values,
+  ///       and order parameters are updated incrementally as events are
+  ///       applied, and recalculated for the full supercell when sampled
+  ///       after this many events have been applied, to control round-off
+  ///       drift.
+  ///   clex_n_threads: int, default=1
+  ///       Number of threads used to calculate correlations and cluster
+  ///       expansion values for the full supercell when they are sampled
+  ///       and not updated incrementally. Results only differ by round-off
+  ///       from the single-threaded calculation.
+  ///   cluster_flip_fraction: float, default=0.0
+  ///       For "serial", the fraction of proposed events which are cluster
+  ///       flips, which change the species of a connected domain of sites
+  ///       grown from a random seed site (see `ClusterFlipEventProposer`).
+  ///       Cluster flips reduce autocorrelation times near order-disorder
+  ///       transitions. Requires semi-grand canonical single site swaps and
+  ///       "metropolis_batch_size" == 1. If 0.0, only single site events are
+  ///       proposed.
+  ///   cluster_flip_bond_probability: float, default=0.5
+  ///       For cluster flips, the probability of adding a nearest neighbor
+  ///       site with the same species to the domain, in `[0.0, 1.0)`. For a
+  ///       nearest neighbor pair interaction `J` (a broken bond costs `2J`),
+  ///       `1 - exp(-2 * J / (k_B * T))` gives Wolff cluster moves.
+  ///   order_parameter_pot_key: str, optional
+  ///       The DoFSpace whose order parameter is used by the
+  ///       "order_parameter_pot" and "order_parameter_quad_pot_*"
+  ///       conditions. Required for those conditions unless the system has
+  ///       exactly one DoFSpace.
+  ///
+  ///   ensemble_formation_energy: dict, optional
+  ///       If given, the formation energy is one coefficient set, or the
+  ///       mean of all coefficient sets, of a multi-cluster expansion, for
+  ///       instance an ensemble of bootstrap fits, rather than the
+  ///       "formation_energy" cluster expansion. The changes of all
+  ///       coefficient sets due to each proposed event are evaluated
+  ///       together, and for "serial" runs they are reused to update
+  ///       "multiclex.<key>" when events are accepted. Not supported with
+  ///       "checkerboard". Format:
+  ///
+  ///           {
+  ///             "multiclex": str,  // multi-cluster expansion name
+  ///             "member": "mean" | str | int  // default="mean"
+  ///           }
+  ///
+  ///   n_threads: int, default=1
+  ///       For "checkerboard", the number of threads. For replica exchange
+  ///       and parallel chain runs, the maximum number of threads replicas
+  ///       or chains are evolved on.
+  ///
+  ///   replica_exchange_interval: int, default=1
+  ///       For replica exchange runs, the number of passes between attempts
+  ///       to exchange the configurations of neighboring replicas.
   void _reset() override {
     ParentInputParser parser{params};
 
@@ -449,6 +1293,201 @@ class SemiGrandCanonicalCalculator : public BaseMonteCalculator {
     this->verbosity_level = parse_verbosity(parser);
     CASM::log().set_verbosity(this->verbosity_level);
 
+    // "metropolis_method": str, default="serial"
+    this->metropolis_method = "serial";
+    parser.optional(this->metropolis_method, "metropolis_method");
+    if (this->metropolis_method != "serial" &&
+        this->metropolis_method != "checkerboard") {
+      parser.insert_error("metropolis_method",
+                          "Error: \"metropolis_method\" must be one of "
+                          "\"serial\", \"checkerboard\"");
+    }
+
+    // "n_threads": int, default=1
+    this->n_threads = 1;
+    parser.optional(this->n_threads, "n_threads");
+    if (this->n_threads < 1) {
+      parser.insert_error("n_threads", "Error: \"n_threads\" must be >= 1");
+    }
+
+    // "metropolis_batch_size": int, default=1
+    this->metropolis_batch_size = 1;
+    parser.optional(this->metropolis_batch_size, "metropolis_batch_size");
+    if (this->metropolis_batch_size < 1) {
+      parser.insert_error("metropolis_batch_size",
+                          "Error: \"metropolis_batch_size\" must be >= 1");
+    }
+
+    // "metropolis_check_by_pass": bool, default=false
+    this->metropolis_check_by_pass = false;
+    parser.optional(this->metropolis_check_by_pass,
+                    "metropolis_check_by_pass");
+
+    // "metropolis_buffered_random_numbers": bool, default=false
+    this->metropolis_buffered_random_numbers = false;
+    parser.optional(this->metropolis_buffered_random_numbers,
+                    "metropolis_buffered_random_numbers");
+
+    // "metropolis_proposal_block_size": int, default=1
+    this->metropolis_proposal_block_size = 1;
+    parser.optional(this->metropolis_proposal_block_size,
+                    "metropolis_proposal_block_size");
+    if (this->metropolis_proposal_block_size < 1) {
+      parser.insert_error(
+          "metropolis_proposal_block_size",
+          "Error: \"metropolis_proposal_block_size\" must be >= 1");
+    }
+
+    // "metropolis_prefetch": bool, default=false
+    this->metropolis_prefetch = false;
+    parser.optional(this->metropolis_prefetch, "metropolis_prefetch");
+
+    // "metropolis_proposal_weighting": bool, default=false
+    this->metropolis_proposal_weighting = false;
+    parser.optional(this->metropolis_proposal_weighting,
+                    "metropolis_proposal_weighting");
+    if (this->metropolis_proposal_weighting &&
+        (this->metropolis_method != "serial" ||
+         this->metropolis_batch_size != 1 ||
+         this->metropolis_proposal_block_size != 1)) {
+      parser.insert_error(
+          "metropolis_proposal_weighting",
+          "Error: \"metropolis_proposal_weighting\" requires "
+          "\"metropolis_method\" == \"serial\", "
+          "\"metropolis_batch_size\" == 1, and "
+          "\"metropolis_proposal_block_size\" == 1");
+    }
+
+    // "proposal_weight_min": float, default=0.01
+    this->proposal_weight_min = 0.01;
+    parser.optional(this->proposal_weight_min, "proposal_weight_min");
+    if (!(this->proposal_weight_min > 0.0 &&
+          this->proposal_weight_min <= 1.0)) {
+      parser.insert_error("proposal_weight_min",
+                          "Error: \"proposal_weight_min\" must be in "
+                          "(0.0, 1.0]");
+    }
+
+    // "proposal_weight_update_interval": int, default=10000
+    this->proposal_weight_update_interval = 10000;
+    parser.optional(this->proposal_weight_update_interval,
+                    "proposal_weight_update_interval");
+    if (this->proposal_weight_update_interval < 1) {
+      parser.insert_error(
+          "proposal_weight_update_interval",
+          "Error: \"proposal_weight_update_interval\" must be >= 1");
+    }
+
+    // "proposal_weight_adaptation_passes": int, default=100
+    this->proposal_weight_adaptation_passes = 100;
+    parser.optional(this->proposal_weight_adaptation_passes,
+                    "proposal_weight_adaptation_passes");
+    if (this->proposal_weight_adaptation_passes < 0) {
+      parser.insert_error(
+          "proposal_weight_adaptation_passes",
+          "Error: \"proposal_weight_adaptation_passes\" must be >= 0");
+    }
+    this->weighted_swap_proposer.reset();
+    this->weighted_swap_proposer_system.reset();
+
+    // "metropolis_acceptance_tol": float, default=0.0
+    this->metropolis_acceptance_table_params =
+        MetropolisAcceptanceTableParams();
+    parser.optional(this->metropolis_acceptance_table_params.tolerance,
+                    "metropolis_acceptance_tol");
+    if (this->metropolis_acceptance_table_params.tolerance < 0.0) {
+      parser.insert_error(
+          "metropolis_acceptance_tol",
+          "Error: \"metropolis_acceptance_tol\" must be >= 0.0");
+    }
+
+    // "metropolis_acceptance_table_size": int, default=4096
+    parser.optional(this->metropolis_acceptance_table_params.max_size,
+                    "metropolis_acceptance_table_size");
+    if (this->metropolis_acceptance_table_params.max_size < 1) {
+      parser.insert_error(
+          "metropolis_acceptance_table_size",
+          "Error: \"metropolis_acceptance_table_size\" must be >= 1");
+    }
+
+    // "clex_tracker_reset_interval": int, default=10000
+    this->clex_tracker_reset_interval = 10000;
+    parser.optional(this->clex_tracker_reset_interval,
+                    "clex_tracker_reset_interval");
+    if (this->clex_tracker_reset_interval < 1) {
+      parser.insert_error(
+          "clex_tracker_reset_interval",
+          "Error: \"clex_tracker_reset_interval\" must be >= 1");
+    }
+
+    // "clex_n_threads": int, default=1
+    this->clex_n_threads = 1;
+    parser.optional(this->clex_n_threads, "clex_n_threads");
+    if (this->clex_n_threads < 1) {
+      parser.insert_error("clex_n_threads",
+                          "Error: \"clex_n_threads\" must be >= 1");
+    }
+
+    // "cluster_flip_fraction": float, default=0.0
+    this->cluster_flip_fraction = 0.0;
+    parser.optional(this->cluster_flip_fraction, "cluster_flip_fraction");
+    if (this->cluster_flip_fraction < 0.0 ||
+        this->cluster_flip_fraction > 1.0) {
+      parser.insert_error(
+          "cluster_flip_fraction",
+          "Error: \"cluster_flip_fraction\" must be in [0.0, 1.0]");
+    }
+    if (this->cluster_flip_fraction > 0.0 &&
+        (this->metropolis_method != "serial" ||
+         this->metropolis_batch_size != 1)) {
+      parser.insert_error(
+          "cluster_flip_fraction",
+          "Error: \"cluster_flip_fraction\" > 0.0 requires "
+          "\"metropolis_method\" == \"serial\" and "
+          "\"metropolis_batch_size\" == 1");
+    }
+
+    // "cluster_flip_bond_probability": float, default=0.5
+    this->cluster_flip_bond_probability = 0.5;
+    parser.optional(this->cluster_flip_bond_probability,
+                    "cluster_flip_bond_probability");
+    if (this->cluster_flip_bond_probability < 0.0 ||
+        this->cluster_flip_bond_probability >= 1.0) {
+      parser.insert_error(
+          "cluster_flip_bond_probability",
+          "Error: \"cluster_flip_bond_probability\" must be in [0.0, 1.0)");
+    }
+
+    // "order_parameter_pot_key": str, optional
+    this->order_parameter_pot_key.reset();
+    parser.optional(this->order_parameter_pot_key, "order_parameter_pot_key");
+    if (this->order_parameter_pot_key.has_value() &&
+        !this->system->dof_spaces.count(*this->order_parameter_pot_key)) {
+      parser.insert_error(
+          "order_parameter_pot_key",
+          "Error: \"order_parameter_pot_key\" is not found in dof_spaces");
+    }
+
+    // "ensemble_formation_energy": dict, optional
+    parse_ensemble_formation_energy(parser, *this->system,
+                                    this->ensemble_params);
+    if (this->ensemble_params.has_value() &&
+        this->metropolis_method == "checkerboard") {
+      parser.insert_error("ensemble_formation_energy",
+                          "Error: \"ensemble_formation_energy\" is not "
+                          "supported with \"metropolis_method\"="
+                          "\"checkerboard\"");
+    }
+
+    // "replica_exchange_interval": int, default=1
+    this->replica_exchange_interval = 1;
+    parser.optional(this->replica_exchange_interval,
+                    "replica_exchange_interval");
+    if (this->replica_exchange_interval < 1) {
+      parser.insert_error("replica_exchange_interval",
+                          "Error: \"replica_exchange_interval\" must be >= 1");
+    }
+
     // TODO: enumeration
 
     std::stringstream ss;
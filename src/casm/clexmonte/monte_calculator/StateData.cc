@@ -21,9 +21,11 @@ StateData::StateData(std::shared_ptr<system_type> _system,
   //        "Error constructing StateData: occ_location==nullptr");
   //  }
 
+  conditions = make_conditions(*system, *state);
   transformation_matrix_to_super = get_transformation_matrix_to_super(*state);
   n_unitcells = transformation_matrix_to_super.determinant();
-  convert = &get_index_conversions(*system, *state);
+  supercell_data = get_shared_supercell_data(*system, *state);
+  convert = &supercell_data->convert;
 
   // make supercell_neighbor_list
   auto supercell_neighbor_list = get_supercell_neighbor_list(*system, *state);
@@ -150,5 +152,26 @@ StateData::StateData(std::shared_ptr<system_type> _system,
   }
 }
 
+/// \brief Set `StateData::parallel_corr` to calculate full supercell
+///     correlations using multiple threads
+///
+/// \param state_data The state data
+/// \param n_threads Number of threads. If <= 1, `parallel_corr` is cleared
+///     and full supercell correlations are calculated on the calling thread.
+void set_parallel_corr(StateData &state_data, Index n_threads) {
+  state_data.parallel_corr.clear();
+  if (n_threads <= 1) {
+    return;
+  }
+  auto supercell_neighbor_list =
+      get_supercell_neighbor_list(*state_data.system, *state_data.state);
+  for (auto const &pair : state_data.system->basis_sets) {
+    state_data.parallel_corr.emplace(
+        pair.first, std::make_shared<ParallelCorrelations>(
+                        supercell_neighbor_list, *pair.second,
+                        &get_dof_values(*state_data.state), n_threads));
+  }
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
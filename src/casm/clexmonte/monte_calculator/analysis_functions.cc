@@ -172,6 +172,62 @@ results_analysis_function_type make_param_thermochem_susc_f(
       make_susc_normalization_constant_f(calculation, "param_thermochem_susc"));
 }
 
+/// \brief Make cluster expansion coefficients ensemble analysis function
+///     ("eci_ensemble.<key>")
+///
+/// Gives the mean formation energy per unit cell that would be obtained
+/// with each coefficient set of the multi-cluster expansion `key`, for
+/// instance bootstrap fits of the "formation_energy" coefficients, by
+/// reweighting the samples of a single run (see
+/// `ensemble_reweighted_means`). The spread of the results over the
+/// ensemble estimates the uncertainty due to the fit, without rerunning
+/// with each coefficient set.
+///
+/// Notes:
+/// - Requires sampling "clex.formation_energy"
+/// - Requires sampling "multiclex.<key>"
+/// - Requires scalar condition "temperature"
+/// - Requires result "initial_state"
+/// - The multi-cluster expansion must be a perturbation of the
+///   "formation_energy" cluster expansion; coefficient sets that differ too
+///   much have few effective samples.
+results_analysis_function_type make_eci_ensemble_f(
+    std::shared_ptr<MonteCalculator> const &calculation, std::string key) {
+  auto const &data = get_multiclex_data(get_system(calculation), key);
+  std::vector<std::string> component_names;
+  for (Index i = 0; i < data.coefficients.size(); ++i) {
+    component_names.push_back(std::to_string(i));
+  }
+  for (auto const &pair : data.coefficients_glossary) {
+    component_names[pair.second] = pair.first;
+  }
+
+  std::string name = "eci_ensemble." + key;
+  auto make_beta_n_unitcells_f = [=]() -> double {
+    // validate temperature
+    auto const &state = get_state(calculation);
+    auto const &conditions = state.conditions;
+    Index n_unitcells = get_transformation_matrix_to_super(state).determinant();
+    if (!conditions.scalar_values.count("temperature")) {
+      std::stringstream msg;
+      msg << "Results analysis error: " << name
+          << " requires temperature condition";
+      throw std::runtime_error(msg.str());
+    }
+    double temperature = conditions.scalar_values.at("temperature");
+
+    // calculate
+    return n_unitcells / (CASM::KB * temperature);
+  };
+
+  return make_ensemble_reweighting_f(
+      name,
+      "Formation energy (per unit cell) of each multi-cluster expansion "
+      "coefficient set, reweighted from samples of clex.formation_energy",
+      "clex.formation_energy", "multiclex." + key, component_names,
+      make_beta_n_unitcells_f);
+}
+
 }  // namespace monte_calculator
 }  // namespace clexmonte
 }  // namespace CASM
@@ -2,6 +2,7 @@
 
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/MonteCalculatorCache.hh"
 #include "casm/system/RuntimeLibrary.hh"
 
 namespace CASM {
@@ -50,6 +51,13 @@ fs::path resolve_path(fs::path p, std::vector<fs::path> search_path) {
 ///     Options used to compile the MonteCalculator shared object file, if it
 ///     is not yet compiled. Example:
 ///     "g++ -shared -L/path/to/lib -lcasm_clexmonte "
+///
+///   cache_dir: string (optional)
+///     If given, or if the CASM_MONTE_CALCULATOR_CACHE_DIR environment
+///     variable is set, the MonteCalculator is compiled in an entry of a
+///     content-addressed cache in this directory, and jobs or workers with
+///     the same source and options load the compiled library from it
+///     instead of compiling again (see `MonteCalculatorCache`).
 void parse(InputParser<std::shared_ptr<MonteCalculator>> &parser,
            std::shared_ptr<System> &system, jsonParser const &params,
            std::vector<fs::path> search_path) {
@@ -117,12 +125,33 @@ void parse(InputParser<std::shared_ptr<MonteCalculator>> &parser,
   parser.optional_else(calculator_so_options, "so_options",
                        default_calculator_so_options);
 
-  if (parser.valid()) {
+  // - optional compiled calculator cache
+  std::optional<std::string> cache_dir_input;
+  parser.optional(cache_dir_input, "cache_dir");
+  std::optional<fs::path> cache_dir =
+      default_monte_calculator_cache_dir(cache_dir_input);
+
+  if (!parser.valid()) {
+    return;
+  }
+
+  if (!cache_dir.has_value()) {
     parser.value = std::make_unique<std::shared_ptr<MonteCalculator>>(
         make_monte_calculator_from_source(
             calculator_dirpath, calculator_name, params, system,
             calculator_compile_options, calculator_so_options));
+    return;
   }
+
+  // Hold the cache entry lock while the calculator is compiled and loaded
+  MonteCalculatorCache cache(*cache_dir);
+  SourceDirCacheEntry entry =
+      cache.acquire(calculator_dirpath, calculator_name,
+                    calculator_compile_options, calculator_so_options);
+  parser.value = std::make_unique<std::shared_ptr<MonteCalculator>>(
+      make_monte_calculator_from_source(entry.dir, calculator_name, params,
+                                        system, calculator_compile_options,
+                                        calculator_so_options));
 }
 
 }  // namespace clexmonte
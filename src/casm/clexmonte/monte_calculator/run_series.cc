@@ -0,0 +1,210 @@
+#include "casm/clexmonte/monte_calculator/run_series.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/run/io/json/RunParams_json_io.hh"
+#include "casm/clexmonte/run/io/json/RunParams_json_io_impl.hh"
+#include "casm/clexmonte/run/io/json/StateGenerator_json_io.hh"
+#include "casm/clexmonte/state/Conditions.hh"
+#include "casm/clexmonte/state/io/json/parse_conditions.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace monte_calculator {
+
+namespace {
+
+/// \brief Adapts a MonteCalculator to the CalculationType interface of
+///     `clexmonte::run_series` and `clexmonte::run_series_parallel`
+struct SeriesCalculation {
+  typedef MonteCalculator::engine_type engine_type;
+
+  SeriesCalculation(std::shared_ptr<MonteCalculator> _calculator)
+      : calculator(_calculator),
+        system(_calculator->system()),
+        update_species(_calculator->update_species()) {}
+
+  std::shared_ptr<MonteCalculator> calculator;
+
+  std::shared_ptr<system_type> system;
+
+  bool update_species;
+
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<engine_type> &run_manager) {
+    calculator->run(state, occ_location, run_manager);
+  }
+};
+
+/// \brief Copy the functions of `original` which are also in `available`,
+///     using the functions in `available`
+///
+/// \throws If a function named in `requested` is not in `available`
+template <typename FunctionMapType, typename AvailableMapType>
+FunctionMapType rebind_functions(std::string const &label,
+                                 FunctionMapType const &original,
+                                 AvailableMapType const &available,
+                                 std::vector<std::string> const &requested) {
+  FunctionMapType result;
+  for (auto const &pair : original) {
+    auto it = available.find(pair.first);
+    if (it != available.end()) {
+      result.emplace(pair.first, it->second);
+    }
+  }
+  for (std::string const &name : requested) {
+    if (!result.count(name)) {
+      std::stringstream msg;
+      msg << "Error in monte_calculator::run_series: sampling fixture \""
+          << label << "\" requests sampling function \"" << name
+          << "\", which is not a standard sampling function of the "
+             "calculator, so it cannot be used in parallel runs.";
+      throw std::runtime_error(msg.str());
+    }
+  }
+  return result;
+}
+
+/// \brief Copy sampling fixture parameters, using the sampling functions of
+///     `calculator` with the same names
+///
+/// Sampling functions which are not requested by the sampling fixture, and
+/// are not provided by `calculator`, are dropped. Requested sampling
+/// functions which are not provided by `calculator`, such as functions added
+/// by users, cannot be used by another calculator and result in an
+/// exception.
+std::vector<sampling_fixture_params_type> rebind_sampling_fixture_params(
+    std::vector<sampling_fixture_params_type> const &sampling_fixture_params,
+    MonteCalculator const &calculator) {
+  std::vector<sampling_fixture_params_type> result = sampling_fixture_params;
+  for (sampling_fixture_params_type &params : result) {
+    params.sampling_functions = rebind_functions(
+        params.label, params.sampling_functions, calculator.sampling_functions,
+        params.sampling_params.sampler_names);
+    params.json_sampling_functions = rebind_functions(
+        params.label, params.json_sampling_functions,
+        calculator.json_sampling_functions,
+        params.sampling_params.json_sampler_names);
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Construct a StateGenerator from JSON, for a series of runs with a
+///     MonteCalculator
+///
+/// \param json The "state_generation" JSON, as documented for
+///     `clexmonte::RunParams`, for example
+///     `{"method": "incremental", "kwargs": {...}}`
+/// \param calculator The calculator, which provides the system and the
+///     state modifying functions that may be named as "modifiers"
+///
+/// \returns The state generator
+std::unique_ptr<state_generator_type> make_state_generator(
+    jsonParser const &json,
+    std::shared_ptr<MonteCalculator> const &calculator) {
+  std::shared_ptr<system_type> system = calculator->system();
+  Conditions const *conditions_ptr = nullptr;
+  auto state_generator_methods = standard_state_generator_methods(
+      system, calculator->modifying_functions,
+      standard_config_generator_methods(system), conditions_ptr);
+  InputParser<state_generator_type> parser(json, state_generator_methods);
+  std::runtime_error error_if_invalid{
+      "Error in monte_calculator::make_state_generator: invalid input"};
+  report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+  return std::move(parser.value);
+}
+
+/// \brief Perform a series of runs with a MonteCalculator, according to a
+///     state generator
+///
+/// With `n_threads` == 1, or if the state generator does not generate
+/// independent states, runs are performed one after another, as by
+/// `clexmonte::run_series`. Otherwise, independent runs are performed in
+/// parallel, as by `clexmonte::run_series_parallel`:
+/// - Worker 0 uses `calculator` and the given sampling fixture parameters.
+/// - Each other worker uses a calculator made by
+///   `calculator->make_independent_copy()`, and copies of the sampling
+///   fixture parameters whose sampling functions are replaced by the worker
+///   calculator's sampling functions of the same name.
+/// - Sampling fixtures of different workers write results when their runs
+///   finish, to the same output directory. Results reads and writes are
+///   serialized (see `clexmonte::serialize_results_io`), so each run is
+///   written once, in the order runs finish.
+///
+/// \param calculator The calculator
+/// \param engine Random number engine
+/// \param state_generator A StateGenerator, which produces a series of
+///     initial states
+/// \param sampling_fixture_params Sampling fixture parameters for each run
+/// \param global_cutoff If true, the run is complete if any sampling
+///     fixture is complete. Otherwise, all sampling fixtures must be
+///     completed for the run to be completed.
+/// \param before_first_run Optional sampling fixture parameters for a run
+///     performed before the first run
+/// \param before_each_run Optional sampling fixture parameters for a run
+///     performed before each run
+/// \param n_threads Maximum number of threads used for independent runs
+/// \param auto_equilibration Optional, automatic equilibration of the
+///     "before each run" runs, shared by all workers (see
+///     `clexmonte::run_series`)
+///
+/// \returns The completed runs of `state_generator`, including runs
+///     completed before this call that were read from its output
+std::vector<RunData> run_series(
+    std::shared_ptr<MonteCalculator> const &calculator,
+    std::shared_ptr<MonteCalculator::engine_type> engine,
+    state_generator_type &state_generator,
+    std::vector<sampling_fixture_params_type> const &sampling_fixture_params,
+    bool global_cutoff,
+    std::vector<sampling_fixture_params_type> const &before_first_run,
+    std::vector<sampling_fixture_params_type> const &before_each_run,
+    Index n_threads, std::shared_ptr<AutoEquilibration> auto_equilibration) {
+  if (!calculator) {
+    throw std::runtime_error(
+        "Error in monte_calculator::run_series: calculator is null");
+  }
+  if (!engine) {
+    throw std::runtime_error(
+        "Error in monte_calculator::run_series: engine is null");
+  }
+  if (n_threads < 1) {
+    throw std::runtime_error(
+        "Error in monte_calculator::run_series: n_threads < 1");
+  }
+
+  auto make_worker_f = [&](Index worker_index) {
+    SeriesWorker<SeriesCalculation> worker;
+    worker.auto_equilibration = auto_equilibration;
+    if (worker_index == 0) {
+      worker.calculation = std::make_shared<SeriesCalculation>(calculator);
+      worker.sampling_fixture_params = sampling_fixture_params;
+      worker.before_first_run = before_first_run;
+      worker.before_each_run = before_each_run;
+    } else {
+      auto worker_calculator = calculator->make_independent_copy();
+      worker.calculation =
+          std::make_shared<SeriesCalculation>(worker_calculator);
+      worker.sampling_fixture_params = rebind_sampling_fixture_params(
+          sampling_fixture_params, *worker_calculator);
+      worker.before_first_run =
+          rebind_sampling_fixture_params(before_first_run, *worker_calculator);
+      worker.before_each_run =
+          rebind_sampling_fixture_params(before_each_run, *worker_calculator);
+    }
+    return worker;
+  };
+
+  clexmonte::run_series_parallel<SeriesCalculation>(
+      make_worker_f, engine, state_generator, n_threads, global_cutoff);
+  return state_generator.completed_runs();
+}
+
+}  // namespace monte_calculator
+}  // namespace clexmonte
+}  // namespace CASM
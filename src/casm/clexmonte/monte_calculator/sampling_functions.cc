@@ -20,6 +20,55 @@ namespace CASM {
 namespace clexmonte {
 namespace monte_calculator {
 
+namespace {
+
+/// Get an intermediate value from `state_data.sample_cache`, if it is set,
+/// else calculate it
+template <typename MakeF>
+Eigen::VectorXd _get_sample_value(StateData &state_data,
+                                  std::string const &name, MakeF make) {
+  if (state_data.sample_cache) {
+    return state_data.sample_cache->get_or_make(name, make);
+  }
+  return make();
+}
+
+/// Mean number of each component, per unit cell
+Eigen::VectorXd _mean_num_each_component(
+    std::shared_ptr<MonteCalculator> const &calculation) {
+  auto &state_data = *calculation->state_data();
+  return _get_sample_value(state_data, "mol_composition", [&]() {
+    if (state_data.component_counts) {
+      return Eigen::VectorXd(
+          state_data.component_counts->mean_num_each_component());
+    }
+    auto const &system = get_system(calculation);
+    auto const &state = get_state(calculation);
+    Eigen::VectorXi const &occupation = get_occupation(state);
+    return Eigen::VectorXd(
+        get_composition_calculator(system).mean_num_each_component(
+            occupation));
+  });
+}
+
+/// Order parameter value, using `StateData::clex_trackers` if it is set
+Eigen::VectorXd _order_parameter(
+    std::shared_ptr<MonteCalculator> const &calculation,
+    std::string const &key) {
+  auto &state_data = *calculation->state_data();
+  return _get_sample_value(state_data, "order_parameter." + key, [&]() {
+    auto const &order_parameter = state_data.order_parameters.at(key);
+    if (state_data.clex_trackers) {
+      return Eigen::VectorXd(
+          state_data.clex_trackers->get_order_parameter(key, order_parameter)
+              .value());
+    }
+    return Eigen::VectorXd(order_parameter->value());
+  });
+}
+
+}  // namespace
+
 /// \brief Make temperature sampling function ("temperature")
 ///
 /// Requires:
@@ -44,13 +93,8 @@ state_sampling_function_type make_mol_composition_f(
       "mol_composition",
       "Number of each component (normalized per primitive cell)",
       components,  // component names
-      shape, [calculation]() {
-        auto const &system = get_system(calculation);
-        auto const &state = get_state(calculation);
-        Eigen::VectorXi const &occupation = get_occupation(state);
-        return get_composition_calculator(system).mean_num_each_component(
-            occupation);
-      });
+      shape,
+      [calculation]() { return _mean_num_each_component(calculation); });
 }
 
 /// \brief Make parametric composition sampling function ("param_composition")
@@ -73,16 +117,10 @@ state_sampling_function_type make_param_composition_f(
       component_names,  // component names
       shape, [calculation]() {
         auto const &system = get_system(calculation);
-        auto const &state = get_state(calculation);
-        composition::CompositionCalculator const &composition_calculator =
-            get_composition_calculator(system);
         composition::CompositionConverter const &composition_converter =
             get_composition_converter(system);
-
-        Eigen::VectorXi const &occupation = get_occupation(state);
-        Eigen::VectorXd mol_composition =
-            composition_calculator.mean_num_each_component(occupation);
-        return composition_converter.param_composition(mol_composition);
+        return composition_converter.param_composition(
+            _mean_num_each_component(calculation));
       });
 }
 
@@ -116,6 +154,12 @@ state_sampling_function_type make_param_chem_pot_f(
 
 /// \brief Make correlations sampling function ("corr.<key>")
 ///
+/// Notes:
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell
+/// - Otherwise, uses `StateData::parallel_corr`, if it is set, to calculate
+///   for the full supercell using multiple threads
+///
 /// \param calculation Monte Carlo calculator
 /// \param key Key into StateData::corr, a basis set name
 state_sampling_function_type make_corr_f(
@@ -128,7 +172,16 @@ state_sampling_function_type make_corr_f(
       std::string("corr.") + key,
       "Correlations values (normalized per primitive cell)", shape,
       [calculation, key]() {
-        auto &correlations = calculation->state_data()->corr.at(key);
+        auto &state_data = *calculation->state_data();
+        auto &correlations = state_data.corr.at(key);
+        if (state_data.clex_trackers) {
+          return state_data.clex_trackers->get_corr(key, correlations)
+              .per_unitcell();
+        }
+        auto it = state_data.parallel_corr.find(key);
+        if (it != state_data.parallel_corr.end()) {
+          return it->second->per_unitcell();
+        }
         auto const &per_supercell_corr = correlations->per_supercell();
         return correlations->per_unitcell(per_supercell_corr);
       });
@@ -136,16 +189,36 @@ state_sampling_function_type make_corr_f(
 
 /// \brief Make cluster expansion value sampling function ("clex.<key>")
 ///
+/// Notes:
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell
+/// - Otherwise, uses `StateData::parallel_corr`, if it is set, to calculate
+///   for the full supercell using multiple threads
+///
 /// \param calculation Monte Carlo calculator
 /// \param key Key into StateData::clex, a cluster expansion name
 state_sampling_function_type make_clex_f(
     std::shared_ptr<MonteCalculator> const &calculation, std::string key) {
+  auto const &clex_data = get_clex_data(get_system(calculation), key);
+  std::string basis_set_name = clex_data.basis_set_name;
+  clexulator::SparseCoefficients coefficients = clex_data.coefficients;
   return state_sampling_function_type(
       std::string("clex.") + key,
       "Cluster expansion value (normalized per primitive cell)", {},  // scalar
-      [calculation, key]() {
+      [calculation, key, basis_set_name, coefficients]() {
         Eigen::VectorXd value(1);
-        value(0) = calculation->state_data()->clex.at(key)->per_unitcell();
+        auto &state_data = *calculation->state_data();
+        auto &clex = state_data.clex.at(key);
+        auto it = state_data.parallel_corr.find(basis_set_name);
+        if (state_data.clex_trackers) {
+          value(0) =
+              state_data.clex_trackers->get_clex(key, clex).per_unitcell();
+        } else if (it != state_data.parallel_corr.end()) {
+          value(0) =
+              it->second->per_supercell(coefficients) / state_data.n_unitcells;
+        } else {
+          value(0) = clex->per_unitcell();
+        }
         return value;
       });
 }
@@ -153,11 +226,24 @@ state_sampling_function_type make_clex_f(
 /// \brief Make multi-cluster expansion value sampling function
 /// ("multiclex.<key>")
 ///
+/// Notes:
+/// - The correlations are evaluated once per sample, for all coefficient
+///   sets, so sampling many coefficient sets, for instance an ensemble of
+///   bootstrap fits, costs little more than sampling one
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell. If the potential uses the multi-cluster
+///   expansion (see EnsembleClusterExpansion), the tracker reuses the value
+///   changes the potential evaluated for accepted events.
+/// - Otherwise, uses `StateData::parallel_corr`, if it is set, to calculate
+///   for the full supercell using multiple threads
+///
 /// \param calculation Monte Carlo calculator
 /// \param key Key into StateData::multiclex, a multi-cluster expansion name
 state_sampling_function_type make_multiclex_f(
     std::shared_ptr<MonteCalculator> const &calculation, std::string key) {
   auto const &data = get_multiclex_data(get_system(calculation), key);
+  std::string basis_set_name = data.basis_set_name;
+  std::vector<clexulator::SparseCoefficients> coefficients = data.coefficients;
   std::vector<Index> shape;
   Index size = data.coefficients.size();
   shape.push_back(size);
@@ -171,17 +257,37 @@ state_sampling_function_type make_multiclex_f(
   }
 
   return state_sampling_function_type(
-      std::string("clex.") + key,
-      "Mulit-cluster expansion value (normalized per primitive cell)",
-      component_names,
-      shape,  // scalar
-      [calculation, key]() {
-        return calculation->state_data()->multiclex.at(key)->per_unitcell();
+      std::string("multiclex.") + key,
+      "Multi-cluster expansion value (normalized per primitive cell)",
+      component_names, shape,
+      [calculation, key, basis_set_name, coefficients]() -> Eigen::VectorXd {
+        auto &state_data = *calculation->state_data();
+        auto &multiclex = state_data.multiclex.at(key);
+        auto it = state_data.parallel_corr.find(basis_set_name);
+        if (state_data.clex_trackers) {
+          return state_data.clex_trackers->get_multiclex(key, multiclex)
+              .per_unitcell();
+        } else if (it == state_data.parallel_corr.end()) {
+          return multiclex->per_unitcell();
+        }
+        Eigen::VectorXd const &corr = it->second->per_unitcell();
+        Eigen::VectorXd value = Eigen::VectorXd::Zero(coefficients.size());
+        for (Index i = 0; i < coefficients.size(); ++i) {
+          auto const &coeff = coefficients[i];
+          for (Index k = 0; k < coeff.index.size(); ++k) {
+            value(i) += coeff.value[k] * corr(coeff.index[k]);
+          }
+        }
+        return value;
       });
 }
 
 /// \brief Make non-zero coefficients correlations sampling function
 ///     ("clex.<key>.sparse_corr")
+///
+/// Notes:
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell
 state_sampling_function_type make_clex_sparse_corr_f(
     std::shared_ptr<MonteCalculator> const &calculation, std::string key) {
   auto const &system = get_system(calculation);
@@ -200,11 +306,17 @@ state_sampling_function_type make_clex_sparse_corr_f(
       "Cluster expansion correlations, for non-zero coefficients (normalized "
       "per primitive cell)",
       component_names, shape, [calculation, key]() {
-        auto &correlations =
-            calculation->state_data()->clex.at(key)->correlations();
-        auto const &per_supercell_corr = correlations.per_supercell();
-        Eigen::VectorXd all_corr =
-            correlations.per_unitcell(per_supercell_corr);
+        auto &state_data = *calculation->state_data();
+        auto &clex = state_data.clex.at(key);
+        auto &correlations = clex->correlations();
+        Eigen::VectorXd all_corr;
+        if (state_data.clex_trackers) {
+          all_corr =
+              state_data.clex_trackers->get_clex_corr(key, clex).per_unitcell();
+        } else {
+          auto const &per_supercell_corr = correlations.per_supercell();
+          all_corr = correlations.per_unitcell(per_supercell_corr);
+        }
         auto const &indices = correlations.correlation_indices();
         Eigen::VectorXd sparse_corr(indices.size());
         Index i = 0;
@@ -264,7 +376,9 @@ state_sampling_function_type make_multiclex_sparse_corr_f(
 /// <label>)
 ///
 /// Notes:
-/// - This uses calculation->potential->per_unitcell()
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell
+/// - Otherwise, uses calculation->potential->per_unitcell()
 ///
 /// \param calculation Monte Carlo calculator
 /// \param label Name to give the sampling function
@@ -277,13 +391,33 @@ state_sampling_function_type make_potential_energy_f(
       label, desc, {},  // scalar
       [calculation]() {
         Eigen::VectorXd value(1);
-        value(0) = calculation->potential().per_unitcell();
+        auto &state_data = *calculation->state_data();
+        if (state_data.clex_trackers) {
+          auto potential =
+              std::make_shared<MontePotential>(calculation->potential());
+          auto per_supercell_f = [potential]() {
+            return potential->per_supercell();
+          };
+          auto occ_delta_f = [potential](monte::OccEvent const &event) {
+            return potential->occ_delta_per_supercell(event.linear_site_index,
+                                                      event.new_occ);
+          };
+          value(0) = state_data.clex_trackers
+                         ->get_potential(per_supercell_f, occ_delta_f)
+                         .per_unitcell();
+        } else {
+          value(0) = calculation->potential().per_unitcell();
+        }
         return value;
       });
 }
 
 /// \brief Make order parameter sampling function ("order_parameter.<key>")
 ///
+/// Notes:
+/// - Uses `StateData::clex_trackers`, if it is set, rather than calculating
+///   for the full supercell
+///
 /// \param calculation Monte Carlo calculator
 /// \param key Key into StateData::dof_spaces
 state_sampling_function_type make_order_parameter_f(
@@ -295,9 +429,7 @@ state_sampling_function_type make_order_parameter_f(
 
   return state_sampling_function_type(
       name, desc, {dof_space.subspace_dim},  // vector size
-      [calculation, key]() {
-        return calculation->state_data()->order_parameters.at(key)->value();
-      });
+      [calculation, key]() { return _order_parameter(calculation, key); });
 }
 
 /// \brief Make order parameter magnitudes by subspace sampling function
@@ -305,7 +437,8 @@ state_sampling_function_type make_order_parameter_f(
 ///
 /// Creates a "order_parameters.<key>.subspace_magnitudes" function for the
 /// specified DoFSpace, using the subspaces specified in the
-/// `calculation->system()->dof_subspaces` map.
+/// `calculation->system()->dof_subspaces` map. Uses `StateData::clex_trackers`,
+/// if it is set, rather than calculating for the full supercell.
 ///
 /// Example system input JSON, to measure the magnitude of the order parameter
 /// in four distinct subspaces:
@@ -345,8 +478,7 @@ state_sampling_function_type make_subspace_order_parameter_f(
   return state_sampling_function_type(
       name, desc, {n_subspaces},  // vector size
       [calculation, key]() {
-        Eigen::VectorXd eta =
-            calculation->state_data()->order_parameters.at(key)->value();
+        Eigen::VectorXd eta = _order_parameter(calculation, key);
 
         auto const &system = get_system(calculation);
         auto const &subspaces = system.dof_subspaces.at(key);
@@ -0,0 +1,216 @@
+#include "casm/clexmonte/nfold/canonical_nfold_events.hh"
+
+#include <set>
+
+#include "casm/clexmonte/events/PrimImpactInfoSnapshot.hh"
+#include "casm/clexmonte/events/event_methods.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/occ_events/orbits.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+CanonicalCompleteEventCalculator::CanonicalCompleteEventCalculator(
+    std::shared_ptr<canonical::CanonicalPotential> _potential,
+    std::vector<PrimEventData> const &_prim_event_list,
+    EventDataList const &_event_list)
+    : prim_event_list(_prim_event_list),
+      event_list(_event_list),
+      potential(_potential) {}
+
+/// \brief Calculate the rate of the event with the given event ID
+///
+/// The rate is the Metropolis acceptance probability, `min(1,
+/// exp(-beta * dE))`, if the event is allowed in the current configuration,
+/// else 0.0.
+double CanonicalCompleteEventCalculator::calculate_rate(EventID const &id) {
+  EventData const &event_data = event_list.at(id);
+  PrimEventData const &prim_event_data =
+      prim_event_list.at(id.prim_event_index);
+
+  /// ---
+
+  Eigen::VectorXi const &occupation = get_occupation(*potential->state());
+
+  int i = 0;
+  for (Index l : event_data.event.linear_site_index) {
+    if (occupation(l) != prim_event_data.occ_init[i]) {
+      event_state.is_allowed = false;
+      event_state.rate = 0.0;
+      return event_state.rate;
+    }
+    ++i;
+  }
+  event_state.is_allowed = true;
+
+  // calculate change in energy to final state
+  event_state.dE_final = potential->occ_delta_per_supercell(
+      event_data.event.linear_site_index, prim_event_data.occ_final);
+
+  // calculate rate
+  if (event_state.dE_final <= 0.0) {
+    event_state.rate = 1.0;
+  } else {
+    event_state.rate =
+        exp(-potential->conditions()->beta * event_state.dE_final);
+  }
+
+  /// ---
+
+  return event_state.rate;
+}
+
+/// \brief Calculate the rates of a batch of events
+///
+/// \param event_id_list Events to calculate
+/// \param rates Set to the event rates, with `rates[i]` being the rate of
+///     `event_id_list[i]`
+void CanonicalCompleteEventCalculator::calculate_rates(
+    std::vector<EventID> const &event_id_list, std::vector<double> &rates) {
+  rates.resize(event_id_list.size());
+  for (Index i = 0; i < event_id_list.size(); ++i) {
+    rates[i] = calculate_rate(event_id_list[i]);
+  }
+}
+
+namespace {
+
+occ_events::OccPosition _make_atom_position(
+    xtal::UnitCellCoord const &integral_site_coordinate, Index occupant_index) {
+  return occ_events::OccPosition{false, true, integral_site_coordinate,
+                                 occupant_index, 0};
+}
+
+/// \brief Make the canonical swap event exchanging the occupants of two sites
+///
+/// \param site_a, site_b The sites
+/// \param asym_a, asym_b The asymmetric unit indices of the sites
+/// \param species_a, species_b The species initially on `site_a` and
+///     `site_b`, respectively
+/// \param convert Index conversions
+occ_events::OccEvent _make_canonical_swap_event(
+    xtal::UnitCellCoord const &site_a, Index asym_a, Index species_a,
+    xtal::UnitCellCoord const &site_b, Index asym_b, Index species_b,
+    monte::Conversions const &convert) {
+  occ_events::OccTrajectory traj_a(
+      {_make_atom_position(site_a, convert.occ_index(asym_a, species_a)),
+       _make_atom_position(site_b, convert.occ_index(asym_b, species_a))});
+  occ_events::OccTrajectory traj_b(
+      {_make_atom_position(site_b, convert.occ_index(asym_b, species_b)),
+       _make_atom_position(site_a, convert.occ_index(asym_a, species_b))});
+  return occ_events::OccEvent({traj_a, traj_b});
+}
+
+}  // namespace
+
+/// \brief Make OccEventTypeData for canonical swap events
+///
+/// Events exchange the occupants of a site in the origin unit cell and a
+/// site in the same unit cell or one of the 6 unit cells neighboring it
+/// along the lattice vectors, as allowed by `canonical_swaps`, plus all
+/// symmetrically equivalent events. Each orbit of equivalent events is one
+/// event type. An event and its reverse are in the same event type.
+///
+/// \param system System data
+/// \param state A state, used to get index conversions
+/// \param canonical_swaps The allowed canonical swaps
+///
+/// \returns Event type data, with event type names
+///     "swap-<asym_a>-<species_a>-<asym_b>-<species_b>-<index>", where
+///     `index` distinguishes orbits with the same species and asymmetric
+///     units.
+std::map<std::string, OccEventTypeData> make_canonical_swap_event_type_data(
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::vector<monte::OccSwap> const &canonical_swaps) {
+  monte::Conversions const &convert = get_index_conversions(*system, state);
+  auto const &occevent_symgroup_rep = get_occevent_symgroup_rep(*system);
+
+  std::vector<Eigen::Vector3l> translations = {
+      Eigen::Vector3l(0, 0, 0),  Eigen::Vector3l(1, 0, 0),
+      Eigen::Vector3l(-1, 0, 0), Eigen::Vector3l(0, 1, 0),
+      Eigen::Vector3l(0, -1, 0), Eigen::Vector3l(0, 0, 1),
+      Eigen::Vector3l(0, 0, -1)};
+
+  std::map<std::string, OccEventTypeData> event_type_data;
+  std::set<std::set<occ_events::OccEvent>> orbits;
+  for (monte::OccSwap const &swap : canonical_swaps) {
+    Index asym_a = swap.cand_a.asym;
+    Index species_a = swap.cand_a.species_index;
+    Index asym_b = swap.cand_b.asym;
+    Index species_b = swap.cand_b.species_index;
+
+    // do not repeat forward and reverse, or the same swap with sites a and b
+    //   exchanged - reverse will be constructed by make_prim_event_list
+    if (species_a > species_b || asym_a > asym_b) {
+      continue;
+    }
+    Index n_orbits = 0;
+    for (Index b_a : convert.asym_to_b(asym_a)) {
+      for (Index b_b : convert.asym_to_b(asym_b)) {
+        for (Eigen::Vector3l const &translation : translations) {
+          if (b_a == b_b && translation.isZero()) {
+            continue;
+          }
+          xtal::UnitCellCoord site_a(b_a, 0, 0, 0);
+          xtal::UnitCellCoord site_b(b_b, xtal::UnitCell(translation));
+          occ_events::OccEvent event = _make_canonical_swap_event(
+              site_a, asym_a, species_a, site_b, asym_b, species_b, convert);
+
+          // skip events already included, forward or reverse
+          std::set<occ_events::OccEvent> orbit =
+              occ_events::make_prim_periodic_orbit(event,
+                                                   occevent_symgroup_rep);
+          std::set<occ_events::OccEvent> reverse_orbit =
+              occ_events::make_prim_periodic_orbit(copy_reverse(event),
+                                                   occevent_symgroup_rep);
+          if (orbits.count(orbit) || orbits.count(reverse_orbit)) {
+            continue;
+          }
+          orbits.insert(orbit);
+
+          std::string event_type_name =
+              "swap-" + std::to_string(asym_a) + "-" +
+              std::to_string(species_a) + "-" + std::to_string(asym_b) + "-" +
+              std::to_string(species_b) + "-" + std::to_string(n_orbits);
+          event_type_data[event_type_name].events =
+              std::vector<occ_events::OccEvent>(orbit.begin(), orbit.end());
+          ++n_orbits;
+        }
+      }
+    }
+  }
+  return event_type_data;
+}
+
+/// \brief Construct CanonicalNfoldEventData
+CanonicalNfoldEventData::CanonicalNfoldEventData(
+    std::shared_ptr<system_type> system, state_type const &state,
+    monte::OccLocation const &occ_location,
+    std::vector<monte::OccSwap> const &canonical_swaps,
+    std::shared_ptr<canonical::CanonicalPotential> potential) {
+  // Make OccEvents from canonical swaps
+  // key: event_type_name, value: symmetrically equivalent events
+  system->event_type_data =
+      make_canonical_swap_event_type_data(system, state, canonical_swaps);
+
+  prim_event_list = clexmonte::make_prim_event_list(*system);
+
+  prim_impact_info_list = clexmonte::load_or_make_prim_impact_info_list(
+      *system, prim_event_list, {"formation_energy"});
+
+  event_list = clexmonte::make_complete_event_list(
+      prim_event_list, prim_impact_info_list, occ_location);
+
+  // Construct CanonicalCompleteEventCalculator
+  event_calculator = std::make_shared<CanonicalCompleteEventCalculator>(
+      potential, prim_event_list, event_list.events);
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
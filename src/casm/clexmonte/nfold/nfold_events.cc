@@ -1,6 +1,7 @@
 
 #include "casm/clexmonte/nfold/nfold_events.hh"
 
+#include "casm/clexmonte/events/PrimImpactInfoSnapshot.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/state/Conditions.hh"
 #include "casm/clexmonte/system/System.hh"
@@ -15,28 +16,126 @@ namespace CASM {
 namespace clexmonte {
 namespace nfold {
 
+/// \brief Constructor
+///
+/// \param _potential Semi-grand canonical potential
+/// \param _prim_event_list Prim event list
+/// \param _event_list Complete event list
+/// \param convert Index conversions, used to find the species of the event
+///     sites
 CompleteEventCalculator::CompleteEventCalculator(
     std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
         _potential,
     std::vector<PrimEventData> const &_prim_event_list,
-    std::map<EventID, EventData> const &_event_list)
-    : prim_event_list(_prim_event_list),
-      event_list(_event_list),
-      potential(_potential) {}
+    EventDataList const &_event_list, monte::Conversions const &convert)
+    : prim_event_list(_prim_event_list), event_list(_event_list) {
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    std::vector<std::pair<Index, Index>> species;
+    for (Index i = 0; i < prim_event_data.sites.size(); ++i) {
+      Index asym = convert.b_to_asym(prim_event_data.sites[i].sublattice());
+      species.emplace_back(
+          convert.species_index(asym, prim_event_data.occ_init[i]),
+          convert.species_index(asym, prim_event_data.occ_final[i]));
+    }
+    prim_event_species.push_back(species);
+  }
+  set_potential(_potential);
+}
+
+/// \brief Set the potential, and the exchange chemical potential change
+///     due to each prim event at its conditions
+///
+/// Notes:
+/// - Must be called again if the potential conditions change
+void CompleteEventCalculator::set_potential(
+    std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
+        _potential) {
+  potential = _potential;
+  prim_event_delta_chem_pot.clear();
+  if (potential == nullptr || potential->conditions() == nullptr) {
+    return;
+  }
+  Eigen::MatrixXd const &exchange_chem_pot =
+      potential->conditions()->exchange_chem_pot;
+  for (auto const &species : prim_event_species) {
+    double delta_chem_pot = 0.0;
+    for (auto const &pair : species) {
+      delta_chem_pot -= exchange_chem_pot(pair.second, pair.first);
+    }
+    prim_event_delta_chem_pot.push_back(delta_chem_pot);
+  }
+}
 
 /// \brief Get CASM::monte::OccEvent corresponding to given event ID
 double CompleteEventCalculator::calculate_rate(EventID const &id) {
-  EventData const &event_data = event_list.at(id);
-  PrimEventData const &prim_event_data =
-      prim_event_list.at(id.prim_event_index);
+  return _calculate_rate(
+      event_list.at(id), prim_event_list.at(id.prim_event_index),
+      prim_event_delta_chem_pot.at(id.prim_event_index),
+      potential->get()->occupation, *potential->formation_energy(),
+      potential->conditions()->beta);
+}
 
-  /// ---
+/// \brief Calculate the rates of a batch of events
+///
+/// Events are grouped by prim event, so that the site species conversions
+/// and the exchange chemical potential term are evaluated once per prim
+/// event, and only the formation energy change is calculated per event.
+///
+/// \param event_id_list Events to calculate
+/// \param rates Set to the event rates, with `rates[i]` being the rate of
+///     `event_id_list[i]`
+void CompleteEventCalculator::calculate_rates(
+    std::vector<EventID> const &event_id_list, std::vector<double> &rates) {
+  Index n_prim_events = prim_event_list.size();
+  Index n_events = event_id_list.size();
+  rates.resize(n_events);
 
-  clexulator::ConfigDoFValues const *dof_values = potential->get();
+  // counting sort of event_id_list by prim_event_index
+  batch_offsets.assign(n_prim_events + 1, 0);
+  for (EventID const &id : event_id_list) {
+    if (id.prim_event_index < 0 || id.prim_event_index >= n_prim_events) {
+      throw std::out_of_range(
+          "Error in CompleteEventCalculator::calculate_rates: "
+          "prim_event_index out of range");
+    }
+    ++batch_offsets[id.prim_event_index + 1];
+  }
+  for (Index p = 0; p < n_prim_events; ++p) {
+    batch_offsets[p + 1] += batch_offsets[p];
+  }
+  batch_order.resize(n_events);
+  for (Index i = 0; i < n_events; ++i) {
+    batch_order[batch_offsets[event_id_list[i].prim_event_index]++] = i;
+  }
+  // batch_offsets[p] is now the end of group p, shift back to the beginning
+  for (Index p = n_prim_events; p > 0; --p) {
+    batch_offsets[p] = batch_offsets[p - 1];
+  }
+  batch_offsets[0] = 0;
+
+  Eigen::VectorXi const &occupation = potential->get()->occupation;
+  clexulator::ClusterExpansion &formation_energy =
+      *potential->formation_energy();
+  double beta = potential->conditions()->beta;
+  for (Index p = 0; p < n_prim_events; ++p) {
+    PrimEventData const &prim_event_data = prim_event_list[p];
+    double delta_chem_pot = prim_event_delta_chem_pot[p];
+    for (Index k = batch_offsets[p]; k < batch_offsets[p + 1]; ++k) {
+      Index i = batch_order[k];
+      rates[i] = _calculate_rate(event_list.at(event_id_list[i]),
+                                 prim_event_data, delta_chem_pot, occupation,
+                                 formation_energy, beta);
+    }
+  }
+}
 
+double CompleteEventCalculator::_calculate_rate(
+    EventData const &event_data, PrimEventData const &prim_event_data,
+    double delta_chem_pot, Eigen::VectorXi const &occupation,
+    clexulator::ClusterExpansion &formation_energy, double beta) {
   int i = 0;
   for (Index l : event_data.event.linear_site_index) {
-    if (dof_values->occupation(l) != prim_event_data.occ_init[i]) {
+    if (occupation(l) != prim_event_data.occ_init[i]) {
       event_state.is_allowed = false;
       event_state.rate = 0.0;
       return event_state.rate;
@@ -46,19 +145,17 @@ double CompleteEventCalculator::calculate_rate(EventID const &id) {
   event_state.is_allowed = true;
 
   // calculate change in energy to final state
-  event_state.dE_final = potential->occ_delta_per_supercell(
-      event_data.event.linear_site_index, prim_event_data.occ_final);
+  event_state.dE_final =
+      formation_energy.occ_delta_value(event_data.event.linear_site_index,
+                                       prim_event_data.occ_final) +
+      delta_chem_pot;
 
   // calculate rate
   if (event_state.dE_final <= 0.0) {
     event_state.rate = 1.0;
   } else {
-    event_state.rate =
-        exp(-potential->conditions()->beta * event_state.dE_final);
+    event_state.rate = exp(-beta * event_state.dE_final);
   }
-
-  /// ---
-
   return event_state.rate;
 }
 
@@ -169,7 +266,7 @@ NfoldEventData::NfoldEventData(
 
   prim_event_list = clexmonte::make_prim_event_list(*system);
 
-  prim_impact_info_list = clexmonte::make_prim_impact_info_list(
+  prim_impact_info_list = clexmonte::load_or_make_prim_impact_info_list(
       *system, prim_event_list, {"formation_energy"});
 
   // TODO: rejection-clexmonte option does not require impact table
@@ -178,7 +275,8 @@ NfoldEventData::NfoldEventData(
 
   // Construct CompleteEventCalculator
   event_calculator = std::make_shared<CompleteEventCalculator>(
-      potential, prim_event_list, event_list.events);
+      potential, prim_event_list, event_list.events,
+      get_index_conversions(*system, state));
 }
 
 }  // namespace nfold
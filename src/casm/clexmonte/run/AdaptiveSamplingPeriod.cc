@@ -0,0 +1,223 @@
+#include "casm/clexmonte/run/AdaptiveSamplingPeriod.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "casm/monte/run_management/SamplingFixture.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Estimate the integrated autocorrelation time of a series, in units
+///     of samples
+///
+/// Uses the windowed estimator `tau = 1 + 2 * sum_{t=1}^{M} rho(t)`, where
+/// `rho(t)` is the autocorrelation at lag `t` and the window `M` is the
+/// smallest lag with `M >= window_factor * tau(M)` (Sokal's automatic
+/// windowing). Independent samples give `tau ~= 1`.
+///
+/// \param x Series, in sampling order
+/// \param window_factor Automatic windowing factor
+///
+/// \returns Integrated autocorrelation time, or 1.0 if `x` has fewer than 2
+///     values or zero variance
+double integrated_autocorrelation_time(Eigen::VectorXd const &x,
+                                       double window_factor) {
+  Index n = x.size();
+  if (n < 2) {
+    return 1.0;
+  }
+  Eigen::VectorXd d = x.array() - x.mean();
+  double c0 = d.squaredNorm() / n;
+  if (!(c0 > 0.0)) {
+    return 1.0;
+  }
+  double tau = 1.0;
+  for (Index t = 1; t < n; ++t) {
+    double c = d.head(n - t).dot(d.tail(n - t)) / n;
+    tau += 2.0 * c / c0;
+    if (t >= window_factor * tau) {
+      break;
+    }
+  }
+  return tau;
+}
+
+/// \brief Constructor
+AdaptiveSamplingPeriod::AdaptiveSamplingPeriod(
+    AdaptiveSamplingPeriodParams _params)
+    : params(std::move(_params)),
+      m_period(params.initial_period),
+      m_autocorrelation_time(0.0) {
+  if (!(params.min_period > 0.0) || params.max_period < params.min_period) {
+    throw std::runtime_error(
+        "Error constructing AdaptiveSamplingPeriod: requires 0 < min_period "
+        "<= max_period");
+  }
+  if (params.initial_period < params.min_period ||
+      params.initial_period > params.max_period) {
+    throw std::runtime_error(
+        "Error constructing AdaptiveSamplingPeriod: initial_period is not in "
+        "[min_period, max_period]");
+  }
+  if (params.window < 16) {
+    throw std::runtime_error(
+        "Error constructing AdaptiveSamplingPeriod: window < 16");
+  }
+  if (!(params.max_change_factor > 1.0)) {
+    throw std::runtime_error(
+        "Error constructing AdaptiveSamplingPeriod: max_change_factor <= 1");
+  }
+}
+
+/// \brief Count (or time) at which sample `n` is taken
+///
+/// Positions are stored as they are generated, so repeated calls with the
+/// same `n` return the same value. `n == 0` begins a new run.
+double AdaptiveSamplingPeriod::sample_at(Index n) {
+  if (n == 0) {
+    m_period = params.initial_period;
+    m_autocorrelation_time = 0.0;
+    m_period_history = {m_period};
+    m_sample_at = {params.begin};
+    m_values.clear();
+    return m_sample_at[0];
+  }
+  if (n < 0 || n > Index(m_sample_at.size())) {
+    throw std::runtime_error(
+        "Error in AdaptiveSamplingPeriod::sample_at: samples must be "
+        "requested in order, beginning with sample 0");
+  }
+  while (Index(m_sample_at.size()) <= n) {
+    m_sample_at.push_back(m_sample_at.back() + m_period);
+  }
+  return m_sample_at[n];
+}
+
+/// \brief Add a sampled value of a sampling function
+///
+/// After `params.window` values of each sampling function are added, the
+/// autocorrelation time is estimated and the period updated.
+void AdaptiveSamplingPeriod::push(std::string const &sampler_name,
+                                  Eigen::VectorXd const &value) {
+  std::vector<Eigen::VectorXd> &values = m_values[sampler_name];
+  values.push_back(value);
+  for (auto const &pair : m_values) {
+    if (Index(pair.second.size()) < params.window) {
+      return;
+    }
+  }
+  _update();
+}
+
+/// Estimate the autocorrelation time and update the period
+void AdaptiveSamplingPeriod::_update() {
+  double tau_max = 0.0;
+  bool any_estimate = false;
+  for (auto const &pair : m_values) {
+    std::vector<Eigen::VectorXd> const &values = pair.second;
+    Index n = values.size();
+    Index n_components = values.front().size();
+    for (Index j = 0; j < n_components; ++j) {
+      Eigen::VectorXd x(n);
+      for (Index i = 0; i < n; ++i) {
+        x(i) = values[i](j);
+      }
+      if (!((x.array() - x.mean()).matrix().squaredNorm() > 0.0)) {
+        continue;
+      }
+      any_estimate = true;
+      double tau_s = integrated_autocorrelation_time(x, params.window_factor);
+      // invert tau_s = coth(period / tau); tau_s <= 1 means no resolvable
+      // correlation at the current period, so shrink as much as allowed
+      double tau = 0.0;
+      if (tau_s > 1.0) {
+        tau = m_period / std::atanh(1.0 / tau_s);
+      }
+      tau_max = std::max(tau_max, tau);
+    }
+  }
+  m_values.clear();
+  if (!any_estimate) {
+    return;
+  }
+  m_autocorrelation_time = tau_max;
+  // move half way to the estimate, on a log scale, to damp estimator noise
+  double f = params.max_change_factor;
+  double period = std::sqrt(m_period * std::max(tau_max, m_period / (f * f)));
+  period = std::clamp(period, m_period / f, m_period * f);
+  m_period = std::clamp(period, params.min_period, params.max_period);
+  m_period_history.push_back(m_period);
+}
+
+/// \brief Make a sampling fixture use an adaptive sampling period
+///
+/// Sets the sampling method of `sampling_fixture_params` to use
+/// `adaptive_sampling_period->sample_at` as its custom sample spacing, and
+/// wraps the sampling functions used to estimate the autocorrelation time so
+/// that their sampled values are pushed to `adaptive_sampling_period`.
+///
+/// The sampling period is in units of the fixture's sampling mode (steps,
+/// passes, or time). With `sampler_names` empty, the sampling functions with
+/// a requested precision in the fixture's completion check parameters are
+/// used.
+///
+/// \param sampling_fixture_params Sampling fixture parameters, modified
+/// \param adaptive_sampling_period Adaptive sampling period, which must not
+///     be shared with another sampling fixture
+void enable_adaptive_sampling_period(
+    sampling_fixture_params_type &sampling_fixture_params,
+    std::shared_ptr<AdaptiveSamplingPeriod> adaptive_sampling_period) {
+  if (!adaptive_sampling_period) {
+    throw std::runtime_error(
+        "Error in enable_adaptive_sampling_period: adaptive_sampling_period "
+        "is null");
+  }
+  std::vector<std::string> names =
+      adaptive_sampling_period->params.sampler_names;
+  if (names.empty()) {
+    for (auto const &pair :
+         sampling_fixture_params.completion_check_params.requested_precision) {
+      std::string const &name = pair.first.sampler_name;
+      if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.push_back(name);
+      }
+    }
+  }
+  if (names.empty()) {
+    throw std::runtime_error(
+        "Error in enable_adaptive_sampling_period: sampling fixture '" +
+        sampling_fixture_params.label +
+        "' has no requested precision and no sampler_names are given");
+  }
+
+  auto &sampling_functions = sampling_fixture_params.sampling_functions;
+  auto const &sampler_names =
+      sampling_fixture_params.sampling_params.sampler_names;
+  for (std::string const &name : names) {
+    auto it = sampling_functions.find(name);
+    if (it == sampling_functions.end() ||
+        std::find(sampler_names.begin(), sampler_names.end(), name) ==
+            sampler_names.end()) {
+      throw std::runtime_error(
+          "Error in enable_adaptive_sampling_period: sampling fixture '" +
+          sampling_fixture_params.label + "' does not sample '" + name + "'");
+    }
+    auto original_function = it->second.function;
+    it->second.function = [=]() -> Eigen::VectorXd {
+      Eigen::VectorXd value = original_function();
+      adaptive_sampling_period->push(name, value);
+      return value;
+    };
+  }
+
+  auto &s = sampling_fixture_params.sampling_params;
+  s.sample_method = monte::SAMPLE_METHOD::CUSTOM;
+  s.custom_sample_at = [=](monte::CountType n) -> double {
+    return adaptive_sampling_period->sample_at(n);
+  };
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,259 @@
+#include "casm/clexmonte/run/AsyncRunPool.hh"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Name of an AsyncRunStatus: "pending", "running", "finished",
+///     "cancelled", or "failed"
+std::string async_run_status_name(AsyncRunStatus status) {
+  switch (status) {
+    case AsyncRunStatus::pending:
+      return "pending";
+    case AsyncRunStatus::running:
+      return "running";
+    case AsyncRunStatus::finished:
+      return "finished";
+    case AsyncRunStatus::cancelled:
+      return "cancelled";
+    case AsyncRunStatus::failed:
+      return "failed";
+    default:
+      throw std::runtime_error(
+          "Error in async_run_status_name: invalid AsyncRunStatus");
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _run The run. Any objects it uses must be kept alive by the
+///     function, and not used by other threads until the run is done.
+/// \param _run_control The RunControl checked by the run, which is used to
+///     stop it if it is cancelled while running. May be null, if the run can
+///     only be cancelled before it starts.
+/// \param _telemetry The channel the run publishes its progress to. May be
+///     null.
+AsyncRun::AsyncRun(std::function<void()> _run,
+                   std::shared_ptr<RunControl> _run_control,
+                   std::shared_ptr<TelemetryChannel> _telemetry)
+    : run_control(_run_control),
+      telemetry(_telemetry),
+      m_run(std::move(_run)),
+      m_status(AsyncRunStatus::pending),
+      m_cancel_requested(false) {
+  if (m_run == nullptr) {
+    throw std::runtime_error("Error constructing AsyncRun: run == nullptr");
+  }
+}
+
+/// \brief Current status
+AsyncRunStatus AsyncRun::status() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_status;
+}
+
+/// \brief True if finished, cancelled, or failed
+bool AsyncRun::done() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _is_done();
+}
+
+/// \brief Cancel a pending run, or request that a running run stops
+///
+/// Does nothing if the run is done.
+void AsyncRun::cancel() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (_is_done()) {
+    return;
+  }
+  m_cancel_requested = true;
+  if (m_status == AsyncRunStatus::running && run_control) {
+    run_control->request_stop();
+  }
+}
+
+/// \brief Wait until the run is done
+void AsyncRun::wait() const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return _is_done(); });
+}
+
+/// \brief Wait until the run is done, for at most `timeout_s` seconds
+///
+/// \returns True if the run is done
+bool AsyncRun::wait_for(double timeout_s) const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_cv.wait_for(lock, std::chrono::duration<double>(timeout_s),
+                       [&] { return _is_done(); });
+}
+
+/// \brief Rethrow the exception that ended a failed run
+///
+/// Does nothing if the run did not fail.
+void AsyncRun::rethrow_if_failed() const {
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    exception = m_exception;
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/// \brief Add a function to call when the run is done
+///
+/// The function is called on the worker thread that performed the run, or
+/// on the calling thread if the run is already done. It must not throw.
+void AsyncRun::add_done_callback(std::function<void()> f) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!_is_done()) {
+      m_done_callbacks.push_back(std::move(f));
+      return;
+    }
+  }
+  f();
+}
+
+/// \brief Worker: Perform the run, unless cancelled
+///
+/// A run that was cancelled while pending is not started. The run function
+/// is released when the run is done, so objects it holds are not kept alive
+/// by the AsyncRun.
+void AsyncRun::execute() {
+  bool cancelled;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_status != AsyncRunStatus::pending) {
+      throw std::runtime_error(
+          "Error in AsyncRun::execute: run is not pending");
+    }
+    cancelled = m_cancel_requested;
+    if (!cancelled) {
+      m_status = AsyncRunStatus::running;
+    }
+  }
+  if (cancelled) {
+    _finish(AsyncRunStatus::cancelled, nullptr);
+    return;
+  }
+
+  std::exception_ptr exception;
+  try {
+    m_run();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  AsyncRunStatus status;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (exception) {
+      status = AsyncRunStatus::failed;
+    } else if (m_cancel_requested) {
+      status = AsyncRunStatus::cancelled;
+    } else {
+      status = AsyncRunStatus::finished;
+    }
+  }
+  _finish(status, exception);
+}
+
+/// Requires m_mutex is locked
+bool AsyncRun::_is_done() const {
+  return m_status != AsyncRunStatus::pending &&
+         m_status != AsyncRunStatus::running;
+}
+
+/// Set the final status, release the run function, and call done callbacks
+void AsyncRun::_finish(AsyncRunStatus status, std::exception_ptr exception) {
+  m_run = nullptr;
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_status = status;
+    m_exception = exception;
+    callbacks.swap(m_done_callbacks);
+  }
+  m_cv.notify_all();
+  for (auto const &f : callbacks) {
+    f();
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _n_workers Number of worker threads, which is the maximum number
+///     of runs in progress at once
+AsyncRunPool::AsyncRunPool(Index _n_workers) : m_stop(false) {
+  if (_n_workers < 1) {
+    throw std::runtime_error(
+        "Error constructing AsyncRunPool: n_workers < 1");
+  }
+  for (Index i = 0; i < _n_workers; ++i) {
+    m_threads.emplace_back(&AsyncRunPool::_work, this);
+  }
+}
+
+/// \brief Destructor, cancels pending runs and waits for running runs
+///
+/// Running runs are not stopped; call `AsyncRun::cancel` first to stop
+/// them.
+AsyncRunPool::~AsyncRunPool() {
+  std::deque<std::shared_ptr<AsyncRun>> pending;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+    pending.swap(m_queue);
+  }
+  m_cv.notify_all();
+  for (auto const &run : pending) {
+    run->cancel();
+    run->execute();
+  }
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/// \brief Queue a run
+void AsyncRunPool::submit(std::shared_ptr<AsyncRun> run) {
+  if (!run) {
+    throw std::runtime_error("Error in AsyncRunPool::submit: run is null");
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(std::move(run));
+  }
+  m_cv.notify_one();
+}
+
+/// \brief Number of submitted runs not yet started
+Index AsyncRunPool::n_pending() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_queue.size();
+}
+
+/// Worker thread: perform queued runs in order
+void AsyncRunPool::_work() {
+  while (true) {
+    std::shared_ptr<AsyncRun> run;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+      if (m_queue.empty()) {
+        return;
+      }
+      run = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    run->execute();
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,255 @@
+#include "casm/clexmonte/run/AsyncSampling.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _get_occupation Function which returns the current occupation
+/// \param _n_threads Number of worker threads
+/// \param _max_pending Maximum number of pending evaluations, before
+///     `record` blocks
+AsyncSampling::AsyncSampling(
+    std::function<Eigen::VectorXi const &()> _get_occupation,
+    Index _n_threads, Index _max_pending)
+    : m_get_occupation(_get_occupation),
+      m_max_pending(_max_pending),
+      m_n_snapshots(0),
+      m_n_busy(0),
+      m_stop(false) {
+  if (m_get_occupation == nullptr) {
+    throw std::runtime_error(
+        "Error constructing AsyncSampling: get_occupation == nullptr");
+  }
+  if (_n_threads < 1) {
+    throw std::runtime_error("Error constructing AsyncSampling: n_threads < 1");
+  }
+  if (m_max_pending < 1) {
+    throw std::runtime_error(
+        "Error constructing AsyncSampling: max_pending < 1");
+  }
+  for (Index i = 0; i < _n_threads; ++i) {
+    m_threads.emplace_back(&AsyncSampling::_work, this);
+  }
+}
+
+AsyncSampling::~AsyncSampling() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/// \brief Register a function
+///
+/// \param name Function name, must be unique
+/// \param component_names Names of the components of calculated values
+/// \param make_function Function which makes the function which calculates
+///     a value from an occupation. It is called once per worker thread, on
+///     the worker thread.
+///
+/// \returns The function index
+Index AsyncSampling::add_function(std::string name,
+                                  std::vector<std::string> component_names,
+                                  make_function_type make_function) {
+  if (make_function == nullptr) {
+    throw std::runtime_error(
+        "Error in AsyncSampling::add_function: make_function == nullptr");
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (Function const &f : m_functions) {
+    if (f.name == name) {
+      throw std::runtime_error(
+          "Error in AsyncSampling::add_function: a function named \"" + name +
+          "\" already exists");
+    }
+  }
+  m_functions.push_back(Function{name, component_names, make_function, {}});
+  return m_functions.size() - 1;
+}
+
+/// \brief Index of a registered function, by name
+Index AsyncSampling::function_index(std::string const &name) const {
+  for (Index i = 0; i < Index(m_functions.size()); ++i) {
+    if (m_functions[i].name == name) {
+      return i;
+    }
+  }
+  throw std::runtime_error("Error in AsyncSampling: no function named \"" +
+                           name + "\"");
+}
+
+/// \brief Names of the components of a registered function
+std::vector<std::string> const &AsyncSampling::component_names(
+    Index function_index) const {
+  return m_functions.at(function_index).component_names;
+}
+
+/// \brief Snapshot the current occupation and queue the evaluation of a
+///     function
+///
+/// \returns The row of `values` where the value of this sample is stored
+Index AsyncSampling::record(Index function_index) {
+  Eigen::VectorXi const &occupation = m_get_occupation();
+  if (!m_snapshot || m_snapshot->size() != occupation.size() ||
+      *m_snapshot != occupation) {
+    m_snapshot = std::make_shared<Eigen::VectorXi const>(occupation);
+    ++m_n_snapshots;
+  }
+  Index sample_index;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [&] {
+      return m_exception || Index(m_queue.size()) + m_n_busy < m_max_pending;
+    });
+    _rethrow_if_failed();
+    std::vector<Eigen::VectorXd> &values =
+        m_functions.at(function_index).values;
+    sample_index = values.size();
+    values.emplace_back();
+    m_queue.push_back(Task{function_index, sample_index, m_snapshot});
+  }
+  m_cv.notify_all();
+  return sample_index;
+}
+
+/// \brief Wait for all pending evaluations to finish
+void AsyncSampling::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return m_queue.empty() && m_n_busy == 0; });
+  _rethrow_if_failed();
+}
+
+/// \brief Wait for pending evaluations and return the sampled values of a
+///     function
+///
+/// \returns Sampled values, with one row per sample and one column per
+///     component
+Eigen::MatrixXd AsyncSampling::values(std::string const &name) {
+  wait();
+  Function const &f = m_functions[function_index(name)];
+  Eigen::MatrixXd result(f.values.size(), f.component_names.size());
+  for (Index i = 0; i < Index(f.values.size()); ++i) {
+    result.row(i) = f.values[i].transpose();
+  }
+  return result;
+}
+
+/// \brief Number of samples recorded for a function
+Index AsyncSampling::n_samples(std::string const &name) const {
+  return m_functions[function_index(name)].values.size();
+}
+
+/// \brief Wait for pending evaluations, then clear sampled values
+void AsyncSampling::reset() {
+  wait();
+  for (Function &f : m_functions) {
+    f.values.clear();
+  }
+  m_snapshot.reset();
+  m_n_snapshots = 0;
+}
+
+/// Rethrow, and clear, an evaluation exception. Requires m_mutex is locked.
+void AsyncSampling::_rethrow_if_failed() {
+  if (m_exception) {
+    std::exception_ptr exception = m_exception;
+    m_exception = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+/// Worker thread: evaluate queued tasks, with one evaluator per function
+void AsyncSampling::_work() {
+  std::vector<evaluate_function_type> evaluators;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;
+    }
+    Task task = std::move(m_queue.front());
+    m_queue.pop_front();
+    ++m_n_busy;
+    Function const &f = m_functions[task.function_index];
+    make_function_type make_function;
+    if (Index(evaluators.size()) <= task.function_index ||
+        evaluators[task.function_index] == nullptr) {
+      make_function = f.make_function;
+    }
+    std::string name = f.name;
+    Index n_components = f.component_names.size();
+    lock.unlock();
+
+    std::exception_ptr exception;
+    Eigen::VectorXd value;
+    try {
+      if (make_function) {
+        evaluators.resize(std::max(Index(evaluators.size()),
+                                   task.function_index + 1));
+        evaluators[task.function_index] = make_function();
+      }
+      value = evaluators[task.function_index](*task.occupation);
+      if (value.size() != n_components) {
+        std::stringstream msg;
+        msg << "Error in AsyncSampling function \"" << name
+            << "\": calculated value has size " << value.size()
+            << ", expected " << n_components;
+        throw std::runtime_error(msg.str());
+      }
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception) {
+      m_exception = exception;
+      m_queue.clear();
+    } else {
+      m_functions[task.function_index].values[task.sample_index] =
+          std::move(value);
+    }
+    --m_n_busy;
+    m_cv.notify_all();
+  }
+}
+
+/// \brief Make a state sampling function which records samples for an
+///     AsyncSampling function
+///
+/// \param async_sampling The AsyncSampling
+/// \param name Name of a function registered with `async_sampling`
+/// \param description Sampling function description
+///
+/// \returns A scalar state sampling function, named `name`, which calls
+///     `async_sampling->record` and returns the row of
+///     `async_sampling->values(name)` where the value of the sample is
+///     stored.
+monte::StateSamplingFunction make_async_state_sampling_function(
+    std::shared_ptr<AsyncSampling> async_sampling, std::string name,
+    std::string description) {
+  if (!async_sampling) {
+    throw std::runtime_error(
+        "Error in make_async_state_sampling_function: async_sampling is null");
+  }
+  Index function_index = async_sampling->function_index(name);
+  return monte::StateSamplingFunction(
+      name, description, {},  // scalar
+      [async_sampling, function_index]() -> Eigen::VectorXd {
+        return Eigen::VectorXd::Constant(
+            1, async_sampling->record(function_index));
+      });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,197 @@
+#include "casm/clexmonte/run/AutoEquilibration.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/clexmonte/misc/BatchMeansStatistics.hh"
+#include "casm/monte/run_management/SamplingFixture.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief (Weighted) mean of observations in [begin, end)
+double _mean(Eigen::VectorXd const &observations,
+             Eigen::VectorXd const &sample_weight, Index begin, Index end) {
+  auto x = observations.segment(begin, end - begin);
+  if (sample_weight.size() == 0) {
+    return x.mean();
+  }
+  auto w = sample_weight.segment(begin, end - begin);
+  return x.dot(w) / w.sum();
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _confidence Confidence level of the drift test
+/// \param _min_samples Minimum number of observations to attempt the test,
+///     at least 16 are required
+DriftEquilibrationCheck::DriftEquilibrationCheck(double _confidence,
+                                                 Index _min_samples)
+    : confidence(_confidence),
+      min_samples(std::max(_min_samples, Index(16))) {}
+
+/// \brief Check equilibration
+///
+/// \param observations Observations, in sampling order
+/// \param sample_weight Sample weights, or empty for equally weighted
+///     samples
+/// \param requested_precision Unused
+///
+/// \returns If equilibrated, `N_samples_for_equilibration` is the number of
+///     observations before the trailing half
+monte::IndividualEquilibrationCheckResult DriftEquilibrationCheck::operator()(
+    Eigen::VectorXd const &observations, Eigen::VectorXd const &sample_weight,
+    monte::RequestedPrecision requested_precision) const {
+  if (sample_weight.size() != 0 &&
+      sample_weight.size() != observations.size()) {
+    throw std::runtime_error(
+        "Error in DriftEquilibrationCheck: sample_weight size does not match "
+        "observations size");
+  }
+  monte::IndividualEquilibrationCheckResult result;
+  result.is_equilibrated = false;
+  result.N_samples_for_equilibration = 0;
+  Index n = observations.size();
+  if (n < min_samples) {
+    return result;
+  }
+
+  // trailing half [begin, n), split into halves at mid, each split into
+  // n_batches batches
+  Index n_batches = 4;
+  Index begin = n / 2;
+  Index mid = begin + (n - begin) / 2;
+  double half_mean[2];
+  double ss = 0.0;
+  Index half_begin[3] = {begin, mid, n};
+  for (Index h = 0; h < 2; ++h) {
+    Index b = half_begin[h];
+    Index e = half_begin[h + 1];
+    half_mean[h] = _mean(observations, sample_weight, b, e);
+    for (Index i = 0; i < n_batches; ++i) {
+      Index batch_b = b + (e - b) * i / n_batches;
+      Index batch_e = b + (e - b) * (i + 1) / n_batches;
+      double d = _mean(observations, sample_weight, batch_b, batch_e) -
+                 half_mean[h];
+      ss += d * d;
+    }
+  }
+
+  // pooled variance of batch means, and standard error of the difference
+  // of the half means
+  double var_batch = ss / (2 * (n_batches - 1));
+  double std_err = std::sqrt(2.0 * var_batch / n_batches);
+  double diff = std::abs(half_mean[1] - half_mean[0]);
+  if (diff <= normal_confidence_interval_z(confidence) * std_err) {
+    result.is_equilibrated = true;
+    result.N_samples_for_equilibration = begin;
+  }
+  return result;
+}
+
+/// \brief Constructor
+AutoEquilibration::AutoEquilibration(AutoEquilibrationParams _params)
+    : params(std::move(_params)) {
+  if (params.min_n_samples < 0 || params.max_n_samples < 1 ||
+      params.min_n_samples > params.max_n_samples) {
+    throw std::runtime_error(
+        "Error constructing AutoEquilibration: requires 0 <= min_n_samples "
+        "<= max_n_samples and max_n_samples >= 1");
+  }
+  if (!(params.learned_length_fraction > 0.0)) {
+    throw std::runtime_error(
+        "Error constructing AutoEquilibration: learned_length_fraction <= 0");
+  }
+}
+
+/// \brief Make sampling fixture parameters for an equilibration run
+///
+/// \param before_each_run Sampling fixture parameters for the "before each
+///     run" run, which must sample at least one of `params.sampler_names`
+///
+/// \returns Copies of `before_each_run`, with the equilibration check,
+///     requested precision, and sample cutoffs set as described for
+///     AutoEquilibration. Other requested precisions are removed.
+std::vector<sampling_fixture_params_type>
+AutoEquilibration::make_sampling_fixture_params(
+    std::vector<sampling_fixture_params_type> const &before_each_run) const {
+  std::optional<Index> guess = initial_guess();
+  std::vector<sampling_fixture_params_type> result = before_each_run;
+  for (sampling_fixture_params_type &fixture_params : result) {
+    auto &c = fixture_params.completion_check_params;
+    c.equilibration_check_f =
+        DriftEquilibrationCheck(params.confidence, params.min_n_samples);
+    c.requested_precision.clear();
+    for (std::string const &name : params.sampler_names) {
+      auto const &sampler_names = fixture_params.sampling_params.sampler_names;
+      if (std::find(sampler_names.begin(), sampler_names.end(), name) ==
+          sampler_names.end()) {
+        continue;
+      }
+      auto it = fixture_params.sampling_functions.find(name);
+      if (it == fixture_params.sampling_functions.end()) {
+        continue;
+      }
+      auto const &component_names = it->second.component_names;
+      for (Index i = 0; i < component_names.size(); ++i) {
+        monte::SamplerComponent key(name, i, component_names[i]);
+        c.requested_precision[key] = monte::RequestedPrecision::abs(
+            std::numeric_limits<double>::max());
+      }
+    }
+    if (c.requested_precision.empty()) {
+      throw std::runtime_error(
+          "Error in AutoEquilibration::make_sampling_fixture_params: "
+          "sampling fixture '" +
+          fixture_params.label +
+          "' does not sample any of the drift test quantities");
+    }
+    Index min_n_samples = params.min_n_samples;
+    if (guess.has_value()) {
+      min_n_samples = std::max(min_n_samples, *guess);
+    }
+    c.cutoff_params.min_sample = std::min(min_n_samples, params.max_n_samples);
+    c.cutoff_params.max_sample = params.max_n_samples;
+  }
+  return result;
+}
+
+/// \brief Record the number of samples of a completed equilibration run
+void AutoEquilibration::record(Index n_samples) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_history.push_back(n_samples);
+}
+
+/// \brief Learned minimum number of samples, or std::nullopt if not
+///     learning or no runs are recorded
+///
+/// The learned value is `params.learned_length_fraction` times the median
+/// of the recorded numbers of samples, so a typical equilibration run
+/// begins checking the drift test shortly before it is expected to pass.
+std::optional<Index> AutoEquilibration::initial_guess() const {
+  if (!params.learn_length) {
+    return std::nullopt;
+  }
+  std::vector<Index> lengths = history();
+  if (lengths.empty()) {
+    return std::nullopt;
+  }
+  auto median_it = lengths.begin() + lengths.size() / 2;
+  std::nth_element(lengths.begin(), median_it, lengths.end());
+  return Index(std::floor(params.learned_length_fraction * (*median_it)));
+}
+
+/// \brief Number of samples of each recorded equilibration run
+std::vector<Index> AutoEquilibration::history() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_history;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,86 @@
+#include "casm/clexmonte/run/BackgroundWriter.hh"
+
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+BackgroundWriter::BackgroundWriter(Index _max_queue_size)
+    : m_max_queue_size(_max_queue_size), m_is_busy(false), m_stop(false) {
+  if (m_max_queue_size < 1) {
+    throw std::runtime_error(
+        "Error constructing BackgroundWriter: max_queue_size < 1");
+  }
+  m_thread = std::thread(&BackgroundWriter::_work, this);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+/// \brief Queue a task, blocking while the queue is full
+void BackgroundWriter::push(std::function<void()> task) {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [&] {
+      return m_exception || Index(m_queue.size()) < m_max_queue_size;
+    });
+    _rethrow_if_failed();
+    m_queue.push_back(std::move(task));
+  }
+  m_cv.notify_all();
+}
+
+/// \brief Wait for all queued tasks to finish
+void BackgroundWriter::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return m_queue.empty() && !m_is_busy; });
+  _rethrow_if_failed();
+}
+
+/// Rethrow, and clear, a task exception. Requires m_mutex is locked.
+void BackgroundWriter::_rethrow_if_failed() {
+  if (m_exception) {
+    std::exception_ptr exception = m_exception;
+    m_exception = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+/// Background thread: perform queued tasks in order
+void BackgroundWriter::_work() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;
+    }
+    std::function<void()> task = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_is_busy = true;
+    lock.unlock();
+
+    std::exception_ptr exception;
+    try {
+      task();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception) {
+      m_exception = exception;
+      m_queue.clear();
+    }
+    m_is_busy = false;
+    m_cv.notify_all();
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,137 @@
+#include "casm/clexmonte/run/BatchedSamplingFunction.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _name Sampling function name
+/// \param _description Sampling function description
+/// \param _component_names Names of the components of batched values
+/// \param _batch_size Number of samples per call of `_batch_function`
+/// \param _batch_function Function which calculates values from occupations,
+///     one row per sample
+/// \param _get_occupation Function which returns the current occupation
+BatchedSamplingFunction::BatchedSamplingFunction(
+    std::string _name, std::string _description,
+    std::vector<std::string> _component_names, Index _batch_size,
+    batch_function_type _batch_function,
+    std::function<Eigen::VectorXi const &()> _get_occupation)
+    : name(_name),
+      description(_description),
+      component_names(_component_names),
+      batch_size(_batch_size),
+      m_batch_function(_batch_function),
+      m_get_occupation(_get_occupation),
+      m_n_buffered(0),
+      m_n_evaluated(0),
+      m_n_batches(0) {
+  if (batch_size < 1) {
+    throw std::runtime_error(
+        "Error constructing BatchedSamplingFunction: batch_size < 1");
+  }
+  if (m_batch_function == nullptr) {
+    throw std::runtime_error(
+        "Error constructing BatchedSamplingFunction: batch_function == "
+        "nullptr");
+  }
+  if (m_get_occupation == nullptr) {
+    throw std::runtime_error(
+        "Error constructing BatchedSamplingFunction: get_occupation == "
+        "nullptr");
+  }
+}
+
+/// \brief Record the current occupation, evaluating a batch if the buffer
+///     is full
+///
+/// \returns The row of `values` where the value of this sample is stored
+Index BatchedSamplingFunction::record() {
+  Eigen::VectorXi const &occupation = m_get_occupation();
+  if (occupation.size() != m_buffer.cols()) {
+    flush();
+    m_buffer.resize(batch_size, occupation.size());
+  }
+  m_buffer.row(m_n_buffered) = occupation.transpose();
+  ++m_n_buffered;
+  Index sample_index = n_samples() - 1;
+  if (m_n_buffered == batch_size) {
+    flush();
+  }
+  return sample_index;
+}
+
+/// \brief Evaluate buffered samples
+void BatchedSamplingFunction::flush() {
+  if (m_n_buffered == 0) {
+    return;
+  }
+  Index n = m_n_buffered;
+  Eigen::MatrixXd batch_values = m_batch_function(m_buffer.topRows(n));
+  ++m_n_batches;
+  if (batch_values.rows() != n ||
+      batch_values.cols() != Index(component_names.size())) {
+    std::stringstream msg;
+    msg << "Error in BatchedSamplingFunction \"" << name
+        << "\": batch_function returned a " << batch_values.rows() << "x"
+        << batch_values.cols() << " matrix, expected " << n << "x"
+        << component_names.size();
+    throw std::runtime_error(msg.str());
+  }
+  if (m_n_evaluated + n > m_values.rows()) {
+    Index capacity = std::max(2 * m_values.rows(), m_n_evaluated + n);
+    m_values.conservativeResize(capacity, component_names.size());
+  }
+  m_values.middleRows(m_n_evaluated, n) = batch_values;
+  m_n_evaluated += n;
+  m_n_buffered = 0;
+}
+
+/// \brief Evaluate buffered samples and return all sampled values
+///
+/// \returns Sampled values, with one row per sample and one column per
+///     component
+Eigen::MatrixXd BatchedSamplingFunction::values() {
+  flush();
+  return m_values.topRows(m_n_evaluated);
+}
+
+/// \brief Clear buffered samples and sampled values
+void BatchedSamplingFunction::reset() {
+  m_n_buffered = 0;
+  m_n_evaluated = 0;
+  m_n_batches = 0;
+  m_values.resize(0, component_names.size());
+}
+
+/// \brief Make a state sampling function which records samples for a
+///     BatchedSamplingFunction
+///
+/// \param batched_function The batched function
+///
+/// \returns A scalar state sampling function, with the name and description
+///     of `batched_function`, which calls `batched_function->record()` and
+///     returns the row of `batched_function->values()` where the batched
+///     value of the sample is stored.
+monte::StateSamplingFunction make_batched_state_sampling_function(
+    std::shared_ptr<BatchedSamplingFunction> batched_function) {
+  if (!batched_function) {
+    throw std::runtime_error(
+        "Error in make_batched_state_sampling_function: batched_function is "
+        "null");
+  }
+  return monte::StateSamplingFunction(
+      batched_function->name, batched_function->description, {},  // scalar
+      [batched_function]() -> Eigen::VectorXd {
+        return Eigen::VectorXd::Constant(1, batched_function->record());
+      });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,366 @@
+#include "casm/clexmonte/run/ColumnarResultsIO.hh"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte/run_management/Results.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// One row of a per-run column
+struct Row {
+  Eigen::VectorXd value;
+  std::vector<std::string> component_names;
+  std::string value_type;
+  std::vector<Index> shape;
+};
+
+std::vector<std::string> make_index_component_names(Index n) {
+  std::vector<std::string> names;
+  for (Index i = 0; i < n; ++i) {
+    names.push_back(std::to_string(i));
+  }
+  return names;
+}
+
+Row make_scalar_row(double value, std::string value_type = "scalar") {
+  return Row{Eigen::VectorXd::Constant(1, value), {"0"}, value_type, {}};
+}
+
+void write_values(std::ofstream &file, double const *data, Index size,
+                  fs::path const &path) {
+  file.write(reinterpret_cast<char const *>(data), size * sizeof(double));
+  if (!file) {
+    std::stringstream msg;
+    msg << "Error in ColumnarResultsIO: failed writing " << path;
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/// Write one per-sample column, and add it to the run index
+void write_sample_column(fs::path const &run_dir, std::string const &name,
+                         std::vector<std::string> const &component_names,
+                         Eigen::MatrixXd const &values, jsonParser &json,
+                         bool is_float32 = false) {
+  fs::path path = run_dir / (name + ".bin");
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  // row-major
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      row_major = values;
+  if (is_float32) {
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        row_major_float = row_major.cast<float>();
+    file.write(reinterpret_cast<char const *>(row_major_float.data()),
+               row_major_float.size() * sizeof(float));
+    if (!file) {
+      std::stringstream msg;
+      msg << "Error in ColumnarResultsIO: failed writing " << path;
+      throw std::runtime_error(msg.str());
+    }
+  } else {
+    write_values(file, row_major.data(), row_major.size(), path);
+  }
+  jsonParser &column_json = json[name];
+  column_json["file"] = name + ".bin";
+  column_json["dtype"] = is_float32 ? "float32" : "float64";
+  column_json["component_names"] = component_names;
+  column_json["n_samples"] = values.rows();
+}
+
+template <typename T>
+Eigen::MatrixXd to_column(std::vector<T> const &values) {
+  Eigen::MatrixXd column(values.size(), 1);
+  for (Index i = 0; i < Index(values.size()); ++i) {
+    column(i, 0) = static_cast<double>(values[i]);
+  }
+  return column;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _output_dir Directory where columns are written
+/// \param _write_observations If true, write the per-sample columns of each
+///     run
+/// \param _float32_sampler_names Names of samplers whose per-sample columns
+///     are stored as float32, rather than float64
+ColumnarResultsIO::ColumnarResultsIO(
+    fs::path _output_dir, bool _write_observations,
+    std::set<std::string> _float32_sampler_names)
+    : m_output_dir(_output_dir),
+      m_write_observations(_write_observations),
+      m_float32_sampler_names(std::move(_float32_sampler_names)),
+      m_is_loaded(false),
+      m_n_runs(0) {}
+
+/// \brief Read the conditions of the runs written, in order
+std::vector<monte::ValueMap> ColumnarResultsIO::read_conditions() {
+  _load();
+  std::vector<monte::ValueMap> conditions(m_n_runs);
+  std::string prefix = "conditions.";
+  for (auto const &pair : m_columns) {
+    if (pair.first.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    std::string key = pair.first.substr(prefix.size());
+    Column const &column = pair.second;
+    Eigen::MatrixXd values = read_results_column(m_output_dir, pair.first);
+    for (Index i = 0; i < m_n_runs; ++i) {
+      Eigen::VectorXd value = values.row(i).transpose();
+      if (value.size() && std::isnan(value(0))) {
+        continue;
+      }
+      if (column.value_type == "scalar") {
+        conditions[i].scalar_values[key] = value(0);
+      } else if (column.value_type == "boolean") {
+        conditions[i].boolean_values[key] = (value(0) != 0.0);
+      } else if (column.value_type == "vector") {
+        conditions[i].vector_values[key] = value;
+      } else if (column.value_type == "matrix") {
+        conditions[i].matrix_values[key] =
+            Eigen::Map<Eigen::MatrixXd>(value.data(), column.shape[0],
+                                        column.shape[1]);
+      }
+    }
+  }
+  return conditions;
+}
+
+/// \brief Append the results of one run
+///
+/// \param results Results of the run
+/// \param conditions Conditions of the run
+/// \param run_index Index of the run, written to the "run_index" column and
+///     used to name the run directory
+void ColumnarResultsIO::write(results_type const &results,
+                              monte::ValueMap const &conditions,
+                              Index run_index) {
+  _load();
+  fs::create_directories(m_output_dir);
+
+  // Collect the row of each per-run column
+  std::map<std::string, Row> rows;
+  rows["run_index"] = make_scalar_row(run_index);
+  rows["n_samples"] = make_scalar_row(results.sample_count.size());
+  rows["n_accept"] = make_scalar_row(results.n_accept);
+  rows["n_reject"] = make_scalar_row(results.n_reject);
+  rows["elapsed_clocktime"] = make_scalar_row(
+      results.elapsed_clocktime.has_value()
+          ? *results.elapsed_clocktime
+          : std::numeric_limits<double>::quiet_NaN());
+  auto const &completion = results.completion_check_results;
+  rows["is_complete"] = make_scalar_row(completion.is_complete, "boolean");
+  rows["all_equilibrated"] = make_scalar_row(
+      completion.equilibration_check_results.all_equilibrated, "boolean");
+  rows["all_converged"] = make_scalar_row(
+      completion.convergence_check_results.all_converged, "boolean");
+  for (auto const &pair : conditions.scalar_values) {
+    rows["conditions." + pair.first] = make_scalar_row(pair.second);
+  }
+  for (auto const &pair : conditions.boolean_values) {
+    rows["conditions." + pair.first] =
+        make_scalar_row(pair.second, "boolean");
+  }
+  for (auto const &pair : conditions.vector_values) {
+    Index n = pair.second.size();
+    rows["conditions." + pair.first] =
+        Row{pair.second, make_index_component_names(n), "vector", {n}};
+  }
+  for (auto const &pair : conditions.matrix_values) {
+    Eigen::MatrixXd const &M = pair.second;
+    rows["conditions." + pair.first] =
+        Row{Eigen::Map<Eigen::VectorXd const>(M.data(), M.size()),
+            make_index_component_names(M.size()), "matrix",
+            {M.rows(), M.cols()}};
+  }
+  for (auto const &pair : results.analysis) {
+    Index n = pair.second.size();
+    std::vector<std::string> component_names = make_index_component_names(n);
+    auto f_it = results.analysis_functions.find(pair.first);
+    if (f_it != results.analysis_functions.end() &&
+        Index(f_it->second.component_names.size()) == n) {
+      component_names = f_it->second.component_names;
+    }
+    rows["analysis." + pair.first] =
+        Row{pair.second, component_names, "vector", {n}};
+  }
+
+  // Register new columns, with NaN rows for the runs already written
+  for (auto const &pair : rows) {
+    if (m_columns.count(pair.first)) {
+      continue;
+    }
+    Row const &row = pair.second;
+    m_columns[pair.first] = Column{row.component_names, row.value_type,
+                                   row.shape};
+    fs::path path = m_output_dir / (pair.first + ".bin");
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::vector<double> nan_rows(
+        m_n_runs * row.value.size(), std::numeric_limits<double>::quiet_NaN());
+    write_values(file, nan_rows.data(), nan_rows.size(), path);
+  }
+
+  // Append one row to every column
+  for (auto const &pair : m_columns) {
+    Column const &column = pair.second;
+    Index n = column.component_names.size();
+    Eigen::VectorXd value =
+        Eigen::VectorXd::Constant(n, std::numeric_limits<double>::quiet_NaN());
+    auto it = rows.find(pair.first);
+    if (it != rows.end()) {
+      if (it->second.value.size() != n) {
+        std::stringstream msg;
+        msg << "Error in ColumnarResultsIO: the size of \"" << pair.first
+            << "\" changed";
+        throw std::runtime_error(msg.str());
+      }
+      value = it->second.value;
+    }
+    fs::path path = m_output_dir / (pair.first + ".bin");
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    write_values(file, value.data(), value.size(), path);
+  }
+
+  // Per-sample columns
+  if (m_write_observations) {
+    fs::path run_dir = m_output_dir / ("run." + std::to_string(run_index));
+    fs::create_directories(run_dir);
+    jsonParser json = jsonParser::object();
+    for (auto const &pair : results.samplers) {
+      write_sample_column(run_dir, pair.first,
+                          pair.second->component_names(),
+                          pair.second->values(), json,
+                          m_float32_sampler_names.count(pair.first));
+    }
+    if (results.sample_count.size()) {
+      write_sample_column(run_dir, "sample_count", {"0"},
+                          to_column(results.sample_count), json);
+    }
+    if (results.sample_time.size()) {
+      write_sample_column(run_dir, "sample_time", {"0"},
+                          to_column(results.sample_time), json);
+    }
+    if (results.sample_weight.size()) {
+      write_sample_column(run_dir, "sample_weight", {"0"},
+                          to_column(results.sample_weight), json);
+    }
+    if (results.sample_clocktime.size()) {
+      write_sample_column(run_dir, "sample_clocktime", {"0"},
+                          to_column(results.sample_clocktime), json);
+    }
+    SafeOfstream file;
+    file.open(run_dir / "observations.json");
+    json.print(file.ofstream());
+    file.close();
+  }
+
+  ++m_n_runs;
+  _write_index();
+}
+
+/// \brief Read "columns.json", if it exists, and discard rows beyond
+///     "n_runs"
+void ColumnarResultsIO::_load() {
+  if (m_is_loaded) {
+    return;
+  }
+  m_is_loaded = true;
+  fs::path index_path = m_output_dir / "columns.json";
+  if (!fs::exists(index_path)) {
+    return;
+  }
+  jsonParser json(index_path);
+  m_n_runs = json["n_runs"].get<Index>();
+  for (auto it = json["columns"].begin(); it != json["columns"].end(); ++it) {
+    Column column;
+    from_json(column.component_names, (*it)["component_names"]);
+    from_json(column.value_type, (*it)["value_type"]);
+    from_json(column.shape, (*it)["shape"]);
+    fs::path path = m_output_dir / (it.name() + ".bin");
+    std::uintmax_t size =
+        m_n_runs * column.component_names.size() * sizeof(double);
+    if (fs::exists(path) && fs::file_size(path) > size) {
+      fs::resize_file(path, size);
+    }
+    m_columns[it.name()] = column;
+  }
+}
+
+void ColumnarResultsIO::_write_index() const {
+  jsonParser json = jsonParser::object();
+  json["n_runs"] = m_n_runs;
+  json["columns"] = jsonParser::object();
+  for (auto const &pair : m_columns) {
+    jsonParser &column_json = json["columns"][pair.first];
+    column_json["file"] = pair.first + ".bin";
+    column_json["dtype"] = "float64";
+    column_json["component_names"] = pair.second.component_names;
+    column_json["value_type"] = pair.second.value_type;
+    column_json["shape"] = pair.second.shape;
+  }
+  SafeOfstream file;
+  file.open(m_output_dir / "columns.json");
+  json.print(file.ofstream());
+  file.close();
+}
+
+/// \brief Read a per-run column written by ColumnarResultsIO
+///
+/// \param output_dir ColumnarResultsIO output directory
+/// \param column_name Column name, such as "conditions.temperature" or
+///     "analysis.heat_capacity"
+///
+/// \returns Values, with one row per run and one column per component
+Eigen::MatrixXd read_results_column(fs::path const &output_dir,
+                                    std::string const &column_name) {
+  fs::path index_path = output_dir / "columns.json";
+  if (!fs::exists(index_path)) {
+    std::stringstream msg;
+    msg << "Error in read_results_column: " << index_path
+        << " does not exist";
+    throw std::runtime_error(msg.str());
+  }
+  jsonParser json(index_path);
+  if (!json["columns"].contains(column_name)) {
+    std::stringstream msg;
+    msg << "Error in read_results_column: no column \"" << column_name
+        << "\" in " << index_path;
+    throw std::runtime_error(msg.str());
+  }
+  jsonParser const &column_json = json["columns"][column_name];
+  Index n_runs = json["n_runs"].get<Index>();
+  Index n_components = column_json["component_names"].size();
+
+  // written row-major, read into a column-major matrix by rows
+  std::vector<double> buffer(n_runs * n_components);
+  fs::path path = output_dir / column_json["file"].get<std::string>();
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char *>(buffer.data()),
+            buffer.size() * sizeof(double));
+  if (!file) {
+    std::stringstream msg;
+    msg << "Error in read_results_column: failed reading " << path;
+    throw std::runtime_error(msg.str());
+  }
+  Eigen::MatrixXd values(n_runs, n_components);
+  for (Index i = 0; i < n_runs; ++i) {
+    for (Index j = 0; j < n_components; ++j) {
+      values(i, j) = buffer[i * n_components + j];
+    }
+  }
+  return values;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,139 @@
+#include "casm/clexmonte/run/ConfigGeneratorCache.hh"
+
+#include <sstream>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+#include "casm/monte/io/json/ValueMap_json_io.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return the configuration stored by `key`, calling `make_f` to
+///     generate and store it if it is not yet stored
+///
+/// The lock is not held while `make_f` is called, so that generators of
+/// different configurations do not wait for each other. If two threads
+/// generate the same configuration at the same time, the first one stored
+/// is kept and returned to both.
+std::shared_ptr<config_type const> ConfigGeneratorCache::get_or_make(
+    std::string const &key, std::function<config_type()> const &make_f) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_configurations.find(key);
+    if (it != m_configurations.end()) {
+      ++m_n_hits;
+      return it->second;
+    }
+  }
+  auto configuration = std::make_shared<config_type const>(make_f());
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_n_misses;
+  return m_configurations.emplace(key, configuration).first->second;
+}
+
+/// \brief Number of stored configurations
+Index ConfigGeneratorCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_configurations.size();
+}
+
+/// \brief Remove all stored configurations
+void ConfigGeneratorCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_configurations.clear();
+}
+
+/// \brief Number of `get_or_make` calls that returned a stored
+///     configuration
+Index ConfigGeneratorCache::n_hits() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_n_hits;
+}
+
+/// \brief Number of `get_or_make` calls that generated a configuration
+Index ConfigGeneratorCache::n_misses() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_n_misses;
+}
+
+/// \brief A ConfigGeneratorCache shared by all configuration generators of
+///     this process
+///
+/// Used by the "fixed" configuration generator input parser to store
+/// motifs tiled into supercells, so that parsing the same input again, for
+/// instance once per parallel worker or once per series, does not repeat
+/// the symmetry analysis and copying.
+std::shared_ptr<ConfigGeneratorCache> default_config_generator_cache() {
+  static std::shared_ptr<ConfigGeneratorCache> cache =
+      std::make_shared<ConfigGeneratorCache>();
+  return cache;
+}
+
+/// \brief Make a ConfigGeneratorCache key
+///
+/// \param prefix Identifies the generation method
+/// \param transformation_matrix_to_super If not null, the transformation
+///     matrix of the generated configuration's supercell
+/// \param motif If not null, a configuration the generated configuration is
+///     made from. The key includes the motif's prim, so motifs of different
+///     systems have different keys.
+/// \param conditions If not null, the conditions the generated
+///     configuration is made for
+/// \param condition_keys Names of the `conditions` included in the key.
+///     Conditions not in `conditions` are ignored.
+///
+/// \returns A compact JSON string with all the given values
+std::string make_config_cache_key(
+    std::string const &prefix,
+    Eigen::Matrix3l const *transformation_matrix_to_super,
+    config_type const *motif, monte::ValueMap const *conditions,
+    std::vector<std::string> const &condition_keys) {
+  jsonParser json;
+  json["prefix"] = prefix;
+  if (transformation_matrix_to_super) {
+    to_json(*transformation_matrix_to_super, json["T"]);
+  }
+  if (motif) {
+    std::stringstream prim_address;
+    prim_address << motif->supercell->prim.get();
+    json["prim"] = prim_address.str();
+    to_json(*motif, json["motif"]);
+  }
+  if (conditions) {
+    monte::ValueMap subset;
+    for (std::string const &name : condition_keys) {
+      if (conditions->boolean_values.count(name)) {
+        subset.boolean_values[name] = conditions->boolean_values.at(name);
+      }
+      if (conditions->scalar_values.count(name)) {
+        subset.scalar_values[name] = conditions->scalar_values.at(name);
+      }
+      if (conditions->vector_values.count(name)) {
+        subset.vector_values[name] = conditions->vector_values.at(name);
+      }
+      if (conditions->matrix_values.count(name)) {
+        subset.matrix_values[name] = conditions->matrix_values.at(name);
+      }
+    }
+    to_json(subset, json["conditions"]);
+  }
+  std::stringstream ss;
+  json.print(ss, -1);
+  return ss.str();
+}
+
+config_type CachedConfigGenerator::operator()(
+    monte::ValueMap const &conditions,
+    std::vector<RunData> const &completed_runs) {
+  std::string key = make_config_cache_key(m_key_prefix, nullptr, nullptr,
+                                          &conditions, m_condition_keys);
+  return *m_cache->get_or_make(key, [&]() {
+    return (*m_config_generator)(conditions, completed_runs);
+  });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,154 @@
+#include "casm/clexmonte/run/DecimatedSampleStore.hh"
+
+#include <stdexcept>
+
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _component_names Names of the components of sampled values
+/// \param _level_size Maximum number of entries per level, which must be
+///     >= 2. Level 0 keeps this many of the most recent samples at full
+///     resolution.
+DecimatedSampleStore::DecimatedSampleStore(
+    std::vector<std::string> _component_names, Index _level_size)
+    : component_names(std::move(_component_names)),
+      level_size(_level_size),
+      m_n_samples(0) {
+  if (level_size < 2) {
+    throw std::runtime_error(
+        "Error constructing DecimatedSampleStore: level_size < 2");
+  }
+  reset();
+}
+
+/// \brief Add a sample
+///
+/// \param value Sampled value, with one element per component
+/// \param time Time, or count, of the sample
+void DecimatedSampleStore::push(Eigen::VectorXd const &value, double time) {
+  if (value.size() != Index(component_names.size())) {
+    throw std::runtime_error(
+        "Error in DecimatedSampleStore::push: value size does not match "
+        "component names");
+  }
+
+  // exact statistics
+  ++m_n_samples;
+  Eigen::VectorXd delta = value - m_mean;
+  m_mean += delta / double(m_n_samples);
+  m_m2 += delta.cwiseProduct(value - m_mean);
+
+  // full resolution entry, then merge overflowing levels
+  m_levels[0].push_back(Entry{value, time, time, 1});
+  for (Index k = 0; k < Index(m_levels.size()); ++k) {
+    if (Index(m_levels[k].size()) <= level_size) {
+      break;
+    }
+    Entry first = m_levels[k].front();
+    m_levels[k].pop_front();
+    Entry second = m_levels[k].front();
+    m_levels[k].pop_front();
+    Index n = first.n_samples + second.n_samples;
+    Entry merged{(first.value * first.n_samples +
+                  second.value * second.n_samples) /
+                     double(n),
+                 first.time_begin, second.time_end, n};
+    if (k + 1 == Index(m_levels.size())) {
+      m_levels.emplace_back();
+    }
+    // merged entries are newer than all entries of the next level
+    m_levels[k + 1].push_back(merged);
+  }
+}
+
+/// \brief Number of stored entries
+Index DecimatedSampleStore::n_entries() const {
+  Index n = 0;
+  for (auto const &level : m_levels) {
+    n += level.size();
+  }
+  return n;
+}
+
+/// \brief Stored entries, oldest first
+std::vector<DecimatedSampleStore::Entry> DecimatedSampleStore::entries()
+    const {
+  std::vector<Entry> _entries;
+  _entries.reserve(n_entries());
+  for (auto level = m_levels.rbegin(); level != m_levels.rend(); ++level) {
+    _entries.insert(_entries.end(), level->begin(), level->end());
+  }
+  return _entries;
+}
+
+/// \brief Stored entry values, oldest first, one row per entry
+Eigen::MatrixXd DecimatedSampleStore::values() const {
+  Eigen::MatrixXd _values(n_entries(), component_names.size());
+  Index i = 0;
+  for (auto level = m_levels.rbegin(); level != m_levels.rend(); ++level) {
+    for (Entry const &entry : *level) {
+      _values.row(i++) = entry.value.transpose();
+    }
+  }
+  return _values;
+}
+
+/// \brief Sample variance of all samples pushed
+///
+/// Uses the unbiased estimator, and returns zeros for fewer than 2 samples.
+Eigen::VectorXd DecimatedSampleStore::variance() const {
+  if (m_n_samples < 2) {
+    return Eigen::VectorXd::Zero(component_names.size());
+  }
+  return m_m2 / double(m_n_samples - 1);
+}
+
+/// \brief Remove all samples
+void DecimatedSampleStore::reset() {
+  m_levels.clear();
+  m_levels.emplace_back();
+  m_n_samples = 0;
+  m_mean = Eigen::VectorXd::Zero(component_names.size());
+  m_m2 = Eigen::VectorXd::Zero(component_names.size());
+}
+
+/// \brief Make a state sampling function which pushes samples to a
+///     DecimatedSampleStore
+///
+/// The sampled values are kept by `store`, so that memory is bounded, and
+/// the value returned to the sampling fixture is only the number of samples
+/// pushed to `store`, so the values are not available for convergence
+/// checks.
+///
+/// \param name Sampling function name
+/// \param description Sampling function description
+/// \param function Function returning the value to sample, with
+///     `store->component_names.size()` elements
+/// \param store Stores the sampled values
+/// \param get_time_f Returns the time of each sample, such as the kinetic
+///     Monte Carlo time. If null, the number of samples already pushed is
+///     used.
+monte::StateSamplingFunction make_decimated_state_sampling_function(
+    std::string name, std::string description,
+    std::function<Eigen::VectorXd()> function,
+    std::shared_ptr<DecimatedSampleStore> store,
+    std::function<double()> get_time_f) {
+  if (!store) {
+    throw std::runtime_error(
+        "Error in make_decimated_state_sampling_function: store is null");
+  }
+  return monte::StateSamplingFunction(
+      name, description, {},  // scalar
+      [=]() -> Eigen::VectorXd {
+        double time = get_time_f ? get_time_f() : double(store->n_samples());
+        store->push(function(), time);
+        return Eigen::VectorXd::Constant(1, store->n_samples());
+      });
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,111 @@
+#include "casm/clexmonte/run/HistogramSamplingFunction.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _name Sampling function name
+/// \param _description Sampling function description
+/// \param _source The sampling function whose values are binned
+/// \param _prototype An empty histogram, with fixed or adaptive bins,
+///     which is copied for each component of the source value
+HistogramSamplingFunction::HistogramSamplingFunction(
+    std::string _name, std::string _description,
+    state_sampling_function_type _source, HistogramAccumulator _prototype)
+    : name(_name),
+      description(_description),
+      source(_source),
+      m_prototype(_prototype),
+      m_n_samples(0) {
+  if (source.function == nullptr) {
+    throw std::runtime_error(
+        "Error constructing HistogramSamplingFunction: source function == "
+        "nullptr");
+  }
+  m_prototype.reset();
+  m_histograms.assign(source.component_names.size(), m_prototype);
+}
+
+/// \brief Evaluate the source function and add each component to its
+///     histogram
+void HistogramSamplingFunction::record() {
+  Eigen::VectorXd value = source.function();
+  if (value.size() != Index(m_histograms.size())) {
+    std::stringstream msg;
+    msg << "Error in HistogramSamplingFunction \"" << name
+        << "\": source function returned " << value.size()
+        << " components, expected " << m_histograms.size();
+    throw std::runtime_error(msg.str());
+  }
+  for (Index i = 0; i < value.size(); ++i) {
+    m_histograms[i].push(value(i));
+  }
+  ++m_n_samples;
+}
+
+/// \brief Remove all samples
+///
+/// Adaptive histograms are reset to the initial bin width.
+void HistogramSamplingFunction::reset() {
+  m_histograms.assign(m_histograms.size(), m_prototype);
+  m_n_samples = 0;
+}
+
+/// \brief Make a state sampling function which records samples for a
+///     HistogramSamplingFunction
+///
+/// \param histogram_function The histogram function
+///
+/// \returns A state sampling function, with the name and description of
+///     `histogram_function`, which calls `histogram_function->record()`
+///     and returns an empty value.
+monte::StateSamplingFunction make_histogram_state_sampling_function(
+    std::shared_ptr<HistogramSamplingFunction> histogram_function) {
+  if (!histogram_function) {
+    throw std::runtime_error(
+        "Error in make_histogram_state_sampling_function: "
+        "histogram_function is null");
+  }
+  return monte::StateSamplingFunction(
+      histogram_function->name, histogram_function->description,
+      std::vector<Index>({0}),  // empty
+      [histogram_function]() -> Eigen::VectorXd {
+        histogram_function->record();
+        return Eigen::VectorXd(0);
+      });
+}
+
+/// \brief Write HistogramSamplingFunction histograms to JSON
+///
+/// Format:
+///
+///   n_samples: int
+///       Number of samples recorded.
+///   component_names: array of str
+///       Names of the components of the source value.
+///   histograms: array of object
+///       One histogram per component (see `to_json(HistogramAccumulator
+///       const &, jsonParser &)`).
+jsonParser &to_json(HistogramSamplingFunction const &histogram_function,
+                    jsonParser &json) {
+  json.put_obj();
+  json["n_samples"] = histogram_function.n_samples();
+  json["component_names"] = histogram_function.component_names();
+  json["histograms"] = jsonParser::array();
+  for (auto const &histogram : histogram_function.histograms()) {
+    jsonParser tjson;
+    to_json(histogram, tjson);
+    json["histograms"].push_back(tjson);
+  }
+  return json;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,197 @@
+#include "casm/clexmonte/run/MappedTrajectoryWriter.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+Index const header_size = 64;
+
+/// Header field offsets
+Index const n_sites_offset = 8;
+Index const bytes_per_value_offset = 16;
+Index const record_size_offset = 24;
+Index const n_frames_offset = 32;
+Index const capacity_offset = 40;
+
+void write_header_value(unsigned char *data, Index offset,
+                        std::uint64_t value) {
+  std::memcpy(data + offset, &value, sizeof(value));
+}
+
+template <typename ValueType>
+void write_frame_values(unsigned char *begin,
+                        Eigen::VectorXi const &occupation) {
+  ValueType *values = reinterpret_cast<ValueType *>(begin);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    values[l] = static_cast<ValueType>(occupation(l));
+  }
+}
+
+std::runtime_error make_error(std::string what, std::string path) {
+  std::stringstream msg;
+  msg << "Error in MappedTrajectoryWriter: " << what << " (" << path << ")";
+  return std::runtime_error(msg.str());
+}
+
+}  // namespace
+
+MappedTrajectoryWriter::MappedTrajectoryWriter()
+    : m_fd(-1),
+      m_n_sites(0),
+      m_bytes_per_value(0),
+      m_record_size(0),
+      m_capacity(0),
+      m_n_frames(0),
+      m_data(nullptr) {}
+
+MappedTrajectoryWriter::MappedTrajectoryWriter(std::string path,
+                                               Index n_sites,
+                                               int max_occupant_index,
+                                               Index initial_capacity)
+    : MappedTrajectoryWriter() {
+  open(path, n_sites, max_occupant_index, initial_capacity);
+}
+
+MappedTrajectoryWriter::~MappedTrajectoryWriter() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+/// \brief Create, or overwrite, a trajectory file and map it
+///
+/// \param path Trajectory file path
+/// \param n_sites Number of sites per frame
+/// \param max_occupant_index Maximum occupation index, which determines the
+///     number of bytes per site
+/// \param initial_capacity Number of frames preallocated
+///
+/// If a file is already open, it is closed first.
+void MappedTrajectoryWriter::open(std::string path, Index n_sites,
+                                  int max_occupant_index,
+                                  Index initial_capacity) {
+  close();
+  if (n_sites < 0 || max_occupant_index < 0) {
+    throw make_error("invalid n_sites or max_occupant_index", path);
+  }
+  m_path = path;
+  m_n_sites = n_sites;
+  if (max_occupant_index <= 0xFF) {
+    m_bytes_per_value = 1;
+  } else if (max_occupant_index <= 0xFFFF) {
+    m_bytes_per_value = 2;
+  } else {
+    m_bytes_per_value = 4;
+  }
+  m_record_size = 16 + ((m_n_sites * m_bytes_per_value + 7) / 8) * 8;
+  m_n_frames = 0;
+
+  m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) {
+    throw make_error("failed to open file", m_path);
+  }
+  _map(std::max(initial_capacity, Index(1)));
+
+  std::memcpy(m_data, "CLXTRAJ1", 8);
+  write_header_value(m_data, n_sites_offset, m_n_sites);
+  write_header_value(m_data, bytes_per_value_offset, m_bytes_per_value);
+  write_header_value(m_data, record_size_offset, m_record_size);
+  write_header_value(m_data, n_frames_offset, 0);
+}
+
+/// \brief Return true if a file is open
+bool MappedTrajectoryWriter::is_open() const { return m_fd >= 0; }
+
+/// \brief Write one frame, and return its frame index
+///
+/// \param occupation Occupation indices, with size `n_sites`
+/// \param sample_index The per-run index of the sample
+/// \param time The simulated time of the sample, or NaN
+Index MappedTrajectoryWriter::write(Eigen::VectorXi const &occupation,
+                                    Index sample_index, double time) {
+  if (!is_open()) {
+    throw std::runtime_error(
+        "Error in MappedTrajectoryWriter::write: no file is open");
+  }
+  if (occupation.size() != m_n_sites) {
+    throw make_error("occupation size does not match n_sites", m_path);
+  }
+  if (m_n_frames == m_capacity) {
+    _unmap();
+    _map(2 * m_capacity);
+  }
+
+  unsigned char *record = m_data + header_size + m_n_frames * m_record_size;
+  std::uint64_t _sample_index = sample_index;
+  std::memcpy(record, &_sample_index, 8);
+  std::memcpy(record + 8, &time, 8);
+  if (m_bytes_per_value == 1) {
+    write_frame_values<std::uint8_t>(record + 16, occupation);
+  } else if (m_bytes_per_value == 2) {
+    write_frame_values<std::uint16_t>(record + 16, occupation);
+  } else {
+    write_frame_values<std::uint32_t>(record + 16, occupation);
+  }
+
+  ++m_n_frames;
+  write_header_value(m_data, n_frames_offset, m_n_frames);
+  return m_n_frames - 1;
+}
+
+/// \brief Number of frames written to the open file
+Index MappedTrajectoryWriter::n_frames() const { return m_n_frames; }
+
+/// \brief Unmap, truncate to the frames written, and close the file
+void MappedTrajectoryWriter::close() {
+  if (!is_open()) {
+    return;
+  }
+  write_header_value(m_data, capacity_offset, m_n_frames);
+  _unmap();
+  int fd = m_fd;
+  m_fd = -1;
+  Index size = header_size + m_n_frames * m_record_size;
+  bool failed = (::ftruncate(fd, size) != 0);
+  failed = (::close(fd) != 0) || failed;
+  if (failed) {
+    throw make_error("failed to truncate and close file", m_path);
+  }
+}
+
+/// Resize the open file to `capacity` frame records and map it
+void MappedTrajectoryWriter::_map(Index capacity) {
+  Index size = header_size + capacity * m_record_size;
+  if (::ftruncate(m_fd, size) != 0) {
+    throw make_error("failed to allocate file", m_path);
+  }
+  void *data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED) {
+    throw make_error("failed to map file", m_path);
+  }
+  m_data = static_cast<unsigned char *>(data);
+  m_capacity = capacity;
+  write_header_value(m_data, capacity_offset, m_capacity);
+}
+
+/// Unmap the open file
+void MappedTrajectoryWriter::_unmap() {
+  if (m_data != nullptr) {
+    ::munmap(m_data, header_size + m_capacity * m_record_size);
+    m_data = nullptr;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,98 @@
+#include "casm/clexmonte/run/MemoryReport.hh"
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Add a subsystem
+///
+/// \param name Subsystem name
+/// \param bytes Approximate memory used, in bytes
+/// \param max_bytes Memory budget of the subsystem, in bytes, if it has one
+void MemoryReport::add(std::string name, std::size_t bytes,
+                       std::optional<std::size_t> max_bytes) {
+  Entry entry;
+  entry.name = std::move(name);
+  entry.bytes = bytes;
+  entry.max_bytes = max_bytes;
+  entries.push_back(std::move(entry));
+}
+
+/// \brief Approximate memory used by all subsystems, in bytes
+std::size_t MemoryReport::total_bytes() const {
+  std::size_t total = 0;
+  for (Entry const &entry : entries) {
+    total += entry.bytes;
+  }
+  return total;
+}
+
+/// \brief Write a MemoryReport to a log, in MB
+///
+/// Writes one line per subsystem, with its budget if it has one, and the
+/// total.
+void print(Log &log, MemoryReport const &report) {
+  double const MB = 1024.0 * 1024.0;
+  log.indent() << "Approximate memory usage (MB):" << std::endl;
+  for (MemoryReport::Entry const &entry : report.entries) {
+    log.indent() << "- " << entry.name << ": " << entry.bytes / MB;
+    if (entry.max_bytes.has_value()) {
+      log << " (budget: " << *entry.max_bytes / MB << ")";
+    }
+    log << std::endl;
+  }
+  log.indent() << "- total: " << report.total_bytes() / MB << std::endl;
+}
+
+/// \brief Write a MemoryReport to JSON
+///
+/// Format:
+///
+///   subsystems: dict
+///       The approximate memory used by each subsystem, as an object with
+///       "bytes" and, if the subsystem has a memory budget, "max_bytes".
+///   total_bytes: int
+///       The approximate memory used by all subsystems.
+jsonParser &to_json(MemoryReport const &report, jsonParser &json) {
+  json.put_obj();
+  json["subsystems"] = jsonParser::object();
+  for (MemoryReport::Entry const &entry : report.entries) {
+    jsonParser &entry_json = json["subsystems"][entry.name];
+    entry_json["bytes"] = static_cast<Index>(entry.bytes);
+    if (entry.max_bytes.has_value()) {
+      entry_json["max_bytes"] = static_cast<Index>(*entry.max_bytes);
+    }
+  }
+  json["total_bytes"] = static_cast<Index>(report.total_bytes());
+  return json;
+}
+
+/// \brief Approximate memory used by an occupant location tracker, in bytes
+///
+/// Includes the occupant list, the site to occupant index, the candidate
+/// location lists, and, if species are updated, the atom list. Like the
+/// other estimates, counts the sizes of the stored elements, so it is
+/// intended for comparing against a memory budget rather than exact
+/// accounting.
+///
+/// \param occ_location The occupant location tracker
+/// \param n_sites Number of sites in the supercell
+///
+/// \returns Approximate memory used, in bytes
+std::size_t approximate_memory_usage(monte::OccLocation const &occ_location,
+                                     Index n_sites) {
+  std::size_t n_mol = occ_location.mol_size();
+  std::size_t bytes = n_mol * (sizeof(monte::Mol) + sizeof(Index));
+  bytes += n_sites * sizeof(Index);
+  bytes += occ_location.cand_size() * sizeof(std::vector<Index>) +
+           n_mol * sizeof(Index);
+  // atom name index, jump count, and position of each atom
+  bytes += occ_location.atom_size() * (2 * sizeof(Index) + 3 * sizeof(double));
+  return bytes;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,188 @@
+#include "casm/clexmonte/run/MultiHistogramReweighting.hh"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief Return ln(sum_i exp(x_i)), without overflow
+double log_sum_exp(Eigen::VectorXd const &x) {
+  double x_max = x.maxCoeff();
+  return x_max + std::log((x.array() - x_max).exp().sum());
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param temperatures Temperature of each run
+/// \param potential_energy Sampled potential energy (per unit cell) of each
+///     run, as sampled by "potential_energy"
+/// \param n_unitcells Number of unit cells in the supercell of the runs
+/// \param tol Tolerance on the change of each free energy between iterations
+/// \param max_iterations Maximum number of iterations
+MultiHistogramReweighting::MultiHistogramReweighting(
+    std::vector<double> const &temperatures,
+    std::vector<Eigen::VectorXd> const &potential_energy, Index n_unitcells,
+    double tol, Index max_iterations)
+    : m_n_unitcells(n_unitcells), m_converged(false), m_n_iterations(0) {
+  if (temperatures.empty()) {
+    throw std::runtime_error(
+        "Error constructing MultiHistogramReweighting: no runs");
+  }
+  if (temperatures.size() != potential_energy.size()) {
+    throw std::runtime_error(
+        "Error constructing MultiHistogramReweighting: temperatures.size() != "
+        "potential_energy.size()");
+  }
+  if (m_n_unitcells < 1) {
+    throw std::runtime_error(
+        "Error constructing MultiHistogramReweighting: n_unitcells < 1");
+  }
+
+  Index n_runs = temperatures.size();
+  Index n_samples = 0;
+  m_beta.resize(n_runs);
+  m_log_n_samples.resize(n_runs);
+  for (Index k = 0; k < n_runs; ++k) {
+    if (!(temperatures[k] > 0.0)) {
+      throw std::runtime_error(
+          "Error constructing MultiHistogramReweighting: temperature <= 0.0");
+    }
+    if (potential_energy[k].size() == 0) {
+      std::stringstream msg;
+      msg << "Error constructing MultiHistogramReweighting: run " << k
+          << " has no samples";
+      throw std::runtime_error(msg.str());
+    }
+    m_beta(k) = 1.0 / (CASM::KB * temperatures[k]);
+    m_log_n_samples(k) = std::log(double(potential_energy[k].size()));
+    n_samples += potential_energy[k].size();
+  }
+
+  m_energy.resize(n_samples);
+  Index n = 0;
+  for (Index k = 0; k < n_runs; ++k) {
+    m_energy.segment(n, potential_energy[k].size()) =
+        potential_energy[k] * double(m_n_unitcells);
+    n += potential_energy[k].size();
+  }
+
+  // Solve for the free energies by direct iteration
+  m_f = Eigen::VectorXd::Zero(n_runs);
+  Eigen::VectorXd f_next(n_runs);
+  Eigen::VectorXd x(n_samples);
+  while (m_n_iterations < max_iterations) {
+    _update_log_denominator();
+    for (Index k = 0; k < n_runs; ++k) {
+      x = -m_beta(k) * m_energy - m_log_denominator;
+      f_next(k) = -log_sum_exp(x);
+    }
+    f_next.array() -= f_next(0);
+    ++m_n_iterations;
+    double max_change = (f_next - m_f).cwiseAbs().maxCoeff();
+    m_f = f_next;
+    if (max_change < tol) {
+      m_converged = true;
+      break;
+    }
+  }
+  _update_log_denominator();
+}
+
+/// \brief Reweighted averages at a temperature
+///
+/// \param temperature Temperature, which may be between or outside the run
+///     temperatures. Check `effective_n_samples` to judge whether the runs
+///     sample the energies important at this temperature.
+ReweightedAverages MultiHistogramReweighting::averages(
+    double temperature) const {
+  if (!(temperature > 0.0)) {
+    throw std::runtime_error(
+        "Error in MultiHistogramReweighting::averages: temperature <= 0.0");
+  }
+  double beta = 1.0 / (CASM::KB * temperature);
+  Eigen::VectorXd log_w = -beta * m_energy - m_log_denominator;
+  Eigen::VectorXd w = (log_w.array() - log_w.maxCoeff()).exp();
+  double sum_w = w.sum();
+
+  double mean = w.dot(m_energy) / sum_w;
+  double var = w.dot((m_energy.array() - mean).square().matrix()) / sum_w;
+
+  ReweightedAverages result;
+  result.temperature = temperature;
+  result.potential_energy = mean / m_n_unitcells;
+  result.heat_capacity =
+      var / (CASM::KB * temperature * temperature * m_n_unitcells);
+  result.effective_n_samples = sum_w * sum_w / w.squaredNorm();
+  return result;
+}
+
+/// \brief Reweighted averages at each of a series of temperatures
+std::vector<ReweightedAverages> MultiHistogramReweighting::averages(
+    std::vector<double> const &temperatures) const {
+  std::vector<ReweightedAverages> result;
+  result.reserve(temperatures.size());
+  for (double temperature : temperatures) {
+    result.push_back(averages(temperature));
+  }
+  return result;
+}
+
+void MultiHistogramReweighting::_update_log_denominator() {
+  Index n_runs = m_beta.size();
+  m_log_denominator.resize(m_energy.size());
+  Eigen::VectorXd x(n_runs);
+  for (Index n = 0; n < m_energy.size(); ++n) {
+    x = m_log_n_samples + m_f - m_beta * m_energy(n);
+    m_log_denominator(n) = log_sum_exp(x);
+  }
+}
+
+/// \brief Construct multi-histogram reweighting for a completed series of
+///     runs at different temperatures
+///
+/// \param completed_runs Completed runs, for example from
+///     `StateGenerator::completed_runs`. Each must have the scalar condition
+///     "temperature", and all must have the same supercell.
+/// \param potential_energy Sampled "potential_energy" (per unit cell) of
+///     each completed run, for example from `read_streamed_observations`
+/// \param tol Tolerance on the change of each free energy between iterations
+/// \param max_iterations Maximum number of iterations
+MultiHistogramReweighting make_multi_histogram_reweighting(
+    std::vector<RunData> const &completed_runs,
+    std::vector<Eigen::VectorXd> const &potential_energy, double tol,
+    Index max_iterations) {
+  if (completed_runs.empty()) {
+    throw std::runtime_error(
+        "Error in make_multi_histogram_reweighting: no completed runs");
+  }
+  std::vector<double> temperatures;
+  for (RunData const &run_data : completed_runs) {
+    auto const &scalar_values = run_data.conditions.scalar_values;
+    if (!scalar_values.count("temperature")) {
+      throw std::runtime_error(
+          "Error in make_multi_histogram_reweighting: requires temperature "
+          "condition");
+    }
+    if (run_data.transformation_matrix_to_super !=
+        completed_runs[0].transformation_matrix_to_super) {
+      throw std::runtime_error(
+          "Error in make_multi_histogram_reweighting: completed runs must "
+          "have the same supercell");
+    }
+    temperatures.push_back(scalar_values.at("temperature"));
+  }
+  return MultiHistogramReweighting(temperatures, potential_energy,
+                                   completed_runs[0].n_unitcells, tol,
+                                   max_iterations);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,250 @@
+#include "casm/clexmonte/run/ObservationStream.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _output_dir Directory where run directories are written
+/// \param _chunk_size Number of rows buffered per sampler before they are
+///     written
+/// \param _float32_sampler_names Names of samplers whose values are stored
+///     as float32, rather than float64
+ObservationStream::ObservationStream(
+    fs::path _output_dir, Index _chunk_size,
+    std::set<std::string> _float32_sampler_names)
+    : output_dir(_output_dir),
+      chunk_size(_chunk_size),
+      float32_sampler_names(std::move(_float32_sampler_names)),
+      m_is_open(false) {
+  if (chunk_size < 1) {
+    throw std::runtime_error(
+        "Error constructing ObservationStream: chunk_size < 1");
+  }
+}
+
+ObservationStream::~ObservationStream() {
+  try {
+    end_run();
+  } catch (...) {
+  }
+}
+
+/// \brief Flush the previous run, and begin writing a new run
+///
+/// Existing observations for `run_index` are overwritten.
+void ObservationStream::begin_run(Index run_index) {
+  end_run();
+  m_run_dir = output_dir / ("run." + std::to_string(run_index));
+  fs::create_directories(m_run_dir);
+  m_is_open = true;
+}
+
+/// \brief Append one sampled value
+void ObservationStream::append(std::string const &sampler_name,
+                               std::vector<std::string> const &component_names,
+                               Eigen::VectorXd const &value) {
+  if (!m_is_open) {
+    throw std::runtime_error(
+        "Error in ObservationStream::append: begin_run was not called");
+  }
+  auto it = m_columns.find(sampler_name);
+  if (it == m_columns.end()) {
+    it = m_columns.emplace(sampler_name, Column()).first;
+    Column &column = it->second;
+    column.component_names = component_names;
+    column.is_float32 = float32_sampler_names.count(sampler_name);
+    fs::path path = m_run_dir / (sampler_name + ".bin");
+    column.file.open(path, std::ios::binary | std::ios::trunc);
+    if (!column.file) {
+      std::stringstream msg;
+      msg << "Error in ObservationStream::append: failed to open " << path;
+      throw std::runtime_error(msg.str());
+    }
+    column.buffer.reserve(chunk_size * value.size());
+  }
+  Column &column = it->second;
+  if (value.size() != Index(column.component_names.size())) {
+    std::stringstream msg;
+    msg << "Error in ObservationStream::append: size of \"" << sampler_name
+        << "\" value does not match its component names";
+    throw std::runtime_error(msg.str());
+  }
+  column.buffer.insert(column.buffer.end(), value.data(),
+                       value.data() + value.size());
+  ++column.n_samples;
+  if (Index(column.buffer.size()) >= chunk_size * value.size()) {
+    _flush_column(column);
+  }
+}
+
+/// \brief Write buffered rows and the index of the current run
+void ObservationStream::flush() {
+  if (!m_is_open) {
+    return;
+  }
+  jsonParser json = jsonParser::object();
+  for (auto &pair : m_columns) {
+    Column &column = pair.second;
+    _flush_column(column);
+    column.file.flush();
+    jsonParser &column_json = json[pair.first];
+    column_json["file"] = pair.first + ".bin";
+    column_json["dtype"] = column.is_float32 ? "float32" : "float64";
+    column_json["component_names"] = column.component_names;
+    column_json["n_samples"] = column.n_samples;
+  }
+  SafeOfstream file;
+  file.open(m_run_dir / "observations.json");
+  json.print(file.ofstream());
+  file.close();
+}
+
+/// \brief Flush and close the current run
+void ObservationStream::end_run() {
+  if (!m_is_open) {
+    return;
+  }
+  flush();
+  m_columns.clear();
+  m_is_open = false;
+}
+
+void ObservationStream::_flush_column(Column &column) {
+  if (column.buffer.empty()) {
+    return;
+  }
+  if (column.is_float32) {
+    std::vector<float> values(column.buffer.begin(), column.buffer.end());
+    column.file.write(reinterpret_cast<char const *>(values.data()),
+                      values.size() * sizeof(float));
+  } else {
+    column.file.write(reinterpret_cast<char const *>(column.buffer.data()),
+                      column.buffer.size() * sizeof(double));
+  }
+  if (!column.file) {
+    throw std::runtime_error(
+        "Error in ObservationStream: failed writing observations");
+  }
+  column.buffer.clear();
+}
+
+/// \brief Wrap sampling functions so that sampled values are also appended
+///     to an ObservationStream
+///
+/// \param sampling_functions All sampling functions
+/// \param sampler_names Names of the sampling functions to wrap
+/// \param observation_stream Stream that sampled values are appended to
+///
+/// \returns A copy of `sampling_functions`, in which the functions named in
+///     `sampler_names` are wrapped.
+monte::StateSamplingFunctionMap make_streaming_sampling_functions(
+    monte::StateSamplingFunctionMap sampling_functions,
+    std::vector<std::string> const &sampler_names,
+    std::shared_ptr<ObservationStream> observation_stream) {
+  if (!observation_stream) {
+    throw std::runtime_error(
+        "Error in make_streaming_sampling_functions: observation_stream is "
+        "null");
+  }
+  for (std::string const &name : sampler_names) {
+    auto it = sampling_functions.find(name);
+    if (it == sampling_functions.end()) {
+      std::stringstream msg;
+      msg << "Error in make_streaming_sampling_functions: no sampling "
+             "function named \""
+          << name << "\"";
+      throw std::runtime_error(msg.str());
+    }
+    auto &f = it->second;
+    auto original_function = f.function;
+    auto component_names = f.component_names;
+    f.function = [=]() -> Eigen::VectorXd {
+      Eigen::VectorXd value = original_function();
+      observation_stream->append(name, component_names, value);
+      return value;
+    };
+  }
+  return sampling_functions;
+}
+
+/// \brief Read the observations of one sampler for one run, written by an
+///     ObservationStream
+///
+/// \param output_dir ObservationStream output directory
+/// \param run_index Run index, as passed to `begin_run`
+/// \param sampler_name Sampler name
+///
+/// \returns Observations, with one row per sample and one column per
+///     component
+Eigen::MatrixXd read_streamed_observations(fs::path const &output_dir,
+                                           Index run_index,
+                                           std::string const &sampler_name) {
+  fs::path run_dir = output_dir / ("run." + std::to_string(run_index));
+  fs::path index_path = run_dir / "observations.json";
+  if (!fs::exists(index_path)) {
+    std::stringstream msg;
+    msg << "Error in read_streamed_observations: " << index_path
+        << " does not exist";
+    throw std::runtime_error(msg.str());
+  }
+  jsonParser json(index_path);
+  if (!json.contains(sampler_name)) {
+    std::stringstream msg;
+    msg << "Error in read_streamed_observations: no observations of \""
+        << sampler_name << "\" in " << index_path;
+    throw std::runtime_error(msg.str());
+  }
+  jsonParser const &column_json = json[sampler_name];
+  Index n_samples = column_json["n_samples"].get<Index>();
+  Index n_components = column_json["component_names"].size();
+
+  std::string dtype = "float64";
+  if (column_json.contains("dtype")) {
+    dtype = column_json["dtype"].get<std::string>();
+  }
+  if (dtype != "float64" && dtype != "float32") {
+    std::stringstream msg;
+    msg << "Error in read_streamed_observations: unknown dtype \"" << dtype
+        << "\"";
+    throw std::runtime_error(msg.str());
+  }
+
+  // written row-major, read into a column-major matrix by rows
+  std::vector<double> buffer(n_samples * n_components);
+  fs::path path = run_dir / column_json["file"].get<std::string>();
+  std::ifstream file(path, std::ios::binary);
+  if (dtype == "float32") {
+    std::vector<float> values(buffer.size());
+    file.read(reinterpret_cast<char *>(values.data()),
+              values.size() * sizeof(float));
+    std::copy(values.begin(), values.end(), buffer.begin());
+  } else {
+    file.read(reinterpret_cast<char *>(buffer.data()),
+              buffer.size() * sizeof(double));
+  }
+  if (!file) {
+    std::stringstream msg;
+    msg << "Error in read_streamed_observations: failed reading " << path;
+    throw std::runtime_error(msg.str());
+  }
+  Eigen::MatrixXd observations(n_samples, n_components);
+  for (Index i = 0; i < n_samples; ++i) {
+    for (Index j = 0; j < n_components; ++j) {
+      observations(i, j) = buffer[i * n_components + j];
+    }
+  }
+  return observations;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,105 @@
+#include "casm/clexmonte/run/OccLocationCache.hh"
+
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/events/OccLocation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _update_species Passed to the `monte::OccLocation` constructor. If
+///     true, occupant species are updated and atoms are tracked.
+/// \param _max_changed_fraction Maximum fraction of tracked occupants whose
+///     species may have changed for the tracker to be updated rather than
+///     re-initialized
+OccLocationCache::OccLocationCache(bool _update_species,
+                                   double _max_changed_fraction)
+    : update_species(_update_species),
+      max_changed_fraction(_max_changed_fraction),
+      m_n_constructed(0),
+      m_n_initialized(0),
+      m_n_reused(0),
+      m_n_changed_sites(0) {}
+
+OccLocationCache::~OccLocationCache() = default;
+
+/// \brief Return an occupant location tracker initialized with the
+///     occupation of `state`
+///
+/// If the last tracker returned was for the same supercell, it is updated
+/// or re-initialized and returned; otherwise a new tracker is constructed.
+///
+/// \param system The system
+/// \param state The state of the next run
+///
+/// \returns An occupant location tracker, valid until the next call to
+///     `get` or until the OccLocationCache is destroyed
+monte::OccLocation &OccLocationCache::get(System &system,
+                                          state_type const &state) {
+  auto supercell_data = get_shared_supercell_data(system, state);
+  if (!m_occ_location || supercell_data != m_supercell_data) {
+    m_occ_location.reset();
+    m_supercell_data = supercell_data;
+    m_occ_location = std::make_unique<monte::OccLocation>(
+        m_supercell_data->convert, m_supercell_data->occ_candidate_list,
+        update_species);
+    ++m_n_constructed;
+  } else if (!update_species && _update(state)) {
+    ++m_n_reused;
+    return *m_occ_location;
+  }
+  m_occ_location->initialize(get_occupation(state));
+  ++m_n_initialized;
+  return *m_occ_location;
+}
+
+/// \brief Apply the occupation of `state` to a tracker of the same
+///     supercell, if few sites changed
+///
+/// \returns True if the tracker was updated, false if more than
+///     `max_changed_fraction` of the tracked occupants changed species, in
+///     which case the tracker is unchanged and must be re-initialized.
+bool OccLocationCache::_update(state_type const &state) {
+  Eigen::VectorXi const &occupation = get_occupation(state);
+  monte::OccLocation &occ_location = *m_occ_location;
+  monte::Conversions const &convert = occ_location.convert();
+  Index mol_size = occ_location.mol_size();
+  Index max_changed = Index(max_changed_fraction * mol_size);
+
+  m_event.linear_site_index.clear();
+  m_event.new_occ.clear();
+  m_event.occ_transform.clear();
+  m_event.atom_traj.clear();
+  for (Index mol_id = 0; mol_id < mol_size; ++mol_id) {
+    monte::Mol const &mol = occ_location.mol(mol_id);
+    Index asym = convert.l_to_asym(mol.l);
+    Index species = convert.species_index(asym, occupation(mol.l));
+    if (species == mol.species_index) {
+      continue;
+    }
+    if (Index(m_event.occ_transform.size()) == max_changed) {
+      return false;
+    }
+    monte::OccTransform transform;
+    transform.mol_id = mol_id;
+    transform.l = mol.l;
+    transform.asym = asym;
+    transform.from_species = mol.species_index;
+    transform.to_species = species;
+    m_event.linear_site_index.push_back(mol.l);
+    m_event.new_occ.push_back(occupation(mol.l));
+    m_event.occ_transform.push_back(transform);
+  }
+
+  m_n_changed_sites = m_event.occ_transform.size();
+  if (m_n_changed_sites) {
+    m_occupation = occupation;
+    occ_location.apply(m_event, m_occupation);
+  }
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,149 @@
+#include "casm/clexmonte/run/RunCheckpoint.hh"
+
+#include "casm/casm_io/SafeOfstream.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _checkpoint_path Checkpoint file path
+/// \param _period_in_s Minimum clocktime between checkpoints, used by
+///     the "checkpoint" sampling function
+RunCheckpointWriter::RunCheckpointWriter(fs::path _checkpoint_path,
+                                         double _period_in_s)
+    : checkpoint_path(_checkpoint_path),
+      period_in_s(_period_in_s),
+      m_run_index(0),
+      m_last_checkpoint(clock_type::now()),
+      m_is_writing(false),
+      m_stop(false),
+      m_thread(&RunCheckpointWriter::_work, this) {}
+
+/// \brief Destructor, waits for pending checkpoints to be written
+RunCheckpointWriter::~RunCheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+/// \brief Begin a run, setting the run index of checkpoints
+void RunCheckpointWriter::begin_run(Index run_index) {
+  wait();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_run_index = run_index;
+  m_last_checkpoint = clock_type::now();
+}
+
+/// \brief Current run index
+Index RunCheckpointWriter::run_index() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_run_index;
+}
+
+/// \brief Return true if a checkpoint is due, by clocktime
+bool RunCheckpointWriter::is_due() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::chrono::duration<double> elapsed = clock_type::now() - m_last_checkpoint;
+  return elapsed.count() >= period_in_s;
+}
+
+/// \brief Hand a checkpoint off to the background thread to be written
+///
+/// Throws if writing a previous checkpoint failed.
+void RunCheckpointWriter::write(RunCheckpointData data) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+    m_pending = std::move(data);
+    m_last_checkpoint = clock_type::now();
+  }
+  m_cv.notify_all();
+}
+
+/// \brief Wait for pending checkpoints to be written
+///
+/// Throws if writing a checkpoint failed.
+void RunCheckpointWriter::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return !m_pending.has_value() && !m_is_writing; });
+  if (m_error) {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/// \brief Wait for pending checkpoints, and remove the checkpoint file
+void RunCheckpointWriter::end_run() {
+  wait();
+  if (fs::exists(checkpoint_path)) {
+    fs::remove(checkpoint_path);
+  }
+}
+
+/// \brief Read a checkpoint file, if it exists
+std::optional<RunCheckpointData> RunCheckpointWriter::read() const {
+  if (!fs::exists(checkpoint_path)) {
+    return std::nullopt;
+  }
+  jsonParser json(checkpoint_path);
+  RunCheckpointData data;
+  data.run_index = json["run_index"].get<Index>();
+  data.occupation = unpack_compact_occupation(
+      json["occupation"].get<std::string>(), json["size"].get<Index>(),
+      json["bits_per_value"].get<int>());
+  data.engine_state = json["engine_state"].get<std::string>();
+  return data;
+}
+
+/// Background thread: write pending checkpoints
+void RunCheckpointWriter::_work() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [&] { return m_stop || m_pending.has_value(); });
+    if (!m_pending.has_value()) {
+      return;
+    }
+    RunCheckpointData data = std::move(*m_pending);
+    m_pending.reset();
+    m_is_writing = true;
+    lock.unlock();
+
+    try {
+      jsonParser json;
+      json["run_index"] = data.run_index;
+      json["size"] = data.occupation.size();
+      json["occupation"] = pack_occupation(data.occupation);
+      json["bits_per_value"] = data.occupation.bits_per_value();
+      json["engine_state"] = data.engine_state;
+      if (!checkpoint_path.parent_path().empty()) {
+        fs::create_directories(checkpoint_path.parent_path());
+      }
+      SafeOfstream file;
+      file.open(checkpoint_path);
+      json.print(file.ofstream(), -1);
+      file.close();
+    } catch (...) {
+      lock.lock();
+      m_error = std::current_exception();
+      m_is_writing = false;
+      m_cv.notify_all();
+      continue;
+    }
+
+    lock.lock();
+    m_is_writing = false;
+    m_cv.notify_all();
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,83 @@
+#include "casm/clexmonte/run/RunControl.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Name of a RunControlAction: "proceed", "stop", or "extend"
+std::string run_control_action_name(RunControlAction action) {
+  switch (action) {
+    case RunControlAction::proceed:
+      return "proceed";
+    case RunControlAction::stop:
+      return "stop";
+    case RunControlAction::extend:
+      return "extend";
+  }
+  throw std::runtime_error(
+      "Error in run_control_action_name: invalid RunControlAction");
+}
+
+/// \brief RunControlAction from its name
+///
+/// \throws If `name` is not "proceed", "stop", or "extend"
+RunControlAction run_control_action_from_name(std::string const &name) {
+  if (name == "proceed") {
+    return RunControlAction::proceed;
+  } else if (name == "stop") {
+    return RunControlAction::stop;
+  } else if (name == "extend") {
+    return RunControlAction::extend;
+  }
+  std::stringstream msg;
+  msg << "Error in run_control_action_from_name: invalid action \"" << name
+      << "\", expected one of \"proceed\", \"stop\", or \"extend\"";
+  throw std::runtime_error(msg.str());
+}
+
+/// \brief Constructor
+///
+/// \param _predicate Function which returns the requested action, given the
+///     results of the sampling fixture. It is called after each new sample.
+/// \param _sampling_fixture_label Label of the sampling fixture whose
+///     results are checked. If empty, or if no sampling fixture has this
+///     label, the first sampling fixture is used.
+RunControl::RunControl(predicate_type _predicate,
+                       std::string _sampling_fixture_label)
+    : predicate(_predicate),
+      sampling_fixture_label(_sampling_fixture_label),
+      m_action(RunControlAction::proceed),
+      m_stop_requested(false),
+      m_n_samples(0),
+      m_n_evaluations(0) {
+  if (predicate == nullptr) {
+    throw std::runtime_error(
+        "Error constructing RunControl: predicate == nullptr");
+  }
+}
+
+/// \brief Reset the requested action and sample count, at the beginning
+///     of a run
+void RunControl::begin_run() {
+  m_action = RunControlAction::proceed;
+  m_n_samples = 0;
+  m_n_evaluations = 0;
+}
+
+/// \brief Evaluate the predicate if the number of samples has changed
+///
+/// \param results Results of the sampling fixture being checked
+void RunControl::check(results_type const &results) {
+  Index n_samples = results.sample_count.size();
+  if (n_samples == m_n_samples) {
+    return;
+  }
+  m_n_samples = n_samples;
+  m_action = predicate(results);
+  ++m_n_evaluations;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,121 @@
+#include "casm/clexmonte/run/SamplingFunctionProfiler.hh"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte/sampling/StateSamplingFunction.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+double elapsed_s(clock_type::time_point begin) {
+  std::chrono::duration<double> elapsed = clock_type::now() - begin;
+  return elapsed.count();
+}
+
+template <typename FunctionMapType>
+void check_profiler_args(FunctionMapType const &functions,
+                         std::vector<std::string> const &names,
+                         SamplingFunctionProfiler const *profiler,
+                         std::string const &method) {
+  if (!profiler) {
+    throw std::runtime_error("Error in " + method + ": profiler is null");
+  }
+  for (std::string const &name : names) {
+    if (!functions.count(name)) {
+      std::stringstream msg;
+      msg << "Error in " << method << ": no sampling function named \""
+          << name << "\"";
+      throw std::runtime_error(msg.str());
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Record one call of a sampling function
+void SamplingFunctionProfiler::record(std::string const &name,
+                                      double time_s) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry &entry = m_entries[name];
+  ++entry.n_calls;
+  entry.total_time_s += time_s;
+}
+
+/// \brief Return the profile of each sampling function called
+std::map<std::string, SamplingFunctionProfiler::Entry>
+SamplingFunctionProfiler::entries() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries;
+}
+
+/// \brief Clear all entries
+void SamplingFunctionProfiler::reset() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+/// \brief Wrap sampling functions so that each call is recorded by a
+///     SamplingFunctionProfiler
+///
+/// \param sampling_functions Sampling functions
+/// \param sampler_names Names of the sampling functions to wrap
+/// \param profiler The profiler to record calls
+///
+/// \returns A copy of `sampling_functions`, in which the functions named in
+///     `sampler_names` are wrapped.
+monte::StateSamplingFunctionMap make_profiled_sampling_functions(
+    monte::StateSamplingFunctionMap sampling_functions,
+    std::vector<std::string> const &sampler_names,
+    std::shared_ptr<SamplingFunctionProfiler> profiler) {
+  check_profiler_args(sampling_functions, sampler_names, profiler.get(),
+                      "make_profiled_sampling_functions");
+  for (std::string const &name : sampler_names) {
+    auto &f = sampling_functions.at(name);
+    auto original_function = f.function;
+    f.function = [=]() -> Eigen::VectorXd {
+      clock_type::time_point begin = clock_type::now();
+      Eigen::VectorXd value = original_function();
+      profiler->record(name, elapsed_s(begin));
+      return value;
+    };
+  }
+  return sampling_functions;
+}
+
+/// \brief Wrap JSON sampling functions so that each call is recorded by a
+///     SamplingFunctionProfiler
+///
+/// \param json_sampling_functions JSON sampling functions
+/// \param json_sampler_names Names of the JSON sampling functions to wrap
+/// \param profiler The profiler to record calls
+///
+/// \returns A copy of `json_sampling_functions`, in which the functions
+///     named in `json_sampler_names` are wrapped.
+monte::jsonStateSamplingFunctionMap make_profiled_json_sampling_functions(
+    monte::jsonStateSamplingFunctionMap json_sampling_functions,
+    std::vector<std::string> const &json_sampler_names,
+    std::shared_ptr<SamplingFunctionProfiler> profiler) {
+  check_profiler_args(json_sampling_functions, json_sampler_names,
+                      profiler.get(), "make_profiled_json_sampling_functions");
+  for (std::string const &name : json_sampler_names) {
+    auto &f = json_sampling_functions.at(name);
+    auto original_function = f.function;
+    f.function = [=]() -> jsonParser {
+      clock_type::time_point begin = clock_type::now();
+      jsonParser value = original_function();
+      profiler->record(name, elapsed_s(begin));
+      return value;
+    };
+  }
+  return json_sampling_functions;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,102 @@
+#include "casm/clexmonte/run/TelemetryChannel.hh"
+
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _capacity Maximum number of unread records. Records published
+///     while the buffer is full are dropped.
+/// \param _min_interval_s Minimum time between records published during a
+///     run, in seconds. The record published when a run is finalized is
+///     always published.
+/// \param _sampler_names Names of the samplers whose most recent values are
+///     included in records
+/// \param _sampling_fixture_label Label of the sampling fixture records are
+///     made from. If empty, or if no sampling fixture has this label, the
+///     first sampling fixture is used.
+TelemetryChannel::TelemetryChannel(Index _capacity, double _min_interval_s,
+                                   std::vector<std::string> _sampler_names,
+                                   std::string _sampling_fixture_label)
+    : capacity(_capacity),
+      min_interval_s(_min_interval_s),
+      sampler_names(_sampler_names),
+      sampling_fixture_label(_sampling_fixture_label),
+      m_start(clock_type::now()),
+      m_head(0),
+      m_tail(0),
+      m_n_dropped(0),
+      m_last_time(0.0),
+      m_last_run_index(-1),
+      m_last_n_steps(0) {
+  if (capacity < 1) {
+    throw std::runtime_error(
+        "Error constructing TelemetryChannel: capacity < 1");
+  }
+  if (min_interval_s < 0.0) {
+    throw std::runtime_error(
+        "Error constructing TelemetryChannel: min_interval_s < 0.0");
+  }
+  m_slots.resize(capacity);
+  for (TelemetryRecord &record : m_slots) {
+    record.sampled_values.resize(sampler_names.size());
+  }
+}
+
+/// \brief Seconds since the channel was constructed
+double TelemetryChannel::clocktime() const {
+  std::chrono::duration<double> elapsed = clock_type::now() - m_start;
+  return elapsed.count();
+}
+
+/// \brief Producer: True if `min_interval_s` has passed since the last
+///     published record
+bool TelemetryChannel::is_due() const {
+  return m_last_run_index == -1 || clocktime() - m_last_time >= min_interval_s;
+}
+
+/// \brief Producer: Record the time and step count of a new record and
+///     return the steps per second since the previous record
+///
+/// \param run_index Run index of the new record
+/// \param n_steps Number of steps of the new record
+/// \param now Time of the new record, as given by `clocktime()`
+///
+/// \returns Steps per second since the previous record, or 0.0 if the
+///     previous record was from a different run
+double TelemetryChannel::update_events_per_s(Index run_index, Index n_steps,
+                                             double now) {
+  double events_per_s = 0.0;
+  if (run_index == m_last_run_index && n_steps >= m_last_n_steps &&
+      now > m_last_time) {
+    events_per_s = (n_steps - m_last_n_steps) / (now - m_last_time);
+  }
+  m_last_time = now;
+  m_last_run_index = run_index;
+  m_last_n_steps = n_steps;
+  return events_per_s;
+}
+
+/// \brief Consumer: Take all published records, oldest first
+///
+/// Records are copied out of the buffer, and their slots are then released
+/// for the producer to reuse.
+///
+/// \returns Records published since the last call, excluding dropped
+///     records
+std::vector<TelemetryRecord> TelemetryChannel::read() {
+  Index tail = m_tail.load(std::memory_order_relaxed);
+  Index head = m_head.load(std::memory_order_acquire);
+  std::vector<TelemetryRecord> records;
+  records.reserve(head - tail);
+  for (Index i = tail; i < head; ++i) {
+    records.push_back(m_slots[i % capacity]);
+  }
+  m_tail.store(head, std::memory_order_release);
+  return records;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
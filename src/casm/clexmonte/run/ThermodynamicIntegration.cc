@@ -0,0 +1,224 @@
+#include "casm/clexmonte/run/ThermodynamicIntegration.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "casm/clexmonte/run/AdaptiveConditionsStateGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief Second divided difference, f[v0, v1, v2], or 0 if any of the
+///     points coincide
+double second_divided_difference(double v0, double v1, double v2, double f0,
+                                 double f1, double f2) {
+  double tol = 1e-14 * (std::abs(v0) + std::abs(v1) + std::abs(v2) + 1.0);
+  if (std::abs(v1 - v0) < tol || std::abs(v2 - v1) < tol ||
+      std::abs(v2 - v0) < tol) {
+    return 0.0;
+  }
+  return ((f2 - f1) / (v2 - v1) - (f1 - f0) / (v1 - v0)) / (v2 - v0);
+}
+
+/// \brief Estimated trapezoid error of the integral of `f dv` between points
+///     `i` and `i+1`
+///
+/// The trapezoid error of an interval of width `h` is `h^3 * f'' / 12`, and
+/// `f''` is estimated as twice the mean second divided difference of the
+/// point triples that include the interval.
+double trapezoid_error(std::vector<double> const &v,
+                       std::vector<double> const &f, Index i) {
+  Index n = v.size();
+  double sum = 0.0;
+  Index count = 0;
+  if (i > 0) {
+    sum += std::abs(second_divided_difference(v[i - 1], v[i], v[i + 1],
+                                              f[i - 1], f[i], f[i + 1]));
+    ++count;
+  }
+  if (i + 2 < n) {
+    sum += std::abs(second_divided_difference(v[i], v[i + 1], v[i + 2], f[i],
+                                              f[i + 1], f[i + 2]));
+    ++count;
+  }
+  if (count == 0) {
+    return 0.0;
+  }
+  double h = std::abs(v[i + 1] - v[i]);
+  return h * h * h * (2.0 * sum / count) / 12.0;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param t Path parameter of each run
+/// \param temperature Temperature of each run
+/// \param param_chem_pot Parametric chemical potential of each run. Give
+///     size 0 vectors for canonical runs.
+/// \param potential_energy Mean potential energy per unit cell, as sampled
+///     by "potential_energy", of each run
+/// \param param_composition Mean parametric composition of each run, with
+///     the same size as `param_chem_pot`
+/// \param reference_free_energy The free energy per unit cell of the run
+///     with the smallest `t`
+ThermodynamicIntegration::ThermodynamicIntegration(
+    std::vector<double> const &t, std::vector<double> const &temperature,
+    std::vector<Eigen::VectorXd> const &param_chem_pot,
+    std::vector<double> const &potential_energy,
+    std::vector<Eigen::VectorXd> const &param_composition,
+    double reference_free_energy) {
+  Index n = t.size();
+  if (n == 0) {
+    throw std::runtime_error(
+        "Error constructing ThermodynamicIntegration: no runs");
+  }
+  if (temperature.size() != n || param_chem_pot.size() != n ||
+      potential_energy.size() != n || param_composition.size() != n) {
+    throw std::runtime_error(
+        "Error constructing ThermodynamicIntegration: the number of values "
+        "of each input must equal the number of runs");
+  }
+  Index n_mu = param_chem_pot[0].size();
+  for (Index k = 0; k < n; ++k) {
+    if (!(temperature[k] > 0.0)) {
+      throw std::runtime_error(
+          "Error constructing ThermodynamicIntegration: temperature <= 0.0");
+    }
+    if (param_chem_pot[k].size() != n_mu ||
+        param_composition[k].size() != n_mu) {
+      throw std::runtime_error(
+          "Error constructing ThermodynamicIntegration: param_chem_pot and "
+          "param_composition sizes must be equal for all runs");
+    }
+  }
+
+  // Sort by path parameter
+  m_order.resize(n);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  std::stable_sort(m_order.begin(), m_order.end(),
+                   [&](Index a, Index b) { return t[a] < t[b]; });
+
+  // Integration variables and integrands, in order
+  std::vector<double> beta;
+  std::vector<double> u;
+  std::vector<std::vector<double>> mu(n_mu);
+  std::vector<std::vector<double>> beta_x(n_mu);
+  for (Index k : m_order) {
+    m_t.push_back(t[k]);
+    double _beta = 1.0 / (CASM::KB * temperature[k]);
+    beta.push_back(_beta);
+    u.push_back(potential_energy[k]);
+    for (Index j = 0; j < n_mu; ++j) {
+      mu[j].push_back(param_chem_pot[k](j));
+      beta_x[j].push_back(_beta * param_composition[k](j));
+    }
+  }
+
+  // Trapezoid rule, for beta*phi
+  Eigen::VectorXd beta_phi(n);
+  beta_phi(0) = beta[0] * reference_free_energy;
+  for (Index i = 0; i + 1 < n; ++i) {
+    double delta = 0.5 * (u[i] + u[i + 1]) * (beta[i + 1] - beta[i]);
+    for (Index j = 0; j < n_mu; ++j) {
+      delta -= 0.5 * (beta_x[j][i] + beta_x[j][i + 1]) *
+               (mu[j][i + 1] - mu[j][i]);
+    }
+    beta_phi(i + 1) = beta_phi(i) + delta;
+  }
+  m_free_energy.resize(n);
+  for (Index i = 0; i < n; ++i) {
+    m_free_energy(i) = beta_phi(i) / beta[i];
+  }
+
+  // Error estimates, converted from beta*phi to phi conservatively
+  m_error_estimate = Eigen::VectorXd::Zero(std::max(n - 1, Index(0)));
+  for (Index i = 0; i + 1 < n; ++i) {
+    double error = trapezoid_error(beta, u, i);
+    for (Index j = 0; j < n_mu; ++j) {
+      error += trapezoid_error(mu[j], beta_x[j], i);
+    }
+    m_error_estimate(i) = error / std::min(beta[i], beta[i + 1]);
+  }
+}
+
+/// \brief Path parameters at which to add runs, the midpoints of the
+///     intervals with error estimate larger than `tol`
+///
+/// \param tol Tolerance on the error estimate of the free energy per unit
+///     cell accumulated over one interval
+std::vector<double> ThermodynamicIntegration::refinement_t(double tol) const {
+  std::vector<double> t;
+  for (Index i = 0; i < m_error_estimate.size(); ++i) {
+    if (m_error_estimate(i) > tol) {
+      t.push_back(0.5 * (m_t[i] + m_t[i + 1]));
+    }
+  }
+  return t;
+}
+
+/// \brief Construct thermodynamic integration for a completed series of
+///     runs along the path `initial_conditions + t * conditions_increment`
+///
+/// \param completed_runs The completed runs, which must have a
+///     "temperature" condition, and if semi-grand canonical a
+///     "param_chem_pot" condition
+/// \param initial_conditions, conditions_increment Define the path, as for
+///     AdaptiveConditionsStateGenerator, and are used to find the path
+///     parameter of each run
+/// \param potential_energy Mean potential energy per unit cell of each run
+/// \param param_composition Mean parametric composition of each run. Ignored
+///     (may be empty) for runs without a "param_chem_pot" condition.
+/// \param reference_free_energy The free energy per unit cell of the run
+///     with the smallest path parameter
+ThermodynamicIntegration make_thermodynamic_integration(
+    std::vector<RunData> const &completed_runs,
+    monte::ValueMap const &initial_conditions,
+    monte::ValueMap const &conditions_increment,
+    std::vector<double> const &potential_energy,
+    std::vector<Eigen::VectorXd> const &param_composition,
+    double reference_free_energy) {
+  if (completed_runs.empty()) {
+    throw std::runtime_error(
+        "Error in make_thermodynamic_integration: no completed runs");
+  }
+  std::vector<double> t;
+  std::vector<double> temperature;
+  std::vector<Eigen::VectorXd> param_chem_pot;
+  std::vector<Eigen::VectorXd> _param_composition;
+  for (Index k = 0; k < completed_runs.size(); ++k) {
+    RunData const &run_data = completed_runs[k];
+    auto const &scalar_values = run_data.conditions.scalar_values;
+    auto const &vector_values = run_data.conditions.vector_values;
+    if (!scalar_values.count("temperature")) {
+      throw std::runtime_error(
+          "Error in make_thermodynamic_integration: requires temperature "
+          "condition");
+    }
+    t.push_back(get_conditions_path_parameter(
+        run_data.conditions, initial_conditions, conditions_increment));
+    temperature.push_back(scalar_values.at("temperature"));
+    if (vector_values.count("param_chem_pot")) {
+      param_chem_pot.push_back(vector_values.at("param_chem_pot"));
+      if (k >= param_composition.size()) {
+        throw std::runtime_error(
+            "Error in make_thermodynamic_integration: param_composition is "
+            "required for runs with a param_chem_pot condition");
+      }
+      _param_composition.push_back(param_composition[k]);
+    } else {
+      param_chem_pot.push_back(Eigen::VectorXd());
+      _param_composition.push_back(Eigen::VectorXd());
+    }
+  }
+  return ThermodynamicIntegration(t, temperature, param_chem_pot,
+                                  potential_energy, _param_composition,
+                                  reference_free_energy);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
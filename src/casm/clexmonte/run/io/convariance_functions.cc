@@ -1,5 +1,6 @@
 #include <limits>
 
+#include "casm/clexmonte/misc/CovarianceAccumulator.hh"
 #include "casm/clexmonte/misc/eigen.hh"
 #include "casm/clexmonte/run/covariance_functions.hh"
 #include "casm/clexmonte/state/Configuration.hh"
@@ -11,6 +12,21 @@
 namespace CASM {
 namespace clexmonte {
 
+namespace {
+
+/// Copy the last `N_stats` samples of each component into the columns of a
+/// matrix, so each component is copied once
+template <typename SamplerType>
+Eigen::MatrixXd _tail_samples(SamplerType const &sampler, Index N_stats) {
+  Eigen::MatrixXd X(N_stats, sampler.n_components());
+  for (Index i = 0; i < sampler.n_components(); ++i) {
+    X.col(i) = sampler.component(i).tail(N_stats);
+  }
+  return X;
+}
+
+}  // namespace
+
 /// \brief Make variance analysis function (i.e. "heat_capacity")
 ///
 /// \param name Name to give analysis function (ex. "heat_capacity")
@@ -47,15 +63,16 @@ results_analysis_function_type make_variance_f(
 
         Index N_stats = N_samples_for_statistics(results);
 
+        // one streaming pass over the samples for all components
         Index n = sampler.n_components();
-        Eigen::VectorXd var = Eigen::VectorXd::Zero(n);
+        Eigen::VectorXd var(n);
+        Eigen::MatrixXd X = _tail_samples(sampler, N_stats);
         for (Index i = 0; i < n; ++i) {
-          if (N_stats == 0) {
-            var(i) = std::numeric_limits<double>::quiet_NaN();
-          } else {
-            Eigen::VectorXd x = sampler.component(i).tail(N_stats);
-            var(i) = monte::variance(x) / normalization_constant;
+          CovarianceAccumulator accumulator(1, 1);
+          for (Index k = 0; k < N_stats; ++k) {
+            accumulator.push(X.block(k, i, 1, 1), X.block(k, i, 1, 1));
           }
+          var(i) = accumulator.covariance()(0, 0) / normalization_constant;
         }
 
         return var;
@@ -123,24 +140,128 @@ results_analysis_function_type make_covariance_f(
 
         Index N_stats = N_samples_for_statistics(results);
 
+        // one streaming pass over the samples for all pairs of components
         Index m = first_sampler.n_components();
         Index n = second_sampler.n_components();
-        Eigen::MatrixXd cov = Eigen::MatrixXd::Zero(m, n);
-        for (Index i = 0; i < m; ++i) {
-          for (Index j = 0; j < n; ++j) {
-            if (N_stats == 0) {
-              cov(i, j) = std::numeric_limits<double>::quiet_NaN();
-            } else {
-              Eigen::VectorXd x = first_sampler.component(i).tail(N_stats);
-              Eigen::VectorXd y = second_sampler.component(j).tail(N_stats);
-              cov(i, j) = monte::covariance(x, y) / normalization_constant;
-            }
-          }
+        Eigen::MatrixXd X = _tail_samples(first_sampler, N_stats);
+        Eigen::MatrixXd Y = _tail_samples(second_sampler, N_stats);
+        CovarianceAccumulator accumulator(m, n);
+        for (Index k = 0; k < N_stats; ++k) {
+          accumulator.push(X.row(k).transpose(), Y.row(k).transpose());
         }
+        Eigen::MatrixXd cov = accumulator.covariance() / normalization_constant;
 
         return monte::reshaped(cov);
       });
 }
 
+/// \brief Mean energy of each member of an ensemble of potentials,
+///     reweighted from samples of a reference potential
+///
+/// Samples drawn with the reference potential are reweighted to ensemble
+/// member `k` with weights `exp(-beta*n_unitcells*(E_k - E_ref))`, which
+/// is exact for potentials that differ only in the energy, such as
+/// cluster expansions with different coefficients. The reweighting is
+/// reliable only while the ensemble members are close enough to the
+/// reference that the effective number of samples remains large.
+///
+/// \param reference_energy The energy per unit cell of the reference
+///     potential, for each sample
+/// \param ensemble_energy The energy per unit cell of each ensemble member
+///     (columns), for each sample (rows)
+/// \param beta_n_unitcells The value `n_unitcells / (kB * temperature)`
+/// \param effective_n_samples If not null, set to the effective number of
+///     samples, `(sum w)^2 / sum(w^2)`, for each ensemble member
+///
+/// \returns The reweighted mean of `ensemble_energy.col(k)`, for each
+///     ensemble member `k`
+Eigen::VectorXd ensemble_reweighted_means(
+    Eigen::VectorXd const &reference_energy,
+    Eigen::MatrixXd const &ensemble_energy, double beta_n_unitcells,
+    Eigen::VectorXd *effective_n_samples) {
+  Index n_samples = reference_energy.size();
+  Index n_members = ensemble_energy.cols();
+  if (ensemble_energy.rows() != n_samples) {
+    throw std::runtime_error(
+        "Error in ensemble_reweighted_means: reference_energy and "
+        "ensemble_energy must have the same number of samples");
+  }
+  if (n_samples == 0) {
+    throw std::runtime_error("Error in ensemble_reweighted_means: no samples");
+  }
+  Eigen::VectorXd means(n_members);
+  if (effective_n_samples) {
+    effective_n_samples->resize(n_members);
+  }
+  for (Index k = 0; k < n_members; ++k) {
+    // shift the exponent by its maximum so the largest weight is 1
+    Eigen::ArrayXd exponent =
+        -beta_n_unitcells *
+        (ensemble_energy.col(k) - reference_energy).array();
+    Eigen::ArrayXd w = (exponent - exponent.maxCoeff()).exp();
+    double sum_w = w.sum();
+    means(k) = (w * ensemble_energy.col(k).array()).sum() / sum_w;
+    if (effective_n_samples) {
+      (*effective_n_samples)(k) = sum_w * sum_w / w.square().sum();
+    }
+  }
+  return means;
+}
+
+/// \brief Make ensemble reweighting analysis function (i.e.
+///     "eci_ensemble.<key>")
+///
+/// \param name Name to give analysis function
+/// \param description Description to give analysis function
+/// \param reference_sampler_name Name of state sampler function collecting
+///     the energy per unit cell of the potential used for sampling
+/// \param ensemble_sampler_name Name of state sampler function collecting
+///     the energy per unit cell of each ensemble member
+/// \param component_names Names for each ensemble member
+/// \param make_beta_n_unitcells_f A function that returns
+///     `n_unitcells / (kB * temperature)`
+///
+/// The analysis function gives the reweighted mean energy per unit cell of
+/// each ensemble member (see `ensemble_reweighted_means`).
+results_analysis_function_type make_ensemble_reweighting_f(
+    std::string name, std::string description,
+    std::string reference_sampler_name, std::string ensemble_sampler_name,
+    std::vector<std::string> component_names,
+    std::function<double()> make_beta_n_unitcells_f) {
+  std::vector<Index> shape;
+  shape.push_back(component_names.size());
+
+  return results_analysis_function_type(
+      name, description, component_names, shape,
+      [=](results_type const &results) -> Eigen::VectorXd {
+        // validation of sampled data:
+        auto reference_it = results.samplers.find(reference_sampler_name);
+        if (reference_it == results.samplers.end()) {
+          std::stringstream msg;
+          msg << "Results analysis error: " << name << " requires sampling "
+              << reference_sampler_name;
+          throw std::runtime_error(msg.str());
+        }
+        auto const &reference_sampler = *reference_it->second;
+
+        // validation of sampled data:
+        auto ensemble_it = results.samplers.find(ensemble_sampler_name);
+        if (ensemble_it == results.samplers.end()) {
+          std::stringstream msg;
+          msg << "Results analysis error: " << name << " requires sampling "
+              << ensemble_sampler_name;
+          throw std::runtime_error(msg.str());
+        }
+        auto const &ensemble_sampler = *ensemble_it->second;
+
+        double beta_n_unitcells = make_beta_n_unitcells_f();
+
+        Index N_stats = N_samples_for_statistics(results);
+        Eigen::MatrixXd X = _tail_samples(reference_sampler, N_stats);
+        Eigen::MatrixXd Y = _tail_samples(ensemble_sampler, N_stats);
+        return ensemble_reweighted_means(X.col(0), Y, beta_n_unitcells);
+      });
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
@@ -0,0 +1,74 @@
+#include "casm/clexmonte/run/io/json/AutoEquilibration_json_io.hh"
+
+#include <algorithm>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/AutoEquilibration.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Construct AutoEquilibrationParams from JSON
+///
+/// Expected format:
+/// \code
+///   "sampler_names": array of string (optional,
+///           default=["potential_energy", "mol_composition"])
+///       Names of the sampling functions whose components must pass the
+///       drift test. Names not sampled by a sampling fixture are skipped.
+///
+///   "confidence": number (optional, default=0.95)
+///       Confidence level of the drift test.
+///
+///   "min_n_samples": int (optional, default=20)
+///       Minimum number of samples of each equilibration run.
+///
+///   "max_n_samples": int (optional, default=10000)
+///       Maximum number of samples of each equilibration run.
+///
+///   "learn_length": bool (optional, default=false)
+///       If true, the minimum number of samples of each equilibration run
+///       is at least "learned_length_fraction" times the median number of
+///       samples of the previous equilibration runs in the series.
+///
+///   "learned_length_fraction": number (optional, default=0.5)
+///       See "learn_length".
+/// \endcode
+void parse(InputParser<AutoEquilibrationParams> &parser) {
+  AutoEquilibrationParams const defaults;
+  AutoEquilibrationParams params;
+  parser.optional_else(params.sampler_names, "sampler_names",
+                       defaults.sampler_names);
+  parser.optional_else(params.confidence, "confidence", defaults.confidence);
+  parser.optional_else(params.min_n_samples, "min_n_samples",
+                       defaults.min_n_samples);
+  parser.optional_else(params.max_n_samples, "max_n_samples",
+                       defaults.max_n_samples);
+  parser.optional_else(params.learn_length, "learn_length",
+                       defaults.learn_length);
+  parser.optional_else(params.learned_length_fraction,
+                       "learned_length_fraction",
+                       defaults.learned_length_fraction);
+
+  if (!(params.confidence > 0.0 && params.confidence < 1.0)) {
+    parser.insert_error("confidence", "Error: must be in (0, 1)");
+  }
+  if (params.min_n_samples < 0) {
+    parser.insert_error("min_n_samples", "Error: must be >= 0");
+  }
+  if (params.max_n_samples < std::max(Index(1), params.min_n_samples)) {
+    parser.insert_error("max_n_samples",
+                        "Error: must be >= 1 and >= min_n_samples");
+  }
+  if (!(params.learned_length_fraction > 0.0)) {
+    parser.insert_error("learned_length_fraction", "Error: must be > 0");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<AutoEquilibrationParams>(params);
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,45 @@
+#include "casm/clexmonte/run/io/json/ColumnarResultsIO_json_io.hh"
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/ColumnarResultsIO.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Construct ColumnarResultsIO from JSON
+///
+/// Expected format:
+/// \code
+///   "output_dir": string (required)
+///       Directory where per-run columns, "columns.json", and run
+///       directories are written.
+///
+///   "write_observations": bool (optional, default=false)
+///       If true, write the sampled observations, sample counts, times,
+///       weights, and clocktimes of each run to per-sample columns in
+///       "run.<run_index>/".
+///
+///   "float32_samplers": array of string (optional, default=[])
+///       Names of samplers whose per-sample columns are stored as float32,
+///       rather than float64. Sampled values and statistics are calculated
+///       in double precision either way.
+/// \endcode
+void parse(InputParser<ColumnarResultsIO> &parser) {
+  std::string output_dir;
+  parser.require(output_dir, "output_dir");
+
+  bool write_observations;
+  parser.optional_else(write_observations, "write_observations", false);
+
+  std::set<std::string> float32_sampler_names;
+  parser.optional(float32_sampler_names, "float32_samplers");
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<ColumnarResultsIO>(
+        output_dir, write_observations, float32_sampler_names);
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
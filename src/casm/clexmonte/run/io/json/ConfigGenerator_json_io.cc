@@ -3,8 +3,10 @@
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/ConfigGeneratorCache.hh"
 #include "casm/clexmonte/run/FixedConfigGenerator.hh"
 #include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/clexulator/io/json/ConfigDoFValues_json_io.hh"
 #include "casm/configuration/Configuration.hh"
@@ -64,6 +66,14 @@ void parse(
 ///       `transformation_matrix_to_supercell` is given but no `motif` is
 ///       provided, the default configuration is used.
 ///
+///   "occupation": string or object, optional
+///       Occupation of the `transformation_matrix_to_supercell` supercell,
+///       used instead of `motif`. Either the path to a binary occupation
+///       file (see `write_occupation_file`), or a packed occupation object
+///       (see `pack_occupation_json`). This is much faster to read than the
+///       "occ" array of a large `configuration`, which is parsed element by
+///       element. Other DoF have default values.
+///
 /// \endcode
 ///
 ///
@@ -96,51 +106,91 @@ void parse(InputParser<FixedConfigGenerator> &parser,
     std::shared_ptr<config::Supercell const> supercell =
         std::make_shared<config::Supercell const>(system->prim, T);
 
-    if (parser.self.contains("motif") && !parser.self["motif"].is_null()) {
+    if (parser.self.contains("occupation") &&
+        !parser.self["occupation"].is_null()) {
+      if (parser.self.contains("motif") && !parser.self["motif"].is_null()) {
+        parser.insert_error("occupation",
+                            "Only one of `motif` or `occupation` may be given");
+        return;
+      }
+      config::Configuration configuration(supercell);
+      Eigen::VectorXi occupation;
+      try {
+        occupation = read_occupation_json(parser.self["occupation"]);
+      } catch (std::exception &e) {
+        parser.insert_error("occupation", e.what());
+        return;
+      }
+      if (occupation.size() != configuration.dof_values.occupation.size()) {
+        std::stringstream msg;
+        msg << "Occupation size (" << occupation.size()
+            << ") does not match the supercell ("
+            << configuration.dof_values.occupation.size() << " sites)";
+        parser.insert_error("occupation", msg.str());
+        return;
+      }
+      configuration.dof_values.occupation = occupation;
+      parser.value = std::make_unique<FixedConfigGenerator>(configuration);
+    } else if (parser.self.contains("motif") &&
+               !parser.self["motif"].is_null()) {
       std::unique_ptr<config::Configuration> motif =
           parser.optional<config::Configuration>("motif", *system->supercells);
 
-      // check if motif can tile into `transformation_matrix_to_supercell`
-      auto const &superlattice = supercell->superlattice.superlattice();
-      auto const &unit_lattice = motif->supercell->superlattice.superlattice();
-      auto const &fg_elements = system->prim->sym_info.factor_group->element;
-      double tol = std::max(superlattice.tol(), unit_lattice.tol());
-      auto result = is_equivalent_superlattice(superlattice, unit_lattice,
-                                               fg_elements.begin(),
-                                               fg_elements.end(), tol);
-      bool is_equivalent = (result.first != fg_elements.end());
-      Index prim_factor_group_index = -1;
-      if (is_equivalent) {
-        prim_factor_group_index =
-            std::distance(fg_elements.begin(), result.first);
-        if (prim_factor_group_index != 0) {
-          log << "Note: For \"fixed\" configuration generator: " << std::endl;
-          log << "Note: `motif` tiles the supercell specified by "
-                 "`transformation_matrix_to_supercell` after applying "
-                 "prim factor group operation "
-              << prim_factor_group_index + 1 << " (indexing from 1)."
-              << std::endl;
-          log << "Note: Prim factor group operations: (Cartesian)" << std::endl;
-          Index i = 1;
-          for (auto op : fg_elements) {
-            xtal::SymInfo syminfo(op, system->prim->basicstructure->lattice());
-            log << "- " << i << ": "
-                << to_brief_unicode(syminfo, xtal::SymInfoOptions(CART))
+      // tile motif into `transformation_matrix_to_supercell`
+      auto make_f = [&]() {
+        // check if motif can tile into `transformation_matrix_to_supercell`
+        auto const &superlattice = supercell->superlattice.superlattice();
+        auto const &unit_lattice =
+            motif->supercell->superlattice.superlattice();
+        auto const &fg_elements = system->prim->sym_info.factor_group->element;
+        double tol = std::max(superlattice.tol(), unit_lattice.tol());
+        auto result = is_equivalent_superlattice(superlattice, unit_lattice,
+                                                 fg_elements.begin(),
+                                                 fg_elements.end(), tol);
+        bool is_equivalent = (result.first != fg_elements.end());
+        Index prim_factor_group_index = -1;
+        if (is_equivalent) {
+          prim_factor_group_index =
+              std::distance(fg_elements.begin(), result.first);
+          if (prim_factor_group_index != 0) {
+            log << "Note: For \"fixed\" configuration generator: "
+                << std::endl;
+            log << "Note: `motif` tiles the supercell specified by "
+                   "`transformation_matrix_to_supercell` after applying "
+                   "prim factor group operation "
+                << prim_factor_group_index + 1 << " (indexing from 1)."
                 << std::endl;
-            ++i;
+            log << "Note: Prim factor group operations: (Cartesian)"
+                << std::endl;
+            Index i = 1;
+            for (auto op : fg_elements) {
+              xtal::SymInfo syminfo(op,
+                                    system->prim->basicstructure->lattice());
+              log << "- " << i << ": "
+                  << to_brief_unicode(syminfo, xtal::SymInfoOptions(CART))
+                  << std::endl;
+              ++i;
+            }
+            log << std::endl;
           }
-          log << std::endl;
+        } else {
+          log << "Warning: For \"fixed\" configuration generator: "
+              << std::endl;
+          log << "Warning: `motif` cannot tile the supercell specified by "
+                 "`transformation_matrix_to_supercell`. Filling "
+                 "imperfectly.";
+          prim_factor_group_index = 0;
         }
-      } else {
-        log << "Warning: For \"fixed\" configuration generator: " << std::endl;
-        log << "Warning: `motif` cannot tile the supercell specified by "
-               "`transformation_matrix_to_supercell`. Filling imperfectly.";
-        prim_factor_group_index = 0;
-      }
 
-      xtal::UnitCell translation(0, 0, 0);
-      parser.value = std::make_unique<FixedConfigGenerator>(copy_configuration(
-          prim_factor_group_index, translation, *motif, supercell));
+        xtal::UnitCell translation(0, 0, 0);
+        return copy_configuration(prim_factor_group_index, translation,
+                                  *motif, supercell);
+      };
+
+      // the same motif and supercell are only tiled once per process
+      std::string key = make_config_cache_key("fixed", &T, motif.get());
+      parser.value = std::make_unique<FixedConfigGenerator>(
+          *default_config_generator_cache()->get_or_make(key, make_f));
     } else {
       log << "Note: For \"fixed\" configuration generator: " << std::endl;
       log << "Note: No \"motif\" parameter. Using default configuration."
@@ -2,13 +2,16 @@
 
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/run/ColumnarResultsIO.hh"
 #include "casm/clexmonte/run/FixedConfigGenerator.hh"
 #include "casm/clexmonte/run/StateGenerator.hh"
 #include "casm/clexmonte/run/StateModifyingFunction.hh"
 #include "casm/clexmonte/run/io/RunParams.hh"
+#include "casm/clexmonte/run/io/json/ColumnarResultsIO_json_io.hh"
 #include "casm/clexmonte/run/io/json/ConfigGenerator_json_io.hh"
 #include "casm/clexmonte/run/io/json/RunParams_json_io_impl.hh"
 #include "casm/clexmonte/run/io/json/StateGenerator_json_io.hh"
+#include "casm/clexmonte/run/io/json/jsonIndexedResultsIO.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/state/io/json/State_json_io.hh"
 #include "casm/configuration/io/json/Configuration_json_io.hh"
@@ -37,7 +40,9 @@ MethodParserMap<results_io_type> standard_results_io_methods() {
   MethodParserMap<results_io_type> results_io_methods;
 
   results_io_methods.insert(
-      f.template make<monte::jsonResultsIO<results_type>>("json")
+      f.template make<monte::jsonResultsIO<results_type>>("json"),
+      f.template make<jsonIndexedResultsIO>("json_indexed"),
+      f.template make<ColumnarResultsIO>("columnar")
       // To add additional state generators:
       // f.make<DerivedClassName>("<name>", ...args...),
   );
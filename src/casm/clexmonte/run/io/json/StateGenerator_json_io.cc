@@ -18,14 +18,22 @@ namespace clexmonte {
 ///
 /// Expected JSON:
 ///   method: string (required)
-///     The name of the chosen state generation method. Currently, the only
-///     option is:
+///     The name of the chosen state generation method. Options are:
 ///     - "incremental": IncrementalConditionsStateGenerator
+///     - "adaptive": AdaptiveConditionsStateGenerator
+///     - "grid": GridConditionsStateGenerator
+///     - "finite_size_scaling": FiniteSizeScalingStateGenerator
 ///
 ///   kwargs: dict (optional, default={})
 ///     Method-specific options. See documentation for particular methods:
 ///     - "incremental":
 ///           `parse(InputParser<incremental_state_generator_type> &, ...)`
+///     - "adaptive":
+///           `parse(InputParser<AdaptiveConditionsStateGenerator> &, ...)`
+///     - "grid":
+///           `parse(InputParser<GridConditionsStateGenerator> &, ...)`
+///     - "finite_size_scaling":
+///           `parse(InputParser<FiniteSizeScalingStateGenerator> &, ...)`
 ///
 void parse(
     InputParser<state_generator_type> &parser,
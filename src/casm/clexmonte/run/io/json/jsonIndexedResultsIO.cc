@@ -0,0 +1,121 @@
+#include "casm/clexmonte/run/io/json/jsonIndexedResultsIO.hh"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/monte/io/json/ValueMap_json_io.hh"
+#include "casm/monte/run_management/io/json/jsonResultsIO_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _output_dir Directory for the index file and run directories
+/// \param _write_trajectory If true, write the trajectory of each run
+/// \param _write_observations If true, write the observations of each run
+jsonIndexedResultsIO::jsonIndexedResultsIO(fs::path _output_dir,
+                                           bool _write_trajectory,
+                                           bool _write_observations)
+    : m_output_dir(_output_dir),
+      m_write_trajectory(_write_trajectory),
+      m_write_observations(_write_observations) {}
+
+/// \brief Read the conditions of the runs in the index, in the order
+///     written
+std::vector<monte::ValueMap> jsonIndexedResultsIO::read_conditions() {
+  std::vector<monte::ValueMap> conditions;
+  fs::path index_path = m_output_dir / "summary.jsonl";
+  if (!fs::exists(index_path)) {
+    return conditions;
+  }
+  std::ifstream file(index_path);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (file.eof()) {
+      // no newline: an interrupted write
+      break;
+    }
+    if (line.empty()) {
+      continue;
+    }
+    monte::ValueMap run_conditions;
+    from_json(run_conditions, jsonParser::parse(line)["conditions"]);
+    conditions.push_back(run_conditions);
+  }
+  return conditions;
+}
+
+/// \brief Write the results of one run, and append it to the index
+///
+/// The cost does not depend on the number of runs already written.
+void jsonIndexedResultsIO::write(results_type const &results,
+                                 monte::ValueMap const &conditions,
+                                 Index run_index) {
+  fs::path _run_dir = this->run_dir(run_index);
+  if (fs::exists(_run_dir)) {
+    // a run that is repeated replaces the previous results
+    fs::remove_all(_run_dir);
+  }
+  monte::jsonResultsIO<results_type> run_results_io(
+      _run_dir, m_write_trajectory, m_write_observations);
+  run_results_io.write(results, conditions, 0);
+
+  jsonParser json;
+  json["run_index"] = run_index;
+  json["conditions"] = conditions;
+  json["summary"] = jsonParser(_run_dir / "summary.json");
+
+  fs::path index_path = m_output_dir / "summary.jsonl";
+  std::ofstream file(index_path, std::ios::app);
+  json.print(file, -1);
+  file << "\n";
+  file.flush();
+  if (!file) {
+    std::stringstream ss;
+    ss << "Error in jsonIndexedResultsIO: failed to write " << index_path;
+    throw std::runtime_error(ss.str());
+  }
+}
+
+/// \brief Directory with the results of run `run_index`
+fs::path jsonIndexedResultsIO::run_dir(Index run_index) const {
+  return m_output_dir / ("run." + std::to_string(run_index));
+}
+
+/// \brief Construct jsonIndexedResultsIO from JSON
+///
+/// Expected format:
+/// \code
+///   "output_dir": string (required)
+///       Directory for the index file, "summary.jsonl", and the results of
+///       each run, in "run.<run_index>/".
+///
+///   "write_trajectory": bool (optional, default=false)
+///       If true, write the trajectory of each run.
+///
+///   "write_observations": bool (optional, default=false)
+///       If true, write the observations of each run.
+/// \endcode
+void parse(InputParser<jsonIndexedResultsIO> &parser) {
+  std::string output_dir;
+  parser.require(output_dir, "output_dir");
+
+  bool write_trajectory;
+  parser.optional_else(write_trajectory, "write_trajectory", false);
+
+  bool write_observations;
+  parser.optional_else(write_observations, "write_observations", false);
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<jsonIndexedResultsIO>(
+        output_dir, write_trajectory, write_observations);
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,96 @@
+#include "casm/clexmonte/state/CompactOccupation.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Construct with all values zero
+///
+/// \param _size Number of sites
+/// \param _bits_per_value Bits per site, one of 1, 2, 4, or 8
+CompactOccupation::CompactOccupation(Index _size, int _bits_per_value)
+    : m_size(_size),
+      m_bits_per_value(_bits_per_value),
+      m_mask((1 << _bits_per_value) - 1) {
+  if (m_size < 0) {
+    throw std::runtime_error("Error constructing CompactOccupation: size < 0");
+  }
+  if (m_bits_per_value != 1 && m_bits_per_value != 2 &&
+      m_bits_per_value != 4 && m_bits_per_value != 8) {
+    std::stringstream msg;
+    msg << "Error constructing CompactOccupation: bits_per_value="
+        << m_bits_per_value << ", expected one of 1, 2, 4, or 8";
+    throw std::runtime_error(msg.str());
+  }
+  m_data.assign((std::size_t(m_size) * m_bits_per_value + 7) / 8, 0);
+}
+
+/// \brief Copy all values into `occupation`, resizing it if necessary
+void CompactOccupation::to_vector(Eigen::VectorXi &occupation) const {
+  occupation.resize(m_size);
+  for (Index l = 0; l < m_size; ++l) {
+    occupation(l) = get(l);
+  }
+}
+
+/// \brief Return all values as `Eigen::VectorXi`
+Eigen::VectorXi CompactOccupation::to_vector() const {
+  Eigen::VectorXi occupation;
+  to_vector(occupation);
+  return occupation;
+}
+
+/// \brief Fewest bits per value, of 1, 2, 4, or 8, that can hold
+///     `max_value`
+///
+/// \throws If `max_value` < 0 or `max_value` > 255
+int compact_bits_per_value(int max_value) {
+  if (max_value < 0 || max_value > 255) {
+    std::stringstream msg;
+    msg << "Error in compact_bits_per_value: max_value=" << max_value
+        << " is not in [0, 255]";
+    throw std::runtime_error(msg.str());
+  }
+  int bits_per_value = 1;
+  while ((max_value >> bits_per_value) != 0) {
+    bits_per_value *= 2;
+  }
+  return bits_per_value;
+}
+
+/// \brief Make a CompactOccupation from occupation indices
+///
+/// \param occupation Occupation indices, which must be in [0, 255]
+/// \param bits_per_value Bits per site, one of 1, 2, 4, or 8. If 0, the
+///     fewest bits that hold the maximum occupation index are used.
+///
+/// \returns The compact occupation
+CompactOccupation make_compact_occupation(Eigen::VectorXi const &occupation,
+                                          int bits_per_value) {
+  int min_value = occupation.size() ? occupation.minCoeff() : 0;
+  int max_value = occupation.size() ? occupation.maxCoeff() : 0;
+  if (min_value < 0) {
+    throw std::runtime_error(
+        "Error in make_compact_occupation: occupation indices must be >= 0");
+  }
+  int required_bits_per_value = compact_bits_per_value(max_value);
+  if (bits_per_value == 0) {
+    bits_per_value = required_bits_per_value;
+  } else if (bits_per_value < required_bits_per_value) {
+    std::stringstream msg;
+    msg << "Error in make_compact_occupation: bits_per_value="
+        << bits_per_value << " cannot hold occupation index " << max_value;
+    throw std::runtime_error(msg.str());
+  }
+  CompactOccupation compact(occupation.size(), bits_per_value);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    compact.set(l, occupation(l));
+  }
+  return compact;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
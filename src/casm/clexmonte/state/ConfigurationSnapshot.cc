@@ -0,0 +1,177 @@
+#include "casm/clexmonte/state/ConfigurationSnapshot.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief Share `previous` if it exists and equals `value`, else copy
+template <typename MatrixType>
+std::shared_ptr<MatrixType const> _share_or_copy(
+    std::shared_ptr<MatrixType const> const &previous,
+    MatrixType const &value) {
+  if (previous && previous->rows() == value.rows() &&
+      previous->cols() == value.cols() && *previous == value) {
+    return previous;
+  }
+  return std::make_shared<MatrixType const>(value);
+}
+
+}  // namespace
+
+/// \brief Copy the occupation
+Eigen::VectorXi ConfigurationSnapshot::occupation() const {
+  Eigen::VectorXi result(n_sites);
+  for (Index b = 0; b < Index(occupation_blocks.size()); ++b) {
+    Eigen::VectorXi const &block = *occupation_blocks[b];
+    result.segment(b * block_size, block.size()) = block;
+  }
+  return result;
+}
+
+/// \brief Copy the full configuration
+Configuration ConfigurationSnapshot::configuration() const {
+  clexulator::ConfigDoFValues dof_values;
+  dof_values.occupation = occupation();
+  for (auto const &pair : local_dof_values) {
+    dof_values.local_dof_values.emplace(pair.first, *pair.second);
+  }
+  for (auto const &pair : global_dof_values) {
+    dof_values.global_dof_values.emplace(pair.first, *pair.second);
+  }
+  return Configuration(supercell, dof_values);
+}
+
+/// \brief Constructor
+///
+/// \param _block_size Number of sites per occupation block
+/// \param _use_modification_tracking If true, only blocks marked by
+///     `mark_modified` since the previous snapshot are copied; otherwise
+///     blocks are compared with the previous snapshot
+ConfigurationSnapshotter::ConfigurationSnapshotter(
+    Index _block_size, bool _use_modification_tracking)
+    : block_size(_block_size),
+      use_modification_tracking(_use_modification_tracking),
+      m_all_modified(true),
+      m_n_blocks_copied(0),
+      m_n_blocks_shared(0) {
+  if (block_size < 1) {
+    throw std::runtime_error(
+        "Error constructing ConfigurationSnapshotter: block_size < 1");
+  }
+}
+
+/// \brief Take a snapshot
+///
+/// The first snapshot, the first after `reset` or `mark_all_modified`, and
+/// any snapshot after the supercell changes, copy all blocks.
+std::shared_ptr<ConfigurationSnapshot const> ConfigurationSnapshotter::take(
+    Configuration const &configuration) {
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  Index n_sites = occupation.size();
+  Index n_blocks = (n_sites + block_size - 1) / block_size;
+  bool is_comparable = m_last && !m_all_modified &&
+                       m_last->supercell == configuration.supercell &&
+                       m_last->n_sites == n_sites;
+
+  auto snapshot = std::make_shared<ConfigurationSnapshot>();
+  snapshot->supercell = configuration.supercell;
+  snapshot->n_sites = n_sites;
+  snapshot->block_size = block_size;
+  snapshot->occupation_blocks.resize(n_blocks);
+  for (Index b = 0; b < n_blocks; ++b) {
+    Index begin = b * block_size;
+    Index size = std::min(block_size, n_sites - begin);
+    auto block = occupation.segment(begin, size);
+    bool is_shared = false;
+    if (is_comparable) {
+      auto const &previous = m_last->occupation_blocks[b];
+      is_shared =
+          use_modification_tracking ? !m_modified[b] : (*previous == block);
+    }
+    if (is_shared) {
+      snapshot->occupation_blocks[b] = m_last->occupation_blocks[b];
+      ++m_n_blocks_shared;
+    } else {
+      snapshot->occupation_blocks[b] =
+          std::make_shared<Eigen::VectorXi const>(block);
+      ++m_n_blocks_copied;
+    }
+  }
+
+  for (auto const &pair : configuration.dof_values.local_dof_values) {
+    std::shared_ptr<Eigen::MatrixXd const> previous;
+    if (is_comparable) {
+      auto it = m_last->local_dof_values.find(pair.first);
+      if (it != m_last->local_dof_values.end()) {
+        previous = it->second;
+      }
+    }
+    snapshot->local_dof_values.emplace(pair.first,
+                                       _share_or_copy(previous, pair.second));
+  }
+  for (auto const &pair : configuration.dof_values.global_dof_values) {
+    std::shared_ptr<Eigen::VectorXd const> previous;
+    if (is_comparable) {
+      auto it = m_last->global_dof_values.find(pair.first);
+      if (it != m_last->global_dof_values.end()) {
+        previous = it->second;
+      }
+    }
+    snapshot->global_dof_values.emplace(pair.first,
+                                        _share_or_copy(previous, pair.second));
+  }
+
+  m_last = snapshot;
+  m_modified.assign(n_blocks, 0);
+  m_all_modified = false;
+  return snapshot;
+}
+
+/// \brief Take a snapshot and keep it
+///
+/// \returns The index of the snapshot in `snapshots()`
+Index ConfigurationSnapshotter::record(Configuration const &configuration) {
+  m_snapshots.push_back(take(configuration));
+  return m_snapshots.size() - 1;
+}
+
+/// \brief Mark a site as modified since the last snapshot
+///
+/// Only used with `use_modification_tracking`.
+void ConfigurationSnapshotter::mark_modified(Index linear_site_index) {
+  Index b = linear_site_index / block_size;
+  if (b < Index(m_modified.size())) {
+    m_modified[b] = 1;
+  }
+}
+
+/// \brief Mark the sites changed by an event as modified since the last
+///     snapshot
+void ConfigurationSnapshotter::mark_modified(monte::OccEvent const &event) {
+  for (Index l : event.linear_site_index) {
+    mark_modified(l);
+  }
+}
+
+/// \brief Mark all sites as modified, so the next snapshot is a full copy
+///
+/// Use this, with `use_modification_tracking`, if the occupation is changed
+/// other than by marked events, for example, when a new run begins.
+void ConfigurationSnapshotter::mark_all_modified() { m_all_modified = true; }
+
+/// \brief Forget the previous snapshot and kept snapshots
+void ConfigurationSnapshotter::reset() {
+  m_last.reset();
+  m_modified.clear();
+  m_all_modified = true;
+  m_snapshots.clear();
+  m_n_blocks_copied = 0;
+  m_n_blocks_shared = 0;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
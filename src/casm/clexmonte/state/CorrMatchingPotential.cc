@@ -1,6 +1,9 @@
 #include "casm/clexmonte/state/CorrMatchingPotential.hh"
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
@@ -92,6 +95,145 @@ double delta_corr_matching_potential(Eigen::VectorXd const &corr,
   return dEpot;
 }
 
+std::vector<unsigned int> make_corr_matching_indices(
+    CorrMatchingParams const &params) {
+  std::vector<unsigned int> indices;
+  for (auto const &target : params.targets) {
+    if (target.index < 0) {
+      throw std::runtime_error(
+          "Error in make_corr_matching_indices: target index out of range");
+    }
+    indices.push_back(target.index);
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  return indices;
+}
+
+CorrMatchingPotentialCalculator::CorrMatchingPotentialCalculator(
+    CorrMatchingParams const &params,
+    std::shared_ptr<clexulator::Correlations> correlations,
+    Index n_unitcells)
+    : m_params(params),
+      m_correlations(correlations),
+      m_n_unitcells(n_unitcells),
+      m_corr(params.targets.size()),
+      m_n_exact(0),
+      m_new_corr(params.targets.size()) {
+  Index corr_size = m_correlations->per_supercell().size();
+  for (auto const &target : m_params.targets) {
+    if (target.index < 0 || target.index >= corr_size) {
+      throw std::runtime_error(
+          "Error constructing CorrMatchingPotentialCalculator: target index "
+          "out of range");
+    }
+  }
+  reset();
+}
+
+void CorrMatchingPotentialCalculator::reset() {
+  Eigen::VectorXd const &per_supercell = m_correlations->per_supercell();
+  for (Index i = 0; i < m_params.targets.size(); ++i) {
+    m_corr(i) = per_supercell(m_params.targets[i].index) / m_n_unitcells;
+  }
+  m_n_exact = _count_n_exact(m_corr);
+}
+
+void CorrMatchingPotentialCalculator::apply(monte::OccEvent const &event) {
+  Eigen::VectorXd const &delta_per_supercell =
+      m_correlations->occ_delta(event.linear_site_index, event.new_occ);
+  for (Index i = 0; i < m_params.targets.size(); ++i) {
+    m_corr(i) += delta_per_supercell(m_params.targets[i].index) / m_n_unitcells;
+  }
+  m_n_exact = _count_n_exact(m_corr);
+}
+
+double CorrMatchingPotentialCalculator::value() const {
+  double Epot = 0;
+  for (Index i = 0; i < m_params.targets.size(); ++i) {
+    auto const &target = m_params.targets[i];
+    Epot += target.weight * std::abs(m_corr(i) - target.value);
+  }
+  Epot -= m_params.exact_matching_weight * m_n_exact;
+  return Epot;
+}
+
+double CorrMatchingPotentialCalculator::occ_delta(
+    std::vector<Index> const &linear_site_index,
+    std::vector<int> const &new_occ) {
+  Eigen::VectorXd const &delta_per_supercell =
+      m_correlations->occ_delta(linear_site_index, new_occ);
+  double dEpot = 0;
+  for (Index i = 0; i < m_params.targets.size(); ++i) {
+    auto const &target = m_params.targets[i];
+    double value = m_corr(i);
+    m_new_corr(i) = value + delta_per_supercell(target.index) / m_n_unitcells;
+    dEpot += target.weight * (std::abs(m_new_corr(i) - target.value) -
+                              std::abs(value - target.value));
+  }
+  dEpot -= m_params.exact_matching_weight *
+           (_count_n_exact(m_new_corr) - m_n_exact);
+  return dEpot;
+}
+
+Index CorrMatchingPotentialCalculator::_count_n_exact(
+    Eigen::VectorXd const &corr) const {
+  Index n_exact = 0;
+  while (n_exact < m_params.targets.size() &&
+         CASM::almost_equal(corr(n_exact), m_params.targets[n_exact].value,
+                            m_params.tol)) {
+    ++n_exact;
+  }
+  return n_exact;
+}
+
+/// \brief Wrap a correlations calculator so that results are cached by
+///     `sublattice_prob`
+///
+/// Random alloy correlations are calculated from `sublattice_prob` by
+/// `RandomAlloyCorrMatchingParams::update_targets`, which is called each time
+/// conditions are constructed, for example for each step of an incremental
+/// conditions scan. The result calls `corr_f` once for each distinct
+/// `sublattice_prob`, and otherwise returns the cached value. Values are
+/// compared exactly, so repeated values generated by the same increments are
+/// found.
+///
+/// Copies of the result share the cache, which is thread-safe.
+///
+/// \param corr_f Correlations calculator
+/// \param max_size Maximum number of cached values. When exceeded, the cache
+///     is cleared.
+CorrCalculatorFunction make_memoized_corr_f(CorrCalculatorFunction corr_f,
+                                            Index max_size) {
+  struct Cache {
+    std::mutex mutex;
+    std::map<std::vector<double>, Eigen::VectorXd> values;
+  };
+  auto cache = std::make_shared<Cache>();
+  return [=](std::vector<Eigen::VectorXd> const &sublattice_prob) {
+    // Key includes the sublattice sizes, so it is unique
+    std::vector<double> key;
+    for (auto const &prob : sublattice_prob) {
+      key.push_back(prob.size());
+      key.insert(key.end(), prob.data(), prob.data() + prob.size());
+    }
+    {
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      auto it = cache->values.find(key);
+      if (it != cache->values.end()) {
+        return it->second;
+      }
+    }
+    Eigen::VectorXd value = corr_f(sublattice_prob);
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (cache->values.size() >= max_size) {
+      cache->values.clear();
+    }
+    cache->values.emplace(key, value);
+    return value;
+  };
+}
+
 RandomAlloyCorrMatchingParams::RandomAlloyCorrMatchingParams(
     CorrCalculatorFunction _random_alloy_corr_f)
     : CorrMatchingParams(),
@@ -0,0 +1,171 @@
+#include "casm/clexmonte/state/OrderParameterPotential.hh"
+
+#include <stdexcept>
+
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/monte/Conversions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+OrderParameterPotential::OrderParameterPotential(
+    std::shared_ptr<clexulator::OrderParameter> order_parameter,
+    xtal::BasicStructure const &prim, monte::Conversions const &convert,
+    Eigen::VectorXi const &occupation,
+    std::optional<Eigen::VectorXd> order_parameter_pot,
+    std::optional<Eigen::VectorXd> target, std::optional<Eigen::MatrixXd> V)
+    : m_order_parameter(order_parameter),
+      m_n_unitcells(convert.l_size() / prim.basis().size()),
+      m_order_parameter_pot(order_parameter_pot),
+      m_target(target),
+      m_V(V),
+      m_tracking(false) {
+  Index dim = m_order_parameter->value().size();
+  if (m_order_parameter_pot.has_value() &&
+      m_order_parameter_pot->size() != dim) {
+    throw std::runtime_error(
+        "Error constructing OrderParameterPotential: order_parameter_pot "
+        "dimensions mismatch");
+  }
+  if (m_target.has_value() != m_V.has_value()) {
+    throw std::runtime_error(
+        "Error constructing OrderParameterPotential: quadratic potential "
+        "requires both target and coefficients");
+  }
+  if (m_V.has_value()) {
+    if (m_target->size() != dim || m_V->rows() != dim || m_V->cols() != dim) {
+      throw std::runtime_error(
+          "Error constructing OrderParameterPotential: quadratic potential "
+          "dimensions mismatch");
+    }
+    m_V_plus_Vt = *m_V + m_V->transpose();
+  }
+  m_d.resize(dim);
+
+  // Contribution of each occupant on each site, from single site changes,
+  // which do not depend on the occupation of other sites
+  Index n_site_occupants = 0;
+  m_site_offset.resize(convert.l_size());
+  for (Index l = 0; l < convert.l_size(); ++l) {
+    m_site_offset[l] = n_site_occupants;
+    n_site_occupants += prim.basis()[convert.l_to_b(l)].occupant_dof().size();
+  }
+  m_contribution = Eigen::MatrixXd::Zero(dim, n_site_occupants);
+  std::vector<Index> linear_site_index(1);
+  std::vector<int> new_occ(1);
+  for (Index l = 0; l < convert.l_size(); ++l) {
+    Index n_occupants = prim.basis()[convert.l_to_b(l)].occupant_dof().size();
+    linear_site_index[0] = l;
+    for (Index occ = 0; occ < n_occupants; ++occ) {
+      if (occ == occupation(l)) {
+        continue;
+      }
+      new_occ[0] = occ;
+      m_contribution.col(m_site_offset[l] + occ) =
+          m_order_parameter->occ_delta(linear_site_index, new_occ);
+    }
+  }
+}
+
+std::optional<OrderParameterPotential> OrderParameterPotential::from_conditions(
+    monte::ValueMap const &conditions,
+    std::shared_ptr<clexulator::OrderParameter> order_parameter,
+    xtal::BasicStructure const &prim, monte::Conversions const &convert,
+    Eigen::VectorXi const &occupation) {
+  auto const &vector_values = conditions.vector_values;
+  auto const &matrix_values = conditions.matrix_values;
+
+  std::optional<Eigen::VectorXd> order_parameter_pot;
+  if (vector_values.count("order_parameter_pot")) {
+    order_parameter_pot = vector_values.at("order_parameter_pot");
+  }
+  std::optional<Eigen::VectorXd> target;
+  std::optional<Eigen::MatrixXd> V;
+  if (vector_values.count("order_parameter_quad_pot_target")) {
+    if (matrix_values.count("order_parameter_quad_pot_matrix")) {
+      V = matrix_values.at("order_parameter_quad_pot_matrix");
+    } else if (vector_values.count("order_parameter_quad_pot_vector")) {
+      V = vector_values.at("order_parameter_quad_pot_vector").asDiagonal();
+    }
+    if (V.has_value()) {
+      target = vector_values.at("order_parameter_quad_pot_target");
+    }
+  }
+  if (!order_parameter_pot.has_value() && !V.has_value()) {
+    return std::nullopt;
+  }
+  return OrderParameterPotential(order_parameter, prim, convert, occupation,
+                                 order_parameter_pot, target, V);
+}
+
+void OrderParameterPotential::reset() {
+  m_value = m_order_parameter->value();
+  m_tracking = true;
+}
+
+void OrderParameterPotential::apply(monte::OccEvent const &event,
+                                    Eigen::VectorXi const &occupation) {
+  if (!m_tracking) {
+    return;
+  }
+  _delta(occupation, event.linear_site_index, event.new_occ);
+  m_value += m_d;
+}
+
+double OrderParameterPotential::per_supercell() {
+  Eigen::VectorXd const &value = _value();
+  double potential = 0.0;
+  if (m_order_parameter_pot.has_value()) {
+    potential += m_order_parameter_pot->dot(value);
+  }
+  if (m_V.has_value()) {
+    m_y = value - *m_target;
+    potential += m_y.dot(*m_V * m_y);
+  }
+  return m_n_unitcells * potential;
+}
+
+double OrderParameterPotential::occ_delta_per_supercell(
+    Eigen::VectorXi const &occupation,
+    std::vector<Index> const &linear_site_index,
+    std::vector<int> const &new_occ) {
+  _delta(occupation, linear_site_index, new_occ);
+  if (m_d.isZero(0.0)) {
+    return 0.0;
+  }
+  double delta = 0.0;
+  if (m_order_parameter_pot.has_value()) {
+    delta += m_order_parameter_pot->dot(m_d);
+  }
+  if (m_V.has_value()) {
+    m_y = _value() - *m_target;
+
+    // (y+d)^T V (y+d) - y^T V y = d^T (V + V^T) y + d^T V d
+    delta += m_d.dot(m_V_plus_Vt * m_y) + m_d.dot(*m_V * m_d);
+  }
+  return m_n_unitcells * delta;
+}
+
+Eigen::VectorXd const &OrderParameterPotential::_value() {
+  if (!m_tracking) {
+    m_value = m_order_parameter->value();
+  }
+  return m_value;
+}
+
+void OrderParameterPotential::_delta(
+    Eigen::VectorXi const &occupation,
+    std::vector<Index> const &linear_site_index,
+    std::vector<int> const &new_occ) {
+  m_d.setZero();
+  for (Index i = 0; i < linear_site_index.size(); ++i) {
+    Index l = linear_site_index[i];
+    if (occupation(l) != new_occ[i]) {
+      m_d += m_contribution.col(m_site_offset[l] + new_occ[i]) -
+             m_contribution.col(m_site_offset[l] + occupation(l));
+    }
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
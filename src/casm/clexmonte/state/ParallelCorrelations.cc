@@ -0,0 +1,93 @@
+#include "casm/clexmonte/state/ParallelCorrelations.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param _supercell_neighbor_list The supercell neighbor list
+/// \param _clexulator The clexulator, which is copied for each thread
+/// \param _dof_values The DoF values to be evaluated, which must outlive
+///     this object
+/// \param _n_threads Number of threads, including the calling thread
+/// \param _block_size Number of unit cells per block
+ParallelCorrelations::ParallelCorrelations(
+    std::shared_ptr<clexulator::SuperNeighborList> _supercell_neighbor_list,
+    clexulator::Clexulator const &_clexulator,
+    clexulator::ConfigDoFValues const *_dof_values, Index _n_threads,
+    Index _block_size)
+    : m_supercell_neighbor_list(_supercell_neighbor_list),
+      m_clexulator(_n_threads, _clexulator),
+      m_dof_values(_dof_values),
+      m_n_unitcells(_supercell_neighbor_list->n_unitcells()),
+      m_block_size(_block_size),
+      m_pool(_n_threads) {
+  if (m_block_size < 1) {
+    throw std::runtime_error(
+        "Error constructing ParallelCorrelations: block_size < 1");
+  }
+  Index corr_size = _clexulator.corr_size();
+  Index n_blocks = (m_n_unitcells + m_block_size - 1) / m_block_size;
+  m_block_sum.resize(corr_size, n_blocks);
+  m_contribution.resize(corr_size, _n_threads);
+}
+
+/// \brief Correlations, normalized per supercell
+Eigen::VectorXd const &ParallelCorrelations::per_supercell() {
+  if (m_dof_values == nullptr) {
+    throw std::runtime_error(
+        "Error in ParallelCorrelations::per_supercell: DoF values not set");
+  }
+  Index n_blocks = m_block_sum.cols();
+  Index n_threads = m_pool.n_threads();
+  m_pool.run([&](Index thread_index) {
+    auto &clexulator = m_clexulator[thread_index];
+    double *contribution = m_contribution.col(thread_index).data();
+    Index block_begin = (n_blocks * thread_index) / n_threads;
+    Index block_end = (n_blocks * (thread_index + 1)) / n_threads;
+    for (Index b = block_begin; b < block_end; ++b) {
+      auto block_sum = m_block_sum.col(b);
+      block_sum.setZero();
+      Index end = std::min(m_n_unitcells, (b + 1) * m_block_size);
+      for (Index i = b * m_block_size; i < end; ++i) {
+        clexulator.calc_global_corr_contribution(
+            *m_dof_values, m_supercell_neighbor_list->sites(i).data(),
+            contribution);
+        block_sum += m_contribution.col(thread_index);
+      }
+    }
+  });
+
+  // Add block sums in block order, independent of the number of threads
+  m_per_supercell.setZero(m_block_sum.rows());
+  for (Index b = 0; b < n_blocks; ++b) {
+    m_per_supercell += m_block_sum.col(b);
+  }
+  return m_per_supercell;
+}
+
+/// \brief Correlations, normalized per unit cell
+Eigen::VectorXd const &ParallelCorrelations::per_unitcell() {
+  m_per_unitcell = this->per_supercell() / double(m_n_unitcells);
+  return m_per_unitcell;
+}
+
+/// \brief Cluster expansion value, normalized per supercell
+///
+/// \param coefficients Cluster expansion coefficients, with indices into
+///     the correlations of this object's clexulator
+double ParallelCorrelations::per_supercell(
+    clexulator::SparseCoefficients const &coefficients) {
+  Eigen::VectorXd const &corr = this->per_supercell();
+  double value = 0.0;
+  for (Index k = 0; k < coefficients.index.size(); ++k) {
+    value += coefficients.value[k] * corr(coefficients.index[k]);
+  }
+  return value;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,82 @@
+#include "casm/clexmonte/state/io/json/EnsembleClusterExpansion_json_io.hh"
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/state/EnsembleClusterExpansion.hh"
+#include "casm/clexmonte/system/System.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Parse the optional "ensemble_formation_energy" calculation
+///     parameter
+///
+/// Expected format:
+/// \code
+///   "ensemble_formation_energy": {
+///     "multiclex": str,
+///         Name of a multi-cluster expansion in the system, whose coefficient
+///         sets are an ensemble of fits of the formation energy.
+///     "member": "mean", str, or int, default="mean"
+///         Which coefficient set the potential uses: "mean" for the mean
+///         of all sets, the name of a coefficient set, or its index.
+///   }
+/// \endcode
+///
+/// \param parser Parser of the calculation parameters
+/// \param system The system, which contains the multi-cluster expansion
+/// \param ensemble_params Set to the parsed parameters, or std::nullopt if
+///     "ensemble_formation_energy" is not present
+void parse_ensemble_formation_energy(
+    ParentInputParser &parser, System const &system,
+    std::optional<EnsembleClusterExpansionParams> &ensemble_params) {
+  ensemble_params.reset();
+  if (!parser.self.contains("ensemble_formation_energy")) {
+    return;
+  }
+  fs::path option = "ensemble_formation_energy";
+  EnsembleClusterExpansionParams params;
+  parser.require(params.multiclex_key, option / "multiclex");
+  if (!parser.valid()) {
+    return;
+  }
+  auto it = system.multiclex_data.find(params.multiclex_key);
+  if (it == system.multiclex_data.end()) {
+    parser.insert_error(option / "multiclex",
+                        "Error: \"" + params.multiclex_key +
+                            "\" is not found in the system multiclex");
+    return;
+  }
+  MultiClexData const &data = it->second;
+
+  params.member = -1;
+  jsonParser const &json = parser.self["ensemble_formation_energy"];
+  if (json.contains("member")) {
+    jsonParser const &tjson = json["member"];
+    if (tjson.is_int()) {
+      params.member = tjson.get<Index>();
+      if (params.member < 0 || params.member >= data.coefficients.size()) {
+        parser.insert_error(option / "member",
+                            "Error: coefficient set index out of range");
+        return;
+      }
+    } else if (tjson.is_string() && tjson.get<std::string>() != "mean") {
+      auto glossary_it =
+          data.coefficients_glossary.find(tjson.get<std::string>());
+      if (glossary_it == data.coefficients_glossary.end()) {
+        parser.insert_error(option / "member",
+                            "Error: coefficient set name not found");
+        return;
+      }
+      params.member = glossary_it->second;
+    } else if (!tjson.is_string()) {
+      parser.insert_error(option / "member",
+                          "Error: must be \"mean\", a coefficient set name, "
+                          "or a coefficient set index");
+      return;
+    }
+  }
+  ensemble_params = params;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,386 @@
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/state/CompactOccupation.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+char const *base64_chars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string base64_encode(std::vector<unsigned char> const &bytes) {
+  std::string text;
+  text.reserve(4 * ((bytes.size() + 2) / 3));
+  for (std::size_t i = 0; i < bytes.size(); i += 3) {
+    std::uint32_t n = std::uint32_t(bytes[i]) << 16;
+    if (i + 1 < bytes.size()) {
+      n |= std::uint32_t(bytes[i + 1]) << 8;
+    }
+    if (i + 2 < bytes.size()) {
+      n |= std::uint32_t(bytes[i + 2]);
+    }
+    text.push_back(base64_chars[(n >> 18) & 63]);
+    text.push_back(base64_chars[(n >> 12) & 63]);
+    text.push_back(i + 1 < bytes.size() ? base64_chars[(n >> 6) & 63] : '=');
+    text.push_back(i + 2 < bytes.size() ? base64_chars[n & 63] : '=');
+  }
+  return text;
+}
+
+std::vector<unsigned char> base64_decode(std::string const &text) {
+  int value[256];
+  for (int i = 0; i < 256; ++i) {
+    value[i] = -1;
+  }
+  for (int i = 0; i < 64; ++i) {
+    value[static_cast<unsigned char>(base64_chars[i])] = i;
+  }
+  std::vector<unsigned char> bytes;
+  bytes.reserve(3 * (text.size() / 4));
+  std::uint32_t n = 0;
+  int n_bits = 0;
+  for (char c : text) {
+    if (c == '=') {
+      break;
+    }
+    int v = value[static_cast<unsigned char>(c)];
+    if (v < 0) {
+      throw std::runtime_error(
+          "Error in unpack_occupation: invalid base64 character");
+    }
+    n = (n << 6) | v;
+    n_bits += 6;
+    if (n_bits >= 8) {
+      n_bits -= 8;
+      bytes.push_back((n >> n_bits) & 0xFF);
+    }
+  }
+  return bytes;
+}
+
+/// Compress with zlib, then base64 encode
+std::string compress_and_encode(std::uint8_t const *packed,
+                                std::size_t packed_size) {
+  uLongf compressed_size = compressBound(packed_size);
+  std::vector<unsigned char> compressed(compressed_size);
+  if (compress2(compressed.data(), &compressed_size, packed, packed_size,
+                Z_DEFAULT_COMPRESSION) != Z_OK) {
+    throw std::runtime_error("Error in pack_occupation: zlib compress failed");
+  }
+  compressed.resize(compressed_size);
+  return base64_encode(compressed);
+}
+
+/// Base64 decode, then uncompress with zlib into `packed`, which must have
+/// the expected uncompressed size
+void decode_and_uncompress(std::string const &data,
+                           std::vector<std::uint8_t> &packed) {
+  std::vector<unsigned char> compressed = base64_decode(data);
+  uLongf packed_size = packed.size();
+  if (packed_size &&
+      (uncompress(packed.data(), &packed_size, compressed.data(),
+                  compressed.size()) != Z_OK ||
+       packed_size != packed.size())) {
+    throw std::runtime_error(
+        "Error in unpack_occupation: zlib uncompress failed");
+  }
+}
+
+/// Bit-pack occupation indices, least significant bits first
+std::vector<unsigned char> bitpack(Eigen::VectorXi const &occupation,
+                                   int bits_per_value) {
+  std::vector<unsigned char> packed((occupation.size() * bits_per_value + 7) /
+                                    8);
+  std::size_t bit = 0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    for (int b = 0; b < bits_per_value; ++b, ++bit) {
+      if ((occupation(l) >> b) & 1) {
+        packed[bit / 8] |= (1 << (bit % 8));
+      }
+    }
+  }
+  return packed;
+}
+
+/// Inverse of `bitpack`
+Eigen::VectorXi bitunpack(std::vector<std::uint8_t> const &packed,
+                          Index size, int bits_per_value) {
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(size);
+  std::size_t bit = 0;
+  for (Index l = 0; l < size; ++l) {
+    for (int b = 0; b < bits_per_value; ++b, ++bit) {
+      if ((packed[bit / 8] >> (bit % 8)) & 1) {
+        occupation(l) |= (1 << b);
+      }
+    }
+  }
+  return occupation;
+}
+
+/// Magic bytes at the start of an occupation file
+char const occupation_file_magic[8] = {'C', 'A', 'S', 'M', 'O', 'C', 'C', '1'};
+
+}  // namespace
+
+/// \brief Encode occupation indices compactly, as text
+///
+/// Occupation indices are bit-packed, using the fewest bits per value that
+/// can hold the maximum index, then compressed with zlib and base64 encoded.
+///
+/// \param occupation Occupation indices, which must be >= 0
+/// \param bits_per_value Set to the number of bits used per value
+///
+/// \returns The encoded occupation
+std::string pack_occupation(Eigen::VectorXi const &occupation,
+                            int &bits_per_value) {
+  int max_occ = 0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    if (occupation(l) < 0) {
+      throw std::runtime_error(
+          "Error in pack_occupation: occupation indices must be >= 0");
+    }
+    max_occ = std::max(max_occ, occupation(l));
+  }
+  bits_per_value = 1;
+  while ((max_occ >> bits_per_value) != 0) {
+    ++bits_per_value;
+  }
+
+  std::vector<unsigned char> packed = bitpack(occupation, bits_per_value);
+  return compress_and_encode(packed.data(), packed.size());
+}
+
+/// \brief Encode a compact occupation as text
+///
+/// The packed bytes of `occupation` are compressed with zlib and base64
+/// encoded, without expanding the occupation, giving the same encoding as
+/// `pack_occupation` for `occupation.bits_per_value()` bits per value.
+///
+/// \param occupation Compact occupation
+///
+/// \returns The encoded occupation
+std::string pack_occupation(CompactOccupation const &occupation) {
+  return compress_and_encode(occupation.data().data(),
+                             occupation.data().size());
+}
+
+/// \brief Decode occupation indices encoded by `pack_occupation`
+///
+/// \param data The encoded occupation
+/// \param size The number of occupation indices
+/// \param bits_per_value The number of bits used per value
+///
+/// \returns The occupation indices
+Eigen::VectorXi unpack_occupation(std::string const &data, Index size,
+                                  int bits_per_value) {
+  if (size < 0 || bits_per_value < 1 || bits_per_value > 30) {
+    throw std::runtime_error(
+        "Error in unpack_occupation: invalid size or bits_per_value");
+  }
+  std::vector<std::uint8_t> packed((size * bits_per_value + 7) / 8);
+  decode_and_uncompress(data, packed);
+  return bitunpack(packed, size, bits_per_value);
+}
+
+/// \brief Decode occupation indices encoded by `pack_occupation`, as a
+///     compact occupation
+///
+/// If `bits_per_value` is 1, 2, 4, or 8, the packed bytes are used directly.
+/// Otherwise, the occupation is expanded and then compacted.
+///
+/// \param data The encoded occupation
+/// \param size The number of occupation indices
+/// \param bits_per_value The number of bits used per value
+///
+/// \returns The compact occupation
+CompactOccupation unpack_compact_occupation(std::string const &data,
+                                            Index size, int bits_per_value) {
+  if (bits_per_value != 1 && bits_per_value != 2 && bits_per_value != 4 &&
+      bits_per_value != 8) {
+    return make_compact_occupation(
+        unpack_occupation(data, size, bits_per_value));
+  }
+  if (size < 0) {
+    throw std::runtime_error("Error in unpack_occupation: invalid size");
+  }
+  CompactOccupation occupation(size, bits_per_value);
+  decode_and_uncompress(data, occupation.data());
+  return occupation;
+}
+
+/// \brief Write occupation indices to a binary file
+///
+/// The file holds the 8 bytes "CASMOCC1", the number of values as a
+/// little-endian 64-bit unsigned integer, the number of bits per value as one
+/// byte, and then the occupation indices bit-packed as by `pack_occupation`,
+/// but not compressed, so that reading is limited only by the file size.
+///
+/// \param path The file to write
+/// \param occupation Occupation indices, which must be >= 0
+void write_occupation_file(std::string const &path,
+                           Eigen::VectorXi const &occupation) {
+  int max_occ = 0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    if (occupation(l) < 0) {
+      throw std::runtime_error(
+          "Error in write_occupation_file: occupation indices must be >= 0");
+    }
+    max_occ = std::max(max_occ, occupation(l));
+  }
+  int bits_per_value = 1;
+  while ((max_occ >> bits_per_value) != 0) {
+    ++bits_per_value;
+  }
+  std::vector<unsigned char> packed = bitpack(occupation, bits_per_value);
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Error in write_occupation_file: cannot open '" +
+                             path + "'");
+  }
+  unsigned char header[9];
+  std::uint64_t size = occupation.size();
+  for (int i = 0; i < 8; ++i) {
+    header[i] = (size >> (8 * i)) & 0xFF;
+  }
+  header[8] = bits_per_value;
+  file.write(occupation_file_magic, 8);
+  file.write(reinterpret_cast<char const *>(header), 9);
+  file.write(reinterpret_cast<char const *>(packed.data()), packed.size());
+  if (!file) {
+    throw std::runtime_error("Error in write_occupation_file: cannot write '" +
+                             path + "'");
+  }
+}
+
+/// \brief Read occupation indices from a binary file
+///
+/// \param path A file written by `write_occupation_file`
+///
+/// \returns The occupation indices
+Eigen::VectorXi read_occupation_file(std::string const &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Error in read_occupation_file: cannot open '" +
+                             path + "'");
+  }
+  char magic[8];
+  unsigned char header[9];
+  file.read(magic, 8);
+  file.read(reinterpret_cast<char *>(header), 9);
+  if (!file || !std::equal(magic, magic + 8, occupation_file_magic)) {
+    throw std::runtime_error("Error in read_occupation_file: '" + path +
+                             "' is not an occupation file");
+  }
+  std::uint64_t size = 0;
+  for (int i = 0; i < 8; ++i) {
+    size |= std::uint64_t(header[i]) << (8 * i);
+  }
+  int bits_per_value = header[8];
+  if (bits_per_value < 1 || bits_per_value > 30) {
+    throw std::runtime_error(
+        "Error in read_occupation_file: invalid bits_per_value");
+  }
+  std::vector<std::uint8_t> packed((size * bits_per_value + 7) / 8);
+  file.read(reinterpret_cast<char *>(packed.data()), packed.size());
+  if (file.gcount() != std::streamsize(packed.size())) {
+    throw std::runtime_error("Error in read_occupation_file: '" + path +
+                             "' is truncated");
+  }
+  return bitunpack(packed, size, bits_per_value);
+}
+
+/// \brief Read occupation indices given in JSON as a packed occupation or
+///     an occupation file, without an element-by-element array
+///
+/// \param json Either a packed occupation object, as written by
+///     `pack_occupation_json` for "occ_packed", or a string, the path to a
+///     file written by `write_occupation_file`
+///
+/// \returns The occupation indices
+Eigen::VectorXi read_occupation_json(jsonParser const &json) {
+  if (json.is_string()) {
+    return read_occupation_file(json.get<std::string>());
+  }
+  std::string encoding;
+  from_json(encoding, json["encoding"]);
+  if (encoding != "bitpacked_zlib_base64") {
+    std::stringstream msg;
+    msg << "Error in read_occupation_json: unknown encoding '" << encoding
+        << "'";
+    throw std::runtime_error(msg.str());
+  }
+  Index size;
+  int bits_per_value;
+  std::string data;
+  from_json(size, json["size"]);
+  from_json(bits_per_value, json["bits_per_value"]);
+  from_json(data, json["data"]);
+  return unpack_occupation(data, size, bits_per_value);
+}
+
+/// \brief Replace the occupation of a state or configuration, in JSON, with
+///     its packed encoding
+///
+/// The "occ" array of `json["dof"]` (for a configuration) or
+/// `json["configuration"]["dof"]` (for a state) is replaced by
+/// "occ_packed", a JSON object with attributes "encoding"
+/// ("bitpacked_zlib_base64"), "size", "bits_per_value", and "data" (see
+/// `pack_occupation`). If there is no "occ" array, `json` is not changed.
+void pack_occupation_json(jsonParser &json) {
+  jsonParser *config_json = json.contains("configuration")
+                                ? &json["configuration"]
+                                : &json;
+  if (!config_json->contains("dof") || !(*config_json)["dof"].contains("occ")) {
+    return;
+  }
+  jsonParser &dof_json = (*config_json)["dof"];
+  std::vector<int> occ;
+  from_json(occ, dof_json["occ"]);
+  Eigen::VectorXi occupation =
+      Eigen::Map<Eigen::VectorXi>(occ.data(), occ.size());
+  int bits_per_value;
+  std::string data = pack_occupation(occupation, bits_per_value);
+  dof_json.erase("occ");
+  jsonParser &packed_json = dof_json["occ_packed"];
+  packed_json["encoding"] = "bitpacked_zlib_base64";
+  packed_json["size"] = occupation.size();
+  packed_json["bits_per_value"] = bits_per_value;
+  packed_json["data"] = data;
+}
+
+/// \brief Replace a packed occupation, in the JSON for a state or
+///     configuration, with the standard occupation array
+///
+/// \returns True if a packed occupation was found and replaced
+bool unpack_occupation_json(jsonParser &json) {
+  jsonParser *config_json = json.contains("configuration")
+                                ? &json["configuration"]
+                                : &json;
+  if (!config_json->contains("dof") ||
+      !(*config_json)["dof"].contains("occ_packed")) {
+    return false;
+  }
+  jsonParser &dof_json = (*config_json)["dof"];
+  Eigen::VectorXi occupation = read_occupation_json(dof_json["occ_packed"]);
+  dof_json.erase("occ_packed");
+  dof_json["occ"] = std::vector<int>(occupation.data(),
+                                     occupation.data() + occupation.size());
+  return true;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,171 @@
+#include "casm/clexmonte/system/ClexulatorCache.hh"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/misc/ContentHash.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+bool is_compiled_file(fs::path const &path) {
+  std::string ext = path.extension().string();
+  return ext == ".o" || ext == ".so" || ext == ".dylib";
+}
+
+/// Source directory files, except compiled files, sorted by relative path
+std::vector<fs::path> source_files(fs::path const &source_dir) {
+  std::vector<fs::path> files;
+  for (auto const &entry : fs::recursive_directory_iterator(source_dir)) {
+    if (entry.is_regular_file() && !is_compiled_file(entry.path())) {
+      files.push_back(fs::relative(entry.path(), source_dir));
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+std::string read_file(fs::path const &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+FileLock::FileLock(fs::path _path) : m_path(_path), m_fd(-1) {
+  m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (m_fd < 0 || ::flock(m_fd, LOCK_EX) != 0) {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+    std::stringstream msg;
+    msg << "Error in FileLock: failed to lock " << m_path;
+    throw std::runtime_error(msg.str());
+  }
+}
+
+FileLock::~FileLock() {
+  ::flock(m_fd, LOCK_UN);
+  ::close(m_fd);
+}
+
+/// \brief Lock, and populate if necessary, the cache entry for a source
+///     directory
+///
+/// The entry key is a hash of `key_data`, the compiler environment
+/// variables (CASM_CXX, CASM_CXXFLAGS, CASM_SOFLAGS, CASM_PREFIX,
+/// CASM_INCLUDEDIR, CASM_LIBDIR), and the contents of the source directory
+/// (except compiled files). The entry is:
+///
+///     <cache_dir>/
+///       <key>/
+///         <copy of the source directory, and any compiled files>
+///       <key>.lock
+///
+/// \param cache_dir Cache directory, which is created if it does not exist
+/// \param source_dir Source directory, which is copied into the cache entry
+/// \param key_data Additional data distinguishing entries with the same
+///     source, such as compile options
+///
+/// \returns The cache entry, which is locked until `lock` is destroyed.
+SourceDirCacheEntry acquire_source_dir_cache_entry(
+    fs::path const &cache_dir, fs::path const &source_dir,
+    std::vector<std::string> const &key_data) {
+  std::vector<fs::path> files = source_files(source_dir);
+
+  ContentHash hash;
+  for (std::string const &data : key_data) {
+    hash.update(data);
+  }
+  for (std::string var : {"CASM_CXX", "CASM_CXXFLAGS", "CASM_SOFLAGS",
+                          "CASM_PREFIX", "CASM_INCLUDEDIR", "CASM_LIBDIR"}) {
+    char const *value = std::getenv(var.c_str());
+    hash.update(var + "=" + (value ? value : ""));
+  }
+  for (fs::path const &file : files) {
+    hash.update(file.string());
+    hash.update(read_file(source_dir / file));
+  }
+  std::string key = hash.hex();
+
+  fs::create_directories(cache_dir);
+  SourceDirCacheEntry entry;
+  entry.lock = std::make_unique<FileLock>(cache_dir / (key + ".lock"));
+
+  entry.dir = cache_dir / key;
+  fs::path populated_marker = entry.dir / ".populated";
+  if (!fs::exists(populated_marker)) {
+    // Remove any partial entry left by an interrupted job
+    fs::remove_all(entry.dir);
+    for (fs::path const &file : files) {
+      fs::create_directories((entry.dir / file).parent_path());
+      fs::copy_file(source_dir / file, entry.dir / file);
+    }
+    std::ofstream(populated_marker) << key << std::endl;
+  }
+  return entry;
+}
+
+ClexulatorCache::ClexulatorCache(fs::path _cache_dir)
+    : cache_dir(_cache_dir) {}
+
+/// \brief Lock, and populate if necessary, the cache entry for a
+///     clexulator source file
+///
+/// \param source Path to a clexulator source file. The directory containing
+///     it is copied into the cache entry.
+/// \param basis_set_input The basis set JSON input, as a string, which is
+///     included in the cache key
+///
+/// \returns The cache entry, which is locked until `Entry::lock` is
+///     destroyed. The returned source path should be used in place of
+///     `source` to compile and load the clexulator while the lock is held.
+ClexulatorCache::Entry ClexulatorCache::acquire(
+    fs::path source, std::string const &basis_set_input) const {
+  fs::path source_dir = source.parent_path();
+  if (source_dir.empty()) {
+    source_dir = ".";
+  }
+  SourceDirCacheEntry dir_entry = acquire_source_dir_cache_entry(
+      cache_dir, source_dir, {basis_set_input, source.filename().string()});
+  Entry entry;
+  entry.source = dir_entry.dir / source.filename();
+  entry.lock = std::move(dir_entry.lock);
+  return entry;
+}
+
+/// \brief Return the clexulator cache directory, from the JSON input or the
+///     CASM_CLEXULATOR_CACHE_DIR environment variable, if set
+///
+/// \param cache_dir_input Optional cache directory given by the JSON input,
+///     which takes precedence over the environment variable
+///
+/// \returns The cache directory, or std::nullopt if the cache is not
+///     enabled
+std::optional<fs::path> default_clexulator_cache_dir(
+    std::optional<std::string> cache_dir_input) {
+  if (cache_dir_input.has_value()) {
+    return fs::path(*cache_dir_input);
+  }
+  char const *value = std::getenv("CASM_CLEXULATOR_CACHE_DIR");
+  if (value != nullptr && std::string(value).size()) {
+    return fs::path(value);
+  }
+  return std::nullopt;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,5 +1,7 @@
 #include "casm/clexmonte/system/System.hh"
 
+#include <algorithm>
+
 #include "casm/clexmonte/state/Conditions.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
@@ -8,24 +10,54 @@
 namespace CASM {
 namespace clexmonte {
 
+template <typename MapType>
+typename MapType::mapped_type &_verify(MapType &m, std::string const &key,
+                                       std::string const &name) {
+  auto it = m.find(key);
+  if (it == m.end()) {
+    std::stringstream msg;
+    msg << "System error: '" << name << "' does not contain required '" << key
+        << "'." << std::endl;
+    throw std::runtime_error(msg.str());
+  }
+  return it->second;
+}
+
+template <typename MapType>
+typename MapType::mapped_type const &_verify(MapType const &m,
+                                             std::string const &key,
+                                             std::string const &name) {
+  auto it = m.find(key);
+  if (it == m.end()) {
+    std::stringstream msg;
+    msg << "System error: '" << name << "' does not contain required '" << key
+        << "'." << std::endl;
+    throw std::runtime_error(msg.str());
+  }
+  return it->second;
+}
+
 namespace {
 
-std::map<std::string, std::shared_ptr<clexulator::OrderParameter>>
-make_order_parameters(
-    std::map<std::string, std::shared_ptr<clexulator::DoFSpace const>> const
-        &dof_spaces,
-    Eigen::Matrix3l const &transformation_matrix_to_super,
-    xtal::UnitCellCoordIndexConverter const &supercell_index_converter) {
-  std::map<std::string, std::shared_ptr<clexulator::OrderParameter>>
-      order_parameters;
-  for (auto const &pair : dof_spaces) {
-    auto res = order_parameters.emplace(
-        pair.first, std::make_shared<clexulator::OrderParameter>(*pair.second));
-    clexulator::OrderParameter &order_parameter = *res.first->second;
-    order_parameter.update(transformation_matrix_to_super,
-                           supercell_index_converter);
+/// \brief Find `key` in `m`, or construct and insert the value with
+///     `make_f()`. Requires that the map's mutex is locked.
+template <typename MapType, typename MakeF>
+typename MapType::mapped_type const &_get_or_make(
+    MapType &m, typename MapType::key_type const &key, MakeF make_f) {
+  auto it = m.find(key);
+  if (it == m.end()) {
+    it = m.emplace(key, make_f()).first;
   }
-  return order_parameters;
+  return it->second;
+}
+
+/// \brief Construct the Prim, including its symmetry, timed as startup
+///     phase "prim_symmetry"
+std::shared_ptr<config::Prim const> _make_prim(
+    PhaseTimings &timings,
+    std::shared_ptr<xtal::BasicStructure const> const &shared_prim) {
+  PhaseTimer timer(timings, "prim_symmetry");
+  return std::make_shared<config::Prim const>(shared_prim);
 }
 
 }  // namespace
@@ -41,17 +73,20 @@ make_order_parameters(
 System::System(std::shared_ptr<xtal::BasicStructure const> const &_shared_prim,
                composition::CompositionConverter const &_composition_converter,
                Index _n_dimensions)
-    : prim(std::make_shared<config::Prim const>(_shared_prim)),
+    : prim(_make_prim(startup_timings, _shared_prim)),
       n_dimensions(_n_dimensions),
       composition_converter(_composition_converter),
       composition_calculator(composition_converter.components(),
                              xtal::allowed_molecule_names(*_shared_prim)),
       convert(*prim->basicstructure, Eigen::Matrix3l::Identity()),
-      occevent_symgroup_rep(occ_events::make_occevent_symgroup_rep(
-          prim->sym_info.unitcellcoord_symgroup_rep,
-          prim->sym_info.occ_symgroup_rep,
-          prim->sym_info.atom_position_symgroup_rep)),
       supercells(std::make_shared<config::SupercellSet>(prim)) {
+  PhaseTimer timer(startup_timings, "occevent_symgroup_rep");
+  occevent_symgroup_rep = occ_events::make_occevent_symgroup_rep(
+      prim->sym_info.unitcellcoord_symgroup_rep,
+      prim->sym_info.occ_symgroup_rep,
+      prim->sym_info.atom_position_symgroup_rep);
+  timer.stop();
+
   monte::OccCandidateList occ_candidate_list(convert);
   canonical_swaps = monte::make_canonical_swaps(convert, occ_candidate_list);
   semigrand_canonical_swaps =
@@ -59,120 +94,430 @@ System::System(std::shared_ptr<xtal::BasicStructure const> const &_shared_prim,
 }
 
 /// \brief Constructor
+///
+/// Only the index conversions and occupation candidate list are constructed
+/// here. The neighbor list, correlations, cluster expansions, and order
+/// parameters are constructed on first access.
 SupercellSystemData::SupercellSystemData(
     System const &system, Eigen::Matrix3l const &transformation_matrix_to_super)
-    : convert(*system.prim->basicstructure, transformation_matrix_to_super),
+    : n_unitcells(transformation_matrix_to_super.determinant()),
+      convert(*system.prim->basicstructure, transformation_matrix_to_super),
       occ_candidate_list(convert),
-      order_parameters(make_order_parameters(
-          system.dof_spaces, convert.transformation_matrix_to_super(),
-          convert.index_converter())) {
-  // make supercell_neighbor_list
-  if (system.prim_neighbor_list != nullptr) {
-    supercell_neighbor_list = std::make_shared<clexulator::SuperNeighborList>(
-        transformation_matrix_to_super, *system.prim_neighbor_list);
+      m_system(system) {}
+
+/// \brief SuperNeighborList, used for evaluating correlations in a
+///     particular supercell, or nullptr if the system has no prim neighbor
+///     list
+std::shared_ptr<clexulator::SuperNeighborList> const &
+SupercellSystemData::supercell_neighbor_list() {
+  std::call_once(m_supercell_neighbor_list_flag, [&]() {
+    if (m_system.prim_neighbor_list != nullptr) {
+      PhaseTimer timer(m_system.startup_timings, "supercell_neighbor_list");
+      m_supercell_neighbor_list =
+          std::make_shared<clexulator::SuperNeighborList>(
+              convert.transformation_matrix_to_super(),
+              *m_system.prim_neighbor_list);
+      m_has_supercell_neighbor_list.store(true, std::memory_order_release);
+    }
+  });
+  return m_supercell_neighbor_list;
+}
+
+/// \brief Estimated size, in bytes, of the index conversions and, if it has
+///     been constructed, the supercell neighbor list
+///
+/// Notes:
+/// - The index conversions are counted as a fixed number of Index values per
+///   site (site index, sublattice index, unit cell index and coordinates,
+///   and asymmetric unit index)
+/// - The supercell neighbor list is counted as the site and unit cell
+///   neighbor indices of each unit cell
+/// - The correlations, cluster expansions, and order parameters, which are
+///   small compared to the neighbor list, are not counted
+Index SupercellSystemData::size_in_bytes() const {
+  Index n_index_per_site = 7;
+  Index total = convert.l_size() * n_index_per_site * sizeof(Index);
+  if (m_has_supercell_neighbor_list.load(std::memory_order_acquire)) {
+    auto const &neighbor_list = *m_supercell_neighbor_list;
+    Index n_neighbors_per_unitcell =
+        neighbor_list.sites(0).size() + neighbor_list.unitcells(0).size();
+    total += n_unitcells * n_neighbors_per_unitcell * sizeof(Index);
   }
+  return total;
+}
 
-  // make corr
-  for (auto const &pair : system.basis_sets) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct corr with "
-          "empty neighbor list");
-    }
-    auto const &key = pair.first;
-    auto const &_clexulator = pair.second;
-    auto _corr = std::make_shared<clexulator::Correlations>(
-        supercell_neighbor_list, _clexulator);
-    corr.emplace(key, _corr);
+namespace {
+
+void _require_neighbor_list(
+    std::shared_ptr<clexulator::SuperNeighborList> const &neighbor_list,
+    std::string const &name) {
+  if (neighbor_list == nullptr) {
+    std::stringstream msg;
+    msg << "Error in SupercellSystemData: Cannot construct " << name
+        << " with empty neighbor list";
+    throw std::runtime_error(msg.str());
   }
+}
 
-  // make local_corr
-  for (auto const &pair : system.local_basis_sets) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct local_corr "
-          "with empty neighbor list");
-    }
-    auto const &key = pair.first;
-    auto const &_clexulator = pair.second;
-    auto _corr = std::make_shared<clexulator::LocalCorrelations>(
-        supercell_neighbor_list, _clexulator);
-    local_corr.emplace(key, _corr);
+}  // namespace
+
+/// \brief Order parameter calculator, constructing as necessary
+std::shared_ptr<clexulator::OrderParameter>
+SupercellSystemData::order_parameter(std::string const &key) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_order_parameters, key, [&]() {
+    auto definition = _verify(m_system.dof_spaces, key, "order_parameters");
+    auto _order_parameter =
+        std::make_shared<clexulator::OrderParameter>(*definition);
+    _order_parameter->update(convert.transformation_matrix_to_super(),
+                             convert.index_converter());
+    return _order_parameter;
+  });
+}
+
+/// \brief Correlations calculator, constructing as necessary
+std::shared_ptr<clexulator::Correlations> SupercellSystemData::corr(
+    std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_corr, key, [&]() {
+    auto _clexulator = _verify(m_system.basis_sets, key, "corr");
+    _require_neighbor_list(neighbor_list, "corr");
+    return std::make_shared<clexulator::Correlations>(neighbor_list,
+                                                      _clexulator);
+  });
+}
+
+/// \brief Local correlations calculator, constructing as necessary
+std::shared_ptr<clexulator::LocalCorrelations> SupercellSystemData::local_corr(
+    std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_local_corr, key, [&]() {
+    auto _clexulator = _verify(m_system.local_basis_sets, key, "local_corr");
+    _require_neighbor_list(neighbor_list, "local_corr");
+    return std::make_shared<clexulator::LocalCorrelations>(neighbor_list,
+                                                           _clexulator);
+  });
+}
+
+/// \brief Cluster expansion calculator, constructing as necessary
+std::shared_ptr<clexulator::ClusterExpansion> SupercellSystemData::clex(
+    std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_clex, key, [&]() {
+    auto const &data = _verify(m_system.clex_data, key, "clex");
+    _require_neighbor_list(neighbor_list, "clex");
+    auto _clexulator = get_basis_set(m_system, data.basis_set_name);
+    return std::make_shared<clexulator::ClusterExpansion>(
+        neighbor_list, _clexulator, data.coefficients);
+  });
+}
+
+/// \brief Multi-cluster expansion calculator, constructing as necessary
+std::shared_ptr<clexulator::MultiClusterExpansion>
+SupercellSystemData::multiclex(std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_multiclex, key, [&]() {
+    auto const &data = _verify(m_system.multiclex_data, key, "multiclex");
+    _require_neighbor_list(neighbor_list, "multiclex");
+    auto _clexulator = get_basis_set(m_system, data.basis_set_name);
+    return std::make_shared<clexulator::MultiClusterExpansion>(
+        neighbor_list, _clexulator, data.coefficients);
+  });
+}
+
+/// \brief Local cluster expansion calculator, constructing as necessary
+std::shared_ptr<clexulator::LocalClusterExpansion>
+SupercellSystemData::local_clex(std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_local_clex, key, [&]() {
+    auto const &data = _verify(m_system.local_clex_data, key, "local_clex");
+    _require_neighbor_list(neighbor_list, "local_clex");
+    auto _local_clexulator =
+        get_local_basis_set(m_system, data.local_basis_set_name);
+    return std::make_shared<clexulator::LocalClusterExpansion>(
+        neighbor_list, _local_clexulator, data.coefficients);
+  });
+}
+
+/// \brief Local multi-cluster expansion calculator, constructing as
+///     necessary
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+SupercellSystemData::local_multiclex(std::string const &key) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(m_local_multiclex, key, [&]() {
+    auto const &data =
+        _verify(m_system.local_multiclex_data, key, "local_multiclex");
+    _require_neighbor_list(neighbor_list, "local_multiclex");
+    auto _local_clexulator =
+        get_local_basis_set(m_system, data.local_basis_set_name);
+    return std::make_shared<clexulator::MultiLocalClusterExpansion>(
+        neighbor_list, _local_clexulator, data.coefficients);
+  });
+}
+
+/// \brief Local multi-cluster expansion calculator, using only the named
+///     coefficient sets, constructing as necessary
+///
+/// The local correlations calculator of the result only evaluates basis
+/// functions with a non-zero coefficient in one of the named coefficient
+/// sets, and values are returned in the order of `coefficient_names`.
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+SupercellSystemData::local_multiclex(
+    std::string const &key, std::vector<std::string> const &coefficient_names) {
+  auto const &neighbor_list = supercell_neighbor_list();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _get_or_make(
+      m_local_multiclex_subset, std::make_pair(key, coefficient_names), [&]() {
+        auto const &data =
+            _verify(m_system.local_multiclex_data, key, "local_multiclex");
+        _require_neighbor_list(neighbor_list, "local_multiclex");
+        auto _local_clexulator =
+            get_local_basis_set(m_system, data.local_basis_set_name);
+        return std::make_shared<clexulator::MultiLocalClusterExpansion>(
+            neighbor_list, _local_clexulator,
+            select_coefficients(data, coefficient_names));
+      });
+}
+
+namespace {
+
+/// \brief Return true if two supercells have the same lattice
+///
+/// The lattices are the same if T_a^{-1} * T_b is an integer matrix with
+/// determinant 1.
+bool _is_same_supercell_lattice(Eigen::Matrix3l const &T_a,
+                                Eigen::Matrix3l const &T_b) {
+  if (T_a.determinant() != T_b.determinant()) {
+    return false;
   }
+  Eigen::Matrix3d U = T_a.cast<double>().inverse() * T_b.cast<double>();
+  return (U - U.array().round().matrix()).cwiseAbs().maxCoeff() < 1e-6;
+}
 
-  // make clex
-  for (auto const &pair : system.clex_data) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct clex with "
-          "empty neighbor list");
+/// \brief Return true if two supercell index conversions have the same site
+///     ordering
+bool _is_same_site_order(monte::Conversions const &convert_a,
+                         monte::Conversions const &convert_b) {
+  if (convert_a.l_size() != convert_b.l_size()) {
+    return false;
+  }
+  for (Index l = 0; l < convert_a.l_size(); ++l) {
+    xtal::UnitCellCoord const &bijk_a = convert_a.l_to_bijk(l);
+    xtal::UnitCellCoord const &bijk_b = convert_b.l_to_bijk(l);
+    if (bijk_a.sublattice() != bijk_b.sublattice() ||
+        bijk_a.unitcell() != bijk_b.unitcell()) {
+      return false;
     }
-    auto const &key = pair.first;
-    auto const &data = pair.second;
-    auto _clexulator = get_basis_set(system, data.basis_set_name);
-    auto _clex = std::make_shared<clexulator::ClusterExpansion>(
-        supercell_neighbor_list, _clexulator, data.coefficients);
-    clex.emplace(key, _clex);
   }
+  return true;
+}
 
-  // make multiclex
-  for (auto const &pair : system.multiclex_data) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct multiclex "
-          "with empty neighbor list");
-    }
-    auto const &key = pair.first;
-    auto const &data = pair.second;
-    auto _clexulator = get_basis_set(system, data.basis_set_name);
-    auto _multiclex = std::make_shared<clexulator::MultiClusterExpansion>(
-        supercell_neighbor_list, _clexulator, data.coefficients);
-    multiclex.emplace(key, _multiclex);
+}  // namespace
+
+/// \brief Get SupercellSystemData, constructing as necessary
+///
+/// Notes:
+/// - Safe to call concurrently
+/// - Construction of a new entry, including insertion into
+///   `system.supercells`, happens while holding the cache lock, so it is
+///   done once per supercell
+/// - If a new entry is constructed and `max_size_in_bytes` is set, least
+///   recently used entries are evicted as necessary
+/// - If no entry exists for `transformation_matrix_to_super`, but an entry
+///   exists for a supercell with the same lattice and the same site
+///   ordering, that entry is shared. Occupation vectors are then valid for
+///   both, so the supercell neighbor list and calculators are shared
+///   without permuting indices. Only if an entry with the same lattice
+///   exists are index conversions constructed to check the site ordering,
+///   and a new SupercellSystemData is only constructed if no entry is
+///   shared.
+std::shared_ptr<SupercellSystemData> SupercellSystemDataCache::get_or_make(
+    System const &system,
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = _find(transformation_matrix_to_super);
+  if (it != m_data.end()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru_it);
+    return it->second.data;
   }
+  system.supercells->insert(transformation_matrix_to_super);
 
-  // make local_clex
-  for (auto const &pair : system.local_clex_data) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct local_clex "
-          "with empty neighbor list");
+  std::unique_ptr<monte::Conversions> convert;
+  for (it = m_data.begin(); it != m_data.end(); ++it) {
+    if (!_is_same_supercell_lattice(it->first,
+                                    transformation_matrix_to_super)) {
+      continue;
+    }
+    if (convert == nullptr) {
+      convert = std::make_unique<monte::Conversions>(
+          *system.prim->basicstructure, transformation_matrix_to_super);
+    }
+    if (_is_same_site_order(it->second.data->convert, *convert)) {
+      it->second.aliases.push_back(transformation_matrix_to_super);
+      m_alias.emplace(transformation_matrix_to_super, it->first);
+      m_lru.splice(m_lru.begin(), m_lru, it->second.lru_it);
+      return it->second.data;
     }
-    auto const &key = pair.first;
-    auto const &data = pair.second;
-    auto _local_clexulator =
-        get_local_basis_set(system, data.local_basis_set_name);
-    auto _local_clex = std::make_shared<clexulator::LocalClusterExpansion>(
-        supercell_neighbor_list, _local_clexulator, data.coefficients);
-    local_clex.emplace(key, _local_clex);
   }
 
-  // make local_multiclex
-  for (auto const &pair : system.local_multiclex_data) {
-    if (supercell_neighbor_list == nullptr) {
-      throw std::runtime_error(
-          "Error constructing SupercellSystemData: Cannot construct "
-          "local_multiclex with empty neighbor list");
+  PhaseTimer timer(system.startup_timings, "supercell_data");
+  auto data = std::make_shared<SupercellSystemData>(
+      system, transformation_matrix_to_super);
+  timer.stop();
+
+  m_lru.push_front(transformation_matrix_to_super);
+  Entry entry;
+  entry.data = data;
+  entry.lru_it = m_lru.begin();
+  m_data.emplace(transformation_matrix_to_super, std::move(entry));
+  _evict();
+  return data;
+}
+
+/// \brief Get SupercellSystemData if it exists, else nullptr
+///
+/// This does not count as a use for least recently used eviction.
+std::shared_ptr<SupercellSystemData> SupercellSystemDataCache::find(
+    Eigen::Matrix3l const &transformation_matrix_to_super) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = _find(transformation_matrix_to_super);
+  if (it == m_data.end()) {
+    return nullptr;
+  }
+  return it->second.data;
+}
+
+/// \brief Number of distinct entries (equivalent supercells count once)
+Index SupercellSystemDataCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_data.size();
+}
+
+/// \brief Estimated total size, in bytes, of all entries
+Index SupercellSystemDataCache::size_in_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _size_in_bytes();
+}
+
+/// \brief Maximum estimated total size, in bytes, or std::nullopt for no
+///     limit
+std::optional<Index> SupercellSystemDataCache::max_size_in_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_max_size_in_bytes;
+}
+
+/// \brief Set the maximum estimated total size, in bytes, evicting entries
+///     as necessary
+void SupercellSystemDataCache::set_max_size_in_bytes(
+    std::optional<Index> _max_size_in_bytes) {
+  if (_max_size_in_bytes.has_value() && *_max_size_in_bytes < 0) {
+    throw std::runtime_error(
+        "Error in SupercellSystemDataCache::set_max_size_in_bytes: "
+        "max_size_in_bytes < 0");
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_max_size_in_bytes = _max_size_in_bytes;
+  _evict();
+}
+
+/// \brief Remove all entries
+///
+/// Entries held outside the cache remain valid until released.
+void SupercellSystemDataCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_data.clear();
+  m_lru.clear();
+  m_alias.clear();
+}
+
+/// Find the entry for a transformation matrix, directly or by alias.
+/// Requires m_mutex is locked.
+SupercellSystemDataCache::data_map_type::iterator
+SupercellSystemDataCache::_find(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  auto alias_it = m_alias.find(transformation_matrix_to_super);
+  if (alias_it != m_alias.end()) {
+    return m_data.find(alias_it->second);
+  }
+  return m_data.find(transformation_matrix_to_super);
+}
+
+/// Find the entry for a transformation matrix, directly or by alias.
+/// Requires m_mutex is locked.
+SupercellSystemDataCache::data_map_type::const_iterator
+SupercellSystemDataCache::_find(
+    Eigen::Matrix3l const &transformation_matrix_to_super) const {
+  auto alias_it = m_alias.find(transformation_matrix_to_super);
+  if (alias_it != m_alias.end()) {
+    return m_data.find(alias_it->second);
+  }
+  return m_data.find(transformation_matrix_to_super);
+}
+
+/// Estimated total size. Requires m_mutex is locked.
+Index SupercellSystemDataCache::_size_in_bytes() const {
+  Index total = 0;
+  for (auto const &pair : m_data) {
+    total += pair.second.data->size_in_bytes();
+  }
+  return total;
+}
+
+/// Evict least recently used entries, except the most recently used entry
+/// and entries held outside the cache, until within m_max_size_in_bytes.
+/// Requires m_mutex is locked.
+void SupercellSystemDataCache::_evict() {
+  if (!m_max_size_in_bytes.has_value() || m_lru.empty()) {
+    return;
+  }
+  Index total = _size_in_bytes();
+  auto lru_it = std::prev(m_lru.end());
+  while (total > *m_max_size_in_bytes && lru_it != m_lru.begin()) {
+    auto it = m_data.find(*lru_it);
+    auto next_lru_it = std::prev(lru_it);
+    if (it->second.data.use_count() == 1) {
+      total -= it->second.data->size_in_bytes();
+      for (auto const &alias : it->second.aliases) {
+        m_alias.erase(alias);
+      }
+      m_data.erase(it);
+      m_lru.erase(lru_it);
     }
-    auto const &key = pair.first;
-    auto const &data = pair.second;
-    auto _local_clexulator =
-        get_local_basis_set(system, data.local_basis_set_name);
-    auto _local_multiclex =
-        std::make_shared<clexulator::MultiLocalClusterExpansion>(
-            supercell_neighbor_list, _local_clexulator, data.coefficients);
-    local_multiclex.emplace(key, _local_multiclex);
+    lru_it = next_lru_it;
   }
+}
 
-  // make order_parameters
-  for (auto const &pair : system.dof_spaces) {
-    auto const &key = pair.first;
-    auto const &definition = *pair.second;
-    auto _order_parameter =
-        std::make_shared<clexulator::OrderParameter>(definition);
-    _order_parameter->update(convert.transformation_matrix_to_super(),
-                             convert.index_converter());
-    order_parameters.emplace(key, _order_parameter);
+/// \brief Get a neighborhood, constructing it with `make` as necessary
+///
+/// Safe to call concurrently. The returned reference remains valid until
+/// `clear` is called.
+std::vector<xtal::UnitCellCoord> const &LocalSiteNeighborhoodCache::get_or_make(
+    key_type const &key,
+    std::function<std::vector<xtal::UnitCellCoord>()> const &make) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_data.find(key);
+  if (it == m_data.end()) {
+    it = m_data.emplace(key, make()).first;
   }
+  return it->second;
+}
+
+/// \brief Number of cached neighborhoods
+Index LocalSiteNeighborhoodCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_data.size();
+}
+
+/// \brief Remove all entries, invalidating references
+void LocalSiteNeighborhoodCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_data.clear();
 }
 
 // --- The following are used to construct a common interface between "System"
@@ -185,16 +530,12 @@ namespace {
 ///     constructing as necessary
 SupercellSystemData &get_supercell_data(
     System &system, Eigen::Matrix3l const &transformation_matrix_to_super) {
-  auto it = system.supercell_data.find(transformation_matrix_to_super);
-  if (it == system.supercell_data.end()) {
-    system.supercells->insert(transformation_matrix_to_super);
-    it = system.supercell_data
-             .emplace(
-                 std::piecewise_construct,
-                 std::forward_as_tuple(transformation_matrix_to_super),
-                 std::forward_as_tuple(system, transformation_matrix_to_super))
-             .first;
-  }
+  // The reference stays valid until the entry is evicted, which does not
+  // happen while it is the most recently used entry or is held by
+  // `get_shared_supercell_data`
+  return *system.supercell_data.get_or_make(system,
+                                            transformation_matrix_to_super);
+}
   return it->second;
 }
 
@@ -354,33 +695,6 @@ state_type to_standard_values(System const &system,
   return state_in_standard_basis;
 }
 
-template <typename MapType>
-typename MapType::mapped_type &_verify(MapType &m, std::string const &key,
-                                       std::string const &name) {
-  auto it = m.find(key);
-  if (it == m.end()) {
-    std::stringstream msg;
-    msg << "System error: '" << name << "' does not contain required '" << key
-        << "'." << std::endl;
-    throw std::runtime_error(msg.str());
-  }
-  return it->second;
-}
-
-template <typename MapType>
-typename MapType::mapped_type const &_verify(MapType const &m,
-                                             std::string const &key,
-                                             std::string const &name) {
-  auto it = m.find(key);
-  if (it == m.end()) {
-    std::stringstream msg;
-    msg << "System error: '" << name << "' does not contain required '" << key
-        << "'." << std::endl;
-    throw std::runtime_error(msg.str());
-  }
-  return it->second;
-}
-
 /// \brief Check for DoFSpace
 bool is_dof_space(System const &system, std::string const &key) {
   return system.dof_spaces.find(key) != system.dof_spaces.end();
@@ -460,36 +774,84 @@ LocalMultiClexData const &get_local_multiclex_data(System const &system,
   return _verify(system.local_multiclex_data, key, "local_multiclex");
 }
 
-/// \brief Construct impact tables
+/// \brief Sites used to evaluate a cluster expansion, relative to the origin
+///     unit cell
+///
+/// Only basis functions with non-zero coefficients are included. The change
+/// in value due to an occupation change on a site only depends on the
+/// occupation of sites in this neighborhood, translated to the unit cell of
+/// the site.
 std::set<xtal::UnitCellCoord> get_required_update_neighborhood(
-    System const &system, LocalClexData const &local_clex_data,
-    Index equivalent_index) {
+    System const &system, ClexData const &clex_data) {
   auto const &clexulator =
-      *_verify(system.local_basis_sets, local_clex_data.local_basis_set_name,
-               "local_basis_sets");
+      *_verify(system.basis_sets, clex_data.basis_set_name, "basis_sets");
 
-  auto const &coeff = local_clex_data.coefficients;
+  auto const &coeff = clex_data.coefficients;
   auto begin = coeff.index.data();
   auto end = begin + coeff.index.size();
-  return clexulator[equivalent_index].site_neighborhood(begin, end);
+  return clexulator.site_neighborhood(begin, end);
 }
 
-/// \brief Construct impact tables
-std::set<xtal::UnitCellCoord> get_required_update_neighborhood(
-    System const &system, LocalMultiClexData const &local_multiclex_data,
+namespace {
+
+/// Sites used to evaluate the basis functions with the given indices, in
+/// sorted order, from the cache of `system`
+std::vector<xtal::UnitCellCoord> const &_get_local_site_neighborhood(
+    System const &system, std::string const &local_basis_set_name,
+    Index equivalent_index, std::vector<unsigned int> function_indices) {
+  auto const &clexulator = *_verify(
+      system.local_basis_sets, local_basis_set_name, "local_basis_sets");
+
+  std::sort(function_indices.begin(), function_indices.end());
+  function_indices.erase(
+      std::unique(function_indices.begin(), function_indices.end()),
+      function_indices.end());
+
+  return system.local_site_neighborhoods.get_or_make(
+      std::make_tuple(local_basis_set_name, equivalent_index,
+                      function_indices),
+      [&]() {
+        auto begin = function_indices.data();
+        auto end = begin + function_indices.size();
+        auto nhood = clexulator[equivalent_index].site_neighborhood(begin, end);
+        return std::vector<xtal::UnitCellCoord>(nhood.begin(), nhood.end());
+      });
+}
+
+}  // namespace
+
+/// \brief Sites used to evaluate a local cluster expansion, relative to the
+///     origin unit cell, as a sorted vector
+///
+/// Only basis functions with non-zero coefficients are included. The result
+/// is cached in `system.local_site_neighborhoods`.
+std::vector<xtal::UnitCellCoord> const &get_required_update_neighborhood(
+    System const &system, LocalClexData const &local_clex_data,
     Index equivalent_index) {
-  auto const &clexulator =
-      *_verify(system.local_basis_sets,
-               local_multiclex_data.local_basis_set_name, "local_basis_sets");
+  auto const &index = local_clex_data.coefficients.index;
+  return _get_local_site_neighborhood(
+      system, local_clex_data.local_basis_set_name, equivalent_index,
+      std::vector<unsigned int>(index.begin(), index.end()));
+}
 
-  std::set<xtal::UnitCellCoord> nhood;
+/// \brief Sites used to evaluate a local multi-cluster expansion, relative
+///     to the origin unit cell, as a sorted vector
+///
+/// Only basis functions with non-zero coefficients in any of the coefficient
+/// sets are included, so the neighborhood is constructed once for the union
+/// of the coefficient sets. The result is cached in
+/// `system.local_site_neighborhoods`.
+std::vector<xtal::UnitCellCoord> const &get_required_update_neighborhood(
+    System const &system, LocalMultiClexData const &local_multiclex_data,
+    Index equivalent_index) {
+  std::vector<unsigned int> function_indices;
   for (auto const &coeff : local_multiclex_data.coefficients) {
-    auto begin = coeff.index.data();
-    auto end = begin + coeff.index.size();
-    auto tmp = clexulator[equivalent_index].site_neighborhood(begin, end);
-    nhood.insert(tmp.begin(), tmp.end());
+    function_indices.insert(function_indices.end(), coeff.index.begin(),
+                            coeff.index.end());
   }
-  return nhood;
+  return _get_local_site_neighborhood(
+      system, local_multiclex_data.local_basis_set_name, equivalent_index,
+      std::move(function_indices));
 }
 
 /// \brief Single swap types for canonical Monte Carlo events
@@ -538,6 +900,9 @@ OccEventTypeData const &get_event_type_data(System const &system,
 }
 
 /// \brief Random alloy correlation matching
+///
+/// When implemented, wrap the result with `make_memoized_corr_f` so that
+/// conditions scans that repeat compositions do not repeat the calculation.
 CorrCalculatorFunction get_random_alloy_corr_f(System const &system) {
   // TODO - this is a placeholder, need to implement actual function
   return [=](std::vector<Eigen::VectorXd> const &sublattice_prob) {
@@ -549,6 +914,25 @@ CorrCalculatorFunction get_random_alloy_corr_f(System const &system) {
 
 // --- Supercell-specific
 
+/// \brief Helper to get shared SupercellSystemData for a particular
+///     state's supercell, constructing as necessary
+///
+/// Holding the result keeps the SupercellSystemData, and references from
+/// `get_index_conversions`, etc., valid if it is evicted from or cleared
+/// from `system.supercell_data`.
+///
+/// \relates System
+std::shared_ptr<SupercellSystemData> get_shared_supercell_data(
+    System &system, state_type const &state) {
+  return system.supercell_data.get_or_make(
+      system, get_transformation_matrix_to_super(state));
+}
+
+/// \brief Remove all SupercellSystemData
+///
+/// \relates System
+void clear_supercell_data(System &system) { system.supercell_data.clear(); }
+
 /// \brief Helper to get the correct clexulator::Correlations for a
 ///     particular state's supercell, constructing as necessary
 ///
@@ -560,7 +944,7 @@ CorrCalculatorFunction get_random_alloy_corr_f(System const &system) {
 std::shared_ptr<clexulator::Correlations> get_corr(System &system,
                                                    state_type const &state,
                                                    std::string const &key) {
-  auto corr = _verify(get_supercell_data(system, state).corr, key, "corr");
+  auto corr = get_supercell_data(system, state).corr(key);
   corr->set(&get_dof_values(state));
   return corr;
 }
@@ -575,8 +959,7 @@ std::shared_ptr<clexulator::Correlations> get_corr(System &system,
 ///   get_local_clex(...).correlations().
 std::shared_ptr<clexulator::LocalCorrelations> get_local_corr(
     System &system, state_type const &state, std::string const &key) {
-  auto local_corr =
-      _verify(get_supercell_data(system, state).local_corr, key, "local_corr");
+  auto local_corr = get_supercell_data(system, state).local_corr(key);
   local_corr->set(&get_dof_values(state));
   return local_corr;
 }
@@ -588,7 +971,7 @@ std::shared_ptr<clexulator::LocalCorrelations> get_local_corr(
 std::shared_ptr<clexulator::ClusterExpansion> get_clex(System &system,
                                                        state_type const &state,
                                                        std::string const &key) {
-  auto clex = _verify(get_supercell_data(system, state).clex, key, "clex");
+  auto clex = get_supercell_data(system, state).clex(key);
 
   set(*clex, state);
   return clex;
@@ -605,8 +988,7 @@ std::shared_ptr<clexulator::ClusterExpansion> get_clex(System &system,
 /// \relates System
 std::shared_ptr<clexulator::MultiClusterExpansion> get_multiclex(
     System &system, state_type const &state, std::string const &key) {
-  auto clex =
-      _verify(get_supercell_data(system, state).multiclex, key, "multiclex");
+  auto clex = get_supercell_data(system, state).multiclex(key);
   set(*clex, state);
   return clex;
 }
@@ -615,8 +997,7 @@ std::shared_ptr<clexulator::MultiClusterExpansion> get_multiclex(
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::LocalClusterExpansion> get_local_clex(
     System &system, state_type const &state, std::string const &key) {
-  auto clex =
-      _verify(get_supercell_data(system, state).local_clex, key, "local_clex");
+  auto clex = get_supercell_data(system, state).local_clex(key);
   set(*clex, state);
   return clex;
 }
@@ -631,8 +1012,27 @@ std::shared_ptr<clexulator::LocalClusterExpansion> get_local_clex(
 ///
 std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
     System &system, state_type const &state, std::string const &key) {
-  auto clex = _verify(get_supercell_data(system, state).local_multiclex, key,
-                      "local_multiclex");
+  auto clex = get_supercell_data(system, state).local_multiclex(key);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Helper to get a clexulator::MultiLocalClusterExpansion, using only
+///     the named coefficient sets, for a particular state's supercell,
+///     constructing as necessary
+///
+/// Notes:
+/// - The resulting object contains a clexulator::LocalCorrelations set to
+///   evaluate only the correlations which have non-zero eci for at least one
+///   of the named coefficient sets
+/// - Values are in the order of `coefficient_names`
+///
+/// \relates System
+std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
+    System &system, state_type const &state, std::string const &key,
+    std::vector<std::string> const &coefficient_names) {
+  auto clex =
+      get_supercell_data(system, state).local_multiclex(key, coefficient_names);
   set(*clex, state);
   return clex;
 }
@@ -641,7 +1041,154 @@ std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::SuperNeighborList> get_supercell_neighbor_list(
     System &system, state_type const &state) {
-  return get_supercell_data(system, state).supercell_neighbor_list;
+  return get_supercell_data(system, state).supercell_neighbor_list();
+}
+
+/// \brief Construct a clexulator::ClusterExpansion for a particular state's
+///     supercell, which is not shared with other calculators
+///
+/// The result has its own copy of the Clexulator, and therefore its own
+/// scratch space, so it can be used on a different thread than the
+/// clexulator::ClusterExpansion from `get_clex`. It shares the supercell
+/// neighbor list, and is set to evaluate `state`.
+///
+/// \relates System
+std::shared_ptr<clexulator::ClusterExpansion> make_independent_clex(
+    System &system, state_type const &state, std::string const &key) {
+  ClexData const &clex_data = get_clex_data(system, key);
+  auto clex = std::make_shared<clexulator::ClusterExpansion>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<clexulator::Clexulator>(
+          *get_basis_set(system, clex_data.basis_set_name)),
+      clex_data.coefficients);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Construct a clexulator::Correlations for a particular state's
+///     supercell, which is not shared with other calculators
+///
+/// The result has its own copy of the Clexulator, and shares the supercell
+/// neighbor list. It is set to evaluate all correlations for `state`.
+///
+/// \relates System
+std::shared_ptr<clexulator::Correlations> make_independent_corr(
+    System &system, state_type const &state, std::string const &key) {
+  auto corr = std::make_shared<clexulator::Correlations>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<clexulator::Clexulator>(*get_basis_set(system, key)));
+  corr->set(&get_dof_values(state));
+  return corr;
+}
+
+/// \brief Construct a clexulator::MultiClusterExpansion for a particular
+///     state's supercell, which is not shared with other calculators
+///
+/// The result has its own copy of the Clexulator, and shares the supercell
+/// neighbor list. It is set to evaluate `state`.
+///
+/// \relates System
+std::shared_ptr<clexulator::MultiClusterExpansion> make_independent_multiclex(
+    System &system, state_type const &state, std::string const &key) {
+  MultiClexData const &data = get_multiclex_data(system, key);
+  auto clex = std::make_shared<clexulator::MultiClusterExpansion>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<clexulator::Clexulator>(
+          *get_basis_set(system, data.basis_set_name)),
+      data.coefficients);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Construct a clexulator::LocalClusterExpansion for a particular
+///     state's supercell, which is not shared with other calculators
+///
+/// The result has its own copies of the local Clexulator, and shares the
+/// supercell neighbor list. It is set to evaluate `state`.
+///
+/// \relates System
+std::shared_ptr<clexulator::LocalClusterExpansion> make_independent_local_clex(
+    System &system, state_type const &state, std::string const &key) {
+  LocalClexData const &data = get_local_clex_data(system, key);
+  auto clex = std::make_shared<clexulator::LocalClusterExpansion>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<std::vector<clexulator::Clexulator>>(
+          *get_local_basis_set(system, data.local_basis_set_name)),
+      data.coefficients);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Construct a clexulator::MultiLocalClusterExpansion for a
+///     particular state's supercell, which is not shared with other
+///     calculators
+///
+/// The result has its own copies of the local Clexulator, and shares the
+/// supercell neighbor list. It is set to evaluate `state`.
+///
+/// \relates System
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+make_independent_local_multiclex(System &system, state_type const &state,
+                                 std::string const &key) {
+  LocalMultiClexData const &data = get_local_multiclex_data(system, key);
+  auto clex = std::make_shared<clexulator::MultiLocalClusterExpansion>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<std::vector<clexulator::Clexulator>>(
+          *get_local_basis_set(system, data.local_basis_set_name)),
+      data.coefficients);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Construct a clexulator::MultiLocalClusterExpansion, using only the
+///     named coefficient sets, for a particular state's supercell, which is
+///     not shared with other calculators
+///
+/// As `make_independent_local_multiclex`, but only basis functions with a
+/// non-zero coefficient in one of the named coefficient sets are evaluated,
+/// and values are in the order of `coefficient_names`.
+///
+/// \relates System
+std::shared_ptr<clexulator::MultiLocalClusterExpansion>
+make_independent_local_multiclex(
+    System &system, state_type const &state, std::string const &key,
+    std::vector<std::string> const &coefficient_names) {
+  LocalMultiClexData const &data = get_local_multiclex_data(system, key);
+  auto clex = std::make_shared<clexulator::MultiLocalClusterExpansion>(
+      get_supercell_neighbor_list(system, state),
+      std::make_shared<std::vector<clexulator::Clexulator>>(
+          *get_local_basis_set(system, data.local_basis_set_name)),
+      select_coefficients(data, coefficient_names));
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Select coefficient sets of a local multi-cluster expansion by name
+///
+/// \param data Local multi-cluster expansion data
+/// \param coefficient_names Names of coefficient sets, as in
+///     `data.coefficients_glossary`
+///
+/// \returns The named coefficient sets, in the order of `coefficient_names`
+///
+/// \relates System
+std::vector<clexulator::SparseCoefficients> select_coefficients(
+    LocalMultiClexData const &data,
+    std::vector<std::string> const &coefficient_names) {
+  std::vector<clexulator::SparseCoefficients> coefficients;
+  for (std::string const &name : coefficient_names) {
+    auto it = data.coefficients_glossary.find(name);
+    if (it == data.coefficients_glossary.end() || it->second < 0 ||
+        it->second >= data.coefficients.size()) {
+      std::stringstream msg;
+      msg << "Error in select_coefficients: local multi-cluster expansion "
+             "coefficients '"
+          << name << "' not found";
+      throw std::runtime_error(msg.str());
+    }
+    coefficients.push_back(data.coefficients[it->second]);
+  }
+  return coefficients;
 }
 
 /// \brief Helper to get the correct order parameter calculators for a
@@ -651,8 +1198,7 @@ std::shared_ptr<clexulator::SuperNeighborList> get_supercell_neighbor_list(
 std::shared_ptr<clexulator::OrderParameter> get_order_parameter(
     System &system, state_type const &state, std::string const &key) {
   auto order_parameter =
-      _verify(get_supercell_data(system, state).order_parameters, key,
-              "order_parameters");
+      get_supercell_data(system, state).order_parameter(key);
   order_parameter->set(&get_dof_values(state));
   return order_parameter;
 }
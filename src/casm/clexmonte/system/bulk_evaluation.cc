@@ -0,0 +1,170 @@
+#include "casm/clexmonte/system/bulk_evaluation.hh"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/methods/thread_pool.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// \brief Evaluate one calculator per thread for blocks of configurations
+///
+/// Each thread has its own copy of `state`, whose occupation is set to each
+/// row of `occupation` in turn, and its own calculator, made by
+/// `make_calculator_f(thread_state)` and set to evaluate `thread_state`.
+/// Calculators are made on the calling thread, and share the supercell
+/// neighbor list. Then `evaluate_f(calculator, i)` is called for each row
+/// `i`, and should write results by index.
+template <typename MakeCalculatorF, typename EvaluateF>
+void _evaluate_bulk(System &system, state_type const &state,
+                    Eigen::Ref<bulk_occupation_type const> const &occupation,
+                    Index n_threads, std::string const &name,
+                    MakeCalculatorF make_calculator_f, EvaluateF evaluate_f) {
+  Index n_sites = get_occupation(state).size();
+  if (occupation.cols() != n_sites) {
+    throw std::runtime_error("Error in " + name + ": occupation has " +
+                             std::to_string(occupation.cols()) +
+                             " columns, but the supercell has " +
+                             std::to_string(n_sites) + " sites");
+  }
+  Index n = occupation.rows();
+  n_threads = std::max(Index(1), std::min(n_threads, n));
+
+  std::vector<state_type> thread_state(n_threads, state);
+  std::vector<decltype(make_calculator_f(thread_state[0]))> calculator;
+  for (Index t = 0; t < n_threads; ++t) {
+    calculator.push_back(make_calculator_f(thread_state[t]));
+  }
+
+  parallel_for_blocks(
+      n, n_threads, [&](Index begin, Index end, Index thread_index) {
+        Eigen::VectorXi &occ = get_occupation(thread_state[thread_index]);
+        for (Index i = begin; i < end; ++i) {
+          occ = occupation.row(i).transpose();
+          evaluate_f(*calculator[thread_index], i);
+        }
+      });
+}
+
+}  // namespace
+
+/// \brief Evaluate a cluster expansion (per unit cell) for many
+///     configurations in one supercell
+///
+/// Screening workflows may evaluate a cluster expansion for very many
+/// candidate configurations of one supercell. This evaluates all of them
+/// in one call, in parallel, with one independent calculator per thread
+/// sharing the supercell neighbor list, rather than setting up a state for
+/// each configuration.
+///
+/// \param system System data
+/// \param state A state in the supercell, which gives the supercell and
+///     any DoF values other than occupation. Its occupation is not used.
+/// \param key Cluster expansion name
+/// \param occupation Occupations, one row per configuration
+/// \param n_threads Number of threads
+///
+/// \returns Value per unit cell of each configuration
+Eigen::VectorXd bulk_clex_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads) {
+  Eigen::VectorXd value(occupation.rows());
+  _evaluate_bulk(
+      system, state, occupation, n_threads, "bulk_clex_per_unitcell",
+      [&](state_type const &thread_state) {
+        return make_independent_clex(system, thread_state, key);
+      },
+      [&](clexulator::ClusterExpansion &clex, Index i) {
+        value(i) = clex.per_unitcell();
+      });
+  return value;
+}
+
+/// \brief Evaluate a multi-cluster expansion (per unit cell) for many
+///     configurations in one supercell
+///
+/// Correlations are evaluated once per configuration for all coefficient
+/// sets. See `bulk_clex_per_unitcell` for parameters.
+///
+/// \returns Values per unit cell, one row per configuration and one column
+///     per coefficient set
+Eigen::MatrixXd bulk_multiclex_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads) {
+  Index n_values = get_multiclex_data(system, key).coefficients.size();
+  Eigen::MatrixXd value(occupation.rows(), n_values);
+  _evaluate_bulk(
+      system, state, occupation, n_threads, "bulk_multiclex_per_unitcell",
+      [&](state_type const &thread_state) {
+        return make_independent_multiclex(system, thread_state, key);
+      },
+      [&](clexulator::MultiClusterExpansion &multiclex, Index i) {
+        value.row(i) = multiclex.per_unitcell().transpose();
+      });
+  return value;
+}
+
+/// \brief Evaluate correlations (per unit cell) for many configurations in
+///     one supercell
+///
+/// See `bulk_clex_per_unitcell` for parameters, except `key` is a basis set
+/// name.
+///
+/// \returns Correlations per unit cell, one row per configuration
+Eigen::MatrixXd bulk_corr_per_unitcell(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads) {
+  Index n_corr = get_basis_set(system, key)->corr_size();
+  Eigen::MatrixXd value(occupation.rows(), n_corr);
+  _evaluate_bulk(
+      system, state, occupation, n_threads, "bulk_corr_per_unitcell",
+      [&](state_type const &thread_state) {
+        return make_independent_corr(system, thread_state, key);
+      },
+      [&](clexulator::Correlations &corr, Index i) {
+        value.row(i) = corr.per_unitcell(corr.per_supercell()).transpose();
+      });
+  return value;
+}
+
+/// \brief Evaluate an order parameter for many configurations in one
+///     supercell
+///
+/// See `bulk_clex_per_unitcell` for parameters, except `key` is an order
+/// parameter name.
+///
+/// \returns Order parameter values, one row per configuration
+Eigen::MatrixXd bulk_order_parameter(
+    System &system, state_type const &state, std::string const &key,
+    Eigen::Ref<bulk_occupation_type const> const &occupation,
+    Index n_threads) {
+  auto shared_order_parameter = get_order_parameter(system, state, key);
+  Eigen::MatrixXd value(occupation.rows(),
+                        shared_order_parameter->value().size());
+  _evaluate_bulk(
+      system, state, occupation, n_threads, "bulk_order_parameter",
+      [&](state_type const &thread_state) {
+        auto order_parameter = std::make_shared<clexulator::OrderParameter>(
+            *shared_order_parameter);
+        order_parameter->set(&get_dof_values(thread_state));
+        return order_parameter;
+      },
+      [&](clexulator::OrderParameter &order_parameter, Index i) {
+        value.row(i) = order_parameter.value().transpose();
+      });
+  return value;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,9 +1,13 @@
 #include "casm/clexmonte/system/io/json/System_json_io.hh"
 
+#include <optional>
+#include <sstream>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/misc/parse_array.hh"
 #include "casm/clexmonte/misc/subparse_from_file.hh"
+#include "casm/clexmonte/system/ClexulatorCache.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/clexmonte/system/io/json/system_data_json_io.hh"
 #include "casm/clexulator/NeighborList.hh"
@@ -62,6 +66,40 @@ bool parse_from_file(ParserType &parser, fs::path option,
   return true;
 }
 
+/// \brief Parse "basis_sets"/<name> or "local_basis_sets"/<name>, compiling
+///     and loading the clexulator from a cache entry if `cache` is not null
+template <typename RequiredType>
+std::shared_ptr<InputParser<RequiredType>> subparse_clexulator(
+    InputParser<System> &parser, fs::path option, ClexulatorCache const *cache,
+    std::shared_ptr<clexulator::PrimNeighborList> &prim_neighbor_list,
+    std::vector<fs::path> search_path) {
+  auto it = parser.self.find_at(option);
+  if (cache == nullptr || it == parser.self.end() || !it->is_obj() ||
+      !it->contains("source") || !(*it)["source"].is_string()) {
+    return parser.subparse<RequiredType>(option, prim_neighbor_list,
+                                         search_path);
+  }
+  fs::path source =
+      resolve_path((*it)["source"].get<std::string>(), search_path);
+  if (!fs::exists(source)) {
+    return parser.subparse<RequiredType>(option, prim_neighbor_list,
+                                         search_path);
+  }
+
+  // Hold the cache entry lock while the clexulator is compiled and loaded
+  std::stringstream basis_set_input;
+  basis_set_input << *it;
+  ClexulatorCache::Entry entry =
+      cache->acquire(source, basis_set_input.str());
+  jsonParser json = *it;
+  json["source"] = entry.source.string();
+  auto subparser = std::make_shared<InputParser<RequiredType>>(
+      json, prim_neighbor_list, search_path);
+  subparser->type_name = CASM::type_name<RequiredType>();
+  parser.insert(parser.relpath(option), subparser);
+  return subparser;
+}
+
 /// \brief Parse and validate "basis_set" or "local_basis_set" (name)
 template <typename ParserType, typename BasisSetMapType>
 bool parse_and_validate_basis_set_name(ParserType &parser, fs::path option,
@@ -199,6 +237,36 @@ bool parse_event(
 ///   "composition_axes": <composition::CompositionConverter>
 ///       Specifies composition axes
 ///
+///   "supercell_data_max_size_in_bytes": int (optional)
+///       If given, limits the estimated total size of the cached
+///       supercell-specific data (neighbor lists, index conversions, and
+///       calculators), by evicting least recently used supercells. By
+///       default, supercell data is not evicted.
+///
+///   "prim_impact_info_snapshot": string (optional)
+///       If given, path of a versioned binary snapshot of the KMC prim event
+///       cluster expansion update neighborhoods. The snapshot is read if it
+///       matches the current events and cluster expansions, and is written
+///       otherwise, so that jobs sharing a system skip recalculating the
+///       neighborhoods (see `load_or_make_prim_impact_info_list`).
+///
+///   "startup_timing_verbosity": int = 20
+///       Minimum `CASM::log()` verbosity at which the times of startup
+///       phases, such as parsing this input, compiling clexulators, and
+///       constructing supercell data and KMC event lists, are written to the
+///       log as they complete. The default, 20, is "verbose". The prim
+///       symmetry phases, which are timed while the System is constructed,
+///       are logged at the default verbosity. All phase times are kept in
+///       `System::startup_timings` regardless.
+///
+///   "clexulator_cache_dir": string (optional)
+///       If given, or if the CASM_CLEXULATOR_CACHE_DIR environment variable is
+///       set, clexulators for "basis_sets" and "local_basis_sets" are copied
+///       to, compiled in, and loaded from a content-addressed cache in this
+///       directory, so that jobs with the same basis sets and compiler
+///       options compile each clexulator once (see `ClexulatorCache`). The
+///       input value takes precedence over the environment variable.
+///
 ///   "basis_sets": object (optional)
 ///       Input specifies one or more CASM cluster expansion basis sets. A JSON
 ///       object containing one or more of:
@@ -336,6 +404,9 @@ bool parse_event(
 /// \endcode
 ///
 void parse(InputParser<System> &parser, std::vector<fs::path> search_path) {
+  PhaseTimer::clock_type::time_point parse_begin =
+      PhaseTimer::clock_type::now();
+
   // Parse "prim"
   std::shared_ptr<xtal::BasicStructure const> shared_prim =
       parser.require<xtal::BasicStructure>("prim", TOL);
@@ -351,10 +422,59 @@ void parse(InputParser<System> &parser, std::vector<fs::path> search_path) {
   // Construct System
   parser.value = std::make_unique<System>(shared_prim, *composition_axes);
   System &system = *parser.value;
+  PhaseTimer system_json_timer(system.startup_timings, "system_json",
+                               parse_begin);
+
+  // Parse "startup_timing_verbosity"
+  int startup_timing_verbosity = system.startup_timings.log_verbosity();
+  parser.optional(startup_timing_verbosity, "startup_timing_verbosity");
+  system.startup_timings.set_log_verbosity(startup_timing_verbosity);
 
   // Parse "n_dimensions"
   parser.optional(system.n_dimensions, "n_dimensions");
 
+  // Parse "supercell_data_max_size_in_bytes"
+  std::optional<Index> supercell_data_max_size_in_bytes;
+  parser.optional(supercell_data_max_size_in_bytes,
+                  "supercell_data_max_size_in_bytes");
+  if (supercell_data_max_size_in_bytes.has_value()) {
+    if (*supercell_data_max_size_in_bytes < 0) {
+      parser.insert_error("supercell_data_max_size_in_bytes",
+                          "Error: must be >= 0");
+    } else {
+      system.supercell_data.set_max_size_in_bytes(
+          supercell_data_max_size_in_bytes);
+    }
+  }
+
+  // Parse "prim_impact_info_snapshot"
+  std::optional<std::string> prim_impact_info_snapshot;
+  parser.optional(prim_impact_info_snapshot, "prim_impact_info_snapshot");
+  if (prim_impact_info_snapshot.has_value()) {
+    system.prim_impact_info_snapshot_path =
+        fs::path(*prim_impact_info_snapshot);
+  }
+
+  // Parse "clexulator_cache_dir"
+  std::optional<std::string> clexulator_cache_dir_input;
+  parser.optional(clexulator_cache_dir_input, "clexulator_cache_dir");
+  std::optional<fs::path> clexulator_cache_dir =
+      default_clexulator_cache_dir(clexulator_cache_dir_input);
+  std::unique_ptr<ClexulatorCache> clexulator_cache;
+  if (clexulator_cache_dir.has_value()) {
+    clexulator_cache = std::make_unique<ClexulatorCache>(*clexulator_cache_dir);
+  }
+
+  // Record input, so an equivalent System can be parsed again elsewhere
+  system.input = parser.self;
+  if (clexulator_cache_dir.has_value()) {
+    (*system.input)["clexulator_cache_dir"] =
+        fs::absolute(*clexulator_cache_dir).string();
+  }
+  for (fs::path const &path : search_path) {
+    system.input_search_path.push_back(fs::absolute(path));
+  }
+
   // Parse "basis_sets"
   if (parser.self.contains("basis_sets")) {
     auto &prim = *system.prim;
@@ -366,8 +486,11 @@ void parse(InputParser<System> &parser, std::vector<fs::path> search_path) {
     auto end = parser.self["basis_sets"].end();
     for (auto it = begin; it != end; ++it) {
       // parse "basis_sets"/<name>/"source"
-      auto subparser = parser.subparse<clexulator::Clexulator>(
-          fs::path("basis_sets") / it.name(), prim_neighbor_list, search_path);
+      PhaseTimer clexulator_timer(system.startup_timings, "clexulator");
+      auto subparser = subparse_clexulator<clexulator::Clexulator>(
+          parser, fs::path("basis_sets") / it.name(), clexulator_cache.get(),
+          prim_neighbor_list, search_path);
+      clexulator_timer.stop();
       if (subparser->valid()) {
         auto clexulator = std::make_shared<clexulator::Clexulator>(
             std::move(*subparser->value));
@@ -401,9 +524,12 @@ void parse(InputParser<System> &parser, std::vector<fs::path> search_path) {
     auto end = parser.self["local_basis_sets"].end();
     for (auto it = begin; it != end; ++it) {
       // parse "local_basis_sets"/<name>/"source"
-      auto subparser = parser.subparse<std::vector<clexulator::Clexulator>>(
-          fs::path("local_basis_sets") / it.name(), prim_neighbor_list,
-          search_path);
+      PhaseTimer clexulator_timer(system.startup_timings, "clexulator");
+      auto subparser =
+          subparse_clexulator<std::vector<clexulator::Clexulator>>(
+              parser, fs::path("local_basis_sets") / it.name(),
+              clexulator_cache.get(), prim_neighbor_list, search_path);
+      clexulator_timer.stop();
       if (subparser->valid()) {
         auto local_clexulator =
             std::make_shared<std::vector<clexulator::Clexulator>>(
@@ -0,0 +1,73 @@
+#ifndef CASM_benchmark_benchmark_systems
+#define CASM_benchmark_benchmark_systems
+
+#include <memory>
+
+#include "KMCCompleteEventCalculatorTestSystem.hh"
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "teststructures.hh"
+
+namespace benchmark_systems {
+
+using namespace CASM;
+
+/// \brief ZrO test system, for use outside of a googletest test
+///
+/// Notes:
+/// - The test systems derive from testing::Test so that they can be used as
+///   test fixtures; `TestBody` is defined so they can be constructed
+///   directly.
+/// - The system is constructed once per benchmark, so the Clexulator is
+///   only compiled the first time (see ZrOTestSystem).
+class ZrOBenchmarkSystem : public test::ZrOTestSystem {
+ public:
+  void TestBody() override {}
+
+  /// \brief Make a dim x dim x dim supercell state, with O on half of the
+  ///     O sites, at T=600K
+  std::unique_ptr<clexmonte::state_type> make_state(Index dim) {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * dim;
+    Index volume = T.determinant();
+    auto state = std::make_unique<clexmonte::state_type>(
+        clexmonte::make_default_configuration(*system, T),
+        clexmonte::canonical::make_conditions(
+            600.0, system->composition_converter,
+            {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}}));
+    for (Index i = 0; i < volume; ++i) {
+      clexmonte::get_occupation(*state)(2 * volume + i) = 1;
+    }
+    return state;
+  }
+};
+
+/// \brief FCC A-B-Va KMC test system, for use outside of a googletest test
+///
+/// See ZrOBenchmarkSystem notes.
+class KMCBenchmarkSystem : public test::KMCCompleteEventCalculatorTestSystem {
+ public:
+  KMCBenchmarkSystem() { setup_input_files(false /*use_sparse_format_eci*/); }
+
+  void TestBody() override {}
+
+  std::shared_ptr<clexmonte::System> const &get_system() const {
+    return system;
+  }
+
+  /// \brief Make a dim x dim x dim (of the conventional 4-atom cell) state,
+  ///     with A on all sites except a single Va, at T=600K
+  std::unique_ptr<clexmonte::state_type> make_state(Index dim) {
+    Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+    auto state = std::make_unique<clexmonte::state_type>(
+        clexmonte::make_default_configuration(*system, T));
+    clexmonte::get_occupation(*state)(0) = 2;
+    state->conditions.scalar_values.emplace("temperature", 600.0);
+    return state;
+  }
+};
+
+}  // namespace benchmark_systems
+
+#endif
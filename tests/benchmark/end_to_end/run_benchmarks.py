@@ -0,0 +1,477 @@
+"""End-to-end throughput benchmarks of the ccasm_clexmonte programs
+
+Runs ``ccasm_clexmonte_canonical``, ``ccasm_clexmonte_semigrand_canonical``,
+``ccasm_clexmonte_kmc``, and ``ccasm_clexmonte_nfold`` on the ZrO and FCC
+A-B-Va unit test systems at several supercell sizes, and writes a JSON report.
+If a baseline report is given, throughput and memory use are compared against
+it and the script exits with status 1 if any case regressed.
+
+Usage::
+
+    python run_benchmarks.py --bin-dir <dir with ccasm_clexmonte_* programs> \\
+        --work-dir <scratch dir> --output report.json \\
+        [--baseline baseline.json] [--tolerance 0.1] [--repeat 3] \\
+        [--case <name> ...] [--size <dim> ...]
+
+For each case and supercell size, two runs are made:
+
+- A startup run, with no Monte Carlo passes, which measures the time to
+  construct the system, compile or load the Clexulators, and set up each
+  state (including, for KMC, constructing the event list).
+- A throughput run, with ``n_passes`` passes per state. Steps per second is
+  the number of steps divided by the difference between the throughput and
+  startup run wall times.
+
+The number of steps per pass is the number of sites with more than one
+allowed occupant (``variable_sites_per_unitcell`` times the number of unit
+cells). For the rejection-free KMC and n-fold way methods steps are events,
+so events per second is reported; for the Metropolis methods it is null.
+
+Peak RSS is the maximum resident set size of the throughput run, in MiB.
+
+With ``--repeat N``, each run is repeated N times and the fastest is
+reported, to reduce noise. The random number generator is seeded, so repeated
+runs follow the same trajectory.
+
+Report format::
+
+    {
+      "cases": {
+        "<case>/<dim>": {
+          "program": str,
+          "dim": int,
+          "n_steps": int,
+          "startup_time_s": float,
+          "run_time_s": float,
+          "steps_per_s": float,
+          "events_per_s": float or null,
+          "peak_rss_mb": float
+        },
+        ...
+      },
+      "regressions": [ {"case": str, "metric": str, "value": float,
+                        "baseline": float}, ... ]
+    }
+"""
+
+import argparse
+import copy
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import time
+
+DATA_DIR = (
+    pathlib.Path(__file__).resolve().parent.parent.parent
+    / "unit"
+    / "clexmonte"
+    / "data"
+)
+
+# Sampled quantities are kept to a minimum, so throughput is dominated by
+# the Monte Carlo steps
+CASES = {
+    "canonical": {
+        "program": "ccasm_clexmonte_canonical",
+        "system": "ZrO",
+        "variable_sites_per_unitcell": 2,
+        "conditions": {
+            "temperature": 1000.0,
+            "mol_composition": {"Zr": 2.0, "O": 1.0, "Va": 1.0},
+        },
+        "quantities": ["potential_energy"],
+        "n_passes": 100,
+        "sizes": [4, 8, 16],
+        "is_rejection_free": False,
+    },
+    "semigrand_canonical": {
+        "program": "ccasm_clexmonte_semigrand_canonical",
+        "system": "ZrO",
+        "variable_sites_per_unitcell": 2,
+        "conditions": {"temperature": 1000.0, "param_chem_pot": {"a": 0.0}},
+        "quantities": ["potential_energy"],
+        "n_passes": 100,
+        "sizes": [4, 8, 16],
+        "is_rejection_free": False,
+    },
+    "kmc": {
+        "program": "ccasm_clexmonte_kmc",
+        "system": "FCC_binary_vacancy",
+        "variable_sites_per_unitcell": 1,
+        "conditions": {
+            "temperature": 600.0,
+            "mol_composition": {"A": 0.9, "B": 0.09, "Va": 0.01},
+        },
+        "quantities": ["mol_composition"],
+        "n_passes": 10,
+        "sizes": [8, 16, 24],
+        "is_rejection_free": True,
+    },
+    "nfold": {
+        "program": "ccasm_clexmonte_nfold",
+        "system": "ZrO",
+        "variable_sites_per_unitcell": 2,
+        "conditions": {"temperature": 300.0, "param_chem_pot": {"a": -1.0}},
+        "quantities": ["potential_energy"],
+        "n_passes": 10,
+        "sizes": [4, 8, 12],
+        "is_rejection_free": True,
+    },
+}
+
+
+def _copy_tree(src, dest):
+    """Copy a directory, keeping files (and compiled Clexulators) already in
+    dest, so Clexulators are only compiled once per work directory"""
+    shutil.copytree(src, dest, dirs_exist_ok=True, copy_function=_copy_if_new)
+
+
+def _copy_if_new(src, dest):
+    if not os.path.exists(dest):
+        shutil.copy2(src, dest)
+
+
+def make_zro_system(work_dir):
+    """Write the ZrO system input and return its path"""
+    src = DATA_DIR / "Clex_ZrO_Occ"
+    dest = work_dir / "ZrO"
+    _copy_tree(src / "basis_sets", dest / "basis_sets")
+    _copy_if_new(src / "formation_energy_eci.json", dest / "formation_energy_eci.json")
+    with open(src / "system.json", "r") as f:
+        system = json.load(f)
+    bset_dir = dest / "basis_sets" / "bset.formation_energy"
+    system["basis_sets"]["formation_energy"]["source"] = str(
+        bset_dir / "ZrO_Clexulator_formation_energy.cc"
+    )
+    system["clex"]["formation_energy"]["coefficients"] = str(
+        dest / "formation_energy_eci.json"
+    )
+    system_path = dest / "system.json"
+    with open(system_path, "w") as f:
+        json.dump(system, f, indent=2)
+    return system_path
+
+
+def make_fcc_binary_vacancy_system(work_dir):
+    """Write the FCC A-B-Va KMC system input and return its path
+
+    This is equivalent to the input written by the KMCTestSystem unit test
+    fixture."""
+    src = DATA_DIR / "FCC_binary_vacancy"
+    dest = work_dir / "FCC_binary_vacancy"
+    _copy_tree(src / "basis_sets", dest / "basis_sets")
+    _copy_tree(src / "kmc_events", dest / "kmc_events")
+    _copy_if_new(src / "formation_energy_eci.json", dest / "formation_energy_eci.json")
+    with open(DATA_DIR / "kmc" / "system_template.json", "r") as f:
+        template = json.load(f)
+    system = {
+        "prim": template["kwargs"]["system"]["prim"],
+        "composition_axes": template["kwargs"]["system"]["composition_axes"],
+    }
+    prefix = "FCC_binary_vacancy_Clexulator_"
+    bset_dir = dest / "basis_sets" / "bset.default"
+    system["basis_sets"] = {
+        "default": {
+            "source": str(bset_dir / (prefix + "default.cc")),
+            "basis": str(bset_dir / "basis.json"),
+        }
+    }
+    system["clex"] = {
+        "formation_energy": {
+            "basis_set": "default",
+            "coefficients": str(dest / "formation_energy_eci.json"),
+        }
+    }
+    system["event_system"] = str(dest / "kmc_events" / "event_system.json")
+    system["local_basis_sets"] = {}
+    system["kmc_events"] = {}
+    for name in ["A_Va_1NN", "B_Va_1NN"]:
+        bset_dir = dest / "basis_sets" / ("bset." + name)
+        event_dir = dest / "kmc_events" / ("event." + name)
+        system["local_basis_sets"][name] = {
+            "source": str(bset_dir / (prefix + name + ".cc")),
+            "equivalents_info": str(bset_dir / "equivalents_info.json"),
+        }
+        system["kmc_events"][name] = {
+            "event": str(event_dir / "event.json"),
+            "local_basis_set": name,
+            "coefficients": {
+                "kra": str(event_dir / "kra_eci.json"),
+                "freq": str(event_dir / "freq_eci.json"),
+            },
+        }
+    system_path = dest / "system.json"
+    with open(system_path, "w") as f:
+        json.dump(system, f, indent=2)
+    return system_path
+
+
+SYSTEMS = {
+    "ZrO": make_zro_system,
+    "FCC_binary_vacancy": make_fcc_binary_vacancy_system,
+}
+
+
+def make_run_params(case, dim, n_passes, output_dir):
+    """Return run_params for a single state, run for exactly `n_passes`"""
+    conditions_increment = copy.deepcopy(case["conditions"])
+    for key, value in conditions_increment.items():
+        if isinstance(value, dict):
+            conditions_increment[key] = {k: 0.0 for k in value}
+        else:
+            conditions_increment[key] = 0.0
+    return {
+        "random_number_generator": {"seed": 0},
+        "state_generation": {
+            "method": "incremental",
+            "kwargs": {
+                "initial_configuration": {
+                    "method": "fixed",
+                    "kwargs": {
+                        "transformation_matrix_to_supercell": [
+                            [dim, 0, 0],
+                            [0, dim, 0],
+                            [0, 0, dim],
+                        ]
+                    },
+                },
+                "initial_conditions": case["conditions"],
+                "conditions_increment": conditions_increment,
+                "n_states": 1,
+                "dependent_runs": False,
+                "modifiers": [],
+            },
+        },
+        "sampling_fixtures": {
+            "thermo": {
+                "sampling": {
+                    "sample_by": "pass",
+                    "spacing": "linear",
+                    "begin": 0,
+                    "period": 1,
+                    "quantities": case["quantities"],
+                    "sample_trajectory": False,
+                },
+                "completion_check": {
+                    "cutoff": {"count": {"min": n_passes, "max": n_passes}},
+                    "begin": 0.0,
+                    "period": 10.0,
+                    "confidence": 0.95,
+                    "convergence": [],
+                },
+                "results_io": {
+                    "method": "json",
+                    "kwargs": {
+                        "output_dir": str(output_dir),
+                        "write_trajectory": False,
+                        "write_observations": False,
+                    },
+                },
+            }
+        },
+    }
+
+
+def run_program(program_path, system_path, run_params, run_dir):
+    """Run a program, returning (wall time in s, peak RSS in MiB)"""
+    if run_dir.exists():
+        shutil.rmtree(run_dir)
+    run_dir.mkdir(parents=True)
+    run_params_path = run_dir / "run_params.json"
+    with open(run_params_path, "w") as f:
+        json.dump(run_params, f, indent=2)
+
+    log_path = run_dir / "log.txt"
+    with open(log_path, "w") as log:
+        start = time.perf_counter()
+        process = subprocess.Popen(
+            [str(program_path), str(system_path), str(run_params_path)],
+            cwd=run_dir,
+            stdout=log,
+            stderr=subprocess.STDOUT,
+        )
+        _, status, rusage = os.wait4(process.pid, 0)
+        wall_time = time.perf_counter() - start
+    returncode = os.waitstatus_to_exitcode(status)
+
+    # the programs report errors on stdout, with exit status 0
+    if returncode != 0 or not (run_dir / "output").exists():
+        raise RuntimeError(
+            f"{program_path.name} failed, see {log_path}:\n" + log_path.read_text()
+        )
+
+    # ru_maxrss is in kilobytes on Linux, bytes on macOS
+    rss_scale = 1.0 / 1024.0**2 if sys.platform == "darwin" else 1.0 / 1024.0
+    return wall_time, rusage.ru_maxrss * rss_scale
+
+
+def run_case(name, case, dim, bin_dir, work_dir, system_path, repeat):
+    program_path = bin_dir / case["program"]
+    if not program_path.exists():
+        raise RuntimeError(f"program does not exist: {program_path}")
+    case_dir = work_dir / "runs" / name / str(dim)
+
+    startup_time = None
+    run_time = None
+    peak_rss = None
+    for i in range(repeat):
+        t, _ = run_program(
+            program_path,
+            system_path,
+            make_run_params(case, dim, 0, case_dir / "startup" / "output"),
+            case_dir / "startup",
+        )
+        startup_time = t if startup_time is None else min(startup_time, t)
+
+        t, rss = run_program(
+            program_path,
+            system_path,
+            make_run_params(case, dim, case["n_passes"], case_dir / "run" / "output"),
+            case_dir / "run",
+        )
+        run_time = t if run_time is None else min(run_time, t)
+        peak_rss = rss if peak_rss is None else max(peak_rss, rss)
+
+    n_steps = case["n_passes"] * case["variable_sites_per_unitcell"] * dim**3
+    steps_per_s = n_steps / max(run_time - startup_time, 1e-9)
+    return {
+        "program": case["program"],
+        "dim": dim,
+        "n_steps": n_steps,
+        "startup_time_s": startup_time,
+        "run_time_s": run_time,
+        "steps_per_s": steps_per_s,
+        "events_per_s": steps_per_s if case["is_rejection_free"] else None,
+        "peak_rss_mb": peak_rss,
+    }
+
+
+def compare_to_baseline(report, baseline, tolerance):
+    """Return regressions: throughput lower than, or startup time or peak RSS
+    higher than, the baseline by more than the fractional tolerance"""
+    regressions = []
+    lower_is_worse = ["steps_per_s"]
+    higher_is_worse = ["startup_time_s", "peak_rss_mb"]
+    for key, result in report["cases"].items():
+        if key not in baseline["cases"]:
+            continue
+        expected = baseline["cases"][key]
+        for metric in lower_is_worse + higher_is_worse:
+            value = result[metric]
+            ref = expected.get(metric)
+            if ref is None:
+                continue
+            if metric in lower_is_worse:
+                is_regression = value < ref * (1.0 - tolerance)
+            else:
+                is_regression = value > ref * (1.0 + tolerance)
+            if is_regression:
+                regressions.append(
+                    {"case": key, "metric": metric, "value": value, "baseline": ref}
+                )
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="End-to-end throughput benchmarks of the ccasm_clexmonte "
+        "programs"
+    )
+    parser.add_argument(
+        "--bin-dir",
+        type=pathlib.Path,
+        required=True,
+        help="Directory containing the ccasm_clexmonte_* programs",
+    )
+    parser.add_argument(
+        "--work-dir",
+        type=pathlib.Path,
+        default=pathlib.Path("clexmonte_benchmarks"),
+        help="Scratch directory for inputs, compiled Clexulators, and runs",
+    )
+    parser.add_argument(
+        "--output",
+        type=pathlib.Path,
+        default=None,
+        help="Report file (default: print to stdout)",
+    )
+    parser.add_argument(
+        "--baseline", type=pathlib.Path, default=None, help="Baseline report"
+    )
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.1,
+        help="Fractional change from the baseline allowed before a case is "
+        "reported as a regression (default: 0.1)",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=1,
+        help="Number of times to repeat each run, reporting the fastest",
+    )
+    parser.add_argument(
+        "--case",
+        action="append",
+        choices=list(CASES.keys()),
+        default=None,
+        help="Case to run (default: all)",
+    )
+    parser.add_argument(
+        "--size",
+        action="append",
+        type=int,
+        default=None,
+        help="Supercell size to run (default: each case's sizes)",
+    )
+    args = parser.parse_args()
+
+    work_dir = args.work_dir.resolve()
+    work_dir.mkdir(parents=True, exist_ok=True)
+    bin_dir = args.bin_dir.resolve()
+
+    system_paths = {}
+    report = {"cases": {}, "regressions": []}
+    for name in args.case or CASES.keys():
+        case = CASES[name]
+        if case["system"] not in system_paths:
+            system_paths[case["system"]] = SYSTEMS[case["system"]](work_dir)
+        for dim in args.size or case["sizes"]:
+            key = f"{name}/{dim}"
+            print(f"Running {key}...", file=sys.stderr)
+            report["cases"][key] = run_case(
+                name,
+                case,
+                dim,
+                bin_dir,
+                work_dir,
+                system_paths[case["system"]],
+                args.repeat,
+            )
+
+    if args.baseline is not None:
+        with open(args.baseline, "r") as f:
+            baseline = json.load(f)
+        report["regressions"] = compare_to_baseline(report, baseline, args.tolerance)
+
+    if args.output is None:
+        print(json.dumps(report, indent=2))
+    else:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    for r in report["regressions"]:
+        print(
+            f"Regression: {r['case']} {r['metric']}: {r['value']:.6g} "
+            f"(baseline: {r['baseline']:.6g})",
+            file=sys.stderr,
+        )
+    return 1 if report["regressions"] else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,140 @@
+#include "benchmark/benchmark.h"
+#include "benchmark_systems.hh"
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/kinetic/kinetic_events.hh"
+#include "casm/clexmonte/state/Conditions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+using namespace CASM;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// Constructed once, so the Clexulators are only compiled once
+benchmark_systems::KMCBenchmarkSystem &kmc_system() {
+  static benchmark_systems::KMCBenchmarkSystem system;
+  return system;
+}
+
+}  // namespace
+
+/// \brief Construct the complete event list and impact table
+///
+/// Args: supercell dim, ImpactTableType
+static void BM_make_complete_event_list(benchmark::State &bm) {
+  auto &sys = kmc_system();
+  auto state = sys.make_state(bm.range(0));
+  sys.make_prim_event_list();
+  monte::OccLocation occ_location(
+      get_index_conversions(*sys.get_system(), *state),
+      get_occ_candidate_list(*sys.get_system(), *state));
+  occ_location.initialize(get_occupation(*state));
+
+  CompleteEventListParams params;
+  params.impact_table_type = static_cast<ImpactTableType>(bm.range(1));
+  Index n_events = 0;
+  for (auto _ : bm) {
+    CompleteEventList event_list =
+        make_complete_event_list(sys.prim_event_list, sys.prim_impact_info_list,
+                                 occ_location, {}, params);
+    n_events = event_list.events.size();
+    benchmark::DoNotOptimize(event_list);
+  }
+  bm.counters["n_events"] = n_events;
+}
+BENCHMARK(BM_make_complete_event_list)
+    ->ArgsProduct({{4, 8, 12},
+                   {static_cast<int64_t>(ImpactTableType::map),
+                    static_cast<int64_t>(ImpactTableType::relative),
+                    static_cast<int64_t>(ImpactTableType::supercell),
+                    static_cast<int64_t>(ImpactTableType::csr)}})
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Calculate the state of each event in turn, by
+///     EventStateCalculator::calculate_event_state
+///
+/// Args: supercell dim
+static void BM_calculate_event_state(benchmark::State &bm) {
+  auto &sys = kmc_system();
+  auto state = sys.make_state(bm.range(0));
+  sys.make_complete_event_calculator(*state);
+
+  std::vector<EventID> event_ids;
+  for (auto const &event : sys.event_list.events) {
+    event_ids.push_back(event.first);
+  }
+  kinetic::EventState event_state;
+  Index i = 0;
+  for (auto _ : bm) {
+    EventID const &id = event_ids[i];
+    sys.prim_event_calculators[id.prim_event_index].calculate_event_state(
+        event_state, sys.event_list.events.at(id),
+        sys.prim_event_list[id.prim_event_index]);
+    benchmark::DoNotOptimize(event_state.rate);
+    if (++i == event_ids.size()) {
+      i = 0;
+    }
+  }
+  bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_calculate_event_state)->Arg(4)->Arg(8)->Arg(12);
+
+/// \brief Calculate the rate of each event in turn, by
+///     CompleteEventCalculator::calculate_rate
+///
+/// Args: supercell dim
+static void BM_calculate_rate(benchmark::State &bm) {
+  auto &sys = kmc_system();
+  auto state = sys.make_state(bm.range(0));
+  sys.make_complete_event_calculator(*state);
+
+  std::vector<EventID> event_ids;
+  for (auto const &event : sys.event_list.events) {
+    event_ids.push_back(event.first);
+  }
+  Index i = 0;
+  for (auto _ : bm) {
+    benchmark::DoNotOptimize(
+        sys.event_calculator->calculate_rate(event_ids[i]));
+    if (++i == event_ids.size()) {
+      i = 0;
+    }
+  }
+  bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_calculate_rate)->Arg(4)->Arg(8)->Arg(12);
+
+/// \brief One KMC step: apply an allowed event and recalculate the rates of
+///     the events it impacts, using the map impact table
+///
+/// The allowed event is chosen uniformly from the impacted events of the
+/// previous step, which, with a single vacancy, are the vacancy hops.
+///
+/// Args: supercell dim
+static void BM_kmc_step(benchmark::State &bm) {
+  auto &sys = kmc_system();
+  auto state = sys.make_state(bm.range(0));
+  sys.make_complete_event_calculator(*state);
+  Eigen::VectorXi &occupation = get_occupation(*state);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+
+  std::vector<EventID> allowed;
+  for (auto const &event : sys.event_list.events) {
+    if (sys.event_calculator->calculate_rate(event.first) > 0.0) {
+      allowed.push_back(event.first);
+    }
+  }
+  for (auto _ : bm) {
+    EventID id =
+        allowed[random_number_generator.random_int(allowed.size() - 1)];
+    sys.occ_location->apply(sys.event_list.events.at(id).event, occupation);
+    allowed.clear();
+    for (EventID const &impacted : sys.event_list.impact_table.at(id)) {
+      if (sys.event_calculator->calculate_rate(impacted) > 0.0) {
+        allowed.push_back(impacted);
+      }
+    }
+  }
+  bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_kmc_step)->Arg(4)->Arg(8)->Arg(12);
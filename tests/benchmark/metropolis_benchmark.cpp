@@ -0,0 +1,171 @@
+#include "benchmark/benchmark.h"
+#include "benchmark_systems.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/methods/neighborhood_prefetch.hh"
+#include "casm/clexmonte/methods/swap_proposal_stream.hh"
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/state/sampling_functions.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+
+using namespace CASM;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// Constructed once, so the Clexulator is only compiled once
+benchmark_systems::ZrOBenchmarkSystem &zro_system() {
+  static benchmark_systems::ZrOBenchmarkSystem system;
+  return system;
+}
+
+typedef canonical::Canonical<std::mt19937_64> calculation_type;
+
+}  // namespace
+
+/// \brief One canonical Metropolis step: propose a swap, calculate the
+///     change in potential energy, and accept or reject it
+///
+/// Args: supercell dim
+static void BM_canonical_metropolis_step(benchmark::State &bm) {
+  auto &sys = zro_system();
+  auto state = sys.make_state(bm.range(0));
+  std::shared_ptr<Conditions> conditions = make_conditions(*sys.system, *state);
+
+  monte::Conversions convert{*get_prim_basicstructure(*sys.system),
+                             get_transformation_matrix_to_super(*state)};
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> canonical_swaps =
+      make_canonical_swaps(convert, occ_candidate_list);
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(get_occupation(*state));
+
+  canonical::CanonicalPotential potential(sys.system);
+  potential.set(state.get(), conditions);
+
+  monte::OccEvent event;
+  double beta = conditions->beta;
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+  for (auto _ : bm) {
+    monte::propose_canonical_event(event, occ_location, canonical_swaps,
+                                   random_number_generator);
+    double delta_potential_energy = potential.occ_delta_per_supercell(
+        event.linear_site_index, event.new_occ);
+    if (monte::metropolis_acceptance(delta_potential_energy, beta,
+                                     random_number_generator)) {
+      occ_location.apply(event, get_occupation(*state));
+    }
+  }
+  bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_canonical_metropolis_step)->Arg(4)->Arg(8)->Arg(16);
+
+/// \brief One canonical Metropolis step, proposing swaps from a
+///     SwapProposalStream, optionally prefetching the neighborhood of the
+///     next proposal
+///
+/// Args: supercell dim, prefetch (0: no, 1: yes)
+static void BM_canonical_metropolis_step_prefetch(benchmark::State &bm) {
+  auto &sys = zro_system();
+  auto state = sys.make_state(bm.range(0));
+  bool prefetch = bm.range(1);
+  std::shared_ptr<Conditions> conditions = make_conditions(*sys.system, *state);
+
+  monte::Conversions convert{*get_prim_basicstructure(*sys.system),
+                             get_transformation_matrix_to_super(*state)};
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> canonical_swaps =
+      make_canonical_swaps(convert, occ_candidate_list);
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(get_occupation(*state));
+
+  canonical::CanonicalPotential potential(sys.system);
+  potential.set(state.get(), conditions);
+
+  SwapProposalStream stream(canonical_swaps, true, 1024);
+  auto neighbor_list = get_supercell_neighbor_list(*sys.system, *state);
+  NeighborhoodPrefetcher prefetcher(*neighbor_list, get_occupation(*state));
+
+  monte::OccEvent event;
+  double beta = conditions->beta;
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+  for (auto _ : bm) {
+    stream.propose(event, occ_location, random_number_generator);
+    if (prefetch) {
+      stream.prefetch_next(occ_location, prefetcher);
+    }
+    double delta_potential_energy = potential.occ_delta_per_supercell(
+        event.linear_site_index, event.new_occ);
+    if (monte::metropolis_acceptance(delta_potential_energy, beta,
+                                     random_number_generator)) {
+      occ_location.apply(event, get_occupation(*state));
+      stream.notify_applied(event);
+    }
+  }
+  bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_canonical_metropolis_step_prefetch)
+    ->ArgsProduct({{16, 32, 48}, {0, 1}});
+
+/// \brief Enforce a composition, starting from the default configuration
+///
+/// The reset of the occupation between iterations is not timed.
+///
+/// Args: supercell dim
+static void BM_enforce_composition(benchmark::State &bm) {
+  auto &sys = zro_system();
+  auto state = sys.make_state(bm.range(0));
+  Eigen::VectorXi initial_occupation = get_occupation(*state);
+
+  monte::OccLocation occ_location(
+      get_index_conversions(*sys.system, *state),
+      get_occ_candidate_list(*sys.system, *state));
+  Eigen::VectorXd target_mol_composition =
+      sys.system->composition_converter.mol_composition(
+          (Eigen::VectorXd(1) << 0.5).finished());
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+  for (auto _ : bm) {
+    bm.PauseTiming();
+    get_occupation(*state) = initial_occupation;
+    occ_location.initialize(get_occupation(*state));
+    bm.ResumeTiming();
+    enforce_composition(get_occupation(*state), target_mol_composition,
+                        get_composition_calculator(*sys.system),
+                        get_semigrand_canonical_swaps(*sys.system),
+                        occ_location, random_number_generator);
+  }
+}
+BENCHMARK(BM_enforce_composition)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Evaluate a standard sampling function
+///
+/// Args: supercell dim, sampling function index (0: "mol_composition", 1:
+/// "formation_energy_corr", 2: "formation_energy")
+static void BM_sampling_function(benchmark::State &bm) {
+  auto &sys = zro_system();
+  auto state = sys.make_state(bm.range(0));
+
+  auto calculation = std::make_shared<calculation_type>(sys.system);
+  calculation->state = state.get();
+  calculation->formation_energy =
+      get_clex(*sys.system, *state, "formation_energy");
+
+  std::vector<state_sampling_function_type> functions = {
+      make_mol_composition_f(calculation),
+      make_formation_energy_corr_f(calculation),
+      make_formation_energy_f(calculation)};
+  state_sampling_function_type const &f = functions[bm.range(1)];
+  bm.SetLabel(f.name);
+  for (auto _ : bm) {
+    benchmark::DoNotOptimize(f.function());
+  }
+}
+BENCHMARK(BM_sampling_function)->ArgsProduct({{4, 8, 16}, {0, 1, 2}});
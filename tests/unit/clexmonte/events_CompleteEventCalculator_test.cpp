@@ -101,3 +101,729 @@ TEST_F(events_CompleteEventCalculator_Test, Test1) {
   EXPECT_EQ(n_not_allowed, occupation.size() * 24 - 12);
   EXPECT_EQ(n_allowed, 12);
 }
+
+/// \brief Test that rates calculated using the structure-of-arrays event
+///     site storage match rates calculated using the event OccEvent
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test2) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  CompleteEventListParams params;
+  params.store_site_arrays = true;
+  CompleteEventList soa_event_list = clexmonte::make_complete_event_list(
+      prim_event_list, prim_impact_info_list, *occ_location, {}, params);
+  EXPECT_FALSE(event_list.events.has_site_arrays());
+  EXPECT_TRUE(soa_event_list.events.has_site_arrays());
+  EXPECT_FALSE(soa_event_list.events.stores_event_data());
+  EXPECT_EQ(soa_event_list.events.size(), event_list.events.size());
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  kinetic::CompleteEventCalculator soa_event_calculator(
+      prim_event_list, prim_event_calculators, soa_event_list.events);
+
+  Index n_allowed = 0;
+  for (auto const &event : event_list.events) {
+    auto const &event_id = event.first;
+    Index linear_index = soa_event_list.events.linear_index(event_id);
+    Index const *sites = soa_event_list.events.linear_site_index(linear_index);
+    Index n_sites = soa_event_list.events.n_sites(event_id.prim_event_index);
+    std::vector<Index> soa_sites(sites, sites + n_sites);
+    EXPECT_EQ(soa_sites, event.second.event.linear_site_index);
+    EXPECT_EQ(soa_event_list.events.at(event_id).event.linear_site_index,
+              event.second.event.linear_site_index);
+
+    double rate = event_calculator.calculate_rate(event_id);
+    double soa_rate = soa_event_calculator.calculate_rate(event_id);
+    EXPECT_EQ(rate, soa_rate);
+    if (event_calculator.event_state.is_allowed) {
+      ++n_allowed;
+    }
+  }
+  EXPECT_EQ(n_allowed, 12);
+}
+
+/// \brief Test that events constructed on demand match stored events
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test3) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  CompleteEventListParams params;
+  params.store_event_data = false;
+  CompleteEventList lazy_event_list = clexmonte::make_complete_event_list(
+      prim_event_list, prim_impact_info_list, *occ_location, {}, params);
+  EXPECT_TRUE(event_list.events.stores_event_data());
+  EXPECT_FALSE(lazy_event_list.events.stores_event_data());
+  EXPECT_EQ(lazy_event_list.events.size(), event_list.events.size());
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  kinetic::CompleteEventCalculator lazy_event_calculator(
+      prim_event_list, prim_event_calculators, lazy_event_list.events);
+
+  for (auto const &event : event_list.events) {
+    auto const &event_id = event.first;
+    monte::OccEvent const &expected = event.second.event;
+    monte::OccEvent const &lazy = lazy_event_list.events.at(event_id).event;
+    EXPECT_EQ(lazy.linear_site_index, expected.linear_site_index);
+    EXPECT_EQ(lazy.new_occ, expected.new_occ);
+    EXPECT_EQ(lazy.atom_traj.size(), expected.atom_traj.size());
+
+    double rate = event_calculator.calculate_rate(event_id);
+    double lazy_rate = lazy_event_calculator.calculate_rate(event_id);
+    EXPECT_EQ(rate, lazy_rate);
+  }
+}
+
+/// \brief Test that batch rate calculation matches single rate calculation
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test4) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+
+  // batch of impacted events, in impact table order (not grouped)
+  EventID selected_event_id = event_list.events.begin()->first;
+  std::vector<EventID> const &impacted =
+      event_list.impact_table.at(selected_event_id);
+  std::vector<double> rates;
+  event_calculator.calculate_rates(impacted, rates);
+  ASSERT_EQ(rates.size(), impacted.size());
+
+  // batched rates use kinetic::vectorizable_exp, which is accurate to 1e-15
+  for (Index i = 0; i < impacted.size(); ++i) {
+    double rate = event_calculator.calculate_rate(impacted[i]);
+    EXPECT_NEAR(rates[i], rate, 1e-15 * rate);
+  }
+}
+
+/// \brief Test that multithreaded rate calculation matches serial calculation
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test5) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  auto event_calculator = std::make_shared<kinetic::CompleteEventCalculator>(
+      prim_event_list, prim_event_calculators, event_list.events);
+  kinetic::ParallelCompleteEventCalculator parallel_event_calculator(
+      event_calculator, system, state, conditions, 3);
+  EXPECT_EQ(parallel_event_calculator.n_threads(), 3);
+
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+  std::vector<double> rates;
+  std::vector<double> parallel_rates;
+  event_calculator->calculate_rates(event_id_list, rates);
+  parallel_event_calculator.calculate_rates(event_id_list, parallel_rates);
+  ASSERT_EQ(parallel_rates.size(), rates.size());
+  Index n_allowed = 0;
+  for (Index i = 0; i < rates.size(); ++i) {
+    EXPECT_EQ(parallel_rates[i], rates[i]);
+    if (rates[i] > 0.0) {
+      ++n_allowed;
+    }
+  }
+  EXPECT_EQ(n_allowed, 12);
+}
+
+/// \brief Test that rates calculated using EventStateCache match
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test6) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  kinetic::CompleteEventCalculator cached_event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  cached_event_calculator.event_state_cache =
+      std::make_shared<kinetic::EventStateCache>(
+          prim_impact_info_list,
+          occ_location->convert().unitcell_index_converter());
+
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+  std::vector<double> rates;
+  std::vector<double> cached_rates;
+  event_calculator.calculate_rates(event_id_list, rates);
+
+  // first calculation fills the cache, second uses it
+  for (Index pass = 0; pass < 2; ++pass) {
+    cached_event_calculator.calculate_rates(event_id_list, cached_rates);
+    ASSERT_EQ(cached_rates.size(), rates.size());
+    for (Index i = 0; i < rates.size(); ++i) {
+      EXPECT_EQ(cached_rates[i], rates[i]);
+    }
+  }
+
+  // impacted events are marked out of date
+  EventID selected_event_id = event_id_list[0];
+  cached_event_calculator.set_occurred_event(selected_event_id);
+  Index n_out_of_date = 0;
+  for (unsigned char flags :
+       cached_event_calculator.event_state_cache->update_flags) {
+    if (flags != update_none) {
+      ++n_out_of_date;
+    }
+  }
+  EXPECT_GT(n_out_of_date, 0);
+  EXPECT_LE(n_out_of_date, 708);
+}
+
+/// \brief Test EventStateStore, with complete and compact storage
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test7) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  Index n_events = event_list.events.n_slots();
+  for (Index max_full_size : {n_events, Index(0)}) {
+    kinetic::CompleteEventCalculator event_calculator(
+        prim_event_list, prim_event_calculators, event_list.events);
+    event_calculator.event_state_store =
+        std::make_shared<kinetic::EventStateStore>(n_events, max_full_size);
+    kinetic::EventStateStore const &store = *event_calculator.event_state_store;
+    EXPECT_EQ(store.is_full(), max_full_size != 0);
+
+    Index n_allowed = 0;
+    for (auto const &event : event_list.events) {
+      Index linear_index = event_list.events.linear_index(event.first);
+      EXPECT_FALSE(store.is_calculated(linear_index));
+      double rate = event_calculator.calculate_rate(event.first);
+      EXPECT_TRUE(store.is_calculated(linear_index));
+      EXPECT_EQ(store.is_allowed(linear_index),
+                event_calculator.event_state.is_allowed);
+      EXPECT_FLOAT_EQ(store.rate(linear_index), rate);
+      if (store.is_full()) {
+        EXPECT_EQ(store.event_state(linear_index).rate, rate);
+      } else {
+        EXPECT_THROW(store.event_state(linear_index), std::runtime_error);
+      }
+      if (store.is_allowed(linear_index)) {
+        EXPECT_FLOAT_EQ(store.dE_activated(linear_index),
+                        event_calculator.event_state.dE_activated);
+        ++n_allowed;
+      }
+    }
+    EXPECT_EQ(n_allowed, 12);
+  }
+}
+
+/// \brief Test skipping impossible events and the active event set
+TEST_F(events_CompleteEventCalculator_Test, Test8) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  // B is not present, so only the A-Va hops are possible
+  std::vector<bool> is_possible =
+      find_possible_prim_events(prim_event_list, *occ_location);
+  EXPECT_EQ(std::count(is_possible.begin(), is_possible.end(), true), 12);
+
+  CompleteEventListParams params;
+  params.skip_impossible_events = true;
+  CompleteEventList skip_event_list = clexmonte::make_complete_event_list(
+      prim_event_list, prim_impact_info_list, *occ_location, {}, params);
+  EXPECT_EQ(skip_event_list.events.size() * 2, event_list.events.size());
+  for (auto const &event : skip_event_list.events) {
+    EXPECT_TRUE(is_possible[event.first.prim_event_index]);
+  }
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  kinetic::CompleteEventCalculator active_event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  active_event_calculator.active_event_set = std::make_shared<ActiveEventSet>(
+      prim_event_list, event_list.events, occupation);
+  EXPECT_EQ(active_event_calculator.active_event_set->size(), 12);
+
+  for (auto const &event : event_list.events) {
+    double rate = event_calculator.calculate_rate(event.first);
+    bool is_allowed = event_calculator.event_state.is_allowed;
+    EXPECT_EQ(active_event_calculator.calculate_rate(event.first), rate);
+    EXPECT_EQ(active_event_calculator.event_state.is_allowed, is_allowed);
+  }
+}
+
+/// \brief Test that EventStateCache may be kept when only conditions change
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test9) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state
+  Index dim = 10;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with single Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator cached_event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  cached_event_calculator.event_state_cache =
+      std::make_shared<kinetic::EventStateCache>(
+          prim_impact_info_list,
+          occ_location->convert().unitcell_index_converter());
+
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+  std::vector<double> initial_rates;
+  cached_event_calculator.calculate_rates(event_id_list, initial_rates);
+
+  // change only the temperature, keeping the cache
+  state.conditions.scalar_values.at("temperature") = 900.0;
+  auto new_conditions = make_conditions(*system, state);
+  for (auto &prim_event_calculator : prim_event_calculators) {
+    prim_event_calculator.set(&state, new_conditions);
+  }
+  std::vector<double> cached_rates;
+  cached_event_calculator.calculate_rates(event_id_list, cached_rates);
+
+  // compare to rates calculated without the cache
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  std::vector<double> rates;
+  event_calculator.calculate_rates(event_id_list, rates);
+  ASSERT_EQ(cached_rates.size(), rates.size());
+  Index n_changed = 0;
+  for (Index i = 0; i < rates.size(); ++i) {
+    EXPECT_EQ(cached_rates[i], rates[i]);
+    if (rates[i] != initial_rates[i]) {
+      ++n_changed;
+    }
+  }
+  EXPECT_EQ(n_changed, 12);
+}
+
+/// \brief Test KineticEventDataCache insertion and least recently used
+///     eviction
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 2 x 2 x 2 and 3 x 3 x 3 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test10) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default states, A with a single Va
+  Eigen::Matrix3l T_a = test::fcc_conventional_transf_mat() * 2;
+  monte::State<clexmonte::Configuration> state_a(
+      make_default_configuration(*system, T_a));
+  get_occupation(state_a)(0) = 2;
+  state_a.conditions.scalar_values.emplace("temperature", 600.0);
+
+  Eigen::Matrix3l T_b = test::fcc_conventional_transf_mat() * 3;
+  monte::State<clexmonte::Configuration> state_b(
+      make_default_configuration(*system, T_b));
+  get_occupation(state_b)(0) = 2;
+  state_b.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- Construct event data ---
+
+  make_prim_event_list();
+  auto event_data_a = std::make_shared<kinetic::KineticEventData>(system);
+  event_data_a->split_impact_neighborhoods = true;
+  make_complete_event_list(state_a);
+  event_data_a->update(state_a, make_conditions(*system, state_a),
+                       *occ_location, {});
+  std::size_t bytes_a = event_data_a->approximate_memory_usage();
+
+  auto event_data_b = kinetic::make_event_data_with_same_options(*event_data_a);
+  EXPECT_TRUE(event_data_b->split_impact_neighborhoods);
+  make_complete_event_list(state_b);
+  event_data_b->update(state_b, make_conditions(*system, state_b),
+                       *occ_location, {});
+  std::size_t bytes_b = event_data_b->approximate_memory_usage();
+  EXPECT_GT(bytes_a, 0);
+  EXPECT_GT(bytes_b, bytes_a);
+
+  /// --- Cache ---
+
+  // nothing is kept if max_bytes is 0
+  kinetic::KineticEventDataCache cache;
+  cache.insert(T_a, event_data_a);
+  EXPECT_EQ(cache.size(), 0);
+
+  cache.set_max_bytes(bytes_a + bytes_b);
+  cache.insert(T_a, event_data_a);
+  cache.insert(T_b, event_data_b);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.bytes(), bytes_a + bytes_b);
+
+  // take removes the entry
+  EXPECT_EQ(cache.take(T_a), event_data_a);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.take(T_a), nullptr);
+
+  // re-inserted a is more recently used than b, so b is evicted
+  cache.insert(T_a, event_data_a);
+  cache.set_max_bytes(bytes_a);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.take(T_b), nullptr);
+  EXPECT_EQ(cache.take(T_a), event_data_a);
+  EXPECT_EQ(cache.bytes(), 0);
+}
+
+/// \brief Test that EventRateTotals sums the calculated rates by prim event
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test11) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state, A with two Va
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * 4;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  get_occupation(state)(0) = 2;
+  get_occupation(state)(100) = 2;
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  auto event_rate_totals = std::make_shared<kinetic::EventRateTotals>(
+      event_list.events.n_slots(), prim_event_list.size());
+  event_calculator.event_rate_totals = event_rate_totals;
+
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+  std::vector<double> rates;
+  event_calculator.calculate_rates(event_id_list, rates);
+
+  std::vector<double> expected(prim_event_list.size(), 0.0);
+  for (Index i = 0; i < event_id_list.size(); ++i) {
+    expected[event_id_list[i].prim_event_index] += rates[i];
+  }
+  std::vector<double> const &totals =
+      event_rate_totals->prim_event_total_rate();
+  ASSERT_EQ(totals.size(), expected.size());
+  double total_rate = 0.0;
+  for (Index p = 0; p < expected.size(); ++p) {
+    EXPECT_NEAR(totals[p], expected[p], 1e-10 * (1.0 + expected[p]));
+    total_rate += totals[p];
+  }
+  EXPECT_GT(total_rate, 0.0);
+
+  // re-calculating one event replaces its stored rate
+  EventID const &id = event_id_list[0];
+  double rate = event_calculator.calculate_rate(id);
+  EXPECT_NEAR(totals[id.prim_event_index], expected[id.prim_event_index],
+              1e-10 * (1.0 + expected[id.prim_event_index]));
+  EXPECT_EQ(event_rate_totals->rate(event_list.events.linear_index(id)),
+            rate);
+
+  event_rate_totals->reset();
+  EXPECT_EQ(totals[id.prim_event_index], 0.0);
+}
+
+/// \brief Test that LocalEnvironmentCache gives the same rates as direct
+///     calculation
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell)
+TEST_F(events_CompleteEventCalculator_Test, Test12) {
+  using namespace clexmonte;
+  // --- State setup ---
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state, A with two Va and one B
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * 4;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  get_occupation(state)(0) = 2;
+  get_occupation(state)(100) = 2;
+  get_occupation(state)(101) = 1;
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  /// --- KMC implementation ---
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+
+  kinetic::CompleteEventCalculator event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_list.events);
+  std::vector<double> rates;
+  event_calculator.calculate_rates(event_id_list, rates);
+
+  kinetic::CompleteEventCalculator cached_event_calculator(
+      prim_event_list, prim_event_calculators, event_list.events);
+  auto cache = std::make_shared<kinetic::LocalEnvironmentCache>(
+      prim_impact_info_list, occ_location->convert().index_converter(),
+      occ_location->convert().unitcell_index_converter(), 1000);
+  cached_event_calculator.local_environment_cache = cache;
+
+  // first pass: allowed events are found or inserted
+  std::vector<double> cached_rates;
+  cached_event_calculator.calculate_rates(event_id_list, cached_rates);
+  ASSERT_EQ(cached_rates.size(), rates.size());
+  for (Index i = 0; i < rates.size(); ++i) {
+    EXPECT_NEAR(cached_rates[i], rates[i], 1e-10 * rates[i]);
+  }
+  Index n_allowed = cache->n_hits() + cache->n_misses();
+  EXPECT_GT(n_allowed, 0);
+  EXPECT_GT(cache->n_hits(), 0);
+  EXPECT_EQ(cache->size(), cache->n_misses());
+
+  // second pass: every allowed event is found
+  for (Index i = 0; i < event_id_list.size(); ++i) {
+    EXPECT_NEAR(cached_event_calculator.calculate_rate(event_id_list[i]),
+                rates[i], 1e-10 * rates[i]);
+  }
+  EXPECT_EQ(cache->n_hits() + cache->n_misses(), 2 * n_allowed);
+  EXPECT_EQ(cache->size(), cache->n_misses());
+
+  // copies have no entries or counts
+  auto copy = cache->make_empty_copy();
+  EXPECT_EQ(copy->size(), 0);
+  EXPECT_EQ(copy->n_hits(), 0);
+  EXPECT_EQ(copy->max_size(), 1000);
+}
+
+/// \brief Test NonNormalEventLog counting and example limit
+TEST(events_NonNormalEventLog_Test, Test1) {
+  for (bool async : {false, true}) {
+    std::stringstream ss;
+    kinetic::NonNormalEventLog log(3, 2, ss, async);
+    for (Index i = 0; i < 5; ++i) {
+      if (log.count(i % 3)) {
+        log.write("example " + std::to_string(i) + "\n");
+      }
+    }
+    log.flush();
+    EXPECT_EQ(ss.str(), "example 0\nexample 1\n");
+    EXPECT_EQ(log.total_count(), 5);
+    EXPECT_EQ(log.counts_by_prim_event(), std::vector<Index>({2, 2, 1}));
+    EXPECT_EQ(log.async(), async);
+  }
+}
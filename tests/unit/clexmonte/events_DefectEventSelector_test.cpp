@@ -0,0 +1,88 @@
+#include <random>
+
+#include "KMCCompleteEventCalculatorTestSystem.hh"
+#include "casm/clexmonte/events/DefectEventSelector.hh"
+#include "casm/clexmonte/kinetic/kinetic.hh"
+#include "casm/clexmonte/kinetic/kinetic_events.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+/// NOTE:
+/// - This test is designed to copy data to the same directory each time, so
+///   that the Clexulators do not need to be re-compiled.
+/// - To clear existing data, remove the directory:
+//    CASM_test_projects/FCCBinaryVacancy_default directory
+class events_DefectEventSelector_Test
+    : public test::KMCCompleteEventCalculatorTestSystem {};
+
+/// \brief Test that DefectEventSelector rates match the complete event list
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 5 x 5 x 5 (of the conventional 4-atom cell), with 3 Va
+TEST_F(events_DefectEventSelector_Test, Test1) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // --- State setup ---
+
+  // Create default state
+  Index dim = 5;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+
+  // Set configuration - A, with B and 3 Va
+  Eigen::VectorXi &occupation = get_occupation(state);
+  for (Index l = 0; l < occupation.size(); l += 7) {
+    occupation(l) = 1;
+  }
+  occupation(0) = 2;
+  occupation(50) = 2;
+  occupation(101) = 2;
+
+  // Set conditions
+  state.conditions.scalar_values.emplace("temperature", 600);
+
+  // --- KMC implementation ---
+
+  // Make calculators
+  make_complete_event_calculator(state);
+  auto on_demand_event_calculator =
+      std::make_shared<kinetic::OnDemandEventCalculator>(
+          prim_event_list, prim_event_calculators, *occ_location);
+
+  // Make selector
+  std::vector<bool> is_defect_species =
+      kinetic::make_is_defect_species(*get_event_system(*system), {"Va"});
+  DefectEventSelector<kinetic::OnDemandEventCalculator, std::mt19937_64>
+      selector(on_demand_event_calculator, prim_event_list,
+               prim_impact_info_list, is_defect_species, *occ_location,
+               std::make_shared<std::mt19937_64>(1234));
+  EXPECT_EQ(selector.n_defects(), 3);
+
+  // Run, comparing against rates calculated for every event
+  for (Index i = 0; i < 100; ++i) {
+    EventID id;
+    double time_step;
+    std::tie(id, time_step) = selector.select_event();
+    EXPECT_GT(time_step, 0.0);
+
+    double total_rate = 0.0;
+    for (auto const &event : event_list.events) {
+      double rate = event_calculator->calculate_rate(event.first);
+      EXPECT_NEAR(selector.rate(event.first), rate, 1e-10 * (1.0 + rate));
+      total_rate += rate;
+    }
+    EXPECT_NEAR(selector.total_rate(), total_rate, 1e-8 * total_rate);
+    EXPECT_GT(event_calculator->calculate_rate(id), 0.0);
+    EXPECT_EQ(selector.n_defects(), 3);
+
+    // Apply selected event
+    occ_location->apply(event_list.events.at(id).event, occupation);
+  }
+}
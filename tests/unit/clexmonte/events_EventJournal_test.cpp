@@ -0,0 +1,69 @@
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/clexmonte/events/EventJournal.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Event selector which selects random events
+struct RandomEventSelector {
+  Index n_unitcells;
+  Index n_prim_events;
+  std::mt19937_64 engine;
+
+  std::pair<clexmonte::EventID, double> select_event() {
+    clexmonte::EventID event_id{Index(engine() % n_prim_events),
+                                Index(engine() % n_unitcells)};
+    double time_increment = std::generate_canonical<double, 64>(engine);
+    return std::make_pair(event_id, time_increment);
+  }
+};
+
+}  // namespace
+
+/// \brief Test that a journaled run is replayed exactly
+TEST(events_EventJournal_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path path = tmp_dir.path() / "events.journal";
+  Index n_unitcells = 1000000;
+  Index n_prim_events = 24;
+  Index n_events = 10000;
+
+  RandomEventSelector selector{n_unitcells, n_prim_events,
+                               std::mt19937_64(1234)};
+  std::vector<std::pair<EventID, double>> expected;
+  {
+    // small buffer, so records are written in several blocks
+    auto journal = std::make_shared<EventJournalWriter>(path, n_unitcells,
+                                                        n_prim_events, 1000);
+    JournalingEventSelector<RandomEventSelector> journaling_selector(
+        selector, journal);
+    for (Index i = 0; i < n_events; ++i) {
+      expected.push_back(journaling_selector.select_event());
+    }
+    EXPECT_EQ(journal->n_events(), n_events);
+  }
+  EXPECT_LT(fs::file_size(path), 13 * n_events);
+
+  EXPECT_THROW(ReplayEventSelector(std::make_shared<EventJournalReader>(path),
+                                   n_unitcells + 1, n_prim_events),
+               std::runtime_error);
+
+  auto reader = std::make_shared<EventJournalReader>(path, 100);
+  EXPECT_EQ(reader->n_unitcells(), n_unitcells);
+  EXPECT_EQ(reader->n_prim_events(), n_prim_events);
+  ReplayEventSelector replay_selector(reader, n_unitcells, n_prim_events);
+  for (Index i = 0; i < n_events; ++i) {
+    auto result = replay_selector.select_event();
+    ASSERT_EQ(result.first, expected[i].first);
+    ASSERT_EQ(result.second, expected[i].second);
+  }
+  EXPECT_THROW(replay_selector.select_event(), std::runtime_error);
+}
@@ -0,0 +1,493 @@
+#include <cmath>
+#include <map>
+#include <random>
+
+#include "casm/clexmonte/events/EventSchedule.hh"
+#include "casm/clexmonte/events/event_selectors.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Event calculator with fixed rates spanning several orders of magnitude
+struct FixedRateCalculator {
+  Index n_prim_events;
+
+  double scale = 1.0;
+
+  double calculate_rate(clexmonte::EventID const &id) {
+    return scale * std::pow(10.0, id.prim_event_index - 2.0) *
+           (1.0 + id.unitcell_index);
+  }
+
+  void calculate_rates(std::vector<clexmonte::EventID> const &event_id_list,
+                       std::vector<double> &rates) {
+    rates.resize(event_id_list.size());
+    for (Index i = 0; i < event_id_list.size(); ++i) {
+      rates[i] = calculate_rate(event_id_list[i]);
+    }
+  }
+
+  void set_occurred_event(clexmonte::EventID const &id) {}
+};
+
+}  // namespace
+
+/// \brief Test that each event selector selects events in proportion to
+///     their rates, with mean time increment 1 / total_rate
+TEST(events_EventSelector_Test, Test1) {
+  using namespace clexmonte;
+  Index n_unitcells = 4;
+  Index n_prim_events = 3;
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    for (Index p = 0; p < n_prim_events; ++p) {
+      event_id_list.push_back(EventID{p, u});
+    }
+  }
+  std::map<EventID, std::vector<EventID>> impact_table;
+  for (EventID const &id : event_id_list) {
+    impact_table[id] = event_id_list;
+  }
+  auto calculator = std::make_shared<FixedRateCalculator>();
+  double total_rate = 0.0;
+  for (EventID const &id : event_id_list) {
+    total_rate += calculator->calculate_rate(id);
+  }
+
+  for (EventSelectorType type :
+       {EventSelectorType::sum_tree, EventSelectorType::grouped_sum_tree,
+        EventSelectorType::composition_rejection,
+        EventSelectorType::rejection}) {
+    EventSelectorParams params;
+    params.type = type;
+    params.max_rate_factor = 1.0;
+    auto engine = std::make_shared<std::mt19937_64>(1234);
+    Index n_steps = 200000;
+    std::vector<double> n_selected(event_id_list.size(), 0.0);
+    double time = 0.0;
+    run_with_event_selector(
+        params, calculator, n_unitcells, n_prim_events, event_id_list,
+        impact_table, engine, [&](auto &event_selector) {
+          for (Index i = 0; i < n_steps; ++i) {
+            auto selected = event_selector.select_event();
+            n_selected[linear_index(selected.first, n_prim_events)] += 1.0;
+            time += selected.second;
+          }
+        });
+    for (EventID const &id : event_id_list) {
+      double expected = calculator->calculate_rate(id) / total_rate;
+      EXPECT_NEAR(n_selected[linear_index(id, n_prim_events)] / n_steps,
+                  expected, 0.01);
+    }
+    EXPECT_NEAR(time / n_steps * total_rate, 1.0, 0.02);
+  }
+}
+
+/// \brief Test that SumTreeEventSelector::reset_rates recalculates all rates
+TEST(events_EventSelector_Test, Test2) {
+  using namespace clexmonte;
+  Index n_unitcells = 5;
+  Index n_prim_events = 3;
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    for (Index p = 0; p < n_prim_events; ++p) {
+      event_id_list.push_back(EventID{p, u});
+    }
+  }
+  std::map<EventID, std::vector<EventID>> impact_table;
+  for (EventID const &id : event_id_list) {
+    impact_table[id] = event_id_list;
+  }
+  auto calculator = std::make_shared<FixedRateCalculator>();
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  SumTreeEventSelector<FixedRateCalculator,
+                       std::map<EventID, std::vector<EventID>>,
+                       std::mt19937_64>
+      event_selector(calculator, n_unitcells, n_prim_events, event_id_list,
+                     impact_table, engine);
+  double total_rate = event_selector.total_rate();
+  event_selector.select_event();
+
+  calculator->scale = 2.0;
+  event_selector.reset_rates(engine);
+  EXPECT_NEAR(event_selector.total_rate(), 2.0 * total_rate, 1e-10);
+  for (EventID const &id : event_id_list) {
+    EXPECT_NEAR(event_selector.rate(id), calculator->calculate_rate(id),
+                1e-12);
+  }
+}
+
+namespace {
+
+/// Event calculator for a 1d chain, in which each event's rate depends on
+/// how often events within 2 unit cells have occurred
+struct ChainRateCalculator {
+  std::vector<Index> n_occurred;
+
+  double calculate_rate(clexmonte::EventID const &id) {
+    Index n = n_occurred.size();
+    double rate = 1.0;
+    for (Index d = -2; d <= 2; ++d) {
+      rate += 0.1 * n_occurred[(id.unitcell_index + d + n) % n];
+    }
+    return rate;
+  }
+
+  void calculate_rates(std::vector<clexmonte::EventID> const &event_id_list,
+                       std::vector<double> &rates) {
+    rates.resize(event_id_list.size());
+    for (Index i = 0; i < event_id_list.size(); ++i) {
+      rates[i] = calculate_rate(event_id_list[i]);
+    }
+  }
+
+  void set_occurred_event(clexmonte::EventID const &id) {
+    n_occurred[id.unitcell_index] += 1;
+  }
+};
+
+}  // namespace
+
+/// \brief Test SumTreeEventSelector deferred updates: events within the
+///     radius are always current, and all events are current after a flush
+TEST(events_EventSelector_Test, Test3) {
+  using namespace clexmonte;
+  Index n_unitcells = 10;
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  T(0, 0) = n_unitcells;
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+
+  // simple cubic, a=1
+  xtal::BasicStructure prim = test::no_dof_prim();
+  EventImpactInfo info;
+  info.phenomenal_sites.push_back(xtal::UnitCellCoord(0, 0, 0, 0));
+  for (Index d = -2; d <= 2; ++d) {
+    info.required_update_neighborhood.insert(xtal::UnitCellCoord(0, d, 0, 0));
+  }
+  std::vector<EventImpactInfo> prim_impact_info_list = {info};
+  RelativeEventImpactTable impact_table(prim_impact_info_list,
+                                        unitcell_converter);
+  auto immediate_table = std::make_shared<RelativeEventImpactTable>(
+      make_relative_impact_table_within(prim_impact_info_list, prim, 1.0),
+      unitcell_converter);
+
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    event_id_list.push_back(EventID{0, u});
+  }
+  auto calculator = std::make_shared<ChainRateCalculator>();
+  calculator->n_occurred.assign(n_unitcells, 0);
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  SumTreeEventSelector<ChainRateCalculator, RelativeEventImpactTable,
+                       std::mt19937_64>
+      event_selector(calculator, n_unitcells, 1, event_id_list, impact_table,
+                     engine);
+  Index update_interval = 4;
+  event_selector.set_deferred_updates(immediate_table, update_interval);
+
+  auto is_current = [&](EventID const &id) {
+    return std::abs(event_selector.rate(id) - calculator->calculate_rate(id)) <
+           1e-12;
+  };
+  EventID last_event_id = event_selector.select_event().first;
+  for (Index step = 1; step <= 40; ++step) {
+    EventID event_id = event_selector.select_event().first;
+    for (Index d = -1; d <= 1; ++d) {
+      Index u = (last_event_id.unitcell_index + d + n_unitcells) % n_unitcells;
+      EXPECT_TRUE(is_current(EventID{0, u}));
+    }
+    if (step % update_interval == 0) {
+      for (EventID const &id : event_id_list) {
+        EXPECT_TRUE(is_current(id));
+      }
+    }
+    last_event_id = event_id;
+  }
+
+  DeferredUpdateDiagnostics const &d =
+      event_selector.deferred_update_diagnostics();
+  EXPECT_EQ(d.n_flushes, 10);
+  EXPECT_EQ(d.n_deferred_updates, 2 * 40);
+  EXPECT_GT(d.max_abs_rate_error, 0.0);
+  EXPECT_GT(d.max_rel_total_rate_error, 0.0);
+}
+
+namespace {
+
+/// Event calculator for a trap: events 0 and 1 are fast hops back and
+/// forth, and event 2 is a slow escape
+struct TrapRateCalculator {
+  double calculate_rate(clexmonte::EventID const &id) {
+    return id.prim_event_index < 2 ? 100.0 : 1.0;
+  }
+
+  void calculate_rates(std::vector<clexmonte::EventID> const &event_id_list,
+                       std::vector<double> &rates) {
+    rates.resize(event_id_list.size());
+    for (Index i = 0; i < event_id_list.size(); ++i) {
+      rates[i] = calculate_rate(event_id_list[i]);
+    }
+  }
+
+  void set_occurred_event(clexmonte::EventID const &id) {}
+};
+
+}  // namespace
+
+/// \brief Test SumTreeEventSelector superbasin acceleration: recurrent
+///     event rates are only ever scaled down to within the bounds, and the
+///     escape event is selected more often than without scaling
+TEST(events_EventSelector_Test, Test4) {
+  using namespace clexmonte;
+  std::vector<EventID> event_id_list = {{0, 0}, {1, 0}, {2, 0}};
+  std::map<EventID, std::vector<EventID>> impact_table;
+  for (EventID const &id : event_id_list) {
+    impact_table[id] = event_id_list;
+  }
+  auto calculator = std::make_shared<TrapRateCalculator>();
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  SumTreeEventSelector<TrapRateCalculator,
+                       std::map<EventID, std::vector<EventID>>,
+                       std::mt19937_64>
+      event_selector(calculator, 1, 3, event_id_list, impact_table, engine);
+  SuperbasinParams params;
+  params.n_recurrence = 2;
+  params.min_scale = 1e-3;
+  event_selector.set_superbasin(params);
+
+  Index n_steps = 100000;
+  Index n_escape = 0;
+  for (Index step = 0; step < n_steps; ++step) {
+    if (event_selector.select_event().first.prim_event_index == 2) {
+      ++n_escape;
+    }
+    double total_rate = 0.0;
+    for (EventID const &id : event_id_list) {
+      double scale = event_selector.rate(id) / calculator->calculate_rate(id);
+      EXPECT_LE(scale, 1.0 + 1e-12);
+      EXPECT_GE(scale, params.min_scale * (1.0 - 1e-12));
+      total_rate += event_selector.rate(id);
+    }
+    EXPECT_NEAR(event_selector.total_rate(), total_rate, 1e-9 * total_rate);
+  }
+  // without scaling, the escape probability is 1 / 201
+  EXPECT_GT(double(n_escape) / n_steps, 0.02);
+
+  SuperbasinDiagnostics const &d = event_selector.superbasin_diagnostics();
+  EXPECT_GT(d.n_recurrences, 0);
+  EXPECT_GT(d.n_scalings, 0);
+  EXPECT_GT(d.n_exits, 0);
+  EXPECT_GT(d.scaled_time, 0.0);
+  EXPECT_LT(d.min_scale, 1.0);
+  EXPECT_GE(d.min_scale, params.min_scale);
+}
+
+/// \brief Test that RejectionEventSelector with an upper bound on rates for
+///     each prim event selects events in proportion to their rates, and
+///     counts rejected proposals
+TEST(events_EventSelector_Test, Test5) {
+  using namespace clexmonte;
+  Index n_unitcells = 4;
+  Index n_prim_events = 3;
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    for (Index p = 0; p < n_prim_events; ++p) {
+      event_id_list.push_back(EventID{p, u});
+    }
+  }
+  auto calculator = std::make_shared<FixedRateCalculator>();
+  double total_rate = 0.0;
+  for (EventID const &id : event_id_list) {
+    total_rate += calculator->calculate_rate(id);
+  }
+
+  // upper bounds are estimated for prim events without a value
+  typedef RejectionEventSelector<FixedRateCalculator, std::mt19937_64>
+      selector_type;
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  selector_type event_selector(calculator, event_id_list, {0.0, 0.5}, 0.0,
+                               2.0, engine);
+  ASSERT_EQ(event_selector.prim_event_max_rate().size(), 3);
+  EXPECT_NEAR(event_selector.prim_event_max_rate()[0], 0.08, 1e-12);
+  EXPECT_NEAR(event_selector.prim_event_max_rate()[1], 0.5, 1e-12);
+  EXPECT_NEAR(event_selector.prim_event_max_rate()[2], 8.0, 1e-12);
+
+  Index n_steps = 200000;
+  std::vector<double> n_selected(event_id_list.size(), 0.0);
+  double time = 0.0;
+  for (Index i = 0; i < n_steps; ++i) {
+    auto selected = event_selector.select_event();
+    n_selected[linear_index(selected.first, n_prim_events)] += 1.0;
+    time += selected.second;
+  }
+  for (EventID const &id : event_id_list) {
+    double expected = calculator->calculate_rate(id) / total_rate;
+    EXPECT_NEAR(n_selected[linear_index(id, n_prim_events)] / n_steps,
+                expected, 0.01);
+  }
+  EXPECT_NEAR(time / n_steps * total_rate, 1.0, 0.02);
+
+  // expected acceptance probability is total_rate / sum of upper bounds
+  RejectionDiagnostics const &d = event_selector.diagnostics();
+  EXPECT_EQ(d.n_accepted, n_steps);
+  double expected_rejection_fraction =
+      1.0 - total_rate / (n_unitcells * (0.08 + 0.5 + 8.0));
+  EXPECT_NEAR(d.rejection_fraction(), expected_rejection_fraction, 0.01);
+
+  // a rate greater than its upper bound is an error
+  selector_type bad_selector(calculator, event_id_list, {0.08, 0.5, 1.0},
+                             0.0, 2.0, engine);
+  EXPECT_THROW(
+      {
+        for (Index i = 0; i < 1000; ++i) {
+          bad_selector.select_event();
+        }
+      },
+      std::runtime_error);
+}
+
+/// \brief Test that ScheduledEventSelector disables and enables events, and
+///     changes rates, at the scheduled times
+TEST(events_EventSelector_Test, Test6) {
+  using namespace clexmonte;
+  Index n_unitcells = 4;
+  Index n_prim_events = 3;
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    for (Index p = 0; p < n_prim_events; ++p) {
+      event_id_list.push_back(EventID{p, u});
+    }
+  }
+  std::map<EventID, std::vector<EventID>> impact_table;
+  for (EventID const &id : event_id_list) {
+    impact_table[id] = event_id_list;
+  }
+  auto calculator = std::make_shared<FixedRateCalculator>();
+  double total_rate = 0.0;
+  double region_rate = 0.0;
+  for (EventID const &id : event_id_list) {
+    total_rate += calculator->calculate_rate(id);
+    if (id.unitcell_index == 3) {
+      region_rate += calculator->calculate_rate(id);
+    }
+  }
+
+  typedef SumTreeEventSelector<FixedRateCalculator,
+                               std::map<EventID, std::vector<EventID>>,
+                               std::mt19937_64>
+      selector_type;
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  selector_type event_selector(calculator, n_unitcells, n_prim_events,
+                               event_id_list, impact_table, engine);
+
+  // unit cell 3 is disabled until t1, then the rates are doubled (the
+  // "temperature" is the rate scale factor) until t2, when all events are
+  // disabled until t3
+  double t1 = 20000.0 / (total_rate - region_rate);
+  double t2 = t1 + 20000.0 / (2.0 * total_rate);
+  double t3 = t2 + 100.0;
+  std::vector<EventID> region =
+      make_region_event_id_list({3}, {}, n_prim_events);
+  std::vector<EventScheduleStep> schedule(4);
+  schedule[0].time = 0.0;
+  schedule[0].disabled_events = region;
+  schedule[1].time = t1;
+  schedule[1].enabled_events = region;
+  schedule[1].temperature = 2.0;
+  schedule[2].time = t2;
+  schedule[2].disabled_events = event_id_list;
+  schedule[3].time = t3;
+  schedule[3].enabled_events = event_id_list;
+  ScheduledEventSelector<selector_type> scheduled_selector(
+      event_selector, schedule,
+      [&](double temperature) { calculator->scale = temperature; });
+
+  double time = 0.0;
+  Index n_before = 0;
+  Index n_region_before = 0;
+  Index n_during = 0;
+  Index n_region_during = 0;
+  while (time < t2) {
+    auto selected = scheduled_selector.select_event();
+    time += selected.second;
+    bool in_region = (selected.first.unitcell_index == 3);
+    if (time < t1) {
+      ++n_before;
+      n_region_before += in_region;
+    } else if (time < t2) {
+      ++n_during;
+      n_region_during += in_region;
+    }
+  }
+  EXPECT_NEAR(time, scheduled_selector.time(), 1e-8 * time);
+  EXPECT_EQ(n_region_before, 0);
+  EXPECT_NEAR(n_before / 20000.0, 1.0, 0.05);
+  EXPECT_NEAR(n_during / 20000.0, 1.0, 0.05);
+  EXPECT_NEAR(double(n_region_during) / n_during, region_rate / total_rate,
+              0.02);
+
+  // no events are enabled from t2 to t3, so the first event after t2
+  // occurs after t3
+  EXPECT_GT(time, t3);
+  EXPECT_EQ(scheduled_selector.n_steps_applied(), 4);
+  EXPECT_TRUE(event_selector.is_enabled(EventID{0, 3}));
+}
+
+/// \brief Test bulk rate updates and rebuilds of SumTreeEventSelector
+TEST(events_EventSelector_Test, Test7) {
+  using namespace clexmonte;
+  Index n_unitcells = 37;
+  Index n_prim_events = 3;
+  std::vector<EventID> event_id_list;
+  for (Index u = 0; u < n_unitcells; ++u) {
+    for (Index p = 0; p < n_prim_events; ++p) {
+      if (u % 5 != 4) {
+        event_id_list.push_back(EventID{p, u});
+      }
+    }
+  }
+  std::map<EventID, std::vector<EventID>> impact_table;
+  for (EventID const &id : event_id_list) {
+    impact_table[id] = {id};
+  }
+  auto calculator = std::make_shared<FixedRateCalculator>();
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  SumTreeEventSelector<FixedRateCalculator,
+                       std::map<EventID, std::vector<EventID>>,
+                       std::mt19937_64>
+      event_selector(calculator, n_unitcells, n_prim_events, event_id_list,
+                     impact_table, engine);
+
+  // rebuild with rates set by the caller, on several threads
+  std::vector<double> rates;
+  double total_rate = 0.0;
+  for (Index k = 0; k < event_id_list.size(); ++k) {
+    rates.push_back(1.0 + k);
+    total_rate += rates.back();
+  }
+  event_selector.set_n_threads(4);
+  event_selector.rebuild(rates);
+  EXPECT_NEAR(event_selector.total_rate(), total_rate, 1e-10 * total_rate);
+  EXPECT_EQ(event_selector.rate(event_id_list[5]), 6.0);
+  EXPECT_THROW(event_selector.rebuild({1.0}), std::runtime_error);
+
+  // set a batch of rates, with a repeated event and an event which is not
+  // in the event list
+  std::vector<EventID> batch = {event_id_list[7], EventID{1, 4},
+                                event_id_list[2], event_id_list[7]};
+  event_selector.set_rates(batch, {100.0, 100.0, 0.0, 50.0});
+  total_rate += 50.0 - 8.0 - 3.0;
+  EXPECT_NEAR(event_selector.total_rate(), total_rate, 1e-10 * total_rate);
+  EXPECT_EQ(event_selector.rate(event_id_list[7]), 50.0);
+  EXPECT_EQ(event_selector.rate(event_id_list[2]), 0.0);
+  EXPECT_EQ(event_selector.rate(EventID{1, 4}), 0.0);
+
+  for (Index i = 0; i < 1000; ++i) {
+    auto selected = event_selector.select_event();
+    EXPECT_NE(selected.first.unitcell_index % 5, 4);
+    EXPECT_FALSE(selected.first == event_id_list[2]);
+  }
+}
@@ -51,6 +51,14 @@ class events_EventStateCalculator_Test
         kinetic::make_prim_event_calculators(system, state, prim_event_list,
                                              conditions);
     EXPECT_EQ(prim_event_calculators.size(), 24);
+    for (Index i = 0; i < prim_event_list.size(); ++i) {
+      for (Index j = 0; j < prim_event_list.size(); ++j) {
+        EXPECT_EQ(prim_event_calculators[i].is_shared_with(
+                      prim_event_calculators[j]),
+                  prim_event_list[i].event_type_name ==
+                      prim_event_list[j].event_type_name);
+      }
+    }
     // std::cout << "#prim event calculators: " << prim_event_calculators.size()
     //           << std::endl;
 
@@ -110,3 +118,66 @@ TEST_F(events_EventStateCalculator_Test, Test2) {
   setup_input_files(true /*use_sparse_format_eci*/);
   run_checks();
 }
+
+/// \brief Test calculating event states with fixed and BEP barrier models
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 10 x 10 x 10 (of the conventional 4-atom cell)
+TEST_F(events_EventStateCalculator_Test, Test3) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  // Create default state - A, with single Va
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * 10;
+  state_type state(make_default_configuration(*system, T));
+  get_occupation(state)(0) = 2;
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+  auto conditions = make_conditions(*system, state);
+
+  kinetic::BarrierModel fixed;
+  fixed.type = kinetic::BarrierModelType::fixed;
+  fixed.barrier = 0.7;
+  kinetic::BarrierModel bep;
+  bep.type = kinetic::BarrierModelType::bep;
+  bep.intercept = 0.6;
+  bep.slope = 0.25;
+
+  for (kinetic::BarrierModel const &model : {fixed, bep}) {
+    std::map<std::string, kinetic::BarrierModel> barrier_models;
+    for (auto const &prim_event_data : prim_event_list) {
+      barrier_models[prim_event_data.event_type_name] = model;
+    }
+    std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+        kinetic::make_prim_event_calculators(system, state, prim_event_list,
+                                             conditions, barrier_models);
+
+    // dE_final is 0.0 for all allowed events
+    double expected_dE_activated = model.intercept;
+    if (model.type == kinetic::BarrierModelType::fixed) {
+      expected_dE_activated = model.barrier;
+    }
+    double expected_rate =
+        1e12 * std::exp(-conditions->beta * expected_dE_activated);
+
+    Index n_allowed = 0;
+    kinetic::EventState event_state;
+    for (auto const &event : event_list.events) {
+      auto const &event_id = event.first;
+      prim_event_calculators[event_id.prim_event_index].calculate_event_state(
+          event_state, event.second,
+          prim_event_list[event_id.prim_event_index]);
+      if (event_state.is_allowed) {
+        EXPECT_TRUE(CASM::almost_equal(event_state.dE_activated,
+                                       expected_dE_activated));
+        EXPECT_TRUE(event_state.is_normal);
+        EXPECT_NEAR(event_state.rate, expected_rate, 1e-12 * expected_rate);
+        ++n_allowed;
+      }
+    }
+    EXPECT_EQ(n_allowed, 12);
+  }
+}
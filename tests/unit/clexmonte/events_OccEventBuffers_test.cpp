@@ -0,0 +1,122 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "KMCCompleteEventListTestSystem.hh"
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+// --- Counting allocator ---
+//
+// Replaces the global operator new/delete for the test executable. Heap
+// allocations are only counted on a thread while `count_allocations` is set.
+
+namespace {
+
+std::atomic<Index> n_allocations(0);
+thread_local bool count_allocations = false;
+
+/// \brief Count heap allocations made on this thread during its lifetime
+struct AllocationCounter {
+  AllocationCounter() : m_begin(n_allocations.load()) {
+    count_allocations = true;
+  }
+  ~AllocationCounter() { count_allocations = false; }
+
+  Index count() const { return n_allocations.load() - m_begin; }
+
+ private:
+  Index m_begin;
+};
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  if (count_allocations) {
+    ++n_allocations;
+  }
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+/// NOTE:
+/// - This test is designed to copy data to the same directory each time, so
+///   that the Clexulators do not need to be re-compiled.
+/// - To clear existing data, remove the directory:
+//    CASM_test_projects/FCCBinaryVacancy_default directory
+class events_OccEventBuffers_Test
+    : public test::KMCCompleteEventListTestSystem {};
+
+/// \brief Test that getting events in the steady state of a KMC or N-fold
+///     way run does not allocate
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell)
+TEST_F(events_OccEventBuffers_Test, Test1) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  Index dim = 4;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+
+  std::vector<EventID> event_id_list;
+  for (auto const &event : event_list.events) {
+    event_id_list.push_back(event.first);
+  }
+  ASSERT_GT(event_id_list.size(), 0);
+
+  // Stored events: get_event_f returns a reference to the stored event
+  auto get_event_f = [&](EventID const &id) -> monte::OccEvent const & {
+    return event_list.events.at(id).event;
+  };
+  Index n_sites = 0;
+  Index n_allocations_stored = 0;
+  {
+    AllocationCounter counter;
+    for (auto const &id : event_id_list) {
+      n_sites += get_event_f(id).linear_site_index.size();
+    }
+    n_allocations_stored = counter.count();
+  }
+  EXPECT_EQ(n_allocations_stored, 0);
+  EXPECT_GT(n_sites, 0);
+
+  // Events built on demand: the builder's buffers are reused once they have
+  // grown to hold the largest event
+  EventDataBuilder builder(prim_event_list, *occ_location);
+  for (auto const &id : event_id_list) {
+    builder(id);
+  }
+  bool all_equal = true;
+  Index n_allocations_on_demand = 0;
+  {
+    AllocationCounter counter;
+    for (auto const &id : event_id_list) {
+      EventData const &event_data = builder(id);
+      all_equal = all_equal &&
+                  event_data.event.linear_site_index ==
+                      event_list.events.at(id).event.linear_site_index;
+    }
+    n_allocations_on_demand = counter.count();
+  }
+  EXPECT_EQ(n_allocations_on_demand, 0);
+  EXPECT_TRUE(all_equal);
+}
@@ -0,0 +1,109 @@
+#include "casm/clexmonte/events/SharedImpactTable.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// One prim event, a nearest neighbor pair along a, impacting events with a
+/// phenomenal site within one unit cell along a
+std::vector<clexmonte::EventImpactInfo> make_prim_impact_info_list() {
+  clexmonte::EventImpactInfo impact;
+  impact.phenomenal_sites = {xtal::UnitCellCoord(0, 0, 0, 0),
+                             xtal::UnitCellCoord(0, 1, 0, 0)};
+  impact.required_update_neighborhood = {
+      xtal::UnitCellCoord(0, -1, 0, 0), xtal::UnitCellCoord(0, 0, 0, 0),
+      xtal::UnitCellCoord(0, 1, 0, 0), xtal::UnitCellCoord(0, 2, 0, 0)};
+  impact.clex_update_neighborhood = impact.required_update_neighborhood;
+  return {impact};
+}
+
+void expect_equal(clexmonte::CsrEventImpactTable const &table,
+                  clexmonte::CsrEventImpactTable const &expected) {
+  ASSERT_EQ(table.n_prim_events(), expected.n_prim_events());
+  ASSERT_EQ(table.n_offsets(), expected.n_offsets());
+  ASSERT_EQ(table.n_impacted(), expected.n_impacted());
+  for (Index i = 0; i < expected.n_offsets(); ++i) {
+    EXPECT_EQ(table.offsets()[i], expected.offsets()[i]);
+  }
+  for (Index i = 0; i < expected.n_impacted(); ++i) {
+    EXPECT_EQ(table.impacted()[i].key, expected.impacted()[i].key);
+  }
+}
+
+}  // namespace
+
+/// \brief Test writing, mapping, and reusing a shared impact table file
+TEST(events_SharedImpactTable_Test, Test1) {
+  test::TmpDir tmp_dir;
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  auto prim_impact_info_list = make_prim_impact_info_list();
+
+  clexmonte::CsrEventImpactTable expected(prim_impact_info_list,
+                                          unitcell_converter);
+  EXPECT_EQ(expected.n_offsets(), 64 + 1);
+  EXPECT_GT(expected.n_impacted(), 0);
+
+  auto table = clexmonte::make_shared_csr_event_impact_table(
+      prim_impact_info_list, unitcell_converter, T, tmp_dir.path());
+  ASSERT_TRUE(table != nullptr);
+  expect_equal(*table, expected);
+
+  // a second call maps the existing file
+  std::string key =
+      clexmonte::make_shared_impact_table_key(prim_impact_info_list, T);
+  fs::path path = tmp_dir.path() / ("csr_impact_table." + key + ".bin");
+  EXPECT_TRUE(fs::exists(path));
+  auto mapped = clexmonte::make_shared_csr_event_impact_table(
+      prim_impact_info_list, unitcell_converter, T, tmp_dir.path());
+  ASSERT_TRUE(mapped != nullptr);
+  expect_equal(*mapped, expected);
+
+  clexmonte::EventID id;
+  id.prim_event_index = 0;
+  id.unitcell_index = 5;
+  ASSERT_EQ((*mapped)(id).size(), expected(id).size());
+
+  // a different supercell has a different key
+  Eigen::Matrix3l T2 = Eigen::Matrix3l::Identity() * 3;
+  EXPECT_NE(clexmonte::make_shared_impact_table_key(prim_impact_info_list, T2),
+            key);
+  EXPECT_TRUE(clexmonte::map_csr_event_impact_table(
+                  path, clexmonte::make_shared_impact_table_key(
+                            prim_impact_info_list, T2)) == nullptr);
+}
+
+/// \brief Test that impact tables constructed by several threads are
+///     identical to those constructed by one thread
+TEST(events_SharedImpactTable_Test, Test2) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 5;
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  auto prim_impact_info_list = make_prim_impact_info_list();
+  clexmonte::RelativeEventImpactTable relative(prim_impact_info_list,
+                                               unitcell_converter);
+
+  clexmonte::CsrEventImpactTable expected(prim_impact_info_list,
+                                          unitcell_converter, 1);
+  clexmonte::SupercellEventImpactTable supercell(prim_impact_info_list,
+                                                 unitcell_converter, 4);
+  for (Index n_threads : {2, 3, 8, 200}) {
+    clexmonte::CsrEventImpactTable table(prim_impact_info_list,
+                                         unitcell_converter, n_threads);
+    expect_equal(table, expected);
+  }
+
+  clexmonte::EventID id;
+  id.prim_event_index = 0;
+  for (Index l = 0; l < unitcell_converter.total_sites(); ++l) {
+    id.unitcell_index = l;
+    std::vector<clexmonte::EventID> impacted = relative(id);
+    auto csr_impacted = expected(id);
+    ASSERT_EQ(csr_impacted.size(), impacted.size());
+    for (Index i = 0; i < impacted.size(); ++i) {
+      EXPECT_EQ(clexmonte::unpack(csr_impacted.begin()[i]), impacted[i]);
+    }
+    ASSERT_EQ(supercell(id), impacted);
+  }
+}
@@ -0,0 +1,198 @@
+#include <map>
+#include <random>
+
+#include "casm/clexmonte/events/SublatticeDecomposition.hh"
+#include "casm/clexmonte/events/SynchronousSublatticeEventSelector.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// One prim event on a single site, impacting events with a phenomenal site
+/// within `range` unit cells along a
+std::vector<clexmonte::EventImpactInfo> make_prim_impact_info_list(
+    Index range) {
+  clexmonte::EventImpactInfo impact;
+  impact.phenomenal_sites = {xtal::UnitCellCoord(0, 0, 0, 0)};
+  for (Index i = -range; i <= range; ++i) {
+    impact.required_update_neighborhood.emplace(0, i, 0, 0);
+  }
+  return {impact};
+}
+
+/// Flip events on a periodic chain of `n` sites: prim event 0 sets the
+/// occupation 0 -> 1, with rate 1.0, and prim event 1 sets it 1 -> 0, with a
+/// rate that increases with the number of occupied neighbors.
+struct ChainFlipCalculator {
+  ChainFlipCalculator(Eigen::VectorXi const &_occupation)
+      : occupation(_occupation) {}
+
+  Eigen::VectorXi const &occupation;
+
+  double calculate_rate(clexmonte::EventID const &id) {
+    Index n = occupation.size();
+    Index u = id.unitcell_index;
+    int initial = (id.prim_event_index == 0) ? 0 : 1;
+    if (occupation(u) != initial) {
+      return 0.0;
+    }
+    if (id.prim_event_index == 0) {
+      return 1.0;
+    }
+    return 0.5 + occupation((u + 1) % n) + occupation((u + n - 1) % n);
+  }
+
+  void calculate_rates(std::vector<clexmonte::EventID> const &event_id_list,
+                       std::vector<double> &rates) {
+    rates.resize(event_id_list.size());
+    for (Index i = 0; i < event_id_list.size(); ++i) {
+      rates[i] = calculate_rate(event_id_list[i]);
+    }
+  }
+
+  void set_occurred_event(clexmonte::EventID const &id) {}
+};
+
+struct ChainFlipEvents {
+  ChainFlipEvents(Index n) {
+    event_list.data.resize(2 * n);
+    for (Index u = 0; u < n; ++u) {
+      for (Index p = 0; p < 2; ++p) {
+        clexmonte::EventID id{p, u};
+        event_id_list.push_back(id);
+        clexmonte::EventData &data =
+            event_list.data[clexmonte::linear_index(id, 2)];
+        data.unitcell_index = u;
+        data.event.linear_site_index = {u};
+        data.event.new_occ = {(p == 0) ? 1 : 0};
+        for (Index du = -1; du <= 1; ++du) {
+          for (Index q = 0; q < 2; ++q) {
+            impact_table[id].push_back({q, (u + du + n) % n});
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<clexmonte::EventID> event_id_list;
+  clexmonte::EventDataList event_list;
+  std::map<clexmonte::EventID, std::vector<clexmonte::EventID>> impact_table;
+};
+
+/// Run `n_steps` events with `n_threads` threads, checking each is allowed,
+/// and return the time-averaged fraction of occupied sites
+double run_chain(Index n_threads, Index n_steps,
+                 std::vector<clexmonte::EventID> *selected = nullptr) {
+  typedef clexmonte::SynchronousSublatticeEventSelector<
+      ChainFlipCalculator,
+      std::map<clexmonte::EventID, std::vector<clexmonte::EventID>>,
+      std::mt19937_64>
+      selector_type;
+  Index n = 40;
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(n);
+  ChainFlipEvents events(n);
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  T(0, 0) = n;
+  auto decomposition = std::make_shared<clexmonte::SublatticeDecomposition>(
+      T, clexmonte::event_impact_reach(make_prim_impact_info_list(1)), 2,
+      events.event_id_list);
+  std::vector<std::shared_ptr<ChainFlipCalculator>> calculators;
+  for (Index i = 0; i < n_threads; ++i) {
+    calculators.push_back(std::make_shared<ChainFlipCalculator>(occupation));
+  }
+  selector_type event_selector(
+      calculators, decomposition, 2, events.impact_table, events.event_list,
+      occupation, 0.2, std::make_shared<std::mt19937_64>(1));
+
+  double time = 0.0;
+  double occupied_time = 0.0;
+  for (Index i = 0; i < n_steps; ++i) {
+    auto result = event_selector.select_event();
+    clexmonte::EventID const &id = result.first;
+    EXPECT_GE(result.second, 0.0);
+    int initial = (id.prim_event_index == 0) ? 0 : 1;
+    EXPECT_EQ(occupation(id.unitcell_index), initial);
+    occupied_time += result.second * occupation.sum();
+    time += result.second;
+    occupation(id.unitcell_index) = 1 - initial;
+    if (selected) {
+      selected->push_back(id);
+    }
+  }
+  EXPECT_EQ(event_selector.diagnostics().n_events, n_steps);
+  return occupied_time / time / n;
+}
+
+}  // namespace
+
+/// \brief Test the impact reach and assignment of events to tasks
+TEST(events_SynchronousSublattice_Test, Test1) {
+  auto reach = clexmonte::event_impact_reach(make_prim_impact_info_list(2));
+  EXPECT_EQ(reach(0), 2);
+  EXPECT_EQ(reach(1), 0);
+  EXPECT_EQ(reach(2), 0);
+
+  Index n = 24;
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  T(0, 0) = n;
+  T(1, 1) = 2;
+  std::vector<clexmonte::EventID> event_id_list;
+  for (Index u = 0; u < 2 * n; ++u) {
+    event_id_list.push_back({0, u});
+  }
+  clexmonte::SublatticeDecomposition decomposition(T, reach, 1,
+                                                   event_id_list);
+
+  // 24 / (2 * (2 + 1)) = 4 domains along a, 1 along b and c
+  EXPECT_EQ(decomposition.domain_shape(), Eigen::Vector3l(4, 1, 1));
+  EXPECT_EQ(decomposition.n_domains(), 4);
+  EXPECT_EQ(decomposition.n_sectors(), 2);
+  EXPECT_EQ(decomposition.n_tasks(), 8);
+
+  Index n_assigned = 0;
+  for (Index task = 0; task < decomposition.n_tasks(); ++task) {
+    auto const &task_events = decomposition.task_events(task);
+    EXPECT_EQ(task_events.size(), 6);
+    for (Index i = 0; i < task_events.size(); ++i) {
+      Index l = clexmonte::linear_index(task_events[i], 1);
+      EXPECT_EQ(decomposition.task_index(l), task);
+      EXPECT_EQ(decomposition.local_index(l), i);
+    }
+    n_assigned += task_events.size();
+  }
+  EXPECT_EQ(n_assigned, event_id_list.size());
+}
+
+/// \brief Test invalid decompositions
+TEST(events_SynchronousSublattice_Test, Test2) {
+  auto reach = clexmonte::event_impact_reach(make_prim_impact_info_list(2));
+  std::vector<clexmonte::EventID> event_id_list;
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 12;
+
+  // too many domains: sectors narrower than reach + 1
+  EXPECT_THROW(clexmonte::SublatticeDecomposition(
+                   T, reach, 1, event_id_list, Eigen::Vector3l(4, 1, 1)),
+               std::runtime_error);
+
+  // non-diagonal transformation matrix
+  T(0, 1) = 1;
+  EXPECT_THROW(
+      clexmonte::SublatticeDecomposition(T, reach, 1, event_id_list),
+      std::runtime_error);
+}
+
+/// \brief Test that selected events are allowed, that results do not depend
+///     on the number of threads, and that the equilibrium occupation is
+///     close to that of a serial calculation
+TEST(events_SynchronousSublattice_Test, Test3) {
+  std::vector<clexmonte::EventID> selected_1;
+  std::vector<clexmonte::EventID> selected_3;
+  double mean_1 = run_chain(1, 200000, &selected_1);
+  double mean_3 = run_chain(3, 200000, &selected_3);
+  EXPECT_EQ(mean_1, mean_3);
+  EXPECT_TRUE(selected_1 == selected_3);
+
+  // serial calculations give ~0.4545
+  EXPECT_NEAR(mean_1, 0.4545, 0.01);
+}
@@ -3,6 +3,7 @@
 
 // impact table & event lists
 #include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/PrimImpactInfoSnapshot.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/monte/events/OccLocation.hh"
@@ -49,6 +50,33 @@ TEST_F(events_impact_table_Test, Test1) {
   EXPECT_EQ(prim_impact_info_list.size(), 24);
   for (auto const &impact : prim_impact_info_list) {
     EXPECT_EQ(impact.required_update_neighborhood.size(), 20);
+
+    // required_update_neighborhood is the union of the split neighborhoods
+    std::set<xtal::UnitCellCoord> expected =
+        impact.local_clex_update_neighborhood;
+    expected.insert(impact.clex_update_neighborhood.begin(),
+                    impact.clex_update_neighborhood.end());
+    EXPECT_EQ(impact.required_update_neighborhood, expected);
+  }
+
+  // split update table has the same impacted events as the impact table
+  std::vector<std::vector<clexmonte::RelativeEventID>> relative_impact_table =
+      clexmonte::make_relative_impact_table(prim_impact_info_list);
+  std::vector<std::vector<clexmonte::RelativeEventUpdate>>
+      relative_update_table =
+          clexmonte::make_relative_update_table(prim_impact_info_list);
+  ASSERT_EQ(relative_update_table.size(), relative_impact_table.size());
+  for (Index i = 0; i < relative_impact_table.size(); ++i) {
+    ASSERT_EQ(relative_update_table[i].size(),
+              relative_impact_table[i].size());
+    for (Index j = 0; j < relative_impact_table[i].size(); ++j) {
+      auto const &update = relative_update_table[i][j];
+      EXPECT_EQ(update.event.prim_event_index,
+                relative_impact_table[i][j].prim_event_index);
+      EXPECT_EQ(update.event.translation,
+                relative_impact_table[i][j].translation);
+      EXPECT_NE(update.flags, clexmonte::update_none);
+    }
   }
 
   // Create config
@@ -67,6 +95,21 @@ TEST_F(events_impact_table_Test, Test1) {
     EXPECT_EQ(impacted.second.size(), 708);
   }
   EXPECT_EQ(event_list.events.size(), 1000 * 24);
+  EXPECT_EQ(event_list.events.n_prim_events(), 24);
+  EXPECT_EQ(event_list.events.n_unitcells(), 1000);
+
+  // dense storage is addressed by unitcell_index * n_prim_events +
+  // prim_event_index
+  Index n_iterated = 0;
+  for (auto const &event : event_list.events) {
+    clexmonte::EventID const &id = event.first;
+    Index linear_index = event_list.events.linear_index(id);
+    EXPECT_EQ(linear_index, id.unitcell_index * 24 + id.prim_event_index);
+    EXPECT_EQ(&event_list.events[linear_index], &event.second);
+    EXPECT_EQ(event.second.unitcell_index, id.unitcell_index);
+    ++n_iterated;
+  }
+  EXPECT_EQ(n_iterated, 1000 * 24);
 }
 
 /// \brief Simpler test:
@@ -128,6 +171,210 @@ TEST_F(events_impact_table_Test, Test2) {
   EXPECT_EQ(event_list.events.size(), 1000 * 12);
 }
 
+/// \brief Impact table types: Supercell and CSR tables match Relative table
+TEST_F(events_impact_table_Test, Test4) {
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  std::vector<clexmonte::PrimEventData> prim_event_list =
+      make_prim_event_list(*system);
+  std::vector<clexmonte::EventImpactInfo> prim_impact_info_list =
+      make_prim_impact_info_list(*system, prim_event_list,
+                                 {"formation_energy"});
+
+  // Create config
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 5;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  monte::OccLocation occ_location{get_index_conversions(*system, state),
+                                  get_occ_candidate_list(*system, state)};
+  occ_location.initialize(get_occupation(state));
+
+  clexmonte::CompleteEventListParams params;
+  params.impact_table_type = clexmonte::ImpactTableType::csr;
+  clexmonte::CompleteEventList event_list = clexmonte::make_complete_event_list(
+      prim_event_list, prim_impact_info_list, occ_location, {}, params);
+  EXPECT_EQ(event_list.impact_table.size(), 0);
+  ASSERT_TRUE(event_list.csr_impact_table != nullptr);
+  EXPECT_EQ(event_list.csr_impact_table->n_impacted(), 125 * 24 * 708);
+
+  auto const &unitcell_converter =
+      occ_location.convert().unitcell_index_converter();
+  clexmonte::RelativeEventImpactTable relative_table(prim_impact_info_list,
+                                                     unitcell_converter);
+  clexmonte::SupercellEventImpactTable supercell_table(prim_impact_info_list,
+                                                       unitcell_converter);
+  clexmonte::CsrEventImpactTable const &csr_table =
+      *event_list.csr_impact_table;
+
+  for (clexmonte::EventID const &id :
+       clexmonte::make_included_event_id_list(event_list.events)) {
+    std::vector<clexmonte::EventID> const &expected = relative_table(id);
+    std::vector<clexmonte::EventID> const &supercell_impacted =
+        supercell_table(id);
+    clexmonte::PackedEventIDRange csr_impacted = csr_table(id);
+    ASSERT_EQ(supercell_impacted.size(), expected.size());
+    ASSERT_EQ(csr_impacted.size(), expected.size());
+    for (Index i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(supercell_impacted[i], expected[i]);
+      EXPECT_EQ(clexmonte::unpack(csr_impacted.begin()[i]), expected[i]);
+    }
+  }
+}
+
+/// \brief Excluded events are removed from impact tables
+TEST_F(events_impact_table_Test, EventFilters) {
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  std::vector<clexmonte::PrimEventData> prim_event_list =
+      make_prim_event_list(*system);
+  std::vector<clexmonte::EventImpactInfo> prim_impact_info_list =
+      make_prim_impact_info_list(*system, prim_event_list,
+                                 {"formation_energy"});
+
+  // Create config
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 5;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  monte::OccLocation occ_location{get_index_conversions(*system, state),
+                                  get_occ_candidate_list(*system, state)};
+  occ_location.initialize(get_occupation(state));
+
+  // exclude prim event 0 in unit cells 0-9, include only prim event 1 in
+  // unit cells 10-19
+  clexmonte::EventFilterGroup exclude_filter;
+  exclude_filter.include_by_default = true;
+  exclude_filter.prim_event_index = {0};
+  clexmonte::EventFilterGroup include_filter;
+  include_filter.include_by_default = false;
+  include_filter.prim_event_index = {1};
+  for (Index l = 0; l < 10; ++l) {
+    exclude_filter.unitcell_index.insert(l);
+    include_filter.unitcell_index.insert(l + 10);
+  }
+  std::vector<clexmonte::EventFilterGroup> event_filters = {exclude_filter,
+                                                            include_filter};
+
+  clexmonte::EventFilterIndex filter_index(event_filters, 125, 24);
+  EXPECT_FALSE(filter_index.is_included(0, 0));
+  EXPECT_TRUE(filter_index.is_included(0, 1));
+  EXPECT_FALSE(filter_index.is_included(10, 0));
+  EXPECT_TRUE(filter_index.is_included(10, 1));
+  EXPECT_FALSE(filter_index.is_included(10, 2));
+  EXPECT_TRUE(filter_index.is_included(20, 0));
+  EXPECT_FALSE(filter_index.is_excluded_everywhere(0));
+
+  Index n_included = 125 * 24 - 10 - 10 * 23;
+  for (auto type : {clexmonte::ImpactTableType::map,
+                    clexmonte::ImpactTableType::supercell,
+                    clexmonte::ImpactTableType::csr}) {
+    clexmonte::CompleteEventListParams params;
+    params.impact_table_type = type;
+    clexmonte::CompleteEventList event_list =
+        clexmonte::make_complete_event_list(prim_event_list,
+                                            prim_impact_info_list,
+                                            occ_location, event_filters,
+                                            params);
+    clexmonte::EventDataList const &events = event_list.events;
+    EXPECT_EQ(events.size(), n_included);
+
+    clexmonte::SupercellEventImpactTable unfiltered_table(
+        prim_impact_info_list,
+        occ_location.convert().unitcell_index_converter());
+    Index n_impacted = 0;
+    for (clexmonte::EventID const &id :
+         clexmonte::make_included_event_id_list(events)) {
+      std::vector<clexmonte::EventID> expected;
+      for (clexmonte::EventID const &impacted_id : unfiltered_table(id)) {
+        if (events.count(impacted_id)) {
+          expected.push_back(impacted_id);
+        }
+      }
+      std::vector<clexmonte::EventID> impacted;
+      if (type == clexmonte::ImpactTableType::map) {
+        impacted = event_list.impact_table.at(id);
+      } else if (type == clexmonte::ImpactTableType::supercell) {
+        impacted = (*event_list.supercell_impact_table)(id);
+      } else {
+        for (auto const &packed_id : (*event_list.csr_impact_table)(id)) {
+          impacted.push_back(clexmonte::unpack(packed_id));
+        }
+      }
+      EXPECT_EQ(impacted, expected);
+      n_impacted += impacted.size();
+    }
+    EXPECT_LT(n_impacted, n_included * 708);
+    if (type == clexmonte::ImpactTableType::csr) {
+      EXPECT_EQ(event_list.csr_impact_table->n_impacted(), n_impacted);
+    }
+  }
+}
+
+/// \brief Prim impact info snapshot is written, then read back unchanged
+TEST_F(events_impact_table_Test, Snapshot) {
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  std::vector<clexmonte::PrimEventData> prim_event_list =
+      make_prim_event_list(*system);
+  std::vector<clexmonte::EventImpactInfo> expected =
+      make_prim_impact_info_list(*system, prim_event_list,
+                                 {"formation_energy"});
+
+  fs::path snapshot_path = test_dir / "prim_impact_info.bin";
+  fs::remove(snapshot_path);
+  system->prim_impact_info_snapshot_path = snapshot_path;
+
+  for (int i = 0; i < 2; ++i) {
+    std::vector<clexmonte::EventImpactInfo> prim_impact_info_list =
+        clexmonte::load_or_make_prim_impact_info_list(
+            *system, prim_event_list, {"formation_energy"});
+    EXPECT_TRUE(fs::exists(snapshot_path));
+    ASSERT_EQ(prim_impact_info_list.size(), expected.size());
+    for (Index j = 0; j < expected.size(); ++j) {
+      EXPECT_EQ(prim_impact_info_list[j].phenomenal_sites,
+                expected[j].phenomenal_sites);
+      EXPECT_EQ(prim_impact_info_list[j].required_update_neighborhood,
+                expected[j].required_update_neighborhood);
+      EXPECT_EQ(prim_impact_info_list[j].clex_update_neighborhood,
+                expected[j].clex_update_neighborhood);
+    }
+  }
+
+  // a snapshot for different cluster expansions is stale
+  std::string key = clexmonte::make_prim_impact_info_snapshot_key(
+      *system, expected, {"formation_energy"}, {});
+  EXPECT_TRUE(
+      clexmonte::read_prim_impact_info_snapshot(snapshot_path, key)
+          .has_value());
+  std::string other_key =
+      clexmonte::make_prim_impact_info_snapshot_key(*system, expected, {}, {});
+  EXPECT_FALSE(
+      clexmonte::read_prim_impact_info_snapshot(snapshot_path, other_key)
+          .has_value());
+  fs::remove(snapshot_path);
+}
+
+/// \brief PackedEventID round trip, ordering, and linear index
+TEST(events_PackedEventID_Test, Test1) {
+  clexmonte::EventID a;
+  a.prim_event_index = 3;
+  a.unitcell_index = 1000;
+  clexmonte::EventID b;
+  b.prim_event_index = 23;
+  b.unitcell_index = 999;
+
+  clexmonte::PackedEventID packed_a = clexmonte::pack(a);
+  clexmonte::PackedEventID packed_b = clexmonte::pack(b);
+  EXPECT_EQ(sizeof(packed_a), 8);
+  EXPECT_EQ(clexmonte::unpack(packed_a), a);
+  EXPECT_EQ(clexmonte::unpack(packed_b), b);
+  EXPECT_EQ(packed_b < packed_a, b < a);
+  EXPECT_EQ(clexmonte::linear_index(packed_a, 24), 1000 * 24 + 3);
+  EXPECT_EQ(clexmonte::linear_index(a, 24), 1000 * 24 + 3);
+  EXPECT_EQ(clexmonte::make_event_id(1000 * 24 + 3, 24), a);
+  EXPECT_EQ(std::hash<clexmonte::EventID>()(a),
+            std::hash<clexmonte::PackedEventID>()(packed_a));
+}
+
 // /// \brief Useful for big supercell tests
 // TEST_F(events_impact_table_Test, Test3) {
 //
@@ -0,0 +1,98 @@
+#include "casm/clexmonte/kinetic/AutoTuner.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<jsonParser> make_candidate_values(Index n) {
+  std::vector<jsonParser> candidate_values;
+  for (Index i = 0; i < n; ++i) {
+    jsonParser json;
+    json["event_selector"]["type"] = "candidate_" + std::to_string(i);
+    candidate_values.push_back(json);
+  }
+  return candidate_values;
+}
+
+/// \brief Calibration function returning stubbed steps per second, where a
+///     negative value means the calibration fails, and counting calls
+struct StubTimings {
+  std::vector<double> steps_per_second;
+  Index n_calls = 0;
+
+  double operator()(Index i) {
+    ++n_calls;
+    if (steps_per_second.at(i) < 0.0) {
+      throw std::runtime_error("stubbed calibration failure");
+    }
+    return steps_per_second.at(i);
+  }
+};
+
+}  // namespace
+
+/// \brief Test that the fastest candidate is chosen, failed candidates are
+///     skipped, and each supercell is only calibrated once
+TEST(kinetic_AutoTuner_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path output_file = tmp_dir.path() / "auto_tune.json";
+  kinetic::AutoTuner tuner(make_candidate_values(4), 100,
+                           output_file.string());
+  EXPECT_EQ(tuner.applied, -1);
+
+  Eigen::Matrix3l T1 = Eigen::Matrix3l::Identity() * 2;
+  StubTimings timings1{{100.0, 300.0, -1.0, 200.0}};
+  EXPECT_EQ(tuner.choose(T1, std::ref(timings1)), 1);
+  EXPECT_EQ(timings1.n_calls, 4);
+
+  // no re-calibration for the same supercell
+  StubTimings timings1b{{1000.0, 1.0, 1.0, 1.0}};
+  EXPECT_EQ(tuner.choose(T1, std::ref(timings1b)), 1);
+  EXPECT_EQ(timings1b.n_calls, 0);
+
+  // a new supercell is calibrated
+  Eigen::Matrix3l T2 = Eigen::Matrix3l::Identity() * 3;
+  StubTimings timings2{{100.0, -1.0, 50.0, 400.0}};
+  EXPECT_EQ(tuner.choose(T2, std::ref(timings2)), 3);
+  EXPECT_EQ(timings2.n_calls, 4);
+  EXPECT_EQ(tuner.choose(T1, std::ref(timings2)), 1);
+  EXPECT_EQ(timings2.n_calls, 4);
+
+  // results
+  jsonParser const &results = tuner.results();
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0]["choice"].get<Index>(), 1);
+  EXPECT_EQ(results[0]["n_steps"].get<Index>(), 100);
+  ASSERT_EQ(results[0]["candidates"].size(), 4);
+  EXPECT_EQ(results[0]["candidates"][1]["params"], tuner.candidate_values[1]);
+  EXPECT_EQ(results[0]["candidates"][1]["steps_per_second"].get<double>(),
+            300.0);
+  EXPECT_TRUE(results[0]["candidates"][2].contains("error"));
+  EXPECT_FALSE(results[0]["candidates"][2].contains("steps_per_second"));
+  EXPECT_EQ(results[1]["choice"].get<Index>(), 3);
+  EXPECT_TRUE(results[1]["candidates"][1].contains("error"));
+  EXPECT_EQ(jsonParser(output_file), results);
+}
+
+/// \brief Test that ties choose the first candidate, and that failure of all
+///     candidates, or no candidates, is an error
+TEST(kinetic_AutoTuner_Test, Test2) {
+  using namespace clexmonte;
+  kinetic::AutoTuner tuner(make_candidate_values(3), 100);
+
+  Eigen::Matrix3l T1 = Eigen::Matrix3l::Identity();
+  StubTimings timings1{{-1.0, 200.0, 200.0}};
+  EXPECT_EQ(tuner.choose(T1, std::ref(timings1)), 1);
+
+  Eigen::Matrix3l T2 = Eigen::Matrix3l::Identity() * 2;
+  StubTimings timings2{{-1.0, -1.0, -1.0}};
+  EXPECT_THROW(tuner.choose(T2, std::ref(timings2)), std::runtime_error);
+  EXPECT_EQ(timings2.n_calls, 3);
+  EXPECT_EQ(tuner.results().size(), 1);
+
+  EXPECT_THROW(kinetic::AutoTuner(make_candidate_values(0), 100),
+               std::runtime_error);
+}
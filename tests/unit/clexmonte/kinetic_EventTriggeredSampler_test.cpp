@@ -0,0 +1,103 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/kinetic/EventTriggeredSampler.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Event selector which selects a fixed sequence of prim events, each
+/// after a time increment of 1.0
+struct SequenceEventSelector {
+  std::vector<Index> prim_event_index;
+  Index next = 0;
+
+  std::pair<clexmonte::EventID, double> select_event() {
+    clexmonte::EventID event_id{prim_event_index[next++], 0};
+    return std::make_pair(event_id, 1.0);
+  }
+};
+
+}  // namespace
+
+/// \brief Test that samples are taken only after triggering events, from
+///     the state after the event
+TEST(kinetic_EventTriggeredSampler_Test, Test1) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  // the "state" is the number of events applied
+  double n_applied = 0.0;
+  std::map<std::string, state_sampling_function_type> functions;
+  functions.emplace(
+      "n_applied",
+      state_sampling_function_type("n_applied", "Events applied", {}, [&]() {
+        return monte::reshaped(n_applied);
+      }));
+
+  EventTriggeredSamplingParams params;
+  params.prim_event_index = {1};
+  params.event_type_name = {"B"};
+  params.sampler_names = {"n_applied"};
+  auto sampler = std::make_shared<EventTriggeredSampler>(params, functions);
+  sampler->reset({"A", "A", "B", "C"});
+  EXPECT_FALSE(sampler->is_trigger(0));
+  EXPECT_TRUE(sampler->is_trigger(1));
+  EXPECT_TRUE(sampler->is_trigger(2));
+  EXPECT_FALSE(sampler->is_trigger(3));
+
+  SequenceEventSelector selector{{0, 1, 3, 2, 0, 3, 1}};
+  EventTriggeredSamplingSelector<SequenceEventSelector> sampling_selector(
+      selector, sampler);
+  for (Index i = 0; i < 7; ++i) {
+    sampling_selector.select_event();
+    n_applied += 1.0;  // apply the event
+  }
+  sampler->sample_if_pending();
+
+  ASSERT_EQ(sampler->n_samples(), 3);
+  EXPECT_EQ(sampler->sample_n_events(), std::vector<Index>({2, 4, 7}));
+  EXPECT_EQ(sampler->sample_prim_event_index(), std::vector<Index>({1, 2, 1}));
+  EXPECT_EQ(sampler->sample_time(), std::vector<double>({2.0, 4.0, 7.0}));
+  Eigen::MatrixXd values = sampler->values("n_applied");
+  ASSERT_EQ(values.rows(), 3);
+  EXPECT_EQ(values(0, 0), 2.0);
+  EXPECT_EQ(values(1, 0), 4.0);
+  EXPECT_EQ(values(2, 0), 7.0);
+
+  jsonParser json;
+  to_json(*sampler, json);
+  EXPECT_EQ(json["n_events"].size(), 3);
+  EXPECT_EQ(json["samplers"]["n_applied"]["value"].size(), 3);
+
+  // reset clears samples
+  sampler->reset({"A", "A", "B", "C"});
+  EXPECT_EQ(sampler->n_samples(), 0);
+}
+
+/// \brief Test invalid parameters are rejected
+TEST(kinetic_EventTriggeredSampler_Test, Test2) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  std::map<std::string, state_sampling_function_type> functions;
+
+  EventTriggeredSamplingParams params;
+  EXPECT_THROW(EventTriggeredSampler(params, functions), std::runtime_error);
+
+  params.prim_event_index = {4};
+  EventTriggeredSampler sampler(params, functions);
+  EXPECT_THROW(sampler.reset({"A", "A", "B", "C"}), std::runtime_error);
+
+  params.prim_event_index.clear();
+  params.event_type_name = {"D"};
+  EventTriggeredSampler sampler_2(params, functions);
+  EXPECT_THROW(sampler_2.reset({"A", "A", "B", "C"}), std::runtime_error);
+
+  params.sampler_names = {"unknown"};
+  EXPECT_THROW(EventTriggeredSampler(params, functions), std::runtime_error);
+}
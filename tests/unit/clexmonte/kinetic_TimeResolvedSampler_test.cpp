@@ -0,0 +1,203 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/kinetic/TimeResolvedSampler.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Event selector which selects prim event 0 after a time increment of
+/// `dt_begin` for the first `n_begin` events, then of `dt_end`
+struct RateChangeEventSelector {
+  double dt_begin;
+  Index n_begin;
+  double dt_end;
+  Index n_selected = 0;
+
+  std::pair<clexmonte::EventID, double> select_event() {
+    clexmonte::EventID event_id{0, 0};
+    double dt = (n_selected < n_begin) ? dt_begin : dt_end;
+    ++n_selected;
+    return std::make_pair(event_id, dt);
+  }
+};
+
+/// Sampling functions, where the "state" is the number of events applied
+std::map<std::string, clexmonte::state_sampling_function_type>
+make_n_applied_function(double &n_applied) {
+  using namespace clexmonte;
+  std::map<std::string, state_sampling_function_type> functions;
+  functions.emplace(
+      "n_applied",
+      state_sampling_function_type("n_applied", "Events applied", {}, [&]() {
+        return monte::reshaped(n_applied);
+      }));
+  return functions;
+}
+
+/// Select and apply `n` events
+template <typename SelectorType>
+void run_events(SelectorType &selector, double &n_applied, Index n) {
+  for (Index i = 0; i < n; ++i) {
+    selector.select_event();
+    n_applied += 1.0;  // apply the event
+  }
+}
+
+}  // namespace
+
+/// \brief Test that, without lookahead, samples are the state at each
+///     sample time and every event is checked
+TEST(kinetic_TimeResolvedSampler_Test, Test1) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  double n_applied = 0.0;
+  TimeResolvedSamplingParams params;
+  params.period = 1.0;
+  params.sampler_names = {"n_applied"};
+  params.lookahead = false;
+  auto sampler = std::make_shared<TimeResolvedSampler>(
+      params, make_n_applied_function(n_applied));
+  sampler->reset();
+
+  RateChangeEventSelector selector{0.25, 100, 0.25};
+  TimeResolvedSamplingSelector<RateChangeEventSelector> sampling_selector(
+      selector, sampler);
+  run_events(sampling_selector, n_applied, 14);
+
+  EXPECT_EQ(sampler->n_checks(), 14);
+  ASSERT_EQ(sampler->n_samples(), 4);
+  EXPECT_EQ(sampler->sample_time(), std::vector<double>({0.0, 1.0, 2.0, 3.0}));
+  EXPECT_EQ(sampler->sample_n_events(), std::vector<Index>({0, 3, 7, 11}));
+  EXPECT_EQ(sampler->sample_is_exact(),
+            std::vector<bool>({true, true, true, true}));
+  Eigen::MatrixXd values = sampler->values("n_applied");
+  ASSERT_EQ(values.rows(), 4);
+  EXPECT_EQ(values(0, 0), 0.0);
+  EXPECT_EQ(values(1, 0), 3.0);
+  EXPECT_EQ(values(2, 0), 7.0);
+  EXPECT_EQ(values(3, 0), 11.0);
+
+  jsonParser json;
+  to_json(*sampler, json);
+  EXPECT_EQ(json["time"].size(), 4);
+  EXPECT_EQ(json["is_exact"].size(), 4);
+  EXPECT_EQ(json["samplers"]["n_applied"]["value"].size(), 4);
+
+  // reset clears samples
+  sampler->reset();
+  EXPECT_EQ(sampler->n_samples(), 0);
+  EXPECT_EQ(sampler->n_checks(), 0);
+}
+
+/// \brief Test that, with lookahead and a constant event rate, checks are
+///     skipped and samples are unchanged
+TEST(kinetic_TimeResolvedSampler_Test, Test2) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  double n_applied = 0.0;
+  TimeResolvedSamplingParams params;
+  params.period = 4.0;
+  params.sampler_names = {"n_applied"};
+  params.lookahead = true;
+  params.lookahead_fraction = 0.5;
+  params.lookahead_min_events = 4;
+  auto sampler = std::make_shared<TimeResolvedSampler>(
+      params, make_n_applied_function(n_applied));
+  sampler->reset();
+
+  // 16 events per sample period: after the first full period, 8 events
+  // per period are not checked
+  RateChangeEventSelector selector{0.25, 100, 0.25};
+  TimeResolvedSamplingSelector<RateChangeEventSelector> sampling_selector(
+      selector, sampler);
+  run_events(sampling_selector, n_applied, 48);
+
+  EXPECT_EQ(sampler->n_checks(), 32);
+  ASSERT_EQ(sampler->n_samples(), 4);
+  EXPECT_EQ(sampler->sample_time(),
+            std::vector<double>({0.0, 4.0, 8.0, 12.0}));
+  EXPECT_EQ(sampler->sample_n_events(), std::vector<Index>({0, 15, 31, 47}));
+  EXPECT_EQ(sampler->sample_is_exact(),
+            std::vector<bool>({true, true, true, true}));
+  Eigen::MatrixXd values = sampler->values("n_applied");
+  EXPECT_EQ(values(3, 0), 47.0);
+}
+
+/// \brief Test that a sample time passed while checks are skipped, after
+///     the event rate decreases, is sampled from the current state or by
+///     interpolation
+TEST(kinetic_TimeResolvedSampler_Test, Test3) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  for (bool interpolate : {false, true}) {
+    double n_applied = 0.0;
+    TimeResolvedSamplingParams params;
+    params.period = 4.0;
+    params.sampler_names = {"n_applied"};
+    params.lookahead = true;
+    params.lookahead_fraction = 0.5;
+    params.lookahead_min_events = 4;
+    params.interpolate = interpolate;
+    auto sampler = std::make_shared<TimeResolvedSampler>(
+        params, make_n_applied_function(n_applied));
+    sampler->reset();
+
+    // after the sample at time 4.0, 8 events are not checked, which take
+    // until time 12.0, so the sample times 8.0 and 12.0 are found at time
+    // 13.0, after the event at time 12.0 was applied
+    RateChangeEventSelector selector{0.25, 16, 1.0};
+    TimeResolvedSamplingSelector<RateChangeEventSelector> sampling_selector(
+        selector, sampler);
+    run_events(sampling_selector, n_applied, 25);
+
+    ASSERT_EQ(sampler->n_samples(), 4);
+    EXPECT_EQ(sampler->sample_time(),
+              std::vector<double>({0.0, 4.0, 8.0, 12.0}));
+    EXPECT_EQ(sampler->sample_n_events(), std::vector<Index>({0, 15, 24, 24}));
+    EXPECT_EQ(sampler->sample_is_exact(),
+              std::vector<bool>({true, true, false, false}));
+    Eigen::MatrixXd values = sampler->values("n_applied");
+    EXPECT_EQ(values(1, 0), 15.0);
+    EXPECT_EQ(values(3, 0), 24.0);
+
+    // the state at time 8.0 had 19 events applied
+    if (interpolate) {
+      EXPECT_EQ(values(2, 0), 19.5);
+    } else {
+      EXPECT_EQ(values(2, 0), 24.0);
+    }
+  }
+}
+
+/// \brief Test invalid parameters are rejected
+TEST(kinetic_TimeResolvedSampler_Test, Test4) {
+  using namespace clexmonte;
+  using namespace clexmonte::kinetic;
+
+  double n_applied = 0.0;
+  auto functions = make_n_applied_function(n_applied);
+
+  TimeResolvedSamplingParams params;
+  params.period = 0.0;
+  EXPECT_THROW(TimeResolvedSampler(params, functions), std::runtime_error);
+
+  params.period = 1.0;
+  params.begin = -1.0;
+  EXPECT_THROW(TimeResolvedSampler(params, functions), std::runtime_error);
+
+  params.begin = 0.0;
+  params.lookahead_fraction = 1.5;
+  EXPECT_THROW(TimeResolvedSampler(params, functions), std::runtime_error);
+
+  params.lookahead_fraction = 0.5;
+  params.sampler_names = {"unknown"};
+  EXPECT_THROW(TimeResolvedSampler(params, functions), std::runtime_error);
+}
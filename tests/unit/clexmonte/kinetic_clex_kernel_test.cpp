@@ -0,0 +1,96 @@
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/clexmonte/kinetic/clex_kernel.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test make_flat_coefficient_table
+TEST(kinetic_clex_kernel_Test, Test1) {
+  using namespace clexmonte::kinetic;
+  clexulator::SparseCoefficients a;
+  a.index = {0, 2, 5};
+  a.value = {1.0, -0.5, 0.25};
+  clexulator::SparseCoefficients b;
+  b.index = {1, 3};
+  b.value = {2.0, 3.0};
+
+  FlatCoefficientTable table = make_flat_coefficient_table({a, b});
+  EXPECT_EQ(table.n_properties, 2);
+  EXPECT_EQ(table.n_corr, 6);
+  EXPECT_EQ(table.offsets, std::vector<Index>({0, 3, 5}));
+  EXPECT_EQ(table.index, std::vector<Index>({0, 2, 5, 1, 3}));
+  EXPECT_EQ(table.value, std::vector<double>({1.0, -0.5, 0.25, 2.0, 3.0}));
+}
+
+/// \brief Test ClexBatch against the scalar sparse dot product
+TEST(kinetic_clex_kernel_Test, Test2) {
+  using namespace clexmonte::kinetic;
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+  Index n_corr = 20;
+  std::vector<clexulator::SparseCoefficients> coefficients(3);
+  for (auto &c : coefficients) {
+    for (Index j = 0; j < n_corr; j += 1 + (engine() % 3)) {
+      c.index.push_back(j);
+      c.value.push_back(dist(engine));
+    }
+  }
+  FlatCoefficientTable table = make_flat_coefficient_table(coefficients);
+
+  Index n = 1001;
+  std::vector<std::vector<double>> event_corr(n);
+  ClexBatch batch;
+  batch.resize(n, n_corr);
+  for (Index i = 0; i < n; ++i) {
+    for (Index j = 0; j < n_corr; ++j) {
+      event_corr[i].push_back(dist(engine));
+    }
+    batch.set_corr(i, event_corr[i].data());
+  }
+  batch.calculate(table);
+
+  for (Index p = 0; p < coefficients.size(); ++p) {
+    auto const &c = coefficients[p];
+    for (Index i = 0; i < n; ++i) {
+      double expected = 0.0;
+      for (Index k = 0; k < c.index.size(); ++k) {
+        expected += c.value[k] * event_corr[i][c.index[k]];
+      }
+      EXPECT_EQ(batch.value(p, i), expected);
+    }
+  }
+}
+
+/// \brief Test write_specialized_clex_kernel_source
+TEST(kinetic_clex_kernel_Test, Test3) {
+  using namespace clexmonte::kinetic;
+  clexulator::SparseCoefficients a;
+  a.index = {0, 2};
+  a.value = {1.5, -0.25};
+  clexulator::SparseCoefficients b;
+  FlatCoefficientTable table = make_flat_coefficient_table({a, b});
+
+  std::stringstream ss;
+  write_specialized_clex_kernel_source(ss, table, "formation_energy");
+  std::string source = ss.str();
+  EXPECT_NE(source.find("extern \"C\" void formation_energy(long n, double "
+                        "const *corr, double *values)"),
+            std::string::npos);
+  EXPECT_NE(source.find("constexpr long index_0[2] = {0, 2};"),
+            std::string::npos);
+  EXPECT_NE(source.find("constexpr double value_0[2] = {0x1.8p+0, "
+                        "-0x1p-2};"),
+            std::string::npos);
+  // properties without coefficients have no tables
+  EXPECT_EQ(source.find("index_1"), std::string::npos);
+
+  std::stringstream ss2;
+  EXPECT_THROW(write_specialized_clex_kernel_source(ss2, table, "1abc"),
+               std::runtime_error);
+  EXPECT_THROW(write_specialized_clex_kernel_source(ss2, table, "a-b"),
+               std::runtime_error);
+}
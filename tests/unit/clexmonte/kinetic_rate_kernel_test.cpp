@@ -0,0 +1,125 @@
+#include <cmath>
+#include <random>
+
+#include "casm/clexmonte/kinetic/kernel_dispatch.hh"
+#include "casm/clexmonte/kinetic/rate_kernel.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test vectorizable_exp accuracy compared to std::exp
+TEST(kinetic_rate_kernel_Test, Test1) {
+  using namespace clexmonte::kinetic;
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> wide(-708.0, 709.0);
+  std::uniform_real_distribution<double> narrow(-50.0, 0.0);
+  double max_relative_error = 0.0;
+  for (Index i = 0; i < 1000000; ++i) {
+    double x = (i % 2) ? wide(engine) : narrow(engine);
+    double expected = std::exp(x);
+    double relative_error = std::abs(vectorizable_exp(x) - expected) / expected;
+    max_relative_error = std::max(max_relative_error, relative_error);
+  }
+  EXPECT_LT(max_relative_error, 1e-15);
+
+  EXPECT_EQ(vectorizable_exp(0.0), 1.0);
+  EXPECT_EQ(vectorizable_exp(-1000.0), 0.0);
+  EXPECT_TRUE(std::isinf(vectorizable_exp(1000.0)));
+}
+
+/// \brief Test calculate_arrhenius_rates against the scalar calculation
+TEST(kinetic_rate_kernel_Test, Test2) {
+  using namespace clexmonte::kinetic;
+  double beta = 1.0 / (8.617333262e-5 * 600.0);
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> dE(-1.0, 1.0);
+  std::uniform_real_distribution<double> kra(-0.5, 1.5);
+
+  ArrheniusRateBatch batch;
+  Index n = 1001;
+  for (Index i = 0; i < n; ++i) {
+    batch.push_back(dE(engine), kra(engine), 1e12);
+  }
+  batch.calculate(beta);
+  ASSERT_EQ(batch.rate.size(), n);
+
+  Index n_not_normal = 0;
+  for (Index i = 0; i < n; ++i) {
+    double dE_final = batch.dE_final[i];
+    double Ekra = batch.Ekra[i];
+
+    // same as the scalar calculation, which uses std::exp
+    double dE_activated;
+    bool is_normal;
+    double rate;
+    calculate_arrhenius_rate(dE_final, Ekra, 1e12, beta, dE_activated,
+                             is_normal, rate);
+    EXPECT_EQ(batch.dE_activated[i], dE_activated);
+    EXPECT_EQ(bool(batch.is_normal[i]), is_normal);
+    EXPECT_NEAR(batch.rate[i], rate, 1e-15 * rate);
+
+    // close to the reference formula
+    double expected_dE_activated = dE_final * 0.5 + Ekra;
+    bool expected_is_normal = (expected_dE_activated > 0.0) &&
+                              (expected_dE_activated > dE_final);
+    if (expected_dE_activated < dE_final) expected_dE_activated = dE_final;
+    if (expected_dE_activated < 0.0) expected_dE_activated = 0.0;
+    double expected_rate = 1e12 * std::exp(-beta * expected_dE_activated);
+    EXPECT_EQ(dE_activated, expected_dE_activated);
+    EXPECT_EQ(is_normal, expected_is_normal);
+    EXPECT_EQ(rate, expected_rate);
+    if (!is_normal) {
+      ++n_not_normal;
+    }
+  }
+  EXPECT_GT(n_not_normal, 0);
+  EXPECT_LT(n_not_normal, n);
+}
+
+/// \brief Test calculate_arrhenius_rates with each barrier model
+TEST(kinetic_rate_kernel_Test, Test3) {
+  using namespace clexmonte::kinetic;
+  double beta = 1.0 / (8.617333262e-5 * 600.0);
+  ArrheniusRateBatch batch;
+  batch.push_back(-0.4, 0.8, 1e12);
+  batch.push_back(0.2, 0.8, 1e12);
+  batch.push_back(1.2, 0.1, 1e13);
+
+  BarrierModel kra;
+  BarrierModel fixed;
+  fixed.type = BarrierModelType::fixed;
+  fixed.barrier = 0.5;
+  BarrierModel bep;
+  bep.type = BarrierModelType::bep;
+  bep.intercept = 0.3;
+  bep.slope = 0.5;
+
+  // expected activation energies, after clamping to >= dE_final and >= 0.0
+  std::vector<std::vector<double>> expected = {
+      {0.6, 0.9, 1.2}, {0.5, 0.5, 1.2}, {0.1, 0.4, 1.2}};
+  std::vector<std::vector<bool>> expected_is_normal = {
+      {true, true, false}, {true, true, false}, {true, true, false}};
+  std::vector<BarrierModel> models = {kra, fixed, bep};
+  for (Index m = 0; m < models.size(); ++m) {
+    batch.calculate(models[m], beta);
+    for (Index i = 0; i < batch.size(); ++i) {
+      EXPECT_NEAR(batch.dE_activated[i], expected[m][i], 1e-12);
+      EXPECT_EQ(bool(batch.is_normal[i]), expected_is_normal[m][i]);
+      EXPECT_NEAR(batch.rate[i],
+                  batch.freq[i] * std::exp(-beta * batch.dE_activated[i]),
+                  1e-15 * batch.rate[i]);
+    }
+  }
+}
+
+/// \brief Test that the selected kernel variant is supported by the CPU and
+///     is the same for each call
+TEST(kinetic_rate_kernel_Test, Test4) {
+  using namespace clexmonte::kinetic;
+  KernelISA isa = kernel_isa();
+  EXPECT_LE(int(isa), int(detect_kernel_isa()));
+  EXPECT_EQ(kernel_isa(), isa);
+  EXPECT_EQ(to_string(KernelISA::baseline), "baseline");
+  EXPECT_EQ(to_string(KernelISA::avx2), "avx2");
+  EXPECT_EQ(to_string(KernelISA::avx512), "avx512");
+}
@@ -0,0 +1,64 @@
+#include <set>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/checkerboard_metropolis.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that unit cells of the same color are at least `spacing`
+///     apart, including periodic images
+TEST(methods_checkerboard_metropolis_Test, CheckerboardColoringTest1) {
+  using namespace clexmonte;
+  Eigen::Matrix3l T;
+  T << 6, 0, 0, 0, 6, 0, 0, 0, 1;
+  CheckerboardColoring coloring(T, 3);
+  EXPECT_EQ(coloring.spacing(), 3);
+  EXPECT_EQ(coloring.n_colors(), 9);
+
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  std::set<Index> all;
+  for (Index c = 0; c < coloring.n_colors(); ++c) {
+    auto const &unitcells = coloring.color(c);
+    EXPECT_EQ(unitcells.size(), 4);
+    for (Index a : unitcells) {
+      all.insert(a);
+      for (Index b : unitcells) {
+        if (a == b) {
+          continue;
+        }
+        Eigen::Vector3l d = unitcell_converter(a) - unitcell_converter(b);
+        Index max_distance = 0;
+        for (Index k = 0; k < 2; ++k) {
+          Index x = ((d(k) % 6) + 6) % 6;
+          max_distance = std::max(max_distance, std::min(x, 6 - x));
+        }
+        EXPECT_GE(max_distance, 3);
+      }
+    }
+  }
+  EXPECT_EQ(all.size(), unitcell_converter.total_sites());
+}
+
+/// \brief Test that unsupported supercells are rejected
+TEST(methods_checkerboard_metropolis_Test, CheckerboardColoringTest2) {
+  using namespace clexmonte;
+  Eigen::Matrix3l T;
+  T << 6, 0, 0, 0, 4, 0, 0, 0, 6;
+  EXPECT_THROW(CheckerboardColoring(T, 3), std::runtime_error);
+
+  T << 6, 1, 0, 0, 6, 0, 0, 0, 6;
+  EXPECT_THROW(CheckerboardColoring(T, 3), std::runtime_error);
+}
+
+/// \brief Test unitcell_reach
+TEST(methods_checkerboard_metropolis_Test, UnitCellReachTest1) {
+  using namespace clexmonte;
+  std::set<xtal::UnitCellCoord> neighborhood;
+  neighborhood.emplace(0, 0, 0, 0);
+  EXPECT_EQ(unitcell_reach(neighborhood), 0);
+  neighborhood.emplace(1, 1, -2, 0);
+  neighborhood.emplace(0, 0, 1, 1);
+  EXPECT_EQ(unitcell_reach(neighborhood), 2);
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/cluster_flip.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Ising energy, `-J * sum_<ij> s_i * s_j`, with `s = 2 * occ - 1`
+double ising_energy(Eigen::VectorXi const &occupation,
+                    clexmonte::ClusterFlipEventProposer const &proposer,
+                    double J) {
+  double e = 0.0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    for (Index l_nbor : proposer.neighbors(l)) {
+      e += -J * (2 * occupation(l) - 1) * (2 * occupation(l_nbor) - 1);
+    }
+  }
+  return e / 2.0;
+}
+
+}  // namespace
+
+/// \brief Test nearest neighbor bonds, including periodic images in small
+///     supercells
+TEST(methods_cluster_flip_Test, NeighborsTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  auto bonds = make_nearest_neighbor_bonds(prim, convert);
+  ASSERT_EQ(bonds.size(), 1);
+  EXPECT_EQ(bonds[0].size(), 12);
+
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_semigrand_canonical_swaps(convert, occ_candidate_list);
+  ClusterFlipEventProposer proposer(T, convert, bonds, swaps, 0.5);
+  for (Index l = 0; l < convert.l_size(); ++l) {
+    EXPECT_EQ(proposer.neighbors(l).size(), 12);
+  }
+
+  // in a 2x2x2 supercell, opposite neighbors are the same periodic image
+  T = Eigen::Matrix3l::Identity() * 2;
+  monte::Conversions convert_2(prim, T);
+  ClusterFlipEventProposer proposer_2(T, convert_2, bonds, swaps, 0.5);
+  for (Index l = 0; l < convert_2.l_size(); ++l) {
+    EXPECT_EQ(proposer_2.neighbors(l).size(), 6);
+  }
+
+  EXPECT_THROW(ClusterFlipEventProposer(T, convert_2, bonds, swaps, 1.0),
+               std::runtime_error);
+}
+
+/// \brief Test that for the Ising model, with `bond_probability = 1 -
+///     exp(-2 * beta * J)`, the proposal ratio cancels the energy change
+///     exactly, so every cluster flip is accepted
+TEST(methods_cluster_flip_Test, IsingDetailedBalanceTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_semigrand_canonical_swaps(convert, occ_candidate_list);
+  double J = 1.0;
+  double beta = 0.1;
+  ClusterFlipEventProposer proposer(T, convert,
+                                    make_nearest_neighbor_bonds(prim, convert),
+                                    swaps, 1.0 - std::exp(-2.0 * beta * J));
+
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+  Eigen::VectorXi occupation(convert.l_size());
+  for (Index l = 0; l < occupation.size(); ++l) {
+    occupation(l) = (random_number_generator.random_real(1.0) < 0.5) ? 0 : 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  monte::OccEvent event;
+  double log_proposal_ratio;
+  Index max_domain_size = 0;
+  for (Index step = 0; step < 1000; ++step) {
+    ASSERT_TRUE(proposer.propose(event, log_proposal_ratio, occupation,
+                                 occ_location, random_number_generator));
+    max_domain_size =
+        std::max(max_domain_size, Index(event.linear_site_index.size()));
+    double e_init = ising_energy(occupation, proposer, J);
+    occ_location.apply(event, occupation);
+    double dE = ising_energy(occupation, proposer, J) - e_init;
+    EXPECT_NEAR(dE - log_proposal_ratio / beta, 0.0, 1e-8);
+  }
+  EXPECT_GT(max_domain_size, 1);
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/local_swap_proposal.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+/// \brief Test the nearest neighbor shell and a user-defined shell
+TEST(methods_local_swap_proposal_Test, NeighborsTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+
+  auto neighbors = make_local_swap_neighbors(prim, {true});
+  ASSERT_EQ(neighbors.size(), 1);
+  EXPECT_EQ(neighbors[0].size(), 12);
+
+  neighbors = make_local_swap_neighbors(prim, {true}, 4.0);
+  EXPECT_EQ(neighbors[0].size(), 18);
+
+  neighbors = make_local_swap_neighbors(prim, {false}, 4.0);
+  EXPECT_EQ(neighbors[0].size(), 0);
+
+  EXPECT_THROW(make_local_swap_neighbors(prim, {false}), std::runtime_error);
+  EXPECT_THROW(make_local_swap_neighbors(prim, {true, true}),
+               std::runtime_error);
+}
+
+/// \brief Test that the neighbor relation is symmetric, and that proposals
+///     are valid swaps of neighboring sites
+TEST(methods_local_swap_proposal_Test, ProposeTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_canonical_swaps(convert, occ_candidate_list);
+
+  LocalSwapProposer proposer(T, convert, swaps, prim);
+  ASSERT_EQ(proposer.n_sites(), 64);
+  std::vector<Index> site_k(convert.l_size(), -1);
+  for (Index k = 0; k < proposer.n_sites(); ++k) {
+    site_k[proposer.site(k)] = k;
+  }
+  auto count = [&](Index k, Index l) {
+    Index n = 0;
+    for (Index i = 0; i < proposer.n_neighbors(k); ++i) {
+      n += (proposer.neighbor(k, i) == l);
+    }
+    return n;
+  };
+  for (Index k = 0; k < proposer.n_sites(); ++k) {
+    ASSERT_EQ(proposer.n_neighbors(k), 12);
+    for (Index i = 0; i < proposer.n_neighbors(k); ++i) {
+      Index l = proposer.neighbor(k, i);
+      EXPECT_NE(l, proposer.site(k));
+      EXPECT_EQ(count(site_k[l], proposer.site(k)), count(k, l));
+    }
+  }
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+
+  monte::OccEvent event;
+  Index n_proposed = 0;
+  for (Index i = 0; i < 1000; ++i) {
+    if (!proposer.propose(event, occupation, occ_location,
+                          random_number_generator)) {
+      continue;
+    }
+    ++n_proposed;
+    ASSERT_EQ(event.linear_site_index.size(), 2);
+    Index l_a = event.linear_site_index[0];
+    Index l_b = event.linear_site_index[1];
+    EXPECT_GT(count(site_k[l_a], l_b), 0);
+    EXPECT_NE(occupation(l_a), occupation(l_b));
+    EXPECT_EQ(event.new_occ[0], occupation(l_b));
+    EXPECT_EQ(event.new_occ[1], occupation(l_a));
+    if (i % 10 == 0) {
+      occ_location.apply(event, occupation);
+    }
+  }
+  EXPECT_GT(n_proposed, 0);
+  EXPECT_EQ(occupation.sum(), 16);
+}
@@ -0,0 +1,89 @@
+#include <cmath>
+
+#include "casm/clexmonte/methods/metropolis_acceptance_table.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Random number generator that always returns the same value, and
+///     counts how many values were drawn
+struct FixedRandomNumberGenerator {
+  double value = 0.5;
+  Index n_draws = 0;
+
+  double random_real(double max) {
+    ++n_draws;
+    return value * max;
+  }
+};
+
+}  // namespace
+
+/// \brief Test tabulated probabilities for energy changes that are multiples
+///     of the tolerance
+TEST(methods_metropolis_acceptance_table_Test, ProbabilityTest1) {
+  using namespace clexmonte;
+  double beta = 2.0;
+  MetropolisAcceptanceTableParams params;
+  params.tolerance = 0.25;
+  params.max_size = 100;
+  MetropolisAcceptanceTable table(beta, params);
+  EXPECT_TRUE(table.enabled());
+  EXPECT_EQ(table.size(), 80);
+
+  for (Index k = 0; k < 200; ++k) {
+    double delta = k * params.tolerance;
+    EXPECT_NEAR(table.probability(delta), std::exp(-beta * delta), 1e-14);
+  }
+  EXPECT_EQ(table.probability(-1.0), 1.0);
+
+  // rounded to the nearest multiple of the tolerance
+  EXPECT_NEAR(table.probability(0.26), std::exp(-beta * 0.25), 1e-14);
+}
+
+/// \brief Test that no table is used by default
+TEST(methods_metropolis_acceptance_table_Test, DisabledTest1) {
+  using namespace clexmonte;
+  MetropolisAcceptanceTable table(2.0, MetropolisAcceptanceTableParams());
+  EXPECT_FALSE(table.enabled());
+  EXPECT_EQ(table.size(), 0);
+  EXPECT_NEAR(table.probability(0.26), std::exp(-2.0 * 0.26), 1e-14);
+}
+
+/// \brief Test that downhill events do not draw random numbers
+TEST(methods_metropolis_acceptance_table_Test, AcceptTest1) {
+  using namespace clexmonte;
+  MetropolisAcceptanceTableParams params;
+  params.tolerance = 0.1;
+  MetropolisAcceptanceTable table(1.0, params);
+  FixedRandomNumberGenerator generator;
+
+  EXPECT_TRUE(table.accept(-0.3, generator));
+  EXPECT_TRUE(table.accept(0.01, generator));
+  EXPECT_EQ(generator.n_draws, 0);
+
+  // exp(-0.5) ~ 0.61 > 0.5
+  EXPECT_TRUE(table.accept(0.5, generator));
+  // exp(-1.0) ~ 0.37 < 0.5
+  EXPECT_FALSE(table.accept(1.0, generator));
+  EXPECT_EQ(generator.n_draws, 2);
+}
+
+/// \brief Test that the table is disabled if energy changes are too widely
+///     distributed
+TEST(methods_metropolis_acceptance_table_Test, AcceptTest2) {
+  using namespace clexmonte;
+  MetropolisAcceptanceTableParams params;
+  params.tolerance = 0.001;
+  params.max_size = 10;
+  MetropolisAcceptanceTable table(1.0, params);
+  FixedRandomNumberGenerator generator;
+  EXPECT_TRUE(table.enabled());
+
+  for (Index i = 0; i < MetropolisAcceptanceTable::check_interval; ++i) {
+    table.accept(0.5, generator);
+  }
+  EXPECT_FALSE(table.enabled());
+}
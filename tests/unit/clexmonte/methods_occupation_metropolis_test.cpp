@@ -0,0 +1,167 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/methods/occupation_metropolis.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::monte;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// \brief A proposed event, and whether it was accepted
+struct Step {
+  std::vector<Index> linear_site_index;
+  std::vector<int> new_occ;
+  bool accept = false;
+
+  bool operator==(Step const &other) const {
+    return linear_site_index == other.linear_site_index &&
+           new_occ == other.new_occ && accept == other.accept;
+  }
+};
+
+}  // namespace
+
+class methods_occupation_metropolis_Test : public ZrOTestSystem {
+ public:
+  typedef std::mt19937_64 engine_type;
+
+  static constexpr Index n_passes = 20;
+
+  /// \brief Construct the state, occupant location tracker, and potential
+  void initialize() {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+    Index volume = T.determinant();
+    state = std::make_unique<state_type>(
+        make_default_configuration(*system, T),
+        canonical::make_conditions(600.0, system->composition_converter,
+                                   {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}}));
+    for (Index l = 0; l < volume; ++l) {
+      get_occupation(*state)(2 * volume + l) = 1;
+    }
+    convert = std::make_unique<Conversions>(*get_prim_basicstructure(*system),
+                                            T);
+    occ_candidate_list = std::make_unique<OccCandidateList>(*convert);
+    canonical_swaps = make_canonical_swaps(*convert, *occ_candidate_list);
+    occ_location = std::make_unique<OccLocation>(*convert, *occ_candidate_list);
+    occ_location->initialize(get_occupation(*state));
+    potential = std::make_shared<canonical::CanonicalPotential>(system);
+    potential->set(state.get(), make_conditions(*system, *state));
+  }
+
+  /// \brief Run `n_passes` passes with `occupation_metropolis_v2`, and
+  ///     return the trajectory
+  std::vector<Step> run(std::uint64_t seed, bool buffered_random_numbers) {
+    initialize();
+
+    SamplingParams sampling_params;
+    sampling_params.sample_mode = SAMPLE_MODE::BY_PASS;
+    CompletionCheckParams<statistics_type> completion_check_params;
+    completion_check_params.equilibration_check_f = default_equilibration_check;
+    completion_check_params.calc_statistics_f = BasicStatisticsCalculator();
+    completion_check_params.cutoff_params.min_count = n_passes;
+    completion_check_params.cutoff_params.max_count = n_passes;
+
+    std::vector<sampling_fixture_params_type> sampling_fixture_params;
+    sampling_fixture_params.push_back(make_sampling_fixture_params(
+        "thermo", {}, {}, {}, sampling_params, completion_check_params,
+        {} /*analysis_names*/, false /*write_results*/,
+        false /*write_trajectory*/, false /*write_observations*/,
+        false /*write_status*/, std::nullopt /*output_dir*/,
+        std::nullopt /*log_file*/, 600.0 /*log_frequency_in_s*/));
+    run_manager_type<engine_type> run_manager(
+        std::make_shared<engine_type>(seed), sampling_fixture_params,
+        true /*global_cutoff*/);
+
+    std::vector<Step> trajectory;
+    OccEvent proposed_event;
+    auto propose_event_f =
+        [&](auto &random_number_generator) -> OccEvent const & {
+      propose_canonical_event(proposed_event, *occ_location, canonical_swaps,
+                              random_number_generator);
+      trajectory.push_back(
+          Step{proposed_event.linear_site_index, proposed_event.new_occ});
+      return proposed_event;
+    };
+    auto potential_occ_delta_per_supercell_f = [&](OccEvent const &event) {
+      return potential->occ_delta_per_supercell(event.linear_site_index,
+                                                event.new_occ);
+    };
+    auto apply_event_f = [&](OccEvent const &event) {
+      trajectory.back().accept = true;
+      occ_location->apply(event, get_occupation(*state));
+    };
+
+    occupation_metropolis_v2(
+        *state, *occ_location, 600.0, potential_occ_delta_per_supercell_f,
+        propose_event_f, apply_event_f, run_manager,
+        MetropolisAcceptanceTableParams(), nullptr /*loop_profile*/,
+        nullptr /*telemetry*/, nullptr /*run_control*/,
+        1 /*steps_per_check*/, buffered_random_numbers);
+    return trajectory;
+  }
+
+  /// \brief Run `n_passes` passes with a plain Metropolis loop, as before
+  ///     the buffered random number option, and return the trajectory
+  std::vector<Step> run_baseline(std::uint64_t seed) {
+    initialize();
+
+    RandomNumberGenerator<engine_type> random_number_generator(
+        std::make_shared<engine_type>(seed));
+    double beta = 1.0 / (CASM::KB * 600.0);
+    Index n_steps = n_passes * occ_location->mol_size();
+
+    std::vector<Step> trajectory;
+    OccEvent event;
+    for (Index step = 0; step < n_steps; ++step) {
+      propose_canonical_event(event, *occ_location, canonical_swaps,
+                              random_number_generator);
+      double delta_potential_energy = potential->occ_delta_per_supercell(
+          event.linear_site_index, event.new_occ);
+      bool accept = metropolis_acceptance(delta_potential_energy, beta,
+                                          random_number_generator);
+      trajectory.push_back(
+          Step{event.linear_site_index, event.new_occ, accept});
+      if (accept) {
+        occ_location->apply(event, get_occupation(*state));
+      }
+    }
+    return trajectory;
+  }
+
+  std::unique_ptr<state_type> state;
+  std::unique_ptr<Conversions> convert;
+  std::unique_ptr<OccCandidateList> occ_candidate_list;
+  std::vector<OccSwap> canonical_swaps;
+  std::unique_ptr<OccLocation> occ_location;
+  std::shared_ptr<canonical::CanonicalPotential> potential;
+};
+
+/// \brief Test that, by default, the trajectory for a fixed seed is that of
+///     a plain Metropolis loop using monte::RandomNumberGenerator
+TEST_F(methods_occupation_metropolis_Test, DefaultGeneratorTest1) {
+  std::uint64_t seed = 1234;
+  std::vector<Step> baseline = run_baseline(seed);
+  Eigen::VectorXi baseline_occupation = get_occupation(*state);
+
+  std::vector<Step> trajectory = run(seed, false);
+  ASSERT_EQ(trajectory.size(), baseline.size());
+  EXPECT_TRUE(trajectory == baseline);
+  EXPECT_EQ(get_occupation(*state), baseline_occupation);
+
+  // the opt-in buffered generator draws a different sequence
+  std::vector<Step> buffered = run(seed, true);
+  ASSERT_EQ(buffered.size(), baseline.size());
+  EXPECT_FALSE(buffered == baseline);
+}
@@ -0,0 +1,221 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/methods/replica_exchange_metropolis.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::monte;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// \brief Random number generator that always returns the same value
+struct FixedRandomNumberGenerator {
+  double value = 0.5;
+
+  double random_real(double max) { return value * max; }
+};
+
+}  // namespace
+
+/// \brief Test the exchange acceptance criterion
+TEST(methods_replica_exchange_metropolis_Test, AcceptanceTest1) {
+  // equal conditions: delta = (beta_i - beta_j) * (phi(c_j) - phi(c_i))
+  EXPECT_DOUBLE_EQ(replica_exchange_delta(2.0, 1.0, 1.0, 0.0, 0.0, 1.0),
+                   -1.0);
+  EXPECT_DOUBLE_EQ(replica_exchange_delta(2.0, 1.0, 0.0, 1.0, 1.0, 0.0),
+                   1.0);
+  EXPECT_DOUBLE_EQ(replica_exchange_delta(1.0, 1.0, 0.0, 1.0, 1.0, 0.0),
+                   0.0);
+
+  // different conditions: each configuration at the other's conditions
+  EXPECT_DOUBLE_EQ(replica_exchange_delta(2.0, 0.5, 1.0, 3.0, 2.0, 5.0),
+                   2.0 * (2.0 - 1.0) + 0.5 * (5.0 - 3.0));
+
+  // accepted with probability min(1, exp(-delta))
+  FixedRandomNumberGenerator random_number_generator;
+  EXPECT_TRUE(replica_exchange_acceptance(-1.0, random_number_generator));
+  EXPECT_TRUE(replica_exchange_acceptance(0.0, random_number_generator));
+  random_number_generator.value = 0.99;
+  EXPECT_TRUE(replica_exchange_acceptance(0.0, random_number_generator));
+  EXPECT_FALSE(replica_exchange_acceptance(0.5, random_number_generator));
+  random_number_generator.value = 0.6;
+  EXPECT_TRUE(replica_exchange_acceptance(0.5, random_number_generator));
+  EXPECT_FALSE(replica_exchange_acceptance(0.52, random_number_generator));
+}
+
+class methods_replica_exchange_metropolis_Test : public ZrOTestSystem {
+ public:
+  typedef std::mt19937_64 engine_type;
+
+  /// \brief Run a canonical replica exchange calculation
+  ///
+  /// \param temperatures The temperature of each replica
+  /// \param seed Seed of the engine of the first run manager
+  /// \param n_threads Number of threads
+  void run(std::vector<double> const &temperatures, std::uint64_t seed,
+           Index n_threads) {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+    Index volume = T.determinant();
+    Index n_replicas = temperatures.size();
+    Conversions convert{*get_prim_basicstructure(*system), T};
+    OccCandidateList occ_candidate_list(convert);
+    canonical_swaps = make_canonical_swaps(convert, occ_candidate_list);
+
+    states.clear();
+    occ_locations.clear();
+    potentials.clear();
+    events.assign(n_replicas, OccEvent());
+    for (Index i = 0; i < n_replicas; ++i) {
+      states.emplace_back(
+          make_default_configuration(*system, T),
+          canonical::make_conditions(temperatures[i],
+                                     system->composition_converter,
+                                     {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}}));
+      for (Index l = 0; l < volume; ++l) {
+        get_occupation(states[i])(2 * volume + l) = 1;
+      }
+      occ_locations.emplace_back(convert, occ_candidate_list);
+      occ_locations[i].initialize(get_occupation(states[i]));
+    }
+
+    std::vector<MetropolisReplica<engine_type>> replicas(n_replicas);
+    for (Index i = 0; i < n_replicas; ++i) {
+      auto potential = std::make_shared<canonical::CanonicalPotential>(system);
+      potential->set(&states[i], make_conditions(*system, states[i]));
+      potentials.push_back(potential);
+
+      auto &replica = replicas[i];
+      replica.potential_occ_delta_per_supercell_f =
+          [=](OccEvent const &event) {
+            return potential->occ_delta_per_supercell(event.linear_site_index,
+                                                      event.new_occ);
+          };
+      replica.potential_per_supercell_f = [=]() {
+        return potential->per_supercell();
+      };
+      replica.propose_event_f =
+          [this, i](RandomNumberGenerator<engine_type> &random_number_generator)
+          -> OccEvent const & {
+        propose_canonical_event(events[i], occ_locations[i], canonical_swaps,
+                                random_number_generator);
+        return events[i];
+      };
+      replica.apply_event_f = [this, i](OccEvent const &event) {
+        occ_locations[i].apply(event, get_occupation(states[i]));
+      };
+    }
+
+    // each replica is complete after 20 passes
+    SamplingParams sampling_params;
+    sampling_params.sample_mode = SAMPLE_MODE::BY_PASS;
+    CompletionCheckParams<statistics_type> completion_check_params;
+    completion_check_params.equilibration_check_f = default_equilibration_check;
+    completion_check_params.calc_statistics_f = BasicStatisticsCalculator();
+    completion_check_params.cutoff_params.min_count = 20;
+    completion_check_params.cutoff_params.max_count = 20;
+
+    auto engine = std::make_shared<engine_type>(seed);
+    run_managers.clear();
+    for (Index i = 0; i < n_replicas; ++i) {
+      std::vector<sampling_fixture_params_type> sampling_fixture_params;
+      sampling_fixture_params.push_back(make_sampling_fixture_params(
+          "thermo", {}, {}, {}, sampling_params, completion_check_params,
+          {} /*analysis_names*/, false /*write_results*/,
+          false /*write_trajectory*/, false /*write_observations*/,
+          false /*write_status*/, std::nullopt /*output_dir*/,
+          std::nullopt /*log_file*/, 600.0 /*log_frequency_in_s*/));
+      // only the first engine is used, to seed the replica streams
+      run_managers.push_back(std::make_shared<run_manager_type<engine_type>>(
+          i == 0 ? engine : std::make_shared<engine_type>(),
+          sampling_fixture_params, true /*global_cutoff*/));
+    }
+
+    replica_exchange_metropolis(
+        states, occ_locations, temperatures, replicas, [](Index) {},
+        2 /*exchange_interval*/, n_threads, run_managers, counts);
+  }
+
+  std::vector<OccSwap> canonical_swaps;
+  std::vector<state_type> states;
+  std::vector<OccLocation> occ_locations;
+  std::vector<OccEvent> events;
+  std::vector<std::shared_ptr<canonical::CanonicalPotential>> potentials;
+  std::vector<std::shared_ptr<run_manager_type<engine_type>>> run_managers;
+  ReplicaExchangeCounts counts;
+};
+
+/// \brief Test that replicas keep their temperature, and exchanges are
+///     attempted between alternating pairs of the temperature ladder
+TEST_F(methods_replica_exchange_metropolis_Test, LadderTest1) {
+  std::vector<double> temperatures = {300.0, 600.0, 1200.0, 2400.0};
+  run(temperatures, 42, 2);
+
+  ASSERT_EQ(counts.n_attempt.size(), 3);
+  ASSERT_EQ(counts.n_accept.size(), 3);
+
+  // 20 passes, with exchanges every 2 passes: 10 rounds, alternating pairs
+  // (0,1),(2,3) and (1,2)
+  EXPECT_EQ(counts.n_attempt, std::vector<Index>({5, 5, 5}));
+  for (Index i = 0; i < 3; ++i) {
+    EXPECT_LE(counts.n_accept[i], counts.n_attempt[i]);
+  }
+
+  Index volume = 64;
+  for (Index i = 0; i < Index(temperatures.size()); ++i) {
+    // conditions stay with the replica; configurations are exchanged
+    EXPECT_EQ(states[i].conditions.scalar_values.at("temperature"),
+              temperatures[i]);
+    EXPECT_EQ(run_managers[i]->sampling_fixtures.front()->counter().pass, 20);
+
+    // the composition of each exchanged configuration is unchanged
+    Eigen::VectorXi const &occupation = get_occupation(states[i]);
+    EXPECT_EQ(occupation.tail(2 * volume).sum(), volume);
+  }
+}
+
+/// \brief Test that exchanges between replicas at equal conditions are
+///     always accepted
+TEST_F(methods_replica_exchange_metropolis_Test, LadderTest2) {
+  run({600.0, 600.0, 600.0}, 42, 1);
+  for (Index i = 0; i < 2; ++i) {
+    EXPECT_GT(counts.n_attempt[i], 0);
+    EXPECT_EQ(counts.n_accept[i], counts.n_attempt[i]);
+  }
+}
+
+/// \brief Test that results are determined by the seed, independent of the
+///     number of threads
+TEST_F(methods_replica_exchange_metropolis_Test, SeedTest1) {
+  std::vector<double> temperatures = {300.0, 600.0, 1200.0};
+
+  run(temperatures, 42, 1);
+  std::vector<Eigen::VectorXi> occupation;
+  for (auto const &state : states) {
+    occupation.push_back(get_occupation(state));
+  }
+  ReplicaExchangeCounts counts_1 = counts;
+
+  run(temperatures, 42, 3);
+  for (Index i = 0; i < Index(temperatures.size()); ++i) {
+    EXPECT_EQ(get_occupation(states[i]), occupation[i]);
+  }
+  EXPECT_EQ(counts.n_accept, counts_1.n_accept);
+
+  // a different seed gives a different trajectory
+  run(temperatures, 43, 1);
+  bool any_different = false;
+  for (Index i = 0; i < Index(temperatures.size()); ++i) {
+    if (get_occupation(states[i]) != occupation[i]) {
+      any_different = true;
+    }
+  }
+  EXPECT_TRUE(any_different);
+}
@@ -0,0 +1,124 @@
+#include "casm/clexmonte/methods/replica_exchange_slots.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Random number generator that always returns the same value
+struct FixedRandomNumberGenerator {
+  double value = 0.5;
+
+  double random_real(double max) { return value * max; }
+};
+
+}  // namespace
+
+/// \brief Test exchange partners on a 3 x 2 slot grid
+TEST(methods_replica_exchange_slots_Test, PartnerTest1) {
+  using namespace clexmonte;
+  ReplicaExchangeSlots slots({3, 2}, std::vector<double>(6, 1.0));
+  EXPECT_EQ(slots.n_slots(), 6);
+  EXPECT_EQ(slots.n_axes(), 2);
+  EXPECT_EQ(slots.coordinate(4, 0), 1);
+  EXPECT_EQ(slots.coordinate(4, 1), 1);
+
+  // round 0: axis 0, pairs (0,1)
+  EXPECT_EQ(slots.partner(0, 0), 1);
+  EXPECT_EQ(slots.partner(1, 0), 0);
+  EXPECT_EQ(slots.partner(2, 0), -1);
+  EXPECT_EQ(slots.partner(3, 0), 4);
+
+  // round 1: axis 1, pairs (0,1)
+  EXPECT_EQ(slots.partner(0, 1), 3);
+  EXPECT_EQ(slots.partner(5, 1), 2);
+
+  // round 2: axis 0, pairs (1,2)
+  EXPECT_EQ(slots.partner(0, 2), -1);
+  EXPECT_EQ(slots.partner(1, 2), 2);
+  EXPECT_EQ(slots.partner(2, 2), 1);
+
+  // round 3: axis 1, no pairs (1,2)
+  EXPECT_EQ(slots.partner(0, 3), -1);
+  EXPECT_EQ(slots.partner(3, 3), -1);
+}
+
+/// \brief Test exchange acceptance and replica trajectories
+TEST(methods_replica_exchange_slots_Test, ExchangeTest1) {
+  using namespace clexmonte;
+  std::vector<double> beta = {2.0, 1.0, 0.5};
+  ReplicaExchangeSlots slots({3}, beta);
+  FixedRandomNumberGenerator random_number_generator;
+
+  // Phi does not depend on conditions, so the energy of each walker at its
+  // partner's conditions equals its energy at its own conditions, and
+  // delta = (beta_k - beta_l) * (phi[w_l] - phi[w_k])
+  std::vector<double> phi = {1.0, 0.0, -1.0};
+
+  // round 0: pair (0,1), walkers 0 and 1: delta = 1*(0-1) = -1: accept
+  slots.exchange(0, phi, phi, random_number_generator);
+  EXPECT_EQ(slots.walker(0), 1);
+  EXPECT_EQ(slots.walker(1), 0);
+  EXPECT_EQ(slots.slot(0), 1);
+  EXPECT_EQ(slots.n_attempt(0, 0), 1);
+  EXPECT_EQ(slots.n_accept(0, 0), 1);
+
+  // round 1: pair (1,2), walkers 0 and 2: delta = 0.5*(-1-1) = -1: accept
+  slots.exchange(1, phi, phi, random_number_generator);
+  EXPECT_EQ(slots.slot(0), 2);
+  EXPECT_EQ(slots.slot(2), 1);
+
+  // round 2: pair (0,1), walkers 1 and 2: delta = 1*(-1-0) = -1: accept
+  slots.exchange(2, phi, phi, random_number_generator);
+  EXPECT_EQ(slots.slot(2), 0);
+  EXPECT_EQ(slots.slot(1), 1);
+
+  // round 3: pair (1,2), walkers 1 and 0: delta = 0.5*(1-0) = 0.5,
+  // accepted because 0.5 < exp(-0.5)
+  slots.exchange(3, phi, phi, random_number_generator);
+  EXPECT_EQ(slots.slot(0), 1);
+  EXPECT_EQ(slots.slot(1), 2);
+  EXPECT_EQ(slots.n_attempt(1, 0), 2);
+  EXPECT_EQ(slots.n_accept(1, 0), 2);
+
+  // round 4: pair (0,1), walkers 2 and 0: delta = 1*(1-(-1)) = 2,
+  // rejected because 0.9 >= exp(-2)
+  random_number_generator.value = 0.9;
+  slots.exchange(4, phi, phi, random_number_generator);
+  EXPECT_EQ(slots.slot(0), 1);
+  EXPECT_EQ(slots.slot(2), 0);
+  EXPECT_EQ(slots.n_attempt(0, 0), 3);
+  EXPECT_EQ(slots.n_accept(0, 0), 2);
+  EXPECT_NEAR(slots.acceptance_rate(0, 0), 2.0 / 3.0, 1e-12);
+
+  // initial slots, and slots after each of the 5 rounds
+  ASSERT_EQ(slots.history().size(), 6);
+  std::vector<Index> walker_0_slots;
+  for (auto const &x : slots.history()) {
+    walker_0_slots.push_back(x[0]);
+  }
+  EXPECT_EQ(walker_0_slots, std::vector<Index>({0, 1, 2, 2, 1, 1}));
+
+  // walker 0 went 0 -> 2 and walker 2 went 2 -> 0: no round trips
+  EXPECT_EQ(slots.n_round_trips(0), 0);
+  EXPECT_EQ(slots.n_round_trips(2), 0);
+}
+
+/// \brief Test round trip counting
+TEST(methods_replica_exchange_slots_Test, RoundTripTest1) {
+  using namespace clexmonte;
+  ReplicaExchangeSlots slots({2}, {1.0, 1.0});
+  FixedRandomNumberGenerator random_number_generator;
+
+  // equal energies: every exchange is accepted
+  std::vector<double> phi = {0.0, 0.0};
+  for (Index round = 0; round < 4; ++round) {
+    slots.exchange(round, phi, phi, random_number_generator);
+  }
+  // round 0 and 2 attempt (0,1); rounds 1 and 3 have no pairs
+  EXPECT_EQ(slots.n_attempt(0, 0), 2);
+
+  // walker 0: 0 -> 1 -> 1 -> 0 -> 0
+  EXPECT_EQ(slots.n_round_trips(0), 1);
+  EXPECT_EQ(slots.n_round_trips(1), 1);
+}
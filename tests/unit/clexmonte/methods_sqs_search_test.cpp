@@ -0,0 +1,61 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/methods/sqs_search.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+class methods_sqs_search_Test : public test::ZrOTestSystem {};
+
+/// \brief Test that results are sorted, have the reported potential, and do
+///     not depend on the number of threads
+TEST_F(methods_sqs_search_Test, Test1) {
+  using namespace clexmonte;
+
+  std::vector<Eigen::Matrix3l> supercells;
+  supercells.push_back(Eigen::Matrix3l::Identity() * 2);
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  T(2, 2) = 3;
+  supercells.push_back(T);
+
+  Eigen::VectorXd target_mol_composition =
+      system->composition_converter.mol_composition(
+          (Eigen::VectorXd(1) << 0.5).finished());
+  CorrMatchingParams params(
+      1.0,
+      {CorrMatchingTarget(1, 0.0, 1.0), CorrMatchingTarget(2, 0.0, 1.0)},
+      CASM::TOL);
+
+  SQSSearchParams search_params;
+  search_params.n_chains_per_supercell = 2;
+  search_params.n_passes = 20;
+  search_params.n_best = 3;
+  search_params.stop_if_exact = false;
+
+  search_params.n_threads = 1;
+  std::vector<SQSResult> results_1 = sqs_search(
+      *system, supercells, target_mol_composition, params, search_params);
+  search_params.n_threads = 2;
+  std::vector<SQSResult> results_2 = sqs_search(
+      *system, supercells, target_mol_composition, params, search_params);
+
+  ASSERT_EQ(results_1.size(), 3);
+  ASSERT_EQ(results_2.size(), 3);
+  for (Index i = 0; i < results_1.size(); ++i) {
+    SQSResult const &result = results_1[i];
+    if (i > 0) {
+      EXPECT_LE(results_1[i - 1].potential, result.potential);
+    }
+    EXPECT_NEAR(results_2[i].potential, result.potential, 1e-10);
+
+    state_type state(make_default_configuration(
+        *system, result.transformation_matrix_to_super));
+    get_occupation(state) = result.occupation;
+    auto correlations = get_corr(*system, state, "formation_energy");
+    Eigen::VectorXd corr =
+        correlations->per_unitcell(correlations->per_supercell());
+    EXPECT_NEAR(corr_matching_potential(corr, params), result.potential,
+                1e-10);
+  }
+}
@@ -0,0 +1,145 @@
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/swap_proposal_stream.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+/// \brief Test that canonical proposals are valid swaps, and that a block
+///     is kept while applied events do not change the candidate counts
+TEST(methods_swap_proposal_stream_Test, CanonicalTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_canonical_swaps(convert, occ_candidate_list);
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  EXPECT_THROW(SwapProposalStream(swaps, true, 0), std::runtime_error);
+  SwapProposalStream stream(swaps, true, 100);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+
+  monte::OccEvent event;
+  for (Index i = 0; i < 100; ++i) {
+    stream.propose(event, occ_location, random_number_generator);
+    ASSERT_EQ(event.linear_site_index.size(), 2);
+    Index l_a = event.linear_site_index[0];
+    Index l_b = event.linear_site_index[1];
+    EXPECT_NE(occupation(l_a), occupation(l_b));
+    EXPECT_EQ(event.new_occ[0], occupation(l_b));
+    EXPECT_EQ(event.new_occ[1], occupation(l_a));
+
+    // swaps on one sublattice do not change the candidate counts
+    if (i % 10 == 0) {
+      occ_location.apply(event, occupation);
+      stream.notify_applied(event);
+    }
+  }
+  EXPECT_EQ(stream.n_blocks(), 1);
+  EXPECT_EQ(occupation.sum(), 16);
+
+  stream.propose(event, occ_location, random_number_generator);
+  EXPECT_EQ(stream.n_blocks(), 2);
+}
+
+/// \brief Test that semi-grand canonical proposals choose sites in
+///     proportion to the number of candidates, and that a block is
+///     discarded when an applied event changes the candidate counts
+TEST(methods_swap_proposal_stream_Test, SemiGrandCanonicalTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_semigrand_canonical_swaps(convert, occ_candidate_list);
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  SwapProposalStream stream(swaps, false, 1000);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+
+  monte::OccEvent event;
+  Index n = 20000;
+  Index n_from_1 = 0;
+  for (Index i = 0; i < n; ++i) {
+    stream.propose(event, occ_location, random_number_generator);
+    ASSERT_EQ(event.linear_site_index.size(), 1);
+    Index l = event.linear_site_index[0];
+    EXPECT_NE(event.new_occ[0], occupation(l));
+    if (occupation(l) == 1) {
+      ++n_from_1;
+    }
+  }
+  EXPECT_EQ(stream.n_blocks(), n / 1000);
+  EXPECT_NEAR(double(n_from_1) / n, 16.0 / 64.0, 0.02);
+
+  occ_location.apply(event, occupation);
+  stream.notify_applied(event);
+  stream.propose(event, occ_location, random_number_generator);
+  EXPECT_EQ(stream.n_blocks(), n / 1000 + 1);
+}
+
+/// \brief Test that `prefetch_next` visits the sites of the next proposal
+TEST(methods_swap_proposal_stream_Test, PrefetchNextTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_canonical_swaps(convert, occ_candidate_list);
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  SwapProposalStream stream(swaps, true, 10);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+
+  std::vector<Index> sites;
+  auto f = [&](Index l) { sites.push_back(l); };
+
+  // nothing drawn yet
+  stream.prefetch_next(occ_location, f);
+  EXPECT_EQ(sites.size(), 0);
+
+  monte::OccEvent event;
+  stream.propose(event, occ_location, random_number_generator);
+  for (Index i = 1; i < 10; ++i) {
+    sites.clear();
+    stream.prefetch_next(occ_location, f);
+    stream.propose(event, occ_location, random_number_generator);
+    EXPECT_EQ(sites, event.linear_site_index);
+  }
+
+  // block used up
+  sites.clear();
+  stream.prefetch_next(occ_location, f);
+  EXPECT_EQ(sites.size(), 0);
+}
@@ -0,0 +1,111 @@
+#include "casm/clexmonte/methods/wang_landau.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that windows cover all bins and neighbors overlap
+TEST(methods_wang_landau_Test, WindowsTest1) {
+  using namespace clexmonte;
+  auto windows = make_wang_landau_windows(100, 4, 0.5);
+  ASSERT_EQ(windows.size(), 4);
+  EXPECT_EQ(windows.front().first, 0);
+  EXPECT_EQ(windows.back().second, 100);
+  for (Index k = 1; k < windows.size(); ++k) {
+    EXPECT_LT(windows[k].first, windows[k - 1].second);
+    EXPECT_GT(windows[k].first, windows[k - 1].first);
+  }
+
+  // no overlap requested: neighbors still share one bin
+  windows = make_wang_landau_windows(10, 2, 0.0);
+  EXPECT_EQ(windows[1].first, windows[0].second - 1);
+
+  EXPECT_THROW(make_wang_landau_windows(2, 3, 0.5), std::runtime_error);
+  EXPECT_THROW(make_wang_landau_windows(10, 2, 1.0), std::runtime_error);
+}
+
+/// \brief Test histogram flatness and the modification factor schedule
+TEST(methods_wang_landau_Test, WindowTest1) {
+  using namespace clexmonte;
+  WangLandauParams params;
+  params.flatness = 0.8;
+  params.one_over_t = false;
+  WangLandauWindow window(10, 13, 1.0);
+  EXPECT_EQ(window.size(), 3);
+  EXPECT_TRUE(window.contains(12));
+  EXPECT_FALSE(window.contains(13));
+
+  // not flat: ln_f is unchanged
+  for (Index i = 0; i < 10; ++i) {
+    window.update(10);
+  }
+  window.update(11);
+  window.update_ln_f(params);
+  EXPECT_EQ(window.ln_f, 1.0);
+  EXPECT_EQ(window.ln_g[0], 10.0);
+
+  // flat over the visited bins: ln_f is halved and the histogram reset
+  for (Index i = 0; i < 9; ++i) {
+    window.update(11);
+  }
+  EXPECT_TRUE(window.is_flat(params.flatness));
+  window.update_ln_f(params);
+  EXPECT_EQ(window.ln_f, 0.5);
+  EXPECT_EQ(window.histogram[0], 0);
+  EXPECT_EQ(window.visited[2], 0);
+
+  // 1/t schedule, once ln_f < n_bins / n_steps
+  params.one_over_t = true;
+  window.ln_f = 0.1;
+  window.update(10);
+  window.update(11);
+  window.update_ln_f(params);
+  EXPECT_TRUE(window.is_one_over_t);
+  EXPECT_DOUBLE_EQ(window.ln_f, 3.0 / 22.0);
+}
+
+/// \brief Test joining windows with offset ln_g
+TEST(methods_wang_landau_Test, JoinTest1) {
+  using namespace clexmonte;
+  // exact ln_g(b) = b, windows [0, 6) and [4, 10), second offset by -7
+  WangLandauResults results;
+  results.windows.emplace_back(0, 6, 0.0);
+  results.windows.emplace_back(4, 10, 0.0);
+  for (auto &window : results.windows) {
+    double offset = (window.begin == 0) ? 3.0 : -7.0;
+    for (Index i = 0; i < window.size(); ++i) {
+      window.ln_g[i] = window.begin + i + offset;
+      window.visited[i] = 1;
+    }
+  }
+  join_wang_landau_windows(results, 10);
+  for (Index b = 0; b < 10; ++b) {
+    EXPECT_TRUE(results.visited[b]);
+    EXPECT_NEAR(results.ln_g[b], b, 1e-12);
+  }
+}
+
+/// \brief Test thermodynamic averages of a two-level system
+TEST(methods_wang_landau_Test, ThermodynamicsTest1) {
+  using namespace clexmonte;
+  // one unit cell, energies 0.0 and 0.1 (bin centers), g = 1 and 2
+  WangLandauResults results;
+  results.energy_min = -0.05;
+  results.bin_width = 0.1;
+  results.n_unitcells = 1;
+  results.ln_g = {0.0, std::log(2.0)};
+  results.visited = {1, 1};
+
+  double temperature = 1000.0;
+  double beta = 1.0 / (CASM::KB * temperature);
+  double w = 2.0 * std::exp(-beta * 0.1);
+  double Z = 1.0 + w;
+  double mean_E = 0.1 * w / Z;
+  double var_E = 0.01 * w / Z - mean_E * mean_E;
+
+  WangLandauThermodynamics thermo =
+      wang_landau_thermodynamics(results, temperature);
+  EXPECT_NEAR(thermo.energy, mean_E, 1e-12);
+  EXPECT_NEAR(thermo.heat_capacity,
+              var_E / (CASM::KB * temperature * temperature), 1e-12);
+  EXPECT_NEAR(thermo.free_energy, -std::log(Z) / beta, 1e-12);
+}
@@ -0,0 +1,111 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "casm/clexmonte/methods/weighted_swap_proposal.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+/// \brief Test that with equal weights, sites are chosen in proportion to
+///     the number of candidates and the proposal ratio is 1
+TEST(methods_weighted_swap_proposal_Test, UniformTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_semigrand_canonical_swaps(convert, occ_candidate_list);
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  EXPECT_THROW(WeightedSwapProposer(swaps, 0.0), std::runtime_error);
+  EXPECT_THROW(WeightedSwapProposer(swaps, 0.1, 0), std::runtime_error);
+  WeightedSwapProposer proposer(swaps);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+
+  monte::OccEvent event;
+  double log_proposal_ratio;
+  Index n = 20000;
+  Index n_from_1 = 0;
+  for (Index i = 0; i < n; ++i) {
+    proposer.propose(event, log_proposal_ratio, occ_location,
+                     random_number_generator);
+    ASSERT_EQ(event.linear_site_index.size(), 1);
+    Index l = event.linear_site_index[0];
+    EXPECT_NE(event.new_occ[0], occupation(l));
+    EXPECT_NEAR(log_proposal_ratio, 0.0, 1e-12);
+    if (occupation(l) == 1) {
+      ++n_from_1;
+    }
+  }
+  EXPECT_NEAR(double(n_from_1) / n, 16.0 / 64.0, 0.02);
+}
+
+/// \brief Test that weights follow acceptance rates, and that with the
+///     proposal ratio, unequal weights sample the correct distribution
+TEST(methods_weighted_swap_proposal_Test, HastingsTest1) {
+  using namespace clexmonte;
+  xtal::BasicStructure prim = test::FCC_binary_prim();
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  monte::Conversions convert(prim, T);
+  monte::OccCandidateList occ_candidate_list(convert);
+  std::vector<monte::OccSwap> swaps =
+      monte::make_semigrand_canonical_swaps(convert, occ_candidate_list);
+  ASSERT_EQ(swaps.size(), 2);
+
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(convert.l_size());
+  for (Index l = 0; l < 16; ++l) {
+    occupation(l) = 1;
+  }
+  monte::OccLocation occ_location(convert, occ_candidate_list);
+  occ_location.initialize(occupation);
+
+  WeightedSwapProposer proposer(swaps, 0.05, 100);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(12345));
+  monte::OccEvent event;
+  double log_proposal_ratio;
+
+  // accept only flips from species 0 while adapting
+  proposer.begin_adaptation(1000);
+  for (Index i = 0; i < 1000; ++i) {
+    proposer.propose(event, log_proposal_ratio, occ_location,
+                     random_number_generator);
+    if (event.occ_transform[0].from_species == 0) {
+      proposer.notify_accepted();
+    }
+  }
+  Index from_0 = (swaps[0].cand_a.species_index == 0) ? 0 : 1;
+  EXPECT_DOUBLE_EQ(proposer.weights()[from_0], 1.0);
+  EXPECT_DOUBLE_EQ(proposer.weights()[1 - from_0], 0.05);
+
+  // with zero energy, all occupations are equally likely, so the mean
+  // number of sites with species 1 is half the number of sites
+  Index n = 400000;
+  double sum = 0.0;
+  for (Index i = 0; i < n; ++i) {
+    proposer.propose(event, log_proposal_ratio, occ_location,
+                     random_number_generator);
+    if (std::log(random_number_generator.random_real(1.0)) <
+        log_proposal_ratio) {
+      occ_location.apply(event, occupation);
+      proposer.notify_accepted();
+    }
+    sum += occupation.sum();
+  }
+  EXPECT_NEAR(sum / n, 32.0, 1.0);
+  EXPECT_DOUBLE_EQ(proposer.weights()[1 - from_0], 0.05);
+}
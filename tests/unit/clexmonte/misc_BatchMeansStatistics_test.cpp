@@ -0,0 +1,64 @@
+#include <cmath>
+#include <random>
+
+#include "casm/clexmonte/misc/BatchMeansStatistics.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(BatchMeansStatisticsTest, NormalConfidenceIntervalZ) {
+  EXPECT_NEAR(clexmonte::normal_confidence_interval_z(0.95), 1.959964, 1e-6);
+  EXPECT_NEAR(clexmonte::normal_confidence_interval_z(0.99), 2.575829, 1e-6);
+}
+
+TEST(BatchMeansStatisticsTest, BatchMerging) {
+  clexmonte::BatchMeansAccumulator accumulator(8);
+  double sum = 0.0;
+  for (Index i = 0; i < 1000; ++i) {
+    accumulator.push(i);
+    sum += i;
+    if (accumulator.count() >= 4) {
+      EXPECT_GE(accumulator.n_batches(), 4);
+    }
+    EXPECT_LT(accumulator.n_batches(), 8);
+    EXPECT_EQ(accumulator.n_batches() * accumulator.batch_size() +
+                  accumulator.count() % accumulator.batch_size(),
+              accumulator.count());
+  }
+  EXPECT_NEAR(accumulator.mean(), sum / 1000, 1e-10);
+}
+
+TEST(BatchMeansStatisticsTest, IndependentSamples) {
+  std::mt19937_64 engine(1234);
+  std::normal_distribution<double> dist(2.0, 0.5);
+  Index n = 100000;
+  Eigen::VectorXd observations(n);
+  for (Index i = 0; i < n; ++i) {
+    observations(i) = dist(engine);
+  }
+
+  clexmonte::BatchMeansStatisticsCalculator calculator;
+  monte::RequestedPrecision requested_precision;
+  monte::BasicStatistics stats =
+      calculator(observations, Eigen::VectorXd(), requested_precision);
+  EXPECT_NEAR(stats.mean, observations.mean(), 1e-10);
+
+  // for independent samples, expect close to z * sigma / sqrt(n)
+  double expected = 1.959964 * 0.5 / std::sqrt(double(n));
+  EXPECT_GT(stats.calculated_precision, 0.5 * expected);
+  EXPECT_LT(stats.calculated_precision, 2.0 * expected);
+
+  // weighted mean
+  Eigen::VectorXd sample_weight = Eigen::VectorXd::Ones(n);
+  sample_weight.head(n / 2) *= 3.0;
+  stats = calculator(observations, sample_weight, requested_precision);
+  double weighted_mean = observations.dot(sample_weight) / sample_weight.sum();
+  EXPECT_NEAR(stats.mean, weighted_mean, 1e-10);
+}
+
+TEST(BatchMeansStatisticsTest, TooFewSamples) {
+  clexmonte::BatchMeansAccumulator accumulator;
+  EXPECT_TRUE(std::isnan(accumulator.mean()));
+  accumulator.push(1.0);
+  EXPECT_TRUE(std::isinf(accumulator.calculated_precision(0.95)));
+}
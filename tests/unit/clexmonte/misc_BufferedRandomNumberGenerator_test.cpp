@@ -0,0 +1,47 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "casm/clexmonte/misc/BufferedRandomNumberGenerator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test ranges and reproducibility, across buffer refills
+TEST(misc_BufferedRandomNumberGenerator_Test, Test1) {
+  typedef std::mt19937_64 engine_type;
+  clexmonte::BufferedRandomNumberGenerator<engine_type> a(
+      std::make_shared<engine_type>(12345), 10);
+  clexmonte::BufferedRandomNumberGenerator<engine_type> b(
+      std::make_shared<engine_type>(12345), 7);
+
+  std::vector<Index> counts(5, 0);
+  double sum = 0.0;
+  Index n = 10000;
+  for (Index i = 0; i < n; ++i) {
+    double x = a.random_real(2.0);
+    EXPECT_EQ(x, b.random_real(2.0));
+    EXPECT_GE(x, 0.0);
+    EXPECT_LT(x, 2.0);
+    sum += x;
+
+    Index k = a.random_int(Index(4));
+    EXPECT_EQ(k, b.random_int(Index(4)));
+    ASSERT_GE(k, 0);
+    ASSERT_LE(k, 4);
+    ++counts[k];
+  }
+  EXPECT_NEAR(sum / n, 1.0, 0.05);
+  for (Index count : counts) {
+    EXPECT_NEAR(double(count) / n, 0.2, 0.02);
+  }
+
+  // engines with other output ranges use std::uniform_real_distribution
+  clexmonte::BufferedRandomNumberGenerator<std::minstd_rand> c(
+      std::make_shared<std::minstd_rand>(12345), 3);
+  for (Index i = 0; i < 100; ++i) {
+    double x = c.random_real(1.0);
+    EXPECT_GE(x, 0.0);
+    EXPECT_LT(x, 1.0);
+  }
+}
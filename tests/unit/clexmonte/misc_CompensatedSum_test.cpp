@@ -0,0 +1,89 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "casm/clexmonte/misc/CompensatedSum.hh"
+#include "casm/global/definitions.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that incremental updates of rates spanning 20 orders of
+///     magnitude do not drift, and that the error bound detects when
+///     cancellation requires re-summation
+TEST(misc_CompensatedSum_Test, Test1) {
+  using namespace clexmonte;
+
+  std::mt19937_64 engine(12345);
+  std::uniform_int_distribution<int> index_dist(0, 99);
+  std::uniform_real_distribution<double> exponent_dist(-10.0, 10.0);
+
+  auto exact_sum = [](std::vector<double> const &terms) {
+    CompensatedSum sum;
+    for (double x : terms) {
+      sum.add(x);
+    }
+    return sum.value();
+  };
+
+  std::vector<double> rate(100, 0.0);
+  CompensatedSum total;
+  double naive_total = 0.0;
+  for (Index k = 0; k < 1000000; ++k) {
+    int i = index_dist(engine);
+    double new_rate = std::pow(10.0, exponent_dist(engine));
+    total.add(new_rate);
+    total.add(-rate[i]);
+    naive_total += new_rate - rate[i];
+    rate[i] = new_rate;
+  }
+  double expected = exact_sum(rate);
+  EXPECT_NEAR(total.value(), expected, 1e-15 * expected);
+  EXPECT_LE(std::abs(total.value() - expected),
+            total.error_bound() + 1e-15 * expected);
+  EXPECT_FALSE(total.needs_refresh());
+
+  // set all rates to 1e-8, so large terms cancel
+  for (Index i = 0; i < 100; ++i) {
+    total.add(1e-8);
+    total.add(-rate[i]);
+    naive_total += 1e-8 - rate[i];
+    rate[i] = 1e-8;
+  }
+  expected = exact_sum(rate);
+  EXPECT_LE(std::abs(total.value() - expected),
+            total.error_bound() + 1e-15 * expected);
+  EXPECT_NEAR(total.value(), expected, 1e-6 * expected);
+  EXPECT_TRUE(total.needs_refresh());
+
+  // the uncompensated total has lost all accuracy
+  EXPECT_GT(std::abs(naive_total - expected), expected);
+}
+
+/// \brief Test the error bound and reset
+TEST(misc_CompensatedSum_Test, Test2) {
+  using namespace clexmonte;
+
+  CompensatedSum total(1.0);
+  EXPECT_EQ(total.value(), 1.0);
+  EXPECT_EQ(total.error_bound(), 0.0);
+
+  // exactly representable sums accumulate no error
+  total.add(2.0);
+  total.add(-0.5);
+  EXPECT_EQ(total.value(), 2.5);
+  EXPECT_EQ(total.error_bound(), 0.0);
+
+  // round-off is kept in the compensation term
+  total.reset(1.0);
+  total.add(1e-20);
+  total.add(-1.0);
+  EXPECT_EQ(total.value(), 1e-20);
+  EXPECT_GT(total.error_bound(), 0.0);
+  EXPECT_TRUE(total.needs_refresh(1e-20));
+
+  total.reset();
+  EXPECT_EQ(total.value(), 0.0);
+  EXPECT_EQ(total.error_bound(), 0.0);
+  EXPECT_FALSE(total.needs_refresh());
+}
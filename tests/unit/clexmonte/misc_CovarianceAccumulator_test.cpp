@@ -0,0 +1,55 @@
+#include <cmath>
+
+#include "casm/clexmonte/misc/CovarianceAccumulator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Two-pass population covariance of the columns of X and Y
+Eigen::MatrixXd two_pass_covariance(Eigen::MatrixXd const &X,
+                                    Eigen::MatrixXd const &Y) {
+  Eigen::MatrixXd dX = X.rowwise() - X.colwise().mean();
+  Eigen::MatrixXd dY = Y.rowwise() - Y.colwise().mean();
+  return dX.transpose() * dY / double(X.rows());
+}
+
+}  // namespace
+
+/// \brief Test that streaming and merged covariance match the two-pass
+///     result
+TEST(misc_CovarianceAccumulator_Test, Test1) {
+  using namespace clexmonte;
+
+  Index N = 100;
+  Eigen::MatrixXd X(N, 2);
+  Eigen::MatrixXd Y(N, 3);
+  for (Index k = 0; k < N; ++k) {
+    double t = k;
+    X.row(k) << 1e6 + std::sin(t), std::cos(0.3 * t);
+    Y.row(k) << t, std::sin(t) * std::cos(t), -2.0;
+  }
+  Eigen::MatrixXd expected = two_pass_covariance(X, Y);
+
+  CovarianceAccumulator all(2, 3);
+  CovarianceAccumulator first(2, 3);
+  CovarianceAccumulator second(2, 3);
+  EXPECT_TRUE(std::isnan(all.covariance()(0, 0)));
+  for (Index k = 0; k < N; ++k) {
+    all.push(X.row(k).transpose(), Y.row(k).transpose());
+    if (k < 37) {
+      first.push(X.row(k).transpose(), Y.row(k).transpose());
+    } else {
+      second.push(X.row(k).transpose(), Y.row(k).transpose());
+    }
+  }
+  first.merge(second);
+
+  EXPECT_EQ(all.count(), N);
+  EXPECT_EQ(first.count(), N);
+  EXPECT_TRUE(all.covariance().isApprox(expected, 1e-8));
+  EXPECT_TRUE(first.covariance().isApprox(expected, 1e-8));
+  EXPECT_TRUE(all.mean_x().isApprox(X.colwise().mean().transpose()));
+  EXPECT_TRUE(first.mean_y().isApprox(Y.colwise().mean().transpose()));
+}
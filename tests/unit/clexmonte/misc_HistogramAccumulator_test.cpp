@@ -0,0 +1,78 @@
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/clexmonte/misc/HistogramAccumulator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test fixed bins, with underflow and overflow
+TEST(misc_HistogramAccumulator_Test, Test1) {
+  using namespace clexmonte;
+
+  HistogramAccumulator histogram(0.0, 1.0, 4);
+  for (double x : {-0.1, 0.0, 0.1, 0.3, 0.55, 0.99, 1.0, 2.0}) {
+    histogram.push(x);
+  }
+  EXPECT_EQ(histogram.count(), 8);
+  EXPECT_EQ(histogram.n_underflow(), 1);
+  EXPECT_EQ(histogram.n_overflow(), 2);
+  EXPECT_EQ(histogram.counts(), std::vector<Index>({2, 1, 1, 1}));
+  Eigen::VectorXd edges = histogram.bin_edges();
+  ASSERT_EQ(edges.size(), 5);
+  EXPECT_DOUBLE_EQ(edges(0), 0.0);
+  EXPECT_DOUBLE_EQ(edges(4), 1.0);
+
+  HistogramAccumulator other(0.0, 1.0, 4);
+  other.push(0.6);
+  histogram.merge(other);
+  EXPECT_EQ(histogram.counts(), std::vector<Index>({2, 1, 2, 1}));
+  EXPECT_EQ(histogram.count(), 9);
+
+  EXPECT_THROW(histogram.merge(HistogramAccumulator(0.0, 2.0, 4)),
+               std::runtime_error);
+  EXPECT_THROW(HistogramAccumulator(1.0, 0.0, 4), std::runtime_error);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.counts(), std::vector<Index>({0, 0, 0, 0}));
+}
+
+/// \brief Test adaptive bins grow to include all values, doubling the bin
+///     width when needed, and match a histogram of all values at the final
+///     width
+TEST(misc_HistogramAccumulator_Test, Test2) {
+  using namespace clexmonte;
+
+  HistogramAccumulator histogram = HistogramAccumulator::adaptive(0.5, 8);
+  HistogramAccumulator first = HistogramAccumulator::adaptive(0.5, 8);
+  HistogramAccumulator second = HistogramAccumulator::adaptive(0.5, 8);
+  std::vector<double> values;
+  for (Index k = 0; k < 200; ++k) {
+    double x = 3.0 * std::sin(0.7 * k) - 0.25;
+    values.push_back(x);
+    histogram.push(x);
+    (k % 2 ? first : second).push(x);
+  }
+  EXPECT_EQ(histogram.count(), 200);
+  EXPECT_LE(histogram.counts().size(), 8);
+  EXPECT_GT(histogram.bin_width(), 0.5);
+
+  // each value is in its bin
+  double w = histogram.bin_width();
+  Eigen::VectorXd edges = histogram.bin_edges();
+  std::vector<Index> expected(histogram.counts().size(), 0);
+  for (double x : values) {
+    Index i = Index(std::floor((x - edges(0)) / w));
+    ASSERT_GE(i, 0);
+    ASSERT_LT(i, Index(expected.size()));
+    ++expected[i];
+  }
+  EXPECT_EQ(histogram.counts(), expected);
+
+  first.merge(second);
+  EXPECT_EQ(first.count(), 200);
+  EXPECT_EQ(first.bin_width(), w);
+  EXPECT_EQ(first.counts(), expected);
+}
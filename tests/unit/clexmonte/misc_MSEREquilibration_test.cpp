@@ -0,0 +1,80 @@
+#include <cmath>
+#include <random>
+
+#include "casm/clexmonte/misc/MSEREquilibration.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Samples that decay exponentially from 10.0 to 0.0, plus noise
+Eigen::VectorXd make_burn_in_observations(Index n, double decay_length,
+                                          std::mt19937_64 &engine) {
+  std::normal_distribution<double> dist(0.0, 0.1);
+  Eigen::VectorXd observations(n);
+  for (Index i = 0; i < n; ++i) {
+    observations(i) = 10.0 * std::exp(-i / decay_length) + dist(engine);
+  }
+  return observations;
+}
+
+}  // namespace
+
+TEST(MSEREquilibrationTest, Truncation) {
+  std::vector<double> block_means = {10.0, 5.0, 1.0, 0.0, 0.1,
+                                     -0.1, 0.0, 0.1, -0.1, 0.0};
+  clexmonte::MSERTruncation truncation =
+      clexmonte::mser_truncation(block_means);
+  EXPECT_TRUE(truncation.is_equilibrated);
+  EXPECT_EQ(truncation.n_truncated_blocks, 3);
+
+  // minimum in the second half: not equilibrated
+  block_means = {10.0, 9.0, 8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0};
+  truncation = clexmonte::mser_truncation(block_means);
+  EXPECT_FALSE(truncation.is_equilibrated);
+
+  // too few blocks
+  truncation = clexmonte::mser_truncation({1.0, 1.0}, 4);
+  EXPECT_FALSE(truncation.is_equilibrated);
+}
+
+TEST(MSEREquilibrationTest, EquilibrationCheck) {
+  std::mt19937_64 engine(1234);
+  Eigen::VectorXd observations =
+      make_burn_in_observations(10000, 200.0, engine);
+  clexmonte::MSEREquilibrationCheck check;
+  monte::RequestedPrecision requested_precision;
+  monte::IndividualEquilibrationCheckResult result =
+      check(observations, Eigen::VectorXd(), requested_precision);
+  EXPECT_TRUE(result.is_equilibrated);
+  EXPECT_EQ(result.N_samples_for_equilibration % 5, 0);
+  EXPECT_GT(result.N_samples_for_equilibration, 500);
+  EXPECT_LT(result.N_samples_for_equilibration, 5000);
+
+  // still decaying: not equilibrated
+  result = check(observations.head(200), Eigen::VectorXd(),
+                 requested_precision);
+  EXPECT_FALSE(result.is_equilibrated);
+}
+
+TEST(MSEREquilibrationTest, Streaming) {
+  std::mt19937_64 engine(1234);
+  Index n = 100000;
+  Eigen::VectorXd observations = make_burn_in_observations(n, 200.0, engine);
+
+  clexmonte::StreamingMSEREquilibration streaming(5, 16);
+  for (Index i = 0; i < n; ++i) {
+    streaming.push(observations(i));
+    EXPECT_LT(streaming.n_kept_blocks(), 16);
+  }
+  EXPECT_TRUE(streaming.is_equilibrated());
+  EXPECT_EQ(streaming.n_kept_blocks(), 0);
+  EXPECT_GT(streaming.n_burn_in_samples(), 500);
+  EXPECT_LT(streaming.n_burn_in_samples(), n / 2);
+
+  // production statistics exclude burn-in
+  clexmonte::BatchMeansAccumulator const &production = streaming.production();
+  EXPECT_NEAR(production.mean(), 0.0, 0.05);
+  EXPECT_LT(production.calculated_precision(0.95), 0.05);
+}
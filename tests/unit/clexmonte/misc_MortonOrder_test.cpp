@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <set>
+
+#include "casm/clexmonte/misc/MortonOrder.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test Morton codes of small coordinates
+TEST(misc_MortonOrder_Test, MortonCodeTest1) {
+  using clexmonte::morton_code;
+  EXPECT_EQ(morton_code(0, 0, 0), 0u);
+  EXPECT_EQ(morton_code(1, 0, 0), 1u);
+  EXPECT_EQ(morton_code(0, 1, 0), 2u);
+  EXPECT_EQ(morton_code(0, 0, 1), 4u);
+  EXPECT_EQ(morton_code(1, 1, 1), 7u);
+  EXPECT_EQ(morton_code(2, 0, 0), 8u);
+  EXPECT_EQ(morton_code(3, 3, 3), 63u);
+  EXPECT_EQ(morton_code((1 << 21) - 1, 0, 0), 0x1249249249249249u);
+}
+
+/// \brief Test that Morton order is a permutation of all unit cells, and
+///     that each aligned 2x2x2 block is visited consecutively
+TEST(misc_MortonOrder_Test, MortonUnitcellOrderTest1) {
+  Eigen::Matrix3l T;
+  T << 4, 0, 0, 0, 4, 0, 0, 0, 4;
+  xtal::UnitCellIndexConverter unitcell_converter(T);
+  std::vector<Index> order =
+      clexmonte::make_morton_unitcell_order(unitcell_converter);
+  ASSERT_EQ(order.size(), 64);
+  EXPECT_EQ(std::set<Index>(order.begin(), order.end()).size(), 64);
+
+  for (Index block = 0; block < 8; ++block) {
+    std::set<std::vector<long>> block_origin;
+    for (Index i = 0; i < 8; ++i) {
+      xtal::UnitCell c = unitcell_converter(order[block * 8 + i]);
+      block_origin.insert({c(0) / 2, c(1) / 2, c(2) / 2});
+    }
+    EXPECT_EQ(block_origin.size(), 1);
+  }
+}
@@ -0,0 +1,51 @@
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/misc/PhaseTimings.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that repeated phases accumulate, in the order first timed
+TEST(misc_PhaseTimings_Test, PhaseTimingsTest1) {
+  clexmonte::PhaseTimings timings;
+  timings.add("b", 1.0);
+  timings.add("a", 2.0);
+  timings.add("b", 0.5);
+
+  auto entries = timings.entries();
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[0].first, "b");
+  EXPECT_EQ(entries[0].second.n_calls, 2);
+  EXPECT_DOUBLE_EQ(entries[0].second.total_time_s, 1.5);
+  EXPECT_EQ(entries[1].first, "a");
+  EXPECT_EQ(entries[1].second.n_calls, 1);
+
+  jsonParser json;
+  to_json(timings, json);
+  EXPECT_EQ(json["b"]["n_calls"].get<Index>(), 2);
+  EXPECT_DOUBLE_EQ(json["a"]["total_time_s"].get<double>(), 2.0);
+}
+
+/// \brief Test PhaseTimer, and the times of phases timed since an earlier
+///     copy
+TEST(misc_PhaseTimings_Test, PhaseTimerTest1) {
+  clexmonte::PhaseTimings timings;
+  timings.set_log_verbosity(Log::debug + 1);
+  {
+    clexmonte::PhaseTimer timer(timings, "a");
+    timer.stop();
+    timer.stop();
+  }
+  auto earlier = timings.entries();
+  ASSERT_EQ(earlier.size(), 1);
+  EXPECT_EQ(earlier[0].second.n_calls, 1);
+  EXPECT_GE(earlier[0].second.total_time_s, 0.0);
+
+  timings.add("b", 3.0);
+  auto since = clexmonte::phase_times_since(timings, earlier);
+  ASSERT_EQ(since.size(), 1);
+  EXPECT_EQ(since[0].first, "b");
+  EXPECT_DOUBLE_EQ(since[0].second, 3.0);
+
+  since = clexmonte::phase_times_since(timings, {});
+  EXPECT_EQ(since.size(), 2);
+}
@@ -0,0 +1,51 @@
+#include <random>
+
+#include "casm/clexmonte/misc/Philox4x32.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test Philox4x32-10 known answers (from the Random123 test vectors)
+TEST(misc_Philox4x32_Test, KnownAnswerTest1) {
+  using clexmonte::Philox4x32;
+  EXPECT_EQ(Philox4x32::block({0, 0, 0, 0}, {0, 0}),
+            (std::array<std::uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                          0x9b00dbd8}));
+  EXPECT_EQ(Philox4x32::block({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                              {0xffffffff, 0xffffffff}),
+            (std::array<std::uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                          0x6d5451fd}));
+  EXPECT_EQ(Philox4x32::block({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                              {0xa4093822, 0x299f31d0}),
+            (std::array<std::uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                          0x24126ea1}));
+}
+
+/// \brief Test streams, seeding, and discard
+TEST(misc_Philox4x32_Test, StreamTest1) {
+  using clexmonte::Philox4x32;
+  Philox4x32 a(12345, 0);
+  Philox4x32 b(12345, 1);
+  Philox4x32 c(12345, 0);
+  std::vector<std::uint32_t> values_a;
+  bool all_equal = true;
+  for (int i = 0; i < 10; ++i) {
+    values_a.push_back(a());
+    all_equal = all_equal && (values_a.back() == b());
+    EXPECT_EQ(values_a.back(), c());
+  }
+  EXPECT_FALSE(all_equal);
+
+  for (int n = 0; n < 10; ++n) {
+    Philox4x32 d(12345, 0);
+    d.discard(n);
+    EXPECT_EQ(d(), values_a[n]);
+  }
+
+  auto e0 = clexmonte::make_stream_engine<std::mt19937_64>(12345, 0);
+  auto e1 = clexmonte::make_stream_engine<std::mt19937_64>(12345, 1);
+  auto e2 = clexmonte::make_stream_engine<std::mt19937_64>(12345, 0);
+  auto x0 = (*e0)();
+  EXPECT_NE(x0, (*e1)());
+  EXPECT_EQ(x0, (*e2)());
+}
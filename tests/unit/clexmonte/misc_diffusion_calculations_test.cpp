@@ -0,0 +1,361 @@
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/misc/diffusion_calculations.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Has the members of monte::KMCData used by KMCDisplacementCache
+struct TestKMCData {
+  Eigen::MatrixXd atom_positions_cart;
+  std::map<std::string, Eigen::MatrixXd> prev_atom_positions_cart;
+  double time = 0.0;
+  std::map<std::string, double> prev_time;
+  std::string sampling_fixture_label;
+  std::vector<Index> atom_name_index_list;
+};
+
+}  // namespace
+
+/// \brief Test that KMCDisplacementCache updates when the sample changes
+TEST(misc_diffusion_calculations_Test, KMCDisplacementCacheTest1) {
+  using namespace clexmonte;
+
+  TestKMCData kmc_data;
+  kmc_data.atom_positions_cart = Eigen::MatrixXd::Constant(3, 4, 1.0);
+  kmc_data.prev_atom_positions_cart["A"] = Eigen::MatrixXd::Zero(3, 4);
+  kmc_data.prev_atom_positions_cart["B"] =
+      Eigen::MatrixXd::Constant(3, 4, 0.5);
+  kmc_data.time = 2.0;
+  kmc_data.prev_time["A"] = 0.0;
+  kmc_data.prev_time["B"] = 1.5;
+  kmc_data.sampling_fixture_label = "A";
+
+  KMCDisplacementCache cache;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(
+      Eigen::MatrixXd::Constant(3, 4, 1.0)));
+  EXPECT_EQ(cache.delta_time(kmc_data), 2.0);
+
+  // Same sample: the cached matrix is reused
+  Eigen::MatrixXd const *first = &cache.delta_R(kmc_data);
+  EXPECT_EQ(&cache.delta_R(kmc_data), first);
+
+  // Different sampling fixture
+  kmc_data.sampling_fixture_label = "B";
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(
+      Eigen::MatrixXd::Constant(3, 4, 0.5)));
+  EXPECT_EQ(cache.delta_time(kmc_data), 0.5);
+
+  // Later sample by the same sampling fixture
+  kmc_data.prev_atom_positions_cart["B"] = kmc_data.atom_positions_cart;
+  kmc_data.prev_time["B"] = kmc_data.time;
+  kmc_data.atom_positions_cart = Eigen::MatrixXd::Constant(3, 4, 3.0);
+  kmc_data.time = 4.0;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(
+      Eigen::MatrixXd::Constant(3, 4, 2.0)));
+  EXPECT_EQ(cache.delta_time(kmc_data), 2.0);
+
+  // Positions changed without a change in time require reset
+  kmc_data.atom_positions_cart = Eigen::MatrixXd::Constant(3, 4, 5.0);
+  cache.reset();
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(
+      Eigen::MatrixXd::Constant(3, 4, 4.0)));
+}
+
+/// \brief Test KMCDisplacementCache with accumulated displacements
+TEST(misc_diffusion_calculations_Test, KMCDisplacementCacheTest2) {
+  using namespace clexmonte;
+
+  // kmc_data positions are not used
+  TestKMCData kmc_data;
+  kmc_data.atom_name_index_list = {0, 1, 1};
+  kmc_data.prev_time["A"] = 0.0;
+  kmc_data.prev_time["B"] = 0.0;
+
+  KMCDisplacementCache cache;
+  cache.reset_accumulated(3, {"A", "B"});
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::individual_isotropic, {"X", "Y"});
+
+  // First sample of each fixture is relative to the reset
+  cache.add_displacement(1, Eigen::Vector3d(1.0, 0.0, 0.0));
+  cache.add_displacement(1, Eigen::Vector3d(1.0, 0.0, 0.0));
+  kmc_data.time = 1.0;
+  kmc_data.sampling_fixture_label = "A";
+  Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(3, 3);
+  expected(0, 1) = 2.0;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(expected));
+  DiffusionSums const &sums = cache.diffusion_sums(kmc_data, layout);
+  EXPECT_EQ(sums.n_atoms, 3.0);
+  EXPECT_TRUE(sums.N.isApprox(Eigen::Vector2d(1.0, 2.0)));
+  EXPECT_EQ(sums.sumR(0, 1), 2.0);
+  EXPECT_EQ(sums.sumRR(0, 1), 4.0);
+  EXPECT_EQ(sums.sumR.col(0).norm(), 0.0);
+
+  cache.add_displacement(2, Eigen::Vector3d(0.0, 0.0, 3.0));
+  kmc_data.time = 2.0;
+  kmc_data.sampling_fixture_label = "B";
+  expected(2, 2) = 3.0;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(expected));
+
+  // Later samples are relative to the fixture's previous sample
+  kmc_data.prev_time["A"] = 1.0;
+  kmc_data.time = 3.0;
+  kmc_data.sampling_fixture_label = "A";
+  expected.setZero();
+  expected(2, 2) = 3.0;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(expected));
+  EXPECT_EQ(cache.delta_time(kmc_data), 2.0);
+
+  // A skipped sample is an error
+  kmc_data.prev_time["B"] = 2.5;
+  kmc_data.sampling_fixture_label = "B";
+  EXPECT_THROW(cache.delta_R(kmc_data), std::runtime_error);
+
+  // A sampling fixture without a slot is an error
+  kmc_data.prev_time["C"] = 0.0;
+  kmc_data.sampling_fixture_label = "C";
+  EXPECT_THROW(cache.delta_R(kmc_data), std::runtime_error);
+
+  // Repeated requests for one sample do not consume displacements again
+  cache.add_displacement(0, Eigen::Vector3d(0.0, 1.0, 0.0));
+  kmc_data.prev_time["A"] = 3.0;
+  kmc_data.time = 4.0;
+  kmc_data.sampling_fixture_label = "A";
+  expected.setZero();
+  expected(1, 0) = 1.0;
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(expected));
+  EXPECT_TRUE(cache.delta_R(kmc_data).isApprox(expected));
+  EXPECT_EQ(cache.delta_time(kmc_data), 1.0);
+}
+
+/// \brief Test KMCJumpCounter counting jumps of individual atoms
+TEST(misc_diffusion_calculations_Test, KMCJumpCounterTest1) {
+  using namespace clexmonte;
+
+  KMCJumpCounter counter;
+  counter.reset({1, 1, 0}, 3);
+  EXPECT_TRUE(counter.n_atoms().isApprox(Eigen::Vector3d(1.0, 2.0, 0.0)));
+  EXPECT_TRUE(counter.sum_n_jumps().isZero());
+
+  counter.count_atom(0);
+  counter.count_atom(2);
+  counter.count_atom(2);
+  EXPECT_TRUE(
+      counter.sum_n_jumps().isApprox(Eigen::Vector3d(2.0, 1.0, 0.0)));
+}
+
+/// \brief Test DiffusionObservableLayout against direct calculation
+TEST(misc_diffusion_calculations_Test, DiffusionObservableLayoutTest1) {
+  using namespace clexmonte;
+
+  std::vector<std::string> name_list({"A", "B", "C"});
+  Index n_atoms = 50;
+  std::vector<Index> name_index_list;
+  for (Index l = 0; l < n_atoms; ++l) {
+    name_index_list.push_back(l % 3);
+  }
+  Eigen::MatrixXd delta_R = Eigen::MatrixXd::Random(3, n_atoms);
+
+  DiffusionSums sums;
+  sums.reset(name_list.size());
+  sums.accumulate(name_index_list, delta_R);
+
+  // Direct per type sums
+  std::vector<Eigen::Vector3d> sumR(3, Eigen::Vector3d::Zero());
+  std::vector<Eigen::Matrix3d> sumRR(3, Eigen::Matrix3d::Zero());
+  std::vector<double> N(3, 0.0);
+  for (Index l = 0; l < n_atoms; ++l) {
+    Index i = name_index_list[l];
+    sumR[i] += delta_R.col(l);
+    sumRR[i] += delta_R.col(l) * delta_R.col(l).transpose();
+    N[i] += 1.0;
+  }
+
+  Eigen::VectorXd v;
+  DiffusionObservableLayout collective_isotropic(
+      DiffusionObservableType::collective_isotropic, name_list);
+  collective_isotropic.mean_R_squared(sums, v);
+  ASSERT_EQ(v.size(),
+            make_component_names<CollectiveIsotropicCounter>(name_list).size());
+  CollectiveIsotropicCounter c1(name_list);
+  for (Index c = 0; c < v.size(); ++c, c1.advance()) {
+    EXPECT_NEAR(v(c), sumR[c1.i].dot(sumR[c1.j]) / n_atoms, 1e-12);
+  }
+
+  DiffusionObservableLayout collective_anisotropic(
+      DiffusionObservableType::collective_anisotropic, name_list);
+  collective_anisotropic.mean_R_squared(sums, v);
+  ASSERT_EQ(v.size(), make_component_names<CollectiveAnisotropicCounter>(
+                          name_list)
+                          .size());
+  CollectiveAnisotropicCounter c2(name_list);
+  for (Index c = 0; c < v.size(); ++c, c2.advance()) {
+    EXPECT_NEAR(v(c), sumR[c2.i](c2.alpha) * sumR[c2.j](c2.beta) / n_atoms,
+                1e-12);
+  }
+
+  DiffusionObservableLayout individual_isotropic(
+      DiffusionObservableType::individual_isotropic, name_list);
+  individual_isotropic.mean_R_squared(sums, v);
+  ASSERT_EQ(v.size(), 3);
+  for (Index i = 0; i < 3; ++i) {
+    EXPECT_NEAR(v(i), sumRR[i].trace() / N[i], 1e-12);
+  }
+
+  DiffusionObservableLayout individual_anisotropic(
+      DiffusionObservableType::individual_anisotropic, name_list);
+  individual_anisotropic.mean_R_squared(sums, v);
+  ASSERT_EQ(v.size(), make_component_names<IndividualAnisotropicCounter>(
+                          name_list)
+                          .size());
+  IndividualAnisotropicCounter c3(name_list);
+  for (Index c = 0; c < v.size(); ++c, c3.advance()) {
+    EXPECT_NEAR(v(c), sumRR[c3.i](c3.alpha, c3.beta) / N[c3.i], 1e-12);
+  }
+
+  // Sums over separate sets of atoms may be combined
+  DiffusionSums first;
+  first.reset(name_list.size());
+  first.accumulate(std::vector<Index>(name_index_list.begin(),
+                                      name_index_list.begin() + 20),
+                   delta_R.leftCols(20));
+  DiffusionSums second;
+  second.reset(name_list.size());
+  second.accumulate(std::vector<Index>(name_index_list.begin() + 20,
+                                       name_index_list.end()),
+                    delta_R.rightCols(n_atoms - 20));
+  first.add(second);
+  EXPECT_EQ(first.n_atoms, sums.n_atoms);
+  EXPECT_TRUE(first.sumR.isApprox(sums.sumR));
+  EXPECT_TRUE(first.sumRR.isApprox(sums.sumRR));
+  EXPECT_TRUE(first.N.isApprox(sums.N));
+}
+
+/// \brief Test KMCRateWeightedDiffusionSums for an unbiased 1d random walk,
+///     with constant rates, against the exact values
+TEST(misc_diffusion_calculations_Test, KMCRateWeightedDiffusionSumsTest1) {
+  using namespace clexmonte;
+
+  // one atom type, events +x and -x, each with rate r
+  double r = 2.0;
+  Index n_atoms = 10;
+  std::vector<std::vector<PrimEventAtomDisplacement>> prim_event_dR(2);
+  prim_event_dR[0].push_back({0, Eigen::Vector3d(1.0, 0.0, 0.0)});
+  prim_event_dR[1].push_back({0, Eigen::Vector3d(-1.0, 0.0, 0.0)});
+  std::vector<double> prim_event_total_rate({r, r});
+
+  KMCRateWeightedDiffusionSums sums;
+  sums.reset(prim_event_dR, 1, n_atoms, false);
+  sums.add_step(prim_event_total_rate, 0);
+  EXPECT_EQ(sums.sums().n_steps, 0);
+
+  sums.reset(prim_event_dR, 1, n_atoms, true);
+  Index n_steps = 100;
+  for (Index k = 0; k < n_steps; ++k) {
+    sums.add_step(prim_event_total_rate, (k % 3) ? 0 : 1);
+  }
+  EXPECT_EQ(sums.sums().n_steps, n_steps);
+
+  // E[dR dR^T](x, x) = n_steps, independent of the selected events
+  Eigen::MatrixXd E;
+  double delta_time =
+      sums.second_moment(KMCRateWeightedDiffusionSums::Snapshot(), E);
+  EXPECT_NEAR(delta_time, n_steps / (2.0 * r), 1e-12);
+  ASSERT_EQ(E.rows(), 3);
+  EXPECT_NEAR(E(0, 0), double(n_steps), 1e-10);
+  EXPECT_NEAR(E.norm(), double(n_steps), 1e-10);
+
+  // L_anisotropic(x, x) = r / n_atoms
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_anisotropic, {"A"});
+  Eigen::VectorXd v;
+  layout.collective_mean_R_squared(E, sums.n_atoms(), v);
+  v /= (2.0 * delta_time);
+  EXPECT_NEAR(v(0), r / n_atoms, 1e-12);
+
+  // Same result from a snapshot, over the following interval
+  KMCRateWeightedDiffusionSums::Snapshot prev = sums.sums();
+  for (Index k = 0; k < n_steps; ++k) {
+    sums.add_step(prim_event_total_rate, 0);
+  }
+  delta_time = sums.second_moment(prev, E);
+  EXPECT_NEAR(delta_time, n_steps / (2.0 * r), 1e-12);
+  EXPECT_NEAR(E(0, 0), double(n_steps), 1e-10);
+}
+
+/// \brief Test KMCRateWeightedDiffusionSums for a biased walk, with varying
+///     rates and two atom types, against direct summation
+TEST(misc_diffusion_calculations_Test, KMCRateWeightedDiffusionSumsTest2) {
+  using namespace clexmonte;
+
+  // atom types A and B; event 0 moves A +x and B -y, event 1 moves A -z
+  std::vector<std::vector<PrimEventAtomDisplacement>> prim_event_dR(2);
+  prim_event_dR[0].push_back({0, Eigen::Vector3d(1.0, 0.0, 0.0)});
+  prim_event_dR[0].push_back({1, Eigen::Vector3d(0.0, -1.0, 0.0)});
+  prim_event_dR[1].push_back({0, Eigen::Vector3d(0.0, 0.0, -1.0)});
+  Eigen::VectorXd v0(6), v1(6);
+  v0 << 1.0, 0.0, 0.0, 0.0, -1.0, 0.0;
+  v1 << 0.0, 0.0, -1.0, 0.0, 0.0, 0.0;
+
+  KMCRateWeightedDiffusionSums sums;
+  sums.reset(prim_event_dR, 2, 4, true);
+
+  Index n_steps = 50;
+  Index n_prev = 20;
+  KMCRateWeightedDiffusionSums::Snapshot prev;
+  Eigen::VectorXd R = Eigen::VectorXd::Zero(6);
+  Eigen::VectorXd R_prev;
+  Eigen::MatrixXd E_expected = Eigen::MatrixXd::Zero(6, 6);
+  double W_expected = 0.0;
+  for (Index k = 0; k < n_steps; ++k) {
+    if (k == n_prev) {
+      prev = sums.sums();
+      R_prev = R;
+    }
+    std::vector<double> rate({1.0 + 0.5 * (k % 4), 0.25 + 0.1 * k});
+    Index selected = (k % 5) ? 0 : 1;
+    if (k >= n_prev) {
+      // expected change in (R - R_prev)(R - R_prev)^T over the step
+      double gamma = rate[0] + rate[1];
+      Eigen::VectorXd D = R - R_prev;
+      for (Index p = 0; p < 2; ++p) {
+        Eigen::VectorXd const &v = (p == 0) ? v0 : v1;
+        E_expected += (rate[p] / gamma) *
+                      (D * v.transpose() + v * D.transpose() +
+                       v * v.transpose());
+      }
+      W_expected += 1.0 / gamma;
+    }
+    sums.add_step(rate, selected);
+    R += (selected == 0) ? v0 : v1;
+  }
+  EXPECT_TRUE(sums.sums().R.isApprox(R));
+
+  Eigen::MatrixXd E;
+  double delta_time = sums.second_moment(prev, E);
+  EXPECT_NEAR(delta_time, W_expected, 1e-12);
+  EXPECT_TRUE(E.isApprox(E_expected, 1e-12));
+
+  // isotropic: trace of each 3x3 block, per atom
+  DiffusionObservableLayout layout(
+      DiffusionObservableType::collective_isotropic, {"A", "B"});
+  Eigen::VectorXd v;
+  layout.collective_mean_R_squared(E, 4.0, v);
+  ASSERT_EQ(v.size(), 3);
+  CollectiveIsotropicCounter c({"A", "B"});
+  for (Index i = 0; i < v.size(); ++i, c.advance()) {
+    double expected = E_expected.block<3, 3>(3 * c.i, 3 * c.j).trace() / 4.0;
+    EXPECT_NEAR(v(i), expected, 1e-10);
+  }
+
+  DiffusionObservableLayout individual(
+      DiffusionObservableType::individual_isotropic, {"A", "B"});
+  EXPECT_THROW(individual.collective_mean_R_squared(E, 4.0, v),
+               std::runtime_error);
+}
@@ -0,0 +1,41 @@
+#include <fstream>
+
+#include "casm/clexmonte/monte_calculator/MonteCalculatorCache.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+/// \brief Test that cache entries are keyed by source content and options,
+///     and copy the source directory
+TEST(monte_calculator_MonteCalculatorCache_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path source_dir = tmp_dir.path() / "src";
+  fs::create_directories(source_dir);
+  std::ofstream(source_dir / "MyCalculator.cc") << "// version 1\n";
+  std::ofstream(source_dir / "MyCalculator.o") << "compiled\n";
+
+  MonteCalculatorCache cache(tmp_dir.path() / "cache");
+  fs::path dir_a;
+  {
+    SourceDirCacheEntry entry =
+        cache.acquire(source_dir, "MyCalculator", "-O3", "-shared");
+    dir_a = entry.dir;
+    EXPECT_TRUE(fs::exists(entry.dir / "MyCalculator.cc"));
+    EXPECT_FALSE(fs::exists(entry.dir / "MyCalculator.o"));
+  }
+
+  // same source and options: same entry
+  EXPECT_EQ(cache.acquire(source_dir, "MyCalculator", "-O3", "-shared").dir,
+            dir_a);
+
+  // different options: new entry
+  EXPECT_NE(cache.acquire(source_dir, "MyCalculator", "-O2", "-shared").dir,
+            dir_a);
+
+  // different source: new entry
+  std::ofstream(source_dir / "MyCalculator.cc") << "// version 2\n";
+  EXPECT_NE(cache.acquire(source_dir, "MyCalculator", "-O3", "-shared").dir,
+            dir_a);
+}
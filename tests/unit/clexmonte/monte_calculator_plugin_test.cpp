@@ -0,0 +1,12 @@
+#include "casm/clexmonte/monte_calculator/plugin.hh"
+
+#include "gtest/gtest.h"
+
+CASM_CLEXMONTE_PLUGIN(TestCalculator)
+
+/// \brief Test that the plugin header compiles on its own and that
+///     CASM_CLEXMONTE_PLUGIN declares the current plugin API version
+TEST(monte_calculator_plugin_Test, Test1) {
+  EXPECT_EQ(TestCalculator_plugin_api_version(),
+            CASM_CLEXMONTE_PLUGIN_API_VERSION);
+}
@@ -0,0 +1,251 @@
+#include <cmath>
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/events/SumTreeEventSelector.hh"
+#include "casm/clexmonte/nfold/canonical_nfold.hh"
+#include "casm/clexmonte/nfold/canonical_nfold_json_io.hh"
+#include "casm/clexmonte/run/io/json/parse_and_run_series.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::monte;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// \brief Write a Clex_ZrO_Occ system.json, with absolute paths to the
+///     clexulator source and coefficients, to `test_dir`
+fs::path write_system_json(fs::path test_dir) {
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  fs::path clexulator_src_relpath = fs::path("basis_sets") /
+                                    "bset.formation_energy" /
+                                    "ZrO_Clexulator_formation_energy.cc";
+  fs::path eci_relpath = "formation_energy_eci.json";
+
+  fs::create_directories(test_dir / clexulator_src_relpath.parent_path());
+  fs::copy_file(test_data_dir / clexulator_src_relpath,
+                test_dir / clexulator_src_relpath);
+  fs::copy_file(test_data_dir / eci_relpath, test_dir / eci_relpath);
+
+  jsonParser system_json(test_data_dir / "system.json");
+  system_json["basis_sets"]["formation_energy"]["source"] =
+      (test_dir / clexulator_src_relpath).string();
+  system_json["clex"]["formation_energy"]["coefficients"] =
+      (test_dir / eci_relpath).string();
+  fs::path system_json_file = test_dir / "system.json";
+  system_json.write(system_json_file);
+  return system_json_file;
+}
+
+/// \brief Write a short canonical N-fold way run_params.json, using the
+///     "sum_tree" event selector and writing results to `output_dir`, to
+///     `run_params_json_file`
+void write_run_params_json(fs::path run_params_json_file, fs::path output_dir,
+                           Index n_states) {
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  jsonParser run_params_json(test_data_dir / "run_params_complete.json");
+  jsonParser &kwargs = run_params_json["state_generation"]["kwargs"];
+  kwargs["initial_configuration"]["kwargs"]
+        ["transformation_matrix_to_supercell"] = jsonParser::parse(
+            std::string("[[2, 0, 0], [0, 2, 0], [0, 0, 2]]"));
+  kwargs["n_states"] = n_states;
+  kwargs["completed_runs"]["output_dir"] = output_dir.string();
+  jsonParser &thermo = run_params_json["sampling_fixtures"]["thermo"];
+  thermo["completion_check"]["cutoff"]["count"]["max"] = 10;
+  thermo["results_io"]["kwargs"]["output_dir"] =
+      (output_dir / "thermo").string();
+  run_params_json["calculation_options"]["event_selector"]["type"] =
+      "sum_tree";
+  run_params_json.write(run_params_json_file);
+}
+
+}  // namespace
+
+class nfold_canonical_nfold_Test : public ZrOTestSystem {
+ public:
+  typedef std::mt19937_64 engine_type;
+
+  nfold_canonical_nfold_Test()
+      : T(Eigen::Matrix3l::Identity() * 3),
+        state(make_default_configuration(*system, T),
+              canonical::make_conditions(
+                  1000.0, system->composition_converter,
+                  {{"Zr", 2.0}, {"O", 2.0 / 3.0}, {"Va", 4.0 / 3.0}})),
+        convert(*get_prim_basicstructure(*system), T),
+        occ_candidate_list(convert),
+        occ_location(convert, occ_candidate_list) {
+    // occupy 18 of the 54 O sites, so that O and Va are mixed
+    Index volume = T.determinant();
+    for (Index i = 0; i < 2 * volume; i += 3) {
+      get_occupation(state)(2 * volume + i) = 1;
+    }
+    occ_location.initialize(get_occupation(state));
+    potential = std::make_shared<canonical::CanonicalPotential>(system);
+    potential->set(&state, make_conditions(*system, state));
+    event_data = std::make_shared<nfold::CanonicalNfoldEventData>(
+        system, state, occ_location, get_canonical_swaps(*system), potential);
+  }
+
+  /// \brief Brute-force rate of an event: the Metropolis acceptance
+  ///     probability, from the difference of two full potential energy
+  ///     evaluations, if the event is allowed, else 0.0
+  double brute_force_rate(EventID const &id) {
+    auto const &event = event_data->event_list.events.at(id).event;
+    auto const &prim_event_data =
+        event_data->prim_event_list.at(id.prim_event_index);
+    Eigen::VectorXi &occupation = get_occupation(state);
+    for (Index i = 0; i < event.linear_site_index.size(); ++i) {
+      if (occupation(event.linear_site_index[i]) !=
+          prim_event_data.occ_init[i]) {
+        return 0.0;
+      }
+    }
+    double E_init = potential->per_supercell();
+    for (Index i = 0; i < event.linear_site_index.size(); ++i) {
+      occupation(event.linear_site_index[i]) = prim_event_data.occ_final[i];
+    }
+    double E_final = potential->per_supercell();
+    for (Index i = 0; i < event.linear_site_index.size(); ++i) {
+      occupation(event.linear_site_index[i]) = prim_event_data.occ_init[i];
+    }
+    double beta = potential->conditions()->beta;
+    return std::min(1.0, std::exp(-beta * (E_final - E_init)));
+  }
+
+  Eigen::Matrix3l T;
+  state_type state;
+  Conversions convert;
+  OccCandidateList occ_candidate_list;
+  OccLocation occ_location;
+  std::shared_ptr<canonical::CanonicalPotential> potential;
+  std::shared_ptr<nfold::CanonicalNfoldEventData> event_data;
+};
+
+/// \brief Test that each event is a composition conserving swap, with the
+///     rate of a brute-force Metropolis acceptance probability
+TEST_F(nfold_canonical_nfold_Test, RateTest1) {
+  Index n_unitcells = T.determinant();
+  Index n_prim_events = event_data->prim_event_list.size();
+  ASSERT_GT(n_prim_events, 0);
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_data->event_list.events);
+  EXPECT_EQ(event_id_list.size(), n_unitcells * n_prim_events);
+
+  Index n_allowed = 0;
+  Index n_uphill = 0;
+  for (EventID const &id : event_id_list) {
+    auto const &event = event_data->event_list.events.at(id).event;
+    auto const &prim_event_data =
+        event_data->prim_event_list.at(id.prim_event_index);
+    ASSERT_EQ(event.linear_site_index.size(), 2);
+
+    // the species on the two sites are exchanged
+    std::vector<Index> species_init;
+    std::vector<Index> species_final;
+    for (Index i = 0; i < 2; ++i) {
+      Index asym = convert.l_to_asym(event.linear_site_index[i]);
+      species_init.push_back(
+          convert.species_index(asym, prim_event_data.occ_init[i]));
+      species_final.push_back(
+          convert.species_index(asym, prim_event_data.occ_final[i]));
+    }
+    EXPECT_NE(species_init[0], species_init[1]);
+    EXPECT_EQ(species_final[0], species_init[1]);
+    EXPECT_EQ(species_final[1], species_init[0]);
+
+    double rate = event_data->event_calculator->calculate_rate(id);
+    double expected = brute_force_rate(id);
+    EXPECT_NEAR(rate, expected, 1e-10);
+    if (expected > 0.0) {
+      ++n_allowed;
+    }
+    if (expected > 0.0 && expected < 1.0) {
+      ++n_uphill;
+    }
+  }
+  EXPECT_GT(n_allowed, 0);
+  EXPECT_GT(n_uphill, 0);
+}
+
+/// \brief Test that the time step is the expected number of Metropolis
+///     steps per accepted event, compared with brute-force Metropolis
+///     proposals of the complete event list
+TEST_F(nfold_canonical_nfold_Test, TimeStepTest1) {
+  Index n_unitcells = T.determinant();
+  Index n_prim_events = event_data->prim_event_list.size();
+  std::vector<EventID> event_id_list =
+      make_included_event_id_list(event_data->event_list.events);
+  double n_events_possible = event_id_list.size();
+
+  double total_rate = 0.0;
+  for (EventID const &id : event_id_list) {
+    total_rate += brute_force_rate(id);
+  }
+
+  auto engine = std::make_shared<engine_type>(1234);
+  engine_type engine_copy = *engine;
+  typedef std::map<EventID, std::vector<EventID>> table_type;
+  SumTreeEventSelector<nfold::CanonicalCompleteEventCalculator, table_type,
+                       engine_type>
+      event_selector(event_data->event_calculator, n_unitcells, n_prim_events,
+                     event_id_list, event_data->event_list.impact_table,
+                     engine);
+  EXPECT_NEAR(event_selector.total_rate(), total_rate, 1e-10 * total_rate);
+
+  // the first time increment, from the same random numbers
+  RandomNumberGenerator<engine_type> random_number_generator(
+      std::make_shared<engine_type>(engine_copy));
+  random_number_generator.random_real(total_rate);
+  double u = 1.0 - random_number_generator.random_real(1.0);
+  std::pair<EventID, double> selected = event_selector.select_event();
+  EXPECT_NEAR(selected.second, -std::log(u) / total_rate,
+              1e-10 * selected.second);
+  EXPECT_GT(brute_force_rate(selected.first), 0.0);
+
+  // without applying events, the mean number of Metropolis steps per
+  // accepted event is n_events_possible / total_rate
+  double expected_steps = n_events_possible / total_rate;
+  double sum_steps = 0.0;
+  Index n_select = 20000;
+  for (Index i = 0; i < n_select; ++i) {
+    sum_steps += n_events_possible * event_selector.select_event().second;
+  }
+  EXPECT_NEAR(sum_steps / n_select, expected_steps, 0.05 * expected_steps);
+
+  Index n_proposed = 0;
+  Index n_accepted = 0;
+  while (n_accepted < 2000) {
+    Index i = random_number_generator.random_int(event_id_list.size() - 1);
+    ++n_proposed;
+    if (random_number_generator.random_real(1.0) <
+        brute_force_rate(event_id_list[i])) {
+      ++n_accepted;
+    }
+  }
+  EXPECT_NEAR(double(n_proposed) / n_accepted, expected_steps,
+              0.1 * expected_steps);
+}
+
+/// \brief Test a canonical N-fold way series, as run by
+///     ccasm_clexmonte_canonical_nfold
+TEST(nfold_canonical_nfold_series_Test, Test1) {
+  test::TmpDir tmp_dir;
+  fs::path system_json_file = write_system_json(tmp_dir.path());
+  fs::path output_dir = tmp_dir.path() / "output";
+  fs::path run_params_json_file = tmp_dir.path() / "run_params.json";
+  write_run_params_json(run_params_json_file, output_dir, 2);
+
+  clexmonte::parse_and_run_series<nfold::CanonicalNfold_mt19937_64>(
+      system_json_file, run_params_json_file);
+
+  EXPECT_TRUE(fs::exists(output_dir / "completed_runs.json"));
+  jsonParser completed_runs_json(output_dir / "completed_runs.json");
+  EXPECT_EQ(completed_runs_json.size(), 2);
+  EXPECT_TRUE(fs::exists(output_dir / "thermo" / "summary.json"));
+}
@@ -0,0 +1,134 @@
+#include "ZrOTestSystem.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/run/AdaptiveConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/misc/CASM_math.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+
+class run_AdaptiveConditionsStateGeneratorTest : public test::ZrOTestSystem {
+};
+
+/// \brief Test that the step is refined where the composition jumps
+///
+/// The "final state" of each run is the initial state, with the second O
+/// sublattice filled if the temperature is >= 560 K, so that the
+/// composition jumps between t=2.5 (550 K) and t=2.75 (575 K).
+TEST_F(run_AdaptiveConditionsStateGeneratorTest, Test1) {
+  using namespace CASM;
+  using namespace CASM::monte;
+  using namespace CASM::clexmonte;
+
+  ValueMap init_conditions =
+      canonical::make_conditions(300.0, get_composition_converter(*system),
+                                 {{"Zr", 2.0}, {"O", 0.2}, {"Va", 1.8}});
+  ValueMap conditions_increment = canonical::make_conditions_increment(
+      100.0, get_composition_converter(*system),
+      {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}});
+  Index n_states = 5;
+  bool dependent_runs = false;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Index volume = T.determinant();
+  Configuration init_config = make_default_configuration(*system, T);
+  for (Index i = 0; i < volume; ++i) {
+    init_config.dof_values.occupation(2 * volume + i) = 1;
+  }
+  std::unique_ptr<config_generator_type> config_generator =
+      std::make_unique<FixedConfigGenerator>(init_config);
+
+  AdaptiveStepParams params;
+  params.max_change["mol_composition"] = 0.1;
+  params.max_refinement_level = 2;
+
+  RunDataOutputParams output_params;
+  AdaptiveConditionsStateGenerator state_generator(
+      system, output_params, std::move(config_generator), init_conditions,
+      conditions_increment, n_states, dependent_runs, params);
+  EXPECT_FALSE(state_generator.has_independent_states());
+
+  std::vector<double> temperatures;
+  while (!state_generator.is_complete()) {
+    state_type state = state_generator.next_state();
+    double temperature = state.conditions.scalar_values.at("temperature");
+    temperatures.push_back(temperature);
+
+    state_type final_state = state;
+    if (temperature >= 560.0) {
+      for (Index i = 0; i < volume; ++i) {
+        get_occupation(final_state)(3 * volume + i) = 1;
+      }
+    }
+    RunData run_data;
+    run_data.initial_state = state;
+    run_data.final_state = final_state;
+    run_data.conditions = state.conditions;
+    run_data.transformation_matrix_to_super = T;
+    run_data.n_unitcells = T.determinant();
+    state_generator.push_back(run_data);
+    ASSERT_LT(temperatures.size(), 20);
+  }
+
+  std::vector<double> expected = {300.0, 400.0, 500.0, 600.0,
+                                  550.0, 575.0, 700.0};
+  ASSERT_EQ(temperatures.size(), expected.size());
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(CASM::almost_equal(temperatures[i], expected[i]));
+  }
+
+  std::vector<double> t = state_generator.completed_t();
+  ASSERT_EQ(t.size(), expected.size());
+  EXPECT_TRUE(CASM::almost_equal(t[4], 2.5));
+  EXPECT_TRUE(CASM::almost_equal(t[5], 2.75));
+}
+
+/// \brief Test that without a change in observables, the path is the same
+///     as for IncrementalConditionsStateGenerator
+TEST_F(run_AdaptiveConditionsStateGeneratorTest, Test2) {
+  using namespace CASM;
+  using namespace CASM::monte;
+  using namespace CASM::clexmonte;
+
+  ValueMap init_conditions =
+      canonical::make_conditions(300.0, get_composition_converter(*system),
+                                 {{"Zr", 2.0}, {"O", 0.2}, {"Va", 1.8}});
+  ValueMap conditions_increment = canonical::make_conditions_increment(
+      10.0, get_composition_converter(*system),
+      {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}});
+  Index n_states = 11;
+  bool dependent_runs = true;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Configuration init_config = make_default_configuration(*system, T);
+  std::unique_ptr<config_generator_type> config_generator =
+      std::make_unique<FixedConfigGenerator>(init_config);
+
+  AdaptiveStepParams params;
+  params.max_change["mol_composition"] = 0.1;
+
+  RunDataOutputParams output_params;
+  AdaptiveConditionsStateGenerator state_generator(
+      system, output_params, std::move(config_generator), init_conditions,
+      conditions_increment, n_states, dependent_runs, params);
+
+  while (!state_generator.is_complete()) {
+    state_type state = state_generator.next_state();
+    EXPECT_TRUE(
+        CASM::almost_equal(state.conditions.scalar_values.at("temperature"),
+                           300.0 + 10.0 * state_generator.n_completed_runs()));
+    RunData run_data;
+    run_data.initial_state = state;
+    run_data.final_state = state;
+    run_data.conditions = state.conditions;
+    run_data.transformation_matrix_to_super = T;
+    run_data.n_unitcells = T.determinant();
+    state_generator.push_back(run_data);
+  }
+  EXPECT_EQ(state_generator.n_completed_runs(), n_states);
+}
@@ -0,0 +1,89 @@
+#include "casm/clexmonte/run/AdaptiveSamplingPeriod.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Samples of an AR(1) process, x_{i+1} = phi * x_i + noise
+Eigen::VectorXd make_ar1(double phi, Index n, std::mt19937_64 &engine) {
+  std::normal_distribution<double> dist(0.0, 1.0);
+  Eigen::VectorXd x(n);
+  x(0) = dist(engine);
+  for (Index i = 1; i < n; ++i) {
+    x(i) = phi * x(i - 1) + std::sqrt(1.0 - phi * phi) * dist(engine);
+  }
+  return x;
+}
+
+}  // namespace
+
+/// \brief Test the integrated autocorrelation time estimator against the
+///     exact value (1 + phi) / (1 - phi) of an AR(1) process
+TEST(run_AdaptiveSamplingPeriod_Test, IntegratedAutocorrelationTime) {
+  std::mt19937_64 engine(1234);
+
+  double tau = clexmonte::integrated_autocorrelation_time(
+      make_ar1(0.0, 20000, engine));
+  EXPECT_NEAR(tau, 1.0, 0.1);
+
+  tau = clexmonte::integrated_autocorrelation_time(
+      make_ar1(0.9, 200000, engine));
+  EXPECT_NEAR(tau, 19.0, 3.0);
+
+  tau = clexmonte::integrated_autocorrelation_time(Eigen::VectorXd::Ones(10));
+  EXPECT_EQ(tau, 1.0);
+}
+
+/// \brief Test that the period approaches the autocorrelation time of a
+///     process with exponentially decaying correlations, from above and
+///     below
+TEST(run_AdaptiveSamplingPeriod_Test, Period) {
+  // correlation exp(-t / 50), integrated autocorrelation time 100 counts
+  double tau_exp = 50.0;
+  Index n_counts = 2000000;
+  std::mt19937_64 engine(1234);
+  Eigen::VectorXd process = make_ar1(std::exp(-1.0 / tau_exp), n_counts,
+                                     engine);
+
+  for (double initial_period : {1.0, 1000.0}) {
+    clexmonte::AdaptiveSamplingPeriodParams params;
+    params.initial_period = initial_period;
+    clexmonte::AdaptiveSamplingPeriod adaptive(params);
+
+    Index n = 0;
+    while (true) {
+      Index count = std::lround(adaptive.sample_at(n));
+      if (count >= n_counts) {
+        break;
+      }
+      Eigen::VectorXd value(2);
+      value << process(count), 1.0;  // constant components are ignored
+      adaptive.push("x", value);
+      ++n;
+    }
+
+    std::vector<double> history = adaptive.period_history();
+    ASSERT_GT(history.size(), 20);
+    std::vector<double> tail(history.end() - 10, history.end());
+    std::nth_element(tail.begin(), tail.begin() + 5, tail.end());
+    EXPECT_GT(tail[5], 40.0) << "initial_period: " << initial_period;
+    EXPECT_LT(tail[5], 200.0) << "initial_period: " << initial_period;
+  }
+
+  // sample_at(0) begins a new run
+  clexmonte::AdaptiveSamplingPeriodParams params;
+  params.begin = 10.0;
+  params.initial_period = 5.0;
+  clexmonte::AdaptiveSamplingPeriod adaptive(params);
+  EXPECT_EQ(adaptive.sample_at(0), 10.0);
+  EXPECT_EQ(adaptive.sample_at(1), 15.0);
+  EXPECT_EQ(adaptive.sample_at(1), 15.0);
+  EXPECT_EQ(adaptive.sample_at(2), 20.0);
+  EXPECT_THROW(adaptive.sample_at(4), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "casm/clexmonte/run/AsyncRunPool.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that runs finish, failures are rethrown, and done callbacks
+///     are called
+TEST(run_AsyncRunPool_Test, Test1) {
+  using namespace clexmonte;
+
+  std::atomic<Index> n_runs(0);
+  std::atomic<Index> n_callbacks(0);
+  auto good = std::make_shared<AsyncRun>([&]() { ++n_runs; });
+  auto bad = std::make_shared<AsyncRun>(
+      [&]() { throw std::runtime_error("run failed"); });
+  good->add_done_callback([&]() { ++n_callbacks; });
+  bad->add_done_callback([&]() { ++n_callbacks; });
+  EXPECT_EQ(good->status(), AsyncRunStatus::pending);
+
+  {
+    AsyncRunPool pool(2);
+    EXPECT_EQ(pool.n_workers(), 2);
+    pool.submit(good);
+    pool.submit(bad);
+    good->wait();
+    EXPECT_TRUE(bad->wait_for(10.0));
+  }
+
+  EXPECT_EQ(good->status(), AsyncRunStatus::finished);
+  EXPECT_NO_THROW(good->rethrow_if_failed());
+  EXPECT_EQ(bad->status(), AsyncRunStatus::failed);
+  EXPECT_THROW(bad->rethrow_if_failed(), std::runtime_error);
+  EXPECT_EQ(n_runs.load(), 1);
+  EXPECT_EQ(n_callbacks.load(), 2);
+
+  // callbacks added after a run is done are called immediately
+  good->add_done_callback([&]() { ++n_callbacks; });
+  EXPECT_EQ(n_callbacks.load(), 3);
+
+  EXPECT_THROW(AsyncRunPool(0), std::runtime_error);
+  EXPECT_EQ(async_run_status_name(AsyncRunStatus::cancelled), "cancelled");
+}
+
+/// \brief Test cancelling pending and running runs
+TEST(run_AsyncRunPool_Test, Test2) {
+  using namespace clexmonte;
+
+  auto run_control = std::make_shared<RunControl>(
+      [](results_type const &results) { return RunControlAction::proceed; });
+  std::atomic<bool> started(false);
+  auto running = std::make_shared<AsyncRun>(
+      [&]() {
+        started = true;
+        while (!run_control->stop_requested()) {
+          std::this_thread::yield();
+        }
+      },
+      run_control);
+
+  bool pending_was_run = false;
+  auto pending =
+      std::make_shared<AsyncRun>([&]() { pending_was_run = true; });
+
+  AsyncRunPool pool(1);
+  pool.submit(running);
+  pool.submit(pending);
+  while (!started) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(running->status(), AsyncRunStatus::running);
+  EXPECT_EQ(pool.n_pending(), 1);
+  EXPECT_FALSE(running->wait_for(0.01));
+
+  pending->cancel();
+  running->cancel();
+  running->wait();
+  pending->wait();
+
+  EXPECT_EQ(running->status(), AsyncRunStatus::cancelled);
+  EXPECT_EQ(pending->status(), AsyncRunStatus::cancelled);
+  EXPECT_FALSE(pending_was_run);
+  EXPECT_TRUE(run_control->stopped());
+}
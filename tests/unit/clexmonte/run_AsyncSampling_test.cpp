@@ -0,0 +1,84 @@
+#include "casm/clexmonte/run/AsyncSampling.hh"
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that values evaluated on worker threads are in sampling
+///     order and match the occupation when each sample was recorded
+TEST(run_AsyncSampling_Test, Test1) {
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(4);
+  clexmonte::AsyncSampling async_sampling(
+      [&]() -> Eigen::VectorXi const & { return occupation; }, 3, 4);
+  EXPECT_EQ(async_sampling.n_threads(), 3);
+
+  std::atomic<Index> n_made(0);
+  Index n_index = async_sampling.add_function(
+      "n_occupied", {"n", "n_squared"}, [&]() {
+        ++n_made;
+        return [](Eigen::VectorXi const &occ) -> Eigen::VectorXd {
+          double n = occ.sum();
+          Eigen::VectorXd value(2);
+          value << n, n * n;
+          return value;
+        };
+      });
+  Index first_index = async_sampling.add_function(
+      "first", {"occ0"}, []() {
+        return [](Eigen::VectorXi const &occ) -> Eigen::VectorXd {
+          return Eigen::VectorXd::Constant(1, occ(0));
+        };
+      });
+  EXPECT_EQ(async_sampling.function_index("first"), first_index);
+  EXPECT_THROW(async_sampling.add_function(
+                   "first", {"x"},
+                   []() -> clexmonte::AsyncSampling::evaluate_function_type {
+                     return nullptr;
+                   }),
+               std::runtime_error);
+
+  Index n_steps = 100;
+  std::vector<double> expected_n;
+  std::vector<double> expected_first;
+  for (Index i = 0; i < n_steps; ++i) {
+    occupation(i % 4) = 1 - occupation(i % 4);
+    // both functions share one snapshot per step
+    EXPECT_EQ(async_sampling.record(n_index), i);
+    EXPECT_EQ(async_sampling.record(first_index), i);
+    expected_n.push_back(occupation.sum());
+    expected_first.push_back(occupation(0));
+  }
+  EXPECT_EQ(async_sampling.n_snapshots(), n_steps);
+
+  Eigen::MatrixXd n_values = async_sampling.values("n_occupied");
+  Eigen::MatrixXd first_values = async_sampling.values("first");
+  ASSERT_EQ(n_values.rows(), n_steps);
+  ASSERT_EQ(n_values.cols(), 2);
+  ASSERT_EQ(first_values.rows(), n_steps);
+  for (Index i = 0; i < n_steps; ++i) {
+    EXPECT_EQ(n_values(i, 0), expected_n[i]);
+    EXPECT_EQ(n_values(i, 1), expected_n[i] * expected_n[i]);
+    EXPECT_EQ(first_values(i, 0), expected_first[i]);
+  }
+  EXPECT_LE(n_made, 3);
+
+  async_sampling.reset();
+  EXPECT_EQ(async_sampling.n_samples("n_occupied"), 0);
+  EXPECT_EQ(async_sampling.values("n_occupied").rows(), 0);
+}
+
+/// \brief Test that an evaluation which throws is rethrown
+TEST(run_AsyncSampling_Test, Test2) {
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(4);
+  clexmonte::AsyncSampling async_sampling(
+      [&]() -> Eigen::VectorXi const & { return occupation; });
+  Index index = async_sampling.add_function("bad", {"x", "y"}, []() {
+    return [](Eigen::VectorXi const &occ) -> Eigen::VectorXd {
+      return Eigen::VectorXd::Zero(1);
+    };
+  });
+  async_sampling.record(index);
+  EXPECT_THROW(async_sampling.wait(), std::runtime_error);
+}
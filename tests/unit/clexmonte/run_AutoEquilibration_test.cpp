@@ -0,0 +1,65 @@
+#include "casm/clexmonte/run/AutoEquilibration.hh"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test the drift test, on samples that decay to a constant value
+TEST(run_AutoEquilibration_Test, DriftEquilibrationCheck) {
+  std::mt19937_64 engine(1234);
+  std::normal_distribution<double> dist(0.0, 0.1);
+  Index n = 4000;
+  Eigen::VectorXd observations(n);
+  for (Index i = 0; i < n; ++i) {
+    observations(i) = 10.0 * std::exp(-i / 100.0) + dist(engine);
+  }
+
+  clexmonte::DriftEquilibrationCheck check;
+  monte::RequestedPrecision requested_precision;
+
+  // too few samples
+  auto result =
+      check(observations.head(10), Eigen::VectorXd(), requested_precision);
+  EXPECT_FALSE(result.is_equilibrated);
+
+  // still drifting
+  result = check(observations.head(200), Eigen::VectorXd(),
+                 requested_precision);
+  EXPECT_FALSE(result.is_equilibrated);
+
+  // equilibrated from the start of the trailing half
+  result = check(observations, Eigen::VectorXd(), requested_precision);
+  EXPECT_TRUE(result.is_equilibrated);
+  EXPECT_EQ(result.N_samples_for_equilibration, n / 2);
+
+  // constant observations, such as a fixed composition
+  result = check(Eigen::VectorXd::Ones(100), Eigen::VectorXd(),
+                 requested_precision);
+  EXPECT_TRUE(result.is_equilibrated);
+}
+
+/// \brief Test learning the equilibration length
+TEST(run_AutoEquilibration_Test, LearnLength) {
+  clexmonte::AutoEquilibrationParams params;
+  clexmonte::AutoEquilibration not_learning(params);
+  not_learning.record(100);
+  EXPECT_FALSE(not_learning.initial_guess().has_value());
+  EXPECT_EQ(not_learning.history().size(), 1);
+
+  params.learn_length = true;
+  params.learned_length_fraction = 0.5;
+  clexmonte::AutoEquilibration learning(params);
+  EXPECT_FALSE(learning.initial_guess().has_value());
+  learning.record(100);
+  learning.record(300);
+  learning.record(200);
+  ASSERT_TRUE(learning.initial_guess().has_value());
+  EXPECT_EQ(*learning.initial_guess(), 100);
+
+  params.max_n_samples = 0;
+  EXPECT_THROW(clexmonte::AutoEquilibration invalid(params),
+               std::runtime_error);
+}
@@ -0,0 +1,64 @@
+#include "casm/clexmonte/run/BatchedSamplingFunction.hh"
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that batched values match values calculated per sample
+TEST(run_BatchedSamplingFunction_Test, Test1) {
+  typedef clexmonte::BatchedSamplingFunction::occupation_batch_type
+      occupation_batch_type;
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(4);
+  std::vector<Index> batch_sizes;
+  clexmonte::BatchedSamplingFunction f(
+      "n_occupied", "Number of occupied sites", {"n", "n_squared"}, 3,
+      [&](Eigen::Ref<occupation_batch_type const> const &batch) {
+        batch_sizes.push_back(batch.rows());
+        Eigen::MatrixXd values(batch.rows(), 2);
+        for (Index i = 0; i < batch.rows(); ++i) {
+          double n = batch.row(i).sum();
+          values(i, 0) = n;
+          values(i, 1) = n * n;
+        }
+        return values;
+      },
+      [&]() -> Eigen::VectorXi const & { return occupation; });
+
+  for (Index i = 0; i < 7; ++i) {
+    occupation(i % 4) = 1 - occupation(i % 4);
+    EXPECT_EQ(f.record(), i);
+  }
+  EXPECT_EQ(f.n_samples(), 7);
+  EXPECT_EQ(f.n_batches(), 2);
+
+  // expected number of occupied sites after each flip
+  std::vector<double> expected = {1, 2, 3, 4, 3, 2, 1};
+  Eigen::MatrixXd values = f.values();
+  EXPECT_EQ(f.n_batches(), 3);
+  EXPECT_EQ(batch_sizes, std::vector<Index>({3, 3, 1}));
+  ASSERT_EQ(values.rows(), 7);
+  ASSERT_EQ(values.cols(), 2);
+  for (Index i = 0; i < 7; ++i) {
+    EXPECT_EQ(values(i, 0), expected[i]);
+    EXPECT_EQ(values(i, 1), expected[i] * expected[i]);
+  }
+
+  f.reset();
+  EXPECT_EQ(f.n_samples(), 0);
+  EXPECT_EQ(f.values().rows(), 0);
+}
+
+/// \brief Test that a batch function returning the wrong shape throws
+TEST(run_BatchedSamplingFunction_Test, Test2) {
+  typedef clexmonte::BatchedSamplingFunction::occupation_batch_type
+      occupation_batch_type;
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(4);
+  clexmonte::BatchedSamplingFunction f(
+      "bad", "Returns one row too few", {"x"}, 2,
+      [&](Eigen::Ref<occupation_batch_type const> const &batch) {
+        return Eigen::MatrixXd(Eigen::MatrixXd::Zero(batch.rows() - 1, 1));
+      },
+      [&]() -> Eigen::VectorXi const & { return occupation; });
+  f.record();
+  EXPECT_THROW(f.record(), std::runtime_error);
+}
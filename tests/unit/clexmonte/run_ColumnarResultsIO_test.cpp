@@ -0,0 +1,176 @@
+#include <cmath>
+#include <fstream>
+
+#include "casm/clexmonte/run/ColumnarResultsIO.hh"
+#include "casm/clexmonte/run/ObservationStream.hh"
+#include "casm/monte/run_management/Results.hh"
+#include "casm/monte/sampling/Sampler.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Conditions of run `i`; the matrix condition is only set for
+///     runs after the first
+monte::ValueMap make_conditions(Index i) {
+  monte::ValueMap conditions;
+  conditions.scalar_values["temperature"] = 300.0 + 100.0 * i;
+  conditions.boolean_values["fixed"] = (i % 2 == 0);
+  Eigen::VectorXd mol_composition(3);
+  mol_composition << 2.0, 0.1 * i, 2.0 - 0.1 * i;
+  conditions.vector_values["mol_composition"] = mol_composition;
+  if (i > 0) {
+    Eigen::MatrixXd M(2, 3);
+    M << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 * i;
+    conditions.matrix_values["strain"] = M;
+  }
+  return conditions;
+}
+
+/// \brief Results of run `i`, with `i + 2` samples; the analysis result is
+///     only set for runs after the first
+clexmonte::results_type make_results(Index i) {
+  clexmonte::results_type results({}, {}, {}, {}, {});
+  auto energy = std::make_shared<monte::Sampler>(std::vector<Index>({1}));
+  auto corr = std::make_shared<monte::Sampler>(std::vector<Index>({2}));
+  for (Index j = 0; j < i + 2; ++j) {
+    energy->append(Eigen::VectorXd::Constant(1, -1.0 / (j + 1) - i));
+    Eigen::VectorXd value(2);
+    value << 0.1 * j, 1.0 / 3.0 + i;
+    corr->append(value);
+    results.sample_count.push_back(10 * (j + 1));
+  }
+  results.samplers.emplace("energy", energy);
+  results.samplers.emplace("corr", corr);
+  results.n_accept = 100 + i;
+  results.n_reject = 200 + i;
+  results.elapsed_clocktime = 1.5 * i;
+  results.completion_check_results.is_complete = true;
+  if (i > 0) {
+    Eigen::VectorXd heat_capacity(1);
+    heat_capacity << 0.25 * i;
+    results.analysis["heat_capacity"] = heat_capacity;
+  }
+  return results;
+}
+
+void expect_conditions_eq(monte::ValueMap const &a, monte::ValueMap const &b) {
+  EXPECT_EQ(a.scalar_values, b.scalar_values);
+  EXPECT_EQ(a.boolean_values, b.boolean_values);
+  ASSERT_EQ(a.vector_values.size(), b.vector_values.size());
+  for (auto const &pair : a.vector_values) {
+    EXPECT_EQ(pair.second, b.vector_values.at(pair.first));
+  }
+  ASSERT_EQ(a.matrix_values.size(), b.matrix_values.size());
+  for (auto const &pair : a.matrix_values) {
+    EXPECT_EQ(pair.second, b.matrix_values.at(pair.first));
+  }
+}
+
+}  // namespace
+
+/// \brief Test that written runs read back the same, including columns
+///     first written after the first run, and per-sample columns
+TEST(run_ColumnarResultsIO_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path output_dir = tmp_dir.path() / "columns";
+  Index n_runs = 3;
+
+  {
+    ColumnarResultsIO results_io(output_dir, true, {"corr"});
+    EXPECT_EQ(results_io.read_conditions().size(), 0);
+    for (Index i = 0; i < n_runs; ++i) {
+      results_io.write(make_results(i), make_conditions(i), i + 1);
+    }
+  }
+
+  // conditions, read by a new instance
+  ColumnarResultsIO results_io(output_dir, true, {"corr"});
+  std::vector<monte::ValueMap> conditions = results_io.read_conditions();
+  ASSERT_EQ(conditions.size(), n_runs);
+  for (Index i = 0; i < n_runs; ++i) {
+    expect_conditions_eq(conditions[i], make_conditions(i));
+  }
+
+  // per-run columns
+  Eigen::MatrixXd run_index = read_results_column(output_dir, "run_index");
+  Eigen::MatrixXd n_samples = read_results_column(output_dir, "n_samples");
+  Eigen::MatrixXd n_accept = read_results_column(output_dir, "n_accept");
+  Eigen::MatrixXd is_complete =
+      read_results_column(output_dir, "is_complete");
+  Eigen::MatrixXd heat_capacity =
+      read_results_column(output_dir, "analysis.heat_capacity");
+  ASSERT_EQ(run_index.rows(), n_runs);
+  ASSERT_EQ(heat_capacity.rows(), n_runs);
+  EXPECT_TRUE(std::isnan(heat_capacity(0, 0)));
+  for (Index i = 0; i < n_runs; ++i) {
+    EXPECT_EQ(run_index(i, 0), i + 1);
+    EXPECT_EQ(n_samples(i, 0), i + 2);
+    EXPECT_EQ(n_accept(i, 0), 100 + i);
+    EXPECT_EQ(is_complete(i, 0), 1.0);
+    if (i > 0) {
+      EXPECT_EQ(heat_capacity(i, 0), 0.25 * i);
+    }
+  }
+  EXPECT_THROW(read_results_column(output_dir, "analysis.missing"),
+               std::runtime_error);
+
+  // per-sample columns, as float64 and float32
+  for (Index i = 0; i < n_runs; ++i) {
+    clexmonte::results_type results = make_results(i);
+    Eigen::MatrixXd energy =
+        read_streamed_observations(output_dir, i + 1, "energy");
+    Eigen::MatrixXd corr =
+        read_streamed_observations(output_dir, i + 1, "corr");
+    Eigen::MatrixXd sample_count =
+        read_streamed_observations(output_dir, i + 1, "sample_count");
+    EXPECT_EQ(energy, results.samplers.at("energy")->values());
+    Eigen::MatrixXf corr_float32 =
+        results.samplers.at("corr")->values().cast<float>();
+    EXPECT_EQ(corr, corr_float32.cast<double>());
+    ASSERT_EQ(sample_count.rows(), i + 2);
+    for (Index j = 0; j < i + 2; ++j) {
+      EXPECT_EQ(sample_count(j, 0), 10 * (j + 1));
+    }
+  }
+}
+
+/// \brief Test that rows of a partially written run are discarded when the
+///     next run is written
+TEST(run_ColumnarResultsIO_Test, Test2) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path output_dir = tmp_dir.path() / "columns";
+
+  {
+    ColumnarResultsIO results_io(output_dir, false);
+    results_io.write(make_results(0), make_conditions(0), 1);
+    results_io.write(make_results(1), make_conditions(1), 2);
+  }
+
+  // an interrupted write of a third run, before "columns.json" was updated
+  {
+    std::ofstream file(output_dir / "n_accept.bin",
+                       std::ios::binary | std::ios::app);
+    double value = -1.0;
+    file.write(reinterpret_cast<char const *>(&value), sizeof(double));
+  }
+  EXPECT_EQ(read_results_column(output_dir, "n_accept").rows(), 2);
+
+  ColumnarResultsIO results_io(output_dir, false);
+  results_io.write(make_results(2), make_conditions(2), 3);
+  Eigen::MatrixXd n_accept = read_results_column(output_dir, "n_accept");
+  ASSERT_EQ(n_accept.rows(), 3);
+  EXPECT_EQ(n_accept(0, 0), 100);
+  EXPECT_EQ(n_accept(1, 0), 101);
+  EXPECT_EQ(n_accept(2, 0), 102);
+  EXPECT_EQ(fs::file_size(output_dir / "n_accept.bin"), 3 * sizeof(double));
+  EXPECT_FALSE(fs::exists(output_dir / "run.1"));
+
+  std::vector<monte::ValueMap> conditions = results_io.read_conditions();
+  ASSERT_EQ(conditions.size(), 3);
+  expect_conditions_eq(conditions[2], make_conditions(2));
+}
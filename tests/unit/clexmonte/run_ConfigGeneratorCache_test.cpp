@@ -0,0 +1,129 @@
+#include <thread>
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/run/ConfigGeneratorCache.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+
+namespace {
+
+using namespace CASM;
+using namespace CASM::clexmonte;
+
+/// \brief Counts how many times it generates a configuration
+class CountingConfigGenerator : public ConfigGenerator {
+ public:
+  CountingConfigGenerator(config_type const &configuration, Index &_count)
+      : m_configuration(configuration), m_count(_count) {}
+
+  config_type operator()(monte::ValueMap const &conditions,
+                         std::vector<RunData> const &completed_runs) override {
+    ++m_count;
+    return m_configuration;
+  }
+
+ private:
+  config_type m_configuration;
+  Index &m_count;
+};
+
+}  // namespace
+
+class run_ConfigGeneratorCacheTest : public test::ZrOTestSystem {};
+
+TEST_F(run_ConfigGeneratorCacheTest, KeyTest1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Configuration motif = make_default_configuration(*system, T);
+  Configuration other_motif = motif;
+  other_motif.dof_values.occupation(0) = 1;
+  Eigen::Matrix3l T_other = Eigen::Matrix3l::Identity() * 4;
+
+  monte::ValueMap conditions_a =
+      canonical::make_conditions(300.0, system->composition_converter,
+                                 {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}});
+  monte::ValueMap conditions_b =
+      canonical::make_conditions(600.0, system->composition_converter,
+                                 {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}});
+
+  std::string key = make_config_cache_key("fixed", &T, &motif);
+  EXPECT_EQ(key, make_config_cache_key("fixed", &T, &motif));
+  EXPECT_NE(key, make_config_cache_key("other", &T, &motif));
+  EXPECT_NE(key, make_config_cache_key("fixed", &T_other, &motif));
+  EXPECT_NE(key, make_config_cache_key("fixed", &T, &other_motif));
+
+  // only the named conditions are part of the key
+  EXPECT_EQ(make_config_cache_key("c", nullptr, nullptr, &conditions_a,
+                                  {"mol_composition"}),
+            make_config_cache_key("c", nullptr, nullptr, &conditions_b,
+                                  {"mol_composition"}));
+  EXPECT_NE(make_config_cache_key("c", nullptr, nullptr, &conditions_a,
+                                  {"temperature"}),
+            make_config_cache_key("c", nullptr, nullptr, &conditions_b,
+                                  {"temperature"}));
+}
+
+TEST_F(run_ConfigGeneratorCacheTest, CachedConfigGeneratorTest1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Configuration init_config = make_default_configuration(*system, T);
+  std::vector<RunData> completed_runs;
+
+  Index count = 0;
+  CachedConfigGenerator config_generator(
+      std::make_unique<CountingConfigGenerator>(init_config, count),
+      {"mol_composition"});
+
+  // varying temperature reuses the stored configuration
+  for (Index j = 0; j < 10; ++j) {
+    monte::ValueMap conditions = canonical::make_conditions(
+        300.0 + 10.0 * j, system->composition_converter,
+        {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}});
+    Configuration config = config_generator(conditions, completed_runs);
+    EXPECT_EQ(config.dof_values.occupation, init_config.dof_values.occupation);
+  }
+  EXPECT_EQ(count, 1);
+
+  // a different composition generates a new configuration
+  monte::ValueMap conditions =
+      canonical::make_conditions(300.0, system->composition_converter,
+                                 {{"Zr", 2.0}, {"O", 2.0}, {"Va", 0.0}});
+  config_generator(conditions, completed_runs);
+  EXPECT_EQ(count, 2);
+  EXPECT_EQ(config_generator.cache()->size(), 2);
+  EXPECT_EQ(config_generator.cache()->n_hits(), 9);
+  EXPECT_EQ(config_generator.cache()->n_misses(), 2);
+}
+
+TEST_F(run_ConfigGeneratorCacheTest, SharedCacheTest1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Configuration init_config = make_default_configuration(*system, T);
+  std::string key = make_config_cache_key("fixed", &T, &init_config);
+
+  // all threads get the same stored configuration
+  auto cache = std::make_shared<ConfigGeneratorCache>();
+  Index n_threads = 4;
+  std::vector<std::shared_ptr<config_type const>> results(n_threads);
+  std::vector<std::thread> threads;
+  for (Index t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      results[t] = cache->get_or_make(key, [&]() { return init_config; });
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cache->size(), 1);
+  for (Index t = 0; t < n_threads; ++t) {
+    EXPECT_EQ(results[t], results[0]);
+  }
+  EXPECT_EQ(cache->n_hits() + cache->n_misses(), n_threads);
+
+  cache->clear();
+  EXPECT_EQ(cache->size(), 0);
+}
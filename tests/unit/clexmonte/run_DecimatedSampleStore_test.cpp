@@ -0,0 +1,64 @@
+#include <cmath>
+
+#include "casm/clexmonte/run/DecimatedSampleStore.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that memory is bounded, entries are ordered, and statistics
+///     are exact
+TEST(run_DecimatedSampleStore_Test, Test1) {
+  Index level_size = 8;
+  clexmonte::DecimatedSampleStore store({"x", "x2"}, level_size);
+
+  Index n = 100000;
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  for (Index i = 0; i < n; ++i) {
+    double x = std::sin(0.001 * i) + 0.01 * i;
+    Eigen::VectorXd value(2);
+    value << x, x * x;
+    store.push(value, double(i));
+    sum += x;
+    sum_sq += x * x;
+  }
+  EXPECT_EQ(store.n_samples(), n);
+
+  // logarithmic number of levels, bounded entries per level
+  EXPECT_LE(store.n_levels(), 15);
+  EXPECT_LE(store.n_entries(), level_size * store.n_levels());
+
+  // entries cover all samples, in order, and the most recent are at full
+  // resolution
+  auto entries = store.entries();
+  Index n_covered = 0;
+  double previous_time_end = -1.0;
+  for (auto const &entry : entries) {
+    EXPECT_EQ(entry.time_begin, previous_time_end + 1.0);
+    EXPECT_EQ(entry.time_end - entry.time_begin + 1.0, entry.n_samples);
+    previous_time_end = entry.time_end;
+    n_covered += entry.n_samples;
+  }
+  EXPECT_EQ(n_covered, n);
+  for (Index i = entries.size() - level_size; i < entries.size(); ++i) {
+    EXPECT_EQ(entries[i].n_samples, 1);
+  }
+
+  // the weighted mean of the entries equals the exact mean
+  Eigen::VectorXd weighted_mean = Eigen::VectorXd::Zero(2);
+  for (auto const &entry : entries) {
+    weighted_mean += entry.value * entry.n_samples;
+  }
+  weighted_mean /= double(n);
+
+  double mean = sum / n;
+  double variance = (sum_sq - n * mean * mean) / (n - 1);
+  EXPECT_NEAR(store.mean()(0), mean, 1e-10 * std::abs(mean));
+  EXPECT_NEAR(weighted_mean(0), mean, 1e-10 * std::abs(mean));
+  EXPECT_NEAR(store.variance()(0), variance, 1e-8 * variance);
+  EXPECT_EQ(store.values().rows(), store.n_entries());
+
+  store.reset();
+  EXPECT_EQ(store.n_samples(), 0);
+  EXPECT_EQ(store.n_entries(), 0);
+}
@@ -0,0 +1,135 @@
+#include "ZrOTestSystem.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/run/FiniteSizeScalingStateGenerator.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/misc/CASM_math.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+
+class run_FiniteSizeScalingStateGeneratorTest : public test::ZrOTestSystem {
+ protected:
+  std::unique_ptr<CASM::clexmonte::FiniteSizeScalingStateGenerator>
+  make_state_generator(bool dependent_runs) {
+    using namespace CASM;
+    using namespace CASM::monte;
+    using namespace CASM::clexmonte;
+
+    ValueMap init_conditions =
+        canonical::make_conditions(300.0, get_composition_converter(*system),
+                                   {{"Zr", 2.0}, {"O", 0.2}, {"Va", 1.8}});
+    ValueMap conditions_increment = canonical::make_conditions_increment(
+        100.0, get_composition_converter(*system),
+        {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}});
+    Index n_states = 2;
+
+    // given out of volume order
+    std::vector<Eigen::Matrix3l> transformation_matrices = {
+        Eigen::Matrix3l::Identity() * 3, Eigen::Matrix3l::Identity(),
+        Eigen::Matrix3l::Identity() * 2};
+
+    std::unique_ptr<config_generator_type> config_generator =
+        std::make_unique<FixedConfigGenerator>(
+            make_default_configuration(*system, Eigen::Matrix3l::Identity()));
+
+    RunDataOutputParams output_params;
+    return std::make_unique<FiniteSizeScalingStateGenerator>(
+        system, output_params, std::move(config_generator), init_conditions,
+        conditions_increment, n_states, transformation_matrices,
+        dependent_runs);
+  }
+
+  void complete(
+      CASM::clexmonte::FiniteSizeScalingStateGenerator &state_generator,
+      CASM::clexmonte::state_type const &state) {
+    CASM::clexmonte::RunData run_data;
+    run_data.initial_state = state;
+    run_data.final_state = state;
+    run_data.conditions = state.conditions;
+    run_data.transformation_matrix_to_super =
+        CASM::clexmonte::get_transformation_matrix_to_super(state);
+    run_data.n_unitcells =
+        run_data.transformation_matrix_to_super.determinant();
+    state_generator.push_back(run_data);
+  }
+};
+
+/// \brief Test that supercells are sorted by volume, states are generated in
+///     each supercell, and runs are grouped by supercell
+TEST_F(run_FiniteSizeScalingStateGeneratorTest, Test1) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  auto state_generator = make_state_generator(true);
+  ASSERT_EQ(state_generator->n_supercells(), 3);
+  for (Index s = 0; s < 3; ++s) {
+    EXPECT_EQ(state_generator->transformation_matrices()[s],
+              Eigen::Matrix3l(Eigen::Matrix3l::Identity() * (s + 1)));
+  }
+  EXPECT_TRUE(state_generator->has_independent_lines());
+
+  Index n_prim_sites =
+      make_default_configuration(*system, Eigen::Matrix3l::Identity())
+          .dof_values.occupation.size();
+  std::vector<Index> points;
+  while (!state_generator->is_complete()) {
+    state_type state = state_generator->next_state();
+    Index s = points.size() / 2;
+    EXPECT_EQ(get_transformation_matrix_to_super(state),
+              state_generator->transformation_matrices()[s]);
+    EXPECT_EQ(get_occupation(state).size(),
+              n_prim_sites * (s + 1) * (s + 1) * (s + 1));
+    EXPECT_TRUE(
+        CASM::almost_equal(state.conditions.scalar_values.at("temperature"),
+                           300.0 + 100.0 * (points.size() % 2)));
+    complete(*state_generator, state);
+    points.push_back(state_generator->point_index(
+        state_generator->completed_runs().back()));
+    ASSERT_LE(points.size(), 6);
+  }
+  EXPECT_EQ(points, std::vector<Index>({0, 1, 2, 3, 4, 5}));
+
+  auto by_supercell = state_generator->completed_runs_by_supercell();
+  ASSERT_EQ(by_supercell.size(), 3);
+  for (Index s = 0; s < 3; ++s) {
+    ASSERT_EQ(by_supercell[s].size(), 2);
+    EXPECT_EQ(by_supercell[s][0]->n_unitcells, (s + 1) * (s + 1) * (s + 1));
+  }
+}
+
+/// \brief Test remaining lines are largest supercell first, and completed
+///     points are recovered from the supercell and conditions
+TEST_F(run_FiniteSizeScalingStateGeneratorTest, Test2) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  auto state_generator = make_state_generator(false);
+  std::vector<std::vector<Index>> lines = state_generator->remaining_lines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], std::vector<Index>({4, 5}));
+  EXPECT_EQ(lines[1], std::vector<Index>({2, 3}));
+  EXPECT_EQ(lines[2], std::vector<Index>({0, 1}));
+
+  // complete the second point of the middle supercell
+  state_type state = state_generator->line_state(3, nullptr);
+  complete(*state_generator, state);
+  EXPECT_TRUE(state_generator->is_completed(3));
+  EXPECT_FALSE(state_generator->is_complete());
+
+  lines = state_generator->remaining_lines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[1], std::vector<Index>({2}));
+
+  std::vector<state_type> states = state_generator->remaining_states();
+  EXPECT_EQ(states.size(), 5);
+
+  // a supercell not in the family is rejected
+  RunData run_data = state_generator->completed_runs().back();
+  run_data.transformation_matrix_to_super = Eigen::Matrix3l::Identity() * 4;
+  EXPECT_THROW(state_generator->point_index(run_data), std::runtime_error);
+}
@@ -1,8 +1,11 @@
 #include "ZrOTestSystem.hh"
 #include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/canonical/canonical.hh"
 #include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/io/json/ConfigGenerator_json_io.hh"
 #include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/monte/run_management/State.hh"
@@ -38,3 +41,58 @@ TEST_F(run_FixedConfigGeneratorTest, Test1) {
     EXPECT_EQ(config.dof_values.occupation, init_config.dof_values.occupation);
   }
 }
+
+TEST_F(run_FixedConfigGeneratorTest, ParseOccupationFile) {
+  using namespace CASM;
+  using namespace CASM::monte;
+  using namespace CASM::clexmonte;
+
+  monte::ValueMap conditions =
+      canonical::make_conditions(300.0, system->composition_converter,
+                                 {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}});
+  std::vector<RunData> completed_runs;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  Index volume = T.determinant();
+  Configuration init_config = make_default_configuration(*system, T);
+  for (Index i = 0; i < volume; i += 3) {
+    init_config.dof_values.occupation(2 * volume + i) = 1;
+  }
+
+  test::TmpDir tmp_dir;
+  fs::path path = tmp_dir.path() / "occupation.bin";
+  write_occupation_file(path.string(), init_config.dof_values.occupation);
+  EXPECT_EQ(read_occupation_file(path.string()),
+            init_config.dof_values.occupation);
+
+  jsonParser json;
+  json["transformation_matrix_to_supercell"] = T;
+
+  // binary occupation file
+  json["occupation"] = path.string();
+  InputParser<FixedConfigGenerator> parser(json, system);
+  EXPECT_TRUE(parser.valid());
+  Configuration config = (*parser.value)(conditions, completed_runs);
+  EXPECT_EQ(config.dof_values.occupation, init_config.dof_values.occupation);
+
+  // packed occupation
+  int bits_per_value;
+  json["occupation"] = jsonParser::object();
+  json["occupation"]["encoding"] = "bitpacked_zlib_base64";
+  json["occupation"]["size"] = init_config.dof_values.occupation.size();
+  json["occupation"]["data"] =
+      pack_occupation(init_config.dof_values.occupation, bits_per_value);
+  json["occupation"]["bits_per_value"] = bits_per_value;
+  InputParser<FixedConfigGenerator> packed_parser(json, system);
+  EXPECT_TRUE(packed_parser.valid());
+  config = (*packed_parser.value)(conditions, completed_runs);
+  EXPECT_EQ(config.dof_values.occupation, init_config.dof_values.occupation);
+
+  // size mismatch
+  json["occupation"]["size"] = 8;
+  json["occupation"]["data"] =
+      pack_occupation(Eigen::VectorXi::Zero(8), bits_per_value);
+  json["occupation"]["bits_per_value"] = bits_per_value;
+  InputParser<FixedConfigGenerator> invalid_parser(json, system);
+  EXPECT_FALSE(invalid_parser.valid());
+}
@@ -0,0 +1,137 @@
+#include "ZrOTestSystem.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/GridConditionsStateGenerator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/misc/CASM_math.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+
+class run_GridConditionsStateGeneratorTest : public test::ZrOTestSystem {
+ protected:
+  std::unique_ptr<CASM::clexmonte::GridConditionsStateGenerator>
+  make_state_generator(bool dependent_runs, bool independent_lines) {
+    using namespace CASM;
+    using namespace CASM::monte;
+    using namespace CASM::clexmonte;
+
+    ValueMap init_conditions =
+        canonical::make_conditions(300.0, get_composition_converter(*system),
+                                   {{"Zr", 2.0}, {"O", 0.2}, {"Va", 1.8}});
+    std::vector<ValueMap> conditions_increments;
+    conditions_increments.push_back(canonical::make_conditions_increment(
+        100.0, get_composition_converter(*system),
+        {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}}));
+    conditions_increments.push_back(canonical::make_conditions_increment(
+        0.0, get_composition_converter(*system),
+        {{"Zr", 0.0}, {"O", 0.2}, {"Va", -0.2}}));
+    std::vector<Index> n_points = {3, 2};
+
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+    std::unique_ptr<config_generator_type> config_generator =
+        std::make_unique<FixedConfigGenerator>(
+            make_default_configuration(*system, T));
+
+    RunDataOutputParams output_params;
+    return std::make_unique<GridConditionsStateGenerator>(
+        system, output_params, std::move(config_generator), init_conditions,
+        conditions_increments, n_points, dependent_runs, independent_lines);
+  }
+
+  void complete(CASM::clexmonte::GridConditionsStateGenerator &state_generator,
+                CASM::clexmonte::state_type const &state) {
+    CASM::clexmonte::RunData run_data;
+    run_data.initial_state = state;
+    run_data.final_state = state;
+    run_data.conditions = state.conditions;
+    run_data.transformation_matrix_to_super =
+        Eigen::Matrix3l::Identity() * 2;
+    run_data.n_unitcells = 8;
+    state_generator.push_back(run_data);
+  }
+};
+
+/// \brief Test that lines are walked in snake order
+TEST_F(run_GridConditionsStateGeneratorTest, Test1) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  auto state_generator = make_state_generator(true, false);
+  EXPECT_EQ(state_generator->line_size(), 3);
+  EXPECT_EQ(state_generator->n_lines(), 2);
+  EXPECT_FALSE(state_generator->has_independent_lines());
+
+  std::vector<Index> points;
+  while (!state_generator->is_complete()) {
+    state_type state = state_generator->next_state();
+    points.push_back(state_generator->grid_point(state.conditions));
+    complete(*state_generator, state);
+    ASSERT_LE(points.size(), 6);
+  }
+  std::vector<Index> expected = {0, 1, 2, 5, 4, 3};
+  EXPECT_EQ(points, expected);
+  EXPECT_EQ(state_generator->n_completed_runs(), 6);
+}
+
+/// \brief Test grid conditions and grid point round trip
+TEST_F(run_GridConditionsStateGeneratorTest, Test2) {
+  using namespace CASM;
+  using namespace CASM::monte;
+  using namespace CASM::clexmonte;
+
+  auto state_generator = make_state_generator(false, true);
+  for (Index point = 0; point < 6; ++point) {
+    ValueMap conditions = state_generator->grid_conditions(point);
+    EXPECT_EQ(state_generator->grid_point(conditions), point);
+    EXPECT_TRUE(
+        CASM::almost_equal(conditions.scalar_values.at("temperature"),
+                           300.0 + 100.0 * (point % 3)));
+  }
+
+  ValueMap off_grid = state_generator->grid_conditions(1);
+  off_grid.scalar_values.at("temperature") += 50.0;
+  EXPECT_THROW(state_generator->grid_point(off_grid), std::runtime_error);
+}
+
+/// \brief Test remaining lines, with independent lines
+TEST_F(run_GridConditionsStateGeneratorTest, Test3) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  auto state_generator = make_state_generator(true, true);
+  EXPECT_TRUE(state_generator->has_independent_lines());
+
+  std::vector<std::vector<Index>> lines = state_generator->remaining_lines();
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], std::vector<Index>({0, 1, 2}));
+  EXPECT_EQ(lines[1], std::vector<Index>({3, 4, 5}));
+
+  // complete part of the second line, out of walk order
+  state_type state = state_generator->line_state(3, nullptr);
+  complete(*state_generator, state);
+  state = state_generator->line_state(4, &state.configuration);
+  complete(*state_generator, state);
+  EXPECT_TRUE(state_generator->is_completed(3));
+  EXPECT_TRUE(state_generator->is_completed(4));
+  EXPECT_FALSE(state_generator->is_complete());
+
+  lines = state_generator->remaining_lines();
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], std::vector<Index>({0, 1, 2}));
+  EXPECT_EQ(lines[1], std::vector<Index>({5}));
+
+  // with independent lines, walk order is forward along every line
+  std::vector<Index> points;
+  while (!state_generator->is_complete()) {
+    state_type state = state_generator->next_state();
+    points.push_back(state_generator->grid_point(state.conditions));
+    complete(*state_generator, state);
+    ASSERT_LE(points.size(), 4);
+  }
+  EXPECT_EQ(points, std::vector<Index>({0, 1, 2, 5}));
+}
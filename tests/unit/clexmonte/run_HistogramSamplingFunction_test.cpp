@@ -0,0 +1,41 @@
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/run/HistogramSamplingFunction.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that each component of the source value is binned, and the
+///     sampled value is empty
+TEST(run_HistogramSamplingFunction_Test, Test1) {
+  using namespace clexmonte;
+
+  Eigen::VectorXd value(2);
+  state_sampling_function_type source(
+      "order_parameter", "Order parameter", {2},
+      [&]() -> Eigen::VectorXd { return value; });
+  auto histogram_function = std::make_shared<HistogramSamplingFunction>(
+      "order_parameter.histogram", "Histogram of order_parameter", source,
+      HistogramAccumulator(0.0, 1.0, 2));
+  monte::StateSamplingFunction f =
+      make_histogram_state_sampling_function(histogram_function);
+  EXPECT_EQ(f.name, "order_parameter.histogram");
+
+  for (Index k = 0; k < 5; ++k) {
+    value << 0.2 * k, 0.9;
+    EXPECT_EQ(f.function().size(), 0);
+  }
+  EXPECT_EQ(histogram_function->n_samples(), 5);
+  auto const &histograms = histogram_function->histograms();
+  ASSERT_EQ(histograms.size(), 2);
+  EXPECT_EQ(histograms[0].counts(), std::vector<Index>({3, 2}));
+  EXPECT_EQ(histograms[1].counts(), std::vector<Index>({0, 5}));
+
+  jsonParser json;
+  to_json(*histogram_function, json);
+  EXPECT_EQ(json["n_samples"].get<Index>(), 5);
+  EXPECT_EQ(json["histograms"].size(), 2);
+
+  histogram_function->reset();
+  EXPECT_EQ(histogram_function->n_samples(), 0);
+  EXPECT_EQ(histogram_function->histograms()[0].count(), 0);
+}
@@ -3,12 +3,14 @@
 #include "casm/clexmonte/canonical/canonical.hh"
 #include "casm/clexmonte/run/FixedConfigGenerator.hh"
 #include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/OccLocationCache.hh"
 #include "casm/clexmonte/run/StateModifyingFunction.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "casm/misc/CASM_math.hh"
+#include "casm/monte/events/OccLocation.hh"
 #include "casm/monte/run_management/State.hh"
 #include "gtest/gtest.h"
 #include "testdir.hh"
@@ -142,3 +144,50 @@ TEST_F(run_IncrementalConditionsStateGeneratorTest, Test2) {
     state_generator.push_back(run_data);
   }
 }
+
+/// \brief Test that state modifiers may be deferred and given an occupant
+///     location tracker
+TEST_F(run_IncrementalConditionsStateGeneratorTest, Test3) {
+  using namespace CASM;
+  using namespace CASM::monte;
+  using namespace CASM::clexmonte;
+
+  ValueMap init_conditions =
+      canonical::make_conditions(300.0, get_composition_converter(*system),
+                                 {{"Zr", 2.0}, {"O", 0.2}, {"Va", 1.8}});
+  ValueMap conditions_increment = canonical::make_conditions_increment(
+      10.0, get_composition_converter(*system),
+      {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}});
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Configuration init_config = make_default_configuration(*system, T);
+  std::unique_ptr<config_generator_type> config_generator =
+      notstd::make_unique<FixedConfigGenerator>(init_config);
+
+  // records the occupant location tracker each call was given
+  std::vector<OccLocation *> calls;
+  std::vector<StateModifyingFunction> modifiers;
+  modifiers.emplace_back(
+      "record", "Record the occupant location tracker",
+      [&](state_type &state, OccLocation *occ_location) {
+        calls.push_back(occ_location);
+      });
+
+  RunDataOutputParams output_params;
+  IncrementalConditionsStateGenerator state_generator(
+      system, output_params, std::move(config_generator), init_conditions,
+      conditions_increment, 2, false, modifiers);
+
+  state_type state = state_generator.next_state();
+  ASSERT_EQ(calls.size(), 1);
+  EXPECT_EQ(calls[0], nullptr);
+
+  state = state_generator.next_unmodified_state();
+  EXPECT_EQ(calls.size(), 1);
+
+  OccLocationCache occ_location_cache(false);
+  OccLocation &occ_location = occ_location_cache.get(*system, state);
+  state_generator.modify_state(state, &occ_location);
+  ASSERT_EQ(calls.size(), 2);
+  EXPECT_EQ(calls[1], &occ_location);
+}
@@ -0,0 +1,66 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "casm/clexmonte/run/MappedTrajectoryWriter.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::uint64_t read_uint64(std::vector<char> const &data, Index offset) {
+  std::uint64_t value;
+  std::memcpy(&value, data.data() + offset, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+/// \brief Test writing frames, growing the file past its initial capacity
+TEST(run_MappedTrajectoryWriter_Test, Test1) {
+  test::TmpDir tmp_dir;
+  fs::path path = tmp_dir.path() / "trajectory.bin";
+
+  Index n_sites = 5;
+  clexmonte::MappedTrajectoryWriter writer(path.string(), n_sites, 300, 2);
+  EXPECT_TRUE(writer.is_open());
+  for (Index i = 0; i < 3; ++i) {
+    Eigen::VectorXi occupation = Eigen::VectorXi::Constant(n_sites, i);
+    occupation(0) = 300;
+    EXPECT_EQ(writer.write(occupation, i, 0.5 * i), i);
+  }
+  EXPECT_EQ(writer.n_frames(), 3);
+  writer.close();
+  EXPECT_FALSE(writer.is_open());
+
+  std::ifstream file(path, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+  // 2 bytes per value, 10 bytes of values padded to 16
+  Index record_size = 16 + 16;
+  ASSERT_EQ(data.size(), 64 + 3 * record_size);
+  EXPECT_EQ(std::string(data.data(), 8), "CLXTRAJ1");
+  EXPECT_EQ(read_uint64(data, 8), n_sites);
+  EXPECT_EQ(read_uint64(data, 16), 2);
+  EXPECT_EQ(read_uint64(data, 24), record_size);
+  EXPECT_EQ(read_uint64(data, 32), 3);
+
+  char const *record = data.data() + 64 + 2 * record_size;
+  double time;
+  std::memcpy(&time, record + 8, sizeof(time));
+  std::uint16_t values[5];
+  std::memcpy(values, record + 16, sizeof(values));
+  EXPECT_EQ(read_uint64(data, 64 + 2 * record_size), 2);
+  EXPECT_EQ(time, 1.0);
+  EXPECT_EQ(values[0], 300);
+  EXPECT_EQ(values[4], 2);
+
+  EXPECT_THROW(writer.write(Eigen::VectorXi::Zero(n_sites), 0, 0.0),
+               std::runtime_error);
+}
@@ -0,0 +1,53 @@
+#include "ZrOTestSystem.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/run/MemoryReport.hh"
+#include "casm/clexmonte/run/OccLocationCache.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+
+using namespace test;
+
+class run_MemoryReportTest : public test::ZrOTestSystem {};
+
+/// \brief Test MemoryReport totals and JSON output
+TEST_F(run_MemoryReportTest, Test1) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  MemoryReport report;
+  EXPECT_EQ(report.total_bytes(), 0);
+  report.add("a", 100);
+  report.add("b", 250, 1000);
+  EXPECT_EQ(report.entries.size(), 2);
+  EXPECT_EQ(report.total_bytes(), 350);
+
+  jsonParser json;
+  to_json(report, json);
+  EXPECT_EQ(json["total_bytes"].get<Index>(), 350);
+  EXPECT_EQ(json["subsystems"]["a"]["bytes"].get<Index>(), 100);
+  EXPECT_FALSE(json["subsystems"]["a"].contains("max_bytes"));
+  EXPECT_EQ(json["subsystems"]["b"]["bytes"].get<Index>(), 250);
+  EXPECT_EQ(json["subsystems"]["b"]["max_bytes"].get<Index>(), 1000);
+}
+
+/// \brief Test that the occupant location tracker estimate scales with the
+///     supercell volume
+TEST_F(run_MemoryReportTest, Test2) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  OccLocationCache cache(false);
+  std::vector<std::size_t> bytes;
+  for (Index n : {2, 4}) {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * n;
+    monte::State<Configuration> state(make_default_configuration(*system, T));
+    monte::OccLocation &occ_location = cache.get(*system, state);
+    bytes.push_back(approximate_memory_usage(occ_location,
+                                             get_occupation(state).size()));
+  }
+  EXPECT_GT(bytes[0], 0);
+  EXPECT_GT(bytes[1], 4 * bytes[0]);
+}
@@ -0,0 +1,57 @@
+#include "casm/clexmonte/run/MultiHistogramReweighting.hh"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Excitation probability of a two-level site, with excitation
+///     energy 1.0, at `temperature`
+double excitation_prob(double temperature) {
+  double x = std::exp(-1.0 / (CASM::KB * temperature));
+  return x / (1.0 + x);
+}
+
+}  // namespace
+
+/// \brief Test reweighting of independent two-level sites, for which the
+///     exact averages are known
+TEST(run_MultiHistogramReweighting_Test, Test1) {
+  using namespace clexmonte;
+
+  Index n_unitcells = 50;
+  Index n_samples = 4000;
+  std::vector<double> temperatures = {0.3 / CASM::KB, 0.5 / CASM::KB,
+                                      0.8 / CASM::KB};
+  std::mt19937_64 engine(0);
+  std::vector<Eigen::VectorXd> potential_energy;
+  for (double temperature : temperatures) {
+    std::binomial_distribution<Index> dist(n_unitcells,
+                                           excitation_prob(temperature));
+    Eigen::VectorXd e(n_samples);
+    for (Index i = 0; i < n_samples; ++i) {
+      e(i) = double(dist(engine)) / n_unitcells;
+    }
+    potential_energy.push_back(e);
+  }
+
+  MultiHistogramReweighting reweighting(temperatures, potential_energy,
+                                        n_unitcells);
+  EXPECT_TRUE(reweighting.converged());
+  EXPECT_EQ(reweighting.n_samples(), 3 * n_samples);
+  EXPECT_EQ(reweighting.free_energy()(0), 0.0);
+
+  for (double kT : {0.35, 0.4, 0.65}) {
+    double temperature = kT / CASM::KB;
+    double p = excitation_prob(temperature);
+    ReweightedAverages averages = reweighting.averages(temperature);
+    EXPECT_NEAR(averages.potential_energy, p, 0.01);
+    double heat_capacity = p * (1.0 - p) / (kT * temperature);
+    EXPECT_NEAR(averages.heat_capacity / heat_capacity, 1.0, 0.1);
+    EXPECT_GT(averages.effective_n_samples, 1000.0);
+  }
+}
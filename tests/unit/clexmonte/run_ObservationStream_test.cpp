@@ -0,0 +1,43 @@
+#include "casm/clexmonte/run/ObservationStream.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+/// \brief Test writing and reading float64 and float32 observations
+TEST(run_ObservationStream_Test, Test1) {
+  test::TmpDir tmp_dir;
+
+  Index n_samples = 25;
+  std::vector<std::string> component_names = {"0", "1"};
+  {
+    clexmonte::ObservationStream stream(tmp_dir.path(), 10, {"single"});
+    stream.begin_run(3);
+    for (Index i = 0; i < n_samples; ++i) {
+      Eigen::VectorXd value(2);
+      value << 1.0 / (i + 1), -0.1 * i;
+      stream.append("double", component_names, value);
+      stream.append("single", component_names, value);
+    }
+    stream.end_run();
+  }
+
+  fs::path run_dir = tmp_dir.path() / "run.3";
+  EXPECT_EQ(fs::file_size(run_dir / "double.bin"),
+            n_samples * 2 * sizeof(double));
+  EXPECT_EQ(fs::file_size(run_dir / "single.bin"),
+            n_samples * 2 * sizeof(float));
+
+  Eigen::MatrixXd observations_64 =
+      clexmonte::read_streamed_observations(tmp_dir.path(), 3, "double");
+  Eigen::MatrixXd observations_32 =
+      clexmonte::read_streamed_observations(tmp_dir.path(), 3, "single");
+  ASSERT_EQ(observations_64.rows(), n_samples);
+  ASSERT_EQ(observations_32.rows(), n_samples);
+  for (Index i = 0; i < n_samples; ++i) {
+    EXPECT_EQ(observations_64(i, 0), 1.0 / (i + 1));
+    EXPECT_EQ(observations_64(i, 1), -0.1 * i);
+    EXPECT_EQ(observations_32(i, 0), double(float(1.0 / (i + 1))));
+    EXPECT_EQ(observations_32(i, 1), double(float(-0.1 * i)));
+  }
+}
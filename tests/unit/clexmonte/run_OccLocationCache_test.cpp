@@ -0,0 +1,87 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/run/OccLocationCache.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/run_management/State.hh"
+#include "gtest/gtest.h"
+
+using namespace test;
+
+namespace {
+
+/// \brief Expect that the species of each tracked occupant match
+///     `occupation`
+void expect_consistent(CASM::monte::OccLocation const &occ_location,
+                       Eigen::VectorXi const &occupation) {
+  using namespace CASM;
+  auto const &convert = occ_location.convert();
+  for (Index mol_id = 0; mol_id < occ_location.mol_size(); ++mol_id) {
+    auto const &mol = occ_location.mol(mol_id);
+    Index asym = convert.l_to_asym(mol.l);
+    EXPECT_EQ(mol.species_index,
+              convert.species_index(asym, occupation(mol.l)));
+  }
+}
+
+}  // namespace
+
+class run_OccLocationCacheTest : public test::ZrOTestSystem {};
+
+/// \brief Test that the occupant location tracker is reused while the
+///     supercell is unchanged, and updated for each state
+TEST_F(run_OccLocationCacheTest, Test1) {
+  using namespace CASM;
+  using namespace CASM::clexmonte;
+
+  OccLocationCache cache(false);
+  EXPECT_EQ(cache.n_constructed(), 0);
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Index volume = T.determinant();
+  monte::State<Configuration> state_a(make_default_configuration(*system, T));
+  monte::State<Configuration> state_b(state_a);
+  for (Index i = 0; i < volume; ++i) {
+    get_occupation(state_b)(2 * volume + i) = 1;
+  }
+
+  monte::OccLocation &occ_location_a = cache.get(*system, state_a);
+  EXPECT_EQ(cache.n_constructed(), 1);
+  EXPECT_EQ(cache.n_initialized(), 1);
+  EXPECT_EQ(&occ_location_a.convert(),
+            &get_index_conversions(*system, state_a));
+  expect_consistent(occ_location_a, get_occupation(state_a));
+
+  // Many sites changed: re-initialized
+  monte::OccLocation &occ_location_b = cache.get(*system, state_b);
+  EXPECT_EQ(cache.n_constructed(), 1);
+  EXPECT_EQ(cache.n_initialized(), 2);
+  EXPECT_EQ(cache.n_reused(), 0);
+  EXPECT_EQ(&occ_location_b, &occ_location_a);
+  expect_consistent(occ_location_b, get_occupation(state_b));
+
+  // Unchanged, as for dependent runs: reused
+  cache.get(*system, state_b);
+  EXPECT_EQ(cache.n_initialized(), 2);
+  EXPECT_EQ(cache.n_reused(), 1);
+  EXPECT_EQ(cache.n_changed_sites(), 0);
+  expect_consistent(occ_location_b, get_occupation(state_b));
+
+  // One site changed: reused and updated
+  get_occupation(state_b)(2 * volume) = 0;
+  cache.get(*system, state_b);
+  EXPECT_EQ(cache.n_initialized(), 2);
+  EXPECT_EQ(cache.n_reused(), 2);
+  EXPECT_EQ(cache.n_changed_sites(), 1);
+  expect_consistent(occ_location_b, get_occupation(state_b));
+
+  // A different supercell requires a new tracker
+  Eigen::Matrix3l T_c = Eigen::Matrix3l::Identity() * 3;
+  monte::State<Configuration> state_c(
+      make_default_configuration(*system, T_c));
+  monte::OccLocation &occ_location_c = cache.get(*system, state_c);
+  EXPECT_EQ(cache.n_constructed(), 2);
+  EXPECT_EQ(cache.n_initialized(), 3);
+  EXPECT_EQ(&occ_location_c.convert(),
+            &get_index_conversions(*system, state_c));
+}
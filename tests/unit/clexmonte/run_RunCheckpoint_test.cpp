@@ -0,0 +1,166 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/run/RunCheckpoint.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/events/OccCandidate.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::monte;
+using namespace CASM::clexmonte;
+
+class run_RunCheckpoint_Test : public ZrOTestSystem {
+ public:
+  typedef canonical::Canonical_mt19937_64 calculation_type;
+  typedef calculation_type::engine_type engine_type;
+
+  run_RunCheckpoint_Test()
+      : calculation(std::make_shared<calculation_type>(system)) {}
+
+  /// \brief Initial state: 4x4x4 supercell, half of the O sites occupied
+  state_type make_initial_state() const {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+    Index volume = T.determinant();
+    state_type state(
+        make_default_configuration(*system, T),
+        canonical::make_conditions(600.0, system->composition_converter,
+                                   {{"Zr", 2.0}, {"O", 1.0}, {"Va", 1.0}}));
+    for (Index l = 0; l < volume; ++l) {
+      get_occupation(state)(2 * volume + 2 * l) = 1;
+    }
+    return state;
+  }
+
+  /// \brief Run `n_passes` canonical Monte Carlo passes, as `run_series`
+  ///     does, with occupant tracking initialized from `state`
+  ///
+  /// If `checkpoint_writer` is not null, the "checkpoint" sampling function
+  /// is sampled every pass.
+  void run_passes(state_type &state, std::shared_ptr<engine_type> engine,
+                  Index n_passes,
+                  std::shared_ptr<RunCheckpointWriter> checkpoint_writer) {
+    Conversions const &convert = get_index_conversions(*system, state);
+    OccCandidateList const &occ_candidate_list =
+        get_occ_candidate_list(*system, state);
+    OccLocation occ_location(convert, occ_candidate_list);
+    occ_location.initialize(get_occupation(state));
+
+    std::map<std::string, state_sampling_function_type> sampling_functions;
+    SamplingParams sampling_params;
+    sampling_params.sample_mode = SAMPLE_MODE::BY_PASS;
+    if (checkpoint_writer) {
+      auto f = make_run_checkpoint_f(calculation, engine, checkpoint_writer);
+      sampling_functions.emplace(f.name, f);
+      sampling_params.sampler_names = {f.name};
+    }
+    CompletionCheckParams<statistics_type> completion_check_params;
+    completion_check_params.equilibration_check_f = default_equilibration_check;
+    completion_check_params.calc_statistics_f = BasicStatisticsCalculator();
+    completion_check_params.cutoff_params.min_count = n_passes;
+    completion_check_params.cutoff_params.max_count = n_passes;
+
+    std::vector<sampling_fixture_params_type> sampling_fixture_params;
+    sampling_fixture_params.push_back(make_sampling_fixture_params(
+        "thermo", sampling_functions, {}, {}, sampling_params,
+        completion_check_params, {} /*analysis_names*/,
+        false /*write_results*/, false /*write_trajectory*/,
+        false /*write_observations*/, false /*write_status*/,
+        std::nullopt /*output_dir*/, std::nullopt /*log_file*/,
+        600.0 /*log_frequency_in_s*/));
+    run_manager_type<engine_type> run_manager(engine, sampling_fixture_params,
+                                              true /*global_cutoff*/);
+    calculation->run(state, occ_location, run_manager);
+  }
+
+  std::shared_ptr<calculation_type> calculation;
+};
+
+/// \brief Test that a run resumed from a checkpoint continues exactly as the
+///     run that wrote the checkpoint would have continued
+///
+/// A resumed run re-initializes occupant tracking from the checkpointed
+/// occupation, so the uninterrupted run is continued the same way, without
+/// writing or reading a checkpoint.
+TEST_F(run_RunCheckpoint_Test, ResumeTest1) {
+  test::TmpDir tmp_dir;
+  fs::path checkpoint_path = tmp_dir.path() / "checkpoint.json";
+  Index run_index = 3;
+
+  // uninterrupted: 10 passes, then 10 more passes
+  state_type state_a = make_initial_state();
+  auto engine_a = std::make_shared<engine_type>(42);
+  run_passes(state_a, engine_a, 10, nullptr);
+  Eigen::VectorXi occupation_at_checkpoint = get_occupation(state_a);
+  run_passes(state_a, engine_a, 10, nullptr);
+
+  // interrupted: 10 passes, taking a checkpoint every pass, and a final
+  // checkpoint when interrupted
+  {
+    state_type state_b = make_initial_state();
+    auto engine_b = std::make_shared<engine_type>(42);
+    auto checkpoint_writer =
+        std::make_shared<RunCheckpointWriter>(checkpoint_path, 0.0);
+    checkpoint_writer->begin_run(run_index);
+    run_passes(state_b, engine_b, 10, checkpoint_writer);
+    EXPECT_EQ(get_occupation(state_b), occupation_at_checkpoint);
+
+    auto f = make_run_checkpoint_f(calculation, engine_b, checkpoint_writer);
+    EXPECT_EQ(f.function()(0), 1.0);
+    checkpoint_writer->wait();
+  }
+  ASSERT_TRUE(fs::exists(checkpoint_path));
+
+  // restore, in a new writer, state and engine
+  state_type state_c = make_initial_state();
+  auto engine_c = std::make_shared<engine_type>(7);
+  RunCheckpointWriter checkpoint_writer(checkpoint_path, 0.0);
+
+  // a checkpoint for a different run is not used
+  checkpoint_writer.begin_run(run_index + 1);
+  EXPECT_FALSE(resume_from_run_checkpoint(checkpoint_writer, state_c,
+                                          *engine_c));
+  EXPECT_EQ(*engine_c, engine_type(7));
+
+  checkpoint_writer.begin_run(run_index);
+  ASSERT_TRUE(resume_from_run_checkpoint(checkpoint_writer, state_c,
+                                         *engine_c));
+  EXPECT_EQ(get_occupation(state_c), occupation_at_checkpoint);
+
+  // continue: 10 more passes
+  run_passes(state_c, engine_c, 10, nullptr);
+  EXPECT_EQ(get_occupation(state_c), get_occupation(state_a));
+  EXPECT_EQ(*engine_c, *engine_a);
+
+  // the checkpoint is removed when the run completes
+  checkpoint_writer.end_run();
+  EXPECT_FALSE(fs::exists(checkpoint_path));
+  EXPECT_FALSE(checkpoint_writer.read().has_value());
+}
+
+/// \brief Test that a checkpoint whose occupation does not match the
+///     supercell is rejected
+TEST_F(run_RunCheckpoint_Test, ResumeTest2) {
+  test::TmpDir tmp_dir;
+  fs::path checkpoint_path = tmp_dir.path() / "checkpoint.json";
+
+  RunCheckpointWriter checkpoint_writer(checkpoint_path, 0.0);
+  checkpoint_writer.begin_run(0);
+  RunCheckpointData data;
+  data.run_index = 0;
+  data.occupation = make_compact_occupation(Eigen::VectorXi::Zero(8));
+  std::stringstream ss;
+  ss << engine_type(42);
+  data.engine_state = ss.str();
+  checkpoint_writer.write(data);
+  checkpoint_writer.wait();
+
+  state_type state = make_initial_state();
+  engine_type engine;
+  EXPECT_THROW(resume_from_run_checkpoint(checkpoint_writer, state, engine),
+               std::runtime_error);
+}
@@ -0,0 +1,80 @@
+#include "casm/clexmonte/run/RunControl.hh"
+
+#include "casm/monte/run_management/Results.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that the predicate is only evaluated after new samples
+TEST(run_RunControl_Test, Test1) {
+  Index n_calls = 0;
+  clexmonte::RunControl run_control(
+      [&](clexmonte::results_type const &results) {
+        ++n_calls;
+        if (results.sample_count.size() >= 3) {
+          return clexmonte::RunControlAction::stop;
+        }
+        return clexmonte::RunControlAction::extend;
+      });
+
+  // results without samplers
+  clexmonte::results_type results({}, {}, {}, {}, {});
+  run_control.begin_run();
+  EXPECT_EQ(run_control.action(), clexmonte::RunControlAction::proceed);
+
+  // no samples yet
+  run_control.check(results);
+  EXPECT_EQ(n_calls, 0);
+
+  results.sample_count.push_back(0);
+  run_control.check(results);
+  run_control.check(results);
+  EXPECT_EQ(n_calls, 1);
+  EXPECT_EQ(run_control.action(), clexmonte::RunControlAction::extend);
+
+  results.sample_count.push_back(1);
+  results.sample_count.push_back(2);
+  run_control.check(results);
+  EXPECT_EQ(n_calls, 2);
+  EXPECT_EQ(run_control.n_evaluations(), 2);
+  EXPECT_TRUE(run_control.stopped());
+
+  run_control.begin_run();
+  EXPECT_EQ(run_control.action(), clexmonte::RunControlAction::proceed);
+  EXPECT_EQ(run_control.n_evaluations(), 0);
+}
+
+/// \brief Test action names
+TEST(run_RunControl_Test, Test2) {
+  for (auto action : {clexmonte::RunControlAction::proceed,
+                      clexmonte::RunControlAction::stop,
+                      clexmonte::RunControlAction::extend}) {
+    EXPECT_EQ(clexmonte::run_control_action_from_name(
+                  clexmonte::run_control_action_name(action)),
+              action);
+  }
+  EXPECT_THROW(clexmonte::run_control_action_from_name("pause"),
+               std::runtime_error);
+  EXPECT_THROW(clexmonte::RunControl(nullptr), std::runtime_error);
+}
+
+/// \brief Test that a stop request persists across begin_run until cleared
+TEST(run_RunControl_Test, Test3) {
+  clexmonte::RunControl run_control(
+      [](clexmonte::results_type const &results) {
+        return clexmonte::RunControlAction::proceed;
+      });
+  EXPECT_FALSE(run_control.stop_requested());
+  EXPECT_FALSE(run_control.stopped());
+
+  run_control.request_stop();
+  EXPECT_TRUE(run_control.stop_requested());
+  EXPECT_TRUE(run_control.stopped());
+  EXPECT_EQ(run_control.action(), clexmonte::RunControlAction::proceed);
+
+  run_control.begin_run();
+  EXPECT_TRUE(run_control.stopped());
+
+  run_control.clear_stop_request();
+  EXPECT_FALSE(run_control.stopped());
+}
@@ -0,0 +1,107 @@
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/run/RunSeriesCoordinator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test that runs are distributed to workers and results are
+///     gathered in run order, regardless of the order runs finish
+TEST(run_RunSeriesCoordinator_Test, Test1) {
+  using namespace clexmonte;
+
+  RunSeriesCoordinator<std::string> coordinator(4, 2, 1);
+  std::vector<std::string> gathered;
+  auto gather = [&](std::vector<std::string> const &results) {
+    gathered.insert(gathered.end(), results.begin(), results.end());
+  };
+
+  EXPECT_EQ(coordinator.ready(1), 0);
+  EXPECT_EQ(coordinator.ready(2), 1);
+
+  // run 1 finishes first, and is held until run 0 is finished
+  gather(coordinator.done(1, "result 1"));
+  EXPECT_TRUE(gathered.empty());
+  EXPECT_EQ(coordinator.ready(2), 2);
+  gather(coordinator.done(0, "result 0"));
+  EXPECT_EQ(gathered, std::vector<std::string>({"result 0", "result 1"}));
+  EXPECT_EQ(coordinator.ready(1), 3);
+
+  // idle workers are only stopped when all runs are finished
+  EXPECT_FALSE(coordinator.ready(2).has_value());
+  EXPECT_TRUE(coordinator.take_workers_to_stop().empty());
+  gather(coordinator.done(3, "result 3"));
+  gather(coordinator.done(2, "result 2"));
+  EXPECT_EQ(gathered, std::vector<std::string>(
+                          {"result 0", "result 1", "result 2", "result 3"}));
+  EXPECT_TRUE(coordinator.is_finished());
+  EXPECT_EQ(coordinator.take_workers_to_stop(), std::vector<int>({2}));
+  EXPECT_EQ(coordinator.n_active_workers(), 1);
+  EXPECT_FALSE(coordinator.ready(1).has_value());
+  EXPECT_EQ(coordinator.take_workers_to_stop(), std::vector<int>({1}));
+  EXPECT_EQ(coordinator.n_active_workers(), 0);
+  EXPECT_EQ(coordinator.n_gathered(), 4);
+  EXPECT_TRUE(coordinator.errors().empty());
+
+  EXPECT_THROW(coordinator.done(0, "again"), std::runtime_error);
+}
+
+/// \brief Test that failed runs are requeued to idle workers, up to
+///     max_attempts, and reported if they can not be completed
+TEST(run_RunSeriesCoordinator_Test, Test2) {
+  using namespace clexmonte;
+
+  RunSeriesCoordinator<std::string> coordinator(2, 3, 2, 11);
+  EXPECT_EQ(coordinator.ready(1), 0);
+  EXPECT_EQ(coordinator.ready(2), 1);
+  EXPECT_FALSE(coordinator.ready(3).has_value());
+
+  // run 0 fails on worker 1, and is given to idle worker 3
+  auto requeued = coordinator.failed(1, 0, "bad state");
+  ASSERT_TRUE(requeued.has_value());
+  EXPECT_EQ(requeued->first, 3);
+  EXPECT_EQ(requeued->second, 0);
+  EXPECT_EQ(coordinator.n_attempts(0), 2);
+  EXPECT_EQ(coordinator.n_active_workers(), 2);
+
+  // run 0 fails again, and is not requeued
+  EXPECT_FALSE(coordinator.failed(3, 0, "bad state").has_value());
+  EXPECT_EQ(coordinator.done(1, "result 1").size(), 0);
+  EXPECT_TRUE(coordinator.is_finished());
+  EXPECT_FALSE(coordinator.ready(2).has_value());
+  EXPECT_EQ(coordinator.take_workers_to_stop(), std::vector<int>({2}));
+  EXPECT_EQ(coordinator.n_active_workers(), 0);
+
+  auto errors = coordinator.errors();
+  ASSERT_EQ(errors.size(), 1);
+  EXPECT_EQ(errors[0], "Run 11 failed 2 times: bad state");
+
+  // all workers fail: the remaining run is reported as not performed
+  RunSeriesCoordinator<std::string> coordinator2(1, 1, 2);
+  EXPECT_EQ(coordinator2.ready(1), 0);
+  EXPECT_FALSE(coordinator2.failed(1, 0, "crash").has_value());
+  EXPECT_EQ(coordinator2.n_active_workers(), 0);
+  EXPECT_FALSE(coordinator2.is_finished());
+  ASSERT_EQ(coordinator2.errors().size(), 1);
+  EXPECT_EQ(coordinator2.errors()[0],
+            "Run 0 was not performed: no workers remaining");
+}
+
+/// \brief Test that permission to write results is granted to one worker
+///     at a time, in request order
+TEST(run_RunSeriesCoordinator_Test, Test3) {
+  using namespace clexmonte;
+
+  RunSeriesCoordinator<std::string> coordinator(3, 3, 1);
+  EXPECT_TRUE(coordinator.request_write(2));
+  EXPECT_FALSE(coordinator.request_write(1));
+  EXPECT_FALSE(coordinator.request_write(3));
+  EXPECT_EQ(coordinator.write_done(), 1);
+  EXPECT_EQ(coordinator.write_done(), 3);
+  EXPECT_FALSE(coordinator.write_done().has_value());
+  EXPECT_TRUE(coordinator.request_write(3));
+
+  EXPECT_THROW(RunSeriesCoordinator<std::string>(1, 1, 0),
+               std::runtime_error);
+}
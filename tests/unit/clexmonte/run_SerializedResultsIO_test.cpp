@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "casm/clexmonte/run/SerializedResultsIO.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Records writes, and whether any two writes overlapped
+class RecordingResultsIO : public clexmonte::results_io_type {
+ public:
+  std::vector<monte::ValueMap> read_conditions() override {
+    return std::vector<monte::ValueMap>(run_indices.size());
+  }
+
+  void write(clexmonte::results_type const &results,
+             monte::ValueMap const &conditions, Index run_index) override {
+    if (n_writing++ != 0) {
+      overlapped = true;
+    }
+    // a read-modify-write of a shared file, such as "summary.json"
+    std::vector<Index> tmp = run_indices;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    tmp.push_back(run_index);
+    run_indices = tmp;
+    --n_writing;
+  }
+
+  std::atomic<Index> n_writing{0};
+  std::atomic<bool> overlapped{false};
+  std::vector<Index> run_indices;
+};
+
+}  // namespace
+
+/// \brief Test that writes by several workers to one ResultsIO are
+///     serialized, so that no run is lost
+TEST(run_SerializedResultsIO_Test, Test1) {
+  using namespace clexmonte;
+
+  auto recording = std::make_shared<RecordingResultsIO>();
+  auto mutex = std::make_shared<std::mutex>();
+  Index n_workers = 4;
+  Index n_runs_per_worker = 10;
+
+  std::vector<std::thread> threads;
+  for (Index t = 0; t < n_workers; ++t) {
+    threads.emplace_back([&, t]() {
+      SerializedResultsIO results_io(recording, mutex);
+      results_type results({}, {}, {}, {}, {});
+      for (Index i = 0; i < n_runs_per_worker; ++i) {
+        results_io.write(results, monte::ValueMap(),
+                         t * n_runs_per_worker + i + 1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_FALSE(recording->overlapped);
+  std::vector<Index> run_indices = recording->run_indices;
+  ASSERT_EQ(run_indices.size(), n_workers * n_runs_per_worker);
+  std::sort(run_indices.begin(), run_indices.end());
+  for (Index i = 0; i < Index(run_indices.size()); ++i) {
+    EXPECT_EQ(run_indices[i], i + 1);
+  }
+
+  SerializedResultsIO results_io(recording, mutex);
+  EXPECT_EQ(results_io.read_conditions().size(), run_indices.size());
+}
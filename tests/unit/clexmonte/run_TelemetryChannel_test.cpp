@@ -0,0 +1,91 @@
+#include "casm/clexmonte/run/TelemetryChannel.hh"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+bool publish_n_steps(clexmonte::TelemetryChannel &channel, Index n_steps) {
+  return channel.try_publish([&](clexmonte::TelemetryRecord &record) {
+    record.run_index = 0;
+    record.n_steps = n_steps;
+  });
+}
+
+}  // namespace
+
+/// \brief Test that records are read in order and dropped when full
+TEST(run_TelemetryChannel_Test, Test1) {
+  clexmonte::TelemetryChannel channel(3);
+  EXPECT_TRUE(channel.read().empty());
+
+  EXPECT_TRUE(publish_n_steps(channel, 1));
+  EXPECT_TRUE(publish_n_steps(channel, 2));
+  EXPECT_EQ(channel.n_unread(), 2);
+
+  std::vector<clexmonte::TelemetryRecord> records = channel.read();
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].n_steps, 1);
+  EXPECT_EQ(records[1].n_steps, 2);
+  EXPECT_EQ(channel.n_unread(), 0);
+
+  // fill the buffer, wrapping around, then drop
+  EXPECT_TRUE(publish_n_steps(channel, 3));
+  EXPECT_TRUE(publish_n_steps(channel, 4));
+  EXPECT_TRUE(publish_n_steps(channel, 5));
+  EXPECT_FALSE(publish_n_steps(channel, 6));
+  EXPECT_EQ(channel.n_published(), 5);
+  EXPECT_EQ(channel.n_dropped(), 1);
+
+  records = channel.read();
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[0].n_steps, 3);
+  EXPECT_EQ(records[2].n_steps, 5);
+
+  EXPECT_TRUE(publish_n_steps(channel, 7));
+  records = channel.read();
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].n_steps, 7);
+}
+
+/// \brief Test events_per_s bookkeeping and invalid construction
+TEST(run_TelemetryChannel_Test, Test2) {
+  clexmonte::TelemetryChannel channel(4, 10.0);
+  EXPECT_TRUE(channel.is_due());
+  EXPECT_EQ(channel.update_events_per_s(0, 100, 1.0), 0.0);
+  EXPECT_FALSE(channel.is_due());
+  EXPECT_DOUBLE_EQ(channel.update_events_per_s(0, 300, 2.0), 200.0);
+
+  // a new run restarts the rate
+  EXPECT_EQ(channel.update_events_per_s(1, 50, 3.0), 0.0);
+
+  EXPECT_THROW(clexmonte::TelemetryChannel(0), std::runtime_error);
+  EXPECT_THROW(clexmonte::TelemetryChannel(4, -1.0), std::runtime_error);
+}
+
+/// \brief Test that a concurrent reader receives every record in order
+TEST(run_TelemetryChannel_Test, Test3) {
+  clexmonte::TelemetryChannel channel(8);
+  Index n_records = 10000;
+
+  std::vector<Index> received;
+  std::thread reader([&]() {
+    while (Index(received.size()) + channel.n_dropped() < n_records) {
+      for (auto const &record : channel.read()) {
+        received.push_back(record.n_steps);
+      }
+    }
+  });
+  for (Index i = 0; i < n_records; ++i) {
+    publish_n_steps(channel, i);
+  }
+  reader.join();
+
+  EXPECT_EQ(Index(received.size()) + channel.n_dropped(), n_records);
+  for (Index i = 1; i < Index(received.size()); ++i) {
+    EXPECT_LT(received[i - 1], received[i]);
+  }
+}
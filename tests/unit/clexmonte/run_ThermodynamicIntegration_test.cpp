@@ -0,0 +1,132 @@
+#include "casm/clexmonte/run/ThermodynamicIntegration.hh"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Excitation probability of a two-level site, with excitation
+///     energy 1.0, at `temperature`
+double excitation_prob(double temperature) {
+  double x = std::exp(-1.0 / (CASM::KB * temperature));
+  return x / (1.0 + x);
+}
+
+/// \brief Free energy of a two-level site, with excitation energy 1.0, at
+///     `temperature`
+double two_level_free_energy(double temperature) {
+  double kT = CASM::KB * temperature;
+  return -kT * std::log(1.0 + std::exp(-1.0 / kT));
+}
+
+/// \brief Integrate along a temperature path, kT = 0.2 + 0.1 * t, for
+///     independent two-level sites
+clexmonte::ThermodynamicIntegration make_two_level_integration(
+    std::vector<double> const &t) {
+  std::vector<double> temperature;
+  std::vector<Eigen::VectorXd> empty;
+  std::vector<double> potential_energy;
+  for (double _t : t) {
+    double T = (0.2 + 0.1 * _t) / CASM::KB;
+    temperature.push_back(T);
+    empty.push_back(Eigen::VectorXd());
+    potential_energy.push_back(excitation_prob(T));
+  }
+  double T_init = 0.2 / CASM::KB;
+  return clexmonte::ThermodynamicIntegration(t, temperature, empty,
+                                             potential_energy, empty,
+                                             two_level_free_energy(T_init));
+}
+
+}  // namespace
+
+/// \brief Test integration over temperature, for which the exact free energy
+///     is known, and that refinement targets the largest errors
+TEST(run_ThermodynamicIntegration_Test, Test1) {
+  using namespace clexmonte;
+
+  // Unsorted input
+  std::vector<double> t = {4.0, 0.0, 2.0, 1.0, 3.0, 5.0, 6.0, 7.0, 8.0};
+  ThermodynamicIntegration integration = make_two_level_integration(t);
+  ASSERT_EQ(integration.n_runs(), 9);
+  EXPECT_EQ(integration.order()[0], 1);
+  EXPECT_EQ(integration.t()[0], 0.0);
+  EXPECT_EQ(integration.t()[8], 8.0);
+  ASSERT_EQ(integration.error_estimate().size(), 8);
+
+  double total_error = 0.0;
+  for (Index i = 0; i < integration.n_runs(); ++i) {
+    double T = (0.2 + 0.1 * integration.t()[i]) / CASM::KB;
+    double exact = two_level_free_energy(T);
+    double error = std::abs(integration.free_energy()(i) - exact);
+    if (i > 0) {
+      total_error += integration.error_estimate()(i - 1);
+    }
+    // the estimate is of the right magnitude
+    EXPECT_LT(error, 3.0 * total_error + 1e-10);
+    EXPECT_LT(error, 0.02);
+  }
+
+  // Refinement midpoints, and refined integration is more accurate
+  double tol = integration.error_estimate().maxCoeff() / 2.0;
+  std::vector<double> refinement_t = integration.refinement_t(tol);
+  EXPECT_GT(refinement_t.size(), 0);
+  EXPECT_LT(refinement_t.size(), 8);
+  std::vector<double> refined = t;
+  for (double _t : refinement_t) {
+    EXPECT_EQ(_t - std::floor(_t), 0.5);
+    refined.push_back(_t);
+  }
+  ThermodynamicIntegration refined_integration =
+      make_two_level_integration(refined);
+  Index last = refined_integration.n_runs() - 1;
+  double T_final = 1.0 / CASM::KB;
+  EXPECT_LT(
+      std::abs(refined_integration.free_energy()(last) -
+               two_level_free_energy(T_final)),
+      std::abs(integration.free_energy()(8) - two_level_free_energy(T_final)));
+}
+
+/// \brief Test integration over chemical potential, for an ideal lattice
+///     gas, with semi-grand canonical free energy -kT*ln(1 + exp(mu/kT))
+TEST(run_ThermodynamicIntegration_Test, Test2) {
+  using namespace clexmonte;
+
+  double kT = 0.05;
+  double T = kT / CASM::KB;
+  auto exact = [&](double mu) {
+    return -kT * std::log(1.0 + std::exp(mu / kT));
+  };
+
+  std::vector<double> t;
+  std::vector<double> temperature;
+  std::vector<Eigen::VectorXd> param_chem_pot;
+  std::vector<double> potential_energy;
+  std::vector<Eigen::VectorXd> param_composition;
+  for (Index i = 0; i <= 40; ++i) {
+    double mu = -0.2 + 0.01 * i;
+    double x = 1.0 / (1.0 + std::exp(-mu / kT));
+    t.push_back(i);
+    temperature.push_back(T);
+    param_chem_pot.push_back(Eigen::VectorXd::Constant(1, mu));
+    potential_energy.push_back(-mu * x);
+    param_composition.push_back(Eigen::VectorXd::Constant(1, x));
+  }
+  ThermodynamicIntegration integration(t, temperature, param_chem_pot,
+                                       potential_energy, param_composition,
+                                       exact(-0.2));
+  for (Index i = 0; i < integration.n_runs(); ++i) {
+    double mu = -0.2 + 0.01 * i;
+    EXPECT_NEAR(integration.free_energy()(i), exact(mu), 1e-4);
+  }
+
+  // Curvature of x(mu) is largest at |mu| ~= 1.3 * kT, and 0 at mu = 0
+  Index i_max;
+  integration.error_estimate().maxCoeff(&i_max);
+  EXPECT_NEAR(std::abs(integration.t()[i_max] + 0.5 - 20.0), 6.5, 1.5);
+  EXPECT_LT(integration.error_estimate()(19),
+            integration.error_estimate()(i_max) / 2.0);
+}
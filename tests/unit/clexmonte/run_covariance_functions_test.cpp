@@ -0,0 +1,64 @@
+#include "casm/clexmonte/run/covariance_functions.hh"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Excitation probability of a two-level site, with excitation
+///     energy `energy`, at `kT`
+double excitation_prob(double energy, double kT) {
+  double x = std::exp(-energy / kT);
+  return x / (1.0 + x);
+}
+
+}  // namespace
+
+/// \brief Test reweighting samples of independent two-level sites to
+///     ensemble members with different excitation energies, for which the
+///     exact averages are known
+TEST(run_covariance_functions_Test, EnsembleReweightedMeans) {
+  using namespace clexmonte;
+
+  Index n_unitcells = 100;
+  Index n_samples = 20000;
+  double kT = 0.5;
+  std::vector<double> member_energy = {1.0, 0.98, 1.01, 1.03};
+  Index n_members = member_energy.size();
+
+  std::mt19937_64 engine(0);
+  std::binomial_distribution<Index> dist(n_unitcells,
+                                         excitation_prob(1.0, kT));
+  Eigen::VectorXd reference_energy(n_samples);
+  Eigen::MatrixXd ensemble_energy(n_samples, n_members);
+  for (Index i = 0; i < n_samples; ++i) {
+    double x = double(dist(engine)) / n_unitcells;
+    reference_energy(i) = x;
+    for (Index k = 0; k < n_members; ++k) {
+      ensemble_energy(i, k) = member_energy[k] * x;
+    }
+  }
+
+  Eigen::VectorXd effective_n_samples;
+  Eigen::VectorXd means =
+      ensemble_reweighted_means(reference_energy, ensemble_energy,
+                                n_unitcells / kT, &effective_n_samples);
+  ASSERT_EQ(means.size(), n_members);
+  ASSERT_EQ(effective_n_samples.size(), n_members);
+
+  // the reference member is not reweighted
+  EXPECT_NEAR(means(0), reference_energy.mean(), 1e-12);
+  EXPECT_NEAR(effective_n_samples(0), double(n_samples), 1e-6);
+
+  for (Index k = 0; k < n_members; ++k) {
+    double exact = member_energy[k] * excitation_prob(member_energy[k], kT);
+    EXPECT_NEAR(means(k) / exact, 1.0, 0.01);
+    EXPECT_GT(effective_n_samples(k), 1000.0);
+  }
+  // fewer effective samples for members further from the reference
+  EXPECT_LT(effective_n_samples(3), effective_n_samples(2));
+}
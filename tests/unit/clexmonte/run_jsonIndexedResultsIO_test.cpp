@@ -0,0 +1,138 @@
+#include <fstream>
+
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexmonte/run/io/json/jsonIndexedResultsIO.hh"
+#include "casm/monte/run_management/Results.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+monte::ValueMap make_conditions(double temperature) {
+  monte::ValueMap conditions;
+  conditions.scalar_values["temperature"] = temperature;
+  Eigen::VectorXd mol_composition(3);
+  mol_composition << 2.0, 0.5, 1.5;
+  conditions.vector_values["mol_composition"] = mol_composition;
+  return conditions;
+}
+
+/// \brief Number of lines in a file
+Index count_lines(fs::path const &path) {
+  std::ifstream file(path);
+  std::string line;
+  Index n = 0;
+  while (std::getline(file, line)) {
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace
+
+/// \brief Test that written runs are read back, in the order written, and
+///     each run has its own results directory
+TEST(run_jsonIndexedResultsIO_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path output_dir = tmp_dir.path() / "results";
+  std::vector<double> temperatures = {300.0, 400.0, 500.0};
+
+  {
+    jsonIndexedResultsIO results_io(output_dir, false, false);
+    EXPECT_EQ(results_io.read_conditions().size(), 0);
+    results_type results({}, {}, {}, {}, {});
+    for (Index i = 0; i < Index(temperatures.size()); ++i) {
+      results_io.write(results, make_conditions(temperatures[i]), i + 1);
+    }
+  }
+
+  // read by a new instance
+  jsonIndexedResultsIO results_io(output_dir, false, false);
+  std::vector<monte::ValueMap> conditions = results_io.read_conditions();
+  ASSERT_EQ(conditions.size(), temperatures.size());
+  for (Index i = 0; i < Index(temperatures.size()); ++i) {
+    monte::ValueMap expected = make_conditions(temperatures[i]);
+    EXPECT_EQ(conditions[i].scalar_values, expected.scalar_values);
+    EXPECT_EQ(conditions[i].vector_values.at("mol_composition"),
+              expected.vector_values.at("mol_composition"));
+    std::string run_dir_name = "run." + std::to_string(i + 1);
+    EXPECT_EQ(results_io.run_dir(i + 1), output_dir / run_dir_name);
+    EXPECT_TRUE(fs::exists(results_io.run_dir(i + 1) / "summary.json"));
+  }
+
+  // each index line holds the run index, conditions, and the run summary
+  std::ifstream file(output_dir / "summary.jsonl");
+  std::string line;
+  for (Index i = 0; i < Index(temperatures.size()); ++i) {
+    ASSERT_TRUE(std::getline(file, line));
+    jsonParser json = jsonParser::parse(line);
+    EXPECT_EQ(json["run_index"].get<Index>(), i + 1);
+    EXPECT_EQ(json["conditions"]["temperature"].get<double>(),
+              temperatures[i]);
+    EXPECT_EQ(json["summary"],
+              jsonParser(results_io.run_dir(i + 1) / "summary.json"));
+  }
+}
+
+/// \brief Test that a partially written index line is ignored, and that a
+///     repeated run replaces the run directory and is appended to the index
+TEST(run_jsonIndexedResultsIO_Test, Test2) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path output_dir = tmp_dir.path() / "results";
+  results_type results({}, {}, {}, {}, {});
+
+  jsonIndexedResultsIO results_io(output_dir, false, false);
+  results_io.write(results, make_conditions(300.0), 1);
+  results_io.write(results, make_conditions(400.0), 2);
+
+  // an interrupted write of a third run
+  {
+    std::ofstream file(output_dir / "summary.jsonl", std::ios::app);
+    file << "{\"run_index\": 3, \"conditions\": {\"temp";
+  }
+  std::vector<monte::ValueMap> conditions = results_io.read_conditions();
+  ASSERT_EQ(conditions.size(), 2);
+  EXPECT_EQ(conditions[1].scalar_values.at("temperature"), 400.0);
+
+  // a repeated run, after the partial line was removed by a restart
+  {
+    std::ifstream in(output_dir / "summary.jsonl");
+    std::string line;
+    std::string complete;
+    while (std::getline(in, line) && !in.eof()) {
+      complete += line + "\n";
+    }
+    in.close();
+    std::ofstream out(output_dir / "summary.jsonl", std::ios::trunc);
+    out << complete;
+  }
+  fs::path marker = results_io.run_dir(2) / "marker";
+  std::ofstream(marker) << "x" << std::endl;
+  results_io.write(results, make_conditions(450.0), 2);
+  EXPECT_FALSE(fs::exists(marker));
+  EXPECT_EQ(count_lines(output_dir / "summary.jsonl"), 3);
+  conditions = results_io.read_conditions();
+  ASSERT_EQ(conditions.size(), 3);
+  EXPECT_EQ(conditions[2].scalar_values.at("temperature"), 450.0);
+}
+
+/// \brief Test parsing jsonIndexedResultsIO
+TEST(run_jsonIndexedResultsIO_Test, ParseTest1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  jsonParser json;
+  json["output_dir"] = (tmp_dir.path() / "results").string();
+  json["write_observations"] = true;
+  InputParser<jsonIndexedResultsIO> parser(json);
+  ASSERT_TRUE(parser.valid());
+  EXPECT_EQ(parser.value->run_dir(4), tmp_dir.path() / "results" / "run.4");
+
+  jsonParser invalid_json = jsonParser::object();
+  InputParser<jsonIndexedResultsIO> invalid_parser(invalid_json);
+  EXPECT_FALSE(invalid_parser.valid());
+}
@@ -0,0 +1,146 @@
+#include <fstream>
+
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/canonical/canonical_json_io.hh"
+#include "casm/clexmonte/run/io/json/parse_and_run_series.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Write a Clex_ZrO_Occ system.json, with absolute paths to the
+///     clexulator source and coefficients, to `test_dir`
+fs::path write_system_json(fs::path test_dir) {
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  fs::path clexulator_src_relpath = fs::path("basis_sets") /
+                                    "bset.formation_energy" /
+                                    "ZrO_Clexulator_formation_energy.cc";
+  fs::path eci_relpath = "formation_energy_eci.json";
+
+  fs::create_directories(test_dir / clexulator_src_relpath.parent_path());
+  fs::copy_file(test_data_dir / clexulator_src_relpath,
+                test_dir / clexulator_src_relpath);
+  fs::copy_file(test_data_dir / eci_relpath, test_dir / eci_relpath);
+
+  jsonParser system_json(test_data_dir / "system.json");
+  system_json["basis_sets"]["formation_energy"]["source"] =
+      (test_dir / clexulator_src_relpath).string();
+  system_json["clex"]["formation_energy"]["coefficients"] =
+      (test_dir / eci_relpath).string();
+  fs::path system_json_file = test_dir / "system.json";
+  system_json.write(system_json_file);
+  return system_json_file;
+}
+
+/// \brief Write a short canonical run_params.json, writing results to
+///     `output_dir`, to `run_params_json_file`
+void write_run_params_json(fs::path run_params_json_file, fs::path output_dir,
+                           Index n_states) {
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  jsonParser run_params_json(test_data_dir / "run_params_complete.json");
+  jsonParser &kwargs = run_params_json["state_generation"]["kwargs"];
+  kwargs["initial_configuration"]["kwargs"]
+        ["transformation_matrix_to_supercell"] = jsonParser::parse(
+            std::string("[[2, 0, 0], [0, 2, 0], [0, 0, 2]]"));
+  kwargs["n_states"] = n_states;
+  kwargs["completed_runs"]["output_dir"] = output_dir.string();
+  jsonParser &thermo = run_params_json["sampling_fixtures"]["thermo"];
+  thermo["completion_check"]["cutoff"]["count"]["max"] = 10;
+  thermo["results_io"]["kwargs"]["output_dir"] =
+      (output_dir / "thermo").string();
+  run_params_json.write(run_params_json_file);
+}
+
+}  // namespace
+
+/// \brief Test that directories are expanded to their ".json" files, in
+///     order of file name, and files are kept in the order given
+TEST(run_parse_and_run_series_Test, ExpandTest1) {
+  test::TmpDir tmp_dir;
+  fs::path scan_dir = tmp_dir.path() / "scan";
+  fs::create_directories(scan_dir);
+  for (std::string name : {"T_600.json", "T_300.json", "notes.txt"}) {
+    std::ofstream(scan_dir / name) << "{}" << std::endl;
+  }
+  fs::path single = tmp_dir.path() / "single.json";
+  std::ofstream(single) << "{}" << std::endl;
+
+  std::vector<fs::path> files =
+      clexmonte::expand_run_params_json_files({single, scan_dir});
+  ASSERT_EQ(files.size(), 3);
+  EXPECT_EQ(files[0], single);
+  EXPECT_EQ(files[1], scan_dir / "T_300.json");
+  EXPECT_EQ(files[2], scan_dir / "T_600.json");
+
+  EXPECT_THROW(clexmonte::expand_run_params_json_files(
+                   {tmp_dir.path() / "missing.json"}),
+               std::runtime_error);
+}
+
+/// \brief Test parsing and running a canonical series from files
+TEST(run_parse_and_run_series_Test, Test1) {
+  test::TmpDir tmp_dir;
+  fs::path system_json_file = write_system_json(tmp_dir.path());
+  fs::path output_dir = tmp_dir.path() / "output";
+  fs::path run_params_json_file = tmp_dir.path() / "run_params.json";
+  write_run_params_json(run_params_json_file, output_dir, 2);
+
+  clexmonte::parse_and_run_series<clexmonte::canonical::Canonical_mt19937_64>(
+      system_json_file, run_params_json_file);
+
+  EXPECT_TRUE(fs::exists(output_dir / "completed_runs.json"));
+  jsonParser completed_runs_json(output_dir / "completed_runs.json");
+  EXPECT_EQ(completed_runs_json.size(), 2);
+  EXPECT_TRUE(fs::exists(output_dir / "thermo" / "summary.json"));
+
+  EXPECT_THROW(
+      clexmonte::parse_and_run_series<
+          clexmonte::canonical::Canonical_mt19937_64>(
+          system_json_file, tmp_dir.path() / "missing.json"),
+      std::runtime_error);
+}
+
+/// \brief Test running several series, in the order given, including
+///     series which share a calculation
+TEST(run_parse_and_run_series_Test, Test2) {
+  test::TmpDir tmp_dir;
+  fs::path system_json_file = write_system_json(tmp_dir.path());
+  std::vector<fs::path> run_params_json_files;
+  std::vector<Index> n_states = {1, 2, 1};
+  for (Index i = 0; i < Index(n_states.size()); ++i) {
+    fs::path run_params_json_file =
+        tmp_dir.path() / ("run_params." + std::to_string(i) + ".json");
+    write_run_params_json(run_params_json_file,
+                          tmp_dir.path() / ("output." + std::to_string(i)),
+                          n_states[i]);
+    run_params_json_files.push_back(run_params_json_file);
+  }
+
+  // the last series uses different "calculation_options"
+  jsonParser last_json(run_params_json_files.back());
+  last_json["calculation_options"]["label"] = "other";
+  last_json.write(run_params_json_files.back());
+
+  clexmonte::parse_and_run_series<clexmonte::canonical::Canonical_mt19937_64>(
+      system_json_file, run_params_json_files);
+
+  for (Index i = 0; i < Index(n_states.size()); ++i) {
+    fs::path output_dir = tmp_dir.path() / ("output." + std::to_string(i));
+    jsonParser completed_runs_json(output_dir / "completed_runs.json");
+    EXPECT_EQ(completed_runs_json.size(), n_states[i]);
+    EXPECT_TRUE(fs::exists(output_dir / "thermo" / "summary.json"));
+  }
+
+  // a missing file stops the series which follow it
+  fs::path missing = tmp_dir.path() / "missing.json";
+  fs::path after = tmp_dir.path() / "run_params.after.json";
+  write_run_params_json(after, tmp_dir.path() / "output.after", 1);
+  EXPECT_THROW(
+      clexmonte::parse_and_run_series<
+          clexmonte::canonical::Canonical_mt19937_64>(
+          system_json_file, std::vector<fs::path>({missing, after})),
+      std::runtime_error);
+  EXPECT_FALSE(fs::exists(tmp_dir.path() / "output.after"));
+}
@@ -0,0 +1,96 @@
+#include <fstream>
+
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/canonical/canonical_json_io.hh"
+#include "casm/clexmonte/run/io/json/serve_run_queue.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+/// \brief Test that pending requests are claimed once each, in order of
+///     file name, and that other files are ignored
+TEST(run_serve_run_queue_Test, ClaimTest1) {
+  test::TmpDir tmp_dir;
+  clexmonte::RunQueueDirs dirs(tmp_dir.path());
+  fs::create_directories(dirs.pending);
+  fs::create_directories(dirs.running);
+
+  for (std::string name : {"b.json", "a.json", "c.json.tmp"}) {
+    std::ofstream(dirs.pending / name) << "{}" << std::endl;
+  }
+
+  fs::path first = clexmonte::claim_run_request(dirs);
+  EXPECT_EQ(first, dirs.running / "a.json");
+  EXPECT_TRUE(fs::exists(first));
+  EXPECT_FALSE(fs::exists(dirs.pending / "a.json"));
+
+  fs::path second = clexmonte::claim_run_request(dirs);
+  EXPECT_EQ(second, dirs.running / "b.json");
+
+  // "c.json.tmp" is not a request, for instance because it is still being
+  // written
+  EXPECT_TRUE(clexmonte::claim_run_request(dirs).empty());
+  EXPECT_TRUE(fs::exists(dirs.pending / "c.json.tmp"));
+}
+
+/// \brief Test serving a queue with one valid and one invalid request
+TEST(run_serve_run_queue_Test, Test1) {
+  test::TmpDir tmp_dir;
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  fs::path clexulator_src_relpath = fs::path("basis_sets") /
+                                    "bset.formation_energy" /
+                                    "ZrO_Clexulator_formation_energy.cc";
+  fs::path eci_relpath = "formation_energy_eci.json";
+
+  fs::path test_dir = tmp_dir.path();
+  fs::create_directories(test_dir / clexulator_src_relpath.parent_path());
+  fs::copy_file(test_data_dir / clexulator_src_relpath,
+                test_dir / clexulator_src_relpath);
+  fs::copy_file(test_data_dir / eci_relpath, test_dir / eci_relpath);
+
+  jsonParser system_json(test_data_dir / "system.json");
+  system_json["basis_sets"]["formation_energy"]["source"] =
+      (test_dir / clexulator_src_relpath).string();
+  system_json["clex"]["formation_energy"]["coefficients"] =
+      (test_dir / eci_relpath).string();
+  system_json.write(test_dir / "system.json");
+
+  // a short canonical series
+  fs::path output_dir = test_dir / "output";
+  jsonParser run_params_json(test_data_dir / "run_params_complete.json");
+  jsonParser &kwargs = run_params_json["state_generation"]["kwargs"];
+  kwargs["initial_configuration"]["kwargs"]
+        ["transformation_matrix_to_supercell"] = jsonParser::parse(
+            std::string("[[2, 0, 0], [0, 2, 0], [0, 0, 2]]"));
+  kwargs["n_states"] = 2;
+  kwargs["completed_runs"]["output_dir"] = output_dir.string();
+  jsonParser &thermo = run_params_json["sampling_fixtures"]["thermo"];
+  thermo["completion_check"]["cutoff"]["count"]["max"] = 10;
+  thermo["results_io"]["kwargs"]["output_dir"] =
+      (output_dir / "thermo").string();
+
+  clexmonte::RunQueueDirs dirs(test_dir / "queue");
+  fs::create_directories(dirs.pending);
+  run_params_json.write(dirs.pending / "a.json");
+  run_params_json.erase("sampling_fixtures");
+  run_params_json.write(dirs.pending / "b.json");
+
+  clexmonte::RunQueueParams params;
+  params.exit_when_empty = true;
+  clexmonte::RunQueueSummary summary =
+      clexmonte::serve_run_queue<clexmonte::canonical::Canonical_mt19937_64>(
+          test_dir / "system.json", test_dir / "queue", params);
+
+  EXPECT_EQ(summary.n_done, 1);
+  EXPECT_EQ(summary.n_failed, 1);
+  EXPECT_TRUE(fs::exists(dirs.done / "a.json"));
+  EXPECT_TRUE(fs::exists(dirs.failed / "b.json"));
+  EXPECT_TRUE(fs::exists(dirs.failed / "b.error"));
+  EXPECT_TRUE(fs::is_empty(dirs.pending));
+  EXPECT_TRUE(fs::is_empty(dirs.running));
+
+  jsonParser completed_runs_json(output_dir / "completed_runs.json");
+  EXPECT_EQ(completed_runs_json.size(), 2);
+  EXPECT_TRUE(fs::exists(output_dir / "thermo" / "summary.json"));
+}
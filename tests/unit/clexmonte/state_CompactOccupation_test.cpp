@@ -0,0 +1,76 @@
+#include "casm/clexmonte/state/CompactOccupation.hh"
+
+#include "casm/clexmonte/state/io/json/PackedOccupation_json_io.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+/// \brief Test round trips with each number of bits per value
+TEST(state_CompactOccupation_Test, Test1) {
+  EXPECT_EQ(clexmonte::compact_bits_per_value(0), 1);
+  EXPECT_EQ(clexmonte::compact_bits_per_value(1), 1);
+  EXPECT_EQ(clexmonte::compact_bits_per_value(3), 2);
+  EXPECT_EQ(clexmonte::compact_bits_per_value(4), 4);
+  EXPECT_EQ(clexmonte::compact_bits_per_value(15), 4);
+  EXPECT_EQ(clexmonte::compact_bits_per_value(255), 8);
+
+  for (int max_value : {1, 3, 15, 255}) {
+    Eigen::VectorXi occupation(37);
+    for (Index l = 0; l < occupation.size(); ++l) {
+      occupation(l) = (7 * l + 3) % (max_value + 1);
+    }
+    clexmonte::CompactOccupation compact =
+        clexmonte::make_compact_occupation(occupation);
+    int bits_per_value = clexmonte::compact_bits_per_value(max_value);
+    EXPECT_EQ(compact.bits_per_value(), bits_per_value);
+    EXPECT_EQ(compact.size(), 37);
+    EXPECT_EQ(compact.data().size(), (37 * bits_per_value + 7) / 8);
+    EXPECT_EQ(compact.to_vector(), occupation);
+
+    // set does not modify neighboring values
+    compact.set(10, max_value);
+    occupation(10) = max_value;
+    compact.set(11, 0);
+    occupation(11) = 0;
+    EXPECT_EQ(compact.to_vector(), occupation);
+  }
+}
+
+/// \brief Test encoding compact occupations as text
+TEST(state_CompactOccupation_Test, Test2) {
+  Eigen::VectorXi occupation(100);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    occupation(l) = l % 3;
+  }
+
+  // same encoding as pack_occupation for the same bits per value
+  clexmonte::CompactOccupation compact =
+      clexmonte::make_compact_occupation(occupation);
+  int bits_per_value;
+  std::string expected = clexmonte::pack_occupation(occupation, bits_per_value);
+  EXPECT_EQ(bits_per_value, 2);
+  std::string data = clexmonte::pack_occupation(compact);
+  EXPECT_EQ(data, expected);
+  EXPECT_EQ(clexmonte::unpack_compact_occupation(data, 100, 2).to_vector(),
+            occupation);
+
+  // decoding an encoding with 3 bits per value
+  occupation(0) = 5;
+  data = clexmonte::pack_occupation(occupation, bits_per_value);
+  EXPECT_EQ(bits_per_value, 3);
+  clexmonte::CompactOccupation decoded =
+      clexmonte::unpack_compact_occupation(data, 100, bits_per_value);
+  EXPECT_EQ(decoded.bits_per_value(), 4);
+  EXPECT_EQ(decoded.to_vector(), occupation);
+}
+
+/// \brief Test invalid input
+TEST(state_CompactOccupation_Test, Test3) {
+  EXPECT_THROW(clexmonte::CompactOccupation(10, 3), std::runtime_error);
+  Eigen::VectorXi occupation = Eigen::VectorXi::Constant(4, 4);
+  EXPECT_THROW(clexmonte::make_compact_occupation(occupation, 2),
+               std::runtime_error);
+  occupation(0) = -1;
+  EXPECT_THROW(clexmonte::make_compact_occupation(occupation),
+               std::runtime_error);
+}
@@ -0,0 +1,80 @@
+#include "casm/clexmonte/state/ConfigurationSnapshot.hh"
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+class state_ConfigurationSnapshot_Test : public test::ZrOTestSystem {};
+
+/// \brief Test that snapshots share unchanged blocks, found by comparison,
+///     and are not modified by later changes of the configuration
+TEST_F(state_ConfigurationSnapshot_Test, Test1) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  state_type state(make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  Index n_sites = occupation.size();
+  Index block_size = 16;
+  Index n_blocks = (n_sites + block_size - 1) / block_size;
+
+  ConfigurationSnapshotter snapshotter(block_size);
+  auto first = snapshotter.take(state.configuration);
+  EXPECT_EQ(snapshotter.n_blocks_copied(), n_blocks);
+  EXPECT_EQ(snapshotter.n_blocks_shared(), 0);
+  Eigen::VectorXi first_occupation = occupation;
+
+  // change a site in the last block of O/Va sites
+  occupation(n_sites - 1) = 1;
+  auto second = snapshotter.take(state.configuration);
+  EXPECT_EQ(snapshotter.n_blocks_copied(), n_blocks + 1);
+  EXPECT_EQ(snapshotter.n_blocks_shared(), n_blocks - 1);
+  EXPECT_EQ(first->occupation_blocks[0], second->occupation_blocks[0]);
+  EXPECT_NE(first->occupation_blocks.back(), second->occupation_blocks.back());
+
+  EXPECT_EQ(first->occupation(), first_occupation);
+  EXPECT_EQ(second->occupation(), occupation);
+  Configuration config = second->configuration();
+  EXPECT_EQ(config.supercell, state.configuration.supercell);
+  EXPECT_EQ(config.dof_values.occupation, occupation);
+}
+
+/// \brief Test that with modification tracking only marked blocks are
+///     copied
+TEST_F(state_ConfigurationSnapshot_Test, Test2) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  state_type state(make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  Index n_sites = occupation.size();
+  Index block_size = 16;
+  Index n_blocks = (n_sites + block_size - 1) / block_size;
+
+  ConfigurationSnapshotter snapshotter(block_size, true);
+  EXPECT_EQ(snapshotter.record(state.configuration), 0);
+
+  monte::OccEvent event;
+  event.linear_site_index = {n_sites - 1, n_sites - 2};
+  event.new_occ = {1, 1};
+  occupation(n_sites - 1) = 1;
+  occupation(n_sites - 2) = 1;
+  snapshotter.mark_modified(event);
+  EXPECT_EQ(snapshotter.record(state.configuration), 1);
+  EXPECT_EQ(snapshotter.n_blocks_copied(), n_blocks + 1);
+  EXPECT_EQ(snapshotter.snapshots()[1]->occupation(), occupation);
+
+  // unmarked changes are not seen until mark_all_modified
+  occupation(0) = 1;
+  snapshotter.record(state.configuration);
+  EXPECT_NE(snapshotter.snapshots()[2]->occupation(), occupation);
+  snapshotter.mark_all_modified();
+  snapshotter.record(state.configuration);
+  EXPECT_EQ(snapshotter.snapshots()[3]->occupation(), occupation);
+  EXPECT_EQ(snapshotter.n_blocks_copied(), 2 * n_blocks + 1);
+
+  snapshotter.reset();
+  EXPECT_EQ(snapshotter.snapshots().size(), 0);
+}
@@ -0,0 +1,100 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/CorrMatchingPotential.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+class state_CorrMatchingPotential_Test : public test::ZrOTestSystem {};
+
+/// \brief Test that CorrMatchingPotentialCalculator matches
+///     corr_matching_potential, for a sequence of applied single site changes
+TEST_F(state_CorrMatchingPotential_Test, Test1) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  Index volume = T.determinant();
+  state_type state(make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+
+  std::shared_ptr<clexulator::Correlations> correlations =
+      get_corr(*system, state, "formation_energy");
+  auto corr_f = [&]() -> Eigen::VectorXd {
+    return correlations->per_unitcell(correlations->per_supercell());
+  };
+
+  // the first two targets match the initial correlations exactly
+  Eigen::VectorXd initial_corr = corr_f();
+  ASSERT_GE(initial_corr.size(), 4);
+  CorrMatchingParams params(
+      1.0,
+      {CorrMatchingTarget(0, initial_corr(0), 1.0),
+       CorrMatchingTarget(1, initial_corr(1), 2.0),
+       CorrMatchingTarget(3, initial_corr(3) + 0.1, 0.5)},
+      CASM::TOL);
+  CorrMatchingPotentialCalculator calculator(params, correlations, volume);
+  EXPECT_EQ(calculator.n_exact(), 2);
+  EXPECT_NEAR(calculator.value(), corr_matching_potential(initial_corr, params),
+              1e-10);
+
+  // O/Va sites are the last 2 * volume sites
+  monte::OccEvent event;
+  event.linear_site_index.resize(1);
+  event.new_occ.resize(1);
+  for (Index i = 0; i < 2 * volume; i += 3) {
+    Index l = 2 * volume + i;
+    event.linear_site_index[0] = l;
+    event.new_occ[0] = 1 - occupation(l);
+
+    double value_before = corr_matching_potential(corr_f(), params);
+    double delta =
+        calculator.occ_delta(event.linear_site_index, event.new_occ);
+    calculator.apply(event);
+    occupation(l) = event.new_occ[0];
+    double value_after = corr_matching_potential(corr_f(), params);
+
+    EXPECT_NEAR(delta, value_after - value_before, 1e-10);
+    EXPECT_NEAR(calculator.value(), value_after, 1e-10);
+  }
+}
+
+/// \brief Test that out of range target indices are rejected at construction
+TEST_F(state_CorrMatchingPotential_Test, Test2) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  state_type state(make_default_configuration(*system, T));
+  std::shared_ptr<clexulator::Correlations> correlations =
+      get_corr(*system, state, "formation_energy");
+  Index corr_size = correlations->per_supercell().size();
+
+  CorrMatchingParams params(1.0, {CorrMatchingTarget(corr_size, 0.0, 1.0)},
+                            CASM::TOL);
+  EXPECT_THROW(CorrMatchingPotentialCalculator(params, correlations,
+                                               T.determinant()),
+               std::runtime_error);
+}
+
+/// \brief Test that make_memoized_corr_f only calculates each distinct
+///     sublattice_prob once, and that copies share the cache
+TEST(state_CorrMatchingPotential_MemoizeTest, Test1) {
+  using namespace clexmonte;
+
+  Index n_calls = 0;
+  CorrCalculatorFunction corr_f =
+      [&](std::vector<Eigen::VectorXd> const &sublattice_prob) {
+        ++n_calls;
+        return Eigen::VectorXd(sublattice_prob[0]);
+      };
+  CorrCalculatorFunction memoized_f = make_memoized_corr_f(corr_f);
+  CorrCalculatorFunction memoized_f_copy = memoized_f;
+
+  std::vector<Eigen::VectorXd> prob_a = {Eigen::Vector2d(0.25, 0.75)};
+  std::vector<Eigen::VectorXd> prob_b = {Eigen::Vector2d(0.5, 0.5)};
+  EXPECT_TRUE(memoized_f(prob_a).isApprox(prob_a[0]));
+  EXPECT_TRUE(memoized_f_copy(prob_a).isApprox(prob_a[0]));
+  EXPECT_EQ(n_calls, 1);
+  EXPECT_TRUE(memoized_f(prob_b).isApprox(prob_b[0]));
+  EXPECT_EQ(n_calls, 2);
+}
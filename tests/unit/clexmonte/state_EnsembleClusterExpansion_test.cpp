@@ -0,0 +1,162 @@
+#include <random>
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/state/ClexTrackers.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/EnsembleClusterExpansion.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "gtest/gtest.h"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::monte;
+using namespace CASM::clexmonte;
+
+class state_EnsembleClusterExpansion_Test : public ZrOTestSystem {
+ public:
+  state_EnsembleClusterExpansion_Test()
+      : T(Eigen::Matrix3l::Identity() * 4),
+        volume(T.determinant()),
+        state(make_default_configuration(*system, T)) {
+    // an ensemble of 3 coefficient sets for the formation energy basis set
+    ClexData const &clex_data = get_clex_data(*system, "formation_energy");
+    MultiClexData multiclex_data;
+    multiclex_data.basis_set_name = clex_data.basis_set_name;
+    multiclex_data.cluster_info = clex_data.cluster_info;
+    for (double scale : {1.0, 0.5, -2.0}) {
+      clexulator::SparseCoefficients coefficients = clex_data.coefficients;
+      for (double &value : coefficients.value) {
+        value *= scale;
+      }
+      multiclex_data.coefficients.push_back(coefficients);
+    }
+    multiclex_data.coefficients[2].value[0] += 1.0;
+    system->multiclex_data.emplace("formation_energy_ensemble",
+                                   multiclex_data);
+
+    // occupy half of the O sites
+    for (Index l = 0; l < volume; ++l) {
+      get_occupation(state)(2 * volume + 2 * l) = 1;
+    }
+    multiclex = get_multiclex(*system, state, "formation_energy_ensemble");
+  }
+
+  /// \brief Make a random swap of an O and a Va on the O sublattices
+  OccEvent make_random_swap(std::mt19937_64 &engine) {
+    Eigen::VectorXi const &occupation = get_occupation(state);
+    std::uniform_int_distribution<Index> dist(2 * volume, 4 * volume - 1);
+    Index l_O;
+    Index l_Va;
+    do {
+      l_O = dist(engine);
+    } while (occupation(l_O) != 1);
+    do {
+      l_Va = dist(engine);
+    } while (occupation(l_Va) != 0);
+    OccEvent event;
+    event.linear_site_index = {l_O, l_Va};
+    event.new_occ = {0, 1};
+    return event;
+  }
+
+  /// \brief Apply an event to the configuration
+  void apply(OccEvent const &event) {
+    for (Index i = 0; i < Index(event.linear_site_index.size()); ++i) {
+      get_occupation(state)(event.linear_site_index[i]) = event.new_occ[i];
+    }
+  }
+
+  Eigen::Matrix3l T;
+  Index volume;
+  state_type state;
+  std::shared_ptr<clexulator::MultiClusterExpansion> multiclex;
+};
+
+/// \brief Test that the incremental change of the selected member, or the
+///     mean, and of all members, equals the difference of two full
+///     evaluations
+TEST_F(state_EnsembleClusterExpansion_Test, DeltaTest1) {
+  for (Index member : {Index(-1), Index(0), Index(2)}) {
+    EnsembleClusterExpansion ensemble(multiclex, member);
+    EXPECT_EQ(ensemble.n_members(), 3);
+
+    std::mt19937_64 engine(42 + member);
+    for (Index i = 0; i < 50; ++i) {
+      OccEvent event = make_random_swap(engine);
+      double delta =
+          ensemble.occ_delta_value(event.linear_site_index, event.new_occ);
+      Eigen::VectorXd delta_all = ensemble.occ_delta_values(event);
+
+      double value_init = ensemble.per_supercell();
+      Eigen::VectorXd values_init = multiclex->per_supercell();
+      apply(event);
+      ensemble.invalidate();
+      double value_final = ensemble.per_supercell();
+      Eigen::VectorXd values_final = multiclex->per_supercell();
+
+      EXPECT_NEAR(delta, value_final - value_init, 1e-8);
+      ASSERT_EQ(delta_all.size(), 3);
+      for (Index j = 0; j < 3; ++j) {
+        EXPECT_NEAR(delta_all(j), values_final(j) - values_init(j), 1e-8);
+      }
+      if (member == -1) {
+        EXPECT_NEAR(value_final, values_final.mean(), 1e-8);
+      } else {
+        EXPECT_NEAR(value_final, values_final(member), 1e-8);
+      }
+    }
+  }
+}
+
+/// \brief Test that the changes kept from the potential evaluation are
+///     reused only for the same event in the same configuration
+TEST_F(state_EnsembleClusterExpansion_Test, DeltaTest2) {
+  EnsembleClusterExpansion ensemble(multiclex, -1);
+  std::mt19937_64 engine(42);
+  OccEvent event = make_random_swap(engine);
+  ensemble.occ_delta_value(event.linear_site_index, event.new_occ);
+  Eigen::VectorXd delta_forward = ensemble.occ_delta_values(event);
+
+  // after the configuration changes, the reverse of the event is evaluated
+  apply(event);
+  ensemble.invalidate();
+  OccEvent reverse = event;
+  reverse.new_occ = {1, 0};
+  Eigen::VectorXd delta_reverse = ensemble.occ_delta_values(reverse);
+  for (Index j = 0; j < 3; ++j) {
+    EXPECT_NEAR(delta_reverse(j), -delta_forward(j), 1e-8);
+  }
+
+  EXPECT_THROW(EnsembleClusterExpansion(multiclex, 3), std::runtime_error);
+  EXPECT_THROW(EnsembleClusterExpansion(multiclex, -2), std::runtime_error);
+}
+
+/// \brief Test that tracked values, incremented by the changes reused from
+///     the potential evaluation, equal a full evaluation
+TEST_F(state_EnsembleClusterExpansion_Test, TrackerTest1) {
+  EnsembleClusterExpansion ensemble(multiclex, 0);
+  MultiClusterExpansionTracker tracker(
+      multiclex, volume, 0 /*reset_interval*/,
+      [&](OccEvent const &event) -> Eigen::VectorXd const & {
+        return ensemble.occ_delta_values(event);
+      });
+
+  std::mt19937_64 engine(42);
+  for (Index i = 0; i < 100; ++i) {
+    OccEvent event = make_random_swap(engine);
+    ensemble.occ_delta_value(event.linear_site_index, event.new_occ);
+    if (i % 3 == 0) {
+      // rejected
+      continue;
+    }
+    tracker.apply(event);
+    apply(event);
+    ensemble.invalidate();
+  }
+  Eigen::VectorXd expected = multiclex->per_supercell();
+  Eigen::VectorXd tracked = tracker.per_supercell();
+  ASSERT_EQ(tracked.size(), 3);
+  for (Index j = 0; j < 3; ++j) {
+    EXPECT_NEAR(tracked(j), expected(j), 1e-8);
+  }
+}
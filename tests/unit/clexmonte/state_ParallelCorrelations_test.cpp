@@ -0,0 +1,57 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/ParallelCorrelations.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+class state_ParallelCorrelations_Test : public test::ZrOTestSystem {};
+
+/// \brief Test that ParallelCorrelations matches Correlations, and that
+///     results do not depend on the number of threads
+TEST_F(state_ParallelCorrelations_Test, Test1) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 6;
+  Index volume = T.determinant();
+  state_type state(make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  // O/Va sites are the last 2 * volume sites
+  for (Index i = 0; i < 2 * volume; i += 3) {
+    occupation(2 * volume + i) = 1;
+  }
+
+  std::shared_ptr<clexulator::Correlations> correlations =
+      get_corr(*system, state, "formation_energy");
+  Eigen::VectorXd expected = correlations->per_supercell();
+
+  auto supercell_neighbor_list = get_supercell_neighbor_list(*system, state);
+  auto clexulator = get_basis_set(*system, "formation_energy");
+  auto const &coefficients =
+      get_clex_data(*system, "formation_energy").coefficients;
+  double expected_value = 0.0;
+  for (Index k = 0; k < coefficients.index.size(); ++k) {
+    expected_value += coefficients.value[k] * expected(coefficients.index[k]);
+  }
+
+  Eigen::VectorXd first;
+  for (Index n_threads : {1, 2, 3, 4}) {
+    ParallelCorrelations parallel_corr(supercell_neighbor_list, *clexulator,
+                                       &get_dof_values(state), n_threads,
+                                       10);
+    EXPECT_EQ(parallel_corr.n_threads(), n_threads);
+    Eigen::VectorXd corr = parallel_corr.per_supercell();
+    EXPECT_TRUE(almost_equal(corr, expected, 1e-10));
+    EXPECT_TRUE(almost_equal(parallel_corr.per_unitcell(),
+                             Eigen::VectorXd(expected / volume), 1e-10));
+    EXPECT_NEAR(parallel_corr.per_supercell(coefficients), expected_value,
+                1e-10);
+    if (n_threads == 1) {
+      first = corr;
+    } else {
+      EXPECT_EQ(corr, first);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/ParamCompQuadPotential.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+class state_ParamCompQuadPotential_Test : public test::ZrOTestSystem {};
+
+/// \brief Test that occ_delta_per_supercell matches the difference in
+///     per_supercell values, for a sequence of single site changes
+TEST_F(state_ParamCompQuadPotential_Test, Test1) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  Index volume = T.determinant();
+  state_type state(make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+
+  monte::ValueMap conditions;
+  conditions.vector_values["param_comp_quad_pot_target"] =
+      Eigen::VectorXd::Constant(1, 0.3);
+  conditions.matrix_values["param_comp_quad_pot_matrix"] =
+      Eigen::MatrixXd::Constant(1, 1, 2.0);
+
+  auto const &composition_calculator = get_composition_calculator(*system);
+  auto const &composition_converter = get_composition_converter(*system);
+  auto const &convert = get_index_conversions(*system, state);
+  std::optional<ParamCompQuadPotential> potential =
+      ParamCompQuadPotential::from_conditions(
+          conditions, composition_calculator, composition_converter, convert);
+  ASSERT_TRUE(potential.has_value());
+
+  // O/Va sites are the last 2 * volume sites
+  std::vector<Index> linear_site_index(1);
+  std::vector<int> new_occ(1);
+  for (Index i = 0; i < 2 * volume; i += 3) {
+    Index l = 2 * volume + i;
+    linear_site_index[0] = l;
+    new_occ[0] = 1 - occupation(l);
+
+    Eigen::VectorXd before =
+        composition_calculator.mean_num_each_component(occupation);
+    double delta = potential->occ_delta_per_supercell(before, occupation,
+                                                      linear_site_index,
+                                                      new_occ);
+    double value_before = potential->per_supercell(before);
+
+    occupation(l) = new_occ[0];
+    Eigen::VectorXd after =
+        composition_calculator.mean_num_each_component(occupation);
+    double value_after = potential->per_supercell(after);
+
+    EXPECT_NEAR(delta, value_after - value_before, 1e-10);
+  }
+
+  // No change in species
+  linear_site_index[0] = 2 * volume;
+  new_occ[0] = occupation(2 * volume);
+  Eigen::VectorXd current =
+      composition_calculator.mean_num_each_component(occupation);
+  EXPECT_EQ(potential->occ_delta_per_supercell(current, occupation,
+                                               linear_site_index, new_occ),
+            0.0);
+}
+
+/// \brief Test that no potential is constructed without coefficients
+TEST_F(state_ParamCompQuadPotential_Test, Test2) {
+  using namespace clexmonte;
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  state_type state(make_default_configuration(*system, T));
+
+  monte::ValueMap conditions;
+  conditions.vector_values["param_comp_quad_pot_target"] =
+      Eigen::VectorXd::Constant(1, 0.3);
+  EXPECT_FALSE(ParamCompQuadPotential::from_conditions(
+                   conditions, get_composition_calculator(*system),
+                   get_composition_converter(*system),
+                   get_index_conversions(*system, state))
+                   .has_value());
+}
@@ -0,0 +1,212 @@
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/system/ClexulatorCache.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+void write_file(fs::path const &path, std::string const &contents) {
+  fs::create_directories(path.parent_path());
+  std::ofstream(path) << contents;
+}
+
+/// \brief Write a fake clexulator source directory
+fs::path make_source(fs::path const &dir, std::string const &contents) {
+  fs::path source = dir / "bset.default" / "Test_Clexulator_default.cc";
+  write_file(source, contents);
+  write_file(dir / "bset.default" / "basis.json", "{}");
+  return source;
+}
+
+/// \brief Number of cache entry directories
+Index count_entries(fs::path const &cache_dir) {
+  Index n = 0;
+  for (auto const &entry : fs::directory_iterator(cache_dir)) {
+    if (entry.is_directory()) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+/// \brief Compiled clexulator files in the cache entry directories
+std::vector<fs::path> compiled_files(fs::path const &cache_dir) {
+  std::vector<fs::path> files;
+  for (auto const &entry : fs::recursive_directory_iterator(cache_dir)) {
+    std::string ext = entry.path().extension().string();
+    if (ext == ".so" || ext == ".dylib") {
+      files.push_back(entry.path());
+    }
+  }
+  return files;
+}
+
+}  // namespace
+
+/// \brief Test that the same source, input, and compiler options hit the
+///     same cache entry, and that a change to any of them misses
+TEST(system_ClexulatorCache_Test, Test1) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path cache_dir = tmp_dir.path() / "cache";
+  ClexulatorCache cache(cache_dir);
+
+  fs::path source = make_source(tmp_dir.path() / "a", "// version 1");
+  fs::path entry_source;
+  {
+    ClexulatorCache::Entry entry = cache.acquire(source, "{}");
+    entry_source = entry.source;
+    EXPECT_EQ(entry_source.filename(), source.filename());
+    EXPECT_TRUE(fs::exists(entry_source));
+    EXPECT_TRUE(fs::exists(entry_source.parent_path() / "basis.json"));
+    EXPECT_EQ(entry_source.parent_path().parent_path(), cache_dir);
+    // as if compiled while the lock is held
+    write_file(entry_source.parent_path() / "Test_Clexulator_default.so", "");
+  }
+  EXPECT_EQ(count_entries(cache_dir), 1);
+
+  // hit: same contents in another directory, ignoring compiled files
+  fs::path same = make_source(tmp_dir.path() / "b", "// version 1");
+  write_file(same.parent_path() / "Test_Clexulator_default.o", "");
+  EXPECT_EQ(cache.acquire(same, "{}").source, entry_source);
+  EXPECT_TRUE(
+      fs::exists(entry_source.parent_path() / "Test_Clexulator_default.so"));
+  EXPECT_EQ(count_entries(cache_dir), 1);
+
+  // misses: source contents, basis set input, compiler options
+  fs::path changed = make_source(tmp_dir.path() / "c", "// version 2");
+  EXPECT_NE(cache.acquire(changed, "{}").source, entry_source);
+  EXPECT_EQ(count_entries(cache_dir), 2);
+
+  EXPECT_NE(cache.acquire(source, "{\"a\": 1}").source, entry_source);
+  EXPECT_EQ(count_entries(cache_dir), 3);
+
+  char const *cxxflags = std::getenv("CASM_CXXFLAGS");
+  std::optional<std::string> original;
+  if (cxxflags != nullptr) {
+    original = cxxflags;
+  }
+  setenv("CASM_CXXFLAGS", "-O0 -fPIC --std=c++17 -DCACHE_TEST", 1);
+  fs::path flags_source = cache.acquire(source, "{}").source;
+  if (original.has_value()) {
+    setenv("CASM_CXXFLAGS", original->c_str(), 1);
+  } else {
+    unsetenv("CASM_CXXFLAGS");
+  }
+  EXPECT_NE(flags_source, entry_source);
+  EXPECT_EQ(count_entries(cache_dir), 4);
+
+  // hit again, after restoring the compiler options
+  EXPECT_EQ(cache.acquire(source, "{}").source, entry_source);
+  EXPECT_EQ(count_entries(cache_dir), 4);
+}
+
+/// \brief Test that a partially populated entry is re-populated, and that
+///     concurrent acquisitions of one entry populate and "compile" once
+TEST(system_ClexulatorCache_Test, Test2) {
+  using namespace clexmonte;
+  test::TmpDir tmp_dir;
+  fs::path cache_dir = tmp_dir.path() / "cache";
+  ClexulatorCache cache(cache_dir);
+  fs::path source = make_source(tmp_dir.path() / "a", "// version 1");
+
+  // an entry left by an interrupted job, without the populated marker
+  fs::path entry_dir = cache.acquire(source, "{}").source.parent_path();
+  fs::remove(entry_dir / ".populated");
+  fs::remove(entry_dir / "basis.json");
+  write_file(entry_dir / "partial", "");
+  EXPECT_EQ(cache.acquire(source, "{}").source.parent_path(), entry_dir);
+  EXPECT_TRUE(fs::exists(entry_dir / "basis.json"));
+  EXPECT_FALSE(fs::exists(entry_dir / "partial"));
+
+  // concurrent jobs: only the first to hold the lock "compiles"
+  fs::remove_all(cache_dir);
+  Index n_threads = 8;
+  std::vector<Index> n_compiled(n_threads, 0);
+  std::vector<std::thread> threads;
+  for (Index i = 0; i < n_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      ClexulatorCache::Entry entry = cache.acquire(source, "{}");
+      fs::path compiled = entry.source.parent_path() / "compiled.so";
+      if (!fs::exists(compiled)) {
+        write_file(compiled, "");
+        n_compiled[i] = 1;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  Index total = 0;
+  for (Index n : n_compiled) {
+    total += n;
+  }
+  EXPECT_EQ(total, 1);
+  EXPECT_EQ(count_entries(cache_dir), 1);
+}
+
+/// \brief Test the cache directory given by input or environment variable
+TEST(system_ClexulatorCache_Test, DefaultDirTest1) {
+  using namespace clexmonte;
+  char const *value = std::getenv("CASM_CLEXULATOR_CACHE_DIR");
+  std::optional<std::string> original;
+  if (value != nullptr) {
+    original = value;
+  }
+
+  unsetenv("CASM_CLEXULATOR_CACHE_DIR");
+  EXPECT_FALSE(default_clexulator_cache_dir(std::nullopt).has_value());
+  EXPECT_EQ(default_clexulator_cache_dir(std::string("input")),
+            fs::path("input"));
+
+  setenv("CASM_CLEXULATOR_CACHE_DIR", "env", 1);
+  EXPECT_EQ(default_clexulator_cache_dir(std::nullopt), fs::path("env"));
+  EXPECT_EQ(default_clexulator_cache_dir(std::string("input")),
+            fs::path("input"));
+
+  if (original.has_value()) {
+    setenv("CASM_CLEXULATOR_CACHE_DIR", original->c_str(), 1);
+  } else {
+    unsetenv("CASM_CLEXULATOR_CACHE_DIR");
+  }
+}
+
+class system_ClexulatorCache_SystemTest : public test::ZrOTestSystem {
+ public:
+  system_ClexulatorCache_SystemTest()
+      : test::ZrOTestSystem(
+            "ZrOTestSystem_ClexulatorCache",
+            test::data_dir("clexmonte") / "ZrOTestSystem" / "system.json") {
+    set_clex("formation_energy", "formation_energy",
+             "formation_energy_eci.json");
+  }
+};
+
+/// \brief Test that the System compiles a clexulator in the cache once, and
+///     loads it from the cache when constructed again
+TEST_F(system_ClexulatorCache_SystemTest, Test1) {
+  test::TmpDir tmp_dir;
+  fs::path cache_dir = tmp_dir.path() / "cache";
+  system_json["clexulator_cache_dir"] = cache_dir.string();
+
+  make_system();
+  ASSERT_TRUE(system != nullptr);
+  EXPECT_EQ(system->basis_sets.size(), 1);
+  EXPECT_EQ(count_entries(cache_dir), 1);
+  std::vector<fs::path> compiled = compiled_files(cache_dir);
+  ASSERT_EQ(compiled.size(), 1);
+  auto compile_time = fs::last_write_time(compiled[0]);
+
+  system.reset();
+  make_system();
+  ASSERT_TRUE(system != nullptr);
+  EXPECT_EQ(count_entries(cache_dir), 1);
+  ASSERT_EQ(compiled_files(cache_dir), compiled);
+  EXPECT_EQ(fs::last_write_time(compiled[0]), compile_time);
+}
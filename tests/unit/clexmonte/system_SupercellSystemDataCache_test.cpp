@@ -0,0 +1,249 @@
+#include <thread>
+
+#include "ZrOTestSystem.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "gtest/gtest.h"
+
+using namespace test;
+using namespace CASM;
+using namespace CASM::clexmonte;
+
+namespace {
+
+/// \brief Supercells with distinct lattices
+std::vector<Eigen::Matrix3l> make_supercells() {
+  std::vector<Eigen::Matrix3l> supercells;
+  for (Eigen::Vector3l diagonal : {Eigen::Vector3l(2, 2, 2),
+                                   Eigen::Vector3l(3, 3, 3),
+                                   Eigen::Vector3l(2, 2, 4),
+                                   Eigen::Vector3l(4, 2, 2)}) {
+    supercells.push_back(diagonal.asDiagonal());
+  }
+  return supercells;
+}
+
+/// \brief True if two supercells have the same site ordering
+bool is_same_site_order(System const &system, Eigen::Matrix3l const &T_a,
+                        Eigen::Matrix3l const &T_b) {
+  monte::Conversions convert_a(*system.prim->basicstructure, T_a);
+  monte::Conversions convert_b(*system.prim->basicstructure, T_b);
+  if (convert_a.l_size() != convert_b.l_size()) {
+    return false;
+  }
+  for (Index l = 0; l < convert_a.l_size(); ++l) {
+    xtal::UnitCellCoord const &bijk_a = convert_a.l_to_bijk(l);
+    xtal::UnitCellCoord const &bijk_b = convert_b.l_to_bijk(l);
+    if (bijk_a.sublattice() != bijk_b.sublattice() ||
+        bijk_a.unitcell() != bijk_b.unitcell()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Number of SupercellSystemData constructed, from the startup
+///     timings
+Index n_supercell_data_constructed(System const &system) {
+  for (auto const &pair : system.startup_timings.entries()) {
+    if (pair.first == "supercell_data") {
+      return pair.second.n_calls;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+class system_SupercellSystemDataCache_Test : public ZrOTestSystem {};
+
+/// \brief Test that concurrent threads sharing one System get the same
+///     SupercellSystemData, and the same lazily constructed calculators,
+///     which are constructed once
+TEST_F(system_SupercellSystemDataCache_Test, ConcurrencyTest1) {
+  std::vector<Eigen::Matrix3l> supercells = make_supercells();
+  Index n_supercells = supercells.size();
+  std::vector<state_type> states;
+  for (auto const &T : supercells) {
+    states.emplace_back(make_default_configuration(*system, T));
+  }
+
+  Index n_threads = 8;
+  std::vector<std::vector<std::shared_ptr<SupercellSystemData>>> data(
+      n_threads,
+      std::vector<std::shared_ptr<SupercellSystemData>>(n_supercells));
+  std::vector<std::vector<std::shared_ptr<clexulator::ClusterExpansion>>> clex(
+      n_threads,
+      std::vector<std::shared_ptr<clexulator::ClusterExpansion>>(n_supercells));
+  std::vector<std::thread> threads;
+  for (Index i = 0; i < n_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      // each thread visits the supercells in a different order
+      for (Index k = 0; k < n_supercells; ++k) {
+        Index j = (i + k) % n_supercells;
+        data[i][j] = get_shared_supercell_data(*system, states[j]);
+        clex[i][j] = data[i][j]->clex("formation_energy");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(system->supercell_data.size(), n_supercells);
+  for (Index j = 0; j < n_supercells; ++j) {
+    ASSERT_TRUE(data[0][j] != nullptr);
+    EXPECT_EQ(data[0][j]->convert.transformation_matrix_to_super(),
+              supercells[j]);
+    EXPECT_EQ(data[0][j], system->supercell_data.find(supercells[j]));
+    ASSERT_TRUE(clex[0][j] != nullptr);
+    for (Index i = 1; i < n_threads; ++i) {
+      EXPECT_EQ(data[i][j], data[0][j]);
+      EXPECT_EQ(clex[i][j], clex[0][j]);
+    }
+  }
+}
+
+/// \brief Test that least recently used entries are evicted to stay within
+///     `max_size_in_bytes`
+TEST_F(system_SupercellSystemDataCache_Test, EvictionTest1) {
+  std::vector<Eigen::Matrix3l> supercells = make_supercells();
+  Eigen::Matrix3l const &A = supercells[0];
+  Eigen::Matrix3l const &B = supercells[1];
+  Eigen::Matrix3l const &C = supercells[2];
+  Eigen::Matrix3l const &D = supercells[3];
+
+  SupercellSystemDataCache cache;
+  EXPECT_FALSE(cache.max_size_in_bytes().has_value());
+  Index size_A = cache.get_or_make(*system, A)->size_in_bytes();
+  Index size_B = cache.get_or_make(*system, B)->size_in_bytes();
+  Index size_C = cache.get_or_make(*system, C)->size_in_bytes();
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.size_in_bytes(), size_A + size_B + size_C);
+
+  // setting the limit evicts the least recently used entry, A
+  cache.set_max_size_in_bytes(size_B + size_C);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.find(A) == nullptr);
+  EXPECT_EQ(cache.size_in_bytes(), size_B + size_C);
+
+  // after using B, adding D (the same size as C) evicts C
+  cache.get_or_make(*system, B);
+  Index size_D = cache.get_or_make(*system, D)->size_in_bytes();
+  EXPECT_EQ(size_D, size_C);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.find(C) == nullptr);
+  EXPECT_TRUE(cache.find(B) != nullptr);
+  EXPECT_TRUE(cache.find(D) != nullptr);
+
+  // an evicted entry is re-constructed on its next use
+  EXPECT_TRUE(cache.get_or_make(*system, A) != nullptr);
+  EXPECT_TRUE(cache.find(A) != nullptr);
+  EXPECT_LE(cache.size_in_bytes(), size_B + size_C);
+
+  EXPECT_THROW(cache.set_max_size_in_bytes(-1), std::runtime_error);
+  cache.set_max_size_in_bytes(std::nullopt);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.size_in_bytes(), 0);
+}
+
+/// \brief Test that the most recently used entry, and entries held outside
+///     the cache, are not evicted, and that the supercell neighbor list is
+///     counted once constructed
+TEST_F(system_SupercellSystemDataCache_Test, EvictionTest2) {
+  std::vector<Eigen::Matrix3l> supercells = make_supercells();
+  Eigen::Matrix3l const &A = supercells[0];
+  Eigen::Matrix3l const &B = supercells[1];
+  Eigen::Matrix3l const &C = supercells[2];
+
+  SupercellSystemDataCache cache;
+  std::shared_ptr<SupercellSystemData> held = cache.get_or_make(*system, A);
+  cache.get_or_make(*system, B);
+  cache.get_or_make(*system, C);
+
+  cache.set_max_size_in_bytes(0);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.find(A), held);
+  EXPECT_TRUE(cache.find(B) == nullptr);
+  EXPECT_TRUE(cache.find(C) != nullptr);
+
+  // once released, the held entry is evicted by the next eviction
+  held.reset();
+  cache.set_max_size_in_bytes(0);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_TRUE(cache.find(A) == nullptr);
+
+  // the neighbor list is counted once constructed
+  cache.set_max_size_in_bytes(std::nullopt);
+  std::shared_ptr<SupercellSystemData> data = cache.get_or_make(*system, C);
+  Index size_before = data->size_in_bytes();
+  EXPECT_TRUE(data->supercell_neighbor_list() != nullptr);
+  EXPECT_GT(data->size_in_bytes(), size_before);
+  EXPECT_EQ(cache.size_in_bytes(), data->size_in_bytes());
+
+  // copies have the same limit, and are empty
+  cache.set_max_size_in_bytes(1000000);
+  SupercellSystemDataCache copy(cache);
+  EXPECT_EQ(copy.max_size_in_bytes(), cache.max_size_in_bytes());
+  EXPECT_EQ(copy.size(), 0);
+
+  // clearing the System cache leaves held entries valid
+  std::shared_ptr<SupercellSystemData> system_data =
+      system->supercell_data.get_or_make(*system, B);
+  clear_supercell_data(*system);
+  EXPECT_EQ(system->supercell_data.size(), 0);
+  EXPECT_EQ(system_data->convert.transformation_matrix_to_super(), B);
+}
+
+/// \brief Test that a supercell with the same lattice and site ordering as
+///     an existing entry shares it, without constructing SupercellSystemData,
+///     and that other supercells with the same lattice get their own entry
+TEST_F(system_SupercellSystemDataCache_Test, AliasTest1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 2;
+  Eigen::Matrix3l cyclic;
+  cyclic << 0, 0, 1, 1, 0, 0, 0, 1, 0;
+  Eigen::Matrix3l shear;
+  shear << 1, 1, 0, 0, 1, 0, 0, 0, 1;
+  std::vector<Eigen::Matrix3l> same_lattice = {T * cyclic,
+                                               T * cyclic * cyclic, T * shear,
+                                               T * shear.transpose()};
+
+  SupercellSystemDataCache cache;
+  Index n_constructed = n_supercell_data_constructed(*system);
+  std::shared_ptr<SupercellSystemData> data = cache.get_or_make(*system, T);
+  EXPECT_EQ(n_supercell_data_constructed(*system), n_constructed + 1);
+
+  Index n_aliased = 0;
+  for (Eigen::Matrix3l const &T_b : same_lattice) {
+    n_constructed = n_supercell_data_constructed(*system);
+    std::shared_ptr<SupercellSystemData> data_b =
+        cache.get_or_make(*system, T_b);
+    if (is_same_site_order(*system, T, T_b)) {
+      ++n_aliased;
+      EXPECT_EQ(data_b, data);
+      EXPECT_EQ(n_supercell_data_constructed(*system), n_constructed);
+    } else {
+      EXPECT_NE(data_b, data);
+      EXPECT_EQ(data_b->convert.transformation_matrix_to_super(), T_b);
+      EXPECT_EQ(n_supercell_data_constructed(*system), n_constructed + 1);
+    }
+    EXPECT_EQ(cache.find(T_b), data_b);
+    // an alias is a cache hit
+    EXPECT_EQ(cache.get_or_make(*system, T_b), data_b);
+    EXPECT_EQ(n_supercell_data_constructed(*system),
+              n_constructed + (data_b == data ? 0 : 1));
+  }
+  EXPECT_GT(n_aliased, 0);
+  EXPECT_EQ(cache.size(), 1 + Index(same_lattice.size()) - n_aliased);
+
+  // aliases are removed with their entry
+  Eigen::Matrix3l other = Eigen::Matrix3l::Identity() * 3;
+  data.reset();
+  cache.set_max_size_in_bytes(0);
+  cache.get_or_make(*system, other);
+  EXPECT_TRUE(cache.find(T) == nullptr);
+  for (Eigen::Matrix3l const &T_b : same_lattice) {
+    EXPECT_TRUE(cache.find(T_b) == nullptr);
+  }
+  EXPECT_EQ(cache.size(), 1);
+}